@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+// The same cycle as bench/corosio/connection_churn_bench.cpp: connect,
+// accept, and a close with a zero linger on each side
+
+// Close a socket with a reset rather than a FIN
+void close_reset(tcp::socket& s)
+{
+    boost::system::error_code ec;
+    s.set_option(asio::socket_base::linger(true, 0), ec);
+    s.close(ec);
+}
+
+// Client side: one connection at a time until the cycles run out
+asio::awaitable<void> client_task(
+    tcp::endpoint ep,
+    std::atomic<int>& remaining,
+    std::atomic<int>& failed,
+    bench::histogram& stats)
+{
+    auto ex = co_await asio::this_coro::executor;
+    while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0)
+    {
+        bench::stopwatch sw;
+        tcp::socket sock(ex);
+        boost::system::error_code ec;
+        co_await sock.async_connect(ep, asio::redirect_error(asio::use_awaitable, ec));
+
+        // The server may have accepted and reset the connection before
+        // the connect completes
+        if (ec && ec != boost::system::errc::connection_reset)
+        {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Returns when the server's reset arrives
+        if (!ec)
+        {
+            char c;
+            co_await sock.async_read_some(
+                asio::buffer(&c, 1), asio::redirect_error(asio::use_awaitable, ec));
+        }
+        close_reset(sock);
+        stats.add(sw.elapsed_us());
+    }
+}
+
+// Server side: a new socket for each connection
+asio::awaitable<void> accept_task(tcp::acceptor& acc, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        boost::system::error_code ec;
+        tcp::socket peer = co_await acc.async_accept(
+            asio::redirect_error(asio::use_awaitable, ec));
+        if (ec)
+            co_return;
+        close_reset(peer);
+    }
+}
+
+// Benchmark: churn against an acceptor
+void bench_acceptor_churn(int num_threads, int connections, int cycles)
+{
+    asio::io_context ioc(num_threads);
+    tcp::acceptor acc(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    acc.listen(1024);
+    auto ep = acc.local_endpoint();
+
+    std::atomic<int> remaining{cycles};
+    std::atomic<int> failed{0};
+    std::atomic<int> running{connections};
+    std::vector<bench::histogram> stats(connections);
+
+    auto client = [&](int i) -> asio::awaitable<void>
+    {
+        co_await client_task(ep, remaining, failed, stats[i]);
+
+        // The last client closes the acceptor, which also cancels any
+        // accept left waiting for a connect that failed
+        if (running.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            asio::post(acc.get_executor(), [&acc]() { acc.close(); });
+    };
+
+    bench::stopwatch sw;
+    asio::co_spawn(ioc, accept_task(acc, cycles), asio::detached);
+    for (int i = 0; i < connections; ++i)
+        asio::co_spawn(ioc, client(i), asio::detached);
+
+    std::vector<std::thread> runners;
+    for (int t = 1; t < num_threads; ++t)
+        runners.emplace_back([&ioc]() { ioc.run(); });
+    ioc.run();
+    for (auto& t : runners)
+        t.join();
+    double elapsed = sw.elapsed_seconds();
+
+    bench::histogram all;
+    for (auto& s : stats)
+        all.merge(s);
+    double rate = static_cast<double>(all.count()) / elapsed;
+
+    std::cout << "  " << num_threads << " thread(s): "
+              << bench::format_rate(rate) << ", p50 "
+              << bench::format_latency(all.p50()) << ", p99 "
+              << bench::format_latency(all.p99());
+    if (failed.load())
+        std::cout << " (" << failed.load() << " failed)";
+    std::cout << "\n";
+
+    bench::record(bench::result("acceptor")
+        .param("threads", num_threads)
+        .param("connections", connections)
+        .param("cycles", cycles)
+        .ops_per_sec(rate)
+        .latency(all));
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --cycles <n>        Connections per test (default: 20000)\n";
+    std::cout << "  --connections <n>   Concurrent clients (default: 16)\n";
+    std::cout << "  --threads <n>       Largest thread count (default: 8)\n";
+    std::cout << "  --json <file>       Write the results as JSON\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int cycles = 20000;
+    int connections = 16;
+    int max_threads = 8;
+    bench::report::get().describe("asio", "connection_churn");
+    bench::report::get().set_backend("asio");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc)
+        {
+            cycles = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc)
+        {
+            connections = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            max_threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Asio Connection Churn Benchmarks\n";
+    std::cout << "======================================\n";
+    std::cout << "  Cycles: " << cycles << ", concurrent clients: "
+              << connections << "\n";
+
+    bench::print_header("Connect/Accept/Close (Asio acceptor)");
+    for (int t = 1; t <= max_threads; t *= 2)
+        bench_acceptor_churn(t, connections, cycles);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -9,6 +9,7 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/awaitable.hpp>
@@ -49,6 +50,10 @@ void bench_single_threaded_post(int num_handlers)
               << elapsed << " s\n";
     std::cout << "  Throughput:  " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("single_threaded_post")
+        .param("handlers", num_handlers)
+        .ops_per_sec(ops_per_sec));
+
     if (counter != num_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << num_handlers
@@ -56,6 +61,75 @@ void bench_single_threaded_post(int num_handlers)
     }
 }
 
+// Handler that posts itself back to its strand until done
+struct strand_chain
+{
+    asio::strand<asio::io_context::executor_type>* strand;
+    int* resumes;
+    int remaining;
+
+    void operator()()
+    {
+        ++*resumes;
+        if (--remaining > 0)
+            asio::post(*strand, *this);
+    }
+};
+
+// Benchmark: Post chains serialized by strands across threads
+void bench_strand_post(int iterations)
+{
+    bench::print_header("Strand Post (Asio)");
+
+    for (int num_strands : {1, 64})
+    {
+        for (int num_threads : {1, 4})
+        {
+            asio::io_context ioc(num_threads);
+            std::vector<asio::strand<asio::io_context::executor_type>> strands;
+            std::vector<int> resumes(num_strands, 0);
+            int per_strand = iterations / num_strands;
+            for (int s = 0; s < num_strands; ++s)
+                strands.push_back(asio::make_strand(ioc));
+
+            bench::stopwatch sw;
+            for (int s = 0; s < num_strands; ++s)
+                asio::post(strands[s],
+                    strand_chain{&strands[s], &resumes[s], per_strand});
+
+            std::vector<std::thread> runners;
+            for (int t = 0; t < num_threads; ++t)
+                runners.emplace_back([&ioc]() { ioc.run(); });
+            for (auto& t : runners)
+                t.join();
+
+            double elapsed = sw.elapsed_seconds();
+            int total = per_strand * num_strands;
+            double ops_per_sec = static_cast<double>(total) / elapsed;
+
+            std::cout << "  " << num_strands << " strand(s), "
+                      << num_threads << " thread(s): "
+                      << bench::format_rate(ops_per_sec) << "\n";
+
+            bench::record(bench::result("strand_post")
+                .param("strands", num_strands)
+                .param("threads", num_threads)
+                .param("iterations", total)
+                .ops_per_sec(ops_per_sec));
+
+            for (int s = 0; s < num_strands; ++s)
+            {
+                if (resumes[s] != per_strand)
+                {
+                    std::cerr << "  ERROR: resume mismatch! Expected "
+                              << per_strand << ", got " << resumes[s] << "\n";
+                    break;
+                }
+            }
+        }
+    }
+}
+
 // Benchmark: Multi-threaded scaling
 void bench_multithreaded_scaling(int num_handlers, int max_threads)
 {
@@ -103,6 +177,11 @@ void bench_multithreaded_scaling(int num_handlers, int max_threads)
         }
         std::cout << "\n";
 
+        bench::record(bench::result("multithreaded_scaling")
+            .param("handlers", num_handlers)
+            .param("threads", num_threads)
+            .ops_per_sec(ops_per_sec));
+
         if (counter.load() != num_handlers)
         {
             std::cerr << "  ERROR: counter mismatch! Expected " << num_handlers
@@ -146,6 +225,11 @@ void bench_interleaved_post_run(int iterations, int handlers_per_iteration)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("interleaved_post_run")
+        .param("iterations", iterations)
+        .param("handlers_per_iteration", handlers_per_iteration)
+        .ops_per_sec(ops_per_sec));
+
     if (counter != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -193,6 +277,11 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("concurrent_post_run")
+        .param("threads", num_threads)
+        .param("handlers_per_thread", handlers_per_thread)
+        .ops_per_sec(ops_per_sec));
+
     if (counter.load() != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -200,8 +289,12 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
     }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    bench::report::get().describe("asio", "io_context_callbacks");
+    bench::report::get().set_backend("asio");
+    bench::parse_options(argc, argv);
+
     std::cout << "Boost.Asio io_context Benchmarks\n";
     std::cout << "=================================\n";
 
@@ -216,6 +309,7 @@ int main()
 
     // Run benchmarks
     bench_single_threaded_post(1000000);
+    bench_strand_post(1000000);
     bench_multithreaded_scaling(1000000, 8);
     bench_interleaved_post_run(10000, 100);
     bench_concurrent_post_run(4, 250000);
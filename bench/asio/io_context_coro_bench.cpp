@@ -62,6 +62,10 @@ void bench_single_threaded_post(int num_handlers)
               << elapsed << " s\n";
     std::cout << "  Throughput:  " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("single_threaded_post")
+        .param("handlers", num_handlers)
+        .ops_per_sec(ops_per_sec));
+
     if (counter != num_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << num_handlers
@@ -111,6 +115,11 @@ void bench_multithreaded_scaling(int num_handlers, int max_threads)
 
         std::cout << "\n";
 
+        bench::record(bench::result("multithreaded_scaling")
+            .param("handlers", num_handlers)
+            .param("threads", num_threads)
+            .ops_per_sec(ops_per_sec));
+
         if (counter.load() != num_handlers)
         {
             std::cerr << "  ERROR: counter mismatch! Expected " << num_handlers
@@ -152,6 +161,11 @@ void bench_interleaved_post_run(int iterations, int handlers_per_iteration)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("interleaved_post_run")
+        .param("iterations", iterations)
+        .param("handlers_per_iteration", handlers_per_iteration)
+        .ops_per_sec(ops_per_sec));
+
     if (counter != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -195,6 +209,11 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("concurrent_post_run")
+        .param("threads", num_threads)
+        .param("handlers_per_thread", handlers_per_thread)
+        .ops_per_sec(ops_per_sec));
+
     if (counter.load() != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -202,8 +221,12 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
     }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    bench::report::get().describe("asio", "io_context");
+    bench::report::get().set_backend("asio");
+    bench::parse_options(argc, argv);
+
     std::cout << "Boost.Asio io_context Benchmarks (Coroutine Version)\n";
     std::cout << "====================================================\n";
     std::cout << "Using coroutines for fair comparison with Corosio\n";
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+// The same queries as bench/corosio/resolver_bench.cpp. Asio has no
+// cache of its own, so there is no "cached" run; its resolver does
+// each lookup on one private thread.
+
+struct query
+{
+    char const* name;
+    char const* host;
+    char const* service;
+    tcp::resolver::flags flags;
+};
+
+query const queries[] = {
+    {"localhost", "localhost", "80", tcp::resolver::flags()},
+    {"numeric", "127.0.0.1", "80",
+        tcp::resolver::numeric_host | tcp::resolver::numeric_service},
+};
+
+// One client: resolve until the count runs out
+asio::awaitable<void> client_task(
+    query const& q,
+    std::atomic<int>& remaining,
+    std::atomic<int>& failed,
+    bench::histogram& stats)
+{
+    auto ex = co_await asio::this_coro::executor;
+    tcp::resolver r(ex);
+    while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0)
+    {
+        bench::stopwatch sw;
+        boost::system::error_code ec;
+        auto results = co_await r.async_resolve(q.host, q.service, q.flags,
+            asio::redirect_error(asio::use_awaitable, ec));
+        if (ec || results.empty())
+        {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        stats.add(sw.elapsed_us());
+    }
+}
+
+// Benchmark: resolves per second for one query and concurrency
+void bench_resolve(query const& q, int concurrency, int count)
+{
+    asio::io_context ioc(1);
+
+    std::size_t const threads_before = bench::thread_count();
+    std::atomic<int> remaining{count};
+    std::atomic<int> failed{0};
+    std::vector<bench::histogram> stats(concurrency);
+
+    bench::stopwatch sw;
+    for (int i = 0; i < concurrency; ++i)
+        asio::co_spawn(ioc,
+            client_task(q, remaining, failed, stats[i]), asio::detached);
+    ioc.run();
+    double elapsed = sw.elapsed_seconds();
+
+    std::size_t const threads_after = bench::thread_count();
+    std::size_t const spawned = threads_after > threads_before
+        ? threads_after - threads_before : 0;
+
+    bench::histogram all;
+    for (auto& s : stats)
+        all.merge(s);
+    double rate = static_cast<double>(all.count()) / elapsed;
+
+    std::cout << "  " << concurrency << " concurrent: "
+              << bench::format_rate(rate) << ", p50 "
+              << bench::format_latency(all.p50()) << ", p99 "
+              << bench::format_latency(all.p99()) << ", p99.9 "
+              << bench::format_latency(all.p999());
+    if (threads_before)
+        std::cout << ", " << spawned << " thread(s) started";
+    if (failed.load())
+        std::cout << " (" << failed.load() << " failed)";
+    std::cout << "\n";
+
+    auto r = bench::result(q.name);
+    r.param("concurrency", concurrency)
+        .param("count", count)
+        .ops_per_sec(rate)
+        .latency(all);
+    if (threads_before)
+        r.metric("threads_started", static_cast<double>(spawned));
+    bench::record(std::move(r));
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --count <n>         Resolves per test (default: 20000)\n";
+    std::cout << "  --concurrency <n>   Largest number of clients (default: 64)\n";
+    std::cout << "  --json <file>       Write the results as JSON\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 20000;
+    int max_concurrency = 64;
+    bench::report::get().describe("asio", "resolver");
+    bench::report::get().set_backend("asio");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+        {
+            count = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--concurrency") == 0 && i + 1 < argc)
+        {
+            max_concurrency = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Asio Resolver Benchmarks\n";
+    std::cout << "==============================\n";
+    std::cout << "  Resolves per test: " << count << "\n";
+
+    for (auto const& q : queries)
+    {
+        std::string header = std::string("Resolve (Asio ") + q.name + ")";
+        bench::print_header(header.c_str());
+        for (int c = 1; c <= max_concurrency; c *= 4)
+            bench_resolve(q, c, count);
+    }
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -51,7 +51,7 @@ asio::awaitable<void> pingpong_task(
     tcp::socket& server,
     std::size_t message_size,
     int iterations,
-    bench::statistics& stats)
+    bench::histogram& stats)
 {
     std::vector<char> send_buf(message_size, 'P');
     std::vector<char> recv_buf(message_size);
@@ -102,7 +102,7 @@ void bench_pingpong_latency(std::size_t message_size, int iterations)
     asio::io_context ioc;
     auto [client, server] = make_socket_pair(ioc);
 
-    bench::statistics latency_stats;
+    bench::histogram latency_stats;
 
     asio::co_spawn(ioc,
         pingpong_task(client, server, message_size, iterations, latency_stats),
@@ -112,6 +112,11 @@ void bench_pingpong_latency(std::size_t message_size, int iterations)
     bench::print_latency_stats(latency_stats, "Round-trip latency");
     std::cout << "\n";
 
+    bench::record(bench::result("pingpong")
+        .param("message_size", message_size)
+        .param("iterations", iterations)
+        .latency(latency_stats));
+
     client.close();
     server.close();
 }
@@ -128,7 +133,7 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
     // Store sockets and stats separately for safe reference passing
     std::vector<tcp::socket> clients;
     std::vector<tcp::socket> servers;
-    std::vector<bench::statistics> stats(num_pairs);
+    std::vector<bench::histogram> stats(num_pairs);
 
     clients.reserve(num_pairs);
     servers.reserve(num_pairs);
@@ -164,15 +169,25 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
     // Calculate average across all pairs
     double total_mean = 0;
     double total_p99 = 0;
+    bench::histogram all;
     for (auto& s : stats)
     {
         total_mean += s.mean();
         total_p99 += s.p99();
+        all.merge(s);
     }
     std::cout << "  Average mean latency: "
               << bench::format_latency(total_mean / num_pairs) << "\n";
     std::cout << "  Average p99 latency:  "
-              << bench::format_latency(total_p99 / num_pairs) << "\n\n";
+              << bench::format_latency(total_p99 / num_pairs) << "\n";
+    bench::print_latency_stats(all, "All pairs");
+    std::cout << "\n";
+
+    bench::record(bench::result("concurrent_pairs")
+        .param("pairs", num_pairs)
+        .param("message_size", message_size)
+        .param("iterations", iterations)
+        .latency(all));
 
     for (auto& c : clients)
         c.close();
@@ -180,8 +195,12 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
         s.close();
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    bench::report::get().describe("asio", "socket_latency");
+    bench::report::get().set_backend("asio");
+    bench::parse_options(argc, argv);
+
     std::cout << "Boost.Asio Socket Latency Benchmarks\n";
     std::cout << "====================================\n";
 
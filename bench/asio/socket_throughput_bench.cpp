@@ -112,6 +112,11 @@ void bench_throughput(std::size_t chunk_size, std::size_t total_bytes)
               << elapsed << " s\n";
     std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
 
+    bench::record(bench::result("unidirectional")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
     writer.close();
     reader.close();
 }
@@ -223,12 +228,21 @@ void bench_bidirectional_throughput(std::size_t chunk_size, std::size_t total_by
     std::cout << "    Throughput:  " << bench::format_throughput(throughput)
               << " (combined)\n\n";
 
+    bench::record(bench::result("bidirectional")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
     sock1.close();
     sock2.close();
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    bench::report::get().describe("asio", "socket_throughput");
+    bench::report::get().set_backend("asio");
+    bench::parse_options(argc, argv);
+
     std::cout << "Boost.Asio Socket Throughput Benchmarks\n";
     std::cout << "=======================================\n";
 
@@ -0,0 +1,427 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+// The same measurements as bench/corosio/timer_bench.cpp
+
+using clock_type = asio::steady_timer::clock_type;
+
+struct suite_options
+{
+    int timers = 1000000;
+    int idle_timers = 100000;
+    int resets = 10;
+    int burst = 100000;
+    int ticks = 1000;
+    int load_pairs = 4;
+};
+
+double to_us(clock_type::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// One per-request deadline: create, arm, cancel and destroy a timer
+inline void timer_cycle(asio::io_context& ioc)
+{
+    asio::steady_timer t(ioc);
+    t.expires_after(std::chrono::seconds(30));
+    t.cancel();
+}
+
+// Benchmark: timer lifecycle rate across threads sharing one context
+void bench_timer_cycles(int cycles_per_thread, int max_threads)
+{
+    bench::print_header("Create/Arm/Cancel/Destroy (Asio)");
+
+    std::cout << "  Cycles per thread: " << cycles_per_thread << "\n\n";
+
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+    {
+        asio::io_context ioc(num_threads);
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&ioc, &go, cycles_per_thread]()
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (int i = 0; i < cycles_per_thread; ++i)
+                    timer_cycle(ioc);
+            });
+        }
+
+        bench::stopwatch sw;
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads)
+            t.join();
+        double elapsed = sw.elapsed_seconds();
+
+        auto total = static_cast<double>(cycles_per_thread) * num_threads;
+        std::cout << "  " << num_threads << " thread(s): "
+                  << bench::format_rate(total / elapsed)
+                  << " ("
+                  << bench::format_latency(elapsed * 1e6 * num_threads / total)
+                  << " per cycle per thread)\n";
+
+        bench::record(bench::result("timer_cycle")
+            .param("threads", num_threads)
+            .param("cycles_per_thread", cycles_per_thread)
+            .ops_per_sec(total / elapsed));
+    }
+}
+
+// Wait once, for the expiry or a cancellation
+asio::awaitable<void> wait_task(asio::steady_timer& t, int& done)
+{
+    boost::system::error_code ec;
+    co_await t.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    ++done;
+}
+
+// Benchmark: arm timers, each with a coroutine waiting on it, then
+// cancel them all
+void bench_arm_cancel(int count)
+{
+    asio::io_context ioc(1);
+    std::vector<asio::steady_timer> timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i)
+        timers.emplace_back(ioc);
+    int done = 0;
+
+    // Expiries spread over a minute, out of order
+    bench::stopwatch sw;
+    for (int i = 0; i < count; ++i)
+    {
+        auto spread = (static_cast<long long>(i) * 7919) % 60000000;
+        timers[i].expires_after(
+            std::chrono::seconds(60) + std::chrono::microseconds(spread));
+        asio::co_spawn(ioc, wait_task(timers[i], done), asio::detached);
+    }
+    ioc.poll();
+    double arm = sw.elapsed_seconds();
+
+    sw.reset();
+    for (auto& t : timers)
+        t.cancel();
+    ioc.run();
+    double cancel = sw.elapsed_seconds();
+
+    std::cout << "  Arm " << count << ": " << bench::format_rate(count / arm)
+              << ", cancel: " << bench::format_rate(count / cancel) << "\n";
+
+    bench::record(bench::result("arm")
+        .param("timers", count)
+        .ops_per_sec(count / arm));
+    bench::record(bench::result("cancel")
+        .param("timers", count)
+        .ops_per_sec(count / cancel));
+}
+
+// An idle timeout: a reset cancels the wait, which starts again
+asio::awaitable<void> idle_timeout_task(asio::steady_timer& t, bool const& stopping)
+{
+    for (;;)
+    {
+        boost::system::error_code ec;
+        co_await t.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        if (!ec || stopping)
+            co_return;
+    }
+}
+
+// Benchmark: push every idle timeout back, round after round
+void bench_reset(int count, int rounds)
+{
+    asio::io_context ioc(1);
+    std::vector<asio::steady_timer> timers;
+    timers.reserve(count);
+    bool stopping = false;
+    for (int i = 0; i < count; ++i)
+    {
+        auto& t = timers.emplace_back(ioc);
+        t.expires_after(std::chrono::seconds(30));
+        asio::co_spawn(ioc, idle_timeout_task(t, stopping), asio::detached);
+    }
+    ioc.poll();
+
+    bench::stopwatch sw;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto& t : timers)
+            t.expires_after(std::chrono::seconds(30));
+        ioc.poll();
+    }
+    double elapsed = sw.elapsed_seconds();
+    auto total = static_cast<double>(count) * rounds;
+
+    stopping = true;
+    for (auto& t : timers)
+        t.cancel();
+    ioc.run();
+
+    std::cout << "  Reset " << count << " x " << rounds << ": "
+              << bench::format_rate(total / elapsed) << "\n";
+
+    bench::record(bench::result("reset")
+        .param("timers", count)
+        .param("rounds", rounds)
+        .ops_per_sec(total / elapsed));
+}
+
+// Wait for a shared deadline, noting when the waits complete
+asio::awaitable<void> burst_task(
+    asio::steady_timer& t,
+    clock_type::time_point& first,
+    clock_type::time_point& last)
+{
+    boost::system::error_code ec;
+    co_await t.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    if (ec)
+        co_return;
+    last = clock_type::now();
+    if (first == clock_type::time_point())
+        first = last;
+}
+
+// Benchmark: many timers expiring at the same instant
+void bench_burst(int count)
+{
+    asio::io_context ioc(1);
+    std::vector<asio::steady_timer> timers;
+    timers.reserve(count);
+    clock_type::time_point first;
+    clock_type::time_point last;
+
+    auto deadline = clock_type::now() + std::chrono::milliseconds(200);
+    for (int i = 0; i < count; ++i)
+    {
+        auto& t = timers.emplace_back(ioc);
+        t.expires_at(deadline);
+        asio::co_spawn(ioc, burst_task(t, first, last), asio::detached);
+    }
+    bool late_start = clock_type::now() > deadline;
+    ioc.run();
+
+    double first_late = to_us(first - deadline);
+    double drain = to_us(last - first);
+    double rate = count / (to_us(last - deadline) / 1e6);
+
+    std::cout << "  Burst " << count << ": first after "
+              << bench::format_latency(first_late) << ", all after "
+              << bench::format_latency(to_us(last - deadline)) << " ("
+              << bench::format_rate(rate) << ")";
+    if (late_start)
+        std::cout << " (armed after the deadline)";
+    std::cout << "\n";
+
+    bench::record(bench::result("burst")
+        .param("timers", count)
+        .ops_per_sec(rate)
+        .metric("first_late_us", first_late)
+        .metric("drain_us", drain));
+}
+
+std::pair<tcp::socket, tcp::socket> make_socket_pair(asio::io_context& ioc)
+{
+    tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    tcp::socket client(ioc);
+    client.connect(acceptor.local_endpoint());
+    tcp::socket server = acceptor.accept();
+    client.set_option(tcp::no_delay(true));
+    server.set_option(tcp::no_delay(true));
+    return {std::move(client), std::move(server)};
+}
+
+// Background traffic on a socket pair until `stop` is set
+asio::awaitable<void> load_task(
+    tcp::socket& client,
+    tcp::socket& server,
+    bool const& stop)
+{
+    char buf[64] = {};
+    while (!stop)
+    {
+        boost::system::error_code ec;
+        co_await asio::async_write(client, asio::buffer(buf),
+            asio::redirect_error(asio::use_awaitable, ec));
+        if (ec)
+            co_return;
+        co_await asio::async_read(server, asio::buffer(buf),
+            asio::redirect_error(asio::use_awaitable, ec));
+        if (ec)
+            co_return;
+    }
+}
+
+// A periodic timer, recording how late each tick completes
+asio::awaitable<void> ticker_task(
+    asio::steady_timer& t,
+    int ticks,
+    std::chrono::microseconds period,
+    bench::histogram& lateness,
+    bool& stop)
+{
+    auto due = clock_type::now() + period;
+    for (int i = 0; i < ticks; ++i, due += period)
+    {
+        t.expires_at(due);
+        boost::system::error_code ec;
+        co_await t.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        if (ec)
+            break;
+        lateness.add(to_us(clock_type::now() - due));
+    }
+    stop = true;
+}
+
+// Benchmark: how late a 1 ms periodic timer completes, on an idle
+// context and on one busy with socket traffic
+void bench_accuracy(int ticks, int load_pairs)
+{
+    for (int pairs : {0, load_pairs})
+    {
+        asio::io_context ioc(1);
+        std::vector<std::pair<tcp::socket, tcp::socket>> sockets;
+        sockets.reserve(pairs);
+        bool stop = false;
+        for (int i = 0; i < pairs; ++i)
+        {
+            auto& p = sockets.emplace_back(make_socket_pair(ioc));
+            asio::co_spawn(ioc, load_task(p.first, p.second, stop), asio::detached);
+        }
+
+        asio::steady_timer t(ioc);
+        bench::histogram lateness;
+        asio::co_spawn(ioc, ticker_task(
+            t, ticks, std::chrono::milliseconds(1), lateness, stop),
+            asio::detached);
+        ioc.run();
+
+        std::cout << "  " << (pairs ? "Loaded" : "Idle") << ": p50 "
+                  << bench::format_latency(lateness.p50()) << ", p99 "
+                  << bench::format_latency(lateness.p99()) << ", max "
+                  << bench::format_latency((lateness.max)()) << " late\n";
+
+        bench::record(bench::result(pairs ? "accuracy_loaded" : "accuracy_idle")
+            .param("ticks", ticks)
+            .param("load_pairs", pairs)
+            .latency(lateness));
+    }
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --cycles <n>       Timer cycles per thread (default: 1000000)\n";
+    std::cout << "  --threads <n>      Largest thread count (default: 8)\n";
+    std::cout << "  --timers <n>       Timers armed and cancelled (default: 1000000)\n";
+    std::cout << "  --idle <n>         Idle timeouts reset each round (default: 100000)\n";
+    std::cout << "  --resets <n>       Reset rounds (default: 10)\n";
+    std::cout << "  --burst <n>        Timers expiring together (default: 100000)\n";
+    std::cout << "  --ticks <n>        Ticks of the 1 ms accuracy timer (default: 1000)\n";
+    std::cout << "  --json <file>      Write the results as JSON\n";
+    std::cout << "  --help             Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int cycles = 1000000;
+    int max_threads = 8;
+    suite_options opt;
+    bench::report::get().describe("asio", "timer");
+    bench::report::get().set_backend("asio");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc)
+        {
+            cycles = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            max_threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--timers") == 0 && i + 1 < argc)
+        {
+            opt.timers = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--idle") == 0 && i + 1 < argc)
+        {
+            opt.idle_timers = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--resets") == 0 && i + 1 < argc)
+        {
+            opt.resets = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--burst") == 0 && i + 1 < argc)
+        {
+            opt.burst = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+        {
+            opt.ticks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Asio Timer Benchmarks\n";
+    std::cout << "===========================\n\n";
+
+    bench_timer_cycles(cycles, max_threads);
+
+    bench::print_header("Timer suite (Asio)");
+    bench_arm_cancel(opt.timers);
+    bench_reset(opt.idle_timers, opt.resets);
+    bench_burst(opt.burst);
+    bench_accuracy(opt.ticks, opt.load_pairs);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
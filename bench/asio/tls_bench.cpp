@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include <openssl/ssl.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+#include "../common/tls_credentials.hpp"
+
+namespace asio = boost::asio;
+namespace ssl = boost::asio::ssl;
+using tcp = asio::ip::tcp;
+
+// Create a connected socket pair using TCP loopback
+std::pair<tcp::socket, tcp::socket> make_socket_pair(asio::io_context& ioc)
+{
+    tcp::acceptor acceptor(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    tcp::socket client(ioc);
+    tcp::socket server(ioc);
+
+    client.connect(acceptor.local_endpoint());
+    server = acceptor.accept();
+
+    client.set_option(tcp::no_delay(true));
+    server.set_option(tcp::no_delay(true));
+
+    return {std::move(client), std::move(server)};
+}
+
+ssl::context make_server_context()
+{
+    ssl::context ctx(ssl::context::tls);
+    ctx.use_certificate(
+        asio::buffer(std::string_view(bench::tls_cert_pem)), ssl::context::pem);
+    ctx.use_private_key(
+        asio::buffer(std::string_view(bench::tls_key_pem)), ssl::context::pem);
+    return ctx;
+}
+
+ssl::context make_client_context()
+{
+    ssl::context ctx(ssl::context::tls);
+    ctx.add_certificate_authority(
+        asio::buffer(std::string_view(bench::tls_cert_pem)));
+    ctx.set_verify_mode(ssl::verify_peer);
+    ctx.set_verify_callback(ssl::host_name_verification("localhost"));
+    return ctx;
+}
+
+// A client stream that names the server, as the Corosio client does
+void prepare_client(ssl::stream<tcp::socket>& stream)
+{
+    SSL_set_tlsext_host_name(stream.native_handle(), "localhost");
+}
+
+// Benchmark: sequential connections to one listener, each doing a
+// handshake and reading the server's first byte. The byte makes the
+// client take in TLS 1.3 session tickets, which follow the handshake.
+// Resumption offers the last session received, as Asio keeps none.
+void bench_handshakes(int count, bool resume)
+{
+    std::cout << "  " << (resume ? "Resumed" : "Full") << " handshakes: "
+              << count << "\n";
+
+    asio::io_context ioc;
+    tcp::acceptor acc(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    auto ep = acc.local_endpoint();
+
+    auto server_ctx = make_server_context();
+    auto client_ctx = make_client_context();
+
+    int completed = 0;
+    int failed = 0;
+    bench::statistics stats;
+    std::shared_ptr<SSL_SESSION> session;
+
+    auto server_task = [&]() -> asio::awaitable<void>
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            try
+            {
+                ssl::stream<tcp::socket> stream(
+                    co_await acc.async_accept(asio::use_awaitable), server_ctx);
+                co_await stream.async_handshake(
+                    ssl::stream_base::server, asio::use_awaitable);
+                char c = 'r';
+                co_await stream.async_write_some(
+                    asio::buffer(&c, 1), asio::use_awaitable);
+
+                // Wait for the client to hang up
+                co_await stream.async_read_some(
+                    asio::buffer(&c, 1), asio::use_awaitable);
+            }
+            catch (std::exception const&) {}
+        }
+    };
+
+    auto client_task = [&]() -> asio::awaitable<void>
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            ssl::stream<tcp::socket> stream(ioc, client_ctx);
+            prepare_client(stream);
+            if (resume && session)
+                SSL_set_session(stream.native_handle(), session.get());
+            bench::stopwatch sw;
+            try
+            {
+                co_await stream.next_layer().async_connect(ep, asio::use_awaitable);
+                co_await stream.async_handshake(
+                    ssl::stream_base::client, asio::use_awaitable);
+                char c;
+                co_await stream.async_read_some(
+                    asio::buffer(&c, 1), asio::use_awaitable);
+                stats.add(sw.elapsed_us());
+                ++completed;
+                if (resume)
+                    session.reset(SSL_get1_session(stream.native_handle()),
+                        SSL_SESSION_free);
+            }
+            catch (std::exception const&)
+            {
+                ++failed;
+            }
+            boost::system::error_code ec;
+            stream.next_layer().close(ec);
+        }
+    };
+
+    bench::stopwatch sw;
+    asio::co_spawn(ioc, server_task(), asio::detached);
+    asio::co_spawn(ioc, client_task(), asio::detached);
+    ioc.run();
+    double elapsed = sw.elapsed_seconds();
+
+    std::cout << "    Completed:   " << completed;
+    if (failed)
+        std::cout << " (" << failed << " failed)";
+    std::cout << "\n";
+    std::cout << "    Elapsed:     " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Rate:        " << bench::format_rate(completed / elapsed) << "\n";
+    std::cout << "    Latency:     mean " << bench::format_latency(stats.mean())
+              << ", p50 " << bench::format_latency(stats.p50())
+              << ", p99 " << bench::format_latency(stats.p99()) << "\n\n";
+
+    bench::record(bench::result("handshake")
+        .param("resume", resume ? "on" : "off")
+        .param("count", count)
+        .ops_per_sec(completed / elapsed)
+        .latency(stats));
+}
+
+// Benchmark: one-way transfer in writes of a given size; writes up
+// to 16 KiB map to records of the same size
+void bench_bulk_throughput(std::size_t chunk_size, std::size_t total_bytes)
+{
+    std::cout << "  Write size: " << chunk_size << " bytes, ";
+    std::cout << "Transfer: " << (total_bytes / (1024 * 1024)) << " MB\n";
+
+    asio::io_context ioc;
+    auto [s1, s2] = make_socket_pair(ioc);
+    auto client_ctx = make_client_context();
+    auto server_ctx = make_server_context();
+    ssl::stream<tcp::socket> writer(std::move(s1), client_ctx);
+    ssl::stream<tcp::socket> reader(std::move(s2), server_ctx);
+    prepare_client(writer);
+
+    std::vector<char> write_buf(chunk_size, 'x');
+    std::vector<char> read_buf(65536);
+
+    std::size_t total_written = 0;
+    std::size_t total_read = 0;
+    bench::stopwatch sw;
+
+    auto write_task = [&]() -> asio::awaitable<void>
+    {
+        try
+        {
+            co_await writer.async_handshake(
+                ssl::stream_base::client, asio::use_awaitable);
+            while (total_written < total_bytes)
+            {
+                std::size_t to_write = (std::min)(chunk_size, total_bytes - total_written);
+                auto n = co_await writer.async_write_some(
+                    asio::buffer(write_buf.data(), to_write),
+                    asio::use_awaitable);
+                total_written += n;
+            }
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "    Write error: " << e.what() << "\n";
+        }
+    };
+
+    auto read_task = [&]() -> asio::awaitable<void>
+    {
+        try
+        {
+            co_await reader.async_handshake(
+                ssl::stream_base::server, asio::use_awaitable);
+            sw.reset();
+            while (total_read < total_bytes)
+            {
+                auto n = co_await reader.async_read_some(
+                    asio::buffer(read_buf.data(), read_buf.size()),
+                    asio::use_awaitable);
+                total_read += n;
+            }
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "    Read error: " << e.what() << "\n";
+        }
+    };
+
+    asio::co_spawn(ioc, write_task(), asio::detached);
+    asio::co_spawn(ioc, read_task(), asio::detached);
+    ioc.run();
+
+    double elapsed = sw.elapsed_seconds();
+    double throughput = static_cast<double>(total_read) / elapsed;
+
+    std::cout << "    Read:       " << total_read << " bytes\n";
+    std::cout << "    Elapsed:    " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
+
+    bench::record(bench::result("bulk")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+}
+
+// Benchmark: resident memory added by the TLS state of connections
+// that finished their handshake and sit idle. The sockets exist
+// before the first measurement, so only the streams are counted.
+void bench_idle_memory(int count)
+{
+    std::cout << "  Connections: " << count << "\n";
+
+    asio::io_context ioc;
+    auto client_ctx = make_client_context();
+    auto server_ctx = make_server_context();
+
+    using socket_pair = std::pair<tcp::socket, tcp::socket>;
+    std::vector<std::unique_ptr<socket_pair>> sockets;
+    sockets.reserve(count);
+    for (int i = 0; i < count; ++i)
+        sockets.push_back(std::make_unique<socket_pair>(make_socket_pair(ioc)));
+
+    using stream_type = ssl::stream<tcp::socket&>;
+    std::vector<std::unique_ptr<stream_type>> streams;
+    streams.reserve(2 * count);
+    std::size_t before = bench::resident_memory();
+
+    int failed = 0;
+    auto handshake = [&](stream_type& stream, ssl::stream_base::handshake_type type)
+        -> asio::awaitable<void>
+    {
+        try
+        {
+            co_await stream.async_handshake(type, asio::use_awaitable);
+        }
+        catch (std::exception const&)
+        {
+            ++failed;
+        }
+    };
+    for (auto& p : sockets)
+    {
+        streams.push_back(std::make_unique<stream_type>(p->first, client_ctx));
+        SSL_set_tlsext_host_name(streams.back()->native_handle(), "localhost");
+        streams.push_back(std::make_unique<stream_type>(p->second, server_ctx));
+        asio::co_spawn(ioc,
+            handshake(*streams[streams.size() - 2], ssl::stream_base::client),
+            asio::detached);
+        asio::co_spawn(ioc,
+            handshake(*streams.back(), ssl::stream_base::server),
+            asio::detached);
+    }
+    ioc.run();
+
+    std::size_t after = bench::resident_memory();
+    if (failed)
+        std::cout << "    Failed handshakes: " << failed << "\n";
+    if (before == 0 || after == 0)
+    {
+        std::cout << "    Resident memory is not available on this platform\n\n";
+        return;
+    }
+
+    double added = after > before
+        ? static_cast<double>(after - before)
+        : 0.0;
+    std::cout << "    Added:      " << bench::format_bytes(added) << "\n";
+    std::cout << "    Per conn:   " << bench::format_bytes(added / count)
+              << " (client + server)\n\n";
+
+    bench::record(bench::result("idle_memory")
+        .param("connections", count)
+        .metric("bytes_per_connection", added / count));
+}
+
+int main(int argc, char* argv[])
+{
+    bench::report::get().describe("asio", "tls");
+    bench::report::get().set_backend("asio_ssl");
+    bench::parse_options(argc, argv);
+
+    std::cout << "Boost.Asio TLS Benchmarks\n";
+    std::cout << "=========================\n";
+
+    bench::print_header("Handshakes (Asio SSL)");
+    bench_handshakes(2000, false);
+    bench_handshakes(2000, true);
+
+    bench::print_header("Bulk Throughput (Asio SSL)");
+    std::size_t transfer_size = 64 * 1024 * 1024; // 64 MB
+    for (std::size_t size : {1024, 4096, 16384, 65536})
+        bench_bulk_throughput(size, transfer_size);
+
+    bench::print_header("Idle Connection Memory (Asio SSL)");
+    bench_idle_memory(256);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -11,17 +11,72 @@
 #define BOOST_COROSIO_BENCH_BENCHMARK_HPP
 
 #include <algorithm>
+#include <bit>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#else
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <tlhelp32.h>
+#endif
+
 namespace bench {
 
+#if defined(BOOST_COROSIO_BENCH_COUNT_ALLOCATIONS)
+inline constexpr bool counting_allocations = true;
+
+// Calls to the global operator new so far, counted by the
+// replacement in count_allocations.cpp
+std::size_t allocation_count() noexcept;
+#else
+inline constexpr bool counting_allocations = false;
+
+inline std::size_t allocation_count() noexcept
+{
+    return 0;
+}
+#endif
+
+// The interval a stopwatch last reported in seconds, and the
+// allocations made during it, so that a rate recorded from it
+// can be reported per operation too
+struct interval
+{
+    double seconds = 0;
+    std::size_t allocations = 0;
+};
+
+inline interval& last_interval() noexcept
+{
+    thread_local interval i;
+    return i;
+}
+
 // RAII timer using steady_clock
 class stopwatch
 {
@@ -32,12 +87,14 @@ public:
 
     stopwatch()
         : start_(clock::now())
+        , allocations_(allocation_count())
     {
     }
 
     void reset()
     {
         start_ = clock::now();
+        allocations_ = allocation_count();
     }
 
     duration elapsed() const
@@ -47,7 +104,9 @@ public:
 
     double elapsed_seconds() const
     {
-        return std::chrono::duration<double>(elapsed()).count();
+        auto const seconds = std::chrono::duration<double>(elapsed()).count();
+        last_interval() = {seconds, allocation_count() - allocations_};
+        return seconds;
     }
 
     double elapsed_ms() const
@@ -62,6 +121,7 @@ public:
 
 private:
     time_point start_;
+    std::size_t allocations_;
 };
 
 // Statistics collector
@@ -154,6 +214,137 @@ private:
     std::vector<double> samples_;
 };
 
+// Latency histogram in the manner of HdrHistogram. Takes microseconds
+// like statistics, but keeps counts in log-linear buckets of
+// nanoseconds instead of the samples: values under 256 ns are exact
+// and larger ones are kept to within 1 part in 128, up to about an
+// hour. Memory is constant and recording is a few instructions.
+class histogram
+{
+    static constexpr int sub_bits = 8;
+    static constexpr int half_bits = sub_bits - 1;
+    static constexpr std::uint64_t half_count = 1u << half_bits;
+    static constexpr int bucket_count = 35;
+    static constexpr std::uint64_t highest =
+        (std::uint64_t(1) << (bucket_count - 1 + sub_bits)) - 1;
+
+    static std::size_t index_of(std::uint64_t v)
+    {
+        v = (std::min)(v, highest);
+        int bucket = (64 - std::countl_zero(v | ((1u << sub_bits) - 1))) -
+            sub_bits;
+        return ((static_cast<std::size_t>(bucket) + 1) << half_bits) +
+            static_cast<std::size_t>((v >> bucket) - half_count);
+    }
+
+    // Largest value counted at index i
+    static std::uint64_t highest_at(std::size_t i)
+    {
+        int bucket = static_cast<int>(i >> half_bits) - 1;
+        std::uint64_t sub = (i & (half_count - 1)) + half_count;
+        if (bucket < 0)
+        {
+            sub -= half_count;
+            bucket = 0;
+        }
+        return (sub << bucket) + ((std::uint64_t(1) << bucket) - 1);
+    }
+
+public:
+    histogram()
+        : counts_((bucket_count + 1) * half_count)
+    {
+    }
+
+    void add(double us)
+    {
+        auto ns = static_cast<std::uint64_t>(
+            std::llround((std::max)(us, 0.0) * 1e3));
+        ++counts_[index_of(ns)];
+        ++count_;
+        sum_ += ns;
+        min_ = (std::min)(min_, ns);
+        max_ = (std::max)(max_, ns);
+    }
+
+    // Adds the counts of another histogram, e.g. one per connection
+    void merge(histogram const& other)
+    {
+        for (std::size_t i = 0; i < counts_.size(); ++i)
+            counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = (std::min)(min_, other.min_);
+        max_ = (std::max)(max_, other.max_);
+    }
+
+    void clear()
+    {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = (std::numeric_limits<std::uint64_t>::max)();
+        max_ = 0;
+    }
+
+    std::size_t count() const
+    {
+        return static_cast<std::size_t>(count_);
+    }
+
+    double mean() const
+    {
+        if (count_ == 0)
+            return 0.0;
+        return static_cast<double>(sum_) / static_cast<double>(count_) / 1e3;
+    }
+
+    double (min)() const
+    {
+        if (count_ == 0)
+            return 0.0;
+        return static_cast<double>(min_) / 1e3;
+    }
+
+    double (max)() const
+    {
+        return static_cast<double>(max_) / 1e3;
+    }
+
+    // Returns the p-th percentile (p in [0, 1]) in microseconds
+    double percentile(double p) const
+    {
+        if (count_ == 0)
+            return 0.0;
+
+        p = (std::clamp)(p, 0.0, 1.0);
+        auto target = (std::max)(std::uint64_t(1), static_cast<std::uint64_t>(
+            std::ceil(p * static_cast<double>(count_))));
+        std::uint64_t below = 0;
+        for (std::size_t i = 0; i < counts_.size(); ++i)
+        {
+            below += counts_[i];
+            if (below >= target)
+                return static_cast<double>(
+                    (std::min)(highest_at(i), max_)) / 1e3;
+        }
+        return (max)();
+    }
+
+    double p50() const { return percentile(0.50); }
+    double p90() const { return percentile(0.90); }
+    double p99() const { return percentile(0.99); }
+    double p999() const { return percentile(0.999); }
+    double p9999() const { return percentile(0.9999); }
+
+private:
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = (std::numeric_limits<std::uint64_t>::max)();
+    std::uint64_t max_ = 0;
+};
+
 // Format operations per second
 inline std::string format_rate(double ops_per_sec)
 {
@@ -208,6 +399,86 @@ inline std::string format_latency(double microseconds)
     return oss.str();
 }
 
+// Format a byte count
+inline std::string format_bytes(double bytes)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+
+    if (bytes >= 1024.0 * 1024.0)
+        oss << (bytes / (1024.0 * 1024.0)) << " MiB";
+    else if (bytes >= 1024.0)
+        oss << (bytes / 1024.0) << " KiB";
+    else
+        oss << bytes << " B";
+
+    return oss.str();
+}
+
+// Resident set size of this process in bytes, or 0 where unknown
+inline std::size_t resident_memory()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    if (!(statm >> pages >> resident))
+        return 0;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// Threads in this process, or 0 where unknown
+inline std::size_t thread_count()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0, 8, "Threads:") == 0)
+            return static_cast<std::size_t>(std::strtoul(line.c_str() + 8, nullptr, 10));
+    return 0;
+#elif defined(_WIN32)
+    HANDLE snap = ::CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snap == INVALID_HANDLE_VALUE)
+        return 0;
+    DWORD const pid = ::GetCurrentProcessId();
+    std::size_t n = 0;
+    THREADENTRY32 te{};
+    te.dwSize = sizeof(te);
+    for (BOOL ok = ::Thread32First(snap, &te); ok; ok = ::Thread32Next(snap, &te))
+        if (te.th32OwnerProcessID == pid)
+            ++n;
+    ::CloseHandle(snap);
+    return n;
+#else
+    return 0;
+#endif
+}
+
+// Raise the descriptor limit toward what `pairs` connection pairs need,
+// and return how many pairs fit in the limit in effect
+inline int raise_fd_limit(int pairs)
+{
+#if !defined(_WIN32)
+    rlimit rl{};
+    if (::getrlimit(RLIMIT_NOFILE, &rl) != 0)
+        return pairs;
+    rlim_t const want = 2 * static_cast<rlim_t>(pairs) + 256;
+    if (rl.rlim_cur < want)
+    {
+        rl.rlim_cur = (std::min)(want, rl.rlim_max);
+        ::setrlimit(RLIMIT_NOFILE, &rl);
+        ::getrlimit(RLIMIT_NOFILE, &rl);
+    }
+    if (rl.rlim_cur < want)
+        return rl.rlim_cur > 256 ? static_cast<int>((rl.rlim_cur - 256) / 2) : 0;
+#endif
+    return pairs;
+}
+
 // Print a benchmark result header
 inline void print_header(char const* name)
 {
@@ -235,6 +506,302 @@ inline void print_latency_stats(statistics const& stats, char const* label)
     std::cout << "    max:   " << format_latency((stats.max)()) << "\n";
 }
 
+// Print latency percentiles from a histogram
+inline void print_latency_stats(histogram const& stats, char const* label)
+{
+    std::cout << "  " << label << ":\n";
+    std::cout << "    mean:   " << format_latency(stats.mean()) << "\n";
+    std::cout << "    p50:    " << format_latency(stats.p50()) << "\n";
+    std::cout << "    p90:    " << format_latency(stats.p90()) << "\n";
+    std::cout << "    p99:    " << format_latency(stats.p99()) << "\n";
+    std::cout << "    p99.9:  " << format_latency(stats.p999()) << "\n";
+    std::cout << "    p99.99: " << format_latency(stats.p9999()) << "\n";
+    std::cout << "    min:    " << format_latency((stats.min)()) << "\n";
+    std::cout << "    max:    " << format_latency((stats.max)()) << "\n";
+}
+
+// Write a string as a JSON string literal
+inline void write_json_string(std::ostream& os, std::string const& s)
+{
+    os << '"';
+    for (char c : s)
+    {
+        switch (c)
+        {
+        case '"':  os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                os << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+            else
+                os << c;
+        }
+    }
+    os << '"';
+}
+
+// Format a number for JSON, which has no infinity or NaN
+inline std::string json_number(double v)
+{
+    if (!std::isfinite(v))
+        return "null";
+    std::ostringstream oss;
+    oss << std::setprecision(10) << v;
+    return oss.str();
+}
+
+// One measurement for the machine-readable report. Benchmarks that
+// measure the same thing in bench/corosio and bench/asio use the same
+// suite, name and parameters so that runs can be compared.
+class result
+{
+public:
+    explicit result(std::string name)
+        : name_(std::move(name))
+    {
+    }
+
+    template<class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+    result& param(std::string key, T value)
+    {
+        params_.emplace_back(
+            std::move(key), json_number(static_cast<double>(value)));
+        return *this;
+    }
+
+    result& param(std::string key, std::string const& value)
+    {
+        std::ostringstream oss;
+        write_json_string(oss, value);
+        params_.emplace_back(std::move(key), oss.str());
+        return *this;
+    }
+
+    // Operations completed per second. When allocations are
+    // counted, those made during the interval last timed with
+    // elapsed_seconds() are reported per operation beside it.
+    result& ops_per_sec(double v)
+    {
+        metric("ops_per_sec", v);
+        auto const& i = last_interval();
+        if (counting_allocations && v > 0 && i.seconds > 0)
+            allocations_per_op(
+                static_cast<double>(i.allocations) / (v * i.seconds));
+        return *this;
+    }
+
+    // Global operator new calls per operation
+    result& allocations_per_op(double v)
+    {
+        allocations_per_op_ = v;
+        return metric("allocs_per_op", v);
+    }
+
+    // Payload bytes moved per second
+    result& bytes_per_sec(double v)
+    {
+        return metric("bytes_per_sec", v);
+    }
+
+    // Any other figure worth tracking, larger or smaller being better
+    result& metric(std::string key, double v)
+    {
+        metrics_.emplace_back(std::move(key), v);
+        return *this;
+    }
+
+    // Latency percentiles, in microseconds
+    template<class Stats>
+    result& latency(Stats const& stats)
+    {
+        has_latency_ = true;
+        latency_ = {
+            {"mean", stats.mean()},
+            {"p50", stats.p50()},
+            {"p90", stats.p90()},
+            {"p99", stats.p99()},
+            {"p99.9", stats.p999()},
+            {"max", (stats.max)()}};
+        return *this;
+    }
+
+    result& latency(histogram const& stats)
+    {
+        latency<histogram>(stats);
+        latency_.insert(latency_.end() - 1, {"p99.99", stats.p9999()});
+        return *this;
+    }
+
+    void write(
+        std::ostream& os,
+        std::string const& backend,
+        std::size_t rss) const
+    {
+        os << "    {\"name\": ";
+        write_json_string(os, name_);
+        os << ", \"backend\": ";
+        write_json_string(os, backend);
+        os << ",\n     \"params\": {";
+        for (std::size_t i = 0; i < params_.size(); ++i)
+        {
+            os << (i ? ", " : "");
+            write_json_string(os, params_[i].first);
+            os << ": " << params_[i].second;
+        }
+        os << "}";
+        for (auto const& [key, v] : metrics_)
+        {
+            os << ", ";
+            write_json_string(os, key);
+            os << ": " << json_number(v);
+        }
+        if (has_latency_)
+        {
+            os << ",\n     \"latency_us\": {";
+            for (std::size_t i = 0; i < latency_.size(); ++i)
+            {
+                os << (i ? ", " : "");
+                write_json_string(os, latency_[i].first);
+                os << ": " << json_number(latency_[i].second);
+            }
+            os << "}";
+        }
+        os << ", \"rss_bytes\": " << rss << "}";
+    }
+
+    std::string const& name() const noexcept
+    {
+        return name_;
+    }
+
+    // Negative when not measured
+    double allocations_per_op() const noexcept
+    {
+        return allocations_per_op_;
+    }
+
+private:
+    std::string name_;
+    std::vector<std::pair<std::string, std::string>> params_;
+    std::vector<std::pair<std::string, double>> metrics_;
+    std::vector<std::pair<std::string, double>> latency_;
+    bool has_latency_ = false;
+    double allocations_per_op_ = -1;
+};
+
+// Collects results and writes them as JSON when the program exits.
+// Nothing is written unless a file was named with --json.
+class report
+{
+public:
+    static report& get()
+    {
+        static report r;
+        return r;
+    }
+
+    // Name the library ("corosio" or "asio") and suite of this program
+    void describe(std::string library, std::string suite)
+    {
+        library_ = std::move(library);
+        suite_ = std::move(suite);
+    }
+
+    // Backend recorded with the results that follow
+    void set_backend(std::string backend)
+    {
+        backend_ = std::move(backend);
+    }
+
+    void open(std::string path)
+    {
+        path_ = std::move(path);
+    }
+
+    bool enabled() const noexcept
+    {
+        return !path_.empty();
+    }
+
+    void add(result r)
+    {
+        if (r.allocations_per_op() >= 0)
+            std::cout << "  " << r.name() << ": " << std::fixed
+                      << std::setprecision(2) << r.allocations_per_op()
+                      << " allocs/op\n";
+        if (!enabled())
+            return;
+        std::ostringstream oss;
+        r.write(oss, backend_, resident_memory());
+        entries_.push_back(oss.str());
+    }
+
+    ~report()
+    {
+        if (!enabled())
+            return;
+        std::ofstream out(path_);
+        out << "{\n  \"library\": ";
+        write_json_string(out, library_);
+        out << ",\n  \"suite\": ";
+        write_json_string(out, suite_);
+        out << ",\n  \"results\": [\n";
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+            out << entries_[i] << (i + 1 < entries_.size() ? ",\n" : "\n");
+        out << "  ]\n}\n";
+        if (!out)
+            std::cerr << "Error: could not write " << path_ << "\n";
+    }
+
+private:
+    report() = default;
+
+    std::string path_;
+    std::string library_;
+    std::string suite_;
+    std::string backend_ = "default";
+    std::vector<std::string> entries_;
+};
+
+// Record a result in the report
+inline void record(result r)
+{
+    report::get().add(std::move(r));
+}
+
+// Consume "--json <file>" at argv[i], returning false for other options
+inline bool parse_json_option(int argc, char* argv[], int& i)
+{
+    if (std::strcmp(argv[i], "--json") != 0)
+        return false;
+    if (i + 1 >= argc)
+    {
+        std::cerr << "Error: --json requires a file name\n";
+        std::exit(1);
+    }
+    report::get().open(argv[++i]);
+    return true;
+}
+
+// Parse the options of a benchmark that takes no others
+inline void parse_options(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (parse_json_option(argc, argv, i))
+            continue;
+        bool help = std::strcmp(argv[i], "--help") == 0 ||
+            std::strcmp(argv[i], "-h") == 0;
+        if (!help)
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+        std::cout << "Usage: " << argv[0] << " [--json <file>]\n";
+        std::exit(help ? 0 : 1);
+    }
+}
+
 } // namespace bench
 
 #endif
@@ -0,0 +1,389 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Compares two benchmark reports written with --json and flags the
+// measurements that got worse by more than a threshold. Either report
+// may hold a corosio or an asio run; with --ignore-backend results are
+// matched on suite, name and parameters alone, so that corosio can be
+// compared against asio.
+//
+// Rates ("..._per_sec") are better when larger; latencies and the
+// other figures are better when smaller. The exit status is 1 when
+// anything regressed.
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Just enough JSON for the reports in bench/common/benchmark.hpp
+struct value
+{
+    enum class kind { null, boolean, number, string, array, object };
+
+    kind k = kind::null;
+    double number = 0;
+    std::string string;
+    std::vector<value> array;
+    std::vector<std::pair<std::string, value>> object;
+
+    value const* find(std::string const& key) const
+    {
+        for (auto const& [k2, v] : object)
+            if (k2 == key)
+                return &v;
+        return nullptr;
+    }
+};
+
+class parser
+{
+public:
+    explicit parser(std::string text)
+        : text_(std::move(text))
+    {
+    }
+
+    value parse()
+    {
+        value v = parse_value();
+        skip_space();
+        if (pos_ != text_.size())
+            fail("trailing characters");
+        return v;
+    }
+
+private:
+    [[noreturn]] void fail(char const* what) const
+    {
+        throw std::runtime_error(
+            std::string(what) + " at offset " + std::to_string(pos_));
+    }
+
+    void skip_space()
+    {
+        while (pos_ < text_.size() &&
+            std::strchr(" \t\r\n", text_[pos_]) != nullptr)
+            ++pos_;
+    }
+
+    bool consume(char c)
+    {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c)
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c))
+            fail("unexpected character");
+    }
+
+    bool consume_word(char const* word)
+    {
+        std::size_t n = std::strlen(word);
+        if (text_.compare(pos_, n, word) != 0)
+            return false;
+        pos_ += n;
+        return true;
+    }
+
+    value parse_value()
+    {
+        skip_space();
+        if (pos_ >= text_.size())
+            fail("unexpected end");
+
+        value v;
+        char c = text_[pos_];
+        if (c == '{')
+        {
+            ++pos_;
+            v.k = value::kind::object;
+            if (consume('}'))
+                return v;
+            do
+            {
+                skip_space();
+                std::string key = parse_string();
+                expect(':');
+                v.object.emplace_back(std::move(key), parse_value());
+            } while (consume(','));
+            expect('}');
+        }
+        else if (c == '[')
+        {
+            ++pos_;
+            v.k = value::kind::array;
+            if (consume(']'))
+                return v;
+            do
+                v.array.push_back(parse_value());
+            while (consume(','));
+            expect(']');
+        }
+        else if (c == '"')
+        {
+            v.k = value::kind::string;
+            v.string = parse_string();
+        }
+        else if (consume_word("null"))
+        {
+        }
+        else if (consume_word("true"))
+        {
+            v.k = value::kind::boolean;
+            v.number = 1;
+        }
+        else if (consume_word("false"))
+        {
+            v.k = value::kind::boolean;
+        }
+        else
+        {
+            char const* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            v.k = value::kind::number;
+            v.number = std::strtod(begin, &end);
+            if (end == begin)
+                fail("bad value");
+            pos_ += static_cast<std::size_t>(end - begin);
+        }
+        return v;
+    }
+
+    std::string parse_string()
+    {
+        if (pos_ >= text_.size() || text_[pos_] != '"')
+            fail("expected a string");
+        ++pos_;
+        std::string s;
+        while (pos_ < text_.size() && text_[pos_] != '"')
+        {
+            char c = text_[pos_++];
+            if (c != '\\')
+            {
+                s += c;
+                continue;
+            }
+            if (pos_ >= text_.size())
+                break;
+            c = text_[pos_++];
+            switch (c)
+            {
+            case 'n': s += '\n'; break;
+            case 't': s += '\t'; break;
+            case 'r': s += '\r'; break;
+            case 'b': s += '\b'; break;
+            case 'f': s += '\f'; break;
+            case 'u':
+                // Reports only escape control characters
+                if (pos_ + 4 > text_.size())
+                    fail("bad escape");
+                s += static_cast<char>(
+                    std::strtol(text_.substr(pos_, 4).c_str(), nullptr, 16));
+                pos_ += 4;
+                break;
+            default: s += c; break;
+            }
+        }
+        if (pos_ >= text_.size())
+            fail("unterminated string");
+        ++pos_;
+        return s;
+    }
+
+    std::string text_;
+    std::size_t pos_ = 0;
+};
+
+// The figures of one result, by metric name
+using figures = std::map<std::string, double>;
+
+std::string format_param(value const& v)
+{
+    if (v.k == value::kind::string)
+        return v.string;
+    std::ostringstream oss;
+    oss << std::setprecision(15) << v.number;
+    return oss.str();
+}
+
+// Read a report into figures keyed by what was measured
+std::map<std::string, figures>
+load(char const* path, bool ignore_backend)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error(std::string("cannot open ") + path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    value doc = parser(ss.str()).parse();
+
+    std::string suite;
+    if (auto const* s = doc.find("suite"))
+        suite = s->string;
+
+    std::map<std::string, figures> out;
+    auto const* results = doc.find("results");
+    if (!results)
+        return out;
+
+    for (auto const& r : results->array)
+    {
+        std::string key = suite + "/";
+        if (auto const* name = r.find("name"))
+            key += name->string;
+        if (auto const* params = r.find("params"))
+            for (auto const& [k, v] : params->object)
+                key += " " + k + "=" + format_param(v);
+        if (!ignore_backend)
+            if (auto const* backend = r.find("backend"))
+                key += " [" + backend->string + "]";
+
+        figures f;
+        for (auto const& [k, v] : r.object)
+            if (v.k == value::kind::number && k != "rss_bytes")
+                f[k] = v.number;
+        if (auto const* lat = r.find("latency_us"))
+            for (auto const& [k, v] : lat->object)
+                if (k == "p50" || k == "p99")
+                    f["latency_" + k + "_us"] = v.number;
+        out[key] = std::move(f);
+    }
+    return out;
+}
+
+bool higher_is_better(std::string const& metric)
+{
+    auto const n = metric.size();
+    return n >= 8 && metric.compare(n - 8, 8, "_per_sec") == 0;
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name
+              << " [OPTIONS] <baseline.json> <candidate.json>\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --threshold <pct>  Change counted as a regression (default: 5)\n";
+    std::cout << "  --ignore-backend   Match results regardless of backend\n";
+    std::cout << "  --help             Show this help message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    double threshold = 5.0;
+    bool ignore_backend = false;
+    std::vector<char const*> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ignore-backend") == 0)
+        {
+            ignore_backend = true;
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else if (argv[i][0] != '-')
+        {
+            files.push_back(argv[i]);
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (files.size() != 2)
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, figures> baseline;
+    std::map<std::string, figures> candidate;
+    try
+    {
+        baseline = load(files[0], ignore_backend);
+        candidate = load(files[1], ignore_backend);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+
+    int regressions = 0;
+    int compared = 0;
+    for (auto const& [key, base] : baseline)
+    {
+        auto it = candidate.find(key);
+        if (it == candidate.end())
+            continue;
+
+        std::cout << key << "\n";
+        for (auto const& [metric, before] : base)
+        {
+            auto m = it->second.find(metric);
+            if (m == it->second.end() || before == 0)
+                continue;
+            double after = m->second;
+            double change = (after - before) / std::fabs(before) * 100.0;
+            double worse = higher_is_better(metric) ? -change : change;
+            bool regressed = worse > threshold;
+
+            std::cout << "  " << std::left << std::setw(24) << metric
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(16) << before << std::setw(16) << after
+                      << std::setw(9) << std::setprecision(1)
+                      << std::showpos << change << "%" << std::noshowpos
+                      << (regressed ? "  REGRESSION" : "") << "\n";
+            ++compared;
+            if (regressed)
+                ++regressions;
+        }
+    }
+
+    for (auto const& [key, f] : baseline)
+        if (!candidate.count(key))
+            std::cout << "Only in baseline:  " << key << "\n";
+    for (auto const& [key, f] : candidate)
+        if (!baseline.count(key))
+            std::cout << "Only in candidate: " << key << "\n";
+
+    std::cout << std::defaultfloat << "\n" << compared << " figures compared, " << regressions
+              << " regressed beyond " << threshold << "%\n";
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,408 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/corosio/test/mocket.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/test/fuse.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+/*  The cost of the library's own part of a read or a write, with no
+    system call behind it.
+
+      inline   mockets with staged data: the awaitable, the buffer
+               sequence handed over as io_buffer_param, and the
+               virtual call into the implementation, which completes
+               at once without suspending
+      posted   an in-memory stream whose reads suspend until the peer
+               writes, which completes them by posting the reader to
+               the context: adds the suspension, the scheduler queue
+               and the resumption
+
+    Every allocation in the program is counted, by the replacement
+    operator new in count_allocations.cpp. With --check the
+    program fails if the measured loops allocate at all, which is
+    what CI runs to catch allocations creeping into the hot path.
+*/
+
+//------------------------------------------------
+// In-memory stream
+
+/*  One end of an in-memory connection. A write copies into the
+    peer's pending read if there is one, completing it through the
+    reader's executor, and otherwise into the peer's inbox. A read
+    takes from the inbox, or waits for the peer to write.
+*/
+class memory_stream : public corosio::io_stream
+{
+    static constexpr std::size_t max_buffers = 16;
+
+    struct impl : io_stream_impl
+    {
+        impl* peer = nullptr;
+        std::string inbox;
+
+        // The pending read
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+        std::array<capy::mutable_buffer, max_buffers> bufs;
+        std::size_t count = 0;
+        boost::system::error_code* ec = nullptr;
+        std::size_t* bytes = nullptr;
+
+        void release() override
+        {
+            delete this;
+        }
+
+        // Copy into the buffers, returning the bytes copied
+        static std::size_t copy(
+            capy::mutable_buffer const* dst,
+            std::size_t count,
+            char const* src,
+            std::size_t n)
+        {
+            std::size_t done = 0;
+            for (std::size_t i = 0; i < count && done < n; ++i)
+            {
+                auto k = (std::min)(dst[i].size(), n - done);
+                std::memcpy(dst[i].data(), src + done, k);
+                done += k;
+            }
+            return done;
+        }
+
+        bool read_some(
+            std::coroutine_handle<> h_,
+            capy::executor_ref ex_,
+            corosio::io_buffer_param buffers,
+            std::stop_token,
+            boost::system::error_code* ec_,
+            std::size_t* bytes_) override
+        {
+            count = buffers.copy_to(bufs.data(), max_buffers);
+            if (!inbox.empty())
+            {
+                auto n = copy(bufs.data(), count, inbox.data(), inbox.size());
+                inbox.erase(0, n);
+                *ec_ = {};
+                *bytes_ = n;
+                return true;
+            }
+            h = h_;
+            ex = ex_;
+            ec = ec_;
+            bytes = bytes_;
+            return false;
+        }
+
+        bool write_some(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            corosio::io_buffer_param buffers,
+            std::stop_token,
+            boost::system::error_code* ec_,
+            std::size_t* bytes_) override
+        {
+            std::array<capy::mutable_buffer, max_buffers> src;
+            auto n = buffers.copy_to(src.data(), max_buffers);
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto const* p = static_cast<char const*>(src[i].data());
+                auto size = src[i].size();
+                if (peer->h)
+                {
+                    auto k = copy(peer->bufs.data(), peer->count, p, size);
+                    *peer->ec = {};
+                    *peer->bytes = k;
+                    peer->inbox.append(p + k, size - k);
+                    auto reader = std::exchange(peer->h, nullptr);
+                    peer->ex.post(reader);
+                }
+                else
+                {
+                    peer->inbox.append(p, size);
+                }
+                total += size;
+            }
+            *ec_ = {};
+            *bytes_ = total;
+            return true;
+        }
+    };
+
+public:
+    explicit memory_stream(capy::execution_context& ctx)
+        : io_stream(ctx)
+    {
+        impl_ = new impl;
+    }
+
+    ~memory_stream()
+    {
+        if (impl_)
+            impl_->release();
+    }
+
+    // Connect two streams to each other
+    friend void connect(memory_stream& a, memory_stream& b)
+    {
+        auto& ia = *static_cast<impl*>(a.impl_);
+        auto& ib = *static_cast<impl*>(b.impl_);
+        ia.peer = &ib;
+        ib.peer = &ia;
+        ia.inbox.reserve(4096);
+        ib.inbox.reserve(4096);
+    }
+};
+
+//------------------------------------------------
+
+struct measurement
+{
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+};
+
+// Print and record one mode
+measurement report(
+    char const* name,
+    std::size_t buffers,
+    std::size_t ops,
+    double seconds,
+    std::size_t allocs)
+{
+    measurement m;
+    m.ns_per_op = seconds * 1e9 / static_cast<double>(ops);
+    m.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(ops);
+
+    std::cout << "  " << buffers << " buffer(s): " << std::fixed
+              << std::setprecision(1) << m.ns_per_op << " ns/op, "
+              << std::setprecision(3) << m.allocs_per_op << " allocs/op, "
+              << bench::format_rate(static_cast<double>(ops) / seconds) << "\n";
+
+    bench::record(bench::result(name)
+        .param("buffers", buffers)
+        .ops_per_sec(static_cast<double>(ops) / seconds)
+        .metric("ns_per_op", m.ns_per_op)
+        .metric("allocs_per_op", m.allocs_per_op));
+    return m;
+}
+
+// Reads and writes on mockets whose data is staged, in a
+// sequence of `N` buffers
+template<std::size_t N>
+capy::task<> inline_task(
+    corosio::test::mocket& a,
+    corosio::test::mocket& b,
+    int warmup,
+    int iterations,
+    double& seconds,
+    std::size_t& allocs)
+{
+    // Short enough for the staged strings to stay within their small
+    // buffer, so that staging does not allocate
+    std::array<char, 8> storage{};
+    std::array<capy::mutable_buffer, N> bufs;
+    for (std::size_t i = 0; i < N; ++i)
+        bufs[i] = capy::mutable_buffer(
+            storage.data() + i * (storage.size() / N), storage.size() / N);
+    std::string const chunk(storage.size(), 'x');
+
+    bench::stopwatch sw;
+    std::size_t before = 0;
+    for (int i = 0; i < warmup + iterations; ++i)
+    {
+        if (i == warmup)
+        {
+            sw.reset();
+            before = bench::allocation_count();
+        }
+        a.provide(chunk);
+        auto [ec1, n1] = co_await b.read_some(bufs);
+        b.expect(chunk);
+        auto [ec2, n2] = co_await b.write_some(bufs);
+        if (ec1 || ec2)
+        {
+            std::cerr << "    I/O error\n";
+            co_return;
+        }
+    }
+    seconds = sw.elapsed_seconds();
+    allocs = bench::allocation_count() - before;
+}
+
+template<std::size_t N>
+measurement bench_inline(int iterations)
+{
+    corosio::io_context ioc;
+    capy::test::fuse f;
+    auto [m1, m2] = corosio::test::make_mockets(ioc, f);
+
+    double seconds = 0;
+    std::size_t allocs = 0;
+    capy::run_async(ioc.get_executor())(
+        inline_task<N>(m1, m2, iterations / 10, iterations, seconds, allocs));
+    ioc.run();
+
+    // A read and a write per iteration
+    return report("inline", N, 2 * static_cast<std::size_t>(iterations),
+        seconds, allocs);
+}
+
+// Ping-pong over in-memory streams; every read suspends and is
+// resumed from the context's queue
+capy::task<> echo_task(memory_stream& s, int count)
+{
+    std::array<char, 64> buf{};
+    for (int i = 0; i < count; ++i)
+    {
+        auto [ec1, n1] = co_await s.read_some(
+            capy::mutable_buffer(buf.data(), buf.size()));
+        auto [ec2, n2] = co_await s.write_some(
+            capy::const_buffer(buf.data(), n1));
+        if (ec1 || ec2)
+            co_return;
+    }
+}
+
+capy::task<> ping_task(
+    memory_stream& s,
+    int warmup,
+    int iterations,
+    double& seconds,
+    std::size_t& allocs)
+{
+    std::array<char, 64> buf{};
+    bench::stopwatch sw;
+    std::size_t before = 0;
+    for (int i = 0; i < warmup + iterations; ++i)
+    {
+        if (i == warmup)
+        {
+            sw.reset();
+            before = bench::allocation_count();
+        }
+        auto [ec1, n1] = co_await s.write_some(
+            capy::const_buffer(buf.data(), buf.size()));
+        auto [ec2, n2] = co_await s.read_some(
+            capy::mutable_buffer(buf.data(), buf.size()));
+        if (ec1 || ec2)
+            co_return;
+    }
+    seconds = sw.elapsed_seconds();
+    allocs = bench::allocation_count() - before;
+}
+
+measurement bench_posted(int iterations)
+{
+    corosio::io_context ioc;
+    memory_stream a(ioc);
+    memory_stream b(ioc);
+    connect(a, b);
+
+    int const warmup = iterations / 10;
+    double seconds = 0;
+    std::size_t allocs = 0;
+    capy::run_async(ioc.get_executor())(echo_task(b, warmup + iterations));
+    capy::run_async(ioc.get_executor())(
+        ping_task(a, warmup, iterations, seconds, allocs));
+    ioc.run();
+
+    // Two reads and two writes per round trip
+    return report("posted", 1, 4 * static_cast<std::size_t>(iterations),
+        seconds, allocs);
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --iterations <n>   Iterations per test (default: 1000000)\n";
+    std::cout << "  --check            Fail if the measured loops allocate\n";
+    std::cout << "  --json <file>      Write the results as JSON\n";
+    std::cout << "  --help             Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = 1000000;
+    bool check = false;
+    bench::report::get().describe("corosio", "completion_path");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            iterations = (std::max)(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--check") == 0)
+        {
+            check = true;
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Corosio Completion Path Benchmarks\n";
+    std::cout << "========================================\n";
+
+    std::vector<measurement> results;
+
+    bench::print_header("Inline completion (mocket)");
+    results.push_back(bench_inline<1>(iterations));
+    results.push_back(bench_inline<4>(iterations));
+    results.push_back(bench_inline<8>(iterations));
+
+    bench::print_header("Posted completion (in-memory stream)");
+    results.push_back(bench_posted(iterations));
+
+    if (check)
+    {
+        bool allocates = std::any_of(results.begin(), results.end(),
+            [](measurement const& m) { return m.allocs_per_op > 0; });
+        if (allocates)
+        {
+            std::cerr << "\nError: the completion path allocates\n";
+            return 1;
+        }
+    }
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
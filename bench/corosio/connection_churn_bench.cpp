@@ -0,0 +1,404 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/tcp_server.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+namespace urls = boost::urls;
+
+/*  Each cycle is a client that opens a socket, connects, and waits
+    for the server, which accepts the connection and closes it at
+    once. Both sides close with a zero linger, so the connection ends
+    in a reset and leaves nothing in TIME_WAIT to run the loopback
+    out of ports. A cycle therefore costs a socket open, a connect,
+    an accept, registering both descriptors with the reactor, and two
+    closes.
+*/
+
+// Close a socket with a reset rather than a FIN
+void close_reset(corosio::socket& s)
+{
+    try
+    {
+        s.set_linger(true, 0);
+    }
+    catch (boost::system::system_error const&)
+    {
+    }
+    s.close();
+}
+
+// Client side: one connection at a time until the cycles run out
+capy::task<> client_task(
+    corosio::io_context& ioc,
+    corosio::endpoint ep,
+    std::atomic<int>& remaining,
+    std::atomic<int>& failed,
+    bench::histogram& stats)
+{
+    while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0)
+    {
+        bench::stopwatch sw;
+        corosio::socket sock(ioc);
+        sock.open();
+        auto [ec] = co_await sock.connect(ep);
+
+        // The server may have accepted and reset the connection before
+        // the connect completes
+        if (ec && ec != boost::system::errc::connection_reset)
+        {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            sock.close();
+            continue;
+        }
+
+        // Returns when the server's reset arrives
+        if (!ec)
+        {
+            char c;
+            auto [rec, n] = co_await sock.read_some(
+                capy::mutable_buffer(&c, 1));
+            (void)rec;
+            (void)n;
+        }
+        close_reset(sock);
+        stats.add(sw.elapsed_us());
+    }
+}
+
+// Server side over a bare acceptor: a new socket for each connection
+capy::task<> accept_task(
+    corosio::io_context& ioc,
+    corosio::acceptor& acc,
+    int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        corosio::socket peer(ioc);
+        auto [ec] = co_await acc.accept(peer);
+        if (ec)
+            co_return;
+        close_reset(peer);
+    }
+}
+
+// Server side for one of several contexts: accept until closed
+capy::task<> accept_loop(
+    corosio::io_context& ioc,
+    corosio::acceptor& acc)
+{
+    for (;;)
+    {
+        corosio::socket peer(ioc);
+        auto [ec] = co_await acc.accept(peer);
+        if (ec)
+            co_return;
+        close_reset(peer);
+    }
+}
+
+// Server side over tcp_server: pooled workers that reset each connection
+class churn_server : public corosio::tcp_server
+{
+    class worker : public worker_base
+    {
+        corosio::io_context& ctx_;
+        corosio::socket sock_;
+
+    public:
+        explicit worker(corosio::io_context& ctx)
+            : ctx_(ctx)
+            , sock_(ctx)
+        {
+        }
+
+        corosio::socket& socket() override
+        {
+            return sock_;
+        }
+
+        void run(launcher launch) override
+        {
+            launch(ctx_.get_executor(), close_connection());
+        }
+
+        capy::task<> close_connection()
+        {
+            close_reset(sock_);
+            co_return;
+        }
+    };
+
+public:
+    churn_server(corosio::io_context& ctx, int num_workers)
+        : tcp_server(ctx, ctx.get_executor())
+    {
+        wv_.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            wv_.emplace<worker>(ctx);
+    }
+};
+
+// Run the context on a number of threads until it runs out of work
+void run_threads(corosio::io_context& ioc, int num_threads)
+{
+    std::vector<std::thread> runners;
+    for (int t = 1; t < num_threads; ++t)
+        runners.emplace_back([&ioc]() { ioc.run(); });
+    ioc.run();
+    for (auto& t : runners)
+        t.join();
+}
+
+// Start the clients, and report once they and the server are done
+void run_clients(
+    char const* name,
+    corosio::io_context& ioc,
+    corosio::endpoint ep,
+    int num_threads,
+    int connections,
+    int cycles,
+    capy::task<> server_done)
+{
+    std::atomic<int> remaining{cycles};
+    std::atomic<int> failed{0};
+    std::atomic<int> running{connections};
+    std::vector<bench::histogram> stats(connections);
+
+    auto client = [&](int i) -> capy::task<>
+    {
+        co_await client_task(ioc, ep, remaining, failed, stats[i]);
+        if (running.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            co_await std::move(server_done);
+    };
+
+    bench::stopwatch sw;
+    for (int i = 0; i < connections; ++i)
+        capy::run_async(ioc.get_executor())(client(i));
+    run_threads(ioc, num_threads);
+    double elapsed = sw.elapsed_seconds();
+
+    bench::histogram all;
+    for (auto& s : stats)
+        all.merge(s);
+    double rate = static_cast<double>(all.count()) / elapsed;
+
+    std::cout << "  " << num_threads << " thread(s): "
+              << bench::format_rate(rate) << ", p50 "
+              << bench::format_latency(all.p50()) << ", p99 "
+              << bench::format_latency(all.p99());
+    if (failed.load())
+        std::cout << " (" << failed.load() << " failed)";
+    std::cout << "\n";
+
+    bench::record(bench::result(name)
+        .param("threads", num_threads)
+        .param("connections", connections)
+        .param("cycles", cycles)
+        .ops_per_sec(rate)
+        .latency(all));
+}
+
+// Benchmark: churn against a bare acceptor
+void bench_acceptor_churn(int num_threads, int connections, int cycles)
+{
+    corosio::io_context ioc(static_cast<unsigned>(num_threads));
+    corosio::acceptor acc(ioc);
+    acc.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0), 1024);
+
+    // Closed by the last client, which also cancels any accept left
+    // waiting for a connect that failed
+    auto server_done = [](corosio::acceptor& a) -> capy::task<>
+    {
+        a.close();
+        co_return;
+    };
+
+    capy::run_async(ioc.get_executor())(accept_task(ioc, acc, cycles));
+    run_clients("acceptor", ioc, acc.local_endpoint(), num_threads,
+        connections, cycles, server_done(acc));
+}
+
+// Benchmark: churn against a tcp_server and its worker pool
+void bench_server_churn(int num_threads, int connections, int cycles)
+{
+    corosio::io_context ioc(static_cast<unsigned>(num_threads));
+
+    // Find a free port for the server to bind
+    std::uint16_t port = 0;
+    {
+        corosio::acceptor probe(ioc);
+        probe.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0));
+        port = probe.local_endpoint().port();
+        probe.close();
+    }
+
+    churn_server server(ioc, connections);
+    corosio::endpoint ep(urls::ipv4_address::loopback(), port);
+    if (auto ec = server.bind(ep))
+    {
+        std::cerr << "  Bind failed: " << ec.message() << "\n";
+        return;
+    }
+    server.start();
+
+    auto server_done = [](churn_server& s) -> capy::task<>
+    {
+        (void)co_await s.drain(std::chrono::seconds(5));
+    };
+
+    run_clients("tcp_server", ioc, ep, num_threads,
+        connections, cycles, server_done(server));
+}
+
+/*  One listening socket shared by several contexts, each run on a
+    thread of its own with its own accept loop. With exclusive
+    wakeup each connection wakes a single context, where without it
+    every context waiting on the socket would race for it. Compare
+    with the acceptor run on the same number of threads.
+*/
+void bench_shared_churn(int num_contexts, int connections, int cycles)
+{
+    std::vector<std::unique_ptr<corosio::io_context>> servers;
+    std::vector<corosio::acceptor> acceptors;
+    servers.reserve(num_contexts);
+    acceptors.reserve(num_contexts);
+
+    corosio::acceptor::listen_options opts;
+    opts.backlog = 1024;
+    opts.exclusive_wakeup = true;
+    for (int i = 0; i < num_contexts; ++i)
+    {
+        servers.push_back(std::make_unique<corosio::io_context>(1u));
+        auto& acc = acceptors.emplace_back(*servers.back());
+        if (i == 0)
+            acc.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0), opts);
+        else
+            acc.share(acceptors.front());
+    }
+    auto ep = acceptors.front().local_endpoint();
+
+    std::vector<std::thread> runners;
+    for (int i = 0; i < num_contexts; ++i)
+    {
+        capy::run_async(servers[i]->get_executor())(
+            accept_loop(*servers[i], acceptors[i]));
+        runners.emplace_back([&ioc = *servers[i]]() { ioc.run(); });
+    }
+
+    // Each acceptor is closed on its own context, which then runs
+    // out of work
+    auto server_done = [](
+        std::vector<std::unique_ptr<corosio::io_context>>& ctxs,
+        std::vector<corosio::acceptor>& accs) -> capy::task<>
+    {
+        auto close = [](corosio::acceptor& a) -> capy::task<>
+        {
+            a.close();
+            co_return;
+        };
+        for (std::size_t i = 0; i < ctxs.size(); ++i)
+            capy::run_async(ctxs[i]->get_executor())(close(accs[i]));
+        co_return;
+    };
+
+    corosio::io_context clients(static_cast<unsigned>(num_contexts));
+    run_clients("shared_listener", clients, ep, num_contexts,
+        connections, cycles, server_done(servers, acceptors));
+    for (auto& t : runners)
+        t.join();
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --cycles <n>        Connections per test (default: 20000)\n";
+    std::cout << "  --connections <n>   Concurrent clients (default: 16)\n";
+    std::cout << "  --threads <n>       Largest thread count (default: 8)\n";
+    std::cout << "  --json <file>       Write the results as JSON\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int cycles = 20000;
+    int connections = 16;
+    int max_threads = 8;
+    bench::report::get().describe("corosio", "connection_churn");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc)
+        {
+            cycles = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc)
+        {
+            connections = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            max_threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Corosio Connection Churn Benchmarks\n";
+    std::cout << "=========================================\n";
+    std::cout << "  Cycles: " << cycles << ", concurrent clients: "
+              << connections << "\n";
+
+    bench::print_header("Connect/Accept/Close (acceptor)");
+    for (int t = 1; t <= max_threads; t *= 2)
+        bench_acceptor_churn(t, connections, cycles);
+
+    bench::print_header("Connect/Accept/Close (tcp_server)");
+    for (int t = 1; t <= max_threads; t *= 2)
+        bench_server_churn(t, connections, cycles);
+
+    bench::print_header("Connect/Accept/Close (shared listener)");
+    for (int t = 1; t <= max_threads; t *= 2)
+        bench_shared_churn(t, connections, cycles);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
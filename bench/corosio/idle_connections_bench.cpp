@@ -0,0 +1,570 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/tcp_server.hpp>
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+#include <boost/corosio/tls/context.hpp>
+#include <boost/corosio/tls/openssl_stream.hpp>
+#include <boost/corosio/tls/tls_stream.hpp>
+#endif
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+#include "../common/tls_credentials.hpp"
+#endif
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+namespace urls = boost::urls;
+
+/*  Each test opens loopback connection pairs and leaves the server
+    side of every pair waiting to read, the way a server holds
+    connections whose clients have nothing to say. It reports the
+    resident memory added per pair, client and server together, and
+    how long opening and closing them all took.
+
+    A client address can use each ephemeral port once per listening
+    endpoint, so the connections are spread over one listener per
+    connections_per_listener.
+*/
+
+constexpr int connections_per_listener = 20000;
+constexpr int max_connects_in_flight = 256;
+constexpr std::size_t read_buffer_size = 4096;
+
+// Process work until `done` holds
+template<class Pred>
+void run_until(corosio::io_context& ioc, Pred done)
+{
+    while (!done())
+        ioc.run_one();
+    ioc.poll();
+}
+
+// Listening endpoints on free loopback ports, enough for `count`
+std::vector<corosio::endpoint>
+free_endpoints(corosio::io_context& ioc, int count)
+{
+    std::vector<corosio::endpoint> eps;
+    int listeners = (count + connections_per_listener - 1) / connections_per_listener;
+    for (int i = 0; i < listeners; ++i)
+    {
+        corosio::acceptor probe(ioc);
+        probe.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0));
+        eps.push_back(probe.local_endpoint());
+        probe.close();
+    }
+    return eps;
+}
+
+// Connect every client, a bounded number at a time
+void connect_clients(
+    corosio::io_context& ioc,
+    std::vector<corosio::endpoint> const& eps,
+    std::vector<std::unique_ptr<corosio::socket>>& clients,
+    std::atomic<int>& connected,
+    std::atomic<int>& failed)
+{
+    auto next = std::make_shared<std::atomic<std::size_t>>(0);
+    auto connector = [&, next]() -> capy::task<>
+    {
+        for (;;)
+        {
+            auto i = next->fetch_add(1, std::memory_order_relaxed);
+            if (i >= clients.size())
+                co_return;
+            auto& s = *clients[i];
+            s.open();
+            auto [ec] = co_await s.connect(eps[i % eps.size()]);
+            if (ec)
+                failed.fetch_add(1, std::memory_order_relaxed);
+            else
+                connected.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    for (int i = 0; i < max_connects_in_flight; ++i)
+        capy::run_async(ioc.get_executor())(connector());
+}
+
+// Print and record one test
+void report(
+    char const* name,
+    int count,
+    std::size_t before,
+    std::size_t after,
+    double open_seconds,
+    double close_seconds,
+    int failed)
+{
+    std::cout << "  Connections:  " << count;
+    if (failed)
+        std::cout << " (" << failed << " failed)";
+    std::cout << "\n";
+    std::cout << "    Open:       " << std::fixed << std::setprecision(3)
+              << open_seconds << " s ("
+              << bench::format_rate(count / open_seconds) << ")\n";
+    std::cout << "    Close:      " << close_seconds << " s ("
+              << bench::format_rate(count / close_seconds) << ")\n";
+
+    auto result = bench::result(name).param("connections", count);
+    result.metric("open_per_sec", count / open_seconds);
+    result.metric("close_per_sec", count / close_seconds);
+    if (before == 0 || after == 0)
+    {
+        std::cout << "    Resident memory is not available on this platform\n\n";
+    }
+    else
+    {
+        double added = after > before
+            ? static_cast<double>(after - before)
+            : 0.0;
+        std::cout << "    Added:      " << bench::format_bytes(added) << "\n";
+        std::cout << "    Per conn:   " << bench::format_bytes(added / count)
+                  << " (client + server)\n\n";
+        result.metric("bytes_per_connection", added / count);
+    }
+    bench::record(std::move(result));
+}
+
+enum class idle_mode
+{
+    read,   // read_some into a buffer of the connection
+    wait,   // wait for readability, with no buffer
+    leased  // read_leased, which takes a pooled buffer once data arrives
+};
+
+// Server side of one connection: wait for the client to hang up
+capy::task<> idle_task(corosio::socket& s, idle_mode mode)
+{
+    if (mode == idle_mode::read)
+    {
+        std::unique_ptr<char[]> buf(new char[read_buffer_size]);
+        auto [ec, n] = co_await s.read_some(
+            capy::mutable_buffer(buf.get(), read_buffer_size));
+        (void)ec;
+        (void)n;
+    }
+    else if (mode == idle_mode::wait)
+    {
+        auto [ec] = co_await s.wait(corosio::socket::wait_type::read);
+        (void)ec;
+    }
+    else
+    {
+        auto [ec, lease] = co_await s.read_leased();
+        (void)ec;
+    }
+    s.close();
+}
+
+// Accept a listener's share of the connections and start their idle tasks
+capy::task<> accept_task(
+    corosio::io_context& ioc,
+    corosio::acceptor& acc,
+    std::vector<std::unique_ptr<corosio::socket>>& servers,
+    std::atomic<std::size_t>& next,
+    std::atomic<int>& accepted,
+    int share,
+    idle_mode mode)
+{
+    for (int i = 0; i < share; ++i)
+    {
+        auto& s = *servers[next.fetch_add(1, std::memory_order_relaxed)];
+        auto [ec] = co_await acc.accept(s);
+        if (ec)
+            co_return;
+        accepted.fetch_add(1, std::memory_order_relaxed);
+        capy::run_async(ioc.get_executor())(idle_task(s, mode));
+    }
+}
+
+// Benchmark: idle connections over bare sockets
+void bench_sockets(char const* name, int count, idle_mode mode)
+{
+    corosio::io_context ioc(1);
+    auto eps = free_endpoints(ioc, count);
+
+    std::vector<std::unique_ptr<corosio::socket>> clients;
+    std::vector<std::unique_ptr<corosio::socket>> servers;
+    std::vector<corosio::acceptor> acceptors;
+    clients.reserve(count);
+    servers.reserve(count);
+    acceptors.reserve(eps.size());
+    std::atomic<std::size_t> next{0};
+    std::atomic<int> accepted{0};
+    std::atomic<int> connected{0};
+    std::atomic<int> failed{0};
+
+    std::size_t before = bench::resident_memory();
+    bench::stopwatch sw;
+
+    for (int i = 0; i < count; ++i)
+    {
+        clients.push_back(std::make_unique<corosio::socket>(ioc));
+        servers.push_back(std::make_unique<corosio::socket>(ioc));
+    }
+    int const listeners = static_cast<int>(eps.size());
+    for (int i = 0; i < listeners; ++i)
+    {
+        auto& acc = acceptors.emplace_back(ioc);
+        acc.listen(eps[i], 4096);
+        int share = count / listeners + (i < count % listeners ? 1 : 0);
+        capy::run_async(ioc.get_executor())(
+            accept_task(ioc, acc, servers, next, accepted, share, mode));
+    }
+    connect_clients(ioc, eps, clients, connected, failed);
+    run_until(ioc, [&]
+    {
+        return connected.load() + failed.load() == count &&
+            accepted.load() >= connected.load();
+    });
+    double open_seconds = sw.elapsed_seconds();
+    std::size_t after = bench::resident_memory();
+
+    // Hanging up completes the idle tasks, which close the servers
+    sw.reset();
+    for (auto& c : clients)
+        c->close();
+    for (auto& acc : acceptors)
+        acc.close();
+    ioc.run();
+    double close_seconds = sw.elapsed_seconds();
+
+    report(name, count, before, after, open_seconds, close_seconds,
+        failed.load());
+}
+
+// Server over tcp_server: a worker per connection, each reading into
+// a buffer of its own
+class idle_server : public corosio::tcp_server
+{
+    class worker : public worker_base
+    {
+        corosio::io_context& ctx_;
+        corosio::socket sock_;
+        std::atomic<int>& accepted_;
+        std::unique_ptr<char[]> buf_;
+
+    public:
+        worker(corosio::io_context& ctx, std::atomic<int>& accepted)
+            : ctx_(ctx)
+            , sock_(ctx)
+            , accepted_(accepted)
+            , buf_(new char[read_buffer_size])
+        {
+        }
+
+        corosio::socket& socket() override
+        {
+            return sock_;
+        }
+
+        void run(launcher launch) override
+        {
+            accepted_.fetch_add(1, std::memory_order_relaxed);
+            launch(ctx_.get_executor(), session());
+        }
+
+        capy::task<> session()
+        {
+            auto [ec, n] = co_await sock_.read_some(
+                capy::mutable_buffer(buf_.get(), read_buffer_size));
+            (void)ec;
+            (void)n;
+            sock_.close();
+        }
+    };
+
+public:
+    idle_server(
+        corosio::io_context& ctx,
+        int num_workers,
+        std::atomic<int>& accepted)
+        : tcp_server(ctx, ctx.get_executor())
+    {
+        wv_.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            wv_.emplace<worker>(ctx, accepted);
+    }
+};
+
+// Benchmark: idle connections held by tcp_server workers
+void bench_tcp_server(int count)
+{
+    corosio::io_context ioc(1);
+    auto eps = free_endpoints(ioc, count);
+
+    std::vector<std::unique_ptr<corosio::socket>> clients;
+    clients.reserve(count);
+    std::atomic<int> accepted{0};
+    std::atomic<int> connected{0};
+    std::atomic<int> failed{0};
+
+    std::size_t before = bench::resident_memory();
+    bench::stopwatch sw;
+
+    for (int i = 0; i < count; ++i)
+        clients.push_back(std::make_unique<corosio::socket>(ioc));
+    idle_server server(ioc, count, accepted);
+    for (auto const& ep : eps)
+    {
+        if (auto ec = server.bind(ep, corosio::acceptor::listen_options{
+                .backlog = 4096}))
+        {
+            std::cerr << "  Bind failed: " << ec.message() << "\n";
+            return;
+        }
+    }
+    server.start();
+    connect_clients(ioc, eps, clients, connected, failed);
+    run_until(ioc, [&]
+    {
+        return connected.load() + failed.load() == count &&
+            accepted.load() >= connected.load();
+    });
+    double open_seconds = sw.elapsed_seconds();
+    std::size_t after = bench::resident_memory();
+
+    sw.reset();
+    for (auto& c : clients)
+        c->close();
+    auto stop = [](idle_server& s) -> capy::task<>
+    {
+        (void)co_await s.drain(std::chrono::seconds(30));
+    };
+    capy::run_async(ioc.get_executor())(stop(server));
+    ioc.run();
+    double close_seconds = sw.elapsed_seconds();
+
+    report("tcp_server", count, before, after, open_seconds, close_seconds,
+        failed.load());
+}
+
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+namespace tls = boost::corosio::tls;
+
+// Benchmark: idle TLS connections, each server stream waiting to read
+// after the handshake
+void bench_tls_streams(int count)
+{
+    corosio::io_context ioc(1);
+    auto eps = free_endpoints(ioc, count);
+
+    tls::context server_ctx;
+    server_ctx.use_certificate(bench::tls_cert_pem, tls::file_format::pem);
+    server_ctx.use_private_key(bench::tls_key_pem, tls::file_format::pem);
+    tls::context client_ctx;
+    client_ctx.add_certificate_authority(bench::tls_cert_pem);
+    client_ctx.set_verify_mode(tls::verify_mode::peer);
+    client_ctx.set_hostname("localhost");
+
+    // Build the native contexts, which are shared, before measuring
+    {
+        corosio::socket s(ioc);
+        corosio::openssl_stream c(s, client_ctx);
+        corosio::openssl_stream d(s, server_ctx);
+    }
+
+    std::vector<std::unique_ptr<corosio::socket>> clients;
+    std::vector<std::unique_ptr<corosio::socket>> servers;
+    std::vector<std::unique_ptr<corosio::openssl_stream>> client_streams;
+    std::vector<std::unique_ptr<corosio::openssl_stream>> server_streams;
+    std::vector<corosio::acceptor> acceptors;
+    clients.reserve(count);
+    servers.reserve(count);
+    client_streams.reserve(count);
+    server_streams.reserve(count);
+    acceptors.reserve(eps.size());
+    std::atomic<std::size_t> next{0};
+    std::atomic<int> accepted{0};
+    std::atomic<int> connected{0};
+    std::atomic<int> failed{0};
+    std::atomic<int> handshakes{0};
+
+    std::size_t before = bench::resident_memory();
+    bench::stopwatch sw;
+
+    for (int i = 0; i < count; ++i)
+    {
+        clients.push_back(std::make_unique<corosio::socket>(ioc));
+        servers.push_back(std::make_unique<corosio::socket>(ioc));
+    }
+    int const listeners = static_cast<int>(eps.size());
+    for (int i = 0; i < listeners; ++i)
+    {
+        auto& acc = acceptors.emplace_back(ioc);
+        acc.listen(eps[i], 4096);
+        int share = count / listeners + (i < count % listeners ? 1 : 0);
+
+        // Accepted sockets wait for the handshake phase
+        auto accept_only = [&](corosio::acceptor& a, int k) -> capy::task<>
+        {
+            for (int j = 0; j < k; ++j)
+            {
+                auto& s = *servers[next.fetch_add(1, std::memory_order_relaxed)];
+                auto [ec] = co_await a.accept(s);
+                if (ec)
+                    co_return;
+                accepted.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+        capy::run_async(ioc.get_executor())(accept_only(acc, share));
+    }
+    connect_clients(ioc, eps, clients, connected, failed);
+    run_until(ioc, [&]
+    {
+        return connected.load() + failed.load() == count &&
+            accepted.load() >= connected.load();
+    });
+
+    // The two ends of a pair are the client and server of different
+    // indexes, so each side handshakes on its own
+    auto client_side = [](corosio::openssl_stream& s, std::atomic<int>& n)
+        -> capy::task<>
+    {
+        auto [ec] = co_await s.handshake(corosio::tls_stream::client);
+        if (!ec)
+            n.fetch_add(1, std::memory_order_relaxed);
+    };
+    auto server_side = [](corosio::openssl_stream& s) -> capy::task<>
+    {
+        auto [hec] = co_await s.handshake(corosio::tls_stream::server);
+        if (hec)
+            co_return;
+        std::unique_ptr<char[]> buf(new char[read_buffer_size]);
+        auto [ec, n] = co_await s.read_some(
+            capy::mutable_buffer(buf.get(), read_buffer_size));
+        (void)ec;
+        (void)n;
+    };
+    for (int i = 0; i < count; ++i)
+    {
+        client_streams.push_back(
+            std::make_unique<corosio::openssl_stream>(*clients[i], client_ctx));
+        server_streams.push_back(
+            std::make_unique<corosio::openssl_stream>(*servers[i], server_ctx));
+        capy::run_async(ioc.get_executor())(
+            client_side(*client_streams.back(), handshakes));
+        capy::run_async(ioc.get_executor())(
+            server_side(*server_streams.back()));
+    }
+    run_until(ioc, [&]
+    {
+        return handshakes.load() + failed.load() >= connected.load();
+    });
+    double open_seconds = sw.elapsed_seconds();
+    std::size_t after = bench::resident_memory();
+
+    sw.reset();
+    for (auto& c : clients)
+        c->close();
+    for (auto& s : servers)
+        s->close();
+    for (auto& acc : acceptors)
+        acc.close();
+    ioc.run();
+    client_streams.clear();
+    server_streams.clear();
+    double close_seconds = sw.elapsed_seconds();
+
+    report("tls_stream", count, before, after, open_seconds, close_seconds,
+        failed.load() + connected.load() - handshakes.load());
+}
+#endif
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --connections <n>       Connection pairs per test (default: 100000)\n";
+    std::cout << "  --tls-connections <n>   Pairs for the TLS test (default: 10000)\n";
+    std::cout << "  --json <file>           Write the results as JSON\n";
+    std::cout << "  --help                  Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 100000;
+    int tls_count = 10000;
+    bench::report::get().describe("corosio", "idle_connections");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc)
+        {
+            count = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--tls-connections") == 0 && i + 1 < argc)
+        {
+            tls_count = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int fitted = bench::raise_fd_limit((std::max)(count, tls_count));
+    if (fitted < (std::max)(count, tls_count))
+    {
+        std::cout << "Descriptor limit allows " << fitted << " pairs\n";
+        count = (std::min)(count, fitted);
+        tls_count = (std::min)(tls_count, fitted);
+    }
+
+    std::cout << "Boost.Corosio Idle Connection Benchmarks\n";
+    std::cout << "========================================\n";
+
+    bench::print_header("Pending read_some with a 4 KiB buffer");
+    bench_sockets("socket_read", count, idle_mode::read);
+
+    bench::print_header("Pending readiness wait");
+    bench_sockets("socket_wait", count, idle_mode::wait);
+
+    bench::print_header("Pending read_leased (pooled buffers)");
+    bench_sockets("socket_leased", count, idle_mode::leased);
+
+    bench::print_header("tcp_server workers with a 4 KiB buffer");
+    bench_tcp_server(count);
+
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+    bench::print_header("openssl_stream after the handshake");
+    bench_tls_streams(tls_count);
+#endif
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
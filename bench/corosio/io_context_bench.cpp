@@ -9,13 +9,21 @@
 
 #include <boost/corosio/io_context.hpp>
 #include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/strand.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
 #include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/read.hpp>
 #include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
 
 #include <atomic>
+#include <coroutine>
 #include <cstring>
 #include <iostream>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "../common/benchmark.hpp"
@@ -32,6 +40,8 @@ inline const char* default_backend_name()
     return "epoll";
 #elif BOOST_COROSIO_HAS_KQUEUE
     return "kqueue";
+#elif BOOST_COROSIO_HAS_POLL
+    return "poll";
 #elif BOOST_COROSIO_HAS_SELECT
     return "select";
 #else
@@ -51,6 +61,9 @@ inline void print_available_backends()
 #if BOOST_COROSIO_HAS_KQUEUE
     std::cout << "  kqueue   - BSD/macOS kqueue (default)\n";
 #endif
+#if BOOST_COROSIO_HAS_POLL
+    std::cout << "  poll     - POSIX poll (portable)\n";
+#endif
 #if BOOST_COROSIO_HAS_SELECT
     std::cout << "  select   - POSIX select (portable)\n";
 #endif
@@ -82,6 +95,7 @@ void bench_single_threaded_post(int num_handlers)
     int counter = 0;
 
     bench::stopwatch sw;
+    auto allocs_before = bench::allocation_count();
 
     for (int i = 0; i < num_handlers; ++i)
         capy::run_async(ex)(increment_task(counter));
@@ -90,11 +104,19 @@ void bench_single_threaded_post(int num_handlers)
 
     double elapsed = sw.elapsed_seconds();
     double ops_per_sec = static_cast<double>(num_handlers) / elapsed;
+    auto allocs = bench::allocation_count() - allocs_before;
 
     std::cout << "  Handlers:    " << num_handlers << "\n";
     std::cout << "  Elapsed:     " << std::fixed << std::setprecision(3)
               << elapsed << " s\n";
     std::cout << "  Throughput:  " << bench::format_rate(ops_per_sec) << "\n";
+    std::cout << "  Allocations: " << std::setprecision(2)
+              << static_cast<double>(allocs) / num_handlers << " per handler\n";
+
+    bench::record(bench::result("single_threaded_post")
+        .param("handlers", num_handlers)
+        .ops_per_sec(ops_per_sec)
+        .metric("allocs_per_op", static_cast<double>(allocs) / num_handlers));
 
     if (counter != num_handlers)
     {
@@ -103,6 +125,226 @@ void bench_single_threaded_post(int num_handlers)
     }
 }
 
+// Coroutine driven entirely by executor posts, with no task frames
+struct post_loop
+{
+    struct promise_type
+    {
+        post_loop get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename Executor>
+struct post_awaitable
+{
+    Executor ex;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { ex.post(h); }
+    void await_resume() const noexcept {}
+};
+
+template <typename Executor>
+post_loop run_post_loop(Executor ex, int count, int& resumes)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        co_await post_awaitable<Executor>{ex};
+        ++resumes;
+    }
+}
+
+// Benchmark: Post-and-resume cost by concurrency hint
+template <typename Context>
+void bench_post_resume_by_hint(int iterations)
+{
+    bench::print_header("Post and Resume by Concurrency Hint");
+
+    for (unsigned hint : {1u, 2u})
+    {
+        Context ioc(hint);
+        int resumes = 0;
+
+        bench::stopwatch sw;
+        run_post_loop(ioc.get_executor(), iterations, resumes);
+        ioc.run();
+        double elapsed = sw.elapsed_seconds();
+
+        std::cout << "  hint=" << hint << ":  "
+                  << bench::format_latency(elapsed * 1e6 / iterations)
+                  << " per post+resume ("
+                  << bench::format_rate(iterations / elapsed) << ")\n";
+
+        bench::record(bench::result("post_resume")
+            .param("hint", hint)
+            .param("iterations", iterations)
+            .ops_per_sec(iterations / elapsed));
+
+        if (resumes != iterations)
+        {
+            std::cerr << "  ERROR: resume mismatch! Expected " << iterations
+                      << ", got " << resumes << "\n";
+        }
+    }
+}
+
+// Benchmark: Post chains serialized by strands across threads
+template <typename Context>
+void bench_strand_post(int iterations)
+{
+    bench::print_header("Strand Post");
+
+    for (int num_strands : {1, 64})
+    {
+        for (int num_threads : {1, 4})
+        {
+            Context ioc(num_threads);
+            std::vector<corosio::strand> strands;
+            std::vector<int> resumes(num_strands, 0);
+            int per_strand = iterations / num_strands;
+            for (int s = 0; s < num_strands; ++s)
+                strands.emplace_back(ioc.get_executor());
+
+            bench::stopwatch sw;
+            for (int s = 0; s < num_strands; ++s)
+                run_post_loop(strands[s], per_strand, resumes[s]);
+
+            std::vector<std::thread> runners;
+            for (int t = 0; t < num_threads; ++t)
+                runners.emplace_back([&ioc]() { ioc.run(); });
+            for (auto& t : runners)
+                t.join();
+
+            double elapsed = sw.elapsed_seconds();
+            int total = per_strand * num_strands;
+            double ops_per_sec = static_cast<double>(total) / elapsed;
+
+            std::cout << "  " << num_strands << " strand(s), "
+                      << num_threads << " thread(s): "
+                      << bench::format_rate(ops_per_sec) << "\n";
+
+            bench::record(bench::result("strand_post")
+                .param("strands", num_strands)
+                .param("threads", num_threads)
+                .param("iterations", total)
+                .ops_per_sec(ops_per_sec));
+
+            for (int s = 0; s < num_strands; ++s)
+            {
+                if (resumes[s] != per_strand)
+                {
+                    std::cerr << "  ERROR: resume mismatch! Expected "
+                              << per_strand << ", got " << resumes[s] << "\n";
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Subscriber coroutine that counts itself when resumed
+struct subscriber
+{
+    struct promise_type
+    {
+        std::atomic<int>* counter = nullptr;
+
+        subscriber get_return_object() noexcept
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept
+        {
+            counter->fetch_add(1, std::memory_order_relaxed);
+        }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+subscriber make_subscriber(std::atomic<int>& counter)
+{
+    auto s = []() -> subscriber { co_return; }();
+    s.h.promise().counter = &counter;
+    return s;
+}
+
+// Benchmark: Fan-out of one message to many subscribers, posted one
+// by one or as a batch, while runner threads wait for work
+template <typename Context>
+void bench_post_batch(int subscribers, int messages)
+{
+    bench::print_header("Fan-out Post vs Post Batch");
+
+    for (bool batched : {false, true})
+    {
+        Context ioc(4);
+        auto ex = ioc.get_executor();
+        std::atomic<int> counter{0};
+
+        ex.on_work_started();
+        std::vector<std::thread> runners;
+        for (int t = 0; t < 4; ++t)
+            runners.emplace_back([&ioc]() { ioc.run(); });
+
+        std::vector<capy::coro> hs;
+        hs.reserve(subscribers);
+        double posting = 0;
+
+        bench::stopwatch sw;
+        for (int m = 0; m < messages; ++m)
+        {
+            hs.clear();
+            for (int i = 0; i < subscribers; ++i)
+                hs.push_back(make_subscriber(counter).h);
+
+            bench::stopwatch post_sw;
+            if (batched)
+                ex.post_batch(hs);
+            else
+                for (auto h : hs)
+                    ex.post(h);
+            posting += post_sw.elapsed_seconds();
+
+            int const expected = (m + 1) * subscribers;
+            while (counter.load(std::memory_order_relaxed) < expected)
+                std::this_thread::yield();
+        }
+        double elapsed = sw.elapsed_seconds();
+
+        ex.on_work_finished();
+        for (auto& t : runners)
+            t.join();
+
+        int total = subscribers * messages;
+        double ops_per_sec = static_cast<double>(total) / elapsed;
+
+        std::cout << "  " << (batched ? "post_batch: " : "post:       ")
+                  << bench::format_rate(ops_per_sec) << ", "
+                  << bench::format_latency(posting * 1e6 / messages)
+                  << " to post each message\n";
+
+        bench::record(bench::result("post_batch")
+            .param("batched", batched ? 1 : 0)
+            .param("subscribers", subscribers)
+            .param("messages", messages)
+            .ops_per_sec(ops_per_sec));
+
+        if (counter.load() != total)
+        {
+            std::cerr << "  ERROR: counter mismatch! Expected " << total
+                      << ", got " << counter.load() << "\n";
+        }
+    }
+}
+
 // Benchmark: Multi-threaded scaling
 template <typename Context>
 void bench_multithreaded_scaling(int num_handlers, int max_threads)
@@ -149,6 +391,11 @@ void bench_multithreaded_scaling(int num_handlers, int max_threads)
         }
         std::cout << "\n";
 
+        bench::record(bench::result("multithreaded_scaling")
+            .param("handlers", num_handlers)
+            .param("threads", num_threads)
+            .ops_per_sec(ops_per_sec));
+
         if (counter.load() != num_handlers)
         {
             std::cerr << "  ERROR: counter mismatch! Expected " << num_handlers
@@ -192,6 +439,11 @@ void bench_interleaved_post_run(int iterations, int handlers_per_iteration)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("interleaved_post_run")
+        .param("iterations", iterations)
+        .param("handlers_per_iteration", handlers_per_iteration)
+        .ops_per_sec(ops_per_sec));
+
     if (counter != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -237,6 +489,11 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
               << elapsed << " s\n";
     std::cout << "  Throughput:        " << bench::format_rate(ops_per_sec) << "\n";
 
+    bench::record(bench::result("concurrent_post_run")
+        .param("threads", num_threads)
+        .param("handlers_per_thread", handlers_per_thread)
+        .ops_per_sec(ops_per_sec));
+
     if (counter.load() != total_handlers)
     {
         std::cerr << "  ERROR: counter mismatch! Expected " << total_handlers
@@ -244,6 +501,82 @@ void bench_concurrent_post_run(int num_threads, int handlers_per_thread)
     }
 }
 
+#if BOOST_COROSIO_HAS_EPOLL
+// Echo rounds over one socket pair, one readiness event per hop
+capy::task<> echo_rounds_task(
+    corosio::socket& client,
+    corosio::socket& server,
+    int rounds)
+{
+    char buf[64] = {};
+    for (int i = 0; i < rounds; ++i)
+    {
+        auto [ec1, n1] = co_await capy::write(
+            client, capy::const_buffer(buf, sizeof(buf)));
+        if (ec1)
+            co_return;
+        auto [ec2, n2] = co_await capy::read(
+            server, capy::mutable_buffer(buf, sizeof(buf)));
+        if (ec2)
+            co_return;
+    }
+}
+
+// Benchmark: Readiness events harvested per epoll_wait by batch size
+void bench_events_per_syscall(int num_pairs, int rounds)
+{
+    bench::print_header("Events per epoll_wait by Batch Size");
+
+    for (unsigned max_events : {1u, 16u, 64u, 256u})
+    {
+        corosio::epoll_options opts;
+        opts.max_events = max_events;
+        corosio::epoll_context ioc(1, opts);
+
+        std::vector<corosio::socket> clients;
+        std::vector<corosio::socket> servers;
+        clients.reserve(num_pairs);
+        servers.reserve(num_pairs);
+        for (int i = 0; i < num_pairs; ++i)
+        {
+            auto [c, s] = corosio::test::make_local_socket_pair(ioc);
+            clients.push_back(std::move(c));
+            servers.push_back(std::move(s));
+        }
+
+        auto before = ioc.stats();
+        bench::stopwatch sw;
+        for (int i = 0; i < num_pairs; ++i)
+            capy::run_async(ioc.get_executor())(
+                echo_rounds_task(clients[i], servers[i], rounds));
+        ioc.run();
+        double elapsed = sw.elapsed_seconds();
+        auto after = ioc.stats();
+
+        auto polls = after.reactor_polls - before.reactor_polls;
+        auto events = after.events_harvested - before.events_harvested;
+        double per_poll = polls ? static_cast<double>(events) / polls : 0.0;
+        auto ops = static_cast<double>(num_pairs) * rounds;
+
+        std::cout << "  max_events=" << max_events << ":  "
+                  << polls << " polls, "
+                  << per_poll << " events/poll, "
+                  << bench::format_rate(ops / elapsed) << "\n";
+
+        bench::record(bench::result("events_per_syscall")
+            .param("pairs", num_pairs)
+            .param("max_events", max_events)
+            .ops_per_sec(ops / elapsed)
+            .metric("polls", static_cast<double>(polls)));
+
+        for (auto& c : clients)
+            c.close();
+        for (auto& s : servers)
+            s.close();
+    }
+}
+#endif
+
 // Run all benchmarks for a specific context type
 template <typename Context>
 void run_all_benchmarks(const char* backend_name)
@@ -251,6 +584,7 @@ void run_all_benchmarks(const char* backend_name)
     std::cout << "Boost.Corosio io_context Benchmarks\n";
     std::cout << "====================================\n";
     std::cout << "Backend: " << backend_name << "\n\n";
+    bench::report::get().set_backend(backend_name);
 
     // Warm up
     {
@@ -264,9 +598,16 @@ void run_all_benchmarks(const char* backend_name)
 
     // Run benchmarks
     bench_single_threaded_post<Context>(1000000);
+    bench_post_resume_by_hint<Context>(1000000);
+    bench_strand_post<Context>(1000000);
+    bench_post_batch<Context>(10000, 100);
     bench_multithreaded_scaling<Context>(1000000, 8);
     bench_interleaved_post_run<Context>(10000, 100);
     bench_concurrent_post_run<Context>(4, 250000);
+#if BOOST_COROSIO_HAS_EPOLL
+    if constexpr (std::is_same_v<Context, corosio::epoll_context>)
+        bench_events_per_syscall(128, 2000);
+#endif
 
     std::cout << "\nBenchmarks complete.\n";
 }
@@ -277,6 +618,7 @@ void print_usage(const char* program_name)
     std::cout << "Options:\n";
     std::cout << "  --backend <name>   Select I/O backend (default: platform default)\n";
     std::cout << "  --list             List available backends\n";
+    std::cout << "  --json <file>      Write the results as JSON\n";
     std::cout << "  --help             Show this help message\n";
     std::cout << "\n";
     print_available_backends();
@@ -285,10 +627,13 @@ void print_usage(const char* program_name)
 int main(int argc, char* argv[])
 {
     const char* backend = nullptr;
+    bench::report::get().describe("corosio", "io_context");
 
     // Parse command-line arguments
     for (int i = 1; i < argc; ++i)
     {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
         if (std::strcmp(argv[i], "--backend") == 0)
         {
             if (i + 1 < argc)
@@ -334,6 +679,22 @@ int main(int argc, char* argv[])
     }
 #endif
 
+#if BOOST_COROSIO_HAS_KQUEUE
+    if (std::strcmp(backend, "kqueue") == 0)
+    {
+        run_all_benchmarks<corosio::kqueue_context>("kqueue");
+        return 0;
+    }
+#endif
+
+#if BOOST_COROSIO_HAS_POLL
+    if (std::strcmp(backend, "poll") == 0)
+    {
+        run_all_benchmarks<corosio::poll_context>("poll");
+        return 0;
+    }
+#endif
+
 #if BOOST_COROSIO_HAS_SELECT
     if (std::strcmp(backend, "select") == 0)
     {
@@ -0,0 +1,595 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/tcp_server.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/read.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+namespace urls = boost::urls;
+
+/*  A load generator against a small HTTP-like server. Every client
+    connection sends a request and reads the fixed-size response, one
+    request at a time.
+
+    The closed loop sends the next request as soon as the response
+    arrives, which finds the most the server can do but hides queueing:
+    when the server stalls, the clients stop sending too. The open loop
+    sends at a fixed rate instead. A request that could not be sent on
+    schedule because the one before it was late is still timed from
+    when it should have been sent, so a stall counts against every
+    request it delayed rather than only the one it hit.
+*/
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::string_view http_request =
+    "GET /plaintext HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "\r\n";
+
+constexpr std::string_view http_response =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Length: 13\r\n"
+    "Content-Type: text/plain\r\n"
+    "\r\n"
+    "Hello, World!";
+
+struct load_options
+{
+    int connections = 1000;
+    int threads = 1;
+    double seconds = 5.0;
+    std::vector<double> rates;
+};
+
+double to_us(clock_type::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// Server side of one connection: answer each request in the input
+capy::task<> http_session(corosio::socket& s)
+{
+    constexpr std::string_view end_of_head = "\r\n\r\n";
+    std::vector<char> buf(4096);
+    std::size_t used = 0;
+    for (;;)
+    {
+        auto [ec, n] = co_await s.read_some(
+            capy::mutable_buffer(buf.data() + used, buf.size() - used));
+        if (ec)
+            break;
+        used += n;
+
+        std::string_view data(buf.data(), used);
+        std::size_t consumed = 0;
+        for (auto pos = data.find(end_of_head);
+             pos != std::string_view::npos;
+             pos = data.find(end_of_head, consumed))
+        {
+            consumed = pos + end_of_head.size();
+            auto [wec, wn] = co_await capy::write(
+                s, capy::const_buffer(http_response.data(), http_response.size()));
+            if (wec)
+                co_return;
+        }
+
+        // A request that does not fit the buffer is not answered
+        if (consumed == 0 && used == buf.size())
+            break;
+        std::memmove(buf.data(), buf.data() + consumed, used - consumed);
+        used -= consumed;
+    }
+}
+
+// Server over a bare acceptor: a coroutine per connection
+capy::task<> acceptor_serve(
+    corosio::basic_io_context& ctx,
+    corosio::acceptor& acc)
+{
+    for (;;)
+    {
+        auto peer = std::make_unique<corosio::socket>(ctx);
+        auto [ec] = co_await acc.accept(*peer);
+        if (ec)
+            co_return;
+        peer->set_no_delay(true);
+
+        auto session = [](std::unique_ptr<corosio::socket> s) -> capy::task<>
+        {
+            co_await http_session(*s);
+            s->close();
+        };
+        capy::run_async(ctx.get_executor())(session(std::move(peer)));
+    }
+}
+
+// Server over tcp_server: a worker per connection
+class http_server : public corosio::tcp_server
+{
+    class worker : public worker_base
+    {
+        corosio::io_context& ctx_;
+        corosio::socket sock_;
+
+    public:
+        explicit worker(corosio::io_context& ctx)
+            : ctx_(ctx)
+            , sock_(ctx)
+        {
+        }
+
+        corosio::socket& socket() override
+        {
+            return sock_;
+        }
+
+        void run(launcher launch) override
+        {
+            sock_.set_no_delay(true);
+            launch(ctx_.get_executor(), session());
+        }
+
+        capy::task<> session()
+        {
+            co_await http_session(sock_);
+            sock_.close();
+        }
+    };
+
+public:
+    http_server(corosio::io_context& ctx, int num_workers)
+        : tcp_server(ctx, ctx.get_executor())
+    {
+        wv_.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            wv_.emplace<worker>(ctx);
+    }
+};
+
+// One client connection and what it measured
+struct connection
+{
+    corosio::socket sock;
+    bench::histogram latency;
+    std::uint64_t completed = 0;
+
+    explicit connection(capy::execution_context& ctx)
+        : sock(ctx)
+    {
+    }
+};
+
+// Send one request and read its response
+capy::task<bool> exchange(corosio::socket& s)
+{
+    std::array<char, http_response.size()> buf;
+    auto [wec, wn] = co_await capy::write(
+        s, capy::const_buffer(http_request.data(), http_request.size()));
+    if (wec)
+        co_return false;
+    auto [rec, rn] = co_await capy::read(
+        s, capy::mutable_buffer(buf.data(), buf.size()));
+    co_return !rec;
+}
+
+capy::task<> connect_task(
+    connection& c,
+    corosio::endpoint ep,
+    std::atomic<int>& failed)
+{
+    c.sock.open();
+    auto [ec] = co_await c.sock.connect(ep);
+    if (ec)
+    {
+        failed.fetch_add(1, std::memory_order_relaxed);
+        c.sock.close();
+        co_return;
+    }
+    c.sock.set_no_delay(true);
+}
+
+// Closed loop: the next request goes out when the response arrives
+capy::task<> closed_loop_task(connection& c, clock_type::time_point end)
+{
+    while (clock_type::now() < end)
+    {
+        auto sent = clock_type::now();
+        if (!co_await exchange(c.sock))
+            co_return;
+        c.latency.add(to_us(clock_type::now() - sent));
+        ++c.completed;
+    }
+}
+
+// Open loop: requests are due every `interval` from `start`, and each
+// is timed from when it was due
+capy::task<> open_loop_task(
+    capy::execution_context& ctx,
+    connection& c,
+    clock_type::time_point start,
+    clock_type::time_point end,
+    clock_type::duration interval)
+{
+    corosio::timer t(ctx);
+    for (auto due = start; due < end; due += interval)
+    {
+        if (clock_type::now() < due)
+        {
+            t.expires_at(due);
+            auto [ec] = co_await t.wait();
+            if (ec)
+                co_return;
+        }
+        if (!co_await exchange(c.sock))
+            co_return;
+        c.latency.add(to_us(clock_type::now() - due));
+        ++c.completed;
+    }
+}
+
+// Run the context on a number of threads until it runs out of work
+void run_threads(corosio::basic_io_context& ioc, int num_threads)
+{
+    std::vector<std::thread> runners;
+    for (int t = 1; t < num_threads; ++t)
+        runners.emplace_back([&ioc]() { ioc.run(); });
+    ioc.run();
+    for (auto& t : runners)
+        t.join();
+    ioc.restart();
+}
+
+// Print and record one load level, then reset the connections' figures
+double report_level(
+    char const* name,
+    char const* server_kind,
+    std::vector<std::unique_ptr<connection>>& conns,
+    double offered,
+    double elapsed)
+{
+    bench::histogram all;
+    std::uint64_t completed = 0;
+    for (auto& c : conns)
+    {
+        all.merge(c->latency);
+        completed += c->completed;
+        c->latency.clear();
+        c->completed = 0;
+    }
+    double achieved = static_cast<double>(completed) / elapsed;
+
+    std::cout << "  ";
+    if (offered > 0)
+        std::cout << "offered " << bench::format_rate(offered) << ", ";
+    std::cout << "achieved " << bench::format_rate(achieved)
+              << ", p50 " << bench::format_latency(all.p50())
+              << ", p99 " << bench::format_latency(all.p99())
+              << ", p99.9 " << bench::format_latency(all.p999())
+              << ", max " << bench::format_latency((all.max)()) << "\n";
+
+    auto result = bench::result(name)
+        .param("server", std::string(server_kind))
+        .param("connections", static_cast<int>(conns.size()));
+    if (offered > 0)
+        result.param("offered_rate", offered);
+    result.ops_per_sec(achieved).latency(all);
+    bench::record(std::move(result));
+    return achieved;
+}
+
+// Connect the clients, run the closed loop and then each open loop
+// rate, and stop the server
+void run_load(
+    corosio::basic_io_context& server_ctx,
+    corosio::basic_io_context& client_ctx,
+    corosio::endpoint ep,
+    char const* server_kind,
+    load_options const& opt,
+    capy::task<> stop_server)
+{
+    std::vector<std::thread> server_threads;
+    for (int t = 0; t < opt.threads; ++t)
+        server_threads.emplace_back([&server_ctx]() { server_ctx.run(); });
+
+    std::vector<std::unique_ptr<connection>> conns;
+    conns.reserve(opt.connections);
+    std::atomic<int> failed{0};
+    for (int i = 0; i < opt.connections; ++i)
+    {
+        conns.push_back(std::make_unique<connection>(client_ctx));
+        capy::run_async(client_ctx.get_executor())(
+            connect_task(*conns.back(), ep, failed));
+    }
+    run_threads(client_ctx, opt.threads);
+    if (failed.load())
+    {
+        std::cout << "  " << failed.load() << " connects failed\n";
+        std::erase_if(conns, [](auto const& c) { return !c->sock.is_open(); });
+    }
+
+    auto const duration = std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>(opt.seconds));
+
+    bench::print_header("Closed loop");
+    auto end = clock_type::now() + duration;
+    bench::stopwatch sw;
+    for (auto& c : conns)
+        capy::run_async(client_ctx.get_executor())(closed_loop_task(*c, end));
+    run_threads(client_ctx, opt.threads);
+    double peak = report_level(
+        "closed_loop", server_kind, conns, 0, sw.elapsed_seconds());
+
+    // Without rates given, sweep the offered load through the peak
+    std::vector<double> rates = opt.rates;
+    if (rates.empty())
+        for (double f : {0.25, 0.5, 0.75, 0.9, 1.0, 1.1})
+            rates.push_back(peak * f);
+
+    bench::print_header("Open loop");
+    for (double rate : rates)
+    {
+        if (rate <= 0 || conns.empty())
+            continue;
+        auto const n = static_cast<double>(conns.size());
+        auto const interval = (std::max)(
+            std::chrono::duration_cast<clock_type::duration>(
+                std::chrono::duration<double>(n / rate)),
+            clock_type::duration(1));
+
+        // Staggered so the connections' requests do not arrive in bursts
+        auto start = clock_type::now() + std::chrono::milliseconds(10);
+        end = start + duration;
+        sw.reset();
+        for (std::size_t i = 0; i < conns.size(); ++i)
+        {
+            auto offset = interval * static_cast<long long>(i) /
+                static_cast<long long>(conns.size());
+            capy::run_async(client_ctx.get_executor())(open_loop_task(
+                client_ctx, *conns[i], start + offset, end, interval));
+        }
+        run_threads(client_ctx, opt.threads);
+        report_level("open_loop", server_kind, conns, rate, sw.elapsed_seconds());
+    }
+
+    for (auto& c : conns)
+        c->sock.close();
+    capy::run_async(server_ctx.get_executor())(std::move(stop_server));
+    for (auto& t : server_threads)
+        t.join();
+}
+
+// Run the load on one backend. The server is a tcp_server on the
+// platform's default context, which tcp_server requires, and a bare
+// acceptor on the others.
+template<class Context>
+void run_backend(char const* backend_name, load_options const& opt)
+{
+    std::cout << "Backend: " << backend_name << "\n";
+    bench::report::get().set_backend(backend_name);
+
+    Context server_ctx(static_cast<unsigned>(opt.threads));
+    Context client_ctx(static_cast<unsigned>(opt.threads));
+
+    // Deep enough for every client to connect at once
+    int const backlog = (std::max)(opt.connections, 128);
+
+    if constexpr (std::is_same_v<Context, corosio::io_context>)
+    {
+        corosio::endpoint ep;
+        {
+            corosio::acceptor probe(server_ctx);
+            probe.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0));
+            ep = probe.local_endpoint();
+            probe.close();
+        }
+
+        http_server server(server_ctx, opt.connections);
+        if (auto ec = server.bind(ep, corosio::acceptor::listen_options{
+                .backlog = backlog}))
+        {
+            std::cerr << "  Bind failed: " << ec.message() << "\n";
+            return;
+        }
+        server.start();
+
+        auto stop = [](http_server& s) -> capy::task<>
+        {
+            (void)co_await s.drain(std::chrono::seconds(5));
+        };
+        run_load(server_ctx, client_ctx, ep, "tcp_server", opt, stop(server));
+    }
+    else
+    {
+        corosio::acceptor acc(server_ctx);
+        acc.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0), backlog);
+        capy::run_async(server_ctx.get_executor())(acceptor_serve(server_ctx, acc));
+
+        auto stop = [](corosio::acceptor& a) -> capy::task<>
+        {
+            a.close();
+            co_return;
+        };
+        run_load(server_ctx, client_ctx, acc.local_endpoint(), "acceptor",
+            opt, stop(acc));
+    }
+}
+
+// Parse a comma-separated list of rates
+std::vector<double> parse_rates(char const* text)
+{
+    std::vector<double> rates;
+    char* end = nullptr;
+    for (char const* p = text; *p; p = end)
+    {
+        rates.push_back(std::strtod(p, &end));
+        if (end == p)
+            break;
+        if (*end == ',')
+            ++end;
+    }
+    return rates;
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --backend <name>      Select I/O backend (default: platform default)\n";
+    std::cout << "  --connections <n>     Client connections (default: 1000)\n";
+    std::cout << "  --threads <n>         Threads for each of client and server (default: 1)\n";
+    std::cout << "  --seconds <s>         Duration of each load level (default: 5)\n";
+    std::cout << "  --rates <r1,r2,...>   Open loop rates in requests/s\n";
+    std::cout << "                        (default: fractions of the closed loop rate)\n";
+    std::cout << "  --json <file>         Write the results as JSON\n";
+    std::cout << "  --help                Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    char const* backend = nullptr;
+    load_options opt;
+    bench::report::get().describe("corosio", "load");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc)
+        {
+            backend = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc)
+        {
+            opt.connections = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            opt.threads = (std::max)(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            opt.seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--rates") == 0 && i + 1 < argc)
+        {
+            opt.rates = parse_rates(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int fitted = bench::raise_fd_limit(opt.connections);
+    if (fitted < opt.connections)
+    {
+        std::cout << "Descriptor limit allows " << fitted << " connections\n";
+        opt.connections = fitted;
+    }
+
+    std::cout << "Boost.Corosio Request/Response Load Benchmarks\n";
+    std::cout << "==============================================\n";
+    std::cout << "  Connections: " << opt.connections << ", threads: "
+              << opt.threads << ", " << opt.seconds << " s per level\n";
+
+    if (!backend)
+    {
+        run_backend<corosio::io_context>("default", opt);
+        std::cout << "\nBenchmarks complete.\n";
+        return 0;
+    }
+
+    bool found = false;
+#if BOOST_COROSIO_HAS_IO_URING
+    if (std::strcmp(backend, "io_uring") == 0)
+    {
+        run_backend<corosio::io_uring_context>("io_uring", opt);
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_EPOLL
+    if (std::strcmp(backend, "epoll") == 0)
+    {
+        run_backend<corosio::epoll_context>("epoll", opt);
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_KQUEUE
+    if (std::strcmp(backend, "kqueue") == 0)
+    {
+        run_backend<corosio::kqueue_context>("kqueue", opt);
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_POLL
+    if (std::strcmp(backend, "poll") == 0)
+    {
+        run_backend<corosio::poll_context>("poll", opt);
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+    if (std::strcmp(backend, "select") == 0)
+    {
+        run_backend<corosio::select_context>("select", opt);
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_IOCP
+    if (std::strcmp(backend, "iocp") == 0)
+    {
+        run_backend<corosio::iocp_context>("iocp", opt);
+        found = true;
+    }
+#endif
+
+    if (!found)
+    {
+        std::cerr << "Error: Backend '" << backend << "' is not available on this platform.\n";
+        return 1;
+    }
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
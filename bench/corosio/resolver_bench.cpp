@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/resolver.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+/*  Each client resolves the same query in a loop until the resolves
+    run out. Three queries cover the ways a resolve completes:
+
+    - "localhost" goes to getaddrinfo on the resolver's worker
+      threads (or GetAddrInfoExW on Windows), then back to the
+      context, so it measures the hand-off as much as the lookup.
+    - A numeric host with numeric_host and numeric_service is parsed
+      without a lookup, the fast path for addresses from config.
+    - "localhost" again with the context's cache enabled, which
+      completes without suspending once the first lookup fills it.
+      The cache is POSIX only; on Windows this repeats the first.
+
+    The context runs on one thread. The threads the resolver started
+    are reported with each result, as the rise in the process's
+    thread count since before the first resolve.
+*/
+
+struct query
+{
+    char const* name;
+    char const* host;
+    char const* service;
+    corosio::resolve_flags flags;
+    bool cached;
+};
+
+query const queries[] = {
+    {"localhost", "localhost", "80", corosio::resolve_flags::none, false},
+    {"numeric", "127.0.0.1", "80",
+        corosio::resolve_flags::numeric_host |
+        corosio::resolve_flags::numeric_service, false},
+    {"cached", "localhost", "80", corosio::resolve_flags::none, true},
+};
+
+// One client: resolve until the count runs out
+capy::task<> client_task(
+    corosio::io_context& ioc,
+    query const& q,
+    std::atomic<int>& remaining,
+    std::atomic<int>& failed,
+    bench::histogram& stats)
+{
+    corosio::resolver r(ioc);
+    while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0)
+    {
+        bench::stopwatch sw;
+        auto [ec, results] = co_await r.resolve(q.host, q.service, q.flags);
+        if (ec || results.empty())
+        {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        stats.add(sw.elapsed_us());
+    }
+}
+
+// Benchmark: resolves per second for one query and concurrency
+void bench_resolve(query const& q, int concurrency, int count)
+{
+    corosio::io_context ioc;
+    if (q.cached)
+    {
+        corosio::resolver_cache_options opts;
+        opts.max_entries = 1024;
+        corosio::set_resolver_cache(ioc, opts);
+    }
+
+    std::size_t const threads_before = bench::thread_count();
+    std::atomic<int> remaining{count};
+    std::atomic<int> failed{0};
+    std::vector<bench::histogram> stats(concurrency);
+
+    bench::stopwatch sw;
+    for (int i = 0; i < concurrency; ++i)
+        capy::run_async(ioc.get_executor())(
+            client_task(ioc, q, remaining, failed, stats[i]));
+    ioc.run();
+    double elapsed = sw.elapsed_seconds();
+
+    // The workers stay idle in the pool until the context is destroyed
+    std::size_t const threads_after = bench::thread_count();
+    std::size_t const spawned = threads_after > threads_before
+        ? threads_after - threads_before : 0;
+
+    bench::histogram all;
+    for (auto& s : stats)
+        all.merge(s);
+    double rate = static_cast<double>(all.count()) / elapsed;
+
+    std::cout << "  " << concurrency << " concurrent: "
+              << bench::format_rate(rate) << ", p50 "
+              << bench::format_latency(all.p50()) << ", p99 "
+              << bench::format_latency(all.p99()) << ", p99.9 "
+              << bench::format_latency(all.p999());
+    if (threads_before)
+        std::cout << ", " << spawned << " thread(s) started";
+    if (failed.load())
+        std::cout << " (" << failed.load() << " failed)";
+    std::cout << "\n";
+
+    auto r = bench::result(q.name);
+    r.param("concurrency", concurrency)
+        .param("count", count)
+        .ops_per_sec(rate)
+        .latency(all);
+    if (threads_before)
+        r.metric("threads_started", static_cast<double>(spawned));
+    bench::record(std::move(r));
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --count <n>         Resolves per test (default: 20000)\n";
+    std::cout << "  --concurrency <n>   Largest number of clients (default: 64)\n";
+    std::cout << "  --json <file>       Write the results as JSON\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int count = 20000;
+    int max_concurrency = 64;
+    bench::report::get().describe("corosio", "resolver");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+        {
+            count = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--concurrency") == 0 && i + 1 < argc)
+        {
+            max_concurrency = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Corosio Resolver Benchmarks\n";
+    std::cout << "=================================\n";
+    std::cout << "  Resolves per test: " << count << "\n";
+
+    for (auto const& q : queries)
+    {
+        std::string header = std::string("Resolve (") + q.name + ")";
+        bench::print_header(header.c_str());
+        for (int c = 1; c <= max_concurrency; c *= 4)
+            bench_resolve(q, c, count);
+    }
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -0,0 +1,397 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/io_context_pool.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/read.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+/*  The same socket workload, ping-pong over loopback pairs, run on
+    a number of threads under each way of spreading work over them:
+
+      shared       one io_context run by every thread
+      per_thread   an io_context per thread, each run by its thread
+      pool         an io_context_pool with a shard per thread
+      affine       like shared, on an epoll_context with completion
+                   affinity, so completions stay on the thread that
+                   started the operation (Linux only)
+
+    Each thread gets the same number of pairs, so with perfect scaling
+    the throughput grows with the threads and the latency stays put.
+*/
+
+using clock_type = std::chrono::steady_clock;
+
+struct scaling_options
+{
+    int max_threads = 0;
+    int pairs_per_thread = 16;
+    std::size_t message_size = 64;
+    double seconds = 2.0;
+    bool pin = false;
+};
+
+// What one layout measured at one thread count
+struct scaling_point
+{
+    double rate = 0;
+    double p99 = 0;
+};
+
+// One socket pair and what its ping-pong measured
+struct pair_state
+{
+    corosio::socket client;
+    corosio::socket server;
+    bench::histogram latency;
+
+    explicit pair_state(std::pair<corosio::socket, corosio::socket> p)
+        : client(std::move(p.first))
+        , server(std::move(p.second))
+    {
+        client.set_no_delay(true);
+        server.set_no_delay(true);
+    }
+};
+
+// Round trips on one pair until `end`
+capy::task<> pingpong_task(
+    pair_state& p,
+    std::size_t message_size,
+    clock_type::time_point end)
+{
+    std::vector<char> send_buf(message_size, 'P');
+    std::vector<char> recv_buf(message_size);
+
+    while (clock_type::now() < end)
+    {
+        bench::stopwatch sw;
+        auto [ec1, n1] = co_await capy::write(
+            p.client, capy::const_buffer(send_buf.data(), send_buf.size()));
+        if (ec1)
+            co_return;
+        auto [ec2, n2] = co_await capy::read(
+            p.server, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec2)
+            co_return;
+        auto [ec3, n3] = co_await capy::write(
+            p.server, capy::const_buffer(recv_buf.data(), n2));
+        if (ec3)
+            co_return;
+        auto [ec4, n4] = co_await capy::read(
+            p.client, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec4)
+            co_return;
+        p.latency.add(sw.elapsed_us());
+    }
+}
+
+// Make the pairs of one context
+void add_pairs(
+    corosio::basic_io_context& ioc,
+    int count,
+    std::vector<std::unique_ptr<pair_state>>& pairs)
+{
+    for (int i = 0; i < count; ++i)
+        pairs.push_back(std::make_unique<pair_state>(
+            corosio::test::make_socket_pair(ioc)));
+}
+
+// Print and record one layout at one thread count
+scaling_point report_point(
+    char const* layout,
+    int threads,
+    scaling_options const& opt,
+    std::vector<std::unique_ptr<pair_state>>& pairs,
+    double elapsed)
+{
+    bench::histogram all;
+    for (auto& p : pairs)
+    {
+        all.merge(p->latency);
+        p->client.close();
+        p->server.close();
+    }
+
+    scaling_point pt;
+    pt.rate = static_cast<double>(all.count()) / elapsed;
+    pt.p99 = all.p99();
+
+    std::cout << "  " << std::setw(3) << threads << " thread(s): "
+              << bench::format_rate(pt.rate) << ", p50 "
+              << bench::format_latency(all.p50()) << ", p99 "
+              << bench::format_latency(pt.p99) << "\n";
+
+    bench::record(bench::result(layout)
+        .param("threads", threads)
+        .param("pairs", static_cast<int>(pairs.size()))
+        .param("message_size", opt.message_size)
+        .ops_per_sec(pt.rate)
+        .latency(all));
+    return pt;
+}
+
+// Start every pair's ping-pong on its own context
+void start_pairs(
+    std::vector<std::unique_ptr<pair_state>>& pairs,
+    std::vector<corosio::basic_io_context*> const& owners,
+    scaling_options const& opt)
+{
+    auto const end = clock_type::now() +
+        std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>(opt.seconds));
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+        capy::run_async(owners[i]->get_executor())(
+            pingpong_task(*pairs[i], opt.message_size, end));
+}
+
+// Run one context on every thread
+scaling_point run_shared(
+    corosio::basic_io_context& ioc,
+    char const* layout,
+    int threads,
+    scaling_options const& opt)
+{
+    std::vector<std::unique_ptr<pair_state>> pairs;
+    add_pairs(ioc, threads * opt.pairs_per_thread, pairs);
+    std::vector<corosio::basic_io_context*> owners(pairs.size(), &ioc);
+
+    bench::stopwatch sw;
+    start_pairs(pairs, owners, opt);
+    std::vector<std::thread> runners;
+    for (int t = 1; t < threads; ++t)
+        runners.emplace_back([&ioc]() { ioc.run(); });
+    ioc.run();
+    for (auto& t : runners)
+        t.join();
+
+    return report_point(layout, threads, opt, pairs, sw.elapsed_seconds());
+}
+
+// Layout: one context run by every thread
+scaling_point bench_shared(int threads, scaling_options const& opt)
+{
+    corosio::io_context ioc(static_cast<unsigned>(threads));
+    return run_shared(ioc, "shared", threads, opt);
+}
+
+#if BOOST_COROSIO_HAS_EPOLL
+// Layout: one context run by every thread, with completion affinity
+scaling_point bench_affine(int threads, scaling_options const& opt)
+{
+    corosio::epoll_options eo;
+    eo.completion_affinity = true;
+    corosio::epoll_context ioc(static_cast<unsigned>(threads), eo);
+    return run_shared(ioc, "affine", threads, opt);
+}
+#endif
+
+// Layout: a context per thread
+scaling_point bench_per_thread(int threads, scaling_options const& opt)
+{
+    std::vector<std::unique_ptr<corosio::io_context>> contexts;
+    std::vector<std::unique_ptr<pair_state>> pairs;
+    std::vector<corosio::basic_io_context*> owners;
+    for (int t = 0; t < threads; ++t)
+    {
+        contexts.push_back(std::make_unique<corosio::io_context>(1));
+        add_pairs(*contexts.back(), opt.pairs_per_thread, pairs);
+        owners.resize(pairs.size(), contexts.back().get());
+    }
+
+    bench::stopwatch sw;
+    start_pairs(pairs, owners, opt);
+    std::vector<std::thread> runners;
+    for (int t = 1; t < threads; ++t)
+        runners.emplace_back([&ioc = *contexts[t]]() { ioc.run(); });
+    contexts[0]->run();
+    for (auto& t : runners)
+        t.join();
+
+    return report_point("per_thread", threads, opt, pairs, sw.elapsed_seconds());
+}
+
+// Layout: an io_context_pool with a shard per thread
+scaling_point bench_pool(int threads, scaling_options const& opt)
+{
+    corosio::io_context_pool pool(
+        static_cast<std::size_t>(threads),
+        opt.pin ? corosio::io_context_pool::affinity::per_core
+                : corosio::io_context_pool::affinity::none);
+    std::vector<std::unique_ptr<pair_state>> pairs;
+    std::vector<corosio::basic_io_context*> owners;
+    for (std::size_t s = 0; s < pool.size(); ++s)
+    {
+        add_pairs(pool.get_context(s), opt.pairs_per_thread, pairs);
+        owners.resize(pairs.size(), &pool.get_context(s));
+    }
+
+    bench::stopwatch sw;
+    start_pairs(pairs, owners, opt);
+    pool.start();
+    pool.join();
+
+    return report_point("pool", threads, opt, pairs, sw.elapsed_seconds());
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --max-threads <n>   Largest thread count (default: cores, at most 64)\n";
+    std::cout << "  --pairs <n>         Socket pairs per thread (default: 16)\n";
+    std::cout << "  --size <bytes>      Message size (default: 64)\n";
+    std::cout << "  --seconds <s>       Duration of each run (default: 2)\n";
+    std::cout << "  --pin               Pin the pool's threads to cores\n";
+    std::cout << "  --json <file>       Write the results as JSON\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    scaling_options opt;
+    bench::report::get().describe("corosio", "scaling");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc)
+        {
+            opt.max_threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--pairs") == 0 && i + 1 < argc)
+        {
+            opt.pairs_per_thread = (std::max)(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+        {
+            opt.message_size = static_cast<std::size_t>(
+                (std::max)(1, std::atoi(argv[++i])));
+        }
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            opt.seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--pin") == 0)
+        {
+            opt.pin = true;
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.max_threads <= 0)
+        opt.max_threads = (std::min)(64,
+            (std::max)(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+    // Counts double up to the largest, which is always included
+    std::vector<int> counts;
+    for (int t = 1; t < opt.max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(opt.max_threads);
+
+    int fitted = bench::raise_fd_limit(opt.max_threads * opt.pairs_per_thread);
+    if (fitted < opt.max_threads * opt.pairs_per_thread)
+        opt.pairs_per_thread = (std::max)(1, fitted / opt.max_threads);
+
+    std::cout << "Boost.Corosio Multi-Core Scaling Benchmarks\n";
+    std::cout << "===========================================\n";
+    std::cout << "  Pairs per thread: " << opt.pairs_per_thread
+              << ", message size: " << opt.message_size << " bytes, "
+              << opt.seconds << " s per run\n";
+
+    std::vector<scaling_point> shared;
+    std::vector<scaling_point> per_thread;
+    std::vector<scaling_point> pool;
+    std::vector<scaling_point> affine;
+
+    bench::print_header("One io_context, N threads");
+    for (int t : counts)
+        shared.push_back(bench_shared(t, opt));
+
+#if BOOST_COROSIO_HAS_EPOLL
+    bench::print_header("One epoll_context with completion affinity, N threads");
+    for (int t : counts)
+        affine.push_back(bench_affine(t, opt));
+#endif
+
+    bench::print_header("N io_contexts, one thread each");
+    for (int t : counts)
+        per_thread.push_back(bench_per_thread(t, opt));
+
+    bench::print_header(opt.pin
+        ? "io_context_pool, N shards pinned to cores"
+        : "io_context_pool, N shards");
+    for (int t : counts)
+        pool.push_back(bench_pool(t, opt));
+
+    // Side by side, with the speedup over one thread of the same layout
+    std::vector<std::pair<char const*, std::vector<scaling_point> const*>>
+        layouts = {{"shared", &shared}, {"per_thread", &per_thread},
+                   {"pool", &pool}};
+    if (!affine.empty())
+        layouts.push_back({"affine", &affine});
+
+    bench::print_header("Summary (round trips/s, speedup, p99)");
+    std::cout << "  threads";
+    for (auto const& [name, points] : layouts)
+        std::cout << std::setw(30) << name;
+    std::cout << "\n";
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        std::cout << "  " << std::setw(7) << counts[i];
+        for (auto const& [name, layout] : layouts)
+        {
+            auto const& pt = (*layout)[i];
+            auto const base = (*layout)[0].rate;
+            std::ostringstream cell;
+            cell << bench::format_rate(pt.rate) << " x" << std::fixed
+                 << std::setprecision(1) << (base > 0 ? pt.rate / base : 0)
+                 << " " << bench::format_latency(pt.p99);
+            std::cout << std::setw(30) << cell.str();
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
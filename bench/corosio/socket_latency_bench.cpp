@@ -8,6 +8,7 @@
 //
 
 #include <boost/corosio/io_context.hpp>
+#include <boost/corosio/detail/platform.hpp>
 #include <boost/corosio/socket.hpp>
 #include <boost/corosio/test/socket_pair.hpp>
 #include <boost/capy/buffers.hpp>
@@ -15,7 +16,11 @@
 #include <boost/capy/read.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/capy/write.hpp>
+#include <boost/system/system_error.hpp>
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -30,7 +35,7 @@ capy::task<> pingpong_task(
     corosio::socket& server,
     std::size_t message_size,
     int iterations,
-    bench::statistics& stats)
+    bench::histogram& stats)
 {
     std::vector<char> send_buf(message_size, 'P');
     std::vector<char> recv_buf(message_size);
@@ -81,44 +86,54 @@ capy::task<> pingpong_task(
 }
 
 // Benchmark: Ping-pong latency measurement
-void bench_pingpong_latency(std::size_t message_size, int iterations)
+void bench_pingpong_latency(
+    corosio::basic_io_context& ioc,
+    std::size_t message_size,
+    int iterations)
 {
     std::cout << "  Message size: " << message_size << " bytes, ";
     std::cout << "Iterations: " << iterations << "\n";
 
-    corosio::io_context ioc;
     auto [client, server] = corosio::test::make_socket_pair(ioc);
 
     // Disable Nagle's algorithm for low latency
     client.set_no_delay(true);
     server.set_no_delay(true);
 
-    bench::statistics latency_stats;
+    bench::histogram latency_stats;
 
     capy::run_async(ioc.get_executor())(
         pingpong_task(client, server, message_size, iterations, latency_stats));
     ioc.run();
+    ioc.restart();
 
     bench::print_latency_stats(latency_stats, "Round-trip latency");
     std::cout << "\n";
 
+    bench::record(bench::result("pingpong")
+        .param("message_size", message_size)
+        .param("iterations", iterations)
+        .latency(latency_stats));
+
     client.close();
     server.close();
 }
 
 // Benchmark: Multiple concurrent socket pairs
-void bench_concurrent_latency(int num_pairs, std::size_t message_size, int iterations)
+void bench_concurrent_latency(
+    corosio::basic_io_context& ioc,
+    int num_pairs,
+    std::size_t message_size,
+    int iterations)
 {
     std::cout << "  Concurrent pairs: " << num_pairs << ", ";
     std::cout << "Message size: " << message_size << " bytes, ";
     std::cout << "Iterations: " << iterations << "\n";
 
-    corosio::io_context ioc;
-
     // Store sockets and stats separately for safe reference passing
     std::vector<corosio::socket> clients;
     std::vector<corosio::socket> servers;
-    std::vector<bench::statistics> stats(num_pairs);
+    std::vector<bench::histogram> stats(num_pairs);
 
     clients.reserve(num_pairs);
     servers.reserve(num_pairs);
@@ -141,6 +156,7 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
     }
 
     ioc.run();
+    ioc.restart();
 
     std::cout << "  Per-pair results:\n";
     for (int i = 0; i < num_pairs && i < 3; ++i)
@@ -156,15 +172,25 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
     // Calculate average across all pairs
     double total_mean = 0;
     double total_p99 = 0;
+    bench::histogram all;
     for (auto& s : stats)
     {
         total_mean += s.mean();
         total_p99 += s.p99();
+        all.merge(s);
     }
     std::cout << "  Average mean latency: "
               << bench::format_latency(total_mean / num_pairs) << "\n";
     std::cout << "  Average p99 latency:  "
-              << bench::format_latency(total_p99 / num_pairs) << "\n\n";
+              << bench::format_latency(total_p99 / num_pairs) << "\n";
+    bench::print_latency_stats(all, "All pairs");
+    std::cout << "\n";
+
+    bench::record(bench::result("concurrent_pairs")
+        .param("pairs", num_pairs)
+        .param("message_size", message_size)
+        .param("iterations", iterations)
+        .latency(all));
 
     for (auto& c : clients)
         c.close();
@@ -172,10 +198,308 @@ void bench_concurrent_latency(int num_pairs, std::size_t message_size, int itera
         s.close();
 }
 
-int main()
+// Split-message ping-pong: each side writes a header and then a body
+// as two writes, as a protocol encoder does. The client measures the
+// round trip.
+capy::task<> split_client_task(
+    corosio::socket& client,
+    std::size_t header_size,
+    std::size_t body_size,
+    int iterations,
+    bench::histogram& stats)
 {
-    std::cout << "Boost.Corosio Socket Latency Benchmarks\n";
-    std::cout << "=======================================\n";
+    std::vector<char> header(header_size, 'H');
+    std::vector<char> body(body_size, 'B');
+    std::vector<char> recv_buf(header_size + body_size);
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        bench::stopwatch sw;
+
+        auto [ec1, n1] = co_await capy::write(
+            client, capy::const_buffer(header.data(), header.size()));
+        if (ec1)
+        {
+            std::cerr << "    Write error: " << ec1.message() << "\n";
+            co_return;
+        }
+
+        auto [ec2, n2] = co_await capy::write(
+            client, capy::const_buffer(body.data(), body.size()));
+        if (ec2)
+        {
+            std::cerr << "    Write error: " << ec2.message() << "\n";
+            co_return;
+        }
+
+        auto [ec3, n3] = co_await capy::read(
+            client, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec3)
+        {
+            std::cerr << "    Client read error: " << ec3.message() << "\n";
+            co_return;
+        }
+
+        stats.add(sw.elapsed_us());
+    }
+}
+
+capy::task<> split_server_task(
+    corosio::socket& server,
+    std::size_t header_size,
+    std::size_t body_size,
+    int iterations)
+{
+    std::vector<char> recv_buf(header_size + body_size);
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto [ec1, n1] = co_await capy::read(
+            server, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec1)
+        {
+            std::cerr << "    Server read error: " << ec1.message() << "\n";
+            co_return;
+        }
+
+        auto [ec2, n2] = co_await capy::write(
+            server, capy::const_buffer(recv_buf.data(), header_size));
+        if (ec2)
+        {
+            std::cerr << "    Server write error: " << ec2.message() << "\n";
+            co_return;
+        }
+
+        auto [ec3, n3] = co_await capy::write(
+            server, capy::const_buffer(recv_buf.data() + header_size, body_size));
+        if (ec3)
+        {
+            std::cerr << "    Server write error: " << ec3.message() << "\n";
+            co_return;
+        }
+    }
+}
+
+// Benchmark: Split-message ping-pong, with and without write coalescing
+void bench_split_pingpong_latency(
+    corosio::basic_io_context& ioc,
+    std::size_t header_size,
+    std::size_t body_size,
+    int iterations,
+    bool coalesce)
+{
+    std::cout << "  Header: " << header_size << " bytes, ";
+    std::cout << "Body: " << body_size << " bytes, ";
+    std::cout << "Coalescing: " << (coalesce ? "on" : "off") << "\n";
+
+    auto [client, server] = corosio::test::make_socket_pair(ioc);
+
+    // Disable Nagle's algorithm, so each write is a segment unless coalesced
+    client.set_no_delay(true);
+    server.set_no_delay(true);
+
+    if (coalesce)
+    {
+        try
+        {
+            client.set_write_coalescing(true);
+            server.set_write_coalescing(true);
+        }
+        catch (boost::system::system_error const& e)
+        {
+            std::cout << "  Skipped: " << e.code().message() << "\n\n";
+            client.close();
+            server.close();
+            return;
+        }
+    }
+
+    bench::histogram latency_stats;
+
+    capy::run_async(ioc.get_executor())(
+        split_server_task(server, header_size, body_size, iterations));
+    capy::run_async(ioc.get_executor())(
+        split_client_task(client, header_size, body_size, iterations, latency_stats));
+    ioc.run();
+    ioc.restart();
+
+    bench::print_latency_stats(latency_stats, "Round-trip latency");
+    std::cout << "\n";
+
+    bench::record(bench::result("split_pingpong")
+        .param("header_size", header_size)
+        .param("body_size", body_size)
+        .param("coalesce", coalesce ? "on" : "off")
+        .latency(latency_stats));
+
+    client.close();
+    server.close();
+}
+
+// Server side of the timestamped ping-pong: splits each ping's latency
+// at the kernel receive timestamp
+capy::task<> timestamped_server_task(
+    corosio::socket& server,
+    std::size_t message_size,
+    int iterations,
+    std::vector<std::chrono::system_clock::time_point> const& sent,
+    bench::histogram& wire_stats,
+    bench::histogram& app_stats)
+{
+    std::vector<char> recv_buf(message_size);
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto [ec1, n1] = co_await capy::read(
+            server, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec1)
+        {
+            std::cerr << "    Server read error: " << ec1.message() << "\n";
+            co_return;
+        }
+        auto resumed = std::chrono::system_clock::now();
+        auto received = server.last_receive_time();
+
+        using us = std::chrono::duration<double, std::micro>;
+        wire_stats.add(us(received - sent[i]).count());
+        app_stats.add(us(resumed - received).count());
+
+        auto [ec2, n2] = co_await capy::write(
+            server, capy::const_buffer(recv_buf.data(), n1));
+        if (ec2)
+        {
+            std::cerr << "    Server write error: " << ec2.message() << "\n";
+            co_return;
+        }
+    }
+}
+
+capy::task<> timestamped_client_task(
+    corosio::socket& client,
+    std::size_t message_size,
+    int iterations,
+    std::vector<std::chrono::system_clock::time_point>& sent)
+{
+    std::vector<char> send_buf(message_size, 'P');
+    std::vector<char> recv_buf(message_size);
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        sent[i] = std::chrono::system_clock::now();
+        auto [ec1, n1] = co_await capy::write(
+            client, capy::const_buffer(send_buf.data(), send_buf.size()));
+        if (ec1)
+        {
+            std::cerr << "    Write error: " << ec1.message() << "\n";
+            co_return;
+        }
+
+        auto [ec2, n2] = co_await capy::read(
+            client, capy::mutable_buffer(recv_buf.data(), recv_buf.size()));
+        if (ec2)
+        {
+            std::cerr << "    Client read error: " << ec2.message() << "\n";
+            co_return;
+        }
+    }
+}
+
+// Benchmark: One-way latency split at the kernel receive timestamp
+void bench_timestamped_latency(
+    corosio::basic_io_context& ioc,
+    std::size_t message_size,
+    int iterations)
+{
+    std::cout << "  Message size: " << message_size << " bytes, ";
+    std::cout << "Iterations: " << iterations << "\n";
+
+    auto [client, server] = corosio::test::make_socket_pair(ioc);
+    client.set_no_delay(true);
+    server.set_no_delay(true);
+
+    try
+    {
+        server.set_timestamping(true);
+    }
+    catch (boost::system::system_error const& e)
+    {
+        std::cout << "  Skipped: " << e.code().message() << "\n\n";
+        client.close();
+        server.close();
+        return;
+    }
+
+    std::vector<std::chrono::system_clock::time_point> sent(iterations);
+    bench::histogram wire_stats;
+    bench::histogram app_stats;
+
+    capy::run_async(ioc.get_executor())(timestamped_server_task(
+        server, message_size, iterations, sent, wire_stats, app_stats));
+    capy::run_async(ioc.get_executor())(timestamped_client_task(
+        client, message_size, iterations, sent));
+    ioc.run();
+    ioc.restart();
+
+    bench::print_latency_stats(wire_stats, "Send to kernel receive");
+    bench::print_latency_stats(app_stats, "Kernel receive to resume");
+    std::cout << "\n";
+
+    bench::record(bench::result("timestamped_wire")
+        .param("message_size", message_size)
+        .latency(wire_stats));
+    bench::record(bench::result("timestamped_app")
+        .param("message_size", message_size)
+        .latency(app_stats));
+
+    client.close();
+    server.close();
+}
+
+// Run the ping-pong suite on one context
+void run_latency_suite(corosio::basic_io_context& ioc)
+{
+    for (std::size_t size : {1, 64, 1024})
+        bench_pingpong_latency(ioc, size, 1000);
+    bench_concurrent_latency(ioc, 16, 64, 250);
+}
+
+#if BOOST_COROSIO_HAS_IO_URING && BOOST_COROSIO_HAS_EPOLL
+// Benchmark: io_uring with kernel submission polling against epoll
+void bench_sqpoll_comparison(unsigned sq_thread_idle, int sq_thread_cpu)
+{
+    {
+        bench::print_header("epoll");
+        bench::report::get().set_backend("epoll");
+        corosio::epoll_context ioc(1);
+        run_latency_suite(ioc);
+    }
+
+    {
+        bench::print_header("io_uring");
+        bench::report::get().set_backend("io_uring");
+        corosio::io_uring_context ioc(1);
+        run_latency_suite(ioc);
+    }
+
+    {
+        bench::print_header("io_uring with SQPOLL");
+        bench::report::get().set_backend("io_uring_sqpoll");
+        corosio::io_uring_options opts;
+        opts.sq_poll = true;
+        opts.sq_thread_idle = sq_thread_idle;
+        opts.sq_thread_cpu = sq_thread_cpu;
+        corosio::io_uring_context ioc(1, opts);
+        run_latency_suite(ioc);
+    }
+}
+#endif
+
+// Run the full latency benchmarks on one backend
+template<class Context>
+void run_all_benchmarks(const char* backend_name)
+{
+    std::cout << "Backend: " << backend_name << "\n";
+    bench::report::get().set_backend(backend_name);
 
     bench::print_header("Ping-Pong Round-Trip Latency");
 
@@ -183,15 +507,161 @@ int main()
     std::vector<std::size_t> message_sizes = {1, 64, 1024};
     int iterations = 1000;
 
+    Context ioc;
+
     for (auto size : message_sizes)
-        bench_pingpong_latency(size, iterations);
+        bench_pingpong_latency(ioc, size, iterations);
 
     bench::print_header("Concurrent Socket Pairs Latency");
 
     // Multiple concurrent connections
-    bench_concurrent_latency(1, 64, 1000);
-    bench_concurrent_latency(4, 64, 500);
-    bench_concurrent_latency(16, 64, 250);
+    bench_concurrent_latency(ioc, 1, 64, 1000);
+    bench_concurrent_latency(ioc, 4, 64, 500);
+    bench_concurrent_latency(ioc, 16, 64, 250);
+
+    bench::print_header("Split-Message Ping-Pong Latency");
+
+    // Header and body written separately
+    for (bool coalesce : {false, true})
+    {
+        bench_split_pingpong_latency(ioc, 16, 64, iterations, coalesce);
+        bench_split_pingpong_latency(ioc, 16, 1024, iterations, coalesce);
+    }
+
+    bench::print_header("Kernel Timestamp Latency Split");
+
+    for (auto size : message_sizes)
+        bench_timestamped_latency(ioc, size, iterations);
+}
+
+void print_usage(const char* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --backend <name>   Select I/O backend (default: platform default)\n";
+    std::cout << "  --sqpoll           Compare io_uring SQPOLL against epoll\n";
+    std::cout << "  --sq-idle <ms>     SQPOLL thread idle timeout (default: kernel)\n";
+    std::cout << "  --sq-cpu <n>       CPU to pin the SQPOLL thread to\n";
+    std::cout << "  --json <file>      Write the results as JSON\n";
+    std::cout << "  --help             Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const char* backend = nullptr;
+    bool sqpoll = false;
+    unsigned sq_thread_idle = 0;
+    int sq_thread_cpu = -1;
+    bench::report::get().describe("corosio", "socket_latency");
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc)
+        {
+            backend = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--sqpoll") == 0)
+        {
+            sqpoll = true;
+        }
+        else if (std::strcmp(argv[i], "--sq-idle") == 0 && i + 1 < argc)
+        {
+            sq_thread_idle = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--sq-cpu") == 0 && i + 1 < argc)
+        {
+            sq_thread_cpu = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (sqpoll)
+    {
+#if BOOST_COROSIO_HAS_IO_URING && BOOST_COROSIO_HAS_EPOLL
+        std::cout << "Boost.Corosio SQPOLL Latency Comparison\n";
+        std::cout << "=======================================\n";
+        bench_sqpoll_comparison(sq_thread_idle, sq_thread_cpu);
+        std::cout << "\nBenchmarks complete.\n";
+        return 0;
+#else
+        (void)sq_thread_idle;
+        (void)sq_thread_cpu;
+        std::cerr << "Error: --sqpoll requires the io_uring and epoll backends.\n";
+        return 1;
+#endif
+    }
+
+    std::cout << "Boost.Corosio Socket Latency Benchmarks\n";
+    std::cout << "=======================================\n";
+
+    if (!backend)
+    {
+        run_all_benchmarks<corosio::io_context>("default");
+        std::cout << "\nBenchmarks complete.\n";
+        return 0;
+    }
+
+    bool found = false;
+#if BOOST_COROSIO_HAS_IO_URING
+    if (std::strcmp(backend, "io_uring") == 0)
+    {
+        run_all_benchmarks<corosio::io_uring_context>("io_uring");
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_EPOLL
+    if (std::strcmp(backend, "epoll") == 0)
+    {
+        run_all_benchmarks<corosio::epoll_context>("epoll");
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_KQUEUE
+    if (std::strcmp(backend, "kqueue") == 0)
+    {
+        run_all_benchmarks<corosio::kqueue_context>("kqueue");
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_POLL
+    if (std::strcmp(backend, "poll") == 0)
+    {
+        run_all_benchmarks<corosio::poll_context>("poll");
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+    if (std::strcmp(backend, "select") == 0)
+    {
+        run_all_benchmarks<corosio::select_context>("select");
+        found = true;
+    }
+#endif
+#if BOOST_COROSIO_HAS_IOCP
+    if (std::strcmp(backend, "iocp") == 0)
+    {
+        run_all_benchmarks<corosio::iocp_context>("iocp");
+        found = true;
+    }
+#endif
+
+    if (!found)
+    {
+        std::cerr << "Error: Backend '" << backend << "' is not available on this platform.\n";
+        return 1;
+    }
 
     std::cout << "\nBenchmarks complete.\n";
     return 0;
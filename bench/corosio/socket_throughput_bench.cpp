@@ -119,6 +119,87 @@ void bench_throughput(std::size_t chunk_size, std::size_t total_bytes)
               << elapsed << " s\n";
     std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
 
+    bench::record(bench::result("unidirectional")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
+    writer.close();
+    reader.close();
+}
+
+// Benchmark: Socket throughput with whole-chunk transfers, where the
+// implementation continues partial writes and reads itself
+void bench_throughput_all(std::size_t chunk_size, std::size_t total_bytes)
+{
+    std::cout << "  Buffer size: " << chunk_size << " bytes, ";
+    std::cout << "Transfer: " << (total_bytes / (1024 * 1024)) << " MB\n";
+
+    corosio::io_context ioc;
+    auto [writer, reader] = corosio::test::make_socket_pair(ioc);
+
+    set_nodelay(writer);
+    set_nodelay(reader);
+
+    std::vector<char> write_buf(chunk_size, 'x');
+    std::vector<char> read_buf(chunk_size);
+
+    std::size_t total_written = 0;
+    std::size_t total_read = 0;
+
+    auto write_task = [&]() -> capy::task<>
+    {
+        while (total_written < total_bytes)
+        {
+            std::size_t to_write = (std::min)(chunk_size, total_bytes - total_written);
+            auto [ec, n] = co_await writer.write_all(
+                capy::const_buffer(write_buf.data(), to_write));
+            total_written += n;
+            if (ec)
+            {
+                std::cerr << "    Write error: " << ec.message() << "\n";
+                break;
+            }
+        }
+        writer.shutdown(corosio::socket::shutdown_send);
+    };
+
+    auto read_task = [&]() -> capy::task<>
+    {
+        while (total_read < total_bytes)
+        {
+            std::size_t to_read = (std::min)(chunk_size, total_bytes - total_read);
+            auto [ec, n] = co_await reader.read_exact(
+                capy::mutable_buffer(read_buf.data(), to_read));
+            total_read += n;
+            if (ec)
+            {
+                std::cerr << "    Read error: " << ec.message() << "\n";
+                break;
+            }
+        }
+    };
+
+    bench::stopwatch sw;
+
+    capy::run_async(ioc.get_executor())(write_task());
+    capy::run_async(ioc.get_executor())(read_task());
+    ioc.run();
+
+    double elapsed = sw.elapsed_seconds();
+    double throughput = static_cast<double>(total_read) / elapsed;
+
+    std::cout << "    Written:    " << total_written << " bytes\n";
+    std::cout << "    Read:       " << total_read << " bytes\n";
+    std::cout << "    Elapsed:    " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
+
+    bench::record(bench::result("unidirectional_all")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
     writer.close();
     reader.close();
 }
@@ -216,12 +297,20 @@ void bench_bidirectional_throughput(std::size_t chunk_size, std::size_t total_by
     std::cout << "    Throughput:  " << bench::format_throughput(throughput)
               << " (combined)\n\n";
 
+    bench::record(bench::result("bidirectional")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
     sock1.close();
     sock2.close();
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+    bench::report::get().describe("corosio", "socket_throughput");
+    bench::parse_options(argc, argv);
+
     std::cout << "Boost.Corosio Socket Throughput Benchmarks\n";
     std::cout << "==========================================\n";
 
@@ -234,6 +323,11 @@ int main()
     for (auto size : buffer_sizes)
         bench_throughput(size, transfer_size);
 
+    bench::print_header("Unidirectional Throughput (write_all/read_exact)");
+
+    for (auto size : buffer_sizes)
+        bench_throughput_all(size, transfer_size);
+
     bench::print_header("Bidirectional Throughput");
 
     // Bidirectional with different buffer sizes
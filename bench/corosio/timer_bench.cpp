@@ -0,0 +1,484 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/read.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+
+using clock_type = corosio::timer::clock_type;
+
+// Sizes of the timer suite, run once per backend
+struct suite_options
+{
+    int timers = 1000000;
+    int idle_timers = 100000;
+    int resets = 10;
+    int burst = 100000;
+    int ticks = 1000;
+    int load_pairs = 4;
+    char const* backend = nullptr;
+};
+
+double to_us(clock_type::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// One per-request deadline: create, arm, cancel and destroy a timer
+inline void timer_cycle(boost::capy::execution_context& ctx)
+{
+    corosio::timer t(ctx);
+    t.expires_after(std::chrono::seconds(30));
+    t.cancel();
+}
+
+// Benchmark: timer lifecycle rate across threads sharing one context
+template <typename Context, typename... Args>
+void bench_timer_cycles(
+    char const* label,
+    int cycles_per_thread,
+    int max_threads,
+    Args const&... args)
+{
+    bench::print_header(label);
+
+    std::cout << "  Cycles per thread: " << cycles_per_thread << "\n\n";
+
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+    {
+        Context ioc(static_cast<unsigned>(num_threads), args...);
+        std::atomic<bool> go{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&ioc, &go, cycles_per_thread]()
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (int i = 0; i < cycles_per_thread; ++i)
+                    timer_cycle(ioc);
+            });
+        }
+
+        bench::stopwatch sw;
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads)
+            t.join();
+        double elapsed = sw.elapsed_seconds();
+
+        auto total = static_cast<double>(cycles_per_thread) * num_threads;
+        std::cout << "  " << num_threads << " thread(s): "
+                  << bench::format_rate(total / elapsed)
+                  << " ("
+                  << bench::format_latency(elapsed * 1e6 * num_threads / total)
+                  << " per cycle per thread)\n";
+
+        bench::record(bench::result("timer_cycle")
+            .param("threads", num_threads)
+            .param("cycles_per_thread", cycles_per_thread)
+            .ops_per_sec(total / elapsed));
+    }
+}
+
+// Wait once, for the expiry or a cancellation
+capy::task<> wait_task(corosio::timer& t, int& done)
+{
+    auto [ec] = co_await t.wait();
+    (void)ec;
+    ++done;
+}
+
+// Benchmark: arm timers, each with a coroutine waiting on it, then
+// cancel them all
+template<typename Context, typename... Args>
+void bench_arm_cancel(int count, Args const&... args)
+{
+    Context ioc(1u, args...);
+    std::vector<corosio::timer> timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i)
+        timers.emplace_back(ioc);
+    int done = 0;
+
+    // Expiries spread over a minute, out of order
+    bench::stopwatch sw;
+    for (int i = 0; i < count; ++i)
+    {
+        auto spread = (static_cast<long long>(i) * 7919) % 60000000;
+        timers[i].expires_after(
+            std::chrono::seconds(60) + std::chrono::microseconds(spread));
+        capy::run_async(ioc.get_executor())(wait_task(timers[i], done));
+    }
+    ioc.poll();
+    double arm = sw.elapsed_seconds();
+
+    sw.reset();
+    for (auto& t : timers)
+        t.cancel();
+    ioc.run();
+    double cancel = sw.elapsed_seconds();
+
+    std::cout << "  Arm " << count << ": " << bench::format_rate(count / arm)
+              << ", cancel: " << bench::format_rate(count / cancel) << "\n";
+
+    bench::record(bench::result("arm")
+        .param("timers", count)
+        .ops_per_sec(count / arm));
+    bench::record(bench::result("cancel")
+        .param("timers", count)
+        .ops_per_sec(count / cancel));
+}
+
+// An idle timeout: a reset cancels the wait, which starts again
+capy::task<> idle_timeout_task(corosio::timer& t, bool const& stopping)
+{
+    for (;;)
+    {
+        auto [ec] = co_await t.wait();
+        if (!ec || stopping)
+            co_return;
+    }
+}
+
+// Benchmark: push every idle timeout back, round after round, as a
+// server does when each connection sees traffic
+template<typename Context, typename... Args>
+void bench_reset(int count, int rounds, Args const&... args)
+{
+    Context ioc(1u, args...);
+    std::vector<corosio::timer> timers;
+    timers.reserve(count);
+    bool stopping = false;
+    for (int i = 0; i < count; ++i)
+    {
+        auto& t = timers.emplace_back(ioc);
+        t.expires_after(std::chrono::seconds(30));
+        capy::run_async(ioc.get_executor())(idle_timeout_task(t, stopping));
+    }
+    ioc.poll();
+
+    bench::stopwatch sw;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto& t : timers)
+            t.expires_after(std::chrono::seconds(30));
+        ioc.poll();
+    }
+    double elapsed = sw.elapsed_seconds();
+    auto total = static_cast<double>(count) * rounds;
+
+    stopping = true;
+    for (auto& t : timers)
+        t.cancel();
+    ioc.run();
+
+    std::cout << "  Reset " << count << " x " << rounds << ": "
+              << bench::format_rate(total / elapsed) << "\n";
+
+    bench::record(bench::result("reset")
+        .param("timers", count)
+        .param("rounds", rounds)
+        .ops_per_sec(total / elapsed));
+}
+
+// Wait for a shared deadline, noting when the waits complete
+capy::task<> burst_task(
+    corosio::timer& t,
+    clock_type::time_point& first,
+    clock_type::time_point& last)
+{
+    auto [ec] = co_await t.wait();
+    if (ec)
+        co_return;
+    last = clock_type::now();
+    if (first == clock_type::time_point())
+        first = last;
+}
+
+// Benchmark: many timers expiring at the same instant
+template<typename Context, typename... Args>
+void bench_burst(int count, Args const&... args)
+{
+    Context ioc(1u, args...);
+    std::vector<corosio::timer> timers;
+    timers.reserve(count);
+    clock_type::time_point first;
+    clock_type::time_point last;
+
+    auto deadline = clock_type::now() + std::chrono::milliseconds(200);
+    for (int i = 0; i < count; ++i)
+    {
+        auto& t = timers.emplace_back(ioc);
+        t.expires_at(deadline);
+        capy::run_async(ioc.get_executor())(burst_task(t, first, last));
+    }
+    bool late_start = clock_type::now() > deadline;
+    ioc.run();
+
+    double first_late = to_us(first - deadline);
+    double drain = to_us(last - first);
+    double rate = count / (to_us(last - deadline) / 1e6);
+
+    std::cout << "  Burst " << count << ": first after "
+              << bench::format_latency(first_late) << ", all after "
+              << bench::format_latency(to_us(last - deadline)) << " ("
+              << bench::format_rate(rate) << ")";
+    if (late_start)
+        std::cout << " (armed after the deadline)";
+    std::cout << "\n";
+
+    bench::record(bench::result("burst")
+        .param("timers", count)
+        .ops_per_sec(rate)
+        .metric("first_late_us", first_late)
+        .metric("drain_us", drain));
+}
+
+// Background traffic on a socket pair until `stop` is set
+capy::task<> load_task(
+    corosio::socket& client,
+    corosio::socket& server,
+    bool const& stop)
+{
+    char buf[64] = {};
+    while (!stop)
+    {
+        auto [ec1, n1] = co_await capy::write(
+            client, capy::const_buffer(buf, sizeof(buf)));
+        auto [ec2, n2] = co_await capy::read(
+            server, capy::mutable_buffer(buf, sizeof(buf)));
+        if (ec1 || ec2)
+            co_return;
+    }
+}
+
+// A periodic timer, recording how late each tick completes
+capy::task<> ticker_task(
+    corosio::timer& t,
+    int ticks,
+    std::chrono::microseconds period,
+    bench::histogram& lateness,
+    bool& stop)
+{
+    auto due = clock_type::now() + period;
+    for (int i = 0; i < ticks; ++i, due += period)
+    {
+        t.expires_at(due);
+        auto [ec] = co_await t.wait();
+        if (ec)
+            break;
+        lateness.add(to_us(clock_type::now() - due));
+    }
+    stop = true;
+}
+
+// Benchmark: how late a 1 ms periodic timer completes, on an idle
+// context and on one busy with socket traffic
+template<typename Context, typename... Args>
+void bench_accuracy(int ticks, int load_pairs, Args const&... args)
+{
+    for (int pairs : {0, load_pairs})
+    {
+        Context ioc(1u, args...);
+        std::vector<std::pair<corosio::socket, corosio::socket>> sockets;
+        sockets.reserve(pairs);
+        bool stop = false;
+        for (int i = 0; i < pairs; ++i)
+        {
+            auto& p = sockets.emplace_back(corosio::test::make_local_socket_pair(ioc));
+            capy::run_async(ioc.get_executor())(
+                load_task(p.first, p.second, stop));
+        }
+
+        corosio::timer t(ioc);
+        bench::histogram lateness;
+        capy::run_async(ioc.get_executor())(ticker_task(
+            t, ticks, std::chrono::milliseconds(1), lateness, stop));
+        ioc.run();
+
+        std::cout << "  " << (pairs ? "Loaded" : "Idle") << ": p50 "
+                  << bench::format_latency(lateness.p50()) << ", p99 "
+                  << bench::format_latency(lateness.p99()) << ", max "
+                  << bench::format_latency((lateness.max)()) << " late\n";
+
+        bench::record(bench::result(pairs ? "accuracy_loaded" : "accuracy_idle")
+            .param("ticks", ticks)
+            .param("load_pairs", pairs)
+            .latency(lateness));
+    }
+}
+
+// Run the timer suite on one backend and timer configuration
+template<typename Context, typename... Args>
+void run_suite(
+    char const* name,
+    suite_options const& opt,
+    Args const&... args)
+{
+    if (opt.backend && std::strcmp(opt.backend, name) != 0)
+        return;
+
+    bench::print_header((std::string("Timer suite (") + name + ")").c_str());
+    bench::report::get().set_backend(name);
+
+    bench_arm_cancel<Context>(opt.timers, args...);
+    bench_reset<Context>(opt.idle_timers, opt.resets, args...);
+    bench_burst<Context>(opt.burst, args...);
+    bench_accuracy<Context>(opt.ticks, opt.load_pairs, args...);
+}
+
+void print_usage(char const* program_name)
+{
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --cycles <n>       Timer cycles per thread (default: 1000000)\n";
+    std::cout << "  --threads <n>      Largest thread count (default: 8)\n";
+    std::cout << "  --timers <n>       Timers armed and cancelled (default: 1000000)\n";
+    std::cout << "  --idle <n>         Idle timeouts reset each round (default: 100000)\n";
+    std::cout << "  --resets <n>       Reset rounds (default: 10)\n";
+    std::cout << "  --burst <n>        Timers expiring together (default: 100000)\n";
+    std::cout << "  --ticks <n>        Ticks of the 1 ms accuracy timer (default: 1000)\n";
+    std::cout << "  --backend <name>   Run the timer suite on this backend only\n";
+    std::cout << "  --json <file>      Write the results as JSON\n";
+    std::cout << "  --help             Show this help message\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int cycles = 1000000;
+    int max_threads = 8;
+    suite_options opt;
+    bench::report::get().describe("corosio", "timer");
+
+    // Parse command-line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        if (bench::parse_json_option(argc, argv, i))
+            continue;
+        if (std::strcmp(argv[i], "--cycles") == 0 && i + 1 < argc)
+        {
+            cycles = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            max_threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--timers") == 0 && i + 1 < argc)
+        {
+            opt.timers = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--idle") == 0 && i + 1 < argc)
+        {
+            opt.idle_timers = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--resets") == 0 && i + 1 < argc)
+        {
+            opt.resets = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--burst") == 0 && i + 1 < argc)
+        {
+            opt.burst = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+        {
+            opt.ticks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc)
+        {
+            opt.backend = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Boost.Corosio Timer Benchmarks\n";
+    std::cout << "==============================\n\n";
+
+    bench_timer_cycles<corosio::io_context>(
+        "Create/Arm/Cancel/Destroy (default context)", cycles, max_threads);
+
+#if BOOST_COROSIO_HAS_EPOLL
+    bench::report::get().set_backend("epoll_wheel");
+    bench_timer_cycles<corosio::epoll_context>(
+        "Create/Arm/Cancel/Destroy (epoll, timing wheel)", cycles, max_threads,
+        corosio::epoll_options{.timers = {.queue = corosio::timer_queue::wheel}});
+    bench::report::get().set_backend("epoll_sharded");
+    bench_timer_cycles<corosio::epoll_context>(
+        "Create/Arm/Cancel/Destroy (epoll, sharded heaps)", cycles, max_threads,
+        corosio::epoll_options{.timers = {.queue = corosio::timer_queue::sharded}});
+#endif
+
+    // The same suite on every backend, and on each timer queue where
+    // the backend lets the queue be chosen. On Windows the context
+    // picks the NT timer API or a timer thread by itself; comparing
+    // the two needs runs on systems that differ.
+    run_suite<corosio::io_context>("default", opt);
+#if BOOST_COROSIO_HAS_EPOLL
+    run_suite<corosio::epoll_context>("epoll", opt, corosio::epoll_options{});
+    run_suite<corosio::epoll_context>("epoll_wheel", opt,
+        corosio::epoll_options{.timers = {.queue = corosio::timer_queue::wheel}});
+    run_suite<corosio::epoll_context>("epoll_sharded", opt,
+        corosio::epoll_options{.timers = {.queue = corosio::timer_queue::sharded}});
+#endif
+#if BOOST_COROSIO_HAS_IO_URING
+    run_suite<corosio::io_uring_context>("io_uring", opt, corosio::io_uring_options{});
+    run_suite<corosio::io_uring_context>("io_uring_wheel", opt,
+        corosio::io_uring_options{.timers = {.queue = corosio::timer_queue::wheel}});
+#endif
+#if BOOST_COROSIO_HAS_KQUEUE
+    run_suite<corosio::kqueue_context>("kqueue", opt);
+#endif
+#if BOOST_COROSIO_HAS_POLL
+    run_suite<corosio::poll_context>("poll", opt);
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+    run_suite<corosio::select_context>("select", opt);
+#endif
+#if BOOST_COROSIO_HAS_IOCP
+    run_suite<corosio::iocp_context>("iocp", opt, corosio::iocp_options{});
+    run_suite<corosio::iocp_context>("iocp_wheel", opt,
+        corosio::iocp_options{.timers = {.queue = corosio::timer_queue::wheel}});
+    run_suite<corosio::iocp_context>("iocp_low_resolution", opt,
+        corosio::iocp_options{.high_resolution_timers = false});
+#endif
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
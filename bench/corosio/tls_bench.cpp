@@ -0,0 +1,362 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/tls/context.hpp>
+#include <boost/corosio/tls/tls_stream.hpp>
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+#include <boost/corosio/tls/openssl_stream.hpp>
+#endif
+#ifdef BOOST_COROSIO_HAS_WOLFSSL
+#include <boost/corosio/tls/wolfssl_stream.hpp>
+#endif
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+#include "../common/tls_credentials.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+namespace tls = boost::corosio::tls;
+namespace urls = boost::urls;
+
+tls::context make_server_context()
+{
+    tls::context ctx;
+    ctx.use_certificate(bench::tls_cert_pem, tls::file_format::pem);
+    ctx.use_private_key(bench::tls_key_pem, tls::file_format::pem);
+    return ctx;
+}
+
+// A client that verifies the server. Without a session cache every
+// handshake is a full one.
+tls::context make_client_context(bool resume)
+{
+    tls::context ctx;
+    ctx.add_certificate_authority(bench::tls_cert_pem);
+    ctx.set_verify_mode(tls::verify_mode::peer);
+    ctx.set_hostname("localhost");
+    if (!resume)
+        ctx.set_session_cache_size(0);
+    return ctx;
+}
+
+// Benchmark: sequential connections to one listener, each doing a
+// handshake and reading the server's first byte. The byte makes the
+// client take in TLS 1.3 session tickets, which follow the handshake.
+template<class Stream>
+void bench_handshakes(int count, bool resume)
+{
+    std::cout << "  " << (resume ? "Resumed" : "Full") << " handshakes: "
+              << count << "\n";
+
+    corosio::io_context ioc;
+    corosio::acceptor acc(ioc);
+    acc.listen(corosio::endpoint(urls::ipv4_address::loopback(), 0));
+    auto ep = acc.local_endpoint();
+
+    auto server_ctx = make_server_context();
+    auto client_ctx = make_client_context(resume);
+
+    int completed = 0;
+    int failed = 0;
+    bench::statistics stats;
+
+    auto server_task = [&]() -> capy::task<>
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            corosio::socket sock(ioc);
+            auto [aec] = co_await acc.accept(sock);
+            if (aec)
+                co_return;
+            Stream stream(sock, server_ctx);
+            auto [hec] = co_await stream.handshake(corosio::tls_stream::server);
+            if (hec)
+                continue;
+            char c = 'r';
+            auto [wec, wn] = co_await stream.write_some(
+                capy::const_buffer(&c, 1));
+            if (wec)
+                continue;
+
+            // Wait for the client to hang up
+            auto [rec, rn] = co_await stream.read_some(
+                capy::mutable_buffer(&c, 1));
+            (void)rec;
+        }
+    };
+
+    auto client_task = [&]() -> capy::task<>
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            corosio::socket sock(ioc);
+            sock.open();
+            bench::stopwatch sw;
+            auto [cec] = co_await sock.connect(ep);
+            if (cec)
+            {
+                std::cerr << "    Connect error: " << cec.message() << "\n";
+                co_return;
+            }
+
+            // Made after connecting, so that the stream finds the
+            // session of this server
+            Stream stream(sock, client_ctx);
+            auto [hec] = co_await stream.handshake(corosio::tls_stream::client);
+            char c;
+            auto [rec, rn] = co_await stream.read_some(
+                capy::mutable_buffer(&c, 1));
+            if (hec || rec)
+                ++failed;
+            else
+            {
+                stats.add(sw.elapsed_us());
+                ++completed;
+            }
+            sock.close();
+        }
+    };
+
+    bench::stopwatch sw;
+    capy::run_async(ioc.get_executor())(server_task());
+    capy::run_async(ioc.get_executor())(client_task());
+    ioc.run();
+    double elapsed = sw.elapsed_seconds();
+
+    std::cout << "    Completed:   " << completed;
+    if (failed)
+        std::cout << " (" << failed << " failed)";
+    std::cout << "\n";
+    std::cout << "    Elapsed:     " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Rate:        " << bench::format_rate(completed / elapsed) << "\n";
+    std::cout << "    Latency:     mean " << bench::format_latency(stats.mean())
+              << ", p50 " << bench::format_latency(stats.p50())
+              << ", p99 " << bench::format_latency(stats.p99()) << "\n\n";
+
+    bench::record(bench::result("handshake")
+        .param("resume", resume ? "on" : "off")
+        .param("count", count)
+        .ops_per_sec(completed / elapsed)
+        .latency(stats));
+
+    acc.close();
+}
+
+// Benchmark: one-way transfer in writes of a given size; writes up
+// to 16 KiB map to records of the same size
+template<class Stream>
+void bench_bulk_throughput(std::size_t chunk_size, std::size_t total_bytes)
+{
+    std::cout << "  Write size: " << chunk_size << " bytes, ";
+    std::cout << "Transfer: " << (total_bytes / (1024 * 1024)) << " MB\n";
+
+    corosio::io_context ioc;
+    auto [s1, s2] = corosio::test::make_socket_pair(ioc);
+    auto client_ctx = make_client_context(false);
+    auto server_ctx = make_server_context();
+    Stream writer(s1, client_ctx);
+    Stream reader(s2, server_ctx);
+
+    std::vector<char> write_buf(chunk_size, 'x');
+    std::vector<char> read_buf(65536);
+
+    std::size_t total_written = 0;
+    std::size_t total_read = 0;
+    bench::stopwatch sw;
+
+    auto write_task = [&]() -> capy::task<>
+    {
+        auto [hec] = co_await writer.handshake(corosio::tls_stream::client);
+        if (hec)
+        {
+            std::cerr << "    Handshake error: " << hec.message() << "\n";
+            co_return;
+        }
+        while (total_written < total_bytes)
+        {
+            std::size_t to_write = (std::min)(chunk_size, total_bytes - total_written);
+            auto [ec, n] = co_await writer.write_some(
+                capy::const_buffer(write_buf.data(), to_write));
+            if (ec)
+            {
+                std::cerr << "    Write error: " << ec.message() << "\n";
+                break;
+            }
+            total_written += n;
+        }
+    };
+
+    auto read_task = [&]() -> capy::task<>
+    {
+        auto [hec] = co_await reader.handshake(corosio::tls_stream::server);
+        if (hec)
+            co_return;
+        sw.reset();
+        while (total_read < total_bytes)
+        {
+            auto [ec, n] = co_await reader.read_some(
+                capy::mutable_buffer(read_buf.data(), read_buf.size()));
+            if (ec)
+            {
+                std::cerr << "    Read error: " << ec.message() << "\n";
+                break;
+            }
+            total_read += n;
+        }
+    };
+
+    capy::run_async(ioc.get_executor())(write_task());
+    capy::run_async(ioc.get_executor())(read_task());
+    ioc.run();
+
+    double elapsed = sw.elapsed_seconds();
+    double throughput = static_cast<double>(total_read) / elapsed;
+
+    std::cout << "    Read:       " << total_read << " bytes\n";
+    std::cout << "    Elapsed:    " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
+
+    bench::record(bench::result("bulk")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
+    s1.close();
+    s2.close();
+}
+
+// Benchmark: resident memory added by the TLS state of connections
+// that finished their handshake and sit idle. The sockets exist
+// before the first measurement, so only the streams are counted.
+template<class Stream>
+void bench_idle_memory(int count)
+{
+    std::cout << "  Connections: " << count << "\n";
+
+    corosio::io_context ioc;
+    auto client_ctx = make_client_context(false);
+    auto server_ctx = make_server_context();
+
+    using socket_pair = std::pair<corosio::socket, corosio::socket>;
+    std::vector<std::unique_ptr<socket_pair>> sockets;
+    sockets.reserve(count);
+    for (int i = 0; i < count; ++i)
+        sockets.push_back(std::make_unique<socket_pair>(
+            corosio::test::make_socket_pair(ioc)));
+
+    // Build the native contexts, which are shared, before measuring
+    {
+        Stream c(sockets[0]->first, client_ctx);
+        Stream s(sockets[0]->second, server_ctx);
+    }
+
+    std::vector<std::unique_ptr<Stream>> streams;
+    streams.reserve(2 * count);
+    std::size_t before = bench::resident_memory();
+
+    int failed = 0;
+    auto handshake = [&](Stream& stream, corosio::tls_stream::handshake_type type)
+        -> capy::task<>
+    {
+        auto [ec] = co_await stream.handshake(type);
+        if (ec)
+            ++failed;
+    };
+    for (auto& p : sockets)
+    {
+        streams.push_back(std::make_unique<Stream>(p->first, client_ctx));
+        streams.push_back(std::make_unique<Stream>(p->second, server_ctx));
+        capy::run_async(ioc.get_executor())(
+            handshake(*streams[streams.size() - 2], corosio::tls_stream::client));
+        capy::run_async(ioc.get_executor())(
+            handshake(*streams.back(), corosio::tls_stream::server));
+    }
+    ioc.run();
+
+    std::size_t after = bench::resident_memory();
+    if (failed)
+        std::cout << "    Failed handshakes: " << failed << "\n";
+    if (before == 0 || after == 0)
+    {
+        std::cout << "    Resident memory is not available on this platform\n\n";
+        return;
+    }
+
+    double added = after > before
+        ? static_cast<double>(after - before)
+        : 0.0;
+    std::cout << "    Added:      " << bench::format_bytes(added) << "\n";
+    std::cout << "    Per conn:   " << bench::format_bytes(added / count)
+              << " (client + server)\n\n";
+
+    bench::record(bench::result("idle_memory")
+        .param("connections", count)
+        .metric("bytes_per_connection", added / count));
+
+    streams.clear();
+    for (auto& p : sockets)
+    {
+        p->first.close();
+        p->second.close();
+    }
+}
+
+template<class Stream>
+void run_suite(std::string const& name)
+{
+    bench::report::get().set_backend(name);
+
+    bench::print_header(("Handshakes (" + name + ")").c_str());
+    bench_handshakes<Stream>(2000, false);
+    bench_handshakes<Stream>(2000, true);
+
+    bench::print_header(("Bulk Throughput (" + name + ")").c_str());
+    std::size_t transfer_size = 64 * 1024 * 1024; // 64 MB
+    for (std::size_t size : {1024, 4096, 16384, 65536})
+        bench_bulk_throughput<Stream>(size, transfer_size);
+
+    bench::print_header(("Idle Connection Memory (" + name + ")").c_str());
+    bench_idle_memory<Stream>(256);
+}
+
+int main(int argc, char* argv[])
+{
+    bench::report::get().describe("corosio", "tls");
+    bench::parse_options(argc, argv);
+
+    std::cout << "Boost.Corosio TLS Benchmarks\n";
+    std::cout << "============================\n";
+
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+    run_suite<corosio::openssl_stream>("openssl_stream");
+#endif
+#ifdef BOOST_COROSIO_HAS_WOLFSSL
+    run_suite<corosio::wolfssl_stream>("wolfssl_stream");
+#endif
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/tls/context.hpp>
+#include <boost/corosio/tls/openssl_stream.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace tls = boost::corosio::tls;
+
+tls::context make_context()
+{
+    tls::context ctx;
+    ctx.set_verify_mode(tls::verify_mode::none);
+    ctx.set_ciphersuites("aNULL:!eNULL:@SECLEVEL=0");
+    return ctx;
+}
+
+// Benchmark: constructing streams from one shared context, with each
+// thread running its own io_context
+void bench_shared_context(int num_threads, int streams_per_thread)
+{
+    std::cout << "  Threads: " << num_threads << ", ";
+    std::cout << "Streams per thread: " << streams_per_thread << "\n";
+
+    auto ctx = make_context();
+
+    // Build the native context before timing
+    {
+        corosio::io_context ioc;
+        corosio::socket sock(ioc);
+        corosio::openssl_stream warm(sock, ctx);
+    }
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            corosio::io_context ioc;
+            corosio::socket sock(ioc);
+            while (!start.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            for (int i = 0; i < streams_per_thread; ++i)
+                corosio::openssl_stream s(sock, ctx);
+        });
+    }
+
+    bench::stopwatch sw;
+    start.store(true, std::memory_order_release);
+    for (auto& th : threads)
+        th.join();
+    double elapsed = sw.elapsed_seconds();
+
+    int total = num_threads * streams_per_thread;
+    double per_stream_us = elapsed * 1e6 / total;
+
+    std::cout << "    Elapsed:     " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Per stream:  " << bench::format_latency(per_stream_us) << "\n";
+    std::cout << "    Throughput:  " << bench::format_rate(total / elapsed) << "\n\n";
+
+    bench::record(bench::result("shared_context")
+        .param("threads", num_threads)
+        .param("streams_per_thread", streams_per_thread)
+        .ops_per_sec(total / elapsed));
+}
+
+// Benchmark: a fresh context per stream, which builds the native
+// context every time, for comparison
+void bench_fresh_context(int count)
+{
+    std::cout << "  Streams: " << count << "\n";
+
+    corosio::io_context ioc;
+    corosio::socket sock(ioc);
+
+    bench::stopwatch sw;
+    for (int i = 0; i < count; ++i)
+        corosio::openssl_stream s(sock, make_context());
+    double elapsed = sw.elapsed_seconds();
+
+    std::cout << "    Elapsed:     " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Per stream:  "
+              << bench::format_latency(elapsed * 1e6 / count) << "\n\n";
+
+    bench::record(bench::result("fresh_context")
+        .param("streams", count)
+        .ops_per_sec(count / elapsed));
+}
+
+int main(int argc, char* argv[])
+{
+    bench::report::get().describe("corosio", "tls_stream");
+    bench::report::get().set_backend("openssl_stream");
+    bench::parse_options(argc, argv);
+
+    std::cout << "Boost.Corosio TLS Stream Construction Benchmarks\n";
+    std::cout << "================================================\n";
+
+    bench::print_header("Shared Context (openssl_stream)");
+    for (int threads : {1, 2, 4, 8})
+        bench_shared_context(threads, 100000);
+
+    bench::print_header("Context Per Stream (openssl_stream)");
+    bench_fresh_context(1000);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/tls/context.hpp>
+#include <boost/corosio/tls/openssl_stream.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include "../common/benchmark.hpp"
+
+namespace corosio = boost::corosio;
+namespace capy = boost::capy;
+namespace tls = boost::corosio::tls;
+
+// Anonymous key exchange, so that no certificate is needed; the
+// records are still encrypted
+tls::context make_context()
+{
+    tls::context ctx;
+    ctx.set_verify_mode(tls::verify_mode::none);
+    ctx.set_max_protocol_version(tls::version::tls_1_2);
+    ctx.set_ciphersuites("aNULL:!eNULL:@SECLEVEL=0");
+    return ctx;
+}
+
+// Benchmark: TLS throughput over a socket pair with varying buffer sizes
+void bench_tls_throughput(std::size_t chunk_size, std::size_t total_bytes)
+{
+    std::cout << "  Buffer size: " << chunk_size << " bytes, ";
+    std::cout << "Transfer: " << (total_bytes / (1024 * 1024)) << " MB\n";
+
+    corosio::io_context ioc;
+    auto [s1, s2] = corosio::test::make_socket_pair(ioc);
+    auto ctx = make_context();
+    corosio::openssl_stream writer(s1, ctx);
+    corosio::openssl_stream reader(s2, ctx);
+
+    std::vector<char> write_buf(chunk_size, 'x');
+    std::vector<char> read_buf(chunk_size);
+
+    std::size_t total_written = 0;
+    std::size_t total_read = 0;
+    bench::stopwatch sw;
+
+    auto write_task = [&]() -> capy::task<>
+    {
+        auto [hec] = co_await writer.handshake(corosio::tls_stream::client);
+        if (hec)
+        {
+            std::cerr << "    Handshake error: " << hec.message() << "\n";
+            co_return;
+        }
+        while (total_written < total_bytes)
+        {
+            std::size_t to_write = (std::min)(chunk_size, total_bytes - total_written);
+            auto [ec, n] = co_await writer.write_some(
+                capy::const_buffer(write_buf.data(), to_write));
+            if (ec)
+            {
+                std::cerr << "    Write error: " << ec.message() << "\n";
+                break;
+            }
+            total_written += n;
+        }
+    };
+
+    auto read_task = [&]() -> capy::task<>
+    {
+        auto [hec] = co_await reader.handshake(corosio::tls_stream::server);
+        if (hec)
+            co_return;
+        sw.reset();
+        while (total_read < total_bytes)
+        {
+            auto [ec, n] = co_await reader.read_some(
+                capy::mutable_buffer(read_buf.data(), read_buf.size()));
+            if (ec)
+            {
+                std::cerr << "    Read error: " << ec.message() << "\n";
+                break;
+            }
+            total_read += n;
+        }
+    };
+
+    capy::run_async(ioc.get_executor())(write_task());
+    capy::run_async(ioc.get_executor())(read_task());
+    ioc.run();
+
+    double elapsed = sw.elapsed_seconds();
+    double throughput = static_cast<double>(total_read) / elapsed;
+
+    std::cout << "    Written:    " << total_written << " bytes\n";
+    std::cout << "    Read:       " << total_read << " bytes\n";
+    std::cout << "    Elapsed:    " << std::fixed << std::setprecision(3)
+              << elapsed << " s\n";
+    std::cout << "    Throughput: " << bench::format_throughput(throughput) << "\n\n";
+
+    bench::record(bench::result("unidirectional")
+        .param("chunk_size", chunk_size)
+        .param("total_bytes", total_bytes)
+        .bytes_per_sec(throughput));
+
+    s1.close();
+    s2.close();
+}
+
+int main(int argc, char* argv[])
+{
+    bench::report::get().describe("corosio", "tls_throughput");
+    bench::report::get().set_backend("openssl_stream");
+    bench::parse_options(argc, argv);
+
+    std::cout << "Boost.Corosio TLS Throughput Benchmarks\n";
+    std::cout << "=======================================\n";
+
+    bench::print_header("Unidirectional Throughput (openssl_stream)");
+
+    std::vector<std::size_t> buffer_sizes = {1024, 4096, 16384, 65536};
+    std::size_t transfer_size = 64 * 1024 * 1024; // 64 MB
+
+    for (auto size : buffer_sizes)
+        bench_tls_throughput(size, transfer_size);
+
+    std::cout << "\nBenchmarks complete.\n";
+    return 0;
+}
@@ -11,12 +11,37 @@
 #define BOOST_COROSIO_HPP
 
 #include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/async_event.hpp>
+#include <boost/corosio/async_mutex.hpp>
+#include <boost/corosio/async_semaphore.hpp>
+#include <boost/corosio/buffer_pool.hpp>
+#include <boost/corosio/buffered_stream.hpp>
+#include <boost/corosio/channel.hpp>
+#include <boost/corosio/connect.hpp>
+#include <boost/corosio/connection_pool.hpp>
 #include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/file_base.hpp>
+#include <boost/corosio/frame_allocator.hpp>
+#include <boost/corosio/framed_stream.hpp>
+#include <boost/corosio/io_account.hpp>
 #include <boost/corosio/io_context.hpp>
+#include <boost/corosio/io_context_pool.hpp>
+#include <boost/corosio/local_acceptor.hpp>
+#include <boost/corosio/local_stream_socket.hpp>
+#include <boost/corosio/loop_monitor.hpp>
+#include <boost/corosio/op_tracer.hpp>
+#include <boost/corosio/paced_stream.hpp>
+#include <boost/corosio/parked_ops.hpp>
+#include <boost/corosio/periodic_timer.hpp>
+#include <boost/corosio/random_access_file.hpp>
 #include <boost/corosio/resolver.hpp>
 #include <boost/corosio/resolver_results.hpp>
 #include <boost/corosio/signal_set.hpp>
 #include <boost/corosio/socket.hpp>
+#include <boost/corosio/socket_stats.hpp>
+#include <boost/corosio/strand.hpp>
+#include <boost/corosio/stream_file.hpp>
+#include <boost/corosio/stream_op.hpp>
 #include <boost/corosio/tcp_server.hpp>
 #include <boost/corosio/timer.hpp>
 
@@ -24,5 +49,7 @@
 #include <boost/corosio/tls/openssl_stream.hpp>
 #include <boost/corosio/tls/tls_stream.hpp>
 #include <boost/corosio/tls/wolfssl_stream.hpp>
+#include <boost/corosio/udp_socket.hpp>
+#include <boost/corosio/write_queue.hpp>
 
 #endif
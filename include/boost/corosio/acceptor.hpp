@@ -13,6 +13,7 @@
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/detail/except.hpp>
 #include <boost/corosio/io_object.hpp>
+#include <boost/corosio/detail/io_deadline.hpp>
 #include <boost/capy/io_result.hpp>
 #include <boost/corosio/endpoint.hpp>
 #include <boost/corosio/socket.hpp>
@@ -22,6 +23,7 @@
 
 #include <boost/system/error_code.hpp>
 
+#include <chrono>
 #include <concepts>
 #include <coroutine>
 #include <cstddef>
@@ -184,11 +186,69 @@ public:
     acceptor(acceptor const&) = delete;
     acceptor& operator=(acceptor const&) = delete;
 
+    /** Options for @ref listen. */
+    struct listen_options
+    {
+        /// The maximum length of the queue of pending connections.
+        int backlog = 128;
+
+        /** Set `SO_REUSEPORT` so that several acceptors may bind the
+            same endpoint and the kernel spreads incoming connections
+            among them. Not supported on Windows.
+        */
+        bool reuse_port = false;
+
+        /** Accept IPv4 connections on an IPv6 endpoint.
+
+            With an IPv6 endpoint, `IPV6_V6ONLY` is cleared when this
+            is `true` and set otherwise, so the behavior does not
+            depend on the system default. IPv4 peers of a dual-stack
+            acceptor are reported with IPv4 endpoints. Ignored for
+            IPv4 endpoints.
+        */
+        bool dual_stack = false;
+
+        /** Steer each connection to the acceptor of the receiving CPU.
+
+            Requires `reuse_port`. Attaches a reuseport BPF program
+            that picks the acceptor of the group by the number of the
+            CPU handling the incoming connection: the acceptors that
+            started listening first, second, and so on serve CPUs 0,
+            1, and so on. Connections on other CPUs are distributed
+            by hash as usual. Only supported on Linux.
+        */
+        bool cpu_steering = false;
+
+        /** Accept TCP Fast Open data carried in the SYN.
+
+            Nonzero sets `TCP_FASTOPEN` with this queue length: the
+            number of connections that have sent data in their SYN
+            but not yet completed the handshake. Such a connection
+            is accepted with its data readable, a round trip before
+            an ordinary one. Connections beyond the queue fall back
+            to a regular handshake. Zero leaves Fast Open off. On
+            macOS and FreeBSD the length only enables the option.
+        */
+        int fast_open_queue = 0;
+
+        /** Wake a single context per incoming connection.
+
+            For a listener that other contexts @ref share. Registers
+            the socket with `EPOLLEXCLUSIVE`, so that a connection
+            wakes one of the contexts waiting on it rather than all
+            of them. Unlike a `reuse_port` group, the contexts draw
+            from a single queue, which does not change as they come
+            and go. Ignored by backends other than epoll.
+        */
+        bool exclusive_wakeup = false;
+    };
+
     /** Open, bind, and listen on an endpoint.
 
-        Creates an IPv4 TCP socket, binds it to the specified endpoint,
-        and begins listening for incoming connections. This must be
-        called before initiating accept operations.
+        Creates a TCP socket of the endpoint's family, binds it to the
+        specified endpoint, and begins listening for incoming
+        connections. This must be called before initiating accept
+        operations.
 
         @param ep The local endpoint to bind to. Use `endpoint(port)` to
             bind to all interfaces on a specific port.
@@ -196,9 +256,87 @@ public:
         @param backlog The maximum length of the queue of pending
             connections. Defaults to a reasonable system value.
 
+        @param reuse_port If true, set `SO_REUSEPORT` so that several
+            acceptors may bind the same endpoint and the kernel spreads
+            incoming connections among them. Not supported on Windows.
+
+        @throws std::system_error on failure.
+    */
+    void listen(endpoint ep, int backlog = 128, bool reuse_port = false)
+    {
+        listen(ep, listen_options{
+            .backlog = backlog, .reuse_port = reuse_port});
+    }
+
+    /** Open, bind, and listen on an endpoint with options.
+
+        Like the overload taking a backlog, with every setting in
+        `opts`. A dual-stack acceptor on `[::]` serves both families
+        from one socket:
+
+        @code
+        acc.listen(endpoint(urls::ipv6_address(), 8080),
+            acceptor::listen_options{.dual_stack = true});
+        @endcode
+
+        @param ep The local endpoint to bind to.
+        @param opts The listen options.
+
         @throws std::system_error on failure.
     */
-    void listen(endpoint ep, int backlog = 128);
+    void listen(endpoint ep, listen_options const& opts);
+
+    /** Adopt a socket that is already listening.
+
+        Takes ownership of `h`, a TCP socket bound and listening,
+        typically inherited from the process that opened it or
+        received over a Unix domain socket. The socket is made
+        non-blocking and close-on-exec. A connection queued on it
+        remains queued, so a process taking over the listeners of
+        another refuses none. Not supported on Windows.
+
+        @param h The listening socket.
+
+        @throws std::system_error on failure, in which case `h` is
+            left open and owned by the caller.
+    */
+    void assign(native_handle_type h);
+
+    /** Listen on the socket of another acceptor.
+
+        Opens this acceptor on a duplicate of the listening socket
+        of `other`, typically one belonging to a different context,
+        so that each context runs its own accept loop over the same
+        queue of connections. On epoll the duplicate is registered
+        with `EPOLLEXCLUSIVE`, and `other` should have been opened
+        with @ref listen_options::exclusive_wakeup, so that each
+        connection wakes one context. Closing either acceptor
+        leaves the other listening. Not supported on Windows.
+
+        @par Example
+        @code
+        acceptor::listen_options opts;
+        opts.exclusive_wakeup = true;
+        acceptor acc1(ctx1);
+        acc1.listen(endpoint(8080), opts);
+        acceptor acc2(ctx2);
+        acc2.share(acc1);
+        @endcode
+
+        @param other An acceptor that is listening.
+
+        @throws std::system_error on failure.
+    */
+    void share(acceptor const& other);
+
+    /** Return the native handle of the listening socket.
+
+        Duplicate it or clear its close-on-exec flag to hand it to
+        another process, which can then @ref assign it.
+
+        @return The handle, or an invalid handle if not listening.
+    */
+    native_handle_type native_handle() const noexcept;
 
     /** Close the acceptor.
 
@@ -256,6 +394,26 @@ public:
         return accept_awaitable(*this, peer);
     }
 
+    /** Initiate an asynchronous accept operation with a deadline.
+
+        Like @ref accept, but the accept is cancelled if no connection
+        arrives by `deadline`, and then completes with
+        `errc::timed_out`. The deadline uses a timer node kept by the
+        acceptor.
+
+        @param peer The socket to receive the accepted connection.
+        @param deadline The time at which the accept is cancelled.
+    */
+    auto accept(
+        socket& peer,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        if (!impl_)
+            detail::throw_logic_error("accept: acceptor not listening");
+        return detail::deadline_awaitable<accept_awaitable>(
+            get_deadline(read_slot), deadline, *this, peer);
+    }
+
     /** Cancel any pending asynchronous operations.
 
         All outstanding operations complete with `errc::operation_canceled`.
@@ -293,6 +451,9 @@ public:
         /// Returns the cached local endpoint.
         virtual endpoint local_endpoint() const noexcept = 0;
 
+        /// Returns the listening socket.
+        virtual native_handle_type native_handle() const noexcept = 0;
+
         /** Cancel any pending asynchronous operations.
 
             All outstanding operations complete with operation_canceled error.
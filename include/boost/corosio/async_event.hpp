@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_ASYNC_EVENT_HPP
+#define BOOST_COROSIO_ASYNC_EVENT_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <stop_token>
+
+namespace boost::corosio {
+
+/** An event that coroutines wait for.
+
+    Once @ref set, the event stays set until @ref reset: every
+    coroutine waiting is resumed, in the order it began waiting,
+    each through its own executor, and later waits complete at
+    once.
+
+    The event is lock-free: its state is one atomic word holding
+    either "set" or the stack of waiting coroutines.
+
+    Waiting is not cancelled by a stop request.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    corosio::async_event ready;
+
+    // Any number of coroutines
+    co_await ready.wait();
+
+    // Elsewhere, once
+    ready.set();
+    @endcode
+*/
+class BOOST_COROSIO_DECL async_event
+{
+    struct waiter
+    {
+        waiter* next = nullptr;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+    };
+
+    // Neither null, which means clear, nor a waiter address
+    static constexpr std::uintptr_t is_set_state = 1;
+
+    std::atomic<std::uintptr_t> state_;
+
+    // Returns true if w must suspend
+    bool enqueue(waiter& w) noexcept;
+
+    class wait_awaitable
+    {
+        async_event& e_;
+        waiter w_;
+
+    public:
+        explicit wait_awaitable(async_event& e) noexcept
+            : e_(e)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return e_.is_set();
+        }
+
+        template<typename Ex>
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token) noexcept
+        {
+            w_.h = h;
+            w_.ex = ex;
+            return e_.enqueue(w_);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    /** Construct an event.
+
+        @param initially_set `true` to start set.
+    */
+    explicit
+    async_event(bool initially_set = false) noexcept
+        : state_(initially_set ? is_set_state : 0)
+    {
+    }
+
+    /** Destroy the event.
+
+        No coroutine may be waiting.
+    */
+    ~async_event() = default;
+
+    async_event(async_event const&) = delete;
+    async_event& operator=(async_event const&) = delete;
+
+    /// Return `true` if the event is set.
+    bool
+    is_set() const noexcept
+    {
+        return state_.load(std::memory_order_acquire) == is_set_state;
+    }
+
+    /** Wait for the event to be set.
+
+        @return An awaitable that completes once the event is set.
+    */
+    auto wait() noexcept
+    {
+        return wait_awaitable(*this);
+    }
+
+    /** Set the event, resuming every waiting coroutine.
+
+        Each is posted to its executor, in the order it began
+        waiting. Setting an event already set does nothing.
+    */
+    void set() noexcept;
+
+    /// Clear the event, if set, so that later waits suspend.
+    void
+    reset() noexcept
+    {
+        std::uintptr_t expected = is_set_state;
+        state_.compare_exchange_strong(
+            expected, 0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
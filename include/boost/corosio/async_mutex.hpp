@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_ASYNC_MUTEX_HPP
+#define BOOST_COROSIO_ASYNC_MUTEX_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+
+namespace boost::corosio {
+
+/** A mutex for coroutines.
+
+    A coroutine that finds the mutex locked suspends instead of
+    blocking its thread, so the thread goes on running other work.
+    Unlocking hands the mutex straight to the longest waiting
+    coroutine, which resumes through its own executor already
+    holding it; a coroutine that did not wait cannot take it in
+    between.
+
+    The mutex is lock-free: its state is one atomic word, which
+    holds either "unlocked" or the stack of coroutines that began
+    waiting since the holder last looked. The holder alone turns
+    that stack into the queue it unlocks from.
+
+    Waiting is not cancelled by a stop request.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    corosio::async_mutex m;
+
+    auto g = co_await m.scoped_lock();
+    update_shared_state();
+    // unlocked when g is destroyed
+    @endcode
+*/
+class BOOST_COROSIO_DECL async_mutex
+{
+    struct waiter
+    {
+        waiter* next = nullptr;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+    };
+
+    // Neither null, which means locked, nor a waiter address
+    static constexpr std::uintptr_t unlocked = 1;
+
+    std::atomic<std::uintptr_t> state_{unlocked};
+
+    // Waiters in arrival order, touched only by the holder
+    waiter* waiters_ = nullptr;
+
+    // Returns true if w must suspend
+    bool enqueue(waiter& w) noexcept;
+
+    class lock_awaitable
+    {
+    protected:
+        async_mutex& m_;
+        waiter w_;
+
+    public:
+        explicit lock_awaitable(async_mutex& m) noexcept
+            : m_(m)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return m_.try_lock();
+        }
+
+        template<typename Ex>
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token) noexcept
+        {
+            w_.h = h;
+            w_.ex = ex;
+            return m_.enqueue(w_);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    /** Unlocks the mutex when destroyed.
+
+        Obtained from @ref scoped_lock, or made for a mutex
+        already locked by the caller.
+    */
+    class guard
+    {
+        async_mutex* m_;
+
+    public:
+        /// Take ownership of a lock on `m` held by the caller.
+        guard(async_mutex& m, std::adopt_lock_t) noexcept
+            : m_(&m)
+        {
+        }
+
+        guard(guard&& other) noexcept
+            : m_(std::exchange(other.m_, nullptr))
+        {
+        }
+
+        guard& operator=(guard&&) = delete;
+
+        /// Unlock, if not done already.
+        ~guard()
+        {
+            if (m_)
+                m_->unlock();
+        }
+
+        /// Unlock now.
+        void
+        unlock() noexcept
+        {
+            if (auto* m = std::exchange(m_, nullptr))
+                m->unlock();
+        }
+    };
+
+private:
+    class scoped_lock_awaitable : public lock_awaitable
+    {
+    public:
+        using lock_awaitable::lock_awaitable;
+
+        guard await_resume() const noexcept
+        {
+            return guard(m_, std::adopt_lock);
+        }
+    };
+
+public:
+    /// Construct an unlocked mutex.
+    async_mutex() noexcept = default;
+
+    /** Destroy the mutex.
+
+        It must be unlocked, with no coroutine waiting.
+    */
+    ~async_mutex() = default;
+
+    async_mutex(async_mutex const&) = delete;
+    async_mutex& operator=(async_mutex const&) = delete;
+
+    /** Lock the mutex if it is unlocked.
+
+        @return `true` if the caller now holds the mutex.
+    */
+    bool
+    try_lock() noexcept
+    {
+        std::uintptr_t expected = unlocked;
+        return state_.compare_exchange_strong(
+            expected, 0, std::memory_order_acquire,
+            std::memory_order_relaxed);
+    }
+
+    /** Lock the mutex, suspending until it is handed over.
+
+        @return An awaitable that completes holding the mutex.
+    */
+    auto lock() noexcept
+    {
+        return lock_awaitable(*this);
+    }
+
+    /** Lock the mutex, as by @ref lock.
+
+        @return An awaitable that completes with a @ref guard
+            that unlocks the mutex.
+    */
+    auto scoped_lock() noexcept
+    {
+        return scoped_lock_awaitable(*this);
+    }
+
+    /** Unlock the mutex.
+
+        If coroutines are waiting, the first to wait is handed the
+        mutex and posted to its executor.
+    */
+    void unlock() noexcept;
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_ASYNC_SEMAPHORE_HPP
+#define BOOST_COROSIO_ASYNC_SEMAPHORE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+
+namespace boost::corosio {
+
+/** A counting semaphore for coroutines.
+
+    A coroutine that finds no unit available suspends instead of
+    blocking its thread. Released units go to waiting coroutines
+    in the order they began waiting, each resumed through its own
+    executor already holding its unit.
+
+    Taking or returning a unit while nobody waits is one atomic
+    operation. A lock is taken only to queue a coroutine or to
+    hand units to queued ones.
+
+    Waiting is not cancelled by a stop request.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    corosio::async_semaphore slots(16);
+
+    co_await slots.acquire();
+    co_await upstream_call();
+    slots.release();
+    @endcode
+*/
+class BOOST_COROSIO_DECL async_semaphore
+{
+    struct waiter
+    {
+        waiter* next = nullptr;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+        bool done = false;
+    };
+
+    std::atomic<std::size_t> count_;
+    std::atomic<std::size_t> waiting_{0};
+
+    std::mutex mutex_;
+    waiter* head_ = nullptr;
+    waiter* tail_ = nullptr;
+
+    bool take() noexcept;
+    waiter* hand_out() noexcept;
+    static void wake(waiter* list, waiter const* self) noexcept;
+
+    // Returns true if w must suspend
+    bool enqueue(waiter& w);
+
+    class acquire_awaitable
+    {
+        async_semaphore& s_;
+        waiter w_;
+
+    public:
+        explicit acquire_awaitable(async_semaphore& s) noexcept
+            : s_(s)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            return s_.try_acquire();
+        }
+
+        template<typename Ex>
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token)
+        {
+            w_.h = h;
+            w_.ex = ex;
+            return s_.enqueue(w_);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    /** Construct a semaphore.
+
+        @param initial The number of units available.
+    */
+    explicit
+    async_semaphore(std::size_t initial) noexcept
+        : count_(initial)
+    {
+    }
+
+    /** Destroy the semaphore.
+
+        No coroutine may be waiting.
+    */
+    ~async_semaphore() = default;
+
+    async_semaphore(async_semaphore const&) = delete;
+    async_semaphore& operator=(async_semaphore const&) = delete;
+
+    /// Return the number of units available, which may be stale.
+    std::size_t
+    available() const noexcept
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /** Take a unit if one is available and nobody waits.
+
+        @return `true` if a unit was taken.
+    */
+    bool try_acquire() noexcept;
+
+    /** Take a unit, suspending until one is handed over.
+
+        @return An awaitable that completes holding a unit.
+    */
+    auto acquire() noexcept
+    {
+        return acquire_awaitable(*this);
+    }
+
+    /** Return units.
+
+        Waiting coroutines are handed units first, and posted to
+        their executors.
+
+        @param n The number of units returned.
+    */
+    void release(std::size_t n = 1);
+};
+
+} // namespace boost::corosio
+
+#endif
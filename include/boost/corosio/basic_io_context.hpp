@@ -12,15 +12,22 @@
 
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/detail/scheduler.hpp>
+#include <boost/corosio/op_tracer.hpp>
+#include <boost/corosio/scheduler_stats.hpp>
 #include <boost/capy/coro.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 
 #include <chrono>
 #include <cstddef>
 #include <limits>
+#include <span>
 
 namespace boost::corosio {
 
+namespace detail {
+struct io_context_access;
+} // namespace detail
+
 /** Base class for I/O context implementations.
 
     This class provides the common API for all I/O context types.
@@ -248,7 +255,128 @@ public:
         return sched_->poll_one();
     }
 
+    /** Process ready events, timers and handlers without blocking.
+
+        For driving the context from another event loop, such as a
+        GUI toolkit's or an existing reactor. The host waits on the
+        context's handle, `native_handle()` of @ref epoll_context,
+        @ref kqueue_context or @ref iocp_context, for at most
+        @ref poll_ready_timeout, then calls this function on the
+        same thread. It harvests the reactor once with a zero
+        timeout, processes expired timers, and runs every handler
+        that is ready, including those the handlers post.
+
+        Unlike @ref poll, finding no work does not stop the context,
+        so the host can keep calling it as work comes and goes.
+        After @ref stop it returns zero until @ref restart.
+
+        Posts from other threads, and timers scheduled earlier than
+        the nearest one, make the handle ready, so the host sleeps
+        no longer than a thread inside @ref run would.
+
+        Backends without a handle run what @ref poll would.
+
+        @par Example
+        @code
+        int const fd = ctx.native_handle();     // epoll_context
+        host.watch_readable(fd, [&] { ctx.poll_ready(); });
+        host.before_wait([&]
+        {
+            auto t = ctx.poll_ready_timeout();
+            if (t != std::chrono::milliseconds::max())
+                host.wake_within(t);
+        });
+        @endcode
+
+        @return The number of handlers executed.
+    */
+    std::size_t
+    poll_ready()
+    {
+        return sched_->poll_ready();
+    }
+
+    /** Return how long a host loop may wait before calling poll_ready.
+
+        Zero when the context has no handle to wait on, or work is
+        due already. When timers do not make the handle ready by
+        themselves, the time until the nearest expiry, rounded up.
+        Otherwise `std::chrono::milliseconds::max()`, meaning the
+        host may wait on the handle alone.
+
+        @see poll_ready
+    */
+    std::chrono::milliseconds
+    poll_ready_timeout() const
+    {
+        long const ms = sched_->poll_ready_timeout();
+        if (ms < 0)
+            return (std::chrono::milliseconds::max)();
+        return std::chrono::milliseconds(ms);
+    }
+
+    /** Return a snapshot of the event loop counters.
+
+        Safe to call from any thread, including while other threads
+        are running the context.
+
+        @see scheduler_stats
+    */
+    scheduler_stats
+    stats() const noexcept
+    {
+        scheduler_stats st;
+        sched_->collect_stats(st);
+        return st;
+    }
+
+    /** Return the time timers of this context measure from.
+
+        With @ref timer_options::cached_time on the epoll and
+        io_uring backends this is the clock sample of the last
+        reactor pass, which costs no clock read. With
+        @ref timer_options::virtual_time it is the virtual clock.
+        Otherwise it reads `std::chrono::steady_clock`.
+
+        @par Example
+        @code
+        auto deadline = ctx.now() + std::chrono::seconds(5);
+        t.expires_at(deadline);
+        @endcode
+    */
+    std::chrono::steady_clock::time_point
+    now() const noexcept
+    {
+        return sched_->now();
+    }
+
+    /** Trace the I/O operations of this context.
+
+        Each socket, acceptor and datagram operation started after
+        this call records when it was initiated, became ready, was
+        queued and was resumed, and is reported to `t` as it
+        resumes. A null tracer stops the tracing. Operations already
+        started keep the tracer they were started with, so a tracer
+        must outlive the operations it traces, or the context.
+
+        Tracing is available with the epoll and select backends.
+
+        @param t The tracer, or null.
+
+        @return `false` if this context cannot trace operations.
+
+        @see op_tracer, hdr_op_tracer
+    */
+    bool
+    set_op_tracer(op_tracer* t) noexcept
+    {
+        return sched_->trace_ops(t);
+    }
+
 protected:
+    friend class loop_monitor;
+    friend struct detail::io_context_access;
+
     /** Default constructor.
 
         Derived classes must set sched_ in their constructor body.
@@ -271,7 +399,12 @@ protected:
 
     Executors are lightweight handles that can be copied and compared
     for equality. Two executors compare equal if they refer to the
-    same context.
+    same context with the same priority.
+
+    An executor returned by @ref high_priority posts ahead of other
+    queued work, up to a bound that keeps the rest from starving, on
+    the epoll, select and IOCP backends. Other backends post it
+    normally.
 
     @par Thread Safety
     Distinct objects: Safe.@n
@@ -280,6 +413,7 @@ protected:
 class basic_io_context::executor_type
 {
     basic_io_context* ctx_ = nullptr;
+    bool high_ = false;
 
 public:
     /** Default constructor.
@@ -308,6 +442,30 @@ public:
         return *ctx_;
     }
 
+    /** Return an executor that posts with high priority.
+
+        Coroutines posted or dispatched through it, and coroutines
+        launched on it whenever they are resumed by a post, are
+        queued ahead of other handlers. Suited to control traffic
+        such as heartbeats that must not wait behind bulk work.
+
+        @return A copy of this executor with high priority.
+    */
+    executor_type
+    high_priority() const noexcept
+    {
+        auto ex = *this;
+        ex.high_ = true;
+        return ex;
+    }
+
+    /// Return `true` if this executor posts with high priority.
+    bool
+    is_high_priority() const noexcept
+    {
+        return high_;
+    }
+
     /** Check if the current thread is running this executor's context.
 
         @return `true` if `run()` is being called on this thread.
@@ -355,7 +513,7 @@ public:
     {
         if (running_in_this_thread())
             return h;
-        ctx_->sched_->post(h);
+        post(h);
         return std::noop_coroutine();
     }
 
@@ -369,27 +527,53 @@ public:
     void
     post(capy::coro h) const
     {
-        ctx_->sched_->post(h);
+        if (high_)
+            ctx_->sched_->post_high_priority(h);
+        else
+            ctx_->sched_->post(h);
+    }
+
+    /** Post several coroutines for deferred execution.
+
+        Equivalent to posting each handle in order, but the batch is
+        queued in one step and wakes as many idle threads as it has
+        handles, rather than paying for a queue update and a wakeup
+        per handle. Suited to fan-out, such as resuming every
+        subscriber of a channel.
+
+        @param hs The coroutine handles to post.
+    */
+    void
+    post_batch(std::span<capy::coro const> hs) const
+    {
+        if (high_)
+        {
+            for (auto h : hs)
+                ctx_->sched_->post_high_priority(h);
+        }
+        else
+            ctx_->sched_->post_batch(hs);
     }
 
     /** Compare two executors for equality.
 
-        @return `true` if both executors refer to the same context.
+        @return `true` if both executors refer to the same context
+            with the same priority.
     */
     bool
     operator==(executor_type const& other) const noexcept
     {
-        return ctx_ == other.ctx_;
+        return ctx_ == other.ctx_ && high_ == other.high_;
     }
 
     /** Compare two executors for inequality.
 
-        @return `true` if the executors refer to different contexts.
+        @return `true` if the executors differ in context or priority.
     */
     bool
     operator!=(executor_type const& other) const noexcept
     {
-        return ctx_ != other.ctx_;
+        return !(*this == other);
     }
 };
 
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_BUFFER_LEASE_HPP
+#define BOOST_COROSIO_BUFFER_LEASE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace boost::corosio {
+
+/** A buffer on loan from its owner.
+
+    A leased read completes with the bytes already in a buffer that the
+    I/O implementation chose, typically one drawn from a pool owned by
+    the I/O context. A @ref buffer_pool also hands out empty buffers
+    as leases. The lease gives the caller exclusive use of that
+    buffer until it is destroyed or @ref reset, which hands the buffer
+    back to its owner.
+
+    Leases should be returned promptly: a pool buffer held by a lease
+    is not available to any other socket. Every lease must be returned
+    before the I/O context that produced it is destroyed.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. A lease may be returned on any thread.
+*/
+class buffer_lease
+{
+public:
+    /** Function returning a buffer to its owner.
+
+        @param owner The owner passed at construction.
+        @param data The start of the buffer.
+        @param id The buffer id passed at construction.
+    */
+    using release_fn = void (*)(
+        void* owner, void* data, std::uint32_t id) noexcept;
+
+    /// Construct an empty lease.
+    buffer_lease() = default;
+
+    /** Construct a lease on a buffer owned by `owner`.
+
+        @param data The received bytes.
+        @param size The number of received bytes.
+        @param release Called once to return the buffer.
+        @param owner Passed to `release`.
+        @param id Passed to `release`.
+    */
+    buffer_lease(
+        void* data,
+        std::size_t size,
+        release_fn release,
+        void* owner,
+        std::uint32_t id = 0) noexcept
+        : data_(data)
+        , size_(size)
+        , release_(release)
+        , owner_(owner)
+        , id_(id)
+    {
+    }
+
+    /** Construct a lease owning a heap buffer.
+
+        @param data The buffer, of which the first `size` bytes
+            were received.
+        @param size The number of received bytes.
+    */
+    buffer_lease(
+        std::unique_ptr<unsigned char[]> data,
+        std::size_t size) noexcept
+        : data_(data.release())
+        , size_(size)
+        , release_(&release_heap)
+    {
+    }
+
+    buffer_lease(buffer_lease&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , release_(std::exchange(other.release_, nullptr))
+        , owner_(std::exchange(other.owner_, nullptr))
+        , id_(std::exchange(other.id_, 0))
+    {
+    }
+
+    buffer_lease&
+    operator=(buffer_lease&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            release_ = std::exchange(other.release_, nullptr);
+            owner_ = std::exchange(other.owner_, nullptr);
+            id_ = std::exchange(other.id_, 0);
+        }
+        return *this;
+    }
+
+    buffer_lease(buffer_lease const&) = delete;
+    buffer_lease& operator=(buffer_lease const&) = delete;
+
+    /// Return the buffer to its owner.
+    ~buffer_lease()
+    {
+        reset();
+    }
+
+    /// Return a pointer to the received bytes.
+    void*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+    /// Return the number of received bytes.
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return `true` if the lease holds no buffer.
+    bool
+    empty() const noexcept
+    {
+        return data_ == nullptr;
+    }
+
+    /// Return the received bytes as a buffer.
+    capy::const_buffer
+    buffer() const noexcept
+    {
+        return capy::const_buffer(data_, size_);
+    }
+
+    /// Return the buffer for writing, as for a lease from a @ref buffer_pool.
+    operator capy::mutable_buffer() const noexcept
+    {
+        return capy::mutable_buffer(data_, size_);
+    }
+
+    /** Keep only the first `n` bytes.
+
+        Used after reading into a lease taken from a pool, to
+        leave only the bytes that were read. The whole buffer is
+        still returned to its owner.
+
+        @param n The new size, no greater than @ref size.
+    */
+    void
+    shrink(std::size_t n) noexcept
+    {
+        if (n < size_)
+            size_ = n;
+    }
+
+    /// Return the buffer to its owner, leaving the lease empty.
+    void
+    reset() noexcept
+    {
+        if (data_ && release_)
+            release_(owner_, data_, id_);
+        data_ = nullptr;
+        size_ = 0;
+        release_ = nullptr;
+        owner_ = nullptr;
+        id_ = 0;
+    }
+
+private:
+    static void
+    release_heap(void*, void* data, std::uint32_t) noexcept
+    {
+        delete[] static_cast<unsigned char*>(data);
+    }
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    release_fn release_ = nullptr;
+    void* owner_ = nullptr;
+    std::uint32_t id_ = 0;
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_BUFFER_POOL_HPP
+#define BOOST_COROSIO_BUFFER_POOL_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/buffer_lease.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost::corosio {
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // class needs to have dll-interface
+#endif
+
+/** A pool of I/O buffers shared by the objects of an execution context.
+
+    Buffers come in power-of-two size classes from @ref min_size to
+    @ref max_size. A buffer returned to the pool first goes to a small
+    cache of the returning thread, from which the next request of that
+    thread for the same class is served without a lock; when the
+    cache is full it goes to a list shared by all threads, and when
+    that holds @ref max_cached_bytes it is freed. Larger requests are
+    served by the global allocator.
+
+    A buffer is handed out as a @ref buffer_lease whose size is that of
+    its class, at least the size requested. Destroying the lease
+    returns the buffer, so a connection that takes a buffer only when
+    it has data to read or write, and drops it when done, holds no
+    memory while idle. Leased reads on sockets do this by waiting for
+    readability before taking a buffer.
+
+    New buffers come from the global allocator on the thread that
+    first needs them, so the pool of a context run by a thread bound
+    to a NUMA node, as with `io_context_pool::affinity::per_node`,
+    holds that node's memory.
+
+    The pool of a context is created on first use by
+    @ref get_buffer_pool. Every lease must be returned before the
+    context is destroyed.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    auto& pool = corosio::get_buffer_pool(ioc);
+    auto buf = pool.acquire(16384);
+    auto [ec, n] = co_await s.read_some(capy::mutable_buffer(buf));
+    buf.shrink(n);
+    @endcode
+*/
+class BOOST_COROSIO_DECL buffer_pool
+    : public capy::execution_context::service
+{
+public:
+    /// The smallest size class.
+    static constexpr std::size_t min_size = 512;
+
+    /// The largest size class; larger buffers are not pooled.
+    static constexpr std::size_t max_size = 65536;
+
+    /// Counters of the pool's use.
+    struct statistics
+    {
+        /// Bytes held by outstanding leases of pooled sizes.
+        std::size_t leased_bytes = 0;
+
+        /// Bytes in the list shared by all threads.
+        std::size_t cached_bytes = 0;
+
+        /// Requests served from a cache or the shared list.
+        std::uint64_t hits = 0;
+
+        /// Requests served by the global allocator.
+        std::uint64_t misses = 0;
+    };
+
+    /// Construct the pool of `ctx`; see @ref get_buffer_pool.
+    explicit buffer_pool(capy::execution_context& ctx);
+
+    /// Free the buffers held by the pool.
+    ~buffer_pool();
+
+    buffer_pool(buffer_pool const&) = delete;
+    buffer_pool& operator=(buffer_pool const&) = delete;
+
+    /** Take a buffer of at least `size` bytes.
+
+        @param size The number of bytes needed.
+
+        @return A lease on the buffer, sized to its class.
+
+        @throws std::bad_alloc if memory is exhausted.
+    */
+    buffer_lease acquire(std::size_t size);
+
+    /** Set the most bytes the shared list keeps.
+
+        Defaults to 4 MiB. Lowering it does not free buffers
+        already cached; call @ref trim for that.
+    */
+    void set_max_cached_bytes(std::size_t bytes) noexcept;
+
+    /// Return the most bytes the shared list keeps.
+    std::size_t max_cached_bytes() const noexcept;
+
+    /** Free the cached buffers.
+
+        Frees the shared list and the cache of the calling thread.
+        Caches of other threads are freed when those threads exit.
+    */
+    void trim() noexcept;
+
+    /// Return the pool's counters.
+    statistics stats() const noexcept;
+
+protected:
+    void shutdown() override;
+
+private:
+    struct state;
+
+    static void release(void* owner, void* data, std::uint32_t id) noexcept;
+
+    std::unique_ptr<state> state_;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+/** Return the buffer pool of an execution context.
+
+    The pool is created on first use and lives as long as the
+    context.
+
+    @param ctx The execution context, usually an @ref io_context.
+*/
+BOOST_COROSIO_DECL
+buffer_pool&
+get_buffer_pool(capy::execution_context& ctx);
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_BUFFERED_STREAM_HPP
+#define BOOST_COROSIO_BUFFERED_STREAM_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/task.hpp>
+
+#include <cstddef>
+
+namespace boost::corosio {
+
+/** A read buffer in front of a stream.
+
+    Received bytes are kept in a ring buffer whose readable bytes
+    are always contiguous, so a parser can look at @ref data without
+    the buffer ever being compacted. Where the platform allows, the
+    ring is mapped twice in a row into virtual memory, so that bytes
+    past its end appear again at its start; a read then fills all of
+    the free space, across the wrap, with one system call. Elsewhere
+    the ring is a plain buffer whose contents are moved to its front
+    when the free space at its end runs out.
+
+    @ref fill reads as much as the free space holds, whatever the
+    caller needs right now, so a stream of small messages costs
+    one read per buffer full rather than one per message.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe.
+
+    @par Example
+    @code
+    corosio::buffered_stream bs(sock);
+    for (;;)
+    {
+        auto [ec, n] = co_await bs.fill();
+        if (ec)
+            break;
+        std::size_t used = parse(bs.data());
+        bs.consume(used);
+    }
+    @endcode
+*/
+class BOOST_COROSIO_DECL buffered_stream
+{
+public:
+    /// The capacity used when none is given.
+    static constexpr std::size_t default_capacity = 65536;
+
+    /** Construct a buffered stream over `s`.
+
+        @param s The stream to read from. It must outlive this
+            object.
+
+        @param capacity The number of bytes the ring holds. A
+            mirrored ring rounds it up to a multiple of the page
+            size.
+
+        @throws std::bad_alloc if memory is exhausted.
+    */
+    explicit
+    buffered_stream(
+        io_stream& s,
+        std::size_t capacity = default_capacity);
+
+    /// Free the ring.
+    ~buffered_stream();
+
+    buffered_stream(buffered_stream const&) = delete;
+    buffered_stream& operator=(buffered_stream const&) = delete;
+
+    /// Return the stream read from.
+    io_stream&
+    next_layer() const noexcept
+    {
+        return s_;
+    }
+
+    /// Return the number of bytes the ring holds.
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    /// Return the number of readable bytes.
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return `true` if the ring is mapped twice.
+    bool
+    is_mirrored() const noexcept
+    {
+        return mirrored_;
+    }
+
+    /// Return the readable bytes, which are always contiguous.
+    capy::const_buffer
+    data() const noexcept
+    {
+        return capy::const_buffer(base_ + head_, size_);
+    }
+
+    /** Remove bytes from the front of the readable bytes.
+
+        @param n The number of bytes to remove. Larger values
+            remove all of them.
+    */
+    void
+    consume(std::size_t n) noexcept;
+
+    /** Return free space for `n` bytes after the readable bytes.
+
+        The space is contiguous. Bytes written to it become
+        readable when passed to @ref commit.
+
+        @param n The number of bytes needed.
+
+        @throws std::length_error if `n` exceeds
+            `capacity() - size()`.
+    */
+    capy::mutable_buffer
+    prepare(std::size_t n);
+
+    /** Make bytes written to the prepared space readable.
+
+        @param n The number of bytes written. Larger values are
+            limited to the free space.
+    */
+    void
+    commit(std::size_t n) noexcept;
+
+    /** Read into the free space of the ring.
+
+        Reads once from the stream, into all of the free space.
+
+        @return A task that completes with the number of bytes
+            read. It fails with `errc::no_buffer_space` if the ring
+            is full, and otherwise with the errors of
+            @ref io_stream::read_some.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    fill();
+
+    /** Read bytes, through the ring.
+
+        Readable bytes are copied out first. When there are none, a
+        request at least as large as the ring is read straight into
+        `buffer`; a smaller one first fills the ring.
+
+        @param buffer The buffer to read into.
+
+        @return A task that completes as for
+            @ref io_stream::read_some.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    read_some(capy::mutable_buffer buffer);
+
+private:
+    io_stream& s_;
+    char* base_ = nullptr;
+    std::size_t cap_ = 0;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    bool mirrored_ = false;
+};
+
+} // namespace boost::corosio
+
+#endif
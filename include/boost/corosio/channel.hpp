@@ -0,0 +1,561 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_CHANNEL_HPP
+#define BOOST_COROSIO_CHANNEL_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+/*
+    Channel
+    =======
+
+    Values travel through a bounded ring in which each cell carries
+    a sequence number (the Vyukov MPMC queue). A sender claims the
+    cell at tail_ with a CAS when its sequence says it is empty for
+    that lap, and publishes the value with a release store of the
+    next sequence; a receiver does the same at head_. Neither side
+    ever takes a lock to move a value through the ring.
+
+    Parking
+    -------
+    A sender that finds the ring full, or a receiver that finds it
+    empty, takes wait_mutex_, counts itself in waiting_, links its
+    waiter into the matching list and then pumps: moves the values
+    of parked senders into the ring and the values in the ring to
+    parked receivers, in order, until neither can progress. If the
+    pump completed its own waiter, it does not suspend.
+
+    A side that succeeds on the ring without parking looks at
+    waiting_ after a full fence, and pumps only if someone is
+    parked. The parker's increment and the fast side's ring access
+    are both followed by full fences, so one of them always sees
+    the other: a value pushed as a receiver parks is handed to it
+    either by the receiver's own pump or by the sender's.
+
+    Waking
+    ------
+    Completed waiters are resumed after the lock is released,
+    through dispatch on their own executor. When the waker runs on
+    that executor's thread this resumes the peer directly, as a
+    nested call, without queuing it on the scheduler; otherwise the
+    peer is posted to its executor.
+*/
+
+namespace boost::corosio {
+
+/** A bounded queue of values between coroutines.
+
+    Any number of coroutines, on any threads, may send and receive
+    at once. @ref send suspends while the channel is full and
+    @ref receive while it is empty; each completes as soon as a
+    peer makes room or provides a value. Values sent by one
+    coroutine are received in the order sent.
+
+    The values are kept in a lock-free ring, so a channel that is
+    neither full nor empty moves values without locking or
+    suspending. A lock is taken only to park a coroutine or to
+    wake one.
+
+    @ref close ends the channel: sends fail with
+    `errc::broken_pipe`, and receives fail with `capy::error::eof`
+    once the values already sent have been received.
+
+    Suspended sends and receives are not cancelled by a stop
+    request; close the channel to release them.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    corosio::channel<message> ch(64);
+
+    // Producer
+    co_await ch.send(parse(frame));
+
+    // Consumer
+    for (;;)
+    {
+        auto [ec, msg] = co_await ch.receive();
+        if (ec)
+            break;
+        route(msg);
+    }
+    @endcode
+
+    @tparam T The type of value sent. It must be default
+        constructible and move constructible.
+*/
+template<class T>
+class channel
+{
+    struct cell
+    {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* get() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    struct waiter
+    {
+        waiter* next = nullptr;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+        T* value = nullptr;
+        std::optional<T>* slot = nullptr;
+        system::error_code ec;
+        bool done = false;
+    };
+
+    struct wait_list
+    {
+        waiter* head = nullptr;
+        waiter* tail = nullptr;
+
+        void push(waiter* w) noexcept
+        {
+            w->next = nullptr;
+            if (tail)
+                tail->next = w;
+            else
+                head = w;
+            tail = w;
+        }
+
+        waiter* pop() noexcept
+        {
+            waiter* w = head;
+            if (w)
+            {
+                head = w->next;
+                if (!head)
+                    tail = nullptr;
+                w->next = nullptr;
+            }
+            return w;
+        }
+    };
+
+    std::unique_ptr<cell[]> cells_;
+    std::size_t mask_;
+
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> waiting_{0};
+    std::atomic<bool> closed_{false};
+
+    std::mutex wait_mutex_;
+    wait_list senders_;
+    wait_list receivers_;
+
+    static std::size_t
+    round_capacity(std::size_t n) noexcept
+    {
+        std::size_t c = 2;
+        while (c < n)
+            c <<= 1;
+        return c;
+    }
+
+    // Moves from v only on success
+    bool
+    try_push(T& v)
+    {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;)
+        {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) -
+                static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (tail_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(c->storage)) T(std::move(v));
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool
+    try_pop(std::optional<T>& out)
+    {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;)
+        {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) -
+                static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        T* p = c->get();
+        out.emplace(std::move(*p));
+        p->~T();
+        c->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Completes what parked waiters can, under the lock, adding
+    // them to wake to be resumed once it is released
+    void
+    pump(wait_list& wake)
+    {
+        for (;;)
+        {
+            bool progress = false;
+            while (senders_.head && try_push(*senders_.head->value))
+            {
+                waiter* w = senders_.pop();
+                w->done = true;
+                waiting_.fetch_sub(1, std::memory_order_relaxed);
+                wake.push(w);
+                progress = true;
+            }
+            while (receivers_.head && try_pop(*receivers_.head->slot))
+            {
+                waiter* w = receivers_.pop();
+                w->done = true;
+                waiting_.fetch_sub(1, std::memory_order_relaxed);
+                wake.push(w);
+                progress = true;
+            }
+            if (!progress)
+                break;
+        }
+
+        if (closed_.load(std::memory_order_relaxed))
+        {
+            // Parked senders are refused, and parked receivers
+            // found the ring empty
+            while (waiter* w = senders_.pop())
+            {
+                w->ec = make_error_code(system::errc::broken_pipe);
+                w->done = true;
+                waiting_.fetch_sub(1, std::memory_order_relaxed);
+                wake.push(w);
+            }
+            while (waiter* w = receivers_.pop())
+            {
+                w->ec = make_error_code(capy::error::eof);
+                w->done = true;
+                waiting_.fetch_sub(1, std::memory_order_relaxed);
+                wake.push(w);
+            }
+        }
+    }
+
+    static void
+    wake_all(wait_list& wake, waiter const* self = nullptr)
+    {
+        while (waiter* w = wake.pop())
+        {
+            // The parker completed by its own pump does not suspend
+            if (w == self)
+                continue;
+            auto h = w->h;
+            auto r = w->ex.dispatch(h);
+            if (r.address() == h.address())
+                r.resume();
+        }
+    }
+
+    // After a value moved through the ring without parking
+    void
+    notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_.load(std::memory_order_relaxed) == 0)
+            return;
+        wait_list wake;
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            pump(wake);
+        }
+        wake_all(wake);
+    }
+
+    // Links w into list and pumps. Returns true if w must suspend.
+    bool
+    park(wait_list& list, waiter& w)
+    {
+        wait_list wake;
+        bool suspend;
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            waiting_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            list.push(&w);
+            pump(wake);
+
+            // Once the lock is released, a peer may resume w at any
+            // time, so w is not looked at again
+            suspend = !w.done;
+        }
+        wake_all(wake, &w);
+        return suspend;
+    }
+
+    class send_awaitable
+    {
+        channel& ch_;
+        T value_;
+        waiter w_;
+
+    public:
+        send_awaitable(channel& ch, T value)
+            : ch_(ch)
+            , value_(std::move(value))
+        {
+        }
+
+        bool await_ready()
+        {
+            if (ch_.closed_.load(std::memory_order_acquire))
+            {
+                w_.ec = make_error_code(system::errc::broken_pipe);
+                return true;
+            }
+            if (!ch_.try_push(value_))
+                return false;
+            ch_.notify();
+            return true;
+        }
+
+        template<typename Ex>
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token)
+        {
+            w_.h = h;
+            w_.ex = ex;
+            w_.value = &value_;
+            return ch_.park(ch_.senders_, w_);
+        }
+
+        capy::io_result<> await_resume() const noexcept
+        {
+            return {w_.ec};
+        }
+    };
+
+    class receive_awaitable
+    {
+        channel& ch_;
+        std::optional<T> slot_;
+        waiter w_;
+
+    public:
+        explicit receive_awaitable(channel& ch) noexcept
+            : ch_(ch)
+        {
+        }
+
+        bool await_ready()
+        {
+            if (!ch_.try_pop(slot_))
+                return false;
+            ch_.notify();
+            return true;
+        }
+
+        template<typename Ex>
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token)
+        {
+            w_.h = h;
+            w_.ex = ex;
+            w_.slot = &slot_;
+            return ch_.park(ch_.receivers_, w_);
+        }
+
+        capy::io_result<T> await_resume()
+        {
+            if (w_.ec)
+                return {w_.ec, T{}};
+            return {{}, std::move(*slot_)};
+        }
+    };
+
+public:
+    /** Construct a channel.
+
+        @param capacity The number of values held before senders
+            suspend, rounded up to a power of two no less than 2.
+    */
+    explicit
+    channel(std::size_t capacity)
+        : cells_(new cell[round_capacity(capacity)])
+        , mask_(round_capacity(capacity) - 1)
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    /** Destroy the channel and the values still in it.
+
+        No coroutine may be suspended on the channel.
+    */
+    ~channel()
+    {
+        std::optional<T> v;
+        while (try_pop(v))
+            v.reset();
+    }
+
+    channel(channel const&) = delete;
+    channel& operator=(channel const&) = delete;
+
+    /// Return the number of values held before senders suspend.
+    std::size_t
+    capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    /// Return the number of values held, which may be stale.
+    std::size_t
+    size() const noexcept
+    {
+        std::size_t t = tail_.load(std::memory_order_relaxed);
+        std::size_t h = head_.load(std::memory_order_relaxed);
+        return t > h ? t - h : 0;
+    }
+
+    /// Return `true` if @ref close was called.
+    bool
+    is_closed() const noexcept
+    {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    /** Send a value, suspending while the channel is full.
+
+        @param value The value to send.
+
+        @return An awaitable that completes with `io_result<>`,
+            failing with `errc::broken_pipe` if the channel is
+            closed.
+    */
+    auto send(T value)
+    {
+        return send_awaitable(*this, std::move(value));
+    }
+
+    /** Receive a value, suspending while the channel is empty.
+
+        @return An awaitable that completes with `io_result<T>`,
+            failing with `capy::error::eof` once the channel is
+            closed and empty.
+    */
+    auto receive()
+    {
+        return receive_awaitable(*this);
+    }
+
+    /** Send a value without suspending.
+
+        @param value The value to send, moved from only on success.
+
+        @return `true` if the value was sent, `false` if the channel
+            is full or closed.
+    */
+    bool
+    try_send(T& value)
+    {
+        if (closed_.load(std::memory_order_acquire))
+            return false;
+        if (!try_push(value))
+            return false;
+        notify();
+        return true;
+    }
+
+    /** Receive a value without suspending.
+
+        @return The value, or an empty optional if the channel is
+            empty.
+    */
+    std::optional<T>
+    try_receive()
+    {
+        std::optional<T> v;
+        if (try_pop(v))
+            notify();
+        return v;
+    }
+
+    /** Close the channel.
+
+        Suspended senders fail, and so do suspended receivers, since
+        a receiver suspends only when the channel is empty. Values
+        already sent remain to be received.
+    */
+    void
+    close()
+    {
+        closed_.store(true, std::memory_order_release);
+        wait_list wake;
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            pump(wake);
+        }
+        wake_all(wake);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_CONNECT_HPP
+#define BOOST_COROSIO_CONNECT_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/resolver_results.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <stop_token>
+
+namespace boost::corosio {
+
+namespace detail {
+
+/** Start connecting to the first endpoint of a range that answers.
+
+    @return `true` if the operation completed at once.
+*/
+BOOST_COROSIO_DECL
+bool
+connect_range(
+    socket& s,
+    resolver_results const& results,
+    std::chrono::milliseconds attempt_delay,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    endpoint* ep);
+
+struct connect_range_awaitable
+{
+    socket& s_;
+    resolver_results results_;
+    std::chrono::milliseconds attempt_delay_;
+    std::stop_token token_;
+    mutable system::error_code ec_;
+    mutable endpoint ep_;
+
+    bool await_ready() const noexcept
+    {
+        return token_.stop_requested();
+    }
+
+    capy::io_result<endpoint> await_resume() const noexcept
+    {
+        if (token_.stop_requested() && ec_)
+            return {make_error_code(system::errc::operation_canceled), ep_};
+        return {ec_, ep_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        token_ = std::move(token);
+        if (connect_range(s_, results_, attempt_delay_,
+                h, ex, token_, &ec_, &ep_))
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+} // namespace detail
+
+/** Connect a socket to a host, trying its addresses in parallel.
+
+    Implements Happy Eyeballs (RFC 8305). The resolved endpoints
+    are reordered to alternate between IPv6 and IPv4, starting with
+    the family of the first one. A connection attempt is started on
+    each in turn, the next one as soon as the previous fails or
+    after `attempt_delay` without an answer, so that an address
+    that does not respond costs only the delay instead of a full
+    connect timeout. The first attempt to succeed wins and the
+    others are cancelled.
+
+    Each attempt uses a socket of its own, opened for the family of
+    its endpoint on the context of `s`. The winning socket then
+    replaces `s`, closing any socket `s` had.
+
+    @par Example
+    @code
+    auto [rec, results] = co_await r.resolve("www.example.com", "https");
+    if (rec)
+        co_return;
+    corosio::socket s(ioc);
+    auto [ec, ep] = co_await corosio::connect(s, results);
+    @endcode
+
+    @param s The socket to connect.
+
+    @param results The endpoints to try.
+
+    @param attempt_delay The time to wait for an attempt before
+        starting the next one.
+
+    @return An awaitable that completes with
+        `io_result<endpoint>`, holding the endpoint connected to.
+        On failure the error is that of the last attempt, or
+        `errc::invalid_argument` if `results` is empty.
+*/
+inline
+auto
+connect(
+    socket& s,
+    resolver_results results,
+    std::chrono::milliseconds attempt_delay =
+        std::chrono::milliseconds(250))
+{
+    return detail::connect_range_awaitable{
+        s, std::move(results), attempt_delay};
+}
+
+} // namespace boost::corosio
+
+#endif
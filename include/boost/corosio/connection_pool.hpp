@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_CONNECTION_POOL_HPP
+#define BOOST_COROSIO_CONNECTION_POOL_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace boost::corosio {
+
+/** A pool of warm outbound connections, keyed by endpoint.
+
+    @ref checkout hands out an idle connection to the endpoint when
+    there is one, and connects a new one otherwise, so a client
+    that keeps talking to the same upstreams pays for the connect
+    once rather than once per request. @ref checkin returns a
+    connection for reuse; a connection destroyed without being
+    checked in is closed.
+
+    At most `max_per_host` connections to one endpoint are open at
+    a time, idle or checked out. A checkout past that waits, in
+    order, for one of them to be checked in or closed.
+
+    While idle, each connection waits to become readable. A
+    connection the peer closed, or that received bytes nobody asked
+    for, cannot be reused, so it is closed as soon as that happens
+    rather than handed to the next checkout. Where the backend has
+    no readiness waits, idle connections are kept unchecked. A
+    connection idle for longer than `idle_timeout` is closed.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. A pool belongs to one context and is
+    used from its thread, so it takes no locks; a program running
+    an @ref io_context_pool makes one connection pool per shard.
+
+    @par Example
+    @code
+    corosio::connection_pool pool(ioc);
+
+    auto [ec, conn] = co_await pool.checkout(ep);
+    if (ec)
+        co_return;
+    co_await conn->write_all(request);
+    co_await conn->read_some(response);
+    pool.checkin(std::move(conn));
+    @endcode
+*/
+class BOOST_COROSIO_DECL connection_pool
+{
+    struct state;
+    struct host;
+
+public:
+    /// Limits applied to every endpoint.
+    struct options
+    {
+        /// The most connections open to one endpoint.
+        std::size_t max_per_host = 8;
+
+        /// How long a connection may stay idle before it is closed.
+        std::chrono::steady_clock::duration idle_timeout =
+            std::chrono::seconds(30);
+    };
+
+    /** A connection checked out of a pool.
+
+        Owns the socket until it is checked in. Destroying a
+        connection that still owns its socket closes it, which
+        frees its place under `max_per_host`.
+    */
+    class BOOST_COROSIO_DECL connection
+    {
+        friend class connection_pool;
+
+        std::shared_ptr<state> st_;
+        host* host_ = nullptr;
+        std::optional<socket> sock_;
+
+        connection(
+            std::shared_ptr<state> st,
+            host* h,
+            socket&& s) noexcept;
+
+    public:
+        /// Construct a connection that owns no socket.
+        connection() noexcept;
+
+        /// Close the socket, if one is owned.
+        ~connection();
+
+        connection(connection&& other) noexcept;
+        connection& operator=(connection&& other) noexcept;
+
+        connection(connection const&) = delete;
+        connection& operator=(connection const&) = delete;
+
+        /// Return `true` if a socket is owned.
+        explicit operator bool() const noexcept
+        {
+            return sock_.has_value();
+        }
+
+        /// Return the socket.
+        socket&
+        get() noexcept
+        {
+            return *sock_;
+        }
+
+        socket&
+        operator*() noexcept
+        {
+            return *sock_;
+        }
+
+        socket*
+        operator->() noexcept
+        {
+            return &*sock_;
+        }
+
+    private:
+        void reset() noexcept;
+    };
+
+    /** Construct a pool for connections on `ctx`.
+
+        @param ctx The context the connections belong to, whose
+            thread uses the pool.
+    */
+    explicit
+    connection_pool(basic_io_context& ctx);
+
+    /** Construct a pool for connections on `ctx`.
+
+        @param ctx The context the connections belong to, whose
+            thread uses the pool.
+
+        @param opts The limits to apply.
+    */
+    connection_pool(
+        basic_io_context& ctx,
+        options opts);
+
+    /// Close the pool, as if by @ref close.
+    ~connection_pool();
+
+    connection_pool(connection_pool const&) = delete;
+    connection_pool& operator=(connection_pool const&) = delete;
+
+    /** Take a connection to an endpoint.
+
+        An idle connection is preferred, the most recently used
+        first. Otherwise a new one is connected, once there are
+        fewer than `max_per_host` open.
+
+        @param ep The endpoint to connect to.
+
+        @return A task that completes with the connection. It
+            fails with the error of the connect, or with
+            `errc::operation_canceled` if the pool is closed.
+    */
+    capy::task<capy::io_result<connection>>
+    checkout(endpoint ep);
+
+    /** Return a connection for reuse.
+
+        A connection whose socket was closed, or one returned after
+        the pool was closed, is dropped instead.
+
+        @param c The connection, which then owns no socket.
+    */
+    void
+    checkin(connection c);
+
+    /** Close the pool.
+
+        Idle connections are closed, waiting checkouts fail, and
+        connections checked in later are closed. Connections
+        already checked out are unaffected.
+    */
+    void
+    close();
+
+    /// Return the number of idle connections.
+    std::size_t
+    idle_size() const noexcept;
+
+    /// Return the number of open connections, idle or checked out.
+    std::size_t
+    size() const noexcept;
+
+private:
+    std::shared_ptr<state> st_;
+};
+
+} // namespace boost::corosio
+
+#endif
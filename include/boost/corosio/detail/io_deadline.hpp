@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_DEADLINE_HPP
+#define BOOST_COROSIO_DETAIL_IO_DEADLINE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace boost::corosio::detail {
+
+/** The deadline of one operation slot of an I/O object.
+
+    Holds a timer node of the context's timer service and a stop
+    source that the node stops when it expires. An operation started
+    with the token returned by @ref arm is then cancelled by the
+    backend like any other stop request, and the awaitable reports
+    the cancellation as `errc::timed_out` when @ref expired is set.
+
+    The node and the stop source are kept between operations, so an
+    operation with a deadline allocates nothing once the object has
+    used its slot. The stop source is only replaced after it fired.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. One operation uses a slot at a time.
+*/
+class BOOST_COROSIO_DECL io_deadline
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+    explicit io_deadline(capy::execution_context& ctx);
+    ~io_deadline();
+
+    io_deadline(io_deadline const&) = delete;
+    io_deadline& operator=(io_deadline const&) = delete;
+
+    /** Start the deadline of an operation.
+
+        @param t The time at which the operation is cancelled.
+        @param caller The stop token of the awaiting coroutine, whose
+            stop requests are forwarded.
+
+        @return The token to start the operation with.
+    */
+    std::stop_token arm(time_point t, std::stop_token const& caller);
+
+    /** End the deadline of the operation.
+
+        On return the expiry can no longer fire. Call this before
+        reading @ref expired.
+    */
+    void disarm() noexcept;
+
+    /// Return `true` if the deadline cancelled the operation.
+    bool expired() const noexcept
+    {
+        return fired_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct forward_stop
+    {
+        io_deadline* self;
+        void operator()() const noexcept;
+    };
+
+    static void on_expiry(void* p) noexcept;
+
+    io_object::io_object_impl* timer_ = nullptr;
+    std::stop_source source_;
+    std::optional<std::stop_callback<forward_stop>> caller_cb_;
+    std::atomic<bool> fired_{false};
+};
+
+/** An I/O awaitable given a deadline.
+
+    Starts the wrapped operation with the token of an armed
+    @ref io_deadline and reports an expiry as `errc::timed_out`.
+*/
+template<class Awaitable>
+struct deadline_awaitable : Awaitable
+{
+    io_deadline& dl_;
+    io_deadline::time_point t_;
+
+    template<class... Args>
+    deadline_awaitable(
+        io_deadline& dl,
+        io_deadline::time_point t,
+        Args&&... args) noexcept
+        : Awaitable(std::forward<Args>(args)...)
+        , dl_(dl)
+        , t_(t)
+    {
+    }
+
+    auto await_resume() const noexcept
+    {
+        dl_.disarm();
+        auto r = Awaitable::await_resume();
+        if (dl_.expired())
+            r.ec = make_error_code(system::errc::timed_out);
+        return r;
+    }
+
+    template<typename Ex>
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        Ex const& ex) -> std::coroutine_handle<>
+    {
+        return Awaitable::await_suspend(h, ex, dl_.arm(t_, {}));
+    }
+
+    template<typename Ex>
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        Ex const& ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        return Awaitable::await_suspend(h, ex, dl_.arm(t_, token));
+    }
+};
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -27,6 +27,13 @@
 #  define BOOST_COROSIO_HAS_EPOLL 0
 #endif
 
+// io_uring - Linux completion rings, opt-in at build time
+#if defined(__linux__) && defined(BOOST_COROSIO_USE_IO_URING)
+#  define BOOST_COROSIO_HAS_IO_URING 1
+#else
+#  define BOOST_COROSIO_HAS_IO_URING 0
+#endif
+
 // kqueue - BSD/macOS event notification
 #if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || \
     defined(__NetBSD__) || defined(__DragonFly__)
@@ -42,6 +49,13 @@
 #  define BOOST_COROSIO_HAS_SELECT 0
 #endif
 
+// poll - POSIX portable, without select's FD_SETSIZE limit
+#if !defined(_WIN32)
+#  define BOOST_COROSIO_HAS_POLL 1
+#else
+#  define BOOST_COROSIO_HAS_POLL 0
+#endif
+
 // POSIX APIs (signals, resolver, etc.)
 #if !defined(_WIN32)
 #  define BOOST_COROSIO_POSIX 1
@@ -11,20 +11,80 @@
 #define BOOST_COROSIO_DETAIL_SCHEDULER_HPP
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/scheduler_stats.hpp>
 #include <boost/capy/coro.hpp>
+#include <boost/capy/ex/execution_context.hpp>
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace boost::corosio {
+class op_tracer;
+struct parked_op;
+} // namespace boost::corosio
 
 namespace boost::corosio::detail {
 
 class scheduler_op;
 
+/// A service a backend may create on first use instead of up front.
+enum class deferred_service
+{
+    socket,
+    acceptor,
+    udp,
+    resolver,
+    file,
+    signal
+};
+
+/** What one thread inside run() is doing, see scheduler::sample_handlers. */
+struct handler_sample
+{
+    using time_point = std::chrono::steady_clock::time_point;
+
+    std::thread::id thread;
+
+    /// The handler running now, or null if none or not timed.
+    void const* running = nullptr;
+    time_point running_since;
+
+    /// The longest handler the thread has run while timed.
+    std::chrono::nanoseconds longest{0};
+
+    /// Handlers over the threshold, and the last of them.
+    std::uint64_t slow_count = 0;
+    void const* slow = nullptr;
+    time_point slow_since;
+    std::chrono::nanoseconds slow_time{0};
+};
+
 struct scheduler
 {
     virtual ~scheduler() = default;
     virtual void post(capy::coro) const = 0;
     virtual void post(scheduler_op*) const = 0;
 
+    /** Post a coroutine ahead of other queued handlers.
+
+        Schedulers without priority lanes post it normally.
+    */
+    virtual void post_high_priority(capy::coro h) const { post(h); }
+
+    /** Post coroutines in order as one batch.
+
+        Schedulers without batching post each in turn.
+    */
+    virtual void post_batch(std::span<capy::coro const> hs) const
+    {
+        for (auto h : hs)
+            post(h);
+    }
+
     /** Notify scheduler of pending work (for executor use).
         When the count reaches zero, the scheduler stops.
     */
@@ -47,6 +107,83 @@ struct scheduler
     virtual std::size_t wait_one(long usec) = 0;
     virtual std::size_t poll() = 0;
     virtual std::size_t poll_one() = 0;
+
+    /** Run what is ready without blocking, for a host event loop.
+
+        Unlike poll(), finding no work does not stop the scheduler.
+        Schedulers without a handle for the host to wait on poll
+        when there is work.
+    */
+    virtual std::size_t poll_ready()
+    {
+        if (outstanding_work() == 0)
+            return 0;
+        return poll();
+    }
+
+    /** Return how long a host may wait on the handle, in milliseconds.
+
+        -1 waits for the handle alone. Schedulers without a handle
+        return zero.
+    */
+    virtual long poll_ready_timeout() const { return 0; }
+
+    /** Return the count of work that keeps run() from returning.
+
+        Pending operations, waiting timers and work guards each
+        count. Virtual time reads it to tell when the context is
+        idle, see timer_options::virtual_time; schedulers that do
+        not count return -1, which is never idle.
+    */
+    virtual long outstanding_work() const noexcept { return -1; }
+
+    /** Add the scheduler's counters to `st`.
+
+        Schedulers without counters leave `st` unchanged.
+    */
+    virtual void collect_stats(scheduler_stats&) const noexcept {}
+
+    /** Time each handler, recording those that take `threshold` or longer.
+
+        A zero threshold stops the timing.
+
+        @return `false` if the scheduler cannot time handlers.
+    */
+    virtual bool time_handlers(std::chrono::nanoseconds) noexcept { return false; }
+
+    /// Replace `out` with one sample per thread inside run().
+    virtual void sample_handlers(std::vector<handler_sample>& out) const { out.clear(); }
+
+    /** Append the operations parked on descriptors to `out`.
+
+        Ages are measured from `now`. Schedulers that cannot walk
+        their descriptors append nothing.
+    */
+    virtual void sample_parked(
+        std::vector<parked_op>&,
+        std::chrono::steady_clock::time_point) const {}
+
+    /** Report I/O operations started from now on to `t`.
+
+        A null tracer stops the tracing.
+
+        @return `false` if the scheduler cannot trace operations.
+    */
+    virtual bool trace_ops(op_tracer*) noexcept { return false; }
+
+    /** Create a service this scheduler deferred, or return it if created.
+
+        Called when a lookup for the service misses.
+
+        @return The service, or null if this scheduler defers none
+            of that kind.
+    */
+    virtual capy::execution_context::service*
+    make_deferred_service(deferred_service) { return nullptr; }
+
+    /// Return the time timers measure from, see timer_options::cached_time.
+    virtual std::chrono::steady_clock::time_point
+    now() const noexcept { return std::chrono::steady_clock::now(); }
 };
 
 } // namespace boost::corosio::detail
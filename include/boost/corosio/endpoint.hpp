@@ -19,6 +19,13 @@
 
 namespace boost::corosio {
 
+/** The address family of an endpoint or socket. */
+enum class ip_family
+{
+    v4,     ///< IPv4
+    v6      ///< IPv6
+};
+
 /** An IP endpoint (address + port) supporting both IPv4 and IPv6.
 
     This class represents an endpoint for IP communication,
@@ -118,6 +125,15 @@ public:
         return !is_v4_;
     }
 
+    /** Get the address family of the endpoint.
+
+        @return `ip_family::v4` or `ip_family::v6`.
+    */
+    ip_family family() const noexcept
+    {
+        return is_v4_ ? ip_family::v4 : ip_family::v6;
+    }
+
     /** Get the IPv4 address.
 
         @return The IPv4 address. The value is valid even if
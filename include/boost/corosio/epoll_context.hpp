@@ -16,9 +16,209 @@
 #if BOOST_COROSIO_HAS_EPOLL
 
 #include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
 
 namespace boost::corosio {
 
+/** How the epoll reactor polls before blocking.
+
+    @see epoll_options, epoll_stats
+*/
+enum class busy_poll_mode
+{
+    /// Block in `epoll_wait` as soon as there is no work.
+    off,
+
+    /// Make a fixed number of zero-timeout polls first.
+    spin,
+
+    /// Poll with a zero timeout until a deadline passes.
+    deadline
+};
+
+/** Tuning options for an @ref epoll_context.
+
+    The busy-poll settings trade CPU time for latency: when the
+    reactor runs out of work it keeps polling with a zero timeout
+    for a while before parking in `epoll_wait`, so a completion
+    arriving shortly afterwards is seen without a sleep and wakeup.
+    A nonzero `busy_poll_duration` takes precedence over
+    `busy_poll_spins`. Spinning never outlasts the next timer expiry.
+
+    `max_events` and `handler_budget` balance syscall count against
+    fairness: a larger batch harvests more readiness events per
+    `epoll_wait`, and a budget bounds how many queued handlers run
+    before the reactor is polled again for I/O and expired timers.
+    `inline_completions` does the same for the completions of one
+    poll in single-threaded use.
+
+    `reactors` spreads descriptors over several epoll instances, for
+    loads where one thread cannot keep up with every readiness event.
+*/
+struct epoll_options
+{
+    /// Maximum events harvested by one `epoll_wait` call.
+    unsigned max_events = 64;
+
+    /** Handlers run between reactor polls while work is queued.
+        Zero drains the queue before polling again.
+    */
+    unsigned handler_budget = 0;
+
+    /** Completions run in one batch after a reactor poll.
+
+        Applies to a context with a concurrency hint of one, in `run()`
+        and `poll()`. Straight after the poll, up to this many handlers
+        are taken from the front of the queue under one lock and run
+        back to back. The completions still pass through the queue,
+        behind any work queued before them; what the batch saves is
+        the lock and the checks of a `run_one()` round per handler.
+        Every handler returns before the next one starts, so the batch
+        does not deepen the stack; the bound keeps a large harvest
+        from delaying other work and timers. Zero takes handlers from
+        the queue one at a time.
+    */
+    unsigned inline_completions = 0;
+
+    /// Zero-timeout polls made before blocking.
+    unsigned busy_poll_spins = 0;
+
+    /// How long to keep polling before blocking.
+    std::chrono::microseconds busy_poll_duration{0};
+
+    /** Value for `SO_BUSY_POLL`, in microseconds, applied to every
+        socket. Zero leaves the system default. Raising it above
+        `net.core.busy_read` requires `CAP_NET_ADMIN`; failures are
+        ignored.
+    */
+    int socket_busy_poll = 0;
+
+    /// Set `SO_PREFER_BUSY_POLL` on every socket, where supported.
+    bool prefer_busy_poll = false;
+
+    /** Connections an acceptor may accept ahead of `accept()`.
+
+        Nonzero makes an accept woken by the reactor keep calling
+        `accept4` until it would block or this many further
+        connections wait in the acceptor, so one readiness event
+        drains a deep listen backlog. Later `accept()` calls take the
+        waiting connections without a system call or a trip through
+        the reactor. Zero accepts one connection per event.
+    */
+    unsigned accept_backlog = 0;
+
+    /** Drive timers from a `timerfd` in the epoll set.
+
+        The timerfd is armed for the earliest timer with nanosecond
+        resolution, so timers fire within microseconds of their
+        expiry instead of being rounded up to the millisecond
+        `epoll_wait` timeout. When false, if the timerfd cannot be
+        created, or with @ref timer_options::virtual_time, the
+        timeout is used.
+    */
+    bool use_timerfd = true;
+
+    /** Read signals from a `signalfd` in the epoll set.
+
+        A signal added to a @ref signal_set is then also blocked in
+        the thread that adds it, which threads created afterwards
+        inherit. A signal blocked in every thread is read by the
+        reactor, which completes the waits from its own loop instead
+        of through a signal handler. The handler stays installed for
+        threads that do not block the signal, so for every signal to
+        come through the signalfd, add the signals before starting
+        other threads, or block them in every thread. Removing the
+        last registration of a signal unblocks it in the removing
+        thread only. When false, or if the signalfd cannot be
+        created, signals arrive through the handler.
+    */
+    bool use_signalfd = false;
+
+    /** Number of epoll instances in the context.
+
+        Each socket and acceptor is assigned to one of them, in turn,
+        when it is opened or accepted, and up to this many threads
+        inside `run()` wait for events at the same time, each in a
+        different instance. The first instance also delivers timers,
+        signals and wakeups, and watches the others while no thread
+        waits in them, so every descriptor is still served when
+        fewer threads run the context. Values above the number of
+        threads calling `run()` add only overhead. A context with a
+        concurrency hint of one always uses a single instance.
+    */
+    unsigned reactors = 1;
+
+    /** Run I/O completions on the thread that started the operation.
+
+        Applies to a context with a concurrency hint greater than one.
+        An operation that has to wait for readiness remembers the
+        thread inside `run()` that started it. If that thread is busy
+        in a handler when the operation completes, the completion goes
+        to the thread's own queue, to run next, instead of to whichever
+        thread is free, so a connection's state stays in one cache.
+        Otherwise, and for operations started outside `run()`, the
+        completion goes to any thread as before.
+    */
+    bool completion_affinity = false;
+
+    /** How long a busy thread keeps its completions to itself.
+
+        With `completion_affinity`, other threads take work from a
+        thread's queue only once its current handler has been running
+        this long, or while it is not running a handler at all.
+    */
+    std::chrono::microseconds affinity_steal_delay{100};
+
+    /// How the context keeps its timers.
+    timer_options timers;
+};
+
+/** Counters reported by an @ref epoll_context.
+
+    Extends the counters every context reports with those of the
+    epoll reactor. Values are sampled without synchronization and
+    may be slightly stale while other threads are running the
+    context.
+*/
+struct epoll_stats : scheduler_stats
+{
+    /// The busy-poll mode in effect.
+    busy_poll_mode mode = busy_poll_mode::off;
+
+    /// Zero-timeout polls made while busy-polling.
+    std::uint64_t busy_polls = 0;
+
+    /// Busy-poll phases that found work before blocking.
+    std::uint64_t busy_poll_hits = 0;
+
+    /// Wakeups skipped because one was already pending.
+    std::uint64_t wakeups_suppressed = 0;
+
+    /// Whether timers are driven by a timerfd.
+    bool timerfd = false;
+
+    /// Times the timerfd was armed for a new earliest timer.
+    std::uint64_t timerfd_rearms = 0;
+
+    /// Whether signals are read from a signalfd.
+    bool signalfd = false;
+
+    /// Number of epoll instances, see epoll_options::reactors.
+    unsigned reactors = 1;
+
+    /** Timer wakeups saved by slack.
+
+        Counts timers that expired together with an earlier one only
+        because their slack rounded both to the same time.
+
+        @see timer::set_slack
+    */
+    std::uint64_t timer_wakeups_coalesced = 0;
+};
+
 /** I/O context using Linux epoll for event multiplexing.
 
     This context provides an execution environment for async operations
@@ -53,17 +253,50 @@ public:
 
         @param concurrency_hint A hint for the number of threads that
             will call `run()`. If greater than 1, thread-safe
-            synchronization is used internally.
+            synchronization is used internally. If exactly 1, work
+            posted from the thread calling `run()` bypasses locking;
+            only one thread may call `run()` at a time.
     */
     explicit
     epoll_context(unsigned concurrency_hint);
 
+    /** Construct an epoll_context with a concurrency hint and options.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`.
+        @param opts Reactor tuning options.
+    */
+    epoll_context(
+        unsigned concurrency_hint,
+        epoll_options const& opts);
+
     /** Destructor. */
     ~epoll_context();
 
     // Non-copyable
     epoll_context(epoll_context const&) = delete;
     epoll_context& operator=(epoll_context const&) = delete;
+
+    /** Return the event loop and reactor counters.
+
+        Hides @ref basic_io_context::stats, whose counters are the
+        base of the result.
+    */
+    epoll_stats
+    stats() const noexcept;
+
+    /** Return the epoll file descriptor a host loop waits on.
+
+        The descriptor is readable whenever the context has events,
+        expired timers, signals or posted handlers to process; a
+        host event loop watches it for readability and calls
+        @ref poll_ready. It stays owned by the context and must not
+        be closed, read from or modified.
+
+        @see poll_ready, poll_ready_timeout
+    */
+    int
+    native_handle() const noexcept;
 };
 
 } // namespace boost::corosio
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_FILE_BASE_HPP
+#define BOOST_COROSIO_FILE_BASE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace boost::corosio {
+
+/** Definitions shared by @ref random_access_file and @ref stream_file.
+
+    Holds the flags a file is opened with, the origins of a seek,
+    and the part of the implementation interface both file types
+    have in common.
+*/
+class file_base
+{
+public:
+    /** Flags that control how a file is opened.
+
+        Exactly one of `read_only`, `write_only` and `read_write`
+        must be given. The others may be combined with it.
+    */
+    enum flags : unsigned int
+    {
+        /// Open for reading only.
+        read_only = 1,
+
+        /// Open for writing only.
+        write_only = 2,
+
+        /// Open for reading and writing.
+        read_write = 4,
+
+        /// Every write goes to the end of the file.
+        append = 8,
+
+        /// Create the file if it does not exist.
+        create = 16,
+
+        /// With `create`, fail if the file exists.
+        exclusive = 32,
+
+        /// Truncate an existing file to zero length.
+        truncate = 64,
+
+        /// Every write reaches the storage device before it completes.
+        sync_all_on_write = 128
+    };
+
+    /// The origin of a seek.
+    enum seek_basis
+    {
+        /// From the start of the file.
+        seek_set,
+
+        /// From the current position.
+        seek_cur,
+
+        /// From the end of the file.
+        seek_end
+    };
+
+    /** The operations every file implementation provides.
+
+        Concrete implementations derive from this through
+        @ref random_access_file::random_access_file_impl and
+        @ref stream_file::stream_file_impl.
+    */
+    struct file_impl
+    {
+        virtual ~file_impl() = default;
+
+        /// Open `path`, closing any file held before.
+        virtual system::error_code open(
+            std::string_view path,
+            flags open_flags) = 0;
+
+        /// Return the native file handle, or an invalid handle.
+        virtual native_file_type native_handle() const noexcept = 0;
+
+        /// Cancel all pending operations.
+        virtual void cancel() noexcept = 0;
+
+        /// Return the size of the file in bytes.
+        virtual std::uint64_t size(system::error_code& ec) const = 0;
+
+        /// Extend or truncate the file to `n` bytes.
+        virtual system::error_code resize(std::uint64_t n) = 0;
+
+        /// Flush data and metadata to the storage device.
+        virtual system::error_code sync_all() = 0;
+
+        /// Flush data to the storage device.
+        virtual system::error_code sync_data() = 0;
+    };
+
+protected:
+    ~file_base() = default;
+};
+
+/// Combine open flags.
+constexpr file_base::flags
+operator|(file_base::flags a, file_base::flags b) noexcept
+{
+    return static_cast<file_base::flags>(
+        static_cast<unsigned int>(a) | static_cast<unsigned int>(b));
+}
+
+/// Intersect open flags.
+constexpr file_base::flags
+operator&(file_base::flags a, file_base::flags b) noexcept
+{
+    return static_cast<file_base::flags>(
+        static_cast<unsigned int>(a) & static_cast<unsigned int>(b));
+}
+
+/// Add open flags.
+constexpr file_base::flags&
+operator|=(file_base::flags& a, file_base::flags b) noexcept
+{
+    return a = a | b;
+}
+
+/// Keep only the given open flags.
+constexpr file_base::flags&
+operator&=(file_base::flags& a, file_base::flags b) noexcept
+{
+    return a = a & b;
+}
+
+/// Complement open flags.
+constexpr file_base::flags
+operator~(file_base::flags a) noexcept
+{
+    return static_cast<file_base::flags>(
+        ~static_cast<unsigned int>(a));
+}
+
+} // namespace boost::corosio
+
+#endif
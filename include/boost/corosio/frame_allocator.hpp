@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_FRAME_ALLOCATOR_HPP
+#define BOOST_COROSIO_FRAME_ALLOCATOR_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace boost::corosio {
+
+/** Per-thread recycling of coroutine frames.
+
+    Frames come in power-of-two size classes from @ref min_size to
+    @ref max_size. A freed frame goes to a list of its class kept by
+    the freeing thread, and the next frame of that class allocated on
+    the thread reuses it, so a coroutine spawned per connection or per
+    request reaches the global allocator only until the lists have
+    warmed up. Frames larger than @ref max_size, and frames freed
+    once a thread's list of their class is full, go to the global
+    allocator.
+
+    A frame freed on a thread other than the one that allocated it
+    joins the freeing thread's list. The lists belong to no context
+    and are freed when their thread exits.
+
+    A promise type uses it by forwarding its allocation functions:
+
+    @code
+    static void* operator new(std::size_t n)
+    {
+        return corosio::frame_allocator::allocate(n);
+    }
+
+    static void operator delete(void* p, std::size_t n) noexcept
+    {
+        corosio::frame_allocator::deallocate(p, n);
+    }
+    @endcode
+
+    The connection coroutines that @ref tcp_server starts through a
+    launcher have their wrapper frames allocated this way. For other
+    frames, and for anything taking a `std::pmr::memory_resource`,
+    @ref resource returns the allocator as a memory resource.
+
+    @par Thread Safety
+    Safe to call from any thread.
+*/
+class BOOST_COROSIO_DECL frame_allocator
+{
+public:
+    /// The smallest size class.
+    static constexpr std::size_t min_size = 64;
+
+    /// The largest size class; larger frames are not recycled.
+    static constexpr std::size_t max_size = 16384;
+
+    /** Allocate a frame of at least `n` bytes.
+
+        @throws std::bad_alloc if memory is exhausted.
+    */
+    static void* allocate(std::size_t n);
+
+    /** Free a frame from @ref allocate.
+
+        @param p The frame.
+        @param n The size passed to @ref allocate.
+    */
+    static void deallocate(void* p, std::size_t n) noexcept;
+
+    /** Free the frames cached by the calling thread.
+
+        Lists of other threads are freed when those threads exit.
+    */
+    static void trim() noexcept;
+
+    /** Return the allocator as a memory resource.
+
+        Requests aligned beyond `__STDCPP_DEFAULT_NEW_ALIGNMENT__` are
+        served by the global allocator. All calls return the same
+        object, which compares equal only to itself.
+    */
+    static std::pmr::memory_resource* resource() noexcept;
+};
+
+} // namespace boost::corosio
+
+#endif
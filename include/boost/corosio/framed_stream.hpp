@@ -0,0 +1,415 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_FRAMED_STREAM_HPP
+#define BOOST_COROSIO_FRAMED_STREAM_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/buffered_stream.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace boost::corosio {
+
+/** The length prefix in front of each frame of a @ref framed_stream.
+
+    The prefix is an unsigned count of the payload bytes that follow
+    it, `Width` bytes wide, in `Order`. Both are template parameters,
+    so @ref decode and @ref encode compile to a load or store and at
+    most a byte swap, inlined into the read and write paths.
+
+    @tparam Width The prefix size in bytes: 1, 2, 4 or 8.
+    @tparam Order The byte order, `std::endian::big` for network
+        order.
+*/
+template<
+    std::size_t Width = 4,
+    std::endian Order = std::endian::big>
+struct frame_prefix
+{
+    static_assert(Width == 1 || Width == 2 || Width == 4 || Width == 8,
+        "frame_prefix width must be 1, 2, 4 or 8 bytes");
+
+    /// The prefix size in bytes.
+    static constexpr std::size_t width = Width;
+
+    /// The byte order of the prefix.
+    static constexpr std::endian order = Order;
+
+    /// The largest payload length the prefix can express.
+    static constexpr std::uint64_t max_length = Width == 8
+        ? ~std::uint64_t(0)
+        : (std::uint64_t(1) << (8 * Width)) - 1;
+
+    /// Return the length stored in the `width` bytes at `p`.
+    static constexpr std::uint64_t
+    decode(unsigned char const* p) noexcept
+    {
+        std::uint64_t n = 0;
+        if constexpr (Order == std::endian::big)
+        {
+            for (std::size_t i = 0; i < Width; ++i)
+                n = (n << 8) | p[i];
+        }
+        else
+        {
+            for (std::size_t i = Width; i-- > 0;)
+                n = (n << 8) | p[i];
+        }
+        return n;
+    }
+
+    /// Store `n`, at most @ref max_length, in the `width` bytes at `p`.
+    static constexpr void
+    encode(std::uint64_t n, unsigned char* p) noexcept
+    {
+        if constexpr (Order == std::endian::big)
+        {
+            for (std::size_t i = Width; i-- > 0; n >>= 8)
+                p[i] = static_cast<unsigned char>(n & 0xff);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < Width; ++i, n >>= 8)
+                p[i] = static_cast<unsigned char>(n & 0xff);
+        }
+    }
+};
+
+/** Length-prefixed frames over a stream.
+
+    Reads go through a @ref buffered_stream: each read fills all of
+    the ring's free space, and @ref read_frame returns the payload
+    of the next frame as a view into the ring, without copying it.
+    The view stays valid until the next call to @ref read_frame or
+    @ref read_buffer. A frame must fit in the ring, prefix included;
+    a longer one, or one longer than the limit given at
+    construction, fails the read with `errc::message_size` and
+    leaves the stream unusable for further frames.
+
+    Writes are batched: @ref queue adds a frame without writing it,
+    and @ref flush sends every queued frame, prefixes and payloads,
+    with as few gather writes as the stream allows; writing a burst
+    of small frames costs one system call rather than one or two
+    each. Payloads are not copied and must stay valid until the
+    flush completes.
+
+    @tparam Prefix The length prefix, a @ref frame_prefix.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. One read and one flush may be in
+    progress at the same time.
+
+    @par Example
+    @code
+    corosio::framed_stream<> fs(sock);
+    for (;;)
+    {
+        auto [ec, frame] = co_await fs.read_frame();
+        if (ec)
+            break;
+        fs.queue(handle(frame));
+        if (fs.read_buffer().size() < 4)
+            co_await fs.flush();
+    }
+    @endcode
+*/
+template<class Prefix = frame_prefix<>>
+class framed_stream
+{
+public:
+    /// The length prefix.
+    using prefix_type = Prefix;
+
+    /// The most buffers passed to one gather write.
+    static constexpr std::size_t max_gather = 64;
+
+    /** Construct a framed stream over `s`.
+
+        @param s The stream to read and write. It must outlive this
+            object.
+
+        @param capacity The size of the read ring, see
+            @ref buffered_stream. It bounds the size of a frame.
+
+        @param max_frame The largest payload accepted by
+            @ref read_frame. Zero accepts anything that fits in the
+            ring.
+
+        @throws std::bad_alloc if memory is exhausted.
+    */
+    explicit
+    framed_stream(
+        io_stream& s,
+        std::size_t capacity = buffered_stream::default_capacity,
+        std::size_t max_frame = 0)
+        : rb_(s, capacity)
+        , max_frame_(max_frame)
+    {
+    }
+
+    framed_stream(framed_stream const&) = delete;
+    framed_stream& operator=(framed_stream const&) = delete;
+
+    /// Return the stream read and written.
+    io_stream&
+    next_layer() const noexcept
+    {
+        return rb_.next_layer();
+    }
+
+    /** Return the read ring.
+
+        Releases the frame last returned by @ref read_frame first,
+        so the readable bytes start at the next frame's prefix.
+    */
+    buffered_stream&
+    read_buffer() noexcept
+    {
+        release();
+        return rb_;
+    }
+
+    /** Read the next frame.
+
+        @return A task that completes with a view of the payload,
+            valid until the next call to this function or to
+            @ref read_buffer. It fails with `errc::message_size` if
+            the frame does not fit, and otherwise with the errors
+            of @ref buffered_stream::fill; a stream that ends inside
+            a frame fails with its end-of-stream error.
+    */
+    capy::task<capy::io_result<capy::const_buffer>>
+    read_frame();
+
+    /** Queue a frame for the next @ref flush.
+
+        A frame queued while a flush is in progress is sent by the
+        next flush.
+
+        @param payload The frame's payload. It must stay valid until
+            the flush that sends it completes.
+
+        @throws std::length_error if the payload is longer than the
+            prefix can express.
+    */
+    void
+    queue(capy::const_buffer payload);
+
+    /// Return the number of frames queued and not yet sent.
+    std::size_t
+    queued() const noexcept
+    {
+        return payloads_.size();
+    }
+
+    /** Send every queued frame.
+
+        The frames queued when the flush starts are sent; those
+        queued while it is in progress wait for the next one.
+
+        @return A task that completes with the number of bytes
+            written, prefixes included. On failure the error is
+            that of @ref io_stream::write_some, or
+            `capy::error::eof` if the stream accepted no bytes.
+            The frames not started stay queued, ahead of any queued
+            during the flush, and @ref queued counts them. A frame
+            partly sent is dropped; the peer's framing is then lost
+            and the stream should be closed.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    flush();
+
+    /** Queue a frame and send it with any others queued.
+
+        @param payload The frame's payload.
+
+        @return A task that completes as for @ref flush.
+
+        @throws std::length_error as for @ref queue.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    write_frame(capy::const_buffer payload)
+    {
+        queue(payload);
+        return flush();
+    }
+
+private:
+    using header = std::array<unsigned char, Prefix::width>;
+
+    void
+    release() noexcept
+    {
+        rb_.consume(pending_);
+        pending_ = 0;
+    }
+
+    buffered_stream rb_;
+    std::size_t max_frame_;
+    std::size_t pending_ = 0;   // bytes of the frame last returned
+
+    // Queued frames; the headers are encoded when queued
+    std::vector<header> headers_;
+    std::vector<capy::const_buffer> payloads_;
+
+    // The frames taken by the flush in progress, which the gather
+    // list points into
+    std::vector<header> sending_headers_;
+    std::vector<capy::const_buffer> sending_payloads_;
+    std::vector<capy::const_buffer> gather_;
+};
+
+//------------------------------------------------------------------------------
+
+template<class Prefix>
+capy::task<capy::io_result<capy::const_buffer>>
+framed_stream<Prefix>::
+read_frame()
+{
+    release();
+
+    constexpr std::size_t w = Prefix::width;
+    std::uint64_t const limit = (std::min<std::uint64_t>)(
+        max_frame_ ? max_frame_ : ~std::uint64_t(0),
+        rb_.capacity() < w ? 0 : rb_.capacity() - w);
+
+    for (;;)
+    {
+        auto const d = rb_.data();
+        auto const* p = static_cast<unsigned char const*>(d.data());
+        if (d.size() >= w)
+        {
+            std::uint64_t const n = Prefix::decode(p);
+            if (n > limit)
+                co_return {make_error_code(system::errc::message_size), {}};
+            if (d.size() - w >= n)
+            {
+                pending_ = w + static_cast<std::size_t>(n);
+                co_return {{}, capy::const_buffer(
+                    p + w, static_cast<std::size_t>(n))};
+            }
+        }
+
+        auto [ec, got] = co_await rb_.fill();
+        if (ec)
+            co_return {ec, {}};
+    }
+}
+
+template<class Prefix>
+void
+framed_stream<Prefix>::
+queue(capy::const_buffer payload)
+{
+    if (static_cast<std::uint64_t>(payload.size()) > Prefix::max_length)
+        throw std::length_error("framed_stream frame too long");
+
+    header h;
+    Prefix::encode(payload.size(), h.data());
+    headers_.push_back(h);
+    payloads_.push_back(payload);
+}
+
+template<class Prefix>
+capy::task<capy::io_result<std::size_t>>
+framed_stream<Prefix>::
+flush()
+{
+    // Take the queued frames, so frames queued while this flush is
+    // suspended cannot move the headers the gather list points at
+    sending_headers_.swap(headers_);
+    sending_payloads_.swap(payloads_);
+
+    gather_.clear();
+    gather_.reserve(2 * sending_payloads_.size());
+    for (std::size_t i = 0; i < sending_payloads_.size(); ++i)
+    {
+        gather_.emplace_back(sending_headers_[i].data(), Prefix::width);
+        if (sending_payloads_[i].size() != 0)
+            gather_.push_back(sending_payloads_[i]);
+    }
+
+    std::size_t total = 0;
+    std::size_t first = 0;
+    system::error_code ec;
+    while (first < gather_.size())
+    {
+        std::size_t const count = (std::min)(
+            max_gather, gather_.size() - first);
+        auto [wec, n] = co_await rb_.next_layer().write_some(
+            std::span<capy::const_buffer const>(gather_.data() + first, count));
+        total += n;
+        if (wec)
+        {
+            ec = wec;
+            break;
+        }
+        if (n == 0)
+        {
+            // Looping would never finish
+            ec = capy::error::eof;
+            break;
+        }
+
+        // Step past what was sent, trimming a partly sent buffer
+        while (n > 0)
+        {
+            auto& b = gather_[first];
+            if (n < b.size())
+            {
+                b = capy::const_buffer(
+                    static_cast<char const*>(b.data()) + n, b.size() - n);
+                n = 0;
+            }
+            else
+            {
+                n -= b.size();
+                ++first;
+            }
+        }
+    }
+
+    if (ec)
+    {
+        // Skip the frames sent and any partly sent, and queue the
+        // rest ahead of those queued meanwhile
+        std::size_t done = 0;
+        std::size_t sent = 0;
+        while (done < sending_payloads_.size() && sent < total)
+            sent += Prefix::width + sending_payloads_[done++].size();
+        headers_.insert(headers_.begin(),
+            sending_headers_.begin() + done, sending_headers_.end());
+        payloads_.insert(payloads_.begin(),
+            sending_payloads_.begin() + done, sending_payloads_.end());
+    }
+
+    sending_headers_.clear();
+    sending_payloads_.clear();
+    gather_.clear();
+    co_return {ec, total};
+}
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_HUGE_PAGES_HPP
+#define BOOST_COROSIO_HUGE_PAGES_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <cstddef>
+
+namespace boost::corosio {
+
+/// How the memory of the huge page arena is backed.
+enum class huge_page_backing
+{
+    /// There is no arena; pooled memory comes from the global allocator.
+    none,
+
+    /// Transparent huge pages, which the kernel may assemble lazily.
+    transparent,
+
+    /** Huge pages reserved up front.
+
+        `MAP_HUGETLB` on Linux, `MEM_LARGE_PAGES` on Windows.
+    */
+    reserved
+};
+
+/** Reserve an arena of huge pages for pooled memory.
+
+    Once the arena exists, the memory that the library recycles
+    takes new blocks from it instead of the global allocator:
+    @ref buffer_pool buffers, @ref frame_allocator frames, and the
+    slabs of socket and acceptor impls. A working set spread over
+    gigabytes then needs a TLB entry per 2 MiB instead of per 4 KiB.
+    Blocks are handed out in power-of-two classes up to 64 KiB, and
+    a block freed by its pool goes back to the arena for reuse.
+
+    Explicit huge pages are tried first. On Linux these need pages
+    set aside in `vm.nr_hugepages`, and on Windows the "Lock pages
+    in memory" right, which the call enables on the process token
+    if the account holds it. Otherwise, on Linux, the arena asks for
+    transparent huge pages with `madvise(MADV_HUGEPAGE)`. When
+    neither is available no arena is created and nothing changes.
+
+    Only the first call reserves; later ones return the backing of
+    the existing arena. Call it before creating contexts, since
+    memory the pools already hold stays where it is. Once the arena
+    is used up, pools fall back to the global allocator. The arena
+    is never released before the process exits.
+
+    @param bytes The arena size, rounded up to a whole huge page.
+
+    @return How the arena is backed.
+
+    @par Thread Safety
+    Safe to call from any thread.
+
+    @par Example
+    @code
+    int main()
+    {
+        corosio::reserve_huge_pages(std::size_t(1) << 30);
+        corosio::io_context ioc;
+        // ...
+    }
+    @endcode
+*/
+BOOST_COROSIO_DECL
+huge_page_backing
+reserve_huge_pages(std::size_t bytes);
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_IO_ACCOUNT_HPP
+#define BOOST_COROSIO_IO_ACCOUNT_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost::corosio {
+
+/** The resources charged to an @ref io_account.
+
+    @see io_account::usage
+*/
+struct io_usage
+{
+    /** Time spent running the coroutines resumed by its operations.
+
+        Measured on the resuming thread from the resumption until
+        control returns to the context, so it includes the work the
+        coroutine does before its next suspension.
+    */
+    std::chrono::nanoseconds cpu_time{0};
+
+    /// Bytes returned by reads.
+    std::uint64_t bytes_read = 0;
+
+    /// Bytes accepted by writes.
+    std::uint64_t bytes_written = 0;
+
+    /// Operations completed, including those that failed.
+    std::uint64_t ops = 0;
+
+    /// Return the usage accrued since `earlier`.
+    io_usage
+    operator-(io_usage const& earlier) const noexcept
+    {
+        io_usage u;
+        u.cpu_time = cpu_time - earlier.cpu_time;
+        u.bytes_read = bytes_read - earlier.bytes_read;
+        u.bytes_written = bytes_written - earlier.bytes_written;
+        u.ops = ops - earlier.ops;
+        return u;
+    }
+};
+
+/** Counters charged by the operations of the sockets attached to it.
+
+    Attach an account with @ref socket::set_account. Each operation
+    the socket completes then adds its bytes and one operation, and
+    when it resumes its coroutine, the time until the coroutine
+    suspends again or finishes. Reading the counters never stops the
+    sockets: each is a relaxed atomic, so a snapshot taken while
+    operations complete may mix values from either side of one.
+
+    Charging costs an operation a few relaxed atomic adds, and a
+    resumption two clock reads. A coroutine resumed by an executor
+    that posts instead of running it inline, such as a strand, is
+    charged its bytes but not its time. The account must outlive
+    the operations of the sockets attached to it.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @see tcp_server::worker_base::account
+*/
+class io_account
+{
+    std::atomic<std::int64_t> cpu_ns_{0};
+    std::atomic<std::uint64_t> bytes_read_{0};
+    std::atomic<std::uint64_t> bytes_written_{0};
+    std::atomic<std::uint64_t> ops_{0};
+
+public:
+    io_account() = default;
+    io_account(io_account const&) = delete;
+    io_account& operator=(io_account const&) = delete;
+
+    /// Charge one completed operation and its bytes.
+    void
+    add_op(bool is_read, std::size_t bytes) noexcept
+    {
+        ops_.fetch_add(1, std::memory_order_relaxed);
+        if (bytes == 0)
+            return;
+        (is_read ? bytes_read_ : bytes_written_).fetch_add(
+            bytes, std::memory_order_relaxed);
+    }
+
+    /// Charge time spent running a resumed coroutine.
+    void
+    add_cpu_time(std::chrono::nanoseconds d) noexcept
+    {
+        cpu_ns_.fetch_add(d.count(), std::memory_order_relaxed);
+    }
+
+    /// Return the counters.
+    io_usage
+    usage() const noexcept
+    {
+        io_usage u;
+        u.cpu_time = std::chrono::nanoseconds(
+            cpu_ns_.load(std::memory_order_relaxed));
+        u.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+        u.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+        u.ops = ops_.load(std::memory_order_relaxed);
+        return u;
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -14,6 +14,7 @@
 #include <boost/capy/buffers.hpp>
 
 #include <cstddef>
+#include <type_traits>
 
 namespace boost::corosio {
 
@@ -51,7 +52,10 @@ namespace boost::corosio {
     lifetime extension. When a coroutine is suspended, parameters
     passed to the awaitable remain valid until the coroutine resumes
     or is destroyed. This class exploits that guarantee by holding
-    only a pointer to the caller's buffer sequence.
+    only a pointer to the caller's buffer sequence. A sequence that
+    is a single `const_buffer` or `mutable_buffer` is held by value
+    instead, so `copy_to` fills it in without an indirect call; the
+    memory it refers to must still outlive the operation.
 
     The referenced buffer sequence is valid ONLY while the calling
     coroutine remains suspended at the exact suspension point where
@@ -284,9 +288,10 @@ namespace boost::corosio {
 
     @par Passing Convention
 
-    Pass by value. The class contains only two pointers (16 bytes
-    on 64-bit systems), making copies trivial and clearly
-    communicating the lightweight, transient nature of this type.
+    Pass by value. The class holds two pointers and a size, the
+    last used when it wraps a single buffer, making copies trivial
+    and clearly communicating the lightweight, transient nature of
+    this type.
 
     @code
     // Preferred: pass by value
@@ -310,6 +315,16 @@ public:
         : bs_(&bs)
         , fn_(&copy_impl<BS>)
     {
+        // A single buffer is held by value, so that copy_to fills
+        // it in without an indirect call
+        if constexpr (
+            std::is_same_v<BS, capy::mutable_buffer> ||
+            std::is_same_v<BS, capy::const_buffer>)
+        {
+            bs_ = bs.data();
+            size_ = bs.size();
+            fn_ = nullptr;
+        }
     }
 
     /** Fill an array with buffers from the sequence.
@@ -329,6 +344,14 @@ public:
         capy::mutable_buffer* dest,
         std::size_t n) const noexcept
     {
+        if(! fn_)
+        {
+            if(n == 0 || size_ == 0)
+                return 0;
+            dest[0] = capy::mutable_buffer(
+                const_cast<void*>(bs_), size_);
+            return 1;
+        }
         return fn_(bs_, dest, n);
     }
 
@@ -374,7 +397,9 @@ private:
     using fn_t = std::size_t(*)(void const*,
         capy::mutable_buffer*, std::size_t);
 
+    // The sequence, or the data of a single buffer
     void const* bs_;
+    std::size_t size_ = 0;
     fn_t fn_;
 };
 
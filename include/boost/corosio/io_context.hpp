@@ -24,8 +24,16 @@
 #include <boost/corosio/epoll_context.hpp>
 #endif
 
+#if BOOST_COROSIO_HAS_IO_URING
+#include <boost/corosio/io_uring_context.hpp>
+#endif
+
 #if BOOST_COROSIO_HAS_KQUEUE
-// #include <boost/corosio/kqueue_context.hpp>
+#include <boost/corosio/kqueue_context.hpp>
+#endif
+
+#if BOOST_COROSIO_HAS_POLL
+#include <boost/corosio/poll_context.hpp>
 #endif
 
 #if BOOST_COROSIO_HAS_SELECT
@@ -42,9 +50,10 @@ namespace boost::corosio {
 
     This is a type alias for the platform's default I/O backend:
     - Windows: `iocp_context` (I/O Completion Ports)
-    - Linux: `epoll_context` (epoll)
-    - BSD/macOS: `kqueue_context` (kqueue) [future]
-    - Other POSIX: `select_context` (select) [future]
+    - Linux: `epoll_context` (epoll), or `io_uring_context` when
+      built with `BOOST_COROSIO_USE_IO_URING`
+    - BSD/macOS: `kqueue_context` (kqueue)
+    - Other POSIX: `poll_context` (poll)
 
     For explicit backend selection, use the concrete context types
     directly (e.g., `epoll_context`, `iocp_context`).
@@ -79,11 +88,14 @@ namespace boost::corosio {
 */
 #if BOOST_COROSIO_HAS_IOCP
 using io_context = iocp_context;
+#elif BOOST_COROSIO_HAS_IO_URING
+using io_context = io_uring_context;
 #elif BOOST_COROSIO_HAS_EPOLL
 using io_context = epoll_context;
 #elif BOOST_COROSIO_HAS_KQUEUE
-// using io_context = kqueue_context;
-using io_context = select_context;  // fallback until kqueue implemented
+using io_context = kqueue_context;
+#elif BOOST_COROSIO_HAS_POLL
+using io_context = poll_context;
 #elif BOOST_COROSIO_HAS_SELECT
 using io_context = select_context;
 #endif
@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_IO_CONTEXT_POOL_HPP
+#define BOOST_COROSIO_IO_CONTEXT_POOL_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_context.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace boost::corosio {
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // class needs to have dll-interface
+#endif
+
+/** A sharded runtime of one I/O context per thread.
+
+    The pool owns `size()` independent @ref io_context instances and,
+    once started, one thread running each of them. Every context is
+    constructed with a concurrency hint of 1, so posts made from its
+    own thread take the scheduler's single-threaded fast path. Work
+    is spread across shards by choosing an executor, either in
+    round-robin order or by hashing a key so that related work
+    always lands on the same shard.
+
+    Threads can optionally be pinned, thread `i` to CPU
+    `i % std::thread::hardware_concurrency()`, or bound to the CPUs
+    of NUMA node `i % nodes`. Pinning is a no-op on platforms
+    without an affinity API.
+
+    With NUMA placement each context is also constructed on a thread
+    of its node, so that the memory it allocates up front, and
+    everything its own thread allocates later (sockets, coroutine
+    frames, the buffers of its @ref buffer_pool), is local to the
+    node whose CPUs process its completions. Work handed to a shard
+    of another node, as found with @ref node_of, pays the remote
+    access.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe for @ref get_executor and @ref get_context.
+    @ref start, @ref stop and @ref join must not be called concurrently.
+
+    @par Example
+    @code
+    io_context_pool pool(4);
+    for (int i = 0; i < 100; ++i)
+        capy::run_async(pool.get_executor())(session());
+    pool.start();
+    pool.join();    // returns once every shard runs out of work
+    @endcode
+
+    @see tcp_server
+*/
+class BOOST_COROSIO_DECL io_context_pool
+{
+public:
+    /// The executor type handed out by the pool.
+    using executor_type = io_context::executor_type;
+
+    /// Thread placement policy.
+    enum class affinity
+    {
+        /// Threads are scheduled freely by the operating system.
+        none,
+
+        /// Thread `i` is pinned to CPU `i % hardware_concurrency()`.
+        per_core,
+
+        /** Thread `i` is bound to the CPUs of NUMA node `i % nodes`.
+
+            The scheduler of the node chooses among its CPUs. On a
+            machine with one node, or where the topology cannot be
+            read, this is the same as `none`.
+        */
+        per_node
+    };
+
+    /** Construct a pool with one shard per hardware thread.
+
+        @param placement The thread placement policy.
+    */
+    explicit
+    io_context_pool(affinity placement = affinity::none);
+
+    /** Construct a pool with a number of shards.
+
+        @param size The number of contexts. Zero is treated as one.
+        @param placement The thread placement policy.
+    */
+    explicit
+    io_context_pool(
+        std::size_t size,
+        affinity placement = affinity::none);
+
+    /** Destructor.
+
+        Stops every context and joins the threads.
+    */
+    ~io_context_pool();
+
+    io_context_pool(io_context_pool const&) = delete;
+    io_context_pool& operator=(io_context_pool const&) = delete;
+
+    /// Return the number of shards.
+    std::size_t
+    size() const noexcept
+    {
+        return contexts_.size();
+    }
+
+    /** Return the context for a shard.
+
+        @param index The shard index. Must be less than `size()`.
+    */
+    io_context&
+    get_context(std::size_t index) const noexcept
+    {
+        return *contexts_[index];
+    }
+
+    /** Return the shard index that owns a context.
+
+        @return The index, or `size()` if `ctx` is not part of the pool.
+    */
+    std::size_t
+    index_of(capy::execution_context const& ctx) const noexcept;
+
+    /** Return the NUMA node a shard is bound to.
+
+        @param index The shard index. Must be less than `size()`.
+
+        @return The node number, or 0 unless the pool was
+            constructed with `affinity::per_node`.
+    */
+    unsigned
+    node_of(std::size_t index) const noexcept
+    {
+        return nodes_.empty() ? 0 : nodes_[index];
+    }
+
+    /** Return an executor, cycling through the shards.
+
+        Successive calls return executors for successive shards.
+    */
+    executor_type
+    get_executor() const noexcept
+    {
+        auto i = next_.fetch_add(1, std::memory_order_relaxed);
+        return contexts_[i % contexts_.size()]->get_executor();
+    }
+
+    /** Return the executor for the shard selected by a key.
+
+        The same key always selects the same shard, which keeps
+        related work (for example one client's sessions) together.
+
+        @param key A hash or other value identifying the work.
+    */
+    executor_type
+    get_executor(std::size_t key) const noexcept
+    {
+        return contexts_[key % contexts_.size()]->get_executor();
+    }
+
+    /** Start one thread running each context.
+
+        Each context holds outstanding work until @ref join or
+        @ref stop, so its thread keeps running while idle.
+
+        @throws std::logic_error if the pool is already started.
+    */
+    void start();
+
+    /** Stop every context.
+
+        Threads return from `run()` as soon as possible; queued work
+        remains queued. Call @ref join to wait for the threads.
+    */
+    void stop();
+
+    /** Release the pool's work and wait for every thread to finish.
+
+        Each thread returns once its context runs out of work or is
+        stopped. Afterwards the pool may be started again.
+    */
+    void join();
+
+private:
+    std::vector<std::unique_ptr<io_context>> contexts_;
+    std::vector<std::thread> threads_;
+    std::vector<unsigned> nodes_;    // node of each shard, per_node
+    mutable std::atomic<std::size_t> next_{0};
+    affinity placement_;
+    bool holding_work_ = false;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace boost::corosio
+
+#endif
@@ -13,8 +13,14 @@
 #include <boost/corosio/detail/config.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 
+#include <memory>
+
 namespace boost::corosio {
 
+namespace detail {
+class io_deadline;
+} // namespace detail
+
 /** Base class for I/O objects in the library hierarchy.
 
     This class provides a common base for all I/O object implementations
@@ -52,7 +58,14 @@ public:
     }
 
 protected:
-    virtual ~io_object() = default;
+    /// Operation slots with a deadline of their own.
+    enum deadline_slot
+    {
+        read_slot,      ///< Reads and accepts
+        write_slot      ///< Writes and connects
+    };
+
+    virtual ~io_object();
 
     explicit
     io_object(
@@ -61,8 +74,25 @@ protected:
     {
     }
 
+    /** Return the deadline of an operation slot.
+
+        The deadline is created on first use and kept for the
+        lifetime of the object. Moving an object does not move it.
+    */
+    detail::io_deadline& get_deadline(deadline_slot slot);
+
+    /** Associate the object with another execution context.
+
+        Deadlines made for the previous context are dropped. No
+        operation may be pending.
+    */
+    void rebind_context(capy::execution_context& ctx) noexcept;
+
     capy::execution_context* ctx_ = nullptr;
     io_object_impl* impl_ = nullptr;
+
+private:
+    std::unique_ptr<detail::io_deadline> deadlines_[2];
 };
 
 } // namespace boost::corosio
@@ -11,14 +11,19 @@
 #define BOOST_COROSIO_IO_STREAM_HPP
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/buffer_lease.hpp>
+#include <boost/corosio/buffer_pool.hpp>
 #include <boost/corosio/io_object.hpp>
+#include <boost/corosio/detail/io_deadline.hpp>
 #include <boost/capy/io_result.hpp>
 #include <boost/corosio/io_buffer_param.hpp>
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <chrono>
 #include <coroutine>
 #include <cstddef>
+#include <memory>
 #include <stop_token>
 
 namespace boost::corosio {
@@ -61,6 +66,63 @@ public:
         return read_some_awaitable<MutableBufferSequence>(*this, buffers);
     }
 
+    /** Initiate an asynchronous read with a deadline.
+
+        Like @ref read_some, but the read is cancelled if it has not
+        completed by `deadline`, and then completes with
+        `errc::timed_out`. The deadline uses a timer node kept by the
+        stream, so no timer or stop source of the caller's is needed.
+        Cancellation via `std::stop_token` still applies.
+
+        @param buffers The buffer sequence to read data into.
+        @param deadline The time at which the read is cancelled.
+
+        @return An awaitable that completes as for @ref read_some.
+    */
+    template<class MutableBufferSequence>
+    auto read_some(
+        MutableBufferSequence const& buffers,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        return detail::deadline_awaitable<
+            read_some_awaitable<MutableBufferSequence>>(
+                get_deadline(read_slot), deadline, *this, buffers);
+    }
+
+    /** Initiate an asynchronous read into a leased buffer.
+
+        Like @ref read_some, but the stream chooses the buffer. An
+        implementation with a buffer pool, such as an
+        `io_uring_context` configured with provided buffers, takes a
+        buffer only when data arrives, so a pending read holds no
+        memory. A socket on another backend waits until it is readable
+        and only then takes a buffer of `fallback_size` bytes from the
+        context's @ref buffer_pool, which an idle connection thus does
+        not hold either. Other streams hold a buffer from the pool for
+        the duration of the read.
+
+        The operation supports cancellation via `std::stop_token` through
+        the affine awaitable protocol. Data that was already received
+        when the cancellation arrives is still delivered.
+
+        @param fallback_size The size of a buffer taken from the
+            context's @ref buffer_pool.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, buffer_lease}`. On success the lease holds at
+            least one byte; otherwise it is empty. Errors are those of
+            @ref read_some.
+
+        @par Preconditions
+        The socket must be open and connected. A stream that has
+        started a leased read may keep receiving into its pool, so
+        `read_some` and `read_leased` must not be mixed on it.
+    */
+    auto read_leased(std::size_t fallback_size = 4096)
+    {
+        return read_leased_awaitable(*this, fallback_size);
+    }
+
     /** Initiate an asynchronous write operation.
 
         Writes data from the provided buffer sequence. The operation
@@ -93,6 +155,80 @@ public:
         return write_some_awaitable<ConstBufferSequence>(*this, buffers);
     }
 
+    /** Initiate an asynchronous write with a deadline.
+
+        Like @ref write_some, but the write is cancelled if it has not
+        completed by `deadline`, and then completes with
+        `errc::timed_out`.
+
+        @param buffers The buffer sequence containing data to write.
+        @param deadline The time at which the write is cancelled.
+
+        @return An awaitable that completes as for @ref write_some.
+    */
+    template<class ConstBufferSequence>
+    auto write_some(
+        ConstBufferSequence const& buffers,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        return detail::deadline_awaitable<
+            write_some_awaitable<ConstBufferSequence>>(
+                get_deadline(write_slot), deadline, *this, buffers);
+    }
+
+    /** Initiate an asynchronous read that fills the buffers.
+
+        Reads until the buffer sequence is full, an error occurs,
+        or the peer closes its send direction. Unlike a loop over
+        @ref read_some, each partial read is continued by the
+        implementation, so the coroutine is resumed only once, when
+        the whole operation completes.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param buffers The buffer sequence to read data into.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`. On success the byte
+            count is the size of the buffer sequence. On error it is
+            the number of bytes read before the error, which
+            includes `cond::eof` when the peer closed first.
+
+        @par Preconditions
+        The socket must be open and connected.
+    */
+    template<class MutableBufferSequence>
+    auto read_exact(MutableBufferSequence const& buffers)
+    {
+        return read_exact_awaitable<MutableBufferSequence>(*this, buffers);
+    }
+
+    /** Initiate an asynchronous write of all the buffers.
+
+        Writes until the whole buffer sequence is sent or an error
+        occurs. Partial writes are continued by the implementation,
+        so the coroutine is resumed only once.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param buffers The buffer sequence containing data to write.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`. On success the byte
+            count is the size of the buffer sequence. On error it is
+            the number of bytes written before the error.
+
+        @par Preconditions
+        The socket must be open and connected.
+    */
+    template<class ConstBufferSequence>
+    auto write_all(ConstBufferSequence const& buffers)
+    {
+        return write_all_awaitable<ConstBufferSequence>(*this, buffers);
+    }
+
 protected:
     template<class MutableBufferSequence>
     struct read_some_awaitable
@@ -140,7 +276,88 @@ protected:
             std::stop_token token) -> std::coroutine_handle<>
         {
             token_ = std::move(token);
-            ios_.get().read_some(h, ex, buffers_, token_, &ec_, &bytes_transferred_);
+            if (ios_.get().read_some(h, ex, buffers_, token_, &ec_, &bytes_transferred_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    template<class MutableBufferSequence>
+    struct read_exact_awaitable
+        : read_some_awaitable<MutableBufferSequence>
+    {
+        using read_some_awaitable<
+            MutableBufferSequence>::read_some_awaitable;
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            this->token_ = std::move(token);
+            if (this->ios_.get().read_exact(h, ex, this->buffers_,
+                    this->token_, &this->ec_, &this->bytes_transferred_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    struct read_leased_awaitable
+    {
+        io_stream& ios_;
+        std::size_t fallback_size_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable buffer_lease lease_;
+
+        // Used only when the implementation has no buffer pool
+        mutable bool fallback_ = false;
+        mutable std::size_t bytes_transferred_ = 0;
+
+        read_leased_awaitable(
+            io_stream& ios,
+            std::size_t fallback_size) noexcept
+            : ios_(ios)
+            , fallback_size_(fallback_size)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<buffer_lease> await_resume() const noexcept
+        {
+            if (fallback_)
+                lease_.shrink(bytes_transferred_);
+            if (!ec_ && !lease_.empty())
+                return {{}, std::move(lease_)};
+            lease_.reset();
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), {}};
+            return {ec_, {}};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (!ios_.get().read_leased(
+                    h, ex, fallback_size_, token_, &ec_, &lease_))
+            {
+                // No pool: an ordinary read into a buffer from the
+                // context's buffer_pool
+                fallback_ = true;
+                lease_ = get_buffer_pool(ios_.context()).acquire(
+                    fallback_size_);
+                if (ios_.get().read_some(h, ex,
+                        capy::mutable_buffer(lease_), token_,
+                        &ec_, &bytes_transferred_))
+                    return h;
+            }
             return std::noop_coroutine();
         }
     };
@@ -191,15 +408,59 @@ protected:
             std::stop_token token) -> std::coroutine_handle<>
         {
             token_ = std::move(token);
-            ios_.get().write_some(h, ex, buffers_, token_, &ec_, &bytes_transferred_);
+            if (ios_.get().write_some(h, ex, buffers_, token_, &ec_, &bytes_transferred_))
+                return h;
             return std::noop_coroutine();
         }
     };
 
+    template<class ConstBufferSequence>
+    struct write_all_awaitable
+        : write_some_awaitable<ConstBufferSequence>
+    {
+        using write_some_awaitable<
+            ConstBufferSequence>::write_some_awaitable;
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            this->token_ = std::move(token);
+            if (this->ios_.get().write_all(h, ex, this->buffers_,
+                    this->token_, &this->ec_, &this->bytes_transferred_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    struct io_stream_impl;
+
+private:
+    // Loops over read_some or write_some in a coroutine of its own,
+    // for implementations that do not continue transfers natively
+    static bool transfer_all(
+        io_stream_impl&,
+        bool is_read,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*);
+
 public:
     struct io_stream_impl : io_object_impl
     {
-        virtual void read_some(
+        /** Start a read into the given buffers.
+
+            @return `true` if the read completed before returning,
+                with `*ec` and `*bytes` already stored. `h` is then
+                not resumed and the caller continues inline, without
+                suspending.
+        */
+        virtual bool read_some(
             std::coroutine_handle<>,
             capy::executor_ref,
             io_buffer_param,
@@ -207,13 +468,82 @@ public:
             system::error_code*,
             std::size_t*) = 0;
 
-        virtual void write_some(
+        /** Start a write from the given buffers.
+
+            @return `true` if the write completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool write_some(
             std::coroutine_handle<>,
             capy::executor_ref,
             io_buffer_param,
             std::stop_token,
             system::error_code*,
             std::size_t*) = 0;
+
+        /** Start a read into a buffer chosen by the implementation.
+
+            On completion `*lease` holds the received bytes unless
+            `*ec` reports an error or end of file. `size` is the
+            buffer size to use when the implementation takes the
+            buffer from the context's @ref buffer_pool.
+
+            @return `false` if the implementation has no buffer pool,
+                in which case nothing was started and the caller
+                falls back to @ref read_some.
+        */
+        virtual bool read_leased(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            std::size_t,
+            std::stop_token,
+            system::error_code*,
+            buffer_lease*)
+        {
+            return false;
+        }
+
+        /** Start a read that fills the given buffers.
+
+            The default issues @ref read_some until the buffers are
+            full or an error occurs. An implementation that can
+            continue a partial read without resuming the caller
+            overrides it.
+
+            @return `true` if the read completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool read_exact(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            io_buffer_param buffers,
+            std::stop_token token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            return io_stream::transfer_all(
+                *this, true, h, ex, buffers, token, ec, bytes);
+        }
+
+        /** Start a write of all the given buffers.
+
+            The default issues @ref write_some until the buffers are
+            sent or an error occurs, as for @ref read_exact.
+
+            @return `true` if the write completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool write_all(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            io_buffer_param buffers,
+            std::stop_token token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            return io_stream::transfer_all(
+                *this, false, h, ex, buffers, token, ec, bytes);
+        }
     };
 
     /** Returns the underlying implementation.
@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_IO_URING_CONTEXT_HPP
+#define BOOST_COROSIO_IO_URING_CONTEXT_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include <cstddef>
+#include <span>
+
+namespace boost::corosio {
+
+/** Tuning options for an @ref io_uring_context.
+*/
+struct io_uring_options
+{
+    /** Connections an acceptor may accept ahead of `accept()`.
+
+        Nonzero arms `IORING_OP_ACCEPT` in multishot mode (Linux
+        5.19): a single submission keeps accepting, and the accepted
+        descriptors wait in the acceptor until `accept()` is awaited,
+        which then completes without entering the kernel. When the
+        backlog fills, the multishot request is cancelled and re-armed
+        once `accept()` drains it; connections completing in between
+        are still kept. Zero submits one accept per call.
+    */
+    unsigned accept_backlog = 0;
+
+    /** Buffers in the context's receive pool.
+
+        Nonzero registers a provided buffer ring (Linux 5.19) of this
+        many buffers, a power of two up to 32768, used by
+        `read_leased()`: a socket keeps a multishot receive (Linux 6.0)
+        armed and the kernel takes a buffer from the pool only when
+        data arrives, so idle connections hold no read buffers. When
+        the pool runs dry a leased read falls back to a buffer of its
+        own. If the kernel refuses the ring, leased reads always use
+        the fallback. Zero disables the pool.
+    */
+    unsigned buffer_count = 0;
+
+    /// Size of each pool buffer, in bytes.
+    std::size_t buffer_size = 4096;
+
+    /** Slots in the context's registered file table.
+
+        Nonzero registers a table of this many initially empty slots,
+        which @ref io_uring_context::register_file fills. Zero, or a
+        table the kernel refuses, makes `register_file()` return
+        `false`.
+    */
+    unsigned registered_files = 0;
+
+    /** Poll the submission queue from a kernel thread.
+
+        When `true` the ring is created with `IORING_SETUP_SQPOLL`: a
+        kernel thread picks up submissions as soon as they are queued,
+        so starting an operation makes no syscall while the thread is
+        awake. The thread occupies a CPU while it polls, which suits
+        deployments with cores to spare for I/O.
+    */
+    bool sq_poll = false;
+
+    /** Milliseconds the polling thread spins without work before it
+        sleeps. Waking it again costs one syscall. Zero uses the
+        kernel default of one second. Used only with @ref sq_poll.
+    */
+    unsigned sq_thread_idle = 0;
+
+    /** CPU the polling thread is pinned to, or -1 to leave it
+        unpinned. Used only with @ref sq_poll.
+    */
+    int sq_thread_cpu = -1;
+
+    /// How the context keeps its timers.
+    timer_options timers;
+};
+
+class socket;
+
+/** I/O context using Linux io_uring.
+
+    This context provides an execution environment for async operations
+    using an io_uring instance. Operations are submitted to the kernel
+    and completed there, so reads and writes need no readiness
+    notification followed by a separate syscall, and submissions
+    made between two reactor waits are handed to the kernel together.
+
+    The backend is built only when `BOOST_COROSIO_USE_IO_URING` is
+    defined (the `BOOST_COROSIO_USE_IO_URING` CMake option), and requires
+    Linux 5.11 or later. When built, it becomes the `io_context`
+    alias on Linux; `epoll_context` remains available explicitly:
+
+    @code
+    epoll_context ctx1;      // readiness-based
+    io_uring_context ctx2;   // completion-based
+    @endcode
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe, if using a concurrency hint greater than 1.
+
+    @par Example
+    @code
+    io_uring_context ctx;
+    auto ex = ctx.get_executor();
+    run_async(ex)(my_coroutine());
+    ctx.run();  // Process all queued work
+    @endcode
+*/
+class BOOST_COROSIO_DECL io_uring_context : public basic_io_context
+{
+public:
+    /** Construct an io_uring_context with default concurrency.
+
+        The concurrency hint is set to the number of hardware threads
+        available on the system. If more than one thread is available,
+        thread-safe synchronization is used.
+
+        @throws std::system_error if the ring cannot be created.
+    */
+    io_uring_context();
+
+    /** Construct an io_uring_context with a concurrency hint.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`. If greater than 1, thread-safe
+            synchronization is used internally.
+
+        @throws std::system_error if the ring cannot be created.
+    */
+    explicit
+    io_uring_context(unsigned concurrency_hint);
+
+    /** Construct an io_uring_context with a concurrency hint and options.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`.
+        @param opts Tuning options.
+
+        @throws std::system_error if the ring cannot be created.
+    */
+    io_uring_context(
+        unsigned concurrency_hint,
+        io_uring_options const& opts);
+
+    /** Destructor. */
+    ~io_uring_context();
+
+    /** Register buffers with the kernel for fixed-buffer reads.
+
+        The kernel pins the pages of every buffer once, here, instead
+        of on each read. Afterwards a `read_some()` on a socket of this
+        context whose buffer sequence is a single buffer lying inside
+        one of `bufs` is issued as `IORING_OP_READ_FIXED`. Any sub-range
+        of a registered buffer qualifies, so a registered arena can be
+        carved up freely. Other reads, and all writes, are unaffected.
+
+        Replaces any earlier registration. The memory must stay valid
+        until @ref unregister_buffers is called or the context is
+        destroyed. Must not be called while reads are being started
+        on the context's sockets.
+
+        @param bufs The buffers, at most 16384, each at most 1 GiB.
+
+        @throws std::system_error if the kernel rejects the buffers,
+            for example because they exceed `RLIMIT_MEMLOCK`.
+    */
+    void
+    register_buffers(std::span<capy::mutable_buffer const> bufs);
+
+    /** Unregister the buffers passed to @ref register_buffers.
+
+        Reads already submitted complete normally.
+    */
+    void
+    unregister_buffers() noexcept;
+
+    /** Place a socket in the registered file table.
+
+        Requests on a registered socket name its table slot instead of
+        its descriptor, which saves the kernel a descriptor lookup and
+        reference count on each one; this pays off for long-lived
+        connections with many small reads and writes. The slot is
+        released when the socket is closed.
+
+        Must not be called while the socket has operations pending.
+
+        @param s An open socket of this context.
+
+        @return `true` if the socket is registered, `false` if the table
+            is full or was not configured with
+            @ref io_uring_options::registered_files.
+
+        @throws std::logic_error if `s` belongs to another context.
+        @throws std::system_error if the kernel rejects the update.
+    */
+    bool
+    register_file(socket& s);
+
+    // Non-copyable
+    io_uring_context(io_uring_context const&) = delete;
+    io_uring_context& operator=(io_uring_context const&) = delete;
+};
+
+} // namespace boost::corosio
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_IO_URING_CONTEXT_HPP
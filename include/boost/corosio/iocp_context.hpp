@@ -16,9 +16,89 @@
 #if BOOST_COROSIO_HAS_IOCP
 
 #include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include <span>
 
 namespace boost::corosio {
 
+/** Tuning options for an @ref iocp_context.
+*/
+struct iocp_options
+{
+    /** Completions a thread dequeues per kernel transition.
+
+        Each thread inside `run()` or `poll()` takes up to this many
+        completions with one `GetQueuedCompletionStatusEx` call and
+        runs them before returning to the port. Larger batches save
+        kernel transitions under load, at the cost of completions
+        waiting behind the ones a busy thread already holds instead
+        of going to an idle thread. `run_one()`, `poll_one()` and
+        `wait_one()` always take a single completion. Zero is treated
+        as one.
+    */
+    unsigned completion_batch = 16;
+
+    /** Use Registered I/O (RIO) for sockets where possible.
+
+        When `true` and the system provides RIO (Windows 8 or later),
+        sockets are created for registered I/O and each gets a RIO
+        request queue. A `read_some()` or `write_some()` whose buffer
+        sequence is a single buffer lying inside one registered with
+        @ref iocp_context::register_buffers is then issued as
+        `RIOReceive` or `RIOSend`: the buffer pages are not locked
+        per operation, and completions are dequeued in batches from
+        a RIO completion queue notified through the completion port.
+        Other operations use overlapped I/O as before.
+
+        A pending RIO request cannot be cancelled on its own: a
+        cancellation takes effect when the request completes, or when
+        the socket is closed.
+    */
+    bool registered_io = false;
+
+    /** Connections an acceptor may accept ahead of `accept()`.
+
+        Nonzero makes each listening acceptor keep this many
+        `AcceptEx` calls posted, each with a socket created ahead of
+        time. Connections they accept wait in the acceptor until
+        `accept()` is awaited, which then completes without another
+        round trip to the kernel, and their slots are posted again.
+        Posted and waiting connections together never exceed this
+        number. Zero posts one `AcceptEx` per call.
+    */
+    unsigned accept_backlog = 0;
+
+    /** Wait for socket readiness by polling the AFD driver.
+
+        When `true` and the driver can be opened, `socket::wait()`
+        issues an `IOCTL_AFD_POLL` request to `\Device\Afd` through
+        the completion port, as wepoll and libuv do, instead of a
+        zero-byte receive. A waiting socket then holds no receive in
+        the kernel, write waits complete only once there is room to
+        send, and error waits are supported. Otherwise, or when
+        `false`, waits behave as described at `socket::wait()`.
+    */
+    bool afd_poll = false;
+
+    /** Wake the port for timers with a high resolution waitable timer.
+
+        When `true` and the system supports it (Windows 10 version
+        1803 or later), the waitable timer that wakes the completion
+        port for the nearest expiry is created with
+        `CREATE_WAITABLE_TIMER_HIGH_RESOLUTION`, so timers complete
+        within a fraction of a millisecond instead of at the next
+        system clock tick, without `timeBeginPeriod`. Otherwise, or
+        when `false`, timers are rounded to the system tick, usually
+        15.6 milliseconds.
+    */
+    bool high_resolution_timers = true;
+
+    /// How the context keeps its timers.
+    timer_options timers;
+};
+
 /** I/O context using Windows I/O Completion Ports for event multiplexing.
 
     This context provides an execution environment for async operations
@@ -58,9 +138,67 @@ public:
     explicit
     iocp_context(unsigned concurrency_hint);
 
+    /** Construct an iocp_context with a concurrency hint and options.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`.
+        @param opts Tuning options.
+    */
+    iocp_context(
+        unsigned concurrency_hint,
+        iocp_options const& opts);
+
     /** Destructor. */
     ~iocp_context();
 
+    /** Return `true` if sockets of this context use Registered I/O.
+
+        This is the case when @ref iocp_options::registered_io was
+        set and the system supports RIO.
+    */
+    bool
+    registered_io();
+
+    /** Register buffers for RIO reads and writes.
+
+        Afterwards a `read_some()` or `write_some()` on a socket of
+        this context whose buffer sequence is a single buffer lying
+        inside one of `bufs` goes through RIO. Any sub-range of a
+        registered buffer qualifies, so a registered arena can be
+        carved up freely.
+
+        Replaces any earlier registration. The memory must stay valid
+        until @ref unregister_buffers is called or the context is
+        destroyed. Must not be called while operations on registered
+        buffers are pending.
+
+        @param bufs The buffers, each smaller than 4 GiB.
+
+        @throws std::system_error if the context does not use
+            registered I/O, or the system rejects a buffer.
+    */
+    void
+    register_buffers(std::span<capy::mutable_buffer const> bufs);
+
+    /** Unregister the buffers passed to @ref register_buffers. */
+    void
+    unregister_buffers() noexcept;
+
+    /** Return the I/O completion port of this context.
+
+        Completions, expired timers and posted handlers are all
+        queued to the port. A completion port is not a waitable
+        object, and waiting on it dequeues completions, so a host
+        event loop does not wait on it: @ref poll_ready_timeout is
+        zero and the host calls @ref poll_ready on each turn of its
+        loop. The handle stays owned by the context and must not be
+        closed.
+
+        @return The port, as a `HANDLE`.
+    */
+    void*
+    native_handle() const noexcept;
+
     // Non-copyable
     iocp_context(iocp_context const&) = delete;
     iocp_context& operator=(iocp_context const&) = delete;
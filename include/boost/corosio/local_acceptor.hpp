@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_LOCAL_ACCEPTOR_HPP
+#define BOOST_COROSIO_LOCAL_ACCEPTOR_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/local_stream_socket.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/concept/executor.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <concepts>
+#include <coroutine>
+#include <stop_token>
+#include <string_view>
+#include <type_traits>
+
+namespace boost::corosio {
+
+/** An asynchronous Unix domain stream acceptor for coroutine I/O.
+
+    The local counterpart of @ref acceptor: it binds a path,
+    listens, and accepts connections into @ref local_stream_socket
+    objects, using the backend's acceptor.
+
+    Binding a pathname creates a socket file, which fails with
+    `errc::address_in_use` while the file exists. The file is not
+    removed on close; remove it once the acceptor is closed, and
+    remove a stale one before listening.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. An acceptor must not have concurrent accept
+    operations.
+
+    @par Example
+    @code
+    local_acceptor acc(ioc);
+    acc.listen("/run/app.sock");
+
+    local_stream_socket peer(ioc);
+    auto [ec] = co_await acc.accept(peer);
+    @endcode
+*/
+class BOOST_COROSIO_DECL local_acceptor : public io_object
+{
+    struct accept_awaitable
+    {
+        local_acceptor& acc_;
+        local_stream_socket& peer_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable io_object::io_object_impl* peer_impl_ = nullptr;
+
+        accept_awaitable(
+            local_acceptor& acc,
+            local_stream_socket& peer) noexcept
+            : acc_(acc)
+            , peer_(peer)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled)};
+
+            // Transfer the accepted impl to the peer socket
+            if (!ec_ && peer_impl_)
+            {
+                peer_.close();
+                peer_.impl_ = peer_impl_;
+            }
+            return {ec_};
+        }
+
+        template<typename Ex>
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            Ex const& ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            acc_.get().accept(h, ex, token_, &ec_, &peer_impl_);
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    /** Destructor.
+
+        Closes the acceptor if open, cancelling any pending operations.
+    */
+    ~local_acceptor();
+
+    /** Construct a local acceptor from an execution context.
+
+        @param ctx The execution context that will own this acceptor.
+    */
+    explicit local_acceptor(capy::execution_context& ctx);
+
+    /** Construct a local acceptor from an executor.
+
+        The acceptor is associated with the executor's context.
+
+        @param ex The executor whose context will own the acceptor.
+    */
+    template<class Ex>
+        requires (!std::same_as<std::remove_cvref_t<Ex>, local_acceptor>) &&
+                 capy::Executor<Ex>
+    explicit local_acceptor(Ex const& ex)
+        : local_acceptor(ex.context())
+    {
+    }
+
+    /** Move constructor.
+
+        Transfers ownership of the acceptor resources.
+
+        @param other The acceptor to move from.
+    */
+    local_acceptor(local_acceptor&& other) noexcept
+        : io_object(other.context())
+    {
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+
+    /** Move assignment operator.
+
+        Closes any existing acceptor and transfers ownership.
+        The source and destination must share the same execution context.
+
+        @param other The acceptor to move from.
+
+        @return Reference to this acceptor.
+
+        @throws std::logic_error if the acceptors have different execution contexts.
+    */
+    local_acceptor& operator=(local_acceptor&& other)
+    {
+        if (this != &other)
+        {
+            if (ctx_ != other.ctx_)
+                detail::throw_logic_error(
+                    "cannot move acceptor across execution contexts");
+            close();
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    local_acceptor(local_acceptor const&) = delete;
+    local_acceptor& operator=(local_acceptor const&) = delete;
+
+    /** Open, bind, and listen on a path.
+
+        @param path The socket path. On Linux, a path starting with
+            a NUL byte names a socket in the abstract namespace.
+
+        @param backlog The maximum length of the queue of pending
+            connections.
+
+        @throws std::system_error on failure, including
+            `errc::address_in_use` when the path exists and
+            `errc::operation_not_supported` with a backend that has
+            no local sockets.
+    */
+    void listen(std::string_view path, int backlog = 128);
+
+    /** Close the acceptor.
+
+        Releases acceptor resources. Any pending operations complete
+        with `errc::operation_canceled`. The socket file remains.
+    */
+    void close();
+
+    /** Check if the acceptor is listening.
+
+        @return `true` if the acceptor is open and listening.
+    */
+    bool is_open() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /** Initiate an asynchronous accept operation.
+
+        Accepts an incoming connection into `peer`, closing any
+        connection it had.
+
+        @param peer The socket to receive the accepted connection.
+
+        @return An awaitable that completes with `io_result<>`.
+
+        @throws std::logic_error if the acceptor is not listening.
+    */
+    auto accept(local_stream_socket& peer)
+    {
+        if (!impl_)
+            detail::throw_logic_error("accept: acceptor not listening");
+        return accept_awaitable(*this, peer);
+    }
+
+    /** Cancel any pending asynchronous operations.
+
+        All outstanding operations complete with `errc::operation_canceled`.
+        Check `ec == cond::canceled` for portable comparison.
+    */
+    void cancel();
+
+private:
+    inline acceptor::acceptor_impl& get() const noexcept
+    {
+        return *static_cast<acceptor::acceptor_impl*>(impl_);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,399 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_LOCAL_STREAM_SOCKET_HPP
+#define BOOST_COROSIO_LOCAL_STREAM_SOCKET_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/concept/executor.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <stop_token>
+#include <string_view>
+#include <type_traits>
+
+namespace boost::corosio {
+
+/** An asynchronous Unix domain stream socket for coroutine I/O.
+
+    A local stream socket connects processes on the same host
+    through a filesystem path (`AF_UNIX`, also on Windows 10 and
+    later). It reads and writes like a @ref socket, through the
+    same backend and the same @ref io_stream interface, so it
+    works with the stream algorithms and TLS streams.
+
+    Local sockets are provided by the epoll, io_uring, select, and
+    IOCP backends. On Linux, a path starting with a NUL byte names
+    a socket in the abstract namespace, which has no file.
+
+    Where the backend supports it, a descriptor can be passed to
+    the peer with @ref send_descriptor and taken with
+    @ref receive_descriptor. This is available with the epoll and
+    select backends; others report `errc::operation_not_supported`.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. One read and one write may be in flight
+    simultaneously.
+
+    @par Example
+    @code
+    local_stream_socket s(ioc);
+    s.open();
+    auto [ec] = co_await s.connect("/run/app.sock");
+    if (ec)
+        co_return;
+    auto [wec, n] = co_await s.write_some(
+        capy::const_buffer("ping", 4));
+    @endcode
+*/
+class BOOST_COROSIO_DECL local_stream_socket : public io_stream
+{
+    struct connect_awaitable
+    {
+        local_stream_socket& s_;
+        std::string_view path_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+
+        connect_awaitable(
+            local_stream_socket& s,
+            std::string_view path) noexcept
+            : s_(s)
+            , path_(path)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled)};
+            return {ec_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            // A local connect completes or fails without waiting
+            token_ = std::move(token);
+            ec_ = s_.connect_now(path_);
+            return h;
+        }
+    };
+
+    struct send_descriptor_awaitable
+    {
+        local_stream_socket& s_;
+        native_handle_type fd_;
+        char byte_ = 0;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_ = 0;
+
+        send_descriptor_awaitable(
+            local_stream_socket& s,
+            native_handle_type fd) noexcept
+            : s_(s)
+            , fd_(fd)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<> await_resume() const noexcept
+        {
+            if (token_.stop_requested() && bytes_ == 0)
+                return {make_error_code(system::errc::operation_canceled)};
+            return {ec_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (s_.get().write_with_descriptor(h, ex,
+                    capy::const_buffer(&byte_, 1), fd_,
+                    token_, &ec_, &bytes_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    struct receive_descriptor_awaitable
+    {
+        local_stream_socket& s_;
+        char byte_ = 0;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_ = 0;
+        mutable native_handle_type fd_ = native_handle_type(-1);
+
+        explicit receive_descriptor_awaitable(
+            local_stream_socket& s) noexcept
+            : s_(s)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<native_handle_type> await_resume() const noexcept
+        {
+            // A descriptor that arrived is returned even after a stop,
+            // so that it is not leaked
+            if (bytes_ == 0)
+            {
+                if (token_.stop_requested())
+                    return {make_error_code(
+                        system::errc::operation_canceled), fd_};
+                if (ec_)
+                    return {ec_, fd_};
+                return {capy::error::eof, fd_};
+            }
+            if (fd_ == native_handle_type(-1))
+                return {make_error_code(system::errc::bad_message), fd_};
+            return {{}, fd_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (s_.get().read_with_descriptor(h, ex,
+                    capy::mutable_buffer(&byte_, 1), &fd_,
+                    token_, &ec_, &bytes_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    /** Destructor.
+
+        Closes the socket if open, cancelling any pending operations.
+    */
+    ~local_stream_socket();
+
+    /** Construct a local stream socket from an execution context.
+
+        @param ctx The execution context that will own this socket.
+    */
+    explicit local_stream_socket(capy::execution_context& ctx);
+
+    /** Construct a local stream socket from an executor.
+
+        The socket is associated with the executor's context.
+
+        @param ex The executor whose context will own the socket.
+    */
+    template<class Ex>
+        requires (!std::same_as<std::remove_cvref_t<Ex>, local_stream_socket>) &&
+                 capy::Executor<Ex>
+    explicit local_stream_socket(Ex const& ex)
+        : local_stream_socket(ex.context())
+    {
+    }
+
+    /** Move constructor.
+
+        Transfers ownership of the socket resources.
+
+        @param other The socket to move from.
+    */
+    local_stream_socket(local_stream_socket&& other) noexcept
+        : io_stream(other.context())
+    {
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+
+    /** Move assignment operator.
+
+        Closes any existing socket and transfers ownership.
+        The source and destination must share the same execution context.
+
+        @param other The socket to move from.
+
+        @return Reference to this socket.
+
+        @throws std::logic_error if the sockets have different execution contexts.
+    */
+    local_stream_socket& operator=(local_stream_socket&& other)
+    {
+        if (this != &other)
+        {
+            if (ctx_ != other.ctx_)
+                detail::throw_logic_error(
+                    "cannot move socket across execution contexts");
+            close();
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    local_stream_socket(local_stream_socket const&) = delete;
+    local_stream_socket& operator=(local_stream_socket const&) = delete;
+
+    /** Open the socket.
+
+        Creates an `AF_UNIX` stream socket and associates it with
+        the platform reactor. This must be called before connecting.
+
+        @throws std::system_error on failure, including
+            `errc::operation_not_supported` with a backend that has
+            no local sockets.
+    */
+    void open();
+
+    /** Close the socket.
+
+        Releases socket resources. Any pending operations complete
+        with `errc::operation_canceled`.
+    */
+    void close();
+
+    /** Check if the socket is open.
+
+        @return `true` if the socket is open and ready for operations.
+    */
+    bool is_open() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /** Connect to the socket bound at a path.
+
+        A local connect does not wait: it completes when the
+        awaitable is resumed, with an error such as
+        `errc::connection_refused` when nothing listens at `path`,
+        or `errc::resource_unavailable_try_again` when the
+        listener's queue is full.
+
+        @param path The path of the listening socket. It must stay
+            valid until the awaitable completes.
+
+        @return An awaitable that completes with `io_result<>`.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto connect(std::string_view path)
+    {
+        if (!impl_)
+            detail::throw_logic_error("connect: socket not open");
+        return connect_awaitable(*this, path);
+    }
+
+    /** Pass a descriptor to the peer.
+
+        Sends one byte with `fd` attached as `SCM_RIGHTS`. The
+        peer takes it with @ref receive_descriptor, which gets a
+        duplicate; `fd` stays open here and the caller may close
+        it once this completes.
+
+        @param fd The descriptor to pass.
+
+        @return An awaitable that completes with `io_result<>`.
+            Fails with `errc::operation_not_supported` where the
+            backend cannot pass descriptors.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto send_descriptor(native_handle_type fd)
+    {
+        if (!impl_)
+            detail::throw_logic_error("send_descriptor: socket not open");
+        return send_descriptor_awaitable(*this, fd);
+    }
+
+    /** Take a descriptor passed by the peer.
+
+        Reads the byte written by the peer's @ref send_descriptor
+        and returns the descriptor that came with it, which the
+        caller then owns. Call it only where the peer's protocol
+        places a descriptor; other bytes in the stream must be
+        read with @ref read_some.
+
+        @return An awaitable that completes with
+            `io_result<native_handle_type>`. Fails with `cond::eof`
+            when the peer has closed, `errc::bad_message` when the
+            byte came without a descriptor, and
+            `errc::operation_not_supported` where the backend
+            cannot pass descriptors.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto receive_descriptor()
+    {
+        if (!impl_)
+            detail::throw_logic_error("receive_descriptor: socket not open");
+        return receive_descriptor_awaitable(*this);
+    }
+
+    /** Cancel any pending asynchronous operations.
+
+        All outstanding operations complete with `errc::operation_canceled`.
+        Check `ec == cond::canceled` for portable comparison.
+    */
+    void cancel();
+
+    /** Disable sends or receives on the socket.
+
+        @param what Determines what operations will no longer be allowed.
+    */
+    void shutdown(socket::shutdown_type what);
+
+    /** Get the native socket handle.
+
+        @return The native handle, or an invalid value (-1 on POSIX,
+            INVALID_SOCKET on Windows) if the socket is not open.
+    */
+    native_handle_type native_handle() const noexcept;
+
+private:
+    friend class local_acceptor;
+
+    system::error_code connect_now(std::string_view path);
+
+    inline socket::socket_impl& get() const noexcept
+    {
+        return *static_cast<socket::socket_impl*>(impl_);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_LOOP_MONITOR_HPP
+#define BOOST_COROSIO_LOOP_MONITOR_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace boost::corosio {
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // class needs to have dll-interface
+#endif
+
+/** A handler that ran for at least the stall threshold.
+
+    @see loop_monitor
+*/
+struct stall_report
+{
+    /** The address of the handler.
+
+        For a posted coroutine this is the coroutine's frame, as
+        returned by `std::coroutine_handle::address`; otherwise it
+        is the context's internal operation object.
+    */
+    void const* handler = nullptr;
+
+    /// The thread running the handler.
+    std::thread::id thread;
+
+    /// How long the handler had run when it was seen.
+    std::chrono::nanoseconds duration{0};
+
+    /// True if the handler was still running when reported.
+    bool running = false;
+};
+
+/// Options for a @ref loop_monitor.
+struct loop_monitor_options
+{
+    /// How often to post a probe that measures scheduling lag.
+    std::chrono::milliseconds probe_interval{100};
+
+    /** The handler duration that counts as a stall.
+
+        The monitor checks the running threads at half this
+        interval, so a handler stuck in the loop is reported while
+        it still runs.
+    */
+    std::chrono::milliseconds stall_threshold{50};
+
+    /** Called for each handler that reaches the threshold.
+
+        Runs on the monitor's own thread, never on a thread of the
+        context, so it must be thread-safe, must not throw, and
+        should return quickly. A handler is reported once: while
+        it still runs if the monitor saw it then, otherwise when it
+        finishes.
+    */
+    std::function<void(stall_report const&)> on_stall;
+};
+
+/** Watches an I/O context for stalls.
+
+    While it exists the monitor runs a thread that posts a probe
+    handler to the context every @ref loop_monitor_options::probe_interval
+    and measures how long the probe waited to run: the scheduling
+    lag that every handler is seeing. It also has the context time
+    each handler, keeping the longest duration per thread and
+    reporting handlers that take @ref loop_monitor_options::stall_threshold
+    or longer to `on_stall`.
+
+    Timing a handler costs two clock reads and a few relaxed stores,
+    cheap enough to leave on in production. Handler timing is
+    available with the epoll, select and IOCP backends; with others
+    only the lag is measured. At most one monitor may be attached to
+    a context at a time, and it must be destroyed before the
+    context.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    loop_monitor mon(ioc, {
+        .stall_threshold = std::chrono::milliseconds(20),
+        .on_stall = [](stall_report const& r) {
+            std::fprintf(stderr, "handler %p ran %lld us\n", r.handler,
+                static_cast<long long>(r.duration.count() / 1000));
+        }});
+    ioc.run();
+    @endcode
+*/
+class BOOST_COROSIO_DECL loop_monitor
+{
+public:
+    /// The longest handler one thread has run.
+    struct thread_longest
+    {
+        std::thread::id thread;
+        std::chrono::nanoseconds duration{0};
+    };
+
+    /** Start monitoring a context.
+
+        @param ctx The context to watch.
+        @param opts The options.
+
+        @throws std::system_error if the thread cannot be started.
+    */
+    loop_monitor(
+        basic_io_context& ctx,
+        loop_monitor_options opts = {});
+
+    /** Stop monitoring.
+
+        Stops the monitor's thread and the handler timing. A probe
+        still queued is discarded with the context's other work.
+    */
+    ~loop_monitor();
+
+    loop_monitor(loop_monitor const&) = delete;
+    loop_monitor& operator=(loop_monitor const&) = delete;
+
+    /// Return true if the context times its handlers.
+    bool
+    timing_handlers() const noexcept;
+
+    /// Return the lag measured by the last probe that ran.
+    std::chrono::nanoseconds
+    lag() const noexcept;
+
+    /// Return the largest lag measured.
+    std::chrono::nanoseconds
+    max_lag() const noexcept;
+
+    /** Return the longest handler of each thread inside `run()`.
+
+        Threads that have left `run()` are not listed.
+    */
+    std::vector<thread_longest>
+    longest_handlers() const;
+
+private:
+    struct state;
+    std::shared_ptr<state> st_;
+    std::thread thread_;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace boost::corosio
+
+#endif
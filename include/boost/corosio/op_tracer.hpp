@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_OP_TRACER_HPP
+#define BOOST_COROSIO_OP_TRACER_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+namespace boost::corosio {
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // class needs to have dll-interface
+#endif
+
+/** The life of one traced I/O operation.
+
+    An operation is initiated by the call that starts it. One that
+    must wait becomes ready when the reactor reports its descriptor
+    and is queued once the reactor has performed its I/O; the
+    coroutine is resumed when a thread runs it. An operation that
+    finishes without waiting, or with an error, is queued when it is
+    initiated, so its `ready` and `queued` equal `initiated`.
+
+    @see op_tracer
+*/
+struct op_trace
+{
+    using time_point = std::chrono::steady_clock::time_point;
+
+    time_point initiated;
+    time_point ready;
+    time_point queued;
+    time_point resumed;
+
+    /// True if the operation waited for the reactor.
+    bool parked = false;
+
+    /** True if the operation was cancelled.
+
+        The times of a cancelled operation before `resumed` say when
+        it was started, not when it finished.
+    */
+    bool cancelled = false;
+
+    /// Return the time spent waiting for the descriptor.
+    std::chrono::nanoseconds
+    wait_time() const noexcept
+    {
+        return ready - initiated;
+    }
+
+    /// Return the time the reactor took to perform the I/O.
+    std::chrono::nanoseconds
+    dispatch_time() const noexcept
+    {
+        return queued - ready;
+    }
+
+    /// Return the time from being queued to being resumed.
+    std::chrono::nanoseconds
+    queue_delay() const noexcept
+    {
+        return resumed - queued;
+    }
+};
+
+/** Receives the trace of each completed I/O operation.
+
+    Set on a context with @ref basic_io_context::set_op_tracer. The
+    operation is reported by the thread that resumes it, just before
+    the coroutine resumes, so `on_complete` may be called from every
+    thread running the context at once and should return quickly.
+
+    Operations that complete inline, without suspending the
+    coroutine, are not reported.
+*/
+class op_tracer
+{
+public:
+    virtual ~op_tracer() = default;
+
+    /// Called once for each traced operation.
+    virtual void
+    on_complete(op_trace const& t) noexcept = 0;
+};
+
+/** A histogram of durations with bounded relative error.
+
+    Values are counted in buckets whose width grows with the value,
+    in the manner of HdrHistogram: values below 256 nanoseconds are
+    exact, and larger ones are kept to within 1 part in 128. Values
+    up to about 73 minutes are distinguished; larger ones are counted
+    as the largest.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe. Recording is wait-free; a reader running
+    alongside writers sees a slightly stale histogram.
+*/
+class BOOST_COROSIO_DECL latency_histogram
+{
+public:
+    /// Construct an empty histogram.
+    latency_histogram();
+
+    ~latency_histogram();
+
+    latency_histogram(latency_histogram const&) = delete;
+    latency_histogram& operator=(latency_histogram const&) = delete;
+
+    /// Count one value. Negative values count as zero.
+    void
+    record(std::chrono::nanoseconds d) noexcept;
+
+    /// Remove every value.
+    void
+    reset() noexcept;
+
+    /// Return the number of values.
+    std::uint64_t
+    count() const noexcept;
+
+    /// Return the smallest value, or zero if there are none.
+    std::chrono::nanoseconds
+    min() const noexcept;
+
+    /// Return the largest value, or zero if there are none.
+    std::chrono::nanoseconds
+    max() const noexcept;
+
+    /// Return the mean of the values, or zero if there are none.
+    std::chrono::nanoseconds
+    mean() const noexcept;
+
+    /** Return the value at a percentile.
+
+        @param p The percentile, from 0 to 100.
+
+        @return The largest value equivalent to the one at `p`, or
+            zero if there are none.
+    */
+    std::chrono::nanoseconds
+    value_at_percentile(double p) const noexcept;
+
+    /** Write the percentile distribution.
+
+        The output has the layout of HdrHistogram's percentile
+        distribution, so it can be read by the tools that plot it.
+
+        @param os The stream to write to.
+        @param unit The duration each printed value is a count of.
+    */
+    void
+    print(
+        std::ostream& os,
+        std::chrono::nanoseconds unit = std::chrono::microseconds(1)) const;
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts_;
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_;
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/** An op_tracer that keeps histograms of each stage.
+
+    @par Example
+    @code
+    hdr_op_tracer tracer;
+    ioc.set_op_tracer(&tracer);
+    ioc.run();
+    tracer.print(std::cout);
+    @endcode
+*/
+class BOOST_COROSIO_DECL hdr_op_tracer : public op_tracer
+{
+public:
+    /// Time from initiation to readiness, for parked operations.
+    latency_histogram wait;
+
+    /// Time the reactor took to perform the I/O, for parked operations.
+    latency_histogram dispatch;
+
+    /// Time from being queued to being resumed.
+    latency_histogram queue_delay;
+
+    /// Time from initiation to being resumed.
+    latency_histogram total;
+
+    /** Record the stages of `t`.
+
+        Cancelled operations are not recorded.
+    */
+    void
+    on_complete(op_trace const& t) noexcept override;
+
+    /// Remove every value from each histogram.
+    void
+    reset() noexcept;
+
+    /// Write each histogram's distribution, headed by its name.
+    void
+    print(
+        std::ostream& os,
+        std::chrono::nanoseconds unit = std::chrono::microseconds(1)) const;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_PACED_STREAM_HPP
+#define BOOST_COROSIO_PACED_STREAM_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace boost::corosio {
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // class needs to have dll-interface
+#endif
+
+/** A token bucket of bytes.
+
+    The bucket fills at a steady rate up to its burst size, and a
+    writer takes tokens for the bytes it sends. One bucket may be
+    shared by the @ref paced_stream objects of a tenant, on any
+    number of threads, to cap what they send together.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+*/
+class BOOST_COROSIO_DECL pacing_bucket
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** Construct a full bucket.
+
+        @param bytes_per_second The fill rate, at least 1.
+
+        @param burst The most tokens the bucket holds. Zero uses
+            10 milliseconds' worth at the rate, and at least 4096.
+    */
+    explicit
+    pacing_bucket(
+        std::uint64_t bytes_per_second,
+        std::size_t burst = 0);
+
+    pacing_bucket(pacing_bucket const&) = delete;
+    pacing_bucket& operator=(pacing_bucket const&) = delete;
+
+    /** Change the rate and the burst size.
+
+        Tokens already in the bucket are kept, up to the new burst.
+    */
+    void
+    set_rate(
+        std::uint64_t bytes_per_second,
+        std::size_t burst = 0);
+
+    /// Return the fill rate in bytes per second.
+    std::uint64_t
+    rate() const noexcept;
+
+    /// Return the most tokens the bucket holds.
+    std::size_t
+    burst() const noexcept;
+
+    /** Take tokens for up to `n` bytes.
+
+        @param n The bytes wanted.
+
+        @param wait Set, when nothing is granted, to how long until
+            the bucket holds tokens for `n` bytes or a full burst,
+            whichever is less. Waiting for that many rather than
+            for one keeps writes from being cut into slivers.
+
+        @return The bytes granted, which may be fewer than `n`.
+    */
+    std::size_t
+    take(
+        std::size_t n,
+        clock_type::duration& wait) noexcept;
+
+    /// Return tokens taken but not used.
+    void
+    put_back(std::size_t n) noexcept;
+
+private:
+    void refill(clock_type::time_point now) noexcept;
+
+    mutable std::mutex mutex_;
+    double rate_ = 0;
+    double burst_ = 0;
+    double tokens_ = 0;
+    clock_type::time_point refilled_;
+};
+
+/// Options for a @ref paced_stream.
+struct pacing_options
+{
+    /** The most bytes per second the stream sends.
+
+        Zero leaves the stream itself unpaced, so that only the
+        shared bucket, if any, limits it.
+    */
+    std::uint64_t rate = 0;
+
+    /// The burst size of the stream's bucket, see @ref pacing_bucket.
+    std::size_t burst = 0;
+
+    /** A bucket shared with other streams, such as those of a tenant.
+
+        Each write takes tokens from it as well as from the stream's
+        own. It must outlive the stream.
+    */
+    pacing_bucket* shared = nullptr;
+
+    /** The slack of the pacing timer.
+
+        Waits may end up to this much late, so that the timers of
+        many paced streams whose waits end close together expire
+        on one wakeup. With the timing wheel of @ref timer_options
+        the wheel's tick plays this role, and a slack of one tick
+        costs nothing extra.
+    */
+    std::chrono::microseconds slack{1000};
+
+    /** Let the kernel pace the stream where it can.
+
+        If the stream is a @ref socket and the kernel accepts
+        `SO_MAX_PACING_RATE`, the rate is set on the socket and the
+        stream's own bucket is not used: packets are spaced by the
+        kernel, and a writer that outruns the rate waits for room
+        in the send buffer instead of for a timer. The shared
+        bucket is still used.
+    */
+    bool kernel_pacing = true;
+};
+
+/** A stream that limits the rate it writes at.
+
+    Writes take tokens from a bucket for the stream and from an
+    optional bucket shared with other streams, and send only as many
+    bytes as both grant. When either is empty the write waits on a
+    timer of the stream's context until tokens accumulate, then
+    sends. Bytes a short write leaves unsent are returned to the
+    buckets. Reads are not paced; use @ref next_layer.
+
+    The waits of many streams sharing a context land on the same
+    timer service, and with a nonzero slack, or the timing wheel,
+    those ending within one tick expire together, so pacing
+    thousands of connections costs one wakeup per tick rather than
+    one per connection.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. One write at a time.
+
+    @par Example
+    @code
+    corosio::pacing_bucket tenant(100'000'000);
+    corosio::paced_stream ps(sock, {
+        .rate = 10'000'000,
+        .shared = &tenant });
+    auto [ec, n] = co_await ps.write(capy::const_buffer(data, size));
+    @endcode
+*/
+class BOOST_COROSIO_DECL paced_stream
+{
+public:
+    /** Construct a paced stream over `s`.
+
+        @param s The stream to write to. It must outlive this object.
+
+        @param opts The options.
+    */
+    explicit
+    paced_stream(
+        io_stream& s,
+        pacing_options const& opts = {});
+
+    paced_stream(paced_stream const&) = delete;
+    paced_stream& operator=(paced_stream const&) = delete;
+
+    /// Return the stream written to.
+    io_stream&
+    next_layer() const noexcept
+    {
+        return s_;
+    }
+
+    /// Return `true` if the kernel paces the stream.
+    bool
+    kernel_paced() const noexcept
+    {
+        return kernel_paced_;
+    }
+
+    /** Change the rate of the stream.
+
+        Takes effect from the next write. Zero removes the stream's
+        own limit.
+    */
+    void
+    set_rate(
+        std::uint64_t bytes_per_second,
+        std::size_t burst = 0);
+
+    /** Write some bytes, once the buckets allow.
+
+        @param buffer The bytes to write.
+
+        @return A task that completes as for
+            @ref io_stream::write_some, or with
+            `capy::error::canceled` if the wait for tokens is
+            cancelled.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    write_some(capy::const_buffer buffer);
+
+    /** Write all of the bytes, at the paced rate.
+
+        @param buffer The bytes to write.
+
+        @return A task that completes with the bytes written, which
+            are all of them unless an error is reported.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    write(capy::const_buffer buffer);
+
+private:
+    io_stream& s_;
+    timer timer_;
+    std::optional<pacing_bucket> own_;
+    pacing_bucket* shared_;
+    bool kernel_paced_ = false;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace boost::corosio
+
+#endif
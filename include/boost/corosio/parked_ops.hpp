@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_PARKED_OPS_HPP
+#define BOOST_COROSIO_PARKED_OPS_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+namespace boost::corosio {
+
+class basic_io_context;
+class signal_set;
+
+/// What a parked operation is waiting for.
+enum class parked_kind
+{
+    /// A read, receive or readability wait.
+    read,
+
+    /// A write, send or writability wait.
+    write,
+
+    /// A connect.
+    connect,
+
+    /// An accept.
+    accept,
+
+    /// A timer wait.
+    timer,
+
+    /// A `tcp_server` accept loop waiting for an idle worker.
+    server_pop,
+
+    /// A `tcp_server` accept loop waiting for a connection slot.
+    server_admit
+};
+
+/// Return the name of a kind, such as `"read"`.
+BOOST_COROSIO_DECL
+char const*
+to_string(parked_kind k) noexcept;
+
+/** A suspended coroutine and what it waits for.
+
+    @see parked_ops
+*/
+struct parked_op
+{
+    parked_kind kind = parked_kind::read;
+
+    /// The descriptor waited on, or -1 if there is none.
+    int fd = -1;
+
+    /// How long the coroutine has been parked.
+    std::chrono::nanoseconds age{0};
+
+    /** The address of the awaiting coroutine's frame.
+
+        As returned by `std::coroutine_handle::address`, so it can
+        be matched against the frames a debugger shows.
+    */
+    void const* coroutine = nullptr;
+};
+
+/** Return the coroutines parked in a context.
+
+    Walks the operations the context's backend holds while they
+    wait: socket, acceptor and datagram operations parked on their
+    descriptors, and timer waits. An operation that is ready and
+    queued to run is not parked and is not listed; the depth of the
+    queues is in @ref basic_io_context::stats.
+
+    Each record is read under the lock that guards it, one
+    descriptor or timer queue at a time, so the list is not a
+    single instant, but every record is consistent. The walk takes
+    time proportional to the descriptors and timers of the context
+    and is meant for diagnosis, not for every request.
+
+    Socket operations are listed with the epoll backend; timer
+    waits with every backend. With other backends the socket
+    operations are missing from the list.
+
+    @param ctx The context.
+
+    @return The parked operations, oldest first.
+
+    @par Thread Safety
+    Safe to call from any thread, including while other threads
+    are running the context.
+
+    @see tcp_server::append_parked_ops
+*/
+BOOST_COROSIO_DECL
+std::vector<parked_op>
+parked_ops(basic_io_context& ctx);
+
+/** Write a listing of parked operations.
+
+    Prints a summary count per kind, then one line per operation
+    with its kind, descriptor, age in microseconds and coroutine
+    address.
+
+    @param os The stream to write to.
+    @param ops The operations, as returned by @ref parked_ops.
+*/
+BOOST_COROSIO_DECL
+void
+print_parked_ops(
+    std::ostream& os,
+    std::vector<parked_op> const& ops);
+
+/** Dump the parked operations each time a signal arrives.
+
+    Loops on `signals.async_wait()`, printing the parked operations
+    of the signal set's context to `os` on each delivery, until the
+    wait fails, such as when the signal set is cancelled or the
+    task's stop token is triggered. The listing is written from a
+    handler of the context, so it never runs inside a signal
+    handler.
+
+    @param signals The signals to dump on, such as `SIGUSR1`.
+    @param os The stream to write to.
+
+    @par Example
+    @code
+    corosio::signal_set signals(ioc, SIGUSR1);
+    capy::run_async(ioc.get_executor())(
+        corosio::dump_parked_ops_on(signals, std::cerr));
+    @endcode
+*/
+BOOST_COROSIO_DECL
+capy::task<>
+dump_parked_ops_on(
+    signal_set& signals,
+    std::ostream& os);
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_PERIODIC_TIMER_HPP
+#define BOOST_COROSIO_PERIODIC_TIMER_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <stop_token>
+
+namespace boost::corosio {
+
+/** A timer that ticks at a fixed period.
+
+    Once started, the timer ticks at its first expiry and then at
+    every multiple of the period after it, for as long as it is not
+    cancelled or restarted. Each tick is computed from the first,
+    not from when the previous one completed, so a loop that waits
+    on it does not drift the way one re-arming a @ref timer with
+    `expires_after` does. The context re-arms it itself as each
+    tick expires, moving it within its timer queue rather than
+    removing and inserting it.
+
+    When the loop lags, ticks are not queued up: the next wait
+    completes once, at once, with the number of ticks that passed
+    without a wait to complete, and the following tick is the next
+    multiple of the period still to come.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. A periodic timer must not have
+    concurrent wait operations.
+
+    @par Example
+    @code
+    corosio::periodic_timer heartbeat(ioc);
+    heartbeat.start(std::chrono::seconds(1));
+    for (;;)
+    {
+        auto [ec, missed] = co_await heartbeat.wait();
+        if (ec)
+            break;
+        if (missed)
+            log_lag(missed);
+        send_heartbeat();
+    }
+    @endcode
+*/
+class BOOST_COROSIO_DECL periodic_timer : public io_object
+{
+    struct wait_awaitable
+    {
+        periodic_timer& t_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::uint64_t missed_ = 0;
+
+        explicit wait_awaitable(periodic_timer& t) noexcept : t_(t) {}
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::uint64_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {capy::error::canceled, 0};
+            return {ec_, missed_};
+        }
+
+        template<typename Ex>
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            Ex const& ex) -> std::coroutine_handle<>
+        {
+            t_.do_wait(h, ex, token_, &ec_, &missed_);
+            return std::noop_coroutine();
+        }
+
+        template<typename Ex>
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            Ex const& ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            t_.do_wait(h, ex, token_, &ec_, &missed_);
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    /// The clock type used for time operations.
+    using clock_type = std::chrono::steady_clock;
+
+    /// The time point type for absolute times.
+    using time_point = clock_type::time_point;
+
+    /// The duration type for periods.
+    using duration = clock_type::duration;
+
+    /** Destructor.
+
+        Cancels any pending operations and releases timer resources.
+    */
+    ~periodic_timer();
+
+    /** Construct a periodic timer from an execution context.
+
+        The timer is not started.
+
+        @param ctx The execution context that will own this timer.
+    */
+    explicit periodic_timer(capy::execution_context& ctx);
+
+    /** Move constructor.
+
+        Transfers ownership of the timer resources.
+
+        @param other The timer to move from.
+    */
+    periodic_timer(periodic_timer&& other) noexcept;
+
+    /** Move assignment operator.
+
+        Closes any existing timer and transfers ownership.
+        The source and destination must share the same execution
+        context.
+
+        @param other The timer to move from.
+
+        @return Reference to this timer.
+
+        @throws std::logic_error if the timers have different
+            execution contexts.
+    */
+    periodic_timer& operator=(periodic_timer&& other);
+
+    periodic_timer(periodic_timer const&) = delete;
+    periodic_timer& operator=(periodic_timer const&) = delete;
+
+    /** Start ticking, the first tick at `first`.
+
+        Any pending wait completes with @ref capy::error::canceled,
+        and ticks not yet waited for are discarded.
+
+        @param first The time of the first tick.
+        @param period The time between ticks.
+
+        @throws std::logic_error if `period` is not positive.
+    */
+    void start(time_point first, duration period);
+
+    /** Start ticking, the first tick one period from now.
+
+        @param period The time between ticks.
+
+        @throws std::logic_error if `period` is not positive.
+    */
+    void start(duration period);
+
+    /** Start ticking, the first tick one period from now.
+
+        This is a convenience overload that accepts any duration type
+        and converts it to the timer's native duration type.
+
+        @param period The time between ticks.
+    */
+    template<class Rep, class Period>
+    void start(std::chrono::duration<Rep, Period> period)
+    {
+        start(std::chrono::duration_cast<duration>(period));
+    }
+
+    /** Stop ticking.
+
+        A pending wait completes with @ref capy::error::canceled.
+        The timer must be started again before the next wait.
+    */
+    void cancel();
+
+    /// Return the period, or zero if the timer was never started.
+    duration period() const noexcept;
+
+    /// Return the time of the next tick.
+    time_point expiry() const noexcept;
+
+    /** Wait for the next tick.
+
+        Completes when the next tick expires or, if ticks passed
+        since the previous wait completed, at once. The operation
+        supports cancellation via `std::stop_token` through the
+        affine awaitable protocol.
+
+        @return An awaitable that completes with
+            `io_result<std::uint64_t>`: the number of ticks missed,
+            that is, those that passed before this one without a
+            wait to complete. Zero when the loop keeps up. The
+            error is `capy::error::canceled` if the wait was
+            cancelled, by a stop token, @ref cancel or @ref start.
+
+        @par Preconditions
+        The timer has been started, and not cancelled since.
+    */
+    auto wait()
+    {
+        return wait_awaitable(*this);
+    }
+
+private:
+    void do_wait(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::stop_token,
+        system::error_code*,
+        std::uint64_t*);
+
+    timer::timer_impl& get() const noexcept
+    {
+        return *static_cast<timer::timer_impl*>(impl_);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
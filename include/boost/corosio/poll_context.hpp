@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_POLL_CONTEXT_HPP
+#define BOOST_COROSIO_POLL_CONTEXT_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_POLL
+
+#include <boost/corosio/basic_io_context.hpp>
+
+namespace boost::corosio {
+
+/** I/O context using POSIX poll() for event multiplexing.
+
+    This context provides an execution environment for async operations
+    using the POSIX poll() API for I/O event notification. It is the
+    default on POSIX platforms without epoll or kqueue. Unlike
+    `select_context` it places no limit on descriptor values, and the
+    kernel scans only descriptors with a pending operation, so it
+    scales to tens of thousands of sockets.
+
+    On Linux, `epoll_context`, `poll_context` and `select_context` are
+    all available, allowing users to choose at runtime:
+
+    @code
+    epoll_context ctx1;  // Use epoll (best performance)
+    poll_context ctx2;   // Use poll (portable, no FD_SETSIZE limit)
+    @endcode
+
+    @par Known Limitations
+    - O(n) kernel scan of the pending descriptors on every wait
+    - Level-triggered only (no edge-triggered mode)
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe, if using a concurrency hint greater than 1.
+
+    @par Example
+    @code
+    poll_context ctx;
+    auto ex = ctx.get_executor();
+    run_async(ex)(my_coroutine());
+    ctx.run();  // Process all queued work
+    @endcode
+*/
+class BOOST_COROSIO_DECL poll_context : public basic_io_context
+{
+public:
+    /** Construct a poll_context with default concurrency.
+
+        The concurrency hint is set to the number of hardware threads
+        available on the system. If more than one thread is available,
+        thread-safe synchronization is used.
+    */
+    poll_context();
+
+    /** Construct a poll_context with a concurrency hint.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`. If greater than 1, thread-safe
+            synchronization is used internally.
+    */
+    explicit
+    poll_context(unsigned concurrency_hint);
+
+    /** Destructor. */
+    ~poll_context();
+
+    // Non-copyable
+    poll_context(poll_context const&) = delete;
+    poll_context& operator=(poll_context const&) = delete;
+};
+
+} // namespace boost::corosio
+
+#endif // BOOST_COROSIO_HAS_POLL
+
+#endif // BOOST_COROSIO_POLL_CONTEXT_HPP
@@ -0,0 +1,418 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_RANDOM_ACCESS_FILE_HPP
+#define BOOST_COROSIO_RANDOM_ACCESS_FILE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/file_base.hpp>
+#include <boost/corosio/io_buffer_param.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/concept/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <string_view>
+#include <type_traits>
+
+namespace boost::corosio {
+
+/** An asynchronous file read and written at explicit offsets.
+
+    Each operation names the offset it transfers at, so the file
+    has no position. Where the context supports it the transfer is
+    done by the kernel without blocking: an `io_uring_context`
+    submits reads and writes to the ring and an `iocp_context`
+    issues overlapped I/O. Reactor backends, which cannot wait for
+    regular files, run the transfer on a small pool of worker
+    threads shared by the context's files and post the completion
+    back.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. At most one read and one write may be
+    pending at a time.
+
+    @par Example
+    @code
+    corosio::random_access_file f(ioc, "data.bin",
+        corosio::file_base::read_only);
+    char buf[4096];
+    auto [ec, n] = co_await f.read_some_at(8192,
+        capy::mutable_buffer(buf, sizeof(buf)));
+    @endcode
+*/
+class BOOST_COROSIO_DECL random_access_file
+    : public io_object
+    , public file_base
+{
+    template<class MutableBufferSequence>
+    struct read_some_at_awaitable
+    {
+        random_access_file& f_;
+        std::uint64_t offset_;
+        MutableBufferSequence buffers_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_transferred_ = 0;
+
+        read_some_at_awaitable(
+            random_access_file& f,
+            std::uint64_t offset,
+            MutableBufferSequence buffers) noexcept
+            : f_(f)
+            , offset_(offset)
+            , buffers_(std::move(buffers))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, bytes_transferred_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (f_.get().read_some_at(h, ex, offset_, buffers_,
+                    token_, &ec_, &bytes_transferred_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    template<class ConstBufferSequence>
+    struct write_some_at_awaitable
+    {
+        random_access_file& f_;
+        std::uint64_t offset_;
+        ConstBufferSequence buffers_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_transferred_ = 0;
+
+        write_some_at_awaitable(
+            random_access_file& f,
+            std::uint64_t offset,
+            ConstBufferSequence buffers) noexcept
+            : f_(f)
+            , offset_(offset)
+            , buffers_(std::move(buffers))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, bytes_transferred_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (f_.get().write_some_at(h, ex, offset_, buffers_,
+                    token_, &ec_, &bytes_transferred_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    /** Destructor.
+
+        Closes the file if open, cancelling any pending operations.
+    */
+    ~random_access_file();
+
+    /** Construct a closed file from an execution context.
+
+        @param ctx The execution context that will own this file.
+    */
+    explicit random_access_file(capy::execution_context& ctx);
+
+    /** Construct a file and open it.
+
+        @param ctx The execution context that will own this file.
+        @param path The path of the file.
+        @param open_flags How to open the file.
+
+        @throws std::system_error on failure.
+    */
+    random_access_file(
+        capy::execution_context& ctx,
+        std::string_view path,
+        flags open_flags)
+        : random_access_file(ctx)
+    {
+        open(path, open_flags);
+    }
+
+    /** Construct a closed file from an executor.
+
+        The file is associated with the executor's context.
+
+        @param ex The executor whose context will own the file.
+    */
+    template<class Ex>
+        requires (!std::same_as<std::remove_cvref_t<Ex>, random_access_file>) &&
+                 capy::Executor<Ex>
+    explicit random_access_file(Ex const& ex)
+        : random_access_file(ex.context())
+    {
+    }
+
+    /** Move constructor.
+
+        Transfers ownership of the file resources.
+
+        @param other The file to move from.
+    */
+    random_access_file(random_access_file&& other) noexcept
+        : io_object(other.context())
+    {
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+
+    /** Move assignment operator.
+
+        Closes any open file and transfers ownership. The source and
+        destination must share the same execution context.
+
+        @param other The file to move from.
+
+        @return Reference to this file.
+
+        @throws std::logic_error if the files have different
+            execution contexts.
+    */
+    random_access_file& operator=(random_access_file&& other)
+    {
+        if (this != &other)
+        {
+            if (ctx_ != other.ctx_)
+                detail::throw_logic_error(
+                    "cannot move random_access_file across execution contexts");
+            close();
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    random_access_file(random_access_file const&) = delete;
+    random_access_file& operator=(random_access_file const&) = delete;
+
+    /** Open a file.
+
+        Closes any file held before.
+
+        @param path The path of the file.
+        @param open_flags How to open the file.
+
+        @throws std::system_error on failure.
+    */
+    void open(std::string_view path, flags open_flags);
+
+    /** Close the file.
+
+        Pending operations complete with `errc::operation_canceled`.
+        Has no effect on a closed file.
+    */
+    void close();
+
+    /** Check if the file is open.
+
+        @return `true` if the file is open.
+    */
+    bool is_open() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /** Cancel any pending asynchronous operations.
+
+        A transfer already handed to a worker thread runs to the end;
+        every other pending operation completes with
+        `errc::operation_canceled`.
+    */
+    void cancel();
+
+    /** Return the native file handle.
+
+        @return The handle, or an invalid handle if the file is closed.
+    */
+    native_file_type native_handle() const noexcept;
+
+    /** Return the size of the file in bytes.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    std::uint64_t size() const;
+
+    /** Extend or truncate the file.
+
+        @param n The new size in bytes.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void resize(std::uint64_t n);
+
+    /** Flush data and metadata to the storage device.
+
+        This call blocks until the device has the data.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void sync_all();
+
+    /** Flush data to the storage device.
+
+        Like @ref sync_all, but metadata that is not needed to read
+        the data back, such as the modification time, may be left.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void sync_data();
+
+    /** Initiate an asynchronous read at an offset.
+
+        Reads into the buffer sequence from `offset`. The operation
+        completes when at least one byte was read, at the end of the
+        file, or on error. A backend may read only into the first
+        buffer of the sequence.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param offset The offset in the file to read from.
+        @param buffers The buffer sequence to read data into.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`. Reading at or past the
+            end of the file completes with `capy::error::eof`.
+
+        @par Preconditions
+        The file must be open for reading.
+    */
+    template<class MutableBufferSequence>
+    auto read_some_at(
+        std::uint64_t offset,
+        MutableBufferSequence const& buffers)
+    {
+        if (!impl_)
+            detail::throw_logic_error("read_some_at: file not open");
+        return read_some_at_awaitable<MutableBufferSequence>(
+            *this, offset, buffers);
+    }
+
+    /** Initiate an asynchronous write at an offset.
+
+        Writes from the buffer sequence to `offset`, extending the
+        file as needed. The operation completes when at least one
+        byte was written, or on error. A file opened with `append`
+        writes at its end whatever the offset.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param offset The offset in the file to write to.
+        @param buffers The buffer sequence containing data to write.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`.
+
+        @par Preconditions
+        The file must be open for writing.
+    */
+    template<class ConstBufferSequence>
+    auto write_some_at(
+        std::uint64_t offset,
+        ConstBufferSequence const& buffers)
+    {
+        if (!impl_)
+            detail::throw_logic_error("write_some_at: file not open");
+        return write_some_at_awaitable<ConstBufferSequence>(
+            *this, offset, buffers);
+    }
+
+    struct random_access_file_impl
+        : io_object_impl
+        , file_impl
+    {
+        /** Start a read at `offset` into the given buffers.
+
+            @return `true` if the read completed before returning,
+                with `*ec` and `*bytes` already stored.
+        */
+        virtual bool read_some_at(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            std::uint64_t offset,
+            io_buffer_param,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        /** Start a write at `offset` from the given buffers.
+
+            @return `true` if the write completed before returning,
+                as for @ref read_some_at.
+        */
+        virtual bool write_some_at(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            std::uint64_t offset,
+            io_buffer_param,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+    };
+
+private:
+    random_access_file_impl& get() const noexcept
+    {
+        return *static_cast<random_access_file_impl*>(impl_);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
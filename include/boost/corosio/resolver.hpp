@@ -23,9 +23,13 @@
 #include <boost/system/error_code.hpp>
 
 #include <cassert>
+#include <chrono>
 #include <concepts>
 #include <coroutine>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stop_token>
 #include <string>
 #include <string_view>
@@ -107,6 +111,27 @@ operator&=(resolve_flags& a, resolve_flags b) noexcept
 
 //------------------------------------------------------------------------------
 
+/** How a resolver answers forward queries.
+
+    @see resolver::set_backend
+*/
+enum class resolver_backend
+{
+    /// The system resolver, getaddrinfo, on worker threads.
+    system,
+
+    /// A stub resolver that asks the name servers of resolv.conf
+    /// itself, on the context's reactor, and leaves to the system
+    /// resolver the names that NSS may know better.
+    dns
+};
+
+namespace detail {
+class dns_resolver;
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
 /** Bitmask flags for reverse resolver queries.
 
     These flags correspond to the flags parameter of getnameinfo.
@@ -169,6 +194,75 @@ operator&=(reverse_flags& a, reverse_flags b) noexcept
 
 //------------------------------------------------------------------------------
 
+/** Options for the DNS cache shared by the resolvers of a context.
+
+    @see set_resolver_cache
+*/
+struct resolver_cache_options
+{
+    /** The most queries to remember. Zero disables the cache. */
+    std::size_t max_entries = 0;
+
+    /** How long a successful answer is used.
+
+        `getaddrinfo` does not report the records' TTLs, so this
+        bounds how stale an answer may become; keep it no longer
+        than the TTLs of the names being resolved.
+    */
+    std::chrono::seconds ttl{30};
+
+    /** How long a "host not found" answer is used. */
+    std::chrono::seconds negative_ttl{5};
+
+    /** How long before expiry a hit starts a refresh.
+
+        A hit this close to expiry is still answered from the cache
+        and starts one lookup in the background, so names in steady
+        use never wait for one.
+    */
+    std::chrono::seconds refresh_ahead{5};
+
+    /** The most reverse queries to remember. Zero disables them.
+
+        Reverse answers are keyed by address and flags, so the
+        connections of one peer share an entry whatever their port.
+        A hit answers the service too when the port is the one
+        looked up, or `reverse_flags::numeric_service` is set.
+        Successful answers are used for @ref ttl.
+    */
+    std::size_t max_reverse_entries = 0;
+};
+
+/** Set the DNS cache of a context's resolvers.
+
+    With a cache, a forward resolve whose host, service and flags
+    match a remembered query completes without suspending, and its
+    results share the remembered entries instead of copying them.
+    Lookups that fail with anything but "host not found" are not
+    cached. Reverse resolves are cached separately, see
+    @ref resolver_cache_options::max_reverse_entries, and only when
+    they succeed. Calling this again replaces the options and forgets
+    every remembered query.
+
+    @param ctx The context whose resolvers use the cache.
+
+    @param opts The cache options. `max_entries == 0` disables it,
+        which is the default.
+
+    @throws std::runtime_error if the context has no resolver
+        service.
+
+    @note The forward cache is available on POSIX platforms; on
+        Windows only the reverse cache is used.
+*/
+BOOST_COROSIO_DECL
+void
+set_resolver_cache(
+    capy::execution_context& ctx,
+    resolver_cache_options const& opts);
+
+//------------------------------------------------------------------------------
+
 /** An asynchronous DNS resolver for coroutine I/O.
 
     This class provides asynchronous DNS resolution operations that return
@@ -202,8 +296,8 @@ class BOOST_COROSIO_DECL resolver : public io_object
     struct resolve_awaitable
     {
         resolver& r_;
-        std::string host_;
-        std::string service_;
+        std::pmr::string host_;
+        std::pmr::string service_;
         resolve_flags flags_;
         std::stop_token token_;
         mutable system::error_code ec_;
@@ -215,21 +309,40 @@ class BOOST_COROSIO_DECL resolver : public io_object
             std::string_view service,
             resolve_flags flags) noexcept
             : r_(r)
-            , host_(host)
-            , service_(service)
+            , host_(host, r.memory_resource())
+            , service_(service, r.memory_resource())
             , flags_(flags)
         {
         }
 
         bool await_ready() const noexcept
         {
-            return token_.stop_requested();
+            if (token_.stop_requested())
+                return true;
+            return r_.get().resolve_cached(
+                host_, service_, flags_, &ec_, &results_);
         }
 
         capy::io_result<resolver_results> await_resume() const noexcept
         {
             if (token_.stop_requested())
                 return {make_error_code(system::errc::operation_canceled), {}};
+
+            // Shared and cached answers are on the heap
+            auto* mr = r_.mr_;
+            if (!ec_ && mr && !results_.empty() &&
+                !results_.get_allocator().resource()->is_equal(*mr))
+            {
+                try
+                {
+                    return {ec_, resolver_results(results_, mr)};
+                }
+                catch (std::bad_alloc const&)
+                {
+                    return {make_error_code(
+                        system::errc::not_enough_memory), {}};
+                }
+            }
             return {ec_, std::move(results_)};
         }
 
@@ -238,8 +351,7 @@ class BOOST_COROSIO_DECL resolver : public io_object
             std::coroutine_handle<> h,
             Ex const& ex) -> std::coroutine_handle<>
         {
-            r_.get().resolve(h, ex, host_, service_, flags_, token_, &ec_, &results_);
-            return std::noop_coroutine();
+            return start(h, ex);
         }
 
         template<typename Ex>
@@ -249,6 +361,21 @@ class BOOST_COROSIO_DECL resolver : public io_object
             std::stop_token token) -> std::coroutine_handle<>
         {
             token_ = std::move(token);
+            return start(h, ex);
+        }
+
+    private:
+        std::coroutine_handle<> start(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex)
+        {
+            if (r_.dns_)
+            {
+                if (r_.resolve_dns(h, ex, host_, service_, flags_,
+                        token_, &ec_, &results_))
+                    return h;
+                return std::noop_coroutine();
+            }
             r_.get().resolve(h, ex, host_, service_, flags_, token_, &ec_, &results_);
             return std::noop_coroutine();
         }
@@ -275,7 +402,10 @@ class BOOST_COROSIO_DECL resolver : public io_object
 
         bool await_ready() const noexcept
         {
-            return token_.stop_requested();
+            if (token_.stop_requested())
+                return true;
+            return r_.get().reverse_resolve_cached(
+                ep_, flags_, &ec_, &result_);
         }
 
         capy::io_result<reverse_resolver_result> await_resume() const noexcept
@@ -341,6 +471,8 @@ public:
     */
     resolver(resolver&& other) noexcept
         : io_object(other.context())
+        , dns_(std::move(other.dns_))
+        , mr_(other.mr_)
     {
         impl_ = other.impl_;
         other.impl_ = nullptr;
@@ -368,6 +500,8 @@ public:
             cancel();
             impl_ = other.impl_;
             other.impl_ = nullptr;
+            dns_ = std::move(other.dns_);
+            mr_ = other.mr_;
         }
         return *this;
     }
@@ -467,6 +601,63 @@ public:
     */
     void cancel();
 
+    /** Choose how forward queries are answered.
+
+        With @ref resolver_backend::dns the resolver reads
+        `/etc/resolv.conf` and sends the A and AAAA questions of a
+        name in parallel over UDP, retrying over TCP when an answer is
+        truncated, with the servers, timeout, attempts and rotation
+        given there. No thread is used. Numeric hosts are answered at
+        once. Single-label names, `localhost` and `.local` names,
+        service names other than port numbers, the passive,
+        v4_mapped and all_matching flags, and names that DNS reports
+        as nonexistent or without addresses go to the system
+        resolver, as do all queries when no IPv4 name server is
+        configured or the context has no datagram support. Search
+        domains are not applied.
+
+        On Windows, and for reverse queries, the system resolver is
+        always used.
+
+        No resolve may be pending when the backend is changed.
+
+        @param b The backend to use.
+    */
+    void set_backend(resolver_backend b);
+
+    /// Return the backend in use.
+    resolver_backend backend() const noexcept
+    {
+        return dns_ ? resolver_backend::dns : resolver_backend::system;
+    }
+
+    /** Set the memory resource for the results of resolves.
+
+        Forward resolves that complete after this call return results
+        whose entries are allocated from `mr`, as are the copies of
+        the host and service names each resolve keeps while pending.
+        Answers of @ref resolver_backend::dns are built there
+        directly; those of the system resolver, which are shared
+        with identical resolves in flight and with the context's
+        cache, are copied into it when the resolve completes, on the
+        context's thread. A resource without locking, such as a
+        `std::pmr::monotonic_buffer_resource` per context, is
+        therefore enough.
+
+        @param mr The memory resource, or null for the default. It
+            must outlive the results of every resolve made with it.
+    */
+    void set_memory_resource(std::pmr::memory_resource* mr) noexcept
+    {
+        mr_ = mr;
+    }
+
+    /// Return the memory resource for the results of resolves.
+    std::pmr::memory_resource* memory_resource() const noexcept
+    {
+        return mr_ ? mr_ : std::pmr::get_default_resource();
+    }
+
 public:
     struct resolver_impl : io_object_impl
     {
@@ -490,6 +681,33 @@ public:
             reverse_resolver_result*) = 0;
 
         virtual void cancel() noexcept = 0;
+
+        /** Complete a resolve from the context's DNS cache.
+
+            @return `true` if the cache answered, with the outputs set.
+        */
+        virtual bool resolve_cached(
+            std::string_view,
+            std::string_view,
+            resolve_flags,
+            system::error_code*,
+            resolver_results*) noexcept
+        {
+            return false;
+        }
+
+        /** Complete a reverse resolve from the context's DNS cache.
+
+            @return `true` if the cache answered, with the outputs set.
+        */
+        virtual bool reverse_resolve_cached(
+            endpoint const&,
+            reverse_flags,
+            system::error_code*,
+            reverse_resolver_result*) noexcept
+        {
+            return false;
+        }
     };
 
 private:
@@ -497,6 +715,19 @@ private:
     {
         return *static_cast<resolver_impl*>(impl_);
     }
+
+    bool resolve_dns(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        std::stop_token,
+        system::error_code*,
+        resolver_results*);
+
+    std::shared_ptr<detail::dns_resolver> dns_;
+    std::pmr::memory_resource* mr_ = nullptr;
 };
 
 } // namespace boost::corosio
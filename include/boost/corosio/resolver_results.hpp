@@ -15,6 +15,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -92,23 +93,32 @@ public:
     It provides a range interface for iterating over the
     resolved endpoints.
 
+    Copies share the entries. The entries and their shared block
+    are allocated from a `std::pmr::memory_resource`, the default
+    resource unless one is given; the host and service names of an
+    entry too long for the small string buffer still come from the
+    heap.
+
     @par Thread Safety
     Distinct objects: Safe.@n
     Shared objects: Safe (immutable after construction).
 */
 class resolver_results
 {
+    using entries_type = std::pmr::vector<resolver_entry>;
+
 public:
     using value_type = resolver_entry;
     using const_reference = value_type const&;
     using reference = const_reference;
-    using const_iterator = std::vector<resolver_entry>::const_iterator;
+    using const_iterator = entries_type::const_iterator;
     using iterator = const_iterator;
     using difference_type = std::ptrdiff_t;
     using size_type = std::size_t;
+    using allocator_type = std::pmr::polymorphic_allocator<resolver_entry>;
 
 private:
-    std::shared_ptr<std::vector<resolver_entry>> entries_;
+    std::shared_ptr<entries_type> entries_;
 
 public:
     /** Default constructor creates an empty range. */
@@ -120,11 +130,72 @@ public:
     */
     explicit
     resolver_results(std::vector<resolver_entry> entries)
-        : entries_(std::make_shared<std::vector<resolver_entry>>(
+        : entries_(std::make_shared<entries_type>(
+            std::make_move_iterator(entries.begin()),
+            std::make_move_iterator(entries.end())))
+    {
+    }
+
+    /** Construct from a vector of entries, keeping its allocator.
+
+        The shared block is allocated from the vector's memory
+        resource, and the entries are moved into it without copying.
+
+        @param entries The resolved entries.
+    */
+    explicit
+    resolver_results(entries_type entries)
+        : entries_(std::allocate_shared<entries_type>(
+            std::pmr::polymorphic_allocator<>(
+                entries.get_allocator().resource()),
             std::move(entries)))
     {
     }
 
+    /** Construct a copy allocated from a memory resource.
+
+        Unlike a plain copy, which shares the entries of `other`,
+        this copies them into a block allocated from `mr`.
+
+        @param other The results to copy.
+        @param mr The memory resource. It must outlive the copy and
+            every copy of it.
+
+        @throws std::bad_alloc if memory is exhausted.
+    */
+    resolver_results(
+        resolver_results const& other,
+        std::pmr::memory_resource* mr)
+    {
+        if (other.entries_)
+            entries_ = std::allocate_shared<entries_type>(
+                std::pmr::polymorphic_allocator<>(mr), *other.entries_);
+    }
+
+    /// Copy constructor; the copy shares the entries.
+    resolver_results(resolver_results const&) = default;
+
+    /// Move constructor.
+    resolver_results(resolver_results&&) noexcept = default;
+
+    /// Copy assignment; the copy shares the entries.
+    resolver_results& operator=(resolver_results const&) = default;
+
+    /// Move assignment.
+    resolver_results& operator=(resolver_results&&) noexcept = default;
+
+    /** Return the allocator of the entries.
+
+        Empty results report the default memory resource.
+    */
+    allocator_type
+    get_allocator() const noexcept
+    {
+        if (entries_)
+            return entries_->get_allocator();
+        return allocator_type();
+    }
+
     /** Get the number of entries. */
     size_type
     size() const noexcept
@@ -145,7 +216,7 @@ public:
     {
         if (entries_)
             return entries_->begin();
-        return std::vector<resolver_entry>::const_iterator();
+        return const_iterator();
     }
 
     /** Get an iterator past the last entry. */
@@ -154,7 +225,7 @@ public:
     {
         if (entries_)
             return entries_->end();
-        return std::vector<resolver_entry>::const_iterator();
+        return const_iterator();
     }
 
     /** Get an iterator to the first entry. */
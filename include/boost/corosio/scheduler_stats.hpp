@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_SCHEDULER_STATS_HPP
+#define BOOST_COROSIO_SCHEDULER_STATS_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost::corosio {
+
+/** Counters describing the event loop of an I/O context.
+
+    Each thread inside `run()` keeps its own counters, which are
+    summed when the snapshot is taken, so counting costs a running
+    thread no shared writes. Threads that have left `run()` remain
+    in the totals. Values are sampled without synchronization and
+    may be slightly stale while other threads are running the
+    context.
+
+    The epoll, select and IOCP schedulers fill every field; other
+    backends report zeros.
+
+    @see basic_io_context::stats
+*/
+struct scheduler_stats
+{
+    /// Handlers run by threads inside the context.
+    std::uint64_t handlers_executed = 0;
+
+    /** The most handlers seen waiting in one ready queue.
+
+        Covers the shared queue and, with work stealing, each
+        thread's local queue. IOCP queues handlers in the kernel
+        and reports the largest batch dequeued at once.
+    */
+    std::size_t queue_depth_peak = 0;
+
+    /// Reactor waits that were allowed to block.
+    std::uint64_t blocking_waits = 0;
+
+    /** Wakeups written to interrupt a blocked reactor.
+
+        On IOCP, handlers posted to the completion port.
+    */
+    std::uint64_t wakeup_writes = 0;
+
+    /// Calls to the reactor's wait function, of any kind.
+    std::uint64_t reactor_polls = 0;
+
+    /// Events returned by those calls, including wakeups.
+    std::uint64_t events_harvested = 0;
+
+    /** Times a thread with nothing to run went to sleep.
+
+        On the reactor schedulers this counts waits on the condition
+        variable by threads other than the reactor. On IOCP, where
+        every thread waits in the port, it equals `blocking_waits`.
+    */
+    std::uint64_t idle_parks = 0;
+
+    /// Time threads spent blocked waiting for work or events.
+    std::chrono::nanoseconds blocked_time{0};
+
+    /// Time threads spent inside the context and not blocked.
+    std::chrono::nanoseconds running_time{0};
+
+    /// Return the mean number of events per reactor poll.
+    double
+    events_per_poll() const noexcept
+    {
+        if (reactor_polls == 0)
+            return 0.0;
+        return static_cast<double>(events_harvested) /
+            static_cast<double>(reactor_polls);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
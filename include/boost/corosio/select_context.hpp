@@ -19,6 +19,22 @@
 
 namespace boost::corosio {
 
+/** Tuning options for a @ref select_context.
+*/
+struct select_options
+{
+    /** Connections an acceptor may accept ahead of `accept()`.
+
+        Nonzero makes an accept woken by the reactor keep accepting
+        until it would block or this many further connections wait
+        in the acceptor, so one readiness event drains a deep listen
+        backlog. Later `accept()` calls take the waiting connections
+        without a system call or a trip through the reactor. Zero
+        accepts one connection per event.
+    */
+    unsigned accept_backlog = 0;
+};
+
 /** I/O context using POSIX select() for event multiplexing.
 
     This context provides an execution environment for async operations
@@ -72,6 +88,16 @@ public:
     explicit
     select_context(unsigned concurrency_hint);
 
+    /** Construct a select_context with a concurrency hint and options.
+
+        @param concurrency_hint A hint for the number of threads that
+            will call `run()`.
+        @param opts Tuning options.
+    */
+    select_context(
+        unsigned concurrency_hint,
+        select_options const& opts);
+
     /** Destructor. */
     ~select_context();
 
@@ -13,6 +13,7 @@
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/detail/platform.hpp>
 #include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/io_account.hpp>
 #include <boost/corosio/io_stream.hpp>
 #include <boost/capy/io_result.hpp>
 #include <boost/corosio/io_buffer_param.hpp>
@@ -23,9 +24,11 @@
 
 #include <boost/system/error_code.hpp>
 
+#include <chrono>
 #include <concepts>
 #include <coroutine>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stop_token>
 #include <type_traits>
@@ -34,8 +37,10 @@ namespace boost::corosio {
 
 #if BOOST_COROSIO_HAS_IOCP
 using native_handle_type = std::uintptr_t;  // SOCKET
+using native_file_type = void*;             // HANDLE
 #else
 using native_handle_type = int;
+using native_file_type = int;
 #endif
 
 /** An asynchronous TCP socket for coroutine I/O.
@@ -82,6 +87,14 @@ public:
         shutdown_both
     };
 
+    /** Conditions a socket can be waited on for, see @ref wait. */
+    enum class wait_type
+    {
+        read,   ///< Data or end of stream can be read
+        write,  ///< Data can be written
+        error   ///< An error or urgent data is pending
+    };
+
     /** Options for SO_LINGER socket option. */
     struct linger_options
     {
@@ -89,6 +102,32 @@ public:
         int timeout = 0;  // seconds
     };
 
+    /** Kernel statistics of a TCP connection, see @ref tcp_info.
+
+        Each field is converted from what the platform reports;
+        one it does not report is zero.
+    */
+    struct tcp_statistics
+    {
+        /// Smoothed round-trip time.
+        std::chrono::microseconds rtt{};
+
+        /// Variation of the round-trip time.
+        std::chrono::microseconds rtt_variance{};
+
+        /// Congestion window, in bytes.
+        std::uint64_t congestion_window = 0;
+
+        /// Maximum segment size used for sending, in bytes.
+        std::uint32_t mss = 0;
+
+        /// Segments retransmitted over the life of the connection.
+        std::uint64_t retransmits = 0;
+
+        /// Bytes sent and not yet acknowledged.
+        std::uint64_t bytes_in_flight = 0;
+    };
+
     struct socket_impl : io_stream_impl
     {
         virtual void connect(
@@ -125,11 +164,231 @@ public:
         virtual system::error_code set_linger(bool enabled, int timeout) noexcept = 0;
         virtual linger_options linger(system::error_code& ec) const noexcept = 0;
 
+        /// Enable or disable zero-copy sends; unsupported by default.
+        virtual system::error_code set_zero_copy(bool) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual bool zero_copy(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return false;
+        }
+
+        /// Queue completions with high priority; unsupported by default.
+        virtual system::error_code set_high_priority_completions(bool) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual bool high_priority_completions(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return false;
+        }
+
+        /// Enable or disable write coalescing; unsupported by default.
+        virtual system::error_code set_write_coalescing(bool) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual bool write_coalescing(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return false;
+        }
+
+        /// Enable or disable kernel timestamps; unsupported by default.
+        virtual system::error_code set_timestamping(bool) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual bool timestamping(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return false;
+        }
+
+        /// Returns the kernel receive time of the last read, if known.
+        virtual std::chrono::system_clock::time_point
+        last_receive_time() const noexcept
+        {
+            return {};
+        }
+
+        /// Returns the latest kernel transmit time, if known.
+        virtual std::chrono::system_clock::time_point
+        last_send_time() const noexcept
+        {
+            return {};
+        }
+
+        /// Charge operations to an account; unsupported by default.
+        virtual bool set_account(io_account*) noexcept
+        {
+            return false;
+        }
+
         /// Returns the cached local endpoint.
         virtual endpoint local_endpoint() const noexcept = 0;
 
         /// Returns the cached remote endpoint.
         virtual endpoint remote_endpoint() const noexcept = 0;
+
+        /** Start sending `count` bytes of a file from `offset`.
+
+            The default reads the file into a buffer and writes it
+            with @ref write_all. A backend with a kernel path from
+            files to sockets overrides it.
+
+            @return `true` if the transfer completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool send_file(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            native_file_type file,
+            std::uint64_t offset,
+            std::size_t count,
+            std::stop_token token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            return socket::send_file_copy(
+                *this, h, ex, file, offset, count, token, ec, bytes);
+        }
+
+        /** Start moving up to `max` bytes from this socket to `dst`.
+
+            The default waits until this socket is readable, then
+            moves what arrived to `dst`: with splice(2) through a
+            pipe on Linux, and through a buffer elsewhere or where
+            @ref wait is not supported.
+
+            @return `true` if the transfer completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool splice_to(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            socket_impl& dst,
+            std::size_t max,
+            std::stop_token token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            return socket::relay(
+                *this, h, ex, dst, max, token, ec, bytes);
+        }
+
+        /** Start a connect that carries the first bytes to send.
+
+            The default connects, then writes the data once. On Linux
+            it first sets `TCP_FASTOPEN_CONNECT`, so that write goes
+            out in the SYN when the kernel holds a cookie for the
+            peer. A backend that can hand the data to the connect
+            itself overrides it.
+        */
+        virtual void connect_with_data(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            endpoint ep,
+            capy::const_buffer data,
+            std::stop_token token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            socket::connect_then_write(
+                *this, h, ex, ep, data, token, ec, bytes);
+        }
+
+        /** Start a read into a buffer from the context's buffer pool.
+
+            The default waits until the socket is readable, then
+            takes a buffer of `size` bytes from the context's
+            @ref buffer_pool and reads into it, so that a pending
+            read holds no buffer. Where @ref wait is not supported it
+            takes the buffer at once.
+        */
+        bool read_leased(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::size_t size,
+            std::stop_token token,
+            system::error_code* ec,
+            buffer_lease* lease) override
+        {
+            socket::read_when_ready(*this, h, ex, size, token, ec, lease);
+            return true;
+        }
+
+        /** Start waiting until the socket is ready for `w`.
+
+            The default fails with `errc::operation_not_supported`.
+
+            @return `true` if the wait completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool wait(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            wait_type,
+            std::stop_token,
+            system::error_code* ec)
+        {
+            *ec = make_error_code(system::errc::operation_not_supported);
+            return true;
+        }
+
+        /** Start a write of `buf` with a descriptor attached.
+
+            Used by @ref local_stream_socket to pass descriptors as
+            `SCM_RIGHTS`. The default fails with
+            `errc::operation_not_supported`.
+
+            @return `true` if the write completed before returning,
+                as for @ref write_some.
+        */
+        virtual bool write_with_descriptor(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            capy::const_buffer,
+            native_handle_type,
+            std::stop_token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            *ec = make_error_code(system::errc::operation_not_supported);
+            *bytes = 0;
+            return true;
+        }
+
+        /** Start a read into `buf` that also takes a descriptor.
+
+            On completion `*fd` holds the descriptor sent with the
+            bytes read, or -1 if there was none. The default fails
+            with `errc::operation_not_supported`.
+
+            @return `true` if the read completed before returning,
+                as for @ref read_some.
+        */
+        virtual bool read_with_descriptor(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            capy::mutable_buffer,
+            native_handle_type* fd,
+            std::stop_token,
+            system::error_code* ec,
+            std::size_t* bytes)
+        {
+            *fd = native_handle_type(-1);
+            *ec = make_error_code(system::errc::operation_not_supported);
+            *bytes = 0;
+            return true;
+        }
     };
 
     struct connect_awaitable
@@ -178,6 +437,179 @@ public:
         }
     };
 
+    struct connect_data_awaitable
+    {
+        socket& s_;
+        endpoint endpoint_;
+        capy::const_buffer data_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_ = 0;
+
+        connect_data_awaitable(
+            socket& s,
+            endpoint ep,
+            capy::const_buffer data) noexcept
+            : s_(s)
+            , endpoint_(ep)
+            , data_(data)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, bytes_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            s_.get().connect_with_data(
+                h, ex, endpoint_, data_, token_, &ec_, &bytes_);
+            return std::noop_coroutine();
+        }
+    };
+
+    struct wait_awaitable
+    {
+        socket& s_;
+        wait_type w_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+
+        wait_awaitable(socket& s, wait_type w) noexcept
+            : s_(s)
+            , w_(w)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled)};
+            return {ec_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (s_.get().wait(h, ex, w_, token_, &ec_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    struct send_file_awaitable
+    {
+        socket& s_;
+        native_file_type file_;
+        std::uint64_t offset_;
+        std::size_t count_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_ = 0;
+
+        send_file_awaitable(
+            socket& s,
+            native_file_type file,
+            std::uint64_t offset,
+            std::size_t count) noexcept
+            : s_(s)
+            , file_(file)
+            , offset_(offset)
+            , count_(count)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            // The bytes sent before a stop are still reported
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), bytes_};
+            return {ec_, bytes_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (s_.get().send_file(h, ex, file_, offset_, count_,
+                    token_, &ec_, &bytes_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    struct splice_awaitable
+    {
+        socket& s_;
+        socket& dst_;
+        std::size_t max_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_ = 0;
+
+        splice_awaitable(
+            socket& s,
+            socket& dst,
+            std::size_t max) noexcept
+            : s_(s)
+            , dst_(dst)
+            , max_(max)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            // The bytes moved before a stop are still reported
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), bytes_};
+            return {ec_, bytes_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            if (s_.get().splice_to(h, ex, dst_.get(), max_,
+                    token_, &ec_, &bytes_))
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
 public:
     /** Destructor.
 
@@ -248,13 +680,16 @@ public:
 
     /** Open the socket.
 
-        Creates an IPv4 TCP socket and associates it with the platform
-        reactor (IOCP on Windows). This must be called before initiating
-        I/O operations.
+        Creates a TCP socket of the given family and associates it
+        with the platform reactor (IOCP on Windows). This must be
+        called before initiating I/O operations. Open with the family
+        of the endpoint to connect to, e.g. `s.open(ep.family())`.
+
+        @param family The address family, IPv4 by default.
 
         @throws std::system_error on failure.
     */
-    void open();
+    void open(ip_family family = ip_family::v4);
 
     /** Close the socket.
 
@@ -272,6 +707,56 @@ public:
         return impl_ != nullptr;
     }
 
+    /** Move the socket to another execution context, keeping it open.
+
+        The connection is handed to the reactor of `ctx` and the
+        socket is owned by `ctx` afterwards, so an accepting context
+        can pass connections to others, or a busy one shed them.
+        A closed socket is simply associated with `ctx`.
+
+        Options set on the descriptor, such as no-delay, keep-alive
+        and buffer sizes, carry over. Those this library implements
+        itself, such as zero-copy sends, write coalescing,
+        timestamping and high priority completions, are reset, and
+        deadlines are dropped.
+
+        @par Preconditions
+        No operation is pending on the socket. Await any in flight
+        before calling, from the coroutine that owns the socket.
+
+        @par Example
+        @code
+        socket peer(accept_ctx);
+        co_await acc.accept(peer);
+        peer.rebind(worker_ctx);
+        capy::run_async(worker_ctx.get_executor())(serve(std::move(peer)));
+        @endcode
+
+        @param ctx The execution context to move to.
+
+        @throws std::system_error on failure, leaving the socket
+            open in its current context. The IOCP backend fails with
+            `errc::operation_not_supported`.
+    */
+    void rebind(capy::execution_context& ctx);
+
+    /** Adopt a connected stream socket.
+
+        Takes ownership of `h`, a connected stream socket such as
+        one end of a `socketpair(2)` or a connection inherited from
+        another process, and associates it with the reactor of the
+        socket's context. The socket is made non-blocking and
+        close-on-exec. The endpoints are those of `h` if it is a TCP
+        socket, and default endpoints otherwise. An open socket is
+        closed first. Not supported on Windows.
+
+        @param h The connected socket.
+
+        @throws std::system_error on failure, in which case `h` has
+            been closed.
+    */
+    void assign(native_handle_type h);
+
     /** Initiate an asynchronous connect operation.
 
         Connects the socket to the specified remote endpoint. The socket
@@ -311,6 +796,223 @@ public:
         return connect_awaitable(*this, ep);
     }
 
+    /** Initiate an asynchronous connect operation with a deadline.
+
+        Like @ref connect, but the attempt is cancelled if it has not
+        completed by `deadline`, and then completes with
+        `errc::timed_out`. The deadline uses a timer node kept by the
+        socket and shared with writes, which cannot be pending during
+        a connect.
+
+        @param ep The remote endpoint to connect to.
+        @param deadline The time at which the attempt is cancelled.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto connect(
+        endpoint ep,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        if (!impl_)
+            detail::throw_logic_error("connect: socket not open");
+        return detail::deadline_awaitable<connect_awaitable>(
+            get_deadline(write_slot), deadline, *this, ep);
+    }
+
+    /** Initiate an asynchronous connect that sends the first bytes.
+
+        Connects like @ref connect and sends as much of `data` as the
+        connection takes at once, using TCP Fast Open where it can:
+        once the client holds a Fast Open cookie for the server, from
+        an earlier connection, the data travels in the SYN and the
+        server sees the request a round trip earlier. Otherwise the
+        data is sent right after the handshake.
+
+        The operation completes when the connection is established,
+        or as soon as the data has gone out in the SYN; a handshake
+        that then fails is reported by the next read or write. Fewer
+        bytes than `data.size()` may be reported as sent, including
+        none when the SYN could not carry data, so the caller writes
+        the rest as after @ref write_some.
+
+        Fast Open uses sendto(2) with `MSG_FASTOPEN` on the epoll
+        backend, `TCP_FASTOPEN_CONNECT` on the other Linux backends,
+        and ConnectEx with a send buffer on IOCP. The server must
+        listen with @ref acceptor::listen_options::fast_open_queue
+        set for the data to be accepted in the SYN; a server without
+        it still receives the data, after the handshake.
+
+        @param ep The remote endpoint to connect to.
+        @param data The first bytes to send.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_sent}`. On error `bytes_sent` is zero.
+
+        @throws std::logic_error if the socket is not open.
+
+        @par Example
+        @code
+        auto [ec, n] = co_await s.connect(ep, capy::const_buffer(req, len));
+        if (!ec && n < len)
+            (void)co_await s.write_all(
+                capy::const_buffer(req + n, len - n));
+        @endcode
+    */
+    auto connect(endpoint ep, capy::const_buffer data)
+    {
+        if (!impl_)
+            detail::throw_logic_error("connect: socket not open");
+        return connect_data_awaitable(*this, ep, data);
+    }
+
+    /** Wait until the socket is ready, without transferring data.
+
+        Completes when a read, a write, or the reporting of an error
+        would not block, as selected by `w`, so that a buffer need
+        only be chosen once data has arrived. An idle connection
+        waiting this way holds no buffer. A pending socket error
+        also ends a read or write wait: the reactor backends leave
+        it to the operation that follows to report, while IOCP
+        reports it from the wait.
+
+        A read or error wait takes the place of a read, and a write
+        wait that of a write: neither may be pending alongside the
+        operation it stands for.
+
+        On epoll and select the wait uses the reactor's readiness
+        directly. On IOCP a read wait is a zero-byte receive and a
+        write wait completes at once, since sends do not wait for
+        readiness there, unless @ref iocp_options::afd_poll is set:
+        then all three waits poll the AFD driver and, like the
+        reactors, leave errors to the operation that follows. Error
+        waits are supported on epoll and on IOCP with AFD polling.
+        Other backends complete with `errc::operation_not_supported`.
+
+        @param w The condition to wait for.
+
+        @return An awaitable that completes with `io_result<>`.
+
+        @throws std::logic_error if the socket is not open.
+
+        @par Example
+        @code
+        auto [ec] = co_await s.wait(socket::wait_type::read);
+        if (!ec)
+        {
+            auto buf = pool.acquire();
+            auto [rec, n] = co_await s.read_some(buf);
+        }
+        @endcode
+    */
+    auto wait(wait_type w)
+    {
+        if (!impl_)
+            detail::throw_logic_error("wait: socket not open");
+        return wait_awaitable(*this, w);
+    }
+
+    /** Wait until the socket is ready, with a deadline.
+
+        Like @ref wait, but the wait is cancelled if the socket is
+        not ready by `deadline`, and then completes with
+        `errc::timed_out`. The deadline uses the timer node of the
+        operation the wait stands for.
+
+        @param w The condition to wait for.
+        @param deadline The time at which the wait is cancelled.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto wait(
+        wait_type w,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        if (!impl_)
+            detail::throw_logic_error("wait: socket not open");
+        return detail::deadline_awaitable<wait_awaitable>(
+            get_deadline(w == wait_type::write ? write_slot : read_slot),
+            deadline, *this, w);
+    }
+
+    /** Initiate an asynchronous transmission of part of a file.
+
+        Sends `count` bytes of `file`, starting at `offset`, to the
+        peer. Where the platform allows, the bytes go from the file
+        to the socket inside the kernel without being copied through
+        user space: sendfile(2) on the epoll backend and TransmitFile
+        on IOCP. Other backends read the file into a buffer of the
+        socket's own and write it.
+
+        The file position of `file` is not used or changed, and the
+        file is not closed. The operation is a write, so no other
+        write may be pending on the socket.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param file The open file to send from.
+        @param offset The position in the file of the first byte.
+        @param count The number of bytes to send.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_sent}`. On success `bytes_sent` is
+            `count`. On error or cancellation it is the number of
+            bytes sent before, so a caller can resume the transfer.
+            If the file ends first the error is `capy::error::eof`.
+
+        @throws std::logic_error if the socket is not open.
+
+        @par Preconditions
+        The socket must be open and connected.
+    */
+    auto send_file(
+        native_file_type file,
+        std::uint64_t offset,
+        std::size_t count)
+    {
+        if (!impl_)
+            detail::throw_logic_error("send_file: socket not open");
+        return send_file_awaitable(*this, file, offset, count);
+    }
+
+    /** Initiate an asynchronous move of bytes to another socket.
+
+        Waits until this socket has data, receives up to `max` bytes
+        and sends all of them on `dst`, as one step of a proxy. On
+        Linux the bytes go from one socket to the other through a
+        pipe with splice(2), without being copied through user space;
+        the pipes are cached per thread. Other platforms, and the
+        io_uring backend, receive into a buffer and send it.
+
+        The operation is a read on this socket and a write on `dst`,
+        so neither may have another operation of that kind pending.
+
+        The operation supports cancellation via `std::stop_token`
+        through the affine awaitable protocol.
+
+        @param dst The connected socket to send the bytes on.
+        @param max The most bytes to move.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_moved}`. On success at least one
+            byte was moved. If this socket's peer closed first the
+            error is `capy::error::eof`. On error or cancellation
+            `bytes_moved` is the number of bytes sent on `dst`;
+            bytes received but not sent are lost.
+
+        @throws std::logic_error if either socket is not open.
+
+        @par Preconditions
+        Both sockets must be connected, and belong to the same
+        execution context.
+    */
+    auto splice_to(socket& dst, std::size_t max)
+    {
+        if (!impl_ || !dst.impl_)
+            detail::throw_logic_error("splice_to: socket not open");
+        return splice_awaitable(*this, dst, max);
+    }
+
     /** Cancel any pending asynchronous operations.
 
         All outstanding operations complete with `errc::operation_canceled`.
@@ -483,6 +1185,337 @@ public:
     */
     linger_options linger() const;
 
+    /** Set the limit of unsent data (TCP_NOTSENT_LOWAT).
+
+        Limits how much written data may wait in the kernel before
+        it is sent. The socket reports writable, and a write
+        completes, only while less than `bytes` is waiting, so data
+        stays with the application, where it can still be replaced
+        by something more recent, instead of queueing behind a slow
+        link. Combined with `wait(wait_type::write)`, this lets a
+        sender produce each message at the last moment.
+
+        @param bytes The limit in bytes.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` where the option is
+            unavailable, as on Windows.
+    */
+    void set_not_sent_low_watermark(std::size_t bytes);
+
+    /** Get the limit of unsent data (TCP_NOTSENT_LOWAT).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    std::size_t not_sent_low_watermark() const;
+
+    /** Enable or disable quick acknowledgements (TCP_QUICKACK).
+
+        When enabled, received segments are acknowledged at once
+        rather than after the delayed-ACK timer. Linux only; the
+        kernel may turn the option off again on its own, so it is
+        usually set after each read.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    void set_quick_ack(bool enabled);
+
+    /** Return `true` if quick acknowledgements are on (TCP_QUICKACK).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool quick_ack() const;
+
+    /** Set the time sent data may stay unacknowledged (TCP_USER_TIMEOUT).
+
+        A connection whose data is not acknowledged within `timeout`
+        is dropped, and pending operations fail with
+        `errc::timed_out`, instead of retransmitting for many
+        minutes. Zero restores the system default. Linux only.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    void set_user_timeout(std::chrono::milliseconds timeout);
+
+    /** Get the time sent data may stay unacknowledged (TCP_USER_TIMEOUT).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    std::chrono::milliseconds user_timeout() const;
+
+    /** Set the CPU that processes incoming packets (SO_INCOMING_CPU).
+
+        Linux only. Read it to learn which CPU received the
+        connection's packets, so that the socket can be served by
+        a thread on that CPU.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    void set_incoming_cpu(int cpu);
+
+    /** Get the CPU that processes incoming packets (SO_INCOMING_CPU).
+
+        @return The CPU, or -1 if none is recorded yet.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    int incoming_cpu() const;
+
+    /** Set the queueing priority of sent packets (SO_PRIORITY).
+
+        Linux only. Values from 0 to 6 need no privileges.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    void set_priority(int priority);
+
+    /** Get the queueing priority of sent packets (SO_PRIORITY).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    int priority() const;
+
+    /** Set how long a blocking receive busy-polls the device (SO_BUSY_POLL).
+
+        Linux only, and only useful with a reactor that asks the
+        kernel to busy poll; see @ref epoll_context. Raising it
+        above the system's `net.core.busy_read` needs
+        CAP_NET_ADMIN.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    void set_busy_poll(std::chrono::microseconds duration);
+
+    /** Get how long a blocking receive busy-polls the device (SO_BUSY_POLL).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    std::chrono::microseconds busy_poll() const;
+
+    /** Cap the rate the kernel sends at (SO_MAX_PACING_RATE).
+
+        Linux only. The kernel spaces the packets of the socket so
+        that they leave at no more than the rate, through the fq
+        queueing discipline or TCP's own pacing. Writes still
+        complete as soon as the send buffer takes the bytes, so a
+        writer that outruns the rate fills the buffer and then
+        waits for it, as with a slow peer.
+
+        @param bytes_per_second The rate. Zero removes the cap, and
+            rates the option cannot hold are lowered to the largest
+            it can.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+
+        @see paced_stream
+    */
+    void set_max_pacing_rate(std::uint64_t bytes_per_second);
+
+    /** Get the rate the kernel sends at, or zero if uncapped.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    std::uint64_t max_pacing_rate() const;
+
+    /** Enable or disable zero-copy sends.
+
+        With zero-copy enabled, a write of at least 16 KiB is sent
+        from the caller's buffers without copying them into the
+        kernel, and completes only once the kernel reports that it no
+        longer uses them. This saves a copy of every byte on large
+        transfers, at the price of a notification per send, so smaller
+        writes are still copied. Cancelling a write that has been
+        sent and is waiting for its buffers has no effect until they
+        are released; closing the socket completes it at once.
+
+        Zero-copy sends use MSG_ZEROCOPY on the epoll backend and
+        IORING_OP_SENDMSG_ZC on io_uring, where the kernel supports
+        them.
+
+        @param enabled `true` to send large writes without copying.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` if the backend or the
+            kernel does not support zero-copy sends.
+    */
+    void set_zero_copy(bool enabled);
+
+    /** Return `true` if zero-copy sends are enabled.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool zero_copy() const;
+
+    /** Queue this socket's completions ahead of other handlers.
+
+        The completed reads, writes and connects of a socket marked
+        this way are run before queued completions of other sockets,
+        so control traffic, such as a coordinator connection carrying
+        heartbeats and cancels, does not wait behind bulk transfers.
+        At most a small number of high priority handlers run in a
+        row while others are waiting, so bulk work slows down but
+        cannot starve. Coroutines that must also be posted ahead of
+        others can use a high priority executor, see
+        @ref basic_io_context::executor_type::high_priority.
+
+        This is unrelated to @ref set_priority, which sets the
+        kernel's queueing priority for sent packets. Call it while no
+        operation is pending on the socket; the setting is cleared
+        when the socket is closed. Supported on the epoll, select
+        and IOCP backends.
+
+        @param enabled `true` to queue completions with high priority.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other backends.
+    */
+    void set_high_priority_completions(bool enabled);
+
+    /** Return `true` if completions are queued with high priority.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool high_priority_completions() const;
+
+    /** Enable or disable write coalescing.
+
+        With coalescing enabled, the small writes a program makes
+        before it next yields to the context, such as a header and
+        then a body, are held back and sent together as full
+        segments once the handlers queued so far have run. This
+        saves packets and the peer's wakeups for protocols that
+        write a message in parts, at the price of a delay of one
+        pass through the queue; large writes are not delayed.
+
+        Coalescing uses TCP_CORK on the epoll backend, for TCP
+        sockets.
+
+        @param enabled `true` to coalesce small writes.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` if the backend or the
+            socket does not support coalescing.
+    */
+    void set_write_coalescing(bool enabled);
+
+    /** Return `true` if write coalescing is enabled.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool write_coalescing() const;
+
+    /** Return the kernel's statistics for the connection.
+
+        Reads round-trip time, congestion window, retransmissions
+        and bytes in flight with one system call, cheap enough to
+        sample live connections. They come from `TCP_INFO` on
+        Linux, `SIO_TCP_INFO` on Windows 10 1703 and later, and
+        `TCP_CONNECTION_INFO` on macOS, where bytes in flight
+        include data not yet sent.
+
+        @return The statistics.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` on other platforms.
+    */
+    tcp_statistics tcp_info() const;
+
+    /** Enable or disable kernel timestamps.
+
+        With timestamps enabled, the kernel records when received
+        data arrived and when sent data was handed to the network
+        device, so that time spent on the wire can be told apart
+        from time spent in the program. Read them with
+        @ref last_receive_time and @ref last_send_time.
+
+        Timestamps use SO_TIMESTAMPING on the epoll backend. They
+        are taken in software unless the device was configured for
+        hardware timestamps.
+
+        @param enabled `true` to record timestamps.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure, with
+            `errc::operation_not_supported` if the backend or the
+            kernel does not support timestamps.
+    */
+    void set_timestamping(bool enabled);
+
+    /** Return `true` if kernel timestamps are enabled.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool timestamping() const;
+
+    /** Return when the data of the last read arrived.
+
+        The time is the kernel's timestamp for the data returned by
+        the most recent read, on the system clock. For a
+        `read_exact` it is the time of the first part.
+
+        @return The receive time, or a default-constructed time
+            point if timestamps are off or the read returned none.
+    */
+    std::chrono::system_clock::time_point last_receive_time() const noexcept;
+
+    /** Return when the latest reported send left the host.
+
+        Transmit timestamps are reported by the kernel some time
+        after the write completes, so this is the time of the most
+        recent send reported so far.
+
+        @return The transmit time, or a default-constructed time
+            point if none was reported.
+    */
+    std::chrono::system_clock::time_point last_send_time() const noexcept;
+
+    /** Charge the operations of this socket to an account.
+
+        Operations started after the call add their bytes and their
+        count to `a`, and the time their coroutine runs once resumed.
+        A null account stops the charging. The setting belongs to
+        the open socket, so a socket that is closed, reopened or
+        assigned an accepted connection starts without one.
+
+        Accounting is available with the epoll backend.
+
+        @param a The account, or null.
+
+        @return `false` if the socket is not open or the backend
+            does not keep accounts.
+
+        @see io_account
+    */
+    bool set_account(io_account* a) noexcept;
+
     /** Get the local endpoint of the socket.
 
         Returns the local address and port to which the socket is bound.
@@ -519,6 +1552,50 @@ public:
 private:
     friend class acceptor;
 
+    // Reads the file and writes it, for impls without a kernel path
+    static bool send_file_copy(
+        socket_impl&,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        native_file_type,
+        std::uint64_t,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*);
+
+    // Waits for readability, then moves the bytes to the other socket
+    static bool relay(
+        socket_impl&,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        socket_impl&,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*);
+
+    // Waits for readability, then reads into a pool buffer
+    static void read_when_ready(
+        socket_impl&,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
+        buffer_lease*);
+
+    // Connects, then writes once, for impls without Fast Open
+    static void connect_then_write(
+        socket_impl&,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        endpoint,
+        capy::const_buffer,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*);
+
     inline socket_impl& get() const noexcept
     {
         return *static_cast<socket_impl*>(impl_);
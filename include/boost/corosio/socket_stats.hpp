@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_SOCKET_STATS_HPP
+#define BOOST_COROSIO_SOCKET_STATS_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost::corosio {
+
+class basic_io_context;
+
+/** Counters describing the stream sockets of an I/O context.
+
+    Like @ref scheduler_stats, each thread inside `run()` counts
+    into its own counters, which are summed when the snapshot is
+    taken; operations completed outside `run()` share one set of
+    atomic counters. Values are sampled without synchronization
+    and may be slightly stale while other threads are running the
+    context.
+
+    An operation completes immediately when its first attempt
+    finishes it, without waiting for the socket to become ready;
+    on the reactor backends this is the speculative system call
+    made as the operation starts. The share of reads completing
+    so, see @ref read_fast_path_ratio, tells whether that attempt
+    pays for itself on a workload: a ratio near zero means nearly
+    every read makes a wasted system call first.
+
+    The epoll, select and IOCP backends fill every field; other
+    backends report zeros. Datagram sockets are not counted.
+
+    @see collect_socket_stats
+*/
+struct socket_stats
+{
+    /// Bytes returned by reads.
+    std::uint64_t bytes_read = 0;
+
+    /// Bytes accepted by writes.
+    std::uint64_t bytes_written = 0;
+
+    /// Reads completed by their first attempt.
+    std::uint64_t reads_immediate = 0;
+
+    /// Reads completed after waiting for the socket.
+    std::uint64_t reads_waited = 0;
+
+    /// Writes completed by their first attempt.
+    std::uint64_t writes_immediate = 0;
+
+    /// Writes completed after waiting for the socket.
+    std::uint64_t writes_waited = 0;
+
+    /** Attempts that found the socket not ready.
+
+        Each is followed by a wait. On IOCP, operations the kernel
+        left pending.
+    */
+    std::uint64_t would_block = 0;
+
+    /// Operations of any kind completed as cancelled.
+    std::uint64_t cancellations = 0;
+
+    /// Connections accepted.
+    std::uint64_t accepts = 0;
+
+    /// Connects that completed with an error other than cancellation.
+    std::uint64_t connect_failures = 0;
+
+    /// Socket objects alive in the context, open or not.
+    std::size_t live_sockets = 0;
+
+    /// Return the share of reads that completed immediately.
+    double
+    read_fast_path_ratio() const noexcept
+    {
+        auto const n = reads_immediate + reads_waited;
+        if (n == 0)
+            return 0.0;
+        return static_cast<double>(reads_immediate) /
+            static_cast<double>(n);
+    }
+
+    /// Return the share of writes that completed immediately.
+    double
+    write_fast_path_ratio() const noexcept
+    {
+        auto const n = writes_immediate + writes_waited;
+        if (n == 0)
+            return 0.0;
+        return static_cast<double>(writes_immediate) /
+            static_cast<double>(n);
+    }
+};
+
+/** Return a snapshot of the socket counters of a context.
+
+    Safe to call from any thread, including while other threads
+    are running the context.
+
+    @par Example
+    @code
+    auto st = corosio::collect_socket_stats(ioc);
+    std::cout << "read fast path: "
+              << st.read_fast_path_ratio() * 100 << "%\n";
+    @endcode
+
+    @param ctx The context whose sockets are counted.
+
+    @return The counters, all zero if the context has created no
+        socket yet.
+*/
+BOOST_COROSIO_DECL
+socket_stats
+collect_socket_stats(basic_io_context& ctx) noexcept;
+
+} // namespace boost::corosio
+
+#endif
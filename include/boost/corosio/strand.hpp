@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_STRAND_HPP
+#define BOOST_COROSIO_STRAND_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/capy/coro.hpp>
+
+#include <coroutine>
+
+namespace boost::corosio {
+
+namespace detail {
+struct strand_impl;
+} // namespace detail
+
+/** An executor that runs coroutines one at a time.
+
+    Coroutines posted or dispatched to a strand never run
+    concurrently with each other, even when several threads call
+    `run()` on the underlying context, so state touched only from
+    the strand needs no mutex. A coroutine that awaits an I/O
+    operation or timer with the strand as its executor resumes on
+    the strand.
+
+    Posting pushes the coroutine on a lock-free queue. The post
+    that finds the strand idle schedules a single runner on the
+    context, which resumes queued coroutines in order until the
+    queue is empty, without taking a lock, and hands the strand
+    back after a bounded batch so that one busy strand cannot hold
+    a thread forever. A coroutine dispatched from inside the strand
+    is returned for symmetric transfer instead of being queued.
+
+    Copies share the same queue and compare equal. The context must
+    outlive every copy.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe.
+
+    @par Example
+    @code
+    corosio::io_context ioc(4);
+    corosio::strand s(ioc.get_executor());
+    for (int i = 0; i < 100; ++i)
+        capy::run_async(s)(update_shared_state());
+    @endcode
+*/
+class BOOST_COROSIO_DECL strand
+{
+public:
+    /// The executor the strand runs on.
+    using inner_executor_type = basic_io_context::executor_type;
+
+    /** Construct a strand on an executor.
+
+        @param ex The executor of the context to run on.
+    */
+    explicit
+    strand(inner_executor_type ex);
+
+    /** Construct a strand on a context.
+
+        @param ctx The context to run on.
+    */
+    explicit
+    strand(basic_io_context& ctx)
+        : strand(ctx.get_executor())
+    {
+    }
+
+    /// Copy constructor; the copy shares the queue.
+    strand(strand const& other) noexcept;
+
+    /// Copy assignment; the strand shares the queue of `other`.
+    strand& operator=(strand const& other) noexcept;
+
+    /// Destructor.
+    ~strand();
+
+    /// Return the executor the strand runs on.
+    inner_executor_type
+    get_inner_executor() const noexcept
+    {
+        return ex_;
+    }
+
+    /// Return a reference to the associated execution context.
+    basic_io_context&
+    context() const noexcept
+    {
+        return ex_.context();
+    }
+
+    /** Check if the current thread is running inside this strand.
+
+        @return `true` if called from a coroutine the strand resumed.
+    */
+    bool running_in_this_thread() const noexcept;
+
+    /// Informs the context that work is beginning.
+    void
+    on_work_started() const noexcept
+    {
+        ex_.on_work_started();
+    }
+
+    /// Informs the context that work has completed.
+    void
+    on_work_finished() const noexcept
+    {
+        ex_.on_work_finished();
+    }
+
+    /** Dispatch a coroutine handle.
+
+        If called from inside this strand, returns the handle for
+        symmetric transfer. Otherwise queues it on the strand and
+        returns `noop_coroutine`.
+
+        @param h The coroutine handle to dispatch.
+
+        @return The handle for symmetric transfer, or `noop_coroutine`
+            if the handle was queued.
+    */
+    capy::coro
+    dispatch(capy::coro h) const
+    {
+        if (running_in_this_thread())
+            return h;
+        post(h);
+        return std::noop_coroutine();
+    }
+
+    /** Queue a coroutine on the strand.
+
+        The coroutine is resumed after every coroutine queued before
+        it, and never while another coroutine of the strand runs.
+
+        @param h The coroutine handle to post.
+    */
+    void post(capy::coro h) const;
+
+    /** Compare two strands for equality.
+
+        @return `true` if both share the same queue.
+    */
+    bool
+    operator==(strand const& other) const noexcept
+    {
+        return impl_ == other.impl_;
+    }
+
+    /** Compare two strands for inequality.
+
+        @return `true` if the strands have different queues.
+    */
+    bool
+    operator!=(strand const& other) const noexcept
+    {
+        return impl_ != other.impl_;
+    }
+
+private:
+    inner_executor_type ex_;
+    detail::strand_impl* impl_;
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_STREAM_FILE_HPP
+#define BOOST_COROSIO_STREAM_FILE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/file_base.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/concept/executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace boost::corosio {
+
+/** An asynchronous file read and written as a stream.
+
+    A stream file keeps a position, which each read or write starts
+    at and advances by the bytes it transferred, so it can be used
+    wherever an @ref io_stream is expected: with @ref buffered_stream,
+    the composed `read_exact` and `write_all`, or as the transport of
+    a TLS stream. Transfers go through the same backend paths as
+    @ref random_access_file.
+
+    A read at the end of the file completes with `capy::error::eof`.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. At most one operation may be pending at
+    a time, since each one moves the position.
+
+    @par Example
+    @code
+    corosio::stream_file f(ioc, "log.txt",
+        corosio::file_base::write_only |
+        corosio::file_base::create |
+        corosio::file_base::append);
+    auto [ec, n] = co_await f.write_all(
+        capy::const_buffer(line.data(), line.size()));
+    @endcode
+*/
+class BOOST_COROSIO_DECL stream_file
+    : public io_stream
+    , public file_base
+{
+public:
+    /** Destructor.
+
+        Closes the file if open, cancelling any pending operations.
+    */
+    ~stream_file();
+
+    /** Construct a closed file from an execution context.
+
+        @param ctx The execution context that will own this file.
+    */
+    explicit stream_file(capy::execution_context& ctx);
+
+    /** Construct a file and open it.
+
+        @param ctx The execution context that will own this file.
+        @param path The path of the file.
+        @param open_flags How to open the file.
+
+        @throws std::system_error on failure.
+    */
+    stream_file(
+        capy::execution_context& ctx,
+        std::string_view path,
+        flags open_flags)
+        : stream_file(ctx)
+    {
+        open(path, open_flags);
+    }
+
+    /** Construct a closed file from an executor.
+
+        The file is associated with the executor's context.
+
+        @param ex The executor whose context will own the file.
+    */
+    template<class Ex>
+        requires (!std::same_as<std::remove_cvref_t<Ex>, stream_file>) &&
+                 capy::Executor<Ex>
+    explicit stream_file(Ex const& ex)
+        : stream_file(ex.context())
+    {
+    }
+
+    /** Move constructor.
+
+        Transfers ownership of the file resources.
+
+        @param other The file to move from.
+    */
+    stream_file(stream_file&& other) noexcept
+        : io_stream(other.context())
+    {
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+
+    /** Move assignment operator.
+
+        Closes any open file and transfers ownership. The source and
+        destination must share the same execution context.
+
+        @param other The file to move from.
+
+        @return Reference to this file.
+
+        @throws std::logic_error if the files have different
+            execution contexts.
+    */
+    stream_file& operator=(stream_file&& other)
+    {
+        if (this != &other)
+        {
+            if (ctx_ != other.ctx_)
+                detail::throw_logic_error(
+                    "cannot move stream_file across execution contexts");
+            close();
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    stream_file(stream_file const&) = delete;
+    stream_file& operator=(stream_file const&) = delete;
+
+    /** Open a file.
+
+        Closes any file held before. The position starts at zero.
+
+        @param path The path of the file.
+        @param open_flags How to open the file.
+
+        @throws std::system_error on failure.
+    */
+    void open(std::string_view path, flags open_flags);
+
+    /** Close the file.
+
+        Pending operations complete with `errc::operation_canceled`.
+        Has no effect on a closed file.
+    */
+    void close();
+
+    /** Check if the file is open.
+
+        @return `true` if the file is open.
+    */
+    bool is_open() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /** Cancel any pending asynchronous operations.
+
+        A transfer already handed to a worker thread runs to the end;
+        every other pending operation completes with
+        `errc::operation_canceled`.
+    */
+    void cancel();
+
+    /** Return the native file handle.
+
+        @return The handle, or an invalid handle if the file is closed.
+    */
+    native_file_type native_handle() const noexcept;
+
+    /** Return the size of the file in bytes.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    std::uint64_t size() const;
+
+    /** Extend or truncate the file.
+
+        The position is not changed.
+
+        @param n The new size in bytes.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void resize(std::uint64_t n);
+
+    /** Flush data and metadata to the storage device.
+
+        This call blocks until the device has the data.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void sync_all();
+
+    /** Flush data to the storage device.
+
+        Like @ref sync_all, but metadata that is not needed to read
+        the data back may be left.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error on failure.
+    */
+    void sync_data();
+
+    /** Move the position.
+
+        @param offset The distance to move, from `whence`.
+        @param whence The origin of the move.
+
+        @return The new position.
+
+        @throws std::logic_error if the file is not open.
+        @throws std::system_error if the new position would be
+            negative.
+
+        @par Preconditions
+        No operation is pending.
+    */
+    std::uint64_t seek(std::int64_t offset, seek_basis whence);
+
+    struct stream_file_impl
+        : io_stream_impl
+        , file_impl
+    {
+        /// Move the position, see @ref stream_file::seek.
+        virtual std::uint64_t seek(
+            std::int64_t offset,
+            seek_basis whence,
+            system::error_code& ec) = 0;
+    };
+
+private:
+    stream_file_impl& get() const noexcept
+    {
+        return *static_cast<stream_file_impl*>(
+            static_cast<io_stream_impl*>(impl_));
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
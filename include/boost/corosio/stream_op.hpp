@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_STREAM_OP_HPP
+#define BOOST_COROSIO_STREAM_OP_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <coroutine>
+#include <cstddef>
+
+namespace boost::corosio {
+
+/** A reusable read or write with a completion callback.
+
+    A stream operation starts reads and writes on a stream and
+    reports each result to @ref on_complete, which a derived class
+    overrides. It is meant for paths where even a recycled
+    coroutine frame per operation costs too much: the object is
+    allocated once, typically one per socket and direction, and
+    re-armed from its own completion for as long as the stream
+    lives, with no allocation and no coroutine of the caller's.
+
+    The operation goes through the same backend machinery as
+    @ref io_stream::read_some and @ref io_stream::write_some, so it
+    parks, completes inline and is cancelled exactly as they are.
+    Internally the object owns one suspended coroutine frame,
+    created by its constructor, which the backend resumes in place
+    of an awaiting coroutine; each completion resumes that frame
+    and calls @ref on_complete directly.
+
+    One operation may be pending at a time. Calling @ref read_some
+    or @ref write_some from @ref on_complete starts the next one
+    once the callback returns, without recursion, so a loop of
+    completions that finish inline does not grow the stack. A
+    stream that reads and writes at the same time uses one object
+    for each.
+
+    The stream's operations are not cancelled through this object:
+    cancel or close the stream, and the pending operation completes
+    with the error.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. @ref on_complete runs on a thread
+    running the stream's context.
+
+    @par Example
+    @code
+    struct feed_reader : corosio::stream_op
+    {
+        std::array<char, 4096> buf;
+
+        explicit feed_reader(corosio::socket& s)
+            : stream_op(s)
+        {
+        }
+
+        void on_complete(system::error_code ec, std::size_t n) override
+        {
+            if (ec)
+                return;
+            handle(buf.data(), n);
+            read_some(capy::mutable_buffer(buf.data(), buf.size()));
+        }
+    };
+
+    feed_reader r(sock);
+    r.read_some(capy::mutable_buffer(r.buf.data(), r.buf.size()));
+    ioc.run();
+    @endcode
+*/
+class BOOST_COROSIO_DECL stream_op
+{
+public:
+    /** Construct an operation on `s`.
+
+        Allocates the operation's coroutine frame.
+
+        @param s The stream to read and write. It must outlive this
+            object, and belong to a @ref basic_io_context, whose
+            executor runs the completions.
+
+        @throws std::bad_alloc if memory is exhausted.
+        @throws std::bad_cast if the stream's context is not a
+            @ref basic_io_context.
+    */
+    explicit
+    stream_op(io_stream& s);
+
+    /** Destructor.
+
+        @par Preconditions
+        No operation is pending: it must not be destroyed from
+        @ref on_complete, nor while @ref pending returns `true`.
+    */
+    virtual ~stream_op();
+
+    stream_op(stream_op const&) = delete;
+    stream_op& operator=(stream_op const&) = delete;
+
+    /// Return the stream read and written.
+    io_stream&
+    stream() const noexcept
+    {
+        return s_;
+    }
+
+    /// Return `true` from starting an operation until its completion.
+    bool
+    pending() const noexcept
+    {
+        return pending_;
+    }
+
+    /** Start a read into `buf`.
+
+        If the read completes at once, and this is not called from
+        @ref on_complete, @ref on_complete is called before this
+        function returns.
+
+        @param buf The buffer to read into. It must stay valid until
+            the read completes.
+
+        @par Preconditions
+        No operation is pending.
+    */
+    void
+    read_some(capy::mutable_buffer buf);
+
+    /** Start a write from `buf`.
+
+        Completes as for @ref read_some.
+
+        @param buf The bytes to write. They must stay valid until
+            the write completes.
+
+        @par Preconditions
+        No operation is pending.
+    */
+    void
+    write_some(capy::const_buffer buf);
+
+protected:
+    /** Called when an operation completes.
+
+        The operation is no longer pending when this is called, and
+        it may start the next one.
+
+        @param ec The operation's error, if any.
+        @param n The number of bytes transferred.
+
+        @note It must not throw; an exception escaping it calls
+            `std::terminate`.
+    */
+    virtual void
+    on_complete(system::error_code ec, std::size_t n) = 0;
+
+private:
+    struct driver;
+    struct start_awaitable;
+
+    static driver drive(stream_op& op);
+    void start();
+
+    io_stream& s_;
+    basic_io_context::executor_type ex_;
+    std::coroutine_handle<> h_;
+    capy::mutable_buffer rbuf_;
+    capy::const_buffer wbuf_;
+    system::error_code ec_;
+    std::size_t n_ = 0;
+    bool is_read_ = false;
+    bool pending_ = false;
+    bool in_complete_ = false;
+    bool armed_ = false;
+};
+
+} // namespace boost::corosio
+
+#endif
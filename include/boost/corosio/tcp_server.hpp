@@ -14,16 +14,27 @@
 #include <boost/corosio/acceptor.hpp>
 #include <boost/corosio/socket.hpp>
 #include <boost/corosio/io_context.hpp>
+#include <boost/corosio/io_context_pool.hpp>
 #include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/frame_allocator.hpp>
+#include <boost/corosio/io_account.hpp>
+#include <boost/corosio/parked_ops.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/capy/concept/io_awaitable.hpp>
 #include <boost/capy/concept/executor.hpp>
 #include <boost/capy/ex/any_executor.hpp>
 #include <boost/capy/ex/run_async.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <stdexcept>
+#include <stop_token>
 #include <vector>
 
 namespace boost::corosio {
@@ -80,7 +91,53 @@ namespace boost::corosio {
     };
     @endcode
 
-    @see worker_base, workers, launcher
+    @par Sharded Servers
+    A server constructed from an @ref io_context_pool listens on one
+    acceptor per shard, bound to the same endpoint with `SO_REUSEPORT`
+    so the kernel spreads connections among them. Each connection is
+    accepted on a shard's own reactor and handed to an idle worker
+    whose socket belongs to that shard's context; construct workers
+    with `pool.get_context(i)` to populate every shard. On Linux,
+    `listen_options::cpu_steering` keeps a connection on the core that
+    received it. On Windows, which lacks `SO_REUSEPORT`, only the first
+    shard accepts.
+
+    A worker whose connection ends returns itself to its shard's idle
+    list from whatever thread it ran on, under a lock of that shard
+    alone. With @ref set_accept_loops, each shard accepts on several
+    acceptors joined by `SO_REUSEPORT`, each with its own loop, so
+    that accepts proceed in parallel on the threads running the
+    shard's context. The accept loops of a sharded server run on
+    their shard's context, so a worker handed a connection there
+    can launch its coroutine on the same context.
+
+    @par Elastic Pools
+    With @ref set_worker_limits, the pool grows when an accept finds
+    no idle worker, by calling @ref make_worker, up to `max_workers`.
+    Workers above `min_workers` that stay idle for `idle_timeout` are
+    destroyed. @ref sample_worker_stats reports the pool's size and
+    how long accepts waited for a worker.
+
+    @par Admission Control
+    With @ref set_admission_limits, the server caps the connections
+    it handles at once and the rate at which it accepts them. Over a
+    limit, the accept loops stop accepting, so that new connections
+    wait in the listen backlog until load falls, or with
+    `reset_excess` are accepted and reset at once. @ref counters
+    reads the live counts of connections.
+
+    @par Draining and Handoff
+    @ref drain stops accepting and waits, up to a deadline, for the
+    connections in flight to finish. For a deploy that refuses no
+    connection, the new process takes over the listening sockets
+    before the old one drains: the old process hands each handle
+    from @ref native_handles to it, over a Unix domain socket or
+    by inheritance across `fork` and `exec`, and the new one passes
+    each to @ref adopt instead of calling @ref bind. Both processes
+    then share the same sockets, so connections queued when the old
+    process stops accepting are accepted by the new one.
+
+    @see worker_base, workers, launcher, io_context_pool
 */
 class BOOST_COROSIO_DECL
     tcp_server
@@ -94,9 +151,124 @@ private:
     struct waiter;
 
     io_context& ctx_;
+    io_context_pool* pool_ = nullptr;
     capy::any_executor ex_;
-    waiter* waiters_ = nullptr;
-    std::vector<acceptor> ports_;
+    std::pmr::vector<waiter*> waiters_;  // per shard
+    std::unique_ptr<std::mutex[]> locks_;  // per shard, for idle_ and waiters_
+    std::pmr::vector<acceptor> ports_;
+    std::size_t accept_loops_ = 1;
+    std::stop_source stop_;  // stops the accept loops
+
+public:
+    /** Bounds of an elastic worker pool, see @ref set_worker_limits. */
+    struct worker_limits
+    {
+        /// Workers never destroyed for being idle.
+        std::size_t min_workers = 0;
+
+        /** The most workers the pool grows to.
+
+            Zero disables growth; the pool then holds the workers
+            added with `wv_.emplace()`.
+        */
+        std::size_t max_workers = 0;
+
+        /** How long a worker above `min_workers` may stay idle.
+
+            Zero keeps idle workers.
+        */
+        std::chrono::milliseconds idle_timeout{60000};
+    };
+
+    /** Counters of the worker pool, see @ref sample_worker_stats. */
+    struct worker_stats
+    {
+        /// Workers in the pool.
+        std::size_t workers = 0;
+
+        /// Workers waiting for a connection.
+        std::size_t idle = 0;
+
+        /// Connections accepted.
+        std::uint64_t accepts = 0;
+
+        /// Accepts that found no idle worker and waited for one.
+        std::uint64_t accept_waits = 0;
+
+        /// Total time accepts spent waiting for a worker.
+        std::chrono::nanoseconds accept_wait_time{0};
+
+        /// Longest time one accept waited for a worker.
+        std::chrono::nanoseconds max_accept_wait{0};
+
+        /// Workers made by @ref make_worker.
+        std::uint64_t workers_created = 0;
+
+        /// Workers destroyed after idling.
+        std::uint64_t workers_retired = 0;
+    };
+
+    /** Limits on admitting connections, see @ref set_admission_limits. */
+    struct admission_limits
+    {
+        /** The most connections handled at once.
+
+            Zero is unlimited.
+        */
+        std::size_t max_connections = 0;
+
+        /** The most connections accepted per second, over all loops.
+
+            Up to a second's worth may be accepted in a burst. Zero is
+            unlimited.
+        */
+        std::size_t max_accept_rate = 0;
+
+        /** Reset the connections over a limit.
+
+            When false, accepts pause while over a limit and new
+            connections wait in the listen backlog, which the kernel
+            refuses or drops connections from once it is full. When
+            true, the excess is accepted and closed with a reset, so
+            clients learn at once that the server is overloaded.
+        */
+        bool reset_excess = false;
+    };
+
+    /** Live counters of connections, see @ref counters. */
+    struct connection_counters
+    {
+        /// Connections being handled.
+        std::size_t active = 0;
+
+        /// Connections accepted and handed to a worker.
+        std::uint64_t accepted = 0;
+
+        /// Connections reset for exceeding an admission limit.
+        std::uint64_t rejected = 0;
+    };
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    worker_limits limits_;
+
+    // Guards wv_.v_ and stats_ once started; taken before a shard lock
+    std::mutex pool_mutex_;
+    worker_stats stats_;
+    std::size_t growing_ = 0;  // make_worker calls in progress
+
+    admission_limits admission_;
+    std::atomic<std::size_t> active_{0};
+    std::atomic<std::uint64_t> accepted_{0};
+    std::atomic<std::uint64_t> rejected_{0};
+
+    // Guards admit_waiters_ and the accept rate bucket, and active_
+    // when max_connections is set
+    std::mutex admit_mutex_;
+    waiter* admit_waiters_ = nullptr;
+    double tokens_ = 0;
+    clock_type::time_point refilled_{};
 
     template<capy::Executor Ex>
     struct launch_wrapper
@@ -122,6 +294,17 @@ private:
             {
             }
 
+            // One frame per connection, recycled on the context's thread
+            static void* operator new(std::size_t n)
+            {
+                return frame_allocator::allocate(n);
+            }
+
+            static void operator delete(void* p, std::size_t n) noexcept
+            {
+                frame_allocator::deallocate(p, n);
+            }
+
             launch_wrapper get_return_object() noexcept {
                 return {std::coroutine_handle<promise_type>::from_promise(*this)};
             }
@@ -179,20 +362,27 @@ private:
     {
         waiter* next;
         std::coroutine_handle<> h;
+        capy::executor_ref ex;  // where the accept loop runs
         worker_base* w;
+        std::chrono::steady_clock::time_point since;
     };
 
-    class push_awaitable
+    class pop_awaitable
     {
         tcp_server& self_;
-        worker_base& w_;
+        std::size_t shard_;
+        bool& waited_;
+        waiter wait_;
 
     public:
-        push_awaitable(
+        pop_awaitable(
             tcp_server& self,
-            worker_base& w) noexcept
+            std::size_t shard,
+            bool& waited) noexcept
             : self_(self)
-            , w_(w)
+            , shard_(shard)
+            , waited_(waited)
+            , wait_{}
         {
         }
 
@@ -201,38 +391,40 @@ private:
             return false;
         }
 
+        // Takes an idle worker, or queues to be handed the next one
+        // returned, under the shard's lock
         template<typename Ex>
-        std::coroutine_handle<>
-        await_suspend(std::coroutine_handle<> h, Ex const&, std::stop_token) noexcept
+        bool
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token) noexcept
         {
-            // Dispatch to server's executor before touching shared state
-            return self_.ex_.dispatch(h);
+            std::lock_guard<std::mutex> lock(self_.locks_[shard_]);
+            wait_.w = self_.wv_.try_pop(shard_);
+            if(wait_.w)
+                return false;
+            wait_.h = h;
+            wait_.ex = ex;
+            wait_.since = std::chrono::steady_clock::now();
+            wait_.next = self_.waiters_[shard_];
+            self_.waiters_[shard_] = &wait_;
+            waited_ = true;
+            return true;
         }
 
-        void await_resume() noexcept
+        system::result<worker_base&> await_resume() noexcept
         {
-            // Wake a waiting acceptor if one exists, otherwise add to idle list
-            if(self_.waiters_)
-            {
-                auto* wait = self_.waiters_;
-                self_.waiters_ = wait->next;
-                wait->w = &w_;
-                self_.ex_.post(wait->h);
-            }
-            else
-            {
-                self_.wv_.push(w_);
-            }
+            return *wait_.w;
         }
     };
 
-    class pop_awaitable
+    // Take a connection slot, or queue to be handed the next one
+    // released
+    class admit_awaitable
     {
         tcp_server& self_;
         waiter wait_;
 
     public:
-        pop_awaitable(tcp_server& self) noexcept
+        explicit admit_awaitable(tcp_server& self) noexcept
             : self_(self)
             , wait_{}
         {
@@ -240,55 +432,110 @@ private:
 
         bool await_ready() const noexcept
         {
-            return self_.wv_.idle_ != nullptr;
+            return false;
         }
 
         template<typename Ex>
         bool
-        await_suspend(std::coroutine_handle<> h, Ex const&, std::stop_token) noexcept
+        await_suspend(std::coroutine_handle<> h, Ex const& ex, std::stop_token) noexcept
         {
+            std::lock_guard<std::mutex> lock(self_.admit_mutex_);
+            if(self_.active_.load(std::memory_order_relaxed) <
+                self_.admission_.max_connections)
+            {
+                self_.active_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
             wait_.h = h;
-            wait_.w = nullptr;
-            wait_.next = self_.waiters_;
-            self_.waiters_ = &wait_;
+            wait_.ex = ex;
+            wait_.since = std::chrono::steady_clock::now();
+            wait_.next = self_.admit_waiters_;
+            self_.admit_waiters_ = &wait_;
             return true;
         }
 
-        system::result<worker_base&> await_resume() noexcept
+        void await_resume() noexcept
         {
-            if(wait_.w)
-                return *wait_.w;
-            return *self_.wv_.try_pop();
         }
     };
 
-    push_awaitable push(worker_base& w)
+    // Resume on the server's executor, which owns the worker pool
+    class enter_awaitable
     {
-        return push_awaitable{*this, w};
-    }
+        tcp_server& self_;
+
+    public:
+        explicit enter_awaitable(tcp_server& self) noexcept
+            : self_(self)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename Ex>
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<> h, Ex const&, std::stop_token) noexcept
+        {
+            return self_.ex_.dispatch(h);
+        }
 
-    // Synchronous version for destructor/guard paths
+        void await_resume() noexcept
+        {
+        }
+    };
+
+    // Wake a waiting acceptor of the worker's shard if one exists,
+    // otherwise add the worker to its shard's idle list. Called from
+    // any thread; a waiting accept loop is resumed on its executor.
     void push_sync(worker_base& w) noexcept
     {
-        if(waiters_)
+        if(w.busy.exchange(false, std::memory_order_acq_rel))
         {
-            auto* wait = waiters_;
-            waiters_ = wait->next;
-            wait->w = &w;
-            ex_.post(wait->h);
+            w.arena_.release();
+            release_slot();
         }
-        else
+        w.idle_since = clock_type::now();
+        waiter* wait = nullptr;
         {
-            wv_.push(w);
+            std::lock_guard<std::mutex> lock(locks_[w.shard]);
+            auto& head = waiters_[w.shard];
+            if(head)
+            {
+                wait = head;
+                head = wait->next;
+                wait->w = &w;
+            }
+            else
+            {
+                wv_.push(w);
+            }
         }
+        if(wait)
+            wait->ex.post(wait->h);
     }
 
-    pop_awaitable pop()
+    bool has_idle(std::size_t shard) noexcept
     {
-        return pop_awaitable{*this};
+        std::lock_guard<std::mutex> lock(locks_[shard]);
+        return wv_.idle_[shard] != nullptr;
     }
 
-    capy::task<void> do_accept(acceptor& acc);
+    pop_awaitable pop(std::size_t shard, bool& waited)
+    {
+        return pop_awaitable{*this, shard, waited};
+    }
+
+    capy::task<void> do_accept(acceptor& acc, std::size_t shard);
+    capy::task<void> reap_idle();
+    worker_base* grow(std::size_t shard);
+    void retire_idle();
+    bool try_admit() noexcept;
+    void release_slot() noexcept;
+    clock_type::duration take_token() noexcept;
+    void reject(corosio::socket& s) noexcept;
 
 public:
     /** Abstract base class for connection handlers.
@@ -297,20 +544,101 @@ public:
         Each worker owns a socket and is reused across multiple
         connections to avoid per-connection allocation.
 
+        Each worker also owns an arena, a monotonic memory resource
+        for the allocations of one connection. It is reset when the
+        connection ends, after the connection's coroutine has been
+        destroyed, so nothing allocated from it may outlive the
+        coroutine. A worker constructed with an arena size serves
+        every connection that fits from the same buffer, without
+        touching the heap.
+
         @see tcp_server, launcher
     */
     class BOOST_COROSIO_DECL
         worker_base
     {
         worker_base* next = nullptr;
+        std::size_t shard = 0;
+        std::chrono::steady_clock::time_point idle_since{};
+
+        // The connection being handled, for sample_tcp_info
+        std::atomic<bool> busy{false};
+        native_handle_type handle{};
+        endpoint remote;
+
+        // Charged by the worker's socket; the mark is the usage when
+        // the current connection was accepted, under pool_mutex_
+        io_account account_;
+        io_usage connection_start_;
+
+        std::unique_ptr<std::byte[]> arena_buffer_;
+        std::pmr::monotonic_buffer_resource arena_;
 
         friend class tcp_server;
         friend class workers;
 
+    protected:
+        /// Construct a worker whose arena allocates from the heap.
+        worker_base() = default;
+
+        /** Construct a worker with an arena of a given size.
+
+            @param arena_size The bytes of the arena's buffer.
+                Allocations beyond it come from the default memory
+                resource and are freed on reset.
+        */
+        explicit worker_base(std::size_t arena_size)
+            : worker_base(arena_size, std::pmr::get_default_resource())
+        {
+        }
+
+        /** Construct a worker with an arena over another resource.
+
+            @param arena_size The bytes of the arena's buffer, which
+                may be zero.
+            @param upstream The resource allocations beyond the
+                buffer come from, for example one per shard. It must
+                outlive the worker.
+        */
+        worker_base(
+            std::size_t arena_size,
+            std::pmr::memory_resource* upstream)
+            : arena_buffer_(arena_size
+                ? std::make_unique<std::byte[]>(arena_size)
+                : nullptr)
+            , arena_(arena_buffer_.get(), arena_size, upstream)
+        {
+        }
+
+        /** Return the arena for the current connection.
+
+            Use it for the allocations of the connection, for example
+            through `std::pmr` containers.
+        */
+        std::pmr::memory_resource&
+        arena() noexcept
+        {
+            return arena_;
+        }
+
     public:
         /// Destroy the worker.
         virtual ~worker_base() = default;
 
+        /** Return the account charged by this worker's connections.
+
+            The server attaches it to the socket of each connection
+            the worker accepts, so it totals every connection the
+            worker has served. May be read from any thread.
+
+            @see sample_worker_usage
+        */
+        io_account const&
+        account() const noexcept
+        {
+            return account_;
+        }
+
         /** Handle an accepted connection.
 
             Called when this worker is dispatched to handle a new
@@ -336,12 +664,23 @@ public:
     {
         friend class tcp_server;
 
-        std::vector<std::unique_ptr<worker_base>> v_;
-        worker_base* idle_ = nullptr;
+        std::pmr::vector<std::unique_ptr<worker_base>> v_;
+        std::pmr::vector<worker_base*> idle_;  // per shard
 
     public:
         /// Construct an empty worker pool.
         workers() = default;
+
+        /** Construct an empty worker pool allocating from `mr`.
+
+            The pool's lists are allocated from `mr`; the workers
+            themselves are not.
+        */
+        explicit workers(std::pmr::memory_resource* mr)
+            : v_(mr)
+            , idle_(mr)
+        {
+        }
         workers(workers const&) = delete;
         workers& operator=(workers const&) = delete;
         workers(workers&&) = default;
@@ -350,17 +689,42 @@ public:
     private:
         void push(worker_base& w) noexcept
         {
-            w.next = idle_;
-            idle_ = &w;
+            w.next = idle_[w.shard];
+            idle_[w.shard] = &w;
         }
 
-        worker_base* try_pop() noexcept
+        worker_base* try_pop(std::size_t shard) noexcept
         {
-            auto* w = idle_;
-            idle_ = w->next;
+            auto* w = idle_[shard];
+            if(w)
+                idle_[shard] = w->next;
             return w;
         }
 
+        // Take ownership of a worker made to serve at once
+        worker_base& adopt(
+            std::unique_ptr<worker_base> p,
+            std::size_t shard)
+        {
+            auto& w = *p;
+            w.shard = shard;
+            v_.push_back(std::move(p));
+            return w;
+        }
+
+        // Destroy an idle worker already unlinked from its idle list
+        void destroy(worker_base& w) noexcept
+        {
+            for(auto& p : v_)
+            {
+                if(p.get() != &w)
+                    continue;
+                p = std::move(v_.back());
+                v_.pop_back();
+                return;
+            }
+        }
+
     public:
         /** Construct a worker in place and add it to the pool.
 
@@ -378,6 +742,8 @@ public:
         {
             auto p = std::make_unique<T>(std::forward<Args>(args)...);
             auto* raw = p.get();
+            if(idle_.empty())
+                idle_.resize(1);
             v_.push_back(std::move(p));
             push(*raw);
             return static_cast<T&>(*raw);
@@ -400,6 +766,10 @@ public:
         If destroyed without invoking, the worker is returned to the
         idle pool automatically.
 
+        The frame of the wrapper coroutine that runs the task and
+        returns the worker comes from @ref frame_allocator, so a
+        steady stream of connections reuses the same frames.
+
         @see worker_base::run
     */
     class BOOST_COROSIO_DECL
@@ -464,8 +834,13 @@ public:
                     -> launch_wrapper<Executor>
                 {
                     (void)ex; // Executor stored in promise via constructor
-                    co_await std::move(t);
-                    co_await self->push(*wp);
+                    {
+                        // Destroy the task's frame before the arena
+                        // it may have allocated from is reset
+                        auto local = std::move(t);
+                        co_await std::move(local);
+                    }
+                    self->push_sync(*wp);
                 }(ex, srv_, std::move(task), w);
 
             // Executor is now stored in promise via constructor
@@ -484,20 +859,217 @@ protected:
 
         @param ctx The I/O context for socket operations.
         @param ex The executor for dispatching coroutines.
+        @param mr The memory resource of the server's acceptor,
+            shard and worker lists. It must outlive the server.
     */
     template<capy::Executor Ex>
     tcp_server(
         io_context& ctx,
-        Ex const& ex)
+        Ex const& ex,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
         : ctx_(ctx)
         , ex_(ex)
+        , waiters_(mr)
+        , ports_(mr)
+        , wv_(mr)
     {
     }
 
+    /** Construct a TCP server spread across a pool of contexts.
+
+        Each bound endpoint gets one acceptor per shard of `pool`,
+        whose accept loop runs on the shard's context. The executor
+        runs the coroutines that sample and trim the worker pool.
+
+        @param pool The pool whose contexts accept connections.
+        @param ex The executor for dispatching coroutines.
+        @param mr The memory resource of the server's acceptor,
+            shard and worker lists. It must outlive the server.
+    */
+    template<capy::Executor Ex>
+    tcp_server(
+        io_context_pool& pool,
+        Ex const& ex,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : ctx_(pool.get_context(0))
+        , pool_(&pool)
+        , ex_(ex)
+        , waiters_(mr)
+        , ports_(mr)
+        , wv_(mr)
+    {
+    }
+
+    /** Make a worker for an elastic pool.
+
+        Called on the server's executor when an accept finds no idle
+        worker and the pool holds fewer than `max_workers`. The
+        default makes none, so the accept waits.
+
+        @param ctx The context the worker's socket must belong to:
+            that of the shard accepting.
+
+        @return The new worker, or null to wait for an idle one.
+    */
+    virtual std::unique_ptr<worker_base>
+    make_worker(io_context& ctx);
+
 public:
+    /// Destroy the server.
+    virtual ~tcp_server() = default;
+
+    /// Return the memory resource of the server's lists.
+    std::pmr::memory_resource*
+    memory_resource() const noexcept
+    {
+        return ports_.get_allocator().resource();
+    }
+
+    /** Set the bounds of an elastic worker pool.
+
+        Call before @ref start.
+
+        @param limits The bounds. Growth needs @ref make_worker.
+    */
+    void
+    set_worker_limits(worker_limits const& limits) noexcept
+    {
+        limits_ = limits;
+    }
+
+    /** Set the number of accept loops per endpoint and shard.
+
+        Call before @ref bind. With more than one, each bound endpoint
+        gets that many acceptors per shard, sharing the port through
+        `SO_REUSEPORT` so the kernel spreads connections among them,
+        and each runs its own accept loop. `cpu_steering` is then
+        ignored, since the acceptors no longer map one to one onto
+        shards. On Windows, which lacks `SO_REUSEPORT`, one loop is
+        used.
+
+        @param n The number of loops, at least 1.
+    */
+    void
+    set_accept_loops(std::size_t n) noexcept
+    {
+        accept_loops_ = n ? n : 1;
+    }
+
+    /** Set the limits on admitting connections.
+
+        Call before @ref start.
+
+        @param limits The limits.
+    */
+    void
+    set_admission_limits(admission_limits const& limits) noexcept
+    {
+        admission_ = limits;
+    }
+
+    /** Return the live counters of connections.
+
+        May be called from any thread. The counters are read one at
+        a time, so they may not be mutually consistent.
+    */
+    connection_counters
+    counters() const noexcept
+    {
+        connection_counters c;
+        c.active = active_.load(std::memory_order_relaxed);
+        c.accepted = accepted_.load(std::memory_order_relaxed);
+        c.rejected = rejected_.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    /** Sample the counters of the worker pool.
+
+        The coroutine runs on the server's executor.
+
+        @return A task yielding the counters.
+    */
+    capy::task<worker_stats>
+    sample_worker_stats();
+
+    /** The resources used by one worker, see @ref sample_worker_usage. */
+    struct worker_usage
+    {
+        /// The worker.
+        worker_base const* worker = nullptr;
+
+        /// True if the worker is handling a connection.
+        bool busy = false;
+
+        /// The peer of the current or last connection.
+        endpoint remote_endpoint;
+
+        /// Everything the worker's connections have used.
+        io_usage total;
+
+        /// What the current or last connection has used.
+        io_usage connection;
+    };
+
+    /** Sample the accounts of every worker.
+
+        Reads each worker's @ref worker_base::account without
+        touching its socket, so connections go on undisturbed while
+        the sample is taken; the coroutine runs on the server's
+        executor. Sorting the result by `connection.cpu_time` or
+        bytes finds the connections that use the most.
+
+        Accounts are kept with the epoll backend; with others the
+        usage is zero.
+
+        @return A task yielding one sample per worker.
+    */
+    capy::task<std::vector<worker_usage>>
+    sample_worker_usage();
+
+    /** Append the accept loops parked in this server.
+
+        Adds a @ref parked_kind::server_pop record for each accept
+        loop waiting for an idle worker, and a
+        @ref parked_kind::server_admit record for each waiting for
+        a connection slot. Together with @ref parked_ops this tells
+        where the server's coroutines are suspended.
+
+        May be called from any thread.
+
+        @param out The records to append to.
+    */
+    void
+    append_parked_ops(std::vector<parked_op>& out);
+
+    /** The statistics of one connection, see @ref sample_tcp_info. */
+    struct connection_sample
+    {
+        /// The address of the peer.
+        endpoint remote_endpoint;
+
+        /// The kernel's statistics for the connection.
+        socket::tcp_statistics stats;
+    };
+
+    /** Sample the TCP statistics of every open connection.
+
+        Reads @ref socket::tcp_info for the socket of each worker
+        handling a connection. The handles are recorded on accept,
+        so the sockets are not touched and the workers' own I/O
+        goes on undisturbed; the coroutine runs on the server's
+        executor and makes one system call per connection. A
+        connection closing at that moment may be left out.
+
+        @return A task yielding one sample per connection, empty
+            where the platform provides no statistics.
+    */
+    capy::task<std::vector<connection_sample>>
+    sample_tcp_info();
+
     /** Bind to a local endpoint.
 
-        Creates an acceptor listening on the specified endpoint.
+        Creates an acceptor listening on the specified endpoint, or
+        one per shard when the server was constructed from a pool.
         Multiple endpoints can be bound by calling this method
         multiple times before @ref start.
 
@@ -508,6 +1080,67 @@ public:
     system::error_code
     bind(endpoint ep);
 
+    /** Bind to a local endpoint with listen options.
+
+        Like @ref bind, with the settings of `opts` applied to every
+        acceptor. A sharded server always sets `reuse_port`; setting
+        `cpu_steering` as well, with a pool constructed using
+        `io_context_pool::affinity::per_core`, accepts each connection
+        on the shard pinned to the CPU that received it. A server with
+        one acceptor ignores `cpu_steering`.
+
+        @param ep The local endpoint to bind to.
+        @param opts The listen options.
+
+        @return The error code if binding fails.
+    */
+    system::error_code
+    bind(endpoint ep, acceptor::listen_options opts);
+
+    /** Adopt a listening socket from another process.
+
+        Like @ref bind, with a socket already listening: one handle
+        from the @ref native_handles of the process handing over.
+        Adopt each of them in order; a sharded server gives them to
+        its shards in turn. Call before @ref start.
+
+        @param h The listening socket, owned by the server on success.
+
+        @return The error code if the socket cannot be adopted, in
+            which case the caller still owns it. Not supported on
+            Windows.
+    */
+    system::error_code
+    adopt(native_handle_type h);
+
+    /** Return the listening sockets.
+
+        The handles stay owned by the server. Duplicate them, or
+        clear their close-on-exec flags, to hand them to another
+        process.
+
+        @return One handle per acceptor, in the order bound.
+    */
+    std::vector<native_handle_type>
+    native_handles() const;
+
+    /** Stop accepting and wait for connections to finish.
+
+        Stops the accept loops, each of which closes its acceptor,
+        so that new connections go to any other process sharing the
+        listening sockets, or are refused if there is none. The
+        connections in flight go on until their workers finish or
+        the deadline passes; the coroutine runs on the server's
+        executor and checks for this every 10 milliseconds.
+
+        @param timeout How long to wait for the connections.
+
+        @return A task yielding `true` if every connection finished
+            in time.
+    */
+    capy::task<bool>
+    drain(std::chrono::milliseconds timeout);
+
     /** Start accepting connections.
 
         Launches accept loops for all bound endpoints. Incoming
@@ -515,7 +1148,8 @@ public:
 
         @par Preconditions
         At least one endpoint has been bound via @ref bind.
-        Workers have been added to the pool via `wv_.emplace()`.
+        Workers have been added to the pool via `wv_.emplace()`,
+        or @ref make_worker makes them.
     */
     void start();
 };
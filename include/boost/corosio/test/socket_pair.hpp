@@ -11,6 +11,7 @@
 #define BOOST_COROSIO_TEST_SOCKET_PAIR_HPP
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
 #include <boost/corosio/io_context.hpp>
 #include <boost/corosio/socket.hpp>
 
@@ -23,13 +24,31 @@ namespace boost::corosio::test {
     Creates two sockets connected via loopback TCP sockets.
     Data written to one socket can be read from the other.
 
-    @param ioc The io_context for the sockets.
+    @param ioc The context for the sockets, of any backend.
 
     @return A pair of connected sockets.
 */
 BOOST_COROSIO_DECL
 std::pair<socket, socket>
-make_socket_pair(io_context& ioc);
+make_socket_pair(basic_io_context& ioc);
+
+/** Create a connected pair of sockets without the network stack.
+
+    Creates the pair with `socketpair(2)` as `AF_UNIX` stream
+    sockets and adopts both ends with @ref socket::assign, which
+    costs two system calls instead of the bind, listen, connect
+    and accept of @ref make_socket_pair. Use it where a test or
+    benchmark only moves bytes; TCP options such as no-delay fail
+    on these sockets, and their endpoints are default endpoints.
+    On Windows this is @ref make_socket_pair.
+
+    @param ioc The context for the sockets, of any backend.
+
+    @return A pair of connected sockets.
+*/
+BOOST_COROSIO_DECL
+std::pair<socket, socket>
+make_local_socket_pair(basic_io_context& ioc);
 
 } // namespace boost::corosio::test
 
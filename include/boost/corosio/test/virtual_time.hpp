@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_TEST_VIRTUAL_TIME_HPP
+#define BOOST_COROSIO_TEST_VIRTUAL_TIME_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+
+#include <chrono>
+
+namespace boost::corosio::test {
+
+/** Move the virtual clock of a context forward to `t`.
+
+    Timers due by `t` complete the next time the context runs, in
+    order of expiry. A time not after the context's current time,
+    see @ref basic_io_context::now, changes nothing. Safe to call
+    from any thread, including from a handler of the context.
+
+    @param ctx A context created with @ref timer_options::virtual_time.
+
+    @param t The new time.
+
+    @throws std::logic_error if the context's timers run on the
+        real clock.
+*/
+BOOST_COROSIO_DECL
+void
+advance_time_to(
+    basic_io_context& ctx,
+    std::chrono::steady_clock::time_point t);
+
+/** Move the virtual clock of a context forward by `d`.
+
+    @par Example
+    @code
+    corosio::epoll_options opts;
+    opts.timers.virtual_time = true;
+    opts.timers.auto_advance = false;
+    corosio::epoll_context ctx(1, opts);
+
+    corosio::timer t(ctx);
+    t.expires_after(std::chrono::hours(1));
+    // ... start a coroutine waiting on t
+    corosio::test::advance_time(ctx, std::chrono::hours(1));
+    ctx.run();  // the wait completes at once
+    @endcode
+
+    @param ctx A context created with @ref timer_options::virtual_time.
+
+    @param d How far to move the clock.
+
+    @throws std::logic_error as for @ref advance_time_to.
+*/
+inline
+void
+advance_time(
+    basic_io_context& ctx,
+    std::chrono::steady_clock::duration d)
+{
+    advance_time_to(ctx, ctx.now() + d);
+}
+
+} // namespace boost::corosio::test
+
+#endif
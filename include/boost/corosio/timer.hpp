@@ -27,6 +27,109 @@
 
 namespace boost::corosio {
 
+/** How an I/O context keeps its timers.
+
+    @see timer_options
+*/
+enum class timer_queue
+{
+    /// A binary heap: exact expiry order, O(log n) arm and cancel.
+    heap,
+
+    /// A hierarchical timing wheel: O(1) arm and cancel.
+    wheel,
+
+    /** One heap per shard, each with its own lock.
+
+        A timer belongs to the shard of the thread that created it,
+        so threads running the context arm and expire their own
+        timers without contending with each other.
+    */
+    sharded
+};
+
+/** Timer settings of an I/O context.
+
+    The default heap suits most programs. A program that keeps many
+    timeouts armed and resets them on every message, such as an idle
+    timeout per connection, can use the timing wheel instead: arming,
+    resetting and cancelling a timer then cost the same however many
+    timers exist. Wheel expiries are rounded up to a multiple of
+    `tick`, so a timer may complete up to one tick late, never early.
+    A context run by many threads that each arm their own timers can
+    use the sharded heaps so the threads do not share one lock.
+*/
+struct timer_options
+{
+    /// The timer queue implementation.
+    timer_queue queue = timer_queue::heap;
+
+    /// Wheel resolution. Zero is treated as one microsecond.
+    std::chrono::microseconds tick{1000};
+
+    /** Expired timers the wheel takes per lock acquisition.
+
+        Their waiters are resumed before the next batch is taken, so
+        a long run of expiries does not hold the lock throughout.
+        Zero is treated as one.
+    */
+    unsigned expiry_batch = 256;
+
+    /** Heaps kept by the sharded queue.
+
+        Zero uses one per hardware thread.
+    */
+    unsigned shards = 0;
+
+    /** Read the clock once per reactor pass.
+
+        Expiry processing samples the clock and relative expiries
+        and @ref basic_io_context::now reuse the sample, instead of
+        each reading the clock. The time then stands still while
+        handlers run, so a timer armed with `expires_after` late in
+        a long pass completes early by as much as the pass has run.
+    */
+    bool cached_time = false;
+
+    /** With `cached_time`, sample a coarse clock where available.
+
+        On Linux this reads CLOCK_MONOTONIC_COARSE, which costs no
+        hardware counter read but advances only once per kernel
+        tick, typically 1 to 4 milliseconds. The reactor wakes a
+        tick after each expiry, when the coarse clock has reached
+        it, so timers complete up to a tick late.
+    */
+    bool coarse_clock = false;
+
+    /** Run timers on a virtual clock, for tests and simulations.
+
+        The clock starts at the time the context is created and
+        moves only when @ref test::advance_time is called or, with
+        `auto_advance`, when the context is idle. A test of hours
+        of timeouts then runs in milliseconds, and the order in
+        which timers complete is the same on every run. The
+        timers use the heap whatever `queue` says, and
+        @ref basic_io_context::now returns the virtual time.
+        Supported by the epoll, io_uring and IOCP backends.
+    */
+    bool virtual_time = false;
+
+    /** With `virtual_time`, jump to the next expiry when idle.
+
+        The context is idle when no handler is queued and nothing
+        but a timer can complete: every pending operation is a
+        timer wait or, on epoll, a socket operation waiting for
+        its descriptor that one reactor pass has found not ready.
+        The clock then jumps to the earliest expiry. An operation
+        still in flight, such as a resolve, holds the clock.
+        Idleness is checked before each reactor wait, so it
+        assumes one thread runs the context. IOCP arms its
+        timeout only when the timers change, so it may miss the
+        context going idle; use @ref test::advance_time there.
+    */
+    bool auto_advance = true;
+};
+
 /** An asynchronous timer for coroutine I/O.
 
     This class provides asynchronous timer operations that return
@@ -183,6 +286,39 @@ public:
         expires_after(std::chrono::duration_cast<duration>(d));
     }
 
+    /** Get the timer's slack.
+
+        @return The tolerance set by @ref set_slack, zero by default.
+    */
+    duration slack() const;
+
+    /** Allow the timer to complete late by up to a tolerance.
+
+        With a nonzero slack the context may complete the wait at any
+        time in `[expiry(), expiry() + s)`. Expiries are rounded up to
+        a multiple of `s`, so timers with the same slack and nearby
+        expiries complete on a single wakeup. This suits timeouts
+        whose precision does not matter. The new slack applies from
+        the next call to @ref expires_at or @ref expires_after.
+
+        @param s The tolerance. Zero, the default, completes the wait
+            as soon as the expiry is reached.
+    */
+    void set_slack(duration s);
+
+    /** Allow the timer to complete late by up to a tolerance.
+
+        This is a convenience overload that accepts any duration type
+        and converts it to the timer's native duration type.
+
+        @param s The tolerance.
+    */
+    template<class Rep, class Period>
+    void set_slack(std::chrono::duration<Rep, Period> s)
+    {
+        set_slack(std::chrono::duration_cast<duration>(s));
+    }
+
     /** Wait for the timer to expire.
 
         The operation supports cancellation via `std::stop_token` through
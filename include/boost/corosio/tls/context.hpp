@@ -13,8 +13,13 @@
 #include <boost/corosio/detail/config.hpp>
 #include <boost/system/result.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
 #include <string_view>
 
 namespace boost::corosio::tls {
@@ -212,6 +217,25 @@ public:
     */
     context();
 
+    /** Construct a TLS context allocating from a memory resource.
+
+        The context's shared state, and the certificates, keys, trust
+        anchors, revocation lists and other settings loaded into it,
+        are allocated from `mr`. The native contexts and sessions the
+        TLS backend builds are allocated by the TLS library.
+
+        @param mr The memory resource. It must outlive every copy of
+            the context and every stream made from one.
+
+        @throws std::bad_alloc if the resource cannot allocate.
+    */
+    explicit
+    context( std::pmr::memory_resource* mr );
+
+    /// Return the memory resource of the context's state.
+    std::pmr::memory_resource*
+    memory_resource() const noexcept;
+
     /** Copy constructor.
 
         Creates a new handle that shares ownership of the underlying
@@ -631,6 +655,184 @@ public:
     system::result<void>
     set_alpn( std::initializer_list<std::string_view> protocols );
 
+    /** Enable kernel TLS offload of sending.
+
+        When enabled, a stream whose backend and platform support it
+        hands the session's send keys to the kernel after the
+        handshake, and from then on writes plaintext to the socket,
+        which the kernel encrypts. This saves the copy of each
+        record through the stream's buffers and its encryption in
+        userspace. Receiving is still decrypted by the TLS library.
+
+        Offload is attempted only by `openssl_stream` over a
+        `socket`, with OpenSSL 3 on Linux and a cipher the kernel
+        supports (the `tls` module must be loaded). Otherwise, or if
+        the kernel refuses the keys, the stream silently encrypts in
+        userspace as before.
+
+        @param enable Whether to attempt offload. Off by default.
+
+        @see openssl_stream::kernel_tls_send
+    */
+    void
+    set_kernel_tls( bool enable );
+
+    /** Run handshake computation on a pool of threads.
+
+        The public-key operations of a handshake, such as signing
+        with the server's key, can take hundreds of microseconds.
+        Run on the I/O thread, they delay every other operation of
+        its `io_context`, which shows when many clients connect at
+        once. With a pool, each step of a handshake that computes,
+        rather than waits for I/O, runs on one of the pool's
+        threads, and the handshake resumes on the stream's executor
+        once it is done.
+
+        The threads are started with the first stream made from the
+        context and shared by all of its streams, on any
+        `io_context`. Verification and SNI callbacks then run on
+        them too.
+
+        @param threads The number of threads. Zero, the default,
+            runs handshakes on the I/O thread.
+    */
+    void
+    set_handshake_threads( std::size_t threads );
+
+    /** Start connections with small records.
+
+        When enabled, a stream sends its first megabyte, and again
+        the first megabyte after a second without writes, in
+        records that each fit one TCP segment. The peer can then
+        process data as each segment arrives, rather than wait for
+        the whole of a 16 KiB record while the congestion window is
+        still small. Afterwards records are full size, which costs
+        the least per byte. When disabled, every record is full
+        size.
+
+        Either way, a write of several buffers gathers them into
+        records of the chosen size, rather than writing a record
+        per buffer.
+
+        @param enable Whether to size records dynamically. Off by
+            default.
+    */
+    void
+    set_dynamic_record_sizing( bool enable );
+
+    //--------------------------------------------------------------------------
+    //
+    // Crypto Offload
+    //
+    //--------------------------------------------------------------------------
+
+    /** Take the cryptography from an OpenSSL 3 provider.
+
+        The native context of `openssl_stream` is then built in a
+        library context of its own, into which the provider and the
+        default provider are loaded. Algorithms are fetched with the
+        given property query, so the provider's RSA, ECDHE and
+        AES-GCM are used where it has them and the default
+        provider's elsewhere. Other contexts of the process are not
+        affected.
+
+        If the provider cannot be loaded, streams made from the
+        context fail to construct their session, rather than fall
+        back to software.
+
+        @par Example
+        @code
+        // Intel QAT through the QAT provider
+        ctx.set_crypto_provider( "qatprovider" ).value();
+        @endcode
+
+        @param name The provider's name, as given to
+            `OSSL_PROVIDER_load`.
+
+        @param properties The property query of fetches. Empty, the
+            default, prefers the provider: `"?provider=<name>"`.
+
+        @return An error if `name` is empty.
+
+        @note Only `openssl_stream` with OpenSSL 3 uses this
+            setting; see @ref set_crypto_engine for earlier versions
+            and @ref set_crypto_device for WolfSSL.
+
+        @see set_async_crypto
+    */
+    system::result<void>
+    set_crypto_provider(
+        std::string_view name,
+        std::string_view properties = {} );
+
+    /** Take the cryptography from an OpenSSL engine.
+
+        The engine is loaded, initialized and made the default for
+        every algorithm it implements when the first stream is made
+        from the context. Engine defaults are global to OpenSSL, so
+        this affects every context of the process, whichever asked
+        for it.
+
+        @param id The engine's identifier, as given to
+            `ENGINE_by_id`, such as `"qatengine"`.
+
+        @return An error if `id` is empty.
+
+        @note Only `openssl_stream` uses this setting, and only with
+            an OpenSSL built with engines. Prefer
+            @ref set_crypto_provider with OpenSSL 3.
+    */
+    system::result<void>
+    set_crypto_engine( std::string_view id );
+
+    /** Hand the cryptography to a WolfSSL crypto device.
+
+        The native contexts of `wolfssl_stream` are given the device
+        identifier, so WolfSSL calls the crypto callback registered
+        for it with `wc_CryptoCb_RegisterDevice` for the operations
+        the callback implements, or, with @ref set_async_crypto,
+        submits them to the asynchronous device opened with
+        `wolfAsync_DevOpen`. The application registers or opens the
+        device before the first stream is made.
+
+        @param id The device identifier. -1, the default, uses
+            software.
+
+        @note Only `wolfssl_stream` uses this setting, and only with
+            a WolfSSL built with `WOLF_CRYPTO_CB` or
+            `WOLFSSL_ASYNC_CRYPT`.
+    */
+    void
+    set_crypto_device( int id );
+
+    /** Let handshakes wait for offloaded operations.
+
+        An accelerator reached through a provider, engine or device
+        is fast at each operation but slow to return it: waiting for
+        the result on the I/O thread stalls every other operation of
+        its `io_context`. With asynchronous crypto, a handshake step
+        that submits an operation returns at once; the stream waits
+        for the operation while the thread runs other work, and
+        then steps the handshake again.
+
+        With a pool from @ref set_handshake_threads the wait parks
+        one of the pool's threads; without one, the stream checks
+        the operation each time its executor runs it again. With
+        `openssl_stream` the session's `SSL_MODE_ASYNC` is on only
+        during the handshake, and records are then encrypted
+        without waiting.
+
+        @param enable Whether to wait asynchronously. Off by
+            default.
+
+        @note Has an effect only with an engine or provider that
+            supports OpenSSL's asynchronous jobs, or a WolfSSL built
+            with `WOLFSSL_ASYNC_CRYPT`; otherwise operations
+            complete as they are submitted.
+    */
+    void
+    set_async_crypto( bool enable );
+
     //--------------------------------------------------------------------------
     //
     // Certificate Verification
@@ -747,8 +949,8 @@ public:
         @endcode
 
         @note For virtual hosting with different certificates per hostname,
-            create separate contexts and select the appropriate one before
-            creating the TLS stream.
+            route each hostname to a context holding its certificate with
+            @ref add_server_context.
 
         @see set_hostname
     */
@@ -756,6 +958,125 @@ public:
     void
     set_servername_callback( Callback callback );
 
+    /** Serve a hostname with the certificate of another context.
+
+        A server handshake whose client requests `hostname` through
+        SNI switches to `ctx` when the ClientHello arrives, and
+        presents the certificate, chain and private key of `ctx`,
+        along with any OCSP response stapled by it. Other settings,
+        such as protocol versions and verification, remain those of
+        this context. Handshakes for names that are not routed, or
+        that send no SNI, use this context. A servername callback,
+        if set, is still invoked.
+
+        `hostname` is either an exact name, or a wildcard such as
+        `*.example.com`, which matches names with one more label
+        in front of `example.com`, but not `example.com` itself.
+        An exact route is preferred to a wildcard. Names compare
+        without regard to case. Routing a name again replaces its
+        route.
+
+        Routes are kept in a hash table, so selecting the context
+        of a handshake takes constant time however many hostnames
+        are served. The native context of `ctx` is built the first
+        time one of its names is requested.
+
+        @param hostname The exact or wildcard hostname.
+
+        @param ctx The context serving `hostname`. Its own routes
+            are not consulted.
+
+        @return Success, or `errc::invalid_argument` if `hostname`
+            is empty, longer than 253 characters, has a wildcard
+            other than a leading `*.`, or `ctx` is this context.
+
+        @par Example
+        @code
+        tls::context server_ctx;    // default certificate
+        for( auto& site : sites )
+            server_ctx.add_server_context( site.hostname, site.ctx ).value();
+        server_ctx.add_server_context( "*.example.com", wildcard_ctx ).value();
+        @endcode
+
+        @see set_servername_callback
+    */
+    system::result<void>
+    add_server_context( std::string_view hostname, context const& ctx );
+
+    /** Build server contexts on demand for requested hostnames.
+
+        A server handshake whose client requests a hostname through
+        SNI that @ref add_server_context does not route asks the
+        loader for a context serving it, and then presents that
+        context's certificate as a routed handshake would. Contexts
+        are built only for the hostnames clients ask for, rather
+        than all of them at startup.
+
+        The loader runs on threads owned by this context, never on
+        an I/O thread, so it may block to read files or fetch
+        credentials over the network. Its native context is built
+        there too. Meanwhile the handshakes waiting for it yield
+        their thread: with OpenSSL the handshake is paused at the
+        ClientHello and resumed on its executor once the context is
+        ready. WolfSSL cannot pause a handshake there, and waits in
+        its SNI callback; set @ref set_handshake_threads so that the
+        wait happens on a handshake thread.
+
+        Each hostname is loaded once: handshakes that request it
+        while it is loading wait for the same load. The result,
+        including a loader finding no context, is kept in a cache
+        holding up to `cache_size` hostnames, from which the least
+        recently requested is dropped. Streams already using a
+        dropped context keep it until they are destroyed.
+
+        @tparam Loader A callable with signature
+            `std::optional<context>( std::string_view hostname )`,
+            which returns the context for the lowercase `hostname`,
+            or `std::nullopt` to serve it with this context. An
+            exception it throws counts as `std::nullopt`.
+
+        @param loader The loader.
+
+        @param cache_size The most hostnames whose result is kept.
+            At least one is.
+
+        @param threads The number of threads running the loader.
+            At least one is started, by the first load.
+
+        @par Example
+        @code
+        server_ctx.set_server_context_loader(
+            []( std::string_view hostname ) -> std::optional<tls::context>
+            {
+                auto cert = vault.fetch( hostname );    // may block
+                if( !cert )
+                    return std::nullopt;
+                tls::context ctx;
+                ctx.use_certificate_chain( cert->chain ).value();
+                ctx.use_private_key( cert->key, tls::file_format::pem ).value();
+                return ctx;
+            },
+            4096 );
+        @endcode
+
+        @see add_server_context
+    */
+    template<typename Loader>
+    void
+    set_server_context_loader(
+        Loader loader,
+        std::size_t cache_size = 1024,
+        std::size_t threads = 1 );
+
+private:
+    void
+    set_server_context_loader_impl(
+        std::function<std::optional<context>( std::string_view )> loader,
+        std::size_t cache_size,
+        std::size_t threads );
+
+public:
+
 private:
     void
     set_servername_callback_impl(
@@ -815,7 +1136,10 @@ public:
         to contact the OCSP responder.
 
         The OCSP response must be periodically refreshed (typically
-        every few hours to days) before it expires.
+        every few hours to days) before it expires. It may be
+        replaced at any time, including while streams made from
+        this context are handshaking; later handshakes staple the
+        new response. An empty response stops stapling.
 
         @param response The DER-encoded OCSP response.
 
@@ -823,10 +1147,59 @@ public:
 
         @note This is a server-side operation. Clients use
             `set_require_ocsp_staple()` to require stapled responses.
+
+        @see set_ocsp_staple_source
     */
     system::result<void>
     set_ocsp_staple( std::string_view response );
 
+    /** Set a function that fetches the OCSP response to staple.
+
+        The context calls `fetch` on a thread of its own: first when
+        the first stream is made from it, then every `refresh`
+        interval. Each response it returns replaces the stapled one,
+        as with @ref set_ocsp_staple, so handshakes only ever copy a
+        response from memory and never wait for the responder. If
+        `fetch` throws or returns an empty string, the previous
+        response stays in use and the fetch is retried within a
+        minute.
+
+        @tparam Callback A callable with signature `std::string()`
+            that returns a DER-encoded OCSP response.
+
+        @param fetch The function that fetches a response, typically
+            by a blocking request to the responder named in the
+            certificate's Authority Information Access extension.
+
+        @param refresh The time between fetches. It should be well
+            under the responses' validity period.
+
+        @par Example
+        @code
+        ctx.set_ocsp_staple_source(
+            []{ return fetch_ocsp_response( "server.crt", "issuer.crt" ); },
+            std::chrono::hours( 6 ) );
+        @endcode
+
+        @note Destroying the last copy of the context waits for a
+            fetch in progress to return.
+
+        @note Only `openssl_stream` staples responses.
+    */
+    template<typename Callback>
+    void
+    set_ocsp_staple_source(
+        Callback fetch,
+        std::chrono::seconds refresh = std::chrono::hours( 1 ) );
+
+private:
+    void
+    set_ocsp_staple_source_impl(
+        std::function<std::string()> fetch,
+        std::chrono::seconds refresh );
+
+public:
+
     /** Require OCSP stapling from the server.
 
         For clients, requires the server to provide a stapled OCSP
@@ -834,6 +1207,14 @@ public:
         the server doesn't provide a stapled response, the handshake
         fails.
 
+        A stapled response is checked without contacting the
+        responder: it must be signed by the certificate's issuer or
+        a responder the issuer delegated to, be current, and not
+        report the certificate as revoked. A revoked certificate
+        always fails the handshake. A missing, invalid, or unknown
+        response fails it only when stapling is required or the
+        revocation policy is `hard_fail`.
+
         @param require Whether to require OCSP stapling.
 
         @note Not all servers support OCSP stapling. Enable this only
@@ -864,6 +1245,97 @@ public:
     void
     set_revocation_policy( revocation_policy policy );
 
+    //--------------------------------------------------------------------------
+    //
+    // Session Resumption
+    //
+    //--------------------------------------------------------------------------
+
+    /** Set the number of sessions kept for resumption.
+
+        A server keeps up to this many sessions of its clients, so
+        that a returning client can skip the key exchange and
+        certificate verification of a full handshake. A client
+        keeps up to this many sessions, one per server, and offers
+        the one of the server it connects to; streams sharing this
+        context resume automatically. A server is identified by the
+        hostname set with @ref set_hostname and, when the stream is
+        a `socket`, the remote endpoint.
+
+        Zero disables both caches; a server may still resume
+        clients through session tickets. Defaults to 20480.
+
+        @param size The most sessions to keep on each side.
+
+        @note WolfSSL's server cache has a size fixed when the
+            library is built; there a nonzero size only enables it.
+    */
+    void
+    set_session_cache_size( std::size_t size );
+
+    /** Set how long a session may be resumed.
+
+        Applies to sessions in the server cache and to the
+        lifetime of the session tickets a server issues. Defaults
+        to two hours.
+
+        @param timeout The lifetime of a session.
+    */
+    void
+    set_session_timeout( std::chrono::seconds timeout );
+
+    /** Enable or disable session tickets.
+
+        With tickets, a server hands its client the session
+        encrypted under a key of its own instead of keeping it,
+        so resumption costs the server no memory and works across
+        its cache limit. Enabled by default.
+
+        @param enable Whether to issue and accept tickets.
+    */
+    void
+    set_session_tickets( bool enable );
+
+    /** Set how long a ticket key is used.
+
+        A server encrypts new tickets under its current key, which
+        is replaced by a fresh random key once it is this old. The
+        replaced key still decrypts tickets for another period, and
+        clients presenting one receive a new ticket. Defaults to
+        twelve hours.
+
+        @param lifetime The time each key encrypts new tickets.
+
+        @note Only `openssl_stream` uses this setting. WolfSSL
+            rotates its own ticket keys on a lifetime fixed when the
+            library is built.
+    */
+    void
+    set_ticket_key_lifetime( std::chrono::seconds lifetime );
+
+    /** Accept TLS 1.3 early data on resumed sessions.
+
+        A server with a nonzero limit issues tickets that allow
+        clients to send up to `bytes` of early data when resuming,
+        which streams read with @ref tls_stream::read_early_data
+        before completing the handshake. Zero, the default, issues
+        tickets without it and rejects early data.
+
+        Early data can be replayed by an attacker. The backend does
+        not prevent it; the application must only act on early data
+        that is safe to process more than once.
+
+        @param bytes The most early data a client may send.
+
+        @note Only `openssl_stream` sends and accepts early data.
+            WolfSSL streams complete a regular handshake, and report
+            that no early data was sent or received.
+
+        @see tls_stream::handshake_early
+    */
+    void
+    set_max_early_data( std::size_t bytes );
+
     //--------------------------------------------------------------------------
     //
     // Password Handling
@@ -914,6 +1386,27 @@ set_servername_callback( Callback callback )
     set_servername_callback_impl( std::move( callback ) );
 }
 
+template<typename Loader>
+void
+context::
+set_server_context_loader(
+    Loader loader,
+    std::size_t cache_size,
+    std::size_t threads )
+{
+    set_server_context_loader_impl( std::move( loader ), cache_size, threads );
+}
+
+template<typename Callback>
+void
+context::
+set_ocsp_staple_source(
+    Callback fetch,
+    std::chrono::seconds refresh )
+{
+    set_ocsp_staple_source_impl( std::move( fetch ), refresh );
+}
+
 } // namespace boost::corosio::tls
 
 #endif
@@ -62,6 +62,16 @@ public:
         Releases the underlying OpenSSL resources.
     */
     ~openssl_stream();
+
+    /** Return `true` if the kernel encrypts what this stream sends.
+
+        Offload starts with the handshake, when the context has
+        `tls::context::set_kernel_tls` enabled and the platform,
+        the underlying stream, and the negotiated cipher allow it.
+        Writes then go straight to the socket.
+    */
+    bool
+    kernel_tls_send() const noexcept;
 };
 
 } // namespace boost::corosio
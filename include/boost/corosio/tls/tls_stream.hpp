@@ -11,11 +11,13 @@
 #define BOOST_COROSIO_TLS_TLS_STREAM_HPP
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/capy/buffers.hpp>
 #include <boost/capy/io_result.hpp>
 #include <boost/corosio/io_stream.hpp>
 #include <boost/capy/ex/executor_ref.hpp>
 
 #include <coroutine>
+#include <cstddef>
 #include <stop_token>
 
 namespace boost::corosio {
@@ -128,6 +130,67 @@ class BOOST_COROSIO_DECL tls_stream : public io_stream
         }
     };
 
+    // Completes with a byte count: of early data accepted by a
+    // client handshake, or of early data read by a server
+    template<class Buffer, bool Read>
+    struct early_data_awaitable
+    {
+        tls_stream& stream_;
+        Buffer buf_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t n_ = 0;
+
+        early_data_awaitable(
+            tls_stream& stream,
+            Buffer buf) noexcept
+            : stream_(stream)
+            , buf_(buf)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if(token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, n_};
+        }
+
+        template<typename Ex>
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            Ex const& ex) -> std::coroutine_handle<>
+        {
+            start(h, ex);
+            return std::noop_coroutine();
+        }
+
+        template<typename Ex>
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            Ex const& ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            start(h, ex);
+            return std::noop_coroutine();
+        }
+
+    private:
+        void start(std::coroutine_handle<> h, capy::executor_ref ex)
+        {
+            if constexpr(Read)
+                stream_.get().read_early_data(h, ex, buf_, token_, &ec_, &n_);
+            else
+                stream_.get().handshake_early(h, ex, buf_, token_, &ec_, &n_);
+        }
+    };
+
 public:
     /** Different handshake types. */
     enum handshake_type
@@ -177,6 +240,77 @@ public:
         return handshake_awaitable(*this, type);
     }
 
+    /** Perform a client handshake, sending early data.
+
+        When the stream resumes a TLS 1.3 session whose server allows
+        early data, as much of `data` as the server allows is sent
+        with the ClientHello, a round trip before a regular handshake
+        could send it. Otherwise, or if the server rejects it, the
+        handshake proceeds as a regular client handshake.
+
+        The server may process early data more than once if an
+        attacker replays it, so it should only carry requests that
+        are safe to repeat.
+
+        @param data The first bytes the application would write.
+
+        @return An awaitable that completes with `io_result<std::size_t>`,
+            the number of bytes of `data` the server accepted. The
+            rest, all of it when this is zero, is not delivered and
+            must be written once the handshake completes.
+
+        @par Preconditions
+        The underlying stream must be connected. `data` must remain
+        valid until the operation completes.
+
+        @par Example
+        @code
+        auto [ec, n] = co_await secure.handshake_early(
+            capy::const_buffer(request.data(), request.size()));
+        if(ec) { ... }
+        if(n < request.size())
+            co_await capy::write(secure,
+                capy::const_buffer(request.data() + n, request.size() - n));
+        @endcode
+
+        @see tls::context::set_max_early_data
+    */
+    auto handshake_early(capy::const_buffer data)
+    {
+        return early_data_awaitable<capy::const_buffer, false>(*this, data);
+    }
+
+    /** Read early data sent by a client, before the server handshake.
+
+        A server that opts in with @ref tls::context::set_max_early_data
+        calls this on a new stream until it completes with zero
+        bytes, and then calls @ref handshake. Each call receives the
+        ClientHello if it has not arrived and reads early data the
+        client sent with it. Zero bytes means there is no more, and
+        is the only result for clients that sent none, or when the
+        session is not resumed. A server that never calls this
+        rejects early data, and clients send it again once the
+        handshake completes.
+
+        Early data is not protected against replay: an attacker can
+        make the server receive it again on another connection. The
+        application decides what it is safe to act on before the
+        handshake completes.
+
+        @param buf The buffer to read into.
+
+        @return An awaitable that completes with `io_result<std::size_t>`,
+            the number of bytes read.
+
+        @par Preconditions
+        The stream has not begun a handshake. `buf` must remain valid
+        until the operation completes.
+    */
+    auto read_early_data(capy::mutable_buffer buf)
+    {
+        return early_data_awaitable<capy::mutable_buffer, true>(*this, buf);
+    }
+
     /** Perform a graceful TLS shutdown asynchronously.
 
         This function initiates the TLS shutdown sequence by sending a
@@ -207,6 +341,20 @@ public:
         return shutdown_awaitable(*this);
     }
 
+    /** Return whether the handshake resumed a session.
+
+        @return `true` if the last completed handshake resumed a
+            session the client offered, skipping the key exchange
+            and certificate verification of a full handshake.
+
+        @see tls::context::set_session_cache_size,
+            tls::context::set_session_tickets
+    */
+    bool session_reused() const noexcept
+    {
+        return get().session_reused();
+    }
+
     /** Returns a reference to the underlying stream.
 
         @return Reference to the wrapped io_stream.
@@ -239,6 +387,24 @@ public:
             capy::executor_ref,
             std::stop_token,
             system::error_code*) = 0;
+
+        virtual void handshake_early(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            capy::const_buffer,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual void read_early_data(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            capy::mutable_buffer,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual bool session_reused() const noexcept = 0;
     };
 
 protected:
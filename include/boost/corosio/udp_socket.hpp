@@ -0,0 +1,628 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_UDP_SOCKET_HPP
+#define BOOST_COROSIO_UDP_SOCKET_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/io_deadline.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/io_buffer_param.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/concept/executor.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <span>
+#include <stop_token>
+#include <type_traits>
+
+namespace boost::corosio {
+
+/** An asynchronous UDP socket for coroutine I/O.
+
+    This class sends and receives IPv4 datagrams. Each call to
+    @ref send_to or @ref receive_from transfers one datagram;
+    @ref send_batch and @ref receive_batch transfer several in one
+    system call (`sendmmsg` and `recvmmsg` on Linux), which is what
+    keeps the per-packet cost low at high packet rates.
+
+    Large transfers can also use segmentation offload: with
+    @ref set_gso_segment the kernel splits each send into datagrams
+    of the given size, and with @ref set_gro it coalesces received
+    datagrams of one flow into a single buffer, whose segment size
+    @ref receive_batch reports.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Unsafe. A socket must not have concurrent
+    operations of the same direction. One receive and one send may
+    be in flight simultaneously.
+
+    @par Example
+    @code
+    io_context ioc;
+    udp_socket s(ioc);
+    s.bind(endpoint(9000));
+
+    char buf[1500];
+    endpoint from;
+    auto [ec, n] = co_await s.receive_from(
+        capy::mutable_buffer(buf, sizeof(buf)), from);
+    if (!ec)
+        (void)co_await s.send_to(capy::const_buffer(buf, n), from);
+    @endcode
+
+    @note Only the epoll backend provides datagram sockets so far.
+        On other contexts @ref open throws `std::logic_error`.
+*/
+class BOOST_COROSIO_DECL udp_socket : public io_object
+{
+public:
+    /** One datagram of a batch.
+
+        For @ref send_batch, `buffer` holds the datagram, which is not
+        modified, and `peer` is its destination. For
+        @ref receive_batch, `buffer` is the storage for the datagram
+        and the remaining members are filled in on completion.
+    */
+    struct message
+    {
+        /// The datagram bytes, or the storage to receive into.
+        capy::mutable_buffer buffer;
+
+        /// The destination of a send, or the source of a receive.
+        endpoint peer;
+
+        /// The number of bytes sent or received.
+        std::size_t size = 0;
+
+        /** The segment size of an offloaded datagram.
+
+            On send, a nonzero value asks the kernel to split this
+            datagram into segments of this size (UDP GSO), overriding
+            @ref set_gso_segment. On receive, a nonzero value means GRO
+            coalesced several datagrams of this size, the last one
+            possibly shorter, into `buffer`.
+        */
+        std::size_t segment_size = 0;
+
+        /// `true` if a received datagram did not fit in `buffer`.
+        bool truncated = false;
+    };
+
+    struct udp_socket_impl : io_object_impl
+    {
+        virtual bool send_to(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            io_buffer_param,
+            endpoint,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual bool receive_from(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            io_buffer_param,
+            endpoint*,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual bool send_batch(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            std::span<message>,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual bool receive_batch(
+            std::coroutine_handle<>,
+            capy::executor_ref,
+            std::span<message>,
+            std::stop_token,
+            system::error_code*,
+            std::size_t*) = 0;
+
+        virtual system::error_code bind(endpoint) noexcept = 0;
+
+        virtual native_handle_type native_handle() const noexcept = 0;
+
+        virtual endpoint local_endpoint() const noexcept = 0;
+
+        virtual void cancel() noexcept = 0;
+
+        // Socket options
+        virtual system::error_code set_receive_buffer_size(int size) noexcept = 0;
+        virtual int receive_buffer_size(system::error_code& ec) const noexcept = 0;
+
+        virtual system::error_code set_send_buffer_size(int size) noexcept = 0;
+        virtual int send_buffer_size(system::error_code& ec) const noexcept = 0;
+
+        /// Set the GSO segment size; unsupported by default.
+        virtual system::error_code set_gso_segment(std::size_t) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual std::size_t gso_segment(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return 0;
+        }
+
+        /// Enable or disable GRO; unsupported by default.
+        virtual system::error_code set_gro(bool) noexcept
+        {
+            return make_error_code(system::errc::operation_not_supported);
+        }
+
+        virtual bool gro(system::error_code& ec) const noexcept
+        {
+            ec = {};
+            return false;
+        }
+    };
+
+private:
+    template<class Buffers, bool IsSend>
+    struct datagram_awaitable
+    {
+        udp_socket& s_;
+        Buffers buffers_;
+        endpoint peer_;
+        endpoint* source_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t bytes_transferred_ = 0;
+
+        datagram_awaitable(
+            udp_socket& s,
+            Buffers buffers,
+            endpoint peer,
+            endpoint* source) noexcept
+            : s_(s)
+            , buffers_(std::move(buffers))
+            , peer_(peer)
+            , source_(source)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, bytes_transferred_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            bool done;
+            if constexpr (IsSend)
+                done = s_.get().send_to(h, ex, buffers_, peer_,
+                    token_, &ec_, &bytes_transferred_);
+            else
+                done = s_.get().receive_from(h, ex, buffers_, source_,
+                    token_, &ec_, &bytes_transferred_);
+            if (done)
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+    template<bool IsSend>
+    struct batch_awaitable
+    {
+        udp_socket& s_;
+        std::span<message> messages_;
+        std::stop_token token_;
+        mutable system::error_code ec_;
+        mutable std::size_t count_ = 0;
+
+        batch_awaitable(udp_socket& s, std::span<message> messages) noexcept
+            : s_(s)
+            , messages_(messages)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return token_.stop_requested();
+        }
+
+        capy::io_result<std::size_t> await_resume() const noexcept
+        {
+            if (token_.stop_requested())
+                return {make_error_code(system::errc::operation_canceled), 0};
+            return {ec_, count_};
+        }
+
+        auto await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token token) -> std::coroutine_handle<>
+        {
+            token_ = std::move(token);
+            bool done;
+            if constexpr (IsSend)
+                done = s_.get().send_batch(h, ex, messages_,
+                    token_, &ec_, &count_);
+            else
+                done = s_.get().receive_batch(h, ex, messages_,
+                    token_, &ec_, &count_);
+            if (done)
+                return h;
+            return std::noop_coroutine();
+        }
+    };
+
+public:
+    /** Destructor.
+
+        Closes the socket if open, cancelling any pending operations.
+    */
+    ~udp_socket();
+
+    /** Construct a socket from an execution context.
+
+        @param ctx The execution context that will own this socket.
+    */
+    explicit udp_socket(capy::execution_context& ctx);
+
+    /** Construct a socket from an executor.
+
+        The socket is associated with the executor's context.
+
+        @param ex The executor whose context will own the socket.
+    */
+    template<class Ex>
+        requires (!std::same_as<std::remove_cvref_t<Ex>, udp_socket>) &&
+                 capy::Executor<Ex>
+    explicit udp_socket(Ex const& ex)
+        : udp_socket(ex.context())
+    {
+    }
+
+    /** Move constructor.
+
+        Transfers ownership of the socket resources.
+
+        @param other The socket to move from.
+    */
+    udp_socket(udp_socket&& other) noexcept
+        : io_object(other.context())
+    {
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+
+    /** Move assignment operator.
+
+        Closes any existing socket and transfers ownership.
+        The source and destination must share the same execution context.
+
+        @param other The socket to move from.
+
+        @return Reference to this socket.
+
+        @throws std::logic_error if the sockets have different execution contexts.
+    */
+    udp_socket& operator=(udp_socket&& other)
+    {
+        if (this != &other)
+        {
+            if (ctx_ != other.ctx_)
+                detail::throw_logic_error(
+                    "cannot move udp_socket across execution contexts");
+            close();
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    udp_socket(udp_socket const&) = delete;
+    udp_socket& operator=(udp_socket const&) = delete;
+
+    /** Open the socket.
+
+        Creates an unbound IPv4 UDP socket and associates it with the
+        platform reactor. The kernel assigns a local port on the first
+        send; use @ref bind to choose it.
+
+        @throws std::logic_error if the context has no datagram support.
+        @throws std::system_error on failure.
+    */
+    void open();
+
+    /** Bind the socket to a local endpoint.
+
+        Opens the socket first if it is not open.
+
+        @param ep The local endpoint. Use `endpoint(port)` to receive
+            on all interfaces.
+
+        @throws std::logic_error if the context has no datagram support.
+        @throws std::system_error on failure.
+    */
+    void bind(endpoint ep);
+
+    /** Close the socket.
+
+        Releases socket resources. Any pending operations complete
+        with `errc::operation_canceled`.
+    */
+    void close();
+
+    /** Check if the socket is open.
+
+        @return `true` if the socket is open and ready for operations.
+    */
+    bool is_open() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /** Initiate an asynchronous send of one datagram.
+
+        @param buffers The buffer sequence holding the datagram.
+        @param destination The endpoint to send to.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`. On success the byte
+            count is the size of the datagram. Errors include:
+            - message_size: The datagram is too large to send.
+            - operation_canceled: Cancelled via stop_token or cancel().
+                Check `ec == cond::canceled` for portable comparison.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    template<class ConstBufferSequence>
+    auto send_to(
+        ConstBufferSequence const& buffers,
+        endpoint destination)
+    {
+        if (!impl_)
+            detail::throw_logic_error("send_to: socket not open");
+        return datagram_awaitable<ConstBufferSequence, true>(
+            *this, buffers, destination, nullptr);
+    }
+
+    /** Initiate an asynchronous receive of one datagram.
+
+        @param buffers The buffer sequence to receive into.
+        @param source Set to the sender's endpoint on completion. It
+            must remain valid until the operation completes.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, bytes_transferred}`. A datagram larger than
+            the buffers completes with `errc::message_size` and the
+            bytes that fit; the rest of it is discarded. An empty
+            datagram completes successfully with zero bytes.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    template<class MutableBufferSequence>
+    auto receive_from(
+        MutableBufferSequence const& buffers,
+        endpoint& source)
+    {
+        if (!impl_)
+            detail::throw_logic_error("receive_from: socket not open");
+        return datagram_awaitable<MutableBufferSequence, false>(
+            *this, buffers, endpoint{}, &source);
+    }
+
+    /** Initiate an asynchronous receive of one datagram with a deadline.
+
+        Like @ref receive_from, but the receive is cancelled if no
+        datagram arrives by `deadline`, and then completes with
+        `errc::timed_out`. The deadline uses a timer node kept by the
+        socket.
+
+        @param buffers The buffer sequence to receive into.
+        @param source Set to the sender's endpoint on completion.
+        @param deadline The time at which the receive is cancelled.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    template<class MutableBufferSequence>
+    auto receive_from(
+        MutableBufferSequence const& buffers,
+        endpoint& source,
+        std::chrono::steady_clock::time_point deadline)
+    {
+        if (!impl_)
+            detail::throw_logic_error("receive_from: socket not open");
+        return detail::deadline_awaitable<
+            datagram_awaitable<MutableBufferSequence, false>>(
+                get_deadline(read_slot), deadline,
+                *this, buffers, endpoint{}, &source);
+    }
+
+    /** Initiate an asynchronous send of several datagrams.
+
+        Sends the messages in order with as few system calls as the
+        platform allows, and completes once at least one was sent or
+        an error occurs. The `size` of each sent message is set.
+
+        @param messages The datagrams to send. The span and the
+            buffers must remain valid until the operation completes.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, count}`, where `count` is the number of
+            leading messages sent. Send the rest with another call.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto send_batch(std::span<message> messages)
+    {
+        if (!impl_)
+            detail::throw_logic_error("send_batch: socket not open");
+        return batch_awaitable<true>(*this, messages);
+    }
+
+    /** Initiate an asynchronous receive of several datagrams.
+
+        Waits for at least one datagram, then fills as many of the
+        messages as are already queued, with one system call where
+        the platform allows.
+
+        @param messages The storage for the datagrams. The span and
+            the buffers must remain valid until the operation
+            completes.
+
+        @return An awaitable that completes with a pair of
+            `{error_code, count}`, where `count` is the number of
+            leading messages filled in.
+
+        @throws std::logic_error if the socket is not open.
+    */
+    auto receive_batch(std::span<message> messages)
+    {
+        if (!impl_)
+            detail::throw_logic_error("receive_batch: socket not open");
+        return batch_awaitable<false>(*this, messages);
+    }
+
+    /** Cancel any pending asynchronous operations.
+
+        All outstanding operations complete with `errc::operation_canceled`.
+        Check `ec == cond::canceled` for portable comparison.
+    */
+    void cancel();
+
+    /** Get the native socket handle.
+
+        @return The native socket handle, or an invalid value (-1 on
+            POSIX) if the socket is not open.
+    */
+    native_handle_type native_handle() const noexcept;
+
+    /** Get the local endpoint of the socket.
+
+        @return The local endpoint, or a default endpoint (0.0.0.0:0)
+            if the socket is not open or not yet bound.
+    */
+    endpoint local_endpoint() const noexcept;
+
+    //--------------------------------------------------------------------------
+    //
+    // Socket Options
+    //
+    //--------------------------------------------------------------------------
+
+    /** Set the receive buffer size (SO_RCVBUF).
+
+        @param size The desired receive buffer size in bytes.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    void set_receive_buffer_size(int size);
+
+    /** Get the receive buffer size (SO_RCVBUF).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    int receive_buffer_size() const;
+
+    /** Set the send buffer size (SO_SNDBUF).
+
+        @param size The desired send buffer size in bytes.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    void set_send_buffer_size(int size);
+
+    /** Get the send buffer size (SO_SNDBUF).
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    int send_buffer_size() const;
+
+    /** Set the segment size for UDP generic segmentation offload.
+
+        With a nonzero size every send is split by the kernel, or by
+        the network card, into datagrams of `size` bytes, the last
+        one possibly shorter. A single call can then send up to 64
+        datagrams. Zero disables segmentation.
+
+        @param size The segment size in bytes, or zero.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error with `errc::operation_not_supported`
+            if the backend or the kernel has no UDP GSO.
+    */
+    void set_gso_segment(std::size_t size);
+
+    /** Get the segment size for UDP generic segmentation offload.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    std::size_t gso_segment() const;
+
+    /** Enable or disable UDP generic receive offload.
+
+        With GRO the kernel may deliver several datagrams of one flow
+        as a single buffer. @ref receive_batch reports the segment
+        size of such a buffer in @ref message::segment_size, so
+        receive with it when GRO is enabled.
+
+        @param enabled `true` to enable GRO.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error with `errc::operation_not_supported`
+            if the backend or the kernel has no UDP GRO.
+    */
+    void set_gro(bool enabled);
+
+    /** Return `true` if UDP generic receive offload is enabled.
+
+        @throws std::logic_error if the socket is not open.
+        @throws std::system_error on failure.
+    */
+    bool gro() const;
+
+private:
+    inline udp_socket_impl& get() const noexcept
+    {
+        return *static_cast<udp_socket_impl*>(impl_);
+    }
+};
+
+} // namespace boost::corosio
+
+#endif
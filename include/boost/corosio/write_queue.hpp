@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_WRITE_QUEUE_HPP
+#define BOOST_COROSIO_WRITE_QUEUE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/io_result.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+
+namespace boost::corosio {
+
+/** A queue of writes from many coroutines onto one stream.
+
+    A stream takes one write at a time. A write queue lets any
+    number of coroutines, on any threads, call @ref write at once:
+    each buffer joins the queue, and whichever writer finds no
+    write in progress becomes the one that performs them. It
+    gathers the buffers of every queued write into a single
+    @ref io_stream::write_some, so the writes pending at each
+    point cost one system call together rather than one each,
+    then hands each writer its own byte count as its buffer is
+    sent in full.
+
+    The bytes of one write are never interleaved with those of
+    another, and writes reach the stream in the order they were
+    queued.
+
+    When the queued bytes would exceed @ref limit, further writers
+    wait, in order, until enough of the queue has been sent. A
+    write larger than the limit is still accepted once the queue
+    is empty.
+
+    Individual writes cannot be cancelled. Cancelling or closing
+    the stream fails the write in progress, and with it every
+    write in the queue.
+
+    @par Thread Safety
+    Distinct objects: Safe.@n
+    Shared objects: Safe for @ref write and @ref queued.
+
+    @par Example
+    @code
+    corosio::write_queue wq(sock);
+
+    // From any number of coroutines
+    auto [ec, n] = co_await wq.write(
+        capy::const_buffer(frame.data(), frame.size()));
+    @endcode
+*/
+class BOOST_COROSIO_DECL write_queue
+{
+public:
+    /// The limit on queued bytes used when none is given.
+    static constexpr std::size_t default_limit = 1048576;
+
+    /// The most buffers gathered into one write.
+    static constexpr std::size_t max_gather = 64;
+
+    /** Construct a write queue over `s`.
+
+        @param s The stream to write to. It must outlive this
+            object, and this object must outlive every write
+            made through it.
+
+        @param limit The number of queued bytes past which
+            writers wait.
+    */
+    explicit
+    write_queue(
+        io_stream& s,
+        std::size_t limit = default_limit) noexcept;
+
+    write_queue(write_queue const&) = delete;
+    write_queue& operator=(write_queue const&) = delete;
+
+    /// Return the stream written to.
+    io_stream&
+    next_layer() const noexcept
+    {
+        return s_;
+    }
+
+    /// Return the number of queued bytes past which writers wait.
+    std::size_t
+    limit() const noexcept
+    {
+        return limit_;
+    }
+
+    /// Return the number of bytes queued and not yet sent.
+    std::size_t
+    queued() const;
+
+    /** Write all of a buffer, after the writes already queued.
+
+        @param buffer The bytes to write. They must stay valid
+            until the task completes.
+
+        @return A task that completes with the number of bytes
+            of `buffer` sent, which is all of them unless the
+            stream failed, in which case it fails with that
+            error.
+    */
+    capy::task<capy::io_result<std::size_t>>
+    write(capy::const_buffer buffer);
+
+private:
+    struct writer
+    {
+        writer* next = nullptr;
+        capy::const_buffer buf;
+        std::size_t sent = 0;
+        system::error_code ec;
+        bool done = false;
+        bool lead = false;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+    };
+
+    class join_awaitable;
+
+    capy::task<> send_queued(writer& lead);
+
+    io_stream& s_;
+    std::size_t limit_;
+
+    mutable std::mutex mutex_;
+    writer* head_ = nullptr;
+    writer* tail_ = nullptr;
+    writer* blocked_ = nullptr;
+    writer* blocked_tail_ = nullptr;
+    std::size_t queued_ = 0;
+    bool flushing_ = false;
+};
+
+} // namespace boost::corosio
+
+#endif
@@ -14,7 +14,13 @@
 #include "src/detail/iocp/sockets.hpp"
 #else
 // POSIX backends use the abstract acceptor_service interface
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/make_err.hpp"
 #include "src/detail/socket_service.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #include <boost/corosio/detail/except.hpp>
@@ -36,7 +42,7 @@ acceptor(
 
 void
 acceptor::
-listen(endpoint ep, int backlog)
+listen(endpoint ep, listen_options const& opts)
 {
     if (impl_)
         close();
@@ -46,17 +52,18 @@ listen(endpoint ep, int backlog)
     auto& wrapper = svc.create_acceptor_impl();
     impl_ = &wrapper;
     system::error_code ec = svc.open_acceptor(
-        *wrapper.get_internal(), ep, backlog);
+        *wrapper.get_internal(), ep, opts);
 #else
     // POSIX backends use abstract acceptor_service for runtime polymorphism.
-    // The concrete service (epoll_sockets or select_sockets) must be installed
-    // by the context constructor before any acceptor operations.
-    auto* svc = ctx_->find_service<detail::acceptor_service>();
+    // The concrete service is installed by the context constructor, or
+    // made here on first use if the backend defers it.
+    auto* svc = detail::find_deferred_service<detail::acceptor_service>(
+        *ctx_, detail::deferred_service::acceptor);
     if (!svc)
         detail::throw_logic_error("acceptor::listen: no acceptor service installed");
     auto& wrapper = svc->create_acceptor_impl();
     impl_ = &wrapper;
-    system::error_code ec = svc->open_acceptor(wrapper, ep, backlog);
+    system::error_code ec = svc->open_acceptor(wrapper, ep, opts);
 #endif
     if (ec)
     {
@@ -66,6 +73,86 @@ listen(endpoint ep, int backlog)
     }
 }
 
+void
+acceptor::
+assign(native_handle_type h)
+{
+    if (impl_)
+        close();
+
+#if BOOST_COROSIO_HAS_IOCP
+    (void)h;
+    detail::throw_system_error(
+        make_error_code(system::errc::operation_not_supported),
+        "acceptor::assign");
+#else
+    auto* svc = detail::find_deferred_service<detail::acceptor_service>(
+        *ctx_, detail::deferred_service::acceptor);
+    if (!svc)
+        detail::throw_logic_error("acceptor::assign: no acceptor service installed");
+    auto& wrapper = svc->create_acceptor_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->assign_acceptor(wrapper, h);
+    if (ec)
+    {
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "acceptor::assign");
+    }
+#endif
+}
+
+void
+acceptor::
+share(acceptor const& other)
+{
+    if (!other.is_open())
+        detail::throw_logic_error("acceptor::share: acceptor not listening");
+    if (impl_)
+        close();
+
+#if BOOST_COROSIO_HAS_IOCP
+    detail::throw_system_error(
+        make_error_code(system::errc::operation_not_supported),
+        "acceptor::share");
+#else
+    auto* svc = detail::find_deferred_service<detail::acceptor_service>(
+        *ctx_, detail::deferred_service::acceptor);
+    if (!svc)
+        detail::throw_logic_error("acceptor::share: no acceptor service installed");
+
+    int fd = ::fcntl(other.native_handle(), F_DUPFD_CLOEXEC, 0);
+    if (fd < 0)
+        detail::throw_system_error(detail::make_err(errno), "acceptor::share");
+
+    auto& wrapper = svc->create_acceptor_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->share_acceptor(wrapper, fd);
+    if (ec)
+    {
+        ::close(fd);
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "acceptor::share");
+    }
+#endif
+}
+
+native_handle_type
+acceptor::
+native_handle() const noexcept
+{
+    if (!impl_)
+    {
+#if BOOST_COROSIO_HAS_IOCP
+        return static_cast<native_handle_type>(~0ull);  // INVALID_SOCKET
+#else
+        return -1;
+#endif
+    }
+    return get().native_handle();
+}
+
 void
 acceptor::
 close()
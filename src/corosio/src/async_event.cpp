@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/async_event.hpp>
+
+/*
+    Async Event
+    ===========
+
+    state_ is is_set_state, or else the top of a LIFO stack of
+    waiters, null when there are none. A waiter pushes itself with
+    a CAS unless it sees the event set. set() exchanges the whole
+    stack for is_set_state, reverses it into arrival order, and
+    posts each waiter, reading its links before the post.
+*/
+
+namespace boost::corosio {
+
+bool
+async_event::
+enqueue(waiter& w) noexcept
+{
+    std::uintptr_t old = state_.load(std::memory_order_acquire);
+    do
+    {
+        if (old == is_set_state)
+            return false;
+        w.next = reinterpret_cast<waiter*>(old);
+    }
+    while (!state_.compare_exchange_weak(
+        old, reinterpret_cast<std::uintptr_t>(&w),
+        std::memory_order_release, std::memory_order_acquire));
+    return true;
+}
+
+void
+async_event::
+set() noexcept
+{
+    std::uintptr_t old = state_.exchange(
+        is_set_state, std::memory_order_acq_rel);
+    if (old == is_set_state)
+        return;
+
+    waiter* head = nullptr;
+    auto* p = reinterpret_cast<waiter*>(old);
+    while (p)
+    {
+        waiter* next = p->next;
+        p->next = head;
+        head = p;
+        p = next;
+    }
+
+    while (head)
+    {
+        waiter* next = head->next;
+        head->ex.post(head->h);
+        head = next;
+    }
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/async_mutex.hpp>
+
+/*
+    Async Mutex
+    ===========
+
+    state_ is one of:
+
+      unlocked   nobody holds the mutex
+      0          held, with no waiter arrived since the holder
+                 last emptied state_
+      waiter*    held, with a LIFO stack of waiters that arrived
+                 since then
+
+    A locker CASes unlocked to 0, or pushes its waiter onto the
+    stack. Only the holder ever takes from state_: on unlock, with
+    its own queue empty, it CASes 0 back to unlocked, or if that
+    fails exchanges the stack for 0 and reverses it into waiters_,
+    which is then FIFO. The first waiter is popped and posted, and
+    it now holds the mutex, with the rest of the queue.
+*/
+
+namespace boost::corosio {
+
+bool
+async_mutex::
+enqueue(waiter& w) noexcept
+{
+    std::uintptr_t old = state_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if (old == unlocked)
+        {
+            // Unlocked meanwhile; take it and carry on
+            if (state_.compare_exchange_weak(
+                    old, 0, std::memory_order_acquire,
+                    std::memory_order_relaxed))
+                return false;
+        }
+        else
+        {
+            w.next = reinterpret_cast<waiter*>(old);
+            if (state_.compare_exchange_weak(
+                    old, reinterpret_cast<std::uintptr_t>(&w),
+                    std::memory_order_release,
+                    std::memory_order_relaxed))
+                return true;
+        }
+    }
+}
+
+void
+async_mutex::
+unlock() noexcept
+{
+    waiter* head = waiters_;
+    if (!head)
+    {
+        std::uintptr_t old = 0;
+        if (state_.compare_exchange_strong(
+                old, unlocked, std::memory_order_release,
+                std::memory_order_relaxed))
+            return;
+
+        // Waiters arrived; reverse them into arrival order
+        old = state_.exchange(0, std::memory_order_acquire);
+        auto* p = reinterpret_cast<waiter*>(old);
+        while (p)
+        {
+            waiter* next = p->next;
+            p->next = head;
+            head = p;
+            p = next;
+        }
+    }
+
+    // The queue passes to the new holder with the mutex
+    waiters_ = head->next;
+    head->ex.post(head->h);
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/async_semaphore.hpp>
+
+/*
+    Async Semaphore
+    ===============
+
+    count_ holds the available units and is taken with a CAS that
+    never lets it go below zero. Waiters are queued FIFO under
+    mutex_ and counted in waiting_, and try_acquire() does not take
+    a unit while waiting_ is non-zero, so that released units reach
+    the queue rather than a late arrival.
+
+    A waiter counts itself, fences, queues itself and then hands
+    units out from the head of the queue, possibly to itself. A
+    release adds its units, fences, and hands them out only if it
+    sees a waiter. One of the two fences orders the other side's
+    write first, so a unit released as a waiter queues is always
+    handed out by one of them.
+
+    Waiters handed a unit are unlinked under the lock and posted
+    after it is released, each reading its next link first.
+*/
+
+namespace boost::corosio {
+
+bool
+async_semaphore::
+take() noexcept
+{
+    std::size_t n = count_.load(std::memory_order_relaxed);
+    while (n > 0)
+    {
+        if (count_.compare_exchange_weak(
+                n, n - 1, std::memory_order_acquire,
+                std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+async_semaphore::waiter*
+async_semaphore::
+hand_out() noexcept
+{
+    waiter* list = nullptr;
+    waiter* last = nullptr;
+    while (head_ && take())
+    {
+        waiter* w = head_;
+        head_ = w->next;
+        if (!head_)
+            tail_ = nullptr;
+        w->next = nullptr;
+        w->done = true;
+        waiting_.fetch_sub(1, std::memory_order_relaxed);
+        if (last)
+            last->next = w;
+        else
+            list = w;
+        last = w;
+    }
+    return list;
+}
+
+void
+async_semaphore::
+wake(waiter* list, waiter const* self) noexcept
+{
+    while (list)
+    {
+        waiter* next = list->next;
+        if (list != self)
+            list->ex.post(list->h);
+        list = next;
+    }
+}
+
+bool
+async_semaphore::
+try_acquire() noexcept
+{
+    if (waiting_.load(std::memory_order_relaxed) != 0)
+        return false;
+    return take();
+}
+
+bool
+async_semaphore::
+enqueue(waiter& w)
+{
+    waiter* list;
+    bool suspend;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiting_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tail_)
+            tail_->next = &w;
+        else
+            head_ = &w;
+        tail_ = &w;
+        list = hand_out();
+
+        // A releaser may resume w as soon as the lock is released
+        suspend = !w.done;
+    }
+    wake(list, &w);
+    return suspend;
+}
+
+void
+async_semaphore::
+release(std::size_t n)
+{
+    count_.fetch_add(n, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed) == 0)
+        return;
+
+    waiter* list;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        list = hand_out();
+    }
+    wake(list, nullptr);
+}
+
+} // namespace boost::corosio
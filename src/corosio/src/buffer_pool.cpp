@@ -0,0 +1,286 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/buffer_pool.hpp>
+
+#include "src/detail/huge_page_arena.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+/*
+    Buffer Pool
+    ===========
+
+    Free buffers are threaded on singly linked lists through their
+    first bytes. Each thread keeps one list per size class, bounded to
+    thread_cache_bytes per class, and the pool keeps one more set
+    under its mutex, bounded to max_cached_bytes in all. A lease
+    records the size class in its id, so that a lease shrunk after a
+    read still returns its buffer to the right list.
+
+    The thread caches hold plain blocks from the global allocator and
+    belong to no pool: a buffer may be taken from one pool's lease
+    and handed out again by another's on the same thread. A cache
+    frees its blocks when its thread exits. Buffers above max_size
+    have the id `unpooled` and go straight back to the allocator.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+constexpr std::size_t class_count = 8;
+
+static_assert((buffer_pool::min_size << (class_count - 1)) ==
+    buffer_pool::max_size);
+
+constexpr std::uint32_t unpooled = 0xffffffff;
+
+// Per class, so that a thread caches many small buffers or a few
+// large ones
+constexpr std::size_t thread_cache_bytes = 131072;
+
+struct block
+{
+    block* next;
+};
+
+constexpr std::size_t
+class_size(std::size_t cls) noexcept
+{
+    return buffer_pool::min_size << cls;
+}
+
+std::size_t
+class_of(std::size_t size) noexcept
+{
+    std::size_t cls = 0;
+    while (class_size(cls) < size)
+        ++cls;
+    return cls;
+}
+
+struct thread_cache
+{
+    block* head[class_count] = {};
+    std::size_t count[class_count] = {};
+    bool alive = true;
+
+    ~thread_cache()
+    {
+        trim();
+        // Buffers returned later on this thread bypass the cache
+        alive = false;
+    }
+
+    void trim() noexcept
+    {
+        for (std::size_t cls = 0; cls < class_count; ++cls)
+        {
+            while (head[cls])
+            {
+                auto* b = head[cls];
+                head[cls] = b->next;
+                detail::pool_deallocate(b, class_size(cls));
+            }
+            count[cls] = 0;
+        }
+    }
+
+    void* pop(std::size_t cls) noexcept
+    {
+        auto* b = head[cls];
+        if (!b)
+            return nullptr;
+        head[cls] = b->next;
+        --count[cls];
+        return b;
+    }
+
+    bool push(void* p, std::size_t cls) noexcept
+    {
+        if (!alive || count[cls] >= thread_cache_bytes / class_size(cls))
+            return false;
+        head[cls] = ::new(p) block{head[cls]};
+        ++count[cls];
+        return true;
+    }
+};
+
+thread_cache&
+local_cache() noexcept
+{
+    thread_local thread_cache c;
+    return c;
+}
+
+} // namespace
+
+struct buffer_pool::state
+{
+    std::mutex mutex;
+    block* head[class_count] = {};
+    std::size_t cached_bytes = 0;
+    std::atomic<std::size_t> max_cached_bytes{4 * 1024 * 1024};
+
+    std::atomic<std::size_t> leased_bytes{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+
+    void trim() noexcept
+    {
+        std::lock_guard lock(mutex);
+        for (std::size_t cls = 0; cls < class_count; ++cls)
+        {
+            while (head[cls])
+            {
+                auto* b = head[cls];
+                head[cls] = b->next;
+                detail::pool_deallocate(b, class_size(cls));
+            }
+        }
+        cached_bytes = 0;
+    }
+};
+
+buffer_pool::
+buffer_pool(capy::execution_context&)
+    : state_(std::make_unique<state>())
+{
+}
+
+buffer_pool::
+~buffer_pool()
+{
+    state_->trim();
+}
+
+void
+buffer_pool::
+shutdown()
+{
+    state_->trim();
+}
+
+buffer_lease
+buffer_pool::
+acquire(std::size_t size)
+{
+    auto& st = *state_;
+    if (size > max_size)
+    {
+        st.misses.fetch_add(1, std::memory_order_relaxed);
+        return buffer_lease(
+            ::operator new(size), size, &release, this, unpooled);
+    }
+
+    std::size_t const cls = class_of(size);
+    std::size_t const n = class_size(cls);
+    void* p = local_cache().pop(cls);
+    if (!p)
+    {
+        std::lock_guard lock(st.mutex);
+        if (auto* b = st.head[cls])
+        {
+            st.head[cls] = b->next;
+            st.cached_bytes -= n;
+            p = b;
+        }
+    }
+
+    if (p)
+    {
+        st.hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        p = detail::pool_allocate(n);
+        st.misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    st.leased_bytes.fetch_add(n, std::memory_order_relaxed);
+    return buffer_lease(p, n, &release, this,
+        static_cast<std::uint32_t>(cls));
+}
+
+void
+buffer_pool::
+release(void* owner, void* data, std::uint32_t id) noexcept
+{
+    if (id == unpooled)
+    {
+        ::operator delete(data);
+        return;
+    }
+
+    auto& st = *static_cast<buffer_pool*>(owner)->state_;
+    std::size_t const n = class_size(id);
+    st.leased_bytes.fetch_sub(n, std::memory_order_relaxed);
+    if (local_cache().push(data, id))
+        return;
+
+    {
+        std::lock_guard lock(st.mutex);
+        if (st.cached_bytes + n <=
+            st.max_cached_bytes.load(std::memory_order_relaxed))
+        {
+            st.head[id] = ::new(data) block{st.head[id]};
+            st.cached_bytes += n;
+            return;
+        }
+    }
+    detail::pool_deallocate(data, n);
+}
+
+void
+buffer_pool::
+set_max_cached_bytes(std::size_t bytes) noexcept
+{
+    state_->max_cached_bytes.store(bytes, std::memory_order_relaxed);
+}
+
+std::size_t
+buffer_pool::
+max_cached_bytes() const noexcept
+{
+    return state_->max_cached_bytes.load(std::memory_order_relaxed);
+}
+
+void
+buffer_pool::
+trim() noexcept
+{
+    local_cache().trim();
+    state_->trim();
+}
+
+buffer_pool::statistics
+buffer_pool::
+stats() const noexcept
+{
+    auto& st = *state_;
+    statistics s;
+    s.leased_bytes = st.leased_bytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard lock(st.mutex);
+        s.cached_bytes = st.cached_bytes;
+    }
+    s.hits = st.hits.load(std::memory_order_relaxed);
+    s.misses = st.misses.load(std::memory_order_relaxed);
+    return s;
+}
+
+buffer_pool&
+get_buffer_pool(capy::execution_context& ctx)
+{
+    return ctx.use_service<buffer_pool>();
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/buffered_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*
+    Mirrored Ring
+    =============
+
+    On Linux the ring is a memfd of cap_ bytes mapped twice, back to
+    back, into a reservation of 2 * cap_ bytes. The readable bytes
+    start at head_ < cap_ and the free space follows them, both
+    ending before 2 * cap_, so each is one contiguous range whatever
+    the wrap. When head_ passes cap_ it is moved back by cap_,
+    which names the same bytes.
+
+    Where memfd_create or the mappings fail, the ring is a plain
+    buffer: head_ only grows until the ring empties, and prepare
+    moves the readable bytes to the front when the free space at
+    the end is too small.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+
+// Map a ring of `cap` bytes twice, or return nullptr
+char*
+map_mirrored(std::size_t& cap) noexcept
+{
+    long const page = ::sysconf(_SC_PAGESIZE);
+    if (page <= 0)
+        return nullptr;
+    std::size_t const p = static_cast<std::size_t>(page);
+    std::size_t const n = (cap + p - 1) / p * p;
+
+    int fd = ::memfd_create("corosio-ring", MFD_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    if (::ftruncate(fd, static_cast<off_t>(n)) != 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // Reserve both halves, then map the file over each
+    void* base = ::mmap(nullptr, 2 * n, PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    char* b = static_cast<char*>(base);
+    bool ok =
+        ::mmap(b, n, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+        ::mmap(b + n, n, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    ::close(fd);
+    if (!ok)
+    {
+        ::munmap(base, 2 * n);
+        return nullptr;
+    }
+    cap = n;
+    return b;
+}
+
+void
+unmap_mirrored(char* base, std::size_t cap) noexcept
+{
+    ::munmap(base, 2 * cap);
+}
+
+#else
+
+char*
+map_mirrored(std::size_t&) noexcept
+{
+    return nullptr;
+}
+
+void
+unmap_mirrored(char*, std::size_t) noexcept
+{
+}
+
+#endif
+
+} // namespace
+
+buffered_stream::
+buffered_stream(
+    io_stream& s,
+    std::size_t capacity)
+    : s_(s)
+    , cap_((std::max)(capacity, std::size_t(1)))
+{
+    base_ = map_mirrored(cap_);
+    if (base_)
+        mirrored_ = true;
+    else
+        base_ = new char[cap_];
+}
+
+buffered_stream::
+~buffered_stream()
+{
+    if (mirrored_)
+        unmap_mirrored(base_, cap_);
+    else
+        delete[] base_;
+}
+
+void
+buffered_stream::
+consume(std::size_t n) noexcept
+{
+    n = (std::min)(n, size_);
+    head_ += n;
+    size_ -= n;
+    if (size_ == 0)
+        head_ = 0;
+    else if (head_ >= cap_)
+        head_ -= cap_;
+}
+
+capy::mutable_buffer
+buffered_stream::
+prepare(std::size_t n)
+{
+    if (n > cap_ - size_)
+        throw std::length_error("buffered_stream::prepare: not enough space");
+    if (!mirrored_ && cap_ - head_ - size_ < n)
+    {
+        std::memmove(base_, base_ + head_, size_);
+        head_ = 0;
+    }
+    return capy::mutable_buffer(base_ + head_ + size_, n);
+}
+
+void
+buffered_stream::
+commit(std::size_t n) noexcept
+{
+    size_ += (std::min)(n, cap_ - size_);
+}
+
+capy::task<capy::io_result<std::size_t>>
+buffered_stream::
+fill()
+{
+    if (size_ == cap_)
+        co_return {make_error_code(system::errc::no_buffer_space), 0};
+
+    auto [ec, n] = co_await s_.read_some(prepare(cap_ - size_));
+    commit(n);
+    co_return {ec, n};
+}
+
+capy::task<capy::io_result<std::size_t>>
+buffered_stream::
+read_some(capy::mutable_buffer buffer)
+{
+    if (buffer.size() == 0)
+        co_return {{}, 0};
+
+    if (size_ == 0)
+    {
+        // Nothing gained by copying a read this large
+        if (buffer.size() >= cap_)
+            co_return co_await s_.read_some(buffer);
+
+        auto [ec, n] = co_await fill();
+        if (ec)
+            co_return {ec, 0};
+    }
+
+    std::size_t n = (std::min)(buffer.size(), size_);
+    std::memcpy(buffer.data(), base_ + head_, n);
+    consume(n);
+    co_return {{}, n};
+}
+
+} // namespace boost::corosio
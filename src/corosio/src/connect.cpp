@@ -0,0 +1,322 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/connect.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "src/detail/resume_coro.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/*
+    Happy Eyeballs
+    ==============
+
+    The state of one connect(socket&, resolver_results) is shared by
+    the coroutines it runs: one per connection attempt, and one that
+    starts the next attempt each time attempt_delay passes without an
+    answer. An attempt that fails starts the next one at once. All
+    decisions are made under the state's mutex; coroutines are
+    launched only after it is released, since run_async may start
+    them inline.
+
+    The coroutines run with the token of the state's stop_source. The
+    first attempt to connect sets `done`, requests a stop to cancel
+    the others and the delay timer, and moves its socket into the
+    caller's. When the last attempt fails with none left to start,
+    the caller gets its error. A stop request from the caller
+    prevents further attempts and cancels those in flight, which
+    then fail with operation_canceled.
+
+    Attempt sockets live in a deque, whose elements keep their address
+    as attempts are added. The state is freed, closing the losers,
+    when the last coroutine holding it finishes.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+// RFC 8305 section 4: alternate the address families, starting
+// with that of the first endpoint
+std::vector<endpoint>
+interleave(resolver_results const& results)
+{
+    std::vector<endpoint> first;
+    std::vector<endpoint> second;
+    bool const v6_first = results.begin()->get_endpoint().is_v6();
+    for (auto const& entry : results)
+    {
+        endpoint ep = entry.get_endpoint();
+        (ep.is_v6() == v6_first ? first : second).push_back(ep);
+    }
+
+    std::vector<endpoint> out;
+    out.reserve(results.size());
+    for (std::size_t i = 0; i < (std::max)(first.size(), second.size()); ++i)
+    {
+        if (i < first.size())
+            out.push_back(first[i]);
+        if (i < second.size())
+            out.push_back(second[i]);
+    }
+    return out;
+}
+
+struct happy_eyeballs
+    : std::enable_shared_from_this<happy_eyeballs>
+{
+    struct canceller
+    {
+        happy_eyeballs* self;
+        void operator()() const noexcept { self->stop(); }
+    };
+
+    // An attempt ready to launch
+    struct attempt
+    {
+        socket* sock = nullptr;
+        endpoint ep;
+    };
+
+    socket& s_;
+    std::vector<endpoint> eps_;
+    std::chrono::milliseconds delay_;
+    capy::executor_ref ex_;
+    std::coroutine_handle<> h_;
+    system::error_code* ec_out_;
+    endpoint* ep_out_;
+
+    std::mutex mutex_;
+    std::deque<socket> socks_;
+    timer timer_;
+    std::stop_source source_;
+    std::size_t next_ = 0;
+    std::size_t pending_ = 0;
+    bool done_ = false;
+    system::error_code last_ec_;
+    timer::time_point last_start_;
+    std::optional<std::stop_callback<canceller>> stop_cb_;
+
+    happy_eyeballs(
+        socket& s,
+        std::vector<endpoint> eps,
+        std::chrono::milliseconds delay,
+        capy::executor_ref ex,
+        std::coroutine_handle<> h,
+        system::error_code* ec,
+        endpoint* ep)
+        : s_(s)
+        , eps_(std::move(eps))
+        , delay_(delay)
+        , ex_(ex)
+        , h_(h)
+        , ec_out_(ec)
+        , ep_out_(ep)
+        , timer_(s.context())
+    {
+    }
+
+    // Opens a socket for the next endpoint, skipping those whose
+    // socket cannot be opened. Returns an empty attempt if none is
+    // left.
+    attempt open_next_locked()
+    {
+        while (next_ < eps_.size())
+        {
+            endpoint ep = eps_[next_++];
+            auto& sock = socks_.emplace_back(s_.context());
+            try
+            {
+                sock.open(ep.is_v6() ? ip_family::v6 : ip_family::v4);
+            }
+            catch (system::system_error const& e)
+            {
+                last_ec_ = e.code();
+                continue;
+            }
+            ++pending_;
+            last_start_ = timer::clock_type::now();
+            return {&sock, ep};
+        }
+        return {};
+    }
+
+    // Ends the operation when nothing is in flight or left to start
+    bool finish_if_idle_locked()
+    {
+        if (done_ || pending_ != 0)
+            return false;
+        done_ = true;
+        *ec_out_ = last_ec_;
+        return true;
+    }
+
+    void launch(attempt a);
+    void complete();
+
+    void on_attempt(socket& sock, endpoint ep, system::error_code ec)
+    {
+        attempt a;
+        bool finish = false;
+        {
+            std::lock_guard lock(mutex_);
+            --pending_;
+            if (done_)
+                return;
+            if (!ec)
+            {
+                done_ = true;
+                s_ = std::move(sock);
+                *ec_out_ = {};
+                *ep_out_ = ep;
+                finish = true;
+            }
+            else
+            {
+                last_ec_ = ec;
+                a = open_next_locked();
+                if (!a.sock)
+                    finish = finish_if_idle_locked();
+            }
+        }
+        if (a.sock)
+            launch(a);
+        if (finish)
+        {
+            // Cancel the other attempts and the delay timer
+            source_.request_stop();
+            complete();
+        }
+    }
+
+    void on_delay()
+    {
+        attempt a;
+        {
+            std::lock_guard lock(mutex_);
+            if (done_)
+                return;
+            if (timer::clock_type::now() - last_start_ >= delay_)
+                a = open_next_locked();
+        }
+        if (a.sock)
+            launch(a);
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (done_)
+                return;
+            next_ = eps_.size();
+            last_ec_ = make_error_code(system::errc::operation_canceled);
+        }
+        source_.request_stop();
+    }
+};
+
+capy::task<>
+run_attempt(
+    std::shared_ptr<happy_eyeballs> self,
+    socket& sock,
+    endpoint ep)
+{
+    auto [ec] = co_await sock.connect(ep);
+    self->on_attempt(sock, ep, ec);
+}
+
+capy::task<>
+run_delays(std::shared_ptr<happy_eyeballs> self)
+{
+    for (;;)
+    {
+        {
+            std::lock_guard lock(self->mutex_);
+            if (self->done_ || self->next_ >= self->eps_.size())
+                break;
+            self->timer_.expires_at(self->last_start_ + self->delay_);
+        }
+        (void)co_await self->timer_.wait();
+        self->on_delay();
+    }
+}
+
+void
+happy_eyeballs::
+launch(attempt a)
+{
+    capy::run_async(ex_, source_.get_token())(
+        run_attempt(shared_from_this(), *a.sock, a.ep));
+}
+
+void
+happy_eyeballs::
+complete()
+{
+    // Called once, by the coroutine that set done_; the stop
+    // callback may no longer run after this
+    stop_cb_.reset();
+    resume_coro(ex_, h_);
+}
+
+} // namespace
+
+bool
+connect_range(
+    socket& s,
+    resolver_results const& results,
+    std::chrono::milliseconds attempt_delay,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    endpoint* ep)
+{
+    if (results.empty())
+    {
+        *ec = make_error_code(system::errc::invalid_argument);
+        return true;
+    }
+
+    auto self = std::make_shared<happy_eyeballs>(
+        s, interleave(results), attempt_delay, ex, h, ec, ep);
+
+    // Runs at once if a stop was already requested
+    self->stop_cb_.emplace(token, happy_eyeballs::canceller{self.get()});
+
+    happy_eyeballs::attempt a;
+    {
+        std::lock_guard lock(self->mutex_);
+        a = self->open_next_locked();
+        if (!a.sock)
+        {
+            // Stopped, or no socket could be opened
+            self->done_ = true;
+            *ec = self->last_ec_;
+            return true;
+        }
+    }
+
+    self->launch(a);
+    if (self->eps_.size() > 1)
+        capy::run_async(ex, self->source_.get_token())(run_delays(self));
+    return false;
+}
+
+} // namespace boost::corosio::detail
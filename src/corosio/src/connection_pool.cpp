@@ -0,0 +1,548 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/connection_pool.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <coroutine>
+#include <stop_token>
+#include <vector>
+
+/*
+    Connection Pool
+    ===============
+
+    The pool's state is shared with the coroutines it launches and
+    with the connections it hands out, so that they may outlive the
+    pool object itself; destroying the pool only closes it. All of
+    it is used from the context's one thread, without locks.
+
+    Each endpoint has a host record, found by a linear search: a
+    client talks to tens of upstreams, not thousands. A host counts
+    its open connections, keeps its idle ones as a stack so that
+    the warmest is reused first, and queues the checkouts waiting
+    for a place under max_per_host.
+
+    Health Checks
+    -------------
+    An idle connection is a node watched by a coroutine waiting for
+    it to become readable. Nothing should arrive on an idle
+    connection, so the wait ending for any reason other than a
+    cancellation means the peer closed it or is out of step with
+    it, and the watcher drops the node.
+
+    A checkout taking a watched node cannot use the socket while the
+    wait is pending on it, so it marks the node taken, cancels the
+    wait and suspends until the watcher has finished. The watcher
+    then tells it whether the wait was cancelled, and so whether the
+    connection is still healthy, instead of dropping the node.
+
+    Idle Timeout
+    ------------
+    One reaper coroutine runs while there are idle connections. It
+    sleeps until the earliest expiry, then cancels the watch of
+    each expired node, which makes its watcher drop it.
+*/
+
+namespace boost::corosio {
+
+struct connection_pool::host
+{
+    // A checkout waiting for a place, or for a watcher to finish
+    struct waiter
+    {
+        waiter* next = nullptr;
+        std::coroutine_handle<> h;
+        capy::executor_ref ex;
+    };
+
+    // An idle connection
+    struct node
+    {
+        socket sock;
+        timer::time_point expiry;
+        bool watched = false;
+        bool expiring = false;
+        bool taken = false;
+        bool dead = false;
+        waiter taker;
+
+        explicit node(socket&& s) noexcept
+            : sock(std::move(s))
+        {
+        }
+    };
+
+    endpoint ep;
+    std::size_t open = 0;
+    std::vector<std::unique_ptr<node>> idle;
+    waiter* head = nullptr;
+    waiter* tail = nullptr;
+
+    explicit host(endpoint e) noexcept
+        : ep(e)
+    {
+    }
+
+    void push(waiter& w) noexcept
+    {
+        if (tail)
+            tail->next = &w;
+        else
+            head = &w;
+        tail = &w;
+    }
+
+    waiter* pop() noexcept
+    {
+        waiter* w = head;
+        if (w)
+        {
+            head = w->next;
+            if (!head)
+                tail = nullptr;
+        }
+        return w;
+    }
+};
+
+struct connection_pool::state
+    : std::enable_shared_from_this<state>
+{
+    using node = host::node;
+    using waiter = host::waiter;
+
+    basic_io_context& ctx_;
+    options opts_;
+    timer timer_;
+    std::vector<std::unique_ptr<host>> hosts_;
+    std::size_t idle_ = 0;
+    bool reaping_ = false;
+    bool closed_ = false;
+
+    state(basic_io_context& ctx, options opts)
+        : ctx_(ctx)
+        , opts_(opts)
+        , timer_(ctx)
+    {
+    }
+
+    host& find(endpoint const& ep)
+    {
+        for (auto& h : hosts_)
+            if (h->ep == ep)
+                return *h;
+        return *hosts_.emplace_back(std::make_unique<host>(ep));
+    }
+
+    // Let the next waiting checkout try again
+    void wake_one(host& h) noexcept
+    {
+        if (waiter* w = h.pop())
+            w->ex.post(w->h);
+    }
+
+    // One connection to h fewer
+    void release(host& h) noexcept
+    {
+        --h.open;
+        wake_one(h);
+    }
+
+    // Close an idle connection that is no longer watched
+    void drop(host& h, node* n) noexcept
+    {
+        auto it = std::find_if(h.idle.begin(), h.idle.end(),
+            [n](auto const& p) { return p.get() == n; });
+        if (it == h.idle.end())
+            return;
+        h.idle.erase(it);
+        --idle_;
+        release(h);
+    }
+
+    void expire(host& h, node* n) noexcept
+    {
+        if (!n->watched)
+        {
+            drop(h, n);
+            return;
+        }
+        if (!n->expiring)
+        {
+            n->expiring = true;
+            n->sock.cancel();
+        }
+    }
+
+    // Suspends until a watcher finishes with a taken node
+    struct take_awaitable
+    {
+        node& n_;
+
+        bool await_ready() const noexcept
+        {
+            return !n_.watched;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        bool await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token) noexcept
+        {
+            n_.taker.h = h;
+            n_.taker.ex = ex;
+            return true;
+        }
+    };
+
+    // Suspends until a connection to the host is checked in or closed
+    struct place_awaitable
+    {
+        host& h_;
+        waiter w_;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        bool await_suspend(
+            std::coroutine_handle<> h,
+            capy::executor_ref ex,
+            std::stop_token) noexcept
+        {
+            w_.h = h;
+            w_.ex = ex;
+            h_.push(w_);
+            return true;
+        }
+    };
+
+    void add_idle(host& h, socket&& s);
+
+    static capy::task<> watch(
+        std::shared_ptr<state> st, host& h, node* n);
+    static capy::task<> reap(std::shared_ptr<state> st);
+};
+
+capy::task<>
+connection_pool::state::
+watch(
+    std::shared_ptr<state> st,
+    host& h,
+    node* n)
+{
+    auto [ec] = co_await n->sock.wait(socket::wait_type::read);
+    n->watched = false;
+
+    if (n->taken)
+    {
+        n->dead = ec != capy::cond::canceled &&
+            ec != system::errc::operation_not_supported;
+        if (n->taker.h)
+            n->taker.ex.post(n->taker.h);
+        co_return;
+    }
+
+    // Kept, unchecked, where the backend cannot wait
+    if (ec == system::errc::operation_not_supported)
+        co_return;
+
+    // Readable, failed, expired or closed
+    st->drop(h, n);
+}
+
+capy::task<>
+connection_pool::state::
+reap(std::shared_ptr<state> st)
+{
+    while (!st->closed_)
+    {
+        std::optional<timer::time_point> next;
+        for (auto& h : st->hosts_)
+            for (auto& n : h->idle)
+                if (!n->expiring && (!next || n->expiry < *next))
+                    next = n->expiry;
+        if (!next)
+            break;
+
+        st->timer_.expires_at(*next);
+        (void)co_await st->timer_.wait();
+
+        auto now = timer::clock_type::now();
+        for (auto& h : st->hosts_)
+        {
+            std::vector<node*> expired;
+            for (auto& n : h->idle)
+                if (n->expiry <= now)
+                    expired.push_back(n.get());
+            for (auto* n : expired)
+                st->expire(*h, n);
+        }
+    }
+    st->reaping_ = false;
+}
+
+void
+connection_pool::state::
+add_idle(host& h, socket&& s)
+{
+    auto* n = h.idle.emplace_back(
+        std::make_unique<node>(std::move(s))).get();
+    n->expiry = timer::clock_type::now() + opts_.idle_timeout;
+    n->watched = true;
+    ++idle_;
+
+    capy::run_async(ctx_.get_executor())(
+        watch(shared_from_this(), h, n));
+
+    if (!reaping_)
+    {
+        reaping_ = true;
+        capy::run_async(ctx_.get_executor())(reap(shared_from_this()));
+    }
+
+    // A checkout waiting for a place can take this one
+    wake_one(h);
+}
+
+//------------------------------------------------------------------------------
+// connection
+//------------------------------------------------------------------------------
+
+connection_pool::connection::
+connection() noexcept = default;
+
+connection_pool::connection::
+connection(
+    std::shared_ptr<state> st,
+    host* h,
+    socket&& s) noexcept
+    : st_(std::move(st))
+    , host_(h)
+{
+    sock_.emplace(std::move(s));
+}
+
+connection_pool::connection::
+~connection()
+{
+    reset();
+}
+
+connection_pool::connection::
+connection(connection&& other) noexcept
+    : st_(std::move(other.st_))
+    , host_(other.host_)
+{
+    if (other.sock_)
+    {
+        sock_.emplace(std::move(*other.sock_));
+        other.sock_.reset();
+    }
+    other.host_ = nullptr;
+}
+
+connection_pool::connection&
+connection_pool::connection::
+operator=(connection&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        st_ = std::move(other.st_);
+        host_ = other.host_;
+        if (other.sock_)
+        {
+            sock_.emplace(std::move(*other.sock_));
+            other.sock_.reset();
+        }
+        other.host_ = nullptr;
+    }
+    return *this;
+}
+
+void
+connection_pool::connection::
+reset() noexcept
+{
+    if (sock_)
+    {
+        sock_.reset();
+        st_->release(*host_);
+    }
+    st_.reset();
+    host_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// connection_pool
+//------------------------------------------------------------------------------
+
+connection_pool::
+connection_pool(basic_io_context& ctx)
+    : connection_pool(ctx, options())
+{
+}
+
+connection_pool::
+connection_pool(
+    basic_io_context& ctx,
+    options opts)
+    : st_(std::make_shared<state>(ctx, opts))
+{
+}
+
+connection_pool::
+~connection_pool()
+{
+    close();
+}
+
+capy::task<capy::io_result<connection_pool::connection>>
+connection_pool::
+checkout(endpoint ep)
+{
+    // Keeps the state alive should the pool be destroyed meanwhile
+    auto st = st_;
+
+    for (;;)
+    {
+        if (st->closed_)
+            co_return {make_error_code(system::errc::operation_canceled), {}};
+
+        host& h = st->find(ep);
+        if (!h.idle.empty())
+        {
+            auto n = std::move(h.idle.back());
+            h.idle.pop_back();
+            --st->idle_;
+
+            if (n->watched)
+            {
+                n->taken = true;
+                n->sock.cancel();
+                co_await state::take_awaitable{*n};
+            }
+            if (!n->dead)
+                co_return {{}, connection(st, &h, std::move(n->sock))};
+
+            n.reset();
+            st->release(h);
+            continue;
+        }
+
+        if (h.open < st->opts_.max_per_host)
+        {
+            ++h.open;
+            socket s(st->ctx_);
+            try
+            {
+                s.open(ep.family());
+            }
+            catch (system::system_error const& e)
+            {
+                st->release(h);
+                co_return {e.code(), {}};
+            }
+
+            auto [ec] = co_await s.connect(ep);
+            if (ec)
+            {
+                st->release(h);
+                co_return {ec, {}};
+            }
+            co_return {{}, connection(st, &h, std::move(s))};
+        }
+
+        co_await state::place_awaitable{h, {}};
+    }
+}
+
+void
+connection_pool::
+checkin(connection c)
+{
+    if (!c.sock_)
+        return;
+
+    // Dropped by c's destructor
+    if (c.st_ != st_ || st_->closed_ || !c.sock_->is_open())
+        return;
+
+    socket s(std::move(*c.sock_));
+    c.sock_.reset();
+    host& h = *c.host_;
+    c.st_.reset();
+    c.host_ = nullptr;
+    st_->add_idle(h, std::move(s));
+}
+
+void
+connection_pool::
+close()
+{
+    auto& st = *st_;
+    if (st.closed_)
+        return;
+    st.closed_ = true;
+    st.timer_.cancel();
+
+    for (auto& h : st.hosts_)
+    {
+        std::vector<host::node*> idle;
+        for (auto& n : h->idle)
+            idle.push_back(n.get());
+        for (auto* n : idle)
+        {
+            n->expiring = true;
+            if (n->watched)
+                n->sock.cancel();
+            else
+                st.drop(*h, n);
+        }
+
+        // Each one wakes to find the pool closed
+        while (auto* w = h->pop())
+            w->ex.post(w->h);
+    }
+}
+
+std::size_t
+connection_pool::
+idle_size() const noexcept
+{
+    return st_->idle_;
+}
+
+std::size_t
+connection_pool::
+size() const noexcept
+{
+    std::size_t n = 0;
+    for (auto const& h : st_->hosts_)
+        n += h->open;
+    return n;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_DEFERRED_SERVICE_HPP
+#define BOOST_COROSIO_DETAIL_DEFERRED_SERVICE_HPP
+
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/detail/scheduler.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+namespace boost::corosio::detail {
+
+/// Reaches the scheduler of a context known only as an execution_context.
+struct io_context_access
+{
+    static scheduler*
+    get_scheduler(capy::execution_context& ctx) noexcept
+    {
+        auto* io = dynamic_cast<basic_io_context*>(&ctx);
+        return io ? io->sched_ : nullptr;
+    }
+};
+
+/** Find a service, asking the scheduler to create it if deferred.
+
+    Once the service exists this is the same lookup as
+    `find_service`. Only a miss consults the scheduler.
+
+    @param ctx The context owning the service.
+    @param which The kind of service `Service` is.
+
+    @return The service, or null if it is neither installed nor
+        deferred by the scheduler of `ctx`.
+*/
+template<class Service>
+Service*
+find_deferred_service(
+    capy::execution_context& ctx,
+    deferred_service which)
+{
+    if (auto* svc = ctx.find_service<Service>())
+        return svc;
+    auto* sched = io_context_access::get_scheduler(ctx);
+    if (!sched)
+        return nullptr;
+    return static_cast<Service*>(sched->make_deferred_service(which));
+}
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -0,0 +1,291 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_DNS_MESSAGE_HPP
+#define BOOST_COROSIO_DETAIL_DNS_MESSAGE_HPP
+
+#include <boost/corosio/endpoint.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*
+    DNS Messages
+    ============
+
+    Encoding of the queries and decoding of the answers of a stub
+    resolver (RFC 1035), for the A and AAAA records of one name. A
+    query asks for recursion and carries an EDNS0 OPT record (RFC 6891)
+    offering 1232-byte answers, the size that avoids IP fragmentation
+    on any path, so that answers with many addresses rarely need TCP.
+*/
+
+namespace boost::corosio::detail {
+
+/// Record types of the questions we ask.
+enum class dns_type : std::uint16_t
+{
+    a = 1,
+    aaaa = 28
+};
+
+/// The UDP payload size offered with EDNS0.
+inline constexpr std::size_t dns_udp_size = 1232;
+
+/// The largest encoded query.
+inline constexpr std::size_t dns_max_query = 12 + 256 + 4 + 11;
+
+/// Response codes that matter to us.
+enum : int
+{
+    dns_rcode_noerror = 0,
+    dns_rcode_servfail = 2,
+    dns_rcode_nxdomain = 3
+};
+
+/** The part of an answer a resolve uses. */
+struct dns_answer
+{
+    /// The response code.
+    int rcode = 0;
+
+    /// Set if the answer did not fit and must be asked over TCP.
+    bool truncated = false;
+
+    /// The addresses of the asked type, with port 0.
+    std::vector<endpoint> addresses;
+};
+
+namespace dns_detail {
+
+inline std::uint16_t
+get16(unsigned char const* p) noexcept
+{
+    return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+}
+
+inline void
+put16(unsigned char* p, std::uint16_t v) noexcept
+{
+    p[0] = static_cast<unsigned char>(v >> 8);
+    p[1] = static_cast<unsigned char>(v);
+}
+
+inline unsigned char
+lower(unsigned char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+// Compares the possibly compressed name at `off` with `name`, and
+// sets `end` to the offset after it. Returns false on a malformed
+// name, setting `end` to 0.
+inline bool
+match_name(
+    unsigned char const* msg,
+    std::size_t size,
+    std::size_t off,
+    std::string_view name,
+    std::size_t& end,
+    bool& equal) noexcept
+{
+    equal = true;
+    end = 0;
+    std::size_t pos = 0;  // Into name
+    int hops = 0;
+    for (;;)
+    {
+        if (off >= size)
+            return false;
+        unsigned char len = msg[off];
+        if ((len & 0xC0) == 0xC0)
+        {
+            if (off + 1 >= size || ++hops > 16)
+                return false;
+            if (end == 0)
+                end = off + 2;
+            off = static_cast<std::size_t>(((len & 0x3F) << 8) | msg[off + 1]);
+            continue;
+        }
+        if (len & 0xC0)
+            return false;
+        if (len == 0)
+        {
+            if (end == 0)
+                end = off + 1;
+            if (pos != name.size())
+                equal = false;
+            return true;
+        }
+        if (off + 1 + len > size)
+            return false;
+        if (pos != 0)
+        {
+            if (pos >= name.size() || name[pos] != '.')
+                equal = false;
+            else
+                ++pos;
+        }
+        for (unsigned i = 0; i < len; ++i)
+        {
+            if (!equal || pos >= name.size() ||
+                lower(msg[off + 1 + i]) !=
+                    lower(static_cast<unsigned char>(name[pos])))
+                equal = false;
+            else
+                ++pos;
+        }
+        off += 1 + len;
+    }
+}
+
+} // namespace dns_detail
+
+/** Return `name` without a trailing dot. */
+inline std::string_view
+dns_strip_root(std::string_view name) noexcept
+{
+    if (!name.empty() && name.back() == '.')
+        name.remove_suffix(1);
+    return name;
+}
+
+/** Encode a recursive query for one record type of a name.
+
+    @param buf At least @ref dns_max_query bytes.
+
+    @return The size of the query, or 0 if `name` is not a valid
+        domain name.
+*/
+inline std::size_t
+dns_encode_query(
+    std::uint16_t id,
+    std::string_view name,
+    dns_type type,
+    unsigned char* buf) noexcept
+{
+    name = dns_strip_root(name);
+    if (name.empty() || name.size() > 253)
+        return 0;
+
+    using dns_detail::put16;
+    put16(buf, id);
+    put16(buf + 2, 0x0100);     // RD
+    put16(buf + 4, 1);          // QDCOUNT
+    put16(buf + 6, 0);
+    put16(buf + 8, 0);
+    put16(buf + 10, 1);         // ARCOUNT: the OPT record
+
+    std::size_t n = 12;
+    std::size_t start = 0;
+    while (start <= name.size())
+    {
+        std::size_t dot = name.find('.', start);
+        if (dot == std::string_view::npos)
+            dot = name.size();
+        std::size_t len = dot - start;
+        if (len == 0 || len > 63)
+            return 0;
+        buf[n++] = static_cast<unsigned char>(len);
+        for (std::size_t i = 0; i < len; ++i)
+            buf[n++] = static_cast<unsigned char>(name[start + i]);
+        start = dot + 1;
+    }
+    buf[n++] = 0;
+    put16(buf + n, static_cast<std::uint16_t>(type));
+    put16(buf + n + 2, 1);      // IN
+    n += 4;
+
+    // OPT: root name, type 41, class = UDP size, no flags or options
+    buf[n++] = 0;
+    put16(buf + n, 41);
+    put16(buf + n + 2, static_cast<std::uint16_t>(dns_udp_size));
+    put16(buf + n + 4, 0);
+    put16(buf + n + 6, 0);
+    put16(buf + n + 8, 0);
+    n += 10;
+    return n;
+}
+
+/** Decode the answer to a query.
+
+    Checks that the message answers the query `id` for `name` and
+    `type`, and collects the addresses of that type in the answer
+    section, which includes those reached through CNAME records.
+
+    @return `false` if the message is malformed or answers another
+        question, in which case it should be ignored.
+*/
+inline bool
+dns_parse_answer(
+    unsigned char const* msg,
+    std::size_t size,
+    std::uint16_t id,
+    std::string_view name,
+    dns_type type,
+    dns_answer& out)
+{
+    using dns_detail::get16;
+    if (size < 12 || get16(msg) != id)
+        return false;
+    std::uint16_t const flags = get16(msg + 2);
+    if (!(flags & 0x8000) || get16(msg + 4) != 1)
+        return false;
+
+    out.rcode = flags & 0x000F;
+    out.truncated = (flags & 0x0200) != 0;
+    out.addresses.clear();
+
+    std::size_t end;
+    bool equal;
+    if (!dns_detail::match_name(msg, size, 12, dns_strip_root(name), end, equal) ||
+        !equal || end + 4 > size ||
+        get16(msg + end) != static_cast<std::uint16_t>(type) ||
+        get16(msg + end + 2) != 1)
+        return false;
+
+    std::size_t off = end + 4;
+    std::uint16_t const ancount = get16(msg + 6);
+    for (std::uint16_t i = 0; i < ancount; ++i)
+    {
+        if (!dns_detail::match_name(msg, size, off, {}, end, equal) ||
+            end + 10 > size)
+            return false;
+        std::uint16_t const rtype = get16(msg + end);
+        std::uint16_t const rclass = get16(msg + end + 2);
+        std::size_t const rdlen = get16(msg + end + 8);
+        std::size_t const rdata = end + 10;
+        if (rdata + rdlen > size)
+            return false;
+        off = rdata + rdlen;
+        if (rclass != 1 || rtype != static_cast<std::uint16_t>(type))
+            continue;
+
+        if (type == dns_type::a && rdlen == 4)
+        {
+            urls::ipv4_address::bytes_type b{{
+                msg[rdata], msg[rdata + 1], msg[rdata + 2], msg[rdata + 3]}};
+            out.addresses.emplace_back(urls::ipv4_address(b), 0);
+        }
+        else if (type == dns_type::aaaa && rdlen == 16)
+        {
+            urls::ipv6_address::bytes_type b;
+            for (std::size_t k = 0; k < 16; ++k)
+                b[k] = msg[rdata + k];
+            out.addresses.emplace_back(urls::ipv6_address(b), 0);
+        }
+    }
+    return true;
+}
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_DNS_RESOLVER_HPP
+#define BOOST_COROSIO_DETAIL_DNS_RESOLVER_HPP
+
+#include <boost/corosio/resolver.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include "src/detail/resolv_conf.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+
+namespace boost::corosio::detail {
+
+struct dns_query;
+
+/** The state of a resolver using @ref resolver_backend::dns.
+
+    Holds the resolv.conf read when the backend was chosen, and the
+    query in flight so that it can be cancelled.
+*/
+class dns_resolver
+{
+public:
+    explicit dns_resolver(capy::execution_context& ctx);
+
+    /** Start a forward resolve.
+
+        Queries the name servers for names that DNS can answer, and
+        hands the others to `fallback`, the resolver's system
+        implementation. Answers given here are allocated from `mr`.
+
+        @return `true` if the resolve completed at once, with the
+            outputs set; the coroutine is then not resumed.
+    */
+    bool resolve(
+        resolver::resolver_impl& fallback,
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        std::stop_token token,
+        system::error_code* ec,
+        resolver_results* out,
+        std::pmr::memory_resource* mr);
+
+    /// Cancel the query in flight.
+    void cancel() noexcept;
+
+private:
+    capy::execution_context& ctx_;
+    std::shared_ptr<resolv_conf const> conf_;
+    std::atomic<unsigned> next_server_{0};
+    std::mutex mutex_;
+    std::weak_ptr<dns_query> current_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif
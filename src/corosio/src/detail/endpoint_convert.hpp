@@ -93,6 +93,74 @@ from_sockaddr_in6(sockaddr_in6 const& sa) noexcept
     return endpoint(urls::ipv6_address(bytes), ntohs(sa.sin6_port));
 }
 
+/** Return the address family constant for an endpoint family.
+
+    @param f The family.
+    @return `AF_INET` or `AF_INET6`.
+*/
+inline
+int
+to_af(ip_family f) noexcept
+{
+    return f == ip_family::v6 ? AF_INET6 : AF_INET;
+}
+
+/** Convert an endpoint to a socket address of its family.
+
+    @param ep The endpoint to convert.
+    @param storage Receives the `sockaddr_in` or `sockaddr_in6`.
+    @return The length of the address in `storage`.
+*/
+inline
+socklen_t
+to_sockaddr(endpoint const& ep, sockaddr_storage& storage) noexcept
+{
+    storage = {};
+    if (ep.is_v4())
+    {
+        auto sa = to_sockaddr_in(ep);
+        std::memcpy(&storage, &sa, sizeof(sa));
+        return static_cast<socklen_t>(sizeof(sa));
+    }
+    auto sa = to_sockaddr_in6(ep);
+    std::memcpy(&storage, &sa, sizeof(sa));
+    return static_cast<socklen_t>(sizeof(sa));
+}
+
+/** Create an endpoint from a socket address of either family.
+
+    An IPv4-mapped IPv6 address, as a dual-stack socket reports for
+    IPv4 peers, becomes an IPv4 endpoint.
+
+    @param ss The socket address.
+    @return The endpoint, or a default endpoint for another family.
+*/
+inline
+endpoint
+from_sockaddr(sockaddr_storage const& ss) noexcept
+{
+    if (ss.ss_family == AF_INET)
+    {
+        sockaddr_in sa;
+        std::memcpy(&sa, &ss, sizeof(sa));
+        return from_sockaddr_in(sa);
+    }
+    if (ss.ss_family == AF_INET6)
+    {
+        sockaddr_in6 sa;
+        std::memcpy(&sa, &ss, sizeof(sa));
+        if (IN6_IS_ADDR_V4MAPPED(&sa.sin6_addr))
+        {
+            urls::ipv4_address::bytes_type bytes;
+            std::memcpy(bytes.data(),
+                reinterpret_cast<unsigned char const*>(&sa.sin6_addr) + 12, 4);
+            return endpoint(urls::ipv4_address(bytes), ntohs(sa.sin6_port));
+        }
+        return from_sockaddr_in6(sa);
+    }
+    return endpoint{};
+}
+
 } // namespace boost::corosio::detail
 
 #endif
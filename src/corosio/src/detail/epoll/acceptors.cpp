@@ -15,6 +15,12 @@
 #include "src/detail/epoll/sockets.hpp"
 #include "src/detail/endpoint_convert.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/posix/fast_open.hpp"
+#include "src/detail/posix/listener.hpp"
+#include "src/detail/posix/local.hpp"
+#include "src/detail/posix/reuseport.hpp"
+
+#include <boost/system/system_error.hpp>
 
 #include <errno.h>
 #include <netinet/in.h>
@@ -38,6 +44,34 @@ cancel() noexcept
         request_cancel();
 }
 
+//------------------------------------------------------------------------------
+// epoll_accept_op::perform_io
+//------------------------------------------------------------------------------
+
+void
+epoll_accept_op::
+perform_io() noexcept
+{
+    sockaddr_storage addr{};
+    socklen_t addrlen = sizeof(addr);
+    int new_fd = ::accept4(fd, reinterpret_cast<sockaddr*>(&addr),
+                           &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (new_fd >= 0)
+    {
+        accepted_fd = new_fd;
+        complete(0, 0);
+
+        // One readiness event may stand for a deep backlog
+        if (acceptor_impl_)
+            acceptor_impl_->accept_surplus();
+    }
+    else
+    {
+        complete(errno, 0);
+    }
+}
+
 //------------------------------------------------------------------------------
 // epoll_accept_op::operator() - creates peer socket and caches endpoints
 //------------------------------------------------------------------------------
@@ -47,9 +81,21 @@ epoll_accept_op::
 operator()()
 {
     stop_cb.reset();
+    trace.finish(cancelled.load(std::memory_order_acquire));
+    BOOST_COROSIO_PROBE3(socket_accept, fd, accepted_fd, errn);
 
     bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
 
+    if (acceptor_impl_)
+    {
+        auto counts = static_cast<epoll_acceptor_impl*>(acceptor_impl_)
+            ->service().scheduler().socket_counts();
+        if (cancelled.load(std::memory_order_acquire))
+            counts.add(&socket_counters::cancellations);
+        else if (success)
+            counts.add(&socket_counters::accepts);
+    }
+
     if (ec_out)
     {
         if (cancelled.load(std::memory_order_acquire))
@@ -69,18 +115,33 @@ operator()()
             if (socket_svc)
             {
                 auto& impl = static_cast<epoll_socket_impl&>(socket_svc->create_impl());
-                impl.set_socket(accepted_fd);
-
-                sockaddr_in local_addr{};
+                // set_socket takes ownership of the fd, closing it on failure
+                if (auto reg_ec = impl.set_socket(accepted_fd))
+                {
+                    accepted_fd = -1;
+                    impl.release();
+                    if (ec_out)
+                        *ec_out = reg_ec;
+                    if (impl_out)
+                        *impl_out = nullptr;
+
+                    capy::executor_ref saved_ex( std::move( ex ) );
+                    capy::coro saved_h( std::move( h ) );
+                    impl_ptr.reset();
+                    saved_ex.dispatch( saved_h ).resume();
+                    return;
+                }
+
+                sockaddr_storage local_addr{};
                 socklen_t local_len = sizeof(local_addr);
-                sockaddr_in remote_addr{};
+                sockaddr_storage remote_addr{};
                 socklen_t remote_len = sizeof(remote_addr);
 
                 endpoint local_ep, remote_ep;
                 if (::getsockname(accepted_fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-                    local_ep = from_sockaddr_in(local_addr);
+                    local_ep = from_sockaddr(local_addr);
                 if (::getpeername(accepted_fd, reinterpret_cast<sockaddr*>(&remote_addr), &remote_len) == 0)
-                    remote_ep = from_sockaddr_in(remote_addr);
+                    remote_ep = from_sockaddr(remote_addr);
 
                 impl.set_endpoints(local_ep, remote_ep);
 
@@ -167,8 +228,23 @@ accept(
     op.impl_out = impl_out;
     op.fd = fd_;
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    sockaddr_in addr{};
+    // A connection drained by an earlier readiness event
+    if (!pending_.empty())
+    {
+        int fd = take_pending();
+        if (fd >= 0)
+        {
+            op.accepted_fd = fd;
+            op.complete(0, 0);
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            return;
+        }
+    }
+
+    sockaddr_storage addr{};
     socklen_t addrlen = sizeof(addr);
     int accepted = ::accept4(fd_, reinterpret_cast<sockaddr*>(&addr),
                              &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
@@ -185,36 +261,37 @@ accept(
     if (errno == EAGAIN || errno == EWOULDBLOCK)
     {
         svc_.work_started();
-        // Set registering BEFORE register_fd to close the race window where
-        // reactor sees an event before we set registered.
-        op.registered.store(registration_state::registering, std::memory_order_release);
-        svc_.scheduler().register_fd(fd_, &op, EPOLLIN | EPOLLET);
-
-        // Transition to registered. If this fails, reactor or cancel already
-        // claimed the op (state is now unregistered), so we're done. However,
-        // we must still unregister the fd because cancel's unregister_fd may
-        // have run before our register_fd, leaving the fd orphaned in epoll.
-        auto expected = registration_state::registering;
-        if (!op.registered.compare_exchange_strong(
-                expected, registration_state::registered, std::memory_order_acq_rel))
-        {
-            svc_.scheduler().unregister_fd(fd_);
-            return;
-        }
 
-        // If cancelled was set before we registered, handle it now.
-        if (op.cancelled.load(std::memory_order_acquire))
+        std::unique_lock lock(desc_->mutex);
+
+        // A connection arrived while nothing was parked; retry first
+        if (desc_->read_ready)
         {
-            auto prev = op.registered.exchange(
-                registration_state::unregistered, std::memory_order_acq_rel);
-            if (prev != registration_state::unregistered)
+            desc_->read_ready = false;
+            op.perform_io();
+            if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
             {
-                svc_.scheduler().unregister_fd(fd_);
+                lock.unlock();
                 op.impl_ptr = shared_from_this();
                 svc_.post(&op);
                 svc_.work_finished();
+                return;
             }
+            op.errn = 0;
         }
+
+        if (op.cancelled.load(std::memory_order_acquire))
+        {
+            lock.unlock();
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            svc_.work_finished();
+            return;
+        }
+
+        op.parked_at = std::chrono::steady_clock::now();
+        op.home = svc_.scheduler().affinity_home();
+        desc_->read_op = &op;
         return;
     }
 
@@ -225,26 +302,38 @@ accept(
 
 void
 epoll_acceptor_impl::
-cancel() noexcept
+accept_surplus() noexcept
 {
-    std::shared_ptr<epoll_acceptor_impl> self;
-    try {
-        self = shared_from_this();
-    } catch (const std::bad_weak_ptr&) {
-        return;
+    while (pending_count_ < pending_.size())
+    {
+        int fd = ::accept4(fd_, nullptr, nullptr,
+                           SOCK_NONBLOCK | SOCK_CLOEXEC);
+        // EAGAIN ends the drain; other errors surface on the next accept
+        if (fd < 0)
+            return;
+        pending_[(pending_head_ + pending_count_) % pending_.size()] = fd;
+        ++pending_count_;
     }
+}
 
-    auto prev = acc_.registered.exchange(
-        registration_state::unregistered, std::memory_order_acq_rel);
-    acc_.request_cancel();
+int
+epoll_acceptor_impl::
+take_pending() noexcept
+{
+    std::lock_guard lock(desc_->mutex);
+    if (pending_count_ == 0)
+        return -1;
+    int fd = pending_[pending_head_];
+    pending_head_ = (pending_head_ + 1) % pending_.size();
+    --pending_count_;
+    return fd;
+}
 
-    if (prev != registration_state::unregistered)
-    {
-        svc_.scheduler().unregister_fd(fd_);
-        acc_.impl_ptr = self;
-        svc_.post(&acc_);
-        svc_.work_finished();
-    }
+void
+epoll_acceptor_impl::
+cancel() noexcept
+{
+    cancel_single_op(acc_);
 }
 
 void
@@ -252,24 +341,27 @@ epoll_acceptor_impl::
 cancel_single_op(epoll_op& op) noexcept
 {
     // Called from stop_token callback to cancel a specific pending operation.
-    auto prev = op.registered.exchange(
-        registration_state::unregistered, std::memory_order_acq_rel);
     op.request_cancel();
 
-    if (prev != registration_state::unregistered)
-    {
-        svc_.scheduler().unregister_fd(fd_);
+    if (!desc_)
+        return;
 
-        // Keep impl alive until op completes
-        try {
-            op.impl_ptr = shared_from_this();
-        } catch (const std::bad_weak_ptr&) {
-            // Impl is being destroyed, op will be orphaned but that's ok
-        }
+    {
+        std::lock_guard lock(desc_->mutex);
+        if (desc_->read_op != &op)
+            return;
+        desc_->read_op = nullptr;
+    }
 
-        svc_.post(&op);
-        svc_.work_finished();
+    // Keep impl alive until op completes
+    try {
+        op.impl_ptr = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        // Impl is being destroyed, op will be orphaned but that's ok
     }
+
+    svc_.post(&op);
+    svc_.work_finished();
 }
 
 void
@@ -280,8 +372,20 @@ close_socket() noexcept
 
     if (fd_ >= 0)
     {
-        // Unconditionally remove from epoll to handle edge cases
-        svc_.scheduler().unregister_fd(fd_);
+        if (desc_)
+        {
+            {
+                std::lock_guard lock(desc_->mutex);
+                for (; pending_count_ > 0; --pending_count_)
+                {
+                    ::close(pending_[pending_head_]);
+                    pending_head_ = (pending_head_ + 1) % pending_.size();
+                }
+                pending_head_ = 0;
+            }
+            svc_.scheduler().deregister_descriptor(fd_, desc_);
+            desc_ = nullptr;
+        }
         ::close(fd_);
         fd_ = -1;
     }
@@ -299,6 +403,9 @@ epoll_acceptor_service(capy::execution_context& ctx)
     : ctx_(ctx)
     , state_(std::make_unique<epoll_acceptor_state>(ctx.use_service<epoll_scheduler>()))
 {
+    // The scheduler makes the socket service before this one
+    if (auto* svc = ctx.find_service<detail::socket_service>())
+        socket_svc_ = dynamic_cast<epoll_socket_service*>(svc);
 }
 
 epoll_acceptor_service::
@@ -322,7 +429,7 @@ acceptor::acceptor_impl&
 epoll_acceptor_service::
 create_acceptor_impl()
 {
-    auto impl = std::make_shared<epoll_acceptor_impl>(*this);
+    auto impl = make_recycled_impl<epoll_acceptor_impl>(*this);
     auto* raw = impl.get();
 
     std::lock_guard lock(state_->mutex_);
@@ -347,41 +454,174 @@ epoll_acceptor_service::
 open_acceptor(
     acceptor::acceptor_impl& impl,
     endpoint ep,
-    int backlog)
+    acceptor::listen_options const& opts)
 {
     auto* epoll_impl = static_cast<epoll_acceptor_impl*>(&impl);
     epoll_impl->close_socket();
+    epoll_impl->pending_.assign(scheduler().options().accept_backlog, -1);
 
-    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int fd = ::socket(detail::to_af(ep.family()), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (fd < 0)
         return make_err(errno);
 
     int reuse = 1;
     ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
 
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
-    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    if (opts.reuse_port &&
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
     {
         int errn = errno;
         ::close(fd);
         return make_err(errn);
     }
 
-    if (::listen(fd, backlog) < 0)
+    // Set explicitly; the default differs between platforms
+    if (ep.is_v6())
+    {
+        int v6_only = opts.dual_stack ? 0 : 1;
+        if (::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY,
+                &v6_only, sizeof(v6_only)) < 0)
+        {
+            int errn = errno;
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (opts.fast_open_queue > 0)
+    {
+        int errn = detail::set_fast_open_queue(fd, opts.fast_open_queue);
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    if (::listen(fd, opts.backlog) < 0)
     {
         int errn = errno;
         ::close(fd);
         return make_err(errn);
     }
 
+    if (opts.cpu_steering)
+    {
+        int errn = opts.reuse_port
+            ? detail::attach_cpu_steering(fd)
+            : EINVAL;
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    try {
+        epoll_impl->desc_ = state_->sched_.register_descriptor(
+            fd, opts.exclusive_wakeup);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
     epoll_impl->fd_ = fd;
 
     // Cache the local endpoint (queries OS for ephemeral port if port was 0)
-    sockaddr_in local_addr{};
+    sockaddr_storage local_addr{};
     socklen_t local_len = sizeof(local_addr);
     if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-        epoll_impl->set_local_endpoint(detail::from_sockaddr_in(local_addr));
+        epoll_impl->set_local_endpoint(detail::from_sockaddr(local_addr));
+
+    return {};
+}
 
+system::error_code
+epoll_acceptor_service::
+adopt_listener(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd,
+    bool exclusive)
+{
+    auto* epoll_impl = static_cast<epoll_acceptor_impl*>(&impl);
+    epoll_impl->close_socket();
+    epoll_impl->pending_.assign(scheduler().options().accept_backlog, -1);
+
+    endpoint local;
+    if (int errn = detail::prepare_inherited_listener(fd, local))
+        return make_err(errn);
+
+    try {
+        epoll_impl->desc_ = state_->sched_.register_descriptor(fd, exclusive);
+    } catch (system::system_error const& e) {
+        return e.code();
+    }
+    epoll_impl->fd_ = fd;
+    epoll_impl->set_local_endpoint(local);
+    return {};
+}
+
+system::error_code
+epoll_acceptor_service::
+assign_acceptor(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd)
+{
+    return adopt_listener(impl, fd, false);
+}
+
+system::error_code
+epoll_acceptor_service::
+share_acceptor(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd)
+{
+    return adopt_listener(impl, fd, true);
+}
+
+system::error_code
+epoll_acceptor_service::
+open_local_acceptor(
+    acceptor::acceptor_impl& impl,
+    std::string_view path,
+    int backlog)
+{
+    auto* epoll_impl = static_cast<epoll_acceptor_impl*>(&impl);
+    epoll_impl->close_socket();
+    epoll_impl->pending_.assign(scheduler().options().accept_backlog, -1);
+
+    sockaddr_un addr;
+    socklen_t addrlen;
+    if (int errn = detail::to_sockaddr_un(path, addr, addrlen))
+        return make_err(errn);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0 ||
+        ::listen(fd, backlog) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    try {
+        epoll_impl->desc_ = state_->sched_.register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
+    epoll_impl->fd_ = fd;
     return {};
 }
 
@@ -410,6 +650,8 @@ epoll_socket_service*
 epoll_acceptor_service::
 socket_service() const noexcept
 {
+    if (socket_svc_)
+        return socket_svc_;
     auto* svc = ctx_.find_service<detail::socket_service>();
     return svc ? dynamic_cast<epoll_socket_service*>(svc) : nullptr;
 }
@@ -19,6 +19,7 @@
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
 #include "src/detail/socket_service.hpp"
 
 #include "src/detail/epoll/op.hpp"
@@ -26,7 +27,7 @@
 
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <vector>
 
 namespace boost::corosio::detail {
 
@@ -55,7 +56,7 @@ public:
         system::error_code*,
         io_object::io_object_impl**) override;
 
-    int native_handle() const noexcept { return fd_; }
+    int native_handle() const noexcept override { return fd_; }
     endpoint local_endpoint() const noexcept override { return local_endpoint_; }
     bool is_open() const noexcept { return fd_ >= 0; }
     void cancel() noexcept override;
@@ -63,14 +64,31 @@ public:
     void close_socket() noexcept;
     void set_local_endpoint(endpoint ep) noexcept { local_endpoint_ = ep; }
 
+    /** Accept the connections queued behind one just accepted.
+
+        Called with the descriptor locked. Fills the pending ring,
+        sized by epoll_options::accept_backlog, until accept4 would
+        block or the ring is full.
+    */
+    void accept_surplus() noexcept;
+
     epoll_acceptor_service& service() noexcept { return svc_; }
 
     epoll_accept_op acc_;
 
 private:
+    int take_pending() noexcept;
+
     epoll_acceptor_service& svc_;
     int fd_ = -1;
+    descriptor_state* desc_ = nullptr;
     endpoint local_endpoint_;
+
+    // Connections accepted ahead of accept(), guarded by desc_->mutex.
+    // Empty unless accept_backlog is nonzero.
+    std::vector<int> pending_;
+    std::size_t pending_head_ = 0;
+    std::size_t pending_count_ = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -87,7 +105,7 @@ public:
     epoll_scheduler& sched_;
     std::mutex mutex_;
     intrusive_list<epoll_acceptor_impl> acceptor_list_;
-    std::unordered_map<epoll_acceptor_impl*, std::shared_ptr<epoll_acceptor_impl>> acceptor_ptrs_;
+    impl_ptr_map<epoll_acceptor_impl> acceptor_ptrs_;
 };
 
 /** epoll acceptor service implementation.
@@ -111,6 +129,16 @@ public:
     system::error_code open_acceptor(
         acceptor::acceptor_impl& impl,
         endpoint ep,
+        acceptor::listen_options const& opts) override;
+    system::error_code assign_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd) override;
+    system::error_code share_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd) override;
+    system::error_code open_local_acceptor(
+        acceptor::acceptor_impl& impl,
+        std::string_view path,
         int backlog) override;
 
     epoll_scheduler& scheduler() const noexcept { return state_->sched_; }
@@ -122,8 +150,16 @@ public:
     epoll_socket_service* socket_service() const noexcept;
 
 private:
+    system::error_code adopt_listener(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd,
+        bool exclusive);
+
     capy::execution_context& ctx_;
     std::unique_ptr<epoll_acceptor_state> state_;
+
+    // Cached at construction, so accepts skip the service lookup
+    epoll_socket_service* socket_svc_ = nullptr;
 };
 
 } // namespace boost::corosio::detail
@@ -15,28 +15,45 @@
 #if BOOST_COROSIO_HAS_EPOLL
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_account.hpp>
 #include <boost/corosio/io_object.hpp>
 #include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/udp_socket.hpp>
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/coro.hpp>
 #include <boost/capy/error.hpp>
 #include <boost/system/error_code.hpp>
 
+#include "src/detail/intrusive.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/op_trace.hpp"
+#include "src/detail/probes.hpp"
 #include "src/detail/resume_coro.hpp"
 #include "src/detail/scheduler_op.hpp"
+#include "src/detail/segment_array.hpp"
 #include "src/detail/endpoint_convert.hpp"
+#include "src/detail/posix/local.hpp"
+#include "src/detail/posix/timestamping.hpp"
 
 #include <unistd.h>
 #include <errno.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <stop_token>
+#include <vector>
 
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/sendfile.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 
@@ -49,22 +66,25 @@
     fixed slots for each operation type (conn_, rd_, wr_), so only one
     operation of each type can be pending per socket at a time.
 
+    Persistent Registration
+    -----------------------
+    Every open socket and acceptor owns a descriptor_state that is added
+    to the epoll set exactly once, edge-triggered for both read and write
+    readiness. Operations that would block park themselves in a slot on
+    the descriptor_state; the reactor matches each readiness event to the
+    parked operation, so steady-state I/O makes no epoll_ctl calls.
+
     Completion vs Cancellation Race
     -------------------------------
-    The `registered` atomic uses a tri-state (unregistered, registering,
-    registered) to handle two races: (1) between register_fd() and the
-    reactor seeing an event, and (2) between reactor completion and cancel().
-
-    The registering state closes the window where an event could arrive
-    after register_fd() but before the boolean was set. The reactor and
-    cancel() both treat registering the same as registered when claiming.
+    The slots are protected by the descriptor_state mutex. Whoever removes
+    an operation from its slot while holding the mutex "claims" it and is
+    responsible for completing it: the reactor when the I/O finishes, or
+    cancel(). The loser finds the slot empty and does nothing.
 
-    Whoever atomically exchanges to unregistered "claims" the operation
-    and is responsible for completing it. The loser sees unregistered and
-    does nothing. The initiating thread uses compare_exchange to transition
-    from registering to registered; if this fails, the reactor or cancel
-    already claimed the op. This avoids double-completion bugs without
-    requiring a mutex in the hot path.
+    An edge delivered while no operation is parked is remembered in the
+    read_ready/write_ready flags. An operation that parks afterwards
+    retries its syscall first, since the kernel will not report that
+    edge again.
 
     Impl Lifetime Management
     ------------------------
@@ -75,12 +95,145 @@
     after the coroutine is resumed. Without this, closing a socket with pending
     operations causes use-after-free.
 
+    Stop Slot
+    ---------
+    A std::stop_callback costs a lock on the token's stop state to
+    register and another to remove, which per operation adds up when
+    every operation of a connection carries the same long-lived token.
+    A socket impl therefore keeps one registration, its stop slot, for
+    the first token that can stop; operations started with that token
+    set `stop_slot` and register nothing of their own. Operations with
+    any other token register their own callback as before.
+
+    When the slot's token is stopped, its callback claims, under the
+    descriptor mutex, the parked operations that have `stop_slot` set.
+    An operation not parked yet finds the stop when register_op checks
+    the slot's token under the same mutex, so a stop is never missed
+    between starting and parking. close_socket() releases the slot.
+
+    Inline Completion
+    -----------------
+    When the speculative readv()/sendmsg() in read_some()/write_some()
+    finishes the operation, complete_inline() stores the results and the
+    awaitable resumes without suspending, skipping the scheduler queue.
+    A stream that is always ready would then never yield, so after
+    max_inline_completions in a row the next result is posted as usual.
+
+    Transfer All
+    ------------
+    read_exact() and write_all() set transfer_all on the op. Its
+    perform_io() then repeats the system call, dropping transferred
+    iovecs from the front, until every buffer is done, an error occurs,
+    or the call would block. On EAGAIN the op stays parked with its
+    running total, and the next readiness event continues it, so the
+    coroutine is resumed once for the whole transfer. A sequence with
+    more buffers than max_iovecs uses the looping default of
+    io_stream_impl instead.
+
+    File Transmission
+    -----------------
+    send_file() sets file_fd on the write op, and perform_io() calls
+    sendfile(2) from the file to the socket until the count is sent.
+    The kernel advances file_offset, so the op parks on EAGAIN like a
+    write_all and continues from where it stopped. A zero return
+    before the count is the end of the file and completes with eof.
+
+    Zero-Copy Sends
+    ---------------
+    A socket with set_zero_copy() has SO_ZEROCOPY set, and a write of
+    at least zero_copy_min_bytes gets zc_desc. Each of its sendmsg()
+    calls then passes MSG_ZEROCOPY and counts one send in zc_sent. The
+    kernel reports released sends as ranges on the socket's error
+    queue, which raises EPOLLERR; the reactor drains it and adds each
+    range to zc_done without treating the event as an error. A write
+    whose bytes are sent parks (zc_waiting) until zc_done reaches the
+    count of its last send, so the caller gets its buffers back only
+    when the kernel no longer reads them. Cancellation leaves such a
+    write parked; close_socket() completes it.
+
+    Write Coalescing
+    ----------------
+    A socket with set_write_coalescing() sets TCP_CORK on the first
+    write after it was last uncorked, and posts its uncork op, which
+    clears the option. The uncork op runs after the handlers already
+    queued, so the small writes made by this handler and those run
+    before it are held by the kernel and leave as full segments once
+    it runs, instead of one short segment per write. corked_ is set by
+    the writer and cleared by the uncork op as its last step, so the
+    op is never queued twice; a write that races with it is at worst
+    sent uncoalesced.
+
+    Timestamps
+    ----------
+    A socket with set_timestamping() points its read op's rx_time_out
+    at the impl, and each read then goes through recvmsg() to collect
+    the SCM_TIMESTAMPING data; see posix/timestamping.hpp. Transmit
+    timestamps arrive on the error queue. As with zero-copy sends,
+    descriptor_state::timestamping makes the reactor drain it on
+    EPOLLERR, and the latest time is kept in tx_time.
+
+    Readiness Waits
+    ---------------
+    wait() parks the read or write op with wait_events set instead of
+    buffers. Its perform_io() polls the socket without transferring
+    anything, so the op parks and wakes like a read or write and then
+    completes with no bytes. A pending socket error also ends a wait;
+    the reactor does not report it to the waiter, since the next read
+    or write will. An error wait polls for POLLPRI and parks in the
+    read slot, where EPOLLERR wakes it.
+
+    Datagrams
+    ---------
+    A udp_socket parks its receive op in the read slot and its send op
+    in the write slot of its descriptor_state, like a stream socket.
+    One datagram goes through recvmsg()/sendmsg() with the peer
+    address in msg_name. A batch uses recvmmsg()/sendmmsg() over at
+    most max_batch messages, with one iovec, address and control
+    buffer per message kept in the op, so a socket that receives
+    batches of the same size allocates only once. The control buffer
+    carries UDP_SEGMENT on send and UDP_GRO on receive. A datagram of
+    zero bytes is not EOF.
+
+    Tracing
+    -------
+    Each op takes the scheduler's tracer when it starts, and the
+    reactor stamps it when it moves the op to the ready queue; see
+    op_trace.hpp. operator() reports it before resuming, and an op
+    completed inline or destroyed drops its trace.
+
     EOF Detection
     -------------
     For reads, 0 bytes with no error means EOF. But an empty user buffer also
     returns 0 bytes. The `empty_buffer_read` flag distinguishes these cases
     so we don't spuriously report EOF when the user just passed an empty buffer.
 
+    Parked Operations
+    -----------------
+    An op stamps `parked_at` as it takes its descriptor slot, which is
+    the slow path of an operation that already made a system call and
+    found nothing to do. The scheduler walks the live descriptors for
+    parked_ops(), reading each slot under the descriptor's mutex, and
+    reports the op's kind, descriptor, age and coroutine. Ops that
+    complete without parking never read the clock.
+
+    Accounting
+    ----------
+    A socket with an io_account hands it to each op it starts. The
+    op charges its bytes in store_results(), which both the inline
+    and the resumed paths run, and times resume_coro() around the
+    coroutine it resumes. The account belongs to the open socket and
+    is cleared when it closes, so an accepted connection starts
+    without one. Ops of sockets without an account pay one branch.
+
+    Counters
+    --------
+    Stream socket ops also count into the socket counters of the
+    thread that finishes them (see "Socket Counters" in
+    thread_stats.hpp): store_results() adds the bytes and whether the
+    op completed on its first attempt or after parking, which
+    register_op() records in `waited` together with the would-block
+    count. Connects and accepts count in their own completions.
+
     SIGPIPE Prevention
     ------------------
     Writes use sendmsg() with MSG_NOSIGNAL instead of writev() to prevent
@@ -93,20 +246,8 @@ namespace boost::corosio::detail {
 // Forward declarations for cancellation support
 class epoll_socket_impl;
 class epoll_acceptor_impl;
-
-/** Registration state for async operations.
-
-    Tri-state enum to handle the race between register_fd() and
-    run_reactor() seeing an event. Setting REGISTERING before
-    calling register_fd() ensures events delivered during the
-    registration window are not dropped.
-*/
-enum class registration_state : std::uint8_t
-{
-    unregistered,  ///< Not registered with reactor
-    registering,   ///< register_fd() called, not yet confirmed
-    registered     ///< Fully registered, ready for events
-};
+class epoll_udp_socket_impl;
+struct descriptor_state;
 
 struct epoll_op : scheduler_op
 {
@@ -124,10 +265,21 @@ struct epoll_op : scheduler_op
     int fd = -1;
     int errn = 0;
     std::size_t bytes_transferred = 0;
+    short wait_events = 0;      // wait(), see "Readiness Waits"
+
+    // When the op was put in its descriptor slot, see "Parked Operations"
+    std::chrono::steady_clock::time_point parked_at;
+    bool waited = false;        // parked at least once, see "Counters"
+
+    // Queue of the run() thread that parked the op, or zero, see
+    // "Completion Affinity" in scheduler.cpp
+    std::uint32_t home = 0;
 
     std::atomic<bool> cancelled{false};
-    std::atomic<registration_state> registered{registration_state::unregistered};
     std::optional<std::stop_callback<canceller>> stop_cb;
+    bool stop_slot = false;     // see "Stop Slot"
+    op_trace_state trace;
+    io_account* account = nullptr;  // see "Accounting"
 
     // Prevents use-after-free when socket is closed with pending ops.
     // See "Impl Lifetime Management" in file header.
@@ -148,24 +300,68 @@ struct epoll_op : scheduler_op
         fd = -1;
         errn = 0;
         bytes_transferred = 0;
+        wait_events = 0;
+        waited = false;
         cancelled.store(false, std::memory_order_relaxed);
-        registered.store(registration_state::unregistered, std::memory_order_relaxed);
+        stop_slot = false;
         impl_ptr.reset();
         socket_impl_ = nullptr;
         acceptor_impl_ = nullptr;
+        account = nullptr;
     }
 
+    // Consecutive inline completions, see "Inline Completion"
+    static constexpr int max_inline_completions = 16;
+    int inline_completions = 0;
+
     void operator()() override
     {
         stop_cb.reset();
+        trace.finish(cancelled.load(std::memory_order_acquire));
+        inline_completions = 0;
+        store_results();
+
+        // Move to stack before destroying the frame
+        capy::executor_ref saved_ex( std::move( ex ) );
+        capy::coro saved_h( std::move( h ) );
+        impl_ptr.reset();
+        if (auto* a = account)
+        {
+            auto const t0 = std::chrono::steady_clock::now();
+            resume_coro(saved_ex, saved_h);
+            a->add_cpu_time(std::chrono::steady_clock::now() - t0);
+            return;
+        }
+        resume_coro(saved_ex, saved_h);
+    }
+
+    /** Finish a completed operation without resuming the coroutine.
+
+        @return `false` if the inline budget is spent, in which case
+            nothing was done and the op must be posted.
+    */
+    bool complete_inline() noexcept
+    {
+        if (++inline_completions > max_inline_completions)
+        {
+            inline_completions = 0;
+            return false;
+        }
+        stop_cb.reset();
+        trace.discard();
+        store_results();
+        return true;
+    }
 
+    void store_results() noexcept
+    {
         if (ec_out)
         {
             if (cancelled.load(std::memory_order_acquire))
                 *ec_out = capy::error::canceled;
             else if (errn != 0)
                 *ec_out = make_err(errn);
-            else if (is_read_operation() && bytes_transferred == 0)
+            else if (at_eof())
                 *ec_out = capy::error::eof;
             else
                 *ec_out = {};
@@ -174,19 +370,36 @@ struct epoll_op : scheduler_op
         if (bytes_out)
             *bytes_out = bytes_transferred;
 
-        // Move to stack before destroying the frame
-        capy::executor_ref saved_ex( std::move( ex ) );
-        capy::coro saved_h( std::move( h ) );
-        impl_ptr.reset();
-        resume_coro(saved_ex, saved_h);
+        if (account)
+            account->add_op(is_read_operation(), bytes_transferred);
+
+        if (socket_impl_)
+            count();
+
+#if BOOST_COROSIO_HAS_PROBES
+        if (wait_events == 0)
+        {
+            if (is_read_operation())
+                BOOST_COROSIO_PROBE3(socket_read, fd, bytes_transferred, errn);
+            else
+                BOOST_COROSIO_PROBE3(socket_write, fd, bytes_transferred, errn);
+        }
+#endif
     }
 
     virtual bool is_read_operation() const noexcept { return false; }
+
+    virtual bool at_eof() const noexcept
+    {
+        return is_read_operation() && bytes_transferred == 0;
+    }
+
     virtual void cancel() noexcept = 0;
 
     void destroy() override
     {
         stop_cb.reset();
+        trace.discard();
         impl_ptr.reset();
     }
 
@@ -201,21 +414,17 @@ struct epoll_op : scheduler_op
         stop_cb.reset();
         socket_impl_ = nullptr;
         acceptor_impl_ = nullptr;
+        account = nullptr;
 
         if (token.stop_possible())
             stop_cb.emplace(token, canceller{this});
     }
 
-    void start(std::stop_token token, epoll_socket_impl* impl)
-    {
-        cancelled.store(false, std::memory_order_release);
-        stop_cb.reset();
-        socket_impl_ = impl;
-        acceptor_impl_ = nullptr;
+    // Defined in sockets.cpp where epoll_socket_impl is complete
+    void start(std::stop_token token, epoll_socket_impl* impl);
 
-        if (token.stop_possible())
-            stop_cb.emplace(token, canceller{this});
-    }
+    // Add a completed stream socket op to the counters, see "Counters"
+    void count() const noexcept;
 
     void start(std::stop_token token, epoll_acceptor_impl* impl)
     {
@@ -223,6 +432,7 @@ struct epoll_op : scheduler_op
         stop_cb.reset();
         socket_impl_ = nullptr;
         acceptor_impl_ = impl;
+        account = nullptr;
 
         if (token.stop_possible())
             stop_cb.emplace(token, canceller{this});
@@ -235,6 +445,21 @@ struct epoll_op : scheduler_op
     }
 
     virtual void perform_io() noexcept {}
+
+    // Checks the readiness a wait() asked for, without blocking
+    void perform_wait() noexcept
+    {
+        pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = wait_events;
+        int r = ::poll(&pfd, 1, 0);
+        if (r < 0)
+            complete(errno, 0);
+        else if (r == 0)
+            complete(EAGAIN, 0);
+        else
+            complete(0, 0);
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -251,6 +476,18 @@ struct epoll_connect_op : epoll_op
 
     void perform_io() noexcept override
     {
+        // Readiness may be spurious, e.g. the HUP reported when a socket
+        // is registered before connect() is called. Confirm that the
+        // connect has finished before reading its status.
+        pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+        if (::poll(&pfd, 1, 0) == 0)
+        {
+            complete(EAGAIN, 0);
+            return;
+        }
+
         // connect() completion status is retrieved via SO_ERROR, not return value
         int err = 0;
         socklen_t len = sizeof(err);
@@ -266,69 +503,255 @@ struct epoll_connect_op : epoll_op
 
 //------------------------------------------------------------------------------
 
-struct epoll_read_op : epoll_op
+struct epoll_read_op final : epoll_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    iovec iovecs[max_buffers];
-    int iovec_count = 0;
+    iovec_array iovecs;
     bool empty_buffer_read = false;
+    bool transfer_all = false;  // read_exact, see "Transfer All"
+    bool short_eof = false;     // EOF before the buffers were full
+    int* fd_out = nullptr;      // read_with_descriptor, see posix/local.hpp
+    std::int64_t* rx_time_out = nullptr;    // see "Timestamps"
 
     bool is_read_operation() const noexcept override
     {
-        return !empty_buffer_read;
+        return !empty_buffer_read && wait_events == 0;
+    }
+
+    bool at_eof() const noexcept override
+    {
+        return short_eof || epoll_op::at_eof();
     }
 
     void reset() noexcept
     {
         epoll_op::reset();
-        iovec_count = 0;
+        iovecs.clear();
         empty_buffer_read = false;
+        transfer_all = false;
+        short_eof = false;
+        fd_out = nullptr;
+        rx_time_out = nullptr;
+    }
+
+    // One read into the buffers
+    ssize_t read_part() noexcept
+    {
+        if (rx_time_out)
+            return recv_with_timestamp(
+                fd, iovecs.data(), iovecs.size(), rx_time_out);
+        return ::readv(fd, iovecs.data(), static_cast<int>(iovecs.size()));
     }
 
     void perform_io() noexcept override
     {
-        ssize_t n = ::readv(fd, iovecs, iovec_count);
+        if (wait_events)
+        {
+            perform_wait();
+            return;
+        }
+        if (transfer_all)
+        {
+            perform_transfer_all();
+            return;
+        }
+        ssize_t n = fd_out
+            ? recv_with_fd(fd, iovecs.data(), iovecs.size(), fd_out)
+            : read_part();
         if (n >= 0)
             complete(0, static_cast<std::size_t>(n));
         else
             complete(errno, 0);
     }
 
+    // Reads until the buffers are full; EAGAIN keeps the op parked
+    // with the bytes read so far in bytes_transferred
+    void perform_transfer_all() noexcept
+    {
+        for (;;)
+        {
+            ssize_t n = read_part();
+            if (n < 0)
+            {
+                complete(errno, bytes_transferred);
+                return;
+            }
+            if (n == 0)
+            {
+                short_eof = true;
+                complete(0, bytes_transferred);
+                return;
+            }
+            bytes_transferred += static_cast<std::size_t>(n);
+            if (consume_iovecs(iovecs, static_cast<std::size_t>(n)))
+            {
+                complete(0, bytes_transferred);
+                return;
+            }
+        }
+    }
+
     void cancel() noexcept override;
 };
 
 //------------------------------------------------------------------------------
 
-struct epoll_write_op : epoll_op
+struct epoll_write_op final : epoll_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    iovec iovecs[max_buffers];
-    int iovec_count = 0;
+    // The most bytes one sendfile(2) call transfers
+    static constexpr std::size_t max_sendfile = 0x7ffff000;
+
+    iovec_array iovecs;
+    bool transfer_all = false;  // write_all, see "Transfer All"
+    int pass_fd = -1;           // write_with_descriptor
+
+    // send_file, see "File Transmission"
+    int file_fd = -1;
+    off_t file_offset = 0;
+    std::size_t file_remaining = 0;
+
+    // MSG_ZEROCOPY, see "Zero-Copy Sends"
+    descriptor_state* zc_desc = nullptr;
+    std::uint32_t zc_target = 0;
+    bool zc_waiting = false;
+    int zc_errn = 0;
 
     void reset() noexcept
     {
         epoll_op::reset();
-        iovec_count = 0;
+        iovecs.clear();
+        transfer_all = false;
+        file_fd = -1;
+        file_offset = 0;
+        file_remaining = 0;
+        zc_desc = nullptr;
+        zc_waiting = false;
+        zc_errn = 0;
+        pass_fd = -1;
+    }
+
+    // A send_file that stopped short without an error hit the file's end
+    bool at_eof() const noexcept override
+    {
+        return file_fd >= 0 && file_remaining != 0;
     }
 
     void perform_io() noexcept override
     {
+        if (wait_events)
+        {
+            perform_wait();
+            return;
+        }
+        if (zc_waiting)
+        {
+            wait_zero_copy();
+            return;
+        }
+        if (file_fd >= 0)
+        {
+            perform_send_file();
+            return;
+        }
+        if (transfer_all)
+        {
+            perform_transfer_all();
+            return;
+        }
+        if (pass_fd >= 0)
+        {
+            ssize_t n = send_with_fd(fd, iovecs.data(), iovecs.size(), pass_fd);
+            if (n >= 0)
+                complete(0, static_cast<std::size_t>(n));
+            else
+                complete(errno, 0);
+            return;
+        }
         msghdr msg{};
-        msg.msg_iov = iovecs;
-        msg.msg_iovlen = static_cast<std::size_t>(iovec_count);
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
 
-        ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        ssize_t n = send_part(msg);
         if (n >= 0)
-            complete(0, static_cast<std::size_t>(n));
+            finish(0, static_cast<std::size_t>(n));
         else
-            complete(errno, 0);
+            finish(errno, 0);
+    }
+
+    // Writes until the buffers are sent, as for epoll_read_op
+    void perform_transfer_all() noexcept
+    {
+        for (;;)
+        {
+            msghdr msg{};
+            msg.msg_iov = iovecs.data();
+            msg.msg_iovlen = iovecs.size();
+
+            ssize_t n = send_part(msg);
+            if (n <= 0)
+            {
+                finish(n < 0 ? errno : EIO, bytes_transferred);
+                return;
+            }
+            bytes_transferred += static_cast<std::size_t>(n);
+            if (consume_iovecs(iovecs, static_cast<std::size_t>(n)))
+            {
+                finish(0, bytes_transferred);
+                return;
+            }
+        }
+    }
+
+    // Sends from the file until the count is sent or the file ends.
+    // sendfile advances file_offset, so a parked op resumes in place.
+    void perform_send_file() noexcept
+    {
+        while (file_remaining > 0)
+        {
+            std::size_t n = file_remaining < max_sendfile
+                ? file_remaining : max_sendfile;
+            ssize_t r = ::sendfile(fd, file_fd, &file_offset, n);
+            if (r < 0)
+            {
+                complete(errno, bytes_transferred);
+                return;
+            }
+            if (r == 0)
+                break;
+            bytes_transferred += static_cast<std::size_t>(r);
+            file_remaining -= static_cast<std::size_t>(r);
+        }
+        complete(0, bytes_transferred);
     }
 
+    // Defined after descriptor_state
+    ssize_t send_part(msghdr& msg) noexcept;
+    void finish(int err, std::size_t n) noexcept;
+    void wait_zero_copy() noexcept;
+    bool zero_copy_pending() const noexcept;
+
     void cancel() noexcept override;
 };
 
 //------------------------------------------------------------------------------
 
+/** Clears TCP_CORK after a batch of handlers, see "Write Coalescing". */
+struct epoll_uncork_op : scheduler_op
+{
+    epoll_socket_impl* impl = nullptr;
+    std::shared_ptr<void> impl_ptr;
+    int fd = -1;
+
+    // Defined in sockets.cpp where epoll_socket_impl is complete
+    void operator()() override;
+
+    void destroy() override
+    {
+        impl_ptr.reset();
+    }
+};
+
+//------------------------------------------------------------------------------
+
 struct epoll_accept_op : epoll_op
 {
     int accepted_fd = -1;
@@ -343,29 +766,345 @@ struct epoll_accept_op : epoll_op
         impl_out = nullptr;
     }
 
+    // Defined in acceptors.cpp where epoll_acceptor_impl is complete
+    void perform_io() noexcept override;
+    void operator()() override;
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+/** State of one datagram receive or send, see "Datagrams". */
+struct epoll_datagram_op : epoll_op
+{
+    // The most messages one recvmmsg or sendmmsg call takes (UIO_MAXIOV)
+    static constexpr std::size_t max_batch = 1024;
+
+    struct batch_slot
+    {
+        iovec iov;
+        sockaddr_in addr;
+        union
+        {
+            cmsghdr align;
+            char buf[CMSG_SPACE(sizeof(int))];
+        } control;
+    };
+
+    // For stop_token cancellation, as socket_impl_ is for streams
+    epoll_udp_socket_impl* udp_impl_ = nullptr;
+
+    // One datagram
+    iovec_array iovecs;
+    sockaddr_in addr{};
+    endpoint* source_out = nullptr;
+
+    // A batch; the vectors keep their capacity between operations
+    std::span<udp_socket::message> batch;
+    std::vector<mmsghdr> mmsgs;
+    std::vector<batch_slot> slots;
+    bool want_control = false;
+
+    void reset() noexcept
+    {
+        epoll_op::reset();
+        iovecs.clear();
+        addr = {};
+        source_out = nullptr;
+        batch = {};
+        want_control = false;
+    }
+
+    bool at_eof() const noexcept override
+    {
+        return false;
+    }
+
+    /** Prepare the headers of a batch.
+
+        @throws std::bad_alloc if the headers cannot be allocated.
+    */
+    void assign_batch(std::span<udp_socket::message> msgs)
+    {
+        if (msgs.size() > max_batch)
+            msgs = msgs.first(max_batch);
+        batch = msgs;
+        if (mmsgs.size() < msgs.size())
+        {
+            mmsgs.resize(msgs.size());
+            slots.resize(msgs.size());
+        }
+    }
+
+    // Point each header at its slot; recvmmsg overwrites the lengths
+    void fill_headers() noexcept
+    {
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto& m = batch[i];
+            auto& sl = slots[i];
+            auto& h = mmsgs[i].msg_hdr;
+            sl.iov = iovec{m.buffer.data(), m.buffer.size()};
+            h = msghdr{};
+            h.msg_name = &sl.addr;
+            h.msg_namelen = sizeof(sl.addr);
+            h.msg_iov = &sl.iov;
+            h.msg_iovlen = 1;
+            if (want_control)
+            {
+                h.msg_control = sl.control.buf;
+                h.msg_controllen = sizeof(sl.control.buf);
+            }
+            mmsgs[i].msg_len = 0;
+        }
+    }
+
+    // Defined in udp_sockets.cpp where epoll_udp_socket_impl is complete
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct epoll_receive_from_op : epoll_datagram_op
+{
     void perform_io() noexcept override
     {
-        sockaddr_in addr{};
-        socklen_t addrlen = sizeof(addr);
-        int new_fd = ::accept4(fd, reinterpret_cast<sockaddr*>(&addr),
-                               &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (batch.data())
+        {
+            perform_batch();
+            return;
+        }
+
+        msghdr msg{};
+        msg.msg_name = &addr;
+        msg.msg_namelen = sizeof(addr);
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
+
+        ssize_t n = ::recvmsg(fd, &msg, 0);
+        if (n < 0)
+        {
+            complete(errno, 0);
+            return;
+        }
+        if (source_out)
+            *source_out = from_sockaddr_in(addr);
+
+        // The bytes that fit are delivered with the error
+        complete((msg.msg_flags & MSG_TRUNC) ? EMSGSIZE : 0,
+            static_cast<std::size_t>(n));
+    }
+
+    void perform_batch() noexcept
+    {
+        fill_headers();
+        int n = ::recvmmsg(fd, mmsgs.data(),
+            static_cast<unsigned>(batch.size()), 0, nullptr);
+        if (n < 0)
+        {
+            complete(errno, 0);
+            return;
+        }
 
-        if (new_fd >= 0)
+        for (int i = 0; i < n; ++i)
         {
-            accepted_fd = new_fd;
-            complete(0, 0);
+            auto& m = batch[i];
+            auto& h = mmsgs[i].msg_hdr;
+            m.size = mmsgs[i].msg_len;
+            m.peer = from_sockaddr_in(slots[i].addr);
+            m.truncated = (h.msg_flags & MSG_TRUNC) != 0;
+            m.segment_size = 0;
+#ifdef UDP_GRO
+            for (auto* c = CMSG_FIRSTHDR(&h); c; c = CMSG_NXTHDR(&h, c))
+            {
+                if (c->cmsg_level == SOL_UDP && c->cmsg_type == UDP_GRO)
+                {
+                    int size;
+                    std::memcpy(&size, CMSG_DATA(c), sizeof(size));
+                    m.segment_size = static_cast<std::size_t>(size);
+                }
+            }
+#endif
         }
+        complete(0, static_cast<std::size_t>(n));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+struct epoll_send_to_op : epoll_datagram_op
+{
+    void perform_io() noexcept override
+    {
+        if (batch.data())
+        {
+            perform_batch();
+            return;
+        }
+
+        msghdr msg{};
+        msg.msg_name = &addr;
+        msg.msg_namelen = sizeof(addr);
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
+
+        ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n >= 0)
+            complete(0, static_cast<std::size_t>(n));
         else
+            complete(errno, 0);
+    }
+
+    void perform_batch() noexcept
+    {
+        want_control = false;
+        fill_headers();
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto& h = mmsgs[i].msg_hdr;
+            slots[i].addr = to_sockaddr_in(batch[i].peer);
+#ifdef UDP_SEGMENT
+            // Per-message GSO overrides the socket's segment size
+            if (batch[i].segment_size != 0)
+            {
+                h.msg_control = slots[i].control.buf;
+                h.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+                auto* c = CMSG_FIRSTHDR(&h);
+                c->cmsg_level = SOL_UDP;
+                c->cmsg_type = UDP_SEGMENT;
+                c->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+                auto size = static_cast<std::uint16_t>(batch[i].segment_size);
+                std::memcpy(CMSG_DATA(c), &size, sizeof(size));
+            }
+#endif
+        }
+
+        int n = ::sendmmsg(fd, mmsgs.data(),
+            static_cast<unsigned>(batch.size()), MSG_NOSIGNAL);
+        if (n < 0)
         {
             complete(errno, 0);
+            return;
         }
+        for (int i = 0; i < n; ++i)
+            batch[i].size = mmsgs[i].msg_len;
+        complete(0, static_cast<std::size_t>(n));
     }
+};
 
-    // Defined in acceptors.cpp where epoll_acceptor_impl is complete
-    void operator()() override;
-    void cancel() noexcept override;
+//------------------------------------------------------------------------------
+
+/** Per-descriptor state for persistent epoll registration.
+
+    The descriptor is registered once with EPOLLIN | EPOLLOUT | EPOLLET
+    and `data.ptr` pointing at this object. Operations that would block
+    are parked in the matching slot until the reactor reports readiness.
+
+    All members are protected by `mutex`, except `epoll_fd`, which is
+    set before the descriptor is added to the epoll set and read only
+    by its owner when it is removed.
+
+    Instances are pooled by the scheduler and are not freed while it
+    is running. A reactor thread may still hold a pointer from an
+    earlier epoll_wait after the descriptor is closed, so a released
+    state is retired, and reused only once no such pointer can be
+    left; see "Descriptor Reuse" in scheduler.cpp.
+*/
+struct descriptor_state
+    : intrusive_list<descriptor_state>::node
+{
+    std::mutex mutex;
+    int fd = -1;
+
+    // The epoll set holding fd, see "Multiple Reactors" in scheduler.cpp
+    int epoll_fd = -1;
+
+    epoll_op* read_op = nullptr;
+    epoll_op* write_op = nullptr;
+    epoll_op* connect_op = nullptr;
+
+    // Edge seen while no operation was parked
+    bool read_ready = false;
+    bool write_ready = false;
+
+    // MSG_ZEROCOPY sends issued by the write op, and released by the
+    // kernel as counted by the reactor, see "Zero-Copy Sends"
+    bool zero_copy = false;
+    std::uint32_t zc_sent = 0;
+    std::atomic<std::uint32_t> zc_done{0};
+
+    // Transmit timestamps are drained from the error queue, and the
+    // latest is kept in nanoseconds since the epoch, see "Timestamps"
+    bool timestamping = false;
+    std::atomic<std::int64_t> tx_time{0};
+
+    // Retire epoch of the deregistration, written under the
+    // scheduler's pool mutex, see "Descriptor Reuse"
+    std::uint64_t retired = 0;
 };
 
+//------------------------------------------------------------------------------
+
+inline ssize_t
+epoll_write_op::
+send_part(msghdr& msg) noexcept
+{
+#ifdef MSG_ZEROCOPY
+    if (zc_desc)
+    {
+        ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+        if (n > 0)
+        {
+            zc_target = ++zc_desc->zc_sent;
+            return n;
+        }
+
+        // Over the limit of pinned pages; this part is copied instead
+        if (n == 0 || errno != ENOBUFS)
+            return n;
+    }
+#endif
+    return ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
+inline bool
+epoll_write_op::
+zero_copy_pending() const noexcept
+{
+    return static_cast<std::int32_t>(
+        zc_desc->zc_done.load(std::memory_order_acquire) - zc_target) < 0;
+}
+
+inline void
+epoll_write_op::
+finish(int err, std::size_t n) noexcept
+{
+    complete(err, n);
+    if (err == EAGAIN || err == EWOULDBLOCK)
+        return;
+    if (zc_desc && zero_copy_pending())
+    {
+        // Sent, but the kernel still reads the buffers; park until
+        // the reactor has counted their release
+        zc_waiting = true;
+        zc_errn = err;
+        errn = EAGAIN;
+    }
+}
+
+inline void
+epoll_write_op::
+wait_zero_copy() noexcept
+{
+    if (zero_copy_pending())
+    {
+        errn = EAGAIN;
+        return;
+    }
+    zc_waiting = false;
+    errn = zc_errn;
+}
+
 } // namespace boost::corosio::detail
 
 #endif // BOOST_COROSIO_HAS_EPOLL
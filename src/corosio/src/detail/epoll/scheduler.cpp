@@ -12,53 +12,88 @@
 #if BOOST_COROSIO_HAS_EPOLL
 
 #include "src/detail/epoll/scheduler.hpp"
+#include "src/detail/epoll/acceptors.hpp"
 #include "src/detail/epoll/op.hpp"
+#include "src/detail/epoll/sockets.hpp"
+#include "src/detail/epoll/udp_sockets.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/posix/file_service.hpp"
 #include "src/detail/posix/resolver_service.hpp"
 #include "src/detail/posix/signals.hpp"
+#include "src/detail/thread_stats.hpp"
 
 #include <boost/corosio/detail/except.hpp>
 #include <boost/corosio/detail/thread_local_ptr.hpp>
+#include <boost/corosio/parked_ops.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iterator>
 #include <limits>
+#include <span>
 
 #include <errno.h>
 #include <fcntl.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <signal.h>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/signalfd.h>
 #include <sys/socket.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
 /*
-    epoll Scheduler - Single Reactor Model
-    ======================================
+    epoll Scheduler - Reactor Threads
+    =================================
 
     This scheduler uses a thread coordination strategy to provide handler
     parallelism and avoid the thundering herd problem.
-    Instead of all threads blocking on epoll_wait(), one thread becomes the
-    "reactor" while others wait on a condition variable for handler work.
+    Instead of all threads blocking on epoll_wait(), a thread with nothing
+    to run becomes the thread of a free reactor while the others wait on
+    a condition variable for handler work. There is one reactor unless
+    epoll_options::reactors asks for more, see "Multiple Reactors".
 
     Thread Model
     ------------
-    - ONE thread runs epoll_wait() at a time (the reactor thread)
+    - Each reactor is run by at most ONE thread at a time, so up to
+      epoll_options::reactors threads are in epoll_wait() at once
     - OTHER threads wait on wakeup_event_ (condition variable) for handlers
     - When work is posted, exactly one waiting thread wakes via notify_one()
     - This matches Windows IOCP semantics where N posted items wake N threads
 
     Event Loop Structure (do_one)
     -----------------------------
-    1. Lock mutex, try to pop handler from queue
-    2. If got handler: execute it (unlocked), return
-    3. If queue empty and no reactor running: become reactor
+    1. With a local queue, pop from it without locking mutex_, except
+       every shared_queue_interval handlers, see "Per-Thread Queues"
+    2. Otherwise lock mutex_, drain injected_ and pop from the shared
+       queue, then from the local queue, then steal from another thread
+    3. If got handler: execute it (unlocked), return
+    4. If no handler and a reactor is free: become its thread
        - Run epoll_wait (unlocked), queue I/O completions, loop back
-    4. If queue empty and reactor running: wait on condvar for work
+    5. If no handler and every reactor is running: wait on condvar
 
-    The reactor_running_ flag ensures only one thread owns epoll_wait().
-    After the reactor queues I/O completions, it loops back to try getting
-    a handler, giving priority to handler execution over more I/O polling.
+    Each reactor's running flag ensures only one thread owns its
+    epoll_wait(). After a reactor queues I/O completions its thread
+    loops back to try getting a handler, giving priority to handler
+    execution over more I/O polling.
+
+    Wakeup Coalescing
+    -----------------
+    interrupt_reactor() writes the eventfd only when wakeup_pending was
+    clear, so a burst of posts costs one write and one wakeup per reactor
+    sleep. The reactor drains the eventfd before it clears the flag, so
+    every write made while the flag is clear is still unread when the
+    reactor next waits. An interrupt suppressed in between, while the
+    flag is still set, is covered by the wakeup already in progress:
+    the reactor's thread re-examines injected_, the queues, the work
+    count and the timers before it waits again.
 
     Wake Coordination (wake_one_thread_and_unlock)
     ----------------------------------------------
@@ -71,106 +106,699 @@
     N handlers would wake all threads (thundering herd). Now each post()
     wakes at most one thread, and that thread handles exactly one item.
 
+    Injection Queue
+    ---------------
+    post() from outside a local-queue thread pushes onto injected_, a
+    lock-free intrusive MPSC queue, without taking mutex_. Whoever holds
+    mutex_ in do_one() drains it into completed_ops_. A producer wakes
+    someone only when a consumer is parked: an idle worker (notified via
+    the condvar) or a reactor that announced it is about to block in
+    epoll_wait (interrupted via the eventfd). Consumers announce first
+    and re-check injected_ afterwards, so no post is left unnoticed.
+
+    Batched Posts
+    -------------
+    post_batch() builds every handler first, adds the batch to
+    outstanding_work_ in one update and links it into injected_ with
+    one exchange, so consumers see all of it or none. It then wakes
+    one parked thread per handler, all of them with a single
+    notify_all() when there are at least as many handlers, and
+    interrupts the reactor only if the idle threads cannot take the
+    whole batch. From inside a handler the batch joins the staged
+    posts instead, which handler_scope already publishes in one go.
+
+    Per-Thread Queues (concurrency_hint > 1)
+    ----------------------------------------
+    Every run() frame owns an epoll_thread_queue. post() from a thread
+    already inside the scheduler pushes to that queue under its own small
+    mutex, and do_one() pops from it without touching mutex_. Every
+    shared_queue_interval handlers the thread visits completed_ops_ so
+    reactor completions and external posts are not starved. A thread
+    that finds both queues empty steals the front handler, plus half of
+    the rest, from another thread's queue before becoming the reactor or
+    waiting. Handlers remaining when a thread leaves run() are moved to
+    completed_ops_.
+
+    Completion Affinity
+    -------------------
+    With epoll_options::completion_affinity and work stealing, each
+    local queue gets an id and an operation that parks records the id
+    of the thread that parked it (affinity_home). When the reactor
+    completes it, route_affine() pushes it to that queue if the owner
+    is in a handler, or is the reactor thread itself, instead of to
+    completed_ops_; the owner pops it next, with the connection's
+    state still in its cache. An owner waiting for work gets nothing
+    routed, since waking it specifically would cost more than the
+    cache misses saved. busy_since holds when the owner's current
+    handler started, or zero between handlers, and steal_work() skips
+    a queue whose owner is within epoll_options::affinity_steal_delay
+    of that. A thread that skipped one waits at most that long, in
+    the reactor or on the condvar, before looking again.
+
+    Single-Threaded Mode (concurrency_hint == 1)
+    --------------------------------------------
+    The run() frame gets an unshared local queue. Posts made from inside
+    run() push to it and do_one() pops from it with no mutex, condvar,
+    atomic queue counter or reactor handshake. Posts from other threads
+    (resolver workers, for example) still use injected_, and the slow
+    path is unchanged for them and for the reactor. outstanding_work_
+    stays atomic since work can still be started elsewhere.
+
+    Reactor Completions
+    -------------------
+    In single-threaded mode, with epoll_options::inline_completions
+    set, run() and poll() take up to that many handlers from the front
+    of completed_ops_ in one go right after the reactor returns, and
+    run them with the mutex released, instead of taking them one at a
+    time through do_one(). The reactor still splices what it completed
+    into completed_ops_, which costs a pointer splice and keeps the
+    completions in order behind posted work and in their priority
+    lanes; only the do_one() round per handler, its locking and its
+    queue checks, is skipped. Each handler returns before the next one
+    starts, so the stack does not grow with the batch, and the bound
+    keeps a large harvest from holding up posted work and timers. The
+    reactor role is already given up, so a handler may still call
+    run() on the same context. Handlers a throwing handler or stop()
+    leaves in the batch go back to the front of the queue. run_one()
+    and poll_one() never batch.
+
+    Priority Lanes
+    --------------
+    completed_ops_ is an op_lanes: handlers flagged high_priority are
+    popped first, a bounded number in a row. Flagged handlers always
+    take the locked path to the shared queue, skipping the lock-free
+    injection queue and the local queues, and while any are queued
+    do_one() does not favour local work. The reactor routes what it
+    completes by flag only once a socket has asked for priority, see
+    use_priority_lanes(), so others pay nothing for the lanes.
+
+    Descriptor Registration
+    -----------------------
+    Each socket and acceptor registers its fd once, edge-triggered for
+    both directions, with data.ptr pointing at a pooled descriptor_state.
+    Operations that would block park in a slot of that state; the reactor
+    performs their I/O when an edge arrives and queues the finished ones
+    in a local list, splicing it into completed_ops_ under a single lock.
+    Edges that arrive with no parked operation set a ready flag, letting
+    the next operation retry immediately instead of waiting forever.
+
+    Descriptor Reuse
+    ----------------
+    A reactor may have harvested an event for a descriptor just before
+    another thread closes it, and still hold the descriptor_state
+    pointer in its event buffer. Were the state handed at once to the
+    next socket opened, that event, an EPOLLERR or EPOLLHUP of the old
+    fd, would run against the new socket's operations. So
+    deregister_descriptor() moves the state to desc_retired_, stamped
+    with the next value of retire_epoch_, and register_descriptor()
+    reuses a retired state only once every reactor is idle or began
+    its current harvest after that stamp.
+
+    Each reactor publishes, in harvest_epoch, the retire epoch it read
+    before calling epoll_wait, and idle_epoch once it has processed
+    the events. It stores zero first, pinning every retired state
+    while it reads the epoch. A harvest that read an epoch at or past
+    a state's stamp began after the EPOLL_CTL_DEL that preceded the
+    stamp, so it cannot hold the state. Secondaries polled through
+    their watch are covered by the primary's harvest, which began
+    earlier. A reactor blocked in epoll_wait keeps retired states
+    pinned, so closes during a long wait allocate new states instead.
+
+    Multiple Reactors
+    -----------------
+    With epoll_options::reactors above one the scheduler keeps that
+    many epoll_reactor instances, each with its own epoll set, eventfd,
+    harvest buffer and flags; everything above about "the reactor"
+    then holds per instance. register_descriptor() hands them out in
+    turn and records the set in descriptor_state::epoll_fd. A thread
+    with no handler to run takes the primary, reactors_[0], if it is
+    free, then the secondary it ran last, then any free secondary, and
+    waits on the condvar only when every reactor is running. Wakeups
+    interrupt one running reactor, the primary first, and stop() and
+    the last work_finished() interrupt all of them.
+
+    Only the primary holds the timerfd and the signalfd, and only the
+    primary thread processes expired timers; secondaries block
+    without a timeout. Each secondary's epoll fd is also in the
+    primary's set, EPOLLIN | EPOLLONESHOT, marked by data.ptr pointing
+    at the secondary, so a context run by fewer threads than it has
+    reactors still sees every descriptor. When that watch fires
+    poll_nested() harvests the secondary with a zero timeout and arms
+    the watch again, unless a thread is already waiting in it. Then
+    the watch is left off, so a secondary with a thread of its own
+    stops waking the primary. It is armed again by the thread that
+    releases the secondary while the primary runs, or by the next
+    thread to take the primary, so whenever a thread waits in the
+    primary, every free secondary is watched. unwatched_ counts the
+    watches left off, and the flags and the epoll_ctl calls that
+    change them are under mutex_.
+
     Work Counting
     -------------
     outstanding_work_ tracks pending operations. When it hits zero, run()
     returns. Each operation increments on start, decrements on completion.
 
+    Posts made by a handler running inside run() are counted in its
+    thread's frame instead and, except in single-threaded mode where
+    the local queue is already private, staged there too. When the
+    handler returns, handler_scope adds the staged count less one for
+    the handler itself to outstanding_work_, then publishes the staged
+    handlers. A handler that posts exactly one continuation therefore
+    costs no atomic work-count update at all. The count never drops
+    below the true amount of work: staged handlers cannot run, from
+    any thread, before they are counted. A nested run() on the same
+    scheduler publishes the enclosing handler's staged posts first.
+
+    Busy Polling
+    ------------
+    When epoll_options asks for it, a reactor that would block first
+    calls epoll_wait with a zero timeout, either a fixed number of times
+    or until a deadline passes, stopping early on events or injected
+    posts. The sleeping flag stays clear while spinning, so producers
+    skip the eventfd write; the spin loop sees their posts directly.
+    The remaining blocking timeout is reduced by the time spent.
+
+    Batching
+    --------
+    One epoll_wait harvests up to epoll_options::max_events events into
+    a buffer owned by the scheduler; only the reactor thread touches it.
+    With a nonzero handler_budget, a thread that has run that many
+    handlers from completed_ops_ since the last poll takes the reactor
+    role for a zero-timeout poll before running more, so a long queue
+    cannot delay readiness events and timers indefinitely.
+
     Timer Integration
     -----------------
-    Timers are handled by timer_service. The reactor adjusts epoll_wait
-    timeout to wake for the nearest timer expiry. When a new timer is
-    scheduled earlier than current, timer_service calls interrupt_reactor()
-    to re-evaluate the timeout.
+    Timers are handled by timer_service. By default a timerfd in the
+    epoll set, marked by data.ptr == &timer_fd_, is armed with an
+    absolute CLOCK_MONOTONIC time (steady_clock's epoch) for the nearest
+    expiry. It is re-armed only when that expiry changes: when
+    timer_service reports a new earliest timer, and after the reactor
+    processes expired timers. The read of the nearest expiry and the
+    timerfd_settime() call happen together under timerfd_mutex_, so the
+    last writer always arms the latest head. epoll_wait then needs no
+    timer timeout and arming a timer never interrupts the reactor.
+
+    Without a timerfd the reactor adjusts the epoll_wait timeout, rounded
+    up to milliseconds, to wake for the nearest timer expiry. When a new
+    timer is scheduled earlier than current, timer_service calls
+    interrupt_reactor() to re-evaluate the timeout.
+
+    Signal Delivery
+    ---------------
+    With epoll_options::use_signalfd, a signalfd in the epoll set,
+    marked by data.ptr == &signal_fd_, holds the signals that signal
+    sets of this context registered. The signal service keeps its mask
+    through watch_signal() and blocks each signal in the registering
+    thread. The reactor reads pending signals and completes waits
+    through deliver_posix_signal(), from its own loop, so a signal
+    costs no handler trampoline and no eventfd write.
+
+    Deferred Services
+    -----------------
+    Only the timer service is made with the scheduler, since the
+    reactor arms its timeout from it. The socket, acceptor, UDP,
+    resolver, file and signal services are made by
+    make_deferred_service() the first time an I/O object looks one
+    up and misses (see find_deferred_service), so a context that
+    only runs coroutines and timers never pays for them. Creation is
+    serialized by deferred_mutex_ and rechecks the lookup, so racing
+    first uses agree on one instance. The acceptor service makes the
+    socket service first, keeping the shutdown order of eager
+    construction, where the socket service is shut down last.
+
+    Statistics
+    ----------
+    Handler, park and blocked-time counts live in the thread_stats of
+    each run() frame (see thread_stats.hpp) and are summed on read. The
+    reactor counters are kept per reactor, since mutex_ lets only one
+    thread hold the role of each at a time. The queue depth peak is
+    raised whenever handlers are added to completed_ops_ or a local
+    queue, from the sizes those queues already keep. While a loop
+    monitor is attached, do_one() also times each handler it runs with
+    handler_timer.
+
+    Embedding
+    ---------
+    A host event loop waits on the primary epoll fd and calls
+    poll_ready(), which takes a free reactor for one zero-timeout
+    pass and then runs handlers as poll() does, but never stops the
+    scheduler for lack of work. The fd is readable whenever there is
+    something to do: ready descriptors, the secondaries' watches, the
+    timerfd and the signalfd are all in its set, and so is the
+    eventfd. Before returning, poll_ready() announces the primary as
+    sleeping, as a reactor does before blocking, so posts from
+    outside write the eventfd while the host waits. Without a
+    timerfd an earlier timer interrupts the reactor anyway, and
+    poll_ready_timeout() gives the host the time to the nearest one.
 */
 
 namespace boost::corosio::detail {
 
+/** Run queue owned by one thread inside run().
+
+    Only the owning thread pushes, so its handlers stay on the thread
+    that posted them. Other threads may pop from the front when they
+    run out of work, unless the scheduler is single-threaded. `size`
+    mirrors the queue length so thieves can skip empty queues without
+    taking the mutex.
+*/
+struct epoll_thread_queue
+{
+    std::mutex mutex;
+    op_queue ops;
+    std::atomic<std::size_t> size{0};
+
+    // Owner-only counter forcing a periodic look at the shared queue
+    unsigned tick = 0;
+
+    // See "Completion Affinity"; the id is set under the scheduler's
+    // mutex, busy_since in steady nanoseconds by the owner
+    std::uint32_t id = 0;
+    std::atomic<std::int64_t> busy_since{0};
+
+    // False in single-threaded mode, where no other thread can see
+    // the queue and the mutex and size counter are skipped
+    bool shared = true;
+
+    // Returns the queue's new length
+    std::size_t push(scheduler_op* h) noexcept
+    {
+        if (!shared)
+        {
+            ops.push(h);
+            return ops.size();
+        }
+        std::lock_guard lock(mutex);
+        ops.push(h);
+        size.fetch_add(1, std::memory_order_relaxed);
+        return ops.size();
+    }
+
+    scheduler_op* pop() noexcept
+    {
+        if (!shared)
+            return ops.pop();
+        if (size.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+        std::lock_guard lock(mutex);
+        auto* h = ops.pop();
+        if (h)
+            size.fetch_sub(1, std::memory_order_relaxed);
+        return h;
+    }
+};
+
 namespace {
 
 struct scheduler_context
 {
     epoll_scheduler const* key;
     scheduler_context* next;
+    epoll_thread_queue* queue;
+    thread_stats* stats;
+
+    // Secondary reactor this thread ran last, see "Multiple Reactors"
+    std::size_t reactor = 0;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
 };
 
 corosio::detail::thread_local_ptr<scheduler_context> context_stack;
 
-struct thread_context_guard
+// Returns the innermost run() frame of `sched` on this thread
+scheduler_context*
+find_context(epoll_scheduler const* sched) noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
+
+// Returns the local queue of the innermost run() of `sched` on this thread
+epoll_thread_queue*
+find_thread_queue(epoll_scheduler const* sched) noexcept
+{
+    auto* c = find_context(sched);
+    return c ? c->queue : nullptr;
+}
+
+// Visit the shared queue at least this often while local work remains
+constexpr unsigned shared_queue_interval = 61;
+
+// Steady clock reading for busy_since, never zero
+std::int64_t
+busy_clock() noexcept
+{
+    auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return ns != 0 ? static_cast<std::int64_t>(ns) : 1;
+}
+
+// Adds handler counts, saturating
+std::size_t
+add_count(std::size_t n, std::size_t k) noexcept
+{
+    constexpr auto max = (std::numeric_limits<std::size_t>::max)();
+    return n > max - k ? max : n + k;
+}
+
+} // namespace
+
+/** Brackets one handler invocation inside run().
+
+    Posts made while the scope is active are counted in the frame, and
+    staged there unless the local queue is private. The destructor
+    settles the count, including the handler's own unit of work, and
+    publishes what was staged.
+*/
+class epoll_scheduler::handler_scope
+{
+    epoll_scheduler const* sched_;
+    scheduler_context* frame_;
+
+public:
+    handler_scope(
+        epoll_scheduler const* sched,
+        scheduler_context* frame) noexcept
+        : sched_(sched)
+        , frame_(frame)
+    {
+        frame_->in_handler = true;
+        if (sched_->affinity_ && frame_->queue)
+            frame_->queue->busy_since.store(
+                busy_clock(), std::memory_order_relaxed);
+    }
+
+    ~handler_scope()
+    {
+        frame_->in_handler = false;
+        if (sched_->affinity_ && frame_->queue)
+            frame_->queue->busy_since.store(0, std::memory_order_relaxed);
+        publish(sched_, *frame_, -1);
+    }
+
+    handler_scope(handler_scope const&) = delete;
+    handler_scope& operator=(handler_scope const&) = delete;
+
+    // Folds the frame's private work, plus `adjust`, into
+    // outstanding_work_ and then releases the staged handlers
+    static void
+    publish(
+        epoll_scheduler const* sched,
+        scheduler_context& frame,
+        long adjust) noexcept
+    {
+        long staged = frame.private_work;
+        long n = staged + adjust;
+        frame.private_work = 0;
+
+        if (n > 0)
+            sched->outstanding_work_.fetch_add(n, std::memory_order_relaxed);
+
+        if (!frame.private_ops.empty())
+        {
+            auto* q = frame.queue;
+            if (q && q->shared)
+            {
+                // One lock for the whole batch; wake a thief only when
+                // there is more than the owner will run next
+                bool surplus = staged > 1 ||
+                    q->size.load(std::memory_order_relaxed) > 0;
+                std::size_t depth;
+                {
+                    std::lock_guard lock(q->mutex);
+                    q->ops.splice(frame.private_ops);
+                    q->size.fetch_add(
+                        static_cast<std::size_t>(staged),
+                        std::memory_order_relaxed);
+                    depth = q->ops.size();
+                }
+                raise_peak(sched->queue_peak_, depth);
+                if (surplus &&
+                    sched->idle_thread_count_.load(std::memory_order_relaxed) > 0)
+                {
+                    std::unique_lock lock(sched->mutex_);
+                    sched->wake_one_thread_and_unlock(lock);
+                }
+            }
+            else
+            {
+                while (auto* h = frame.private_ops.pop())
+                    sched->enqueue(h);
+            }
+        }
+
+        // Only the finished handler's own unit can make this negative
+        if (n < 0)
+            sched->work_finished();
+    }
+};
+
+/** Marks the calling thread as running inside the scheduler.
+
+    Pushes a frame on the thread's context stack and attaches a local
+    queue when work stealing or single-threaded mode is enabled; with
+    work stealing the queue is also published to other threads. On
+    exit any handlers left in the local queue move to the shared queue.
+*/
+class epoll_scheduler::run_scope
 {
+    epoll_scheduler const* sched_;
+    epoll_thread_queue queue_;
+    thread_stats stats_;
     scheduler_context frame_;
 
-    explicit thread_context_guard(
-        epoll_scheduler const* ctx) noexcept
-        : frame_{ctx, context_stack.get()}
+public:
+    explicit run_scope(epoll_scheduler const* sched)
+        : sched_(sched)
+        , frame_{sched, context_stack.get(), nullptr, &stats_}
     {
+        // A handler running a nested loop must not hide its posts,
+        // and keeps counting into the outer frame
+        if (auto* outer = find_context(sched))
+        {
+            if (outer->in_handler)
+                handler_scope::publish(sched, *outer, 0);
+            frame_.stats = outer->stats;
+        }
+        else
+        {
+            sched_->stats_registry_.attach(stats_);
+        }
+
+        if (sched_->work_stealing_)
+        {
+            std::lock_guard lock(sched_->mutex_);
+            if (++sched_->next_queue_id_ == 0)
+                ++sched_->next_queue_id_;
+            queue_.id = sched_->next_queue_id_;
+            sched_->thread_queues_.push_back(&queue_);
+            frame_.queue = &queue_;
+        }
+        else if (sched_->single_threaded_)
+        {
+            queue_.shared = false;
+            frame_.queue = &queue_;
+        }
         context_stack.set(&frame_);
     }
 
-    ~thread_context_guard() noexcept
+    ~run_scope()
     {
         context_stack.set(frame_.next);
+
+        if (frame_.stats == &stats_)
+            sched_->stats_registry_.detach(stats_);
+
+        if (!frame_.queue)
+            return;
+
+        std::unique_lock lock(sched_->mutex_);
+        if (queue_.shared)
+        {
+            auto& queues = sched_->thread_queues_;
+            queues.erase(std::find(queues.begin(), queues.end(), &queue_));
+        }
+
+        bool leftover;
+        {
+            std::lock_guard qlock(queue_.mutex);
+            leftover = !queue_.ops.empty();
+            sched_->completed_ops_.splice(queue_.ops);
+            queue_.size.store(0, std::memory_order_relaxed);
+        }
+        raise_peak(sched_->queue_peak_, sched_->completed_ops_.size());
+
+        if (leftover)
+            sched_->wake_one_thread_and_unlock(lock);
     }
-};
 
-} // namespace
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
+};
 
 epoll_scheduler::
 epoll_scheduler(
     capy::execution_context& ctx,
-    int)
-    : epoll_fd_(-1)
-    , event_fd_(-1)
+    int concurrency_hint,
+    epoll_options const& opts)
+    : ctx_(ctx)
+    , opts_(opts)
     , outstanding_work_(0)
     , stopped_(false)
     , shutdown_(false)
-    , reactor_running_(false)
-    , reactor_interrupted_(false)
     , idle_thread_count_(0)
+    , work_stealing_(concurrency_hint > 1)
+    , single_threaded_(concurrency_hint == 1)
+    , affinity_(opts.completion_affinity && concurrency_hint > 1)
+    , steal_delay_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        opts.affinity_steal_delay).count())
 {
-    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
-    if (epoll_fd_ < 0)
-        detail::throw_system_error(make_err(errno), "epoll_create1");
+    if (opts_.busy_poll_duration.count() > 0)
+        poll_mode_ = busy_poll_mode::deadline;
+    else if (opts_.busy_poll_spins > 0)
+        poll_mode_ = busy_poll_mode::spin;
 
-    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
-    if (event_fd_ < 0)
+    // One thread gains nothing from more reactors
+    if (!single_threaded_)
+        reactor_count_ = (std::max)(opts_.reactors, 1u);
+    reactors_ = std::make_unique<epoll_reactor[]>(reactor_count_);
+
+    for (std::size_t i = 0; i < reactor_count_; ++i)
     {
-        int errn = errno;
-        ::close(epoll_fd_);
-        detail::throw_system_error(make_err(errn), "eventfd");
+        auto& r = reactors_[i];
+        r.events.resize((std::max)(opts_.max_events, 1u));
+
+        r.epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (r.epoll_fd < 0)
+        {
+            int errn = errno;
+            close_reactors();
+            detail::throw_system_error(make_err(errn), "epoll_create1");
+        }
+
+        r.event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (r.event_fd < 0)
+        {
+            int errn = errno;
+            close_reactors();
+            detail::throw_system_error(make_err(errn), "eventfd");
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if (::epoll_ctl(r.epoll_fd, EPOLL_CTL_ADD, r.event_fd, &ev) < 0)
+        {
+            int errn = errno;
+            close_reactors();
+            detail::throw_system_error(make_err(errn), "epoll_ctl");
+        }
+
+        // Secondaries are watched from the primary, see "Multiple Reactors"
+        if (i > 0)
+        {
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.ptr = &r;
+            if (::epoll_ctl(reactors_[0].epoll_fd,
+                    EPOLL_CTL_ADD, r.epoll_fd, &ev) < 0)
+            {
+                int errn = errno;
+                close_reactors();
+                detail::throw_system_error(make_err(errn), "epoll_ctl");
+            }
+        }
     }
 
+    int const epoll_fd = reactors_[0].epoll_fd;
     epoll_event ev{};
-    ev.events = EPOLLIN;
-    ev.data.ptr = nullptr;
-    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &ev) < 0)
+
+    // Without a timerfd, timers fall back to the epoll_wait timeout.
+    // Virtual time needs the timeout, computed afresh before each wait
+    if (opts_.use_timerfd && !opts_.timers.virtual_time)
     {
-        int errn = errno;
-        ::close(event_fd_);
-        ::close(epoll_fd_);
-        detail::throw_system_error(make_err(errn), "epoll_ctl");
+        timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timer_fd_ >= 0)
+        {
+            ev.events = EPOLLIN;
+            ev.data.ptr = &timer_fd_;
+            if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd_, &ev) < 0)
+            {
+                ::close(timer_fd_);
+                timer_fd_ = -1;
+            }
+        }
     }
 
-    timer_svc_ = &get_timer_service(ctx, *this);
-    timer_svc_->set_on_earliest_changed(
-        timer_service::callback(
-            this,
-            [](void* p) { static_cast<epoll_scheduler*>(p)->interrupt_reactor(); }));
-
-    // Initialize resolver service
-    get_resolver_service(ctx, *this);
-
-    // Initialize signal service
-    get_signal_service(ctx, *this);
+    timer_svc_ = &get_timer_service(ctx, *this, opts_.timers);
+    if (timer_fd_ >= 0)
+        timer_svc_->set_on_earliest_changed(
+            timer_service::callback(
+                this,
+                [](void* p) { static_cast<epoll_scheduler*>(p)->update_timerfd(); }));
+    else
+        timer_svc_->set_on_earliest_changed(
+            timer_service::callback(
+                this,
+                [](void* p) { static_cast<epoll_scheduler*>(p)->interrupt_reactor(); }));
+
+    // The resolver, file and signal services are deferred, see
+    // "Deferred Services". The signalfd is cheap and made up front,
+    // so signal_fd_ never changes while the reactor runs.
+    if (opts_.use_signalfd)
+    {
+        sigset_t none;
+        sigemptyset(&none);
+        signal_fd_ = ::signalfd(-1, &none, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (signal_fd_ >= 0)
+        {
+            ev.events = EPOLLIN;
+            ev.data.ptr = &signal_fd_;
+            if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd_, &ev) < 0)
+            {
+                ::close(signal_fd_);
+                signal_fd_ = -1;
+            }
+        }
+    }
 }
 
 epoll_scheduler::
 ~epoll_scheduler()
 {
-    if (event_fd_ >= 0)
-        ::close(event_fd_);
-    if (epoll_fd_ >= 0)
-        ::close(epoll_fd_);
+    while (auto* desc = desc_live_.pop_front())
+        delete desc;
+    while (auto* desc = desc_free_.pop_front())
+        delete desc;
+    while (auto* desc = desc_retired_.pop_front())
+        delete desc;
+
+    if (signal_fd_ >= 0)
+        ::close(signal_fd_);
+    if (timer_fd_ >= 0)
+        ::close(timer_fd_);
+    close_reactors();
+}
+
+void
+epoll_scheduler::
+close_reactors() noexcept
+{
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+    {
+        auto& r = reactors_[i];
+        if (r.event_fd >= 0)
+            ::close(r.event_fd);
+        if (r.epoll_fd >= 0)
+            ::close(r.epoll_fd);
+        r.event_fd = -1;
+        r.epoll_fd = -1;
+    }
 }
 
 void
@@ -180,6 +808,7 @@ shutdown()
     {
         std::unique_lock lock(mutex_);
         shutdown_ = true;
+        completed_ops_.take_all(injected_);
 
         while (auto* h = completed_ops_.pop())
         {
@@ -191,62 +820,271 @@ shutdown()
 
     outstanding_work_.store(0, std::memory_order_release);
 
-    if (event_fd_ >= 0)
-        interrupt_reactor();
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+        interrupt_reactor(reactors_[i]);
 
     wakeup_event_.notify_all();
 }
 
+namespace {
+
+// Resumes a posted coroutine
+struct post_handler final
+    : scheduler_op
+    , recycling_op<post_handler>
+{
+    capy::coro h_;
+
+    explicit
+    post_handler(capy::coro h)
+        : h_(h)
+    {
+    }
+
+    ~post_handler() = default;
+
+    void operator()() override
+    {
+        auto h = h_;
+        delete this;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        h.resume();
+    }
+
+    void destroy() override
+    {
+        delete this;
+    }
+
+    void const* target() const noexcept override
+    {
+        return h_.address();
+    }
+};
+
+// Makes a post_handler per coroutine; none leak if one throws
+void
+make_post_handlers(std::span<capy::coro const> hs, op_queue& ops)
+{
+    try
+    {
+        for (auto h : hs)
+            ops.push(new post_handler(h));
+    }
+    catch (...)
+    {
+        while (auto* op = ops.pop())
+            op->destroy();
+        throw;
+    }
+}
+
+} // namespace
+
 void
 epoll_scheduler::
 post(capy::coro h) const
 {
-    struct post_handler final
-        : scheduler_op
-    {
-        capy::coro h_;
+    auto ph = std::make_unique<post_handler>(h);
+    post(ph.release());
+}
+
+void
+epoll_scheduler::
+post_high_priority(capy::coro h) const
+{
+    auto ph = std::make_unique<post_handler>(h);
+    ph->high_priority = true;
+    post(ph.release());
+}
 
-        explicit
-        post_handler(capy::coro h)
-            : h_(h)
+void
+epoll_scheduler::
+post_batch(std::span<capy::coro const> hs) const
+{
+    op_queue ops;
+    make_post_handlers(hs, ops);
+    auto const n = ops.size();
+    if (n == 0)
+        return;
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        c->private_work += static_cast<long>(n);
+        if (single_threaded_)
         {
+            while (auto* h = ops.pop())
+                raise_peak(queue_peak_, c->queue->push(h));
         }
+        else
+            c->private_ops.splice(ops);
+        return;
+    }
+
+    outstanding_work_.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+    injected_.push_all(ops);
+    wake_for_batch(n);
+}
+
+void
+epoll_scheduler::
+wake_for_batch(std::size_t n) const
+{
+    // See "Batched Posts": one wakeup per handler, up to the number
+    // of parked threads, and the reactor if that is not enough
+    auto const idle = static_cast<std::size_t>(
+        idle_thread_count_.load(std::memory_order_seq_cst));
+    if (idle > 0)
+    {
+        std::lock_guard lock(mutex_);
+        if (n >= idle)
+            wakeup_event_.notify_all();
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                wakeup_event_.notify_one();
+    }
+    if (n > idle)
+        interrupt_sleeping();
+}
+
+void
+epoll_scheduler::
+post(scheduler_op* h) const
+{
+    // See "Priority Lanes"
+    if (h->high_priority)
+    {
+        outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+        enqueue_high_priority(h);
+        return;
+    }
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        if (single_threaded_)
+            raise_peak(queue_peak_, c->queue->push(h));
+        else
+            c->private_ops.push(h);
+        return;
+    }
 
-        ~post_handler() = default;
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(h);
+}
 
-        void operator()() override
+void
+epoll_scheduler::
+enqueue(scheduler_op* h) const
+{
+    if (single_threaded_)
+    {
+        // The only thread inside run() needs no lock and no wakeup
+        if (auto* q = find_thread_queue(this))
         {
-            auto h = h_;
-            delete this;
-            std::atomic_thread_fence(std::memory_order_acquire);
-            h.resume();
+            raise_peak(queue_peak_, q->push(h));
+            return;
         }
-
-        void destroy() override
+    }
+    else if (work_stealing_)
+    {
+        if (auto* q = find_thread_queue(this))
         {
-            delete this;
+            // The owner will run this itself; only wake a thief when
+            // there is surplus work and someone idle to take it
+            bool surplus = q->size.load(std::memory_order_relaxed) > 0;
+            raise_peak(queue_peak_, q->push(h));
+            if (surplus && idle_thread_count_.load(std::memory_order_relaxed) > 0)
+            {
+                std::unique_lock lock(mutex_);
+                wake_one_thread_and_unlock(lock);
+            }
+            return;
         }
-    };
+    }
 
-    auto ph = std::make_unique<post_handler>(h);
-    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    injected_.push(h);
 
-    std::unique_lock lock(mutex_);
-    completed_ops_.push(ph.release());
-    wake_one_thread_and_unlock(lock);
+    // Only pay for a wakeup when a consumer is actually parked. The
+    // seq_cst push above pairs with the seq_cst announcements made by
+    // consumers before their final emptiness check.
+    if (idle_thread_count_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(mutex_);
+        wakeup_event_.notify_one();
+    }
+    else
+    {
+        interrupt_sleeping();
+    }
 }
 
 void
 epoll_scheduler::
-post(scheduler_op* h) const
+enqueue_high_priority(scheduler_op* h) const
 {
-    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
-
     std::unique_lock lock(mutex_);
     completed_ops_.push(h);
+    raise_peak(queue_peak_, completed_ops_.size());
     wake_one_thread_and_unlock(lock);
 }
 
+scheduler_op*
+epoll_scheduler::
+steal_work(epoll_thread_queue* self, bool& deferred) const
+{
+    // Caller holds mutex_, which keeps thread_queues_ stable
+    auto const n = thread_queues_.size();
+    std::int64_t const now = affinity_ ? busy_clock() : 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto* victim = thread_queues_[(steal_cursor_ + i) % n];
+        if (victim == self || victim->size.load(std::memory_order_relaxed) == 0)
+            continue;
+
+        // A thread only briefly busy keeps its work, see "Completion Affinity"
+        if (affinity_)
+        {
+            auto const since = victim->busy_since.load(std::memory_order_relaxed);
+            if (since != 0 && now - since < steal_delay_ns_)
+            {
+                deferred = true;
+                continue;
+            }
+        }
+
+        std::unique_lock vlock(victim->mutex, std::try_to_lock);
+        if (!vlock.owns_lock())
+            continue;
+
+        auto* h = victim->ops.pop();
+        if (!h)
+            continue;
+
+        // Take up to half of the remaining work along with it
+        std::size_t avail = victim->size.load(std::memory_order_relaxed) - 1;
+        std::size_t take = self ? avail / 2 : 0;
+        op_queue batch;
+        for (std::size_t k = 0; k < take; ++k)
+            batch.push(victim->ops.pop());
+        victim->size.fetch_sub(take + 1, std::memory_order_relaxed);
+        vlock.unlock();
+
+        if (take > 0)
+        {
+            std::lock_guard slock(self->mutex);
+            self->ops.splice(batch);
+            self->size.fetch_add(take, std::memory_order_relaxed);
+        }
+
+        steal_cursor_ = (steal_cursor_ + i + 1) % n;
+        return h;
+    }
+    return nullptr;
+}
+
 void
 epoll_scheduler::
 on_work_started() noexcept
@@ -285,7 +1123,8 @@ stop()
             std::lock_guard lock(mutex_);
             wakeup_event_.notify_all();
         }
-        interrupt_reactor();
+        for (std::size_t i = 0; i < reactor_count_; ++i)
+            interrupt_reactor(reactors_[i]);
     }
 }
 
@@ -316,12 +1155,11 @@ run()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
 
     std::size_t n = 0;
-    while (do_one(-1))
-        if (n != (std::numeric_limits<std::size_t>::max)())
-            ++n;
+    while (std::size_t k = do_one(-1, true))
+        n = add_count(n, k);
     return n;
 }
 
@@ -338,7 +1176,7 @@ run_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(-1);
 }
 
@@ -355,7 +1193,7 @@ wait_one(long usec)
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(usec);
 }
 
@@ -372,12 +1210,11 @@ poll()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
 
     std::size_t n = 0;
-    while (do_one(0))
-        if (n != (std::numeric_limits<std::size_t>::max)())
-            ++n;
+    while (std::size_t k = do_one(0, true))
+        n = add_count(n, k);
     return n;
 }
 
@@ -394,63 +1231,362 @@ poll_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(0);
 }
 
-void
+std::size_t
 epoll_scheduler::
-register_fd(int fd, epoll_op* op, std::uint32_t events) const
+poll_ready()
 {
-    epoll_event ev{};
-    ev.events = events;
-    ev.data.ptr = op;
-    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
-        detail::throw_system_error(make_err(errno), "epoll_ctl ADD");
-}
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
 
-void
-epoll_scheduler::
-modify_fd(int fd, epoll_op* op, std::uint32_t events) const
-{
-    epoll_event ev{};
-    ev.events = events;
-    ev.data.ptr = op;
-    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) < 0)
-        detail::throw_system_error(make_err(errno), "epoll_ctl MOD");
-}
+    run_scope scope(this);
+    auto* frame = find_context(this);
 
-void
-epoll_scheduler::
-unregister_fd(int fd) const
-{
-    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    // One pass over a free reactor harvests what made the fd
+    // readable, see "Embedding"
+    {
+        std::unique_lock lock(mutex_);
+        if (auto* r = acquire_reactor(frame->reactor))
+        {
+            r->interrupted = true;
+            run_reactor(*r, lock, *frame->stats);
+            release_reactor(*r);
+        }
+    }
+
+    std::size_t n = 0;
+    while (std::size_t k = do_one(0, true))
+        n = add_count(n, k);
+
+    // The host waits on the fd next; have posts that race with the
+    // announcement interrupt it at once
+    auto& r = reactors_[0];
+    r.sleeping.store(true, std::memory_order_seq_cst);
+    if (!injected_.empty() &&
+        r.sleeping.exchange(false, std::memory_order_seq_cst))
+        interrupt_reactor(r);
+    return n;
 }
 
-void
+long
 epoll_scheduler::
-work_started() const noexcept
+poll_ready_timeout() const
 {
-    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    // The timerfd makes the fd readable for timers
+    if (timer_fd_ >= 0)
+        return -1;
+
+    long const us = calculate_timeout(-1);
+    if (us < 0)
+        return -1;
+    return (us + 999) / 1000;
 }
 
-void
+descriptor_state*
 epoll_scheduler::
-work_finished() const noexcept
+register_descriptor(int fd, bool exclusive) const
 {
-    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    descriptor_state* desc;
+    {
+        std::lock_guard lock(desc_mutex_);
+        reclaim_retired();
+        desc = desc_free_.pop_front();
+        if (!desc)
+            desc = new descriptor_state;
+        desc_live_.push_back(desc);
+    }
+
+    // See "Multiple Reactors"
+    int const epoll_fd = reactors_[reactor_count_ == 1 ? 0
+        : next_reactor_.fetch_add(1, std::memory_order_relaxed) %
+            reactor_count_].epoll_fd;
+
+    {
+        std::lock_guard lock(desc->mutex);
+        desc->fd = fd;
+        desc->epoll_fd = epoll_fd;
+        desc->read_op = nullptr;
+        desc->write_op = nullptr;
+        desc->connect_op = nullptr;
+        desc->read_ready = false;
+        desc->write_ready = false;
+        desc->zero_copy = false;
+        desc->zc_sent = 0;
+        desc->zc_done.store(0, std::memory_order_relaxed);
+        desc->timestamping = false;
+        desc->tx_time.store(0, std::memory_order_relaxed);
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    // The kernel refuses EPOLLRDHUP alongside EPOLLEXCLUSIVE, and a
+    // listener needs neither it nor write readiness
+    if (exclusive)
+    {
+        ev.events = EPOLLIN | EPOLLET;
+#ifdef EPOLLEXCLUSIVE
+        ev.events |= EPOLLEXCLUSIVE;
+#endif
+    }
+    ev.data.ptr = desc;
+    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        int errn = errno;
+        {
+            std::lock_guard lock(desc_mutex_);
+            desc_live_.remove(desc);
+            desc_free_.push_back(desc);
+        }
+        detail::throw_system_error(make_err(errn), "epoll_ctl ADD");
+    }
+    return desc;
+}
+
+void
+epoll_scheduler::
+deregister_descriptor(int fd, descriptor_state* desc) const
+{
+    ::epoll_ctl(desc->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+    {
+        std::lock_guard lock(desc->mutex);
+        desc->fd = -1;
+        desc->read_op = nullptr;
+        desc->write_op = nullptr;
+        desc->connect_op = nullptr;
+        desc->read_ready = false;
+        desc->write_ready = false;
+    }
+
+    // Not reused before every harvest that may hold it is done, see
+    // "Descriptor Reuse"
+    std::lock_guard lock(desc_mutex_);
+    desc->retired = retire_epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    desc_live_.remove(desc);
+    desc_retired_.push_back(desc);
+}
+
+// Moves the retired states no harvest can hold to the free list.
+// Called with desc_mutex_ held; stamps are in increasing order.
+void
+epoll_scheduler::
+reclaim_retired() const noexcept
+{
+    if (desc_retired_.empty())
+        return;
+
+    auto oldest = epoll_reactor::idle_epoch;
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+        oldest = (std::min)(oldest,
+            reactors_[i].harvest_epoch.load(std::memory_order_seq_cst));
+
+    while (auto* desc = desc_retired_.front())
+    {
+        if (desc->retired > oldest)
+            break;
+        desc_retired_.pop_front();
+        desc_free_.push_back(desc);
+    }
+}
+
+void
+epoll_scheduler::
+collect_stats(scheduler_stats& st) const noexcept
+{
+    stats_registry_.collect(st);
+    st.queue_depth_peak = (std::max)(st.queue_depth_peak,
+        queue_peak_.load(std::memory_order_relaxed));
+    st.wakeup_writes += wakeup_writes_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+    {
+        auto const& r = reactors_[i];
+        st.blocking_waits += r.blocking_waits.load(std::memory_order_relaxed);
+        st.reactor_polls += r.reactor_polls.load(std::memory_order_relaxed);
+        st.events_harvested += r.events_harvested.load(std::memory_order_relaxed);
+    }
+}
+
+bool
+epoll_scheduler::
+time_handlers(std::chrono::nanoseconds threshold) noexcept
+{
+    stats_registry_.set_threshold(threshold);
+    return true;
+}
+
+void
+epoll_scheduler::
+sample_handlers(std::vector<handler_sample>& out) const
+{
+    stats_registry_.sample(out);
+}
+
+// See "Parked Operations" in op.hpp
+void
+epoll_scheduler::
+sample_parked(
+    std::vector<parked_op>& out,
+    std::chrono::steady_clock::time_point now) const
+{
+    auto add = [&](epoll_op const* op, parked_kind kind, int fd)
+    {
+        if (!op)
+            return;
+        parked_op p;
+        p.kind = kind;
+        p.fd = fd;
+        p.age = now - op->parked_at;
+        p.coroutine = op->h.address();
+        out.push_back(p);
+    };
+
+    std::lock_guard lock(desc_mutex_);
+    desc_live_.for_each([&](descriptor_state& desc)
+    {
+        std::lock_guard desc_lock(desc.mutex);
+        add(desc.read_op,
+            dynamic_cast<epoll_accept_op const*>(desc.read_op)
+                ? parked_kind::accept : parked_kind::read,
+            desc.fd);
+        add(desc.write_op, parked_kind::write, desc.fd);
+        add(desc.connect_op, parked_kind::connect, desc.fd);
+    });
+}
+
+bool
+epoll_scheduler::
+trace_ops(op_tracer* t) noexcept
+{
+    tracer_.store(t, std::memory_order_relaxed);
+    return true;
+}
+
+capy::execution_context::service*
+epoll_scheduler::
+make_deferred_service(deferred_service which)
+{
+    std::lock_guard lock(deferred_mutex_);
+    switch (which)
+    {
+    case deferred_service::socket:
+        if (auto* svc = ctx_.find_service<socket_service>())
+            return svc;
+        return &ctx_.make_service<epoll_socket_service>();
+
+    case deferred_service::acceptor:
+        if (auto* svc = ctx_.find_service<acceptor_service>())
+            return svc;
+        // Accepted peers need the socket service, which must also
+        // outlive the acceptor service at shutdown
+        if (!ctx_.find_service<socket_service>())
+            ctx_.make_service<epoll_socket_service>();
+        return &ctx_.make_service<epoll_acceptor_service>();
+
+    case deferred_service::udp:
+        if (auto* svc = ctx_.find_service<udp_service>())
+            return svc;
+        return &ctx_.make_service<epoll_udp_service>();
+
+    case deferred_service::resolver:
+        if (auto* svc = ctx_.find_service<posix_resolver_service>())
+            return svc;
+        return &get_resolver_service(ctx_, *this);
+
+    case deferred_service::file:
+        if (auto* svc = ctx_.find_service<file_service>())
+            return svc;
+        return &get_file_service(ctx_, *this);
+
+    case deferred_service::signal:
+    {
+        if (auto* svc = ctx_.find_service<posix_signals>())
+            return svc;
+        auto& signals = get_signal_service(ctx_, *this);
+
+        // Without a signalfd, signals arrive through the handler alone
+        if (signal_fd_ >= 0)
+            signals.set_signal_fd(this,
+                [](void* p, int signal_number, bool watch)
+                {
+                    static_cast<epoll_scheduler*>(p)->watch_signal(
+                        signal_number, watch);
+                });
+        return &signals;
+    }
+    }
+    return nullptr;
+}
+
+std::uint32_t
+epoll_scheduler::
+affinity_home() const noexcept
+{
+    if (!affinity_)
+        return 0;
+    auto* q = find_thread_queue(this);
+    return q ? q->id : 0;
+}
+
+socket_counter_ref
+epoll_scheduler::
+socket_counts() const noexcept
+{
+    auto* c = find_context(this);
+    return stats_registry_.sockets(c ? c->stats : nullptr);
+}
+
+epoll_stats
+epoll_scheduler::
+stats() const noexcept
+{
+    epoll_stats st;
+    collect_stats(st);
+    st.mode = poll_mode_;
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+    {
+        auto const& r = reactors_[i];
+        st.busy_polls += r.busy_polls.load(std::memory_order_relaxed);
+        st.busy_poll_hits += r.busy_poll_hits.load(std::memory_order_relaxed);
+    }
+    st.wakeups_suppressed = wakeups_suppressed_.load(std::memory_order_relaxed);
+    st.timer_wakeups_coalesced = timer_svc_->coalesced_wakeups();
+    st.timerfd = timer_fd_ >= 0;
+    st.timerfd_rearms = timerfd_rearms_.load(std::memory_order_relaxed);
+    st.signalfd = signal_fd_ >= 0;
+    st.reactors = static_cast<unsigned>(reactor_count_);
+    return st;
+}
+
+void
+epoll_scheduler::
+work_started() const noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+epoll_scheduler::
+work_finished() const noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
     {
         // Last work item completed - wake all threads so they can exit.
         // notify_all() wakes threads waiting on the condvar.
-        // interrupt_reactor() wakes the reactor thread blocked in epoll_wait().
+        // interrupt_reactor() wakes the reactor threads blocked in epoll_wait().
         // Both are needed because they target different blocking mechanisms.
-        std::unique_lock lock(mutex_);
+        std::lock_guard lock(mutex_);
         wakeup_event_.notify_all();
-        if (reactor_running_ && !reactor_interrupted_)
+        for (std::size_t i = 0; i < reactor_count_; ++i)
         {
-            reactor_interrupted_ = true;
-            lock.unlock();
-            interrupt_reactor();
+            auto& r = reactors_[i];
+            if (r.running && !r.interrupted)
+            {
+                r.interrupted = true;
+                interrupt_reactor(r);
+            }
         }
     }
 }
@@ -459,8 +1595,57 @@ void
 epoll_scheduler::
 interrupt_reactor() const
 {
+    interrupt_reactor(reactors_[0]);
+}
+
+void
+epoll_scheduler::
+interrupt_reactor(epoll_reactor& r) const
+{
+    // At most one write in flight until the reactor drains it
+    if (r.wakeup_pending.exchange(true, std::memory_order_acq_rel))
+    {
+        wakeups_suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    wakeup_writes_.fetch_add(1, std::memory_order_relaxed);
+
     std::uint64_t val = 1;
-    [[maybe_unused]] auto r = ::write(event_fd_, &val, sizeof(val));
+    [[maybe_unused]] auto n = ::write(r.event_fd, &val, sizeof(val));
+}
+
+// Consumes an eventfd interrupt, see "Wakeup Coalescing". The read
+// comes first: cleared before it, the flag would let a producer write
+// the eventfd in between, the read would eat that write, and every
+// later interrupt would be suppressed by a flag left set.
+void
+epoll_scheduler::
+drain_wakeup(epoll_reactor& r) const noexcept
+{
+    std::uint64_t val;
+    [[maybe_unused]] auto n = ::read(r.event_fd, &val, sizeof(val));
+    r.wakeup_pending.store(false, std::memory_order_release);
+}
+
+// Interrupts one reactor that announced it may block, if any. The
+// seq_cst loads pair with the announcement as the exchange did for
+// a single reactor; the exchange keeps two producers from both
+// paying for the same sleeper.
+bool
+epoll_scheduler::
+interrupt_sleeping() const
+{
+    for (std::size_t i = 0; i < reactor_count_; ++i)
+    {
+        auto& r = reactors_[i];
+        if (r.sleeping.load(std::memory_order_seq_cst) &&
+            r.sleeping.exchange(false, std::memory_order_seq_cst))
+        {
+            interrupt_reactor(r);
+            return true;
+        }
+    }
+    return false;
 }
 
 void
@@ -473,27 +1658,223 @@ wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const
         wakeup_event_.notify_one();
         lock.unlock();
     }
-    else if (reactor_running_ && !reactor_interrupted_)
+    else
     {
-        // No idle workers but reactor is running - interrupt it so it
-        // can re-check the queue after processing current epoll events
-        reactor_interrupted_ = true;
+        // No idle workers - interrupt a running reactor, the primary
+        // first, so it can re-check the queue after processing current
+        // epoll events. With none running, a reactor will pick up work
+        // when it re-checks the queue, or the next thread to call run()
+        // will get it.
+        for (std::size_t i = 0; i < reactor_count_; ++i)
+        {
+            auto& r = reactors_[i];
+            if (r.running && !r.interrupted)
+            {
+                r.interrupted = true;
+                lock.unlock();
+                interrupt_reactor(r);
+                return;
+            }
+        }
         lock.unlock();
-        interrupt_reactor();
+    }
+}
+
+namespace {
+
+// Runs a parked op after a readiness event. Returns true if the op
+// finished and was moved to `ready`; false if it is still waiting.
+// `woke` is when epoll_wait returned, see "Operation Tracing".
+bool
+perform_parked_op(
+    epoll_op*& slot,
+    int err,
+    op_queue& ready,
+    op_trace_state::clock::time_point woke)
+{
+    auto* op = slot;
+    if (err != 0 && op->wait_events == 0)
+    {
+        op->complete(err, 0);
     }
     else
     {
-        // No one to wake - either reactor will pick up work when it
-        // re-checks queue, or next thread to call run() will get it
-        lock.unlock();
+        op->perform_io();
+        if (op->errn == EAGAIN || op->errn == EWOULDBLOCK)
+        {
+            // Spurious or already-consumed edge, keep waiting
+            op->errn = 0;
+            return false;
+        }
+    }
+    slot = nullptr;
+    op->trace.mark_ready(woke);
+    ready.push(op);
+    return true;
+}
+
+// Takes the notifications on the socket's error queue: zero-copy
+// sends the kernel released and transmit timestamps. Returns true
+// if there were any.
+bool
+drain_error_queue(descriptor_state& desc) noexcept
+{
+    bool drained = false;
+    for (;;)
+    {
+        alignas(cmsghdr) char control[256];
+        msghdr msg{};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (::recvmsg(desc.fd, &msg, MSG_ERRQUEUE) < 0)
+            return drained;
+
+        for (auto* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+        {
+            if (!(c->cmsg_level == SOL_IP && c->cmsg_type == IP_RECVERR) &&
+                !(c->cmsg_level == SOL_IPV6 && c->cmsg_type == IPV6_RECVERR))
+                continue;
+            sock_extended_err ee;
+            std::memcpy(&ee, CMSG_DATA(c), sizeof(ee));
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+            if (ee.ee_origin == SO_EE_ORIGIN_ZEROCOPY)
+            {
+                // Sends [ee_info, ee_data] are released; ranges may
+                // come out of order, so they are counted rather than
+                // compared
+                desc.zc_done.fetch_add(ee.ee_data - ee.ee_info + 1,
+                    std::memory_order_release);
+                drained = true;
+            }
+#endif
+#ifdef SO_EE_ORIGIN_TIMESTAMPING
+            if (ee.ee_origin == SO_EE_ORIGIN_TIMESTAMPING)
+            {
+                if (auto t = find_timestamp(msg))
+                    desc.tx_time.store(t, std::memory_order_relaxed);
+                drained = true;
+            }
+#endif
+        }
     }
 }
 
-struct work_guard
+// Dispatches one epoll event to the operations parked on `desc`.
+// Returns the number of operations moved to `ready`.
+int
+perform_descriptor_io(
+    descriptor_state& desc,
+    std::uint32_t events,
+    op_queue& ready,
+    op_trace_state::clock::time_point woke)
 {
-    epoll_scheduler const* self;
-    ~work_guard() { self->work_finished(); }
-};
+    std::lock_guard lock(desc.mutex);
+
+    int err = 0;
+    if ((events & EPOLLERR) && desc.fd >= 0)
+    {
+        // Zero-copy and timestamp notifications raise EPOLLERR
+        // without an error
+        bool drained = (desc.zero_copy || desc.timestamping) &&
+            drain_error_queue(desc);
+
+        socklen_t len = sizeof(err);
+        if (::getsockopt(desc.fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+            err = errno;
+        if (err == 0 && !drained)
+            err = EIO;
+    }
+
+    int n = 0;
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    {
+        if (desc.read_op)
+            n += perform_parked_op(desc.read_op, err, ready, woke);
+        else
+            desc.read_ready = true;
+    }
+
+    if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+    {
+        bool had_op = desc.connect_op || desc.write_op;
+        if (desc.connect_op)
+            n += perform_parked_op(desc.connect_op, err, ready, woke);
+        if (desc.write_op)
+            n += perform_parked_op(desc.write_op, err, ready, woke);
+        if (!had_op)
+            desc.write_ready = true;
+    }
+
+    return n;
+}
+
+} // namespace
+
+void
+epoll_scheduler::
+update_timerfd(bool force) noexcept
+{
+    std::lock_guard lock(timerfd_mutex_);
+    auto nearest = timer_svc_->nearest_wakeup();
+    if (nearest == timerfd_expiry_ && !force)
+        return;
+    timerfd_expiry_ = nearest;
+
+    // A zero it_value disarms; expiries at or before the epoch fire
+    // immediately, like any absolute time already past
+    itimerspec spec{};
+    if (nearest != timer_service::time_point::max())
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            nearest.time_since_epoch()).count();
+        if (ns <= 0)
+            ns = 1;
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+    }
+    ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    timerfd_rearms_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+epoll_scheduler::
+watch_signal(int signal_number, bool watch) noexcept
+{
+    if (signal_number <= 0 || signal_number > 64)
+        return;
+
+    std::lock_guard lock(signalfd_mutex_);
+    auto const bit = std::uint64_t(1) << (signal_number - 1);
+    if (watch)
+        signalfd_signals_ |= bit;
+    else
+        signalfd_signals_ &= ~bit;
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int sig = 1; sig <= 64; ++sig)
+        if (signalfd_signals_ & (std::uint64_t(1) << (sig - 1)))
+            sigaddset(&mask, sig);
+    ::signalfd(signal_fd_, &mask, 0);
+}
+
+void
+epoll_scheduler::
+read_signalfd() noexcept
+{
+    signalfd_siginfo info[8];
+    for (;;)
+    {
+        auto n = ::read(signal_fd_, info, sizeof(info));
+        if (n <= 0)
+            return;
+        auto const count = static_cast<std::size_t>(n) / sizeof(signalfd_siginfo);
+        for (std::size_t i = 0; i < count; ++i)
+            deliver_posix_signal(static_cast<int>(info[i].ssi_signo));
+        if (count < std::size(info))
+            return;
+    }
+}
 
 long
 epoll_scheduler::
@@ -502,7 +1883,11 @@ calculate_timeout(long requested_timeout_us) const
     if (requested_timeout_us == 0)
         return 0;
 
-    auto nearest = timer_svc_->nearest_expiry();
+    // The timerfd wakes epoll_wait for timers
+    if (timer_fd_ >= 0)
+        return requested_timeout_us;
+
+    auto nearest = timer_svc_->nearest_wakeup();
     if (nearest == timer_service::time_point::max())
         return requested_timeout_us;
 
@@ -521,12 +1906,200 @@ calculate_timeout(long requested_timeout_us) const
         static_cast<long long>(timer_timeout_us)));
 }
 
+int
+epoll_scheduler::
+busy_poll(epoll_reactor& r, int& timeout_ms)
+{
+    using clock = std::chrono::steady_clock;
+    auto const start = clock::now();
+
+    // Never spin past the next timer expiry
+    auto limit = opts_.busy_poll_duration;
+    if (timeout_ms > 0)
+        limit = (std::min)(limit,
+            std::chrono::microseconds(std::chrono::milliseconds(timeout_ms)));
+
+    std::uint64_t polls = 0;
+    int nfds = 0;
+    for (;;)
+    {
+        nfds = ::epoll_wait(r.epoll_fd, r.events.data(),
+            static_cast<int>(r.events.size()), 0);
+        ++polls;
+        if (nfds != 0 ||
+            !injected_.empty() ||
+            stopped_.load(std::memory_order_relaxed))
+            break;
+
+        if (poll_mode_ == busy_poll_mode::spin)
+        {
+            if (polls >= opts_.busy_poll_spins)
+                break;
+        }
+        else if (clock::now() - start >= limit)
+        {
+            break;
+        }
+    }
+
+    bump(r.busy_polls, polls);
+    bump(r.reactor_polls, polls);
+    if (nfds != 0 || !injected_.empty())
+    {
+        bump(r.busy_poll_hits);
+        timeout_ms = 0;
+    }
+    else if (timeout_ms > 0)
+    {
+        auto spent = std::chrono::duration_cast<std::chrono::milliseconds>(
+            clock::now() - start).count();
+        timeout_ms = static_cast<int>(
+            (std::max)(static_cast<long long>(timeout_ms) - spent, 0LL));
+    }
+    return nfds;
+}
+
+// Takes a free reactor, see "Multiple Reactors". Called with the
+// lock held; returns null when every reactor is running.
+epoll_reactor*
+epoll_scheduler::
+acquire_reactor(std::size_t& hint) const
+{
+    epoll_reactor* r = nullptr;
+    if (!reactors_[0].running)
+        r = &reactors_[0];
+    else if (hint != 0 && !reactors_[hint].running)
+        r = &reactors_[hint];
+    else
+    {
+        for (std::size_t i = 1; i < reactor_count_; ++i)
+        {
+            if (!reactors_[i].running)
+            {
+                r = &reactors_[i];
+                hint = i;
+                break;
+            }
+        }
+        if (!r)
+            return nullptr;
+    }
+
+    r->running = true;
+    r->interrupted = false;
+
+    // The thread in the primary covers every free secondary
+    if (r == &reactors_[0] && unwatched_ > 0)
+        for (std::size_t i = 1; i < reactor_count_; ++i)
+            if (!reactors_[i].watched && !reactors_[i].running)
+                watch_reactor(reactors_[i]);
+    return r;
+}
+
+// Gives up a reactor taken by acquire_reactor. Called with the lock held.
+void
+epoll_scheduler::
+release_reactor(epoll_reactor& r) const
+{
+    r.running = false;
+    if (!r.watched && reactors_[0].running)
+        watch_reactor(r);
+}
+
+// Arms the watch on a secondary in the primary's set. Called with
+// the lock held.
+void
+epoll_scheduler::
+watch_reactor(epoll_reactor& r) const
+{
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = &r;
+    ::epoll_ctl(reactors_[0].epoll_fd, EPOLL_CTL_MOD, r.epoll_fd, &ev);
+    if (!r.watched)
+    {
+        r.watched = true;
+        --unwatched_;
+    }
+}
+
+// Returns the secondary whose watch produced an event, or null
+epoll_reactor*
+epoll_scheduler::
+find_nested(void* p) const noexcept
+{
+    for (std::size_t i = 1; i < reactor_count_; ++i)
+        if (p == &reactors_[i])
+            return &reactors_[i];
+    return nullptr;
+}
+
+// Harvests a secondary whose watch fired, from the primary's thread,
+// see "Multiple Reactors". Returns the completions queued.
+int
+epoll_scheduler::
+poll_nested(
+    epoll_reactor& r,
+    op_queue& ready_ops,
+    op_trace_state::clock::time_point woke)
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (r.running)
+        {
+            // Its own thread sees the events; leave the watch off
+            r.watched = false;
+            ++unwatched_;
+            return 0;
+        }
+        r.running = true;
+        r.interrupted = true;
+    }
+
+    auto* events = r.events.data();
+    int const nfds = ::epoll_wait(
+        r.epoll_fd, events, static_cast<int>(r.events.size()), 0);
+    bump(r.reactor_polls);
+    if (nfds > 0)
+        bump(r.events_harvested, static_cast<std::uint64_t>(nfds));
+
+    int completions_queued = 0;
+    for (int i = 0; i < nfds; ++i)
+    {
+        if (events[i].data.ptr == nullptr)
+        {
+            drain_wakeup(r);
+            continue;
+        }
+
+        completions_queued += perform_descriptor_io(
+            *static_cast<descriptor_state*>(events[i].data.ptr),
+            events[i].events,
+            ready_ops,
+            woke);
+    }
+
+    // Armed again even with events left over, which fire it at once
+    std::lock_guard lock(mutex_);
+    r.running = false;
+    watch_reactor(r);
+    return completions_queued;
+}
+
 void
 epoll_scheduler::
-run_reactor(std::unique_lock<std::mutex>& lock)
+run_reactor(
+    epoll_reactor& r,
+    std::unique_lock<std::mutex>& lock,
+    thread_stats& ts,
+    long timeout_us)
 {
+    // Only the primary waits for timers, see "Multiple Reactors"
+    bool const primary = &r == &reactors_[0];
+
     // Calculate timeout considering timers, use 0 if interrupted
-    long effective_timeout_us = reactor_interrupted_ ? 0 : calculate_timeout(-1);
+    long effective_timeout_us = r.interrupted ? 0
+        : primary ? calculate_timeout(timeout_us) : timeout_us;
 
     int timeout_ms;
     if (effective_timeout_us < 0)
@@ -538,62 +2111,120 @@ run_reactor(std::unique_lock<std::mutex>& lock)
 
     lock.unlock();
 
-    epoll_event events[64];
-    int nfds = ::epoll_wait(epoll_fd_, events, 64, timeout_ms);
+    // See "Descriptor Reuse"
+    r.harvest_epoch.store(0, std::memory_order_seq_cst);
+    r.harvest_epoch.store(
+        retire_epoch_.load(std::memory_order_seq_cst),
+        std::memory_order_seq_cst);
+
+    auto* events = r.events.data();
+    int const max_events = static_cast<int>(r.events.size());
+    int nfds = 0;
+    if (timeout_ms != 0 && poll_mode_ != busy_poll_mode::off)
+        nfds = busy_poll(r, timeout_ms);
+
+    // Announce that we may block, then re-check for posts that raced
+    // with the announcement; producers interrupt only when this is set
+    if (timeout_ms != 0)
+    {
+        r.sleeping.store(true, std::memory_order_seq_cst);
+        if (!injected_.empty())
+            timeout_ms = 0;
+        else
+            bump(r.blocking_waits);
+    }
+
+    if (nfds == 0)
+    {
+        blocked_scope blocked(timeout_ms != 0 ? &ts : nullptr);
+        BOOST_COROSIO_PROBE1(reactor_wait_enter, timeout_ms);
+        nfds = ::epoll_wait(r.epoll_fd, events, max_events, timeout_ms);
+        BOOST_COROSIO_PROBE1(reactor_wait_exit, nfds);
+        bump(r.reactor_polls);
+    }
     int saved_errno = errno;  // Save before process_expired() may overwrite
+    r.sleeping.store(false, std::memory_order_relaxed);
+    if (nfds > 0)
+        bump(r.events_harvested, static_cast<std::uint64_t>(nfds));
+    auto const woke = nfds > 0 ? trace_clock(tracer_)
+        : op_trace_state::clock::time_point{};
 
     // Process timers outside the lock - timer completions may call post()
     // which needs to acquire the lock
-    timer_svc_->process_expired();
+    if (primary)
+        timer_svc_->process_expired();
 
     if (nfds < 0 && saved_errno != EINTR)
+    {
+        r.harvest_epoch.store(
+            epoll_reactor::idle_epoch, std::memory_order_release);
         detail::throw_system_error(make_err(saved_errno), "epoll_wait");
+    }
 
-    // Process I/O completions - these become handlers in the queue
-    // Must re-acquire lock before modifying completed_ops_
-    lock.lock();
-
+    // Perform I/O for ready descriptors without holding the scheduler
+    // mutex; completed operations are spliced into the queue afterwards.
+    op_queue ready_ops;
     int completions_queued = 0;
+    bool timerfd_fired = false;
     for (int i = 0; i < nfds; ++i)
     {
         if (events[i].data.ptr == nullptr)
         {
-            // eventfd interrupt - just drain it
-            std::uint64_t val;
-            [[maybe_unused]] auto r = ::read(event_fd_, &val, sizeof(val));
+            drain_wakeup(r);
             continue;
         }
 
-        auto* op = static_cast<epoll_op*>(events[i].data.ptr);
-
-        // Claim the op by exchanging to unregistered. Both registering and
-        // registered states mean the op is ours to complete. If already
-        // unregistered, cancel or another thread handled it.
-        auto prev = op->registered.exchange(
-            registration_state::unregistered, std::memory_order_acq_rel);
-        if (prev == registration_state::unregistered)
+        if (events[i].data.ptr == &timer_fd_)
+        {
+            // Expired timers were processed above; consume the tick
+            std::uint64_t ticks;
+            [[maybe_unused]] auto n = ::read(timer_fd_, &ticks, sizeof(ticks));
+            timerfd_fired = true;
             continue;
+        }
 
-        unregister_fd(op->fd);
-
-        if (events[i].events & (EPOLLERR | EPOLLHUP))
+        if (events[i].data.ptr == &signal_fd_)
         {
-            int errn = 0;
-            socklen_t len = sizeof(errn);
-            if (::getsockopt(op->fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
-                errn = errno;
-            if (errn == 0)
-                errn = EIO;
-            op->complete(errn, 0);
+            read_signalfd();
+            continue;
         }
-        else
+
+        if (auto* nested = find_nested(events[i].data.ptr))
         {
-            op->perform_io();
+            completions_queued += poll_nested(*nested, ready_ops, woke);
+            continue;
         }
 
-        completed_ops_.push(op);
-        ++completions_queued;
+        completions_queued += perform_descriptor_io(
+            *static_cast<descriptor_state*>(events[i].data.ptr),
+            events[i].events,
+            ready_ops,
+            woke);
+    }
+    r.harvest_epoch.store(epoll_reactor::idle_epoch, std::memory_order_release);
+
+    // Arm for the new head. After a tick was consumed the timerfd is
+    // armed even for an unchanged head, whose own tick may have been
+    // the one read.
+    if (primary && timer_fd_ >= 0)
+        update_timerfd(timerfd_fired);
+
+    lock.lock();
+    if (affinity_ && !ready_ops.empty())
+    {
+        // Completions kept for their busy threads wake nobody but a
+        // thief that may take them after the steal delay
+        int const routed = route_affine(ready_ops, find_thread_queue(this));
+        completions_queued -= routed;
+        if (routed > 0 && completions_queued == 0)
+            completions_queued = 1;
     }
+    if (lanes_routed_.load(std::memory_order_relaxed))
+        completed_ops_.splice_routed(ready_ops);
+    else
+        completed_ops_.splice(ready_ops);
+    raise_peak(queue_peak_, completed_ops_.size());
+    handlers_since_poll_ = 0;
 
     // Wake idle workers if we queued I/O completions
     if (completions_queued > 0)
@@ -606,10 +2237,125 @@ run_reactor(std::unique_lock<std::mutex>& lock)
     }
 }
 
+// Moves completions to the queues of the threads that started them,
+// see "Completion Affinity". Called with the lock held; returns the
+// number moved.
+int
+epoll_scheduler::
+route_affine(op_queue& ready_ops, epoll_thread_queue* self) const
+{
+    op_queue shared;
+    int routed = 0;
+    while (auto* op = ready_ops.pop())
+    {
+        auto const home = static_cast<epoll_op*>(op)->home;
+        epoll_thread_queue* q = nullptr;
+        if (home != 0 && !op->high_priority)
+        {
+            for (auto* t : thread_queues_)
+            {
+                if (t->id == home)
+                {
+                    q = t;
+                    break;
+                }
+            }
+        }
+
+        if (q && (q == self ||
+            q->busy_since.load(std::memory_order_relaxed) != 0))
+        {
+            raise_peak(queue_peak_, q->push(op));
+            ++routed;
+        }
+        else
+        {
+            shared.push(op);
+        }
+    }
+    ready_ops.splice(shared);
+    return routed;
+}
+
+// Runs a batch from the front of completed_ops_, see "Reactor
+// Completions". Called with the lock held; returns with it released.
 std::size_t
 epoll_scheduler::
-do_one(long timeout_us)
+run_completions(std::unique_lock<std::mutex>& lock)
 {
+    auto* frame = find_context(this);
+
+    op_queue ops;
+    for (unsigned i = 0; i < opts_.inline_completions; ++i)
+    {
+        auto* op = completed_ops_.pop();
+        if (!op)
+            break;
+        ops.push(op);
+    }
+    handlers_since_poll_ += ops.size();
+    lock.unlock();
+
+    // Whatever is left goes back in front of the queue
+    struct requeue
+    {
+        epoll_scheduler* self;
+        op_queue& ops;
+
+        ~requeue()
+        {
+            if (ops.empty())
+                return;
+            std::lock_guard lock(self->mutex_);
+            self->completed_ops_.requeue_front(ops);
+        }
+    } guard{this, ops};
+
+    std::size_t n = 0;
+    while (auto* op = ops.pop())
+    {
+        ++n;
+        bump(frame->stats->handlers);
+        handler_scope g{this, frame};
+        handler_timer timed(stats_registry_, *frame->stats,
+            [op] { return op->target(); });
+        BOOST_COROSIO_PROBE1(handler_start, op);
+        (*op)();
+        BOOST_COROSIO_PROBE1(handler_done, op);
+
+        if (stopped_.load(std::memory_order_acquire))
+            break;
+    }
+    return n;
+}
+
+std::size_t
+epoll_scheduler::
+do_one(long timeout_us, bool batch)
+{
+    // Local work runs without touching the shared mutex, except for a
+    // periodic visit to the shared queue so it cannot be starved
+    auto* frame = find_context(this);
+    auto* local = frame->queue;
+    if (local && completed_ops_.high_priority_hint() == 0 &&
+        ++local->tick % shared_queue_interval != 0)
+    {
+        if (stopped_.load(std::memory_order_acquire))
+            return 0;
+
+        if (auto* op = local->pop())
+        {
+            bump(frame->stats->handlers);
+            handler_scope g{this, frame};
+            handler_timer timed(stats_registry_, *frame->stats,
+                [op] { return op->target(); });
+            BOOST_COROSIO_PROBE1(handler_start, op);
+            (*op)();
+            BOOST_COROSIO_PROBE1(handler_done, op);
+            return 1;
+        }
+    }
+
     std::unique_lock lock(mutex_);
 
     using clock = std::chrono::steady_clock;
@@ -622,15 +2368,50 @@ do_one(long timeout_us)
         if (stopped_.load(std::memory_order_acquire))
             return 0;
 
-        // Try to get a handler from the queue
+        if (!injected_.empty())
+        {
+            completed_ops_.take_all(injected_);
+            raise_peak(queue_peak_, completed_ops_.size());
+        }
+
+        // Out of handler budget: poll the reactor once without
+        // blocking before running more queued work
+        if (opts_.handler_budget > 0 &&
+            handlers_since_poll_ >= opts_.handler_budget)
+        {
+            if (auto* r = acquire_reactor(frame->reactor))
+            {
+                r->interrupted = true;
+                run_reactor(*r, lock, *frame->stats);
+                release_reactor(*r);
+                continue;
+            }
+        }
+
+        // Try to get a handler from the shared queue, then our own
+        // local queue, then another thread's
+        bool deferred = false;
         scheduler_op* op = completed_ops_.pop();
+        if (op != nullptr)
+            ++handlers_since_poll_;
+        else if (local != nullptr)
+        {
+            op = local->pop();
+            if (op == nullptr && work_stealing_)
+                op = steal_work(local, deferred);
+        }
 
         if (op != nullptr)
         {
             // Got a handler - execute it
             lock.unlock();
-            work_guard g{this};
+            bump(frame->stats->handlers);
+            handler_scope g{this, frame};
+            handler_timer timed(stats_registry_, *frame->stats,
+                [op] { return op->target(); });
+            BOOST_COROSIO_PROBE1(handler_start, op);
             (*op)();
+            BOOST_COROSIO_PROBE1(handler_done, op);
             return 1;
         }
 
@@ -652,25 +2433,49 @@ do_one(long timeout_us)
                 deadline - now).count();
         }
 
-        if (!reactor_running_)
+        // Work held back for a busy thread is looked at again after
+        // the steal delay, see "Completion Affinity"
+        long wait_us = remaining_us;
+        if (deferred)
         {
-            // No reactor running and queue empty - become the reactor
-            reactor_running_ = true;
-            reactor_interrupted_ = false;
+            long const retry_us = static_cast<long>(
+                (steal_delay_ns_ + 999) / 1000);
+            if (wait_us < 0 || wait_us > retry_us)
+                wait_us = (std::max)(retry_us, 1L);
+        }
+
+        if (auto* r = acquire_reactor(frame->reactor))
+        {
+            // A reactor is free and the queue empty - become its thread
+            run_reactor(*r, lock, *frame->stats, deferred ? wait_us : -1);
 
-            run_reactor(lock);
+            release_reactor(*r);
+
+            // See "Reactor Completions"
+            if (batch && single_threaded_ &&
+                opts_.inline_completions > 0 && !completed_ops_.empty())
+                return run_completions(lock);
 
-            reactor_running_ = false;
             // Loop back to check for handlers that reactor may have queued
             continue;
         }
 
-        // Reactor is running in another thread - wait for work on condvar
+        // Every reactor is running in another thread - wait for work on condvar
         ++idle_thread_count_;
-        if (timeout_us < 0)
-            wakeup_event_.wait(lock);
-        else
-            wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        if (!injected_.empty())
+        {
+            // A post raced with the announcement above
+            --idle_thread_count_;
+            continue;
+        }
+        bump(frame->stats->parks);
+        {
+            blocked_scope blocked(frame->stats);
+            if (wait_us < 0)
+                wakeup_event_.wait(lock);
+            else
+                wakeup_event_.wait_for(lock, std::chrono::microseconds(wait_us));
+        }
         --idle_thread_count_;
     }
 }
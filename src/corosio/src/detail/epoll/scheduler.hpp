@@ -16,9 +16,14 @@
 
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/detail/scheduler.hpp>
+#include <boost/corosio/epoll_context.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 
+#include "src/detail/intrusive.hpp"
+#include "src/detail/op_lanes.hpp"
+#include "src/detail/op_trace.hpp"
 #include "src/detail/scheduler_op.hpp"
+#include "src/detail/thread_stats.hpp"
 #include "src/detail/timer_service.hpp"
 
 #include <atomic>
@@ -26,11 +31,50 @@
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <span>
+#include <vector>
+
+struct epoll_event;
 
 namespace boost::corosio::detail {
 
 struct epoll_op;
+struct descriptor_state;
+struct epoll_thread_queue;
+
+/** One epoll instance of an epoll_scheduler.
+
+    The flags are guarded by the scheduler's mutex. The atomics and
+    the harvest buffer follow the rules the scheduler had for its
+    single reactor, now kept per instance; see "Multiple Reactors"
+    in scheduler.cpp.
+*/
+struct epoll_reactor
+{
+    int epoll_fd = -1;
+    int event_fd = -1;                      // for interrupting this reactor
+    std::vector<epoll_event> events;        // harvest buffer, owner only
+
+    bool running = false;
+    bool interrupted = false;
+    bool watched = true;                    // armed in the primary's set
+    std::atomic<bool> sleeping = false;
+    std::atomic<bool> wakeup_pending = false;  // eventfd written, not drained
+
+    // Retire epoch read before this reactor's current harvest, or
+    // idle_epoch between harvests, see "Descriptor Reuse"
+    static constexpr std::uint64_t idle_epoch = ~std::uint64_t(0);
+    std::atomic<std::uint64_t> harvest_epoch = idle_epoch;
+
+    // Counters, written only by the thread running this reactor
+    std::atomic<std::uint64_t> blocking_waits = 0;
+    std::atomic<std::uint64_t> busy_polls = 0;
+    std::atomic<std::uint64_t> busy_poll_hits = 0;
+    std::atomic<std::uint64_t> reactor_polls = 0;
+    std::atomic<std::uint64_t> events_harvested = 0;
+};
 
 /** Linux scheduler using epoll for I/O multiplexing.
 
@@ -48,6 +92,16 @@ struct epoll_op;
     the reactor and runs epoll_wait. Other threads wait on a condition
     variable until handlers are available.
 
+    With a concurrency hint greater than 1, each thread inside run()
+    also owns a local queue. Handlers posted from such a thread go to
+    its local queue instead of the shared one, and threads that run
+    out of work steal from the local queues of others. The reactor
+    and threads outside the scheduler keep feeding the shared queue.
+
+    With epoll_options::reactors above one, descriptors are spread
+    over that many epoll instances and as many threads may run the
+    reactor role at once, one per instance.
+
     @par Thread Safety
     All public member functions are thread-safe.
 */
@@ -60,14 +114,19 @@ public:
 
     /** Construct the scheduler.
 
-        Creates an epoll instance and eventfd for event notification.
+        Creates the epoll instances and eventfds for event notification.
 
         @param ctx Reference to the owning execution_context.
-        @param concurrency_hint Hint for expected thread count (unused).
+        @param concurrency_hint Hint for expected thread count. Values
+            greater than 1 enable per-thread queues with work stealing.
+            A value of 1 selects a single-threaded fast path for posts
+            made from inside run(); other threads may still post.
+        @param opts Reactor tuning options.
     */
     epoll_scheduler(
         capy::execution_context& ctx,
-        int concurrency_hint = -1);
+        int concurrency_hint = -1,
+        epoll_options const& opts = {});
 
     ~epoll_scheduler();
 
@@ -77,6 +136,8 @@ public:
     void shutdown() override;
     void post(capy::coro h) const override;
     void post(scheduler_op* h) const override;
+    void post_high_priority(capy::coro h) const override;
+    void post_batch(std::span<capy::coro const> hs) const override;
     void on_work_started() noexcept override;
     void on_work_finished() noexcept override;
     bool running_in_this_thread() const noexcept override;
@@ -88,37 +149,110 @@ public:
     std::size_t wait_one(long usec) override;
     std::size_t poll() override;
     std::size_t poll_one() override;
+    std::size_t poll_ready() override;
+    long poll_ready_timeout() const override;
+
+    long outstanding_work() const noexcept override
+    {
+        return outstanding_work_.load(std::memory_order_acquire);
+    }
 
-    /** Return the epoll file descriptor.
+    /** Return the primary epoll file descriptor.
 
-        Used by socket services to register file descriptors
-        for I/O event notification.
+        The primary instance holds the timerfd, the signalfd and
+        the other instances; descriptors are registered through
+        @ref register_descriptor, which picks the instance. It is
+        readable whenever the context has something to do, see
+        "Embedding" in scheduler.cpp.
 
         @return The epoll file descriptor.
     */
-    int epoll_fd() const noexcept { return epoll_fd_; }
+    int epoll_fd() const noexcept { return reactors_[0].epoll_fd; }
+
+    /// Return the options the scheduler was constructed with.
+    epoll_options const& options() const noexcept { return opts_; }
+
+    void collect_stats(scheduler_stats& st) const noexcept override;
+    bool time_handlers(std::chrono::nanoseconds threshold) noexcept override;
+    void sample_handlers(std::vector<handler_sample>& out) const override;
+    void sample_parked(
+        std::vector<parked_op>& out,
+        std::chrono::steady_clock::time_point now) const override;
+    bool trace_ops(op_tracer* t) noexcept override;
+    capy::execution_context::service*
+    make_deferred_service(deferred_service which) override;
+    std::chrono::steady_clock::time_point now() const noexcept override
+    {
+        return timer_svc_->now();
+    }
+
+    /// Return the tracer for operations starting now, or null.
+    op_tracer* tracer() const noexcept
+    {
+        return tracer_.load(std::memory_order_relaxed);
+    }
+
+    /// Return a snapshot of the reactor counters.
+    epoll_stats stats() const noexcept;
+
+    /** Return the queue that completions started here prefer.
+
+        Called when an operation parks in its descriptor slot. Returns
+        the id of the calling thread's queue when completion affinity
+        is enabled and the thread is inside run(), otherwise zero.
+    */
+    std::uint32_t affinity_home() const noexcept;
+
+    /// Return the socket counters of the calling thread.
+    socket_counter_ref socket_counts() const noexcept;
+
+    /// Add the socket counters of every thread to `st`.
+    void collect_socket_stats(socket_stats& st) const noexcept
+    {
+        stats_registry_.collect(st);
+    }
+
+    /** Register a descriptor with epoll.
 
-    /** Register a file descriptor with epoll.
+        Allocates a pooled descriptor_state and adds `fd` to the epoll
+        set of the next reactor in turn, edge-triggered for both read
+        and write readiness. The registration persists until
+        @ref deregister_descriptor.
+
+        An exclusive registration, for a listening socket shared
+        with other schedulers, is for read readiness only and sets
+        `EPOLLEXCLUSIVE` where available, so that an event wakes
+        one of the schedulers rather than all of them.
 
         @param fd The file descriptor to register.
-        @param op The operation associated with this fd.
-        @param events The epoll events to monitor (EPOLLIN, EPOLLOUT, etc.).
+        @param exclusive Whether to register with `EPOLLEXCLUSIVE`.
+
+        @return The descriptor state bound to `fd`.
+
+        @throws std::system_error if epoll_ctl fails.
     */
-    void register_fd(int fd, epoll_op* op, std::uint32_t events) const;
+    descriptor_state* register_descriptor(int fd, bool exclusive = false) const;
+
+    /** Deregister a descriptor from epoll.
 
-    /** Modify epoll registration for a file descriptor.
+        Removes `fd` from the epoll set and returns its state to the
+        pool. Any parked operations must already have been claimed.
 
-        @param fd The file descriptor to modify.
-        @param op The operation associated with this fd.
-        @param events The new epoll events to monitor.
+        @param fd The file descriptor to deregister.
+        @param desc The state returned by @ref register_descriptor.
     */
-    void modify_fd(int fd, epoll_op* op, std::uint32_t events) const;
+    void deregister_descriptor(int fd, descriptor_state* desc) const;
 
-    /** Unregister a file descriptor from epoll.
+    /** Route reactor completions by priority from now on.
 
-        @param fd The file descriptor to unregister.
+        Called when a socket is first marked for high priority
+        completions; until then the reactor queues all of them in
+        the normal lane without looking at each.
     */
-    void unregister_fd(int fd) const;
+    void use_priority_lanes() const noexcept
+    {
+        lanes_routed_.store(true, std::memory_order_relaxed);
+    }
 
     /** For use by I/O operations to track pending work. */
     void work_started() const noexcept override;
@@ -127,26 +261,106 @@ public:
     void work_finished() const noexcept override;
 
 private:
-    std::size_t do_one(long timeout_us);
-    void run_reactor(std::unique_lock<std::mutex>& lock);
+    class run_scope;
+    class handler_scope;
+
+    std::size_t do_one(long timeout_us, bool batch = false);
+    std::size_t run_completions(std::unique_lock<std::mutex>& lock);
+    void enqueue(scheduler_op* h) const;
+    void enqueue_high_priority(scheduler_op* h) const;
+    scheduler_op* steal_work(epoll_thread_queue* self, bool& deferred) const;
+    int route_affine(op_queue& ready_ops, epoll_thread_queue* self) const;
+    epoll_reactor* acquire_reactor(std::size_t& hint) const;
+    void release_reactor(epoll_reactor& r) const;
+    void watch_reactor(epoll_reactor& r) const;
+    epoll_reactor* find_nested(void* p) const noexcept;
+    int poll_nested(
+        epoll_reactor& r,
+        op_queue& ready_ops,
+        op_trace_state::clock::time_point woke);
+    void run_reactor(
+        epoll_reactor& r,
+        std::unique_lock<std::mutex>& lock,
+        thread_stats& ts,
+        long timeout_us = -1);
+    int busy_poll(epoll_reactor& r, int& timeout_ms);
     void wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const;
     void interrupt_reactor() const;
+    void interrupt_reactor(epoll_reactor& r) const;
+    bool interrupt_sleeping() const;
+    void drain_wakeup(epoll_reactor& r) const noexcept;
+    void reclaim_retired() const noexcept;
+    void close_reactors() noexcept;
+    void wake_for_batch(std::size_t n) const;
+    void update_timerfd(bool force = false) noexcept;
+    void watch_signal(int signal_number, bool watch) noexcept;
+    void read_signalfd() noexcept;
     long calculate_timeout(long requested_timeout_us) const;
 
-    int epoll_fd_;
-    int event_fd_;                              // for interrupting reactor
+    // reactors_[0] is the primary, see "Multiple Reactors"
+    std::unique_ptr<epoll_reactor[]> reactors_;
+    std::size_t reactor_count_ = 1;
+    mutable std::atomic<std::size_t> next_reactor_ = 0;
+    mutable std::size_t unwatched_ = 0;         // guarded by mutex_
+    int timer_fd_ = -1;                         // -1 without a timerfd
+    int signal_fd_ = -1;                        // -1 without a signalfd
+    capy::execution_context& ctx_;
+    epoll_options opts_;
+    busy_poll_mode poll_mode_ = busy_poll_mode::off;
+    std::size_t handlers_since_poll_ = 0;       // guarded by mutex_
     mutable std::mutex mutex_;
     mutable std::condition_variable wakeup_event_;
-    mutable op_queue completed_ops_;
+    mutable op_lanes completed_ops_;
+    mutable std::atomic<bool> lanes_routed_ = false;  // see use_priority_lanes
+    mutable intrusive_mpsc_queue<scheduler_op> injected_;  // lock-free posts
     mutable std::atomic<long> outstanding_work_;
     std::atomic<bool> stopped_;
     bool shutdown_;
     timer_service* timer_svc_ = nullptr;
 
-    // Single reactor thread coordination
-    mutable bool reactor_running_ = false;
-    mutable bool reactor_interrupted_ = false;
-    mutable int idle_thread_count_ = 0;
+    // Threads parked on wakeup_event_
+    mutable std::atomic<int> idle_thread_count_ = 0;
+
+    // Per-thread queues, guarded by mutex_ (see epoll_thread_queue)
+    bool work_stealing_ = false;
+    bool single_threaded_ = false;  // concurrency_hint == 1
+    mutable std::vector<epoll_thread_queue*> thread_queues_;
+    mutable std::size_t steal_cursor_ = 0;
+
+    // See "Completion Affinity"
+    bool affinity_ = false;
+    std::int64_t steal_delay_ns_ = 0;
+    mutable std::uint32_t next_queue_id_ = 0;   // guarded by mutex_
+
+    // Wakeup counters, written by any thread
+    mutable std::atomic<std::uint64_t> wakeup_writes_ = 0;
+    mutable std::atomic<std::uint64_t> wakeups_suppressed_ = 0;
+
+    // Per-thread counters and the queue depth peak, see "Statistics"
+    mutable thread_stats_registry stats_registry_;
+    mutable std::atomic<std::size_t> queue_peak_ = 0;
+
+    // See "Operation Tracing" in op_trace.hpp
+    std::atomic<op_tracer*> tracer_ = nullptr;
+
+    // Expiry the timerfd is armed for, see "Timer Integration"
+    std::mutex timerfd_mutex_;
+    timer_service::time_point timerfd_expiry_ = timer_service::time_point::max();
+    std::atomic<std::uint64_t> timerfd_rearms_ = 0;
+
+    // Signals in the signalfd's mask, see "Signal Delivery"
+    std::mutex signalfd_mutex_;
+    std::uint64_t signalfd_signals_ = 0;
+
+    // Serializes creation of deferred services, see "Deferred Services"
+    std::mutex deferred_mutex_;
+
+    // Pool of descriptor states, see descriptor_state in op.hpp
+    mutable std::mutex desc_mutex_;
+    mutable intrusive_list<descriptor_state> desc_live_;
+    mutable intrusive_list<descriptor_state> desc_free_;
+    mutable intrusive_list<descriptor_state> desc_retired_;
+    mutable std::atomic<std::uint64_t> retire_epoch_ = 0;
 };
 
 } // namespace boost::corosio::detail
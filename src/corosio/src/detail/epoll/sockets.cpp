@@ -18,6 +18,9 @@
 
 #include <boost/corosio/detail/except.hpp>
 #include <boost/capy/buffers.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <utility>
 
 #include <errno.h>
 #include <netinet/in.h>
@@ -39,6 +42,76 @@ operator()() const noexcept
     op->cancel();
 }
 
+//------------------------------------------------------------------------------
+// Starting socket operations, see "Stop Slot" in op.hpp
+//------------------------------------------------------------------------------
+
+void
+epoll_op::
+start(std::stop_token token, epoll_socket_impl* impl)
+{
+    cancelled.store(false, std::memory_order_release);
+    stop_cb.reset();
+    socket_impl_ = impl;
+    acceptor_impl_ = nullptr;
+    account = impl->account();
+    stop_slot = false;
+
+    if (!token.stop_possible())
+        return;
+
+    if (impl->use_stop_slot(token))
+    {
+        stop_slot = true;
+        if (token.stop_requested())
+            request_cancel();
+        return;
+    }
+    stop_cb.emplace(token, canceller{this});
+}
+
+// See "Counters" in op.hpp
+void
+epoll_op::
+count() const noexcept
+{
+    auto const c = socket_impl_->service().scheduler().socket_counts();
+    if (cancelled.load(std::memory_order_acquire))
+    {
+        c.add(&socket_counters::cancellations);
+        return;
+    }
+    if (this == &socket_impl_->conn_)
+    {
+        if (errn != 0)
+            c.add(&socket_counters::connect_failures);
+        return;
+    }
+    if (wait_events != 0)
+        return;
+    if (this == &socket_impl_->rd_)
+    {
+        c.add(&socket_counters::bytes_read, bytes_transferred);
+        c.add(waited
+            ? &socket_counters::reads_waited
+            : &socket_counters::reads_immediate);
+    }
+    else
+    {
+        c.add(&socket_counters::bytes_written, bytes_transferred);
+        c.add(waited
+            ? &socket_counters::writes_waited
+            : &socket_counters::writes_immediate);
+    }
+}
+
+void
+epoll_socket_impl::slot_canceller::
+operator()() const noexcept
+{
+    impl->cancel_stopped();
+}
+
 //------------------------------------------------------------------------------
 // cancel() overrides for socket operations
 //------------------------------------------------------------------------------
@@ -82,18 +155,22 @@ epoll_connect_op::
 operator()()
 {
     stop_cb.reset();
+    trace.finish(cancelled.load(std::memory_order_acquire));
+    BOOST_COROSIO_PROBE2(socket_connect, fd, errn);
 
     bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+    if (socket_impl_)
+        count();
 
     // Cache endpoints on successful connect
     if (success && socket_impl_)
     {
         // Query local endpoint via getsockname (may fail, but remote is always known)
         endpoint local_ep;
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         socklen_t local_len = sizeof(local_addr);
         if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_ep = from_sockaddr_in(local_addr);
+            local_ep = from_sockaddr(local_addr);
         // Always cache remote endpoint; local may be default if getsockname failed
         static_cast<epoll_socket_impl*>(socket_impl_)->set_endpoints(local_ep, target_endpoint);
     }
@@ -118,6 +195,19 @@ operator()()
     resume_coro(saved_ex, saved_h);
 }
 
+//------------------------------------------------------------------------------
+// epoll_uncork_op::operator() - ends a coalescing batch
+//------------------------------------------------------------------------------
+
+void
+epoll_uncork_op::
+operator()()
+{
+    // The impl may go with the last reference, after uncork() returns
+    auto self = std::move(impl_ptr);
+    impl->uncork(fd);
+}
+
 //------------------------------------------------------------------------------
 // epoll_socket_impl
 //------------------------------------------------------------------------------
@@ -126,6 +216,7 @@ epoll_socket_impl::
 epoll_socket_impl(epoll_socket_service& svc) noexcept
     : svc_(svc)
 {
+    uncork_.impl = this;
 }
 
 void
@@ -153,18 +244,20 @@ connect(
     op.fd = fd_;
     op.target_endpoint = ep;  // Store target for endpoint caching
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
-    int result = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    int result = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), addrlen);
 
     if (result == 0)
     {
         // Sync success - cache endpoints immediately
         // Remote is always known; local may fail but we still cache remote
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         socklen_t local_len = sizeof(local_addr);
         if (::getsockname(fd_, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_endpoint_ = detail::from_sockaddr_in(local_addr);
+            local_endpoint_ = detail::from_sockaddr(local_addr);
         remote_endpoint_ = ep;
 
         op.complete(0, 0);
@@ -175,38 +268,7 @@ connect(
 
     if (errno == EINPROGRESS)
     {
-        svc_.work_started();
-        // Set registering BEFORE register_fd to close the race window where
-        // reactor sees an event before we set registered. The reactor treats
-        // registering the same as registered when claiming the op.
-        op.registered.store(registration_state::registering, std::memory_order_release);
-        svc_.scheduler().register_fd(fd_, &op, EPOLLOUT | EPOLLET);
-
-        // Transition to registered. If this fails, reactor or cancel already
-        // claimed the op (state is now unregistered), so we're done. However,
-        // we must still unregister the fd because cancel's unregister_fd may
-        // have run before our register_fd, leaving the fd orphaned in epoll.
-        auto expected = registration_state::registering;
-        if (!op.registered.compare_exchange_strong(
-                expected, registration_state::registered, std::memory_order_acq_rel))
-        {
-            svc_.scheduler().unregister_fd(fd_);
-            return;
-        }
-
-        // If cancelled was set before we registered, handle it now.
-        if (op.cancelled.load(std::memory_order_acquire))
-        {
-            auto prev = op.registered.exchange(
-                registration_state::unregistered, std::memory_order_acq_rel);
-            if (prev != registration_state::unregistered)
-            {
-                svc_.scheduler().unregister_fd(fd_);
-                op.impl_ptr = shared_from_this();
-                svc_.post(&op);
-                svc_.work_finished();
-            }
-        }
+        register_op(op, desc_->connect_op, desc_->write_ready);
         return;
     }
 
@@ -217,6 +279,67 @@ connect(
 
 void
 epoll_socket_impl::
+connect_with_data(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    endpoint ep,
+    capy::const_buffer data,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    auto& op = conn_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes;
+    op.fd = fd_;
+    op.target_endpoint = ep;
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+
+    // One sendto() both connects and, when the kernel holds a Fast
+    // Open cookie for the peer, queues the data in the SYN
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    ssize_t n = ::sendto(fd_, data.data(), data.size(),
+        MSG_FASTOPEN | MSG_NOSIGNAL,
+        reinterpret_cast<sockaddr*>(&addr), addrlen);
+
+    // Client Fast Open disabled by net.ipv4.tcp_fastopen
+    if (n < 0 && errno == EOPNOTSUPP)
+        n = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), addrlen);
+
+    if (n >= 0)
+    {
+        // The data is in the SYN; the handshake finishes behind it
+        sockaddr_storage local_addr{};
+        socklen_t local_len = sizeof(local_addr);
+        if (::getsockname(fd_, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+            local_endpoint_ = detail::from_sockaddr(local_addr);
+        remote_endpoint_ = ep;
+
+        op.complete(0, static_cast<std::size_t>(n));
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return;
+    }
+
+    // No cookie yet: the SYN asks for one and carries no data
+    if (errno == EINPROGRESS)
+    {
+        register_op(op, desc_->connect_op, desc_->write_ready);
+        return;
+    }
+
+    op.complete(errno, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+}
+
+bool
+epoll_socket_impl::
 read_some(
     std::coroutine_handle<> h,
     capy::executor_ref ex,
@@ -224,6 +347,33 @@ read_some(
     std::stop_token token,
     system::error_code* ec,
     std::size_t* bytes_out)
+{
+    return start_read(h, ex, param, token, ec, bytes_out, false);
+}
+
+bool
+epoll_socket_impl::
+read_exact(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    return start_read(h, ex, param, token, ec, bytes_out, true);
+}
+
+bool
+epoll_socket_impl::
+start_read(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out,
+    bool all)
 {
     auto& op = rd_;
     op.reset();
@@ -232,86 +382,61 @@ read_some(
     op.ec_out = ec;
     op.bytes_out = bytes_out;
     op.fd = fd_;
-    op.start(token, this);
+    assign_iovecs(op.iovecs, param);
+
+    // Too many buffers for one window, see "Transfer All" in op.hpp
+    if (all && op.iovecs.truncated())
+        return socket_impl::read_exact(h, ex, param, token, ec, bytes_out);
 
-    capy::mutable_buffer bufs[epoll_read_op::max_buffers];
-    op.iovec_count = static_cast<int>(param.copy_to(bufs, epoll_read_op::max_buffers));
+    // See "Timestamps" in op.hpp
+    rx_time_ = 0;
+    if (timestamping_)
+        op.rx_time_out = &rx_time_;
+
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    if (op.iovec_count == 0 || (op.iovec_count == 1 && bufs[0].size() == 0))
+    if (op.iovecs.empty())
     {
         op.empty_buffer_read = true;
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
-    for (int i = 0; i < op.iovec_count; ++i)
+    if (all)
     {
-        op.iovecs[i].iov_base = bufs[i].data();
-        op.iovecs[i].iov_len = bufs[i].size();
+        op.transfer_all = true;
+        return start_transfer(op, desc_->read_op, desc_->read_ready);
     }
 
-    ssize_t n = ::readv(fd_, op.iovecs, op.iovec_count);
+    ssize_t n = op.read_part();
 
-    if (n > 0)
+    // Data or EOF already available, see "Inline Completion" in op.hpp
+    if (n >= 0)
     {
         op.complete(0, static_cast<std::size_t>(n));
+        if (op.complete_inline())
+            return true;
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
-    }
-
-    if (n == 0)
-    {
-        op.complete(0, 0);
-        op.impl_ptr = shared_from_this();
-        svc_.post(&op);
-        return;
+        return false;
     }
 
     if (errno == EAGAIN || errno == EWOULDBLOCK)
     {
-        svc_.work_started();
-        // Set registering BEFORE register_fd to close the race window where
-        // reactor sees an event before we set registered.
-        op.registered.store(registration_state::registering, std::memory_order_release);
-        svc_.scheduler().register_fd(fd_, &op, EPOLLIN | EPOLLET);
-
-        // Transition to registered. If this fails, reactor or cancel already
-        // claimed the op (state is now unregistered), so we're done. However,
-        // we must still unregister the fd because cancel's unregister_fd may
-        // have run before our register_fd, leaving the fd orphaned in epoll.
-        auto expected = registration_state::registering;
-        if (!op.registered.compare_exchange_strong(
-                expected, registration_state::registered, std::memory_order_acq_rel))
-        {
-            svc_.scheduler().unregister_fd(fd_);
-            return;
-        }
-
-        // If cancelled was set before we registered, handle it now.
-        if (op.cancelled.load(std::memory_order_acquire))
-        {
-            auto prev = op.registered.exchange(
-                registration_state::unregistered, std::memory_order_acq_rel);
-            if (prev != registration_state::unregistered)
-            {
-                svc_.scheduler().unregister_fd(fd_);
-                op.impl_ptr = shared_from_this();
-                svc_.post(&op);
-                svc_.work_finished();
-            }
-        }
-        return;
+        register_op(op, desc_->read_op, desc_->read_ready);
+        return false;
     }
 
     op.complete(errno, 0);
     op.impl_ptr = shared_from_this();
     svc_.post(&op);
+    return false;
 }
 
-void
+bool
 epoll_socket_impl::
 write_some(
     std::coroutine_handle<> h,
@@ -320,6 +445,33 @@ write_some(
     std::stop_token token,
     system::error_code* ec,
     std::size_t* bytes_out)
+{
+    return start_write(h, ex, param, token, ec, bytes_out, false);
+}
+
+bool
+epoll_socket_impl::
+write_all(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    return start_write(h, ex, param, token, ec, bytes_out, true);
+}
+
+bool
+epoll_socket_impl::
+start_write(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out,
+    bool all)
 {
     auto& op = wr_;
     op.reset();
@@ -328,78 +480,183 @@ write_some(
     op.ec_out = ec;
     op.bytes_out = bytes_out;
     op.fd = fd_;
-    op.start(token, this);
+    assign_iovecs(op.iovecs, param);
+
+    if (all && op.iovecs.truncated())
+        return socket_impl::write_all(h, ex, param, token, ec, bytes_out);
 
-    capy::mutable_buffer bufs[epoll_write_op::max_buffers];
-    op.iovec_count = static_cast<int>(param.copy_to(bufs, epoll_write_op::max_buffers));
+    // See "Zero-Copy Sends" in op.hpp
+    if (zero_copy_ && iovecs_size(op.iovecs) >= zero_copy_min_bytes)
+        op.zc_desc = desc_;
 
-    if (op.iovec_count == 0 || (op.iovec_count == 1 && bufs[0].size() == 0))
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+
+    if (op.iovecs.empty())
     {
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
-    for (int i = 0; i < op.iovec_count; ++i)
+    // See "Write Coalescing" in op.hpp
+    if (coalesce_ && !corked_.exchange(true, std::memory_order_acq_rel))
+        cork();
+
+    if (all || op.zc_desc)
     {
-        op.iovecs[i].iov_base = bufs[i].data();
-        op.iovecs[i].iov_len = bufs[i].size();
+        op.transfer_all = all;
+        return start_transfer(op, desc_->write_op, desc_->write_ready);
     }
 
     msghdr msg{};
-    msg.msg_iov = op.iovecs;
-    msg.msg_iovlen = static_cast<std::size_t>(op.iovec_count);
+    msg.msg_iov = op.iovecs.data();
+    msg.msg_iovlen = op.iovecs.size();
 
     ssize_t n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
 
     if (n > 0)
     {
         op.complete(0, static_cast<std::size_t>(n));
+        if (op.complete_inline())
+            return true;
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
     if (errno == EAGAIN || errno == EWOULDBLOCK)
     {
-        svc_.work_started();
-        // Set registering BEFORE register_fd to close the race window where
-        // reactor sees an event before we set registered.
-        op.registered.store(registration_state::registering, std::memory_order_release);
-        svc_.scheduler().register_fd(fd_, &op, EPOLLOUT | EPOLLET);
-
-        // Transition to registered. If this fails, reactor or cancel already
-        // claimed the op (state is now unregistered), so we're done. However,
-        // we must still unregister the fd because cancel's unregister_fd may
-        // have run before our register_fd, leaving the fd orphaned in epoll.
-        auto expected = registration_state::registering;
-        if (!op.registered.compare_exchange_strong(
-                expected, registration_state::registered, std::memory_order_acq_rel))
-        {
-            svc_.scheduler().unregister_fd(fd_);
-            return;
-        }
-
-        // If cancelled was set before we registered, handle it now.
-        if (op.cancelled.load(std::memory_order_acquire))
-        {
-            auto prev = op.registered.exchange(
-                registration_state::unregistered, std::memory_order_acq_rel);
-            if (prev != registration_state::unregistered)
-            {
-                svc_.scheduler().unregister_fd(fd_);
-                op.impl_ptr = shared_from_this();
-                svc_.post(&op);
-                svc_.work_finished();
-            }
-        }
-        return;
+        register_op(op, desc_->write_op, desc_->write_ready);
+        return false;
     }
 
     op.complete(errno ? errno : EIO, 0);
     op.impl_ptr = shared_from_this();
     svc_.post(&op);
+    return false;
+}
+
+bool
+epoll_socket_impl::
+write_with_descriptor(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    capy::const_buffer buf,
+    native_handle_type fd,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.pass_fd = fd;
+    assign_iovecs(op.iovecs, buf);
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    return start_transfer(op, desc_->write_op, desc_->write_ready);
+}
+
+bool
+epoll_socket_impl::
+read_with_descriptor(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    capy::mutable_buffer buf,
+    native_handle_type* fd,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.fd_out = fd;
+    assign_iovecs(op.iovecs, buf);
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    return start_transfer(op, desc_->read_op, desc_->read_ready);
+}
+
+bool
+epoll_socket_impl::
+wait(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    socket::wait_type w,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    // See "Readiness Waits" in op.hpp
+    if (w == socket::wait_type::write)
+    {
+        wr_.reset();
+        wr_.wait_events = POLLOUT;
+    }
+    else
+    {
+        rd_.reset();
+        rd_.wait_events = w == socket::wait_type::read ? POLLIN : POLLPRI;
+    }
+
+    epoll_op& op = w == socket::wait_type::write
+        ? static_cast<epoll_op&>(wr_) : rd_;
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = nullptr;
+    op.fd = fd_;
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    if (w == socket::wait_type::write)
+        return start_transfer(op, desc_->write_op, desc_->write_ready);
+    return start_transfer(op, desc_->read_op, desc_->read_ready);
+}
+
+bool
+epoll_socket_impl::
+send_file(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    native_file_type file,
+    std::uint64_t offset,
+    std::size_t count,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.file_fd = file;
+    op.file_offset = static_cast<off_t>(offset);
+    op.file_remaining = count;
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+
+    if (count == 0)
+    {
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    return start_transfer(op, desc_->write_op, desc_->write_ready);
 }
 
 system::error_code
@@ -551,33 +808,285 @@ linger(system::error_code& ec) const noexcept
     return {.enabled = lg.l_onoff != 0, .timeout = lg.l_linger};
 }
 
+system::error_code
+epoll_socket_impl::
+set_zero_copy(bool value) noexcept
+{
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &flag, sizeof(flag)) != 0)
+    {
+        // Kernels before 4.14 do not know the option
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    }
+
+    // Once enabled the reactor keeps draining the error queue, since
+    // sends issued before a disable are still reported there
+    if (value)
+    {
+        std::lock_guard lock(desc_->mutex);
+        desc_->zero_copy = true;
+    }
+    zero_copy_ = value;
+    return {};
+#else
+    (void)value;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+bool
+epoll_socket_impl::
+zero_copy(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return zero_copy_;
+}
+
+system::error_code
+epoll_socket_impl::
+set_timestamping(bool value) noexcept
+{
+    if (int err = detail::set_timestamping(fd_, value))
+        return make_err(err);
+
+    // Transmit timestamps for earlier sends may still be queued, so
+    // the reactor keeps draining them, as for zero-copy sends
+    if (value)
+    {
+        std::lock_guard lock(desc_->mutex);
+        desc_->timestamping = true;
+    }
+    timestamping_ = value;
+    return {};
+}
+
+bool
+epoll_socket_impl::
+timestamping(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return timestamping_;
+}
+
+std::chrono::system_clock::time_point
+epoll_socket_impl::
+last_receive_time() const noexcept
+{
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(rx_time_)));
+}
+
+std::chrono::system_clock::time_point
+epoll_socket_impl::
+last_send_time() const noexcept
+{
+    if (!desc_)
+        return {};
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(
+                desc_->tx_time.load(std::memory_order_relaxed))));
+}
+
+system::error_code
+epoll_socket_impl::
+set_high_priority_completions(bool value) noexcept
+{
+    // See "Priority Lanes" in scheduler.cpp
+    conn_.high_priority = value;
+    rd_.high_priority = value;
+    wr_.high_priority = value;
+    if (value)
+        svc_.scheduler().use_priority_lanes();
+    return {};
+}
+
+bool
+epoll_socket_impl::
+high_priority_completions(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return rd_.high_priority;
+}
+
+system::error_code
+epoll_socket_impl::
+set_write_coalescing(bool value) noexcept
+{
+#ifdef TCP_CORK
+    // Fails for sockets other than TCP, such as local ones
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    if (::getsockopt(fd_, IPPROTO_TCP, TCP_CORK, &flag, &len) != 0)
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+
+    // Data held by a pending cork goes out now
+    if (!value && corked_.load(std::memory_order_acquire))
+    {
+        flag = 0;
+        ::setsockopt(fd_, IPPROTO_TCP, TCP_CORK, &flag, sizeof(flag));
+    }
+    coalesce_ = value;
+    return {};
+#else
+    (void)value;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+bool
+epoll_socket_impl::
+write_coalescing(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return coalesce_;
+}
+
 void
 epoll_socket_impl::
-cancel() noexcept
+cork() noexcept
 {
-    std::shared_ptr<epoll_socket_impl> self;
+#ifdef TCP_CORK
+    int one = 1;
+    if (::setsockopt(fd_, IPPROTO_TCP, TCP_CORK, &one, sizeof(one)) != 0)
+    {
+        corked_.store(false, std::memory_order_release);
+        return;
+    }
+    uncork_.fd = fd_;
     try {
-        self = shared_from_this();
+        uncork_.impl_ptr = shared_from_this();
     } catch (const std::bad_weak_ptr&) {
-        return;
     }
+    svc_.scheduler().post(&uncork_);
+#endif
+}
 
-    auto cancel_op = [this, &self](epoll_op& op) {
-        auto prev = op.registered.exchange(
-            registration_state::unregistered, std::memory_order_acq_rel);
-        op.request_cancel();
-        if (prev != registration_state::unregistered)
+void
+epoll_socket_impl::
+uncork(int fd) noexcept
+{
+#ifdef TCP_CORK
+    // After a close the descriptor may name another socket, which
+    // this only flushes early
+    int zero = 0;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_CORK, &zero, sizeof(zero));
+#else
+    (void)fd;
+#endif
+    corked_.store(false, std::memory_order_release);
+}
+
+bool
+epoll_socket_impl::
+start_transfer(
+    epoll_op& op,
+    epoll_op*& slot,
+    bool& ready_flag)
+{
+    op.perform_io();
+    if (op.errn == EAGAIN || op.errn == EWOULDBLOCK)
+    {
+        op.errn = 0;
+        register_op(op, slot, ready_flag);
+        return false;
+    }
+
+    if (op.complete_inline())
+        return true;
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+    return false;
+}
+
+void
+epoll_socket_impl::
+register_op(
+    epoll_op& op,
+    epoll_op*& slot,
+    bool& ready_flag) noexcept
+{
+    svc_.work_started();
+
+    std::unique_lock lock(desc_->mutex);
+
+    // An edge arrived while nothing was parked; retry before waiting
+    if (ready_flag)
+    {
+        ready_flag = false;
+        op.perform_io();
+        if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
         {
-            svc_.scheduler().unregister_fd(fd_);
-            op.impl_ptr = self;
+            lock.unlock();
+            op.impl_ptr = shared_from_this();
             svc_.post(&op);
             svc_.work_finished();
+            return;
         }
-    };
+        op.errn = 0;
+    }
+
+    // A stop the slot's callback could not claim, see "Stop Slot"
+    if (op.stop_slot && slot_token_.stop_requested())
+        op.request_cancel();
 
-    cancel_op(conn_);
-    cancel_op(rd_);
-    cancel_op(wr_);
+    // Cancellation requested before we could park
+    if (op.cancelled.load(std::memory_order_acquire))
+    {
+        lock.unlock();
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        svc_.work_finished();
+        return;
+    }
+
+    op.parked_at = std::chrono::steady_clock::now();
+    op.home = svc_.scheduler().affinity_home();
+    op.waited = true;
+    svc_.scheduler().socket_counts().add(&socket_counters::would_block);
+    slot = &op;
+}
+
+void
+epoll_socket_impl::
+cancel() noexcept
+{
+    std::shared_ptr<epoll_socket_impl> self;
+    try {
+        self = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        return;
+    }
+
+    conn_.request_cancel();
+    rd_.request_cancel();
+    wr_.request_cancel();
+
+    if (!desc_)
+        return;
+
+    epoll_op* claimed[3];
+    {
+        std::lock_guard lock(desc_->mutex);
+        claimed[0] = std::exchange(desc_->connect_op, nullptr);
+        claimed[1] = std::exchange(desc_->read_op, nullptr);
+
+        // A write whose buffers the kernel still reads stays parked
+        claimed[2] = wr_.zc_waiting && desc_->write_op == &wr_
+            ? nullptr
+            : std::exchange(desc_->write_op, nullptr);
+    }
+
+    for (auto* op : claimed)
+    {
+        if (!op)
+            continue;
+        op->impl_ptr = self;
+        svc_.post(op);
+        svc_.work_finished();
+    }
 }
 
 void
@@ -586,39 +1095,166 @@ cancel_single_op(epoll_op& op) noexcept
 {
     // Called from stop_token callback to cancel a specific pending operation.
     // This performs actual I/O cancellation, not just setting a flag.
-    auto prev = op.registered.exchange(
-        registration_state::unregistered, std::memory_order_acq_rel);
     op.request_cancel();
 
-    if (prev != registration_state::unregistered)
+    if (!desc_)
+        return;
+
+    epoll_op** slot;
+    if (&op == &conn_)
+        slot = &desc_->connect_op;
+    else if (&op == &rd_)
+        slot = &desc_->read_op;
+    else
+        slot = &desc_->write_op;
+
     {
-        svc_.scheduler().unregister_fd(fd_);
+        std::lock_guard lock(desc_->mutex);
+        if (*slot != &op)
+            return;
+        if (&op == &wr_ && wr_.zc_waiting)
+            return;
+        *slot = nullptr;
+    }
 
-        // Keep impl alive until op completes
-        try {
-            op.impl_ptr = shared_from_this();
-        } catch (const std::bad_weak_ptr&) {
-            // Impl is being destroyed, op will be orphaned but that's ok
+    // Keep impl alive until op completes
+    try {
+        op.impl_ptr = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        // Impl is being destroyed, op will be orphaned but that's ok
+    }
+
+    svc_.post(&op);
+    svc_.work_finished();
+}
+
+bool
+epoll_socket_impl::
+use_stop_slot(std::stop_token const& token) noexcept
+{
+    int state = slot_state_.load(std::memory_order_acquire);
+    if (state == slot_ready)
+        return slot_token_ == token;
+
+    // The first token to arrive takes the slot; a racing op that
+    // loses falls back to a callback of its own
+    if (state != slot_empty ||
+        !slot_state_.compare_exchange_strong(
+            state, slot_busy, std::memory_order_acq_rel))
+        return false;
+
+    slot_token_ = token;
+    slot_cb_.emplace(token, slot_canceller{this});
+    slot_state_.store(slot_ready, std::memory_order_release);
+    return true;
+}
+
+void
+epoll_socket_impl::
+cancel_stopped() noexcept
+{
+    if (!desc_)
+        return;
+
+    // Claim the parked ops that rely on the slot
+    epoll_op* claimed[3] = {};
+    {
+        std::lock_guard lock(desc_->mutex);
+        auto claim = [](epoll_op*& slot) -> epoll_op*
+        {
+            if (!slot || !slot->stop_slot)
+                return nullptr;
+            slot->request_cancel();
+            return std::exchange(slot, nullptr);
+        };
+        claimed[0] = claim(desc_->connect_op);
+        claimed[1] = claim(desc_->read_op);
+
+        // A write whose buffers the kernel still reads stays parked
+        if (wr_.zc_waiting && desc_->write_op == &wr_)
+        {
+            if (wr_.stop_slot)
+                wr_.request_cancel();
+        }
+        else
+        {
+            claimed[2] = claim(desc_->write_op);
         }
+    }
 
-        svc_.post(&op);
+    std::shared_ptr<epoll_socket_impl> self;
+    for (auto* op : claimed)
+    {
+        if (!op)
+            continue;
+        if (!self)
+        {
+            try {
+                self = shared_from_this();
+            } catch (const std::bad_weak_ptr&) {
+                // Impl is being destroyed, op will be orphaned but that's ok
+            }
+        }
+        op->impl_ptr = self;
+        svc_.post(op);
         svc_.work_finished();
     }
 }
 
+void
+epoll_socket_impl::
+release_stop_slot() noexcept
+{
+    if (slot_state_.load(std::memory_order_acquire) != slot_ready)
+        return;
+    // Waits for a callback running on another thread
+    slot_cb_.reset();
+    slot_token_ = {};
+    slot_state_.store(slot_empty, std::memory_order_release);
+}
+
 void
 epoll_socket_impl::
 close_socket() noexcept
 {
+    release_stop_slot();
     cancel();
 
+    // A write that cancel() left waiting for its zero-copy buffers
+    // ends here, as the error queue goes with the descriptor
+    if (desc_)
+    {
+        epoll_op* op;
+        {
+            std::lock_guard lock(desc_->mutex);
+            op = std::exchange(desc_->write_op, nullptr);
+        }
+        if (op)
+        {
+            try {
+                op->impl_ptr = shared_from_this();
+            } catch (const std::bad_weak_ptr&) {
+            }
+            svc_.post(op);
+            svc_.work_finished();
+        }
+    }
+    zero_copy_ = false;
+    coalesce_ = false;
+    timestamping_ = false;
+    rx_time_ = 0;
+    account_ = nullptr;
+    conn_.high_priority = false;
+    rd_.high_priority = false;
+    wr_.high_priority = false;
+
     if (fd_ >= 0)
     {
-        // Unconditionally remove from epoll to handle edge cases where
-        // the fd might be registered but cancel() didn't clean it up
-        // due to race conditions. Note: kernel auto-removes on close,
-        // but this is defensive and makes behavior consistent with select.
-        svc_.scheduler().unregister_fd(fd_);
+        if (desc_)
+        {
+            svc_.scheduler().deregister_descriptor(fd_, desc_);
+            desc_ = nullptr;
+        }
         ::close(fd_);
         fd_ = -1;
     }
@@ -628,6 +1264,36 @@ close_socket() noexcept
     remote_endpoint_ = endpoint{};
 }
 
+system::error_code
+epoll_socket_impl::
+set_socket(int fd) noexcept
+{
+    try {
+        desc_ = svc_.scheduler().register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
+    fd_ = fd;
+
+    // Best effort; the kernel may refuse without CAP_NET_ADMIN
+    auto const& opts = svc_.scheduler().options();
+#ifdef SO_BUSY_POLL
+    if (opts.socket_busy_poll > 0)
+        ::setsockopt(fd_, SOL_SOCKET, SO_BUSY_POLL,
+            &opts.socket_busy_poll, sizeof(opts.socket_busy_poll));
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+    if (opts.prefer_busy_poll)
+    {
+        int one = 1;
+        ::setsockopt(fd_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &one, sizeof(one));
+    }
+#endif
+    (void)opts;
+    return {};
+}
+
 //------------------------------------------------------------------------------
 // epoll_socket_service
 //------------------------------------------------------------------------------
@@ -659,7 +1325,7 @@ socket::socket_impl&
 epoll_socket_service::
 create_impl()
 {
-    auto impl = std::make_shared<epoll_socket_impl>(*this);
+    auto impl = make_recycled_impl<epoll_socket_impl>(*this);
     auto* raw = impl.get();
 
     {
@@ -671,6 +1337,15 @@ create_impl()
     return *raw;
 }
 
+void
+epoll_socket_service::
+collect_stats(socket_stats& st) const noexcept
+{
+    state_->sched_.collect_socket_stats(st);
+    std::lock_guard lock(state_->mutex_);
+    st.live_sockets += state_->socket_ptrs_.size();
+}
+
 void
 epoll_socket_service::
 destroy_impl(socket::socket_impl& impl)
@@ -683,16 +1358,49 @@ destroy_impl(socket::socket_impl& impl)
 
 system::error_code
 epoll_socket_service::
-open_socket(socket::socket_impl& impl)
+open_socket(
+    socket::socket_impl& impl,
+    ip_family family)
+{
+    auto* epoll_impl = static_cast<epoll_socket_impl*>(&impl);
+    epoll_impl->close_socket();
+
+    int fd = ::socket(detail::to_af(family), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    return epoll_impl->set_socket(fd);
+}
+
+system::error_code
+epoll_socket_service::
+open_local_socket(
+    socket::socket_impl& impl)
 {
     auto* epoll_impl = static_cast<epoll_socket_impl*>(&impl);
     epoll_impl->close_socket();
 
-    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (fd < 0)
         return make_err(errno);
 
-    epoll_impl->fd_ = fd;
+    return epoll_impl->set_socket(fd);
+}
+
+system::error_code
+epoll_socket_service::
+assign_socket(
+    socket::socket_impl& impl,
+    native_handle_type fd,
+    endpoint local,
+    endpoint remote)
+{
+    auto* epoll_impl = static_cast<epoll_socket_impl*>(&impl);
+    epoll_impl->close_socket();
+
+    if (auto ec = epoll_impl->set_socket(fd))
+        return ec;
+    epoll_impl->set_endpoints(local, remote);
     return {};
 }
 
@@ -19,14 +19,17 @@
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
 #include "src/detail/socket_service.hpp"
 
 #include "src/detail/epoll/op.hpp"
 #include "src/detail/epoll/scheduler.hpp"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <optional>
+#include <stop_token>
 
 /*
     epoll Socket Implementation
@@ -41,20 +44,19 @@
     operations that can complete immediately (common for small reads/writes
     on fast local connections).
 
-    One-Shot Registration
-    ---------------------
-    We use one-shot epoll registration: each operation registers, waits for
-    one event, then unregisters. This simplifies the state machine since we
-    don't need to track whether an fd is currently registered or handle
-    re-arming. The tradeoff is slightly more epoll_ctl calls, but the
-    simplicity is worth it.
+    Persistent Registration
+    -----------------------
+    The fd is registered once when the socket is opened (or accepted) and
+    stays in the epoll set until close_socket(). An operation that would
+    block parks itself in the matching descriptor_state slot; no epoll_ctl
+    call is made per operation. See op.hpp for the slot protocol.
 
     Cancellation
     ------------
-    See op.hpp for the completion/cancellation race handling via the
-    `registered` atomic. cancel() must complete pending operations (post
-    them with cancelled flag) so coroutines waiting on them can resume.
-    close_socket() calls cancel() first to ensure this.
+    cancel() must complete pending operations (post them with cancelled
+    flag) so coroutines waiting on them can resume. Whoever clears a slot
+    under the descriptor mutex owns the op. close_socket() calls cancel()
+    first to ensure this.
 
     Impl Lifetime with shared_ptr
     -----------------------------
@@ -69,6 +71,10 @@
     posting. When the op completes, impl_ptr is cleared, allowing the impl
     to be destroyed if no other references exist.
 
+    Impls, with their control blocks, and the map nodes are allocated
+    through recycling_allocator, so sockets opened and closed at a high
+    rate reuse per-thread blocks instead of calling the global allocator.
+
     Service Ownership
     -----------------
     epoll_socket_service owns all socket impls. destroy_impl() removes the
@@ -84,7 +90,7 @@ class epoll_socket_impl;
 
 //------------------------------------------------------------------------------
 
-class epoll_socket_impl
+class epoll_socket_impl final
     : public socket::socket_impl
     , public std::enable_shared_from_this<epoll_socket_impl>
     , public intrusive_list<epoll_socket_impl>::node
@@ -103,7 +109,32 @@ public:
         std::stop_token,
         system::error_code*) override;
 
-    void read_some(
+    void connect_with_data(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        endpoint,
+        capy::const_buffer,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool read_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool write_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool read_exact(
         std::coroutine_handle<>,
         capy::executor_ref,
         io_buffer_param,
@@ -111,7 +142,7 @@ public:
         system::error_code*,
         std::size_t*) override;
 
-    void write_some(
+    bool write_all(
         std::coroutine_handle<>,
         capy::executor_ref,
         io_buffer_param,
@@ -119,6 +150,41 @@ public:
         system::error_code*,
         std::size_t*) override;
 
+    bool send_file(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        native_file_type,
+        std::uint64_t,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool write_with_descriptor(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        capy::const_buffer,
+        native_handle_type,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool read_with_descriptor(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        capy::mutable_buffer,
+        native_handle_type*,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool wait(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        socket::wait_type,
+        std::stop_token,
+        system::error_code*) override;
+
     system::error_code shutdown(socket::shutdown_type what) noexcept override;
 
     native_handle_type native_handle() const noexcept override { return fd_; }
@@ -139,13 +205,38 @@ public:
     system::error_code set_linger(bool enabled, int timeout) noexcept override;
     socket::linger_options linger(system::error_code& ec) const noexcept override;
 
+    system::error_code set_zero_copy(bool value) noexcept override;
+    bool zero_copy(system::error_code& ec) const noexcept override;
+
+    system::error_code set_high_priority_completions(bool value) noexcept override;
+    bool high_priority_completions(system::error_code& ec) const noexcept override;
+
+    system::error_code set_write_coalescing(bool value) noexcept override;
+    bool write_coalescing(system::error_code& ec) const noexcept override;
+
+    system::error_code set_timestamping(bool value) noexcept override;
+    bool timestamping(system::error_code& ec) const noexcept override;
+    std::chrono::system_clock::time_point
+    last_receive_time() const noexcept override;
+    std::chrono::system_clock::time_point
+    last_send_time() const noexcept override;
+    bool set_account(io_account* a) noexcept override
+    {
+        account_ = a;
+        return true;
+    }
+    io_account* account() const noexcept { return account_; }
+    epoll_socket_service& service() const noexcept { return svc_; }
+
     endpoint local_endpoint() const noexcept override { return local_endpoint_; }
     endpoint remote_endpoint() const noexcept override { return remote_endpoint_; }
     bool is_open() const noexcept { return fd_ >= 0; }
     void cancel() noexcept override;
     void cancel_single_op(epoll_op& op) noexcept;
+    bool use_stop_slot(std::stop_token const& token) noexcept;
     void close_socket() noexcept;
-    void set_socket(int fd) noexcept { fd_ = fd; }
+    void uncork(int fd) noexcept;
+    system::error_code set_socket(int fd) noexcept;
     void set_endpoints(endpoint local, endpoint remote) noexcept
     {
         local_endpoint_ = local;
@@ -157,10 +248,57 @@ public:
     epoll_write_op wr_;
 
 private:
+    bool start_read(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*,
+        bool all);
+
+    bool start_write(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*,
+        bool all);
+
+    struct slot_canceller
+    {
+        epoll_socket_impl* impl;
+        void operator()() const noexcept;
+    };
+
+    bool start_transfer(epoll_op& op, epoll_op*& slot, bool& ready_flag);
+    void register_op(epoll_op& op, epoll_op*& slot, bool& ready_flag) noexcept;
+    void cork() noexcept;
+    void cancel_stopped() noexcept;
+    void release_stop_slot() noexcept;
+
     epoll_socket_service& svc_;
     int fd_ = -1;
+    descriptor_state* desc_ = nullptr;
+    bool zero_copy_ = false;
+    bool coalesce_ = false;                 // see "Write Coalescing"
+    std::atomic<bool> corked_{false};
+    epoll_uncork_op uncork_;
+    bool timestamping_ = false;             // see "Timestamps"
+    std::int64_t rx_time_ = 0;
+    io_account* account_ = nullptr;         // see "Accounting"
     endpoint local_endpoint_;
     endpoint remote_endpoint_;
+
+    // See "Stop Slot" in op.hpp. Last, so that the callback is
+    // removed before anything it uses is destroyed.
+    static constexpr int slot_empty = 0;
+    static constexpr int slot_busy = 1;
+    static constexpr int slot_ready = 2;
+    std::atomic<int> slot_state_{slot_empty};
+    std::stop_token slot_token_;
+    std::optional<std::stop_callback<slot_canceller>> slot_cb_;
 };
 
 //------------------------------------------------------------------------------
@@ -177,7 +315,7 @@ public:
     epoll_scheduler& sched_;
     std::mutex mutex_;
     intrusive_list<epoll_socket_impl> socket_list_;
-    std::unordered_map<epoll_socket_impl*, std::shared_ptr<epoll_socket_impl>> socket_ptrs_;
+    impl_ptr_map<epoll_socket_impl> socket_ptrs_;
 };
 
 /** epoll socket service implementation.
@@ -198,7 +336,17 @@ public:
 
     socket::socket_impl& create_impl() override;
     void destroy_impl(socket::socket_impl& impl) override;
-    system::error_code open_socket(socket::socket_impl& impl) override;
+    system::error_code open_socket(
+        socket::socket_impl& impl,
+        ip_family family) override;
+    system::error_code open_local_socket(
+        socket::socket_impl& impl) override;
+    system::error_code assign_socket(
+        socket::socket_impl& impl,
+        native_handle_type fd,
+        endpoint local,
+        endpoint remote) override;
+    void collect_stats(socket_stats& st) const noexcept override;
 
     epoll_scheduler& scheduler() const noexcept { return state_->sched_; }
     void post(epoll_op* op);
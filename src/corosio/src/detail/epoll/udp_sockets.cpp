@@ -0,0 +1,573 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_EPOLL
+
+#include "src/detail/epoll/udp_sockets.hpp"
+#include "src/detail/endpoint_convert.hpp"
+#include "src/detail/make_err.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+void
+epoll_datagram_op::
+cancel() noexcept
+{
+    if (udp_impl_)
+        udp_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+//------------------------------------------------------------------------------
+// epoll_udp_socket_impl
+//------------------------------------------------------------------------------
+
+epoll_udp_socket_impl::
+epoll_udp_socket_impl(epoll_udp_service& svc) noexcept
+    : svc_(svc)
+{
+}
+
+void
+epoll_udp_socket_impl::
+release()
+{
+    close_socket();
+    svc_.destroy_udp_impl(*this);
+}
+
+void
+epoll_udp_socket_impl::
+prepare(
+    epoll_datagram_op& op,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out) noexcept
+{
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.start(token);
+    op.trace.start(svc_.scheduler().tracer());
+    op.udp_impl_ = this;
+}
+
+bool
+epoll_udp_socket_impl::
+send_to(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    endpoint dest,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    assign_iovecs(op.iovecs, param);
+    op.addr = to_sockaddr_in(dest);
+    prepare(op, h, ex, token, ec, bytes_out);
+    return start(op, desc_->write_op, desc_->write_ready);
+}
+
+bool
+epoll_udp_socket_impl::
+receive_from(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    endpoint* source,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = rd_;
+    op.reset();
+    assign_iovecs(op.iovecs, param);
+    op.source_out = source;
+    prepare(op, h, ex, token, ec, bytes_out);
+    return start(op, desc_->read_op, desc_->read_ready);
+}
+
+bool
+epoll_udp_socket_impl::
+send_batch(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::span<udp_socket::message> msgs,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* count)
+{
+    auto& op = wr_;
+    op.reset();
+    op.assign_batch(msgs);
+    prepare(op, h, ex, token, ec, count);
+    if (msgs.empty())
+        return post_now(op);
+    return start(op, desc_->write_op, desc_->write_ready);
+}
+
+bool
+epoll_udp_socket_impl::
+receive_batch(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::span<udp_socket::message> msgs,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* count)
+{
+    auto& op = rd_;
+    op.reset();
+    op.assign_batch(msgs);
+    op.want_control = gro_;
+    prepare(op, h, ex, token, ec, count);
+    if (msgs.empty())
+        return post_now(op);
+    return start(op, desc_->read_op, desc_->read_ready);
+}
+
+bool
+epoll_udp_socket_impl::
+start(
+    epoll_op& op,
+    epoll_op*& slot,
+    bool& ready_flag)
+{
+    op.perform_io();
+    if (op.errn == EAGAIN || op.errn == EWOULDBLOCK)
+    {
+        op.errn = 0;
+        register_op(op, slot, ready_flag);
+        return false;
+    }
+
+    // See "Inline Completion" in op.hpp
+    if (op.complete_inline())
+        return true;
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+    return false;
+}
+
+bool
+epoll_udp_socket_impl::
+post_now(epoll_op& op)
+{
+    op.complete(0, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+    return false;
+}
+
+void
+epoll_udp_socket_impl::
+register_op(
+    epoll_op& op,
+    epoll_op*& slot,
+    bool& ready_flag) noexcept
+{
+    svc_.work_started();
+
+    std::unique_lock lock(desc_->mutex);
+
+    // An edge arrived while nothing was parked; retry before waiting
+    if (ready_flag)
+    {
+        ready_flag = false;
+        op.perform_io();
+        if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
+        {
+            lock.unlock();
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            svc_.work_finished();
+            return;
+        }
+        op.errn = 0;
+    }
+
+    // Cancellation requested before we could park
+    if (op.cancelled.load(std::memory_order_acquire))
+    {
+        lock.unlock();
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        svc_.work_finished();
+        return;
+    }
+
+    op.parked_at = std::chrono::steady_clock::now();
+    op.home = svc_.scheduler().affinity_home();
+    slot = &op;
+}
+
+system::error_code
+epoll_udp_socket_impl::
+bind(endpoint ep) noexcept
+{
+    sockaddr_in addr = to_sockaddr_in(ep);
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+endpoint
+epoll_udp_socket_impl::
+local_endpoint() const noexcept
+{
+    // Not cached: an unbound socket gets its port on the first send
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (fd_ < 0 ||
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+        return endpoint{};
+    return from_sockaddr_in(addr);
+}
+
+//------------------------------------------------------------------------------
+// Socket Options
+//------------------------------------------------------------------------------
+
+system::error_code
+epoll_udp_socket_impl::
+set_receive_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+epoll_udp_socket_impl::
+receive_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+epoll_udp_socket_impl::
+set_send_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+epoll_udp_socket_impl::
+send_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+epoll_udp_socket_impl::
+set_gso_segment(std::size_t size) noexcept
+{
+#ifdef UDP_SEGMENT
+    if (size > UINT16_MAX)
+        return make_err(EINVAL);
+    int value = static_cast<int>(size);
+    if (::setsockopt(fd_, SOL_UDP, UDP_SEGMENT, &value, sizeof(value)) != 0)
+    {
+        // Kernels before 4.18 do not know the option
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    }
+    return {};
+#else
+    (void)size;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+std::size_t
+epoll_udp_socket_impl::
+gso_segment(system::error_code& ec) const noexcept
+{
+#ifdef UDP_SEGMENT
+    int value = 0;
+    socklen_t len = sizeof(value);
+    if (::getsockopt(fd_, SOL_UDP, UDP_SEGMENT, &value, &len) != 0)
+    {
+        ec = make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+        return 0;
+    }
+    ec = {};
+    return static_cast<std::size_t>(value);
+#else
+    ec = {};
+    return 0;
+#endif
+}
+
+system::error_code
+epoll_udp_socket_impl::
+set_gro(bool value) noexcept
+{
+#ifdef UDP_GRO
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, SOL_UDP, UDP_GRO, &flag, sizeof(flag)) != 0)
+    {
+        // Kernels before 5.0 do not know the option
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    }
+    gro_ = value;
+    return {};
+#else
+    (void)value;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+bool
+epoll_udp_socket_impl::
+gro(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return gro_;
+}
+
+void
+epoll_udp_socket_impl::
+cancel() noexcept
+{
+    std::shared_ptr<epoll_udp_socket_impl> self;
+    try {
+        self = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        return;
+    }
+
+    rd_.request_cancel();
+    wr_.request_cancel();
+
+    if (!desc_)
+        return;
+
+    epoll_op* claimed[2];
+    {
+        std::lock_guard lock(desc_->mutex);
+        claimed[0] = std::exchange(desc_->read_op, nullptr);
+        claimed[1] = std::exchange(desc_->write_op, nullptr);
+    }
+
+    for (auto* op : claimed)
+    {
+        if (!op)
+            continue;
+        op->impl_ptr = self;
+        svc_.post(op);
+        svc_.work_finished();
+    }
+}
+
+void
+epoll_udp_socket_impl::
+cancel_single_op(epoll_op& op) noexcept
+{
+    op.request_cancel();
+
+    if (!desc_)
+        return;
+
+    epoll_op** slot = &op == &rd_ ? &desc_->read_op : &desc_->write_op;
+    {
+        std::lock_guard lock(desc_->mutex);
+        if (*slot != &op)
+            return;
+        *slot = nullptr;
+    }
+
+    // Keep impl alive until op completes
+    try {
+        op.impl_ptr = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+    }
+
+    svc_.post(&op);
+    svc_.work_finished();
+}
+
+void
+epoll_udp_socket_impl::
+close_socket() noexcept
+{
+    cancel();
+
+    if (fd_ >= 0)
+    {
+        if (desc_)
+        {
+            svc_.scheduler().deregister_descriptor(fd_, desc_);
+            desc_ = nullptr;
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+    gro_ = false;
+}
+
+system::error_code
+epoll_udp_socket_impl::
+set_socket(int fd) noexcept
+{
+    try {
+        desc_ = svc_.scheduler().register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
+    fd_ = fd;
+
+    // Best effort; the kernel may refuse without CAP_NET_ADMIN
+    auto const& opts = svc_.scheduler().options();
+#ifdef SO_BUSY_POLL
+    if (opts.socket_busy_poll > 0)
+        ::setsockopt(fd_, SOL_SOCKET, SO_BUSY_POLL,
+            &opts.socket_busy_poll, sizeof(opts.socket_busy_poll));
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+    if (opts.prefer_busy_poll)
+    {
+        int one = 1;
+        ::setsockopt(fd_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &one, sizeof(one));
+    }
+#endif
+    (void)opts;
+    return {};
+}
+
+//------------------------------------------------------------------------------
+// epoll_udp_service
+//------------------------------------------------------------------------------
+
+epoll_udp_service::
+epoll_udp_service(capy::execution_context& ctx)
+    : state_(std::make_unique<epoll_udp_state>(ctx.use_service<epoll_scheduler>()))
+{
+}
+
+epoll_udp_service::
+~epoll_udp_service()
+{
+}
+
+void
+epoll_udp_service::
+shutdown()
+{
+    std::lock_guard lock(state_->mutex_);
+
+    while (auto* impl = state_->socket_list_.pop_front())
+        impl->close_socket();
+
+    state_->socket_ptrs_.clear();
+}
+
+udp_socket::udp_socket_impl&
+epoll_udp_service::
+create_udp_impl()
+{
+    auto impl = make_recycled_impl<epoll_udp_socket_impl>(*this);
+    auto* raw = impl.get();
+
+    {
+        std::lock_guard lock(state_->mutex_);
+        state_->socket_list_.push_back(raw);
+        state_->socket_ptrs_.emplace(raw, std::move(impl));
+    }
+
+    return *raw;
+}
+
+void
+epoll_udp_service::
+destroy_udp_impl(udp_socket::udp_socket_impl& impl)
+{
+    auto* epoll_impl = static_cast<epoll_udp_socket_impl*>(&impl);
+    std::lock_guard lock(state_->mutex_);
+    state_->socket_list_.remove(epoll_impl);
+    state_->socket_ptrs_.erase(epoll_impl);
+}
+
+system::error_code
+epoll_udp_service::
+open_udp_socket(udp_socket::udp_socket_impl& impl)
+{
+    auto* epoll_impl = static_cast<epoll_udp_socket_impl*>(&impl);
+    epoll_impl->close_socket();
+
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    return epoll_impl->set_socket(fd);
+}
+
+void
+epoll_udp_service::
+post(epoll_op* op)
+{
+    state_->sched_.post(op);
+}
+
+void
+epoll_udp_service::
+work_started() noexcept
+{
+    state_->sched_.work_started();
+}
+
+void
+epoll_udp_service::
+work_finished() noexcept
+{
+    state_->sched_.work_finished();
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_EPOLL
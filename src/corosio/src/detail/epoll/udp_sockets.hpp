@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_EPOLL_UDP_SOCKETS_HPP
+#define BOOST_COROSIO_DETAIL_EPOLL_UDP_SOCKETS_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_EPOLL
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/udp_socket.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/socket_service.hpp"
+
+#include "src/detail/epoll/op.hpp"
+#include "src/detail/epoll/scheduler.hpp"
+
+#include <memory>
+#include <mutex>
+
+/*
+    epoll Datagram Socket Implementation
+    ====================================
+
+    A udp_socket follows the pattern of epoll_socket_impl: the fd is
+    registered once with the scheduler, each operation first tries its
+    system call, and one that would block parks in the read or write
+    slot of the descriptor_state until the reactor reports readiness.
+    Cancellation, impl lifetime and service ownership work as
+    described in sockets.hpp.
+
+    Every operation, single or batched, transfers whole datagrams, so
+    there is no partial-transfer state; the batch and control buffers
+    are described under "Datagrams" in op.hpp.
+*/
+
+namespace boost::corosio::detail {
+
+class epoll_udp_service;
+
+//------------------------------------------------------------------------------
+
+class epoll_udp_socket_impl
+    : public udp_socket::udp_socket_impl
+    , public std::enable_shared_from_this<epoll_udp_socket_impl>
+    , public intrusive_list<epoll_udp_socket_impl>::node
+{
+    friend class epoll_udp_service;
+
+public:
+    explicit epoll_udp_socket_impl(epoll_udp_service& svc) noexcept;
+
+    void release() override;
+
+    bool send_to(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        endpoint,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool receive_from(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        endpoint*,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool send_batch(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::span<udp_socket::message>,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool receive_batch(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::span<udp_socket::message>,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    system::error_code bind(endpoint ep) noexcept override;
+
+    native_handle_type native_handle() const noexcept override { return fd_; }
+    endpoint local_endpoint() const noexcept override;
+
+    // Socket options
+    system::error_code set_receive_buffer_size(int size) noexcept override;
+    int receive_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_send_buffer_size(int size) noexcept override;
+    int send_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_gso_segment(std::size_t size) noexcept override;
+    std::size_t gso_segment(system::error_code& ec) const noexcept override;
+
+    system::error_code set_gro(bool value) noexcept override;
+    bool gro(system::error_code& ec) const noexcept override;
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+    void cancel() noexcept override;
+    void cancel_single_op(epoll_op& op) noexcept;
+    void close_socket() noexcept;
+    system::error_code set_socket(int fd) noexcept;
+
+    epoll_receive_from_op rd_;
+    epoll_send_to_op wr_;
+
+private:
+    void prepare(
+        epoll_datagram_op& op,
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) noexcept;
+
+    bool start(epoll_op& op, epoll_op*& slot, bool& ready_flag);
+    bool post_now(epoll_op& op);
+    void register_op(epoll_op& op, epoll_op*& slot, bool& ready_flag) noexcept;
+
+    epoll_udp_service& svc_;
+    int fd_ = -1;
+    descriptor_state* desc_ = nullptr;
+    bool gro_ = false;
+};
+
+//------------------------------------------------------------------------------
+
+/** State for epoll datagram socket service. */
+class epoll_udp_state
+{
+public:
+    explicit epoll_udp_state(epoll_scheduler& sched) noexcept
+        : sched_(sched)
+    {
+    }
+
+    epoll_scheduler& sched_;
+    std::mutex mutex_;
+    intrusive_list<epoll_udp_socket_impl> socket_list_;
+    impl_ptr_map<epoll_udp_socket_impl> socket_ptrs_;
+};
+
+/** epoll datagram socket service implementation.
+
+    Inherits from udp_service to enable runtime polymorphism.
+    Uses key_type = udp_service for service lookup.
+*/
+class epoll_udp_service : public udp_service
+{
+public:
+    explicit epoll_udp_service(capy::execution_context& ctx);
+    ~epoll_udp_service();
+
+    epoll_udp_service(epoll_udp_service const&) = delete;
+    epoll_udp_service& operator=(epoll_udp_service const&) = delete;
+
+    void shutdown() override;
+
+    udp_socket::udp_socket_impl& create_udp_impl() override;
+    void destroy_udp_impl(udp_socket::udp_socket_impl& impl) override;
+    system::error_code open_udp_socket(udp_socket::udp_socket_impl& impl) override;
+
+    epoll_scheduler& scheduler() const noexcept { return state_->sched_; }
+    void post(epoll_op* op);
+    void work_started() noexcept;
+    void work_finished() noexcept;
+
+private:
+    std::unique_ptr<epoll_udp_state> state_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_EPOLL
+
+#endif // BOOST_COROSIO_DETAIL_EPOLL_UDP_SOCKETS_HPP
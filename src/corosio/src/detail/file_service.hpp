@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_FILE_SERVICE_HPP
+#define BOOST_COROSIO_DETAIL_FILE_SERVICE_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/random_access_file.hpp>
+#include <boost/corosio/stream_file.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+
+/*
+    Abstract File Service
+    =====================
+
+    As with socket_service, the backends derive from file_service and
+    inherit its key_type, so find_service<file_service>() returns the
+    implementation the scheduler installed:
+
+    - io_uring_file_service submits reads and writes to the ring
+    - win_file_service issues overlapped ReadFile/WriteFile on the port
+    - posix_file_service runs them on worker threads, for the
+      reactor backends, which cannot wait for regular files
+
+    One implementation object serves both file types: it derives from
+    random_access_file_impl and stream_file_impl, and overrides their
+    common functions once. A stream file passes its position as the
+    offset and advances it when a transfer completes.
+*/
+
+namespace boost::corosio::detail {
+
+/** Abstract file service base class.
+
+    This is the service interface used by random_access_file.cpp
+    and stream_file.cpp.
+*/
+class file_service : public capy::execution_context::service
+{
+public:
+    using key_type = file_service;
+
+    /** Create a new random access file implementation.
+
+        @return Reference to the newly created implementation.
+    */
+    virtual random_access_file::random_access_file_impl&
+    create_random_access_impl() = 0;
+
+    /** Create a new stream file implementation.
+
+        @return Reference to the newly created implementation.
+    */
+    virtual stream_file::stream_file_impl&
+    create_stream_impl() = 0;
+
+protected:
+    file_service() = default;
+    ~file_service() override = default;
+};
+
+/** Compute the position a stream file seek moves to.
+
+    @param pos The current position.
+    @param size The size of the file, used for `seek_end`.
+*/
+inline std::uint64_t
+seek_position(
+    std::uint64_t pos,
+    std::uint64_t size,
+    std::int64_t offset,
+    file_base::seek_basis whence,
+    system::error_code& ec) noexcept
+{
+    std::uint64_t base = 0;
+    if (whence == file_base::seek_cur)
+        base = pos;
+    else if (whence == file_base::seek_end)
+        base = size;
+
+    if (offset < 0 && static_cast<std::uint64_t>(-(offset + 1)) >= base)
+    {
+        ec = make_error_code(system::errc::invalid_argument);
+        return pos;
+    }
+    ec = {};
+    return base + static_cast<std::uint64_t>(offset);
+}
+
+} // namespace boost::corosio::detail
+
+#endif
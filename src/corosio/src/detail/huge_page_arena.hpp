@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_HUGE_PAGE_ARENA_HPP
+#define BOOST_COROSIO_DETAIL_HUGE_PAGE_ARENA_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace boost::corosio::detail {
+
+/** The bounds of the arena made by reserve_huge_pages.
+
+    Both are zero until the arena exists, and set once.
+*/
+struct huge_page_range
+{
+    std::atomic<std::uintptr_t> begin{0};
+    std::atomic<std::uintptr_t> end{0};
+};
+
+BOOST_COROSIO_DECL
+huge_page_range&
+huge_page_bounds() noexcept;
+
+/// Take a block from the arena, or nullptr if there is none left.
+BOOST_COROSIO_DECL
+void*
+huge_page_allocate(std::size_t n) noexcept;
+
+/// Return a block to the arena.
+BOOST_COROSIO_DECL
+void
+huge_page_deallocate(void* p, std::size_t n) noexcept;
+
+/** Allocate a block that a pool recycles.
+
+    Comes from the huge page arena while it has room, otherwise
+    from the global allocator. Free it with @ref pool_deallocate
+    and the same size.
+
+    @throws std::bad_alloc if memory is exhausted.
+*/
+inline void*
+pool_allocate(std::size_t n)
+{
+    if (huge_page_bounds().end.load(std::memory_order_acquire) != 0)
+        if (void* p = huge_page_allocate(n))
+            return p;
+    return ::operator new(n);
+}
+
+/// Free a block from @ref pool_allocate.
+inline void
+pool_deallocate(void* p, std::size_t n) noexcept
+{
+    auto const& r = huge_page_bounds();
+    auto const a = reinterpret_cast<std::uintptr_t>(p);
+    if (a >= r.begin.load(std::memory_order_relaxed) &&
+        a < r.end.load(std::memory_order_relaxed))
+    {
+        huge_page_deallocate(p, n);
+        return;
+    }
+    ::operator delete(p);
+}
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -10,8 +10,14 @@
 #ifndef BOOST_COROSIO_DETAIL_INTRUSIVE_HPP
 #define BOOST_COROSIO_DETAIL_INTRUSIVE_HPP
 
+#include <atomic>
+#include <cstddef>
+
 namespace boost::corosio::detail {
 
+template<class T>
+class intrusive_mpsc_queue;
+
 //------------------------------------------------
 
 /** An intrusive doubly linked list.
@@ -66,6 +72,13 @@ public:
         return head_ == nullptr;
     }
 
+    /// Return the first element, or null if the list is empty.
+    T*
+    front() const noexcept
+    {
+        return head_;
+    }
+
     void
     push_back(T* w) noexcept
     {
@@ -124,6 +137,15 @@ public:
         else
             tail_ = w->prev_;
     }
+
+    /// Call `f` with each element, front to back.
+    template<class F>
+    void
+    for_each(F&& f) const
+    {
+        for(T* w = head_; w; w = w->next_)
+            f(*w);
+    }
 };
 
 //------------------------------------------------
@@ -153,14 +175,18 @@ public:
     class node
     {
         friend class intrusive_queue;
+        friend class intrusive_mpsc_queue<T>;
 
     private:
         T* next_;
     };
 
 private:
+    friend class intrusive_mpsc_queue<T>;
+
     T* head_ = nullptr;
     T* tail_ = nullptr;
+    std::size_t size_ = 0;
 
 public:
     intrusive_queue() = default;
@@ -168,9 +194,11 @@ public:
     intrusive_queue(intrusive_queue&& other) noexcept
         : head_(other.head_)
         , tail_(other.tail_)
+        , size_(other.size_)
     {
         other.head_ = nullptr;
         other.tail_ = nullptr;
+        other.size_ = 0;
     }
 
     intrusive_queue(intrusive_queue const&) = delete;
@@ -183,6 +211,13 @@ public:
         return head_ == nullptr;
     }
 
+    /// Return the number of elements.
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
     void
     push(T* w) noexcept
     {
@@ -192,6 +227,7 @@ public:
         else
             head_ = w;
         tail_ = w;
+        ++size_;
     }
 
     void
@@ -204,8 +240,10 @@ public:
         else
             head_ = other.head_;
         tail_ = other.tail_;
+        size_ += other.size_;
         other.head_ = nullptr;
         other.tail_ = nullptr;
+        other.size_ = 0;
     }
 
     T*
@@ -217,10 +255,126 @@ public:
         head_ = head_->next_;
         if(!head_)
             tail_ = nullptr;
+        --size_;
         return w;
     }
 };
 
+//------------------------------------------------
+
+/** An intrusive multi-producer, single-consumer queue.
+
+    Any number of threads may call @ref push concurrently without
+    locking. Elements are linked through the same `next_` pointer
+    as @ref intrusive_queue, so a type usable with one is usable
+    with the other.
+
+    Producers push onto a lock-free stack. The consumer detaches
+    the whole stack in one exchange and reverses it, so elements
+    are delivered in the order they were pushed. A `next_` link is
+    only written before its element is published and only read
+    after it is detached, so the link itself needs no atomics.
+
+    @tparam T The element type. Must derive from `intrusive_queue<T>::node`.
+*/
+template<class T>
+class intrusive_mpsc_queue
+{
+    std::atomic<T*> head_{nullptr};
+
+public:
+    intrusive_mpsc_queue() = default;
+    intrusive_mpsc_queue(intrusive_mpsc_queue const&) = delete;
+    intrusive_mpsc_queue& operator=(intrusive_mpsc_queue const&) = delete;
+
+    /** Return true if the queue appears empty.
+
+        The result may be stale by the time it is used unless the
+        caller provides its own ordering with producers.
+    */
+    bool
+    empty() const noexcept
+    {
+        return head_.load(std::memory_order_seq_cst) == nullptr;
+    }
+
+    /** Add an element. Safe to call from any thread. */
+    void
+    push(T* w) noexcept
+    {
+        T* head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            w->next_ = head;
+        }
+        while(!head_.compare_exchange_weak(
+            head, w,
+            std::memory_order_seq_cst,
+            std::memory_order_relaxed));
+    }
+
+    /** Add every element of `q`, keeping their order.
+
+        The elements are published with one exchange, so a consumer
+        sees all of them or none. Safe to call from any thread.
+    */
+    void
+    push_all(intrusive_queue<T>& q) noexcept
+    {
+        if(q.empty())
+            return;
+
+        // Link the batch newest first, as single pushes would
+        T* first = q.head_;
+        T* top = nullptr;
+        while(T* w = q.pop())
+        {
+            w->next_ = top;
+            top = w;
+        }
+
+        T* head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            first->next_ = head;
+        }
+        while(!head_.compare_exchange_weak(
+            head, top,
+            std::memory_order_seq_cst,
+            std::memory_order_relaxed));
+    }
+
+    /** Move all elements to the back of `q` in FIFO order.
+
+        Only one thread may consume at a time.
+
+        @return `true` if any elements were moved.
+    */
+    bool
+    pop_all(intrusive_queue<T>& q) noexcept
+    {
+        T* w = head_.exchange(nullptr, std::memory_order_acquire);
+        if(!w)
+            return false;
+
+        // Reverse the detached stack into push order
+        intrusive_queue<T> batch;
+        batch.tail_ = w;
+        T* prev = nullptr;
+        while(w)
+        {
+            T* next = w->next_;
+            w->next_ = prev;
+            prev = w;
+            w = next;
+            ++batch.size_;
+        }
+        batch.head_ = prev;
+        q.splice(batch);
+        return true;
+    }
+};
+
 } // namespace boost::corosio::detail
 
 #endif
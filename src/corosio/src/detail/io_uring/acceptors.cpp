@@ -0,0 +1,651 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/acceptors.hpp"
+#include "src/detail/io_uring/sockets.hpp"
+#include "src/detail/endpoint_convert.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/posix/fast_open.hpp"
+#include "src/detail/posix/listener.hpp"
+#include "src/detail/posix/local.hpp"
+#include "src/detail/posix/reuseport.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <cstring>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+//------------------------------------------------------------------------------
+// io_uring_accept_op::cancel
+//------------------------------------------------------------------------------
+
+void
+io_uring_accept_op::
+cancel() noexcept
+{
+    if (acceptor_impl_)
+        acceptor_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+//------------------------------------------------------------------------------
+// io_uring_accept_op::operator() - creates peer socket and caches endpoints
+//------------------------------------------------------------------------------
+
+void
+io_uring_accept_op::
+operator()()
+{
+    stop_cb.reset();
+
+    bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+
+    if (ec_out)
+    {
+        if (cancelled.load(std::memory_order_acquire))
+            *ec_out = capy::error::canceled;
+        else if (errn != 0)
+            *ec_out = make_err(errn);
+        else
+            *ec_out = {};
+    }
+
+    if (success && accepted_fd >= 0)
+    {
+        if (acceptor_impl_)
+        {
+            auto* socket_svc = static_cast<io_uring_acceptor_impl*>(acceptor_impl_)
+                ->service().socket_service();
+            if (socket_svc)
+            {
+                auto& impl = static_cast<io_uring_socket_impl&>(socket_svc->create_impl());
+                // set_socket takes ownership of the fd, closing it on failure
+                if (auto reg_ec = impl.set_socket(accepted_fd))
+                {
+                    accepted_fd = -1;
+                    impl.release();
+                    if (ec_out)
+                        *ec_out = reg_ec;
+                    if (impl_out)
+                        *impl_out = nullptr;
+
+                    capy::executor_ref saved_ex( std::move( ex ) );
+                    capy::coro saved_h( std::move( h ) );
+                    impl_ptr.reset();
+                    saved_ex.dispatch( saved_h ).resume();
+                    return;
+                }
+
+                sockaddr_storage local_addr{};
+                socklen_t local_len = sizeof(local_addr);
+                sockaddr_storage remote_addr{};
+                socklen_t remote_len = sizeof(remote_addr);
+
+                endpoint local_ep, remote_ep;
+                if (::getsockname(accepted_fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+                    local_ep = from_sockaddr(local_addr);
+                if (::getpeername(accepted_fd, reinterpret_cast<sockaddr*>(&remote_addr), &remote_len) == 0)
+                    remote_ep = from_sockaddr(remote_addr);
+
+                impl.set_endpoints(local_ep, remote_ep);
+
+                if (impl_out)
+                    *impl_out = &impl;
+
+                accepted_fd = -1;
+            }
+            else
+            {
+                if (ec_out && !*ec_out)
+                    *ec_out = make_err(ENOENT);
+                ::close(accepted_fd);
+                accepted_fd = -1;
+                if (impl_out)
+                    *impl_out = nullptr;
+            }
+        }
+        else
+        {
+            ::close(accepted_fd);
+            accepted_fd = -1;
+            if (impl_out)
+                *impl_out = nullptr;
+        }
+    }
+    else
+    {
+        if (accepted_fd >= 0)
+        {
+            ::close(accepted_fd);
+            accepted_fd = -1;
+        }
+
+        if (impl_out)
+            *impl_out = nullptr;
+    }
+
+    // Move to stack before destroying the frame
+    capy::executor_ref saved_ex( std::move( ex ) );
+    capy::coro saved_h( std::move( h ) );
+    impl_ptr.reset();
+    saved_ex.dispatch( saved_h ).resume();
+}
+
+//------------------------------------------------------------------------------
+// io_uring_acceptor_impl
+//------------------------------------------------------------------------------
+
+io_uring_acceptor_impl::
+io_uring_acceptor_impl(io_uring_acceptor_service& svc) noexcept
+    : svc_(svc)
+{
+}
+
+void
+io_uring_acceptor_impl::
+release()
+{
+    close_socket();
+    svc_.destroy_acceptor_impl(*this);
+}
+
+void
+io_uring_acceptor_impl::
+accept(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    io_object::io_object_impl** impl_out)
+{
+    auto& op = acc_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.impl_out = impl_out;
+    op.fd = fd_;
+    op.start(token, this);
+
+    op.impl_ptr = shared_from_this();
+
+    if (backlog_limit_ == 0)
+    {
+        svc_.scheduler().submit(op);
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+
+    if (backlog_.empty() && backlog_errn_ == 0 &&
+        !op.cancelled.load(std::memory_order_acquire))
+    {
+        // Completed by on_cqe() or cancel_single_op()
+        if (!armed_)
+            arm_multishot();
+        svc_.scheduler().work_started();
+        waiting_ = true;
+        return;
+    }
+
+    if (!backlog_.empty())
+    {
+        op.accepted_fd = backlog_.front();
+        backlog_.pop_front();
+    }
+    else if (backlog_errn_ != 0)
+    {
+        op.complete(backlog_errn_, 0);
+        backlog_errn_ = 0;
+    }
+
+    // Room again after throttling, or the stream ended
+    if (!armed_ && fd_ >= 0 && backlog_.size() < backlog_limit_)
+    {
+        try {
+            arm_multishot();
+        } catch (system::system_error const&) {
+            // Retried by the next accept
+        }
+    }
+
+    lock.unlock();
+    svc_.post(&op);
+}
+
+void
+io_uring_acceptor_impl::
+arm_multishot()
+{
+    // Caller holds mutex_
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_ACCEPT;
+    sqe.fd = fd_;
+    sqe.ioprio = IORING_ACCEPT_MULTISHOT;  // Linux 5.19
+    sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+
+    stream_ptr_ = shared_from_this();
+    armed_ = true;
+    cancel_requested_ = false;
+    discard_ = false;
+    try {
+        svc_.scheduler().submit_multishot(*this, sqe);
+    } catch (...) {
+        armed_ = false;
+        stream_ptr_.reset();
+        throw;
+    }
+}
+
+scheduler_op*
+io_uring_acceptor_impl::
+on_cqe(int res, unsigned flags) noexcept
+{
+    // Destroyed after the lock is released; may be the last reference
+    std::shared_ptr<io_uring_acceptor_impl> self;
+    std::lock_guard lock(mutex_);
+
+    bool more = (flags & IORING_CQE_F_MORE) != 0;
+    scheduler_op* ready = nullptr;
+    if (res >= 0)
+    {
+        if (discard_ || fd_ < 0)
+        {
+            ::close(res);
+        }
+        else if (waiting_)
+        {
+            waiting_ = false;
+            acc_.accepted_fd = res;
+            ready = &acc_;
+        }
+        else
+        {
+            backlog_.push_back(res);
+            if (more && !cancel_requested_ &&
+                backlog_.size() >= backlog_limit_)
+            {
+                cancel_requested_ = true;
+                svc_.scheduler().cancel_multishot(*this);
+            }
+        }
+    }
+    else if (res != -ECANCELED || !cancel_requested_)
+    {
+        // The stream failed; report it to the current or next accept
+        if (waiting_)
+        {
+            waiting_ = false;
+            acc_.complete(-res, 0);
+            ready = &acc_;
+        }
+        else if (fd_ >= 0)
+        {
+            backlog_errn_ = -res;
+        }
+    }
+
+    if (more)
+        return ready;
+
+    armed_ = false;
+    self = std::move(stream_ptr_);
+
+    // Re-arm after a throttle, or if an accept arrived meanwhile
+    bool throttled = cancel_requested_ && !discard_ && res == -ECANCELED;
+    if (fd_ >= 0 && backlog_errn_ == 0 &&
+        (waiting_ || (throttled && backlog_.size() < backlog_limit_)))
+    {
+        try {
+            arm_multishot();
+        } catch (system::system_error const& e) {
+            if (waiting_)
+            {
+                waiting_ = false;
+                acc_.complete(e.code().value(), 0);
+                ready = &acc_;
+            }
+        }
+    }
+
+    return ready;
+}
+
+bool
+io_uring_acceptor_impl::
+take_waiter() noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (!waiting_)
+        return false;
+    waiting_ = false;
+    return true;
+}
+
+void
+io_uring_acceptor_impl::
+cancel() noexcept
+{
+    cancel_single_op(acc_);
+}
+
+void
+io_uring_acceptor_impl::
+cancel_single_op(io_uring_op& op) noexcept
+{
+    // Called from stop_token callback to cancel a specific pending operation.
+    op.request_cancel();
+
+    // An accept parked on the multishot stream is not in the kernel
+    if (&op == &acc_ && take_waiter())
+    {
+        svc_.post(&op);
+        svc_.scheduler().work_finished();
+        return;
+    }
+
+    svc_.scheduler().cancel(op);
+}
+
+void
+io_uring_acceptor_impl::
+close_socket() noexcept
+{
+    // Closing the fd alone would not cancel requests the kernel owns
+    cancel();
+
+    {
+        std::lock_guard lock(mutex_);
+        if (armed_ && !discard_)
+        {
+            cancel_requested_ = true;
+            discard_ = true;
+            try {
+                svc_.scheduler().cancel_multishot(*this);
+            } catch (...) {
+                // The ring is unusable; late arrivals are closed
+            }
+        }
+
+        for (int fd : backlog_)
+            ::close(fd);
+        backlog_.clear();
+        backlog_errn_ = 0;
+
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    // Clear cached endpoint
+    local_endpoint_ = endpoint{};
+}
+
+//------------------------------------------------------------------------------
+// io_uring_acceptor_service
+//------------------------------------------------------------------------------
+
+io_uring_acceptor_service::
+io_uring_acceptor_service(capy::execution_context& ctx)
+    : ctx_(ctx)
+    , state_(std::make_unique<io_uring_acceptor_state>(ctx.use_service<io_uring_scheduler>()))
+{
+}
+
+io_uring_acceptor_service::
+~io_uring_acceptor_service()
+{
+}
+
+void
+io_uring_acceptor_service::
+shutdown()
+{
+    std::lock_guard lock(state_->mutex_);
+
+    while (auto* impl = state_->acceptor_list_.pop_front())
+        impl->close_socket();
+
+    state_->acceptor_ptrs_.clear();
+}
+
+acceptor::acceptor_impl&
+io_uring_acceptor_service::
+create_acceptor_impl()
+{
+    auto impl = make_recycled_impl<io_uring_acceptor_impl>(*this);
+    auto* raw = impl.get();
+
+    std::lock_guard lock(state_->mutex_);
+    state_->acceptor_list_.push_back(raw);
+    state_->acceptor_ptrs_.emplace(raw, std::move(impl));
+
+    return *raw;
+}
+
+void
+io_uring_acceptor_service::
+destroy_acceptor_impl(acceptor::acceptor_impl& impl)
+{
+    auto* uring_impl = static_cast<io_uring_acceptor_impl*>(&impl);
+    std::lock_guard lock(state_->mutex_);
+    state_->acceptor_list_.remove(uring_impl);
+    state_->acceptor_ptrs_.erase(uring_impl);
+}
+
+system::error_code
+io_uring_acceptor_service::
+open_acceptor(
+    acceptor::acceptor_impl& impl,
+    endpoint ep,
+    acceptor::listen_options const& opts)
+{
+    auto* uring_impl = static_cast<io_uring_acceptor_impl*>(&impl);
+    uring_impl->close_socket();
+
+    int fd = ::socket(detail::to_af(ep.family()), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (opts.reuse_port &&
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    // Set explicitly; the default differs between platforms
+    if (ep.is_v6())
+    {
+        int v6_only = opts.dual_stack ? 0 : 1;
+        if (::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY,
+                &v6_only, sizeof(v6_only)) < 0)
+        {
+            int errn = errno;
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (opts.fast_open_queue > 0)
+    {
+        int errn = detail::set_fast_open_queue(fd, opts.fast_open_queue);
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    if (::listen(fd, opts.backlog) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (opts.cpu_steering)
+    {
+        int errn = opts.reuse_port
+            ? detail::attach_cpu_steering(fd)
+            : EINVAL;
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    {
+        std::lock_guard lock(uring_impl->mutex_);
+        uring_impl->fd_ = fd;
+        uring_impl->backlog_limit_ = scheduler().options().accept_backlog;
+
+        // A stream still draining from a previous listen is re-armed
+        // by its final CQE once an accept waits
+        if (uring_impl->backlog_limit_ > 0 && !uring_impl->armed_)
+        {
+            try {
+                uring_impl->arm_multishot();
+            } catch (system::system_error const& e) {
+                uring_impl->fd_ = -1;
+                ::close(fd);
+                return e.code();
+            }
+        }
+    }
+
+    // Cache the local endpoint (queries OS for ephemeral port if port was 0)
+    sockaddr_storage local_addr{};
+    socklen_t local_len = sizeof(local_addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+        uring_impl->set_local_endpoint(detail::from_sockaddr(local_addr));
+
+    return {};
+}
+
+system::error_code
+io_uring_acceptor_service::
+assign_acceptor(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd)
+{
+    auto* uring_impl = static_cast<io_uring_acceptor_impl*>(&impl);
+    uring_impl->close_socket();
+
+    endpoint local;
+    if (int errn = detail::prepare_inherited_listener(fd, local))
+        return make_err(errn);
+
+    {
+        std::lock_guard lock(uring_impl->mutex_);
+        uring_impl->fd_ = fd;
+        uring_impl->backlog_limit_ = scheduler().options().accept_backlog;
+        if (uring_impl->backlog_limit_ > 0 && !uring_impl->armed_)
+        {
+            try {
+                uring_impl->arm_multishot();
+            } catch (system::system_error const& e) {
+                uring_impl->fd_ = -1;
+                return e.code();
+            }
+        }
+    }
+    uring_impl->set_local_endpoint(local);
+    return {};
+}
+
+system::error_code
+io_uring_acceptor_service::
+open_local_acceptor(
+    acceptor::acceptor_impl& impl,
+    std::string_view path,
+    int backlog)
+{
+    auto* uring_impl = static_cast<io_uring_acceptor_impl*>(&impl);
+    uring_impl->close_socket();
+
+    sockaddr_un addr;
+    socklen_t addrlen;
+    if (int errn = detail::to_sockaddr_un(path, addr, addrlen))
+        return make_err(errn);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0 ||
+        ::listen(fd, backlog) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    std::lock_guard lock(uring_impl->mutex_);
+    uring_impl->fd_ = fd;
+    uring_impl->backlog_limit_ = scheduler().options().accept_backlog;
+    if (uring_impl->backlog_limit_ > 0 && !uring_impl->armed_)
+    {
+        try {
+            uring_impl->arm_multishot();
+        } catch (system::system_error const& e) {
+            uring_impl->fd_ = -1;
+            ::close(fd);
+            return e.code();
+        }
+    }
+    return {};
+}
+
+void
+io_uring_acceptor_service::
+post(io_uring_op* op)
+{
+    state_->sched_.post(op);
+}
+
+io_uring_socket_service*
+io_uring_acceptor_service::
+socket_service() const noexcept
+{
+    auto* svc = ctx_.find_service<detail::socket_service>();
+    return svc ? dynamic_cast<io_uring_socket_service*>(svc) : nullptr;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
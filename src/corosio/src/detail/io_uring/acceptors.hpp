@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_ACCEPTORS_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_ACCEPTORS_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/acceptor.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/socket_service.hpp"
+
+#include "src/detail/io_uring/op.hpp"
+#include "src/detail/io_uring/scheduler.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace boost::corosio::detail {
+
+class io_uring_acceptor_service;
+class io_uring_acceptor_impl;
+class io_uring_socket_service;
+
+//------------------------------------------------------------------------------
+
+/** io_uring acceptor implementation.
+
+    With a nonzero `io_uring_options::accept_backlog` the acceptor keeps
+    a multishot IORING_OP_ACCEPT armed from the moment it listens. Each
+    accepted descriptor either completes the pending accept op or waits
+    in `backlog_`, so an accept() issued during a connection storm
+    completes without a submission or a syscall. When the backlog
+    reaches its limit the request is cancelled, and it is armed again
+    once accept() makes room. The final CQE of a request releases the
+    impl reference the request held.
+*/
+class io_uring_acceptor_impl
+    : public acceptor::acceptor_impl
+    , public std::enable_shared_from_this<io_uring_acceptor_impl>
+    , public intrusive_list<io_uring_acceptor_impl>::node
+    , public io_uring_multishot
+{
+    friend class io_uring_acceptor_service;
+
+public:
+    explicit io_uring_acceptor_impl(io_uring_acceptor_service& svc) noexcept;
+
+    void release() override;
+
+    void accept(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::stop_token,
+        system::error_code*,
+        io_object::io_object_impl**) override;
+
+    int native_handle() const noexcept override { return fd_; }
+    endpoint local_endpoint() const noexcept override { return local_endpoint_; }
+    bool is_open() const noexcept { return fd_ >= 0; }
+    void cancel() noexcept override;
+    void cancel_single_op(io_uring_op& op) noexcept;
+    void close_socket() noexcept;
+    void set_local_endpoint(endpoint ep) noexcept { local_endpoint_ = ep; }
+
+    io_uring_acceptor_service& service() noexcept { return svc_; }
+
+    scheduler_op* on_cqe(int res, unsigned flags) noexcept override;
+
+    io_uring_accept_op acc_;
+
+private:
+    bool take_waiter() noexcept;
+    void arm_multishot();
+
+    io_uring_acceptor_service& svc_;
+    int fd_ = -1;
+    endpoint local_endpoint_;
+
+    // Multishot state, guarded by mutex_
+    std::mutex mutex_;
+    std::deque<int> backlog_;               // accepted, not yet claimed
+    std::size_t backlog_limit_ = 0;         // zero: one accept per call
+    int backlog_errn_ = 0;                  // stream error for the next accept
+    bool armed_ = false;                    // final CQE not yet seen
+    bool cancel_requested_ = false;         // throttled or closing
+    bool discard_ = false;                  // close late arrivals
+    bool waiting_ = false;                  // acc_ awaits a connection
+    std::shared_ptr<io_uring_acceptor_impl> stream_ptr_;  // held while armed
+};
+
+//------------------------------------------------------------------------------
+
+/** State for io_uring acceptor service. */
+class io_uring_acceptor_state
+{
+public:
+    explicit io_uring_acceptor_state(io_uring_scheduler& sched) noexcept
+        : sched_(sched)
+    {
+    }
+
+    io_uring_scheduler& sched_;
+    std::mutex mutex_;
+    intrusive_list<io_uring_acceptor_impl> acceptor_list_;
+    impl_ptr_map<io_uring_acceptor_impl> acceptor_ptrs_;
+};
+
+/** io_uring acceptor service implementation.
+
+    Inherits from acceptor_service to enable runtime polymorphism.
+    Uses key_type = acceptor_service for service lookup.
+*/
+class io_uring_acceptor_service : public acceptor_service
+{
+public:
+    explicit io_uring_acceptor_service(capy::execution_context& ctx);
+    ~io_uring_acceptor_service();
+
+    io_uring_acceptor_service(io_uring_acceptor_service const&) = delete;
+    io_uring_acceptor_service& operator=(io_uring_acceptor_service const&) = delete;
+
+    void shutdown() override;
+
+    acceptor::acceptor_impl& create_acceptor_impl() override;
+    void destroy_acceptor_impl(acceptor::acceptor_impl& impl) override;
+    system::error_code open_acceptor(
+        acceptor::acceptor_impl& impl,
+        endpoint ep,
+        acceptor::listen_options const& opts) override;
+    system::error_code assign_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd) override;
+    system::error_code open_local_acceptor(
+        acceptor::acceptor_impl& impl,
+        std::string_view path,
+        int backlog) override;
+
+    io_uring_scheduler& scheduler() const noexcept { return state_->sched_; }
+    void post(io_uring_op* op);
+
+    /** Get the socket service for creating peer sockets during accept. */
+    io_uring_socket_service* socket_service() const noexcept;
+
+private:
+    capy::execution_context& ctx_;
+    std::unique_ptr<io_uring_acceptor_state> state_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_ACCEPTORS_HPP
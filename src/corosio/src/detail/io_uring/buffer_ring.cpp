@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/buffer_ring.hpp"
+#include "src/detail/make_err.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+
+#include <atomic>
+#include <cstring>
+
+#include <errno.h>
+#include <sys/mman.h>
+
+namespace boost::corosio::detail {
+
+io_uring_buffer_ring::
+io_uring_buffer_ring(
+    io_uring_ring& ring,
+    std::uint16_t group,
+    unsigned count,
+    std::size_t size)
+    : ring_(ring)
+    , size_(size)
+    , mask_(count - 1)
+    , group_(group)
+{
+    if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || size == 0)
+        detail::throw_system_error(make_err(EINVAL), "io_uring buffer ring");
+
+    // The kernel requires the ring itself to be page aligned
+    ring_bytes_ = count * sizeof(io_uring_buf);
+    void* p = ::mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        detail::throw_system_error(make_err(errno), "io_uring buffer ring mmap");
+    br_ = static_cast<io_uring_buf_ring*>(p);
+
+    pool_bytes_ = count * size;
+    p = ::mmap(nullptr, pool_bytes_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        int errn = errno;
+        ::munmap(br_, ring_bytes_);
+        detail::throw_system_error(make_err(errn), "io_uring buffer pool mmap");
+    }
+    base_ = static_cast<unsigned char*>(p);
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<__u64>(br_);
+    reg.ring_entries = count;
+    reg.bgid = group;
+    int r = ring_.register_op(IORING_REGISTER_PBUF_RING, &reg, 1);
+    if (r < 0)
+    {
+        ::munmap(base_, pool_bytes_);
+        ::munmap(br_, ring_bytes_);
+        detail::throw_system_error(make_err(-r), "IORING_REGISTER_PBUF_RING");
+    }
+
+    std::lock_guard lock(mutex_);
+    for (unsigned i = 0; i < count; ++i)
+        add(static_cast<std::uint16_t>(i));
+}
+
+io_uring_buffer_ring::
+~io_uring_buffer_ring()
+{
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.bgid = group_;
+    ring_.register_op(IORING_UNREGISTER_PBUF_RING, &reg, 1);
+
+    ::munmap(base_, pool_bytes_);
+    ::munmap(br_, ring_bytes_);
+}
+
+void
+io_uring_buffer_ring::
+recycle(std::uint16_t bid) noexcept
+{
+    std::lock_guard lock(mutex_);
+    add(bid);
+}
+
+void
+io_uring_buffer_ring::
+add(std::uint16_t bid) noexcept
+{
+    // Caller holds mutex_
+    auto& buf = br_->bufs[tail_ & mask_];
+    buf.addr = reinterpret_cast<__u64>(buffer(bid));
+    buf.len = static_cast<__u32>(size_);
+    buf.bid = bid;
+    ++tail_;
+
+    // Publishes the entry; pairs with the kernel's acquire of the tail
+    std::atomic_ref<__u16>(br_->tail).store(tail_, std::memory_order_release);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_BUFFER_RING_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_BUFFER_RING_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+
+#include "src/detail/io_uring/ring.hpp"
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/*
+    io_uring Provided Buffer Ring
+    =============================
+
+    A pool of equally sized buffers registered with the kernel through
+    IORING_REGISTER_PBUF_RING (Linux 5.19). A receive submitted with
+    IOSQE_BUFFER_SELECT names the group instead of a buffer; the kernel
+    takes the next buffer from the ring only when data arrives and
+    reports its id in the CQE flags. Idle sockets therefore hold no
+    memory at all.
+
+    The ring is a single-producer queue from user space: recycle()
+    writes the buffer back at the tail and publishes the tail with
+    release semantics. Buffers are returned from whichever thread drops
+    the lease, so recycling is serialized by a mutex. The kernel is the
+    only consumer.
+*/
+
+namespace boost::corosio::detail {
+
+class io_uring_buffer_ring
+{
+public:
+    /** Allocate and register the pool.
+
+        @param ring The ring to register with.
+        @param group The buffer group id.
+        @param count Number of buffers, a power of two up to 32768.
+        @param size Size of each buffer in bytes.
+
+        @throws std::system_error if the kernel refuses the ring.
+    */
+    io_uring_buffer_ring(
+        io_uring_ring& ring,
+        std::uint16_t group,
+        unsigned count,
+        std::size_t size);
+
+    ~io_uring_buffer_ring();
+
+    io_uring_buffer_ring(io_uring_buffer_ring const&) = delete;
+    io_uring_buffer_ring& operator=(io_uring_buffer_ring const&) = delete;
+
+    /// Return the buffer group id.
+    std::uint16_t group() const noexcept { return group_; }
+
+    /// Return the size of each buffer.
+    std::size_t buffer_size() const noexcept { return size_; }
+
+    /// Return the memory of buffer `bid`.
+    void* buffer(std::uint16_t bid) const noexcept
+    {
+        return base_ + static_cast<std::size_t>(bid) * size_;
+    }
+
+    /// Give buffer `bid` back to the kernel. Thread-safe.
+    void recycle(std::uint16_t bid) noexcept;
+
+private:
+    void add(std::uint16_t bid) noexcept;
+
+    io_uring_ring& ring_;
+    io_uring_buf_ring* br_ = nullptr;
+    std::size_t ring_bytes_ = 0;
+    unsigned char* base_ = nullptr;
+    std::size_t pool_bytes_ = 0;
+    std::size_t size_ = 0;
+    unsigned mask_ = 0;
+    std::uint16_t group_ = 0;
+
+    std::mutex mutex_;
+    std::uint16_t tail_ = 0;    // guarded by mutex_
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_BUFFER_RING_HPP
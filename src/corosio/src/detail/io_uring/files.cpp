@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/files.hpp"
+#include "src/detail/io_uring/op.hpp"
+#include "src/detail/io_uring/scheduler.hpp"
+#include "src/detail/posix/file.hpp"
+#include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/segment_array.hpp"
+
+#include <boost/corosio/random_access_file.hpp>
+#include <boost/corosio/stream_file.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace boost::corosio::detail {
+
+class io_uring_file_impl;
+class io_uring_file_service;
+
+//------------------------------------------------------------------------------
+
+struct io_uring_file_op : io_uring_op
+{
+    io_uring_scheduler* sched = nullptr;
+    iovec_array iovecs;
+    std::uint64_t offset = 0;
+    bool is_write = false;
+    bool append = false;
+
+    // A stream file's position, advanced on success
+    std::uint64_t* position = nullptr;
+
+    bool is_read_operation() const noexcept override
+    {
+        return !is_write;
+    }
+
+    void prepare(io_uring_sqe& sqe) noexcept override
+    {
+        sqe.opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+        set_file(sqe);
+        sqe.addr = reinterpret_cast<__u64>(iovecs.data());
+        sqe.len = static_cast<__u32>(iovecs.size());
+        sqe.off = offset;
+    }
+
+    void operator()() override
+    {
+        if (position && errn == 0)
+        {
+            std::uint64_t end = offset + bytes_transferred;
+
+            // An appending write went to the end, wherever that was
+            if (is_write && append)
+            {
+                system::error_code ec;
+                auto size = posix_file_size(fd, ec);
+                if (!ec)
+                    end = size;
+            }
+            *position = end;
+        }
+        io_uring_op::operator()();
+    }
+
+    void cancel() noexcept override
+    {
+        request_cancel();
+        sched->cancel(*this);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class io_uring_file_impl final
+    : public random_access_file::random_access_file_impl
+    , public stream_file::stream_file_impl
+    , public std::enable_shared_from_this<io_uring_file_impl>
+    , public intrusive_list<io_uring_file_impl>::node
+{
+public:
+    io_uring_file_impl(
+        io_uring_file_service& svc,
+        io_uring_scheduler& sched) noexcept
+        : svc_(svc)
+        , sched_(sched)
+    {
+        rd_.sched = &sched;
+        wr_.sched = &sched;
+    }
+
+    ~io_uring_file_impl()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    void release() override;
+
+    system::error_code open(
+        std::string_view path,
+        file_base::flags open_flags) override;
+
+    native_file_type native_handle() const noexcept override
+    {
+        return fd_;
+    }
+
+    void cancel() noexcept override
+    {
+        rd_.cancel();
+        wr_.cancel();
+    }
+
+    std::uint64_t size(system::error_code& ec) const override
+    {
+        return posix_file_size(fd_, ec);
+    }
+
+    system::error_code resize(std::uint64_t n) override
+    {
+        return posix_file_resize(fd_, n);
+    }
+
+    system::error_code sync_all() override
+    {
+        return posix_file_sync(fd_, false);
+    }
+
+    system::error_code sync_data() override
+    {
+        return posix_file_sync(fd_, true);
+    }
+
+    std::uint64_t seek(
+        std::int64_t offset,
+        file_base::seek_basis whence,
+        system::error_code& ec) override;
+
+    bool read_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool read_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+private:
+    bool start(
+        io_uring_file_op& op,
+        bool is_write,
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        std::uint64_t* position,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes);
+
+    io_uring_file_service& svc_;
+    io_uring_scheduler& sched_;
+    io_uring_file_op rd_;
+    io_uring_file_op wr_;
+    int fd_ = -1;
+    bool append_ = false;
+    std::uint64_t pos_ = 0;
+};
+
+//------------------------------------------------------------------------------
+
+class io_uring_file_service final : public file_service
+{
+public:
+    io_uring_file_service(
+        capy::execution_context&,
+        io_uring_scheduler& sched)
+        : sched_(sched)
+    {
+    }
+
+    io_uring_file_service(io_uring_file_service const&) = delete;
+    io_uring_file_service& operator=(io_uring_file_service const&) = delete;
+
+    void shutdown() override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (auto* impl = impl_list_.pop_front())
+            impl->cancel();
+
+        // The scheduler's shutdown reaps the ops still in the kernel
+        impl_ptrs_.clear();
+    }
+
+    random_access_file::random_access_file_impl&
+    create_random_access_impl() override
+    {
+        return create_impl();
+    }
+
+    stream_file::stream_file_impl&
+    create_stream_impl() override
+    {
+        return create_impl();
+    }
+
+    void destroy_impl(io_uring_file_impl& impl)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        impl_list_.remove(&impl);
+        impl_ptrs_.erase(&impl);
+    }
+
+private:
+    io_uring_file_impl& create_impl()
+    {
+        auto impl = make_recycled_impl<io_uring_file_impl>(*this, sched_);
+        auto* raw = impl.get();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        impl_list_.push_back(raw);
+        impl_ptrs_.emplace(raw, std::move(impl));
+        return *raw;
+    }
+
+    io_uring_scheduler& sched_;
+    std::mutex mutex_;
+    intrusive_list<io_uring_file_impl> impl_list_;
+    impl_ptr_map<io_uring_file_impl> impl_ptrs_;
+};
+
+//------------------------------------------------------------------------------
+// io_uring_file_impl
+//------------------------------------------------------------------------------
+
+void
+io_uring_file_impl::
+release()
+{
+    cancel();
+    svc_.destroy_impl(*this);
+}
+
+system::error_code
+io_uring_file_impl::
+open(std::string_view path, file_base::flags open_flags)
+{
+    int fd;
+    auto ec = open_posix_file(path, open_flags, fd);
+    if (ec)
+        return ec;
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = fd;
+    append_ = (open_flags & file_base::append) != 0;
+    pos_ = 0;
+    return {};
+}
+
+std::uint64_t
+io_uring_file_impl::
+seek(
+    std::int64_t offset,
+    file_base::seek_basis whence,
+    system::error_code& ec)
+{
+    std::uint64_t size = 0;
+    if (whence == file_base::seek_end)
+    {
+        size = posix_file_size(fd_, ec);
+        if (ec)
+            return pos_;
+    }
+    pos_ = seek_position(pos_, size, offset, whence, ec);
+    return pos_;
+}
+
+bool
+io_uring_file_impl::
+start(
+    io_uring_file_op& op,
+    bool is_write,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::uint64_t offset,
+    std::uint64_t* position,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    op.reset();
+    assign_iovecs(op.iovecs, param);
+
+    // Nothing to transfer, and no end of file to report
+    if (op.iovecs.empty())
+    {
+        *ec = {};
+        *bytes = 0;
+        return true;
+    }
+
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes;
+    op.fd = fd_;
+    op.is_write = is_write;
+    op.append = append_;
+    op.offset = offset;
+    op.position = position;
+    op.start(std::move(token));
+
+    op.impl_ptr = shared_from_this();
+    sched_.submit(op);
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+file_service&
+get_io_uring_file_service(
+    capy::execution_context& ctx,
+    io_uring_scheduler& sched)
+{
+    return ctx.make_service<io_uring_file_service>(sched);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_FILES_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_FILES_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/file_service.hpp"
+
+/*
+    io_uring File Implementation
+    ============================
+
+    Unlike the reactors, io_uring performs regular file I/O
+    asynchronously in the kernel, so files need no worker threads:
+    each read or write is one IORING_OP_READV or IORING_OP_WRITEV at
+    an explicit offset, submitted and reaped like a socket op.
+
+    Cancellation
+    ------------
+    cancel() marks the pending ops cancelled and asks the kernel to
+    cancel them. A transfer the device has already started may still
+    finish; it completes normally and reports the cancellation.
+
+    Impl Lifetime
+    -------------
+    Each submitted op holds impl_ptr until its handler runs, and the
+    impl closes the descriptor in its destructor, so a file closed
+    with I/O in flight keeps its descriptor until the kernel is done.
+*/
+
+namespace boost::corosio::detail {
+
+class io_uring_scheduler;
+
+/** Get or create the io_uring file service for the given context.
+
+    Called by the io_uring scheduler during initialization.
+
+    @param ctx Reference to the owning execution_context.
+    @param sched Reference to the scheduler that submits the I/O.
+    @return Reference to the file service.
+*/
+file_service&
+get_io_uring_file_service(
+    capy::execution_context& ctx,
+    io_uring_scheduler& sched);
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_FILES_HPP
@@ -0,0 +1,481 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_OP_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_OP_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/buffer_lease.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/coro.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "src/detail/make_err.hpp"
+#include "src/detail/resume_coro.hpp"
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/segment_array.hpp"
+
+#include <linux/io_uring.h>
+
+#include <errno.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stop_token>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/*
+    io_uring Operation State
+    ========================
+
+    Each async I/O operation has an io_uring_op-derived struct holding
+    its state while in flight. As with epoll, the socket impl owns one
+    slot per operation type (conn_, rd_, wr_), so only one operation of
+    each type can be pending per socket at a time.
+
+    Proactor Model
+    --------------
+    Unlike the epoll backend, nothing is attempted in user space. An
+    initiating function fills an SQE whose user_data is the op itself
+    and hands it to the scheduler. The kernel performs the I/O and
+    posts exactly one CQE, which the reactor turns into a call to
+    complete_cqe() followed by queueing the op. All state the kernel
+    reads (iovecs, msghdr, socket addresses) lives in the op, so it
+    stays valid until the completion.
+
+    Cancellation
+    ------------
+    cancel() sets the cancelled flag and submits IORING_OP_ASYNC_CANCEL
+    keyed on the op's address. The target still completes through its
+    own CQE, normally with -ECANCELED, so there is no claim race to
+    resolve: the CQE is the only path to the handler. The flag is
+    checked under the submission lock before an op is queued, and the
+    cancel SQE is queued under the same lock, so a cancel can never
+    overtake the operation it targets.
+
+    Impl Lifetime Management
+    ------------------------
+    `impl_ptr` holds the owning impl alive while the kernel owns the
+    op, exactly as in the epoll backend, since a socket may be closed
+    while its CQE is still outstanding.
+
+    Registered Resources
+    --------------------
+    A socket registered in the context's file table sets file_index,
+    and its SQEs name the slot with IOSQE_FIXED_FILE instead of the
+    fd, sparing the kernel a descriptor lookup and reference count per
+    request. A read into a registered buffer sets buf_index and uses
+    IORING_OP_READ_FIXED, which skips pinning the pages on every call.
+    Writes keep SENDMSG even then: IORING_OP_WRITE_FIXED cannot pass
+    MSG_NOSIGNAL, so a write to a reset connection would raise SIGPIPE.
+
+    Multishot Requests
+    ------------------
+    A multishot SQE produces a stream of CQEs, so it cannot be owned by
+    a one-shot op. Its owner derives from io_uring_multishot instead and
+    translates each CQE into the completion of at most one op. The
+    kernel sets IORING_CQE_F_MORE on every CQE but the last.
+
+    Zero-Copy Sends
+    ---------------
+    A socket with set_zero_copy() sends writes of at least
+    zero_copy_min_bytes with IORING_OP_SENDMSG_ZC. Such a request posts
+    its result with IORING_CQE_F_MORE, then a notification CQE once the
+    kernel has released the buffers. The reactor records the first in
+    the op without queueing it or counting a completion; the second
+    finishes the op like any one-shot CQE, so the caller gets its
+    buffers back only when the kernel no longer reads them. A send that
+    fails posts a single CQE without the flag.
+
+    SIGPIPE Prevention
+    ------------------
+    Writes use IORING_OP_SENDMSG with MSG_NOSIGNAL.
+*/
+
+namespace boost::corosio::detail {
+
+class io_uring_socket_impl;
+class io_uring_acceptor_impl;
+
+struct io_uring_op : scheduler_op
+{
+    struct canceller
+    {
+        io_uring_op* op;
+        void operator()() const noexcept;
+    };
+
+    capy::coro h;
+    capy::executor_ref ex;
+    system::error_code* ec_out = nullptr;
+    std::size_t* bytes_out = nullptr;
+
+    int fd = -1;
+    int file_index = -1;  // registered file slot, or -1
+    int errn = 0;
+    std::size_t bytes_transferred = 0;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> in_kernel{false};  // SQE queued, CQE not yet reaped
+    std::optional<std::stop_callback<canceller>> stop_cb;
+
+    // See "Impl Lifetime Management" in file header.
+    std::shared_ptr<void> impl_ptr;
+
+    io_uring_socket_impl* socket_impl_ = nullptr;
+    io_uring_acceptor_impl* acceptor_impl_ = nullptr;
+
+    io_uring_op()
+    {
+        data_ = this;
+    }
+
+    void reset() noexcept
+    {
+        fd = -1;
+        file_index = -1;
+        errn = 0;
+        bytes_transferred = 0;
+        cancelled.store(false, std::memory_order_relaxed);
+        impl_ptr.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = nullptr;
+    }
+
+    void operator()() override
+    {
+        stop_cb.reset();
+
+        if (ec_out)
+        {
+            if (cancelled.load(std::memory_order_acquire))
+                *ec_out = capy::error::canceled;
+            else if (errn != 0)
+                *ec_out = make_err(errn);
+            else if (is_read_operation() && bytes_transferred == 0)
+                *ec_out = capy::error::eof;
+            else
+                *ec_out = {};
+        }
+
+        if (bytes_out)
+            *bytes_out = bytes_transferred;
+
+        // Move to stack before destroying the frame
+        capy::executor_ref saved_ex( std::move( ex ) );
+        capy::coro saved_h( std::move( h ) );
+        impl_ptr.reset();
+        resume_coro(saved_ex, saved_h);
+    }
+
+    virtual bool is_read_operation() const noexcept { return false; }
+    virtual void cancel() noexcept = 0;
+
+    /** Fill the SQE that starts this operation.
+
+        `sqe` is zeroed by the caller; user_data is set afterwards.
+    */
+    virtual void prepare(io_uring_sqe& sqe) noexcept = 0;
+
+    /// Name the op's socket in `sqe`, by registered slot if it has one.
+    void set_file(io_uring_sqe& sqe) const noexcept
+    {
+        if (file_index >= 0)
+        {
+            sqe.fd = file_index;
+            sqe.flags |= IOSQE_FIXED_FILE;
+        }
+        else
+        {
+            sqe.fd = fd;
+        }
+    }
+
+    void destroy() override
+    {
+        stop_cb.reset();
+        impl_ptr.reset();
+    }
+
+    void request_cancel() noexcept
+    {
+        cancelled.store(true, std::memory_order_release);
+    }
+
+    void start(std::stop_token token, io_uring_socket_impl* impl)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = impl;
+        acceptor_impl_ = nullptr;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    void start(std::stop_token token, io_uring_acceptor_impl* impl)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = impl;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    /// Start an op whose cancel() needs neither a socket nor an acceptor.
+    void start(std::stop_token token)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = nullptr;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    void complete(int err, std::size_t bytes) noexcept
+    {
+        errn = err;
+        bytes_transferred = bytes;
+    }
+
+    /// Record the result of the op's CQE.
+    virtual void complete_cqe(int res) noexcept
+    {
+        if (res < 0)
+            complete(-res, 0);
+        else
+            complete(0, static_cast<std::size_t>(res));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Owner of a multishot request.
+
+    See "Multishot Requests" in file header.
+*/
+struct io_uring_multishot
+{
+    virtual ~io_uring_multishot() = default;
+
+    /** Handle one CQE of the request.
+
+        Called on the reactor thread, or during shutdown. Without
+        IORING_CQE_F_MORE in `flags` this is the last CQE, and the
+        owner may be destroyed before the call returns.
+
+        @param res The CQE result.
+        @param flags The CQE flags.
+
+        @return An op whose work count was already taken and that is
+            now ready to run, or `nullptr`.
+    */
+    virtual scheduler_op* on_cqe(int res, unsigned flags) noexcept = 0;
+};
+
+//------------------------------------------------------------------------------
+
+struct io_uring_connect_op : io_uring_op
+{
+    endpoint target_endpoint;
+    sockaddr_storage addr{};
+    socklen_t addrlen = 0;
+
+    void reset() noexcept
+    {
+        io_uring_op::reset();
+        target_endpoint = endpoint{};
+    }
+
+    void prepare(io_uring_sqe& sqe) noexcept override
+    {
+        sqe.opcode = IORING_OP_CONNECT;
+        set_file(sqe);
+        sqe.addr = reinterpret_cast<__u64>(&addr);
+        sqe.off = addrlen;
+    }
+
+    void complete_cqe(int res) noexcept override
+    {
+        complete(res < 0 ? -res : 0, 0);
+    }
+
+    // Defined in sockets.cpp where io_uring_socket_impl is complete
+    void operator()() override;
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct io_uring_read_op : io_uring_op
+{
+    iovec_array iovecs;
+    int buf_index = -1;  // registered buffer holding iovecs[0], or -1
+    bool empty_buffer_read = false;
+
+    // Leased reads: the pool buffer, or the private buffer used once
+    // the pool has run dry, handed to *lease_out on success
+    buffer_lease* lease_out = nullptr;
+    buffer_lease lease;
+    std::unique_ptr<unsigned char[]> heap;
+
+    bool is_read_operation() const noexcept override
+    {
+        return !empty_buffer_read;
+    }
+
+    void reset() noexcept
+    {
+        io_uring_op::reset();
+        iovecs.clear();
+        buf_index = -1;
+        empty_buffer_read = false;
+        lease_out = nullptr;
+        lease.reset();
+        heap.reset();
+    }
+
+    void prepare(io_uring_sqe& sqe) noexcept override
+    {
+        set_file(sqe);
+        if (buf_index >= 0)
+        {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.addr = reinterpret_cast<__u64>(iovecs[0].iov_base);
+            sqe.len = static_cast<__u32>(iovecs[0].iov_len);
+            sqe.buf_index = static_cast<__u16>(buf_index);
+        }
+        else
+        {
+            sqe.opcode = IORING_OP_READV;
+            sqe.addr = reinterpret_cast<__u64>(iovecs.data());
+            sqe.len = static_cast<__u32>(iovecs.size());
+        }
+        // Sockets are not seekable; -1 means the current position
+        sqe.off = static_cast<__u64>(-1);
+    }
+
+    // Defined in sockets.cpp, delivers leases
+    void operator()() override;
+    void destroy() override;
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct io_uring_write_op : io_uring_op
+{
+    iovec_array iovecs;
+    msghdr msg{};
+    bool zero_copy = false;    // see "Zero-Copy Sends"
+    bool have_result = false;
+
+    void reset() noexcept
+    {
+        io_uring_op::reset();
+        iovecs.clear();
+        zero_copy = false;
+        have_result = false;
+    }
+
+    void prepare(io_uring_sqe& sqe) noexcept override
+    {
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
+
+        sqe.opcode = IORING_OP_SENDMSG;
+#ifdef IORING_CQE_F_NOTIF
+        if (zero_copy)
+            sqe.opcode = IORING_OP_SENDMSG_ZC;
+#endif
+        set_file(sqe);
+        sqe.addr = reinterpret_cast<__u64>(&msg);
+        sqe.len = 1;
+        sqe.msg_flags = MSG_NOSIGNAL;
+    }
+
+    void complete_cqe(int res) noexcept override
+    {
+        // The notification CQE of a zero-copy send carries no result
+        if (have_result)
+            return;
+        have_result = zero_copy;
+        io_uring_op::complete_cqe(res);
+    }
+
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct io_uring_accept_op : io_uring_op
+{
+    int accepted_fd = -1;
+    io_object::io_object_impl** impl_out = nullptr;
+    sockaddr_storage addr{};
+    socklen_t addrlen = 0;
+
+    void reset() noexcept
+    {
+        io_uring_op::reset();
+        accepted_fd = -1;
+        impl_out = nullptr;
+    }
+
+    void prepare(io_uring_sqe& sqe) noexcept override
+    {
+        addrlen = sizeof(addr);
+        sqe.opcode = IORING_OP_ACCEPT;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<__u64>(&addr);
+        sqe.addr2 = reinterpret_cast<__u64>(&addrlen);
+        sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    }
+
+    void complete_cqe(int res) noexcept override
+    {
+        if (res >= 0)
+        {
+            accepted_fd = res;
+            complete(0, 0);
+        }
+        else
+        {
+            complete(-res, 0);
+        }
+    }
+
+    // Defined in acceptors.cpp where io_uring_acceptor_impl is complete
+    void operator()() override;
+    void cancel() noexcept override;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_OP_HPP
@@ -0,0 +1,277 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/ring.hpp"
+#include "src/detail/make_err.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+
+#include <cstring>
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+namespace {
+
+int
+sys_io_uring_setup(unsigned entries, io_uring_params* p) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int
+sys_io_uring_enter(
+    int fd,
+    unsigned to_submit,
+    unsigned min_complete,
+    unsigned flags,
+    void const* arg,
+    std::size_t argsz) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter,
+        fd, to_submit, min_complete, flags, arg, argsz));
+}
+
+template<class T>
+T*
+at_offset(void* base, unsigned off) noexcept
+{
+    return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+}
+
+} // namespace
+
+io_uring_ring::
+io_uring_ring(
+    unsigned entries,
+    unsigned flags,
+    unsigned sq_thread_idle,
+    int sq_thread_cpu)
+{
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    p.flags = flags;
+    if (flags & IORING_SETUP_SQPOLL)
+    {
+        p.sq_thread_idle = sq_thread_idle;
+        if (sq_thread_cpu >= 0)
+        {
+            p.flags |= IORING_SETUP_SQ_AFF;
+            p.sq_thread_cpu = static_cast<unsigned>(sq_thread_cpu);
+        }
+    }
+
+    ring_fd_ = sys_io_uring_setup(entries, &p);
+    if (ring_fd_ < 0)
+        detail::throw_system_error(make_err(errno), "io_uring_setup");
+
+    features_ = p.features;
+    if (!(features_ & IORING_FEAT_EXT_ARG))
+    {
+        ::close(ring_fd_);
+        detail::throw_system_error(make_err(ENOSYS), "io_uring: IORING_FEAT_EXT_ARG");
+    }
+
+    sq_map_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_map_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (features_ & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && cq_map_size_ > sq_map_size_)
+        sq_map_size_ = cq_map_size_;
+
+    sq_map_ = ::mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_map_ == MAP_FAILED)
+    {
+        int errn = errno;
+        sq_map_ = nullptr;
+        ::close(ring_fd_);
+        detail::throw_system_error(make_err(errn), "io_uring mmap sq");
+    }
+
+    if (single_mmap)
+    {
+        cq_map_ = sq_map_;
+    }
+    else
+    {
+        cq_map_ = ::mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_map_ == MAP_FAILED)
+        {
+            int errn = errno;
+            cq_map_ = nullptr;
+            ::munmap(sq_map_, sq_map_size_);
+            ::close(ring_fd_);
+            detail::throw_system_error(make_err(errn), "io_uring mmap cq");
+        }
+    }
+
+    sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        int errn = errno;
+        if (cq_map_ != sq_map_)
+            ::munmap(cq_map_, cq_map_size_);
+        ::munmap(sq_map_, sq_map_size_);
+        ::close(ring_fd_);
+        detail::throw_system_error(make_err(errn), "io_uring mmap sqes");
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sq_head_ = at_offset<unsigned>(sq_map_, p.sq_off.head);
+    sq_tail_ = at_offset<unsigned>(sq_map_, p.sq_off.tail);
+    sq_flags_ = at_offset<unsigned>(sq_map_, p.sq_off.flags);
+    sq_array_ = at_offset<unsigned>(sq_map_, p.sq_off.array);
+    sq_mask_ = *at_offset<unsigned>(sq_map_, p.sq_off.ring_mask);
+    sq_entries_ = p.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+    sq_polled_ = (p.flags & IORING_SETUP_SQPOLL) != 0;
+
+    cq_head_ = at_offset<unsigned>(cq_map_, p.cq_off.head);
+    cq_tail_ = at_offset<unsigned>(cq_map_, p.cq_off.tail);
+    cqes_ = at_offset<io_uring_cqe>(cq_map_, p.cq_off.cqes);
+    cq_mask_ = *at_offset<unsigned>(cq_map_, p.cq_off.ring_mask);
+
+    probe_ops();
+}
+
+void
+io_uring_ring::
+probe_ops() noexcept
+{
+    constexpr unsigned n = 256;
+    alignas(io_uring_probe) unsigned char buf[
+        sizeof(io_uring_probe) + n * sizeof(io_uring_probe_op)] = {};
+    auto* probe = reinterpret_cast<io_uring_probe*>(buf);
+    if (register_op(IORING_REGISTER_PROBE, probe, n) < 0)
+        return;
+    for (unsigned i = 0; i < probe->ops_len; ++i)
+    {
+        auto const& op = probe->ops[i];
+        if (op.flags & IO_URING_OP_SUPPORTED)
+            ops_.set(op.op);
+    }
+}
+
+io_uring_ring::
+~io_uring_ring()
+{
+    if (sqes_)
+        ::munmap(sqes_, sqes_size_);
+    if (cq_map_ && cq_map_ != sq_map_)
+        ::munmap(cq_map_, cq_map_size_);
+    if (sq_map_)
+        ::munmap(sq_map_, sq_map_size_);
+    if (ring_fd_ >= 0)
+        ::close(ring_fd_);
+}
+
+bool
+io_uring_ring::
+push(io_uring_sqe const& sqe) noexcept
+{
+    unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(
+        std::memory_order_acquire);
+    if (sq_local_tail_ - head >= sq_entries_)
+        return false;
+
+    unsigned idx = sq_local_tail_ & sq_mask_;
+    sqes_[idx] = sqe;
+    sq_array_[idx] = idx;
+    ++sq_local_tail_;
+    std::atomic_ref<unsigned>(*sq_tail_).store(
+        sq_local_tail_, std::memory_order_release);
+    return true;
+}
+
+unsigned
+io_uring_ring::
+sq_ready() const noexcept
+{
+    return std::atomic_ref<unsigned>(*sq_tail_).load(std::memory_order_acquire) -
+        std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+}
+
+int
+io_uring_ring::
+enter(unsigned min_complete, long timeout_us) noexcept
+{
+    unsigned to_submit = sq_ready();
+    unsigned flags = 0;
+    __kernel_timespec ts{};
+    io_uring_getevents_arg arg{};
+    void const* argp = nullptr;
+    std::size_t argsz = 0;
+
+    if (sq_polled_ && to_submit > 0)
+    {
+        // Orders the tail store before the flags load, so a thread
+        // going idle either sees the new tail or asks to be woken
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        unsigned sq_flags = std::atomic_ref<unsigned>(*sq_flags_).load(
+            std::memory_order_relaxed);
+        if (sq_flags & IORING_SQ_NEED_WAKEUP)
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        else if (to_submit >= sq_entries_)
+            flags |= IORING_ENTER_SQ_WAIT;  // Linux 5.10
+    }
+
+    if (min_complete > 0)
+    {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeout_us >= 0)
+        {
+            ts.tv_sec = timeout_us / 1000000;
+            ts.tv_nsec = (timeout_us % 1000000) * 1000;
+            arg.ts = reinterpret_cast<__u64>(&ts);
+            flags |= IORING_ENTER_EXT_ARG;
+            argp = &arg;
+            argsz = sizeof(arg);
+        }
+    }
+    else if (to_submit == 0)
+    {
+        return 0;
+    }
+    else if (sq_polled_ && flags == 0)
+    {
+        // The polling thread is awake and will pick the SQEs up
+        return static_cast<int>(to_submit);
+    }
+
+    int r = sys_io_uring_enter(ring_fd_, to_submit, min_complete,
+        flags, argp, argsz);
+    return r < 0 ? -errno : r;
+}
+
+int
+io_uring_ring::
+register_op(
+    unsigned opcode,
+    void const* arg,
+    unsigned nr_args) noexcept
+{
+    int r = static_cast<int>(::syscall(__NR_io_uring_register,
+        ring_fd_, opcode, arg, nr_args));
+    return r < 0 ? -errno : r;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_RING_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_RING_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <linux/io_uring.h>
+
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+
+/*
+    io_uring Ring
+    =============
+
+    A thin wrapper over the raw io_uring_setup/io_uring_enter syscalls
+    and the memory-mapped submission and completion queues. There is
+    no liburing dependency; the kernel UAPI header is all we need.
+
+    Submission Queue
+    ----------------
+    push() copies a prepared SQE into the next free slot and publishes
+    the new tail with release semantics. Pushes must be serialized by
+    the caller. Nothing reaches the kernel until enter() is called;
+    enter() always passes sq_ready() as the count, which is safe when
+    several threads enter concurrently because the kernel clamps the
+    count to what is actually queued.
+
+    Kernel Submission Polling
+    -------------------------
+    With IORING_SETUP_SQPOLL a kernel thread consumes the submission
+    queue by itself, so publishing the tail is the whole submission.
+    enter() then makes a syscall only to wait for completions, to wake
+    the thread after it has gone idle (IORING_SQ_NEED_WAKEUP), or to
+    wait for room in a full queue.
+
+    Completion Queue
+    ----------------
+    The completion queue has a single consumer. reap() walks every
+    available CQE and then releases all of them to the kernel at once.
+    The ring is created with IORING_FEAT_NODROP semantics on any
+    supported kernel, so completions are never lost when the CQ is
+    momentarily full; the kernel buffers them until the next enter().
+*/
+
+namespace boost::corosio::detail {
+
+class io_uring_ring
+{
+public:
+    /** Create a ring.
+
+        @param entries Requested submission queue depth.
+        @param flags IORING_SETUP_* flags.
+        @param sq_thread_idle With IORING_SETUP_SQPOLL, milliseconds
+            the polling thread waits for work before sleeping.
+        @param sq_thread_cpu With IORING_SETUP_SQPOLL, the CPU to pin
+            the polling thread to, or -1 for no affinity.
+
+        @throws std::system_error if the kernel refuses the ring or
+            lacks IORING_FEAT_EXT_ARG (Linux 5.11).
+    */
+    explicit
+    io_uring_ring(
+        unsigned entries,
+        unsigned flags = 0,
+        unsigned sq_thread_idle = 0,
+        int sq_thread_cpu = -1);
+
+    ~io_uring_ring();
+
+    io_uring_ring(io_uring_ring const&) = delete;
+    io_uring_ring& operator=(io_uring_ring const&) = delete;
+
+    /// Return the ring file descriptor.
+    int fd() const noexcept { return ring_fd_; }
+
+    /// Return the IORING_FEAT_* bits reported by the kernel.
+    unsigned features() const noexcept { return features_; }
+
+    /** Return `true` if the kernel supports an IORING_OP_* opcode.
+
+        Kernels before Linux 5.6 cannot be probed and report none.
+    */
+    bool supports(unsigned opcode) const noexcept
+    {
+        return opcode < ops_.size() && ops_[opcode];
+    }
+
+    /// Return the submission queue depth.
+    unsigned sq_entries() const noexcept { return sq_entries_; }
+
+    /// Return `true` if a kernel thread polls the submission queue.
+    bool sq_polled() const noexcept { return sq_polled_; }
+
+    /** Queue an SQE.
+
+        @return `false` if the submission queue is full.
+    */
+    bool push(io_uring_sqe const& sqe) noexcept;
+
+    /// Return the number of SQEs not yet consumed by the kernel.
+    unsigned sq_ready() const noexcept;
+
+    /** Submit queued SQEs and optionally wait for completions.
+
+        @param min_complete Completions to wait for. Zero only submits.
+        @param timeout_us Wait limit in microseconds, or negative to
+            wait without limit. Ignored when `min_complete` is zero.
+
+        @return The number of SQEs submitted, or a negated errno.
+            A timed out wait returns `-ETIME`. With submission polling
+            the count is of SQEs left for the kernel thread.
+    */
+    int enter(unsigned min_complete, long timeout_us) noexcept;
+
+    /** Invoke `f(cqe)` for every available completion.
+
+        @return The number of completions reaped.
+    */
+    template<class F>
+    unsigned
+    reap(F&& f)
+    {
+        unsigned head = *cq_head_;
+        unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(
+            std::memory_order_acquire);
+        unsigned n = tail - head;
+        for (; head != tail; ++head)
+            f(cqes_[head & cq_mask_]);
+        std::atomic_ref<unsigned>(*cq_head_).store(
+            tail, std::memory_order_release);
+        return n;
+    }
+
+    /// Invoke io_uring_register.
+    int register_op(
+        unsigned opcode,
+        void const* arg,
+        unsigned nr_args) noexcept;
+
+private:
+    void probe_ops() noexcept;
+
+    int ring_fd_ = -1;
+    unsigned features_ = 0;
+    std::bitset<256> ops_;
+
+    void* sq_map_ = nullptr;
+    std::size_t sq_map_size_ = 0;
+    void* cq_map_ = nullptr;
+    std::size_t cq_map_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_flags_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned sq_local_tail_ = 0;
+    bool sq_polled_ = false;
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cq_mask_ = 0;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_RING_HPP
@@ -0,0 +1,1142 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/scheduler.hpp"
+#include "src/detail/io_uring/op.hpp"
+#include "src/detail/io_uring/files.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/posix/resolver_service.hpp"
+#include "src/detail/posix/signals.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/thread_local_ptr.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/*
+    io_uring Scheduler - Single Reactor Model
+    =========================================
+
+    The thread coordination strategy is the one used by epoll_scheduler
+    and select_scheduler: one thread at a time becomes the "reactor" and
+    waits in io_uring_enter, the others wait on a condition variable for
+    handlers. What differs is what the reactor harvests. Every CQE is a
+    finished operation, so the reactor records its result and queues it;
+    there is no I/O left to perform in user space.
+
+    Submission
+    ----------
+    SQE pushes are serialized by sq_mutex_, which is a leaf lock held
+    only while copying an SQE into the ring. Pushing does not enter the
+    kernel. The reactor passes everything queued to the kernel in the
+    same io_uring_enter that waits for completions, so handlers that
+    start several operations cost one syscall between them.
+
+    That leaves the case of a reactor that is already blocked: its
+    enter has been issued and will not look at the ring again until a
+    completion arrives. The reactor announces this in reactor_sleeping_
+    before computing its submission count, and a producer checks it
+    after pushing, each separated by a full fence. Either the reactor
+    sees the new SQE, or the producer sees the flag and submits the SQE
+    itself with a non-waiting io_uring_enter.
+
+    Wakeups
+    -------
+    An IORING_OP_READ on an eventfd is kept armed at all times. Writing
+    the eventfd completes the read and so wakes the reactor; the reactor
+    re-arms it while processing the CQE. Writes are coalesced with
+    wakeup_pending_ exactly as in the epoll scheduler.
+
+    Multishot Requests
+    ------------------
+    A multishot SQE carries the address of its io_uring_multishot owner
+    with multishot_bit set. It holds one inflight_ slot until the CQE
+    without IORING_CQE_F_MORE, and no work count of its own, so an
+    acceptor that is merely listening does not keep run() alive.
+
+    Submission Polling
+    ------------------
+    With io_uring_options::sq_poll a kernel thread consumes the SQ, and
+    the ring's enter() skips the syscall unless that thread needs a
+    wakeup. The protocol above is unchanged: a producer that finds the
+    reactor asleep still calls enter(), which is then nearly free.
+
+    Registered Resources
+    --------------------
+    Fixed buffers and the fixed file table are registered with
+    io_uring_register outside sq_mutex_, under rsrc_mutex_. Reads look
+    up fixed buffers only once some are registered, so contexts that
+    never register any skip the lock. Emptying a file slot first hands
+    every queued SQE to the kernel, which resolves a fixed file when it
+    issues the request; a stale SQE can therefore never reach the next
+    socket to take the slot.
+
+    Shutdown
+    --------
+    The kernel may still own operations when the context shuts down,
+    and their CQEs refer to memory inside socket impls. shutdown()
+    cancels everything outstanding and reaps until the kernel has
+    returned every SQE, destroying the ops instead of invoking them.
+
+    Work Counting
+    -------------
+    A submitted operation counts as one unit of work from submit()
+    until its handler has run. Posts made by handlers are counted
+    privately, see handler_scope.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+// Submission queue depth; the kernel sizes the CQ at twice this
+constexpr unsigned ring_entries = 256;
+
+// Group id of the receive buffer pool
+constexpr std::uint16_t buffer_group = 0;
+
+struct scheduler_context
+{
+    io_uring_scheduler const* key;
+    scheduler_context* next;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
+};
+
+corosio::detail::thread_local_ptr<scheduler_context> context_stack;
+
+// Returns the innermost run() frame of `sched` on this thread
+scheduler_context*
+find_context(io_uring_scheduler const* sched) noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
+
+} // namespace
+
+/** Brackets one handler invocation inside run().
+
+    Posts made while the scope is active are counted and staged in the
+    frame. The destructor settles the count, including the handler's
+    own unit of work, and publishes the staged handlers.
+*/
+class io_uring_scheduler::handler_scope
+{
+    io_uring_scheduler const* sched_;
+    scheduler_context* frame_;
+
+public:
+    handler_scope(
+        io_uring_scheduler const* sched,
+        scheduler_context* frame) noexcept
+        : sched_(sched)
+        , frame_(frame)
+    {
+        frame_->in_handler = true;
+    }
+
+    ~handler_scope()
+    {
+        frame_->in_handler = false;
+        publish(sched_, *frame_, -1);
+    }
+
+    handler_scope(handler_scope const&) = delete;
+    handler_scope& operator=(handler_scope const&) = delete;
+
+    // Folds the frame's private work, plus `adjust`, into
+    // outstanding_work_ and then releases the staged handlers
+    static void
+    publish(
+        io_uring_scheduler const* sched,
+        scheduler_context& frame,
+        long adjust) noexcept
+    {
+        long n = frame.private_work + adjust;
+        frame.private_work = 0;
+
+        if (n > 0)
+            sched->outstanding_work_.fetch_add(n, std::memory_order_relaxed);
+
+        while (auto* h = frame.private_ops.pop())
+            sched->enqueue(h);
+
+        // Only the finished handler's own unit can make this negative
+        if (n < 0)
+            sched->work_finished();
+    }
+};
+
+/** Marks the calling thread as running inside the scheduler. */
+class io_uring_scheduler::run_scope
+{
+    scheduler_context frame_;
+
+public:
+    explicit run_scope(io_uring_scheduler const* sched) noexcept
+        : frame_{sched, context_stack.get()}
+    {
+        // A handler running a nested loop must not hide its posts
+        if (auto* outer = find_context(sched); outer && outer->in_handler)
+            handler_scope::publish(sched, *outer, 0);
+
+        context_stack.set(&frame_);
+    }
+
+    ~run_scope() noexcept
+    {
+        context_stack.set(frame_.next);
+    }
+
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
+};
+
+io_uring_scheduler::
+io_uring_scheduler(
+    capy::execution_context& ctx,
+    int,
+    io_uring_options const& opts)
+    : opts_(opts)
+    , ring_(ring_entries,
+        opts_.sq_poll ? IORING_SETUP_SQPOLL : 0u,
+        opts_.sq_thread_idle,
+        opts_.sq_thread_cpu)
+    , outstanding_work_(0)
+    , stopped_(false)
+    , shutdown_(false)
+    , reactor_running_(false)
+    , reactor_interrupted_(false)
+    , idle_thread_count_(0)
+{
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0)
+        detail::throw_system_error(make_err(errno), "eventfd");
+
+    if (opts_.buffer_count > 0)
+    {
+        try {
+            pool_ = std::make_unique<io_uring_buffer_ring>(
+                ring_, buffer_group, opts_.buffer_count, opts_.buffer_size);
+        } catch (system::system_error const&) {
+            // Leased reads fall back to per-read buffers
+        }
+    }
+
+    if (opts_.registered_files > 0)
+    {
+        // All slots start empty; register_file() fills them
+        std::vector<int> fds(opts_.registered_files, -1);
+        if (ring_.register_op(IORING_REGISTER_FILES,
+                fds.data(), opts_.registered_files) == 0)
+        {
+            free_files_.reserve(opts_.registered_files);
+            for (unsigned i = opts_.registered_files; i-- > 0;)
+                free_files_.push_back(static_cast<int>(i));
+        }
+    }
+
+    {
+        std::lock_guard lock(sq_mutex_);
+        arm_wakeup();
+    }
+
+    timer_svc_ = &get_timer_service(ctx, *this, opts_.timers);
+    timer_svc_->set_on_earliest_changed(
+        timer_service::callback(
+            this,
+            [](void* p) { static_cast<io_uring_scheduler*>(p)->interrupt_reactor(); }));
+
+    // Initialize resolver service
+    get_resolver_service(ctx, *this);
+
+    // Initialize file service
+    get_io_uring_file_service(ctx, *this);
+
+    // Initialize signal service
+    get_signal_service(ctx, *this);
+}
+
+io_uring_scheduler::
+~io_uring_scheduler()
+{
+    if (event_fd_ >= 0)
+        ::close(event_fd_);
+}
+
+void
+io_uring_scheduler::
+shutdown()
+{
+    {
+        std::unique_lock lock(mutex_);
+        shutdown_ = true;
+        injected_.pop_all(completed_ops_);
+
+        while (auto* h = completed_ops_.pop())
+        {
+            lock.unlock();
+            h->destroy();
+            lock.lock();
+        }
+    }
+
+    drain();
+
+    outstanding_work_.store(0, std::memory_order_release);
+
+    wakeup_event_.notify_all();
+}
+
+void
+io_uring_scheduler::
+drain() noexcept
+{
+    {
+        std::lock_guard lock(sq_mutex_);
+        io_uring_sqe sqe;
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.cancel_flags = IORING_ASYNC_CANCEL_ANY;  // Linux 5.19
+        sqe.user_data = ignore_tag;
+        try {
+            push_sqe(sqe);
+        } catch (...) {
+            // The ring is unusable; the sockets have already
+            // cancelled their own operations
+        }
+    }
+
+    // Completes the eventfd read even where CANCEL_ANY is unsupported
+    std::uint64_t val = 1;
+    [[maybe_unused]] auto w = ::write(event_fd_, &val, sizeof(val));
+
+    // Give up after about a second without progress rather than hang
+    for (int idle = 0; idle < 10;)
+    {
+        {
+            std::lock_guard lock(sq_mutex_);
+            if (inflight_ == 0)
+                return;
+        }
+
+        ring_.enter(1, 100000);
+
+        std::size_t n = 0;
+        ring_.reap([&](io_uring_cqe const& cqe)
+        {
+            if (cqe.user_data == ignore_tag)
+                return;
+            if (cqe.user_data & multishot_bit)
+            {
+                bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+                if (!more)
+                    ++n;
+                auto* m = reinterpret_cast<io_uring_multishot*>(
+                    cqe.user_data & ~multishot_bit);
+                if (auto* op = m->on_cqe(cqe.res, cqe.flags))
+                    op->destroy();
+                return;
+            }
+            // A zero-copy send's notification CQE follows
+            if (cqe.flags & IORING_CQE_F_MORE)
+                return;
+            ++n;
+            if (cqe.user_data == wakeup_tag)
+                return;
+            auto* op = reinterpret_cast<io_uring_op*>(cqe.user_data);
+            op->in_kernel.store(false, std::memory_order_release);
+            op->destroy();
+        });
+
+        std::lock_guard lock(sq_mutex_);
+        inflight_ -= n;
+        idle = n ? 0 : idle + 1;
+    }
+}
+
+void
+io_uring_scheduler::
+post(capy::coro h) const
+{
+    struct post_handler final
+        : scheduler_op
+        , recycling_op<post_handler>
+    {
+        capy::coro h_;
+
+        explicit
+        post_handler(capy::coro h)
+            : h_(h)
+        {
+        }
+
+        ~post_handler() = default;
+
+        void operator()() override
+        {
+            auto h = h_;
+            delete this;
+            h.resume();
+        }
+
+        void destroy() override
+        {
+            delete this;
+        }
+    };
+
+    auto ph = std::make_unique<post_handler>(h);
+    post(ph.release());
+}
+
+void
+io_uring_scheduler::
+post(scheduler_op* h) const
+{
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        c->private_ops.push(h);
+        return;
+    }
+
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(h);
+}
+
+void
+io_uring_scheduler::
+enqueue(scheduler_op* h) const
+{
+    injected_.push(h);
+
+    // Only pay for a wakeup when a consumer is actually parked, see
+    // the matching announcements in do_one() and run_reactor()
+    if (idle_thread_count_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(mutex_);
+        wakeup_event_.notify_one();
+    }
+    else if (reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+    {
+        interrupt_reactor();
+    }
+}
+
+void
+io_uring_scheduler::
+submit(io_uring_op& op) const
+{
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    op.prepare(sqe);
+    sqe.user_data = reinterpret_cast<__u64>(&op);
+
+    {
+        std::unique_lock lock(sq_mutex_);
+
+        // Cancellation requested before the kernel saw the op
+        if (op.cancelled.load(std::memory_order_acquire))
+        {
+            lock.unlock();
+            post(&op);
+            return;
+        }
+
+        work_started();
+        push_sqe(sqe);
+        op.in_kernel.store(true, std::memory_order_relaxed);
+        ++inflight_;
+    }
+
+    flush_if_reactor_sleeping();
+}
+
+void
+io_uring_scheduler::
+cancel(io_uring_op& op) const
+{
+    {
+        std::lock_guard lock(sq_mutex_);
+
+        // Not submitted yet, or already completed; submit() checks
+        // the cancelled flag under this lock
+        if (!op.in_kernel.load(std::memory_order_acquire))
+            return;
+
+        push_cancel(reinterpret_cast<std::uint64_t>(&op));
+    }
+
+    flush_if_reactor_sleeping();
+}
+
+void
+io_uring_scheduler::
+submit_multishot(io_uring_multishot& m, io_uring_sqe& sqe) const
+{
+    sqe.user_data = reinterpret_cast<std::uint64_t>(&m) | multishot_bit;
+
+    {
+        std::lock_guard lock(sq_mutex_);
+        push_sqe(sqe);
+        ++inflight_;
+    }
+
+    flush_if_reactor_sleeping();
+}
+
+void
+io_uring_scheduler::
+cancel_multishot(io_uring_multishot& m) const
+{
+    {
+        std::lock_guard lock(sq_mutex_);
+        push_cancel(reinterpret_cast<std::uint64_t>(&m) | multishot_bit);
+    }
+
+    flush_if_reactor_sleeping();
+}
+
+void
+io_uring_scheduler::
+push_cancel(std::uint64_t user_data) const
+{
+    // Caller holds sq_mutex_
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.fd = -1;
+    sqe.addr = user_data;
+    sqe.user_data = ignore_tag;
+    push_sqe(sqe);
+}
+
+void
+io_uring_scheduler::
+push_sqe(io_uring_sqe const& sqe) const
+{
+    // Caller holds sq_mutex_. A full SQ is handed to the kernel to
+    // make room; this cannot block on completions.
+    while (!ring_.push(sqe))
+    {
+        int r = ring_.enter(0, -1);
+        if (r < 0 && r != -EINTR && r != -EAGAIN && r != -EBUSY)
+            detail::throw_system_error(make_err(-r), "io_uring_enter");
+    }
+}
+
+void
+io_uring_scheduler::
+flush_if_reactor_sleeping() const
+{
+    // Pairs with the fence in run_reactor(), see "Submission"
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (reactor_sleeping_.load(std::memory_order_relaxed))
+        ring_.enter(0, -1);
+}
+
+void
+io_uring_scheduler::
+arm_wakeup() const
+{
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = event_fd_;
+    sqe.addr = reinterpret_cast<__u64>(&wakeup_buf_);
+    sqe.len = sizeof(wakeup_buf_);
+    sqe.user_data = wakeup_tag;
+    push_sqe(sqe);
+    ++inflight_;
+}
+
+void
+io_uring_scheduler::
+register_buffers(iovec const* iovs, std::size_t n)
+{
+    std::lock_guard lock(rsrc_mutex_);
+
+    if (!fixed_buffers_.empty())
+    {
+        has_fixed_buffers_.store(false, std::memory_order_relaxed);
+        fixed_buffers_.clear();
+        ring_.register_op(IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    }
+
+    if (n == 0)
+        return;
+
+    int r = ring_.register_op(IORING_REGISTER_BUFFERS,
+        iovs, static_cast<unsigned>(n));
+    if (r < 0)
+        detail::throw_system_error(make_err(-r), "io_uring register buffers");
+
+    fixed_buffers_.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto begin = reinterpret_cast<std::uintptr_t>(iovs[i].iov_base);
+        fixed_buffers_.push_back(
+            {begin, begin + iovs[i].iov_len, static_cast<int>(i)});
+    }
+    std::sort(fixed_buffers_.begin(), fixed_buffers_.end(),
+        [](fixed_buffer const& a, fixed_buffer const& b)
+        {
+            return a.begin < b.begin;
+        });
+    has_fixed_buffers_.store(true, std::memory_order_release);
+}
+
+void
+io_uring_scheduler::
+unregister_buffers() noexcept
+{
+    std::lock_guard lock(rsrc_mutex_);
+    if (fixed_buffers_.empty())
+        return;
+    has_fixed_buffers_.store(false, std::memory_order_relaxed);
+    fixed_buffers_.clear();
+    ring_.register_op(IORING_UNREGISTER_BUFFERS, nullptr, 0);
+}
+
+int
+io_uring_scheduler::
+find_buffer(void const* p, std::size_t n) const noexcept
+{
+    if (!has_fixed_buffers_.load(std::memory_order_acquire))
+        return -1;
+
+    auto begin = reinterpret_cast<std::uintptr_t>(p);
+    std::lock_guard lock(rsrc_mutex_);
+
+    // Last buffer starting at or before p
+    auto it = std::upper_bound(fixed_buffers_.begin(), fixed_buffers_.end(),
+        begin,
+        [](std::uintptr_t v, fixed_buffer const& b)
+        {
+            return v < b.begin;
+        });
+    if (it == fixed_buffers_.begin())
+        return -1;
+    --it;
+    if (n > it->end - begin || begin >= it->end)
+        return -1;
+    return it->index;
+}
+
+int
+io_uring_scheduler::
+register_file(int fd) const
+{
+    int slot;
+    {
+        std::lock_guard lock(rsrc_mutex_);
+        if (free_files_.empty())
+            return -1;
+        slot = free_files_.back();
+        free_files_.pop_back();
+    }
+
+    io_uring_files_update up{};
+    up.offset = static_cast<__u32>(slot);
+    up.fds = reinterpret_cast<__u64>(&fd);
+    int r = ring_.register_op(IORING_REGISTER_FILES_UPDATE, &up, 1);
+    if (r < 0)
+    {
+        {
+            std::lock_guard lock(rsrc_mutex_);
+            free_files_.push_back(slot);
+        }
+        detail::throw_system_error(make_err(-r), "io_uring register file");
+    }
+    return slot;
+}
+
+void
+io_uring_scheduler::
+unregister_file(int slot) const noexcept
+{
+    {
+        // See "Registered Resources"
+        std::lock_guard lock(sq_mutex_);
+        while (ring_.sq_ready() > 0)
+        {
+            if (ring_.enter(0, -1) < 0)
+                break;
+            // A polling kernel thread drains the queue on its own time
+            if (ring_.sq_ready() > 0)
+                std::this_thread::yield();
+        }
+
+        int fd = -1;
+        io_uring_files_update up{};
+        up.offset = static_cast<__u32>(slot);
+        up.fds = reinterpret_cast<__u64>(&fd);
+        if (ring_.register_op(IORING_REGISTER_FILES_UPDATE, &up, 1) < 0)
+            return;  // Leak the slot rather than reuse a live one
+    }
+
+    std::lock_guard lock(rsrc_mutex_);
+    free_files_.push_back(slot);
+}
+
+void
+io_uring_scheduler::
+on_work_started() noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+io_uring_scheduler::
+on_work_finished() noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        stop();
+}
+
+bool
+io_uring_scheduler::
+running_in_this_thread() const noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == this)
+            return true;
+    return false;
+}
+
+void
+io_uring_scheduler::
+stop()
+{
+    bool expected = false;
+    if (stopped_.compare_exchange_strong(expected, true,
+            std::memory_order_release, std::memory_order_relaxed))
+    {
+        // Wake all threads so they notice stopped_ and exit
+        {
+            std::lock_guard lock(mutex_);
+            wakeup_event_.notify_all();
+        }
+        interrupt_reactor();
+    }
+}
+
+bool
+io_uring_scheduler::
+stopped() const noexcept
+{
+    return stopped_.load(std::memory_order_acquire);
+}
+
+void
+io_uring_scheduler::
+restart()
+{
+    stopped_.store(false, std::memory_order_release);
+}
+
+std::size_t
+io_uring_scheduler::
+run()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(-1))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+io_uring_scheduler::
+run_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(-1);
+}
+
+std::size_t
+io_uring_scheduler::
+wait_one(long usec)
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(usec);
+}
+
+std::size_t
+io_uring_scheduler::
+poll()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(0))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+io_uring_scheduler::
+poll_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(0);
+}
+
+void
+io_uring_scheduler::
+work_started() const noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+io_uring_scheduler::
+work_finished() const noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // Last work item completed - wake all threads so they can exit.
+        std::unique_lock lock(mutex_);
+        wakeup_event_.notify_all();
+        if (reactor_running_ && !reactor_interrupted_)
+        {
+            reactor_interrupted_ = true;
+            lock.unlock();
+            interrupt_reactor();
+        }
+    }
+}
+
+void
+io_uring_scheduler::
+interrupt_reactor() const
+{
+    // At most one write in flight until the reactor reaps it
+    if (wakeup_pending_.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    std::uint64_t val = 1;
+    [[maybe_unused]] auto r = ::write(event_fd_, &val, sizeof(val));
+}
+
+void
+io_uring_scheduler::
+wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const
+{
+    if (idle_thread_count_ > 0)
+    {
+        // Idle worker exists - wake it via condvar
+        wakeup_event_.notify_one();
+        lock.unlock();
+    }
+    else if (reactor_running_ && !reactor_interrupted_)
+    {
+        // No idle workers but reactor is running - interrupt it
+        reactor_interrupted_ = true;
+        lock.unlock();
+        interrupt_reactor();
+    }
+    else
+    {
+        // No one to wake
+        lock.unlock();
+    }
+}
+
+long
+io_uring_scheduler::
+calculate_timeout(long requested_timeout_us) const
+{
+    if (requested_timeout_us == 0)
+        return 0;
+
+    auto nearest = timer_svc_->nearest_wakeup();
+    if (nearest == timer_service::time_point::max())
+        return requested_timeout_us;
+
+    auto now = std::chrono::steady_clock::now();
+    if (nearest <= now)
+        return 0;
+
+    auto timer_timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        nearest - now).count();
+
+    if (requested_timeout_us < 0)
+        return static_cast<long>(timer_timeout_us);
+
+    return static_cast<long>((std::min)(
+        static_cast<long long>(requested_timeout_us),
+        static_cast<long long>(timer_timeout_us)));
+}
+
+void
+io_uring_scheduler::
+run_reactor(std::unique_lock<std::mutex>& lock)
+{
+    // Calculate timeout considering timers, use 0 if interrupted
+    long timeout_us = reactor_interrupted_ ? 0 : calculate_timeout(-1);
+
+    lock.unlock();
+
+    // Announce that we may block, then re-check for posts that raced
+    // with the announcement. The fence also orders the announcement
+    // before the SQ tail is read, see "Submission".
+    if (timeout_us != 0)
+    {
+        reactor_sleeping_.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!injected_.empty())
+            timeout_us = 0;
+    }
+
+    int r = ring_.enter(timeout_us != 0 ? 1 : 0, timeout_us);
+    reactor_sleeping_.store(false, std::memory_order_relaxed);
+
+    // Process timers outside the lock - timer completions may call post()
+    // which needs to acquire the lock
+    timer_svc_->process_expired();
+
+    if (r < 0 && r != -EINTR && r != -ETIME && r != -EAGAIN && r != -EBUSY)
+        detail::throw_system_error(make_err(-r), "io_uring_enter");
+
+    op_queue ready_ops;
+    int completions_queued = 0;
+    std::size_t reaped = 0;
+    bool rearm = false;
+    ring_.reap([&](io_uring_cqe const& cqe)
+    {
+        if (cqe.user_data == ignore_tag)
+            return;
+
+        if (cqe.user_data & multishot_bit)
+        {
+            // The owner may be destroyed by its final CQE
+            bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+            if (!more)
+                ++reaped;
+            auto* m = reinterpret_cast<io_uring_multishot*>(
+                cqe.user_data & ~multishot_bit);
+            if (auto* op = m->on_cqe(cqe.res, cqe.flags))
+            {
+                ready_ops.push(op);
+                ++completions_queued;
+            }
+            return;
+        }
+
+        // The result of a zero-copy send; the op finishes with the
+        // notification CQE that follows, see "Zero-Copy Sends"
+        if (cqe.flags & IORING_CQE_F_MORE)
+        {
+            reinterpret_cast<io_uring_op*>(cqe.user_data)->complete_cqe(
+                cqe.res);
+            return;
+        }
+
+        ++reaped;
+
+        if (cqe.user_data == wakeup_tag)
+        {
+            // eventfd interrupt - re-arm coalescing and the read
+            wakeup_pending_.store(false, std::memory_order_release);
+            rearm = true;
+            return;
+        }
+
+        auto* op = reinterpret_cast<io_uring_op*>(cqe.user_data);
+        op->in_kernel.store(false, std::memory_order_release);
+        op->complete_cqe(cqe.res);
+        ready_ops.push(op);
+        ++completions_queued;
+    });
+
+    if (reaped > 0)
+    {
+        std::lock_guard sq_lock(sq_mutex_);
+        inflight_ -= reaped;
+        if (rearm)
+            arm_wakeup();
+    }
+
+    lock.lock();
+    completed_ops_.splice(ready_ops);
+
+    // Wake idle workers if we queued I/O completions
+    if (completions_queued > 0)
+    {
+        if (completions_queued >= idle_thread_count_)
+            wakeup_event_.notify_all();
+        else
+            for (int i = 0; i < completions_queued; ++i)
+                wakeup_event_.notify_one();
+    }
+}
+
+std::size_t
+io_uring_scheduler::
+do_one(long timeout_us)
+{
+    std::unique_lock lock(mutex_);
+
+    using clock = std::chrono::steady_clock;
+    auto deadline = (timeout_us > 0)
+        ? clock::now() + std::chrono::microseconds(timeout_us)
+        : clock::time_point{};
+    bool polled = false;
+
+    for (;;)
+    {
+        if (stopped_.load(std::memory_order_acquire))
+            return 0;
+
+        if (!injected_.empty())
+            injected_.pop_all(completed_ops_);
+
+        // Try to get a handler from the queue
+        scheduler_op* op = completed_ops_.pop();
+
+        if (op != nullptr)
+        {
+            // Got a handler - execute it
+            lock.unlock();
+            handler_scope g{this, find_context(this)};
+            (*op)();
+            return 1;
+        }
+
+        // Queue is empty - check if we should become reactor or wait
+        if (outstanding_work_.load(std::memory_order_acquire) == 0)
+            return 0;
+
+        if (timeout_us == 0)
+        {
+            // Completions only arrive through the ring, so a
+            // non-blocking poll harvests it once before giving up
+            if (polled || reactor_running_)
+                return 0;
+            polled = true;
+            reactor_running_ = true;
+            reactor_interrupted_ = true;
+            run_reactor(lock);
+            reactor_running_ = false;
+            continue;
+        }
+
+        // Check if timeout has expired (for positive timeout_us)
+        if (timeout_us > 0 && clock::now() >= deadline)
+            return 0;
+
+        if (!reactor_running_)
+        {
+            // No reactor running and queue empty - become the reactor
+            reactor_running_ = true;
+            reactor_interrupted_ = false;
+
+            run_reactor(lock);
+
+            reactor_running_ = false;
+            // Loop back to check for handlers that reactor may have queued
+            continue;
+        }
+
+        long remaining_us = timeout_us;
+        if (timeout_us > 0)
+            remaining_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - clock::now()).count();
+
+        // Reactor is running in another thread - wait for work on condvar
+        ++idle_thread_count_;
+        if (!injected_.empty())
+        {
+            // A post raced with the announcement above
+            --idle_thread_count_;
+            continue;
+        }
+        if (timeout_us < 0)
+            wakeup_event_.wait(lock);
+        else
+            wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        --idle_thread_count_;
+    }
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
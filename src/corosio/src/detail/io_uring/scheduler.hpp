@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_SCHEDULER_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_SCHEDULER_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/scheduler.hpp>
+#include <boost/corosio/io_uring_context.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/io_uring/buffer_ring.hpp"
+#include "src/detail/io_uring/ring.hpp"
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/timer_service.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace boost::corosio::detail {
+
+struct io_uring_op;
+struct io_uring_multishot;
+
+/** Linux scheduler using io_uring for I/O.
+
+    This scheduler implements the scheduler interface on top of an
+    io_uring instance. I/O operations are submitted as SQEs and
+    completed by the kernel; the reactor only harvests CQEs, so there
+    is no readiness round trip and no per-operation syscall in user
+    space. Thread coordination follows the same single reactor model
+    as epoll_scheduler: one thread waits in io_uring_enter while the
+    others wait on a condition variable for handler work.
+
+    Submissions are batched. SQEs queued while the reactor is awake
+    are handed to the kernel by the reactor's next io_uring_enter,
+    which also waits for completions, so a handler that starts a read
+    and a write costs a single syscall. Only when the reactor is
+    already blocked does the submitting thread enter the ring itself.
+
+    @par Thread Safety
+    All public member functions are thread-safe.
+*/
+class io_uring_scheduler
+    : public scheduler
+    , public capy::execution_context::service
+{
+public:
+    using key_type = scheduler;
+
+    /** Construct the scheduler.
+
+        Creates the ring and an eventfd for reactor interruption.
+
+        @param ctx Reference to the owning execution_context.
+        @param concurrency_hint Hint for expected thread count (unused).
+        @param opts Tuning options.
+    */
+    io_uring_scheduler(
+        capy::execution_context& ctx,
+        int concurrency_hint = -1,
+        io_uring_options const& opts = {});
+
+    ~io_uring_scheduler();
+
+    io_uring_scheduler(io_uring_scheduler const&) = delete;
+    io_uring_scheduler& operator=(io_uring_scheduler const&) = delete;
+
+    void shutdown() override;
+    void post(capy::coro h) const override;
+    void post(scheduler_op* h) const override;
+    void on_work_started() noexcept override;
+    void on_work_finished() noexcept override;
+    bool running_in_this_thread() const noexcept override;
+    void stop() override;
+    bool stopped() const noexcept override;
+    void restart() override;
+    std::size_t run() override;
+    std::size_t run_one() override;
+    std::size_t wait_one(long usec) override;
+    std::size_t poll() override;
+    std::size_t poll_one() override;
+
+    long outstanding_work() const noexcept override
+    {
+        return outstanding_work_.load(std::memory_order_acquire);
+    }
+
+    std::chrono::steady_clock::time_point now() const noexcept override
+    {
+        return timer_svc_->now();
+    }
+
+    /** Start an I/O operation.
+
+        Fills an SQE from `op.prepare()` and queues it. The operation
+        counts as outstanding work until its completion is handled.
+        If cancellation was already requested the SQE is not queued
+        and the op is posted instead, reporting the cancellation.
+
+        @param op The operation. Its `impl_ptr` must already be set.
+    */
+    void submit(io_uring_op& op) const;
+
+    /** Request cancellation of a submitted operation.
+
+        Queues IORING_OP_ASYNC_CANCEL for `op`. The operation still
+        completes through its own CQE.
+
+        @param op An operation previously passed to @ref submit.
+    */
+    void cancel(io_uring_op& op) const;
+
+    /** Arm a multishot request.
+
+        Queues `sqe` on behalf of `m`, which receives every CQE it
+        produces through @ref io_uring_multishot::on_cqe. The request
+        does not count as work: only the operations it completes do.
+
+        @param m The owner. It must stay alive until it sees a CQE
+            without IORING_CQE_F_MORE.
+        @param sqe The prepared request; user_data is overwritten.
+    */
+    void submit_multishot(io_uring_multishot& m, io_uring_sqe& sqe) const;
+
+    /** Request cancellation of an armed multishot request.
+
+        The request ends with a final CQE delivered to `m`.
+    */
+    void cancel_multishot(io_uring_multishot& m) const;
+
+    /// Return the options the scheduler was constructed with.
+    io_uring_options const& options() const noexcept { return opts_; }
+
+    /// Return `true` if the kernel supports an IORING_OP_* opcode.
+    bool supports(unsigned opcode) const noexcept
+    {
+        return ring_.supports(opcode);
+    }
+
+    /// Return the receive buffer pool, or `nullptr` if there is none.
+    io_uring_buffer_ring* buffer_pool() const noexcept { return pool_.get(); }
+
+    /** Register buffers for IORING_OP_READ_FIXED.
+
+        Replaces any earlier registration.
+
+        @throws system::system_error if the kernel rejects them.
+    */
+    void register_buffers(iovec const* iovs, std::size_t n);
+
+    /// Drop the buffers passed to @ref register_buffers.
+    void unregister_buffers() noexcept;
+
+    /** Find the registered buffer holding a range.
+
+        @return The buffer's index, or -1 if no single registered
+            buffer contains all of `[p, p + n)`.
+    */
+    int find_buffer(void const* p, std::size_t n) const noexcept;
+
+    /** Install a descriptor in a free registered file slot.
+
+        @return The slot, or -1 if none is free.
+
+        @throws system::system_error if the kernel rejects the update.
+    */
+    int register_file(int fd) const;
+
+    /** Empty a slot filled by @ref register_file.
+
+        Queued SQEs are handed to the kernel first, so that none of
+        them can resolve the slot after it is reused.
+    */
+    void unregister_file(int slot) const noexcept;
+
+    /** For use by I/O operations to track pending work. */
+    void work_started() const noexcept override;
+
+    /** For use by I/O operations to track completed work. */
+    void work_finished() const noexcept override;
+
+private:
+    class run_scope;
+    class handler_scope;
+
+    std::size_t do_one(long timeout_us);
+    void enqueue(scheduler_op* h) const;
+    void push_sqe(io_uring_sqe const& sqe) const;
+    void flush_if_reactor_sleeping() const;
+    void arm_wakeup() const;
+    void drain() noexcept;
+    void run_reactor(std::unique_lock<std::mutex>& lock);
+    void wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const;
+    void interrupt_reactor() const;
+    long calculate_timeout(long requested_timeout_us) const;
+
+    // user_data of internal SQEs; op addresses are always aligned,
+    // so the low bits are free to mark multishot owners
+    static constexpr std::uint64_t ignore_tag = 0;
+    static constexpr std::uint64_t wakeup_tag = 1;
+    static constexpr std::uint64_t multishot_bit = 2;
+
+    void push_cancel(std::uint64_t user_data) const;
+
+    struct fixed_buffer
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        int index;
+    };
+
+    io_uring_options opts_;
+
+    mutable io_uring_ring ring_;
+    std::unique_ptr<io_uring_buffer_ring> pool_;  // unregistered before ring_ closes
+    int event_fd_ = -1;                         // for interrupting reactor
+    mutable std::uint64_t wakeup_buf_ = 0;      // target of the eventfd read
+    mutable std::mutex sq_mutex_;               // serializes SQ pushes
+    mutable std::size_t inflight_ = 0;          // SQEs owned by the kernel, guarded by sq_mutex_
+
+    // Registered resources, guarded by rsrc_mutex_
+    mutable std::mutex rsrc_mutex_;
+    std::vector<fixed_buffer> fixed_buffers_;    // sorted by begin
+    std::atomic<bool> has_fixed_buffers_ = false;
+    mutable std::vector<int> free_files_;        // empty file slots
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable wakeup_event_;
+    mutable op_queue completed_ops_;
+    mutable intrusive_mpsc_queue<scheduler_op> injected_;  // lock-free posts
+    mutable std::atomic<long> outstanding_work_;
+    std::atomic<bool> stopped_;
+    bool shutdown_;
+    timer_service* timer_svc_ = nullptr;
+
+    // Single reactor thread coordination
+    mutable bool reactor_running_ = false;
+    mutable bool reactor_interrupted_ = false;
+    mutable std::atomic<int> idle_thread_count_ = 0;
+    mutable std::atomic<bool> reactor_sleeping_ = false;
+    mutable std::atomic<bool> wakeup_pending_ = false;  // eventfd written, not reaped
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_SCHEDULER_HPP
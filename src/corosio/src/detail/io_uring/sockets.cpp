@@ -0,0 +1,940 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/sockets.hpp"
+#include "src/detail/endpoint_convert.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/resume_coro.hpp"
+
+#include <boost/capy/buffers.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+namespace {
+
+// Pool buffers one socket may hold unread before its receive pauses
+constexpr std::size_t max_queued_recvs = 4;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// io_uring_op::canceller - implements stop_token cancellation
+//------------------------------------------------------------------------------
+
+void
+io_uring_op::canceller::
+operator()() const noexcept
+{
+    op->cancel();
+}
+
+//------------------------------------------------------------------------------
+// cancel() overrides for socket operations
+//------------------------------------------------------------------------------
+
+void
+io_uring_connect_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+void
+io_uring_read_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+void
+io_uring_write_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+//------------------------------------------------------------------------------
+// io_uring_read_op::operator() - delivers leases
+//------------------------------------------------------------------------------
+
+void
+io_uring_read_op::
+operator()()
+{
+    if (lease_out)
+    {
+        if (heap && errn == 0 && bytes_transferred > 0)
+            lease = buffer_lease(std::move(heap), bytes_transferred);
+
+        if (!lease.empty())
+        {
+            // Received before any cancellation took effect
+            cancelled.store(false, std::memory_order_relaxed);
+            *lease_out = std::move(lease);
+        }
+        heap.reset();
+    }
+
+    io_uring_op::operator()();
+}
+
+void
+io_uring_read_op::
+destroy()
+{
+    lease.reset();
+    heap.reset();
+    io_uring_op::destroy();
+}
+
+//------------------------------------------------------------------------------
+// io_uring_connect_op::operator() - caches endpoints on successful connect
+//------------------------------------------------------------------------------
+
+void
+io_uring_connect_op::
+operator()()
+{
+    stop_cb.reset();
+
+    bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+
+    // Cache endpoints on successful connect
+    if (success && socket_impl_)
+    {
+        endpoint local_ep;
+        sockaddr_storage local_addr{};
+        socklen_t local_len = sizeof(local_addr);
+        if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+            local_ep = from_sockaddr(local_addr);
+        socket_impl_->set_endpoints(local_ep, target_endpoint);
+    }
+
+    if (ec_out)
+    {
+        if (cancelled.load(std::memory_order_acquire))
+            *ec_out = capy::error::canceled;
+        else if (errn != 0)
+            *ec_out = make_err(errn);
+        else
+            *ec_out = {};
+    }
+
+    if (bytes_out)
+        *bytes_out = bytes_transferred;
+
+    // Move to stack before destroying the frame
+    capy::executor_ref saved_ex( std::move( ex ) );
+    capy::coro saved_h( std::move( h ) );
+    impl_ptr.reset();
+    resume_coro(saved_ex, saved_h);
+}
+
+//------------------------------------------------------------------------------
+// io_uring_socket_impl
+//------------------------------------------------------------------------------
+
+io_uring_socket_impl::
+io_uring_socket_impl(io_uring_socket_service& svc) noexcept
+    : svc_(svc)
+{
+}
+
+void
+io_uring_socket_impl::
+release()
+{
+    close_socket();
+    svc_.destroy_impl(*this);
+}
+
+void
+io_uring_socket_impl::
+submit(io_uring_op& op)
+{
+    op.impl_ptr = shared_from_this();
+    svc_.scheduler().submit(op);
+}
+
+void
+io_uring_socket_impl::
+connect(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    endpoint ep,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    auto& op = conn_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.fd = fd_;
+    op.file_index = file_index_;
+    op.target_endpoint = ep;  // Store target for endpoint caching
+    op.addrlen = detail::to_sockaddr(ep, op.addr);
+    op.start(token, this);
+
+    submit(op);
+}
+
+bool
+io_uring_socket_impl::
+read_some(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.file_index = file_index_;
+    assign_iovecs(op.iovecs, param);
+    op.start(token, this);
+
+    if (op.iovecs.empty())
+    {
+        op.empty_buffer_read = true;
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    if (op.iovecs.size() == 1)
+        op.buf_index = svc_.scheduler().find_buffer(
+            op.iovecs[0].iov_base, op.iovecs[0].iov_len);
+
+    submit(op);
+    return false;
+}
+
+bool
+io_uring_socket_impl::
+write_some(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.file_index = file_index_;
+    assign_iovecs(op.iovecs, param);
+    op.zero_copy = zero_copy_ &&
+        iovecs_size(op.iovecs) >= zero_copy_min_bytes;
+    op.start(token, this);
+
+    if (op.iovecs.empty())
+    {
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    submit(op);
+    return false;
+}
+
+bool
+io_uring_socket_impl::
+read_leased(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::size_t size,
+    std::stop_token token,
+    system::error_code* ec,
+    buffer_lease* lease_out)
+{
+    if (!svc_.scheduler().buffer_pool())
+        return socket_impl::read_leased(h, ex, size, token, ec, lease_out);
+
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.lease_out = lease_out;
+    op.fd = fd_;
+    op.file_index = file_index_;
+    op.start(token, this);
+
+    op.impl_ptr = shared_from_this();
+
+    std::unique_lock lock(mutex_);
+
+    if (recv_queue_.empty() && recv_errn_ == 0 && !recv_eof_ &&
+        !op.cancelled.load(std::memory_order_acquire))
+    {
+        // Completed by on_cqe() or cancel_single_op()
+        if (!armed_)
+            arm_recv();
+        svc_.scheduler().work_started();
+        waiting_ = true;
+        return true;
+    }
+
+    if (!recv_queue_.empty())
+    {
+        auto c = recv_queue_.front();
+        recv_queue_.pop_front();
+        op.lease = make_lease(c);
+        op.complete(0, c.size);
+    }
+    else if (recv_errn_ != 0)
+    {
+        op.complete(recv_errn_, 0);
+        recv_errn_ = 0;
+    }
+
+    // Room again after throttling, or the receive ended
+    if (!armed_ && !recv_eof_ && fd_ >= 0 &&
+        recv_queue_.size() < max_queued_recvs)
+    {
+        try {
+            arm_recv();
+        } catch (system::system_error const&) {
+            // Retried by the next read
+        }
+    }
+
+    lock.unlock();
+    svc_.post(&op);
+    return true;
+}
+
+void
+io_uring_socket_impl::
+arm_recv()
+{
+    // Caller holds mutex_
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_RECV;
+    sqe.ioprio = IORING_RECV_MULTISHOT;  // Linux 6.0
+    sqe.flags = IOSQE_BUFFER_SELECT;
+    if (file_index_ >= 0)
+    {
+        sqe.fd = file_index_;
+        sqe.flags |= IOSQE_FIXED_FILE;
+    }
+    else
+    {
+        sqe.fd = fd_;
+    }
+    sqe.buf_group = svc_.scheduler().buffer_pool()->group();
+
+    stream_ptr_ = shared_from_this();
+    armed_ = true;
+    cancel_requested_ = false;
+    discard_ = false;
+    try {
+        svc_.scheduler().submit_multishot(*this, sqe);
+    } catch (...) {
+        armed_ = false;
+        stream_ptr_.reset();
+        throw;
+    }
+}
+
+scheduler_op*
+io_uring_socket_impl::
+read_private() noexcept
+{
+    // Caller holds mutex_ and has taken the parked reader
+    auto& op = rd_;
+    auto size = svc_.scheduler().buffer_pool()->buffer_size();
+    op.heap.reset(new (std::nothrow) unsigned char[size]);
+    if (!op.heap)
+    {
+        op.complete(ENOMEM, 0);
+        return &op;
+    }
+
+    op.iovecs.assign(iovec{op.heap.get(), size});
+
+    auto& sched = svc_.scheduler();
+    try {
+        sched.submit(op);
+    } catch (system::system_error const& e) {
+        op.heap.reset();
+        op.complete(e.code().value(), 0);
+        return &op;
+    }
+
+    // submit() counted the op again
+    sched.work_finished();
+    return nullptr;
+}
+
+buffer_lease
+io_uring_socket_impl::
+make_lease(recv_chunk c) const noexcept
+{
+    auto* pool = svc_.scheduler().buffer_pool();
+    return buffer_lease(pool->buffer(c.bid), c.size,
+        [](void* owner, void*, std::uint32_t id) noexcept
+        {
+            static_cast<io_uring_buffer_ring*>(owner)->recycle(
+                static_cast<std::uint16_t>(id));
+        },
+        pool, c.bid);
+}
+
+scheduler_op*
+io_uring_socket_impl::
+on_cqe(int res, unsigned flags) noexcept
+{
+    // Destroyed after the lock is released; may be the last reference
+    std::shared_ptr<io_uring_socket_impl> self;
+    std::lock_guard lock(mutex_);
+
+    bool more = (flags & IORING_CQE_F_MORE) != 0;
+    auto* pool = svc_.scheduler().buffer_pool();
+    scheduler_op* ready = nullptr;
+
+    if (res > 0 && (flags & IORING_CQE_F_BUFFER))
+    {
+        recv_chunk c{
+            static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT),
+            static_cast<std::uint32_t>(res)};
+
+        if (discard_ || fd_ < 0)
+        {
+            pool->recycle(c.bid);
+        }
+        else if (waiting_)
+        {
+            waiting_ = false;
+            rd_.lease = make_lease(c);
+            rd_.complete(0, c.size);
+            ready = &rd_;
+        }
+        else
+        {
+            recv_queue_.push_back(c);
+            if (more && !cancel_requested_ &&
+                recv_queue_.size() >= max_queued_recvs)
+            {
+                cancel_requested_ = true;
+                svc_.scheduler().cancel_multishot(*this);
+            }
+        }
+    }
+    else
+    {
+        if (flags & IORING_CQE_F_BUFFER)
+            pool->recycle(static_cast<std::uint16_t>(
+                flags >> IORING_CQE_BUFFER_SHIFT));
+
+        if (res == 0)
+        {
+            // Peer closed; every later read reports it too
+            if (!discard_ && fd_ >= 0)
+                recv_eof_ = true;
+            if (waiting_)
+            {
+                waiting_ = false;
+                rd_.complete(0, 0);
+                ready = &rd_;
+            }
+        }
+        else if (res == -ENOBUFS)
+        {
+            // The pool ran dry; a parked read continues without it
+            if (waiting_)
+            {
+                waiting_ = false;
+                ready = read_private();
+            }
+        }
+        else if (res != -ECANCELED || !cancel_requested_)
+        {
+            if (waiting_)
+            {
+                waiting_ = false;
+                rd_.complete(-res, 0);
+                ready = &rd_;
+            }
+            else if (!discard_ && fd_ >= 0)
+            {
+                recv_errn_ = -res;
+            }
+        }
+    }
+
+    if (more)
+        return ready;
+
+    armed_ = false;
+    self = std::move(stream_ptr_);
+
+    // Re-arm after a throttle, or if a read arrived meanwhile
+    bool throttled = cancel_requested_ && !discard_ && res == -ECANCELED;
+    if (fd_ >= 0 && !recv_eof_ && recv_errn_ == 0 &&
+        (waiting_ || (throttled && recv_queue_.size() < max_queued_recvs)))
+    {
+        try {
+            arm_recv();
+        } catch (system::system_error const& e) {
+            if (waiting_)
+            {
+                waiting_ = false;
+                rd_.complete(e.code().value(), 0);
+                ready = &rd_;
+            }
+        }
+    }
+
+    return ready;
+}
+
+bool
+io_uring_socket_impl::
+take_reader() noexcept
+{
+    std::lock_guard lock(mutex_);
+    if (!waiting_)
+        return false;
+    waiting_ = false;
+    return true;
+}
+
+system::error_code
+io_uring_socket_impl::
+shutdown(socket::shutdown_type what) noexcept
+{
+    int how;
+    switch (what)
+    {
+    case socket::shutdown_receive: how = SHUT_RD;   break;
+    case socket::shutdown_send:    how = SHUT_WR;   break;
+    case socket::shutdown_both:    how = SHUT_RDWR; break;
+    default:
+        return make_err(EINVAL);
+    }
+    if (::shutdown(fd_, how) != 0)
+        return make_err(errno);
+    return {};
+}
+
+//------------------------------------------------------------------------------
+// Socket Options
+//------------------------------------------------------------------------------
+
+system::error_code
+io_uring_socket_impl::
+set_no_delay(bool value) noexcept
+{
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+bool
+io_uring_socket_impl::
+no_delay(system::error_code& ec) const noexcept
+{
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    if (::getsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &flag, &len) != 0)
+    {
+        ec = make_err(errno);
+        return false;
+    }
+    ec = {};
+    return flag != 0;
+}
+
+system::error_code
+io_uring_socket_impl::
+set_keep_alive(bool value) noexcept
+{
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+bool
+io_uring_socket_impl::
+keep_alive(system::error_code& ec) const noexcept
+{
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &flag, &len) != 0)
+    {
+        ec = make_err(errno);
+        return false;
+    }
+    ec = {};
+    return flag != 0;
+}
+
+system::error_code
+io_uring_socket_impl::
+set_receive_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+io_uring_socket_impl::
+receive_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+io_uring_socket_impl::
+set_send_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+io_uring_socket_impl::
+send_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+io_uring_socket_impl::
+set_linger(bool enabled, int timeout) noexcept
+{
+    if (timeout < 0)
+        return make_err(EINVAL);
+    struct ::linger lg;
+    lg.l_onoff = enabled ? 1 : 0;
+    lg.l_linger = timeout;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+socket::linger_options
+io_uring_socket_impl::
+linger(system::error_code& ec) const noexcept
+{
+    struct ::linger lg{};
+    socklen_t len = sizeof(lg);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_LINGER, &lg, &len) != 0)
+    {
+        ec = make_err(errno);
+        return {};
+    }
+    ec = {};
+    return {.enabled = lg.l_onoff != 0, .timeout = lg.l_linger};
+}
+
+system::error_code
+io_uring_socket_impl::
+set_zero_copy(bool value) noexcept
+{
+    // IORING_OP_SENDMSG_ZC needs Linux 6.1
+#ifdef IORING_CQE_F_NOTIF
+    if (value && !svc_.scheduler().supports(IORING_OP_SENDMSG_ZC))
+        return make_err(EOPNOTSUPP);
+    zero_copy_ = value;
+    return {};
+#else
+    (void)value;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+bool
+io_uring_socket_impl::
+zero_copy(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return zero_copy_;
+}
+
+void
+io_uring_socket_impl::
+cancel() noexcept
+{
+    conn_.request_cancel();
+    rd_.request_cancel();
+    wr_.request_cancel();
+
+    auto& sched = svc_.scheduler();
+
+    // A leased read parked on the receive stream is not in the kernel
+    if (take_reader())
+    {
+        svc_.post(&rd_);
+        sched.work_finished();
+    }
+
+    sched.cancel(conn_);
+    sched.cancel(rd_);
+    sched.cancel(wr_);
+}
+
+void
+io_uring_socket_impl::
+cancel_single_op(io_uring_op& op) noexcept
+{
+    // Called from stop_token callback to cancel a specific pending operation.
+    op.request_cancel();
+
+    if (&op == &rd_ && take_reader())
+    {
+        svc_.post(&op);
+        svc_.scheduler().work_finished();
+        return;
+    }
+
+    svc_.scheduler().cancel(op);
+}
+
+void
+io_uring_socket_impl::
+close_socket() noexcept
+{
+    // Closing the fd alone would not cancel requests the kernel owns
+    cancel();
+
+    {
+        std::lock_guard lock(mutex_);
+        if (armed_ && !discard_)
+        {
+            cancel_requested_ = true;
+            discard_ = true;
+            try {
+                svc_.scheduler().cancel_multishot(*this);
+            } catch (...) {
+                // The ring is unusable; late arrivals are recycled
+            }
+        }
+
+        if (auto* pool = svc_.scheduler().buffer_pool())
+            for (auto c : recv_queue_)
+                pool->recycle(c.bid);
+        recv_queue_.clear();
+        recv_errn_ = 0;
+        recv_eof_ = false;
+
+        // The table holds its own reference to the file
+        if (file_index_ >= 0)
+        {
+            svc_.scheduler().unregister_file(file_index_);
+            file_index_ = -1;
+        }
+
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    zero_copy_ = false;
+
+    // Clear cached endpoints
+    local_endpoint_ = endpoint{};
+    remote_endpoint_ = endpoint{};
+}
+
+bool
+io_uring_socket_impl::
+register_file()
+{
+    std::lock_guard lock(mutex_);
+    if (fd_ < 0)
+        return false;
+    if (file_index_ < 0)
+        file_index_ = svc_.scheduler().register_file(fd_);
+    return file_index_ >= 0;
+}
+
+system::error_code
+io_uring_socket_impl::
+set_socket(int fd) noexcept
+{
+    std::lock_guard lock(mutex_);
+    fd_ = fd;
+    return {};
+}
+
+//------------------------------------------------------------------------------
+// io_uring_socket_service
+//------------------------------------------------------------------------------
+
+io_uring_socket_service::
+io_uring_socket_service(capy::execution_context& ctx)
+    : state_(std::make_unique<io_uring_socket_state>(ctx.use_service<io_uring_scheduler>()))
+{
+}
+
+io_uring_socket_service::
+~io_uring_socket_service()
+{
+}
+
+void
+io_uring_socket_service::
+shutdown()
+{
+    std::lock_guard lock(state_->mutex_);
+
+    while (auto* impl = state_->socket_list_.pop_front())
+        impl->close_socket();
+
+    state_->socket_ptrs_.clear();
+}
+
+socket::socket_impl&
+io_uring_socket_service::
+create_impl()
+{
+    auto impl = make_recycled_impl<io_uring_socket_impl>(*this);
+    auto* raw = impl.get();
+
+    {
+        std::lock_guard lock(state_->mutex_);
+        state_->socket_list_.push_back(raw);
+        state_->socket_ptrs_.emplace(raw, std::move(impl));
+    }
+
+    return *raw;
+}
+
+void
+io_uring_socket_service::
+destroy_impl(socket::socket_impl& impl)
+{
+    auto* uring_impl = static_cast<io_uring_socket_impl*>(&impl);
+    std::lock_guard lock(state_->mutex_);
+    state_->socket_list_.remove(uring_impl);
+    state_->socket_ptrs_.erase(uring_impl);
+}
+
+system::error_code
+io_uring_socket_service::
+open_socket(
+    socket::socket_impl& impl,
+    ip_family family)
+{
+    auto* uring_impl = static_cast<io_uring_socket_impl*>(&impl);
+    uring_impl->close_socket();
+
+    int fd = ::socket(detail::to_af(family), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    return uring_impl->set_socket(fd);
+}
+
+system::error_code
+io_uring_socket_service::
+open_local_socket(
+    socket::socket_impl& impl)
+{
+    auto* uring_impl = static_cast<io_uring_socket_impl*>(&impl);
+    uring_impl->close_socket();
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    return uring_impl->set_socket(fd);
+}
+
+system::error_code
+io_uring_socket_service::
+assign_socket(
+    socket::socket_impl& impl,
+    native_handle_type fd,
+    endpoint local,
+    endpoint remote)
+{
+    auto* uring_impl = static_cast<io_uring_socket_impl*>(&impl);
+    uring_impl->close_socket();
+
+    if (auto ec = uring_impl->set_socket(fd))
+        return ec;
+    uring_impl->set_endpoints(local, remote);
+    return {};
+}
+
+void
+io_uring_socket_service::
+post(io_uring_op* op)
+{
+    state_->sched_.post(op);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IO_URING_SOCKETS_HPP
+#define BOOST_COROSIO_DETAIL_IO_URING_SOCKETS_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/socket_service.hpp"
+
+#include "src/detail/io_uring/op.hpp"
+#include "src/detail/io_uring/scheduler.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/*
+    io_uring Socket Implementation
+    ==============================
+
+    Each operation fills its op slot and hands it to the scheduler with
+    io_uring_scheduler::submit(); the kernel performs the I/O and the
+    reactor queues the op when its CQE arrives. Nothing is registered
+    per descriptor, and nothing is tried in user space first: an idle
+    socket costs no kernel state beyond its pending SQEs.
+
+    Cancellation
+    ------------
+    cancel() marks every op cancelled and asks the kernel to cancel the
+    ones it owns. Each op still completes exactly once through its CQE,
+    or through post() if it had not been submitted. close_socket()
+    cancels before closing the fd, since closing an fd does not cancel
+    io_uring requests that already hold a reference to the file.
+
+    Impl Lifetime with shared_ptr
+    -----------------------------
+    As in the epoll backend, impls use enable_shared_from_this and every
+    submitted op carries impl_ptr until its handler runs, so a socket
+    closed or destroyed with I/O in flight stays alive until the kernel
+    is done with its op slots.
+
+    Leased Reads
+    ------------
+    With a receive pool configured, read_leased() arms a multishot
+    IORING_OP_RECV that selects buffers from the pool. Each CQE names
+    the buffer the kernel filled; it either completes the parked read
+    op or is queued in recv_queue_ for the next read_leased(), which
+    then completes without a submission. A short queue limit keeps one
+    slow reader from draining the pool: reaching it cancels the
+    receive, and the next read_leased() that makes room re-arms it.
+    When the pool is empty the kernel ends the receive with -ENOBUFS;
+    a parked read then falls back to an ordinary READV into a private
+    buffer, so leased reads never fail for lack of pool buffers.
+    Without a receive pool, read_leased() is that of socket_impl.
+
+    Registered Files
+    ----------------
+    After register_file() every op names the socket by its slot in the
+    context's file table. The table keeps its own reference to the
+    file, so close_socket() empties the slot before closing the fd;
+    otherwise the connection would stay open.
+
+    Service Ownership
+    -----------------
+    io_uring_socket_service owns all socket impls. destroy_impl() removes
+    the shared_ptr from the map, but the impl may survive while ops still
+    hold impl_ptr refs. shutdown() closes all sockets and clears the map;
+    the scheduler's shutdown reaps the remaining completions.
+*/
+
+namespace boost::corosio::detail {
+
+class io_uring_socket_service;
+class io_uring_socket_impl;
+
+//------------------------------------------------------------------------------
+
+class io_uring_socket_impl final
+    : public socket::socket_impl
+    , public std::enable_shared_from_this<io_uring_socket_impl>
+    , public intrusive_list<io_uring_socket_impl>::node
+    , public io_uring_multishot
+{
+    friend class io_uring_socket_service;
+
+public:
+    explicit io_uring_socket_impl(io_uring_socket_service& svc) noexcept;
+
+    void release() override;
+
+    void connect(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        endpoint,
+        std::stop_token,
+        system::error_code*) override;
+
+    bool read_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool write_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool read_leased(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
+        buffer_lease*) override;
+
+    system::error_code shutdown(socket::shutdown_type what) noexcept override;
+
+    native_handle_type native_handle() const noexcept override { return fd_; }
+
+    // Socket options
+    system::error_code set_no_delay(bool value) noexcept override;
+    bool no_delay(system::error_code& ec) const noexcept override;
+
+    system::error_code set_keep_alive(bool value) noexcept override;
+    bool keep_alive(system::error_code& ec) const noexcept override;
+
+    system::error_code set_receive_buffer_size(int size) noexcept override;
+    int receive_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_send_buffer_size(int size) noexcept override;
+    int send_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_linger(bool enabled, int timeout) noexcept override;
+    socket::linger_options linger(system::error_code& ec) const noexcept override;
+
+    system::error_code set_zero_copy(bool value) noexcept override;
+    bool zero_copy(system::error_code& ec) const noexcept override;
+
+    endpoint local_endpoint() const noexcept override { return local_endpoint_; }
+    endpoint remote_endpoint() const noexcept override { return remote_endpoint_; }
+    bool is_open() const noexcept { return fd_ >= 0; }
+    void cancel() noexcept override;
+    void cancel_single_op(io_uring_op& op) noexcept;
+    void close_socket() noexcept;
+    system::error_code set_socket(int fd) noexcept;
+
+    /** Move the socket into the registered file table.
+
+        @return `true` if registered, `false` if no slot is free.
+    */
+    bool register_file();
+    void set_endpoints(endpoint local, endpoint remote) noexcept
+    {
+        local_endpoint_ = local;
+        remote_endpoint_ = remote;
+    }
+
+    scheduler_op* on_cqe(int res, unsigned flags) noexcept override;
+
+    io_uring_connect_op conn_;
+    io_uring_read_op rd_;
+    io_uring_write_op wr_;
+
+private:
+    struct recv_chunk
+    {
+        std::uint16_t bid;
+        std::uint32_t size;
+    };
+
+    void submit(io_uring_op& op);
+    void arm_recv();
+    scheduler_op* read_private() noexcept;
+    bool take_reader() noexcept;
+    buffer_lease make_lease(recv_chunk c) const noexcept;
+
+    io_uring_socket_service& svc_;
+    int fd_ = -1;
+    int file_index_ = -1;                   // registered file slot, or -1
+    bool zero_copy_ = false;                // see "Zero-Copy Sends"
+    endpoint local_endpoint_;
+    endpoint remote_endpoint_;
+
+    // Leased read state, guarded by mutex_
+    std::mutex mutex_;
+    std::deque<recv_chunk> recv_queue_;     // received, not yet claimed
+    int recv_errn_ = 0;                     // stream error for the next read
+    bool recv_eof_ = false;                 // peer closed; sticky
+    bool armed_ = false;                    // final CQE not yet seen
+    bool cancel_requested_ = false;         // throttled or closing
+    bool discard_ = false;                  // recycle late arrivals
+    bool waiting_ = false;                  // rd_ awaits data
+    std::shared_ptr<io_uring_socket_impl> stream_ptr_;  // held while armed
+};
+
+//------------------------------------------------------------------------------
+
+/** State for io_uring socket service. */
+class io_uring_socket_state
+{
+public:
+    explicit io_uring_socket_state(io_uring_scheduler& sched) noexcept
+        : sched_(sched)
+    {
+    }
+
+    io_uring_scheduler& sched_;
+    std::mutex mutex_;
+    intrusive_list<io_uring_socket_impl> socket_list_;
+    impl_ptr_map<io_uring_socket_impl> socket_ptrs_;
+};
+
+/** io_uring socket service implementation.
+
+    Inherits from socket_service to enable runtime polymorphism.
+    Uses key_type = socket_service for service lookup.
+*/
+class io_uring_socket_service : public socket_service
+{
+public:
+    explicit io_uring_socket_service(capy::execution_context& ctx);
+    ~io_uring_socket_service();
+
+    io_uring_socket_service(io_uring_socket_service const&) = delete;
+    io_uring_socket_service& operator=(io_uring_socket_service const&) = delete;
+
+    void shutdown() override;
+
+    socket::socket_impl& create_impl() override;
+    void destroy_impl(socket::socket_impl& impl) override;
+    system::error_code open_socket(
+        socket::socket_impl& impl,
+        ip_family family) override;
+    system::error_code open_local_socket(
+        socket::socket_impl& impl) override;
+    system::error_code assign_socket(
+        socket::socket_impl& impl,
+        native_handle_type fd,
+        endpoint local,
+        endpoint remote) override;
+
+    io_uring_scheduler& scheduler() const noexcept { return state_->sched_; }
+    void post(io_uring_op* op);
+
+private:
+    std::unique_ptr<io_uring_socket_state> state_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IO_URING
+
+#endif // BOOST_COROSIO_DETAIL_IO_URING_SOCKETS_HPP
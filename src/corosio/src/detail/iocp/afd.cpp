@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include "src/detail/iocp/afd.hpp"
+#include "src/detail/iocp/overlapped_op.hpp"
+
+#include <MSWSock.h>
+
+#include <cstdint>
+
+/*
+    The Device
+    ----------
+    AFD is not documented, but its poll request has been stable since
+    Windows Vista and is what WSAPoll is built on. Any name under
+    \Device\Afd opens the driver; the one given here only shows up in
+    handle listings. The functions involved live in ntdll and are
+    looked up when the device is opened, so a system without them
+    keeps the zero-byte receive waits of the completion port.
+
+    Requests
+    --------
+    The status block of a request is the Internal and InternalHigh
+    fields of the operation's OVERLAPPED, which have its layout, and
+    the APC context is the OVERLAPPED itself. The completion packet
+    therefore looks like that of any overlapped socket operation:
+    the scheduler reads the NTSTATUS from Internal, and the key casts
+    the pointer back to the op. Cancelling passes the same pointer
+    to CancelIoEx on the AFD handle.
+
+    A request names the base provider socket, since AFD does not know
+    the handles layered service providers hand out.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+using NTSTATUS = LONG;
+constexpr NTSTATUS STATUS_SUCCESS = 0;
+constexpr NTSTATUS STATUS_PENDING = 0x00000103;
+
+constexpr ULONG ioctl_afd_poll = 0x00012024;
+constexpr ULONG file_open = 0x00000001;
+constexpr ULONG obj_case_insensitive = 0x00000040;
+
+struct nt_unicode_string
+{
+    USHORT length;
+    USHORT maximum_length;
+    wchar_t* buffer;
+};
+
+struct nt_object_attributes
+{
+    ULONG length;
+    HANDLE root_directory;
+    nt_unicode_string* object_name;
+    ULONG attributes;
+    void* security_descriptor;
+    void* security_quality_of_service;
+};
+
+struct nt_io_status_block
+{
+    ULONG_PTR status;
+    ULONG_PTR information;
+};
+
+using NtCreateFileFn = NTSTATUS(NTAPI*)(
+    HANDLE* FileHandle,
+    ACCESS_MASK DesiredAccess,
+    nt_object_attributes* ObjectAttributes,
+    nt_io_status_block* IoStatusBlock,
+    LARGE_INTEGER* AllocationSize,
+    ULONG FileAttributes,
+    ULONG ShareAccess,
+    ULONG CreateDisposition,
+    ULONG CreateOptions,
+    void* EaBuffer,
+    ULONG EaLength);
+
+using NtDeviceIoControlFileFn = NTSTATUS(NTAPI*)(
+    HANDLE FileHandle,
+    HANDLE Event,
+    void* ApcRoutine,
+    void* ApcContext,
+    nt_io_status_block* IoStatusBlock,
+    ULONG IoControlCode,
+    void* InputBuffer,
+    ULONG InputBufferLength,
+    void* OutputBuffer,
+    ULONG OutputBufferLength);
+
+using RtlNtStatusToDosErrorFn = ULONG(WINAPI*)(NTSTATUS);
+
+SOCKET
+base_socket(SOCKET s) noexcept
+{
+    SOCKET base = INVALID_SOCKET;
+    DWORD bytes = 0;
+    if (::WSAIoctl(s, SIO_BASE_HANDLE, nullptr, 0,
+            &base, sizeof(base), &bytes, nullptr, nullptr) != 0)
+        return s;
+    return base;
+}
+
+} // namespace
+
+win_afd::
+win_afd(HANDLE afd, void* ioctl, void* to_dos) noexcept
+    : afd_(afd)
+    , nt_device_io_control_file_(ioctl)
+    , rtl_nt_status_to_dos_error_(to_dos)
+{
+}
+
+std::unique_ptr<win_afd>
+win_afd::
+try_create(void* iocp, completion_key* key)
+{
+    HMODULE ntdll = ::GetModuleHandleW(L"ntdll.dll");
+    if (!ntdll)
+        return nullptr;
+
+    auto nt_create = ::GetProcAddress(ntdll, "NtCreateFile");
+    auto nt_ioctl = ::GetProcAddress(ntdll, "NtDeviceIoControlFile");
+    auto to_dos = ::GetProcAddress(ntdll, "RtlNtStatusToDosError");
+    if (!nt_create || !nt_ioctl || !to_dos)
+        return nullptr;
+
+    wchar_t name[] = L"\\Device\\Afd\\Corosio";
+    nt_unicode_string path{
+        static_cast<USHORT>(sizeof(name) - sizeof(wchar_t)),
+        static_cast<USHORT>(sizeof(name)),
+        name};
+    nt_object_attributes attrs{
+        sizeof(nt_object_attributes), nullptr, &path,
+        obj_case_insensitive, nullptr, nullptr};
+
+    HANDLE afd = nullptr;
+    nt_io_status_block iosb{};
+    auto create_fn = reinterpret_cast<NtCreateFileFn>(nt_create);
+    NTSTATUS status = create_fn(
+        &afd, SYNCHRONIZE, &attrs, &iosb, nullptr, 0,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, file_open, 0, nullptr, 0);
+    if (status != STATUS_SUCCESS)
+        return nullptr;
+
+    if (!::CreateIoCompletionPort(afd, static_cast<HANDLE>(iocp),
+            reinterpret_cast<ULONG_PTR>(key), 0))
+    {
+        ::CloseHandle(afd);
+        return nullptr;
+    }
+
+    // Nothing waits on the handle itself
+    ::SetFileCompletionNotificationModes(afd, FILE_SKIP_SET_EVENT_ON_HANDLE);
+
+    return std::unique_ptr<win_afd>(new win_afd(
+        afd,
+        reinterpret_cast<void*>(nt_ioctl),
+        reinterpret_cast<void*>(to_dos)));
+}
+
+win_afd::
+~win_afd()
+{
+    ::CloseHandle(afd_);
+}
+
+DWORD
+win_afd::
+poll(
+    SOCKET s,
+    ULONG events,
+    afd_poll_info& info,
+    overlapped_op& op) noexcept
+{
+    info.timeout.QuadPart = INT64_MAX;
+    info.number_of_handles = 1;
+    info.exclusive = FALSE;
+    info.handles[0].handle = reinterpret_cast<HANDLE>(base_socket(s));
+    info.handles[0].events = events;
+    info.handles[0].status = 0;
+
+    OVERLAPPED* ov = &op;
+    ov->Internal = static_cast<ULONG_PTR>(STATUS_PENDING);
+
+    auto ioctl_fn = reinterpret_cast<NtDeviceIoControlFileFn>(
+        nt_device_io_control_file_);
+    NTSTATUS status = ioctl_fn(
+        afd_, nullptr, nullptr, ov,
+        reinterpret_cast<nt_io_status_block*>(&ov->Internal),
+        ioctl_afd_poll,
+        &info, sizeof(info),
+        &info, sizeof(info));
+
+    // A request that completed at once still queues its packet
+    if (status == STATUS_PENDING || status >= 0)
+        return 0;
+    auto to_dos = reinterpret_cast<RtlNtStatusToDosErrorFn>(
+        rtl_nt_status_to_dos_error_);
+    return to_dos(status);
+}
+
+void
+win_afd::
+cancel(overlapped_op& op) noexcept
+{
+    ::CancelIoEx(afd_, &op);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IOCP
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IOCP_AFD_HPP
+#define BOOST_COROSIO_DETAIL_IOCP_AFD_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include "src/detail/iocp/windows.hpp"
+#include "src/detail/iocp/completion_key.hpp"
+
+#include <memory>
+
+namespace boost::corosio::detail {
+
+struct overlapped_op;
+
+/// One socket of an IOCTL_AFD_POLL request.
+struct afd_poll_handle_info
+{
+    HANDLE handle;
+    ULONG events;
+    LONG status;
+};
+
+/// The buffer of an IOCTL_AFD_POLL request, in and out.
+struct afd_poll_info
+{
+    LARGE_INTEGER timeout;
+    ULONG number_of_handles;
+    ULONG exclusive;
+    afd_poll_handle_info handles[1];
+};
+
+/** Readiness polling through the Ancillary Function Driver.
+
+    Winsock sockets are endpoints of AFD, which answers an
+    IOCTL_AFD_POLL request on a handle to `\Device\Afd` once one
+    of the sockets named in it is ready. The request is overlapped,
+    so one handle associated with the completion port carries the
+    polls of every socket of the context, each completing as an
+    ordinary packet of its operation. wepoll and libuv do the same.
+
+    A poll holds no buffer and no locked pages, only the request
+    itself, so an idle socket waiting for data costs what it does
+    on a reactor.
+
+    @par Thread Safety
+    All public member functions are thread-safe.
+*/
+class win_afd
+{
+public:
+    /// Data, the end of the stream, or a connection is waiting.
+    static constexpr ULONG poll_receive = 0x0001 | 0x0008 | 0x0080;
+
+    /// There is room to send.
+    static constexpr ULONG poll_send = 0x0004;
+
+    /// Urgent data is waiting.
+    static constexpr ULONG poll_urgent = 0x0002;
+
+    /// The connection was reset or failed to connect.
+    static constexpr ULONG poll_error = 0x0010 | 0x0100;
+
+    /** Open the AFD device, or return nullptr when it cannot be used.
+
+        @param iocp The completion port handle.
+        @param key The key poll completions are dispatched through.
+    */
+    static std::unique_ptr<win_afd> try_create(
+        void* iocp, completion_key* key);
+
+    ~win_afd();
+
+    win_afd(win_afd const&) = delete;
+    win_afd& operator=(win_afd const&) = delete;
+
+    /** Start polling one socket.
+
+        The kernel queues a completion for `op` once the socket is
+        ready for any of `events`, even if it already is.
+
+        @param s The socket.
+        @param events The `poll_*` conditions to wait for.
+        @param info The request, kept until the completion.
+        @param op The operation completed by the poll.
+
+        @return 0, or the error if no completion will be queued.
+    */
+    DWORD poll(
+        SOCKET s,
+        ULONG events,
+        afd_poll_info& info,
+        overlapped_op& op) noexcept;
+
+    /// Cancel a poll started for `op`, if it is pending.
+    void cancel(overlapped_op& op) noexcept;
+
+private:
+    win_afd(HANDLE afd, void* ioctl, void* to_dos) noexcept;
+
+    HANDLE afd_;
+    void* nt_device_io_control_file_;
+    void* rtl_nt_status_to_dos_error_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IOCP
+
+#endif // BOOST_COROSIO_DETAIL_IOCP_AFD_HPP
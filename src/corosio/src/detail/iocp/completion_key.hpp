@@ -57,6 +57,18 @@ struct completion_key
     */
     virtual void destroy(LPOVERLAPPED /*overlapped*/) {}
 
+    /** Return true if a completion should run before others.
+
+        Consulted only once a socket has asked for high priority
+        completions, to reorder a dequeued batch.
+
+        @param overlapped The OVERLAPPED pointer of the completion.
+    */
+    virtual bool high_priority(LPOVERLAPPED /*overlapped*/) const noexcept
+    {
+        return false;
+    }
+
     /** Re-queue this key to the IOCP.
 
         Allows a key to post itself back to the completion port,
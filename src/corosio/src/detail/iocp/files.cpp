@@ -0,0 +1,597 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include "src/detail/iocp/files.hpp"
+#include "src/detail/iocp/completion_key.hpp"
+#include "src/detail/iocp/mutex.hpp"
+#include "src/detail/iocp/overlapped_op.hpp"
+#include "src/detail/iocp/scheduler.hpp"
+#include "src/detail/intrusive.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/recycling_allocator.hpp"
+
+#include <boost/corosio/random_access_file.hpp>
+#include <boost/corosio/stream_file.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "src/detail/iocp/windows.hpp"
+
+namespace boost::corosio::detail {
+
+class win_file_impl;
+class win_file_service;
+
+namespace {
+
+// Convert a UTF-8 path to the UTF-16 CreateFileW expects
+std::wstring
+to_wide(std::string_view s)
+{
+    if (s.empty())
+        return {};
+
+    int len = ::MultiByteToWideChar(
+        CP_UTF8, 0,
+        s.data(), static_cast<int>(s.size()),
+        nullptr, 0);
+
+    if (len <= 0)
+        return {};
+
+    std::wstring result(static_cast<std::size_t>(len), L'\0');
+    ::MultiByteToWideChar(
+        CP_UTF8, 0,
+        s.data(), static_cast<int>(s.size()),
+        result.data(), len);
+
+    return result;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+/** Read or write operation state for a file. */
+struct win_file_op : overlapped_op
+{
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    bool is_write = false;
+    bool append = false;
+    std::uint64_t offset = 0;
+
+    // A stream file's position, advanced on success
+    std::uint64_t* position = nullptr;
+
+    std::shared_ptr<win_file_impl> impl_ptr;  // Keeps the impl alive during I/O
+
+    bool is_read_operation() const noexcept override
+    {
+        return !is_write;
+    }
+
+    void operator()() override
+    {
+        advance();
+
+        // The resumed coroutine may close the file
+        auto self = std::move(impl_ptr);
+        overlapped_op::operator()();
+    }
+
+    void destroy() override
+    {
+        overlapped_op::destroy();
+        impl_ptr.reset();
+    }
+
+    void do_cancel() noexcept override
+    {
+        ::CancelIoEx(handle, this);
+    }
+
+    /// Move a stream file's position past the transferred bytes.
+    void advance() noexcept
+    {
+        if (!position || dwError != 0)
+            return;
+
+        std::uint64_t end = offset + bytes_transferred;
+
+        // An appending write went to the end, wherever that was
+        if (is_write && append)
+        {
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(handle, &size))
+                end = static_cast<std::uint64_t>(size.QuadPart);
+        }
+        *position = end;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class win_file_impl final
+    : public random_access_file::random_access_file_impl
+    , public stream_file::stream_file_impl
+    , public std::enable_shared_from_this<win_file_impl>
+    , public intrusive_list<win_file_impl>::node
+{
+public:
+    explicit win_file_impl(win_file_service& svc) noexcept
+        : svc_(svc)
+    {
+    }
+
+    ~win_file_impl()
+    {
+        if (handle_ != INVALID_HANDLE_VALUE)
+            ::CloseHandle(handle_);
+    }
+
+    void release() override;
+
+    system::error_code open(
+        std::string_view path,
+        file_base::flags open_flags) override;
+
+    native_file_type native_handle() const noexcept override
+    {
+        return handle_;
+    }
+
+    void cancel() noexcept override
+    {
+        rd_.request_cancel();
+        rd_.do_cancel();
+        wr_.request_cancel();
+        wr_.do_cancel();
+    }
+
+    std::uint64_t size(system::error_code& ec) const override;
+    system::error_code resize(std::uint64_t n) override;
+
+    system::error_code sync_all() override
+    {
+        return flush();
+    }
+
+    system::error_code sync_data() override
+    {
+        // Windows has no flush of the data alone
+        return flush();
+    }
+
+    std::uint64_t seek(
+        std::int64_t offset,
+        file_base::seek_basis whence,
+        system::error_code& ec) override;
+
+    bool read_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool read_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+private:
+    bool start(
+        win_file_op& op,
+        bool is_write,
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        std::uint64_t* position,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes);
+
+    system::error_code flush() noexcept
+    {
+        if (!::FlushFileBuffers(handle_))
+            return make_err(::GetLastError());
+        return {};
+    }
+
+    win_file_service& svc_;
+    win_file_op rd_;
+    win_file_op wr_;
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+    bool append_ = false;
+    std::uint64_t pos_ = 0;
+};
+
+//------------------------------------------------------------------------------
+
+class win_file_service final : public file_service
+{
+public:
+    win_file_service(
+        capy::execution_context&,
+        win_scheduler& sched)
+        : sched_(sched)
+        , iocp_(sched.native_handle())
+    {
+    }
+
+    win_file_service(win_file_service const&) = delete;
+    win_file_service& operator=(win_file_service const&) = delete;
+
+    void shutdown() override
+    {
+        std::lock_guard<win_mutex> lock(mutex_);
+        while (auto* impl = impl_list_.pop_front())
+            impl->cancel();
+
+        // The scheduler's shutdown destroys the pending completions
+        impl_ptrs_.clear();
+    }
+
+    random_access_file::random_access_file_impl&
+    create_random_access_impl() override
+    {
+        return create_impl();
+    }
+
+    stream_file::stream_file_impl&
+    create_stream_impl() override
+    {
+        return create_impl();
+    }
+
+    void destroy_impl(win_file_impl& impl)
+    {
+        std::lock_guard<win_mutex> lock(mutex_);
+        impl_list_.remove(&impl);
+        impl_ptrs_.erase(&impl);
+    }
+
+    /// Associate `h` with the completion port.
+    system::error_code associate(HANDLE h) noexcept
+    {
+        if (!::CreateIoCompletionPort(
+                h,
+                static_cast<HANDLE>(iocp_),
+                reinterpret_cast<ULONG_PTR>(&key_),
+                0))
+            return make_err(::GetLastError());
+
+        ::SetFileCompletionNotificationModes(
+            h, FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
+        return {};
+    }
+
+    void post(overlapped_op* op)
+    {
+        sched_.post(op);
+    }
+
+    void work_started() noexcept
+    {
+        sched_.work_started();
+    }
+
+    void work_finished() noexcept
+    {
+        sched_.work_finished();
+    }
+
+private:
+    struct file_key final : completion_key
+    {
+        result on_completion(
+            win_scheduler& sched,
+            DWORD bytes,
+            DWORD dwError,
+            LPOVERLAPPED overlapped) override
+        {
+            auto* op = static_cast<overlapped_op*>(overlapped);
+            if (::InterlockedCompareExchange(&op->ready_, 1, 0) == 0)
+            {
+                win_scheduler::handler_scope g{sched};
+                op->complete(bytes, dwError);
+                (*op)();
+                return result::did_work;
+            }
+            return result::continue_loop;
+        }
+
+        void destroy(LPOVERLAPPED overlapped) override
+        {
+            static_cast<overlapped_op*>(overlapped)->destroy();
+        }
+    };
+
+    win_file_impl& create_impl()
+    {
+        auto impl = make_recycled_impl<win_file_impl>(*this);
+        auto* raw = impl.get();
+
+        std::lock_guard<win_mutex> lock(mutex_);
+        impl_list_.push_back(raw);
+        impl_ptrs_.emplace(raw, std::move(impl));
+        return *raw;
+    }
+
+    win_scheduler& sched_;
+    void* iocp_;
+    file_key key_;
+    win_mutex mutex_;
+    intrusive_list<win_file_impl> impl_list_;
+    impl_ptr_map<win_file_impl> impl_ptrs_;
+};
+
+//------------------------------------------------------------------------------
+// win_file_impl
+//------------------------------------------------------------------------------
+
+void
+win_file_impl::
+release()
+{
+    cancel();
+    svc_.destroy_impl(*this);
+}
+
+system::error_code
+win_file_impl::
+open(std::string_view path, file_base::flags open_flags)
+{
+    DWORD access = 0;
+    if (open_flags & file_base::read_write)
+        access = GENERIC_READ | GENERIC_WRITE;
+    else if (open_flags & file_base::write_only)
+        access = GENERIC_WRITE;
+    else
+        access = GENERIC_READ;
+
+    DWORD disposition = OPEN_EXISTING;
+    if (open_flags & file_base::create)
+    {
+        if (open_flags & file_base::exclusive)
+            disposition = CREATE_NEW;
+        else if (open_flags & file_base::truncate)
+            disposition = CREATE_ALWAYS;
+        else
+            disposition = OPEN_ALWAYS;
+    }
+    else if (open_flags & file_base::truncate)
+    {
+        disposition = TRUNCATE_EXISTING;
+    }
+
+    DWORD attributes = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED;
+    if (open_flags & file_base::sync_all_on_write)
+        attributes |= FILE_FLAG_WRITE_THROUGH;
+
+    HANDLE h = ::CreateFileW(
+        to_wide(path).c_str(),
+        access,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        disposition,
+        attributes,
+        nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return make_err(::GetLastError());
+
+    auto ec = svc_.associate(h);
+    if (ec)
+    {
+        ::CloseHandle(h);
+        return ec;
+    }
+
+    if (handle_ != INVALID_HANDLE_VALUE)
+        ::CloseHandle(handle_);
+    handle_ = h;
+    append_ = (open_flags & file_base::append) != 0;
+    pos_ = 0;
+    return {};
+}
+
+std::uint64_t
+win_file_impl::
+size(system::error_code& ec) const
+{
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(handle_, &size))
+    {
+        ec = make_err(::GetLastError());
+        return 0;
+    }
+    ec = {};
+    return static_cast<std::uint64_t>(size.QuadPart);
+}
+
+system::error_code
+win_file_impl::
+resize(std::uint64_t n)
+{
+    FILE_END_OF_FILE_INFO info;
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(n);
+    if (!::SetFileInformationByHandle(
+            handle_, FileEndOfFileInfo, &info, sizeof(info)))
+        return make_err(::GetLastError());
+    return {};
+}
+
+std::uint64_t
+win_file_impl::
+seek(
+    std::int64_t offset,
+    file_base::seek_basis whence,
+    system::error_code& ec)
+{
+    std::uint64_t n = 0;
+    if (whence == file_base::seek_end)
+    {
+        n = size(ec);
+        if (ec)
+            return pos_;
+    }
+    pos_ = seek_position(pos_, n, offset, whence, ec);
+    return pos_;
+}
+
+bool
+win_file_impl::
+start(
+    win_file_op& op,
+    bool is_write,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::uint64_t offset,
+    std::uint64_t* position,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    // ReadFile and WriteFile take one buffer, see the header
+    capy::mutable_buffer buf;
+    if (param.copy_to(&buf, 1) == 0)
+    {
+        // Nothing to transfer, and no end of file to report
+        *ec = {};
+        *bytes = 0;
+        return true;
+    }
+    auto const n = static_cast<DWORD>(
+        (std::min)(buf.size(), std::size_t(MAXDWORD)));
+
+    op.reset();
+    op.h = h;
+    op.d = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes;
+    op.handle = handle_;
+    op.is_write = is_write;
+    op.append = append_;
+    op.offset = offset;
+    op.position = position;
+
+    // An offset of all ones writes at the end of the file
+    if (is_write && append_)
+    {
+        op.Offset = MAXDWORD;
+        op.OffsetHigh = MAXDWORD;
+    }
+    else
+    {
+        op.Offset = static_cast<DWORD>(offset);
+        op.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    }
+
+    op.impl_ptr = shared_from_this();
+    op.start(token);
+
+    svc_.work_started();
+
+    BOOL result = is_write
+        ? ::WriteFile(handle_, buf.data(), n, nullptr, &op)
+        : ::ReadFile(handle_, buf.data(), n, nullptr, &op);
+
+    if (!result)
+    {
+        DWORD err = ::GetLastError();
+        if (err != ERROR_IO_PENDING)
+        {
+            // ERROR_HANDLE_EOF reports a read past the end
+            svc_.work_finished();
+            op.dwError = err;
+            svc_.post(&op);
+        }
+        return false;
+    }
+
+    // Synchronous completion, see the header
+    svc_.work_finished();
+    if (::InterlockedCompareExchange(&op.ready_, 1, 0) == 0)
+    {
+        op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
+        op.dwError = 0;
+        if (op.complete_inline())
+        {
+            op.advance();
+            op.impl_ptr.reset();
+            return true;
+        }
+        svc_.post(&op);
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+file_service&
+get_win_file_service(
+    capy::execution_context& ctx,
+    win_scheduler& sched)
+{
+    return ctx.make_service<win_file_service>(sched);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IOCP
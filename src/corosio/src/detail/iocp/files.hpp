@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IOCP_FILES_HPP
+#define BOOST_COROSIO_DETAIL_IOCP_FILES_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/file_service.hpp"
+
+/*
+    IOCP File Implementation
+    ========================
+
+    Files are opened with FILE_FLAG_OVERLAPPED and associated with the
+    scheduler's completion port, like sockets. Each read or write is
+    one ReadFile() or WriteFile() whose OVERLAPPED carries the offset;
+    the completion is dispatched through the file service's own
+    completion key.
+
+    ReadFile() and WriteFile() take a single buffer, so an operation
+    transfers into or out of the first non-empty buffer of the
+    sequence only. That is a valid partial transfer, and composed
+    operations such as read() and write() loop over the rest.
+
+    Synchronous Completion
+    ----------------------
+    With FILE_SKIP_COMPLETION_PORT_ON_SUCCESS set, a transfer served
+    from the cache completes without a packet. As for sockets, the
+    initiator races the completion port with a CAS on ready_ and
+    posts the op if it wins.
+
+    Impl Lifetime
+    -------------
+    Each pending op holds a shared_ptr to its impl, and the impl closes
+    the handle in its destructor, so closing a file with I/O in flight
+    cancels the I/O but keeps the handle until the completion arrives.
+*/
+
+namespace boost::corosio::detail {
+
+class win_scheduler;
+
+/** Get or create the IOCP file service for the given context.
+
+    Called by the IOCP scheduler during initialization.
+
+    @param ctx Reference to the owning execution_context.
+    @param sched Reference to the scheduler that owns the port.
+    @return Reference to the file service.
+*/
+file_service&
+get_win_file_service(
+    capy::execution_context& ctx,
+    win_scheduler& sched);
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_IOCP
+
+#endif // BOOST_COROSIO_DETAIL_IOCP_FILES_HPP
@@ -21,6 +21,7 @@
 #include <boost/system/error_code.hpp>
 
 #include "src/detail/make_err.hpp"
+#include "src/detail/probes.hpp"
 #include "src/detail/resume_coro.hpp"
 #include "src/detail/scheduler_op.hpp"
 
@@ -53,7 +54,9 @@ struct overlapped_op
     std::size_t* bytes_out = nullptr;
     DWORD dwError = 0;
     DWORD bytes_transferred = 0;
+    std::size_t bytes_before = 0;  // Earlier parts of a continued transfer
     bool empty_buffer = false;  // True if operation was with empty buffer
+    bool waited = false;        // Went through the port, see "Counters" in sockets.cpp
     std::atomic<bool> cancelled{false};
     std::optional<std::stop_callback<canceller>> stop_cb;
 
@@ -76,15 +79,46 @@ struct overlapped_op
         hEvent = nullptr;
         dwError = 0;
         bytes_transferred = 0;
+        bytes_before = 0;
         empty_buffer = false;
+        waited = false;
         cancelled.store(false, std::memory_order_relaxed);
         ready_ = 0;
     }
 
+    // Consecutive inline completions; after this many the next
+    // synchronous result is posted, so that a stream that is always
+    // ready still yields to the scheduler
+    static constexpr int max_inline_completions = 16;
+    int inline_completions = 0;
+
     void operator()() override
     {
         stop_cb.reset();
+        inline_completions = 0;
+        store_results();
+        resume_coro(d, h);
+    }
+
+    /** Finish a synchronously completed operation without resuming.
 
+        @return `false` if the inline budget is spent, in which case
+            nothing was done and the op must be posted.
+    */
+    bool complete_inline() noexcept
+    {
+        if (++inline_completions > max_inline_completions)
+        {
+            inline_completions = 0;
+            return false;
+        }
+        stop_cb.reset();
+        store_results();
+        return true;
+    }
+
+    void store_results() noexcept
+    {
         if (ec_out)
         {
             if (cancelled.load(std::memory_order_acquire))
@@ -109,9 +143,7 @@ struct overlapped_op
         }
 
         if (bytes_out)
-            *bytes_out = static_cast<std::size_t>(bytes_transferred);
-
-        resume_coro(d, h);
+            *bytes_out = bytes_before + bytes_transferred;
     }
 
     // Returns true if this is a read operation (for EOF detection)
@@ -38,25 +38,34 @@ INT WSAAPI GetAddrInfoExCancel(LPHANDLE lpHandle);
 
     Forward Resolution (GetAddrInfoExW)
     -----------------------------------
-    1. resolve() converts host/service to wide strings (Windows API requirement)
-    2. GetAddrInfoExW() is called with our completion callback
-    3. If it returns WSA_IO_PENDING, completion comes later via callback
-    4. If it returns immediately (0 or error), we post completion manually
-    5. completion() callback stores error, calls work_finished(), posts op
-    6. op_() resumes the coroutine with results or error
+    1. resolve() attaches op_ to the flight for its query, if one is in
+       progress, and is done
+    2. Otherwise it creates a flight, which converts host/service to wide
+       strings (Windows API requirement)
+    3. GetAddrInfoExW() is called with the flight's completion callback
+    4. If it returns WSA_IO_PENDING, completion comes later via callback
+    5. If it returns immediately (0 or error), we finish the flight manually
+    6. finish_flight() converts the results once, gives each attached op
+       a shared copy, calls work_finished() and posts it
+    7. op_() resumes the coroutine with results or error
 
     Reverse Resolution (GetNameInfoW)
     ---------------------------------
-    Unlike GetAddrInfoExW, GetNameInfoW has no async variant. We use a worker
-    thread approach similar to POSIX:
-    1. reverse_resolve() spawns a detached worker thread
-    2. Worker calls GetNameInfoW() (blocking)
-    3. Worker converts wide results to UTF-8 via WideCharToMultiByte
+    Unlike GetAddrInfoExW, GetNameInfoW has no async variant. We use the
+    worker pool design of the POSIX service:
+    1. reverse_resolve() queues reverse_op_ with the service, which starts
+       a worker if more ops are queued than workers are idle, up to
+       max_threads
+    2. A worker takes the op and calls GetNameInfoW() (blocking)
+    3. Worker converts wide results to UTF-8 via WideCharToMultiByte,
+       and stores them in the reverse cache if it is enabled
     4. Worker posts completion to scheduler
     5. op_() resumes the coroutine with results
 
-    Thread tracking (thread_started/thread_finished) ensures safe shutdown
-    by waiting for all worker threads before destroying the service.
+    The op holds a shared_ptr to its impl from submission until its
+    completion has run, so the impl outlives a destroyed resolver.
+    shutdown() joins the workers; flights are tracked separately
+    (thread_finished) and waited for afterwards.
 
     String Conversion
     -----------------
@@ -67,7 +76,8 @@ INT WSAAPI GetAddrInfoExCancel(LPHANDLE lpHandle);
     -------------
     work_started() is called before async operations to keep io_context alive.
     work_finished() is called when the operation completes (in callback for
-    forward resolution, in worker thread for reverse resolution).
+    forward resolution, when the worker or a cancellation posts it for
+    reverse resolution).
 */
 
 namespace boost::corosio::detail {
@@ -171,7 +181,7 @@ convert_results(
     std::string_view host,
     std::string_view service)
 {
-    std::vector<resolver_entry> entries;
+    std::pmr::vector<resolver_entry> entries;
 
     for (auto* p = ai; p != nullptr; p = p->ai_next)
     {
@@ -195,22 +205,40 @@ convert_results(
 } // namespace
 
 //------------------------------------------------------------------------------
-// resolve_op
+// win_resolve_flight
 //------------------------------------------------------------------------------
 
+win_resolve_flight::
+win_resolve_flight(
+    win_resolver_service& svc_,
+    std::string_view host_,
+    std::string_view service_,
+    resolve_flags flags_)
+    : OVERLAPPED{}
+    , svc(svc_)
+    , host(host_)
+    , service(service_)
+    , host_w(to_wide(host_))
+    , service_w(to_wide(service_))
+    , flags(flags_)
+{
+}
+
 void CALLBACK
-resolve_op::
+win_resolve_flight::
 completion(
     DWORD dwError,
     DWORD /*bytes*/,
     OVERLAPPED* ov)
 {
-    auto* op = static_cast<resolve_op*>(ov);
-    op->dwError = dwError;
-    op->impl->svc_.work_finished();
-    op->impl->svc_.post(op);
+    auto* f = static_cast<win_resolve_flight*>(ov);
+    f->svc.finish_flight(f, dwError);
 }
 
+//------------------------------------------------------------------------------
+// resolve_op
+//------------------------------------------------------------------------------
+
 void
 resolve_op::
 operator()()
@@ -227,18 +255,9 @@ operator()()
             *ec_out = {};  // Clear on success
     }
 
-    if (out && !cancelled.load(std::memory_order_acquire) && dwError == 0 && results)
-    {
-        *out = convert_results(results, host, service);
-    }
-
-    if (results)
-    {
-        ::FreeAddrInfoExW(results);
-        results = nullptr;
-    }
-
-    cancel_handle = nullptr;
+    if (out && !cancelled.load(std::memory_order_acquire) && dwError == 0)
+        *out = std::move(stored_results);
+    stored_results = resolver_results{};
 
     resume_coro(d, h);
 }
@@ -248,14 +267,18 @@ resolve_op::
 destroy()
 {
     stop_cb.reset();
+    stored_results = resolver_results{};
+}
 
-    if (results)
+void
+resolve_op::
+do_cancel() noexcept
+{
+    if (impl && impl->svc_.detach(*this))
     {
-        ::FreeAddrInfoExW(results);
-        results = nullptr;
+        impl->svc_.work_finished();
+        impl->svc_.post(this);
     }
-
-    cancel_handle = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -284,6 +307,8 @@ operator()()
             ep, std::move(stored_host), std::move(stored_service));
     }
 
+    // The resumed coroutine may destroy the resolver
+    auto self = std::move(keep_alive);
     resume_coro(d, h);
 }
 
@@ -291,9 +316,86 @@ void
 reverse_resolve_op::
 destroy()
 {
+    auto self = std::move(keep_alive);
     stop_cb.reset();
 }
 
+void
+reverse_resolve_op::
+do_cancel() noexcept
+{
+    // A lookup that has not started completes now
+    if (impl && impl->svc_.withdraw(*this))
+        complete();
+}
+
+void
+reverse_resolve_op::
+run() noexcept
+{
+    // Build sockaddr from endpoint
+    sockaddr_storage ss{};
+    int ss_len;
+
+    if (ep.is_v4())
+    {
+        auto sa = to_sockaddr_in(ep);
+        std::memcpy(&ss, &sa, sizeof(sa));
+        ss_len = sizeof(sockaddr_in);
+    }
+    else
+    {
+        auto sa = to_sockaddr_in6(ep);
+        std::memcpy(&ss, &sa, sizeof(sa));
+        ss_len = sizeof(sockaddr_in6);
+    }
+
+    wchar_t host[NI_MAXHOST];
+    wchar_t service[NI_MAXSERV];
+
+    int result = ::GetNameInfoW(
+        reinterpret_cast<sockaddr*>(&ss), ss_len,
+        host, NI_MAXHOST,
+        service, NI_MAXSERV,
+        flags_to_ni_flags(flags));
+
+    if (!cancelled.load(std::memory_order_acquire))
+    {
+        if (result == 0)
+        {
+            try
+            {
+                stored_host = from_wide(host);
+                stored_service = from_wide(service);
+                gai_error = 0;
+            }
+            catch (std::bad_alloc const&)
+            {
+                gai_error = WSA_NOT_ENOUGH_MEMORY;
+            }
+            if (gai_error == 0)
+                impl->svc_.cache_reverse_result(
+                    ep, flags, stored_host, stored_service);
+        }
+        else
+        {
+            gai_error = result;
+        }
+    }
+
+    complete();
+}
+
+void
+reverse_resolve_op::
+complete() noexcept
+{
+    // Always post so the scheduler can properly drain the op
+    // during shutdown via destroy()
+    impl->svc_.work_finished();
+    impl->svc_.post(this);
+}
+
 //------------------------------------------------------------------------------
 // win_resolver_impl
 //------------------------------------------------------------------------------
@@ -331,47 +433,21 @@ resolve(
     op.ec_out = ec;
     op.out = out;
     op.impl = this;
-    op.host = host;
-    op.service = service;
-    op.host_w = to_wide(host);
-    op.service_w = to_wide(service);
-    op.start(token);
-
-    ADDRINFOEXW hints{};
-    hints.ai_family = AF_UNSPEC;
-    hints.ai_socktype = SOCK_STREAM;
-    hints.ai_flags = flags_to_hints(flags);
+    op.stored_results = resolver_results{};
+    op.flight = nullptr;
 
     // Keep io_context alive while resolution is pending
     svc_.work_started();
 
-    int result = ::GetAddrInfoExW(
-        op.host_w.empty() ? nullptr : op.host_w.c_str(),
-        op.service_w.empty() ? nullptr : op.service_w.c_str(),
-        NS_DNS,
-        nullptr,
-        &hints,
-        &op.results,
-        nullptr,
-        &op,
-        &resolve_op::completion,
-        &op.cancel_handle);
-
-    if (result != WSA_IO_PENDING)
+    try
+    {
+        op.start(token);
+        svc_.submit_resolve(op, host, service, flags);
+    }
+    catch (std::bad_alloc const&)
     {
-        // Completed synchronously - callback won't be invoked
         svc_.work_finished();
-
-        if (result == 0)
-        {
-            // Completed synchronously
-            op.dwError = 0;
-        }
-        else
-        {
-            op.dwError = static_cast<DWORD>(::WSAGetLastError());
-        }
-
+        op.dwError = WSA_NOT_ENOUGH_MEMORY;
         svc_.post(&op);
     }
 }
@@ -396,81 +472,17 @@ reverse_resolve(
     op.impl = this;
     op.ep = ep;
     op.flags = flags;
+    op.stored_host.clear();
+    op.stored_service.clear();
+    op.gai_error = 0;
     op.start(token);
 
     // Keep io_context alive while resolution is pending
     svc_.work_started();
 
-    // Track thread for safe shutdown
-    svc_.thread_started();
-
-    try
-    {
-        // Prevent impl destruction while worker thread is running
-        auto self = this->shared_from_this();
-
-        // GetNameInfoW is synchronous, so we need to use a thread
-        std::thread worker([this, self = std::move(self)]() {
-            // Build sockaddr from endpoint
-            sockaddr_storage ss{};
-            int ss_len;
-
-            if (reverse_op_.ep.is_v4())
-            {
-                auto sa = to_sockaddr_in(reverse_op_.ep);
-                std::memcpy(&ss, &sa, sizeof(sa));
-                ss_len = sizeof(sockaddr_in);
-            }
-            else
-            {
-                auto sa = to_sockaddr_in6(reverse_op_.ep);
-                std::memcpy(&ss, &sa, sizeof(sa));
-                ss_len = sizeof(sockaddr_in6);
-            }
-
-            wchar_t host[NI_MAXHOST];
-            wchar_t service[NI_MAXSERV];
-
-            int result = ::GetNameInfoW(
-                reinterpret_cast<sockaddr*>(&ss), ss_len,
-                host, NI_MAXHOST,
-                service, NI_MAXSERV,
-                flags_to_ni_flags(reverse_op_.flags));
-
-            if (!reverse_op_.cancelled.load(std::memory_order_acquire))
-            {
-                if (result == 0)
-                {
-                    reverse_op_.stored_host = from_wide(host);
-                    reverse_op_.stored_service = from_wide(service);
-                    reverse_op_.gai_error = 0;
-                }
-                else
-                {
-                    reverse_op_.gai_error = result;
-                }
-            }
-
-            // Always post so the scheduler can properly drain the op
-            // during shutdown via destroy().
-            svc_.work_finished();
-            svc_.post(&reverse_op_);
-
-            // Signal thread completion for shutdown synchronization
-            svc_.thread_finished();
-        });
-        worker.detach();
-    }
-    catch (std::system_error const&)
-    {
-        // Thread creation failed - no thread was started
-        svc_.thread_finished();
-
-        // Set error and post completion to avoid hanging the coroutine
-        svc_.work_finished();
-        reverse_op_.gai_error = WSAENOBUFS;  // Map to "not enough memory"
-        svc_.post(&reverse_op_);
-    }
+    // Prevent impl destruction until the completion has run
+    op.keep_alive = shared_from_this();
+    svc_.submit_reverse(op);
 }
 
 void
@@ -478,12 +490,23 @@ win_resolver_impl::
 cancel() noexcept
 {
     op_.request_cancel();
+    op_.do_cancel();
     reverse_op_.request_cancel();
+    reverse_op_.do_cancel();
+}
 
-    if (op_.cancel_handle)
-    {
-        ::GetAddrInfoExCancel(&op_.cancel_handle);
-    }
+bool
+win_resolver_impl::
+reverse_resolve_cached(
+    endpoint const& ep,
+    reverse_flags flags,
+    system::error_code* ec,
+    reverse_resolver_result* out) noexcept
+{
+    if (!svc_.reverse_resolve_cached(ep, flags, out))
+        return false;
+    *ec = {};
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -522,11 +545,12 @@ shutdown()
         }
 
         // Clear the map which releases shared_ptrs
-        // Note: impls may still be alive if worker threads hold references
+        // Note: impls may still be alive if queued ops hold references
         resolver_ptrs_.clear();
     }
 
-    // Wait for all worker threads to finish before service is destroyed
+    // Wait for lookups in progress, then for flights
+    stop_workers();
     {
         std::unique_lock<win_mutex> lock(mutex_);
         cv_.wait(lock, [this] { return active_threads_ == 0; });
@@ -581,26 +605,305 @@ work_finished() noexcept
 
 void
 win_resolver_service::
-thread_started() noexcept
+thread_finished() noexcept
 {
     std::lock_guard<win_mutex> lock(mutex_);
-    ++active_threads_;
+    --active_threads_;
+    cv_.notify_one();
+}
+
+bool
+win_resolver_service::
+is_shutting_down() const noexcept
+{
+    return shutting_down_.load(std::memory_order_acquire);
 }
 
 void
 win_resolver_service::
-thread_finished() noexcept
+submit_resolve(
+    resolve_op& op,
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags)
 {
     std::lock_guard<win_mutex> lock(mutex_);
-    --active_threads_;
-    cv_.notify_one();
+
+    auto it = flights_.find(resolver_query{host, service, flags});
+    if (it != flights_.end())
+    {
+        it->second->waiters.push_back(&op);
+        op.flight = it->second;
+        return;
+    }
+
+    auto f = std::make_unique<win_resolve_flight>(*this, host, service, flags);
+    flights_.emplace(f->query(), f.get());
+    f->waiters.push_back(&op);
+    op.flight = f.get();
+    auto* fp = f.release();
+
+    // Counted so that shutdown waits for the callback
+    ++active_threads_;
+
+    ADDRINFOEXW hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = flags_to_hints(flags);
+
+    // The mutex is recursive, and a callback on another thread waits
+    // for it, so the flight outlives this call
+    int result = ::GetAddrInfoExW(
+        fp->host_w.empty() ? nullptr : fp->host_w.c_str(),
+        fp->service_w.empty() ? nullptr : fp->service_w.c_str(),
+        NS_DNS,
+        nullptr,
+        &hints,
+        &fp->results,
+        nullptr,
+        fp,
+        &win_resolve_flight::completion,
+        &fp->cancel_handle);
+
+    if (result != WSA_IO_PENDING)
+    {
+        // Completed synchronously - callback won't be invoked
+        finish_flight(fp, result == 0
+            ? 0 : static_cast<DWORD>(::WSAGetLastError()));
+    }
 }
 
 bool
 win_resolver_service::
-is_shutting_down() const noexcept
+detach(resolve_op& op) noexcept
 {
-    return shutting_down_.load(std::memory_order_acquire);
+    std::lock_guard<win_mutex> lock(mutex_);
+    auto* f = op.flight;
+    if (!f)
+        return false;
+    f->waiters.remove(&op);
+    op.flight = nullptr;
+
+    // Nobody wants the lookup; its callback still finishes the flight
+    if (f->waiters.empty() && f->cancel_handle)
+        ::GetAddrInfoExCancel(&f->cancel_handle);
+    return true;
+}
+
+void
+win_resolver_service::
+finish_flight(win_resolve_flight* f, DWORD dwError) noexcept
+{
+    resolver_results results;
+    if (dwError == 0 && f->results)
+    {
+        try
+        {
+            results = convert_results(f->results, f->host, f->service);
+        }
+        catch (std::bad_alloc const&)
+        {
+            dwError = WSA_NOT_ENOUGH_MEMORY;
+        }
+    }
+    if (f->results)
+        ::FreeAddrInfoExW(f->results);
+
+    intrusive_list<resolve_waiter> done;
+    {
+        std::lock_guard<win_mutex> lock(mutex_);
+        flights_.erase(f->query());
+        f->cancel_handle = nullptr;
+        while (auto* w = f->waiters.pop_front())
+        {
+            w->flight = nullptr;
+            done.push_back(w);
+        }
+    }
+
+    while (auto* w = done.pop_front())
+    {
+        auto* op = static_cast<resolve_op*>(w);
+        op->dwError = dwError;
+        if (dwError == 0)
+            op->stored_results = results;  // Shares the entries
+        work_finished();
+        post(op);
+    }
+
+    delete f;
+    thread_finished();
+}
+
+void
+win_resolver_service::
+set_cache(resolver_cache_options const& opts)
+{
+    reverse_cache_.configure(opts);
+}
+
+bool
+win_resolver_service::
+reverse_resolve_cached(
+    endpoint const& ep,
+    reverse_flags flags,
+    reverse_resolver_result* out) noexcept
+{
+    if (!reverse_cache_.enabled())
+        return false;
+
+    try
+    {
+        return reverse_cache_.find(ep, flags, out);
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+
+void
+win_resolver_service::
+cache_reverse_result(
+    endpoint const& ep,
+    reverse_flags flags,
+    std::string const& host,
+    std::string const& service) noexcept
+{
+    if (!reverse_cache_.enabled())
+        return;
+
+    try
+    {
+        reverse_cache_.store(ep, flags, host, service);
+    }
+    catch (std::exception const&)
+    {
+        // Not remembered; the next resolve looks it up again
+    }
+}
+
+// Called with work_mutex_ held. Returns false, with the op not
+// queued, if no worker could be started to run it.
+bool
+win_resolver_service::
+enqueue(reverse_resolve_op& op) noexcept
+{
+    queue_.push_back(&op);
+    op.queued = true;
+    ++queued_;
+
+    if (queued_ <= idle_ || workers_.size() >= max_threads)
+    {
+        work_cv_.notify_one();
+        return true;
+    }
+
+    try
+    {
+        workers_.emplace_back([this] { work(); });
+        return true;
+    }
+    catch (std::system_error const&)
+    {
+        // Another worker will get to it eventually
+        if (!workers_.empty())
+        {
+            work_cv_.notify_one();
+            return true;
+        }
+    }
+
+    queue_.remove(&op);
+    op.queued = false;
+    --queued_;
+    return false;
+}
+
+void
+win_resolver_service::
+submit_reverse(reverse_resolve_op& op) noexcept
+{
+    {
+        std::lock_guard<win_mutex> lock(work_mutex_);
+        if (stopped_)
+            op.cancelled.store(true, std::memory_order_release);
+
+        // Cancelled before it was queued; see do_cancel()
+        if (!op.cancelled.load(std::memory_order_acquire))
+        {
+            if (enqueue(op))
+                return;
+            op.gai_error = WSAENOBUFS;  // Map to "not enough memory"
+        }
+    }
+    op.complete();
+}
+
+bool
+win_resolver_service::
+withdraw(reverse_resolve_op& op) noexcept
+{
+    std::lock_guard<win_mutex> lock(work_mutex_);
+    if (!op.queued)
+        return false;
+    queue_.remove(&op);
+    op.queued = false;
+    --queued_;
+    return true;
+}
+
+void
+win_resolver_service::
+stop_workers() noexcept
+{
+    intrusive_list<reverse_resolve_op> abandoned;
+    {
+        std::lock_guard<win_mutex> lock(work_mutex_);
+        stopped_ = true;
+        while (auto* op = queue_.pop_front())
+        {
+            op->queued = false;
+            op->cancelled.store(true, std::memory_order_release);
+            abandoned.push_back(op);
+        }
+        queued_ = 0;
+    }
+    work_cv_.notify_all();
+
+    while (auto* op = abandoned.pop_front())
+        op->complete();
+
+    // No worker is added once stopped_ is set
+    for (auto& t : workers_)
+        t.join();
+    workers_.clear();
+}
+
+void
+win_resolver_service::
+work()
+{
+    std::unique_lock<win_mutex> lock(work_mutex_);
+    for (;;)
+    {
+        while (!stopped_ && queue_.empty())
+        {
+            ++idle_;
+            work_cv_.wait(lock);
+            --idle_;
+        }
+        if (stopped_)
+            return;
+
+        auto* op = queue_.pop_front();
+        op->queued = false;
+        --queued_;
+
+        lock.unlock();
+        op->run();
+        lock.lock();
+    }
 }
 
 } // namespace boost::corosio::detail
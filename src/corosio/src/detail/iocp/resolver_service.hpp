@@ -28,6 +28,7 @@
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/resolver_cache.hpp"
 
 #include "src/detail/iocp/windows.hpp"
 #include "src/detail/iocp/overlapped_op.hpp"
@@ -40,7 +41,9 @@
 #include <condition_variable>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 /*
     Windows IOCP Resolver Service
@@ -54,39 +57,55 @@
     callbacks that integrate with IOCP. This avoids worker threads for
     forward DNS lookups.
 
+    Identical forward resolves (same host, service and flags) that start
+    while a lookup for them is in progress attach to that lookup, a
+    win_resolve_flight, and all complete from its result, so a burst of
+    them costs one GetAddrInfoExW call.
+
     Reverse Resolution (GetNameInfoW)
     ---------------------------------
     Unlike GetAddrInfoExW, GetNameInfoW has no async variant. Reverse
-    resolution spawns a detached worker thread that calls GetNameInfoW
-    and posts the result to the scheduler upon completion.
+    resolves are queued to a pool of worker threads owned by the
+    service, sized as on POSIX: a worker is started when more ops are
+    queued than workers are idle, up to max_threads, and the workers
+    live as long as the service. A worker calls GetNameInfoW and posts
+    the result to the scheduler. With the reverse cache enabled, a
+    remembered address completes without suspending.
 
     Class Hierarchy
     ---------------
     - win_resolver_service (execution_context::service)
         - Owns all win_resolver_impl instances via shared_ptr
         - Coordinates with win_scheduler for work tracking
-        - Tracks active worker threads for safe shutdown
+        - Owns the reverse resolve workers and their queue
+        - Tracks flights in progress for safe shutdown
     - win_resolver_impl (one per resolver object)
         - Contains embedded resolve_op and reverse_resolve_op
         - Inherits from enable_shared_from_this for thread safety
-    - resolve_op (overlapped_op subclass)
-        - OVERLAPPED base enables IOCP integration
+    - win_resolve_flight (heap-allocated, owned by the service)
+        - OVERLAPPED for one GetAddrInfoExW call
         - Static completion() callback invoked by Windows
+    - resolve_op (overlapped_op subclass)
+        - Waits on a flight and receives its converted results
     - reverse_resolve_op (overlapped_op subclass)
-        - Used by worker thread for reverse resolution
+        - Queued to and run by a worker for reverse resolution
 
     Shutdown Synchronization
     ------------------------
-    The service uses condition_variable_any and win_mutex to track active
-    worker threads. During shutdown(), the service waits for all threads
-    to complete before destroying resources. Worker threads always post
-    their completions so the scheduler can properly drain them via destroy().
+    During shutdown(), the service posts every queued reverse op as
+    cancelled, then stops the workers and joins them, which waits for
+    lookups in progress. It then waits, on a condition_variable_any over
+    win_mutex, for the flights in progress. Workers and flights always
+    post their completions so the scheduler can properly drain them via
+    destroy().
 
     Cancellation
     ------------
-    GetAddrInfoExCancel() can cancel in-progress forward resolutions.
-    Reverse resolution checks an atomic cancelled flag after GetNameInfoW
-    returns. The cancel() method sets flags and calls the Windows cancel API.
+    A cancelled forward resolve detaches from its flight and completes at
+    once; GetAddrInfoExCancel() cancels a flight left without resolves.
+    A cancelled reverse resolve still queued is withdrawn and completes
+    at once; one already running checks an atomic cancelled flag after
+    GetNameInfoW returns.
 
     Single-Inflight Constraint
     --------------------------
@@ -100,35 +119,75 @@ namespace boost::corosio::detail {
 
 class win_resolver_service;
 class win_resolver_impl;
+struct win_resolve_flight;
 
 //------------------------------------------------------------------------------
 
+/** Links a forward resolve to the flight it waits on.
+
+    Guarded by the service mutex.
+*/
+struct resolve_waiter : intrusive_list<resolve_waiter>::node
+{
+    win_resolve_flight* flight = nullptr;
+};
+
 /** Resolve operation state. */
-struct resolve_op : overlapped_op
+struct resolve_op : overlapped_op, resolve_waiter
 {
-    ADDRINFOEXW* results = nullptr;
-    HANDLE cancel_handle = nullptr;
     resolver_results* out = nullptr;
+    resolver_results stored_results;
+    win_resolver_impl* impl = nullptr;
+
+    /** Resume the coroutine after resolve completes. */
+    void operator()() override;
+
+    void destroy() override;
+
+    /** Detach from the flight and complete now. */
+    void do_cancel() noexcept override;
+};
+
+/** One GetAddrInfoExW call, shared by identical forward resolves. */
+struct win_resolve_flight : OVERLAPPED
+{
+    win_resolver_service& svc;
     std::string host;
     std::string service;
     std::wstring host_w;
     std::wstring service_w;
-    win_resolver_impl* impl = nullptr;
+    resolve_flags flags;
+    ADDRINFOEXW* results = nullptr;
+    HANDLE cancel_handle = nullptr;
+    intrusive_list<resolve_waiter> waiters;
+
+    win_resolve_flight(
+        win_resolver_service& svc_,
+        std::string_view host_,
+        std::string_view service_,
+        resolve_flags flags_);
+
+    resolver_query
+    query() const noexcept
+    {
+        return {host, service, flags};
+    }
 
     /** Completion callback for GetAddrInfoExW. */
     static void CALLBACK completion(
         DWORD dwError,
         DWORD bytes,
         OVERLAPPED* ov);
-
-    /** Resume the coroutine after resolve completes. */
-    void operator()() override;
-
-    void destroy() override;
 };
 
-/** Reverse resolve operation state. */
-struct reverse_resolve_op : overlapped_op
+/** Reverse resolve operation state.
+
+    The queue links and `queued` are guarded by the service's work
+    mutex.
+*/
+struct reverse_resolve_op
+    : overlapped_op
+    , intrusive_list<reverse_resolve_op>::node
 {
     reverse_resolver_result* result_out = nullptr;
     endpoint ep;
@@ -136,12 +195,25 @@ struct reverse_resolve_op : overlapped_op
     std::string stored_host;
     std::string stored_service;
     int gai_error = 0;
+    bool queued = false;
     win_resolver_impl* impl = nullptr;
 
+    // Keeps the impl alive from submission until the completion runs
+    std::shared_ptr<win_resolver_impl> keep_alive;
+
     /** Resume the coroutine after reverse resolve completes. */
     void operator()() override;
 
     void destroy() override;
+
+    /** Withdraw the op if no worker has taken it, and complete now. */
+    void do_cancel() noexcept override;
+
+    /** Run GetNameInfoW on a worker, then complete. */
+    void run() noexcept;
+
+    /** Post the completion. */
+    void complete() noexcept;
 };
 
 //------------------------------------------------------------------------------
@@ -194,6 +266,7 @@ class win_resolver_impl
 {
     friend class win_resolver_service;
     friend struct resolve_op;
+    friend struct reverse_resolve_op;
 
 public:
     explicit win_resolver_impl(win_resolver_service& svc) noexcept;
@@ -221,6 +294,12 @@ public:
 
     void cancel() noexcept override;
 
+    bool reverse_resolve_cached(
+        endpoint const& ep,
+        reverse_flags flags,
+        system::error_code*,
+        reverse_resolver_result*) noexcept override;
+
     resolve_op op_;
     reverse_resolve_op reverse_op_;
 
@@ -282,24 +361,87 @@ public:
     /** Notify scheduler that I/O work completed. */
     void work_finished() noexcept;
 
-    /** Track worker thread start for safe shutdown. */
-    void thread_started() noexcept;
-
-    /** Track worker thread completion for safe shutdown. */
+    /** Track flight completion for safe shutdown. */
     void thread_finished() noexcept;
 
+    /** Set the options of the DNS cache.
+
+        Only the reverse cache is used; forward lookups share
+        flights instead.
+    */
+    void set_cache(resolver_cache_options const& opts);
+
     /** Check if service is shutting down. */
     bool is_shutting_down() const noexcept;
 
+    /** Attach a resolve to the lookup for its query, starting one if needed. */
+    void submit_resolve(
+        resolve_op& op,
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags);
+
+    /** Detach a resolve from its lookup.
+
+        @return `true` if it was attached, in which case the caller
+            completes it.
+    */
+    bool detach(resolve_op& op) noexcept;
+
+    /** Complete every resolve attached to a finished lookup. */
+    void finish_flight(win_resolve_flight* f, DWORD dwError) noexcept;
+
+    /** Queue a reverse resolve for a worker, or complete it now. */
+    void submit_reverse(reverse_resolve_op& op) noexcept;
+
+    /** Remove a reverse resolve no worker has taken.
+
+        @return `true` if it was queued, in which case the caller
+            completes it.
+    */
+    bool withdraw(reverse_resolve_op& op) noexcept;
+
+    /** Answer a reverse resolve from the cache. */
+    bool reverse_resolve_cached(
+        endpoint const& ep,
+        reverse_flags flags,
+        reverse_resolver_result* out) noexcept;
+
+    /** Remember the answer of a reverse resolve. */
+    void cache_reverse_result(
+        endpoint const& ep,
+        reverse_flags flags,
+        std::string const& host,
+        std::string const& service) noexcept;
+
+    /// The most reverse lookups that run at once.
+    static constexpr std::size_t max_threads = 16;
+
 private:
+    bool enqueue(reverse_resolve_op& op) noexcept;
+    void stop_workers() noexcept;
+    void work();
+
     scheduler& sched_;
     win_mutex mutex_;
     std::condition_variable_any cv_;
     std::atomic<bool> shutting_down_{false};
     std::size_t active_threads_ = 0;
+    reverse_resolver_cache reverse_cache_;
     intrusive_list<win_resolver_impl> resolver_list_;
     std::unordered_map<win_resolver_impl*,
         std::shared_ptr<win_resolver_impl>> resolver_ptrs_;
+    std::unordered_map<resolver_query, win_resolve_flight*,
+        resolver_query_hash, resolver_query_equal> flights_;
+
+    // Guards everything below
+    win_mutex work_mutex_;
+    std::condition_variable_any work_cv_;
+    intrusive_list<reverse_resolve_op> queue_;
+    std::size_t queued_ = 0;
+    std::size_t idle_ = 0;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
 };
 
 } // namespace boost::corosio::detail
@@ -0,0 +1,360 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include "src/detail/iocp/rio.hpp"
+
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+
+#include "src/detail/iocp/overlapped_op.hpp"
+#include "src/detail/iocp/scheduler.hpp"
+#include "src/detail/make_err.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+/*
+    Completion Queue Sizing
+    -----------------------
+    RIO writes a result for every request into the completion queue and
+    fails the queue if it overflows, so the queue must always have room
+    for everything that can still complete. Each open request queue can
+    have one receive and one send outstanding, and requests of sockets
+    already closed keep their slots until their results are dequeued.
+    Before a request queue is created the completion queue is therefore
+    doubled until it holds two slots per request queue plus every
+    request not yet dequeued.
+
+    Notification
+    ------------
+    RIONotify() arms a single completion port packet, delivered once the
+    queue is non-empty. The queue is re-armed right after each dequeue,
+    before the results are dispatched, so that another thread can start
+    on the next batch while this one runs handlers.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+overlapped_op*
+result_op(RIORESULT const& r) noexcept
+{
+    return reinterpret_cast<overlapped_op*>(
+        static_cast<std::uintptr_t>(r.RequestContext));
+}
+
+} // namespace
+
+completion_key::result
+win_rio::notify_key::
+on_completion(
+    win_scheduler& sched,
+    DWORD,
+    DWORD,
+    LPOVERLAPPED)
+{
+    RIORESULT results[max_results];
+    ULONG n = rio.dequeue(results);
+    if (n == 0)
+        return result::continue_loop;
+
+    // Each request holds one unit of work, retired by its scope
+    for (ULONG i = 0; i < n; ++i)
+    {
+        auto* op = result_op(results[i]);
+        win_scheduler::handler_scope g{sched};
+        op->complete(
+            results[i].BytesTransferred,
+            static_cast<DWORD>(results[i].Status));
+        (*op)();
+    }
+    return result::did_work;
+}
+
+void
+win_rio::notify_key::
+destroy(LPOVERLAPPED)
+{
+    RIORESULT results[max_results];
+    ULONG n = rio.dequeue(results);
+    for (ULONG i = 0; i < n; ++i)
+        result_op(results[i])->destroy();
+
+    // The scheduler's drain retired one unit for this packet, which
+    // holds none itself; its results hold one each
+    if (n == 0)
+        rio.sched_.work_started();
+    for (ULONG i = 1; i < n; ++i)
+        rio.sched_.work_finished();
+}
+
+win_rio::
+win_rio(
+    win_scheduler& sched,
+    RIO_EXTENSION_FUNCTION_TABLE const& fn) noexcept
+    : sched_(sched)
+    , fn_(fn)
+    , key_(*this)
+{
+}
+
+std::unique_ptr<win_rio>
+win_rio::
+try_create(
+    win_scheduler& sched,
+    void* iocp)
+{
+    SOCKET sock = ::WSASocketW(
+        AF_INET,
+        SOCK_STREAM,
+        IPPROTO_TCP,
+        nullptr,
+        0,
+        WSA_FLAG_OVERLAPPED | WSA_FLAG_REGISTERED_IO);
+
+    if (sock == INVALID_SOCKET)
+        return nullptr;
+
+    RIO_EXTENSION_FUNCTION_TABLE fn{};
+    fn.cbSize = sizeof(fn);
+    GUID rio_guid = WSAID_MULTIPLE_RIO;
+    DWORD bytes = 0;
+    int r = ::WSAIoctl(
+        sock,
+        SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER,
+        &rio_guid,
+        sizeof(rio_guid),
+        &fn,
+        sizeof(fn),
+        &bytes,
+        nullptr,
+        nullptr);
+    ::closesocket(sock);
+
+    if (r != 0)
+        return nullptr;
+
+    auto p = std::unique_ptr<win_rio>(new win_rio(sched, fn));
+
+    RIO_NOTIFICATION_COMPLETION nc{};
+    nc.Type = RIO_IOCP_COMPLETION;
+    nc.Iocp.IocpHandle = static_cast<HANDLE>(iocp);
+    nc.Iocp.CompletionKey = static_cast<completion_key*>(&p->key_);
+    nc.Iocp.Overlapped = &p->notify_overlapped_;
+
+    p->cq_ = fn.RIOCreateCompletionQueue(initial_cq_size, &nc);
+    if (p->cq_ == RIO_INVALID_CQ)
+        return nullptr;
+    p->cq_size_ = initial_cq_size;
+
+    if (fn.RIONotify(p->cq_) != ERROR_SUCCESS)
+        return nullptr;
+
+    return p;
+}
+
+win_rio::
+~win_rio()
+{
+    clear_buffers();
+    if (cq_ != RIO_INVALID_CQ)
+        fn_.RIOCloseCompletionQueue(cq_);
+}
+
+RIO_RQ
+win_rio::
+create_request_queue(SOCKET s)
+{
+    std::lock_guard<win_mutex> lock(cq_mutex_);
+
+    // See "Completion Queue Sizing"
+    DWORD needed = 2 * (rq_count_ + 1) +
+        static_cast<DWORD>(::InterlockedExchangeAdd(&inflight_, 0));
+    if (needed > cq_size_)
+    {
+        DWORD size = cq_size_;
+        while (size < needed)
+            size *= 2;
+        if (size > RIO_MAX_CQ_SIZE ||
+            !fn_.RIOResizeCompletionQueue(cq_, size))
+        {
+            ::WSASetLastError(WSAENOBUFS);
+            return RIO_INVALID_RQ;
+        }
+        cq_size_ = size;
+    }
+
+    RIO_RQ rq = fn_.RIOCreateRequestQueue(
+        s, 1, 1, 1, 1, cq_, cq_, nullptr);
+    if (rq != RIO_INVALID_RQ)
+        ++rq_count_;
+    return rq;
+}
+
+void
+win_rio::
+release_request_queue() noexcept
+{
+    std::lock_guard<win_mutex> lock(cq_mutex_);
+    --rq_count_;
+}
+
+DWORD
+win_rio::
+receive(
+    RIO_RQ rq,
+    RIO_BUF* buf,
+    overlapped_op* op) noexcept
+{
+    ::InterlockedIncrement(&inflight_);
+    if (fn_.RIOReceive(rq, buf, 1, 0, op))
+        return 0;
+    ::InterlockedDecrement(&inflight_);
+    return static_cast<DWORD>(::WSAGetLastError());
+}
+
+DWORD
+win_rio::
+send(
+    RIO_RQ rq,
+    RIO_BUF* buf,
+    overlapped_op* op) noexcept
+{
+    ::InterlockedIncrement(&inflight_);
+    if (fn_.RIOSend(rq, buf, 1, 0, op))
+        return 0;
+    ::InterlockedDecrement(&inflight_);
+    return static_cast<DWORD>(::WSAGetLastError());
+}
+
+ULONG
+win_rio::
+dequeue(RIORESULT* results)
+{
+    ULONG n;
+    {
+        std::lock_guard<win_mutex> lock(cq_mutex_);
+        n = fn_.RIODequeueCompletion(cq_, results, max_results);
+        fn_.RIONotify(cq_);
+    }
+
+    if (n == RIO_CORRUPT_CQ)
+        detail::throw_system_error(make_err(WSAEINVAL), "RIODequeueCompletion");
+
+    ::InterlockedExchangeAdd(&inflight_, -static_cast<long>(n));
+    return n;
+}
+
+void
+win_rio::
+register_buffers(
+    capy::mutable_buffer const* bufs,
+    std::size_t n)
+{
+    std::lock_guard<win_mutex> lock(buf_mutex_);
+    clear_buffers();
+
+    std::vector<registered_buffer> regs;
+    regs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        DWORD err = 0;
+        RIO_BUFFERID id = RIO_INVALID_BUFFERID;
+        if (bufs[i].size() > MAXDWORD)
+            err = WSAEINVAL;
+        else
+        {
+            id = fn_.RIORegisterBuffer(
+                static_cast<PCHAR>(bufs[i].data()),
+                static_cast<DWORD>(bufs[i].size()));
+            if (id == RIO_INVALID_BUFFERID)
+                err = static_cast<DWORD>(::WSAGetLastError());
+        }
+
+        if (err != 0)
+        {
+            for (auto const& b : regs)
+                fn_.RIODeregisterBuffer(b.id);
+            detail::throw_system_error(make_err(err), "RIORegisterBuffer");
+        }
+
+        auto begin = reinterpret_cast<std::uintptr_t>(bufs[i].data());
+        regs.push_back({begin, begin + bufs[i].size(), id});
+    }
+
+    std::sort(regs.begin(), regs.end(),
+        [](registered_buffer const& a, registered_buffer const& b)
+        {
+            return a.begin < b.begin;
+        });
+    buffers_ = std::move(regs);
+    ::InterlockedExchange(&has_buffers_, buffers_.empty() ? 0 : 1);
+}
+
+void
+win_rio::
+unregister_buffers() noexcept
+{
+    std::lock_guard<win_mutex> lock(buf_mutex_);
+    clear_buffers();
+}
+
+void
+win_rio::
+clear_buffers() noexcept
+{
+    ::InterlockedExchange(&has_buffers_, 0);
+    for (auto const& b : buffers_)
+        fn_.RIODeregisterBuffer(b.id);
+    buffers_.clear();
+}
+
+bool
+win_rio::
+find_buffer(
+    void const* p,
+    std::size_t n,
+    RIO_BUF& out) const noexcept
+{
+    if (::InterlockedExchangeAdd(&has_buffers_, 0) == 0)
+        return false;
+
+    auto begin = reinterpret_cast<std::uintptr_t>(p);
+    std::lock_guard<win_mutex> lock(buf_mutex_);
+
+    // Last buffer starting at or before p
+    auto it = std::upper_bound(buffers_.begin(), buffers_.end(),
+        begin,
+        [](std::uintptr_t v, registered_buffer const& b)
+        {
+            return v < b.begin;
+        });
+    if (it == buffers_.begin())
+        return false;
+    --it;
+    if (begin >= it->end || n > it->end - begin)
+        return false;
+
+    out.BufferId = it->id;
+    out.Offset = static_cast<ULONG>(begin - it->begin);
+    out.Length = static_cast<ULONG>(n);
+    return true;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_DETAIL_HAS_RIO
+
+#endif // BOOST_COROSIO_HAS_IOCP
@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_IOCP_RIO_HPP
+#define BOOST_COROSIO_DETAIL_IOCP_RIO_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include "src/detail/iocp/windows.hpp"
+#include "src/detail/iocp/completion_key.hpp"
+#include "src/detail/iocp/mutex.hpp"
+
+#include <MSWSock.h>
+
+// MSWSock.h declares Registered I/O from Windows 8 on
+#if _WIN32_WINNT >= 0x0602
+#define BOOST_COROSIO_DETAIL_HAS_RIO 1
+#else
+#define BOOST_COROSIO_DETAIL_HAS_RIO 0
+#endif
+
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace boost::corosio::detail {
+
+class win_scheduler;
+struct overlapped_op;
+
+/** Registered I/O (RIO) support for win_sockets.
+
+    Owns the RIO function table, a single completion queue shared by
+    every socket of the context, and the context's registered buffers.
+    The completion queue notifies through the scheduler's completion
+    port: when a notification packet is dequeued, the results are
+    taken from the queue and each operation is completed in its own
+    handler scope, so a single kernel transition can finish many
+    reads and writes.
+
+    A request queue is created for each socket opened with registered
+    I/O, with room for one outstanding receive and one outstanding
+    send, matching the one read and one write a socket allows.
+
+    @par Thread Safety
+    All public member functions are thread-safe. RIO queues are not,
+    so the completion queue is guarded here and each request queue by
+    its socket.
+*/
+class win_rio
+{
+public:
+    /** Create the RIO state, or return nullptr when RIO is unavailable.
+
+        @param sched The scheduler whose completion port is notified.
+        @param iocp The completion port handle.
+    */
+    static std::unique_ptr<win_rio> try_create(
+        win_scheduler& sched, void* iocp);
+
+    ~win_rio();
+
+    win_rio(win_rio const&) = delete;
+    win_rio& operator=(win_rio const&) = delete;
+
+    /** Create the request queue of a socket.
+
+        Grows the completion queue first if it could overflow.
+
+        @param s A socket created with WSA_FLAG_REGISTERED_IO.
+        @return The queue, or RIO_INVALID_RQ on failure.
+    */
+    RIO_RQ create_request_queue(SOCKET s);
+
+    /** Account for a request queue whose socket was closed. */
+    void release_request_queue() noexcept;
+
+    /** Queue a receive into a registered buffer.
+
+        @return 0, or the Winsock error if the request was refused.
+    */
+    DWORD receive(RIO_RQ rq, RIO_BUF* buf, overlapped_op* op) noexcept;
+
+    /** Queue a send from a registered buffer.
+
+        @return 0, or the Winsock error if the request was refused.
+    */
+    DWORD send(RIO_RQ rq, RIO_BUF* buf, overlapped_op* op) noexcept;
+
+    /** Register buffers for RIO reads and writes.
+
+        Replaces any earlier registration.
+
+        @throws system::system_error if a buffer is rejected.
+    */
+    void register_buffers(capy::mutable_buffer const* bufs, std::size_t n);
+
+    /// Drop the buffers passed to @ref register_buffers.
+    void unregister_buffers() noexcept;
+
+    /** Describe a range inside a registered buffer.
+
+        @return `true` and fill `out` if a single registered buffer
+            contains all of `[p, p + n)`.
+    */
+    bool find_buffer(void const* p, std::size_t n, RIO_BUF& out) const noexcept;
+
+private:
+    struct notify_key final : completion_key
+    {
+        win_rio& rio;
+
+        explicit notify_key(win_rio& r) noexcept : rio(r) {}
+
+        result on_completion(
+            win_scheduler& sched,
+            DWORD bytes,
+            DWORD dwError,
+            LPOVERLAPPED overlapped) override;
+
+        void destroy(LPOVERLAPPED overlapped) override;
+    };
+
+    struct registered_buffer
+    {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        RIO_BUFFERID id;
+    };
+
+    // Results taken from the completion queue per notification
+    static constexpr ULONG max_results = 64;
+
+    // Initial completion queue size, doubled as sockets are added
+    static constexpr DWORD initial_cq_size = 256;
+
+    win_rio(win_scheduler& sched, RIO_EXTENSION_FUNCTION_TABLE const& fn) noexcept;
+
+    ULONG dequeue(RIORESULT* results);
+    void clear_buffers() noexcept;
+
+    win_scheduler& sched_;
+    RIO_EXTENSION_FUNCTION_TABLE fn_;
+    notify_key key_;
+    OVERLAPPED notify_overlapped_{};        // carried by notification packets
+
+    // Completion queue, guarded by cq_mutex_
+    win_mutex cq_mutex_;
+    RIO_CQ cq_ = RIO_INVALID_CQ;
+    DWORD cq_size_ = 0;
+    DWORD rq_count_ = 0;                    // open request queues
+    long inflight_ = 0;                     // requests not yet dequeued
+
+    // Registered buffers, guarded by buf_mutex_
+    mutable win_mutex buf_mutex_;
+    std::vector<registered_buffer> buffers_;    // sorted by begin
+    mutable long has_buffers_ = 0;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_DETAIL_HAS_RIO
+
+#endif // BOOST_COROSIO_HAS_IOCP
+
+#endif // BOOST_COROSIO_DETAIL_IOCP_RIO_HPP
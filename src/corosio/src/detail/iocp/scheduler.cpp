@@ -15,14 +15,21 @@
 #include "src/detail/iocp/overlapped_op.hpp"
 #include "src/detail/iocp/timers.hpp"
 #include "src/detail/timer_service.hpp"
+#include "src/detail/iocp/files.hpp"
 #include "src/detail/iocp/resolver_service.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/op_lanes.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/thread_stats.hpp"
 
 #include <boost/corosio/detail/except.hpp>
 #include <boost/corosio/detail/thread_local_ptr.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
+#include <memory>
+#include <span>
 
 /*
     ARCHITECTURE NOTE: Polymorphic Completion Keys
@@ -43,42 +50,166 @@
     Use get_overlapped_op(scheduler_op*) to safely check if a scheduler_op is an
     overlapped_op (returns nullptr if not). All code that processes op_queue
     must be mindful of this mixed content.
+
+    WORK COUNTING: Posts made by a completion handler running inside run()
+    are counted and staged in the thread's win_thread_context. When the
+    handler returns, handler_scope adds the staged count less one for the
+    handler itself to outstanding_work_ and only then queues the staged
+    ops with PQCS, so the count never undershoots the real work. A handler
+    that posts a single continuation costs no interlocked update.
+
+    BATCHED DEQUEUE: run() and poll() dequeue up to completion_batch_
+    entries per GetQueuedCompletionStatusEx call into the thread's frame
+    and dispatch them one at a time, so do_one() only enters the kernel
+    once the batch is used up. Each entry goes through its key exactly as
+    a GQCS result would: GQCSEx reports no per-entry error, so the Win32
+    error is recovered from the NTSTATUS the kernel left in the entry's
+    OVERLAPPED. Entries still held when the loop stops or unwinds, or
+    when a handler enters a nested run(), are reposted to the port so
+    that another thread, or the same one later, can dispatch them.
+
+    STATISTICS: Every thread waits in the port, so the reactor counters
+    live with the handler and blocked-time counts in each run() frame's
+    thread_stats (see thread_stats.hpp) and are summed on read. Only
+    PQCS posts, made from any thread, share a counter. When handlers
+    are timed, do_one() times each dispatch through a key.
+
+    BATCHED POSTS: The port has no call that queues several packets,
+    and each waiting thread is woken by the packet it dequeues, so
+    post_batch() still makes one PQCS per handler. What it saves is
+    the per-post work count update, made once for the whole batch.
+
+    PRIORITY LANES: The completion port is strictly FIFO, so handlers
+    posted with high priority skip it. They wait in priority_ops_ under
+    dispatch_mutex_, and a keyless packet wakes a thread; do_one() runs
+    them before taking the next entry, at most op_lanes::burst in a row
+    while entries are waiting. Completions of sockets marked high
+    priority come from the kernel and cannot skip the port, but once a
+    socket has asked for it each dequeued batch is reordered so their
+    entries run first. With a batch size of one that is no reordering.
 */
 
 namespace boost::corosio::detail {
 
+struct win_thread_context
+{
+    win_scheduler const* key;
+    win_thread_context* next;
+    thread_stats* stats;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
+
+    // Completions dequeued but not yet dispatched, see do_one
+    OVERLAPPED_ENTRY* entries = nullptr;
+    ULONG entry_capacity = 0;
+    ULONG entry_count = 0;
+    ULONG next_entry = 0;
+    OVERLAPPED_ENTRY single_entry{};
+    std::unique_ptr<OVERLAPPED_ENTRY[]> entry_storage;
+
+    // High priority handlers run in a row, see do_one
+    unsigned priority_run = 0;
+};
+
 namespace {
 
 // Max timeout for GQCS to allow periodic re-checking of conditions
 constexpr unsigned long max_gqcs_timeout = 500;
 
-struct scheduler_context
+// used for running_in_this_thread()
+corosio::detail::thread_local_ptr<win_thread_context> context_stack;
+
+// Returns the innermost run() frame of `sched` on this thread
+win_thread_context*
+find_context(win_scheduler const* sched) noexcept
 {
-    win_scheduler const* key;
-    scheduler_context* next;
-};
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
 
-// used for running_in_this_thread()
-corosio::detail::thread_local_ptr<scheduler_context> context_stack;
+} // namespace
 
-struct thread_context_guard
+/** Marks the calling thread as running inside the scheduler. */
+class win_scheduler::run_scope
 {
-    scheduler_context frame_;
+    thread_stats stats_;
+    win_thread_context frame_;
 
-    explicit thread_context_guard(
-        win_scheduler const* ctx) noexcept
-        : frame_{ctx, context_stack.get()}
+public:
+    run_scope(win_scheduler const* sched, ULONG batch)
+        : frame_{sched, context_stack.get(), &stats_}
     {
+        if (batch > 1)
+        {
+            frame_.entry_storage.reset(new OVERLAPPED_ENTRY[batch]);
+            frame_.entries = frame_.entry_storage.get();
+            frame_.entry_capacity = batch;
+        }
+        else
+        {
+            frame_.entries = &frame_.single_entry;
+            frame_.entry_capacity = 1;
+        }
+
+        // A handler running a nested loop must not hide its posts,
+        // nor completions its own loop has dequeued, and keeps
+        // counting into the outer frame
+        if (auto* outer = find_context(sched))
+        {
+            if (outer->in_handler)
+            {
+                sched->publish_private(*outer, 0);
+                sched->repost_entries(*outer);
+            }
+            frame_.stats = outer->stats;
+        }
+        else
+        {
+            sched->stats_registry_.attach(stats_);
+        }
+
         context_stack.set(&frame_);
     }
 
-    ~thread_context_guard() noexcept
+    ~run_scope() noexcept
     {
+        frame_.key->repost_entries(frame_);
         context_stack.set(frame_.next);
+        if (frame_.stats == &stats_)
+            frame_.key->stats_registry_.detach(stats_);
     }
+
+    win_thread_context& frame() noexcept { return frame_; }
+
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
 };
 
-} // namespace
+win_scheduler::handler_scope::
+handler_scope(win_scheduler& sched) noexcept
+    : sched_(sched)
+    , frame_(find_context(&sched))
+{
+    if (frame_)
+        frame_->in_handler = true;
+}
+
+win_scheduler::handler_scope::
+~handler_scope()
+{
+    if (frame_)
+    {
+        frame_->in_handler = false;
+        if (sched_.publish_private(*frame_, -1) >= 0)
+            return;
+    }
+    sched_.on_work_finished();
+}
 
 completion_key::result
 win_scheduler::handler_key::
@@ -88,13 +219,7 @@ on_completion(
     DWORD,
     LPOVERLAPPED overlapped)
 {
-    struct work_guard
-    {
-        win_scheduler* self;
-        ~work_guard() { self->on_work_finished(); }
-    };
-
-    work_guard g{&sched};
+    handler_scope g{sched};
     (*reinterpret_cast<scheduler_op*>(overlapped))();
     return result::did_work;
 }
@@ -127,8 +252,11 @@ on_completion(
 win_scheduler::
 win_scheduler(
     capy::execution_context& ctx,
-    int concurrency_hint)
-    : iocp_(nullptr)
+    int concurrency_hint,
+    iocp_options const& opts)
+    : opts_(opts)
+    , iocp_(nullptr)
+    , completion_batch_(opts.completion_batch > 1 ? opts.completion_batch : 1)
     , outstanding_work_(0)
     , stopped_(0)
     , shutdown_(0)
@@ -145,14 +273,23 @@ win_scheduler(
     if (iocp_ == nullptr)
         detail::throw_system_error(make_err(::GetLastError()));
 
+    // Maps the NTSTATUS of dequeued entries, see entry_error()
+    if (HMODULE ntdll = ::GetModuleHandleW(L"ntdll.dll"))
+        nt_status_to_dos_error_ = reinterpret_cast<nt_status_to_dos_error_fn>(
+            ::GetProcAddress(ntdll, "RtlNtStatusToDosError"));
+
     // Create timer wakeup mechanism (tries NT native, falls back to thread)
-    timers_ = make_win_timers(iocp_, &dispatch_required_);
+    timers_ = make_win_timers(
+        iocp_, &dispatch_required_, opts_.high_resolution_timers);
 
     // Connect timer service to scheduler
-    set_timer_service(&get_timer_service(ctx, *this));
+    set_timer_service(&get_timer_service(ctx, *this, opts_.timers));
 
     // Initialize resolver service
     ctx.make_service<win_resolver_service>(*this);
+
+    // Initialize file service
+    get_win_file_service(ctx, *this);
 }
 
 win_scheduler::
@@ -180,6 +317,8 @@ shutdown()
         {
             std::lock_guard<win_mutex> lock(dispatch_mutex_);
             ops.splice(completed_ops_);  // splice all from completed_ops_
+            ops.splice(priority_ops_);
+            priority_pending_.store(0, std::memory_order_relaxed);
         }
 
         while (auto* h = ops.pop())
@@ -201,48 +340,111 @@ shutdown()
     }
 }
 
-void
-win_scheduler::
-post(capy::coro h) const
+namespace {
+
+// Resumes a posted coroutine
+struct post_handler final
+    : scheduler_op
+    , recycling_op<post_handler>
 {
-    struct post_handler final
-        : scheduler_op
+    capy::coro h_;
+    long ready_ = 1;  // always ready for immediate dispatch
+
+    explicit
+    post_handler(capy::coro h)
+        : h_(h)
     {
-        capy::coro h_;
-        long ready_ = 1;  // always ready for immediate dispatch
+    }
 
-        explicit
-        post_handler(capy::coro h)
-            : h_(h)
-        {
-        }
+    ~post_handler() = default;
 
-        ~post_handler() = default;
+    void operator()() override
+    {
+        auto h = h_;
+        delete this;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        h.resume();
+    }
 
-        void operator()() override
-        {
-            auto h = h_;
-            delete this;
-            std::atomic_thread_fence(std::memory_order_acquire);
-            h.resume();
-        }
+    void destroy() override
+    {
+        delete this;
+    }
 
-        void destroy() override
-        {
-            delete this;
-        }
-    };
+    void const* target() const noexcept override
+    {
+        return h_.address();
+    }
+};
+
+// Makes a post_handler per coroutine; none leak if one throws
+void
+make_post_handlers(std::span<capy::coro const> hs, op_queue& ops)
+{
+    try
+    {
+        for (auto h : hs)
+            ops.push(new post_handler(h));
+    }
+    catch (...)
+    {
+        while (auto* op = ops.pop())
+            op->destroy();
+        throw;
+    }
+}
+
+} // namespace
 
+void
+win_scheduler::
+post(capy::coro h) const
+{
+    post(static_cast<scheduler_op*>(new post_handler(h)));
+}
+
+void
+win_scheduler::
+post_high_priority(capy::coro h) const
+{
     auto* ph = new post_handler(h);
-    ::InterlockedIncrement(&outstanding_work_);
+    ph->high_priority = true;
+    post(static_cast<scheduler_op*>(ph));
+}
 
-    if (!::PostQueuedCompletionStatus(iocp_, 0,
-            reinterpret_cast<ULONG_PTR>(&handler_key_),
-            reinterpret_cast<LPOVERLAPPED>(ph)))
+void
+win_scheduler::
+post_batch(std::span<capy::coro const> hs) const
+{
+    op_queue ops;
+    make_post_handlers(hs, ops);
+    auto const n = static_cast<long>(ops.size());
+    if (n == 0)
+        return;
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
     {
+        c->private_work += n;
+        c->private_ops.splice(ops);
+        return;
+    }
+
+    // See BATCHED POSTS
+    ::InterlockedExchangeAdd(&outstanding_work_, n);
+    wakeup_writes_.fetch_add(ops.size(), std::memory_order_relaxed);
+
+    while (auto* h = ops.pop())
+    {
+        if (::PostQueuedCompletionStatus(iocp_, 0,
+                reinterpret_cast<ULONG_PTR>(&handler_key_),
+                reinterpret_cast<LPOVERLAPPED>(h)))
+            continue;
+
         // PQCS can fail if non-paged pool exhausted; queue for later
         std::lock_guard<win_mutex> lock(dispatch_mutex_);
-        completed_ops_.push(ph);
+        completed_ops_.push(h);
+        completed_ops_.splice(ops);
         ::InterlockedExchange(&dispatch_required_, 1);
     }
 }
@@ -255,7 +457,33 @@ post(scheduler_op* h) const
     if (auto* op = get_overlapped_op(h))
         op->ready_ = 1;
 
+    // See PRIORITY LANES
+    if (h->high_priority)
+    {
+        ::InterlockedIncrement(&outstanding_work_);
+        {
+            std::lock_guard<win_mutex> lock(dispatch_mutex_);
+            priority_ops_.push(h);
+            priority_pending_.fetch_add(1, std::memory_order_release);
+        }
+        wakeup_writes_.fetch_add(1, std::memory_order_relaxed);
+
+        // A keyless packet only wakes a thread; if the port is out of
+        // memory a waiter finds the handler at its next timeout
+        ::PostQueuedCompletionStatus(iocp_, 0, 0, nullptr);
+        return;
+    }
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        c->private_ops.push(h);
+        return;
+    }
+
     ::InterlockedIncrement(&outstanding_work_);
+    wakeup_writes_.fetch_add(1, std::memory_order_relaxed);
 
     if (!::PostQueuedCompletionStatus(iocp_, 0,
             reinterpret_cast<ULONG_PTR>(&handler_key_),
@@ -338,6 +566,13 @@ stopped() const noexcept
     return ::InterlockedExchangeAdd(&stopped_, 0) != 0;
 }
 
+long
+win_scheduler::
+outstanding_work() const noexcept
+{
+    return ::InterlockedExchangeAdd(&outstanding_work_, 0);
+}
+
 void
 win_scheduler::
 restart()
@@ -355,10 +590,10 @@ run()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this, completion_batch_);
 
     std::size_t n = 0;
-    while (do_one(INFINITE))
+    while (do_one(scope.frame(), INFINITE))
         if (n != (std::numeric_limits<std::size_t>::max)())
             ++n;
     return n;
@@ -374,8 +609,8 @@ run_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
-    return do_one(INFINITE);
+    run_scope scope(this, 1);
+    return do_one(scope.frame(), INFINITE);
 }
 
 std::size_t
@@ -388,10 +623,10 @@ wait_one(long usec)
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this, 1);
     unsigned long timeout_ms = usec < 0 ? INFINITE :
         static_cast<unsigned long>((usec + 999) / 1000);
-    return do_one(timeout_ms);
+    return do_one(scope.frame(), timeout_ms);
 }
 
 std::size_t
@@ -404,10 +639,10 @@ poll()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this, completion_batch_);
 
     std::size_t n = 0;
-    while (do_one(0))
+    while (do_one(scope.frame(), 0))
         if (n != (std::numeric_limits<std::size_t>::max)())
             ++n;
     return n;
@@ -423,8 +658,76 @@ poll_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
-    return do_one(0);
+    run_scope scope(this, 1);
+    return do_one(scope.frame(), 0);
+}
+
+void
+win_scheduler::
+collect_stats(scheduler_stats& st) const noexcept
+{
+    stats_registry_.collect(st);
+    st.queue_depth_peak = (std::max)(st.queue_depth_peak,
+        queue_peak_.load(std::memory_order_relaxed));
+    st.wakeup_writes += wakeup_writes_.load(std::memory_order_relaxed);
+}
+
+bool
+win_scheduler::
+time_handlers(std::chrono::nanoseconds threshold) noexcept
+{
+    stats_registry_.set_threshold(threshold);
+    return true;
+}
+
+void
+win_scheduler::
+sample_handlers(std::vector<handler_sample>& out) const
+{
+    stats_registry_.sample(out);
+}
+
+socket_counter_ref
+win_scheduler::
+socket_counts() const noexcept
+{
+    auto* c = find_context(this);
+    return stats_registry_.sockets(c ? c->stats : nullptr);
+}
+
+long
+win_scheduler::
+publish_private(
+    win_thread_context& frame,
+    long adjust) const noexcept
+{
+    long n = frame.private_work + adjust;
+    frame.private_work = 0;
+
+    // Count before queueing so the total never undershoots
+    if (n > 0)
+        ::InterlockedExchangeAdd(&outstanding_work_, n);
+
+    if (!frame.private_ops.empty())
+        wakeup_writes_.fetch_add(
+            frame.private_ops.size(), std::memory_order_relaxed);
+
+    while (auto* h = frame.private_ops.pop())
+    {
+        if (::PostQueuedCompletionStatus(iocp_, 0,
+                reinterpret_cast<ULONG_PTR>(&handler_key_),
+                reinterpret_cast<LPOVERLAPPED>(h)))
+            continue;
+
+        // PQCS can fail if non-paged pool exhausted; queue for later
+        std::lock_guard<win_mutex> lock(dispatch_mutex_);
+        completed_ops_.push(h);
+        completed_ops_.splice(frame.private_ops);
+        ::InterlockedExchange(&dispatch_required_, 1);
+    }
+
+    // Negative only for the finished handler's own unit
+    return n;
 }
 
 void
@@ -452,9 +755,56 @@ post_deferred_completions(
     }
 }
 
+DWORD
+win_scheduler::
+entry_error(OVERLAPPED_ENTRY const& e) const noexcept
+{
+    // Posted handlers and signals carry no status, and a posted
+    // handler's OVERLAPPED* is really a scheduler_op*
+    if (!e.lpOverlapped ||
+        e.lpCompletionKey == reinterpret_cast<ULONG_PTR>(&handler_key_))
+        return 0;
+
+    // The kernel stores the I/O status in OVERLAPPED::Internal
+    auto status = static_cast<LONG>(e.lpOverlapped->Internal);
+    if (status >= 0)
+        return 0;
+    if (!nt_status_to_dos_error_)
+        return ERROR_GEN_FAILURE;
+    return nt_status_to_dos_error_(status);
+}
+
+void
+win_scheduler::
+repost_entries(win_thread_context& frame) const noexcept
+{
+    while (frame.next_entry < frame.entry_count)
+    {
+        auto& e = frame.entries[frame.next_entry++];
+        if (::PostQueuedCompletionStatus(iocp_,
+                e.dwNumberOfBytesTransferred,
+                e.lpCompletionKey,
+                e.lpOverlapped))
+            continue;
+
+        // PQCS can fail if non-paged pool exhausted; only posted
+        // handlers have a fallback queue
+        if (e.lpCompletionKey == reinterpret_cast<ULONG_PTR>(&handler_key_))
+        {
+            std::lock_guard<win_mutex> lock(dispatch_mutex_);
+            completed_ops_.push(reinterpret_cast<scheduler_op*>(e.lpOverlapped));
+            ::InterlockedExchange(&dispatch_required_, 1);
+        }
+    }
+    frame.entry_count = 0;
+    frame.next_entry = 0;
+}
+
 std::size_t
 win_scheduler::
-do_one(unsigned long timeout_ms)
+do_one(
+    win_thread_context& frame,
+    unsigned long timeout_ms)
 {
     for (;;)
     {
@@ -469,36 +819,144 @@ do_one(unsigned long timeout_ms)
             update_timeout();
         }
 
-        DWORD bytes = 0;
-        ULONG_PTR key = 0;
-        LPOVERLAPPED overlapped = nullptr;
-        ::SetLastError(0);
+        if (frame.priority_run < op_lanes::burst &&
+            priority_pending_.load(std::memory_order_acquire) != 0)
+        {
+            if (run_priority(frame))
+                return 1;
+        }
 
-        BOOL result = ::GetQueuedCompletionStatus(
-            iocp_, &bytes, &key, &overlapped,
-            timeout_ms < max_gqcs_timeout ? timeout_ms : max_gqcs_timeout);
-        DWORD dwError = ::GetLastError();
+        bool const priority_waiting =
+            priority_pending_.load(std::memory_order_acquire) != 0;
 
-        if (overlapped || (result && key != 0))
+        if (frame.next_entry == frame.entry_count)
         {
-            auto* target = reinterpret_cast<completion_key*>(key);
-            DWORD dwErr = result ? 0 : dwError;
-            auto r = target->on_completion(*this, bytes, dwErr, overlapped);
+            // Entries the burst held back go first; otherwise peek
+            unsigned long const wait_ms = priority_waiting ? 0 : timeout_ms;
 
-            if (r == completion_key::result::did_work)
-                return 1;
-            if (r == completion_key::result::stop_loop)
-                return 0;
+            auto& ts = *frame.stats;
+            bump(ts.polls);
+            if (wait_ms != 0)
+            {
+                bump(ts.blocking_polls);
+                bump(ts.parks);
+            }
+
+            ULONG removed = 0;
+            BOOL result;
+            {
+                blocked_scope blocked(wait_ms != 0 ? &ts : nullptr);
+                BOOST_COROSIO_PROBE1(reactor_wait_enter,
+                    wait_ms == INFINITE ? -1 : static_cast<long>(wait_ms));
+                result = ::GetQueuedCompletionStatusEx(
+                    iocp_, frame.entries, frame.entry_capacity, &removed,
+                    wait_ms < max_gqcs_timeout ? wait_ms : max_gqcs_timeout,
+                    FALSE);
+                BOOST_COROSIO_PROBE1(reactor_wait_exit,
+                    result ? static_cast<long>(removed) : -1);
+            }
+
+            if (!result)
+            {
+                DWORD dwError = ::GetLastError();
+                if (dwError != WAIT_TIMEOUT)
+                    detail::throw_system_error(make_err(dwError));
+                if (priority_waiting)
+                {
+                    frame.priority_run = 0;
+                    continue;
+                }
+                if (timeout_ms != INFINITE)
+                    return 0;
+                continue;
+            }
+
+            frame.entry_count = removed;
+            frame.next_entry = 0;
+            bump(ts.events, removed);
+            raise_peak(queue_peak_, removed);
+            if (removed > 1 && lanes_routed_.load(std::memory_order_relaxed))
+                sort_entries(frame);
+        }
+
+        auto& e = frame.entries[frame.next_entry++];
+        if (e.lpCompletionKey == 0)
             continue;
+        frame.priority_run = 0;
+
+        auto* target = reinterpret_cast<completion_key*>(e.lpCompletionKey);
+        completion_key::result r;
+        {
+            handler_timer timed(stats_registry_, *frame.stats, [&]() -> void const*
+            {
+                // A posted handler's OVERLAPPED* is really a scheduler_op*
+                if (e.lpOverlapped &&
+                    e.lpCompletionKey == reinterpret_cast<ULONG_PTR>(&handler_key_))
+                    return reinterpret_cast<scheduler_op*>(e.lpOverlapped)->target();
+                return e.lpOverlapped;
+            });
+            BOOST_COROSIO_PROBE1(handler_start, e.lpOverlapped);
+            r = target->on_completion(*this,
+                e.dwNumberOfBytesTransferred, entry_error(e), e.lpOverlapped);
+            BOOST_COROSIO_PROBE1(handler_done, e.lpOverlapped);
         }
 
-        if (!result)
+        if (r == completion_key::result::did_work)
         {
-            if (dwError != WAIT_TIMEOUT)
-                detail::throw_system_error(make_err(dwError));
-            if (timeout_ms != INFINITE)
-                return 0;
+            bump(frame.stats->handlers);
+            return 1;
         }
+        if (r == completion_key::result::stop_loop)
+            return 0;
+    }
+}
+
+std::size_t
+win_scheduler::
+run_priority(win_thread_context& frame)
+{
+    scheduler_op* h;
+    {
+        std::lock_guard<win_mutex> lock(dispatch_mutex_);
+        h = priority_ops_.pop();
+        if (!h)
+            return 0;
+        priority_pending_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    ++frame.priority_run;
+
+    {
+        handler_timer timed(stats_registry_, *frame.stats, [h]() -> void const*
+        {
+            return h->target();
+        });
+        BOOST_COROSIO_PROBE1(handler_start, h);
+        handler_scope g{*this};
+        (*h)();
+        BOOST_COROSIO_PROBE1(handler_done, h);
+    }
+    bump(frame.stats->handlers);
+    return 1;
+}
+
+void
+win_scheduler::
+sort_entries(win_thread_context& frame) const noexcept
+{
+    // Stable, in place: flagged entries move ahead of the rest
+    auto* first = frame.entries + frame.next_entry;
+    auto* last = frame.entries + frame.entry_count;
+    auto* out = first;
+    for (auto* it = first; it != last; ++it)
+    {
+        if (it->lpCompletionKey == 0 || !it->lpOverlapped)
+            continue;
+        auto* key = reinterpret_cast<completion_key*>(it->lpCompletionKey);
+        if (!key->high_priority(it->lpOverlapped))
+            continue;
+        if (it != out)
+            std::rotate(out, it, it + 1);
+        ++out;
     }
 }
 
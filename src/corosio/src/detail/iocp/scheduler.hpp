@@ -16,16 +16,21 @@
 
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/detail/scheduler.hpp>
+#include <boost/corosio/iocp_context.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include <boost/system/error_code.hpp>
 
 #include "src/detail/scheduler_op.hpp"
+#include "src/detail/thread_stats.hpp"
 #include "src/detail/iocp/completion_key.hpp"
 #include "src/detail/iocp/mutex.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 #include "src/detail/iocp/windows.hpp"
 
@@ -33,6 +38,7 @@ namespace boost::corosio::detail {
 
 // Forward declarations
 struct overlapped_op;
+struct win_thread_context;
 class win_timers;
 class timer_service;
 
@@ -45,7 +51,8 @@ public:
 
     win_scheduler(
         capy::execution_context& ctx,
-        int concurrency_hint = -1);
+        int concurrency_hint = -1,
+        iocp_options const& opts = {});
     ~win_scheduler();
     win_scheduler(win_scheduler const&) = delete;
     win_scheduler& operator=(win_scheduler const&) = delete;
@@ -53,6 +60,8 @@ public:
     void shutdown() override;
     void post(capy::coro h) const override;
     void post(scheduler_op* h) const override;
+    void post_high_priority(capy::coro h) const override;
+    void post_batch(std::span<capy::coro const> hs) const override;
     void on_work_started() noexcept override;
     void on_work_finished() noexcept override;
     bool running_in_this_thread() const noexcept override;
@@ -64,17 +73,64 @@ public:
     std::size_t wait_one(long usec) override;
     std::size_t poll() override;
     std::size_t poll_one() override;
+    long outstanding_work() const noexcept override;
+    void collect_stats(scheduler_stats& st) const noexcept override;
+    bool time_handlers(std::chrono::nanoseconds threshold) noexcept override;
+    void sample_handlers(std::vector<handler_sample>& out) const override;
 
     void* native_handle() const noexcept { return iocp_; }
 
+    /// Return the options the scheduler was constructed with.
+    iocp_options const& options() const noexcept { return opts_; }
+
     // For use by I/O operations to track pending work
     void work_started() const noexcept override;
     void work_finished() const noexcept override;
 
+    /// Return the socket counters of the calling thread.
+    socket_counter_ref socket_counts() const noexcept;
+
+    /// Add the socket counters of every thread to `st`.
+    void collect_socket_stats(socket_stats& st) const noexcept
+    {
+        stats_registry_.collect(st);
+    }
+
+    /** Reorder dequeued completions by priority from now on.
+
+        Called when a socket is first marked for high priority
+        completions; until then batches are dispatched in the order
+        the port returned them.
+    */
+    void use_priority_lanes() const noexcept
+    {
+        lanes_routed_.store(true, std::memory_order_relaxed);
+    }
+
     // Timer service integration
     void set_timer_service(timer_service* svc);
     void update_timeout();
 
+    /** Brackets a completion handler run by a thread inside run().
+
+        Posts made by the handler are counted and staged in the
+        thread's frame. The destructor adds them to the work count in
+        a single update that also retires the handler's own unit, then
+        queues them to the completion port.
+    */
+    class handler_scope
+    {
+        win_scheduler& sched_;
+        win_thread_context* frame_;
+
+    public:
+        explicit handler_scope(win_scheduler& sched) noexcept;
+        ~handler_scope();
+
+        handler_scope(handler_scope const&) = delete;
+        handler_scope& operator=(handler_scope const&) = delete;
+    };
+
 private:
     // Completion key for posted handlers (scheduler_op*)
     struct handler_key final : completion_key
@@ -98,12 +154,24 @@ private:
             LPOVERLAPPED overlapped) override;
     };
 
+    class run_scope;
+
     // Static callback thunk - receives 'this' as context
     static void on_timer_changed(void* ctx);
     void post_deferred_completions(op_queue& ops);
-    std::size_t do_one(unsigned long timeout_ms);
+    std::size_t do_one(win_thread_context& frame, unsigned long timeout_ms);
+    DWORD entry_error(OVERLAPPED_ENTRY const& e) const noexcept;
+    void repost_entries(win_thread_context& frame) const noexcept;
+    long publish_private(win_thread_context& frame, long adjust) const noexcept;
+    std::size_t run_priority(win_thread_context& frame);
+    void sort_entries(win_thread_context& frame) const noexcept;
 
+    using nt_status_to_dos_error_fn = ULONG (WINAPI*)(LONG);
+
+    iocp_options opts_;
     void* iocp_;
+    ULONG completion_batch_;                                               // GQCSEx entries per run()/poll() call
+    nt_status_to_dos_error_fn nt_status_to_dos_error_ = nullptr;           // RtlNtStatusToDosError
     mutable long outstanding_work_;
     mutable long stopped_;
     long shutdown_;
@@ -119,8 +187,16 @@ private:
 
     mutable win_mutex dispatch_mutex_;                                      // protects completed_ops_
     mutable op_queue completed_ops_;                                       // fallback when PQCS fails (no auto-destroy)
+    mutable op_queue priority_ops_;                                        // high priority posts, guarded by dispatch_mutex_
+    mutable std::atomic<long> priority_pending_ = 0;                       // size of priority_ops_, read as a hint
+    mutable std::atomic<bool> lanes_routed_ = false;                       // see use_priority_lanes
     std::unique_ptr<win_timers> timers_;                                   // timer wakeup mechanism
     timer_service* timer_svc_ = nullptr;                                   // timer service for processing
+
+    // Counters, see STATISTICS in scheduler.cpp
+    mutable thread_stats_registry stats_registry_;
+    mutable std::atomic<std::uint64_t> wakeup_writes_ = 0;
+    mutable std::atomic<std::size_t> queue_peak_ = 0;
 };
 
 } // namespace boost::corosio::detail
@@ -17,6 +17,9 @@
 #include "src/detail/make_err.hpp"
 #include "src/detail/resume_coro.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 /*
     Windows IOCP Socket Implementation Overview
     ===========================================
@@ -55,6 +58,89 @@
     synchronously (returning immediately) but IOCP still posts a completion.
     The first path to set ready_=1 wins and processes the completion.
 
+    Inline Completion
+    -----------------
+    A WSARecv or WSASend that completes synchronously, and wins the CAS,
+    is finished with overlapped_op::complete_inline(): the results are
+    stored and read_some()/write_some() return true, so the awaitable
+    resumes without suspending and nothing goes through the port or the
+    executor. The op's inline budget bounds how many in a row are done
+    this way before one is posted again.
+
+    Counters
+    --------
+    Reads and writes count into the socket counters of the thread
+    that finishes them (see "Socket Counters" in thread_stats.hpp).
+    An op is marked `waited` before each WSARecv, WSASend or
+    TransmitFile is issued, since a pending op may complete before
+    the call returns, and the mark is taken back when the call
+    completes synchronously. WSA_IO_PENDING counts as a would-block.
+    The op is counted by count() when it resumes its coroutine,
+    inline or through read_op/write_op::operator(); ops with an
+    empty buffer, waits among them, are not counted.
+
+    Transfer All
+    ------------
+    read_exact() and write_all() mark the op transfer_all. When a part
+    of the transfer completes, read_op/write_op::operator() hands it to
+    continue_read()/continue_write() first, which drop the transferred
+    WSABUFs and issue the next WSARecv or WSASend with the same op.
+    The coroutine is resumed only once the buffers are done or a part
+    fails, with the parts before it counted in bytes_before. A stop
+    request that lands between two parts is applied to the next one.
+
+    File Transmission
+    -----------------
+    send_file() gives the write op a file handle and issues TransmitFile
+    with the file offset in the OVERLAPPED, in parts of at most
+    max_transmit_file bytes. write_op::operator() hands each completed
+    part to continue_send_file(), which advances the offset and issues
+    the next one, as continue_write() does for WSASend. A part shorter
+    than asked for without an error is the end of the file and ends the
+    transfer with ERROR_HANDLE_EOF. Without the TransmitFile extension
+    the wrapper uses the read-and-write default of socket_impl.
+
+    Registered I/O
+    --------------
+    With iocp_options::registered_io, sockets are created with
+    WSA_FLAG_REGISTERED_IO and given a RIO request queue (see win_rio).
+    A read or write on a single buffer inside a registered buffer is
+    queued with RIOReceive or RIOSend instead, with the op itself as the
+    request context. Those never complete synchronously and carry no
+    OVERLAPPED; their results arrive through win_rio's notification
+    key, which completes and resumes the op directly, so ready_ plays
+    no part. Everything else on the socket stays overlapped.
+
+    AFD Polling
+    -----------
+    With iocp_options::afd_poll, win_sockets opens the AFD driver (see
+    win_afd) and wait() goes to poll(), which issues an IOCTL_AFD_POLL
+    for the socket with the read or write op as its OVERLAPPED. The
+    poll completes through overlapped_key like any socket I/O, with no
+    bytes and no buffer, and the op's polling flag sends a cancellation
+    to the AFD handle, where the request was issued, instead of the
+    socket. cancel() cancels both ops' polls as well as the socket's
+    I/O. An AFD poll never completes inline: its packet is queued even
+    when the socket is ready at once.
+
+    Accept Pool
+    -----------
+    With iocp_options::accept_backlog, open_acceptor() gives the acceptor
+    that many accept_slots, each an AcceptEx posted with a pre-created
+    socket. A completed slot queues its socket in accepted_ and is posted
+    again, so connections are accepted while no accept() is pending. The
+    slots in flight plus the queued sockets never exceed the pool size,
+    and accept() re-posts the slot whose socket it takes. accept() itself
+    parks acc_ (waiting_) until a socket or a persistent error is queued,
+    then posts it to run on the executor as an ordinary completion.
+
+    A slot counts as no work while the acceptor is open, or a listening
+    acceptor would keep run() from returning; the parked acc_ counts
+    instead. Slot completions still run inside a handler scope, so each
+    one adds the unit its scope retires. close() makes every slot in
+    flight hold a unit (holds_work) until its aborted completion arrives,
+    which also lets the scheduler's shutdown drain wait for them.
+
     Lifetime Management via shared_ptr (Hidden from Public Interface)
     -----------------------------------------------------------------
     The trickiest aspect is ensuring socket state stays alive while I/O is
@@ -150,13 +236,7 @@ on_completion(
     auto* op = static_cast<overlapped_op*>(overlapped);
     if (::InterlockedCompareExchange(&op->ready_, 1, 0) == 0)
     {
-        struct work_guard
-        {
-            win_scheduler* self;
-            ~work_guard() { self->on_work_finished(); }
-        };
-
-        work_guard g{&sched};
+        win_scheduler::handler_scope g{sched};
         op->complete(bytes, dwError);
         (*op)();
         return result::did_work;
@@ -171,14 +251,31 @@ destroy(LPOVERLAPPED overlapped)
     static_cast<overlapped_op*>(overlapped)->destroy();
 }
 
+bool
+win_sockets::overlapped_key::
+high_priority(LPOVERLAPPED overlapped) const noexcept
+{
+    return static_cast<overlapped_op*>(overlapped)->high_priority;
+}
+
 void
 accept_op::
 operator()()
 {
     stop_cb.reset();
+    BOOST_COROSIO_PROBE3(socket_accept, listen_socket, accepted_socket, dwError);
 
     bool success = (dwError == 0 && !cancelled.load(std::memory_order_acquire));
 
+    if (acceptor_ptr)
+    {
+        auto const c = acceptor_ptr->svc_.scheduler().socket_counts();
+        if (cancelled.load(std::memory_order_acquire))
+            c.add(&socket_counters::cancellations);
+        else if (success)
+            c.add(&socket_counters::accepts);
+    }
+
     if (ec_out)
     {
         if (cancelled.load(std::memory_order_acquire))
@@ -203,18 +300,18 @@ operator()()
         peer_wrapper->get_internal()->set_socket(accepted_socket);
 
         // Cache endpoints on the accepted socket
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         int local_len = sizeof(local_addr);
-        sockaddr_in remote_addr{};
+        sockaddr_storage remote_addr{};
         int remote_len = sizeof(remote_addr);
 
         endpoint local_ep, remote_ep;
         if (::getsockname(accepted_socket,
             reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_ep = from_sockaddr_in(local_addr);
+            local_ep = from_sockaddr(local_addr);
         if (::getpeername(accepted_socket,
             reinterpret_cast<sockaddr*>(&remote_addr), &remote_len) == 0)
-            remote_ep = from_sockaddr_in(remote_addr);
+            remote_ep = from_sockaddr(remote_addr);
 
         peer_wrapper->get_internal()->set_endpoints(local_ep, remote_ep);
 
@@ -236,7 +333,8 @@ operator()()
         }
 
         // Release the peer wrapper on failure
-        peer_wrapper->release();
+        if (peer_wrapper)
+            peer_wrapper->release();
         peer_wrapper = nullptr;
 
         if (impl_out)
@@ -259,6 +357,12 @@ void
 accept_op::
 do_cancel() noexcept
 {
+    if (pool)
+    {
+        pool->cancel_waiter();
+        return;
+    }
+
     if (listen_socket != INVALID_SOCKET)
     {
         ::CancelIoEx(
@@ -267,25 +371,58 @@ do_cancel() noexcept
     }
 }
 
+void
+accept_slot::
+operator()()
+{
+    acceptor.on_slot_complete(*this);
+}
+
+void
+accept_slot::
+destroy()
+{
+    if (accepted_socket != INVALID_SOCKET)
+    {
+        ::closesocket(accepted_socket);
+        accepted_socket = INVALID_SOCKET;
+    }
+
+    // The drain retired a unit; a slot of an open acceptor held none
+    if (!holds_work)
+        acceptor.svc_.work_started();
+    holds_work = false;
+
+    // May be the last reference to the acceptor owning this slot
+    auto self = std::move(acceptor_ptr);
+}
+
 void
 connect_op::
 operator()()
 {
     // Cache endpoints on successful connect
     bool success = (dwError == 0 && !cancelled.load(std::memory_order_acquire));
+    auto const c = internal.svc_.scheduler().socket_counts();
+    if (cancelled.load(std::memory_order_acquire))
+        c.add(&socket_counters::cancellations);
+    else if (dwError != 0)
+        c.add(&socket_counters::connect_failures);
+
     if (success && internal.is_open())
     {
         // Query local endpoint via getsockname (may fail, but remote is always known)
         endpoint local_ep;
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         int local_len = sizeof(local_addr);
         if (::getsockname(internal.native_handle(),
             reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_ep = from_sockaddr_in(local_addr);
+            local_ep = from_sockaddr(local_addr);
         // Always cache remote endpoint; local may be default if getsockname failed
         internal.set_endpoints(local_ep, target_endpoint);
     }
 
+    BOOST_COROSIO_PROBE2(socket_connect, internal.native_handle(), dwError);
     overlapped_op::operator()();
     internal_ptr.reset();
 }
@@ -306,6 +443,12 @@ void
 read_op::
 operator()()
 {
+    polling = false;
+    if (transfer_all && internal.continue_read(*this))
+        return;
+    BOOST_COROSIO_PROBE3(socket_read, internal.native_handle(),
+        bytes_before + bytes_transferred, dwError);
+    internal.count(*this, true);
     overlapped_op::operator()();
     internal_ptr.reset();
 }
@@ -314,7 +457,9 @@ void
 read_op::
 do_cancel() noexcept
 {
-    if (internal.is_open())
+    if (polling)
+        internal.svc_.afd()->cancel(*this);
+    else if (internal.is_open())
     {
         ::CancelIoEx(
             reinterpret_cast<HANDLE>(internal.native_handle()),
@@ -326,6 +471,14 @@ void
 write_op::
 operator()()
 {
+    polling = false;
+    if (file && internal.continue_send_file(*this))
+        return;
+    if (transfer_all && internal.continue_write(*this))
+        return;
+    BOOST_COROSIO_PROBE3(socket_write, internal.native_handle(),
+        bytes_before + bytes_transferred, dwError);
+    internal.count(*this, false);
     overlapped_op::operator()();
     internal_ptr.reset();
 }
@@ -334,7 +487,9 @@ void
 write_op::
 do_cancel() noexcept
 {
-    if (internal.is_open())
+    if (polling)
+        internal.svc_.afd()->cancel(*this);
+    else if (internal.is_open())
     {
         ::CancelIoEx(
             reinterpret_cast<HANDLE>(internal.native_handle()),
@@ -380,7 +535,9 @@ connect(
     capy::executor_ref d,
     endpoint ep,
     std::stop_token token,
-    system::error_code* ec)
+    system::error_code* ec,
+    capy::const_buffer data,
+    std::size_t* bytes)
 {
     // Keep internal alive during I/O
     conn_.internal_ptr = shared_from_this();
@@ -390,17 +547,20 @@ connect(
     op.h = h;
     op.d = d;
     op.ec_out = ec;
+    op.bytes_out = bytes;
     op.target_endpoint = ep;  // Store target for endpoint caching
     op.start(token);
 
-    sockaddr_in bind_addr{};
-    bind_addr.sin_family = AF_INET;
-    bind_addr.sin_addr.s_addr = INADDR_ANY;
-    bind_addr.sin_port = 0;
+    // ConnectEx requires a bound socket; bind the any-address of
+    // the target's family
+    sockaddr_storage bind_addr;
+    int bind_len = detail::to_sockaddr(
+        ep.is_v6() ? endpoint(urls::ipv6_address(), 0) : endpoint(),
+        bind_addr);
 
     if (::bind(socket_,
         reinterpret_cast<sockaddr*>(&bind_addr),
-        sizeof(bind_addr)) == SOCKET_ERROR)
+        bind_len) == SOCKET_ERROR)
     {
         op.dwError = ::WSAGetLastError();
         svc_.post(&op);
@@ -415,17 +575,30 @@ connect(
         return;
     }
 
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
+    sockaddr_storage addr;
+    int addrlen = detail::to_sockaddr(ep, addr);
+
+#ifdef TCP_FASTOPEN
+    // Lets ConnectEx put the send buffer in the SYN. Best effort:
+    // before Windows 10 1607 the data follows the handshake.
+    if (data.size() > 0)
+    {
+        DWORD one = 1;
+        ::setsockopt(socket_, IPPROTO_TCP, TCP_FASTOPEN,
+            reinterpret_cast<char const*>(&one), sizeof(one));
+    }
+#endif
 
     svc_.work_started();
 
+    DWORD sent = 0;
     BOOL result = connect_ex(
         socket_,
         reinterpret_cast<sockaddr*>(&addr),
-        sizeof(addr),
-        nullptr,
-        0,
-        nullptr,
+        addrlen,
+        const_cast<void*>(data.data()),
+        static_cast<DWORD>(data.size()),
+        &sent,
         &op);
 
     if (!result)
@@ -450,12 +623,13 @@ connect(
         if (::InterlockedCompareExchange(&op.ready_, 1, 0) == 0)
         {
             op.dwError = 0;
+            op.bytes_transferred = sent;
             svc_.post(&op);
         }
     }
 }
 
-void
+bool
 win_socket_impl_internal::
 read_some(
     capy::coro h,
@@ -463,7 +637,8 @@ read_some(
     io_buffer_param param,
     std::stop_token token,
     system::error_code* ec,
-    std::size_t* bytes_out)
+    std::size_t* bytes_out,
+    bool all)
 {
     // Keep internal alive during I/O
     rd_.internal_ptr = shared_from_this();
@@ -474,36 +649,59 @@ read_some(
     op.d = d;
     op.ec_out = ec;
     op.bytes_out = bytes_out;
-    op.start(token);
+    op.transfer_all = all;
 
-    capy::mutable_buffer bufs[read_op::max_buffers];
-    op.wsabuf_count = static_cast<DWORD>(
-        param.copy_to(bufs, read_op::max_buffers));
+    // Winsock has no buffer limit, so a transfer of everything takes
+    // the whole sequence at once, see "Transfer All"
+    if (all)
+        assign_wsabufs(op.wsabufs, param, std::size_t(-1));
+    else
+        assign_wsabufs(op.wsabufs, param);
+    op.start(token);
 
     // Handle empty buffer: complete immediately with 0 bytes
-    if (op.wsabuf_count == 0)
+    if (op.wsabufs.empty())
     {
         op.bytes_transferred = 0;
         op.dwError = 0;
         op.empty_buffer = true;
         svc_.post(&op);
-        return;
+        return false;
     }
 
-    for (DWORD i = 0; i < op.wsabuf_count; ++i)
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    // A single registered buffer goes through RIO
+    RIO_BUF rio_buf;
+    if (!all && op.wsabufs.size() == 1 && rq_ != RIO_INVALID_RQ &&
+        svc_.rio()->find_buffer(
+            op.wsabufs[0].buf, op.wsabufs[0].len, rio_buf))
     {
-        op.wsabufs[i].buf = static_cast<char*>(bufs[i].data());
-        op.wsabufs[i].len = static_cast<ULONG>(bufs[i].size());
+        op.waited = true;
+        svc_.work_started();
+        DWORD err;
+        {
+            std::lock_guard<win_mutex> lock(rq_mutex_);
+            err = svc_.rio()->receive(rq_, &rio_buf, &op);
+        }
+        if (err != 0)
+        {
+            svc_.work_finished();
+            op.dwError = err;
+            svc_.post(&op);
+        }
+        return false;
     }
+#endif
 
     op.flags = 0;
+    op.waited = true;
 
     svc_.work_started();
 
     int result = ::WSARecv(
         socket_,
-        op.wsabufs,
-        op.wsabuf_count,
+        op.wsabufs.data(),
+        static_cast<DWORD>(op.wsabufs.size()),
         nullptr,
         &op.flags,
         &op,
@@ -517,8 +715,9 @@ read_some(
             svc_.work_finished();
             op.dwError = err;
             svc_.post(&op);
-            return;
+            return false;
         }
+        svc_.scheduler().socket_counts().add(&socket_counters::would_block);
     }
     else
     {
@@ -532,12 +731,165 @@ read_some(
         {
             op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
             op.dwError = 0;
+            op.waited = false;
+            if (all && continue_read(op))
+                return false;
+            if (op.complete_inline())
+            {
+                count(op, true);
+                op.internal_ptr.reset();
+                return true;
+            }
             svc_.post(&op);
         }
     }
+    return false;
 }
 
-void
+bool
+win_socket_impl_internal::
+wait(
+    capy::coro h,
+    capy::executor_ref d,
+    socket::wait_type w,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    if (svc_.afd())
+        return poll(h, d, w, token, ec);
+
+    // Completion ports report finished I/O, not readiness
+    if (w == socket::wait_type::error)
+    {
+        *ec = make_error_code(system::errc::operation_not_supported);
+        return true;
+    }
+
+    // Sends are buffered by the stack and never wait for room
+    if (w == socket::wait_type::write)
+    {
+        wr_.internal_ptr = shared_from_this();
+        auto& op = wr_;
+        op.reset();
+        op.h = h;
+        op.d = d;
+        op.ec_out = ec;
+        op.bytes_out = nullptr;
+        op.transfer_all = false;
+        op.file = nullptr;
+        op.start(token);
+        op.empty_buffer = true;
+        op.dwError = 0;
+        svc_.post(&op);
+        return false;
+    }
+
+    // A zero-byte receive completes once data or the end of the
+    // stream arrives, without taking any of it
+    rd_.internal_ptr = shared_from_this();
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.d = d;
+    op.ec_out = ec;
+    op.bytes_out = nullptr;
+    op.transfer_all = false;
+    op.start(token);
+    op.empty_buffer = true;
+    op.flags = 0;
+
+    WSABUF none{};
+    svc_.work_started();
+
+    int result = ::WSARecv(
+        socket_,
+        &none,
+        1,
+        nullptr,
+        &op.flags,
+        &op,
+        nullptr);
+
+    if (result == SOCKET_ERROR)
+    {
+        DWORD err = ::WSAGetLastError();
+        if (err != WSA_IO_PENDING)
+        {
+            svc_.work_finished();
+            op.dwError = err;
+            svc_.post(&op);
+        }
+        return false;
+    }
+
+    // Synchronous completion, racing IOCP as in read_some
+    svc_.work_finished();
+    if (::InterlockedCompareExchange(&op.ready_, 1, 0) == 0)
+    {
+        op.bytes_transferred = 0;
+        op.dwError = 0;
+        if (op.complete_inline())
+        {
+            op.internal_ptr.reset();
+            return true;
+        }
+        svc_.post(&op);
+    }
+    return false;
+}
+
+bool
+win_socket_impl_internal::
+poll(
+    capy::coro h,
+    capy::executor_ref d,
+    socket::wait_type w,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    // A read or error wait stands for a read, a write wait for a write
+    auto do_poll = [&](auto& op, ULONG events)
+    {
+        op.internal_ptr = shared_from_this();
+        op.reset();
+        op.h = h;
+        op.d = d;
+        op.ec_out = ec;
+        op.bytes_out = nullptr;
+        op.transfer_all = false;
+        op.start(token);
+        op.empty_buffer = true;
+        op.polling = true;
+
+        svc_.work_started();
+        DWORD err = svc_.afd()->poll(socket_, events, op.poll_info, op);
+        if (err != 0)
+        {
+            svc_.work_finished();
+            op.dwError = err;
+            svc_.post(&op);
+        }
+    };
+
+    // Like the reactors, an error ends a wait and is left to the
+    // operation that follows
+    switch (w)
+    {
+    case socket::wait_type::read:
+        do_poll(rd_, win_afd::poll_receive | win_afd::poll_error);
+        break;
+    case socket::wait_type::write:
+        wr_.file = nullptr;
+        do_poll(wr_, win_afd::poll_send | win_afd::poll_error);
+        break;
+    default:
+        do_poll(rd_, win_afd::poll_urgent | win_afd::poll_error);
+        break;
+    }
+    return false;
+}
+
+bool
 win_socket_impl_internal::
 write_some(
     capy::coro h,
@@ -545,7 +897,8 @@ write_some(
     io_buffer_param param,
     std::stop_token token,
     system::error_code* ec,
-    std::size_t* bytes_out)
+    std::size_t* bytes_out,
+    bool all)
 {
     // Keep internal alive during I/O
     wr_.internal_ptr = shared_from_this();
@@ -556,33 +909,57 @@ write_some(
     op.d = d;
     op.ec_out = ec;
     op.bytes_out = bytes_out;
-    op.start(token);
+    op.transfer_all = all;
+    op.file = nullptr;
 
-    capy::mutable_buffer bufs[write_op::max_buffers];
-    op.wsabuf_count = static_cast<DWORD>(
-        param.copy_to(bufs, write_op::max_buffers));
+    // Winsock has no buffer limit, so a transfer of everything takes
+    // the whole sequence at once, see "Transfer All"
+    if (all)
+        assign_wsabufs(op.wsabufs, param, std::size_t(-1));
+    else
+        assign_wsabufs(op.wsabufs, param);
+    op.start(token);
 
     // Handle empty buffer: complete immediately with 0 bytes
-    if (op.wsabuf_count == 0)
+    if (op.wsabufs.empty())
     {
         op.bytes_transferred = 0;
         op.dwError = 0;
         svc_.post(&op);
-        return;
+        return false;
     }
 
-    for (DWORD i = 0; i < op.wsabuf_count; ++i)
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    // A single registered buffer goes through RIO
+    RIO_BUF rio_buf;
+    if (!all && op.wsabufs.size() == 1 && rq_ != RIO_INVALID_RQ &&
+        svc_.rio()->find_buffer(
+            op.wsabufs[0].buf, op.wsabufs[0].len, rio_buf))
     {
-        op.wsabufs[i].buf = static_cast<char*>(bufs[i].data());
-        op.wsabufs[i].len = static_cast<ULONG>(bufs[i].size());
+        op.waited = true;
+        svc_.work_started();
+        DWORD err;
+        {
+            std::lock_guard<win_mutex> lock(rq_mutex_);
+            err = svc_.rio()->send(rq_, &rio_buf, &op);
+        }
+        if (err != 0)
+        {
+            svc_.work_finished();
+            op.dwError = err;
+            svc_.post(&op);
+        }
+        return false;
     }
+#endif
 
+    op.waited = true;
     svc_.work_started();
 
     int result = ::WSASend(
         socket_,
-        op.wsabufs,
-        op.wsabuf_count,
+        op.wsabufs.data(),
+        static_cast<DWORD>(op.wsabufs.size()),
         nullptr,
         0,
         &op,
@@ -596,8 +973,9 @@ write_some(
             svc_.work_finished();
             op.dwError = err;
             svc_.post(&op);
-            return;
+            return false;
         }
+        svc_.scheduler().socket_counts().add(&socket_counters::would_block);
     }
     else
     {
@@ -608,118 +986,463 @@ write_some(
         {
             op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
             op.dwError = 0;
+            op.waited = false;
+            if (all && continue_write(op))
+                return false;
+            if (op.complete_inline())
+            {
+                count(op, false);
+                op.internal_ptr.reset();
+                return true;
+            }
             svc_.post(&op);
         }
     }
+    return false;
 }
 
-void
+bool
 win_socket_impl_internal::
-cancel() noexcept
+continue_read(read_op& op) noexcept
 {
-    if (socket_ != INVALID_SOCKET)
+    // Only a part that succeeded with data is continued; an error,
+    // EOF or cancellation finishes the transfer
+    while (!op.cancelled.load(std::memory_order_acquire) &&
+        op.dwError == 0 && op.bytes_transferred != 0 &&
+        !consume_wsabufs(op.wsabufs, op.bytes_transferred))
     {
-        ::CancelIoEx(
-            reinterpret_cast<HANDLE>(socket_),
+        op.bytes_before += op.bytes_transferred;
+        op.bytes_transferred = 0;
+        op.Internal = 0;
+        op.InternalHigh = 0;
+        op.ready_ = 0;
+        op.flags = 0;
+        bool const waited = op.waited;
+        op.waited = true;
+
+        svc_.work_started();
+
+        int result = ::WSARecv(
+            socket_,
+            op.wsabufs.data(),
+            static_cast<DWORD>(op.wsabufs.size()),
+            nullptr,
+            &op.flags,
+            &op,
             nullptr);
-    }
 
-    conn_.request_cancel();
-    rd_.request_cancel();
-    wr_.request_cancel();
-}
+        if (result == SOCKET_ERROR)
+        {
+            DWORD err = ::WSAGetLastError();
+            if (err != WSA_IO_PENDING)
+            {
+                svc_.work_finished();
+                op.dwError = err;
+                return false;
+            }
+            svc_.scheduler().socket_counts().add(&socket_counters::would_block);
+
+            // A stop between two parts found nothing to cancel
+            if (op.cancelled.load(std::memory_order_acquire))
+                op.do_cancel();
+            return true;
+        }
 
-void
-win_socket_impl_internal::
-close_socket() noexcept
-{
-    if (socket_ != INVALID_SOCKET)
-    {
-        ::closesocket(socket_);
-        socket_ = INVALID_SOCKET;
+        // Synchronous completion, see read_some
+        svc_.work_finished();
+        if (::InterlockedCompareExchange(&op.ready_, 1, 0) != 0)
+            return true;
+        op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
+        op.waited = waited;
     }
-
-    // Clear cached endpoints
-    local_endpoint_ = endpoint{};
-    remote_endpoint_ = endpoint{};
+    return false;
 }
 
-void
-win_socket_impl::
-release()
+bool
+win_socket_impl_internal::
+continue_write(write_op& op) noexcept
 {
-    if (internal_)
+    while (!op.cancelled.load(std::memory_order_acquire) &&
+        op.dwError == 0 && op.bytes_transferred != 0 &&
+        !consume_wsabufs(op.wsabufs, op.bytes_transferred))
     {
-        auto& svc = internal_->svc_;
-        internal_->release_internal();
-        internal_.reset();
-        svc.destroy_impl(*this);
-    }
-}
+        op.bytes_before += op.bytes_transferred;
+        op.bytes_transferred = 0;
+        op.Internal = 0;
+        op.InternalHigh = 0;
+        op.ready_ = 0;
+        bool const waited = op.waited;
+        op.waited = true;
+
+        svc_.work_started();
+
+        int result = ::WSASend(
+            socket_,
+            op.wsabufs.data(),
+            static_cast<DWORD>(op.wsabufs.size()),
+            nullptr,
+            0,
+            &op,
+            nullptr);
 
-win_sockets::
-win_sockets(
-    capy::execution_context& ctx)
-    : sched_(ctx.use_service<win_scheduler>())
-    , iocp_(sched_.native_handle())
-{
-    load_extension_functions();
-}
+        if (result == SOCKET_ERROR)
+        {
+            DWORD err = ::WSAGetLastError();
+            if (err != WSA_IO_PENDING)
+            {
+                svc_.work_finished();
+                op.dwError = err;
+                return false;
+            }
+            svc_.scheduler().socket_counts().add(&socket_counters::would_block);
+
+            if (op.cancelled.load(std::memory_order_acquire))
+                op.do_cancel();
+            return true;
+        }
 
-win_sockets::
-~win_sockets()
-{
+        svc_.work_finished();
+        if (::InterlockedCompareExchange(&op.ready_, 1, 0) != 0)
+            return true;
+        op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
+        op.waited = waited;
+    }
+    return false;
 }
 
-void
-win_sockets::
-shutdown()
+bool
+win_socket_impl_internal::
+send_file(
+    capy::coro h,
+    capy::executor_ref d,
+    HANDLE file,
+    std::uint64_t offset,
+    std::size_t count,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
 {
-    std::lock_guard<win_mutex> lock(mutex_);
-
-    // Just close sockets and remove from list
-    // The shared_ptrs held by socket objects and operations will handle destruction
-    for (auto* impl = socket_list_.pop_front(); impl != nullptr;
-         impl = socket_list_.pop_front())
-    {
-        impl->close_socket();
-        // Note: impl may still be alive if operations hold shared_ptr
-    }
+    // Keep internal alive during I/O
+    wr_.internal_ptr = shared_from_this();
 
-    for (auto* impl = acceptor_list_.pop_front(); impl != nullptr;
-         impl = acceptor_list_.pop_front())
-    {
-        impl->close_socket();
-    }
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.d = d;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.transfer_all = false;
+    op.file = file;
+    op.file_offset = offset;
+    op.file_remaining = count;
+    op.file_chunk = 0;
+    op.start(token);
 
-    // Cleanup wrappers
-    for (auto* w = socket_wrapper_list_.pop_front(); w != nullptr;
-         w = socket_wrapper_list_.pop_front())
+    // Nothing to send: continue_send_file() finds the count done
+    if (count == 0)
     {
-        delete w;
+        svc_.post(&op);
+        return false;
     }
 
-    for (auto* w = acceptor_wrapper_list_.pop_front(); w != nullptr;
-         w = acceptor_wrapper_list_.pop_front())
+    if (!transmit_part(op))
+        return false;
+    if (op.dwError == 0 && continue_send_file(op))
+        return false;
+    if (op.dwError == 0 && op.complete_inline())
     {
-        delete w;
+        count(op, false);
+        op.internal_ptr.reset();
+        return true;
     }
+    svc_.post(&op);
+    return false;
 }
 
-win_socket_impl&
-win_sockets::
-create_impl()
+bool
+win_socket_impl_internal::
+transmit_part(write_op& op) noexcept
 {
-    auto internal = std::make_shared<win_socket_impl_internal>(*this);
+    op.file_chunk = static_cast<DWORD>(
+        (std::min)(op.file_remaining, max_transmit_file));
+    op.Offset = static_cast<DWORD>(op.file_offset);
+    op.OffsetHigh = static_cast<DWORD>(op.file_offset >> 32);
+    bool const waited = op.waited;
+    op.waited = true;
 
-    {
-        std::lock_guard<win_mutex> lock(mutex_);
-        socket_list_.push_back(internal.get());
-    }
-
-    auto* wrapper = new win_socket_impl(std::move(internal));
+    svc_.work_started();
 
-    {
+    BOOL ok = svc_.transmit_file()(
+        socket_,
+        op.file,
+        op.file_chunk,
+        0,
+        &op,
+        nullptr,
+        0);
+
+    if (!ok)
+    {
+        DWORD err = ::WSAGetLastError();
+        if (err != WSA_IO_PENDING)
+        {
+            svc_.work_finished();
+            op.dwError = err;
+            return true;
+        }
+        svc_.scheduler().socket_counts().add(&socket_counters::would_block);
+
+        if (op.cancelled.load(std::memory_order_acquire))
+            op.do_cancel();
+        return false;
+    }
+
+    // Synchronous completion, see read_some
+    svc_.work_finished();
+    if (::InterlockedCompareExchange(&op.ready_, 1, 0) != 0)
+        return false;
+    op.bytes_transferred = static_cast<DWORD>(op.InternalHigh);
+    op.waited = waited;
+    return true;
+}
+
+bool
+win_socket_impl_internal::
+continue_send_file(write_op& op) noexcept
+{
+    while (!op.cancelled.load(std::memory_order_acquire) &&
+        op.dwError == 0)
+    {
+        // Parts move to bytes_before as they are counted, so an op
+        // that passes through here again adds nothing
+        std::size_t n = op.bytes_transferred;
+        op.bytes_before += n;
+        op.bytes_transferred = 0;
+        op.file_offset += n;
+        op.file_remaining -= n;
+
+        if (op.file_remaining == 0)
+            return false;
+        if (n < op.file_chunk)
+        {
+            op.dwError = ERROR_HANDLE_EOF;
+            return false;
+        }
+
+        op.Internal = 0;
+        op.InternalHigh = 0;
+        op.ready_ = 0;
+
+        if (!transmit_part(op))
+            return true;
+    }
+    return false;
+}
+
+// See "Counters"
+void
+win_socket_impl_internal::
+count(overlapped_op const& op, bool read) const noexcept
+{
+    auto const c = svc_.scheduler().socket_counts();
+    if (op.cancelled.load(std::memory_order_acquire))
+    {
+        c.add(&socket_counters::cancellations);
+        return;
+    }
+    if (op.empty_buffer)
+        return;
+    std::uint64_t const n = op.bytes_before + op.bytes_transferred;
+    if (read)
+    {
+        c.add(&socket_counters::bytes_read, n);
+        c.add(op.waited
+            ? &socket_counters::reads_waited
+            : &socket_counters::reads_immediate);
+    }
+    else
+    {
+        c.add(&socket_counters::bytes_written, n);
+        c.add(op.waited
+            ? &socket_counters::writes_waited
+            : &socket_counters::writes_immediate);
+    }
+}
+
+void
+win_socket_impl_internal::
+cancel() noexcept
+{
+    if (socket_ != INVALID_SOCKET)
+    {
+        ::CancelIoEx(
+            reinterpret_cast<HANDLE>(socket_),
+            nullptr);
+    }
+
+    // Polls are requests on the AFD handle, not on the socket
+    if (auto* afd = svc_.afd())
+    {
+        afd->cancel(rd_);
+        afd->cancel(wr_);
+    }
+
+    conn_.request_cancel();
+    rd_.request_cancel();
+    wr_.request_cancel();
+}
+
+void
+win_socket_impl_internal::
+set_socket(SOCKET s) noexcept
+{
+    socket_ = s;
+    svc_.attach_rio(*this);
+}
+
+void
+win_socket_impl_internal::
+close_socket() noexcept
+{
+    if (socket_ != INVALID_SOCKET)
+    {
+        // Closing the socket frees its request queue
+        ::closesocket(socket_);
+        socket_ = INVALID_SOCKET;
+    }
+
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    if (rq_ != RIO_INVALID_RQ)
+    {
+        svc_.rio()->release_request_queue();
+        rq_ = RIO_INVALID_RQ;
+    }
+#endif
+
+    conn_.high_priority = false;
+    rd_.high_priority = false;
+    wr_.high_priority = false;
+
+    // Clear cached endpoints
+    local_endpoint_ = endpoint{};
+    remote_endpoint_ = endpoint{};
+}
+
+void
+win_socket_impl_internal::
+set_high_priority(bool value) noexcept
+{
+    // See PRIORITY LANES in scheduler.cpp
+    conn_.high_priority = value;
+    rd_.high_priority = value;
+    wr_.high_priority = value;
+    if (value)
+        svc_.scheduler().use_priority_lanes();
+}
+
+bool
+win_socket_impl::
+send_file(
+    std::coroutine_handle<> h,
+    capy::executor_ref d,
+    native_file_type file,
+    std::uint64_t offset,
+    std::size_t count,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    if (!internal_->svc_.transmit_file())
+        return socket_impl::send_file(
+            h, d, file, offset, count, token, ec, bytes);
+    return internal_->send_file(
+        h, d, static_cast<HANDLE>(file), offset, count, token, ec, bytes);
+}
+
+void
+win_socket_impl::
+release()
+{
+    if (internal_)
+    {
+        auto& svc = internal_->svc_;
+        internal_->release_internal();
+        internal_.reset();
+        svc.destroy_impl(*this);
+    }
+}
+
+win_sockets::
+win_sockets(
+    capy::execution_context& ctx)
+    : sched_(ctx.use_service<win_scheduler>())
+    , iocp_(sched_.native_handle())
+{
+    load_extension_functions();
+
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    if (sched_.options().registered_io)
+        rio_ = win_rio::try_create(sched_, iocp_);
+#endif
+
+    if (sched_.options().afd_poll)
+        afd_ = win_afd::try_create(iocp_, &overlapped_key_);
+}
+
+win_sockets::
+~win_sockets()
+{
+}
+
+void
+win_sockets::
+shutdown()
+{
+    std::lock_guard<win_mutex> lock(mutex_);
+
+    // Just close sockets and remove from list
+    // The shared_ptrs held by socket objects and operations will handle destruction
+    for (auto* impl = socket_list_.pop_front(); impl != nullptr;
+         impl = socket_list_.pop_front())
+    {
+        impl->close_socket();
+        // Note: impl may still be alive if operations hold shared_ptr
+    }
+
+    for (auto* impl = acceptor_list_.pop_front(); impl != nullptr;
+         impl = acceptor_list_.pop_front())
+    {
+        impl->close_socket();
+    }
+
+    // Cleanup wrappers
+    for (auto* w = socket_wrapper_list_.pop_front(); w != nullptr;
+         w = socket_wrapper_list_.pop_front())
+    {
+        delete w;
+    }
+
+    for (auto* w = acceptor_wrapper_list_.pop_front(); w != nullptr;
+         w = acceptor_wrapper_list_.pop_front())
+    {
+        delete w;
+    }
+}
+
+win_socket_impl&
+win_sockets::
+create_impl()
+{
+    auto internal = make_recycled_impl<win_socket_impl_internal>(*this);
+
+    {
+        std::lock_guard<win_mutex> lock(mutex_);
+        socket_list_.push_back(internal.get());
+    }
+
+    auto* wrapper = new win_socket_impl(std::move(internal));
+
+    {
         std::lock_guard<win_mutex> lock(mutex_);
         socket_wrapper_list_.push_back(wrapper);
     }
@@ -738,6 +1461,18 @@ destroy_impl(win_socket_impl& impl)
     delete &impl;
 }
 
+void
+win_sockets::
+collect_stats(socket_stats& st) noexcept
+{
+    sched_.collect_socket_stats(st);
+    std::lock_guard<win_mutex> lock(mutex_);
+    socket_wrapper_list_.for_each([&](win_socket_impl const&)
+    {
+        ++st.live_sockets;
+    });
+}
+
 void
 win_sockets::
 unregister_impl(win_socket_impl_internal& impl)
@@ -748,18 +1483,77 @@ unregister_impl(win_socket_impl_internal& impl)
 
 system::error_code
 win_sockets::
-open_socket(win_socket_impl_internal& impl)
+open_socket(
+    win_socket_impl_internal& impl,
+    ip_family family)
 {
     impl.close_socket();
 
-    SOCKET sock = ::WSASocketW(
-        AF_INET,
+    SOCKET sock = create_socket(family);
+
+    if (sock == INVALID_SOCKET)
+        return make_err(::WSAGetLastError());
+
+    HANDLE result = ::CreateIoCompletionPort(
+        reinterpret_cast<HANDLE>(sock),
+        static_cast<HANDLE>(iocp_),
+        reinterpret_cast<ULONG_PTR>(&overlapped_key_),
+        0);
+
+    if (result == nullptr)
+    {
+        DWORD dwError = ::GetLastError();
+        ::closesocket(sock);
+        return make_err(dwError);
+    }
+
+    ::SetFileCompletionNotificationModes(
+        reinterpret_cast<HANDLE>(sock),
+        FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
+
+    impl.set_socket(sock);
+    return {};
+}
+
+SOCKET
+win_sockets::
+create_socket(ip_family family) const noexcept
+{
+    DWORD flags = WSA_FLAG_OVERLAPPED;
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    if (rio_)
+        flags |= WSA_FLAG_REGISTERED_IO;
+#endif
+    return ::WSASocketW(
+        detail::to_af(family),
         SOCK_STREAM,
         IPPROTO_TCP,
         nullptr,
         0,
+        flags);
+}
+
+SOCKET
+win_sockets::
+create_local_socket() const noexcept
+{
+    return ::WSASocketW(
+        AF_UNIX,
+        SOCK_STREAM,
+        0,
+        nullptr,
+        0,
         WSA_FLAG_OVERLAPPED);
+}
+
+system::error_code
+win_sockets::
+open_local_socket(
+    win_socket_impl_internal& impl)
+{
+    impl.close_socket();
 
+    SOCKET sock = create_local_socket();
     if (sock == INVALID_SOCKET)
         return make_err(::WSAGetLastError());
 
@@ -780,10 +1574,22 @@ open_socket(win_socket_impl_internal& impl)
         reinterpret_cast<HANDLE>(sock),
         FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
 
-    impl.socket_ = sock;
+    impl.set_socket(sock);
     return {};
 }
 
+void
+win_sockets::
+attach_rio(win_socket_impl_internal& impl) noexcept
+{
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    if (rio_ && impl.socket_ != INVALID_SOCKET)
+        impl.rq_ = rio_->create_request_queue(impl.socket_);
+#else
+    (void)impl;
+#endif
+}
+
 void
 win_sockets::
 post(overlapped_op* op)
@@ -846,6 +1652,18 @@ load_extension_functions()
         nullptr,
         nullptr);
 
+    GUID transmit_file_guid = WSAID_TRANSMITFILE;
+    ::WSAIoctl(
+        sock,
+        SIO_GET_EXTENSION_FUNCTION_POINTER,
+        &transmit_file_guid,
+        sizeof(transmit_file_guid),
+        &transmit_file_,
+        sizeof(transmit_file_),
+        &bytes,
+        nullptr,
+        nullptr);
+
     ::closesocket(sock);
 }
 
@@ -853,7 +1671,7 @@ win_acceptor_impl&
 win_sockets::
 create_acceptor_impl()
 {
-    auto internal = std::make_shared<win_acceptor_impl_internal>(*this);
+    auto internal = make_recycled_impl<win_acceptor_impl_internal>(*this);
 
     {
         std::lock_guard<win_mutex> lock(mutex_);
@@ -894,12 +1712,17 @@ win_sockets::
 open_acceptor(
     win_acceptor_impl_internal& impl,
     endpoint ep,
-    int backlog)
+    acceptor::listen_options const& opts)
 {
     impl.close_socket();
 
+    // SO_REUSEADDR already permits sharing on Windows; there is no
+    // kernel load balancing equivalent to SO_REUSEPORT
+    if (opts.reuse_port || opts.cpu_steering)
+        return make_err(WSAEOPNOTSUPP);
+
     SOCKET sock = ::WSASocketW(
-        AF_INET,
+        detail::to_af(ep.family()),
         SOCK_STREAM,
         IPPROTO_TCP,
         nullptr,
@@ -931,32 +1754,128 @@ open_acceptor(
         reinterpret_cast<HANDLE>(sock),
         FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
 
+    // Set explicitly rather than relying on the system default
+    if (ep.is_v6())
+    {
+        DWORD v6_only = opts.dual_stack ? 0 : 1;
+        if (::setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY,
+            reinterpret_cast<char*>(&v6_only), sizeof(v6_only)) == SOCKET_ERROR)
+        {
+            DWORD dwError = ::WSAGetLastError();
+            ::closesocket(sock);
+            return make_err(dwError);
+        }
+    }
+
     // Bind to endpoint
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
+    sockaddr_storage addr;
+    int addrlen = detail::to_sockaddr(ep, addr);
     if (::bind(sock,
         reinterpret_cast<sockaddr*>(&addr),
-        sizeof(addr)) == SOCKET_ERROR)
+        addrlen) == SOCKET_ERROR)
     {
         DWORD dwError = ::WSAGetLastError();
         ::closesocket(sock);
         return make_err(dwError);
     }
 
+    // Windows takes an on/off flag rather than a queue length
+    if (opts.fast_open_queue > 0)
+    {
+#ifdef TCP_FASTOPEN
+        DWORD on = 1;
+        if (::setsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN,
+            reinterpret_cast<char*>(&on), sizeof(on)) == SOCKET_ERROR)
+        {
+            DWORD dwError = ::WSAGetLastError();
+            ::closesocket(sock);
+            return make_err(dwError);
+        }
+#else
+        ::closesocket(sock);
+        return make_err(WSAEOPNOTSUPP);
+#endif
+    }
+
     // Start listening
-    if (::listen(sock, backlog) == SOCKET_ERROR)
+    if (::listen(sock, opts.backlog) == SOCKET_ERROR)
     {
         DWORD dwError = ::WSAGetLastError();
         ::closesocket(sock);
         return make_err(dwError);
     }
 
-    impl.socket_ = sock;
+    {
+        std::lock_guard<win_mutex> lock(impl.pool_mutex_);
+        impl.socket_ = sock;
+        impl.local_ = false;
+    }
 
     // Cache the local endpoint (queries OS for ephemeral port if port was 0)
-    sockaddr_in local_addr{};
+    sockaddr_storage local_addr{};
     int local_len = sizeof(local_addr);
     if (::getsockname(sock, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-        impl.set_local_endpoint(detail::from_sockaddr_in(local_addr));
+        impl.set_local_endpoint(detail::from_sockaddr(local_addr));
+
+    if (unsigned n = sched_.options().accept_backlog)
+        impl.start_pool(n);
+
+    return {};
+}
+
+system::error_code
+win_sockets::
+open_local_acceptor(
+    win_acceptor_impl_internal& impl,
+    std::string_view path,
+    int backlog)
+{
+    impl.close_socket();
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        return make_err(WSAENAMETOOLONG);
+    std::memcpy(addr.sun_path, path.data(), path.size());
+
+    SOCKET sock = create_local_socket();
+    if (sock == INVALID_SOCKET)
+        return make_err(::WSAGetLastError());
+
+    HANDLE result = ::CreateIoCompletionPort(
+        reinterpret_cast<HANDLE>(sock),
+        static_cast<HANDLE>(iocp_),
+        reinterpret_cast<ULONG_PTR>(&overlapped_key_),
+        0);
+
+    if (result == nullptr)
+    {
+        DWORD dwError = ::GetLastError();
+        ::closesocket(sock);
+        return make_err(dwError);
+    }
+
+    ::SetFileCompletionNotificationModes(
+        reinterpret_cast<HANDLE>(sock),
+        FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
+
+    if (::bind(sock, reinterpret_cast<sockaddr*>(&addr),
+            static_cast<int>(sizeof(addr))) == SOCKET_ERROR ||
+        ::listen(sock, backlog) == SOCKET_ERROR)
+    {
+        DWORD dwError = ::WSAGetLastError();
+        ::closesocket(sock);
+        return make_err(dwError);
+    }
+
+    {
+        std::lock_guard<win_mutex> lock(impl.pool_mutex_);
+        impl.socket_ = sock;
+        impl.local_ = true;
+    }
+
+    if (unsigned n = sched_.options().accept_backlog)
+        impl.start_pool(n);
 
     return {};
 }
@@ -1012,14 +1931,31 @@ accept(
     // Create wrapper for the peer socket (service owns it)
     auto& peer_wrapper = svc_.create_impl();
 
+    if (!slots_.empty())
+    {
+        // Park until the pool has a connection, see "Accept Pool"
+        op.accepted_socket = INVALID_SOCKET;
+        op.peer_wrapper = &peer_wrapper;
+        op.listen_socket = socket_;
+        op.pool = this;
+        {
+            std::lock_guard<win_mutex> lock(pool_mutex_);
+            waiting_ = true;
+            svc_.work_started();
+            serve_waiter();
+            fill_pool();
+        }
+
+        // A stop requested before parking found nothing to cancel
+        if (op.cancelled.load(std::memory_order_acquire))
+            cancel_waiter();
+        return;
+    }
+
     // Create the accepted socket
-    SOCKET accepted = ::WSASocketW(
-        AF_INET,
-        SOCK_STREAM,
-        IPPROTO_TCP,
-        nullptr,
-        0,
-        WSA_FLAG_OVERLAPPED);
+    SOCKET accepted = local_
+        ? svc_.create_local_socket()
+        : svc_.create_socket(local_endpoint_.family());
 
     if (accepted == INVALID_SOCKET)
     {
@@ -1074,8 +2010,8 @@ accept(
         accepted,
         op.addr_buf,
         0,
-        sizeof(sockaddr_in) + 16,
-        sizeof(sockaddr_in) + 16,
+        sizeof(sockaddr_in6) + 16,
+        sizeof(sockaddr_in6) + 16,
         &bytes_received,
         &op);
 
@@ -1107,10 +2043,203 @@ accept(
     }
 }
 
+void
+win_acceptor_impl_internal::
+start_pool(unsigned n)
+{
+    std::lock_guard<win_mutex> lock(pool_mutex_);
+
+    // A re-listen keeps the slots; those still aborting rejoin the
+    // pool when their completion arrives
+    if (slots_.empty())
+    {
+        slots_.reserve(n);
+        idle_slots_.reserve(n);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            slots_.push_back(std::make_unique<accept_slot>(*this));
+            idle_slots_.push_back(slots_.back().get());
+        }
+    }
+    fill_pool();
+}
+
+void
+win_acceptor_impl_internal::
+fill_pool()
+{
+    auto accept_ex = svc_.accept_ex();
+
+    // Slots in flight plus queued sockets never exceed the pool size
+    while (socket_ != INVALID_SOCKET && accept_ex && pool_error_ == 0 &&
+           accepted_.size() < idle_slots_.size())
+    {
+        auto* slot = idle_slots_.back();
+        idle_slots_.pop_back();
+        if (!post_slot(*slot, accept_ex))
+        {
+            idle_slots_.push_back(slot);
+            break;
+        }
+    }
+}
+
+bool
+win_acceptor_impl_internal::
+post_slot(accept_slot& slot, LPFN_ACCEPTEX accept_ex)
+{
+    SOCKET accepted = local_
+        ? svc_.create_local_socket()
+        : svc_.create_socket(local_endpoint_.family());
+    if (accepted == INVALID_SOCKET)
+    {
+        pool_error_ = ::WSAGetLastError();
+        return false;
+    }
+
+    HANDLE result = ::CreateIoCompletionPort(
+        reinterpret_cast<HANDLE>(accepted),
+        svc_.native_handle(),
+        reinterpret_cast<ULONG_PTR>(svc_.io_key()),
+        0);
+
+    if (result == nullptr)
+    {
+        pool_error_ = ::GetLastError();
+        ::closesocket(accepted);
+        return false;
+    }
+
+    ::SetFileCompletionNotificationModes(
+        reinterpret_cast<HANDLE>(accepted),
+        FILE_SKIP_COMPLETION_PORT_ON_SUCCESS);
+
+    slot.reset();
+    slot.accepted_socket = accepted;
+    slot.acceptor_ptr = shared_from_this();
+
+    DWORD bytes_received = 0;
+    BOOL ok = accept_ex(
+        socket_,
+        accepted,
+        slot.addr_buf,
+        0,
+        sizeof(sockaddr_in6) + 16,
+        sizeof(sockaddr_in6) + 16,
+        &bytes_received,
+        &slot);
+
+    if (!ok)
+    {
+        DWORD err = ::WSAGetLastError();
+        if (err != ERROR_IO_PENDING)
+        {
+            ::closesocket(accepted);
+            slot.accepted_socket = INVALID_SOCKET;
+            slot.acceptor_ptr.reset();  // The caller holds another reference
+            pool_error_ = err;
+            return false;
+        }
+    }
+    else if (::InterlockedCompareExchange(&slot.ready_, 1, 0) == 0)
+    {
+        // Synchronous completion, queued here instead of by the port
+        slot.accepted_socket = INVALID_SOCKET;
+        slot.acceptor_ptr.reset();
+        accepted_.push_back(accepted);
+        idle_slots_.push_back(&slot);
+    }
+    return true;
+}
+
+void
+win_acceptor_impl_internal::
+serve_waiter()
+{
+    if (!waiting_ || (accepted_.empty() && pool_error_ == 0))
+        return;
+
+    waiting_ = false;
+    if (!accepted_.empty())
+    {
+        acc_.accepted_socket = accepted_.front();
+        accepted_.pop_front();
+    }
+    else
+    {
+        acc_.dwError = pool_error_;
+        pool_error_ = 0;
+    }
+
+    // The post counts the op again, so retire its parked unit
+    svc_.post(&acc_);
+    svc_.work_finished();
+}
+
+void
+win_acceptor_impl_internal::
+cancel_waiter() noexcept
+{
+    std::lock_guard<win_mutex> lock(pool_mutex_);
+    if (!waiting_)
+        return;
+
+    waiting_ = false;
+    svc_.post(&acc_);
+    svc_.work_finished();
+}
+
+void
+win_acceptor_impl_internal::
+on_slot_complete(accept_slot& slot)
+{
+    // Declared before the lock so the acceptor outlives it
+    std::shared_ptr<win_acceptor_impl_internal> self;
+    std::lock_guard<win_mutex> lock(pool_mutex_);
+    self = std::move(slot.acceptor_ptr);
+
+    // The handler scope retires a unit, which the slot holds only if
+    // the acceptor closed while it was in flight
+    if (!slot.holds_work)
+        svc_.work_started();
+    slot.holds_work = false;
+
+    SOCKET accepted = slot.accepted_socket;
+    slot.accepted_socket = INVALID_SOCKET;
+    idle_slots_.push_back(&slot);
+
+    if (slot.dwError == 0 && socket_ != INVALID_SOCKET)
+    {
+        accepted_.push_back(accepted);
+    }
+    else
+    {
+        ::closesocket(accepted);
+
+        // Aborts come from close() or a re-listen, and a connection
+        // reset before it was accepted is simply dropped
+        if (socket_ != INVALID_SOCKET &&
+            slot.dwError != ERROR_OPERATION_ABORTED &&
+            slot.dwError != ERROR_NETNAME_DELETED)
+            pool_error_ = slot.dwError;
+    }
+
+    serve_waiter();
+    fill_pool();
+}
+
 void
 win_acceptor_impl_internal::
 cancel() noexcept
 {
+    if (!slots_.empty())
+    {
+        // Only the waiter is cancelled; the pool stays posted
+        acc_.request_cancel();
+        cancel_waiter();
+        return;
+    }
+
     if (socket_ != INVALID_SOCKET)
     {
         ::CancelIoEx(
@@ -1125,14 +2254,43 @@ void
 win_acceptor_impl_internal::
 close_socket() noexcept
 {
-    if (socket_ != INVALID_SOCKET)
+    bool parked = false;
     {
-        ::closesocket(socket_);
-        socket_ = INVALID_SOCKET;
+        // Slot completions read socket_ under the pool lock
+        std::lock_guard<win_mutex> lock(pool_mutex_);
+
+        if (socket_ != INVALID_SOCKET)
+        {
+            ::closesocket(socket_);
+            socket_ = INVALID_SOCKET;
+        }
+
+        // Clear cached endpoint
+        local_endpoint_ = endpoint{};
+
+        // The closed socket aborts every slot in flight; count them as
+        // work so that run() and shutdown wait for their completions
+        for (auto& slot : slots_)
+        {
+            if (slot->acceptor_ptr && !slot->holds_work)
+            {
+                slot->holds_work = true;
+                svc_.work_started();
+            }
+        }
+
+        for (SOCKET accepted : accepted_)
+            ::closesocket(accepted);
+        accepted_.clear();
+        pool_error_ = 0;
+        parked = waiting_;
     }
 
-    // Clear cached endpoint
-    local_endpoint_ = endpoint{};
+    if (parked)
+    {
+        acc_.request_cancel();
+        cancel_waiter();
+    }
 }
 
 void
@@ -17,20 +17,30 @@
 #include <boost/corosio/detail/config.hpp>
 #include <boost/corosio/acceptor.hpp>
 #include <boost/corosio/socket.hpp>
+#include <boost/corosio/socket_stats.hpp>
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/segment_array.hpp"
 
 #include "src/detail/iocp/windows.hpp"
+#include "src/detail/iocp/afd.hpp"
 #include "src/detail/iocp/completion_key.hpp"
 #include "src/detail/iocp/overlapped_op.hpp"
 #include "src/detail/iocp/mutex.hpp"
+#include "src/detail/iocp/rio.hpp"
 #include "src/detail/iocp/wsa_init.hpp"
 
+#include <deque>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include <MSWSock.h>
 #include <Ws2tcpip.h>
+#include <afunix.h>
 
 namespace boost::corosio::detail {
 
@@ -56,13 +66,60 @@ struct connect_op : overlapped_op
     void do_cancel() noexcept override;
 };
 
+/** The most buffers one WSARecv or WSASend call is given.
+
+    Winsock has no fixed limit; this matches the usual POSIX
+    `IOV_MAX` so a sequence is cut at the same place everywhere.
+*/
+inline constexpr std::size_t max_wsabufs = 1024;
+
+using wsabuf_array = segment_array<WSABUF>;
+
+/// Fill the descriptors of an overlapped read or write.
+inline std::size_t
+assign_wsabufs(
+    wsabuf_array& a,
+    io_buffer_param p,
+    std::size_t max = max_wsabufs)
+{
+    return a.assign(p, max,
+        [](capy::mutable_buffer b) noexcept
+        {
+            WSABUF w;
+            w.buf = static_cast<char*>(b.data());
+            w.len = static_cast<ULONG>(b.size());
+            return w;
+        });
+}
+
+/** Drop `n` transferred bytes from the front of the descriptors.
+
+    @return `true` if no bytes are left.
+*/
+inline bool
+consume_wsabufs(wsabuf_array& a, std::size_t n) noexcept
+{
+    while (!a.empty() && n >= a[0].len)
+    {
+        n -= a[0].len;
+        a.pop_front();
+    }
+    if (!a.empty())
+    {
+        a[0].buf += n;
+        a[0].len -= static_cast<ULONG>(n);
+    }
+    return a.empty();
+}
+
 /** Read operation state with buffer descriptors. */
 struct read_op : overlapped_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    WSABUF wsabufs[max_buffers];
-    DWORD wsabuf_count = 0;
+    wsabuf_array wsabufs;
     DWORD flags = 0;
+    bool transfer_all = false;  // read_exact, see "Transfer All"
+    bool polling = false;       // a wait polling AFD, see "AFD Polling"
+    afd_poll_info poll_info{};
     win_socket_impl_internal& internal;
     std::shared_ptr<win_socket_impl_internal> internal_ptr;  // Keeps internal alive during I/O
 
@@ -73,12 +130,22 @@ struct read_op : overlapped_op
     void do_cancel() noexcept override;
 };
 
+/// The most bytes one TransmitFile call is given.
+inline constexpr std::size_t max_transmit_file = 0x7ffffffe;
+
 /** Write operation state with buffer descriptors. */
 struct write_op : overlapped_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    WSABUF wsabufs[max_buffers];
-    DWORD wsabuf_count = 0;
+    wsabuf_array wsabufs;
+    bool transfer_all = false;  // write_all, see "Transfer All"
+
+    // send_file, see "File Transmission"
+    HANDLE file = nullptr;
+    std::uint64_t file_offset = 0;
+    std::size_t file_remaining = 0;
+    DWORD file_chunk = 0;
+    bool polling = false;       // a wait polling AFD, see "AFD Polling"
+    afd_poll_info poll_info{};
     win_socket_impl_internal& internal;
     std::shared_ptr<win_socket_impl_internal> internal_ptr;  // Keeps internal alive during I/O
 
@@ -96,16 +163,41 @@ struct accept_op : overlapped_op
     std::shared_ptr<win_acceptor_impl_internal> acceptor_ptr;  // Keeps acceptor alive during I/O
     SOCKET listen_socket = INVALID_SOCKET;  // For SO_UPDATE_ACCEPT_CONTEXT
     io_object::io_object_impl** impl_out = nullptr;  // Output: wrapper for awaitable
+    win_acceptor_impl_internal* pool = nullptr;  // Set when served by an accept pool
     // Buffer for AcceptEx: local + remote addresses
     char addr_buf[2 * (sizeof(sockaddr_in6) + 16)];
 
     /** Resume the coroutine after accept completes. */
     void operator()() override;
 
-    /** Cancel the pending accept via CancelIoEx. */
+    /** Cancel the pending accept via CancelIoEx, or release it from the pool. */
     void do_cancel() noexcept override;
 };
 
+/** A pre-posted AcceptEx of an acceptor's accept pool.
+
+    Slots do not count as work while the acceptor is open, so a
+    listening acceptor does not keep `run()` from returning; see
+    iocp_options::accept_backlog.
+*/
+struct accept_slot : overlapped_op
+{
+    win_acceptor_impl_internal& acceptor;
+    std::shared_ptr<win_acceptor_impl_internal> acceptor_ptr;  // Held while in flight
+    SOCKET accepted_socket = INVALID_SOCKET;
+    bool holds_work = false;  // Counted as work once the acceptor closed
+    // Buffer for AcceptEx: local + remote addresses
+    char addr_buf[2 * (sizeof(sockaddr_in6) + 16)];
+
+    explicit accept_slot(win_acceptor_impl_internal& a) noexcept : acceptor(a) {}
+
+    /** Queue the accepted socket and re-post the pool. */
+    void operator()() override;
+
+    /** Close the accepted socket during shutdown. */
+    void destroy() override;
+};
+
 //------------------------------------------------------------------------------
 
 /** Internal socket state for IOCP-based I/O.
@@ -131,6 +223,10 @@ class win_socket_impl_internal
     read_op rd_;
     write_op wr_;
     SOCKET socket_ = INVALID_SOCKET;
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    RIO_RQ rq_ = RIO_INVALID_RQ;    // set when the socket uses registered I/O
+    win_mutex rq_mutex_;             // RIO request queues are not thread-safe
+#endif
 
 public:
     explicit win_socket_impl_internal(win_sockets& svc) noexcept;
@@ -143,31 +239,70 @@ public:
         capy::executor_ref,
         endpoint,
         std::stop_token,
-        system::error_code*);
+        system::error_code*,
+        capy::const_buffer data = {},
+        std::size_t* bytes = nullptr);
 
-    void read_some(
+    bool read_some(
         capy::coro,
         capy::executor_ref,
         io_buffer_param,
         std::stop_token,
         system::error_code*,
-        std::size_t*);
+        std::size_t*,
+        bool all = false);
 
-    void write_some(
+    bool write_some(
         capy::coro,
         capy::executor_ref,
         io_buffer_param,
         std::stop_token,
         system::error_code*,
+        std::size_t*,
+        bool all = false);
+
+    bool send_file(
+        capy::coro,
+        capy::executor_ref,
+        HANDLE,
+        std::uint64_t,
+        std::size_t,
+        std::stop_token,
+        system::error_code*,
         std::size_t*);
 
+    bool wait(
+        capy::coro,
+        capy::executor_ref,
+        socket::wait_type,
+        std::stop_token,
+        system::error_code*);
+
+    // wait() through win_afd, see "AFD Polling"
+    bool poll(
+        capy::coro,
+        capy::executor_ref,
+        socket::wait_type,
+        std::stop_token,
+        system::error_code*);
+
+    bool continue_read(read_op& op) noexcept;
+    bool continue_write(write_op& op) noexcept;
+
+    // Add a finished read or write to the counters, see "Counters"
+    void count(overlapped_op const& op, bool read) const noexcept;
+    bool continue_send_file(write_op& op) noexcept;
+    bool transmit_part(write_op& op) noexcept;
+
     SOCKET native_handle() const noexcept { return socket_; }
     endpoint local_endpoint() const noexcept { return local_endpoint_; }
     endpoint remote_endpoint() const noexcept { return remote_endpoint_; }
     bool is_open() const noexcept { return socket_ != INVALID_SOCKET; }
     void cancel() noexcept;
     void close_socket() noexcept;
-    void set_socket(SOCKET s) noexcept { socket_ = s; }
+    void set_socket(SOCKET s) noexcept;
+    void set_high_priority(bool value) noexcept;
+    bool high_priority() const noexcept { return rd_.high_priority; }
     void set_endpoints(endpoint local, endpoint remote) noexcept
     {
         local_endpoint_ = local;
@@ -188,9 +323,10 @@ private:
 
     @note Internal implementation detail. Users interact with socket class.
 */
-class win_socket_impl
+class win_socket_impl final
     : public socket::socket_impl
     , public intrusive_list<win_socket_impl>::node
+    , public recycling_op<win_socket_impl>
 {
     std::shared_ptr<win_socket_impl_internal> internal_;
 
@@ -212,7 +348,19 @@ public:
         internal_->connect(h, d, ep, token, ec);
     }
 
-    void read_some(
+    void connect_with_data(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        endpoint ep,
+        capy::const_buffer data,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        internal_->connect(h, d, ep, token, ec, data, bytes);
+    }
+
+    bool read_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param buf,
@@ -220,10 +368,10 @@ public:
         system::error_code* ec,
         std::size_t* bytes) override
     {
-        internal_->read_some(h, d, buf, token, ec, bytes);
+        return internal_->read_some(h, d, buf, token, ec, bytes);
     }
 
-    void write_some(
+    bool write_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param buf,
@@ -231,7 +379,49 @@ public:
         system::error_code* ec,
         std::size_t* bytes) override
     {
-        internal_->write_some(h, d, buf, token, ec, bytes);
+        return internal_->write_some(h, d, buf, token, ec, bytes);
+    }
+
+    bool read_exact(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        io_buffer_param buf,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return internal_->read_some(h, d, buf, token, ec, bytes, true);
+    }
+
+    bool write_all(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        io_buffer_param buf,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return internal_->write_some(h, d, buf, token, ec, bytes, true);
+    }
+
+    bool send_file(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        native_file_type file,
+        std::uint64_t offset,
+        std::size_t count,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override;
+
+    bool wait(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        socket::wait_type w,
+        std::stop_token token,
+        system::error_code* ec) override
+    {
+        return internal_->wait(h, d, w, token, ec);
     }
 
     system::error_code shutdown(socket::shutdown_type what) noexcept override
@@ -373,6 +563,18 @@ public:
         return {.enabled = lg.l_onoff != 0, .timeout = lg.l_linger};
     }
 
+    system::error_code set_high_priority_completions(bool value) noexcept override
+    {
+        internal_->set_high_priority(value);
+        return {};
+    }
+
+    bool high_priority_completions(system::error_code& ec) const noexcept override
+    {
+        ec = {};
+        return internal_->high_priority();
+    }
+
     endpoint local_endpoint() const noexcept override
     {
         return internal_->local_endpoint();
@@ -406,6 +608,8 @@ class win_acceptor_impl_internal
 {
     friend class win_sockets;
     friend class win_acceptor_impl;
+    friend struct accept_op;
+    friend struct accept_slot;
 
 public:
     explicit win_acceptor_impl_internal(win_sockets& svc) noexcept;
@@ -430,9 +634,25 @@ public:
     accept_op acc_;
 
 private:
+    void start_pool(unsigned n);
+    void fill_pool();
+    bool post_slot(accept_slot& slot, LPFN_ACCEPTEX accept_ex);
+    void serve_waiter();
+    void cancel_waiter() noexcept;
+    void on_slot_complete(accept_slot& slot);
+
     win_sockets& svc_;
     SOCKET socket_ = INVALID_SOCKET;
     endpoint local_endpoint_;
+    bool local_ = false;    // AF_UNIX, accepted sockets are too
+
+    // Accept pool, see iocp_options::accept_backlog; guarded by pool_mutex_
+    win_mutex pool_mutex_;
+    std::vector<std::unique_ptr<accept_slot>> slots_;
+    std::vector<accept_slot*> idle_slots_;  // Slots not in flight
+    std::deque<SOCKET> accepted_;           // Accepted, not yet claimed
+    DWORD pool_error_ = 0;                  // Reported by the next accept()
+    bool waiting_ = false;                  // acc_ parked for a connection
 };
 
 //------------------------------------------------------------------------------
@@ -444,9 +664,10 @@ private:
 
     @note Internal implementation detail. Users interact with acceptor class.
 */
-class win_acceptor_impl
+class win_acceptor_impl final
     : public acceptor::acceptor_impl
     , public intrusive_list<win_acceptor_impl>::node
+    , public recycling_op<win_acceptor_impl>
 {
     std::shared_ptr<win_acceptor_impl_internal> internal_;
 
@@ -473,6 +694,11 @@ public:
         return internal_->local_endpoint();
     }
 
+    native_handle_type native_handle() const noexcept override
+    {
+        return static_cast<native_handle_type>(internal_->native_handle());
+    }
+
     void cancel() noexcept override
     {
         internal_->cancel();
@@ -490,7 +716,7 @@ public:
 
     - Socket implementation allocation and deallocation
     - IOCP handle association for sockets
-    - Function pointer loading for ConnectEx/AcceptEx
+    - Function pointer loading for ConnectEx/AcceptEx/TransmitFile
     - Graceful shutdown - destroys all implementations when io_context stops
 
     @par Thread Safety
@@ -540,10 +766,23 @@ public:
 
     /** Create and register a socket with the IOCP.
 
+        @param impl The socket implementation internal to initialize.
+        @param family The address family of the socket.
+        @return Error code, or success.
+    */
+    system::error_code open_socket(
+        win_socket_impl_internal& impl,
+        ip_family family);
+
+    /** Create an AF_UNIX stream socket and register it with IOCP.
+
+        Requires Windows 10 version 1803 or later.
+
         @param impl The socket implementation internal to initialize.
         @return Error code, or success.
     */
-    system::error_code open_socket(win_socket_impl_internal& impl);
+    system::error_code open_local_socket(
+        win_socket_impl_internal& impl);
 
     /** Create a new acceptor implementation wrapper.
         The service owns the returned object.
@@ -564,26 +803,73 @@ public:
 
         @param impl The acceptor implementation internal to initialize.
         @param ep The local endpoint to bind to.
-        @param backlog The listen backlog.
+        @param opts The listen options; `reuse_port` and
+            `cpu_steering` must be false, Windows has no SO_REUSEPORT.
         @return Error code, or success.
     */
     system::error_code open_acceptor(
         win_acceptor_impl_internal& impl,
         endpoint ep,
+        acceptor::listen_options const& opts);
+
+    /** Create, bind, and listen on an AF_UNIX acceptor socket.
+
+        @param impl The acceptor implementation internal to initialize.
+        @param path The socket path to bind to.
+        @param backlog The maximum length of the pending queue.
+        @return Error code, or success.
+    */
+    system::error_code open_local_acceptor(
+        win_acceptor_impl_internal& impl,
+        std::string_view path,
         int backlog);
 
     /** Return the IOCP handle. */
     void* native_handle() const noexcept { return iocp_; }
 
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    /** Return the RIO state, or nullptr if sockets use overlapped I/O only. */
+    win_rio* rio() const noexcept { return rio_.get(); }
+#else
+    void* rio() const noexcept { return nullptr; }
+#endif
+
+    /** Return the AFD poller, or nullptr if waits use zero-byte receives. */
+    win_afd* afd() const noexcept { return afd_.get(); }
+
+    /** Create an overlapped socket, suitable for RIO when it is in use. */
+    SOCKET create_socket(ip_family family) const noexcept;
+
+    /** Create an overlapped AF_UNIX stream socket.
+
+        RIO does not support local sockets, so these never use it.
+    */
+    SOCKET create_local_socket() const noexcept;
+
+    /** Give a socket a RIO request queue when RIO is in use.
+
+        On failure the socket keeps using overlapped I/O only.
+    */
+    void attach_rio(win_socket_impl_internal& impl) noexcept;
+
     /** Return the completion key for associating sockets with IOCP. */
     completion_key* io_key() noexcept { return &overlapped_key_; }
 
+    /** Add the socket counters and the number of open sockets to `st`. */
+    void collect_stats(socket_stats& st) noexcept;
+
+    /** Return the scheduler completions are dispatched by. */
+    win_scheduler& scheduler() const noexcept { return sched_; }
+
     /** Return the ConnectEx function pointer. */
     LPFN_CONNECTEX connect_ex() const noexcept { return connect_ex_; }
 
     /** Return the AcceptEx function pointer. */
     LPFN_ACCEPTEX accept_ex() const noexcept { return accept_ex_; }
 
+    /** Return the TransmitFile function pointer. */
+    LPFN_TRANSMITFILE transmit_file() const noexcept { return transmit_file_; }
+
     /** Post an overlapped operation for completion. */
     void post(overlapped_op* op);
 
@@ -603,6 +889,7 @@ private:
             LPOVERLAPPED overlapped) override;
 
         void destroy(LPOVERLAPPED overlapped) override;
+        bool high_priority(LPOVERLAPPED overlapped) const noexcept override;
     };
 
     void load_extension_functions();
@@ -617,6 +904,11 @@ private:
     void* iocp_;
     LPFN_CONNECTEX connect_ex_ = nullptr;
     LPFN_ACCEPTEX accept_ex_ = nullptr;
+    LPFN_TRANSMITFILE transmit_file_ = nullptr;
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    std::unique_ptr<win_rio> rio_;
+#endif
+    std::unique_ptr<win_afd> afd_;
 };
 
 } // namespace boost::corosio::detail
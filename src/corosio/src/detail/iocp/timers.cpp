@@ -14,18 +14,42 @@
 #include "src/detail/iocp/timers.hpp"
 #include "src/detail/iocp/timers_nt.hpp"
 #include "src/detail/iocp/timers_thread.hpp"
+#include "src/detail/iocp/windows.hpp"
+
+// Declared by SDKs from Windows 10 version 1803 on
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
 namespace boost::corosio::detail {
 
 std::unique_ptr<win_timers>
-make_win_timers(void* iocp, long* dispatch_required)
+make_win_timers(void* iocp, long* dispatch_required, bool high_resolution)
 {
     // Try NT native API first (Windows 8+)
-    if (auto p = win_timers_nt::try_create(iocp, dispatch_required))
+    if (auto p = win_timers_nt::try_create(
+            iocp, dispatch_required, high_resolution))
         return p;
 
     // Fall back to dedicated thread
-    return std::make_unique<win_timers_thread>(iocp, dispatch_required);
+    return std::make_unique<win_timers_thread>(
+        iocp, dispatch_required, high_resolution);
+}
+
+void*
+create_waitable_timer(bool high_resolution) noexcept
+{
+    // Older systems reject the flag with ERROR_INVALID_PARAMETER
+    if (high_resolution)
+    {
+        if (HANDLE h = ::CreateWaitableTimerExW(
+                nullptr,
+                nullptr,
+                CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                TIMER_ALL_ACCESS))
+            return h;
+    }
+    return ::CreateWaitableTimerW(nullptr, FALSE, nullptr);
 }
 
 } // namespace boost::corosio::detail
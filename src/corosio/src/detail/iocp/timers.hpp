@@ -56,8 +56,22 @@ public:
     }
 };
 
+/** Create the timer wakeup mechanism of a scheduler.
+
+    @param high_resolution Create the waitable timer with
+        `CREATE_WAITABLE_TIMER_HIGH_RESOLUTION` where available.
+*/
 std::unique_ptr<win_timers> make_win_timers(
-    void* iocp, long* dispatch_required);
+    void* iocp, long* dispatch_required, bool high_resolution);
+
+/** Create an auto-reset waitable timer.
+
+    Falls back to an ordinary timer where a high resolution one
+    cannot be created.
+
+    @return The timer handle, or nullptr on failure.
+*/
+void* create_waitable_timer(bool high_resolution) noexcept;
 
 } // namespace boost::corosio::detail
 
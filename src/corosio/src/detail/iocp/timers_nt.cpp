@@ -43,6 +43,7 @@ win_timers_nt::
 win_timers_nt(
     void* iocp,
     long* dispatch_required,
+    bool high_resolution,
     void* nt_create,
     void* nt_assoc,
     void* nt_cancel)
@@ -52,12 +53,12 @@ win_timers_nt(
     , nt_associate_wait_completion_packet_(nt_assoc)
     , nt_cancel_wait_completion_packet_(nt_cancel)
 {
-    waitable_timer_ = ::CreateWaitableTimerW(nullptr, FALSE, nullptr);
+    waitable_timer_ = create_waitable_timer(high_resolution);
 }
 
 std::unique_ptr<win_timers_nt>
 win_timers_nt::
-try_create(void* iocp, long* dispatch_required)
+try_create(void* iocp, long* dispatch_required, bool high_resolution)
 {
     HMODULE ntdll = ::GetModuleHandleW(L"ntdll.dll");
     if (!ntdll)
@@ -71,7 +72,7 @@ try_create(void* iocp, long* dispatch_required)
         return nullptr;
 
     auto p = std::unique_ptr<win_timers_nt>(new win_timers_nt(
-        iocp, dispatch_required,
+        iocp, dispatch_required, high_resolution,
         reinterpret_cast<void*>(nt_create),
         reinterpret_cast<void*>(nt_assoc),
         reinterpret_cast<void*>(nt_cancel)));
@@ -30,6 +30,7 @@ class win_timers_nt final : public win_timers
     win_timers_nt(
         void* iocp,
         long* dispatch_required,
+        bool high_resolution,
         void* nt_create,
         void* nt_assoc,
         void* nt_cancel);
@@ -37,7 +38,7 @@ class win_timers_nt final : public win_timers
 public:
     // Returns nullptr if NT APIs unavailable (pre-Windows 8)
     static std::unique_ptr<win_timers_nt> try_create(
-        void* iocp, long* dispatch_required);
+        void* iocp, long* dispatch_required, bool high_resolution);
 
     ~win_timers_nt();
 
@@ -17,11 +17,14 @@
 namespace boost::corosio::detail {
 
 win_timers_thread::
-win_timers_thread(void* iocp, long* dispatch_required) noexcept
+win_timers_thread(
+    void* iocp,
+    long* dispatch_required,
+    bool high_resolution) noexcept
     : win_timers(dispatch_required)
     , iocp_(iocp)
 {
-    waitable_timer_ = ::CreateWaitableTimerW(nullptr, FALSE, nullptr);
+    waitable_timer_ = create_waitable_timer(high_resolution);
 }
 
 win_timers_thread::
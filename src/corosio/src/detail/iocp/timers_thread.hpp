@@ -27,7 +27,8 @@ class win_timers_thread final : public win_timers
     long shutdown_ = 0;
 
 public:
-    win_timers_thread(void* iocp, long* dispatch_required) noexcept;
+    win_timers_thread(
+        void* iocp, long* dispatch_required, bool high_resolution) noexcept;
     ~win_timers_thread();
 
     win_timers_thread(win_timers_thread const&) = delete;
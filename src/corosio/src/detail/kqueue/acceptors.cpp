@@ -0,0 +1,514 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_KQUEUE
+
+#include "src/detail/kqueue/acceptors.hpp"
+#include "src/detail/kqueue/sockets.hpp"
+#include "src/detail/endpoint_convert.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/posix/fast_open.hpp"
+#include "src/detail/posix/listener.hpp"
+#include "src/detail/posix/reuseport.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+//------------------------------------------------------------------------------
+// kqueue_accept_op::cancel
+//------------------------------------------------------------------------------
+
+void
+kqueue_accept_op::
+cancel() noexcept
+{
+    if (acceptor_impl_)
+        acceptor_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+//------------------------------------------------------------------------------
+// kqueue_accept_op::operator() - creates peer socket and caches endpoints
+//------------------------------------------------------------------------------
+
+void
+kqueue_accept_op::
+operator()()
+{
+    stop_cb.reset();
+
+    bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+
+    if (ec_out)
+    {
+        if (cancelled.load(std::memory_order_acquire))
+            *ec_out = capy::error::canceled;
+        else if (errn != 0)
+            *ec_out = make_err(errn);
+        else
+            *ec_out = {};
+    }
+
+    if (success && accepted_fd >= 0)
+    {
+        if (acceptor_impl_)
+        {
+            auto* socket_svc = static_cast<kqueue_acceptor_impl*>(acceptor_impl_)
+                ->service().socket_service();
+            if (socket_svc)
+            {
+                auto& impl = static_cast<kqueue_socket_impl&>(socket_svc->create_impl());
+                // set_socket takes ownership of the fd, closing it on failure
+                if (auto reg_ec = impl.set_socket(accepted_fd))
+                {
+                    accepted_fd = -1;
+                    impl.release();
+                    if (ec_out)
+                        *ec_out = reg_ec;
+                    if (impl_out)
+                        *impl_out = nullptr;
+
+                    capy::executor_ref saved_ex( std::move( ex ) );
+                    capy::coro saved_h( std::move( h ) );
+                    impl_ptr.reset();
+                    saved_ex.dispatch( saved_h ).resume();
+                    return;
+                }
+
+                sockaddr_storage local_addr{};
+                socklen_t local_len = sizeof(local_addr);
+                sockaddr_storage remote_addr{};
+                socklen_t remote_len = sizeof(remote_addr);
+
+                endpoint local_ep, remote_ep;
+                if (::getsockname(accepted_fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+                    local_ep = from_sockaddr(local_addr);
+                if (::getpeername(accepted_fd, reinterpret_cast<sockaddr*>(&remote_addr), &remote_len) == 0)
+                    remote_ep = from_sockaddr(remote_addr);
+
+                impl.set_endpoints(local_ep, remote_ep);
+
+                if (impl_out)
+                    *impl_out = &impl;
+
+                accepted_fd = -1;
+            }
+            else
+            {
+                if (ec_out && !*ec_out)
+                    *ec_out = make_err(ENOENT);
+                ::close(accepted_fd);
+                accepted_fd = -1;
+                if (impl_out)
+                    *impl_out = nullptr;
+            }
+        }
+        else
+        {
+            ::close(accepted_fd);
+            accepted_fd = -1;
+            if (impl_out)
+                *impl_out = nullptr;
+        }
+    }
+    else
+    {
+        if (accepted_fd >= 0)
+        {
+            ::close(accepted_fd);
+            accepted_fd = -1;
+        }
+
+        if (peer_impl)
+        {
+            peer_impl->release();
+            peer_impl = nullptr;
+        }
+
+        if (impl_out)
+            *impl_out = nullptr;
+    }
+
+    // Move to stack before destroying the frame
+    capy::executor_ref saved_ex( std::move( ex ) );
+    capy::coro saved_h( std::move( h ) );
+    impl_ptr.reset();
+    saved_ex.dispatch( saved_h ).resume();
+}
+
+//------------------------------------------------------------------------------
+// kqueue_acceptor_impl
+//------------------------------------------------------------------------------
+
+kqueue_acceptor_impl::
+kqueue_acceptor_impl(kqueue_acceptor_service& svc) noexcept
+    : svc_(svc)
+{
+}
+
+void
+kqueue_acceptor_impl::
+release()
+{
+    close_socket();
+    svc_.destroy_acceptor_impl(*this);
+}
+
+void
+kqueue_acceptor_impl::
+accept(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    io_object::io_object_impl** impl_out)
+{
+    auto& op = acc_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.impl_out = impl_out;
+    op.fd = fd_;
+    op.start(token, this);
+
+    sockaddr_storage addr{};
+    socklen_t addrlen = sizeof(addr);
+    int accepted = ::accept(fd_, reinterpret_cast<sockaddr*>(&addr), &addrlen);
+
+    if (accepted >= 0)
+    {
+        if (int err = kqueue_prepare_descriptor(accepted))
+        {
+            ::close(accepted);
+            op.complete(err, 0);
+        }
+        else
+        {
+            op.accepted_fd = accepted;
+            op.complete(0, 0);
+        }
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return;
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+        svc_.work_started();
+
+        std::unique_lock lock(desc_->mutex);
+
+        // A connection arrived while nothing was parked; retry first
+        if (desc_->read_ready)
+        {
+            desc_->read_ready = false;
+            op.perform_io();
+            if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
+            {
+                lock.unlock();
+                op.impl_ptr = shared_from_this();
+                svc_.post(&op);
+                svc_.work_finished();
+                return;
+            }
+            op.errn = 0;
+        }
+
+        if (op.cancelled.load(std::memory_order_acquire))
+        {
+            lock.unlock();
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            svc_.work_finished();
+            return;
+        }
+
+        desc_->read_op = &op;
+        return;
+    }
+
+    op.complete(errno, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+}
+
+void
+kqueue_acceptor_impl::
+cancel() noexcept
+{
+    cancel_single_op(acc_);
+}
+
+void
+kqueue_acceptor_impl::
+cancel_single_op(kqueue_op& op) noexcept
+{
+    // Called from stop_token callback to cancel a specific pending operation.
+    op.request_cancel();
+
+    if (!desc_)
+        return;
+
+    {
+        std::lock_guard lock(desc_->mutex);
+        if (desc_->read_op != &op)
+            return;
+        desc_->read_op = nullptr;
+    }
+
+    // Keep impl alive until op completes
+    try {
+        op.impl_ptr = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        // Impl is being destroyed, op will be orphaned but that's ok
+    }
+
+    svc_.post(&op);
+    svc_.work_finished();
+}
+
+void
+kqueue_acceptor_impl::
+close_socket() noexcept
+{
+    cancel();
+
+    if (fd_ >= 0)
+    {
+        if (desc_)
+        {
+            svc_.scheduler().deregister_descriptor(fd_, desc_);
+            desc_ = nullptr;
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    // Clear cached endpoint
+    local_endpoint_ = endpoint{};
+}
+
+//------------------------------------------------------------------------------
+// kqueue_acceptor_service
+//------------------------------------------------------------------------------
+
+kqueue_acceptor_service::
+kqueue_acceptor_service(capy::execution_context& ctx)
+    : ctx_(ctx)
+    , state_(std::make_unique<kqueue_acceptor_state>(ctx.use_service<kqueue_scheduler>()))
+{
+}
+
+kqueue_acceptor_service::
+~kqueue_acceptor_service()
+{
+}
+
+void
+kqueue_acceptor_service::
+shutdown()
+{
+    std::lock_guard lock(state_->mutex_);
+
+    while (auto* impl = state_->acceptor_list_.pop_front())
+        impl->close_socket();
+
+    state_->acceptor_ptrs_.clear();
+}
+
+acceptor::acceptor_impl&
+kqueue_acceptor_service::
+create_acceptor_impl()
+{
+    auto impl = make_recycled_impl<kqueue_acceptor_impl>(*this);
+    auto* raw = impl.get();
+
+    std::lock_guard lock(state_->mutex_);
+    state_->acceptor_list_.push_back(raw);
+    state_->acceptor_ptrs_.emplace(raw, std::move(impl));
+
+    return *raw;
+}
+
+void
+kqueue_acceptor_service::
+destroy_acceptor_impl(acceptor::acceptor_impl& impl)
+{
+    auto* kqueue_impl = static_cast<kqueue_acceptor_impl*>(&impl);
+    std::lock_guard lock(state_->mutex_);
+    state_->acceptor_list_.remove(kqueue_impl);
+    state_->acceptor_ptrs_.erase(kqueue_impl);
+}
+
+system::error_code
+kqueue_acceptor_service::
+open_acceptor(
+    acceptor::acceptor_impl& impl,
+    endpoint ep,
+    acceptor::listen_options const& opts)
+{
+    auto* kqueue_impl = static_cast<kqueue_acceptor_impl*>(&impl);
+    kqueue_impl->close_socket();
+
+    int fd = ::socket(detail::to_af(ep.family()), SOCK_STREAM, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    if (int err = kqueue_prepare_descriptor(fd))
+    {
+        ::close(fd);
+        return make_err(err);
+    }
+
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (opts.reuse_port &&
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    // Set explicitly; the default differs between platforms
+    if (ep.is_v6())
+    {
+        int v6_only = opts.dual_stack ? 0 : 1;
+        if (::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY,
+                &v6_only, sizeof(v6_only)) < 0)
+        {
+            int errn = errno;
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (opts.fast_open_queue > 0)
+    {
+        int errn = detail::set_fast_open_queue(fd, opts.fast_open_queue);
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    if (::listen(fd, opts.backlog) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (opts.cpu_steering)
+    {
+        int errn = opts.reuse_port
+            ? detail::attach_cpu_steering(fd)
+            : EINVAL;
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    try {
+        kqueue_impl->desc_ = state_->sched_.register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
+    kqueue_impl->fd_ = fd;
+
+    // Cache the local endpoint (queries OS for ephemeral port if port was 0)
+    sockaddr_storage local_addr{};
+    socklen_t local_len = sizeof(local_addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+        kqueue_impl->set_local_endpoint(detail::from_sockaddr(local_addr));
+
+    return {};
+}
+
+system::error_code
+kqueue_acceptor_service::
+assign_acceptor(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd)
+{
+    auto* kqueue_impl = static_cast<kqueue_acceptor_impl*>(&impl);
+    kqueue_impl->close_socket();
+
+    endpoint local;
+    if (int errn = detail::prepare_inherited_listener(fd, local))
+        return make_err(errn);
+    if (int errn = kqueue_prepare_descriptor(fd))
+        return make_err(errn);
+
+    try {
+        kqueue_impl->desc_ = state_->sched_.register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        return e.code();
+    }
+    kqueue_impl->fd_ = fd;
+    kqueue_impl->set_local_endpoint(local);
+    return {};
+}
+
+void
+kqueue_acceptor_service::
+post(kqueue_op* op)
+{
+    state_->sched_.post(op);
+}
+
+void
+kqueue_acceptor_service::
+work_started() noexcept
+{
+    state_->sched_.work_started();
+}
+
+void
+kqueue_acceptor_service::
+work_finished() noexcept
+{
+    state_->sched_.work_finished();
+}
+
+kqueue_socket_service*
+kqueue_acceptor_service::
+socket_service() const noexcept
+{
+    auto* svc = ctx_.find_service<detail::socket_service>();
+    return svc ? dynamic_cast<kqueue_socket_service*>(svc) : nullptr;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_KQUEUE
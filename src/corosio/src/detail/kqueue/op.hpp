@@ -0,0 +1,447 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_KQUEUE_OP_HPP
+#define BOOST_COROSIO_DETAIL_KQUEUE_OP_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_KQUEUE
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/coro.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "src/detail/intrusive.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/resume_coro.hpp"
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/segment_array.hpp"
+#include "src/detail/endpoint_convert.hpp"
+
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/*
+    kqueue Operation State
+    ======================
+
+    Each async I/O operation has a corresponding kqueue_op-derived struct that
+    holds the operation's state while it's in flight. The socket impl owns
+    fixed slots for each operation type (conn_, rd_, wr_), so only one
+    operation of each type can be pending per socket at a time.
+
+    Persistent Registration
+    -----------------------
+    Every open socket and acceptor owns a kqueue_descriptor_state whose fd
+    is added to the kqueue exactly once, with EVFILT_READ and EVFILT_WRITE
+    filters set to EV_CLEAR so they behave edge-triggered. Operations that
+    would block park themselves in a slot on the kqueue_descriptor_state;
+    the reactor matches each filter event to the parked operation, so
+    steady-state I/O makes no kevent() changes.
+
+    Completion vs Cancellation Race
+    -------------------------------
+    The slots are protected by the kqueue_descriptor_state mutex. Whoever removes
+    an operation from its slot while holding the mutex "claims" it and is
+    responsible for completing it: the reactor when the I/O finishes, or
+    cancel(). The loser finds the slot empty and does nothing.
+
+    An edge delivered while no operation is parked is remembered in the
+    read_ready/write_ready flags. An operation that parks afterwards
+    retries its syscall first, since the kernel will not report that
+    edge again.
+
+    Impl Lifetime Management
+    ------------------------
+    When cancel() posts an op to the scheduler's ready queue, the socket impl
+    might be destroyed before the scheduler processes the op. The `impl_ptr`
+    member holds a shared_ptr to the impl, keeping it alive until the op
+    completes. This is set by cancel() in sockets.hpp and cleared in operator()
+    after the coroutine is resumed. Without this, closing a socket with pending
+    operations causes use-after-free.
+
+    EOF Detection
+    -------------
+    For reads, 0 bytes with no error means EOF. But an empty user buffer also
+    returns 0 bytes. The `empty_buffer_read` flag distinguishes these cases
+    so we don't spuriously report EOF when the user just passed an empty buffer.
+
+    Descriptor Setup
+    ----------------
+    Darwin has neither accept4() nor SOCK_NONBLOCK, so every new socket,
+    whether created or accepted, goes through kqueue_prepare_descriptor()
+    to become non-blocking and close-on-exec.
+
+    SIGPIPE Prevention
+    ------------------
+    Writes use sendmsg() so that MSG_NOSIGNAL can be passed where it
+    exists. Darwin lacks it; there kqueue_prepare_descriptor() sets the
+    SO_NOSIGPIPE socket option instead.
+*/
+
+namespace boost::corosio::detail {
+
+#ifdef MSG_NOSIGNAL
+inline constexpr int kqueue_send_flags = MSG_NOSIGNAL;
+#else
+inline constexpr int kqueue_send_flags = 0;
+#endif
+
+/** Configure a new socket for use with the reactor.
+
+    Makes `fd` non-blocking and close-on-exec and, where the platform
+    has it, sets SO_NOSIGPIPE.
+
+    @return 0 on success, otherwise the errno of the failed call.
+*/
+inline int
+kqueue_prepare_descriptor(int fd) noexcept
+{
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+        return errno;
+    if (::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
+        return errno;
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one)) == -1)
+        return errno;
+#endif
+    return 0;
+}
+
+// Forward declarations for cancellation support
+class kqueue_socket_impl;
+class kqueue_acceptor_impl;
+
+struct kqueue_op : scheduler_op
+{
+    struct canceller
+    {
+        kqueue_op* op;
+        void operator()() const noexcept;
+    };
+
+    capy::coro h;
+    capy::executor_ref ex;
+    system::error_code* ec_out = nullptr;
+    std::size_t* bytes_out = nullptr;
+
+    int fd = -1;
+    int errn = 0;
+    std::size_t bytes_transferred = 0;
+
+    std::atomic<bool> cancelled{false};
+    std::optional<std::stop_callback<canceller>> stop_cb;
+
+    // Prevents use-after-free when socket is closed with pending ops.
+    // See "Impl Lifetime Management" in file header.
+    std::shared_ptr<void> impl_ptr;
+
+    // For stop_token cancellation - pointer to owning socket/acceptor impl.
+    // When stop is requested, we call back to the impl to perform actual I/O cancellation.
+    kqueue_socket_impl* socket_impl_ = nullptr;
+    kqueue_acceptor_impl* acceptor_impl_ = nullptr;
+
+    kqueue_op()
+    {
+        data_ = this;
+    }
+
+    void reset() noexcept
+    {
+        fd = -1;
+        errn = 0;
+        bytes_transferred = 0;
+        cancelled.store(false, std::memory_order_relaxed);
+        impl_ptr.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = nullptr;
+    }
+
+    void operator()() override
+    {
+        stop_cb.reset();
+
+        if (ec_out)
+        {
+            if (cancelled.load(std::memory_order_acquire))
+                *ec_out = capy::error::canceled;
+            else if (errn != 0)
+                *ec_out = make_err(errn);
+            else if (is_read_operation() && bytes_transferred == 0)
+                *ec_out = capy::error::eof;
+            else
+                *ec_out = {};
+        }
+
+        if (bytes_out)
+            *bytes_out = bytes_transferred;
+
+        // Move to stack before destroying the frame
+        capy::executor_ref saved_ex( std::move( ex ) );
+        capy::coro saved_h( std::move( h ) );
+        impl_ptr.reset();
+        resume_coro(saved_ex, saved_h);
+    }
+
+    virtual bool is_read_operation() const noexcept { return false; }
+    virtual void cancel() noexcept = 0;
+
+    void destroy() override
+    {
+        stop_cb.reset();
+        impl_ptr.reset();
+    }
+
+    void request_cancel() noexcept
+    {
+        cancelled.store(true, std::memory_order_release);
+    }
+
+    void start(std::stop_token token)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = nullptr;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    void start(std::stop_token token, kqueue_socket_impl* impl)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = impl;
+        acceptor_impl_ = nullptr;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    void start(std::stop_token token, kqueue_acceptor_impl* impl)
+    {
+        cancelled.store(false, std::memory_order_release);
+        stop_cb.reset();
+        socket_impl_ = nullptr;
+        acceptor_impl_ = impl;
+
+        if (token.stop_possible())
+            stop_cb.emplace(token, canceller{this});
+    }
+
+    void complete(int err, std::size_t bytes) noexcept
+    {
+        errn = err;
+        bytes_transferred = bytes;
+    }
+
+    virtual void perform_io() noexcept {}
+};
+
+//------------------------------------------------------------------------------
+
+struct kqueue_connect_op : kqueue_op
+{
+    endpoint target_endpoint;
+
+    void reset() noexcept
+    {
+        kqueue_op::reset();
+        target_endpoint = endpoint{};
+    }
+
+    void perform_io() noexcept override
+    {
+        // Readiness may be spurious, e.g. the EOF reported when a socket
+        // is registered before connect() is called. Confirm that the
+        // connect has finished before reading its status.
+        pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+        if (::poll(&pfd, 1, 0) == 0)
+        {
+            complete(EAGAIN, 0);
+            return;
+        }
+
+        // connect() completion status is retrieved via SO_ERROR, not return value
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+            err = errno;
+        complete(err, 0);
+    }
+
+    // Defined in sockets.cpp where kqueue_socket_impl is complete
+    void operator()() override;
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct kqueue_read_op : kqueue_op
+{
+    iovec_array iovecs;
+    bool empty_buffer_read = false;
+
+    bool is_read_operation() const noexcept override
+    {
+        return !empty_buffer_read;
+    }
+
+    void reset() noexcept
+    {
+        kqueue_op::reset();
+        iovecs.clear();
+        empty_buffer_read = false;
+    }
+
+    void perform_io() noexcept override
+    {
+        ssize_t n = ::readv(fd, iovecs.data(), static_cast<int>(iovecs.size()));
+        if (n >= 0)
+            complete(0, static_cast<std::size_t>(n));
+        else
+            complete(errno, 0);
+    }
+
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct kqueue_write_op : kqueue_op
+{
+    iovec_array iovecs;
+
+    void reset() noexcept
+    {
+        kqueue_op::reset();
+        iovecs.clear();
+    }
+
+    void perform_io() noexcept override
+    {
+        msghdr msg{};
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
+
+        ssize_t n = ::sendmsg(fd, &msg, kqueue_send_flags);
+        if (n >= 0)
+            complete(0, static_cast<std::size_t>(n));
+        else
+            complete(errno, 0);
+    }
+
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+struct kqueue_accept_op : kqueue_op
+{
+    int accepted_fd = -1;
+    io_object::io_object_impl* peer_impl = nullptr;
+    io_object::io_object_impl** impl_out = nullptr;
+
+    void reset() noexcept
+    {
+        kqueue_op::reset();
+        accepted_fd = -1;
+        peer_impl = nullptr;
+        impl_out = nullptr;
+    }
+
+    void perform_io() noexcept override
+    {
+        sockaddr_storage addr{};
+        socklen_t addrlen = sizeof(addr);
+        int new_fd = ::accept(fd, reinterpret_cast<sockaddr*>(&addr), &addrlen);
+
+        if (new_fd >= 0)
+        {
+            // A blocking socket would stall the reactor; refuse it
+            if (int err = kqueue_prepare_descriptor(new_fd))
+            {
+                ::close(new_fd);
+                complete(err, 0);
+                return;
+            }
+            accepted_fd = new_fd;
+            complete(0, 0);
+        }
+        else
+        {
+            complete(errno, 0);
+        }
+    }
+
+    // Defined in acceptors.cpp where kqueue_acceptor_impl is complete
+    void operator()() override;
+    void cancel() noexcept override;
+};
+
+//------------------------------------------------------------------------------
+
+/** Per-descriptor state for persistent kqueue registration.
+
+    The descriptor is registered once with EVFILT_READ and EVFILT_WRITE
+    filters, both EV_CLEAR, and `udata` pointing at this object.
+    Operations that would block are parked in the matching slot until
+    the reactor reports readiness.
+
+    All members are protected by `mutex`.
+
+    Instances are pooled by the scheduler and are not freed while it
+    is running. A reactor thread may still hold a pointer from an
+    earlier kevent() after the descriptor is closed; the pooled
+    state stays valid and at worst observes a spurious event, which
+    the retry-on-EAGAIN logic absorbs.
+*/
+struct kqueue_descriptor_state
+    : intrusive_list<kqueue_descriptor_state>::node
+{
+    std::mutex mutex;
+    int fd = -1;
+
+    kqueue_op* read_op = nullptr;
+    kqueue_op* write_op = nullptr;
+    kqueue_op* connect_op = nullptr;
+
+    // Edge seen while no operation was parked
+    bool read_ready = false;
+    bool write_ready = false;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_KQUEUE
+
+#endif // BOOST_COROSIO_DETAIL_KQUEUE_OP_HPP
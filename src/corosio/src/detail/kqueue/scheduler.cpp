@@ -0,0 +1,984 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_KQUEUE
+
+#include "src/detail/kqueue/scheduler.hpp"
+#include "src/detail/kqueue/op.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/posix/file_service.hpp"
+#include "src/detail/posix/resolver_service.hpp"
+#include "src/detail/posix/signals.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/thread_local_ptr.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+    kqueue Scheduler - Single Reactor Model
+    =======================================
+
+    The thread coordination strategy is the one used by epoll_scheduler:
+    one thread at a time becomes the "reactor" and waits in kevent(), the
+    others wait on a condition variable for handlers. Posts from outside
+    the scheduler go through the lock-free injected_ queue, and posts
+    made by a running handler are counted and staged in its run() frame
+    (see handler_scope), exactly as in the other POSIX backends.
+
+    Descriptor Registration
+    -----------------------
+    kqueue reports each direction as a separate event. Every socket and
+    acceptor adds an EVFILT_READ and an EVFILT_WRITE filter once, both
+    EV_CLEAR so they behave edge-triggered, with udata pointing at its
+    pooled kqueue_descriptor_state. An operation that would block parks
+    in a slot of that state; the reactor performs its I/O when the
+    matching filter fires. An event that finds no parked operation sets
+    a ready flag so the next operation retries instead of waiting.
+
+    EV_EOF is not treated as an error: the parked operation runs its
+    syscall and reports whatever the socket returns, which preserves
+    data received before the peer closed. EV_ERROR marks a failed
+    registration and completes the parked operation with the error.
+
+    Wakeups
+    -------
+    interrupt_reactor() triggers an EVFILT_USER event with NOTE_TRIGGER.
+    The event is EV_CLEAR, so harvesting it resets it; the reactor then
+    clears wakeup_pending_, and a burst of posts costs one trigger per
+    reactor sleep. Platforms without EVFILT_USER use a non-blocking
+    self-pipe instead, which the reactor drains before it clears the
+    flag, as the epoll reactor does with its eventfd.
+
+    Timers
+    ------
+    Timers are handled by timer_service. The reactor bounds the kevent()
+    timeout by the nearest expiry, and timer_service calls
+    interrupt_reactor() when an earlier timer is scheduled so the
+    timeout is recomputed. No EVFILT_TIMER filter is needed.
+
+    Embedding
+    ---------
+    A host event loop waits for the kqueue fd to become readable, for
+    at most poll_ready_timeout(), and calls poll_ready(). That makes
+    one zero-timeout pass as the reactor, then runs handlers as poll()
+    does without stopping the scheduler for lack of work. On return
+    it announces the reactor as sleeping, so a post from another
+    thread triggers the wakeup event and the fd turns readable. An
+    earlier timer triggers it too, and the host asks for the new
+    timeout.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+struct scheduler_context
+{
+    kqueue_scheduler const* key;
+    scheduler_context* next;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
+};
+
+corosio::detail::thread_local_ptr<scheduler_context> context_stack;
+
+// Returns the innermost run() frame of `sched` on this thread
+scheduler_context*
+find_context(kqueue_scheduler const* sched) noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
+
+#ifndef EVFILT_USER
+int
+set_nonblocking_cloexec(int fd) noexcept
+{
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+        return errno;
+    if (::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
+        return errno;
+    return 0;
+}
+#endif
+
+} // namespace
+
+/** Brackets one handler invocation inside run().
+
+    Posts made while the scope is active are counted and staged in the
+    frame. The destructor settles the count, including the handler's
+    own unit of work, and publishes the staged handlers.
+*/
+class kqueue_scheduler::handler_scope
+{
+    kqueue_scheduler const* sched_;
+    scheduler_context* frame_;
+
+public:
+    handler_scope(
+        kqueue_scheduler const* sched,
+        scheduler_context* frame) noexcept
+        : sched_(sched)
+        , frame_(frame)
+    {
+        frame_->in_handler = true;
+    }
+
+    ~handler_scope()
+    {
+        frame_->in_handler = false;
+        publish(sched_, *frame_, -1);
+    }
+
+    handler_scope(handler_scope const&) = delete;
+    handler_scope& operator=(handler_scope const&) = delete;
+
+    // Folds the frame's private work, plus `adjust`, into
+    // outstanding_work_ and then releases the staged handlers
+    static void
+    publish(
+        kqueue_scheduler const* sched,
+        scheduler_context& frame,
+        long adjust) noexcept
+    {
+        long n = frame.private_work + adjust;
+        frame.private_work = 0;
+
+        if (n > 0)
+            sched->outstanding_work_.fetch_add(n, std::memory_order_relaxed);
+
+        while (auto* h = frame.private_ops.pop())
+            sched->enqueue(h);
+
+        // Only the finished handler's own unit can make this negative
+        if (n < 0)
+            sched->work_finished();
+    }
+};
+
+/** Marks the calling thread as running inside the scheduler. */
+class kqueue_scheduler::run_scope
+{
+    scheduler_context frame_;
+
+public:
+    explicit run_scope(kqueue_scheduler const* sched) noexcept
+        : frame_{sched, context_stack.get()}
+    {
+        // A handler running a nested loop must not hide its posts
+        if (auto* outer = find_context(sched); outer && outer->in_handler)
+            handler_scope::publish(sched, *outer, 0);
+
+        context_stack.set(&frame_);
+    }
+
+    ~run_scope() noexcept
+    {
+        context_stack.set(frame_.next);
+    }
+
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
+};
+
+kqueue_scheduler::
+kqueue_scheduler(
+    capy::execution_context& ctx,
+    int)
+    : outstanding_work_(0)
+    , stopped_(false)
+    , shutdown_(false)
+    , reactor_running_(false)
+    , reactor_interrupted_(false)
+    , idle_thread_count_(0)
+{
+    kq_fd_ = ::kqueue();
+    if (kq_fd_ < 0)
+        detail::throw_system_error(make_err(errno), "kqueue");
+
+    if (::fcntl(kq_fd_, F_SETFD, FD_CLOEXEC) == -1)
+    {
+        int errn = errno;
+        ::close(kq_fd_);
+        detail::throw_system_error(make_err(errn), "fcntl");
+    }
+
+    struct kevent ev;
+#ifdef EVFILT_USER
+    EV_SET(&ev, 0, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+#else
+    if (::pipe(wake_pipe_) < 0)
+    {
+        int errn = errno;
+        ::close(kq_fd_);
+        detail::throw_system_error(make_err(errn), "pipe");
+    }
+    for (int fd : wake_pipe_)
+    {
+        if (int errn = set_nonblocking_cloexec(fd))
+        {
+            ::close(wake_pipe_[0]);
+            ::close(wake_pipe_[1]);
+            ::close(kq_fd_);
+            detail::throw_system_error(make_err(errn), "fcntl");
+        }
+    }
+    EV_SET(&ev, wake_pipe_[0], EVFILT_READ, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+#endif
+    if (::kevent(kq_fd_, &ev, 1, nullptr, 0, nullptr) < 0)
+    {
+        int errn = errno;
+        if (wake_pipe_[0] >= 0)
+        {
+            ::close(wake_pipe_[0]);
+            ::close(wake_pipe_[1]);
+        }
+        ::close(kq_fd_);
+        detail::throw_system_error(make_err(errn), "kevent");
+    }
+
+    timer_svc_ = &get_timer_service(ctx, *this);
+    timer_svc_->set_on_earliest_changed(
+        timer_service::callback(
+            this,
+            [](void* p) { static_cast<kqueue_scheduler*>(p)->interrupt_reactor(); }));
+
+    // Initialize resolver service
+    get_resolver_service(ctx, *this);
+
+    // Regular files cannot be waited for; workers run their I/O
+    get_file_service(ctx, *this);
+
+    // Initialize signal service
+    get_signal_service(ctx, *this);
+}
+
+kqueue_scheduler::
+~kqueue_scheduler()
+{
+    while (auto* desc = desc_live_.pop_front())
+        delete desc;
+    while (auto* desc = desc_free_.pop_front())
+        delete desc;
+
+    if (wake_pipe_[0] >= 0)
+        ::close(wake_pipe_[0]);
+    if (wake_pipe_[1] >= 0)
+        ::close(wake_pipe_[1]);
+    if (kq_fd_ >= 0)
+        ::close(kq_fd_);
+}
+
+void
+kqueue_scheduler::
+shutdown()
+{
+    {
+        std::unique_lock lock(mutex_);
+        shutdown_ = true;
+        injected_.pop_all(completed_ops_);
+
+        while (auto* h = completed_ops_.pop())
+        {
+            lock.unlock();
+            h->destroy();
+            lock.lock();
+        }
+    }
+
+    outstanding_work_.store(0, std::memory_order_release);
+
+    if (kq_fd_ >= 0)
+        interrupt_reactor();
+
+    wakeup_event_.notify_all();
+}
+
+void
+kqueue_scheduler::
+post(capy::coro h) const
+{
+    struct post_handler final
+        : scheduler_op
+        , recycling_op<post_handler>
+    {
+        capy::coro h_;
+
+        explicit
+        post_handler(capy::coro h)
+            : h_(h)
+        {
+        }
+
+        ~post_handler() = default;
+
+        void operator()() override
+        {
+            auto h = h_;
+            delete this;
+            h.resume();
+        }
+
+        void destroy() override
+        {
+            delete this;
+        }
+    };
+
+    auto ph = std::make_unique<post_handler>(h);
+    post(ph.release());
+}
+
+void
+kqueue_scheduler::
+post(scheduler_op* h) const
+{
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        c->private_ops.push(h);
+        return;
+    }
+
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(h);
+}
+
+void
+kqueue_scheduler::
+enqueue(scheduler_op* h) const
+{
+    injected_.push(h);
+
+    // Only pay for a wakeup when a consumer is actually parked, see
+    // the matching announcements in do_one() and run_reactor()
+    if (idle_thread_count_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(mutex_);
+        wakeup_event_.notify_one();
+    }
+    else if (reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+    {
+        interrupt_reactor();
+    }
+}
+
+void
+kqueue_scheduler::
+on_work_started() noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+kqueue_scheduler::
+on_work_finished() noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        stop();
+}
+
+bool
+kqueue_scheduler::
+running_in_this_thread() const noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == this)
+            return true;
+    return false;
+}
+
+void
+kqueue_scheduler::
+stop()
+{
+    bool expected = false;
+    if (stopped_.compare_exchange_strong(expected, true,
+            std::memory_order_release, std::memory_order_relaxed))
+    {
+        // Wake all threads so they notice stopped_ and exit
+        {
+            std::lock_guard lock(mutex_);
+            wakeup_event_.notify_all();
+        }
+        interrupt_reactor();
+    }
+}
+
+bool
+kqueue_scheduler::
+stopped() const noexcept
+{
+    return stopped_.load(std::memory_order_acquire);
+}
+
+void
+kqueue_scheduler::
+restart()
+{
+    stopped_.store(false, std::memory_order_release);
+}
+
+std::size_t
+kqueue_scheduler::
+run()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(-1))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+kqueue_scheduler::
+run_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(-1);
+}
+
+std::size_t
+kqueue_scheduler::
+wait_one(long usec)
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(usec);
+}
+
+std::size_t
+kqueue_scheduler::
+poll()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(0))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+kqueue_scheduler::
+poll_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(0);
+}
+
+std::size_t
+kqueue_scheduler::
+poll_ready()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    run_scope scope(this);
+
+    // Harvest what made the fd readable, see "Embedding"
+    {
+        std::unique_lock lock(mutex_);
+        if (!reactor_running_)
+        {
+            reactor_running_ = true;
+            reactor_interrupted_ = true;
+            run_reactor(lock);
+            reactor_running_ = false;
+        }
+    }
+
+    std::size_t n = 0;
+    while (do_one(0))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+
+    // The host waits on the fd next; have posts that race with the
+    // announcement trigger it at once
+    reactor_sleeping_.store(true, std::memory_order_seq_cst);
+    if (!injected_.empty() &&
+        reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+        interrupt_reactor();
+    return n;
+}
+
+long
+kqueue_scheduler::
+poll_ready_timeout() const
+{
+    long const us = calculate_timeout(-1);
+    if (us < 0)
+        return -1;
+    return (us + 999) / 1000;
+}
+
+kqueue_descriptor_state*
+kqueue_scheduler::
+register_descriptor(int fd) const
+{
+    kqueue_descriptor_state* desc;
+    {
+        std::lock_guard lock(desc_mutex_);
+        desc = desc_free_.pop_front();
+        if (!desc)
+            desc = new kqueue_descriptor_state;
+        desc_live_.push_back(desc);
+    }
+
+    {
+        std::lock_guard lock(desc->mutex);
+        desc->fd = fd;
+        desc->read_op = nullptr;
+        desc->write_op = nullptr;
+        desc->connect_op = nullptr;
+        desc->read_ready = false;
+        desc->write_ready = false;
+    }
+
+    struct kevent changes[2];
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_ADD | EV_CLEAR, 0, 0, desc);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_ADD | EV_CLEAR, 0, 0, desc);
+    if (::kevent(kq_fd_, changes, 2, nullptr, 0, nullptr) < 0)
+    {
+        int errn = errno;
+        {
+            std::lock_guard lock(desc_mutex_);
+            desc_live_.remove(desc);
+            desc_free_.push_back(desc);
+        }
+        detail::throw_system_error(make_err(errn), "kevent EV_ADD");
+    }
+    return desc;
+}
+
+void
+kqueue_scheduler::
+deregister_descriptor(int fd, kqueue_descriptor_state* desc) const
+{
+    // Closing the fd would drop the filters too, but the fd is still
+    // open here and a reused number must not inherit them
+    struct kevent changes[2];
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+    ::kevent(kq_fd_, changes, 2, nullptr, 0, nullptr);
+
+    {
+        std::lock_guard lock(desc->mutex);
+        desc->fd = -1;
+        desc->read_op = nullptr;
+        desc->write_op = nullptr;
+        desc->connect_op = nullptr;
+        desc->read_ready = false;
+        desc->write_ready = false;
+    }
+
+    std::lock_guard lock(desc_mutex_);
+    desc_live_.remove(desc);
+    desc_free_.push_back(desc);
+}
+
+void
+kqueue_scheduler::
+work_started() const noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+kqueue_scheduler::
+work_finished() const noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // Last work item completed - wake all threads so they can exit.
+        // notify_all() wakes threads waiting on the condvar.
+        // interrupt_reactor() wakes the reactor thread blocked in kevent().
+        std::unique_lock lock(mutex_);
+        wakeup_event_.notify_all();
+        if (reactor_running_ && !reactor_interrupted_)
+        {
+            reactor_interrupted_ = true;
+            lock.unlock();
+            interrupt_reactor();
+        }
+    }
+}
+
+void
+kqueue_scheduler::
+interrupt_reactor() const
+{
+    // At most one trigger in flight until the reactor harvests it
+    if (wakeup_pending_.exchange(true, std::memory_order_acq_rel))
+        return;
+
+#ifdef EVFILT_USER
+    struct kevent ev;
+    EV_SET(&ev, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+    ::kevent(kq_fd_, &ev, 1, nullptr, 0, nullptr);
+#else
+    char byte = 0;
+    [[maybe_unused]] auto r = ::write(wake_pipe_[1], &byte, 1);
+#endif
+}
+
+void
+kqueue_scheduler::
+wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const
+{
+    if (idle_thread_count_ > 0)
+    {
+        // Idle worker exists - wake it via condvar
+        wakeup_event_.notify_one();
+        lock.unlock();
+    }
+    else if (reactor_running_ && !reactor_interrupted_)
+    {
+        // No idle workers but reactor is running - interrupt it
+        reactor_interrupted_ = true;
+        lock.unlock();
+        interrupt_reactor();
+    }
+    else
+    {
+        // No one to wake
+        lock.unlock();
+    }
+}
+
+namespace {
+
+// Runs a parked op after a readiness event. Returns true if the op
+// finished and was moved to `ready`; false if it is still waiting.
+bool
+perform_parked_op(
+    kqueue_op*& slot,
+    int err,
+    op_queue& ready)
+{
+    auto* op = slot;
+    if (err != 0)
+    {
+        op->complete(err, 0);
+    }
+    else
+    {
+        op->perform_io();
+        if (op->errn == EAGAIN || op->errn == EWOULDBLOCK)
+        {
+            // Spurious or already-consumed edge, keep waiting
+            op->errn = 0;
+            return false;
+        }
+    }
+    slot = nullptr;
+    ready.push(op);
+    return true;
+}
+
+// Dispatches one kevent to the operations parked on `desc`.
+// Returns the number of operations moved to `ready`.
+int
+perform_descriptor_io(
+    kqueue_descriptor_state& desc,
+    struct kevent const& ev,
+    op_queue& ready)
+{
+    std::lock_guard lock(desc.mutex);
+
+    int err = 0;
+    if (ev.flags & EV_ERROR)
+        err = ev.data ? static_cast<int>(ev.data) : EIO;
+
+    int n = 0;
+    if (ev.filter == EVFILT_READ)
+    {
+        if (desc.read_op)
+            n += perform_parked_op(desc.read_op, err, ready);
+        else
+            desc.read_ready = true;
+    }
+    else if (ev.filter == EVFILT_WRITE)
+    {
+        bool had_op = desc.connect_op || desc.write_op;
+        if (desc.connect_op)
+            n += perform_parked_op(desc.connect_op, err, ready);
+        if (desc.write_op)
+            n += perform_parked_op(desc.write_op, err, ready);
+        if (!had_op)
+            desc.write_ready = true;
+    }
+
+    return n;
+}
+
+} // namespace
+
+long
+kqueue_scheduler::
+calculate_timeout(long requested_timeout_us) const
+{
+    if (requested_timeout_us == 0)
+        return 0;
+
+    auto nearest = timer_svc_->nearest_wakeup();
+    if (nearest == timer_service::time_point::max())
+        return requested_timeout_us;
+
+    auto now = std::chrono::steady_clock::now();
+    if (nearest <= now)
+        return 0;
+
+    auto timer_timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        nearest - now).count();
+
+    if (requested_timeout_us < 0)
+        return static_cast<long>(timer_timeout_us);
+
+    return static_cast<long>((std::min)(
+        static_cast<long long>(requested_timeout_us),
+        static_cast<long long>(timer_timeout_us)));
+}
+
+void
+kqueue_scheduler::
+run_reactor(std::unique_lock<std::mutex>& lock)
+{
+    // Calculate timeout considering timers, use 0 if interrupted
+    long timeout_us = reactor_interrupted_ ? 0 : calculate_timeout(-1);
+
+    lock.unlock();
+
+    // Announce that we may block, then re-check for posts that raced
+    // with the announcement; producers interrupt only when this is set
+    if (timeout_us != 0)
+    {
+        reactor_sleeping_.store(true, std::memory_order_seq_cst);
+        if (!injected_.empty())
+            timeout_us = 0;
+    }
+
+    timespec ts{};
+    timespec* tsp = nullptr;
+    if (timeout_us >= 0)
+    {
+        ts.tv_sec = timeout_us / 1000000;
+        ts.tv_nsec = (timeout_us % 1000000) * 1000;
+        tsp = &ts;
+    }
+
+    int nev = ::kevent(kq_fd_, nullptr, 0, events_, max_events, tsp);
+    int saved_errno = errno;  // Save before process_expired() may overwrite
+    reactor_sleeping_.store(false, std::memory_order_relaxed);
+
+    // Process timers outside the lock - timer completions may call post()
+    // which needs to acquire the lock
+    timer_svc_->process_expired();
+
+    if (nev < 0 && saved_errno != EINTR)
+        detail::throw_system_error(make_err(saved_errno), "kevent");
+
+    // Perform I/O for ready descriptors without holding the scheduler
+    // mutex; completed operations are spliced into the queue afterwards.
+    op_queue ready_ops;
+    int completions_queued = 0;
+    for (int i = 0; i < nev; ++i)
+    {
+        if (events_[i].udata == nullptr)
+        {
+            // Wakeup - drain the pipe if any, then re-arm coalescing,
+            // see "Wakeups"
+#ifndef EVFILT_USER
+            char buf[64];
+            while (::read(wake_pipe_[0], buf, sizeof(buf)) > 0)
+                ;
+#endif
+            wakeup_pending_.store(false, std::memory_order_release);
+            continue;
+        }
+
+        completions_queued += perform_descriptor_io(
+            *static_cast<kqueue_descriptor_state*>(events_[i].udata),
+            events_[i],
+            ready_ops);
+    }
+
+    lock.lock();
+    completed_ops_.splice(ready_ops);
+
+    // Wake idle workers if we queued I/O completions
+    if (completions_queued > 0)
+    {
+        if (completions_queued >= idle_thread_count_)
+            wakeup_event_.notify_all();
+        else
+            for (int i = 0; i < completions_queued; ++i)
+                wakeup_event_.notify_one();
+    }
+}
+
+std::size_t
+kqueue_scheduler::
+do_one(long timeout_us)
+{
+    std::unique_lock lock(mutex_);
+
+    using clock = std::chrono::steady_clock;
+    auto deadline = (timeout_us > 0)
+        ? clock::now() + std::chrono::microseconds(timeout_us)
+        : clock::time_point{};
+    bool polled = false;
+
+    for (;;)
+    {
+        if (stopped_.load(std::memory_order_acquire))
+            return 0;
+
+        if (!injected_.empty())
+            injected_.pop_all(completed_ops_);
+
+        // Try to get a handler from the queue
+        scheduler_op* op = completed_ops_.pop();
+
+        if (op != nullptr)
+        {
+            // Got a handler - execute it
+            lock.unlock();
+            handler_scope g{this, find_context(this)};
+            (*op)();
+            return 1;
+        }
+
+        // Queue is empty - check if we should become reactor or wait
+        if (outstanding_work_.load(std::memory_order_acquire) == 0)
+            return 0;
+
+        if (timeout_us == 0)
+        {
+            // A non-blocking poll harvests the kqueue once before
+            // giving up, so ready I/O is not missed
+            if (polled || reactor_running_)
+                return 0;
+            polled = true;
+            reactor_running_ = true;
+            reactor_interrupted_ = true;
+            run_reactor(lock);
+            reactor_running_ = false;
+            continue;
+        }
+
+        // Check if timeout has expired (for positive timeout_us)
+        if (timeout_us > 0 && clock::now() >= deadline)
+            return 0;
+
+        if (!reactor_running_)
+        {
+            // No reactor running and queue empty - become the reactor
+            reactor_running_ = true;
+            reactor_interrupted_ = false;
+
+            run_reactor(lock);
+
+            reactor_running_ = false;
+            // Loop back to check for handlers that reactor may have queued
+            continue;
+        }
+
+        long remaining_us = timeout_us;
+        if (timeout_us > 0)
+            remaining_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - clock::now()).count();
+
+        // Reactor is running in another thread - wait for work on condvar
+        ++idle_thread_count_;
+        if (!injected_.empty())
+        {
+            // A post raced with the announcement above
+            --idle_thread_count_;
+            continue;
+        }
+        if (timeout_us < 0)
+            wakeup_event_.wait(lock);
+        else
+            wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        --idle_thread_count_;
+    }
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_KQUEUE
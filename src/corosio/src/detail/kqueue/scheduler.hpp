@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_KQUEUE_SCHEDULER_HPP
+#define BOOST_COROSIO_DETAIL_KQUEUE_SCHEDULER_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_KQUEUE
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/scheduler.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/intrusive.hpp"
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/timer_service.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+#include <sys/types.h>
+#include <sys/event.h>
+
+namespace boost::corosio::detail {
+
+struct kqueue_op;
+struct kqueue_descriptor_state;
+
+/** BSD/macOS scheduler using kqueue for I/O multiplexing.
+
+    This scheduler implements the scheduler interface on top of a
+    kqueue. Thread coordination follows the same single reactor model
+    as epoll_scheduler: one thread waits in kevent() while the others
+    wait on a condition variable for handler work.
+
+    The reactor is interrupted through an EVFILT_USER event, or a
+    self-pipe where the platform lacks that filter. Timers need no
+    kernel object: the kevent() timeout is bounded by the nearest
+    timer expiry.
+
+    @par Thread Safety
+    All public member functions are thread-safe.
+*/
+class kqueue_scheduler
+    : public scheduler
+    , public capy::execution_context::service
+{
+public:
+    using key_type = scheduler;
+
+    /** Construct the scheduler.
+
+        Creates the kqueue and registers the wakeup event.
+
+        @param ctx Reference to the owning execution_context.
+        @param concurrency_hint Hint for expected thread count (unused).
+    */
+    kqueue_scheduler(
+        capy::execution_context& ctx,
+        int concurrency_hint = -1);
+
+    ~kqueue_scheduler();
+
+    kqueue_scheduler(kqueue_scheduler const&) = delete;
+    kqueue_scheduler& operator=(kqueue_scheduler const&) = delete;
+
+    void shutdown() override;
+    void post(capy::coro h) const override;
+    void post(scheduler_op* h) const override;
+    void on_work_started() noexcept override;
+    void on_work_finished() noexcept override;
+    bool running_in_this_thread() const noexcept override;
+    void stop() override;
+    bool stopped() const noexcept override;
+    void restart() override;
+    std::size_t run() override;
+    std::size_t run_one() override;
+    std::size_t wait_one(long usec) override;
+    std::size_t poll() override;
+    std::size_t poll_one() override;
+    std::size_t poll_ready() override;
+    long poll_ready_timeout() const override;
+
+    long outstanding_work() const noexcept override
+    {
+        return outstanding_work_.load(std::memory_order_acquire);
+    }
+
+    /** Return the kqueue file descriptor.
+
+        It is readable whenever the kqueue holds events, see
+        "Embedding" in scheduler.cpp.
+    */
+    int kqueue_fd() const noexcept { return kq_fd_; }
+
+    /** Register a descriptor with the kqueue.
+
+        Allocates a pooled kqueue_descriptor_state and adds EVFILT_READ
+        and EVFILT_WRITE filters for `fd`, both EV_CLEAR. The
+        registration persists until @ref deregister_descriptor.
+
+        @param fd The file descriptor to register.
+
+        @return The descriptor state bound to `fd`.
+
+        @throws std::system_error if kevent fails.
+    */
+    kqueue_descriptor_state* register_descriptor(int fd) const;
+
+    /** Deregister a descriptor from the kqueue.
+
+        Deletes the filters for `fd` and returns its state to the
+        pool. Any parked operations must already have been claimed.
+
+        @param fd The file descriptor to deregister.
+        @param desc The state returned by @ref register_descriptor.
+    */
+    void deregister_descriptor(int fd, kqueue_descriptor_state* desc) const;
+
+    /** For use by I/O operations to track pending work. */
+    void work_started() const noexcept override;
+
+    /** For use by I/O operations to track completed work. */
+    void work_finished() const noexcept override;
+
+private:
+    class run_scope;
+    class handler_scope;
+
+    std::size_t do_one(long timeout_us);
+    void enqueue(scheduler_op* h) const;
+    void run_reactor(std::unique_lock<std::mutex>& lock);
+    void wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const;
+    void interrupt_reactor() const;
+    long calculate_timeout(long requested_timeout_us) const;
+
+    // Events harvested by one kevent() call
+    static constexpr int max_events = 128;
+
+    int kq_fd_ = -1;
+    int wake_pipe_[2] = {-1, -1};               // used without EVFILT_USER
+    struct kevent events_[max_events];          // reactor harvest buffer
+    mutable std::mutex mutex_;
+    mutable std::condition_variable wakeup_event_;
+    mutable op_queue completed_ops_;
+    mutable intrusive_mpsc_queue<scheduler_op> injected_;  // lock-free posts
+    mutable std::atomic<long> outstanding_work_;
+    std::atomic<bool> stopped_;
+    bool shutdown_;
+    timer_service* timer_svc_ = nullptr;
+
+    // Single reactor thread coordination
+    mutable bool reactor_running_ = false;
+    mutable bool reactor_interrupted_ = false;
+    mutable std::atomic<int> idle_thread_count_ = 0;
+    mutable std::atomic<bool> reactor_sleeping_ = false;
+    mutable std::atomic<bool> wakeup_pending_ = false;  // triggered, not harvested
+
+    // Pool of descriptor states, see kqueue_descriptor_state in op.hpp
+    mutable std::mutex desc_mutex_;
+    mutable intrusive_list<kqueue_descriptor_state> desc_live_;
+    mutable intrusive_list<kqueue_descriptor_state> desc_free_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_KQUEUE
+
+#endif // BOOST_COROSIO_DETAIL_KQUEUE_SCHEDULER_HPP
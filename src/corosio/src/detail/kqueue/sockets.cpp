@@ -0,0 +1,721 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_KQUEUE
+
+#include "src/detail/kqueue/sockets.hpp"
+#include "src/detail/endpoint_convert.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/resume_coro.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <utility>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost::corosio::detail {
+
+//------------------------------------------------------------------------------
+// kqueue_op::canceller - implements stop_token cancellation
+//------------------------------------------------------------------------------
+
+void
+kqueue_op::canceller::
+operator()() const noexcept
+{
+    op->cancel();
+}
+
+//------------------------------------------------------------------------------
+// cancel() overrides for socket operations
+//------------------------------------------------------------------------------
+
+void
+kqueue_connect_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+void
+kqueue_read_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+void
+kqueue_write_op::
+cancel() noexcept
+{
+    if (socket_impl_)
+        socket_impl_->cancel_single_op(*this);
+    else
+        request_cancel();
+}
+
+//------------------------------------------------------------------------------
+// kqueue_connect_op::operator() - caches endpoints on successful connect
+//------------------------------------------------------------------------------
+
+void
+kqueue_connect_op::
+operator()()
+{
+    stop_cb.reset();
+
+    bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+
+    // Cache endpoints on successful connect
+    if (success && socket_impl_)
+    {
+        // Query local endpoint via getsockname (may fail, but remote is always known)
+        endpoint local_ep;
+        sockaddr_storage local_addr{};
+        socklen_t local_len = sizeof(local_addr);
+        if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+            local_ep = from_sockaddr(local_addr);
+        // Always cache remote endpoint; local may be default if getsockname failed
+        static_cast<kqueue_socket_impl*>(socket_impl_)->set_endpoints(local_ep, target_endpoint);
+    }
+
+    if (ec_out)
+    {
+        if (cancelled.load(std::memory_order_acquire))
+            *ec_out = capy::error::canceled;
+        else if (errn != 0)
+            *ec_out = make_err(errn);
+        else
+            *ec_out = {};
+    }
+
+    if (bytes_out)
+        *bytes_out = bytes_transferred;
+
+    // Move to stack before destroying the frame
+    capy::executor_ref saved_ex( std::move( ex ) );
+    capy::coro saved_h( std::move( h ) );
+    impl_ptr.reset();
+    resume_coro(saved_ex, saved_h);
+}
+
+//------------------------------------------------------------------------------
+// kqueue_socket_impl
+//------------------------------------------------------------------------------
+
+kqueue_socket_impl::
+kqueue_socket_impl(kqueue_socket_service& svc) noexcept
+    : svc_(svc)
+{
+}
+
+void
+kqueue_socket_impl::
+release()
+{
+    close_socket();
+    svc_.destroy_impl(*this);
+}
+
+void
+kqueue_socket_impl::
+connect(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    endpoint ep,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    auto& op = conn_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.fd = fd_;
+    op.target_endpoint = ep;  // Store target for endpoint caching
+    op.start(token, this);
+
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    int result = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), addrlen);
+
+    if (result == 0)
+    {
+        // Sync success - cache endpoints immediately
+        // Remote is always known; local may fail but we still cache remote
+        sockaddr_storage local_addr{};
+        socklen_t local_len = sizeof(local_addr);
+        if (::getsockname(fd_, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
+            local_endpoint_ = detail::from_sockaddr(local_addr);
+        remote_endpoint_ = ep;
+
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return;
+    }
+
+    if (errno == EINPROGRESS)
+    {
+        register_op(op, desc_->connect_op, desc_->write_ready);
+        return;
+    }
+
+    op.complete(errno, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+}
+
+bool
+kqueue_socket_impl::
+read_some(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    assign_iovecs(op.iovecs, param);
+    op.start(token, this);
+
+    if (op.iovecs.empty())
+    {
+        op.empty_buffer_read = true;
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    ssize_t n = ::readv(fd_, op.iovecs.data(), static_cast<int>(op.iovecs.size()));
+
+    if (n > 0)
+    {
+        op.complete(0, static_cast<std::size_t>(n));
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    if (n == 0)
+    {
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+        register_op(op, desc_->read_op, desc_->read_ready);
+        return false;
+    }
+
+    op.complete(errno, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+    return false;
+}
+
+bool
+kqueue_socket_impl::
+write_some(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    assign_iovecs(op.iovecs, param);
+    op.start(token, this);
+
+    if (op.iovecs.empty())
+    {
+        op.complete(0, 0);
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    msghdr msg{};
+    msg.msg_iov = op.iovecs.data();
+    msg.msg_iovlen = op.iovecs.size();
+
+    ssize_t n = ::sendmsg(fd_, &msg, kqueue_send_flags);
+
+    if (n > 0)
+    {
+        op.complete(0, static_cast<std::size_t>(n));
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return false;
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+        register_op(op, desc_->write_op, desc_->write_ready);
+        return false;
+    }
+
+    op.complete(errno ? errno : EIO, 0);
+    op.impl_ptr = shared_from_this();
+    svc_.post(&op);
+    return false;
+}
+
+system::error_code
+kqueue_socket_impl::
+shutdown(socket::shutdown_type what) noexcept
+{
+    int how;
+    switch (what)
+    {
+    case socket::shutdown_receive: how = SHUT_RD;   break;
+    case socket::shutdown_send:    how = SHUT_WR;   break;
+    case socket::shutdown_both:    how = SHUT_RDWR; break;
+    default:
+        return make_err(EINVAL);
+    }
+    if (::shutdown(fd_, how) != 0)
+        return make_err(errno);
+    return {};
+}
+
+//------------------------------------------------------------------------------
+// Socket Options
+//------------------------------------------------------------------------------
+
+system::error_code
+kqueue_socket_impl::
+set_no_delay(bool value) noexcept
+{
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+bool
+kqueue_socket_impl::
+no_delay(system::error_code& ec) const noexcept
+{
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    if (::getsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &flag, &len) != 0)
+    {
+        ec = make_err(errno);
+        return false;
+    }
+    ec = {};
+    return flag != 0;
+}
+
+system::error_code
+kqueue_socket_impl::
+set_keep_alive(bool value) noexcept
+{
+    int flag = value ? 1 : 0;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+bool
+kqueue_socket_impl::
+keep_alive(system::error_code& ec) const noexcept
+{
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &flag, &len) != 0)
+    {
+        ec = make_err(errno);
+        return false;
+    }
+    ec = {};
+    return flag != 0;
+}
+
+system::error_code
+kqueue_socket_impl::
+set_receive_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+kqueue_socket_impl::
+receive_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+kqueue_socket_impl::
+set_send_buffer_size(int size) noexcept
+{
+    if (::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+int
+kqueue_socket_impl::
+send_buffer_size(system::error_code& ec) const noexcept
+{
+    int size = 0;
+    socklen_t len = sizeof(size);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &size, &len) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return size;
+}
+
+system::error_code
+kqueue_socket_impl::
+set_linger(bool enabled, int timeout) noexcept
+{
+    if (timeout < 0)
+        return make_err(EINVAL);
+    struct ::linger lg;
+    lg.l_onoff = enabled ? 1 : 0;
+    lg.l_linger = timeout;
+    if (::setsockopt(fd_, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+socket::linger_options
+kqueue_socket_impl::
+linger(system::error_code& ec) const noexcept
+{
+    struct ::linger lg{};
+    socklen_t len = sizeof(lg);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_LINGER, &lg, &len) != 0)
+    {
+        ec = make_err(errno);
+        return {};
+    }
+    ec = {};
+    return {.enabled = lg.l_onoff != 0, .timeout = lg.l_linger};
+}
+
+void
+kqueue_socket_impl::
+register_op(
+    kqueue_op& op,
+    kqueue_op*& slot,
+    bool& ready_flag) noexcept
+{
+    svc_.work_started();
+
+    std::unique_lock lock(desc_->mutex);
+
+    // An edge arrived while nothing was parked; retry before waiting
+    if (ready_flag)
+    {
+        ready_flag = false;
+        op.perform_io();
+        if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
+        {
+            lock.unlock();
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            svc_.work_finished();
+            return;
+        }
+        op.errn = 0;
+    }
+
+    // Cancellation requested before we could park
+    if (op.cancelled.load(std::memory_order_acquire))
+    {
+        lock.unlock();
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        svc_.work_finished();
+        return;
+    }
+
+    slot = &op;
+}
+
+void
+kqueue_socket_impl::
+cancel() noexcept
+{
+    std::shared_ptr<kqueue_socket_impl> self;
+    try {
+        self = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        return;
+    }
+
+    conn_.request_cancel();
+    rd_.request_cancel();
+    wr_.request_cancel();
+
+    if (!desc_)
+        return;
+
+    kqueue_op* claimed[3];
+    {
+        std::lock_guard lock(desc_->mutex);
+        claimed[0] = std::exchange(desc_->connect_op, nullptr);
+        claimed[1] = std::exchange(desc_->read_op, nullptr);
+        claimed[2] = std::exchange(desc_->write_op, nullptr);
+    }
+
+    for (auto* op : claimed)
+    {
+        if (!op)
+            continue;
+        op->impl_ptr = self;
+        svc_.post(op);
+        svc_.work_finished();
+    }
+}
+
+void
+kqueue_socket_impl::
+cancel_single_op(kqueue_op& op) noexcept
+{
+    // Called from stop_token callback to cancel a specific pending operation.
+    // This performs actual I/O cancellation, not just setting a flag.
+    op.request_cancel();
+
+    if (!desc_)
+        return;
+
+    kqueue_op** slot;
+    if (&op == &conn_)
+        slot = &desc_->connect_op;
+    else if (&op == &rd_)
+        slot = &desc_->read_op;
+    else
+        slot = &desc_->write_op;
+
+    {
+        std::lock_guard lock(desc_->mutex);
+        if (*slot != &op)
+            return;
+        *slot = nullptr;
+    }
+
+    // Keep impl alive until op completes
+    try {
+        op.impl_ptr = shared_from_this();
+    } catch (const std::bad_weak_ptr&) {
+        // Impl is being destroyed, op will be orphaned but that's ok
+    }
+
+    svc_.post(&op);
+    svc_.work_finished();
+}
+
+void
+kqueue_socket_impl::
+close_socket() noexcept
+{
+    cancel();
+
+    if (fd_ >= 0)
+    {
+        if (desc_)
+        {
+            svc_.scheduler().deregister_descriptor(fd_, desc_);
+            desc_ = nullptr;
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    // Clear cached endpoints
+    local_endpoint_ = endpoint{};
+    remote_endpoint_ = endpoint{};
+}
+
+system::error_code
+kqueue_socket_impl::
+set_socket(int fd) noexcept
+{
+    try {
+        desc_ = svc_.scheduler().register_descriptor(fd);
+    } catch (system::system_error const& e) {
+        ::close(fd);
+        return e.code();
+    }
+    fd_ = fd;
+    return {};
+}
+
+//------------------------------------------------------------------------------
+// kqueue_socket_service
+//------------------------------------------------------------------------------
+
+kqueue_socket_service::
+kqueue_socket_service(capy::execution_context& ctx)
+    : state_(std::make_unique<kqueue_socket_state>(ctx.use_service<kqueue_scheduler>()))
+{
+}
+
+kqueue_socket_service::
+~kqueue_socket_service()
+{
+}
+
+void
+kqueue_socket_service::
+shutdown()
+{
+    std::lock_guard lock(state_->mutex_);
+
+    while (auto* impl = state_->socket_list_.pop_front())
+        impl->close_socket();
+
+    state_->socket_ptrs_.clear();
+}
+
+socket::socket_impl&
+kqueue_socket_service::
+create_impl()
+{
+    auto impl = make_recycled_impl<kqueue_socket_impl>(*this);
+    auto* raw = impl.get();
+
+    {
+        std::lock_guard lock(state_->mutex_);
+        state_->socket_list_.push_back(raw);
+        state_->socket_ptrs_.emplace(raw, std::move(impl));
+    }
+
+    return *raw;
+}
+
+void
+kqueue_socket_service::
+destroy_impl(socket::socket_impl& impl)
+{
+    auto* kqueue_impl = static_cast<kqueue_socket_impl*>(&impl);
+    std::lock_guard lock(state_->mutex_);
+    state_->socket_list_.remove(kqueue_impl);
+    state_->socket_ptrs_.erase(kqueue_impl);
+}
+
+system::error_code
+kqueue_socket_service::
+open_socket(
+    socket::socket_impl& impl,
+    ip_family family)
+{
+    auto* kqueue_impl = static_cast<kqueue_socket_impl*>(&impl);
+    kqueue_impl->close_socket();
+
+    int fd = ::socket(detail::to_af(family), SOCK_STREAM, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    if (int err = kqueue_prepare_descriptor(fd))
+    {
+        ::close(fd);
+        return make_err(err);
+    }
+
+    return kqueue_impl->set_socket(fd);
+}
+
+system::error_code
+kqueue_socket_service::
+assign_socket(
+    socket::socket_impl& impl,
+    native_handle_type fd,
+    endpoint local,
+    endpoint remote)
+{
+    auto* kqueue_impl = static_cast<kqueue_socket_impl*>(&impl);
+    kqueue_impl->close_socket();
+
+    if (int err = kqueue_prepare_descriptor(fd))
+    {
+        ::close(fd);
+        return make_err(err);
+    }
+    if (auto ec = kqueue_impl->set_socket(fd))
+        return ec;
+    kqueue_impl->set_endpoints(local, remote);
+    return {};
+}
+
+void
+kqueue_socket_service::
+post(kqueue_op* op)
+{
+    state_->sched_.post(op);
+}
+
+void
+kqueue_socket_service::
+work_started() noexcept
+{
+    state_->sched_.work_started();
+}
+
+void
+kqueue_socket_service::
+work_finished() noexcept
+{
+    state_->sched_.work_finished();
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_KQUEUE
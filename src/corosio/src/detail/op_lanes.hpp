@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_OP_LANES_HPP
+#define BOOST_COROSIO_DETAIL_OP_LANES_HPP
+
+#include "src/detail/scheduler_op.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace boost::corosio::detail {
+
+/** A handler queue with a high priority lane.
+
+    Handlers marked `high_priority` are popped before the others,
+    so control traffic such as heartbeats and cancels does not wait
+    behind a backlog of bulk completions. At most @ref burst high
+    priority handlers run in a row while normal handlers are
+    waiting; then one normal handler runs, so a busy priority
+    source slows bulk work down but cannot stall it.
+
+    Like @ref op_queue, which it replaces in the schedulers that
+    support lanes, it is guarded by the owner's mutex. Only the
+    size of the high lane may be read without it, as a hint.
+*/
+class op_lanes
+{
+    op_queue high_;
+    op_queue normal_;
+    std::atomic<std::size_t> high_size_{0};
+    unsigned run_ = 0;
+
+public:
+    /// High priority handlers run in a row while others wait.
+    static constexpr unsigned burst = 16;
+
+    op_lanes() = default;
+    op_lanes(op_lanes const&) = delete;
+    op_lanes& operator=(op_lanes const&) = delete;
+
+    bool
+    empty() const noexcept
+    {
+        return high_.empty() && normal_.empty();
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return high_.size() + normal_.size();
+    }
+
+    /// Return a possibly stale count of queued high priority handlers.
+    std::size_t
+    high_priority_hint() const noexcept
+    {
+        return high_size_.load(std::memory_order_relaxed);
+    }
+
+    /// Queue a handler in the lane its flag selects.
+    void
+    push(scheduler_op* op) noexcept
+    {
+        if (op->high_priority)
+        {
+            high_.push(op);
+            high_size_.store(high_.size(), std::memory_order_relaxed);
+        }
+        else
+            normal_.push(op);
+    }
+
+    /// Append handlers to the normal lane.
+    void
+    splice(op_queue& ops) noexcept
+    {
+        normal_.splice(ops);
+    }
+
+    /// Move the handlers of a lock-free queue to the normal lane.
+    bool
+    take_all(intrusive_mpsc_queue<scheduler_op>& q) noexcept
+    {
+        return q.pop_all(normal_);
+    }
+
+    /// Append handlers, each to the lane its flag selects.
+    void
+    splice_routed(op_queue& ops) noexcept
+    {
+        while (auto* op = ops.pop())
+            push(op);
+    }
+
+    /// Put handlers taken by @ref pop back in front of their lanes.
+    void
+    requeue_front(op_queue& ops) noexcept
+    {
+        op_queue high;
+        op_queue normal;
+        while (auto* op = ops.pop())
+        {
+            if (op->high_priority)
+                high.push(op);
+            else
+                normal.push(op);
+        }
+        high.splice(high_);
+        high_.splice(high);
+        normal.splice(normal_);
+        normal_.splice(normal);
+        high_size_.store(high_.size(), std::memory_order_relaxed);
+    }
+
+    /// Pop the next handler, or null if both lanes are empty.
+    scheduler_op*
+    pop() noexcept
+    {
+        if (!high_.empty() && (run_ < burst || normal_.empty()))
+        {
+            ++run_;
+            auto* op = high_.pop();
+            high_size_.store(high_.size(), std::memory_order_relaxed);
+            return op;
+        }
+        run_ = 0;
+        return normal_.pop();
+    }
+};
+
+} // namespace boost::corosio::detail
+
+#endif
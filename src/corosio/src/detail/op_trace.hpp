@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_OP_TRACE_HPP
+#define BOOST_COROSIO_DETAIL_OP_TRACE_HPP
+
+#include <boost/corosio/op_tracer.hpp>
+
+#include <atomic>
+#include <chrono>
+
+/*
+    Operation Tracing
+    =================
+
+    A scheduler that traces keeps the tracer in an atomic pointer. An
+    operation reads it once when it is initiated and keeps it, so an
+    untraced operation costs that relaxed load and a branch at each
+    stamp. A traced one reads the clock when it is initiated, when the
+    reactor performs its I/O, and when it resumes. The readiness time
+    is the return of the reactor wait that reported the descriptor,
+    read once per wait, so the time the reactor spends on the other
+    events of a batch falls between ready and queued, and the time
+    spent waiting for a thread after the batch is spliced falls
+    between queued and resumed.
+
+    An operation that completes inline is never resumed through the
+    scheduler and is not reported; one that is destroyed unrun is not
+    reported either.
+*/
+
+namespace boost::corosio::detail {
+
+/** The trace stamps of one operation. */
+struct op_trace_state
+{
+    using clock = std::chrono::steady_clock;
+
+    op_tracer* tracer = nullptr;
+    clock::time_point initiated;
+    clock::time_point ready;
+    clock::time_point queued;
+    bool parked = false;
+
+    /// Begin an operation, tracing it if `t` is not null.
+    void
+    start(op_tracer* t) noexcept
+    {
+        tracer = t;
+        parked = false;
+        if (t)
+            initiated = clock::now();
+    }
+
+    /** Record that the reactor finished the operation's I/O.
+
+        `woke` is null if tracing was turned off after the operation
+        started; the operation is then taken as ready when queued.
+    */
+    void
+    mark_ready(clock::time_point woke) noexcept
+    {
+        if (!tracer)
+            return;
+        parked = true;
+        queued = clock::now();
+        ready = woke == clock::time_point{} ? queued : woke;
+    }
+
+    /// Stop tracing the operation without reporting it.
+    void
+    discard() noexcept
+    {
+        tracer = nullptr;
+    }
+
+    /// Report the operation as it resumes.
+    void
+    finish(bool cancelled) noexcept
+    {
+        if (!tracer)
+            return;
+        op_trace t;
+        t.initiated = initiated;
+        t.ready = parked ? ready : initiated;
+        t.queued = parked ? queued : initiated;
+        t.resumed = clock::now();
+        t.parked = parked;
+        t.cancelled = cancelled;
+        auto* sink = tracer;
+        tracer = nullptr;
+        sink->on_complete(t);
+    }
+};
+
+/** Return the time a reactor wait returned, if anything is traced. */
+inline op_trace_state::clock::time_point
+trace_clock(std::atomic<op_tracer*> const& tracer) noexcept
+{
+    if (!tracer.load(std::memory_order_relaxed))
+        return {};
+    return op_trace_state::clock::now();
+}
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -0,0 +1,918 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_POLL
+
+#include "src/detail/poll/scheduler.hpp"
+#include "src/detail/poll/op.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/posix/file_service.hpp"
+#include "src/detail/posix/resolver_service.hpp"
+#include "src/detail/posix/signals.hpp"
+
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/thread_local_ptr.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*
+    poll Scheduler - Single Reactor Model
+    =====================================
+
+    This scheduler mirrors the select_scheduler design but uses poll()
+    instead of select() for I/O multiplexing. The thread coordination
+    strategy is identical: one thread becomes the "reactor" while others
+    wait on a condition variable.
+
+    Thread Model
+    ------------
+    - ONE thread runs poll() at a time (the reactor thread)
+    - OTHER threads wait on wakeup_event_ (condition variable) for handlers
+    - When work is posted, exactly one waiting thread wakes via notify_one()
+
+    Key Differences from select
+    ---------------------------
+    - No FD_SETSIZE limit; any descriptor value can be registered
+    - The kernel scans only registered descriptors, not 0..max_fd
+    - Registration changes are O(1) and allocate only when the table grows
+
+    Self-Pipe Pattern
+    -----------------
+    To interrupt a blocking poll() call (e.g., when work is posted or a
+    timer expires), we write a byte to pipe_fds_[1]. The read end
+    pipe_fds_[0] is always entry 0 of the pollfd array, so poll() returns
+    immediately. We drain the pipe to clear the readable state.
+
+    Injection Queue
+    ---------------
+    As in the epoll scheduler, post() pushes onto a lock-free MPSC queue
+    that is drained under mutex_, and only wakes a consumer that has
+    announced it is parked (idle on the condvar, or about to block in
+    poll()).
+
+    Work Counting
+    -------------
+    As in the epoll scheduler, posts made by a handler running inside
+    run() are counted and staged in the thread's frame, then published
+    by handler_scope with a single adjustment of outstanding_work_ that
+    also retires the handler's own unit.
+
+    Descriptor Table
+    ----------------
+    pollfds_ is dense: one entry per descriptor with a registered
+    operation, and fd_states_ holds that entry's read and write op at
+    the same index. fd_index_ maps a descriptor value to its index, so
+    neither registration nor the reactor hashes. Removing an entry
+    moves the last one into its place and patches that entry's index.
+
+    The reactor cannot hand pollfds_ to poll() directly, since other
+    threads register while it is blocked. It polls a copy, poll_buf_,
+    refreshed only when the table changed since the last wait, and maps
+    each ready entry back through fd_index_ under the mutex. An entry
+    that was removed or replaced meanwhile is simply skipped or served
+    by its current operation.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+struct scheduler_context
+{
+    poll_scheduler const* key;
+    scheduler_context* next;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
+};
+
+corosio::detail::thread_local_ptr<scheduler_context> context_stack;
+
+// Returns the innermost run() frame of `sched` on this thread
+scheduler_context*
+find_context(poll_scheduler const* sched) noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
+
+} // namespace
+
+/** Brackets one handler invocation inside run().
+
+    Posts made while the scope is active are counted and staged in the
+    frame. The destructor settles the count, including the handler's
+    own unit of work, and publishes the staged handlers.
+*/
+class poll_scheduler::handler_scope
+{
+    poll_scheduler const* sched_;
+    scheduler_context* frame_;
+
+public:
+    handler_scope(
+        poll_scheduler const* sched,
+        scheduler_context* frame) noexcept
+        : sched_(sched)
+        , frame_(frame)
+    {
+        frame_->in_handler = true;
+    }
+
+    ~handler_scope()
+    {
+        frame_->in_handler = false;
+        publish(sched_, *frame_, -1);
+    }
+
+    handler_scope(handler_scope const&) = delete;
+    handler_scope& operator=(handler_scope const&) = delete;
+
+    // Folds the frame's private work, plus `adjust`, into
+    // outstanding_work_ and then releases the staged handlers
+    static void
+    publish(
+        poll_scheduler const* sched,
+        scheduler_context& frame,
+        long adjust) noexcept
+    {
+        long n = frame.private_work + adjust;
+        frame.private_work = 0;
+
+        if (n > 0)
+            sched->outstanding_work_.fetch_add(n, std::memory_order_relaxed);
+
+        while (auto* h = frame.private_ops.pop())
+            sched->enqueue(h);
+
+        // Only the finished handler's own unit can make this negative
+        if (n < 0)
+            sched->work_finished();
+    }
+};
+
+/** Marks the calling thread as running inside the scheduler. */
+class poll_scheduler::run_scope
+{
+    scheduler_context frame_;
+
+public:
+    explicit run_scope(poll_scheduler const* sched) noexcept
+        : frame_{sched, context_stack.get()}
+    {
+        // A handler running a nested loop must not hide its posts
+        if (auto* outer = find_context(sched); outer && outer->in_handler)
+            handler_scope::publish(sched, *outer, 0);
+
+        context_stack.set(&frame_);
+    }
+
+    ~run_scope() noexcept
+    {
+        context_stack.set(frame_.next);
+    }
+
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
+};
+
+poll_scheduler::
+poll_scheduler(
+    capy::execution_context& ctx,
+    int)
+    : pipe_fds_{-1, -1}
+    , outstanding_work_(0)
+    , stopped_(false)
+    , shutdown_(false)
+    , reactor_running_(false)
+    , reactor_interrupted_(false)
+    , idle_thread_count_(0)
+{
+    // Create self-pipe for interrupting poll()
+    if (::pipe(pipe_fds_) < 0)
+        detail::throw_system_error(make_err(errno), "pipe");
+
+    // Set both ends to non-blocking and close-on-exec
+    for (int i = 0; i < 2; ++i)
+    {
+        int flags = ::fcntl(pipe_fds_[i], F_GETFL, 0);
+        if (flags == -1)
+        {
+            int errn = errno;
+            ::close(pipe_fds_[0]);
+            ::close(pipe_fds_[1]);
+            detail::throw_system_error(make_err(errn), "fcntl F_GETFL");
+        }
+        if (::fcntl(pipe_fds_[i], F_SETFL, flags | O_NONBLOCK) == -1)
+        {
+            int errn = errno;
+            ::close(pipe_fds_[0]);
+            ::close(pipe_fds_[1]);
+            detail::throw_system_error(make_err(errn), "fcntl F_SETFL");
+        }
+        if (::fcntl(pipe_fds_[i], F_SETFD, FD_CLOEXEC) == -1)
+        {
+            int errn = errno;
+            ::close(pipe_fds_[0]);
+            ::close(pipe_fds_[1]);
+            detail::throw_system_error(make_err(errn), "fcntl F_SETFD");
+        }
+    }
+
+    pollfds_.push_back({pipe_fds_[0], POLLIN, 0});
+    fd_states_.emplace_back();
+
+    timer_svc_ = &get_timer_service(ctx, *this);
+    timer_svc_->set_on_earliest_changed(
+        timer_service::callback(
+            this,
+            [](void* p) { static_cast<poll_scheduler*>(p)->interrupt_reactor(); }));
+
+    // Initialize resolver service
+    get_resolver_service(ctx, *this);
+
+    // Regular files cannot be waited for; workers run their I/O
+    get_file_service(ctx, *this);
+
+    // Initialize signal service
+    get_signal_service(ctx, *this);
+}
+
+poll_scheduler::
+~poll_scheduler()
+{
+    if (pipe_fds_[0] >= 0)
+        ::close(pipe_fds_[0]);
+    if (pipe_fds_[1] >= 0)
+        ::close(pipe_fds_[1]);
+}
+
+void
+poll_scheduler::
+shutdown()
+{
+    {
+        std::unique_lock lock(mutex_);
+        shutdown_ = true;
+        injected_.pop_all(completed_ops_);
+
+        while (auto* h = completed_ops_.pop())
+        {
+            lock.unlock();
+            h->destroy();
+            lock.lock();
+        }
+    }
+
+    outstanding_work_.store(0, std::memory_order_release);
+
+    if (pipe_fds_[1] >= 0)
+        interrupt_reactor();
+
+    wakeup_event_.notify_all();
+}
+
+void
+poll_scheduler::
+post(capy::coro h) const
+{
+    struct post_handler final
+        : scheduler_op
+        , recycling_op<post_handler>
+    {
+        capy::coro h_;
+
+        explicit
+        post_handler(capy::coro h)
+            : h_(h)
+        {
+        }
+
+        ~post_handler() = default;
+
+        void operator()() override
+        {
+            auto h = h_;
+            delete this;
+            h.resume();
+        }
+
+        void destroy() override
+        {
+            delete this;
+        }
+    };
+
+    auto ph = std::make_unique<post_handler>(h);
+    post(ph.release());
+}
+
+void
+poll_scheduler::
+post(scheduler_op* h) const
+{
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        c->private_ops.push(h);
+        return;
+    }
+
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(h);
+}
+
+void
+poll_scheduler::
+enqueue(scheduler_op* h) const
+{
+    injected_.push(h);
+
+    // Only pay for a wakeup when a consumer is actually parked, see
+    // the matching announcements in do_one() and run_reactor()
+    if (idle_thread_count_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(mutex_);
+        wakeup_event_.notify_one();
+    }
+    else if (reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+    {
+        interrupt_reactor();
+    }
+}
+
+void
+poll_scheduler::
+on_work_started() noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+poll_scheduler::
+on_work_finished() noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        stop();
+}
+
+bool
+poll_scheduler::
+running_in_this_thread() const noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == this)
+            return true;
+    return false;
+}
+
+void
+poll_scheduler::
+stop()
+{
+    bool expected = false;
+    if (stopped_.compare_exchange_strong(expected, true,
+            std::memory_order_release, std::memory_order_relaxed))
+    {
+        // Wake all threads so they notice stopped_ and exit
+        {
+            std::lock_guard lock(mutex_);
+            wakeup_event_.notify_all();
+        }
+        interrupt_reactor();
+    }
+}
+
+bool
+poll_scheduler::
+stopped() const noexcept
+{
+    return stopped_.load(std::memory_order_acquire);
+}
+
+void
+poll_scheduler::
+restart()
+{
+    stopped_.store(false, std::memory_order_release);
+}
+
+std::size_t
+poll_scheduler::
+run()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(-1))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+poll_scheduler::
+run_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(-1);
+}
+
+std::size_t
+poll_scheduler::
+wait_one(long usec)
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(usec);
+}
+
+std::size_t
+poll_scheduler::
+poll()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+
+    std::size_t n = 0;
+    while (do_one(0))
+        if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+    return n;
+}
+
+std::size_t
+poll_scheduler::
+poll_one()
+{
+    if (stopped_.load(std::memory_order_acquire))
+        return 0;
+
+    if (outstanding_work_.load(std::memory_order_acquire) == 0)
+    {
+        stop();
+        return 0;
+    }
+
+    run_scope scope(this);
+    return do_one(0);
+}
+
+void
+poll_scheduler::
+register_fd(int fd, poll_op* op, int events) const
+{
+    if (fd < 0)
+        detail::throw_system_error(make_err(EINVAL), "poll: invalid fd");
+
+    {
+        std::lock_guard lock(mutex_);
+
+        auto const ufd = static_cast<std::size_t>(fd);
+        if (ufd >= fd_index_.size())
+            fd_index_.resize((std::max)(ufd + 1, fd_index_.size() * 2), -1);
+
+        int index = fd_index_[ufd];
+        if (index < 0)
+        {
+            index = static_cast<int>(pollfds_.size());
+            pollfds_.push_back({fd, 0, 0});
+            fd_states_.emplace_back();
+            fd_index_[ufd] = index;
+        }
+
+        auto& pfd = pollfds_[index];
+        auto& state = fd_states_[index];
+        if (events & event_read)
+        {
+            state.read_op = op;
+            pfd.events |= POLLIN;
+        }
+        if (events & event_write)
+        {
+            state.write_op = op;
+            pfd.events |= POLLOUT;
+        }
+        pollfds_changed_ = true;
+    }
+
+    // Wake the reactor so a thread blocked in poll() picks up the
+    // newly registered fd.
+    interrupt_reactor();
+}
+
+void
+poll_scheduler::
+deregister_fd(int fd, int events) const
+{
+    std::lock_guard lock(mutex_);
+
+    auto const ufd = static_cast<std::size_t>(fd);
+    if (fd < 0 || ufd >= fd_index_.size() || fd_index_[ufd] < 0)
+        return;
+
+    auto const index = static_cast<std::size_t>(fd_index_[ufd]);
+    auto& pfd = pollfds_[index];
+    auto& state = fd_states_[index];
+    if (events & event_read)
+    {
+        state.read_op = nullptr;
+        pfd.events &= ~POLLIN;
+    }
+    if (events & event_write)
+    {
+        state.write_op = nullptr;
+        pfd.events &= ~POLLOUT;
+    }
+
+    // Remove entry if both are null
+    if (!state.read_op && !state.write_op)
+        erase_entry(index);
+    pollfds_changed_ = true;
+}
+
+void
+poll_scheduler::
+erase_entry(std::size_t index) const
+{
+    // Swap-remove: the last entry takes over the hole
+    fd_index_[static_cast<std::size_t>(pollfds_[index].fd)] = -1;
+    std::size_t last = pollfds_.size() - 1;
+    if (index != last)
+    {
+        pollfds_[index] = pollfds_[last];
+        fd_states_[index] = fd_states_[last];
+        fd_index_[static_cast<std::size_t>(pollfds_[index].fd)] =
+            static_cast<int>(index);
+    }
+    pollfds_.pop_back();
+    fd_states_.pop_back();
+    pollfds_changed_ = true;
+}
+
+void
+poll_scheduler::
+work_started() const noexcept
+{
+    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+poll_scheduler::
+work_finished() const noexcept
+{
+    if (outstanding_work_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // Last work item completed - wake all threads so they can exit.
+        std::unique_lock lock(mutex_);
+        wakeup_event_.notify_all();
+        if (reactor_running_ && !reactor_interrupted_)
+        {
+            reactor_interrupted_ = true;
+            lock.unlock();
+            interrupt_reactor();
+        }
+    }
+}
+
+void
+poll_scheduler::
+interrupt_reactor() const
+{
+    char byte = 1;
+    [[maybe_unused]] auto r = ::write(pipe_fds_[1], &byte, 1);
+}
+
+void
+poll_scheduler::
+wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const
+{
+    if (idle_thread_count_ > 0)
+    {
+        // Idle worker exists - wake it via condvar
+        wakeup_event_.notify_one();
+        lock.unlock();
+    }
+    else if (reactor_running_ && !reactor_interrupted_)
+    {
+        // No idle workers but reactor is running - interrupt it
+        reactor_interrupted_ = true;
+        lock.unlock();
+        interrupt_reactor();
+    }
+    else
+    {
+        // No one to wake
+        lock.unlock();
+    }
+}
+
+long
+poll_scheduler::
+calculate_timeout(long requested_timeout_us) const
+{
+    if (requested_timeout_us == 0)
+        return 0;
+
+    auto nearest = timer_svc_->nearest_wakeup();
+    if (nearest == timer_service::time_point::max())
+        return requested_timeout_us;
+
+    auto now = std::chrono::steady_clock::now();
+    if (nearest <= now)
+        return 0;
+
+    auto timer_timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        nearest - now).count();
+
+    if (requested_timeout_us < 0)
+        return static_cast<long>(timer_timeout_us);
+
+    return static_cast<long>((std::min)(
+        static_cast<long long>(requested_timeout_us),
+        static_cast<long long>(timer_timeout_us)));
+}
+
+void
+poll_scheduler::
+run_reactor(std::unique_lock<std::mutex>& lock)
+{
+    // Calculate timeout considering timers, use 0 if interrupted
+    long effective_timeout_us = reactor_interrupted_ ? 0 : calculate_timeout(-1);
+
+    int timeout_ms;
+    if (effective_timeout_us < 0)
+        timeout_ms = -1;
+    else
+        timeout_ms = static_cast<int>((effective_timeout_us + 999) / 1000);
+
+    // Refresh the reactor's copy only if registrations changed; poll()
+    // writes nothing but revents, so an unchanged copy is reusable
+    if (pollfds_changed_)
+    {
+        poll_buf_ = pollfds_;
+        pollfds_changed_ = false;
+    }
+
+    lock.unlock();
+
+    // Announce that we may block, then re-check for racing posts
+    if (timeout_ms != 0)
+    {
+        reactor_sleeping_.store(true, std::memory_order_seq_cst);
+        if (!injected_.empty())
+            timeout_ms = 0;
+    }
+
+    int ready = ::poll(poll_buf_.data(),
+        static_cast<nfds_t>(poll_buf_.size()), timeout_ms);
+    int saved_errno = errno;
+    reactor_sleeping_.store(false, std::memory_order_relaxed);
+
+    // Process timers outside the lock
+    timer_svc_->process_expired();
+
+    if (ready < 0 && saved_errno != EINTR)
+        detail::throw_system_error(make_err(saved_errno), "poll");
+
+    // Re-acquire lock before modifying completed_ops_
+    lock.lock();
+
+    // Drain the interrupt pipe if readable
+    if (ready > 0 && poll_buf_[0].revents != 0)
+    {
+        --ready;
+        char buf[256];
+        while (::read(pipe_fds_[0], buf, sizeof(buf)) > 0) {}
+    }
+
+    // Claims `op` from `slot` and performs its I/O, or completes it
+    // with the socket error. Returns true if the op was queued.
+    auto complete_op = [this](poll_op*& slot, int fd, bool has_error)
+    {
+        auto* op = slot;
+        // Claim the op by exchanging to unregistered. Both registering and
+        // registered states mean the op is ours to complete.
+        auto prev = op->registered.exchange(
+            poll_registration_state::unregistered, std::memory_order_acq_rel);
+        if (prev == poll_registration_state::unregistered)
+            return false;
+
+        slot = nullptr;
+
+        if (has_error)
+        {
+            int errn = 0;
+            socklen_t len = sizeof(errn);
+            if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
+                errn = errno;
+            if (errn == 0)
+                errn = EIO;
+            op->complete(errn, 0);
+        }
+        else
+        {
+            op->perform_io();
+        }
+
+        completed_ops_.push(op);
+        return true;
+    };
+
+    // Process I/O completions
+    int completions_queued = 0;
+    for (std::size_t i = 1; ready > 0 && i < poll_buf_.size(); ++i)
+    {
+        auto const& ready_fd = poll_buf_[i];
+        if (ready_fd.revents == 0)
+            continue;
+        --ready;
+
+        // A closed descriptor; its entry is already gone or about to be
+        if (ready_fd.revents & POLLNVAL)
+            continue;
+
+        int fd = ready_fd.fd;
+        int index = fd_index_[static_cast<std::size_t>(fd)];
+        if (index < 0)
+            continue;
+
+        auto& state = fd_states_[index];
+        bool has_error = (ready_fd.revents & POLLERR) != 0;
+        bool readable = (ready_fd.revents & (POLLIN | POLLHUP)) != 0;
+        bool writable = (ready_fd.revents & (POLLOUT | POLLHUP)) != 0;
+
+        if (state.read_op && (readable || has_error) &&
+                complete_op(state.read_op, fd, has_error))
+            ++completions_queued;
+
+        if (state.write_op && (writable || has_error) &&
+                complete_op(state.write_op, fd, has_error))
+            ++completions_queued;
+
+        // Keep the table in step with the remaining ops
+        if (!state.read_op && !state.write_op)
+        {
+            erase_entry(static_cast<std::size_t>(index));
+        }
+        else
+        {
+            auto& pfd = pollfds_[index];
+            auto events = static_cast<short>(
+                (state.read_op ? POLLIN : 0) | (state.write_op ? POLLOUT : 0));
+            if (pfd.events != events)
+            {
+                pfd.events = events;
+                pollfds_changed_ = true;
+            }
+        }
+    }
+
+    // Wake idle workers if we queued I/O completions
+    if (completions_queued > 0)
+    {
+        if (completions_queued >= idle_thread_count_)
+            wakeup_event_.notify_all();
+        else
+            for (int i = 0; i < completions_queued; ++i)
+                wakeup_event_.notify_one();
+    }
+}
+
+std::size_t
+poll_scheduler::
+do_one(long timeout_us)
+{
+    std::unique_lock lock(mutex_);
+
+    using clock = std::chrono::steady_clock;
+    auto deadline = (timeout_us > 0)
+        ? clock::now() + std::chrono::microseconds(timeout_us)
+        : clock::time_point{};
+
+    for (;;)
+    {
+        if (stopped_.load(std::memory_order_acquire))
+            return 0;
+
+        if (!injected_.empty())
+            injected_.pop_all(completed_ops_);
+
+        // Try to get a handler from the queue
+        scheduler_op* op = completed_ops_.pop();
+
+        if (op != nullptr)
+        {
+            // Got a handler - execute it
+            lock.unlock();
+            handler_scope g{this, find_context(this)};
+            (*op)();
+            return 1;
+        }
+
+        // Queue is empty - check if we should become reactor or wait
+        if (outstanding_work_.load(std::memory_order_acquire) == 0)
+            return 0;
+
+        if (timeout_us == 0)
+            return 0;  // Non-blocking poll
+
+        // Check if timeout has expired (for positive timeout_us)
+        long remaining_us = timeout_us;
+        if (timeout_us > 0)
+        {
+            auto now = clock::now();
+            if (now >= deadline)
+                return 0;
+            remaining_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - now).count();
+        }
+
+        if (!reactor_running_)
+        {
+            // No reactor running and queue empty - become the reactor
+            reactor_running_ = true;
+            reactor_interrupted_ = false;
+
+            run_reactor(lock);
+
+            reactor_running_ = false;
+            // Loop back to check for handlers that reactor may have queued
+            continue;
+        }
+
+        // Reactor is running in another thread - wait for work on condvar
+        ++idle_thread_count_;
+        if (!injected_.empty())
+        {
+            // A post raced with the announcement above
+            --idle_thread_count_;
+            continue;
+        }
+        if (timeout_us < 0)
+            wakeup_event_.wait(lock);
+        else
+            wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        --idle_thread_count_;
+    }
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_POLL
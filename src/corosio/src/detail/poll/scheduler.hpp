@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POLL_SCHEDULER_HPP
+#define BOOST_COROSIO_DETAIL_POLL_SCHEDULER_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_POLL
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/scheduler.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/timer_service.hpp"
+
+#include <poll.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace boost::corosio::detail {
+
+struct poll_op;
+
+/** POSIX scheduler using poll() for I/O multiplexing.
+
+    This scheduler implements the scheduler interface using the POSIX
+    poll() call for I/O event notification. It is the fallback for
+    POSIX targets without epoll or kqueue, and unlike select_scheduler
+    it has no FD_SETSIZE limit on descriptor values.
+
+    Registered descriptors live in a dense pollfd array with a parallel
+    array of operation slots. A table indexed by fd locates an entry,
+    and removal swaps the last entry into the hole, so registration
+    changes are O(1) and the array handed to poll() has no gaps.
+
+    The design mirrors select_scheduler for behavioral consistency:
+    - Same single-reactor thread coordination model
+    - Same work counting semantics
+    - Same timer integration pattern
+
+    Known Limitations:
+    - O(n) kernel scan of the pollfd array on every wait
+    - Level-triggered only (no edge-triggered mode)
+
+    @par Thread Safety
+    All public member functions are thread-safe.
+*/
+class poll_scheduler
+    : public scheduler
+    , public capy::execution_context::service
+{
+public:
+    using key_type = scheduler;
+
+    /** Construct the scheduler.
+
+        Creates a self-pipe for reactor interruption.
+
+        @param ctx Reference to the owning execution_context.
+        @param concurrency_hint Hint for expected thread count (unused).
+    */
+    poll_scheduler(
+        capy::execution_context& ctx,
+        int concurrency_hint = -1);
+
+    ~poll_scheduler();
+
+    poll_scheduler(poll_scheduler const&) = delete;
+    poll_scheduler& operator=(poll_scheduler const&) = delete;
+
+    void shutdown() override;
+    void post(capy::coro h) const override;
+    void post(scheduler_op* h) const override;
+    void on_work_started() noexcept override;
+    void on_work_finished() noexcept override;
+    bool running_in_this_thread() const noexcept override;
+    void stop() override;
+    bool stopped() const noexcept override;
+    void restart() override;
+    std::size_t run() override;
+    std::size_t run_one() override;
+    std::size_t wait_one(long usec) override;
+    std::size_t poll() override;
+    std::size_t poll_one() override;
+
+    long outstanding_work() const noexcept override
+    {
+        return outstanding_work_.load(std::memory_order_acquire);
+    }
+
+    /** Register a file descriptor for monitoring.
+
+        @param fd The file descriptor to register.
+        @param op The operation associated with this fd.
+        @param events Event mask: 1 = read, 2 = write, 3 = both.
+    */
+    void register_fd(int fd, poll_op* op, int events) const;
+
+    /** Unregister a file descriptor from monitoring.
+
+        @param fd The file descriptor to unregister.
+        @param events Event mask to remove: 1 = read, 2 = write, 3 = both.
+    */
+    void deregister_fd(int fd, int events) const;
+
+    /** For use by I/O operations to track pending work. */
+    void work_started() const noexcept override;
+
+    /** For use by I/O operations to track completed work. */
+    void work_finished() const noexcept override;
+
+    // Event flags for register_fd/deregister_fd
+    static constexpr int event_read  = 1;
+    static constexpr int event_write = 2;
+
+private:
+    class run_scope;
+    class handler_scope;
+
+    std::size_t do_one(long timeout_us);
+    void enqueue(scheduler_op* h) const;
+    void run_reactor(std::unique_lock<std::mutex>& lock);
+    void erase_entry(std::size_t index) const;
+    void wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const;
+    void interrupt_reactor() const;
+    long calculate_timeout(long requested_timeout_us) const;
+
+    // Self-pipe for interrupting poll()
+    int pipe_fds_[2];  // [0]=read, [1]=write
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable wakeup_event_;
+    mutable op_queue completed_ops_;
+    mutable intrusive_mpsc_queue<scheduler_op> injected_;  // lock-free posts
+    mutable std::atomic<long> outstanding_work_;
+    std::atomic<bool> stopped_;
+    bool shutdown_;
+    timer_service* timer_svc_ = nullptr;
+
+    // Operations registered for the pollfd at the same index
+    struct fd_state
+    {
+        poll_op* read_op = nullptr;
+        poll_op* write_op = nullptr;
+    };
+
+    // Registered descriptors, guarded by mutex_. Entry 0 is the
+    // interrupt pipe, whose fd_state is always empty.
+    mutable std::vector<pollfd> pollfds_;
+    mutable std::vector<fd_state> fd_states_;   // parallel to pollfds_
+    mutable std::vector<int> fd_index_;         // fd -> index, or -1
+    mutable bool pollfds_changed_ = true;
+
+    // Copy of pollfds_ passed to poll(), owned by the reactor thread
+    std::vector<pollfd> poll_buf_;
+
+    // Single reactor thread coordination
+    mutable bool reactor_running_ = false;
+    mutable bool reactor_interrupted_ = false;
+    mutable std::atomic<int> idle_thread_count_ = 0;
+    mutable std::atomic<bool> reactor_sleeping_ = false;
+};
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_POLL
+
+#endif // BOOST_COROSIO_DETAIL_POLL_SCHEDULER_HPP
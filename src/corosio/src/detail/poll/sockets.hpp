@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POLL_SOCKETS_HPP
+#define BOOST_COROSIO_DETAIL_POLL_SOCKETS_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_POLL
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/socket_service.hpp"
+
+#include "src/detail/poll/op.hpp"
+#include "src/detail/poll/scheduler.hpp"
+
+#include <memory>
+#include <mutex>
+
+/*
+    poll Socket Implementation
+    ==========================
+
+    This mirrors the epoll_sockets design for behavioral consistency.
+    Each I/O operation follows the same pattern:
+      1. Try the syscall immediately (non-blocking socket)
+      2. If it succeeds or fails with a real error, post to completion queue
+      3. If EAGAIN/EWOULDBLOCK, register with poll scheduler and wait
+
+    Cancellation
+    ------------
+    See op.hpp for the completion/cancellation race handling via the
+    `registered` atomic. cancel() must complete pending operations (post
+    them with cancelled flag) so coroutines waiting on them can resume.
+    close_socket() calls cancel() first to ensure this.
+
+    Impl Lifetime with shared_ptr
+    -----------------------------
+    Socket impls use enable_shared_from_this. The service owns impls via
+    shared_ptr maps (socket_ptrs_) keyed by raw pointer for O(1) lookup and
+    removal. When a user calls close(), we call cancel() which posts pending
+    ops to the scheduler.
+
+    CRITICAL: The posted ops must keep the impl alive until they complete.
+    Otherwise the scheduler would process a freed op (use-after-free). The
+    cancel() method captures shared_from_this() into op.impl_ptr before
+    posting. When the op completes, impl_ptr is cleared, allowing the impl
+    to be destroyed if no other references exist.
+
+    Service Ownership
+    -----------------
+    poll_socket_service owns all socket impls. destroy_impl() removes the
+    shared_ptr from the map, but the impl may survive if ops still hold
+    impl_ptr refs. shutdown() closes all sockets and clears the map; any
+    in-flight ops will complete and release their refs.
+*/
+
+namespace boost::corosio::detail {
+
+class poll_socket_service;
+class poll_socket_impl;
+
+//------------------------------------------------------------------------------
+
+class poll_socket_impl final
+    : public socket::socket_impl
+    , public std::enable_shared_from_this<poll_socket_impl>
+    , public intrusive_list<poll_socket_impl>::node
+{
+    friend class poll_socket_service;
+
+public:
+    explicit poll_socket_impl(poll_socket_service& svc) noexcept;
+
+    void release() override;
+
+    void connect(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        endpoint,
+        std::stop_token,
+        system::error_code*) override;
+
+    bool read_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool write_some(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        io_buffer_param,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    system::error_code shutdown(socket::shutdown_type what) noexcept override;
+
+    native_handle_type native_handle() const noexcept override { return fd_; }
+
+    // Socket options
+    system::error_code set_no_delay(bool value) noexcept override;
+    bool no_delay(system::error_code& ec) const noexcept override;
+
+    system::error_code set_keep_alive(bool value) noexcept override;
+    bool keep_alive(system::error_code& ec) const noexcept override;
+
+    system::error_code set_receive_buffer_size(int size) noexcept override;
+    int receive_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_send_buffer_size(int size) noexcept override;
+    int send_buffer_size(system::error_code& ec) const noexcept override;
+
+    system::error_code set_linger(bool enabled, int timeout) noexcept override;
+    socket::linger_options linger(system::error_code& ec) const noexcept override;
+
+    endpoint local_endpoint() const noexcept override { return local_endpoint_; }
+    endpoint remote_endpoint() const noexcept override { return remote_endpoint_; }
+    bool is_open() const noexcept { return fd_ >= 0; }
+    void cancel() noexcept override;
+    void cancel_single_op(poll_op& op) noexcept;
+    void close_socket() noexcept;
+    void set_socket(int fd) noexcept { fd_ = fd; }
+    void set_endpoints(endpoint local, endpoint remote) noexcept
+    {
+        local_endpoint_ = local;
+        remote_endpoint_ = remote;
+    }
+
+    poll_connect_op conn_;
+    poll_read_op rd_;
+    poll_write_op wr_;
+
+private:
+    poll_socket_service& svc_;
+    int fd_ = -1;
+    endpoint local_endpoint_;
+    endpoint remote_endpoint_;
+};
+
+//------------------------------------------------------------------------------
+
+/** State for poll socket service. */
+class poll_socket_state
+{
+public:
+    explicit poll_socket_state(poll_scheduler& sched) noexcept
+        : sched_(sched)
+    {
+    }
+
+    poll_scheduler& sched_;
+    std::mutex mutex_;
+    intrusive_list<poll_socket_impl> socket_list_;
+    impl_ptr_map<poll_socket_impl> socket_ptrs_;
+};
+
+/** poll socket service implementation.
+
+    Inherits from socket_service to enable runtime polymorphism.
+    Uses key_type = socket_service for service lookup.
+*/
+class poll_socket_service : public socket_service
+{
+public:
+    explicit poll_socket_service(capy::execution_context& ctx);
+    ~poll_socket_service();
+
+    poll_socket_service(poll_socket_service const&) = delete;
+    poll_socket_service& operator=(poll_socket_service const&) = delete;
+
+    void shutdown() override;
+
+    socket::socket_impl& create_impl() override;
+    void destroy_impl(socket::socket_impl& impl) override;
+    system::error_code open_socket(
+        socket::socket_impl& impl,
+        ip_family family) override;
+    system::error_code assign_socket(
+        socket::socket_impl& impl,
+        native_handle_type fd,
+        endpoint local,
+        endpoint remote) override;
+
+    poll_scheduler& scheduler() const noexcept { return state_->sched_; }
+    void post(poll_op* op);
+    void work_started() noexcept;
+    void work_finished() noexcept;
+
+private:
+    std::unique_ptr<poll_socket_state> state_;
+};
+
+// Backward compatibility alias
+using poll_sockets = poll_socket_service;
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_HAS_POLL
+
+#endif // BOOST_COROSIO_DETAIL_POLL_SOCKETS_HPP
@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_FAST_OPEN_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_FAST_OPEN_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+namespace boost::corosio::detail {
+
+/** Accept TCP Fast Open data in the SYN on a listener.
+
+    Linux takes the length of the queue of connections that have
+    sent data but not finished the handshake. macOS and FreeBSD
+    take an on/off flag, which any positive length sets.
+
+    @param fd The listening socket, bound and not yet listening.
+    @param queue The queue length, greater than zero.
+    @return 0 on success, otherwise the errno value.
+*/
+inline
+int
+set_fast_open_queue(int fd, int queue) noexcept
+{
+#if defined(TCP_FASTOPEN)
+    if (::setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN,
+            &queue, sizeof(queue)) < 0)
+        return errno;
+    return 0;
+#else
+    (void)fd;
+    (void)queue;
+    return EOPNOTSUPP;
+#endif
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_FAST_OPEN_HPP
@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_FILE_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_FILE_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <boost/corosio/file_base.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "src/detail/make_err.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+/*
+    Synchronous file calls shared by the POSIX file services. Opening,
+    sizing and flushing a file do not go through the backend: they are
+    plain system calls made by the caller, as they are for sockets.
+*/
+
+namespace boost::corosio::detail {
+
+/** Open `path` with the given flags.
+
+    @param fd Receives the descriptor on success.
+*/
+inline system::error_code
+open_posix_file(
+    std::string_view path,
+    file_base::flags f,
+    int& fd)
+{
+    int oflags = O_CLOEXEC;
+    if (f & file_base::read_write)
+        oflags |= O_RDWR;
+    else if (f & file_base::write_only)
+        oflags |= O_WRONLY;
+    else
+        oflags |= O_RDONLY;
+    if (f & file_base::append)
+        oflags |= O_APPEND;
+    if (f & file_base::create)
+        oflags |= O_CREAT;
+    if (f & file_base::exclusive)
+        oflags |= O_EXCL;
+    if (f & file_base::truncate)
+        oflags |= O_TRUNC;
+    if (f & file_base::sync_all_on_write)
+        oflags |= O_SYNC;
+
+    std::string p(path);
+    fd = ::open(p.c_str(), oflags, 0644);
+    if (fd < 0)
+        return make_err(errno);
+    return {};
+}
+
+/// Return the size of the file `fd` refers to.
+inline std::uint64_t
+posix_file_size(int fd, system::error_code& ec) noexcept
+{
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ec = make_err(errno);
+        return 0;
+    }
+    ec = {};
+    return static_cast<std::uint64_t>(st.st_size);
+}
+
+/// Extend or truncate the file `fd` refers to.
+inline system::error_code
+posix_file_resize(int fd, std::uint64_t n) noexcept
+{
+    if (n > static_cast<std::uint64_t>(
+            (std::numeric_limits<off_t>::max)()))
+        return make_err(EFBIG);
+    if (::ftruncate(fd, static_cast<off_t>(n)) != 0)
+        return make_err(errno);
+    return {};
+}
+
+/// Flush the file `fd` refers to.
+inline system::error_code
+posix_file_sync(int fd, bool data_only) noexcept
+{
+#if defined(__APPLE__)
+    // fsync on macOS only reaches the drive's cache
+    (void)data_only;
+    int r = ::fcntl(fd, F_FULLFSYNC);
+#elif defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
+    int r = data_only ? ::fdatasync(fd) : ::fsync(fd);
+#else
+    (void)data_only;
+    int r = ::fsync(fd);
+#endif
+    if (r != 0)
+        return make_err(errno);
+    return {};
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_FILE_HPP
@@ -0,0 +1,693 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include "src/detail/posix/file_service.hpp"
+#include "src/detail/posix/file.hpp"
+#include "src/detail/intrusive.hpp"
+#include "src/detail/make_err.hpp"
+#include "src/detail/recycling_allocator.hpp"
+#include "src/detail/resume_coro.hpp"
+#include "src/detail/scheduler_op.hpp"
+#include "src/detail/segment_array.hpp"
+
+#include <boost/corosio/detail/scheduler.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/coro.hpp>
+#include <boost/capy/error.hpp>
+
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace boost::corosio::detail {
+
+class posix_file_impl;
+class posix_file_service_impl;
+
+//------------------------------------------------------------------------------
+
+/// The links of an op in the work queue, guarded by its mutex.
+struct posix_file_work : intrusive_list<posix_file_work>::node
+{
+    bool queued = false;
+};
+
+/** One read or write of a file, run by a worker. */
+struct posix_file_op final
+    : scheduler_op
+    , posix_file_work
+{
+    struct canceller
+    {
+        posix_file_op* op;
+        void operator()() const noexcept;
+    };
+
+    capy::coro h;
+    capy::executor_ref ex;
+    system::error_code* ec_out = nullptr;
+    std::size_t* bytes_out = nullptr;
+
+    iovec_array iovecs;
+    int fd = -1;
+    bool is_write = false;
+    bool append = false;
+    std::uint64_t offset = 0;
+
+    // A stream file's position, set to end_offset on success
+    std::uint64_t* position = nullptr;
+    std::uint64_t end_offset = 0;
+
+    int errn = 0;
+    std::size_t bytes_transferred = 0;
+
+    std::atomic<bool> cancelled{false};
+    std::optional<std::stop_callback<canceller>> stop_cb;
+
+    // See "Impl Lifetime" in the header
+    std::shared_ptr<posix_file_impl> impl_ptr;
+
+    posix_file_op()
+    {
+        data_ = this;
+    }
+
+    void run() noexcept;
+    void operator()() override;
+    void destroy() override;
+};
+
+//------------------------------------------------------------------------------
+
+class posix_file_impl final
+    : public random_access_file::random_access_file_impl
+    , public stream_file::stream_file_impl
+    , public std::enable_shared_from_this<posix_file_impl>
+    , public intrusive_list<posix_file_impl>::node
+{
+    friend struct posix_file_op;
+
+public:
+    explicit posix_file_impl(posix_file_service_impl& svc) noexcept
+        : svc_(svc)
+    {
+    }
+
+    ~posix_file_impl()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    void release() override;
+
+    system::error_code open(
+        std::string_view path,
+        file_base::flags open_flags) override;
+
+    native_file_type native_handle() const noexcept override
+    {
+        return fd_;
+    }
+
+    void cancel() noexcept override;
+
+    std::uint64_t size(system::error_code& ec) const override
+    {
+        return posix_file_size(fd_, ec);
+    }
+
+    system::error_code resize(std::uint64_t n) override
+    {
+        return posix_file_resize(fd_, n);
+    }
+
+    system::error_code sync_all() override
+    {
+        return posix_file_sync(fd_, false);
+    }
+
+    system::error_code sync_data() override
+    {
+        return posix_file_sync(fd_, true);
+    }
+
+    std::uint64_t seek(
+        std::int64_t offset,
+        file_base::seek_basis whence,
+        system::error_code& ec) override;
+
+    bool read_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some_at(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, offset, nullptr,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool read_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(rd_, false, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+    bool write_some(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        return start(wr_, true, h, ex, pos_, &pos_,
+            param, std::move(token), ec, bytes);
+    }
+
+    void cancel_op(posix_file_op& op) noexcept;
+
+private:
+    bool start(
+        posix_file_op& op,
+        bool is_write,
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::uint64_t offset,
+        std::uint64_t* position,
+        io_buffer_param param,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes);
+
+    posix_file_service_impl& svc_;
+    posix_file_op rd_;
+    posix_file_op wr_;
+    int fd_ = -1;
+    bool append_ = false;
+    std::uint64_t pos_ = 0;
+};
+
+//------------------------------------------------------------------------------
+
+class posix_file_service_impl final : public file_service
+{
+public:
+    posix_file_service_impl(
+        capy::execution_context&,
+        scheduler& sched)
+        : sched_(&sched)
+    {
+    }
+
+    posix_file_service_impl(posix_file_service_impl const&) = delete;
+    posix_file_service_impl& operator=(posix_file_service_impl const&) = delete;
+
+    void shutdown() override;
+
+    random_access_file::random_access_file_impl&
+    create_random_access_impl() override
+    {
+        return create_impl();
+    }
+
+    stream_file::stream_file_impl&
+    create_stream_impl() override
+    {
+        return create_impl();
+    }
+
+    void destroy_impl(posix_file_impl& impl);
+
+    void post(scheduler_op* op)
+    {
+        sched_->post(op);
+    }
+
+    void work_started() noexcept
+    {
+        sched_->work_started();
+    }
+
+    void work_finished() noexcept
+    {
+        sched_->work_finished();
+    }
+
+    // Worker pool
+    void submit(posix_file_op* op) noexcept;
+    bool withdraw(posix_file_op* op) noexcept;
+
+    /// The most transfers that run at once.
+    static constexpr std::size_t max_threads = 8;
+
+private:
+    posix_file_impl& create_impl();
+    bool enqueue(posix_file_op* op) noexcept;
+    void stop_workers() noexcept;
+    void work();
+
+    scheduler* sched_;
+    std::mutex mutex_;
+    intrusive_list<posix_file_impl> impl_list_;
+    impl_ptr_map<posix_file_impl> impl_ptrs_;
+
+    // Guards everything below
+    std::mutex work_mutex_;
+    std::condition_variable work_cv_;
+    intrusive_list<posix_file_work> queue_;
+    std::size_t queued_ = 0;
+    std::size_t idle_ = 0;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
+};
+
+//------------------------------------------------------------------------------
+// posix_file_op
+//------------------------------------------------------------------------------
+
+void
+posix_file_op::canceller::
+operator()() const noexcept
+{
+    op->impl_ptr->cancel_op(*op);
+}
+
+void
+posix_file_op::
+run() noexcept
+{
+    auto const n = static_cast<int>(iovecs.size());
+    auto const off = static_cast<off_t>(offset);
+    ssize_t r;
+    do
+    {
+        r = is_write
+            ? ::pwritev(fd, iovecs.data(), n, off)
+            : ::preadv(fd, iovecs.data(), n, off);
+    }
+    while (r < 0 && errno == EINTR);
+
+    if (r < 0)
+    {
+        errn = errno;
+        return;
+    }
+
+    bytes_transferred = static_cast<std::size_t>(r);
+    end_offset = offset + bytes_transferred;
+
+    // An appending write went to the end, wherever that was
+    if (is_write && append && position)
+    {
+        system::error_code ec;
+        auto size = posix_file_size(fd, ec);
+        if (!ec)
+            end_offset = size;
+    }
+}
+
+void
+posix_file_op::
+operator()()
+{
+    stop_cb.reset();
+
+    bool const was_cancelled = cancelled.load(std::memory_order_acquire);
+
+    if (ec_out)
+    {
+        if (was_cancelled)
+            *ec_out = capy::error::canceled;
+        else if (errn != 0)
+            *ec_out = make_err(errn);
+        else if (!is_write && bytes_transferred == 0)
+            *ec_out = capy::error::eof;
+        else
+            *ec_out = {};
+    }
+
+    if (bytes_out)
+        *bytes_out = bytes_transferred;
+
+    if (position && errn == 0)
+        *position = end_offset;
+
+    // The resumed coroutine may close the file
+    auto self = std::move(impl_ptr);
+    auto& svc = self->svc_;
+    capy::executor_ref saved_ex(std::move(ex));
+    capy::coro saved_h(std::move(h));
+    svc.work_finished();
+    resume_coro(saved_ex, saved_h);
+}
+
+void
+posix_file_op::
+destroy()
+{
+    stop_cb.reset();
+    impl_ptr.reset();
+}
+
+//------------------------------------------------------------------------------
+// posix_file_impl
+//------------------------------------------------------------------------------
+
+void
+posix_file_impl::
+release()
+{
+    cancel();
+    svc_.destroy_impl(*this);
+}
+
+system::error_code
+posix_file_impl::
+open(std::string_view path, file_base::flags open_flags)
+{
+    int fd;
+    auto ec = open_posix_file(path, open_flags, fd);
+    if (ec)
+        return ec;
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = fd;
+    append_ = (open_flags & file_base::append) != 0;
+    pos_ = 0;
+    return {};
+}
+
+void
+posix_file_impl::
+cancel() noexcept
+{
+    cancel_op(rd_);
+    cancel_op(wr_);
+}
+
+void
+posix_file_impl::
+cancel_op(posix_file_op& op) noexcept
+{
+    op.cancelled.store(true, std::memory_order_release);
+
+    // A running transfer finishes and reports the cancellation
+    if (svc_.withdraw(&op))
+        svc_.post(&op);
+}
+
+std::uint64_t
+posix_file_impl::
+seek(
+    std::int64_t offset,
+    file_base::seek_basis whence,
+    system::error_code& ec)
+{
+    std::uint64_t size = 0;
+    if (whence == file_base::seek_end)
+    {
+        size = posix_file_size(fd_, ec);
+        if (ec)
+            return pos_;
+    }
+    pos_ = seek_position(pos_, size, offset, whence, ec);
+    return pos_;
+}
+
+bool
+posix_file_impl::
+start(
+    posix_file_op& op,
+    bool is_write,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::uint64_t offset,
+    std::uint64_t* position,
+    io_buffer_param param,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    assign_iovecs(op.iovecs, param);
+
+    // Nothing to transfer, and no end of file to report
+    if (op.iovecs.empty())
+    {
+        *ec = {};
+        *bytes = 0;
+        return true;
+    }
+
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes;
+    op.fd = fd_;
+    op.is_write = is_write;
+    op.append = append_;
+    op.offset = offset;
+    op.position = position;
+    op.end_offset = offset;
+    op.errn = 0;
+    op.bytes_transferred = 0;
+    op.cancelled.store(false, std::memory_order_relaxed);
+    op.impl_ptr = shared_from_this();
+
+    svc_.work_started();
+
+    op.stop_cb.reset();
+    if (token.stop_possible())
+        op.stop_cb.emplace(token, posix_file_op::canceller{&op});
+
+    svc_.submit(&op);
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// posix_file_service_impl
+//------------------------------------------------------------------------------
+
+void
+posix_file_service_impl::
+shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (auto* impl = impl_list_.pop_front())
+            impl->cancel();
+    }
+
+    // Wait for transfers in progress before the files are destroyed
+    stop_workers();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    impl_ptrs_.clear();
+}
+
+posix_file_impl&
+posix_file_service_impl::
+create_impl()
+{
+    auto impl = make_recycled_impl<posix_file_impl>(*this);
+    auto* raw = impl.get();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        impl_list_.push_back(raw);
+        impl_ptrs_.emplace(raw, std::move(impl));
+    }
+
+    return *raw;
+}
+
+void
+posix_file_service_impl::
+destroy_impl(posix_file_impl& impl)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    impl_list_.remove(&impl);
+    impl_ptrs_.erase(&impl);
+}
+
+// Called with work_mutex_ held. Returns false, with the op not
+// queued, if no worker could be started to run it.
+bool
+posix_file_service_impl::
+enqueue(posix_file_op* op) noexcept
+{
+    queue_.push_back(op);
+    op->queued = true;
+    ++queued_;
+
+    if (queued_ <= idle_ || workers_.size() >= max_threads)
+    {
+        work_cv_.notify_one();
+        return true;
+    }
+
+    try
+    {
+        workers_.emplace_back([this] { work(); });
+        return true;
+    }
+    catch (std::system_error const&)
+    {
+        // Another worker will get to it eventually
+        if (!workers_.empty())
+        {
+            work_cv_.notify_one();
+            return true;
+        }
+    }
+
+    queue_.remove(op);
+    op->queued = false;
+    --queued_;
+    return false;
+}
+
+void
+posix_file_service_impl::
+submit(posix_file_op* op) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        if (stopped_)
+            op->cancelled.store(true, std::memory_order_release);
+
+        // Cancelled before it was queued; see cancel_op()
+        if (!op->cancelled.load(std::memory_order_acquire))
+        {
+            if (enqueue(op))
+                return;
+            op->errn = EAGAIN;
+        }
+    }
+    post(op);
+}
+
+bool
+posix_file_service_impl::
+withdraw(posix_file_op* op) noexcept
+{
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    if (!op->queued)
+        return false;
+    queue_.remove(op);
+    op->queued = false;
+    --queued_;
+    return true;
+}
+
+void
+posix_file_service_impl::
+stop_workers() noexcept
+{
+    intrusive_list<posix_file_work> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        stopped_ = true;
+        while (auto* w = queue_.pop_front())
+        {
+            w->queued = false;
+            static_cast<posix_file_op*>(w)->cancelled.store(
+                true, std::memory_order_release);
+            abandoned.push_back(w);
+        }
+        queued_ = 0;
+    }
+    work_cv_.notify_all();
+
+    while (auto* w = abandoned.pop_front())
+        post(static_cast<posix_file_op*>(w));
+
+    // No worker is added once stopped_ is set
+    for (auto& t : workers_)
+        t.join();
+    workers_.clear();
+}
+
+void
+posix_file_service_impl::
+work()
+{
+    std::unique_lock<std::mutex> lock(work_mutex_);
+    for (;;)
+    {
+        while (!stopped_ && queue_.empty())
+        {
+            ++idle_;
+            work_cv_.wait(lock);
+            --idle_;
+        }
+        if (stopped_)
+            return;
+
+        auto* op = static_cast<posix_file_op*>(queue_.pop_front());
+        op->queued = false;
+        --queued_;
+
+        lock.unlock();
+        op->run();
+        post(op);
+        lock.lock();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Free function to get/create the file service
+//------------------------------------------------------------------------------
+
+file_service&
+get_file_service(capy::execution_context& ctx, scheduler& sched)
+{
+    return ctx.make_service<posix_file_service_impl>(sched);
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
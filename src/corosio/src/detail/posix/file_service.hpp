@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_FILE_SERVICE_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_FILE_SERVICE_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+
+#include "src/detail/file_service.hpp"
+
+/*
+    POSIX File Service
+    ==================
+
+    epoll, kqueue, poll and select report regular files as always
+    ready, so a reactor cannot wait for disk I/O. This service runs
+    each read or write as one preadv()/pwritev() on a worker thread
+    and posts the completion back to the scheduler, as the resolver
+    service does for getaddrinfo(). The io_uring backend installs its
+    own file service instead, which needs no threads.
+
+    Worker Pool
+    -----------
+    The service owns a pool of at most max_threads workers, started
+    lazily when more transfers are queued than workers are idle, and
+    joined at shutdown. A burst of reads across many files queues
+    rather than creating a thread each; the bound also caps how many
+    transfers compete for the device at once.
+
+    Cancellation
+    ------------
+    A transfer still queued is withdrawn and completes at once with
+    operation_canceled. One a worker already runs cannot be
+    interrupted and completes normally, reporting the cancellation.
+
+    Impl Lifetime
+    -------------
+    Each op holds a shared_ptr to its impl while queued or running,
+    and the impl closes the descriptor in its destructor, so closing
+    a file while a worker reads it never hands a reused descriptor to
+    that read.
+*/
+
+namespace boost::corosio::detail {
+
+struct scheduler;
+
+/** Get or create the file service for the given context.
+
+    Called by the reactor schedulers during initialization.
+
+    @param ctx Reference to the owning execution_context.
+    @param sched Reference to the scheduler for posting completions.
+    @return Reference to the file service.
+*/
+file_service&
+get_file_service(capy::execution_context& ctx, scheduler& sched);
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_FILE_SERVICE_HPP
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_LISTENER_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_LISTENER_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <boost/corosio/endpoint.hpp>
+
+#include "src/detail/endpoint_convert.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace boost::corosio::detail {
+
+/** Prepare an inherited listening socket for a reactor.
+
+    Checks that `fd` is a TCP socket that is listening, then makes
+    it non-blocking and close-on-exec like the sockets the backends
+    open themselves. The process that handed it over may have
+    cleared close-on-exec to let it through an exec.
+
+    @param fd The socket.
+    @param local Set to the endpoint the socket is bound to.
+    @return 0 on success, otherwise the errno value.
+*/
+inline
+int
+prepare_inherited_listener(int fd, endpoint& local) noexcept
+{
+    int type = 0;
+    socklen_t len = sizeof(type);
+    if (::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) < 0)
+        return errno;
+    if (type != SOCK_STREAM)
+        return EINVAL;
+
+#if defined(SO_ACCEPTCONN)
+    int listening = 0;
+    len = sizeof(listening);
+    if (::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &len) < 0)
+        return errno;
+    if (!listening)
+        return EINVAL;
+#endif
+
+    sockaddr_storage addr{};
+    len = sizeof(addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0)
+        return errno;
+    if (addr.ss_family != AF_INET && addr.ss_family != AF_INET6)
+        return EAFNOSUPPORT;
+
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags == -1 ||
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1 ||
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
+        return errno;
+
+    local = from_sockaddr(addr);
+    return 0;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_LISTENER_HPP
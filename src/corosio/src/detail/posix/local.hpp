@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_LOCAL_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_LOCAL_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*
+    Local Sockets
+    =============
+
+    Unix domain stream sockets use the same impls, ops and reactor
+    paths as TCP sockets; only the address differs. These helpers
+    build the address and pass descriptors over a connection.
+
+    A descriptor travels as SCM_RIGHTS ancillary data attached to at
+    least one byte of normal data, so a read that does not ask for
+    ancillary data would discard it. recv_with_fd asks for room for
+    one descriptor; any others sent with the same bytes are closed,
+    as is one that arrives with MSG_CTRUNC.
+*/
+
+namespace boost::corosio::detail {
+
+/** Build the address of a local socket path.
+
+    A path starting with a NUL byte names a socket in the Linux
+    abstract namespace, and is used with its exact length.
+
+    @param path The socket path.
+    @param sa Receives the address.
+    @param len Receives the length of the address.
+    @return 0 on success, or `ENAMETOOLONG`.
+*/
+inline
+int
+to_sockaddr_un(
+    std::string_view path,
+    sockaddr_un& sa,
+    socklen_t& len) noexcept
+{
+    sa = {};
+    sa.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(sa.sun_path))
+        return ENAMETOOLONG;
+    std::memcpy(sa.sun_path, path.data(), path.size());
+    len = static_cast<socklen_t>(
+        offsetof(sockaddr_un, sun_path) + path.size());
+    // A pathname address includes its terminator
+    if (path.empty() || path[0] != '\0')
+        ++len;
+    return 0;
+}
+
+/** Send bytes with a descriptor attached.
+
+    @return As for sendmsg(2).
+*/
+inline
+ssize_t
+send_with_fd(
+    int sock,
+    iovec* iov,
+    std::size_t iovlen,
+    int fd) noexcept
+{
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovlen;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type = SCM_RIGHTS;
+    cm->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cm), &fd, sizeof(int));
+
+#ifdef MSG_NOSIGNAL
+    return ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+#else
+    return ::sendmsg(sock, &msg, 0);
+#endif
+}
+
+/** Receive bytes and a descriptor sent with them.
+
+    @param fd_out Receives the descriptor, or -1 if none came with
+        the bytes. The descriptor is close-on-exec where the system
+        supports `MSG_CMSG_CLOEXEC`.
+    @return As for recvmsg(2).
+*/
+inline
+ssize_t
+recv_with_fd(
+    int sock,
+    iovec* iov,
+    std::size_t iovlen,
+    int* fd_out) noexcept
+{
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovlen;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+    *fd_out = -1;
+    ssize_t n = ::recvmsg(sock, &msg, flags);
+    if (n < 0)
+        return n;
+
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+    {
+        if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_RIGHTS)
+            continue;
+        std::size_t count =
+            (cm->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            int fd;
+            std::memcpy(&fd, CMSG_DATA(cm) + i * sizeof(int), sizeof(int));
+            if (*fd_out < 0 && !(msg.msg_flags & MSG_CTRUNC))
+                *fd_out = fd;
+            else
+                ::close(fd);
+        }
+    }
+    return n;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_LOCAL_HPP
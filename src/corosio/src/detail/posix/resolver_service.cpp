@@ -14,6 +14,7 @@
 #include "src/detail/posix/resolver_service.hpp"
 #include "src/detail/endpoint_convert.hpp"
 #include "src/detail/intrusive.hpp"
+#include "src/detail/resolver_cache.hpp"
 #include "src/detail/resume_coro.hpp"
 #include "src/detail/scheduler_op.hpp"
 
@@ -32,7 +33,9 @@
 #include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <new>
 #include <optional>
 #include <stop_token>
 #include <string>
@@ -45,8 +48,8 @@
     =============================
 
     This file implements async DNS resolution for POSIX backends using a
-    thread-per-resolution approach. See resolver_service.hpp for the design
-    rationale.
+    pool of worker threads owned by the service. See resolver_service.hpp
+    for the design rationale.
 
     Class Hierarchy
     ---------------
@@ -54,30 +57,59 @@
     - posix_resolver_service_impl (concrete, defined here)
         - Owns all posix_resolver_impl instances via shared_ptr
         - Stores scheduler* for posting completions
+        - Owns the worker threads and the queue of pending lookups
+    - resolver_work (base of what the workers run)
+        - Queue node, cancellation flag and lookup error
+    - resolve_flight (heap-allocated, owned by the service)
+        - One getaddrinfo() call shared by identical forward resolves
+    - resolve_waiter (base of resolve_op)
+        - Links a forward resolve to the flight it waits on
     - posix_resolver_impl (one per resolver object)
         - Contains embedded resolve_op and reverse_resolve_op for reuse
         - Uses shared_from_this to prevent premature destruction
     - resolve_op (forward resolution state)
-        - Uses getaddrinfo() to resolve host/service to endpoints
+        - Waits on a resolve_flight for host/service endpoints
     - reverse_resolve_op (reverse resolution state)
         - Uses getnameinfo() to resolve endpoint to host/service
 
-    Worker Thread Lifetime
-    ----------------------
-    Each resolve() spawns a detached thread. The thread captures a shared_ptr
-    to posix_resolver_impl, ensuring the impl (and its embedded op_) stays
-    alive until the thread completes, even if the resolver is destroyed.
+    Worker Pool
+    -----------
+    resolve() queues its op with the service. A worker is started when
+    more ops are queued than workers are idle, up to max_threads; the
+    workers then live as long as the service. Each op holds a shared_ptr
+    to its posix_resolver_impl from submission until its completion has
+    run, so the impl (and the embedded op) outlives a destroyed resolver.
 
     Completion Flow
     ---------------
     Forward resolution:
-    1. resolve() sets up op_, spawns worker thread
-    2. Worker runs getaddrinfo() (blocking)
-    3. Worker stores results in op_.stored_results
-    4. Worker calls svc_.post(&op_) to queue completion
+    1. resolve() sets up op_ and submits it to the service
+    2. The service attaches op_ to the flight for the same host, service
+       and flags, or queues a new flight if there is none
+    3. A worker takes the flight from the queue and runs getaddrinfo()
+    4. Worker stores the results in every attached op's stored_results
+       and calls svc_.post() for each to queue its completion
     5. Scheduler invokes op_() which resumes the coroutine
 
-    Reverse resolution follows the same pattern using getnameinfo().
+    A burst of identical resolves, such as many coroutines finding the
+    same cache entry expired, thus costs one lookup. An op cancelled
+    while attached is detached and posted at once; a flight left with
+    no ops before a worker took it is withdrawn without a lookup.
+
+    Reverse resolution queues the op itself and runs getnameinfo().
+
+    DNS Cache
+    ---------
+    With the cache enabled, resolve_cached() answers a remembered query
+    before the coroutine suspends. A forward lookup that succeeds, or
+    finds no such host, is stored once it has not been cancelled; other
+    errors are transient and not stored. The first hit within
+    refresh_ahead of an entry's expiry starts a flight with no ops, which
+    forward resolves of the same query may attach to.
+
+    Reverse answers go in a cache of their own, keyed by address and
+    flags, which reverse_resolve_cached() consults the same way; a
+    getnameinfo() that succeeds stores its answer.
 
     Single-Inflight Constraint
     --------------------------
@@ -87,9 +119,8 @@
 
     Shutdown Synchronization
     ------------------------
-    The service tracks active worker threads via thread_started()/thread_finished().
-    During shutdown(), the service sets shutting_down_ flag and waits for all
-    threads to complete before destroying resources.
+    During shutdown(), the service posts every queued op as cancelled, then
+    stops the workers and joins them, which waits for lookups in progress.
 */
 
 namespace boost::corosio::detail {
@@ -143,7 +174,7 @@ convert_results(
     std::string_view host,
     std::string_view service)
 {
-    std::vector<resolver_entry> entries;
+    std::pmr::vector<resolver_entry> entries;
     entries.reserve(4);  // Most lookups return 1-4 addresses
 
     for (auto* p = ai; p != nullptr; p = p->ai_next)
@@ -232,12 +263,156 @@ make_gai_error(int gai_err)
     }
 }
 
+// Return true if a lookup error says the name does not exist,
+// which is worth remembering, rather than a transient failure
+bool
+is_negative_answer(int gai_err) noexcept
+{
+#ifdef EAI_NODATA
+    if (gai_err == EAI_NODATA)
+        return true;
+#endif
+    return gai_err == EAI_NONAME;
+}
+
+// Run getaddrinfo() for a forward resolution
+int
+forward_lookup(
+    std::string const& host,
+    std::string const& service,
+    resolve_flags flags,
+    resolver_results& results) noexcept
+{
+    struct addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = flags_to_hints(flags);
+
+    struct addrinfo* ai = nullptr;
+    int result = ::getaddrinfo(
+        host.empty() ? nullptr : host.c_str(),
+        service.empty() ? nullptr : service.c_str(),
+        &hints, &ai);
+
+    if (result == 0 && ai)
+    {
+        try
+        {
+            results = convert_results(ai, host, service);
+        }
+        catch (std::bad_alloc const&)
+        {
+            result = EAI_MEMORY;
+        }
+    }
+
+    if (ai)
+        ::freeaddrinfo(ai);
+    return result;
+}
+
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
 
 class posix_resolver_impl;
 class posix_resolver_service_impl;
+struct resolve_flight;
+
+//------------------------------------------------------------------------------
+// resolver_work - a lookup queued for or running on a worker
+//------------------------------------------------------------------------------
+
+/** Base of the ops that the service's workers run.
+
+    The queue links and `queued` are guarded by the service's work
+    mutex.
+*/
+struct resolver_work : intrusive_list<resolver_work>::node
+{
+    // Set by cancellation, read by the worker and the completion
+    std::atomic<bool> cancelled{false};
+
+    // Lookup error, or EAI_MEMORY if no worker could be started
+    int gai_error = 0;
+
+    bool queued = false;
+
+    /// Run the blocking lookup, then post the completion.
+    virtual void run() noexcept = 0;
+
+    /// Post the completion without running the lookup.
+    virtual void complete() noexcept = 0;
+
+protected:
+    ~resolver_work() = default;
+};
+
+/** Base of a forward resolve, which waits on a shared lookup.
+
+    The links and `flight` are guarded by the service's work mutex.
+*/
+struct resolve_waiter : intrusive_list<resolve_waiter>::node
+{
+    // Set by cancellation, read by the completion
+    std::atomic<bool> cancelled{false};
+
+    // Lookup error, or EAI_MEMORY if the lookup could not be queued
+    int gai_error = 0;
+
+    // Result storage (populated by the flight's worker)
+    resolver_results stored_results;
+
+    // The flight this waits on, if attached
+    resolve_flight* flight = nullptr;
+
+    /// Post the completion.
+    virtual void complete() noexcept = 0;
+
+protected:
+    ~resolve_waiter() = default;
+};
+
+/** One forward lookup, shared by identical resolves.
+
+    Forward resolves with the same host, service and flags that start
+    while a flight is queued or running attach to it and all complete
+    from its result. A flight deletes itself once it has finished.
+*/
+struct resolve_flight final : resolver_work
+{
+    posix_resolver_service_impl& svc;
+    std::string host;
+    std::string service;
+    resolve_flags flags;
+
+    // Started by the DNS cache, so kept even without waiters
+    bool refresh = false;
+
+    // Guarded by the service's work mutex
+    intrusive_list<resolve_waiter> waiters;
+
+    resolve_flight(
+        posix_resolver_service_impl& svc_,
+        std::string_view host_,
+        std::string_view service_,
+        resolve_flags flags_)
+        : svc(svc_)
+        , host(host_)
+        , service(service_)
+        , flags(flags_)
+    {
+    }
+
+    resolver_query
+    query() const noexcept
+    {
+        return {host, service, flags};
+    }
+
+    void run() noexcept override;
+    void complete() noexcept override;
+};
 
 //------------------------------------------------------------------------------
 // posix_resolver_impl - per-resolver implementation
@@ -294,7 +469,7 @@ public:
     // resolve_op - operation state for a single DNS resolution
     //--------------------------------------------------------------------------
 
-    struct resolve_op : scheduler_op
+    struct resolve_op : scheduler_op, resolve_waiter
     {
         struct canceller
         {
@@ -316,13 +491,9 @@ public:
         std::string service;
         resolve_flags flags = resolve_flags::none;
 
-        // Result storage (populated by worker thread)
-        resolver_results stored_results;
-        int gai_error = 0;
-
         // Thread coordination
-        std::atomic<bool> cancelled{false};
         std::optional<std::stop_callback<canceller>> stop_cb;
+        std::shared_ptr<posix_resolver_impl> keep_alive;
 
         resolve_op()
         {
@@ -332,6 +503,7 @@ public:
         void reset() noexcept;
         void operator()() override;
         void destroy() override;
+        void complete() noexcept override;
         void request_cancel() noexcept;
         void start(std::stop_token token);
     };
@@ -340,7 +512,7 @@ public:
     // reverse_resolve_op - operation state for reverse DNS resolution
     //--------------------------------------------------------------------------
 
-    struct reverse_resolve_op : scheduler_op
+    struct reverse_resolve_op : scheduler_op, resolver_work
     {
         struct canceller
         {
@@ -364,11 +536,10 @@ public:
         // Result storage (populated by worker thread)
         std::string stored_host;
         std::string stored_service;
-        int gai_error = 0;
 
         // Thread coordination
-        std::atomic<bool> cancelled{false};
         std::optional<std::stop_callback<canceller>> stop_cb;
+        std::shared_ptr<posix_resolver_impl> keep_alive;
 
         reverse_resolve_op()
         {
@@ -378,6 +549,8 @@ public:
         void reset() noexcept;
         void operator()() override;
         void destroy() override;
+        void run() noexcept override;
+        void complete() noexcept override;
         void request_cancel() noexcept;
         void start(std::stop_token token);
     };
@@ -410,6 +583,19 @@ public:
 
     void cancel() noexcept override;
 
+    bool resolve_cached(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        system::error_code*,
+        resolver_results*) noexcept override;
+
+    bool reverse_resolve_cached(
+        endpoint const& ep,
+        reverse_flags flags,
+        system::error_code*,
+        reverse_resolver_result*) noexcept override;
+
     resolve_op op_;
     reverse_resolve_op reverse_op_;
 
@@ -442,26 +628,84 @@ public:
 
     void shutdown() override;
     resolver::resolver_impl& create_impl() override;
+    void set_cache(resolver_cache_options const& opts) override;
     void destroy_impl(posix_resolver_impl& impl);
 
     void post(scheduler_op* op);
     void work_started() noexcept;
     void work_finished() noexcept;
 
-    // Thread tracking for safe shutdown
-    void thread_started() noexcept;
-    void thread_finished() noexcept;
+    // Worker pool
+    void submit(resolver_work* w) noexcept;
+    bool withdraw(resolver_work* w) noexcept;
+
+    // Shared forward lookups
+    void submit_resolve(
+        resolve_waiter* w,
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags) noexcept;
+    bool detach(resolve_waiter* w) noexcept;
+    void finish_flight(
+        resolve_flight* f,
+        int gai_err,
+        resolver_results const& results) noexcept;
     bool is_shutting_down() const noexcept;
 
+    /// The most lookups that run at once.
+    static constexpr std::size_t max_threads = 16;
+
+    // DNS cache
+    bool resolve_cached(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        system::error_code* ec,
+        resolver_results* out) noexcept;
+    void cache_result(
+        std::string const& host,
+        std::string const& service,
+        resolve_flags flags,
+        int gai_err,
+        resolver_results const& results) noexcept;
+    bool reverse_resolve_cached(
+        endpoint const& ep,
+        reverse_flags flags,
+        reverse_resolver_result* out) noexcept;
+    void cache_reverse_result(
+        endpoint const& ep,
+        reverse_flags flags,
+        std::string const& host,
+        std::string const& service) noexcept;
+
 private:
+    bool enqueue(resolver_work* w) noexcept;
+    void start_refresh(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags) noexcept;
+    void stop_workers() noexcept;
+    void work();
+
     scheduler* sched_;
     std::mutex mutex_;
-    std::condition_variable cv_;
     std::atomic<bool> shutting_down_{false};
-    std::size_t active_threads_ = 0;
     intrusive_list<posix_resolver_impl> resolver_list_;
     std::unordered_map<posix_resolver_impl*,
         std::shared_ptr<posix_resolver_impl>> resolver_ptrs_;
+    resolver_cache cache_;
+    reverse_resolver_cache reverse_cache_;
+
+    // Guards everything below
+    std::mutex work_mutex_;
+    std::condition_variable work_cv_;
+    intrusive_list<resolver_work> queue_;
+    std::size_t queued_ = 0;
+    std::size_t idle_ = 0;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
+    std::unordered_map<resolver_query, resolve_flight*,
+        resolver_query_hash, resolver_query_equal> flights_;
 };
 
 //------------------------------------------------------------------------------
@@ -477,6 +721,7 @@ reset() noexcept
     flags = resolve_flags::none;
     stored_results = resolver_results{};
     gai_error = 0;
+    flight = nullptr;
     cancelled.store(false, std::memory_order_relaxed);
     stop_cb.reset();
     ec_out = nullptr;
@@ -504,6 +749,8 @@ operator()()
     if (out && !was_cancelled && gai_error == 0)
         *out = std::move(stored_results);
 
+    // The resumed coroutine may destroy the resolver
+    auto self = std::move(keep_alive);
     impl->svc_.work_finished();
     resume_coro(ex, h);
 }
@@ -512,14 +759,28 @@ void
 posix_resolver_impl::resolve_op::
 destroy()
 {
+    auto self = std::move(keep_alive);
     stop_cb.reset();
 }
 
+void
+posix_resolver_impl::resolve_op::
+complete() noexcept
+{
+    // Always post so the scheduler can properly drain the op
+    // during shutdown via destroy().
+    impl->svc_.post(this);
+}
+
 void
 posix_resolver_impl::resolve_op::
 request_cancel() noexcept
 {
     cancelled.store(true, std::memory_order_release);
+
+    // A resolve waiting on a lookup completes now
+    if (impl && impl->svc_.detach(this))
+        complete();
 }
 
 void
@@ -576,6 +837,8 @@ operator()()
             ep, std::move(stored_host), std::move(stored_service));
     }
 
+    // The resumed coroutine may destroy the resolver
+    auto self = std::move(keep_alive);
     impl->svc_.work_finished();
     resume_coro(ex, h);
 }
@@ -584,14 +847,82 @@ void
 posix_resolver_impl::reverse_resolve_op::
 destroy()
 {
+    auto self = std::move(keep_alive);
     stop_cb.reset();
 }
 
+void
+posix_resolver_impl::reverse_resolve_op::
+run() noexcept
+{
+    // Build sockaddr from endpoint
+    sockaddr_storage ss{};
+    socklen_t ss_len;
+
+    if (ep.is_v4())
+    {
+        auto sa = to_sockaddr_in(ep);
+        std::memcpy(&ss, &sa, sizeof(sa));
+        ss_len = sizeof(sockaddr_in);
+    }
+    else
+    {
+        auto sa = to_sockaddr_in6(ep);
+        std::memcpy(&ss, &sa, sizeof(sa));
+        ss_len = sizeof(sockaddr_in6);
+    }
+
+    char host[NI_MAXHOST];
+    char service[NI_MAXSERV];
+
+    int result = ::getnameinfo(
+        reinterpret_cast<sockaddr*>(&ss), ss_len,
+        host, sizeof(host),
+        service, sizeof(service),
+        flags_to_ni_flags(flags));
+
+    if (!cancelled.load(std::memory_order_acquire))
+    {
+        if (result == 0)
+        {
+            try
+            {
+                stored_host = host;
+                stored_service = service;
+                gai_error = 0;
+                impl->svc_.cache_reverse_result(
+                    ep, flags, stored_host, stored_service);
+            }
+            catch (std::bad_alloc const&)
+            {
+                gai_error = EAI_MEMORY;
+            }
+        }
+        else
+        {
+            gai_error = result;
+        }
+    }
+
+    complete();
+}
+
+void
+posix_resolver_impl::reverse_resolve_op::
+complete() noexcept
+{
+    impl->svc_.post(this);
+}
+
 void
 posix_resolver_impl::reverse_resolve_op::
 request_cancel() noexcept
 {
     cancelled.store(true, std::memory_order_release);
+
+    // A lookup that has not started completes now
+    if (impl && impl->svc_.withdraw(this))
+        complete();
 }
 
 void
@@ -644,59 +975,9 @@ resolve(
     // Keep io_context alive while resolution is pending
     op.ex.on_work_started();
 
-    // Track thread for safe shutdown
-    svc_.thread_started();
-
-    try
-    {
-        // Prevent impl destruction while worker thread is running
-        auto self = this->shared_from_this();
-        std::thread worker([this, self = std::move(self)]() {
-            struct addrinfo hints{};
-            hints.ai_family = AF_UNSPEC;
-            hints.ai_socktype = SOCK_STREAM;
-            hints.ai_flags = flags_to_hints(op_.flags);
-
-            struct addrinfo* ai = nullptr;
-            int result = ::getaddrinfo(
-                op_.host.empty() ? nullptr : op_.host.c_str(),
-                op_.service.empty() ? nullptr : op_.service.c_str(),
-                &hints, &ai);
-
-            if (!op_.cancelled.load(std::memory_order_acquire))
-            {
-                if (result == 0 && ai)
-                {
-                    op_.stored_results = convert_results(ai, op_.host, op_.service);
-                    op_.gai_error = 0;
-                }
-                else
-                {
-                    op_.gai_error = result;
-                }
-            }
-
-            if (ai)
-                ::freeaddrinfo(ai);
-
-            // Always post so the scheduler can properly drain the op
-            // during shutdown via destroy().
-            svc_.post(&op_);
-
-            // Signal thread completion for shutdown synchronization
-            svc_.thread_finished();
-        });
-        worker.detach();
-    }
-    catch (std::system_error const&)
-    {
-        // Thread creation failed - no thread was started
-        svc_.thread_finished();
-
-        // Set error and post completion to avoid hanging the coroutine
-        op_.gai_error = EAI_MEMORY;  // Map to "not enough memory"
-        svc_.post(&op_);
-    }
+    // Prevent impl destruction until the completion has run
+    op.keep_alive = shared_from_this();
+    svc_.submit_resolve(&op, op.host, op.service, op.flags);
 }
 
 void
@@ -724,80 +1005,67 @@ reverse_resolve(
     // Keep io_context alive while resolution is pending
     op.ex.on_work_started();
 
-    // Track thread for safe shutdown
-    svc_.thread_started();
-
-    try
-    {
-        // Prevent impl destruction while worker thread is running
-        auto self = this->shared_from_this();
-        std::thread worker([this, self = std::move(self)]() {
-            // Build sockaddr from endpoint
-            sockaddr_storage ss{};
-            socklen_t ss_len;
-
-            if (reverse_op_.ep.is_v4())
-            {
-                auto sa = to_sockaddr_in(reverse_op_.ep);
-                std::memcpy(&ss, &sa, sizeof(sa));
-                ss_len = sizeof(sockaddr_in);
-            }
-            else
-            {
-                auto sa = to_sockaddr_in6(reverse_op_.ep);
-                std::memcpy(&ss, &sa, sizeof(sa));
-                ss_len = sizeof(sockaddr_in6);
-            }
-
-            char host[NI_MAXHOST];
-            char service[NI_MAXSERV];
+    // Prevent impl destruction until the completion has run
+    op.keep_alive = shared_from_this();
+    svc_.submit(&op);
+}
 
-            int result = ::getnameinfo(
-                reinterpret_cast<sockaddr*>(&ss), ss_len,
-                host, sizeof(host),
-                service, sizeof(service),
-                flags_to_ni_flags(reverse_op_.flags));
+void
+posix_resolver_impl::
+cancel() noexcept
+{
+    op_.request_cancel();
+    reverse_op_.request_cancel();
+}
 
-            if (!reverse_op_.cancelled.load(std::memory_order_acquire))
-            {
-                if (result == 0)
-                {
-                    reverse_op_.stored_host = host;
-                    reverse_op_.stored_service = service;
-                    reverse_op_.gai_error = 0;
-                }
-                else
-                {
-                    reverse_op_.gai_error = result;
-                }
-            }
+bool
+posix_resolver_impl::
+resolve_cached(
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags,
+    system::error_code* ec,
+    resolver_results* out) noexcept
+{
+    return svc_.resolve_cached(host, service, flags, ec, out);
+}
 
-            // Always post so the scheduler can properly drain the op
-            // during shutdown via destroy().
-            svc_.post(&reverse_op_);
+bool
+posix_resolver_impl::
+reverse_resolve_cached(
+    endpoint const& ep,
+    reverse_flags flags,
+    system::error_code* ec,
+    reverse_resolver_result* out) noexcept
+{
+    if (!svc_.reverse_resolve_cached(ep, flags, out))
+        return false;
+    *ec = {};
+    return true;
+}
 
-            // Signal thread completion for shutdown synchronization
-            svc_.thread_finished();
-        });
-        worker.detach();
-    }
-    catch (std::system_error const&)
-    {
-        // Thread creation failed - no thread was started
-        svc_.thread_finished();
+//------------------------------------------------------------------------------
+// resolve_flight implementation
+//------------------------------------------------------------------------------
 
-        // Set error and post completion to avoid hanging the coroutine
-        reverse_op_.gai_error = EAI_MEMORY;
-        svc_.post(&reverse_op_);
-    }
+void
+resolve_flight::
+run() noexcept
+{
+    resolver_results results;
+    int result = forward_lookup(host, service, flags, results);
+    svc.cache_result(host, service, flags, result, results);
+    svc.finish_flight(this, result, results);
 }
 
 void
-posix_resolver_impl::
-cancel() noexcept
+resolve_flight::
+complete() noexcept
 {
-    op_.request_cancel();
-    reverse_op_.request_cancel();
+    // Abandoned without a lookup; the waiters see gai_error, or
+    // cancellation if the service stopped
+    resolver_results none;
+    svc.finish_flight(this, gai_error, none);
 }
 
 //------------------------------------------------------------------------------
@@ -825,11 +1093,16 @@ shutdown()
         resolver_ptrs_.clear();
     }
 
-    // Wait for all worker threads to finish before service is destroyed
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        cv_.wait(lock, [this] { return active_threads_ == 0; });
-    }
+    // Wait for lookups in progress before the service is destroyed
+    stop_workers();
+}
+
+void
+posix_resolver_service_impl::
+set_cache(resolver_cache_options const& opts)
+{
+    cache_.configure(opts);
+    reverse_cache_.configure(opts);
 }
 
 resolver::resolver_impl&
@@ -878,21 +1151,272 @@ work_finished() noexcept
     sched_->work_finished();
 }
 
+// Called with work_mutex_ held. Returns false, with the work not
+// queued, if no worker could be started to run it.
+bool
+posix_resolver_service_impl::
+enqueue(resolver_work* w) noexcept
+{
+    queue_.push_back(w);
+    w->queued = true;
+    ++queued_;
+
+    if (queued_ <= idle_ || workers_.size() >= max_threads)
+    {
+        work_cv_.notify_one();
+        return true;
+    }
+
+    try
+    {
+        workers_.emplace_back([this] { work(); });
+        return true;
+    }
+    catch (std::system_error const&)
+    {
+        // Another worker will get to it eventually
+        if (!workers_.empty())
+        {
+            work_cv_.notify_one();
+            return true;
+        }
+    }
+
+    queue_.remove(w);
+    w->queued = false;
+    --queued_;
+    return false;
+}
+
 void
 posix_resolver_service_impl::
-thread_started() noexcept
+submit(resolver_work* w) noexcept
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    ++active_threads_;
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        if (stopped_)
+            w->cancelled.store(true, std::memory_order_release);
+
+        // Cancelled before it was queued; see request_cancel()
+        if (!w->cancelled.load(std::memory_order_acquire))
+        {
+            if (enqueue(w))
+                return;
+            w->gai_error = EAI_MEMORY;  // Map to "not enough memory"
+        }
+    }
+    w->complete();
 }
 
 void
 posix_resolver_service_impl::
-thread_finished() noexcept
+submit_resolve(
+    resolve_waiter* w,
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags) noexcept
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    --active_threads_;
-    cv_.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        if (stopped_)
+            w->cancelled.store(true, std::memory_order_release);
+
+        // Cancelled before it was attached; see request_cancel()
+        if (!w->cancelled.load(std::memory_order_acquire))
+        {
+            auto it = flights_.find(resolver_query{host, service, flags});
+            if (it != flights_.end())
+            {
+                it->second->waiters.push_back(w);
+                w->flight = it->second;
+                return;
+            }
+
+            resolve_flight* f = nullptr;
+            try
+            {
+                f = new resolve_flight(*this, host, service, flags);
+                flights_.emplace(f->query(), f);
+            }
+            catch (std::bad_alloc const&)
+            {
+                delete f;
+                f = nullptr;
+            }
+
+            if (f)
+            {
+                f->waiters.push_back(w);
+                w->flight = f;
+                if (enqueue(f))
+                    return;
+                flights_.erase(f->query());
+                delete f;
+                w->flight = nullptr;
+            }
+            w->gai_error = EAI_MEMORY;  // Map to "not enough memory"
+        }
+    }
+    w->complete();
+}
+
+bool
+posix_resolver_service_impl::
+detach(resolve_waiter* w) noexcept
+{
+    resolve_flight* abandoned = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        auto* f = w->flight;
+        if (!f)
+            return false;
+        f->waiters.remove(w);
+        w->flight = nullptr;
+
+        // Nobody wants a lookup that has not started
+        if (f->waiters.empty() && f->queued && !f->refresh)
+        {
+            queue_.remove(f);
+            f->queued = false;
+            --queued_;
+            flights_.erase(f->query());
+            abandoned = f;
+        }
+    }
+    delete abandoned;
+    return true;
+}
+
+void
+posix_resolver_service_impl::
+finish_flight(
+    resolve_flight* f,
+    int gai_err,
+    resolver_results const& results) noexcept
+{
+    bool const cancelled = f->cancelled.load(std::memory_order_acquire);
+    intrusive_list<resolve_waiter> done;
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        flights_.erase(f->query());
+        while (auto* w = f->waiters.pop_front())
+        {
+            w->flight = nullptr;
+            done.push_back(w);
+        }
+    }
+
+    while (auto* w = done.pop_front())
+    {
+        if (cancelled)
+            w->cancelled.store(true, std::memory_order_release);
+        w->gai_error = gai_err;
+        if (gai_err == 0)
+            w->stored_results = results;  // Shares the entries
+        w->complete();
+    }
+    delete f;
+}
+
+void
+posix_resolver_service_impl::
+start_refresh(
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        if (stopped_)
+            return;
+
+        // A lookup in flight stores the entry anyway
+        if (flights_.find(resolver_query{host, service, flags}) !=
+            flights_.end())
+            return;
+
+        resolve_flight* f = nullptr;
+        try
+        {
+            f = new resolve_flight(*this, host, service, flags);
+            f->refresh = true;
+            flights_.emplace(f->query(), f);
+            if (enqueue(f))
+                return;
+            flights_.erase(f->query());
+        }
+        catch (std::bad_alloc const&)
+        {
+        }
+        delete f;
+    }
+    cache_.end_refresh(host, service, flags);
+}
+
+bool
+posix_resolver_service_impl::
+withdraw(resolver_work* w) noexcept
+{
+    std::lock_guard<std::mutex> lock(work_mutex_);
+    if (!w->queued)
+        return false;
+    queue_.remove(w);
+    w->queued = false;
+    --queued_;
+    return true;
+}
+
+void
+posix_resolver_service_impl::
+stop_workers() noexcept
+{
+    intrusive_list<resolver_work> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(work_mutex_);
+        stopped_ = true;
+        while (auto* w = queue_.pop_front())
+        {
+            w->queued = false;
+            w->cancelled.store(true, std::memory_order_release);
+            abandoned.push_back(w);
+        }
+        queued_ = 0;
+    }
+    work_cv_.notify_all();
+
+    while (auto* w = abandoned.pop_front())
+        w->complete();
+
+    // No worker is added once stopped_ is set
+    for (auto& t : workers_)
+        t.join();
+    workers_.clear();
+}
+
+void
+posix_resolver_service_impl::
+work()
+{
+    std::unique_lock<std::mutex> lock(work_mutex_);
+    for (;;)
+    {
+        while (!stopped_ && queue_.empty())
+        {
+            ++idle_;
+            work_cv_.wait(lock);
+            --idle_;
+        }
+        if (stopped_)
+            return;
+
+        auto* w = queue_.pop_front();
+        w->queued = false;
+        --queued_;
+
+        lock.unlock();
+        w->run();
+        lock.lock();
+    }
 }
 
 bool
@@ -902,6 +1426,101 @@ is_shutting_down() const noexcept
     return shutting_down_.load(std::memory_order_acquire);
 }
 
+bool
+posix_resolver_service_impl::
+resolve_cached(
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags,
+    system::error_code* ec,
+    resolver_results* out) noexcept
+{
+    if (!cache_.enabled())
+        return false;
+
+    try
+    {
+        auto r = cache_.find(host, service, flags, ec, out);
+        if (r == resolver_cache::lookup::hit_refresh)
+            start_refresh(host, service, flags);
+        return r != resolver_cache::lookup::miss;
+    }
+    catch (std::exception const&)
+    {
+        // Out of memory or a lock failure; do the lookup instead
+        return false;
+    }
+}
+
+void
+posix_resolver_service_impl::
+cache_result(
+    std::string const& host,
+    std::string const& service,
+    resolve_flags flags,
+    int gai_err,
+    resolver_results const& results) noexcept
+{
+    if (!cache_.enabled())
+        return;
+
+    try
+    {
+        if (gai_err == 0)
+            cache_.store(host, service, flags, results);
+        else if (is_negative_answer(gai_err))
+            cache_.store_negative(
+                host, service, flags, make_gai_error(gai_err));
+        else
+            cache_.end_refresh(host, service, flags);
+    }
+    catch (std::exception const&)
+    {
+        // Not remembered; the next resolve looks it up again
+    }
+}
+
+bool
+posix_resolver_service_impl::
+reverse_resolve_cached(
+    endpoint const& ep,
+    reverse_flags flags,
+    reverse_resolver_result* out) noexcept
+{
+    if (!reverse_cache_.enabled())
+        return false;
+
+    try
+    {
+        return reverse_cache_.find(ep, flags, out);
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+
+void
+posix_resolver_service_impl::
+cache_reverse_result(
+    endpoint const& ep,
+    reverse_flags flags,
+    std::string const& host,
+    std::string const& service) noexcept
+{
+    if (!reverse_cache_.enabled())
+        return;
+
+    try
+    {
+        reverse_cache_.store(ep, flags, host, service);
+    }
+    catch (std::exception const&)
+    {
+        // Not remembered; the next resolve looks it up again
+    }
+}
+
 //------------------------------------------------------------------------------
 // Free function to get/create the resolver service
 //------------------------------------------------------------------------------
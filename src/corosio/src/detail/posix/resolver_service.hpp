@@ -23,26 +23,44 @@
     ======================
 
     POSIX getaddrinfo() is a blocking call that cannot be monitored with
-    epoll/kqueue/io_uring. We use a worker thread approach: each resolution
-    spawns a dedicated thread that runs the blocking call and posts completion
-    back to the scheduler.
+    epoll/kqueue/io_uring. We use worker threads: each resolution is queued
+    with the service, and a worker runs the blocking call and posts
+    completion back to the scheduler.
 
     This follows the timer_service pattern:
     - posix_resolver_service is an abstract base class (no scheduler dependency)
     - posix_resolver_service_impl is the concrete implementation
     - get_resolver_service(ctx, sched) creates the service with scheduler ref
 
-    Thread-per-resolution Design
-    ----------------------------
-    Simple, no thread pool complexity. DNS lookups are infrequent enough that
-    thread creation overhead is acceptable. Detached threads self-manage;
-    shared_ptr capture keeps impl alive until completion.
+    Worker Pool
+    -----------
+    The service owns a pool of at most max_threads workers, started lazily
+    when more resolutions are queued than workers are idle, and joined at
+    shutdown. Bursts of lookups, such as a proxy resolving many upstream
+    hosts, queue instead of creating a thread each, which would cost a
+    thread creation per lookup and could exhaust the process's thread
+    limit. shared_ptr ownership held by each op keeps its impl alive until
+    completion.
+
+    Shared Lookups
+    --------------
+    Forward resolves with the same host, service and flags that start while
+    a lookup for them is queued or running attach to it and complete from
+    its result, so a burst of identical resolves costs one getaddrinfo().
+
+    DNS Cache
+    ---------
+    set_resolver_cache() enables a cache of forward resolves shared by the
+    context's resolvers. A hit completes in await_ready() without a worker.
+    A hit close to expiry also queues one background lookup that replaces
+    the entry, so names in steady use are never looked up in line.
 
     Cancellation
     ------------
     getaddrinfo() cannot be interrupted mid-call. We use an atomic flag to
-    indicate cancellation was requested. The worker thread checks this flag
-    after getaddrinfo() returns and reports the appropriate error.
+    indicate cancellation was requested. A resolution still queued is removed
+    and completes at once; a running one checks the flag after getaddrinfo()
+    returns and reports the appropriate error.
 */
 
 namespace boost::corosio::detail {
@@ -63,6 +81,9 @@ public:
     /** Create a new resolver implementation. */
     virtual resolver::resolver_impl& create_impl() = 0;
 
+    /** Set the options of the DNS cache. */
+    virtual void set_cache(resolver_cache_options const& opts) = 0;
+
 protected:
     posix_resolver_service() = default;
 };
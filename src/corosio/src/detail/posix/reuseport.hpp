@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_REUSEPORT_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_REUSEPORT_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <errno.h>
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif
+
+/*
+    Reuseport CPU Steering
+    ======================
+
+    Without a program, the kernel picks the listener of a SO_REUSEPORT
+    group by hashing the connection's addresses. The classic BPF
+    program attached here returns the number of the CPU handling the
+    incoming SYN instead, which the kernel uses as an index into the
+    group. Listeners join the group in the order they start listening,
+    so when listener `i` is served by a thread pinned to CPU `i`, a
+    connection is accepted on the core whose softirq received it. An
+    index past the end of the group falls back to the hash.
+
+    The program belongs to the group, so attaching it from every
+    listener just replaces it with an identical one.
+*/
+
+namespace boost::corosio::detail {
+
+/** Attach the CPU steering program to a SO_REUSEPORT listener.
+
+    @param fd The listening socket, already bound with SO_REUSEPORT.
+    @return 0 on success, otherwise the errno value.
+*/
+inline
+int
+attach_cpu_steering(int fd) noexcept
+{
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    sock_filter code[] = {
+        { BPF_LD | BPF_W | BPF_ABS, 0, 0,
+            static_cast<__u32>(SKF_AD_OFF + SKF_AD_CPU) },
+        { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    sock_fprog prog{};
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    if (::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+            &prog, sizeof(prog)) < 0)
+        return errno;
+    return 0;
+#else
+    (void)fd;
+    return EOPNOTSUPP;
+#endif
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_REUSEPORT_HPP
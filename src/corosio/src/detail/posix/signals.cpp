@@ -12,6 +12,7 @@
 #if BOOST_COROSIO_POSIX
 
 #include "src/detail/posix/signals.hpp"
+#include "src/detail/deferred_service.hpp"
 
 #include <boost/corosio/detail/scheduler.hpp>
 #include <boost/corosio/detail/except.hpp>
@@ -29,7 +30,9 @@
 #include <mutex>
 #include <stop_token>
 
+#include <pthread.h>
 #include <signal.h>
+#include <time.h>
 
 /*
     POSIX Signal Implementation
@@ -126,6 +129,24 @@
 
     If a signal was already queued (undelivered > 0), no work tracking is needed
     because completion is posted immediately.
+
+    signalfd Delivery
+    -----------------
+
+    A reactor with a signalfd (epoll, with epoll_options::use_signalfd)
+    hands the service a watch function with set_signal_fd(). When the
+    service gains its first registration of a signal it blocks the
+    signal in the calling thread, which threads created later inherit,
+    and adds it to the signalfd. A signal blocked in every thread stays
+    pending until the reactor reads it and calls deliver_signal() from
+    its own loop, where taking the mutexes is safe. The handler stays
+    installed: a thread that does not block the signal still receives
+    it through the handler, as without a signalfd.
+
+    Removing the last registration of a signal unblocks it in the
+    calling thread, if the service blocked it, after discarding an
+    instance still pending. Unblocking a pending signal would run the
+    handler in this thread, which holds the mutexes the handler takes.
 */
 
 namespace boost::corosio {
@@ -237,6 +258,8 @@ public:
     void cancel_wait(posix_signal_impl& impl);
     void start_wait(posix_signal_impl& impl, signal_op* op);
 
+    void set_signal_fd(void* ctx, signal_fd_watch fn) override;
+
     static void deliver_signal(int signal_number);
 
     void work_started() noexcept;
@@ -247,7 +270,14 @@ private:
     static void add_service(posix_signals_impl* service);
     static void remove_service(posix_signals_impl* service);
 
+    // Called with both mutexes held, when this service gains its
+    // first or loses its last registration of a signal
+    void watch_signal_locked(int signal_number);
+    void unwatch_signal_locked(int signal_number, bool last_global);
+
     scheduler* sched_;
+    void* fd_ctx_ = nullptr;
+    signal_fd_watch fd_watch_ = nullptr;
     std::mutex mutex_;
     intrusive_list<posix_signal_impl> impl_list_;
 
@@ -274,6 +304,9 @@ struct signal_state
     posix_signals_impl* service_list = nullptr;
     std::size_t registration_count[max_signal_number] = {};
     signal_set::flags_t registered_flags[max_signal_number] = {};
+
+    // Signals blocked for a signalfd, which were not blocked before
+    bool blocked[max_signal_number] = {};
 };
 
 signal_state* get_signal_state()
@@ -588,6 +621,9 @@ add_signal(
         registrations_[signal_number]->prev_in_table = new_reg;
     registrations_[signal_number] = new_reg;
 
+    if (registration_count_[signal_number] == 0)
+        watch_signal_locked(signal_number);
+
     ++state->registration_count[signal_number];
     ++registration_count_[signal_number];
 
@@ -618,6 +654,10 @@ remove_signal(
     if (!reg || reg->signal_number != signal_number)
         return {};
 
+    if (registration_count_[signal_number] == 1)
+        unwatch_signal_locked(signal_number,
+            state->registration_count[signal_number] == 1);
+
     // Restore default handler on last global unregistration
     if (state->registration_count[signal_number] == 1)
     {
@@ -663,6 +703,10 @@ clear_signals(posix_signal_impl& impl)
     {
         int signal_number = reg->signal_number;
 
+        if (registration_count_[signal_number] == 1)
+            unwatch_signal_locked(signal_number,
+                state->registration_count[signal_number] == 1);
+
         if (state->registration_count[signal_number] == 1)
         {
             struct sigaction sa = {};
@@ -794,6 +838,62 @@ deliver_signal(int signal_number)
     }
 }
 
+void
+posix_signals_impl::
+set_signal_fd(void* ctx, signal_fd_watch fn)
+{
+    std::lock_guard lock(mutex_);
+    fd_ctx_ = ctx;
+    fd_watch_ = fn;
+}
+
+void
+posix_signals_impl::
+watch_signal_locked(int signal_number)
+{
+    if (!fd_watch_)
+        return;
+
+    signal_state* state = get_signal_state();
+    if (!state->blocked[signal_number])
+    {
+        sigset_t set;
+        sigset_t old;
+        sigemptyset(&set);
+        sigaddset(&set, signal_number);
+        if (::pthread_sigmask(SIG_BLOCK, &set, &old) == 0 &&
+            !sigismember(&old, signal_number))
+            state->blocked[signal_number] = true;
+    }
+    fd_watch_(fd_ctx_, signal_number, true);
+}
+
+void
+posix_signals_impl::
+unwatch_signal_locked(int signal_number, bool last_global)
+{
+    if (!fd_watch_)
+        return;
+
+    fd_watch_(fd_ctx_, signal_number, false);
+
+    signal_state* state = get_signal_state();
+    if (!last_global || !state->blocked[signal_number])
+        return;
+    state->blocked[signal_number] = false;
+
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, signal_number);
+#if BOOST_COROSIO_HAS_EPOLL
+    // Only epoll has a signalfd; sigtimedwait is not on every system
+    timespec const zero{};
+    while (::sigtimedwait(&set, nullptr, &zero) > 0)
+        ;
+#endif
+    ::pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+}
+
 void
 posix_signals_impl::
 work_started() noexcept
@@ -859,6 +959,12 @@ get_signal_service(capy::execution_context& ctx, scheduler& sched)
     return ctx.make_service<posix_signals_impl>(sched);
 }
 
+void
+deliver_posix_signal(int signal_number)
+{
+    posix_signals_impl::deliver_signal(signal_number);
+}
+
 } // namespace detail
 
 //------------------------------------------------------------------------------
@@ -876,7 +982,8 @@ signal_set::
 signal_set(capy::execution_context& ctx)
     : io_object(ctx)
 {
-    auto* svc = ctx.find_service<detail::posix_signals>();
+    auto* svc = detail::find_deferred_service<detail::posix_signals>(
+        ctx, detail::deferred_service::signal);
     if (!svc)
         detail::throw_logic_error("signal_set: signal service not initialized");
     impl_ = &svc->create_impl();
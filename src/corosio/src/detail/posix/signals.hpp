@@ -51,6 +51,22 @@ public:
     /** Create a new signal set implementation. */
     virtual signal_set::signal_set_impl& create_impl() = 0;
 
+    /** Function that adds a signal to, or removes it from, a signalfd.
+
+        Called with `watch == true` when the service gains its first
+        registration of a signal, and `false` when it loses its last.
+    */
+    using signal_fd_watch = void(*)(void* ctx, int signal_number, bool watch);
+
+    /** Route the signals of this service through a reactor's signalfd.
+
+        Each signal is then also blocked in the thread that adds it,
+        so that it stays pending for the signalfd. The reactor passes
+        what it reads to @ref deliver_posix_signal. Must be called
+        before any signal is added.
+    */
+    virtual void set_signal_fd(void* ctx, signal_fd_watch fn) = 0;
+
 protected:
     posix_signals() = default;
 };
@@ -69,6 +85,14 @@ protected:
 posix_signals&
 get_signal_service(capy::execution_context& ctx, scheduler& sched);
 
+/** Deliver a signal read from a signalfd.
+
+    Completes or queues the signal for every signal_set of every
+    context, as the signal handler does.
+*/
+void
+deliver_posix_signal(int signal_number);
+
 } // namespace boost::corosio::detail
 
 #endif // BOOST_COROSIO_POSIX
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_POSIX_TIMESTAMPING_HPP
+#define BOOST_COROSIO_DETAIL_POSIX_TIMESTAMPING_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_POSIX
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#endif
+
+/*
+    Kernel Timestamps
+    =================
+
+    With SO_TIMESTAMPING the kernel stamps each segment as it arrives
+    and each send as it is handed to the network device, using the
+    realtime clock. A receive timestamp comes as SCM_TIMESTAMPING
+    ancillary data on recvmsg(); a read that does not ask for it
+    drops it. A transmit timestamp is queued on the socket's error
+    queue, with OPT_TSONLY so that the sent bytes are not looped
+    back, and is read there by the reactor.
+
+    Of the three times in scm_timestamping, the first holds the
+    software timestamp and the third a raw hardware one; the
+    software one is requested, and the hardware one is used when a
+    device was configured to provide it instead.
+*/
+
+namespace boost::corosio::detail {
+
+/** Turn kernel receive and transmit timestamps on or off.
+
+    @return 0 on success, otherwise the errno value.
+*/
+inline
+int
+set_timestamping(int fd, bool enabled) noexcept
+{
+#if defined(SO_TIMESTAMPING) && defined(SOF_TIMESTAMPING_OPT_TSONLY)
+    int flags = enabled
+        ? SOF_TIMESTAMPING_RX_SOFTWARE |
+          SOF_TIMESTAMPING_TX_SOFTWARE |
+          SOF_TIMESTAMPING_SOFTWARE |
+          SOF_TIMESTAMPING_RAW_HARDWARE |
+          SOF_TIMESTAMPING_OPT_TSONLY
+        : 0;
+    if (::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING,
+            &flags, sizeof(flags)) < 0)
+        return errno == ENOPROTOOPT ? EOPNOTSUPP : errno;
+    return 0;
+#else
+    (void)fd;
+    (void)enabled;
+    return EOPNOTSUPP;
+#endif
+}
+
+/** Return the kernel timestamp carried by a received message.
+
+    @return Nanoseconds since the epoch, or 0 if there is none.
+*/
+inline
+std::int64_t
+find_timestamp(msghdr& msg) noexcept
+{
+#if defined(SO_TIMESTAMPING) && defined(SCM_TIMESTAMPING)
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+    {
+        if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_TIMESTAMPING)
+            continue;
+        timespec ts[3];
+        std::memcpy(ts, CMSG_DATA(cm), sizeof(ts));
+        timespec const& t = (ts[0].tv_sec || ts[0].tv_nsec) ? ts[0] : ts[2];
+        return std::int64_t(t.tv_sec) * 1000000000 + t.tv_nsec;
+    }
+#else
+    (void)msg;
+#endif
+    return 0;
+}
+
+/** Receive bytes along with their kernel timestamp.
+
+    The timestamp is stored only if `*ts_out` is still 0, so that a
+    read made of several calls keeps the time of the first.
+
+    @return As for recvmsg(2).
+*/
+inline
+ssize_t
+recv_with_timestamp(
+    int sock,
+    iovec* iov,
+    std::size_t iovlen,
+    std::int64_t* ts_out) noexcept
+{
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec) * 3)];
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovlen;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n = ::recvmsg(sock, &msg, 0);
+    if (n > 0 && *ts_out == 0)
+        *ts_out = find_timestamp(msg);
+    return n;
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_POSIX
+
+#endif // BOOST_COROSIO_DETAIL_POSIX_TIMESTAMPING_HPP
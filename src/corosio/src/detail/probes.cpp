@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include "src/detail/probes.hpp"
+
+#if BOOST_COROSIO_HAS_PROBES && defined(__linux__)
+
+// The kernel finds each semaphore through the probe's note and
+// raises it while a tracer is attached
+extern "C" {
+#define BOOST_COROSIO_PROBE_SEMAPHORE(name) \
+    __attribute__((section(".probes"), used)) \
+    volatile unsigned short corosio_##name##_semaphore = 0;
+BOOST_COROSIO_PROBE_LIST(BOOST_COROSIO_PROBE_SEMAPHORE)
+#undef BOOST_COROSIO_PROBE_SEMAPHORE
+}
+
+#elif BOOST_COROSIO_HAS_PROBES && BOOST_COROSIO_HAS_IOCP
+
+// The provider id is the one tools derive from the name "Boost.Corosio"
+TRACELOGGING_DEFINE_PROVIDER(
+    boost_corosio_provider,
+    "Boost.Corosio",
+    (0x1822e481, 0x0bd7, 0x5bef,
+        0x3f, 0x24, 0xd0, 0x48, 0x42, 0x7f, 0xcf, 0xb3));
+
+namespace {
+
+// Registered for the life of the module
+struct provider_registration
+{
+    provider_registration() noexcept
+    {
+        ::TraceLoggingRegister(boost_corosio_provider);
+    }
+
+    ~provider_registration()
+    {
+        ::TraceLoggingUnregister(boost_corosio_provider);
+    }
+};
+
+provider_registration const registration;
+
+} // namespace
+
+#endif
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_PROBES_HPP
+#define BOOST_COROSIO_DETAIL_PROBES_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+/*
+    Static Probes
+    =============
+
+    Built with BOOST_COROSIO_USE_PROBES, the library carries static
+    tracepoints for profilers to attach to a running process: USDT
+    probes of provider "corosio" on Linux, where <sys/sdt.h> is
+    available, and TraceLogging events of provider "Boost.Corosio" on
+    Windows. Without it every probe expands to nothing.
+
+    A USDT probe is a nop instruction with a note naming it, and each
+    has a semaphore that the kernel raises while a tracer is attached,
+    so its arguments are computed only then. TraceLogging checks its
+    own enabled flag before evaluating the fields. Either way a probe
+    that is not being traced costs a load and a branch.
+
+    Every argument is passed as a 64-bit integer, pointers by address,
+    so a script reads them the same way on both platforms:
+
+        reactor_wait_enter  timeout in milliseconds, -1 for none
+        reactor_wait_exit   events returned, -1 on error
+        handler_start       handler address
+        handler_done        handler address, which may now be freed
+        socket_read         descriptor, bytes, error code
+        socket_write        descriptor, bytes, error code
+        socket_accept       listening descriptor, new descriptor, error
+        socket_connect      descriptor, error code
+        timer_fire          timer address
+
+    For example, with bpftrace:
+
+        bpftrace -e 'usdt:/path/libboost_corosio.so:corosio:socket_read
+            { @bytes = hist(arg1); }'
+*/
+
+// Each probe, for the semaphores and the list above
+#define BOOST_COROSIO_PROBE_LIST(X) \
+    X(reactor_wait_enter)           \
+    X(reactor_wait_exit)            \
+    X(handler_start)                \
+    X(handler_done)                 \
+    X(socket_read)                  \
+    X(socket_write)                 \
+    X(socket_accept)                \
+    X(socket_connect)               \
+    X(timer_fire)
+
+namespace boost::corosio::detail {
+
+/// Convert a probe argument to the integer passed to the tracer.
+template<class T>
+constexpr std::int64_t
+probe_arg(T v) noexcept
+{
+    if constexpr (std::is_pointer_v<T>)
+        return static_cast<std::int64_t>(
+            reinterpret_cast<std::uintptr_t>(v));
+    else
+        return static_cast<std::int64_t>(v);
+}
+
+} // namespace boost::corosio::detail
+
+#if defined(BOOST_COROSIO_USE_PROBES) && defined(__linux__) && \
+    __has_include(<sys/sdt.h>)
+
+#define BOOST_COROSIO_HAS_PROBES 1
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define BOOST_COROSIO_PROBE_SEMAPHORE(name) \
+    extern "C" volatile unsigned short corosio_##name##_semaphore;
+BOOST_COROSIO_PROBE_LIST(BOOST_COROSIO_PROBE_SEMAPHORE)
+#undef BOOST_COROSIO_PROBE_SEMAPHORE
+
+#define BOOST_COROSIO_PROBE_ENABLED(name) \
+    (__builtin_expect(corosio_##name##_semaphore != 0, 0))
+
+#define BOOST_COROSIO_PROBE1(name, a1)                              \
+    do {                                                            \
+        if (BOOST_COROSIO_PROBE_ENABLED(name))                      \
+            STAP_PROBE1(corosio, name,                              \
+                ::boost::corosio::detail::probe_arg(a1));           \
+    } while (0)
+
+#define BOOST_COROSIO_PROBE2(name, a1, a2)                          \
+    do {                                                            \
+        if (BOOST_COROSIO_PROBE_ENABLED(name))                      \
+            STAP_PROBE2(corosio, name,                              \
+                ::boost::corosio::detail::probe_arg(a1),            \
+                ::boost::corosio::detail::probe_arg(a2));           \
+    } while (0)
+
+#define BOOST_COROSIO_PROBE3(name, a1, a2, a3)                      \
+    do {                                                            \
+        if (BOOST_COROSIO_PROBE_ENABLED(name))                      \
+            STAP_PROBE3(corosio, name,                              \
+                ::boost::corosio::detail::probe_arg(a1),            \
+                ::boost::corosio::detail::probe_arg(a2),            \
+                ::boost::corosio::detail::probe_arg(a3));           \
+    } while (0)
+
+#elif defined(BOOST_COROSIO_USE_PROBES) && BOOST_COROSIO_HAS_IOCP
+
+#define BOOST_COROSIO_HAS_PROBES 1
+
+#include "src/detail/iocp/windows.hpp"
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(boost_corosio_provider);
+
+#define BOOST_COROSIO_PROBE_ENABLED(name) \
+    TraceLoggingProviderEnabled(boost_corosio_provider, 0, 0)
+
+#define BOOST_COROSIO_PROBE1(name, a1)                              \
+    TraceLoggingWrite(boost_corosio_provider, #name,                \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a1), "arg0"))
+
+#define BOOST_COROSIO_PROBE2(name, a1, a2)                          \
+    TraceLoggingWrite(boost_corosio_provider, #name,                \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a1), "arg0"),       \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a2), "arg1"))
+
+#define BOOST_COROSIO_PROBE3(name, a1, a2, a3)                      \
+    TraceLoggingWrite(boost_corosio_provider, #name,                \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a1), "arg0"),       \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a2), "arg1"),       \
+        TraceLoggingInt64(                                          \
+            ::boost::corosio::detail::probe_arg(a3), "arg2"))
+
+#else
+
+#define BOOST_COROSIO_HAS_PROBES 0
+
+#define BOOST_COROSIO_PROBE_ENABLED(name) false
+#define BOOST_COROSIO_PROBE1(name, a1) ((void)0)
+#define BOOST_COROSIO_PROBE2(name, a1, a2) ((void)0)
+#define BOOST_COROSIO_PROBE3(name, a1, a2, a3) ((void)0)
+
+#endif
+
+#endif
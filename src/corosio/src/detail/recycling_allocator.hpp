@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_RECYCLING_ALLOCATOR_HPP
+#define BOOST_COROSIO_DETAIL_RECYCLING_ALLOCATOR_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include "src/detail/huge_page_arena.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+namespace boost::corosio::detail {
+
+/** Per-thread memory recycling for socket and acceptor impls.
+
+    An allocator for `std::allocate_shared` and node-based containers
+    that keeps single-object blocks of each type in a thread-local
+    free list, as @ref recycling_op does for handlers. A program that
+    closes and opens connections at a high rate then reuses the same
+    impl and control block memory instead of going to the global
+    allocator, and to its locks, for every socket.
+
+    Blocks freed on a thread other than the one that allocated them
+    join that thread's list, so the lists do not depend on the
+    lifetime of any service. Each thread keeps at most `max_cached`
+    blocks per type; allocations of more than one object, such as
+    hash table buckets, always use the global allocator. Single
+    blocks come from the huge page arena when there is one.
+*/
+template<class T>
+class recycling_allocator
+{
+    struct block
+    {
+        block* next;
+    };
+
+    union slot
+    {
+        block b;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct cache
+    {
+        block* head = nullptr;
+        std::size_t size = 0;
+
+        ~cache()
+        {
+            while (head)
+            {
+                auto* b = head;
+                head = b->next;
+                pool_deallocate(b, sizeof(slot));
+            }
+            // Blocks freed later on this thread bypass the cache
+            size = max_cached;
+        }
+    };
+
+    static constexpr std::size_t max_cached = 64;
+
+    static cache& local() noexcept
+    {
+        thread_local cache c;
+        return c;
+    }
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+public:
+    using value_type = T;
+
+    recycling_allocator() = default;
+
+    template<class U>
+    recycling_allocator(recycling_allocator<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        auto& c = local();
+        if (n == 1 && c.head)
+        {
+            auto* b = c.head;
+            c.head = b->next;
+            --c.size;
+            return reinterpret_cast<T*>(b);
+        }
+        if (n == 1)
+            return static_cast<T*>(pool_allocate(sizeof(slot)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        auto& c = local();
+        if (n == 1 && c.size < max_cached)
+        {
+            auto* b = ::new(static_cast<void*>(p)) block{c.head};
+            c.head = b;
+            ++c.size;
+            return;
+        }
+        if (n == 1)
+            pool_deallocate(p, sizeof(slot));
+        else
+            ::operator delete(p);
+    }
+
+    template<class U>
+    friend bool operator==(
+        recycling_allocator const&,
+        recycling_allocator<U> const&) noexcept
+    {
+        return true;
+    }
+};
+
+/// Create an impl whose memory, with its control block, is recycled.
+template<class Impl, class... Args>
+std::shared_ptr<Impl>
+make_recycled_impl(Args&&... args)
+{
+    return std::allocate_shared<Impl>(
+        recycling_allocator<Impl>(), std::forward<Args>(args)...);
+}
+
+/// The owning map of a service's impls, with recycled nodes.
+template<class Impl>
+using impl_ptr_map = std::unordered_map<
+    Impl*,
+    std::shared_ptr<Impl>,
+    std::hash<Impl*>,
+    std::equal_to<Impl*>,
+    recycling_allocator<std::pair<Impl* const, std::shared_ptr<Impl>>>>;
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_RECYCLING_OP_HPP
+#define BOOST_COROSIO_DETAIL_RECYCLING_OP_HPP
+
+#include <boost/corosio/detail/config.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace boost::corosio::detail {
+
+/** Per-thread memory recycling for heap-allocated handlers.
+
+    Deriving a handler from `recycling_op<Derived>` replaces its
+    `operator new` and `operator delete` with a small thread-local
+    free list of `sizeof(Derived)` blocks. Combined with the
+    "delete-before-invoke" contract of @ref scheduler_op, a handler
+    that is freed and then resumes a coroutine which posts again
+    gets the same block back, so steady-state posting performs no
+    calls into the global allocator.
+
+    Blocks freed on a thread other than the one that allocated
+    them simply join that thread's list. Each thread keeps at most
+    `max_cached` blocks; the rest go back to the global allocator.
+
+    @tparam Derived The most-derived handler type. Must be final,
+        so every allocation through this base has the same size.
+*/
+template<class Derived>
+class recycling_op
+{
+    struct block
+    {
+        block* next;
+    };
+
+    struct cache
+    {
+        block* head = nullptr;
+        std::size_t size = 0;
+
+        ~cache()
+        {
+            while (head)
+            {
+                auto* b = head;
+                head = b->next;
+                ::operator delete(b);
+            }
+            // Handlers freed later on this thread bypass the cache
+            size = max_cached;
+        }
+    };
+
+    static constexpr std::size_t max_cached = 16;
+
+    static cache& local() noexcept
+    {
+        thread_local cache c;
+        return c;
+    }
+
+public:
+    static void* operator new(std::size_t n)
+    {
+        static_assert(sizeof(Derived) >= sizeof(block));
+
+        auto& c = local();
+        if (n == sizeof(Derived) && c.head)
+        {
+            auto* b = c.head;
+            c.head = b->next;
+            --c.size;
+            return b;
+        }
+        return ::operator new(n);
+    }
+
+    static void operator delete(void* p, std::size_t n) noexcept
+    {
+        auto& c = local();
+        if (n == sizeof(Derived) && c.size < max_cached)
+        {
+            auto* b = static_cast<block*>(p);
+            b->next = c.head;
+            c.head = b;
+            ++c.size;
+            return;
+        }
+        ::operator delete(p);
+    }
+};
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_RESOLV_CONF_HPP
+#define BOOST_COROSIO_DETAIL_RESOLV_CONF_HPP
+
+#include <boost/corosio/endpoint.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost::corosio::detail {
+
+/** The parts of resolv.conf(5) a stub resolver uses. */
+struct resolv_conf
+{
+    /// The name servers, on port 53, in the order listed.
+    std::vector<endpoint> servers;
+
+    /// Time to wait for an answer before trying the next server.
+    std::chrono::seconds timeout{5};
+
+    /// Rounds over all servers before giving up.
+    int attempts = 2;
+
+    /// Start at a different server for each query.
+    bool rotate = false;
+};
+
+namespace resolv_conf_detail {
+
+inline int
+parse_option(std::string_view opt, std::string_view name, int lo, int hi)
+{
+    int v = 0;
+    for (char c : opt.substr(name.size()))
+    {
+        if (c < '0' || c > '9')
+            return -1;
+        v = (std::min)(v * 10 + (c - '0'), hi);
+    }
+    return (std::max)(v, lo);
+}
+
+} // namespace resolv_conf_detail
+
+/** Parse the text of resolv.conf(5).
+
+    Reads `nameserver` lines, up to three as the C library does, and
+    the `timeout:`, `attempts:` and `rotate` options. Everything
+    else is ignored. Without a name server the local one is used.
+*/
+inline resolv_conf
+parse_resolv_conf(std::string_view text)
+{
+    resolv_conf conf;
+    std::istringstream in{std::string(text)};
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream words(line);
+        std::string key;
+        if (!(words >> key) || key[0] == '#' || key[0] == ';')
+            continue;
+
+        if (key == "nameserver")
+        {
+            std::string addr;
+            if (!(words >> addr) || conf.servers.size() >= 3)
+                continue;
+            // A zone index, as in fe80::1%eth0, is not supported
+            if (auto r = urls::parse_ipv4_address(addr))
+                conf.servers.emplace_back(*r, 53);
+            else if (auto r6 = urls::parse_ipv6_address(addr))
+                conf.servers.emplace_back(*r6, 53);
+        }
+        else if (key == "options")
+        {
+            std::string opt;
+            while (words >> opt)
+            {
+                std::string_view o = opt;
+                if (o.starts_with("timeout:"))
+                {
+                    int v = resolv_conf_detail::parse_option(o, "timeout:", 1, 30);
+                    if (v > 0)
+                        conf.timeout = std::chrono::seconds(v);
+                }
+                else if (o.starts_with("attempts:"))
+                {
+                    int v = resolv_conf_detail::parse_option(o, "attempts:", 1, 5);
+                    if (v > 0)
+                        conf.attempts = v;
+                }
+                else if (o == "rotate")
+                {
+                    conf.rotate = true;
+                }
+            }
+        }
+    }
+
+    if (conf.servers.empty())
+        conf.servers.emplace_back(urls::ipv4_address::loopback(), 53);
+    return conf;
+}
+
+/** Read and parse a resolv.conf(5) file.
+
+    A file that cannot be read yields the defaults.
+*/
+inline resolv_conf
+load_resolv_conf(char const* path = "/etc/resolv.conf")
+{
+    std::ifstream f(path);
+    std::stringstream text;
+    if (f)
+        text << f.rdbuf();
+    return parse_resolv_conf(text.str());
+}
+
+} // namespace boost::corosio::detail
+
+#endif
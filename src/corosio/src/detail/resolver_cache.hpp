@@ -0,0 +1,460 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_RESOLVER_CACHE_HPP
+#define BOOST_COROSIO_DETAIL_RESOLVER_CACHE_HPP
+
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/resolver.hpp>
+#include <boost/corosio/resolver_results.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace boost::corosio::detail {
+
+/** The parameters of a forward resolve, viewed. */
+struct resolver_query
+{
+    std::string_view host;
+    std::string_view service;
+    resolve_flags flags;
+};
+
+/** Hash of a @ref resolver_query. */
+struct resolver_query_hash
+{
+    using is_transparent = void;
+
+    std::size_t
+    operator()(resolver_query q) const noexcept
+    {
+        std::hash<std::string_view> h;
+        std::size_t seed = h(q.host);
+        seed ^= h(q.service) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= static_cast<std::size_t>(q.flags) +
+            0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+/** Equality of @ref resolver_query. */
+struct resolver_query_equal
+{
+    using is_transparent = void;
+
+    bool
+    operator()(resolver_query a, resolver_query b) const noexcept
+    {
+        return a.flags == b.flags &&
+            a.host == b.host &&
+            a.service == b.service;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Remembered answers of forward resolves.
+
+    Entries are keyed by host, service and flags. A positive entry
+    holds the results, which share their storage with every copy
+    handed out; a negative entry holds the "host not found" error.
+    When the cache is full, an expired entry is evicted if there is
+    one, else the entry closest to expiry.
+
+    @par Thread Safety
+    All member functions may be called concurrently.
+*/
+class resolver_cache
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /** The outcome of @ref find. */
+    enum class lookup
+    {
+        /// Not cached, or expired
+        miss,
+
+        /// Answered from the cache
+        hit,
+
+        /// Answered from the cache; the caller should refresh the entry
+        /// and then call @ref end_refresh
+        hit_refresh
+    };
+
+    /** Replace the options and forget every entry. */
+    void
+    configure(resolver_cache_options const& opts)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        opts_ = opts;
+        map_.clear();
+        enabled_.store(opts.max_entries > 0, std::memory_order_release);
+    }
+
+    /// Return `true` if the cache is enabled.
+    bool
+    enabled() const noexcept
+    {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    /** Look up a query.
+
+        On a hit, `*ec` and `*results` receive the answer. Of the hits
+        on a positive entry within `refresh_ahead` of its expiry, the
+        first returns @ref lookup::hit_refresh.
+    */
+    lookup
+    find(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        system::error_code* ec,
+        resolver_results* results)
+    {
+        if (!enabled())
+            return lookup::miss;
+
+        auto const now = clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(resolver_query{host, service, flags});
+        if (it == map_.end())
+            return lookup::miss;
+
+        auto& e = it->second;
+        if (now >= e.expires)
+        {
+            // A refresh in flight will store the entry again
+            if (!e.refreshing)
+                map_.erase(it);
+            return lookup::miss;
+        }
+
+        *ec = e.ec;
+        if (!e.ec)
+            *results = e.results;
+
+        if (e.ec || e.refreshing || now < e.expires - opts_.refresh_ahead)
+            return lookup::hit;
+        e.refreshing = true;
+        return lookup::hit_refresh;
+    }
+
+    /** Remember the results of a query. */
+    void
+    store(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        resolver_results results)
+    {
+        put(host, service, flags, std::move(results), {});
+    }
+
+    /** Remember that a query's host was not found. */
+    void
+    store_negative(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        system::error_code ec)
+    {
+        put(host, service, flags, {}, ec);
+    }
+
+    /** Allow another refresh of an entry whose refresh failed. */
+    void
+    end_refresh(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(resolver_query{host, service, flags});
+        if (it != map_.end())
+            it->second.refreshing = false;
+    }
+
+private:
+    struct key
+    {
+        std::string host;
+        std::string service;
+        resolve_flags flags;
+
+        operator resolver_query() const noexcept
+        {
+            return {host, service, flags};
+        }
+    };
+
+    struct entry
+    {
+        resolver_results results;
+        system::error_code ec;
+        clock::time_point expires;
+        bool refreshing = false;
+    };
+
+    void
+    put(
+        std::string_view host,
+        std::string_view service,
+        resolve_flags flags,
+        resolver_results results,
+        system::error_code ec)
+    {
+        if (!enabled())
+            return;
+
+        auto const now = clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        clock::duration ttl = ec ? opts_.negative_ttl : opts_.ttl;
+        if (opts_.max_entries == 0 || ttl <= clock::duration::zero())
+            return;
+
+        auto it = map_.find(resolver_query{host, service, flags});
+        if (it == map_.end())
+        {
+            if (map_.size() >= opts_.max_entries)
+                evict();
+            it = map_.emplace(
+                key{std::string(host), std::string(service), flags},
+                entry{}).first;
+        }
+        auto& e = it->second;
+        e.results = std::move(results);
+        e.ec = ec;
+        e.expires = now + ttl;
+        e.refreshing = false;
+    }
+
+    // Called with mutex_ held on a non-empty map
+    void
+    evict()
+    {
+        auto const now = clock::now();
+        auto victim = map_.begin();
+        for (auto it = map_.begin(); it != map_.end(); ++it)
+        {
+            if (it->second.expires <= now)
+            {
+                victim = it;
+                break;
+            }
+            if (it->second.expires < victim->second.expires)
+                victim = it;
+        }
+        map_.erase(victim);
+    }
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{false};
+    resolver_cache_options opts_;
+    std::unordered_map<key, entry,
+        resolver_query_hash, resolver_query_equal> map_;
+};
+
+//------------------------------------------------------------------------------
+
+/** Remembered answers of reverse resolves.
+
+    Entries are keyed by address and flags, not port, so that the
+    connections of one peer share an entry. Each holds the host name
+    and the port and service name it was looked up with. A hit for
+    another port answers only if the flags ask for a numeric service,
+    which is then the port itself. Only successful answers are kept.
+    Eviction is as for @ref resolver_cache.
+
+    @par Thread Safety
+    All member functions may be called concurrently.
+*/
+class reverse_resolver_cache
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /** Replace the options and forget every entry. */
+    void
+    configure(resolver_cache_options const& opts)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        opts_ = opts;
+        map_.clear();
+        enabled_.store(opts.max_reverse_entries > 0, std::memory_order_release);
+    }
+
+    /// Return `true` if the cache is enabled.
+    bool
+    enabled() const noexcept
+    {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    /** Look up a reverse query.
+
+        @return `true` on a hit, with `*result` set.
+    */
+    bool
+    find(
+        endpoint const& ep,
+        reverse_flags flags,
+        reverse_resolver_result* result)
+    {
+        if (!enabled())
+            return false;
+
+        auto const now = clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(key_of(ep, flags));
+        if (it == map_.end())
+            return false;
+
+        auto& e = it->second;
+        if (now >= e.expires)
+        {
+            map_.erase(it);
+            return false;
+        }
+
+        if (e.port == ep.port())
+            *result = reverse_resolver_result(ep, e.host, e.service);
+        else if ((flags & reverse_flags::numeric_service) != reverse_flags::none)
+            *result = reverse_resolver_result(
+                ep, e.host, std::to_string(ep.port()));
+        else
+            return false;
+        return true;
+    }
+
+    /** Remember the answer of a reverse query. */
+    void
+    store(
+        endpoint const& ep,
+        reverse_flags flags,
+        std::string_view host,
+        std::string_view service)
+    {
+        if (!enabled())
+            return;
+
+        auto const now = clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (opts_.max_reverse_entries == 0 ||
+            opts_.ttl <= std::chrono::seconds::zero())
+            return;
+
+        auto k = key_of(ep, flags);
+        auto it = map_.find(k);
+        if (it == map_.end())
+        {
+            if (map_.size() >= opts_.max_reverse_entries)
+                evict();
+            it = map_.emplace(k, entry{}).first;
+        }
+        auto& e = it->second;
+        e.host.assign(host);
+        e.service.assign(service);
+        e.port = ep.port();
+        e.expires = now + opts_.ttl;
+    }
+
+private:
+    struct key
+    {
+        std::array<unsigned char, 16> addr;
+        bool v4;
+        reverse_flags flags;
+
+        friend bool
+        operator==(key const&, key const&) = default;
+    };
+
+    struct key_hash
+    {
+        std::size_t
+        operator()(key const& k) const noexcept
+        {
+            std::string_view bytes(
+                reinterpret_cast<char const*>(k.addr.data()), k.addr.size());
+            std::size_t seed = std::hash<std::string_view>()(bytes);
+            seed ^= (static_cast<std::size_t>(k.flags) << 1 | k.v4) +
+                0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    struct entry
+    {
+        std::string host;
+        std::string service;
+        std::uint16_t port = 0;
+        clock::time_point expires;
+    };
+
+    static key
+    key_of(endpoint const& ep, reverse_flags flags) noexcept
+    {
+        key k{};
+        k.v4 = ep.is_v4();
+        k.flags = flags;
+        if (k.v4)
+        {
+            auto const b = ep.v4_address().to_bytes();
+            std::memcpy(k.addr.data(), b.data(), b.size());
+        }
+        else
+        {
+            auto const b = ep.v6_address().to_bytes();
+            std::memcpy(k.addr.data(), b.data(), b.size());
+        }
+        return k;
+    }
+
+    // Called with mutex_ held on a non-empty map
+    void
+    evict()
+    {
+        auto const now = clock::now();
+        auto victim = map_.begin();
+        for (auto it = map_.begin(); it != map_.end(); ++it)
+        {
+            if (it->second.expires <= now)
+            {
+                victim = it;
+                break;
+            }
+            if (it->second.expires < victim->second.expires)
+                victim = it;
+        }
+        map_.erase(victim);
+    }
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{false};
+    resolver_cache_options opts_;
+    std::unordered_map<key, entry, key_hash> map_;
+};
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -103,6 +103,25 @@ public:
         return data_;
     }
 
+    /** Return the address to report for this handler.
+
+        Used when handlers are timed. The default is the handler
+        itself; a handler that resumes a coroutine reports the
+        coroutine's frame instead.
+    */
+    virtual void const* target() const noexcept
+    {
+        return this;
+    }
+
+    /** Queue ahead of other handlers, see op_lanes.
+
+        Set on the operations of a socket marked for high priority
+        completions and on handlers posted through a high priority
+        executor. Backends without lanes ignore it.
+    */
+    bool high_priority = false;
+
 protected:
     ~scheduler_op() = default;
 
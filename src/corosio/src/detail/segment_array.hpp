@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_SEGMENT_ARRAY_HPP
+#define BOOST_COROSIO_DETAIL_SEGMENT_ARRAY_HPP
+
+#include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/io_buffer_param.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#if BOOST_COROSIO_POSIX
+#include <climits>
+#include <sys/uio.h>
+#endif
+
+namespace boost::corosio::detail {
+
+/** The buffer descriptors of one scatter/gather operation.
+
+    Holds the system descriptors (`iovec`, `WSABUF`) an operation
+    passes to the kernel. Up to `N` descriptors live inline in the
+    operation, so the common case of a few buffers allocates nothing.
+    A longer sequence moves to heap storage sized to it, which the
+    array keeps for later operations of the same socket.
+
+    A sequence with more than `max` non-empty buffers is cut at
+    `max`; the operation then transfers at most the bytes of the
+    first `max` buffers, as any `read_some` or `write_some` may.
+    An operation that transfers everything checks @ref truncated.
+
+    Such an operation also drops transferred descriptors from the
+    front with @ref pop_front, between system calls.
+
+    @tparam Seg The system buffer descriptor type.
+    @tparam N The number of descriptors stored inline.
+*/
+template<class Seg, std::size_t N = 16>
+class segment_array
+{
+    Seg inline_[N];
+    std::size_t first_ = 0;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = N;
+    bool truncated_ = false;
+    std::unique_ptr<Seg[]> heap_;
+    std::unique_ptr<capy::mutable_buffer[]> scratch_;
+
+    void grow(std::size_t cap)
+    {
+        heap_.reset(new Seg[cap]);
+        scratch_.reset(new capy::mutable_buffer[cap]);
+        capacity_ = cap;
+    }
+
+public:
+    static constexpr std::size_t inline_size = N;
+
+    segment_array() = default;
+    segment_array(segment_array const&) = delete;
+    segment_array& operator=(segment_array const&) = delete;
+
+    Seg* data() noexcept
+    {
+        return (heap_ ? heap_.get() : inline_) + first_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_ - first_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == first_;
+    }
+
+    /// Return `true` if the last fill stopped at its maximum.
+    bool truncated() const noexcept
+    {
+        return truncated_;
+    }
+
+    /// Drop the first descriptor.
+    void pop_front() noexcept
+    {
+        ++first_;
+    }
+
+    Seg& operator[](std::size_t i) noexcept
+    {
+        return data()[i];
+    }
+
+    void clear() noexcept
+    {
+        first_ = 0;
+        size_ = 0;
+        truncated_ = false;
+    }
+
+    /// Replace the contents with one descriptor.
+    void assign(Seg const& s) noexcept
+    {
+        clear();
+        data()[0] = s;
+        size_ = 1;
+    }
+
+    /** Replace the contents with the buffers of a sequence.
+
+        Zero-size buffers are skipped, as by
+        @ref io_buffer_param::copy_to.
+
+        @param p The buffer sequence.
+        @param max The largest number of descriptors to fill.
+        @param convert Makes a `Seg` from a `capy::mutable_buffer`.
+
+        @return The number of descriptors filled.
+
+        @throws std::bad_alloc if the sequence needs heap storage
+            and it cannot be allocated.
+    */
+    template<class Convert>
+    std::size_t assign(
+        io_buffer_param p,
+        std::size_t max,
+        Convert convert)
+    {
+        clear();
+        capy::mutable_buffer bufs[N];
+        std::size_t n = p.copy_to(bufs, N);
+        if (n < N || max <= N)
+        {
+            Seg* d = data();
+            for (std::size_t i = 0; i < n; ++i)
+                d[i] = convert(bufs[i]);
+            size_ = n;
+            truncated_ = n == max;
+            return n;
+        }
+
+        // Overflow: the sequence is not known to end here, so copy
+        // it again into storage doubled until it fits or hits max
+        std::size_t cap = capacity_ > N ? capacity_ : 4 * N;
+        for (;;)
+        {
+            if (cap > max)
+                cap = max;
+            if (cap > capacity_)
+                grow(cap);
+            n = p.copy_to(scratch_.get(), cap);
+            if (n < cap || cap == max)
+                break;
+            cap *= 2;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            heap_[i] = convert(scratch_[i]);
+        size_ = n;
+        truncated_ = n == max;
+        return n;
+    }
+};
+
+#if BOOST_COROSIO_POSIX
+
+/// The most buffers one `readv` or `sendmsg` call accepts.
+#ifdef IOV_MAX
+inline constexpr std::size_t max_iovecs = IOV_MAX;
+#else
+inline constexpr std::size_t max_iovecs = 1024;
+#endif
+
+using iovec_array = segment_array<iovec>;
+
+/// Writes smaller than this are copied even with zero-copy sends enabled.
+inline constexpr std::size_t zero_copy_min_bytes = 16384;
+
+/// Fill the descriptors of a POSIX read or write.
+inline std::size_t
+assign_iovecs(iovec_array& a, io_buffer_param p)
+{
+    return a.assign(p, max_iovecs,
+        [](capy::mutable_buffer b) noexcept
+        {
+            return iovec{b.data(), b.size()};
+        });
+}
+
+/// Return the number of bytes the descriptors hold.
+inline std::size_t
+iovecs_size(iovec_array& a) noexcept
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        n += a[i].iov_len;
+    return n;
+}
+
+/** Drop `n` transferred bytes from the front of the descriptors.
+
+    @return `true` if no bytes are left.
+*/
+inline bool
+consume_iovecs(iovec_array& a, std::size_t n) noexcept
+{
+    while (!a.empty() && n >= a[0].iov_len)
+    {
+        n -= a[0].iov_len;
+        a.pop_front();
+    }
+    if (!a.empty())
+    {
+        a[0].iov_base = static_cast<char*>(a[0].iov_base) + n;
+        a[0].iov_len -= n;
+    }
+    return a.empty();
+}
+
+#endif
+
+} // namespace boost::corosio::detail
+
+#endif
@@ -15,6 +15,10 @@
 #include "src/detail/select/sockets.hpp"
 #include "src/detail/endpoint_convert.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/posix/fast_open.hpp"
+#include "src/detail/posix/listener.hpp"
+#include "src/detail/posix/local.hpp"
+#include "src/detail/posix/reuseport.hpp"
 
 #include <errno.h>
 #include <fcntl.h>
@@ -24,6 +28,74 @@
 
 namespace boost::corosio::detail {
 
+namespace {
+
+// Accept one connection as a non-blocking, close-on-exec socket.
+// Returns the descriptor, or -1 with errno set.
+int
+accept_socket(int listen_fd) noexcept
+{
+    sockaddr_storage addr{};
+    socklen_t addrlen = sizeof(addr);
+
+    // Note: select backend uses accept() + fcntl instead of accept4()
+    // for broader POSIX compatibility
+    int new_fd = ::accept(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addrlen);
+    if (new_fd < 0)
+        return -1;
+
+    // Reject fds that exceed select()'s FD_SETSIZE limit.
+    // Better to fail now than during later async operations.
+    if (new_fd >= FD_SETSIZE)
+    {
+        ::close(new_fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Set non-blocking and close-on-exec flags.
+    // A non-blocking socket is essential for the async reactor;
+    // if we can't configure it, fail rather than risk blocking.
+    int flags = ::fcntl(new_fd, F_GETFL, 0);
+    if (flags == -1 ||
+        ::fcntl(new_fd, F_SETFL, flags | O_NONBLOCK) == -1 ||
+        ::fcntl(new_fd, F_SETFD, FD_CLOEXEC) == -1)
+    {
+        int err = errno;
+        ::close(new_fd);
+        errno = err;
+        return -1;
+    }
+
+    return new_fd;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// select_accept_op::perform_io
+//------------------------------------------------------------------------------
+
+void
+select_accept_op::
+perform_io() noexcept
+{
+    int new_fd = accept_socket(fd);
+    if (new_fd >= 0)
+    {
+        accepted_fd = new_fd;
+        complete(0, 0);
+
+        // One readiness event may stand for a deep backlog
+        if (acceptor_impl_)
+            acceptor_impl_->accept_surplus();
+    }
+    else
+    {
+        complete(errno, 0);
+    }
+}
+
 //------------------------------------------------------------------------------
 // select_accept_op::cancel
 //------------------------------------------------------------------------------
@@ -47,9 +119,20 @@ select_accept_op::
 operator()()
 {
     stop_cb.reset();
+    trace.finish(cancelled.load(std::memory_order_acquire));
+    BOOST_COROSIO_PROBE3(socket_accept, fd, accepted_fd, errn);
 
     bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
 
+    if (acceptor_impl_)
+    {
+        auto counts = acceptor_impl_->service().scheduler().socket_counts();
+        if (cancelled.load(std::memory_order_acquire))
+            counts.add(&socket_counters::cancellations);
+        else if (success)
+            counts.add(&socket_counters::accepts);
+    }
+
     if (ec_out)
     {
         if (cancelled.load(std::memory_order_acquire))
@@ -71,16 +154,16 @@ operator()()
                 auto& impl = static_cast<select_socket_impl&>(socket_svc->create_impl());
                 impl.set_socket(accepted_fd);
 
-                sockaddr_in local_addr{};
+                sockaddr_storage local_addr{};
                 socklen_t local_len = sizeof(local_addr);
-                sockaddr_in remote_addr{};
+                sockaddr_storage remote_addr{};
                 socklen_t remote_len = sizeof(remote_addr);
 
                 endpoint local_ep, remote_ep;
                 if (::getsockname(accepted_fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-                    local_ep = from_sockaddr_in(local_addr);
+                    local_ep = from_sockaddr(local_addr);
                 if (::getpeername(accepted_fd, reinterpret_cast<sockaddr*>(&remote_addr), &remote_len) == 0)
-                    remote_ep = from_sockaddr_in(remote_addr);
+                    remote_ep = from_sockaddr(remote_addr);
 
                 impl.set_endpoints(local_ep, remote_ep);
 
@@ -167,62 +250,25 @@ accept(
     op.impl_out = impl_out;
     op.fd = fd_;
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    sockaddr_in addr{};
-    socklen_t addrlen = sizeof(addr);
-    int accepted = ::accept(fd_, reinterpret_cast<sockaddr*>(&addr), &addrlen);
-
-    if (accepted >= 0)
+    // A connection drained by an earlier readiness event
+    if (!pending_.empty())
     {
-        // Reject fds that exceed select()'s FD_SETSIZE limit.
-        // Better to fail now than during later async operations.
-        if (accepted >= FD_SETSIZE)
-        {
-            ::close(accepted);
-            op.accepted_fd = -1;
-            op.complete(EINVAL, 0);
-            op.impl_ptr = shared_from_this();
-            svc_.post(&op);
-            return;
-        }
-
-        // Set non-blocking and close-on-exec flags.
-        // A non-blocking socket is essential for the async reactor;
-        // if we can't configure it, fail rather than risk blocking.
-        int flags = ::fcntl(accepted, F_GETFL, 0);
-        if (flags == -1)
-        {
-            int err = errno;
-            ::close(accepted);
-            op.accepted_fd = -1;
-            op.complete(err, 0);
-            op.impl_ptr = shared_from_this();
-            svc_.post(&op);
-            return;
-        }
-
-        if (::fcntl(accepted, F_SETFL, flags | O_NONBLOCK) == -1)
-        {
-            int err = errno;
-            ::close(accepted);
-            op.accepted_fd = -1;
-            op.complete(err, 0);
-            op.impl_ptr = shared_from_this();
-            svc_.post(&op);
-            return;
-        }
-
-        if (::fcntl(accepted, F_SETFD, FD_CLOEXEC) == -1)
+        int fd = take_pending();
+        if (fd >= 0)
         {
-            int err = errno;
-            ::close(accepted);
-            op.accepted_fd = -1;
-            op.complete(err, 0);
+            op.accepted_fd = fd;
+            op.complete(0, 0);
             op.impl_ptr = shared_from_this();
             svc_.post(&op);
             return;
         }
+    }
 
+    int accepted = accept_socket(fd_);
+    if (accepted >= 0)
+    {
         op.accepted_fd = accepted;
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
@@ -271,6 +317,35 @@ accept(
     svc_.post(&op);
 }
 
+void
+select_acceptor_impl::
+accept_surplus() noexcept
+{
+    std::lock_guard lock(pending_mutex_);
+    while (pending_count_ < pending_.size())
+    {
+        // EAGAIN ends the drain; other errors surface on the next accept
+        int fd = accept_socket(fd_);
+        if (fd < 0)
+            return;
+        pending_[(pending_head_ + pending_count_) % pending_.size()] = fd;
+        ++pending_count_;
+    }
+}
+
+int
+select_acceptor_impl::
+take_pending() noexcept
+{
+    std::lock_guard lock(pending_mutex_);
+    if (pending_count_ == 0)
+        return -1;
+    int fd = pending_[pending_head_];
+    pending_head_ = (pending_head_ + 1) % pending_.size();
+    --pending_count_;
+    return fd;
+}
+
 void
 select_acceptor_impl::
 cancel() noexcept
@@ -326,6 +401,16 @@ close_socket() noexcept
 {
     cancel();
 
+    {
+        std::lock_guard lock(pending_mutex_);
+        for (; pending_count_ > 0; --pending_count_)
+        {
+            ::close(pending_[pending_head_]);
+            pending_head_ = (pending_head_ + 1) % pending_.size();
+        }
+        pending_head_ = 0;
+    }
+
     if (fd_ >= 0)
     {
         // Unconditionally remove from registered_fds_ to handle edge cases
@@ -343,9 +428,12 @@ close_socket() noexcept
 //------------------------------------------------------------------------------
 
 select_acceptor_service::
-select_acceptor_service(capy::execution_context& ctx)
+select_acceptor_service(
+    capy::execution_context& ctx,
+    unsigned accept_backlog)
     : ctx_(ctx)
     , state_(std::make_unique<select_acceptor_state>(ctx.use_service<select_scheduler>()))
+    , accept_backlog_(accept_backlog)
 {
 }
 
@@ -370,7 +458,7 @@ acceptor::acceptor_impl&
 select_acceptor_service::
 create_acceptor_impl()
 {
-    auto impl = std::make_shared<select_acceptor_impl>(*this);
+    auto impl = make_recycled_impl<select_acceptor_impl>(*this);
     auto* raw = impl.get();
 
     std::lock_guard lock(state_->mutex_);
@@ -395,12 +483,13 @@ select_acceptor_service::
 open_acceptor(
     acceptor::acceptor_impl& impl,
     endpoint ep,
-    int backlog)
+    acceptor::listen_options const& opts)
 {
     auto* select_impl = static_cast<select_acceptor_impl*>(&impl);
     select_impl->close_socket();
+    select_impl->pending_.assign(accept_backlog_, -1);
 
-    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int fd = ::socket(detail::to_af(ep.family()), SOCK_STREAM, 0);
     if (fd < 0)
         return make_err(errno);
 
@@ -435,29 +524,138 @@ open_acceptor(
     int reuse = 1;
     ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
 
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
-    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    if (opts.reuse_port &&
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    // Set explicitly; the default differs between platforms
+    if (ep.is_v6())
+    {
+        int v6_only = opts.dual_stack ? 0 : 1;
+        if (::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY,
+                &v6_only, sizeof(v6_only)) < 0)
+        {
+            int errn = errno;
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0)
     {
         int errn = errno;
         ::close(fd);
         return make_err(errn);
     }
 
-    if (::listen(fd, backlog) < 0)
+    if (opts.fast_open_queue > 0)
+    {
+        int errn = detail::set_fast_open_queue(fd, opts.fast_open_queue);
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
+    if (::listen(fd, opts.backlog) < 0)
     {
         int errn = errno;
         ::close(fd);
         return make_err(errn);
     }
 
+    if (opts.cpu_steering)
+    {
+        int errn = opts.reuse_port
+            ? detail::attach_cpu_steering(fd)
+            : EINVAL;
+        if (errn)
+        {
+            ::close(fd);
+            return make_err(errn);
+        }
+    }
+
     select_impl->fd_ = fd;
 
     // Cache the local endpoint (queries OS for ephemeral port if port was 0)
-    sockaddr_in local_addr{};
+    sockaddr_storage local_addr{};
     socklen_t local_len = sizeof(local_addr);
     if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-        select_impl->set_local_endpoint(detail::from_sockaddr_in(local_addr));
+        select_impl->set_local_endpoint(detail::from_sockaddr(local_addr));
+
+    return {};
+}
 
+system::error_code
+select_acceptor_service::
+assign_acceptor(
+    acceptor::acceptor_impl& impl,
+    native_handle_type fd)
+{
+    auto* select_impl = static_cast<select_acceptor_impl*>(&impl);
+    select_impl->close_socket();
+    select_impl->pending_.assign(accept_backlog_, -1);
+
+    if (fd >= FD_SETSIZE)
+        return make_err(EMFILE);
+
+    endpoint local;
+    if (int errn = detail::prepare_inherited_listener(fd, local))
+        return make_err(errn);
+
+    select_impl->fd_ = fd;
+    select_impl->set_local_endpoint(local);
+    return {};
+}
+
+system::error_code
+select_acceptor_service::
+open_local_acceptor(
+    acceptor::acceptor_impl& impl,
+    std::string_view path,
+    int backlog)
+{
+    auto* select_impl = static_cast<select_acceptor_impl*>(&impl);
+    select_impl->close_socket();
+    select_impl->pending_.assign(accept_backlog_, -1);
+
+    sockaddr_un addr;
+    socklen_t addrlen;
+    if (int errn = detail::to_sockaddr_un(path, addr, addrlen))
+        return make_err(errn);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    // Before bind, which creates the socket file
+    if (fd >= FD_SETSIZE)
+    {
+        ::close(fd);
+        return make_err(EMFILE);
+    }
+
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags == -1 ||
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1 ||
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), addrlen) < 0 ||
+        ::listen(fd, backlog) < 0)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    select_impl->fd_ = fd;
     return {};
 }
 
@@ -19,6 +19,7 @@
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
 #include "src/detail/socket_service.hpp"
 
 #include "src/detail/select/op.hpp"
@@ -26,7 +27,7 @@
 
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <vector>
 
 namespace boost::corosio::detail {
 
@@ -55,7 +56,7 @@ public:
         system::error_code*,
         io_object::io_object_impl**) override;
 
-    int native_handle() const noexcept { return fd_; }
+    int native_handle() const noexcept override { return fd_; }
     endpoint local_endpoint() const noexcept override { return local_endpoint_; }
     bool is_open() const noexcept { return fd_ >= 0; }
     void cancel() noexcept override;
@@ -63,14 +64,31 @@ public:
     void close_socket() noexcept;
     void set_local_endpoint(endpoint ep) noexcept { local_endpoint_ = ep; }
 
+    /** Accept the connections queued behind one just accepted.
+
+        Called by the reactor. Fills the pending ring, sized by
+        select_options::accept_backlog, until accept would block or
+        the ring is full.
+    */
+    void accept_surplus() noexcept;
+
     select_acceptor_service& service() noexcept { return svc_; }
 
     select_accept_op acc_;
 
 private:
+    int take_pending() noexcept;
+
     select_acceptor_service& svc_;
     int fd_ = -1;
     endpoint local_endpoint_;
+
+    // Connections accepted ahead of accept(). Empty unless
+    // accept_backlog is nonzero.
+    std::mutex pending_mutex_;
+    std::vector<int> pending_;
+    std::size_t pending_head_ = 0;
+    std::size_t pending_count_ = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -87,7 +105,7 @@ public:
     select_scheduler& sched_;
     std::mutex mutex_;
     intrusive_list<select_acceptor_impl> acceptor_list_;
-    std::unordered_map<select_acceptor_impl*, std::shared_ptr<select_acceptor_impl>> acceptor_ptrs_;
+    impl_ptr_map<select_acceptor_impl> acceptor_ptrs_;
 };
 
 /** select acceptor service implementation.
@@ -98,7 +116,9 @@ public:
 class select_acceptor_service : public acceptor_service
 {
 public:
-    explicit select_acceptor_service(capy::execution_context& ctx);
+    explicit select_acceptor_service(
+        capy::execution_context& ctx,
+        unsigned accept_backlog = 0);
     ~select_acceptor_service();
 
     select_acceptor_service(select_acceptor_service const&) = delete;
@@ -111,6 +131,13 @@ public:
     system::error_code open_acceptor(
         acceptor::acceptor_impl& impl,
         endpoint ep,
+        acceptor::listen_options const& opts) override;
+    system::error_code assign_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd) override;
+    system::error_code open_local_acceptor(
+        acceptor::acceptor_impl& impl,
+        std::string_view path,
         int backlog) override;
 
     select_scheduler& scheduler() const noexcept { return state_->sched_; }
@@ -124,6 +151,7 @@ public:
 private:
     capy::execution_context& ctx_;
     std::unique_ptr<select_acceptor_state> state_;
+    unsigned accept_backlog_;
 };
 
 } // namespace boost::corosio::detail
@@ -23,8 +23,12 @@
 #include <boost/system/error_code.hpp>
 
 #include "src/detail/make_err.hpp"
+#include "src/detail/op_trace.hpp"
+#include "src/detail/probes.hpp"
 #include "src/detail/scheduler_op.hpp"
+#include "src/detail/segment_array.hpp"
 #include "src/detail/endpoint_convert.hpp"
+#include "src/detail/posix/local.hpp"
 
 #include <unistd.h>
 #include <errno.h>
@@ -37,6 +41,7 @@
 #include <stop_token>
 
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
@@ -75,6 +80,20 @@
     member holds a shared_ptr to the impl, keeping it alive until the op
     completes.
 
+    Readiness Waits
+    ---------------
+    wait() registers the read or write op with wait_events set and no
+    buffers. Its perform_io() polls the socket without transferring
+    anything, and a wait completes with no bytes and no EOF. A socket
+    error reported by select() ends a wait successfully.
+
+    Counters
+    --------
+    Stream socket ops count into the socket counters of the thread
+    that finishes them (see "Socket Counters" in thread_stats.hpp).
+    Registering an op marks it `waited` and counts a would-block;
+    operator() adds the bytes and whether the op was parked.
+
     EOF Detection
     -------------
     For reads, 0 bytes with no error means EOF. But an empty user buffer also
@@ -122,10 +141,13 @@ struct select_op : scheduler_op
     int fd = -1;
     int errn = 0;
     std::size_t bytes_transferred = 0;
+    short wait_events = 0;      // wait(), see "Readiness Waits"
+    bool waited = false;        // registered at least once, see "Counters"
 
     std::atomic<bool> cancelled{false};
     std::atomic<select_registration_state> registered{select_registration_state::unregistered};
     std::optional<std::stop_callback<canceller>> stop_cb;
+    op_trace_state trace;
 
     // Prevents use-after-free when socket is closed with pending ops.
     std::shared_ptr<void> impl_ptr;
@@ -144,6 +166,8 @@ struct select_op : scheduler_op
         fd = -1;
         errn = 0;
         bytes_transferred = 0;
+        wait_events = 0;
+        waited = false;
         cancelled.store(false, std::memory_order_relaxed);
         registered.store(select_registration_state::unregistered, std::memory_order_relaxed);
         impl_ptr.reset();
@@ -154,6 +178,7 @@ struct select_op : scheduler_op
     void operator()() override
     {
         stop_cb.reset();
+        trace.finish(cancelled.load(std::memory_order_acquire));
 
         if (ec_out)
         {
@@ -170,6 +195,19 @@ struct select_op : scheduler_op
         if (bytes_out)
             *bytes_out = bytes_transferred;
 
+        if (socket_impl_)
+            count();
+
+#if BOOST_COROSIO_HAS_PROBES
+        if (wait_events == 0)
+        {
+            if (is_read_operation())
+                BOOST_COROSIO_PROBE3(socket_read, fd, bytes_transferred, errn);
+            else
+                BOOST_COROSIO_PROBE3(socket_write, fd, bytes_transferred, errn);
+        }
+#endif
+
         // Move to stack before destroying the frame
         capy::executor_ref saved_ex( std::move( ex ) );
         capy::coro saved_h( std::move( h ) );
@@ -180,9 +218,14 @@ struct select_op : scheduler_op
     virtual bool is_read_operation() const noexcept { return false; }
     virtual void cancel() noexcept = 0;
 
+    // Add a completed stream socket op to the counters, see "Counters".
+    // Defined in sockets.cpp where select_socket_impl is complete
+    void count() const noexcept;
+
     void destroy() override
     {
         stop_cb.reset();
+        trace.discard();
         impl_ptr.reset();
     }
 
@@ -231,6 +274,21 @@ struct select_op : scheduler_op
     }
 
     virtual void perform_io() noexcept {}
+
+    // Checks the readiness a wait() asked for, without blocking
+    void perform_wait() noexcept
+    {
+        pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = wait_events;
+        int r = ::poll(&pfd, 1, 0);
+        if (r < 0)
+            complete(errno, 0);
+        else if (r == 0)
+            complete(EAGAIN, 0);
+        else
+            complete(0, 0);
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -264,26 +322,33 @@ struct select_connect_op : select_op
 
 struct select_read_op : select_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    iovec iovecs[max_buffers];
-    int iovec_count = 0;
+    iovec_array iovecs;
     bool empty_buffer_read = false;
+    int* fd_out = nullptr;      // read_with_descriptor, see posix/local.hpp
 
     bool is_read_operation() const noexcept override
     {
-        return !empty_buffer_read;
+        return !empty_buffer_read && wait_events == 0;
     }
 
     void reset() noexcept
     {
         select_op::reset();
-        iovec_count = 0;
+        iovecs.clear();
         empty_buffer_read = false;
+        fd_out = nullptr;
     }
 
     void perform_io() noexcept override
     {
-        ssize_t n = ::readv(fd, iovecs, iovec_count);
+        if (wait_events)
+        {
+            perform_wait();
+            return;
+        }
+        ssize_t n = fd_out
+            ? recv_with_fd(fd, iovecs.data(), iovecs.size(), fd_out)
+            : ::readv(fd, iovecs.data(), static_cast<int>(iovecs.size()));
         if (n >= 0)
             complete(0, static_cast<std::size_t>(n));
         else
@@ -297,21 +362,36 @@ struct select_read_op : select_op
 
 struct select_write_op : select_op
 {
-    static constexpr std::size_t max_buffers = 16;
-    iovec iovecs[max_buffers];
-    int iovec_count = 0;
+    iovec_array iovecs;
+    int pass_fd = -1;           // write_with_descriptor
 
     void reset() noexcept
     {
         select_op::reset();
-        iovec_count = 0;
+        iovecs.clear();
+        pass_fd = -1;
     }
 
     void perform_io() noexcept override
     {
+        if (wait_events)
+        {
+            perform_wait();
+            return;
+        }
+        if (pass_fd >= 0)
+        {
+            ssize_t n = send_with_fd(fd, iovecs.data(), iovecs.size(), pass_fd);
+            if (n >= 0)
+                complete(0, static_cast<std::size_t>(n));
+            else
+                complete(errno, 0);
+            return;
+        }
+
         msghdr msg{};
-        msg.msg_iov = iovecs;
-        msg.msg_iovlen = static_cast<std::size_t>(iovec_count);
+        msg.msg_iov = iovecs.data();
+        msg.msg_iovlen = iovecs.size();
 
         ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
         if (n >= 0)
@@ -339,64 +419,8 @@ struct select_accept_op : select_op
         impl_out = nullptr;
     }
 
-    void perform_io() noexcept override
-    {
-        sockaddr_in addr{};
-        socklen_t addrlen = sizeof(addr);
-
-        // Note: select backend uses accept() + fcntl instead of accept4()
-        // for broader POSIX compatibility
-        int new_fd = ::accept(fd, reinterpret_cast<sockaddr*>(&addr), &addrlen);
-
-        if (new_fd >= 0)
-        {
-            // Reject fds that exceed select()'s FD_SETSIZE limit.
-            // Better to fail now than during later async operations.
-            if (new_fd >= FD_SETSIZE)
-            {
-                ::close(new_fd);
-                complete(EINVAL, 0);
-                return;
-            }
-
-            // Set non-blocking and close-on-exec flags.
-            // A non-blocking socket is essential for the async reactor;
-            // if we can't configure it, fail rather than risk blocking.
-            int flags = ::fcntl(new_fd, F_GETFL, 0);
-            if (flags == -1)
-            {
-                int err = errno;
-                ::close(new_fd);
-                complete(err, 0);
-                return;
-            }
-
-            if (::fcntl(new_fd, F_SETFL, flags | O_NONBLOCK) == -1)
-            {
-                int err = errno;
-                ::close(new_fd);
-                complete(err, 0);
-                return;
-            }
-
-            if (::fcntl(new_fd, F_SETFD, FD_CLOEXEC) == -1)
-            {
-                int err = errno;
-                ::close(new_fd);
-                complete(err, 0);
-                return;
-            }
-
-            accepted_fd = new_fd;
-            complete(0, 0);
-        }
-        else
-        {
-            complete(errno, 0);
-        }
-    }
-
     // Defined in acceptors.cpp where select_acceptor_impl is complete
+    void perform_io() noexcept override;
     void operator()() override;
     void cancel() noexcept override;
 };
@@ -14,8 +14,11 @@
 #include "src/detail/select/scheduler.hpp"
 #include "src/detail/select/op.hpp"
 #include "src/detail/make_err.hpp"
+#include "src/detail/recycling_op.hpp"
+#include "src/detail/posix/file_service.hpp"
 #include "src/detail/posix/resolver_service.hpp"
 #include "src/detail/posix/signals.hpp"
+#include "src/detail/thread_stats.hpp"
 
 #include <boost/corosio/detail/except.hpp>
 #include <boost/corosio/detail/thread_local_ptr.hpp>
@@ -23,6 +26,7 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <span>
 
 #include <errno.h>
 #include <fcntl.h>
@@ -47,7 +51,7 @@
     Key Differences from epoll
     --------------------------
     - Uses self-pipe instead of eventfd for interruption (more portable)
-    - fd_set rebuilding each iteration (O(n) vs O(1) for epoll)
+    - fd_set copying and scanning each iteration (O(n) vs O(1) for epoll)
     - FD_SETSIZE limit (~1024 fds on most systems)
     - Level-triggered only (no edge-triggered mode)
 
@@ -58,11 +62,52 @@
     always in the read_fds set, so select() returns immediately. We drain the
     pipe to clear the readable state.
 
+    Injection Queue
+    ---------------
+    As in the epoll scheduler, post() pushes onto a lock-free MPSC queue
+    that is drained under mutex_, and only wakes a consumer that has
+    announced it is parked (idle on the condvar, or about to block in
+    select()).
+
+    Batched Posts
+    -------------
+    As in the epoll scheduler, post_batch() publishes a batch with one
+    exchange on the injection queue and wakes up to as many parked
+    threads as it has handlers.
+
+    Work Counting
+    -------------
+    As in the epoll scheduler, posts made by a handler running inside
+    run() are counted and staged in the thread's frame, then published
+    by handler_scope with a single adjustment of outstanding_work_ that
+    also retires the handler's own unit.
+
+    Priority Lanes
+    --------------
+    completed_ops_ is an op_lanes, so the reactor's completions for
+    sockets marked high priority are popped first, a bounded number
+    in a row. Flagged handlers posted from anywhere take the locked
+    path straight to it rather than the injection queue or a
+    handler's staged posts.
+
     fd-to-op Mapping
     ----------------
-    We use an unordered_map<int, fd_state> to track which operations are
-    registered for each fd. This allows O(1) lookup when select() returns
-    ready fds. Each fd can have at most one read op and one write op registered.
+    Registered operations live in fd_states_, a flat table of FD_SETSIZE
+    entries indexed by fd, allocated once at construction. Each fd can
+    have at most one read op and one write op registered. register_fd()
+    and deregister_fd() also set and clear the matching bits of the
+    master fd_sets read_fds_ and write_fds_, so the reactor never rebuilds
+    them: it copies the masters, and after select() walks the result sets
+    up to max_fd_, indexing the table directly. No iteration hashes or
+    allocates.
+
+    Statistics
+    ----------
+    As in the epoll scheduler, handler, park and blocked-time counts
+    live in each run() frame's thread_stats and the reactor counters are
+    members written by whichever thread holds the reactor role. An event
+    is a bit set in the result sets, so a socket both readable and
+    writable counts twice.
 */
 
 namespace boost::corosio::detail {
@@ -73,28 +118,119 @@ struct scheduler_context
 {
     select_scheduler const* key;
     scheduler_context* next;
+    thread_stats* stats;
+
+    // Posts made by the running handler, see handler_scope
+    op_queue private_ops;
+    long private_work = 0;
+    bool in_handler = false;
 };
 
 corosio::detail::thread_local_ptr<scheduler_context> context_stack;
 
-struct thread_context_guard
+// Returns the innermost run() frame of `sched` on this thread
+scheduler_context*
+find_context(select_scheduler const* sched) noexcept
+{
+    for (auto* c = context_stack.get(); c != nullptr; c = c->next)
+        if (c->key == sched)
+            return c;
+    return nullptr;
+}
+
+} // namespace
+
+/** Brackets one handler invocation inside run().
+
+    Posts made while the scope is active are counted and staged in the
+    frame. The destructor settles the count, including the handler's
+    own unit of work, and publishes the staged handlers.
+*/
+class select_scheduler::handler_scope
 {
+    select_scheduler const* sched_;
+    scheduler_context* frame_;
+
+public:
+    handler_scope(
+        select_scheduler const* sched,
+        scheduler_context* frame) noexcept
+        : sched_(sched)
+        , frame_(frame)
+    {
+        frame_->in_handler = true;
+    }
+
+    ~handler_scope()
+    {
+        frame_->in_handler = false;
+        publish(sched_, *frame_, -1);
+    }
+
+    handler_scope(handler_scope const&) = delete;
+    handler_scope& operator=(handler_scope const&) = delete;
+
+    // Folds the frame's private work, plus `adjust`, into
+    // outstanding_work_ and then releases the staged handlers
+    static void
+    publish(
+        select_scheduler const* sched,
+        scheduler_context& frame,
+        long adjust) noexcept
+    {
+        long n = frame.private_work + adjust;
+        frame.private_work = 0;
+
+        if (n > 0)
+            sched->outstanding_work_.fetch_add(n, std::memory_order_relaxed);
+
+        while (auto* h = frame.private_ops.pop())
+            sched->enqueue(h);
+
+        // Only the finished handler's own unit can make this negative
+        if (n < 0)
+            sched->work_finished();
+    }
+};
+
+/** Marks the calling thread as running inside the scheduler. */
+class select_scheduler::run_scope
+{
+    select_scheduler const* sched_;
+    thread_stats stats_;
     scheduler_context frame_;
 
-    explicit thread_context_guard(
-        select_scheduler const* ctx) noexcept
-        : frame_{ctx, context_stack.get()}
+public:
+    explicit run_scope(select_scheduler const* sched)
+        : sched_(sched)
+        , frame_{sched, context_stack.get(), &stats_}
     {
+        // A handler running a nested loop must not hide its posts,
+        // and keeps counting into the outer frame
+        if (auto* outer = find_context(sched))
+        {
+            if (outer->in_handler)
+                handler_scope::publish(sched, *outer, 0);
+            frame_.stats = outer->stats;
+        }
+        else
+        {
+            sched_->stats_registry_.attach(stats_);
+        }
+
         context_stack.set(&frame_);
     }
 
-    ~thread_context_guard() noexcept
+    ~run_scope() noexcept
     {
         context_stack.set(frame_.next);
+        if (frame_.stats == &stats_)
+            sched_->stats_registry_.detach(stats_);
     }
-};
 
-} // namespace
+    run_scope(run_scope const&) = delete;
+    run_scope& operator=(run_scope const&) = delete;
+};
 
 select_scheduler::
 select_scheduler(
@@ -104,11 +240,15 @@ select_scheduler(
     , outstanding_work_(0)
     , stopped_(false)
     , shutdown_(false)
+    , fd_states_(FD_SETSIZE)
     , max_fd_(-1)
     , reactor_running_(false)
     , reactor_interrupted_(false)
     , idle_thread_count_(0)
 {
+    FD_ZERO(&read_fds_);
+    FD_ZERO(&write_fds_);
+
     // Create self-pipe for interrupting select()
     if (::pipe(pipe_fds_) < 0)
         detail::throw_system_error(make_err(errno), "pipe");
@@ -149,6 +289,9 @@ select_scheduler(
     // Initialize resolver service
     get_resolver_service(ctx, *this);
 
+    // Regular files cannot be waited for; workers run their I/O
+    get_file_service(ctx, *this);
+
     // Initialize signal service
     get_signal_service(ctx, *this);
 }
@@ -169,6 +312,7 @@ shutdown()
     {
         std::unique_lock lock(mutex_);
         shutdown_ = true;
+        completed_ops_.take_all(injected_);
 
         while (auto* h = completed_ops_.pop())
         {
@@ -186,53 +330,165 @@ shutdown()
     wakeup_event_.notify_all();
 }
 
-void
-select_scheduler::
-post(capy::coro h) const
+namespace {
+
+// Resumes a posted coroutine
+struct post_handler final
+    : scheduler_op
+    , recycling_op<post_handler>
 {
-    struct post_handler final
-        : scheduler_op
+    capy::coro h_;
+
+    explicit
+    post_handler(capy::coro h)
+        : h_(h)
     {
-        capy::coro h_;
+    }
 
-        explicit
-        post_handler(capy::coro h)
-            : h_(h)
-        {
-        }
+    ~post_handler() = default;
 
-        ~post_handler() = default;
+    void operator()() override
+    {
+        auto h = h_;
+        delete this;
+        h.resume();
+    }
 
-        void operator()() override
-        {
-            auto h = h_;
-            delete this;
-            h.resume();
-        }
+    void destroy() override
+    {
+        delete this;
+    }
 
-        void destroy() override
-        {
-            delete this;
-        }
-    };
+    void const* target() const noexcept override
+    {
+        return h_.address();
+    }
+};
+
+// Makes a post_handler per coroutine; none leak if one throws
+void
+make_post_handlers(std::span<capy::coro const> hs, op_queue& ops)
+{
+    try
+    {
+        for (auto h : hs)
+            ops.push(new post_handler(h));
+    }
+    catch (...)
+    {
+        while (auto* op = ops.pop())
+            op->destroy();
+        throw;
+    }
+}
 
+} // namespace
+
+void
+select_scheduler::
+post(capy::coro h) const
+{
     auto ph = std::make_unique<post_handler>(h);
-    outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    post(ph.release());
+}
 
-    std::unique_lock lock(mutex_);
-    completed_ops_.push(ph.release());
-    wake_one_thread_and_unlock(lock);
+void
+select_scheduler::
+post_high_priority(capy::coro h) const
+{
+    auto ph = std::make_unique<post_handler>(h);
+    ph->high_priority = true;
+    post(ph.release());
+}
+
+void
+select_scheduler::
+post_batch(std::span<capy::coro const> hs) const
+{
+    op_queue ops;
+    make_post_handlers(hs, ops);
+    auto const n = ops.size();
+    if (n == 0)
+        return;
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        c->private_work += static_cast<long>(n);
+        c->private_ops.splice(ops);
+        return;
+    }
+
+    outstanding_work_.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+    injected_.push_all(ops);
+    wake_for_batch(n);
+}
+
+void
+select_scheduler::
+wake_for_batch(std::size_t n) const
+{
+    // See "Batched Posts": one wakeup per handler, up to the number
+    // of parked threads, and the reactor if that is not enough
+    auto const idle = static_cast<std::size_t>(
+        idle_thread_count_.load(std::memory_order_seq_cst));
+    if (idle > 0)
+    {
+        std::lock_guard lock(mutex_);
+        if (n >= idle)
+            wakeup_event_.notify_all();
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                wakeup_event_.notify_one();
+    }
+    if (n > idle && reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+        interrupt_reactor();
 }
 
 void
 select_scheduler::
 post(scheduler_op* h) const
 {
+    // See "Priority Lanes"
+    if (h->high_priority)
+    {
+        outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock lock(mutex_);
+        completed_ops_.push(h);
+        raise_peak(queue_peak_, completed_ops_.size());
+        wake_one_thread_and_unlock(lock);
+        return;
+    }
+
+    // From inside a handler: counted privately, see handler_scope
+    if (auto* c = find_context(this); c && c->in_handler)
+    {
+        ++c->private_work;
+        c->private_ops.push(h);
+        return;
+    }
+
     outstanding_work_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(h);
+}
 
-    std::unique_lock lock(mutex_);
-    completed_ops_.push(h);
-    wake_one_thread_and_unlock(lock);
+void
+select_scheduler::
+enqueue(scheduler_op* h) const
+{
+    injected_.push(h);
+
+    // Only pay for a wakeup when a consumer is actually parked, see
+    // the matching announcements in do_one() and run_reactor()
+    if (idle_thread_count_.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard lock(mutex_);
+        wakeup_event_.notify_one();
+    }
+    else if (reactor_sleeping_.exchange(false, std::memory_order_seq_cst))
+    {
+        interrupt_reactor();
+    }
 }
 
 void
@@ -304,7 +560,7 @@ run()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
 
     std::size_t n = 0;
     while (do_one(-1))
@@ -326,7 +582,7 @@ run_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(-1);
 }
 
@@ -343,7 +599,7 @@ wait_one(long usec)
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(usec);
 }
 
@@ -360,7 +616,7 @@ poll()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
 
     std::size_t n = 0;
     while (do_one(0))
@@ -382,7 +638,7 @@ poll_one()
         return 0;
     }
 
-    thread_context_guard ctx(this);
+    run_scope scope(this);
     return do_one(0);
 }
 
@@ -397,11 +653,17 @@ register_fd(int fd, select_op* op, int events) const
     {
         std::lock_guard lock(mutex_);
 
-        auto& state = registered_fds_[fd];
+        auto& state = fd_states_[fd];
         if (events & event_read)
+        {
             state.read_op = op;
+            FD_SET(fd, &read_fds_);
+        }
         if (events & event_write)
+        {
             state.write_op = op;
+            FD_SET(fd, &write_fds_);
+        }
 
         if (fd > max_fd_)
             max_fd_ = fd;
@@ -416,35 +678,77 @@ void
 select_scheduler::
 deregister_fd(int fd, int events) const
 {
-    std::lock_guard lock(mutex_);
-
-    auto it = registered_fds_.find(fd);
-    if (it == registered_fds_.end())
+    if (fd < 0 || fd >= FD_SETSIZE)
         return;
 
+    std::lock_guard lock(mutex_);
+
+    auto& state = fd_states_[fd];
     if (events & event_read)
-        it->second.read_op = nullptr;
+    {
+        state.read_op = nullptr;
+        FD_CLR(fd, &read_fds_);
+    }
     if (events & event_write)
-        it->second.write_op = nullptr;
-
-    // Remove entry if both are null
-    if (!it->second.read_op && !it->second.write_op)
     {
-        registered_fds_.erase(it);
+        state.write_op = nullptr;
+        FD_CLR(fd, &write_fds_);
+    }
 
-        // Recalculate max_fd_ if needed
-        if (fd == max_fd_)
-        {
-            max_fd_ = pipe_fds_[0];  // At minimum, the pipe read end
-            for (auto& [registered_fd, state] : registered_fds_)
-            {
-                if (registered_fd > max_fd_)
-                    max_fd_ = registered_fd;
-            }
-        }
+    // Lower max_fd_ past slots that are now empty
+    if (fd == max_fd_)
+    {
+        while (max_fd_ >= 0 &&
+               !fd_states_[max_fd_].read_op &&
+               !fd_states_[max_fd_].write_op)
+            --max_fd_;
     }
 }
 
+void
+select_scheduler::
+collect_stats(scheduler_stats& st) const noexcept
+{
+    stats_registry_.collect(st);
+    st.queue_depth_peak = (std::max)(st.queue_depth_peak,
+        queue_peak_.load(std::memory_order_relaxed));
+    st.blocking_waits += blocking_waits_.load(std::memory_order_relaxed);
+    st.wakeup_writes += wakeup_writes_.load(std::memory_order_relaxed);
+    st.reactor_polls += reactor_polls_.load(std::memory_order_relaxed);
+    st.events_harvested += events_harvested_.load(std::memory_order_relaxed);
+}
+
+socket_counter_ref
+select_scheduler::
+socket_counts() const noexcept
+{
+    auto* c = find_context(this);
+    return stats_registry_.sockets(c ? c->stats : nullptr);
+}
+
+bool
+select_scheduler::
+time_handlers(std::chrono::nanoseconds threshold) noexcept
+{
+    stats_registry_.set_threshold(threshold);
+    return true;
+}
+
+void
+select_scheduler::
+sample_handlers(std::vector<handler_sample>& out) const
+{
+    stats_registry_.sample(out);
+}
+
+bool
+select_scheduler::
+trace_ops(op_tracer* t) noexcept
+{
+    tracer_.store(t, std::memory_order_relaxed);
+    return true;
+}
+
 void
 select_scheduler::
 work_started() const noexcept
@@ -474,6 +778,7 @@ void
 select_scheduler::
 interrupt_reactor() const
 {
+    wakeup_writes_.fetch_add(1, std::memory_order_relaxed);
     char byte = 1;
     [[maybe_unused]] auto r = ::write(pipe_fds_[1], &byte, 1);
 }
@@ -502,12 +807,6 @@ wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const
     }
 }
 
-struct work_guard
-{
-    select_scheduler const* self;
-    ~work_guard() { self->work_finished(); }
-};
-
 long
 select_scheduler::
 calculate_timeout(long requested_timeout_us) const
@@ -515,7 +814,7 @@ calculate_timeout(long requested_timeout_us) const
     if (requested_timeout_us == 0)
         return 0;
 
-    auto nearest = timer_svc_->nearest_expiry();
+    auto nearest = timer_svc_->nearest_wakeup();
     if (nearest == timer_service::time_point::max())
         return requested_timeout_us;
 
@@ -536,35 +835,20 @@ calculate_timeout(long requested_timeout_us) const
 
 void
 select_scheduler::
-run_reactor(std::unique_lock<std::mutex>& lock)
+run_reactor(std::unique_lock<std::mutex>& lock, thread_stats& ts)
 {
     // Calculate timeout considering timers, use 0 if interrupted
     long effective_timeout_us = reactor_interrupted_ ? 0 : calculate_timeout(-1);
 
-    // Build fd_sets from registered_fds_
-    fd_set read_fds, write_fds, except_fds;
-    FD_ZERO(&read_fds);
-    FD_ZERO(&write_fds);
-    FD_ZERO(&except_fds);
+    // Copy the master fd_sets; connect and write ops are also
+    // monitored for errors
+    fd_set read_fds = read_fds_;
+    fd_set write_fds = write_fds_;
+    fd_set except_fds = write_fds_;
 
     // Always include the interrupt pipe
     FD_SET(pipe_fds_[0], &read_fds);
-    int nfds = pipe_fds_[0];
-
-    // Add registered fds
-    for (auto& [fd, state] : registered_fds_)
-    {
-        if (state.read_op)
-            FD_SET(fd, &read_fds);
-        if (state.write_op)
-        {
-            FD_SET(fd, &write_fds);
-            // Also monitor for errors on connect operations
-            FD_SET(fd, &except_fds);
-        }
-        if (fd > nfds)
-            nfds = fd;
-    }
+    int nfds = (std::max)(pipe_fds_[0], max_fd_);
 
     // Convert timeout to timeval
     struct timeval tv;
@@ -578,8 +862,39 @@ run_reactor(std::unique_lock<std::mutex>& lock)
 
     lock.unlock();
 
-    int ready = ::select(nfds + 1, &read_fds, &write_fds, &except_fds, tv_ptr);
+    // Announce that we may block, then re-check for racing posts
+    bool blocking = !tv_ptr || effective_timeout_us > 0;
+    if (blocking)
+    {
+        reactor_sleeping_.store(true, std::memory_order_seq_cst);
+        if (!injected_.empty())
+        {
+            tv.tv_sec = 0;
+            tv.tv_usec = 0;
+            tv_ptr = &tv;
+            blocking = false;
+        }
+        else
+        {
+            bump(blocking_waits_);
+        }
+    }
+
+    int ready;
+    {
+        blocked_scope blocked(blocking ? &ts : nullptr);
+        BOOST_COROSIO_PROBE1(reactor_wait_enter, blocking ? (tv_ptr
+            ? tv_ptr->tv_sec * 1000 + tv_ptr->tv_usec / 1000 : -1) : 0);
+        ready = ::select(nfds + 1, &read_fds, &write_fds, &except_fds, tv_ptr);
+        BOOST_COROSIO_PROBE1(reactor_wait_exit, ready);
+    }
     int saved_errno = errno;
+    reactor_sleeping_.store(false, std::memory_order_relaxed);
+    bump(reactor_polls_);
+    if (ready > 0)
+        bump(events_harvested_, static_cast<std::uint64_t>(ready));
+    auto const woke = ready > 0 ? trace_clock(tracer_)
+        : op_trace_state::clock::time_point{};
 
     // Process timers outside the lock
     timer_svc_->process_expired();
@@ -593,101 +908,106 @@ run_reactor(std::unique_lock<std::mutex>& lock)
     // Drain the interrupt pipe if readable
     if (ready > 0 && FD_ISSET(pipe_fds_[0], &read_fds))
     {
+        --ready;
         char buf[256];
         while (::read(pipe_fds_[0], buf, sizeof(buf)) > 0) {}
     }
 
     // Process I/O completions
     int completions_queued = 0;
-    if (ready > 0)
+    for (int fd = 0; ready > 0 && fd <= nfds; ++fd)
     {
-        // Iterate over registered fds (copy keys to avoid iterator invalidation)
-        std::vector<int> fds_to_check;
-        fds_to_check.reserve(registered_fds_.size());
-        for (auto& [fd, state] : registered_fds_)
-            fds_to_check.push_back(fd);
-
-        for (int fd : fds_to_check)
-        {
-            auto it = registered_fds_.find(fd);
-            if (it == registered_fds_.end())
-                continue;
+        if (fd == pipe_fds_[0])
+            continue;
 
-            auto& state = it->second;
+        bool is_readable = FD_ISSET(fd, &read_fds);
+        bool is_writable = FD_ISSET(fd, &write_fds);
+        bool has_error = FD_ISSET(fd, &except_fds);
+        if (!is_readable && !is_writable && !has_error)
+            continue;
+        ready -= is_readable + is_writable + has_error;
 
-            // Check for errors (especially for connect operations)
-            bool has_error = FD_ISSET(fd, &except_fds);
+        auto& state = fd_states_[fd];
 
-            // Process read readiness
-            if (state.read_op && (FD_ISSET(fd, &read_fds) || has_error))
+        // Process read readiness
+        if (state.read_op && (is_readable || has_error))
+        {
+            auto* op = state.read_op;
+            // Claim the op by exchanging to unregistered. Both registering and
+            // registered states mean the op is ours to complete.
+            auto prev = op->registered.exchange(
+                select_registration_state::unregistered, std::memory_order_acq_rel);
+            if (prev != select_registration_state::unregistered)
             {
-                auto* op = state.read_op;
-                // Claim the op by exchanging to unregistered. Both registering and
-                // registered states mean the op is ours to complete.
-                auto prev = op->registered.exchange(
-                    select_registration_state::unregistered, std::memory_order_acq_rel);
-                if (prev != select_registration_state::unregistered)
+                state.read_op = nullptr;
+                FD_CLR(fd, &read_fds_);
+
+                if (has_error && op->wait_events == 0)
+                {
+                    int errn = 0;
+                    socklen_t len = sizeof(errn);
+                    if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
+                        errn = errno;
+                    if (errn == 0)
+                        errn = EIO;
+                    op->complete(errn, 0);
+                }
+                else
                 {
-                    state.read_op = nullptr;
-
-                    if (has_error)
-                    {
-                        int errn = 0;
-                        socklen_t len = sizeof(errn);
-                        if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
-                            errn = errno;
-                        if (errn == 0)
-                            errn = EIO;
-                        op->complete(errn, 0);
-                    }
-                    else
-                    {
-                        op->perform_io();
-                    }
-
-                    completed_ops_.push(op);
-                    ++completions_queued;
+                    op->perform_io();
                 }
+
+                op->trace.mark_ready(woke);
+                completed_ops_.push(op);
+                ++completions_queued;
             }
+        }
 
-            // Process write readiness
-            if (state.write_op && (FD_ISSET(fd, &write_fds) || has_error))
+        // Process write readiness
+        if (state.write_op && (is_writable || has_error))
+        {
+            auto* op = state.write_op;
+            // Claim the op by exchanging to unregistered. Both registering and
+            // registered states mean the op is ours to complete.
+            auto prev = op->registered.exchange(
+                select_registration_state::unregistered, std::memory_order_acq_rel);
+            if (prev != select_registration_state::unregistered)
             {
-                auto* op = state.write_op;
-                // Claim the op by exchanging to unregistered. Both registering and
-                // registered states mean the op is ours to complete.
-                auto prev = op->registered.exchange(
-                    select_registration_state::unregistered, std::memory_order_acq_rel);
-                if (prev != select_registration_state::unregistered)
+                state.write_op = nullptr;
+                FD_CLR(fd, &write_fds_);
+
+                if (has_error && op->wait_events == 0)
+                {
+                    int errn = 0;
+                    socklen_t len = sizeof(errn);
+                    if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
+                        errn = errno;
+                    if (errn == 0)
+                        errn = EIO;
+                    op->complete(errn, 0);
+                }
+                else
                 {
-                    state.write_op = nullptr;
-
-                    if (has_error)
-                    {
-                        int errn = 0;
-                        socklen_t len = sizeof(errn);
-                        if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errn, &len) < 0)
-                            errn = errno;
-                        if (errn == 0)
-                            errn = EIO;
-                        op->complete(errn, 0);
-                    }
-                    else
-                    {
-                        op->perform_io();
-                    }
-
-                    completed_ops_.push(op);
-                    ++completions_queued;
+                    op->perform_io();
                 }
+
+                op->trace.mark_ready(woke);
+                completed_ops_.push(op);
+                ++completions_queued;
             }
+        }
 
-            // Clean up empty entries
-            if (!state.read_op && !state.write_op)
-                registered_fds_.erase(it);
+        if (fd == max_fd_ && !state.read_op && !state.write_op)
+        {
+            while (max_fd_ >= 0 &&
+                   !fd_states_[max_fd_].read_op &&
+                   !fd_states_[max_fd_].write_op)
+                --max_fd_;
         }
     }
 
+    raise_peak(queue_peak_, completed_ops_.size());
+
     // Wake idle workers if we queued I/O completions
     if (completions_queued > 0)
     {
@@ -703,6 +1023,7 @@ std::size_t
 select_scheduler::
 do_one(long timeout_us)
 {
+    auto* frame = find_context(this);
     std::unique_lock lock(mutex_);
 
     using clock = std::chrono::steady_clock;
@@ -715,6 +1036,12 @@ do_one(long timeout_us)
         if (stopped_.load(std::memory_order_acquire))
             return 0;
 
+        if (!injected_.empty())
+        {
+            completed_ops_.take_all(injected_);
+            raise_peak(queue_peak_, completed_ops_.size());
+        }
+
         // Try to get a handler from the queue
         scheduler_op* op = completed_ops_.pop();
 
@@ -722,8 +1049,13 @@ do_one(long timeout_us)
         {
             // Got a handler - execute it
             lock.unlock();
-            work_guard g{this};
+            bump(frame->stats->handlers);
+            handler_scope g{this, frame};
+            handler_timer timed(stats_registry_, *frame->stats,
+                [op] { return op->target(); });
+            BOOST_COROSIO_PROBE1(handler_start, op);
             (*op)();
+            BOOST_COROSIO_PROBE1(handler_done, op);
             return 1;
         }
 
@@ -751,7 +1083,7 @@ do_one(long timeout_us)
             reactor_running_ = true;
             reactor_interrupted_ = false;
 
-            run_reactor(lock);
+            run_reactor(lock, *frame->stats);
 
             reactor_running_ = false;
             // Loop back to check for handlers that reactor may have queued
@@ -760,10 +1092,20 @@ do_one(long timeout_us)
 
         // Reactor is running in another thread - wait for work on condvar
         ++idle_thread_count_;
-        if (timeout_us < 0)
-            wakeup_event_.wait(lock);
-        else
-            wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        if (!injected_.empty())
+        {
+            // A post raced with the announcement above
+            --idle_thread_count_;
+            continue;
+        }
+        bump(frame->stats->parks);
+        {
+            blocked_scope blocked(frame->stats);
+            if (timeout_us < 0)
+                wakeup_event_.wait(lock);
+            else
+                wakeup_event_.wait_for(lock, std::chrono::microseconds(remaining_us));
+        }
         --idle_thread_count_;
     }
 }
@@ -18,7 +18,10 @@
 #include <boost/corosio/detail/scheduler.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 
+#include "src/detail/op_lanes.hpp"
+#include "src/detail/op_trace.hpp"
 #include "src/detail/scheduler_op.hpp"
+#include "src/detail/thread_stats.hpp"
 #include "src/detail/timer_service.hpp"
 
 #include <sys/select.h>
@@ -29,7 +32,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
 namespace boost::corosio::detail {
 
@@ -53,7 +57,7 @@ struct select_op;
 
     Known Limitations:
     - FD_SETSIZE (~1024) limits maximum concurrent connections
-    - O(n) scanning: rebuilds fd_sets each iteration
+    - O(n) scanning: copies fd_sets and scans them each iteration
     - Level-triggered only (no edge-triggered mode)
 
     @par Thread Safety
@@ -85,6 +89,8 @@ public:
     void shutdown() override;
     void post(capy::coro h) const override;
     void post(scheduler_op* h) const override;
+    void post_high_priority(capy::coro h) const override;
+    void post_batch(std::span<capy::coro const> hs) const override;
     void on_work_started() noexcept override;
     void on_work_finished() noexcept override;
     bool running_in_this_thread() const noexcept override;
@@ -96,6 +102,29 @@ public:
     std::size_t wait_one(long usec) override;
     std::size_t poll() override;
     std::size_t poll_one() override;
+    long outstanding_work() const noexcept override
+    {
+        return outstanding_work_.load(std::memory_order_acquire);
+    }
+    void collect_stats(scheduler_stats& st) const noexcept override;
+    bool time_handlers(std::chrono::nanoseconds threshold) noexcept override;
+    void sample_handlers(std::vector<handler_sample>& out) const override;
+    bool trace_ops(op_tracer* t) noexcept override;
+
+    /// Return the tracer for operations starting now, or null.
+    op_tracer* tracer() const noexcept
+    {
+        return tracer_.load(std::memory_order_relaxed);
+    }
+
+    /// Return the socket counters of the calling thread.
+    socket_counter_ref socket_counts() const noexcept;
+
+    /// Add the socket counters of every thread to `st`.
+    void collect_socket_stats(socket_stats& st) const noexcept
+    {
+        stats_registry_.collect(st);
+    }
 
     /** Return the maximum file descriptor value supported.
 
@@ -133,10 +162,15 @@ public:
     static constexpr int event_write = 2;
 
 private:
+    class run_scope;
+    class handler_scope;
+
     std::size_t do_one(long timeout_us);
-    void run_reactor(std::unique_lock<std::mutex>& lock);
+    void enqueue(scheduler_op* h) const;
+    void run_reactor(std::unique_lock<std::mutex>& lock, thread_stats& ts);
     void wake_one_thread_and_unlock(std::unique_lock<std::mutex>& lock) const;
     void interrupt_reactor() const;
+    void wake_for_batch(std::size_t n) const;
     long calculate_timeout(long requested_timeout_us) const;
 
     // Self-pipe for interrupting select()
@@ -144,7 +178,8 @@ private:
 
     mutable std::mutex mutex_;
     mutable std::condition_variable wakeup_event_;
-    mutable op_queue completed_ops_;
+    mutable op_lanes completed_ops_;
+    mutable intrusive_mpsc_queue<scheduler_op> injected_;  // lock-free posts
     mutable std::atomic<long> outstanding_work_;
     std::atomic<bool> stopped_;
     bool shutdown_;
@@ -156,13 +191,32 @@ private:
         select_op* read_op = nullptr;
         select_op* write_op = nullptr;
     };
-    mutable std::unordered_map<int, fd_state> registered_fds_;
-    mutable int max_fd_ = -1;
+
+    // Registrations, guarded by mutex_. fd_states_ has FD_SETSIZE
+    // entries indexed by fd; the fd_sets mirror which slots are in use.
+    mutable std::vector<fd_state> fd_states_;
+    mutable fd_set read_fds_;
+    mutable fd_set write_fds_;
+    mutable int max_fd_ = -1;  // highest fd with a registered op
 
     // Single reactor thread coordination
     mutable bool reactor_running_ = false;
     mutable bool reactor_interrupted_ = false;
-    mutable int idle_thread_count_ = 0;
+    mutable std::atomic<int> idle_thread_count_ = 0;
+    mutable std::atomic<bool> reactor_sleeping_ = false;
+
+    // Reactor counters, written by the thread holding the reactor role
+    std::atomic<std::uint64_t> blocking_waits_ = 0;
+    std::atomic<std::uint64_t> reactor_polls_ = 0;
+    std::atomic<std::uint64_t> events_harvested_ = 0;
+    mutable std::atomic<std::uint64_t> wakeup_writes_ = 0;
+
+    // Per-thread counters and the queue depth peak, see "Statistics"
+    mutable thread_stats_registry stats_registry_;
+    mutable std::atomic<std::size_t> queue_peak_ = 0;
+
+    // See "Operation Tracing" in op_trace.hpp
+    std::atomic<op_tracer*> tracer_ = nullptr;
 };
 
 } // namespace boost::corosio::detail
@@ -71,6 +71,35 @@ cancel() noexcept
         request_cancel();
 }
 
+// See "Counters" in op.hpp
+void
+select_op::
+count() const noexcept
+{
+    auto const c = socket_impl_->service().scheduler().socket_counts();
+    if (cancelled.load(std::memory_order_acquire))
+    {
+        c.add(&socket_counters::cancellations);
+        return;
+    }
+    if (wait_events != 0)
+        return;
+    if (this == &socket_impl_->rd_)
+    {
+        c.add(&socket_counters::bytes_read, bytes_transferred);
+        c.add(waited
+            ? &socket_counters::reads_waited
+            : &socket_counters::reads_immediate);
+    }
+    else
+    {
+        c.add(&socket_counters::bytes_written, bytes_transferred);
+        c.add(waited
+            ? &socket_counters::writes_waited
+            : &socket_counters::writes_immediate);
+    }
+}
+
 //------------------------------------------------------------------------------
 // select_connect_op::operator() - caches endpoints on successful connect
 //------------------------------------------------------------------------------
@@ -80,18 +109,28 @@ select_connect_op::
 operator()()
 {
     stop_cb.reset();
+    trace.finish(cancelled.load(std::memory_order_acquire));
+    BOOST_COROSIO_PROBE2(socket_connect, fd, errn);
 
     bool success = (errn == 0 && !cancelled.load(std::memory_order_acquire));
+    if (socket_impl_)
+    {
+        auto const c = socket_impl_->service().scheduler().socket_counts();
+        if (cancelled.load(std::memory_order_acquire))
+            c.add(&socket_counters::cancellations);
+        else if (errn != 0)
+            c.add(&socket_counters::connect_failures);
+    }
 
     // Cache endpoints on successful connect
     if (success && socket_impl_)
     {
         // Query local endpoint via getsockname (may fail, but remote is always known)
         endpoint local_ep;
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         socklen_t local_len = sizeof(local_addr);
         if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_ep = from_sockaddr_in(local_addr);
+            local_ep = from_sockaddr(local_addr);
         // Always cache remote endpoint; local may be default if getsockname failed
         static_cast<select_socket_impl*>(socket_impl_)->set_endpoints(local_ep, target_endpoint);
     }
@@ -151,17 +190,19 @@ connect(
     op.fd = fd_;
     op.target_endpoint = ep;  // Store target for endpoint caching
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    sockaddr_in addr = detail::to_sockaddr_in(ep);
-    int result = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    sockaddr_storage addr;
+    socklen_t addrlen = detail::to_sockaddr(ep, addr);
+    int result = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), addrlen);
 
     if (result == 0)
     {
         // Sync success - cache endpoints immediately
-        sockaddr_in local_addr{};
+        sockaddr_storage local_addr{};
         socklen_t local_len = sizeof(local_addr);
         if (::getsockname(fd_, reinterpret_cast<sockaddr*>(&local_addr), &local_len) == 0)
-            local_endpoint_ = detail::from_sockaddr_in(local_addr);
+            local_endpoint_ = detail::from_sockaddr(local_addr);
         remote_endpoint_ = ep;
 
         op.complete(0, 0);
@@ -172,6 +213,7 @@ connect(
 
     if (errno == EINPROGRESS)
     {
+        count_would_block(op);
         svc_.work_started();
         // Set registering BEFORE register_fd to close the race window where
         // reactor sees an event before we set registered. The reactor treats
@@ -212,7 +254,7 @@ connect(
     svc_.post(&op);
 }
 
-void
+bool
 select_socket_impl::
 read_some(
     std::coroutine_handle<> h,
@@ -229,34 +271,27 @@ read_some(
     op.ec_out = ec;
     op.bytes_out = bytes_out;
     op.fd = fd_;
+    assign_iovecs(op.iovecs, param);
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    capy::mutable_buffer bufs[select_read_op::max_buffers];
-    op.iovec_count = static_cast<int>(param.copy_to(bufs, select_read_op::max_buffers));
-
-    if (op.iovec_count == 0 || (op.iovec_count == 1 && bufs[0].size() == 0))
+    if (op.iovecs.empty())
     {
         op.empty_buffer_read = true;
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
-    }
-
-    for (int i = 0; i < op.iovec_count; ++i)
-    {
-        op.iovecs[i].iov_base = bufs[i].data();
-        op.iovecs[i].iov_len = bufs[i].size();
+        return false;
     }
 
-    ssize_t n = ::readv(fd_, op.iovecs, op.iovec_count);
+    ssize_t n = ::readv(fd_, op.iovecs.data(), static_cast<int>(op.iovecs.size()));
 
     if (n > 0)
     {
         op.complete(0, static_cast<std::size_t>(n));
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
     if (n == 0)
@@ -264,11 +299,12 @@ read_some(
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
     if (errno == EAGAIN || errno == EWOULDBLOCK)
     {
+        count_would_block(op);
         svc_.work_started();
         // Set registering BEFORE register_fd to close the race window where
         // reactor sees an event before we set registered.
@@ -284,7 +320,7 @@ read_some(
                 expected, select_registration_state::registered, std::memory_order_acq_rel))
         {
             svc_.scheduler().deregister_fd(fd_, select_scheduler::event_read);
-            return;
+            return false;
         }
 
         // If cancelled was set before we registered, handle it now.
@@ -300,15 +336,16 @@ read_some(
                 svc_.work_finished();
             }
         }
-        return;
+        return false;
     }
 
     op.complete(errno, 0);
     op.impl_ptr = shared_from_this();
     svc_.post(&op);
+    return false;
 }
 
-void
+bool
 select_socket_impl::
 write_some(
     std::coroutine_handle<> h,
@@ -325,28 +362,21 @@ write_some(
     op.ec_out = ec;
     op.bytes_out = bytes_out;
     op.fd = fd_;
+    assign_iovecs(op.iovecs, param);
     op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
 
-    capy::mutable_buffer bufs[select_write_op::max_buffers];
-    op.iovec_count = static_cast<int>(param.copy_to(bufs, select_write_op::max_buffers));
-
-    if (op.iovec_count == 0 || (op.iovec_count == 1 && bufs[0].size() == 0))
+    if (op.iovecs.empty())
     {
         op.complete(0, 0);
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
-    }
-
-    for (int i = 0; i < op.iovec_count; ++i)
-    {
-        op.iovecs[i].iov_base = bufs[i].data();
-        op.iovecs[i].iov_len = bufs[i].size();
+        return false;
     }
 
     msghdr msg{};
-    msg.msg_iov = op.iovecs;
-    msg.msg_iovlen = static_cast<std::size_t>(op.iovec_count);
+    msg.msg_iov = op.iovecs.data();
+    msg.msg_iovlen = op.iovecs.size();
 
     ssize_t n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
 
@@ -355,11 +385,12 @@ write_some(
         op.complete(0, static_cast<std::size_t>(n));
         op.impl_ptr = shared_from_this();
         svc_.post(&op);
-        return;
+        return false;
     }
 
     if (errno == EAGAIN || errno == EWOULDBLOCK)
     {
+        count_would_block(op);
         svc_.work_started();
         // Set registering BEFORE register_fd to close the race window where
         // reactor sees an event before we set registered.
@@ -375,7 +406,7 @@ write_some(
                 expected, select_registration_state::registered, std::memory_order_acq_rel))
         {
             svc_.scheduler().deregister_fd(fd_, select_scheduler::event_write);
-            return;
+            return false;
         }
 
         // If cancelled was set before we registered, handle it now.
@@ -391,12 +422,157 @@ write_some(
                 svc_.work_finished();
             }
         }
-        return;
+        return false;
     }
 
     op.complete(errno ? errno : EIO, 0);
     op.impl_ptr = shared_from_this();
     svc_.post(&op);
+    return false;
+}
+
+bool
+select_socket_impl::
+write_with_descriptor(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    capy::const_buffer buf,
+    native_handle_type fd,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = wr_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.pass_fd = fd;
+    assign_iovecs(op.iovecs, buf);
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    start_op(op, select_scheduler::event_write);
+    return false;
+}
+
+bool
+select_socket_impl::
+read_with_descriptor(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    capy::mutable_buffer buf,
+    native_handle_type* fd,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes_out)
+{
+    auto& op = rd_;
+    op.reset();
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = bytes_out;
+    op.fd = fd_;
+    op.fd_out = fd;
+    assign_iovecs(op.iovecs, buf);
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    start_op(op, select_scheduler::event_read);
+    return false;
+}
+
+bool
+select_socket_impl::
+wait(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    socket::wait_type w,
+    std::stop_token token,
+    system::error_code* ec)
+{
+    // select() reports errors only for descriptors waiting to write
+    if (w == socket::wait_type::error)
+    {
+        *ec = make_error_code(system::errc::operation_not_supported);
+        return true;
+    }
+
+    // See "Readiness Waits" in op.hpp
+    if (w == socket::wait_type::write)
+    {
+        wr_.reset();
+        wr_.wait_events = POLLOUT;
+    }
+    else
+    {
+        rd_.reset();
+        rd_.wait_events = POLLIN;
+    }
+
+    select_op& op = w == socket::wait_type::write
+        ? static_cast<select_op&>(wr_) : rd_;
+    op.h = h;
+    op.ex = ex;
+    op.ec_out = ec;
+    op.bytes_out = nullptr;
+    op.fd = fd_;
+    op.start(token, this);
+    op.trace.start(svc_.scheduler().tracer());
+    start_op(op, w == socket::wait_type::write
+        ? select_scheduler::event_write
+        : select_scheduler::event_read);
+    return false;
+}
+
+void
+select_socket_impl::
+count_would_block(select_op& op) noexcept
+{
+    op.waited = true;
+    svc_.scheduler().socket_counts().add(&socket_counters::would_block);
+}
+
+void
+select_socket_impl::
+start_op(select_op& op, int event)
+{
+    op.perform_io();
+    if (op.errn != EAGAIN && op.errn != EWOULDBLOCK)
+    {
+        op.impl_ptr = shared_from_this();
+        svc_.post(&op);
+        return;
+    }
+    op.errn = 0;
+
+    // Registration as in read_some
+    count_would_block(op);
+    svc_.work_started();
+    op.registered.store(select_registration_state::registering, std::memory_order_release);
+    svc_.scheduler().register_fd(fd_, &op, event);
+
+    auto expected = select_registration_state::registering;
+    if (!op.registered.compare_exchange_strong(
+            expected, select_registration_state::registered, std::memory_order_acq_rel))
+    {
+        svc_.scheduler().deregister_fd(fd_, event);
+        return;
+    }
+
+    if (op.cancelled.load(std::memory_order_acquire))
+    {
+        auto prev = op.registered.exchange(
+            select_registration_state::unregistered, std::memory_order_acq_rel);
+        if (prev != select_registration_state::unregistered)
+        {
+            svc_.scheduler().deregister_fd(fd_, event);
+            op.impl_ptr = shared_from_this();
+            svc_.post(&op);
+            svc_.work_finished();
+        }
+    }
 }
 
 system::error_code
@@ -548,6 +724,25 @@ linger(system::error_code& ec) const noexcept
     return {.enabled = lg.l_onoff != 0, .timeout = lg.l_linger};
 }
 
+system::error_code
+select_socket_impl::
+set_high_priority_completions(bool value) noexcept
+{
+    // See "Priority Lanes" in scheduler.cpp
+    conn_.high_priority = value;
+    rd_.high_priority = value;
+    wr_.high_priority = value;
+    return {};
+}
+
+bool
+select_socket_impl::
+high_priority_completions(system::error_code& ec) const noexcept
+{
+    ec = {};
+    return rd_.high_priority;
+}
+
 void
 select_socket_impl::
 cancel() noexcept
@@ -626,6 +821,10 @@ close_socket() noexcept
         fd_ = -1;
     }
 
+    conn_.high_priority = false;
+    rd_.high_priority = false;
+    wr_.high_priority = false;
+
     // Clear cached endpoints
     local_endpoint_ = endpoint{};
     remote_endpoint_ = endpoint{};
@@ -662,7 +861,7 @@ socket::socket_impl&
 select_socket_service::
 create_impl()
 {
-    auto impl = std::make_shared<select_socket_impl>(*this);
+    auto impl = make_recycled_impl<select_socket_impl>(*this);
     auto* raw = impl.get();
 
     {
@@ -674,6 +873,15 @@ create_impl()
     return *raw;
 }
 
+void
+select_socket_service::
+collect_stats(socket_stats& st) const noexcept
+{
+    state_->sched_.collect_socket_stats(st);
+    std::lock_guard lock(state_->mutex_);
+    st.live_sockets += state_->socket_ptrs_.size();
+}
+
 void
 select_socket_service::
 destroy_impl(socket::socket_impl& impl)
@@ -686,12 +894,14 @@ destroy_impl(socket::socket_impl& impl)
 
 system::error_code
 select_socket_service::
-open_socket(socket::socket_impl& impl)
+open_socket(
+    socket::socket_impl& impl,
+    ip_family family)
 {
     auto* select_impl = static_cast<select_socket_impl*>(&impl);
     select_impl->close_socket();
 
-    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int fd = ::socket(detail::to_af(family), SOCK_STREAM, 0);
     if (fd < 0)
         return make_err(errno);
 
@@ -727,6 +937,60 @@ open_socket(socket::socket_impl& impl)
     return {};
 }
 
+system::error_code
+select_socket_service::
+open_local_socket(
+    socket::socket_impl& impl)
+{
+    auto* select_impl = static_cast<select_socket_impl*>(&impl);
+    select_impl->close_socket();
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return make_err(errno);
+
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags == -1 ||
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1 ||
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
+    {
+        int errn = errno;
+        ::close(fd);
+        return make_err(errn);
+    }
+
+    if (fd >= FD_SETSIZE)
+    {
+        ::close(fd);
+        return make_err(EMFILE);
+    }
+
+    select_impl->fd_ = fd;
+    return {};
+}
+
+system::error_code
+select_socket_service::
+assign_socket(
+    socket::socket_impl& impl,
+    native_handle_type fd,
+    endpoint local,
+    endpoint remote)
+{
+    auto* select_impl = static_cast<select_socket_impl*>(&impl);
+    select_impl->close_socket();
+
+    // Check fd is within select() limits
+    if (fd >= FD_SETSIZE)
+    {
+        ::close(fd);
+        return make_err(EMFILE);
+    }
+    select_impl->fd_ = fd;
+    select_impl->set_endpoints(local, remote);
+    return {};
+}
+
 void
 select_socket_service::
 post(select_op* op)
@@ -19,6 +19,7 @@
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/recycling_allocator.hpp"
 #include "src/detail/socket_service.hpp"
 
 #include "src/detail/select/op.hpp"
@@ -26,7 +27,6 @@
 
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 /*
     select Socket Implementation
@@ -73,7 +73,7 @@ class select_socket_impl;
 
 //------------------------------------------------------------------------------
 
-class select_socket_impl
+class select_socket_impl final
     : public socket::socket_impl
     , public std::enable_shared_from_this<select_socket_impl>
     , public intrusive_list<select_socket_impl>::node
@@ -92,7 +92,7 @@ public:
         std::stop_token,
         system::error_code*) override;
 
-    void read_some(
+    bool read_some(
         std::coroutine_handle<>,
         capy::executor_ref,
         io_buffer_param,
@@ -100,7 +100,7 @@ public:
         system::error_code*,
         std::size_t*) override;
 
-    void write_some(
+    bool write_some(
         std::coroutine_handle<>,
         capy::executor_ref,
         io_buffer_param,
@@ -108,6 +108,31 @@ public:
         system::error_code*,
         std::size_t*) override;
 
+    bool write_with_descriptor(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        capy::const_buffer,
+        native_handle_type,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool read_with_descriptor(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        capy::mutable_buffer,
+        native_handle_type*,
+        std::stop_token,
+        system::error_code*,
+        std::size_t*) override;
+
+    bool wait(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        socket::wait_type,
+        std::stop_token,
+        system::error_code*) override;
+
     system::error_code shutdown(socket::shutdown_type what) noexcept override;
 
     native_handle_type native_handle() const noexcept override { return fd_; }
@@ -128,6 +153,9 @@ public:
     system::error_code set_linger(bool enabled, int timeout) noexcept override;
     socket::linger_options linger(system::error_code& ec) const noexcept override;
 
+    system::error_code set_high_priority_completions(bool value) noexcept override;
+    bool high_priority_completions(system::error_code& ec) const noexcept override;
+
     endpoint local_endpoint() const noexcept override { return local_endpoint_; }
     endpoint remote_endpoint() const noexcept override { return remote_endpoint_; }
     bool is_open() const noexcept { return fd_ >= 0; }
@@ -141,11 +169,19 @@ public:
         remote_endpoint_ = remote;
     }
 
+    select_socket_service& service() const noexcept { return svc_; }
+
     select_connect_op conn_;
     select_read_op rd_;
     select_write_op wr_;
 
 private:
+    // Performs the op, or registers it for `event` if it would block
+    void start_op(select_op& op, int event);
+
+    // Marks an op about to be registered, see "Counters" in op.hpp
+    void count_would_block(select_op& op) noexcept;
+
     select_socket_service& svc_;
     int fd_ = -1;
     endpoint local_endpoint_;
@@ -166,7 +202,7 @@ public:
     select_scheduler& sched_;
     std::mutex mutex_;
     intrusive_list<select_socket_impl> socket_list_;
-    std::unordered_map<select_socket_impl*, std::shared_ptr<select_socket_impl>> socket_ptrs_;
+    impl_ptr_map<select_socket_impl> socket_ptrs_;
 };
 
 /** select socket service implementation.
@@ -187,7 +223,17 @@ public:
 
     socket::socket_impl& create_impl() override;
     void destroy_impl(socket::socket_impl& impl) override;
-    system::error_code open_socket(socket::socket_impl& impl) override;
+    system::error_code open_socket(
+        socket::socket_impl& impl,
+        ip_family family) override;
+    system::error_code open_local_socket(
+        socket::socket_impl& impl) override;
+    system::error_code assign_socket(
+        socket::socket_impl& impl,
+        native_handle_type fd,
+        endpoint local,
+        endpoint remote) override;
+    void collect_stats(socket_stats& st) const noexcept override;
 
     select_scheduler& scheduler() const noexcept { return state_->sched_; }
     void post(select_op* op);
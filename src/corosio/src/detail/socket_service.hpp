@@ -11,12 +11,21 @@
 #define BOOST_COROSIO_DETAIL_SOCKET_SERVICE_HPP
 
 #include <boost/corosio/detail/config.hpp>
+#include <boost/corosio/detail/platform.hpp>
 #include <boost/corosio/socket.hpp>
+#include <boost/corosio/socket_stats.hpp>
 #include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/udp_socket.hpp>
 #include <boost/corosio/endpoint.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <string_view>
+
+#if BOOST_COROSIO_POSIX
+#include <unistd.h>
+#endif
+
 /*
     Abstract Socket Service
     =======================
@@ -73,12 +82,68 @@ public:
 
     /** Open a socket.
 
-        Creates an IPv4 TCP socket and associates it with the platform reactor.
+        Creates a TCP socket and associates it with the platform reactor.
 
         @param impl The socket implementation to open.
+        @param family The address family of the socket.
         @return Error code on failure, empty on success.
     */
-    virtual system::error_code open_socket(socket::socket_impl& impl) = 0;
+    virtual system::error_code open_socket(
+        socket::socket_impl& impl,
+        ip_family family) = 0;
+
+    /** Open a local (Unix domain) stream socket.
+
+        Creates an `AF_UNIX` stream socket and associates it with the
+        platform reactor. Backends without local sockets keep the
+        default, which fails.
+
+        @param impl The socket implementation to open.
+        @return Error code on failure, empty on success.
+    */
+    virtual system::error_code open_local_socket(
+        socket::socket_impl& impl)
+    {
+        (void)impl;
+        return make_error_code(system::errc::operation_not_supported);
+    }
+
+    /** Adopt an open, connected stream socket.
+
+        Associates `fd` with this service's reactor, as for an
+        accepted peer. Backends that cannot adopt a descriptor keep
+        the default, which fails.
+
+        @param impl The socket implementation to assign.
+        @param fd The descriptor, owned by `impl` afterwards and
+            closed on failure.
+        @param local The local endpoint to report.
+        @param remote The remote endpoint to report.
+        @return Error code on failure, empty on success.
+    */
+    virtual system::error_code assign_socket(
+        socket::socket_impl& impl,
+        native_handle_type fd,
+        endpoint local,
+        endpoint remote)
+    {
+        (void)impl;
+        (void)local;
+        (void)remote;
+#if BOOST_COROSIO_POSIX
+        ::close(fd);
+#endif
+        return make_error_code(system::errc::operation_not_supported);
+    }
+
+    /** Add the counters of this service's sockets to `st`.
+
+        Services without counters leave `st` unchanged.
+    */
+    virtual void collect_stats(socket_stats& st) const noexcept
+    {
+        (void)st;
+    }
 
 protected:
     socket_service() = default;
@@ -114,24 +179,128 @@ public:
 
     /** Open an acceptor.
 
-        Creates an IPv4 TCP socket, binds it to the specified endpoint,
-        and begins listening for incoming connections.
+        Creates a TCP socket of the endpoint's family, binds it to the
+        endpoint, and begins listening for incoming connections.
 
         @param impl The acceptor implementation to open.
         @param ep The local endpoint to bind to.
-        @param backlog The maximum length of the queue of pending connections.
+        @param opts The backlog and socket options, see
+            @ref acceptor::listen_options.
         @return Error code on failure, empty on success.
     */
     virtual system::error_code open_acceptor(
         acceptor::acceptor_impl& impl,
         endpoint ep,
-        int backlog) = 0;
+        acceptor::listen_options const& opts) = 0;
+
+    /** Open a local (Unix domain) acceptor.
+
+        Creates an `AF_UNIX` stream socket, binds it to `path`, and
+        begins listening. Backends without local sockets keep the
+        default, which fails.
+
+        @param impl The acceptor implementation to open.
+        @param path The socket path to bind to.
+        @param backlog The maximum length of the pending queue.
+        @return Error code on failure, empty on success.
+    */
+    virtual system::error_code open_local_acceptor(
+        acceptor::acceptor_impl& impl,
+        std::string_view path,
+        int backlog)
+    {
+        (void)impl;
+        (void)path;
+        (void)backlog;
+        return make_error_code(system::errc::operation_not_supported);
+    }
+
+    /** Adopt a listening socket.
+
+        Takes ownership of `fd`, a TCP socket already bound and
+        listening, on success. Backends that cannot adopt sockets
+        keep the default, which fails.
+
+        @param impl The acceptor implementation to open.
+        @param fd The listening socket.
+        @return Error code on failure, empty on success. On failure
+            the caller still owns `fd`.
+    */
+    virtual system::error_code assign_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd)
+    {
+        (void)impl;
+        (void)fd;
+        return make_error_code(system::errc::operation_not_supported);
+    }
+
+    /** Adopt a duplicate of a listening socket shared with others.
+
+        Like @ref assign_acceptor, but `fd` refers to a socket that
+        acceptors of other contexts also listen on. Backends that
+        can limit each connection to waking one of them override
+        this. The default adopts `fd` as @ref assign_acceptor does.
+
+        @param impl The acceptor implementation to open.
+        @param fd The duplicate of the listening socket.
+        @return Error code on failure, empty on success. On failure
+            the caller still owns `fd`.
+    */
+    virtual system::error_code share_acceptor(
+        acceptor::acceptor_impl& impl,
+        native_handle_type fd)
+    {
+        return assign_acceptor(impl, fd);
+    }
 
 protected:
     acceptor_service() = default;
     ~acceptor_service() override = default;
 };
 
+//------------------------------------------------------------------------------
+
+/** Abstract datagram socket service base class.
+
+    This is the service interface used by udp_socket.cpp. A backend
+    that supports datagrams installs a concrete implementation; on
+    the others find_service<udp_service>() returns null.
+
+    The key_type is udp_service itself, which enables runtime polymorphism.
+*/
+class udp_service : public capy::execution_context::service
+{
+public:
+    using key_type = udp_service;
+
+    /** Create a new datagram socket implementation.
+
+        @return Reference to the newly created implementation.
+    */
+    virtual udp_socket::udp_socket_impl& create_udp_impl() = 0;
+
+    /** Destroy a datagram socket implementation.
+
+        @param impl The implementation to destroy.
+    */
+    virtual void destroy_udp_impl(udp_socket::udp_socket_impl& impl) = 0;
+
+    /** Open a datagram socket.
+
+        Creates an IPv4 UDP socket and associates it with the platform reactor.
+
+        @param impl The implementation to open.
+        @return Error code on failure, empty on success.
+    */
+    virtual system::error_code open_udp_socket(
+        udp_socket::udp_socket_impl& impl) = 0;
+
+protected:
+    udp_service() = default;
+    ~udp_service() override = default;
+};
+
 } // namespace boost::corosio::detail
 
 #endif // BOOST_COROSIO_DETAIL_SOCKET_SERVICE_HPP
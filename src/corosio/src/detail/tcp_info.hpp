@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_TCP_INFO_HPP
+#define BOOST_COROSIO_DETAIL_TCP_INFO_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/socket.hpp>
+
+#include "src/detail/make_err.hpp"
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/windows.hpp"
+#include <mstcpip.h>
+#else
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace boost::corosio::detail {
+
+/** Read the kernel's statistics of a TCP connection.
+
+    Takes a native handle so that it can sample a socket owned
+    by another thread without touching the socket object. A
+    handle that was closed reports an error.
+
+    @param fd The connected socket.
+    @param out Receives the statistics on success.
+    @return The error, if any.
+*/
+inline
+system::error_code
+get_tcp_info(
+    native_handle_type fd,
+    socket::tcp_statistics& out) noexcept
+{
+    using std::chrono::microseconds;
+    using std::chrono::milliseconds;
+
+#if BOOST_COROSIO_HAS_IOCP
+#ifdef SIO_TCP_INFO
+    DWORD version = 0;
+    TCP_INFO_v0 ti{};
+    DWORD bytes = 0;
+    if (::WSAIoctl(static_cast<SOCKET>(fd), SIO_TCP_INFO,
+            &version, sizeof(version), &ti, sizeof(ti),
+            &bytes, nullptr, nullptr) != 0)
+    {
+        // Windows before 10 version 1703 does not know the code
+        int err = ::WSAGetLastError();
+        return make_err(static_cast<DWORD>(
+            err == WSAEINVAL ? WSAEOPNOTSUPP : err));
+    }
+    out = {};
+    out.rtt = microseconds(ti.RttUs);
+    out.congestion_window = ti.Cwnd;
+    out.mss = ti.Mss;
+    out.retransmits = ti.Mss ? ti.BytesRetrans / ti.Mss : 0;
+    out.bytes_in_flight = ti.BytesInFlight;
+    return {};
+#else
+    (void)fd;
+    (void)out;
+    return make_err(WSAEOPNOTSUPP);
+#endif
+
+#elif defined(__linux__) && defined(TCP_INFO)
+    struct tcp_info ti{};
+    socklen_t len = sizeof(ti);
+    if (::getsockopt(fd, IPPROTO_TCP, TCP_INFO, &ti, &len) != 0)
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    out = {};
+    out.rtt = microseconds(ti.tcpi_rtt);
+    out.rtt_variance = microseconds(ti.tcpi_rttvar);
+    out.congestion_window =
+        std::uint64_t(ti.tcpi_snd_cwnd) * ti.tcpi_snd_mss;
+    out.mss = ti.tcpi_snd_mss;
+    out.retransmits = ti.tcpi_total_retrans;
+
+    // The kernel's count of packets in flight
+    std::int64_t packets = std::int64_t(ti.tcpi_unacked)
+        - ti.tcpi_sacked - ti.tcpi_lost + ti.tcpi_retrans;
+    if (packets > 0)
+        out.bytes_in_flight = std::uint64_t(packets) * ti.tcpi_snd_mss;
+    return {};
+
+#elif defined(__APPLE__) && defined(TCP_CONNECTION_INFO)
+    tcp_connection_info ti{};
+    socklen_t len = sizeof(ti);
+    if (::getsockopt(fd, IPPROTO_TCP, TCP_CONNECTION_INFO, &ti, &len) != 0)
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    out = {};
+    out.rtt = milliseconds(ti.tcpi_srtt);
+    out.rtt_variance = milliseconds(ti.tcpi_rttvar);
+    out.congestion_window = ti.tcpi_snd_cwnd;
+    out.mss = ti.tcpi_maxseg;
+    out.retransmits = ti.tcpi_txretransmitpackets;
+    out.bytes_in_flight = ti.tcpi_snd_sbbytes;
+    return {};
+
+#else
+    (void)fd;
+    (void)out;
+    return make_err(EOPNOTSUPP);
+#endif
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_DETAIL_TCP_INFO_HPP
@@ -0,0 +1,432 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_THREAD_STATS_HPP
+#define BOOST_COROSIO_DETAIL_THREAD_STATS_HPP
+
+#include <boost/corosio/scheduler_stats.hpp>
+#include <boost/corosio/socket_stats.hpp>
+#include <boost/corosio/detail/scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Per-Thread Counters
+    ===================
+
+    Each thread inside a scheduler's run() owns a thread_stats in its
+    run frame and is the only writer of it, so a count is a relaxed
+    load and store rather than an interlocked update. The registry
+    lists the live counters; a snapshot sums them, and a thread that
+    leaves run() folds its counters into the registry's totals so
+    nothing it counted is lost. A nested run() on the same thread
+    keeps counting into the outer frame's counters, so its time is
+    not counted twice.
+
+    Socket Counters
+    ===============
+
+    The socket services count into the same frames: an operation
+    completing, or parking, on a thread inside run() adds to that
+    thread's socket_counters. Operations started or completed outside
+    run(), such as a read started before the first run() call, have no
+    frame to count into and add to the registry's shared counters with
+    an atomic add instead. socket_counter_ref hides which of the two a
+    thread got, so the services count the same way in both cases.
+
+    Handler Timing
+    ==============
+
+    While a monitor asks for it, handler_timer brackets each handler.
+    It publishes the handler and its start time before running it, so
+    a watcher on another thread can see a handler that is stuck, and
+    keeps the longest duration and the last handler over the
+    threshold. The start time is stored before the handler with
+    release, so a reader that sees the handler sees that start time or
+    a later one and can only underestimate how long it has run. The
+    record of the last slow handler is a sequence lock: the count is
+    odd while it is written. With timing off a handler costs one
+    relaxed load.
+*/
+
+namespace boost::corosio::detail {
+
+/// Add `n` to a counter that only one thread writes.
+inline void
+bump(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1) noexcept
+{
+    counter.store(
+        counter.load(std::memory_order_relaxed) + n,
+        std::memory_order_relaxed);
+}
+
+/// Raise `peak` to `n` if it is lower. Safe from any thread.
+inline void
+raise_peak(std::atomic<std::size_t>& peak, std::size_t n) noexcept
+{
+    std::size_t cur = peak.load(std::memory_order_relaxed);
+    while (n > cur &&
+        !peak.compare_exchange_weak(cur, n, std::memory_order_relaxed))
+    {
+    }
+}
+
+/** Socket service counters of one thread, see socket_stats. */
+struct socket_counters
+{
+    using counter = std::atomic<std::uint64_t>;
+
+    counter bytes_read{0};
+    counter bytes_written{0};
+    counter reads_immediate{0};
+    counter reads_waited{0};
+    counter writes_immediate{0};
+    counter writes_waited{0};
+    counter would_block{0};
+    counter cancellations{0};
+    counter accepts{0};
+    counter connect_failures{0};
+
+    void
+    add_to(socket_stats& st) const noexcept
+    {
+        st.bytes_read += bytes_read.load(std::memory_order_relaxed);
+        st.bytes_written += bytes_written.load(std::memory_order_relaxed);
+        st.reads_immediate += reads_immediate.load(std::memory_order_relaxed);
+        st.reads_waited += reads_waited.load(std::memory_order_relaxed);
+        st.writes_immediate += writes_immediate.load(std::memory_order_relaxed);
+        st.writes_waited += writes_waited.load(std::memory_order_relaxed);
+        st.would_block += would_block.load(std::memory_order_relaxed);
+        st.cancellations += cancellations.load(std::memory_order_relaxed);
+        st.accepts += accepts.load(std::memory_order_relaxed);
+        st.connect_failures += connect_failures.load(std::memory_order_relaxed);
+    }
+};
+
+/** The socket counters the calling thread adds to.
+
+    Either the counters of its run() frame, which only it writes, or
+    the registry's shared counters; see "Socket Counters".
+*/
+class socket_counter_ref
+{
+    socket_counters* c_;
+    bool shared_;
+
+public:
+    socket_counter_ref(socket_counters& c, bool shared) noexcept
+        : c_(&c)
+        , shared_(shared)
+    {
+    }
+
+    /// Add `n` to the counter `m`.
+    void
+    add(socket_counters::counter socket_counters::* m,
+        std::uint64_t n = 1) const noexcept
+    {
+        if (shared_)
+            (c_->*m).fetch_add(n, std::memory_order_relaxed);
+        else
+            bump(c_->*m, n);
+    }
+};
+
+/** Counters of one thread inside a scheduler's run(). */
+struct thread_stats
+{
+    using clock = std::chrono::steady_clock;
+
+    std::atomic<std::uint64_t> handlers{0};
+    std::atomic<std::uint64_t> parks{0};
+    std::atomic<std::uint64_t> blocked_ns{0};
+
+    // Used by schedulers whose threads all wait in the kernel
+    std::atomic<std::uint64_t> polls{0};
+    std::atomic<std::uint64_t> blocking_polls{0};
+    std::atomic<std::uint64_t> events{0};
+
+    // Counted by the socket services, see "Socket Counters"
+    socket_counters sockets;
+
+    clock::time_point const started = clock::now();
+    std::thread::id const thread = std::this_thread::get_id();
+
+    // Handler timing, see handler_timer; times are clock ticks
+    std::atomic<void const*> running{nullptr};
+    std::atomic<std::int64_t> running_since{0};
+    std::atomic<std::uint64_t> longest_ns{0};
+    std::atomic<std::uint64_t> slow_seq{0};
+    std::atomic<void const*> slow{nullptr};
+    std::atomic<std::int64_t> slow_since{0};
+    std::atomic<std::uint64_t> slow_ns{0};
+
+    // Adds the counters to `st`, taking the thread as running until `now`
+    void
+    add_to(scheduler_stats& st, clock::time_point now) const noexcept
+    {
+        auto const blocked = std::chrono::nanoseconds(
+            blocked_ns.load(std::memory_order_relaxed));
+        st.handlers_executed += handlers.load(std::memory_order_relaxed);
+        st.idle_parks += parks.load(std::memory_order_relaxed);
+        st.reactor_polls += polls.load(std::memory_order_relaxed);
+        st.blocking_waits += blocking_polls.load(std::memory_order_relaxed);
+        st.events_harvested += events.load(std::memory_order_relaxed);
+        st.blocked_time += blocked;
+        st.running_time += (std::max)(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now - started) - blocked,
+            std::chrono::nanoseconds(0));
+    }
+};
+
+/** Charges the time until destruction to a thread's blocked time.
+
+    Does nothing when constructed with a null pointer, for waits that
+    only sometimes block.
+*/
+class blocked_scope
+{
+    thread_stats* st_;
+    thread_stats::clock::time_point start_;
+
+public:
+    explicit blocked_scope(thread_stats* st) noexcept
+        : st_(st)
+    {
+        if (st_)
+            start_ = thread_stats::clock::now();
+    }
+
+    ~blocked_scope()
+    {
+        if (!st_)
+            return;
+        bump(st_->blocked_ns, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                thread_stats::clock::now() - start_).count()));
+    }
+
+    blocked_scope(blocked_scope const&) = delete;
+    blocked_scope& operator=(blocked_scope const&) = delete;
+};
+
+/** The counters of every thread that has run a scheduler. */
+class thread_stats_registry
+{
+    mutable std::mutex mutex_;
+    std::vector<thread_stats const*> live_;
+    scheduler_stats retired_;
+    socket_stats retired_sockets_;
+    std::atomic<std::int64_t> threshold_ns_{0};
+
+    // Counted by threads outside run(), see "Socket Counters"
+    mutable socket_counters shared_sockets_;
+
+public:
+    /// Set the handler timing threshold; zero turns timing off.
+    void
+    set_threshold(std::chrono::nanoseconds t) noexcept
+    {
+        threshold_ns_.store(t.count(), std::memory_order_relaxed);
+    }
+
+    /// Return the handler timing threshold in nanoseconds.
+    std::int64_t
+    threshold() const noexcept
+    {
+        return threshold_ns_.load(std::memory_order_relaxed);
+    }
+
+    /// Start reporting the counters of a thread entering run().
+    void
+    attach(thread_stats const& st)
+    {
+        std::lock_guard lock(mutex_);
+        live_.push_back(&st);
+    }
+
+    /// Fold the counters of a thread leaving run() into the totals.
+    void
+    detach(thread_stats const& st) noexcept
+    {
+        auto const now = thread_stats::clock::now();
+        std::lock_guard lock(mutex_);
+        live_.erase(std::find(live_.begin(), live_.end(), &st));
+        st.add_to(retired_, now);
+        st.sockets.add_to(retired_sockets_);
+    }
+
+    /** Return the socket counters of a thread.
+
+        @param st The counters of the thread's run() frame, or null
+            outside run().
+    */
+    socket_counter_ref
+    sockets(thread_stats* st) const noexcept
+    {
+        if (st)
+            return {st->sockets, false};
+        return {shared_sockets_, true};
+    }
+
+    /// Add the socket counters of all threads to `st`.
+    void
+    collect(socket_stats& st) const noexcept
+    {
+        std::lock_guard lock(mutex_);
+        for (auto const* t : live_)
+            t->sockets.add_to(st);
+        shared_sockets_.add_to(st);
+        st.bytes_read += retired_sockets_.bytes_read;
+        st.bytes_written += retired_sockets_.bytes_written;
+        st.reads_immediate += retired_sockets_.reads_immediate;
+        st.reads_waited += retired_sockets_.reads_waited;
+        st.writes_immediate += retired_sockets_.writes_immediate;
+        st.writes_waited += retired_sockets_.writes_waited;
+        st.would_block += retired_sockets_.would_block;
+        st.cancellations += retired_sockets_.cancellations;
+        st.accepts += retired_sockets_.accepts;
+        st.connect_failures += retired_sockets_.connect_failures;
+    }
+
+    /// Add the counters of all threads, live and retired, to `st`.
+    void
+    collect(scheduler_stats& st) const noexcept
+    {
+        auto const now = thread_stats::clock::now();
+        std::lock_guard lock(mutex_);
+        for (auto const* t : live_)
+            t->add_to(st, now);
+        st.handlers_executed += retired_.handlers_executed;
+        st.idle_parks += retired_.idle_parks;
+        st.reactor_polls += retired_.reactor_polls;
+        st.blocking_waits += retired_.blocking_waits;
+        st.events_harvested += retired_.events_harvested;
+        st.blocked_time += retired_.blocked_time;
+        st.running_time += retired_.running_time;
+    }
+
+    /// Replace `out` with the handler timing of each live thread.
+    void
+    sample(std::vector<handler_sample>& out) const
+    {
+        using tp = handler_sample::time_point;
+        out.clear();
+        std::lock_guard lock(mutex_);
+        for (auto const* t : live_)
+        {
+            auto& s = out.emplace_back();
+            s.thread = t->thread;
+            s.running = t->running.load(std::memory_order_acquire);
+            s.running_since = tp(tp::duration(
+                t->running_since.load(std::memory_order_relaxed)));
+            s.longest = std::chrono::nanoseconds(
+                t->longest_ns.load(std::memory_order_relaxed));
+
+            // A few tries to read the slow record between writes
+            for (int i = 0; i < 4; ++i)
+            {
+                auto seq = t->slow_seq.load(std::memory_order_acquire);
+                if (seq & 1)
+                    continue;
+                auto* h = t->slow.load(std::memory_order_relaxed);
+                auto since = t->slow_since.load(std::memory_order_relaxed);
+                auto ns = t->slow_ns.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (t->slow_seq.load(std::memory_order_relaxed) != seq)
+                    continue;
+                s.slow_count = seq / 2;
+                s.slow = h;
+                s.slow_since = tp(tp::duration(since));
+                s.slow_time = std::chrono::nanoseconds(ns);
+                break;
+            }
+        }
+    }
+};
+
+/** Times one handler when the registry's threshold is set.
+
+    `address` returns the address to report for the handler, and is
+    only called when timing is on.
+*/
+class handler_timer
+{
+    using clock = thread_stats::clock;
+
+    thread_stats& st_;
+    std::int64_t const threshold_;
+    void const* h_ = nullptr;
+    void const* prev_ = nullptr;
+    std::int64_t prev_since_ = 0;
+    std::int64_t start_ = 0;
+
+public:
+    template<class Address>
+    handler_timer(
+        thread_stats_registry const& reg,
+        thread_stats& st,
+        Address const& address) noexcept
+        : st_(st)
+        , threshold_(reg.threshold())
+    {
+        if (threshold_ == 0)
+            return;
+        h_ = address();
+
+        // A nested run() times its handlers inside this one
+        prev_ = st_.running.load(std::memory_order_relaxed);
+        prev_since_ = st_.running_since.load(std::memory_order_relaxed);
+        start_ = clock::now().time_since_epoch().count();
+        st_.running_since.store(start_, std::memory_order_relaxed);
+        st_.running.store(h_, std::memory_order_release);
+    }
+
+    ~handler_timer()
+    {
+        if (threshold_ == 0)
+            return;
+        auto const d = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::duration(clock::now().time_since_epoch().count() - start_))
+            .count());
+
+        st_.running_since.store(prev_since_, std::memory_order_relaxed);
+        st_.running.store(prev_, std::memory_order_release);
+
+        if (d > st_.longest_ns.load(std::memory_order_relaxed))
+            st_.longest_ns.store(d, std::memory_order_relaxed);
+
+        if (d >= static_cast<std::uint64_t>(threshold_))
+        {
+            auto seq = st_.slow_seq.load(std::memory_order_relaxed);
+            st_.slow_seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            st_.slow.store(h_, std::memory_order_relaxed);
+            st_.slow_since.store(start_, std::memory_order_relaxed);
+            st_.slow_ns.store(d, std::memory_order_relaxed);
+            st_.slow_seq.store(seq + 2, std::memory_order_release);
+        }
+    }
+
+    handler_timer(handler_timer const&) = delete;
+    handler_timer& operator=(handler_timer const&) = delete;
+};
+
+} // namespace boost::corosio::detail
+
+#endif
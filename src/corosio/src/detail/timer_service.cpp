@@ -10,95 +10,1330 @@
 #include "src/detail/timer_service.hpp"
 
 #include <boost/corosio/detail/scheduler.hpp>
+#include <boost/corosio/parked_ops.hpp>
 #include "src/detail/intrusive.hpp"
+#include "src/detail/probes.hpp"
 #include "src/detail/resume_coro.hpp"
 #include <boost/capy/error.hpp>
 #include <boost/capy/coro.hpp>
 #include <boost/capy/ex/executor_ref.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <coroutine>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <stdexcept>
 #include <stop_token>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <time.h>
+
 namespace boost::corosio::detail {
 
-class timer_service_impl;
+class timer_service_base;
+
+struct timer_impl
+    : timer::timer_impl
+    , intrusive_list<timer_impl>::node
+{
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+    using duration = clock_type::duration;
+
+    timer_service_base* svc_ = nullptr;
+    time_point expiry_;
+    time_point due_;                        // expiry_ rounded by slack_
+    duration slack_{};
+    std::size_t heap_index_ = (std::numeric_limits<std::size_t>::max)();
+    std::size_t shard_ = 0;                 // owning shard, timer_shard_service
+    std::atomic<bool> queued_{false};       // in a timer_heap
+
+    // Lock-free pooling, used by timer_service_impl
+    timer_impl* pool_next_ = nullptr;       // free stack or thread cache
+    timer_impl* all_next_ = nullptr;        // every impl of the service
+
+    // Wheel position, used by timer_wheel_service
+    timer_impl* wheel_prev_ = nullptr;
+    timer_impl* wheel_next_ = nullptr;
+    std::uint64_t wheel_tick_ = 0;
+    int wheel_level_ = -1;                  // -1 when not in the wheel
+    std::size_t wheel_slot_ = 0;
+
+    // Wait operation state
+    std::coroutine_handle<> h_;
+    capy::executor_ref d_;
+    system::error_code* ec_out_ = nullptr;
+    std::stop_token token_;
+    bool waiting_ = false;
+    time_point waited_at_;                  // for parked_ops()
+    timer_impl* expired_next_ = nullptr;    // expired_list link
+
+    // Periodic mode, used by periodic_timer: on expiry the timer is
+    // re-armed a whole number of periods later instead of dequeued,
+    // and ticks_ counts the periods passed since a waiter last took
+    // them. Both are guarded by the lock of the timer's queue.
+    duration period_{};
+    std::uint64_t ticks_ = 0;
+    std::uint64_t* missed_out_ = nullptr;
+
+    // Callback mode, used by io_deadline: a wait with no coroutine
+    // calls fire_ on expiry instead, and nothing on cancellation
+    void (*fire_)(void*) noexcept = nullptr;
+    void* fire_arg_ = nullptr;
+    std::atomic<bool> firing_{false};       // fire_ taken, not yet returned
+
+    explicit timer_impl(timer_service_base& svc) noexcept
+        : svc_(&svc)
+    {
+    }
+
+    void release() override;
+
+    void wait(
+        std::coroutine_handle<>,
+        capy::executor_ref,
+        std::stop_token,
+        system::error_code*) override;
+};
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+// The callback timer being fired on this thread, see timer_service_disarm
+thread_local timer_impl const* this_thread_firing = nullptr;
+
+// Called outside the lock. Clearing firing_ is the last access
+void
+fire_callback(timer_impl& t) noexcept
+{
+    auto const* prev = std::exchange(this_thread_firing, &t);
+    t.fire_(t.fire_arg_);
+    this_thread_firing = prev;
+    t.firing_.store(false, std::memory_order_release);
+}
+
+// Expired waiters, linked through the timers while the service lock is
+// held and resumed once it is released, so firing many timers at once
+// allocates nothing. A timer cannot be destroyed while its wait is
+// pending, so the wait state is still there to read after the lock.
+class expired_list
+{
+    timer_impl* head_ = nullptr;
+    timer_impl* tail_ = nullptr;
+
+public:
+    // Called under the lock with the wait just taken. A callback timer
+    // is marked firing, so it is not reused before fire_callback
+    void push(timer_impl& t) noexcept
+    {
+        if (t.fire_)
+            t.firing_.store(true, std::memory_order_relaxed);
+        t.expired_next_ = nullptr;
+        if (tail_)
+            tail_->expired_next_ = &t;
+        else
+            head_ = &t;
+        tail_ = &t;
+    }
+
+    // Called outside the lock. Returns the number of waiters resumed
+    std::size_t resume(scheduler& sched)
+    {
+        std::size_t n = 0;
+        while (timer_impl* t = head_)
+        {
+            // The waiter may destroy its timer once resumed
+            head_ = t->expired_next_;
+            ++n;
+            BOOST_COROSIO_PROBE1(timer_fire, t);
+
+            if (t->fire_)
+                fire_callback(*t);
+            else
+            {
+                auto h = t->h_;
+                capy::executor_ref d = std::move(t->d_);
+                if (t->ec_out_)
+                    *t->ec_out_ = {};
+                resume_coro(d, h);
+            }
+            // Call on_work_finished AFTER the coroutine resumes, so it has a
+            // chance to add new work before we potentially trigger stop()
+            sched.on_work_finished();
+        }
+        tail_ = nullptr;
+        return n;
+    }
+};
+
+// Round an expiry up to a multiple of the slack, so that timers with the
+// same slack and nearby expiries are queued for the same time
+timer_impl::time_point
+round_to_slack(
+    timer_impl::time_point expiry,
+    timer_impl::duration slack) noexcept
+{
+    using duration = timer_impl::duration;
+    if (slack <= duration::zero() ||
+        expiry == timer_impl::time_point::max())
+        return expiry;
+
+    duration r = expiry.time_since_epoch() % slack;
+    if (r < duration::zero())
+        r += slack;
+    if (r == duration::zero())
+        return expiry;
+    if (timer_impl::time_point::max() - expiry < slack - r)
+        return timer_impl::time_point::max();
+    return expiry + (slack - r);
+}
+
+// Counts, over the timers of one expiry pass, those sharing a queue time
+// with the previous timer only because slack rounded them together
+struct coalesce_counter
+{
+    timer_impl::time_point due = timer_impl::time_point::min();
+    timer_impl::time_point exact = timer_impl::time_point::min();
+    std::uint64_t count = 0;
+
+    void add(timer_impl const& t) noexcept
+    {
+        if (t.slack_ > timer_impl::duration::zero() &&
+            t.due_ == due && t.expiry_ != exact)
+            ++count;
+        due = t.due_;
+        exact = t.expiry_;
+    }
+
+    void publish(std::atomic<std::uint64_t>& total) const noexcept
+    {
+        if (count > 0)
+            total.fetch_add(count, std::memory_order_relaxed);
+    }
+};
+
+// Timers freed by this thread, reused by its next creates. The cache
+// holds timers of one service at a time, named by its id, and is only
+// rebound to another service while empty.
+struct timer_cache
+{
+    std::uint64_t owner = 0;
+    timer_impl* head = nullptr;
+    std::size_t size = 0;
+};
+
+constexpr std::size_t timer_cache_capacity = 64;
+
+thread_local timer_cache this_thread_timers;
+
+std::atomic<std::uint64_t> next_timer_service_id{1};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+/*
+    Periodic Timers
+    ---------------
+    A timer with period_ set stays queued when it expires. Expiry
+    moves expiry_ forward by the whole number of periods that takes
+    it past the current time, so ticks stay on multiples of the
+    period from the first expiry however late each pass runs, and
+    re-queues it where it is: the heaps sift it down from the top,
+    the wheel links it into the slot of its new tick. Nothing is
+    removed and inserted again.
+
+    The periods passed are added to ticks_. A waiter present at
+    expiry takes them at once; otherwise the next wait finds them in
+    start_wait and completes without suspending. Either way all but
+    one are reported as missed. Re-arming or cancelling the timer
+    discards them.
+
+    period_ is written only by update_timer, which sets it with the
+    new expiry under the queue's lock, and cleared by destroy_impl
+    once the timer is off the queue.
+*/
+
+// Operations the free functions below dispatch to the implementation
+class timer_service_base : public timer_service
+{
+public:
+    using key_type = timer_service;
+
+    explicit timer_service_base(scheduler& sched) noexcept
+        : sched_(&sched)
+    {
+    }
+
+    scheduler& get_scheduler() noexcept { return *sched_; }
+
+    virtual void destroy_impl(timer_impl& impl) = 0;
+    virtual void update_timer(
+        timer_impl& impl, time_point new_time, timer_impl::duration period) = 0;
+    virtual void cancel_timer(timer_impl& impl) = 0;
+
+    // Mark the wait started if the timer is queued and has not expired,
+    // under the lock that expiry takes. Returns false if it expired
+    virtual bool start_wait(timer_impl& impl) = 0;
+
+protected:
+    // Move a due periodic timer to its first multiple of the period
+    // after `now`, counting the ticks passed. The caller re-queues it
+    // at due_, under the lock of its queue
+    static void
+    advance_period(timer_impl& t, time_point now) noexcept
+    {
+        auto const behind = now - t.expiry_;
+        auto const n = 1 + static_cast<std::uint64_t>(behind / t.period_);
+        t.expiry_ += t.period_ * static_cast<timer_impl::duration::rep>(n);
+        t.due_ = round_to_slack(t.expiry_, t.slack_);
+        t.ticks_ += n;
+    }
+
+    // Hand the ticks counted to the waiter, reporting all but one as
+    // missed. Returns false if none have passed. Under the lock
+    static bool
+    take_ticks(timer_impl& t) noexcept
+    {
+        if (t.ticks_ == 0)
+            return false;
+        if (t.missed_out_)
+            *t.missed_out_ = t.ticks_ - 1;
+        t.ticks_ = 0;
+        return true;
+    }
+
+    // Record a timer a coroutine waits on, under the lock of its queue
+    static void
+    add_waiter(
+        std::vector<parked_op>& out,
+        timer_impl const& t,
+        time_point now)
+    {
+        if (!t.waiting_ || !t.h_)
+            return;
+        parked_op p;
+        p.kind = parked_kind::timer;
+        p.age = now - t.waited_at_;
+        p.coroutine = t.h_.address();
+        out.push_back(p);
+    }
+
+    scheduler* sched_ = nullptr;
+};
+
+//------------------------------------------------------------------------------
+
+// Binary min-heap of timers ordered by expiry
+class timer_heap
+{
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    // heap_index_ of a timer not in any heap
+    static constexpr std::size_t npos =
+        (std::numeric_limits<std::size_t>::max)();
+
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    time_point top_time() const noexcept
+    {
+        return heap_.empty() ? time_point::max() : heap_[0].time_;
+    }
+
+    timer_impl* top() const noexcept
+    {
+        return heap_[0].timer_;
+    }
+
+    template<class F>
+    void for_each(F&& f) const
+    {
+        for (auto const& e : heap_)
+            f(*e.timer_);
+    }
+
+    // Insert the timer or move it to its new expiry.
+    // Returns true if it is now the earliest.
+    bool set(timer_impl& impl, time_point new_time)
+    {
+        if (impl.heap_index_ < heap_.size())
+        {
+            // Already in heap, update position
+            time_point old_time = heap_[impl.heap_index_].time_;
+            heap_[impl.heap_index_].time_ = new_time;
+
+            if (new_time < old_time)
+                up_heap(impl.heap_index_);
+            else
+                down_heap(impl.heap_index_);
+        }
+        else
+        {
+            // Not in heap, add it
+            impl.heap_index_ = heap_.size();
+            heap_.push_back({new_time, &impl});
+            impl.queued_.store(true, std::memory_order_relaxed);
+            up_heap(heap_.size() - 1);
+        }
+        return impl.heap_index_ == 0;
+    }
+
+    // The release store to queued_ is the last access to the timer,
+    // so a thread that sees it clear may reuse the timer unlocked
+    void remove(timer_impl& impl) noexcept
+    {
+        std::size_t index = impl.heap_index_;
+        if (index >= heap_.size())
+            return; // Not in heap
+
+        if (index == heap_.size() - 1)
+        {
+            // Last element, just pop
+            impl.heap_index_ = npos;
+            impl.queued_.store(false, std::memory_order_release);
+            heap_.pop_back();
+        }
+        else
+        {
+            // Swap with last and reheapify
+            swap_heap(index, heap_.size() - 1);
+            impl.heap_index_ = npos;
+            impl.queued_.store(false, std::memory_order_release);
+            heap_.pop_back();
+
+            if (index > 0 && heap_[index].time_ < heap_[(index - 1) / 2].time_)
+                up_heap(index);
+            else
+                down_heap(index);
+        }
+    }
+
+private:
+    struct heap_entry
+    {
+        time_point time_;
+        timer_impl* timer_;
+    };
+
+    std::vector<heap_entry> heap_;
+
+    void up_heap(std::size_t index) noexcept
+    {
+        while (index > 0)
+        {
+            std::size_t parent = (index - 1) / 2;
+            if (!(heap_[index].time_ < heap_[parent].time_))
+                break;
+            swap_heap(index, parent);
+            index = parent;
+        }
+    }
+
+    void down_heap(std::size_t index) noexcept
+    {
+        std::size_t child = index * 2 + 1;
+        while (child < heap_.size())
+        {
+            std::size_t min_child = (child + 1 == heap_.size() ||
+                heap_[child].time_ < heap_[child + 1].time_)
+                ? child : child + 1;
+
+            if (heap_[index].time_ < heap_[min_child].time_)
+                break;
+
+            swap_heap(index, min_child);
+            index = min_child;
+            child = index * 2 + 1;
+        }
+    }
+
+    void swap_heap(std::size_t i1, std::size_t i2) noexcept
+    {
+        heap_entry tmp = heap_[i1];
+        heap_[i1] = heap_[i2];
+        heap_[i2] = tmp;
+        heap_[i1].timer_->heap_index_ = i1;
+        heap_[i2].timer_->heap_index_ = i2;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/*
+    Timer Pooling
+    -------------
+    The heap service creates and destroys timers without its mutex.
+    Freed timers go to a per-thread cache of up to 64, and past that to
+    a shared lock-free stack. A thread whose cache runs dry takes the
+    whole stack at once; since the stack is only pushed to or emptied,
+    never popped, it has no ABA problem. A cache serves one service at a
+    time and is rebound only while empty, so a thread using timers of
+    two contexts falls back to the shared stack for the second.
+
+    Every timer ever allocated is also linked, push only, into all_head_
+    so shutdown can delete them wherever they are cached.
+
+    Destroying a timer still locks the heap if the timer is queued.
+    timer_heap::remove() clears queued_ with a release store as its last
+    access to the timer, so a thread that sees it clear knows no other
+    thread is touching the timer and can reuse it without the lock. An
+    expired timer whose waiter is still to be resumed is read after
+    that store, but it has a wait pending and cannot be destroyed yet.
+*/
+class timer_service_impl : public timer_service_base
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+protected:
+    mutable std::mutex mutex_;
+    timer_heap heap_;
+    callback on_earliest_changed_;
+
+    // See "Timer Pooling"
+    std::uint64_t const id_;
+    std::atomic<timer_impl*> free_head_{nullptr};
+    std::atomic<timer_impl*> all_head_{nullptr};
+
+public:
+    timer_service_impl(capy::execution_context&, scheduler& sched)
+        : timer_service_base(sched)
+        , id_(next_timer_service_id.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    ~timer_service_impl()
+    {
+    }
+
+    timer_service_impl(timer_service_impl const&) = delete;
+    timer_service_impl& operator=(timer_service_impl const&) = delete;
+
+    void set_on_earliest_changed(callback cb) override
+    {
+        on_earliest_changed_ = cb;
+    }
+
+    void shutdown() override
+    {
+        // Caches of other threads keep stale pointers tagged with id_,
+        // which no later service shares
+        auto& cache = this_thread_timers;
+        if (cache.owner == id_)
+            cache = {};
+
+        free_head_.store(nullptr, std::memory_order_relaxed);
+        auto* impl = all_head_.exchange(nullptr, std::memory_order_acquire);
+        while (impl)
+        {
+            auto* next = impl->all_next_;
+            delete impl;
+            impl = next;
+        }
+    }
+
+    timer::timer_impl* create_impl() override
+    {
+        auto& cache = this_thread_timers;
+        if (cache.size == 0)
+            cache.owner = id_;
+
+        timer_impl* impl = nullptr;
+        if (cache.owner == id_)
+        {
+            if (!cache.head)
+                refill(cache);
+            impl = cache.head;
+            if (impl)
+            {
+                cache.head = impl->pool_next_;
+                --cache.size;
+            }
+        }
+        else
+        {
+            impl = pop_free();
+        }
+
+        if (impl)
+        {
+            impl->heap_index_ = timer_heap::npos;
+            impl->slack_ = {};
+            return impl;
+        }
+
+        impl = new timer_impl(*this);
+        impl->all_next_ = all_head_.load(std::memory_order_relaxed);
+        while (!all_head_.compare_exchange_weak(
+            impl->all_next_, impl,
+            std::memory_order_release,
+            std::memory_order_relaxed))
+            ;
+        return impl;
+    }
+
+    void destroy_impl(timer_impl& impl) override
+    {
+        // Only queued timers need the heap lock
+        if (impl.queued_.load(std::memory_order_acquire))
+        {
+            std::lock_guard lock(mutex_);
+            heap_.remove(impl);
+        }
+
+        // Unqueued now, so expiry no longer reads these
+        impl.period_ = {};
+        impl.missed_out_ = nullptr;
+
+        auto& cache = this_thread_timers;
+        if (cache.size == 0)
+            cache.owner = id_;
+        if (cache.owner == id_ && cache.size < timer_cache_capacity)
+        {
+            impl.pool_next_ = cache.head;
+            cache.head = &impl;
+            ++cache.size;
+            return;
+        }
+        push_free(&impl, &impl);
+    }
+
+    void update_timer(
+        timer_impl& impl, time_point new_time, timer_impl::duration period) override
+    {
+        bool notify = false;
+        bool was_waiting = false;
+        std::coroutine_handle<> h;
+        capy::executor_ref d;
+        system::error_code* ec_out = nullptr;
+
+        {
+            std::lock_guard lock(mutex_);
+
+            // If currently waiting, cancel the pending wait
+            if (impl.waiting_)
+            {
+                was_waiting = true;
+                impl.waiting_ = false;
+                h = impl.h_;
+                d = impl.d_;
+                ec_out = impl.ec_out_;
+            }
+            impl.ticks_ = 0;
+            impl.period_ = period;
+
+            // Notify if this timer is now the earliest
+            notify = heap_.set(impl, new_time);
+        }
+
+        // Resume cancelled waiter outside lock
+        if (was_waiting)
+        {
+            if (ec_out)
+                *ec_out = make_error_code(capy::error::canceled);
+            if (h)
+                resume_coro(d, h);
+            // Call on_work_finished AFTER the coroutine resumes
+            sched_->on_work_finished();
+        }
+
+        if (notify)
+            on_earliest_changed_();
+    }
+
+    void remove_timer(timer_impl& impl)
+    {
+        std::lock_guard lock(mutex_);
+        heap_.remove(impl);
+    }
+
+    bool start_wait(timer_impl& impl) override
+    {
+        std::lock_guard lock(mutex_);
+        if (take_ticks(impl) || impl.heap_index_ == timer_heap::npos)
+            return false;
+        impl.waiting_ = true;
+        sched_->on_work_started();
+        return true;
+    }
+
+    void cancel_timer(timer_impl& impl) override
+    {
+        std::coroutine_handle<> h;
+        capy::executor_ref d;
+        system::error_code* ec_out = nullptr;
+        bool was_waiting = false;
+
+        {
+            std::lock_guard lock(mutex_);
+            heap_.remove(impl);
+            impl.ticks_ = 0;
+            if (impl.waiting_)
+            {
+                was_waiting = true;
+                impl.waiting_ = false;
+                h = impl.h_;
+                d = std::move(impl.d_);
+                ec_out = impl.ec_out_;
+            }
+        }
+
+        // Dispatch outside lock
+        if (was_waiting)
+        {
+            if (ec_out)
+                *ec_out = make_error_code(capy::error::canceled);
+            if (h)
+                resume_coro(d, h);
+            // Call on_work_finished AFTER the coroutine resumes
+            sched_->on_work_finished();
+        }
+    }
+
+    bool empty() const noexcept override
+    {
+        std::lock_guard lock(mutex_);
+        return heap_.empty();
+    }
+
+    time_point nearest_expiry() const noexcept override
+    {
+        std::lock_guard lock(mutex_);
+        return heap_.top_time();
+    }
+
+    void sample_waiters(
+        std::vector<parked_op>& out, time_point now) const override
+    {
+        std::lock_guard lock(mutex_);
+        heap_.for_each([&](timer_impl const& t)
+        {
+            add_waiter(out, t, now);
+        });
+    }
+
+    std::size_t process_expired() override
+    {
+        // Collect expired timers while holding lock
+        expired_list expired;
+        coalesce_counter merged;
+
+        {
+            std::lock_guard lock(mutex_);
+            auto now = sample_now();
+
+            while (!heap_.empty() && heap_.top_time() <= now)
+            {
+                // Removal comes last, see timer_heap::remove
+                timer_impl* t = heap_.top();
+                merged.add(*t);
+
+                if (t->period_ != timer_impl::duration::zero())
+                {
+                    // Stays queued: one sift down from the top
+                    advance_period(*t, now);
+                    heap_.set(*t, t->due_);
+                    if (t->waiting_ && take_ticks(*t))
+                    {
+                        t->waiting_ = false;
+                        expired.push(*t);
+                    }
+                    continue;
+                }
+
+                if (t->waiting_)
+                {
+                    t->waiting_ = false;
+                    expired.push(*t);
+                }
+                // If not waiting, timer is removed but not dispatched -
+                // wait() will handle this by checking expiry
+
+                heap_.remove(*t);
+            }
+        }
+        merged.publish(coalesced_);
+
+        // Resume outside lock
+        return expired.resume(*sched_);
+    }
+
+private:
+    // Push a chain of free timers onto the shared stack
+    void push_free(timer_impl* first, timer_impl* last) noexcept
+    {
+        last->pool_next_ = free_head_.load(std::memory_order_relaxed);
+        while (!free_head_.compare_exchange_weak(
+            last->pool_next_, first,
+            std::memory_order_release,
+            std::memory_order_relaxed))
+            ;
+    }
+
+    // Move the whole shared stack into the cache
+    void refill(timer_cache& cache) noexcept
+    {
+        cache.head = free_head_.exchange(nullptr, std::memory_order_acquire);
+        cache.size = 0;
+        for (auto* p = cache.head; p; p = p->pool_next_)
+            ++cache.size;
+    }
+
+    // Take one timer when the cache belongs to another service. The
+    // stack is only ever emptied whole, which rules out ABA; the rest
+    // is pushed back.
+    timer_impl* pop_free() noexcept
+    {
+        auto* head = free_head_.exchange(nullptr, std::memory_order_acquire);
+        if (!head)
+            return nullptr;
+        if (auto* rest = head->pool_next_)
+        {
+            auto* last = rest;
+            while (last->pool_next_)
+                last = last->pool_next_;
+            push_free(rest, last);
+        }
+        return head;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/*
+    Virtual Time
+    ------------
+    The virtual service is the heap with a clock of its own: the cached
+    time of timer_service, which only advance_to() and auto-advance
+    move. Expiries, process_expired() and now() all read it, and the
+    real clock is never consulted.
+
+    Schedulers size their waits by comparing nearest_expiry() with the
+    real clock, so virtual expiries are not reported to them. The
+    service reports the epoch, always past, when a timer is due on the
+    virtual clock or auto-advance is ready to jump, and the maximum
+    otherwise. The wait is then left to I/O, or to advance_to(), whose
+    earliest-changed callback wakes the reactor.
+
+    Auto-advance jumps when nothing but a timer can make progress. The
+    scheduler counts one unit of work per timer wait, from start_wait()
+    until its waiter is resumed, and one per pending operation. If the
+    count is the waiting timers alone, the jump is taken at once. If
+    it is the waiting timers plus operations parked on descriptors, as
+    when a read waits for a peer that sleeps, one of those may already
+    be ready in the reactor, unharvested: a loopback write makes its
+    peer readable at once. The first sighting then only arms the
+    check, and the epoch it reports makes the next pass poll without
+    blocking. If no handler has run by the next sighting, that pass
+    found nothing and the jump is taken. Anything else, an operation
+    in flight on a resolver thread or a handler queued, holds the
+    clock. Schedulers that cannot walk their descriptors report no
+    parked operations, so there a parked read holds it too.
+
+    nearest_expiry() decides, before the reactor waits, and
+    process_expired() moves the clock after the pass. The checks walk
+    the heap and the descriptors; virtual time is for tests, where
+    that cost goes unnoticed.
+*/
+class virtual_timer_service final : public timer_service_impl
+{
+    bool const auto_advance_;
+
+    // State of the auto-advance check, see "Virtual Time"
+    mutable bool armed_ = false;
+    mutable bool jump_ = false;
+    mutable std::uint64_t armed_handlers_ = 0;
+
+public:
+    virtual_timer_service(
+        capy::execution_context& ctx,
+        scheduler& sched,
+        bool auto_advance)
+        : timer_service_impl(ctx, sched)
+        , auto_advance_(auto_advance)
+    {
+        use_virtual_time();
+    }
+
+    time_point nearest_expiry() const noexcept override
+    {
+        auto const t = timer_service_impl::nearest_expiry();
+        if (t == time_point::max())
+            return t;
+        if (t <= now() || (auto_advance_ && settled()))
+            return time_point();
+        return time_point::max();
+    }
+
+    std::size_t process_expired() override
+    {
+        if (jump_)
+        {
+            jump_ = false;
+            std::lock_guard lock(mutex_);
+            auto const t = heap_.top_time();
+            if (t != time_point::max() && t > now())
+                set_now(t);
+        }
+        return timer_service_impl::process_expired();
+    }
+
+    bool advance_to(time_point t) override
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (t <= now())
+                return true;
+            set_now(t);
+        }
+
+        // Wake the reactor to expire what is now due
+        on_earliest_changed_();
+        return true;
+    }
+
+private:
+    // Whether the clock may jump, or the next pass must poll to find
+    // out. Sets jump_ when it may
+    bool settled() const noexcept
+    {
+        long const work = sched_->outstanding_work();
+        if (work < 0)
+            return false;
+
+        long waits = 0;
+        {
+            std::lock_guard lock(mutex_);
+            heap_.for_each([&](timer_impl const& t)
+            {
+                if (t.waiting_)
+                    ++waits;
+            });
+        }
+        if (work == waits)
+        {
+            armed_ = false;
+            jump_ = true;
+            return true;
+        }
+
+        long parked = 0;
+        try
+        {
+            std::vector<parked_op> ops;
+            sched_->sample_parked(ops, now());
+            parked = static_cast<long>(ops.size());
+        }
+        catch (std::bad_alloc const&)
+        {
+            armed_ = false;
+            return false;
+        }
+        if (work != waits + parked)
+        {
+            armed_ = false;
+            return false;
+        }
+
+        scheduler_stats st;
+        sched_->collect_stats(st);
+        if (armed_ && st.handlers_executed == armed_handlers_)
+        {
+            armed_ = false;
+            jump_ = true;
+            return true;
+        }
+        armed_ = true;
+        armed_handlers_ = st.handlers_executed;
+        return true;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/*
+    Sharded Timer Heaps
+    -------------------
+    Each shard has its own mutex and heap. A thread is given a shard the
+    first time it creates a timer, round robin, and every timer it
+    creates belongs to that shard for its lifetime, so threads arming
+    their own timers never share a lock. Operations on a timer from
+    another thread lock the owning shard only.
+
+    Every shard publishes the expiry at the top of its heap in an atomic
+    after each change, so nearest_expiry() and empty() read the minimum
+    without locking. process_expired() skips shards with nothing due and
+    drains the others one at a time, starting with the calling thread's.
+*/
+class timer_shard_service : public timer_service_base
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+private:
+    using rep = clock_type::rep;
+
+    struct alignas(64) shard
+    {
+        std::mutex mutex;
+        timer_heap heap;
+        intrusive_list<timer_impl> timers;
+        intrusive_list<timer_impl> free_list;
+        std::atomic<rep> earliest{(std::numeric_limits<rep>::max)()};
+
+        // Called with mutex held after the heap changes
+        void publish() noexcept
+        {
+            earliest.store(
+                heap.top_time().time_since_epoch().count(),
+                std::memory_order_release);
+        }
+    };
+
+    std::size_t count_;
+    std::unique_ptr<shard[]> shards_;
+    callback on_earliest_changed_;
+
+public:
+    timer_shard_service(
+        capy::execution_context&,
+        scheduler& sched,
+        timer_options const& opts)
+        : timer_service_base(sched)
+        , count_(opts.shards > 0 ? opts.shards
+            : (std::max)(std::thread::hardware_concurrency(), 1u))
+        , shards_(new shard[count_])
+    {
+    }
+
+    timer_shard_service(timer_shard_service const&) = delete;
+    timer_shard_service& operator=(timer_shard_service const&) = delete;
+
+    void set_on_earliest_changed(callback cb) override
+    {
+        on_earliest_changed_ = cb;
+    }
+
+    void shutdown() override
+    {
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            while (auto* impl = shards_[i].timers.pop_front())
+                delete impl;
+            while (auto* impl = shards_[i].free_list.pop_front())
+                delete impl;
+        }
+    }
+
+    timer::timer_impl* create_impl() override
+    {
+        std::size_t index = this_thread_shard();
+        shard& s = shards_[index];
+        std::lock_guard lock(s.mutex);
+        timer_impl* impl;
+        if (auto* p = s.free_list.pop_front())
+        {
+            impl = p;
+            impl->heap_index_ = timer_heap::npos;
+            impl->slack_ = {};
+        }
+        else
+        {
+            impl = new timer_impl(*this);
+        }
+        impl->shard_ = index;
+        s.timers.push_back(impl);
+        return impl;
+    }
+
+    void destroy_impl(timer_impl& impl) override
+    {
+        shard& s = shards_[impl.shard_];
+        std::lock_guard lock(s.mutex);
+        s.heap.remove(impl);
+        s.publish();
+        impl.period_ = {};
+        impl.missed_out_ = nullptr;
+        s.timers.remove(&impl);
+        s.free_list.push_back(&impl);
+    }
+
+    void update_timer(
+        timer_impl& impl, time_point new_time, timer_impl::duration period) override
+    {
+        bool notify = false;
+        bool was_waiting = false;
+        std::coroutine_handle<> h;
+        capy::executor_ref d;
+        system::error_code* ec_out = nullptr;
+
+        time_point before = nearest_expiry();
+        shard& s = shards_[impl.shard_];
+        {
+            std::lock_guard lock(s.mutex);
+
+            // If currently waiting, cancel the pending wait
+            if (impl.waiting_)
+            {
+                was_waiting = true;
+                impl.waiting_ = false;
+                h = impl.h_;
+                d = impl.d_;
+                ec_out = impl.ec_out_;
+            }
+            impl.ticks_ = 0;
+            impl.period_ = period;
+
+            // Notify if this timer is now the earliest of all shards
+            notify = s.heap.set(impl, new_time) && new_time < before;
+            s.publish();
+        }
+
+        // Resume cancelled waiter outside lock
+        if (was_waiting)
+        {
+            if (ec_out)
+                *ec_out = make_error_code(capy::error::canceled);
+            if (h)
+                resume_coro(d, h);
+            // Call on_work_finished AFTER the coroutine resumes
+            sched_->on_work_finished();
+        }
+
+        if (notify)
+            on_earliest_changed_();
+    }
+
+    bool start_wait(timer_impl& impl) override
+    {
+        shard& s = shards_[impl.shard_];
+        std::lock_guard lock(s.mutex);
+        if (take_ticks(impl) || impl.heap_index_ == timer_heap::npos)
+            return false;
+        impl.waiting_ = true;
+        sched_->on_work_started();
+        return true;
+    }
+
+    void cancel_timer(timer_impl& impl) override
+    {
+        std::coroutine_handle<> h;
+        capy::executor_ref d;
+        system::error_code* ec_out = nullptr;
+        bool was_waiting = false;
+
+        shard& s = shards_[impl.shard_];
+        {
+            std::lock_guard lock(s.mutex);
+            s.heap.remove(impl);
+            s.publish();
+            impl.ticks_ = 0;
+            if (impl.waiting_)
+            {
+                was_waiting = true;
+                impl.waiting_ = false;
+                h = impl.h_;
+                d = std::move(impl.d_);
+                ec_out = impl.ec_out_;
+            }
+        }
 
-struct timer_impl
-    : timer::timer_impl
-    , intrusive_list<timer_impl>::node
-{
-    using clock_type = std::chrono::steady_clock;
-    using time_point = clock_type::time_point;
-    using duration = clock_type::duration;
+        // Dispatch outside lock
+        if (was_waiting)
+        {
+            if (ec_out)
+                *ec_out = make_error_code(capy::error::canceled);
+            if (h)
+                resume_coro(d, h);
+            // Call on_work_finished AFTER the coroutine resumes
+            sched_->on_work_finished();
+        }
+    }
 
-    timer_service_impl* svc_ = nullptr;
-    time_point expiry_;
-    std::size_t heap_index_ = (std::numeric_limits<std::size_t>::max)();
+    bool empty() const noexcept override
+    {
+        return nearest_expiry() == time_point::max();
+    }
 
-    // Wait operation state
-    std::coroutine_handle<> h_;
-    capy::executor_ref d_;
-    system::error_code* ec_out_ = nullptr;
-    std::stop_token token_;
-    bool waiting_ = false;
+    time_point nearest_expiry() const noexcept override
+    {
+        rep earliest = (std::numeric_limits<rep>::max)();
+        for (std::size_t i = 0; i < count_; ++i)
+            earliest = (std::min)(earliest,
+                shards_[i].earliest.load(std::memory_order_acquire));
+        return time_point(clock_type::duration(earliest));
+    }
 
-    explicit timer_impl(timer_service_impl& svc) noexcept
-        : svc_(&svc)
+    void sample_waiters(
+        std::vector<parked_op>& out, time_point now) const override
     {
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard lock(s.mutex);
+            s.heap.for_each([&](timer_impl const& t)
+            {
+                add_waiter(out, t, now);
+            });
+        }
     }
 
-    void release() override;
+    std::size_t process_expired() override
+    {
+        expired_list expired;
 
-    void wait(
-        std::coroutine_handle<>,
-        capy::executor_ref,
-        std::stop_token,
-        system::error_code*) override;
+        auto now = sample_now();
+        std::size_t first = this_thread_shard();
+        std::size_t total = 0;
+        for (std::size_t n = 0; n < count_; ++n)
+        {
+            shard& s = shards_[(first + n) % count_];
+            if (s.earliest.load(std::memory_order_acquire) >
+                    now.time_since_epoch().count())
+                continue;
+
+            coalesce_counter merged;
+            {
+                std::lock_guard lock(s.mutex);
+                while (!s.heap.empty() && s.heap.top_time() <= now)
+                {
+                    timer_impl* t = s.heap.top();
+                    merged.add(*t);
+                    if (t->period_ != timer_impl::duration::zero())
+                    {
+                        advance_period(*t, now);
+                        s.heap.set(*t, t->due_);
+                        if (t->waiting_ && take_ticks(*t))
+                        {
+                            t->waiting_ = false;
+                            expired.push(*t);
+                        }
+                        continue;
+                    }
+                    s.heap.remove(*t);
+
+                    if (t->waiting_)
+                    {
+                        t->waiting_ = false;
+                        expired.push(*t);
+                    }
+                    // If not waiting, timer is removed but not dispatched -
+                    // wait() will handle this by checking expiry
+                }
+                s.publish();
+            }
+            merged.publish(coalesced_);
+
+            // Resume outside lock
+            total += expired.resume(*sched_);
+        }
+        return total;
+    }
+
+private:
+    // Shard of the calling thread, assigned on first use
+    std::size_t this_thread_shard() const noexcept
+    {
+        static std::atomic<std::size_t> next_thread{0};
+        thread_local std::size_t const thread_index =
+            next_thread.fetch_add(1, std::memory_order_relaxed);
+        return thread_index % count_;
+    }
 };
 
 //------------------------------------------------------------------------------
 
-class timer_service_impl : public timer_service
+/*
+    Hierarchical Timing Wheel
+    -------------------------
+    Time is counted in ticks of opts.tick since the service was created,
+    and each expiry is rounded up to a tick. The wheel has four levels of
+    256 slots; level L holds timers due between 256^L and 256^(L+1) ticks
+    ahead, in the slot given by bits 8L..8L+7 of their tick, so arming or
+    cancelling a timer is a list insertion or removal. Timers due further
+    ahead than the top level reaches wait in its farthest slot.
+
+    Whenever the current tick crosses a multiple of 256^L, the level L
+    slot for the new block is cascaded: its timers are re-inserted and so
+    move down a level. Only level 0 slots expire; their timers, and those
+    armed already due, are moved to the due list, which process_expired()
+    drains in batches of opts.expiry_batch under the lock.
+
+    nearest_expiry() looks at a bitmap of occupied level 0 slots. When
+    upper levels hold timers it also reports the next cascade point,
+    which can be earlier than any expiry and then merely wakes the
+    reactor once to cascade.
+*/
+class timer_wheel_service : public timer_service_base
 {
 public:
     using clock_type = std::chrono::steady_clock;
     using time_point = clock_type::time_point;
-    using key_type = timer_service;
 
 private:
-    struct heap_entry
+    static constexpr int levels = 4;
+    static constexpr int slot_bits = 8;
+    static constexpr std::size_t slots = std::size_t(1) << slot_bits;
+    static constexpr std::uint64_t slot_mask = slots - 1;
+    static constexpr int due_level = levels;    // wheel_level_ of the due list
+
+    // Farthest tick the top level can hold, relative to now
+    static constexpr std::uint64_t max_span =
+        (std::uint64_t(1) << (slot_bits * levels)) - 1;
+
+    static constexpr std::uint64_t no_tick =
+        (std::numeric_limits<std::uint64_t>::max)();
+
+    struct slot_list
     {
-        time_point time_;
-        timer_impl* timer_;
+        timer_impl* head = nullptr;
     };
 
-    scheduler* sched_ = nullptr;
     mutable std::mutex mutex_;
-    std::vector<heap_entry> heap_;
+    clock_type::duration tick_;
+    std::size_t batch_;
+    time_point origin_;
+    std::uint64_t now_tick_ = 0;                // last tick processed
+    slot_list wheel_[levels][slots];
+    std::uint64_t occupied_[slots / 64] = {};   // level 0 slots in use
+    slot_list due_;
+    std::size_t size_ = 0;                      // timers in the wheel
+    std::size_t upper_size_ = 0;                // timers above level 0
     intrusive_list<timer_impl> timers_;
     intrusive_list<timer_impl> free_list_;
     callback on_earliest_changed_;
 
 public:
-    timer_service_impl(capy::execution_context&, scheduler& sched)
-        : timer_service()
-        , sched_(&sched)
-    {
-    }
-
-    scheduler& get_scheduler() noexcept { return *sched_; }
-
-    ~timer_service_impl()
+    timer_wheel_service(
+        capy::execution_context&,
+        scheduler& sched,
+        timer_options const& opts)
+        : timer_service_base(sched)
+        , tick_((std::max)(
+            std::chrono::duration_cast<clock_type::duration>(opts.tick),
+            clock_type::duration(std::chrono::microseconds(1))))
+        , batch_(opts.expiry_batch > 0 ? opts.expiry_batch : 1)
+        , origin_(clock_type::now())
     {
     }
 
-    timer_service_impl(timer_service_impl const&) = delete;
-    timer_service_impl& operator=(timer_service_impl const&) = delete;
+    timer_wheel_service(timer_wheel_service const&) = delete;
+    timer_wheel_service& operator=(timer_wheel_service const&) = delete;
 
     void set_on_earliest_changed(callback cb) override
     {
@@ -120,7 +1355,7 @@ public:
         if (auto* p = free_list_.pop_front())
         {
             impl = p;
-            impl->heap_index_ = (std::numeric_limits<std::size_t>::max)();
+            impl->slack_ = {};
         }
         else
         {
@@ -130,15 +1365,18 @@ public:
         return impl;
     }
 
-    void destroy_impl(timer_impl& impl)
+    void destroy_impl(timer_impl& impl) override
     {
         std::lock_guard lock(mutex_);
-        remove_timer_impl(impl);
+        unlink(impl);
+        impl.period_ = {};
+        impl.missed_out_ = nullptr;
         timers_.remove(&impl);
         free_list_.push_back(&impl);
     }
 
-    void update_timer(timer_impl& impl, time_point new_time)
+    void update_timer(
+        timer_impl& impl, time_point new_time, timer_impl::duration period) override
     {
         bool notify = false;
         bool was_waiting = false;
@@ -158,28 +1396,13 @@ public:
                 d = impl.d_;
                 ec_out = impl.ec_out_;
             }
+            impl.ticks_ = 0;
+            impl.period_ = period;
 
-            if (impl.heap_index_ < heap_.size())
-            {
-                // Already in heap, update position
-                time_point old_time = heap_[impl.heap_index_].time_;
-                heap_[impl.heap_index_].time_ = new_time;
-
-                if (new_time < old_time)
-                    up_heap(impl.heap_index_);
-                else
-                    down_heap(impl.heap_index_);
-            }
-            else
-            {
-                // Not in heap, add it
-                impl.heap_index_ = heap_.size();
-                heap_.push_back({new_time, &impl});
-                up_heap(heap_.size() - 1);
-            }
-
-            // Notify if this timer is now the earliest
-            notify = (impl.heap_index_ == 0);
+            std::uint64_t before = nearest_tick();
+            unlink(impl);
+            link(impl, tick_of(new_time));
+            notify = nearest_tick() < before;
         }
 
         // Resume cancelled waiter outside lock
@@ -187,7 +1410,8 @@ public:
         {
             if (ec_out)
                 *ec_out = make_error_code(capy::error::canceled);
-            resume_coro(d, h);
+            if (h)
+                resume_coro(d, h);
             // Call on_work_finished AFTER the coroutine resumes
             sched_->on_work_finished();
         }
@@ -196,13 +1420,7 @@ public:
             on_earliest_changed_();
     }
 
-    void remove_timer(timer_impl& impl)
-    {
-        std::lock_guard lock(mutex_);
-        remove_timer_impl(impl);
-    }
-
-    void cancel_timer(timer_impl& impl)
+    void cancel_timer(timer_impl& impl) override
     {
         std::coroutine_handle<> h;
         capy::executor_ref d;
@@ -211,7 +1429,8 @@ public:
 
         {
             std::lock_guard lock(mutex_);
-            remove_timer_impl(impl);
+            unlink(impl);
+            impl.ticks_ = 0;
             if (impl.waiting_)
             {
                 was_waiting = true;
@@ -227,132 +1446,302 @@ public:
         {
             if (ec_out)
                 *ec_out = make_error_code(capy::error::canceled);
-            resume_coro(d, h);
+            if (h)
+                resume_coro(d, h);
             // Call on_work_finished AFTER the coroutine resumes
             sched_->on_work_finished();
         }
     }
 
+    bool start_wait(timer_impl& impl) override
+    {
+        std::lock_guard lock(mutex_);
+        if (take_ticks(impl) || impl.wheel_level_ < 0)
+            return false;
+        impl.waiting_ = true;
+        sched_->on_work_started();
+        return true;
+    }
+
     bool empty() const noexcept override
     {
         std::lock_guard lock(mutex_);
-        return heap_.empty();
+        return size_ == 0;
     }
 
     time_point nearest_expiry() const noexcept override
     {
         std::lock_guard lock(mutex_);
-        return heap_.empty() ? time_point::max() : heap_[0].time_;
+        std::uint64_t t = nearest_tick();
+        return t == no_tick ? time_point::max() : time_of(t);
     }
 
-    std::size_t process_expired() override
+    void sample_waiters(
+        std::vector<parked_op>& out, time_point now) const override
     {
-        // Collect expired timers while holding lock
-        struct expired_entry
+        std::lock_guard lock(mutex_);
+        timers_.for_each([&](timer_impl const& t)
         {
-            std::coroutine_handle<> h;
-            capy::executor_ref d;
-            system::error_code* ec_out;
-        };
-        std::vector<expired_entry> expired;
+            add_waiter(out, t, now);
+        });
+    }
 
-        {
-            std::lock_guard lock(mutex_);
-            auto now = clock_type::now();
+    std::size_t process_expired() override
+    {
+        expired_list expired;
 
-            while (!heap_.empty() && heap_[0].time_ <= now)
+        auto const now = sample_now();
+        std::uint64_t const target = floor_tick_of(now);
+        std::size_t total = 0;
+        for (;;)
+        {
+            coalesce_counter merged;
+            bool more;
             {
-                timer_impl* t = heap_[0].timer_;
-                remove_timer_impl(*t);
+                std::lock_guard lock(mutex_);
 
-                if (t->waiting_)
+                // Taking non-waiting timers counts toward the batch too,
+                // so the lock is released regularly either way
+                std::size_t taken = 0;
+                while (taken < batch_ && advance(target))
                 {
-                    t->waiting_ = false;
-                    expired.push_back({t->h_, std::move(t->d_), t->ec_out_});
+                    timer_impl* t = due_.head;
+                    unlink(*t);
+                    merged.add(*t);
+                    ++taken;
+
+                    if (t->period_ != timer_impl::duration::zero())
+                    {
+                        // Due after `now`, so it moves into the wheel
+                        // rather than back onto the due list
+                        advance_period(*t, now);
+                        link(*t, tick_of(t->due_));
+                        if (t->waiting_ && take_ticks(*t))
+                        {
+                            t->waiting_ = false;
+                            expired.push(*t);
+                        }
+                        continue;
+                    }
+
+                    if (t->waiting_)
+                    {
+                        t->waiting_ = false;
+                        expired.push(*t);
+                    }
+                    // If not waiting, timer is removed but not dispatched -
+                    // wait() will handle this by checking expiry
                 }
-                // If not waiting, timer is removed but not dispatched -
-                // wait() will handle this by checking expiry
+                more = (taken == batch_);
             }
+            merged.publish(coalesced_);
+
+            // Resume outside lock
+            total += expired.resume(*sched_);
+
+            if (!more)
+                return total;
         }
+    }
 
-        // Dispatch outside lock
-        for (auto& e : expired)
+private:
+    std::uint64_t floor_tick_of(time_point t) const noexcept
+    {
+        if (t <= origin_)
+            return 0;
+        return static_cast<std::uint64_t>((t - origin_) / tick_);
+    }
+
+    // Expiries round up, so a timer never completes early
+    std::uint64_t tick_of(time_point t) const noexcept
+    {
+        if (t <= origin_)
+            return 0;
+        if (t == time_point::max())
+            return no_tick;
+        auto d = t - origin_;
+        auto n = static_cast<std::uint64_t>(d / tick_);
+        if (d % tick_ != clock_type::duration::zero())
+            ++n;
+        return n;
+    }
+
+    time_point time_of(std::uint64_t tick) const noexcept
+    {
+        auto limit = static_cast<std::uint64_t>(
+            (time_point::max() - origin_) / tick_);
+        if (tick >= limit)
+            return time_point::max();
+        return origin_ + tick_ * static_cast<clock_type::rep>(tick);
+    }
+
+    slot_list& list_of(timer_impl const& impl) noexcept
+    {
+        if (impl.wheel_level_ == due_level)
+            return due_;
+        return wheel_[impl.wheel_level_][impl.wheel_slot_];
+    }
+
+    void push(slot_list& list, timer_impl& impl) noexcept
+    {
+        impl.wheel_prev_ = nullptr;
+        impl.wheel_next_ = list.head;
+        if (list.head)
+            list.head->wheel_prev_ = &impl;
+        list.head = &impl;
+    }
+
+    void link(timer_impl& impl, std::uint64_t tick) noexcept
+    {
+        impl.wheel_tick_ = tick;
+        ++size_;
+
+        if (tick <= now_tick_)
         {
-            if (e.ec_out)
-                *e.ec_out = {};
-            resume_coro(e.d, e.h);
-            // Call on_work_finished AFTER the coroutine resumes, so it has a
-            // chance to add new work before we potentially trigger stop()
-            sched_->on_work_finished();
+            impl.wheel_level_ = due_level;
+            push(due_, impl);
+            return;
         }
 
-        return expired.size();
+        // Lowest level whose span covers the delay
+        std::uint64_t delta = (std::min)(tick - now_tick_, max_span);
+        int level = 0;
+        while (level < levels - 1 &&
+               delta >= (std::uint64_t(1) << (slot_bits * (level + 1))))
+            ++level;
+
+        std::uint64_t slot_tick = now_tick_ + delta;
+        impl.wheel_level_ = level;
+        impl.wheel_slot_ = static_cast<std::size_t>(
+            (slot_tick >> (slot_bits * level)) & slot_mask);
+        push(wheel_[level][impl.wheel_slot_], impl);
+
+        if (level == 0)
+            occupied_[impl.wheel_slot_ / 64] |=
+                std::uint64_t(1) << (impl.wheel_slot_ % 64);
+        else
+            ++upper_size_;
     }
 
-private:
-    void remove_timer_impl(timer_impl& impl)
+    void unlink(timer_impl& impl) noexcept
     {
-        std::size_t index = impl.heap_index_;
-        if (index >= heap_.size())
-            return; // Not in heap
+        if (impl.wheel_level_ < 0)
+            return;
 
-        if (index == heap_.size() - 1)
+        slot_list& list = list_of(impl);
+        if (impl.wheel_prev_)
+            impl.wheel_prev_->wheel_next_ = impl.wheel_next_;
+        else
+            list.head = impl.wheel_next_;
+        if (impl.wheel_next_)
+            impl.wheel_next_->wheel_prev_ = impl.wheel_prev_;
+
+        if (impl.wheel_level_ == 0)
         {
-            // Last element, just pop
-            impl.heap_index_ = (std::numeric_limits<std::size_t>::max)();
-            heap_.pop_back();
+            if (!list.head)
+                occupied_[impl.wheel_slot_ / 64] &=
+                    ~(std::uint64_t(1) << (impl.wheel_slot_ % 64));
         }
-        else
+        else if (impl.wheel_level_ != due_level)
         {
-            // Swap with last and reheapify
-            swap_heap(index, heap_.size() - 1);
-            impl.heap_index_ = (std::numeric_limits<std::size_t>::max)();
-            heap_.pop_back();
-
-            if (index > 0 && heap_[index].time_ < heap_[(index - 1) / 2].time_)
-                up_heap(index);
-            else
-                down_heap(index);
+            --upper_size_;
         }
+
+        impl.wheel_prev_ = nullptr;
+        impl.wheel_next_ = nullptr;
+        impl.wheel_level_ = -1;
+        --size_;
     }
 
-    void up_heap(std::size_t index)
+    // Ticks from now_tick_ to the next occupied level 0 slot, 1..256,
+    // or 0 if level 0 is empty
+    std::uint64_t next_level0_distance() const noexcept
     {
-        while (index > 0)
+        std::size_t start = static_cast<std::size_t>((now_tick_ + 1) & slot_mask);
+        for (std::size_t n = 0; n < slots;)
         {
-            std::size_t parent = (index - 1) / 2;
-            if (!(heap_[index].time_ < heap_[parent].time_))
-                break;
-            swap_heap(index, parent);
-            index = parent;
+            // Scan the rest of the word holding slot start + n
+            std::size_t pos = (start + n) & slot_mask;
+            std::size_t bit = pos % 64;
+            std::uint64_t bits = occupied_[pos / 64] >> bit;
+            if (bits)
+            {
+                std::size_t d = n + static_cast<std::size_t>(std::countr_zero(bits));
+                if (d < slots)
+                    return d + 1;
+            }
+            n += 64 - bit;
         }
+        return 0;
     }
 
-    void down_heap(std::size_t index)
+    std::uint64_t nearest_tick() const noexcept
     {
-        std::size_t child = index * 2 + 1;
-        while (child < heap_.size())
-        {
-            std::size_t min_child = (child + 1 == heap_.size() ||
-                heap_[child].time_ < heap_[child + 1].time_)
-                ? child : child + 1;
-
-            if (heap_[index].time_ < heap_[min_child].time_)
-                break;
+        if (due_.head)
+            return now_tick_;
+        if (size_ == 0)
+            return no_tick;
+
+        std::uint64_t best = no_tick;
+        if (std::uint64_t d = next_level0_distance())
+            best = now_tick_ + d;
+        if (upper_size_ > 0)
+            best = (std::min)(best, (now_tick_ | slot_mask) + 1);
+        return best;
+    }
 
-            swap_heap(index, min_child);
-            index = min_child;
-            child = index * 2 + 1;
+    // Re-insert the timers of the level's slot for the current block
+    void cascade(int level) noexcept
+    {
+        std::size_t slot = static_cast<std::size_t>(
+            (now_tick_ >> (slot_bits * level)) & slot_mask);
+        timer_impl* t = wheel_[level][slot].head;
+        while (t)
+        {
+            timer_impl* next = t->wheel_next_;
+            std::uint64_t tick = t->wheel_tick_;
+            unlink(*t);
+            link(*t, tick);
+            t = next;
         }
+
+        if (slot == 0 && level + 1 < levels)
+            cascade(level + 1);
     }
 
-    void swap_heap(std::size_t i1, std::size_t i2)
+    // Move time forward until a timer is due or target is reached.
+    // Returns true if due_ holds a timer.
+    bool advance(std::uint64_t target) noexcept
     {
-        heap_entry tmp = heap_[i1];
-        heap_[i1] = heap_[i2];
-        heap_[i2] = tmp;
-        heap_[i1].timer_->heap_index_ = i1;
-        heap_[i2].timer_->heap_index_ = i2;
+        while (!due_.head && now_tick_ < target)
+        {
+            if (size_ == 0)
+            {
+                now_tick_ = target;
+                break;
+            }
+
+            // Skip ticks that expire and cascade nothing
+            std::uint64_t next = target;
+            if (std::uint64_t d = next_level0_distance())
+                next = (std::min)(next, now_tick_ + d);
+            if (upper_size_ > 0)
+                next = (std::min)(next, (now_tick_ | slot_mask) + 1);
+            now_tick_ = next;
+
+            if ((now_tick_ & slot_mask) == 0)
+                cascade(1);
+
+            // Level 0 timers of this tick are due
+            std::size_t slot = static_cast<std::size_t>(now_tick_ & slot_mask);
+            while (timer_impl* t = wheel_[0][slot].head)
+            {
+                std::uint64_t tick = t->wheel_tick_;
+                unlink(*t);
+                link(*t, tick);
+            }
+        }
+        return due_.head != nullptr;
     }
 };
 
@@ -362,6 +1751,7 @@ void
 timer_impl::
 release()
 {
+    fire_ = nullptr;
     svc_->destroy_impl(*this);
 }
 
@@ -373,25 +1763,25 @@ wait(
     std::stop_token token,
     system::error_code* ec)
 {
-    // Check if timer already expired (not in heap anymore)
-    bool already_expired = (heap_index_ == (std::numeric_limits<std::size_t>::max)());
-
-    if (already_expired)
-    {
-        // Timer already expired - dispatch immediately
-        if (ec)
-            *ec = {};
-        // Note: no work tracking needed - we dispatch synchronously
-        resume_coro(d, h);
-        return;
-    }
-
+    // The service reads the wait state only once waiting_ is set
+    // under its lock, so it can be stored first
     h_ = h;
-    d_ = std::move(d);
+    d_ = d;
     token_ = std::move(token);
     ec_out_ = ec;
-    waiting_ = true;
-    svc_->get_scheduler().on_work_started();
+    if (h)
+        waited_at_ = svc_->now();
+    if (svc_->start_wait(*this))
+        return;
+
+    // Timer already expired - dispatch immediately
+    if (ec)
+        *ec = {};
+    // Note: no work tracking needed - we dispatch synchronously
+    if (h)
+        resume_coro(d, h);
+    else
+        fire_(fire_arg_);
 }
 
 //------------------------------------------------------------------------------
@@ -431,15 +1821,17 @@ timer_service_expires_at(timer::timer_impl& base, timer::time_point t)
 {
     auto& impl = static_cast<timer_impl&>(base);
     impl.expiry_ = t;
-    impl.svc_->update_timer(impl, t);
+    impl.due_ = round_to_slack(t, impl.slack_);
+    impl.svc_->update_timer(impl, impl.due_, impl.period_);
 }
 
 void
 timer_service_expires_after(timer::timer_impl& base, timer::duration d)
 {
     auto& impl = static_cast<timer_impl&>(base);
-    impl.expiry_ = timer::clock_type::now() + d;
-    impl.svc_->update_timer(impl, impl.expiry_);
+    impl.expiry_ = impl.svc_->now() + d;
+    impl.due_ = round_to_slack(impl.expiry_, impl.slack_);
+    impl.svc_->update_timer(impl, impl.due_, impl.period_);
 }
 
 void
@@ -449,10 +1841,149 @@ timer_service_cancel(timer::timer_impl& base) noexcept
     impl.svc_->cancel_timer(impl);
 }
 
+timer::duration
+timer_service_slack(timer::timer_impl& base) noexcept
+{
+    return static_cast<timer_impl&>(base).slack_;
+}
+
+void
+timer_service_set_slack(timer::timer_impl& base, timer::duration s) noexcept
+{
+    static_cast<timer_impl&>(base).slack_ = s;
+}
+
+void
+timer_service_arm_callback(
+    timer::timer_impl& base,
+    timer::time_point t,
+    void (*fn)(void*) noexcept,
+    void* arg)
+{
+    auto& impl = static_cast<timer_impl&>(base);
+    impl.fire_ = fn;
+    impl.fire_arg_ = arg;
+    timer_service_expires_at(base, t);
+    impl.wait({}, {}, {}, nullptr);
+}
+
+void
+timer_service_start_periodic(
+    timer::timer_impl& base,
+    timer::time_point first,
+    timer::duration period)
+{
+    auto& impl = static_cast<timer_impl&>(base);
+    impl.expiry_ = first;
+    impl.due_ = round_to_slack(first, impl.slack_);
+    impl.svc_->update_timer(impl, impl.due_, period);
+}
+
+void
+timer_service_start_periodic_after(
+    timer::timer_impl& base,
+    timer::duration period)
+{
+    auto& impl = static_cast<timer_impl&>(base);
+    timer_service_start_periodic(base, impl.svc_->now() + period, period);
+}
+
+timer::duration
+timer_service_period(timer::timer_impl& base) noexcept
+{
+    return static_cast<timer_impl&>(base).period_;
+}
+
+void
+timer_service_wait_periodic(
+    timer::timer_impl& base,
+    std::coroutine_handle<> h,
+    capy::executor_ref d,
+    std::stop_token token,
+    system::error_code* ec,
+    std::uint64_t* missed)
+{
+    auto& impl = static_cast<timer_impl&>(base);
+    impl.missed_out_ = missed;
+    impl.wait(h, d, std::move(token), ec);
+}
+
+void
+timer_service_disarm(timer::timer_impl& base) noexcept
+{
+    auto& impl = static_cast<timer_impl&>(base);
+    impl.svc_->cancel_timer(impl);
+
+    // An expiry taken before the cancel may still be running its
+    // callback on another thread; wait for it, as ~stop_callback does.
+    // firing_ was set under the lock cancel_timer just released.
+    if (this_thread_firing != &impl)
+        while (impl.firing_.load(std::memory_order_acquire))
+            std::this_thread::yield();
+}
+
+void
+timer_service::
+use_cached_time(bool coarse) noexcept
+{
+    cached_time_ = true;
+    coarse_clock_ = coarse;
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec res;
+    if (coarse && ::clock_getres(CLOCK_MONOTONIC_COARSE, &res) == 0)
+        coarse_tick_ = std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::seconds(res.tv_sec) +
+            std::chrono::nanoseconds(res.tv_nsec));
+#endif
+    sample_now();
+}
+
+timer_service::time_point
+timer_service::
+sample_now() noexcept
+{
+    if (!cached_time_)
+        return clock_type::now();
+    if (virtual_time_)
+        return now();
+
+    time_point t;
+#ifdef CLOCK_MONOTONIC_COARSE
+    // The same clock steady_clock reads, at tick resolution, from the
+    // vDSO without a hardware counter read
+    timespec ts;
+    if (coarse_clock_ && ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+        t = time_point(std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::seconds(ts.tv_sec) +
+            std::chrono::nanoseconds(ts.tv_nsec)));
+    else
+#endif
+        t = clock_type::now();
+    now_.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+    return t;
+}
+
 timer_service&
-get_timer_service(capy::execution_context& ctx, scheduler& sched)
+get_timer_service(
+    capy::execution_context& ctx,
+    scheduler& sched,
+    timer_options const& opts)
 {
-    return ctx.make_service<timer_service_impl>(sched);
+    if (auto* svc = ctx.find_service<timer_service>())
+        return *svc;
+    if (opts.virtual_time)
+        return ctx.make_service<virtual_timer_service>(
+            sched, opts.auto_advance);
+    timer_service* svc;
+    if (opts.queue == timer_queue::wheel)
+        svc = &ctx.make_service<timer_wheel_service>(sched, opts);
+    else if (opts.queue == timer_queue::sharded)
+        svc = &ctx.make_service<timer_shard_service>(sched, opts);
+    else
+        svc = &ctx.make_service<timer_service_impl>(sched);
+    if (opts.cached_time)
+        svc->use_cached_time(opts.coarse_clock);
+    return *svc;
 }
 
 } // namespace boost::corosio::detail
@@ -13,8 +13,15 @@
 #include <boost/corosio/timer.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost::corosio {
+struct parked_op;
+} // namespace boost::corosio
 
 namespace boost::corosio::detail {
 
@@ -48,20 +55,92 @@ public:
     virtual bool empty() const noexcept = 0;
     virtual time_point nearest_expiry() const noexcept = 0;
 
+    // Append the timers a coroutine waits on, aged from `now`
+    virtual void sample_waiters(
+        std::vector<parked_op>& out, time_point now) const = 0;
+
     // Process expired timers - scheduler calls this after wait
     virtual std::size_t process_expired() = 0;
 
     // Callback for when earliest timer changes
     virtual void set_on_earliest_changed(callback cb) = 0;
 
+    // Timers that expired on the same wakeup as an earlier-expiring
+    // timer only because their slack rounded them together
+    std::uint64_t coalesced_wakeups() const noexcept
+    {
+        return coalesced_.load(std::memory_order_relaxed);
+    }
+
+    // The time timer arithmetic uses. With timer_options::cached_time
+    // it is the sample taken by the last process_expired() call, so it
+    // stands still while handlers run; otherwise it reads the clock.
+    time_point now() const noexcept
+    {
+        if (!cached_time_)
+            return clock_type::now();
+        return time_point(clock_type::duration(
+            now_.load(std::memory_order_relaxed)));
+    }
+
+    // When a reactor should wake for the nearest expiry. With
+    // timer_options::coarse_clock this is one coarse tick after it,
+    // when the sampled clock is sure to have reached it; waking at
+    // the expiry itself would find nothing due and wake again at
+    // once until the tick.
+    time_point nearest_wakeup() const noexcept
+    {
+        auto const t = nearest_expiry();
+        if (t > time_point::max() - coarse_tick_)
+            return time_point::max();
+        return t + coarse_tick_;
+    }
+
+    // Called by get_timer_service() before the scheduler runs
+    void use_cached_time(bool coarse) noexcept;
+
+    // Move the virtual clock forward to `t`, expiring the timers due
+    // by then. Returns false if the service runs on the real clock,
+    // see timer_options::virtual_time
+    virtual bool advance_to(time_point) { return false; }
+
 protected:
     timer_service() = default;
+
+    // Read the clock, refreshing the cached time if kept. Called once
+    // per process_expired()
+    time_point sample_now() noexcept;
+
+    // Stop reading the clock: the cached time starts at the current
+    // time and changes only through set_now()
+    void use_virtual_time() noexcept
+    {
+        use_cached_time(false);
+        virtual_time_ = true;
+    }
+
+    void set_now(time_point t) noexcept
+    {
+        now_.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> coalesced_{0};
+
+private:
+    bool cached_time_ = false;
+    bool coarse_clock_ = false;
+    bool virtual_time_ = false;
+    clock_type::duration coarse_tick_{0};
+    std::atomic<clock_type::rep> now_{0};
 };
 
-// Get or create the timer service for the given context
+// Get or create the timer service for the given context. The options
+// choose the implementation when the service is created.
 timer_service&
 get_timer_service(
-    capy::execution_context& ctx, scheduler& sched);
+    capy::execution_context& ctx,
+    scheduler& sched,
+    timer_options const& opts = {});
 
 } // namespace boost::corosio::detail
 
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef BOOST_COROSIO_DETAIL_TUNING_HPP
+#define BOOST_COROSIO_DETAIL_TUNING_HPP
+
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/socket.hpp>
+
+#include "src/detail/make_err.hpp"
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/windows.hpp"
+#else
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+/*
+    Tuning Options
+    ==============
+
+    These options are plain integers the kernel keeps for the socket,
+    with no state in the backends, so they are read and written
+    through the native handle. Each is available only where its
+    option name is defined; elsewhere it reports
+    operation_not_supported.
+*/
+
+namespace boost::corosio::detail {
+
+enum class tuning_option
+{
+    not_sent_low_watermark,
+    quick_ack,
+    user_timeout,
+    incoming_cpu,
+    priority,
+    busy_poll,
+    max_pacing_rate
+};
+
+#if !BOOST_COROSIO_HAS_IOCP
+
+/** Find the level and name of a tuning option.
+
+    @return `false` if this platform lacks the option.
+*/
+inline
+bool
+find_tuning_option(tuning_option opt, int& level, int& name) noexcept
+{
+    switch (opt)
+    {
+#ifdef TCP_NOTSENT_LOWAT
+    case tuning_option::not_sent_low_watermark:
+        level = IPPROTO_TCP;
+        name = TCP_NOTSENT_LOWAT;
+        return true;
+#endif
+#ifdef TCP_QUICKACK
+    case tuning_option::quick_ack:
+        level = IPPROTO_TCP;
+        name = TCP_QUICKACK;
+        return true;
+#endif
+#ifdef TCP_USER_TIMEOUT
+    case tuning_option::user_timeout:
+        level = IPPROTO_TCP;
+        name = TCP_USER_TIMEOUT;
+        return true;
+#endif
+#ifdef SO_INCOMING_CPU
+    case tuning_option::incoming_cpu:
+        level = SOL_SOCKET;
+        name = SO_INCOMING_CPU;
+        return true;
+#endif
+#ifdef SO_PRIORITY
+    case tuning_option::priority:
+        level = SOL_SOCKET;
+        name = SO_PRIORITY;
+        return true;
+#endif
+#ifdef SO_BUSY_POLL
+    case tuning_option::busy_poll:
+        level = SOL_SOCKET;
+        name = SO_BUSY_POLL;
+        return true;
+#endif
+#ifdef SO_MAX_PACING_RATE
+    case tuning_option::max_pacing_rate:
+        level = SOL_SOCKET;
+        name = SO_MAX_PACING_RATE;
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+#endif
+
+/** Set a tuning option of a socket.
+
+    @return The error, if any.
+*/
+inline
+system::error_code
+set_tuning_option(
+    native_handle_type fd,
+    tuning_option opt,
+    int value) noexcept
+{
+#if BOOST_COROSIO_HAS_IOCP
+    (void)fd;
+    (void)opt;
+    (void)value;
+    return make_err(WSAEOPNOTSUPP);
+#else
+    int level = 0;
+    int name = 0;
+    if (!find_tuning_option(opt, level, name))
+        return make_err(EOPNOTSUPP);
+    if (::setsockopt(fd, level, name, &value, sizeof(value)) != 0)
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    return {};
+#endif
+}
+
+/** Get a tuning option of a socket.
+
+    @return The error, if any.
+*/
+inline
+system::error_code
+get_tuning_option(
+    native_handle_type fd,
+    tuning_option opt,
+    int& value) noexcept
+{
+#if BOOST_COROSIO_HAS_IOCP
+    (void)fd;
+    (void)opt;
+    (void)value;
+    return make_err(WSAEOPNOTSUPP);
+#else
+    int level = 0;
+    int name = 0;
+    if (!find_tuning_option(opt, level, name))
+        return make_err(EOPNOTSUPP);
+    socklen_t len = sizeof(value);
+    if (::getsockopt(fd, level, name, &value, &len) != 0)
+        return make_err(errno == ENOPROTOOPT ? EOPNOTSUPP : errno);
+    return {};
+#endif
+}
+
+} // namespace boost::corosio::detail
+
+#endif // BOOST_COROSIO_DETAIL_TUNING_HPP
@@ -0,0 +1,590 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include "src/detail/dns_resolver.hpp"
+#include "src/detail/dns_message.hpp"
+#include "src/detail/resume_coro.hpp"
+
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/udp_socket.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+    Native DNS Resolver
+    ===================
+
+    A stub resolver on the reactor: the A and AAAA questions of a
+    name go out together on one UDP socket, and the answers are read
+    with a deadline from the socket's timer node, so a resolve holds
+    no thread. Each round asks one server per question still open and
+    waits `timeout` from resolv.conf; an answer that does not fit is
+    asked again over TCP. After `attempts` rounds over every server,
+    the addresses received so far are the result.
+
+    Only what DNS alone answers is asked. Numeric hosts complete at
+    once. Everything NSS may know better goes to the system resolver,
+    the fallback: single-label names, localhost and `.local`, service
+    names, and flags that change the query, as do names DNS reports
+    as nonexistent or without addresses, which /etc/hosts may hold.
+    The same happens when no IPv4 server is configured, since
+    udp_socket speaks IPv4 only, or when the context has no datagram
+    support.
+
+    The state of one resolve is shared with its coroutine, which runs
+    with the token of the state's stop_source. A stop request from
+    the caller, or resolver::cancel, stops it; the outstanding
+    receive or TCP operation then fails with operation_canceled.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+endpoint
+with_port(endpoint ep, std::uint16_t port) noexcept
+{
+    if (ep.is_v6())
+        return endpoint(ep.v6_address(), port);
+    return endpoint(ep.v4_address(), port);
+}
+
+std::uint16_t
+random_id()
+{
+    thread_local std::mt19937 gen{std::random_device{}()};
+    return static_cast<std::uint16_t>(gen());
+}
+
+// Parses a port number; an empty service is port 0
+bool
+parse_port(std::string_view s, std::uint16_t& port) noexcept
+{
+    unsigned v = 0;
+    for (char c : s)
+    {
+        if (c < '0' || c > '9')
+            return false;
+        v = v * 10 + static_cast<unsigned>(c - '0');
+        if (v > 65535)
+            return false;
+    }
+    port = static_cast<std::uint16_t>(v);
+    return true;
+}
+
+bool
+ends_with_label(std::string_view name, std::string_view label) noexcept
+{
+    if (name.size() < label.size())
+        return false;
+    auto tail = name.substr(name.size() - label.size());
+    for (std::size_t i = 0; i < label.size(); ++i)
+        if (dns_detail::lower(static_cast<unsigned char>(tail[i])) !=
+            static_cast<unsigned char>(label[i]))
+            return false;
+    return name.size() == label.size() ||
+        name[name.size() - label.size() - 1] == '.';
+}
+
+// Names that the system resolver, not DNS, should answer
+bool
+is_local_name(std::string_view name) noexcept
+{
+    name = dns_strip_root(name);
+    return name.find('.') == std::string_view::npos ||
+        ends_with_label(name, "localhost") ||
+        ends_with_label(name, "local");
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+struct dns_query
+    : std::enable_shared_from_this<dns_query>
+{
+    struct canceller
+    {
+        dns_query* self;
+        void operator()() const noexcept { self->source_.request_stop(); }
+    };
+
+    // One of the two questions of a resolve
+    struct question
+    {
+        dns_type type;
+        std::uint16_t id = 0;
+        std::size_t size = 0;
+        bool done = false;
+        dns_answer answer;
+        unsigned char buf[dns_max_query];
+    };
+
+    // How the queries ended
+    enum class outcome
+    {
+        answered,
+        fallback,
+        failed
+    };
+
+    capy::execution_context& ctx_;
+    std::shared_ptr<resolv_conf const> conf_;
+    resolver::resolver_impl& fallback_;
+    std::string host_;
+    std::string service_;
+    std::uint16_t port_;
+    resolve_flags flags_;
+    std::size_t first_server_;
+    capy::executor_ref ex_;
+    std::coroutine_handle<> h_;
+    system::error_code* ec_out_;
+    resolver_results* out_;
+
+    std::stop_source source_;
+    std::optional<std::stop_callback<canceller>> stop_cb_;
+    system::error_code ec_;
+    std::pmr::vector<resolver_entry> entries_;  // from the resolver's resource
+
+    dns_query(
+        capy::execution_context& ctx,
+        std::shared_ptr<resolv_conf const> conf,
+        resolver::resolver_impl& fallback,
+        std::string_view host,
+        std::string_view service,
+        std::uint16_t port,
+        resolve_flags flags,
+        std::size_t first_server,
+        capy::executor_ref ex,
+        std::coroutine_handle<> h,
+        system::error_code* ec,
+        resolver_results* out,
+        std::pmr::memory_resource* mr)
+        : ctx_(ctx)
+        , conf_(std::move(conf))
+        , fallback_(fallback)
+        , host_(host)
+        , service_(service)
+        , port_(port)
+        , flags_(flags)
+        , first_server_(first_server)
+        , ex_(ex)
+        , h_(h)
+        , ec_out_(ec)
+        , out_(out)
+        , entries_(mr)
+    {
+    }
+
+    bool stopped() const noexcept
+    {
+        return source_.stop_requested();
+    }
+
+    void complete(system::error_code ec, resolver_results results)
+    {
+        *ec_out_ = ec;
+        if (!ec)
+            *out_ = std::move(results);
+        // The stop callback may no longer run after this
+        stop_cb_.reset();
+        resume_coro(ex_, h_);
+    }
+};
+
+namespace {
+
+// Hands a resolve to the system implementation from the coroutine
+struct fallback_awaitable
+{
+    dns_query& q_;
+    system::error_code ec_;
+    resolver_results results_;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<resolver_results> await_resume() noexcept
+    {
+        return {ec_, std::move(results_)};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        q_.fallback_.resolve(h, ex, q_.host_, q_.service_,
+            q_.flags_, std::move(token), &ec_, &results_);
+        return std::noop_coroutine();
+    }
+};
+
+capy::task<system::error_code>
+read_full(
+    socket& s,
+    unsigned char* p,
+    std::size_t n,
+    clock_type::time_point deadline)
+{
+    std::size_t got = 0;
+    while (got < n)
+    {
+        auto [ec, k] = co_await s.read_some(
+            capy::mutable_buffer(p + got, n - got), deadline);
+        if (ec)
+            co_return ec;
+        got += k;
+    }
+    co_return system::error_code{};
+}
+
+// Asks a question whose UDP answer was truncated again over TCP,
+// with RFC 1035 section 4.2.2 framing
+capy::task<bool>
+ask_tcp(
+    dns_query& q,
+    dns_query::question& qu,
+    endpoint server,
+    clock_type::time_point deadline)
+{
+    socket s(q.ctx_);
+    try
+    {
+        s.open(server.is_v6() ? ip_family::v6 : ip_family::v4);
+    }
+    catch (system::system_error const&)
+    {
+        co_return false;
+    }
+
+    auto [cec] = co_await s.connect(server, deadline);
+    if (cec)
+        co_return false;
+
+    std::vector<unsigned char> msg(2 + qu.size);
+    dns_detail::put16(msg.data(), static_cast<std::uint16_t>(qu.size));
+    std::copy(qu.buf, qu.buf + qu.size, msg.data() + 2);
+    std::size_t sent = 0;
+    while (sent < msg.size())
+    {
+        auto [wec, n] = co_await s.write_some(
+            capy::const_buffer(msg.data() + sent, msg.size() - sent),
+            deadline);
+        if (wec)
+            co_return false;
+        sent += n;
+    }
+
+    unsigned char len[2];
+    if (co_await read_full(s, len, 2, deadline))
+        co_return false;
+    msg.resize(dns_detail::get16(len));
+    if (co_await read_full(s, msg.data(), msg.size(), deadline))
+        co_return false;
+
+    dns_answer a;
+    if (!dns_parse_answer(msg.data(), msg.size(),
+            qu.id, q.host_, qu.type, a) || a.truncated)
+        co_return false;
+    qu.answer = std::move(a);
+    qu.done = true;
+    co_return true;
+}
+
+capy::task<dns_query::outcome>
+ask_servers(dns_query& q)
+{
+    using outcome = dns_query::outcome;
+
+    std::vector<endpoint> servers;
+    for (auto const& ep : q.conf_->servers)
+        if (ep.is_v4())
+            servers.push_back(ep);
+    if (servers.empty())
+        co_return outcome::fallback;
+
+    udp_socket sock(q.ctx_);
+    try
+    {
+        sock.open();
+    }
+    catch (std::exception const&)
+    {
+        // No datagram support, or no socket to be had
+        co_return outcome::fallback;
+    }
+
+    // AAAA first, so that its addresses lead the results as with
+    // getaddrinfo on a host with IPv6
+    std::array<dns_query::question, 2> qs{{
+        {dns_type::aaaa}, {dns_type::a}}};
+    for (auto& qu : qs)
+    {
+        qu.id = random_id();
+        qu.size = dns_encode_query(qu.id, q.host_, qu.type, qu.buf);
+        if (qu.size == 0)
+            co_return outcome::fallback;
+    }
+    if (qs[0].id == qs[1].id)
+    {
+        ++qs[1].id;
+        dns_detail::put16(qs[1].buf, qs[1].id);
+    }
+
+    auto all_done = [&]
+    {
+        return qs[0].done && qs[1].done;
+    };
+
+    std::array<unsigned char, dns_udp_size> buf;
+    bool timed_out = false;
+    bool server_failed = false;
+    system::error_code last_ec;
+    for (int attempt = 0;
+        attempt < q.conf_->attempts && !all_done(); ++attempt)
+    {
+        for (std::size_t k = 0; k < servers.size() && !all_done(); ++k)
+        {
+            endpoint const server =
+                servers[(q.first_server_ + k) % servers.size()];
+            for (auto& qu : qs)
+            {
+                if (qu.done)
+                    continue;
+                auto [ec, n] = co_await sock.send_to(
+                    capy::const_buffer(qu.buf, qu.size), server);
+                if (q.stopped())
+                    co_return outcome::failed;
+                if (ec)
+                    last_ec = ec;
+            }
+
+            auto const deadline = clock_type::now() + q.conf_->timeout;
+            while (!all_done())
+            {
+                endpoint from;
+                auto [ec, n] = co_await sock.receive_from(
+                    capy::mutable_buffer(buf.data(), buf.size()),
+                    from, deadline);
+                if (q.stopped())
+                    co_return outcome::failed;
+                if (ec == system::errc::timed_out)
+                {
+                    timed_out = true;
+                    break;
+                }
+                if (ec && ec != system::errc::message_size)
+                {
+                    // Such as connection_refused from an ICMP error
+                    last_ec = ec;
+                    break;
+                }
+                if (from != server)
+                    continue;
+
+                for (auto& qu : qs)
+                {
+                    dns_answer a;
+                    if (qu.done || !dns_parse_answer(
+                            buf.data(), n, qu.id, q.host_, qu.type, a))
+                        continue;
+                    if (!a.truncated)
+                    {
+                        qu.answer = std::move(a);
+                        qu.done = true;
+                    }
+                    else
+                    {
+                        co_await ask_tcp(q, qu, server, deadline);
+                        if (q.stopped())
+                            co_return outcome::failed;
+                    }
+                    break;
+                }
+            }
+
+            // A server that could not answer: ask the next one
+            for (auto& qu : qs)
+            {
+                if (qu.done &&
+                    qu.answer.rcode != dns_rcode_noerror &&
+                    qu.answer.rcode != dns_rcode_nxdomain)
+                {
+                    qu.done = false;
+                    server_failed = true;
+                }
+            }
+        }
+    }
+
+    for (auto& qu : qs)
+    {
+        if (!qu.done)
+            continue;
+        for (auto const& ep : qu.answer.addresses)
+            q.entries_.emplace_back(
+                with_port(ep, q.port_), q.host_, q.service_);
+    }
+    if (!q.entries_.empty())
+        co_return outcome::answered;
+
+    // Nonexistent, or without addresses, for DNS
+    if (all_done())
+        co_return outcome::fallback;
+
+    if (server_failed)
+        q.ec_ = make_error_code(system::errc::resource_unavailable_try_again);
+    else if (timed_out || !last_ec)
+        q.ec_ = make_error_code(system::errc::timed_out);
+    else
+        q.ec_ = last_ec;
+    co_return outcome::failed;
+}
+
+capy::task<>
+run_query(std::shared_ptr<dns_query> q)
+{
+    auto const result = co_await ask_servers(*q);
+    if (q->stopped())
+    {
+        q->complete(make_error_code(system::errc::operation_canceled), {});
+        co_return;
+    }
+
+    switch (result)
+    {
+    case dns_query::outcome::answered:
+        q->complete({}, resolver_results(std::move(q->entries_)));
+        break;
+
+    case dns_query::outcome::fallback:
+    {
+        auto [ec, results] = co_await fallback_awaitable{*q, {}, {}};
+        q->complete(ec, std::move(results));
+        break;
+    }
+
+    case dns_query::outcome::failed:
+        q->complete(q->ec_, {});
+        break;
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+dns_resolver::
+dns_resolver(capy::execution_context& ctx)
+    : ctx_(ctx)
+    , conf_(std::make_shared<resolv_conf const>(load_resolv_conf()))
+{
+}
+
+bool
+dns_resolver::
+resolve(
+    resolver::resolver_impl& fallback,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags,
+    std::stop_token token,
+    system::error_code* ec,
+    resolver_results* out,
+    std::pmr::memory_resource* mr)
+{
+    std::uint16_t port = 0;
+    bool const numeric_port = parse_port(service, port);
+
+    if (numeric_port)
+    {
+        std::optional<endpoint> ep;
+        if (auto r = urls::parse_ipv4_address(host))
+            ep.emplace(*r, port);
+        else if (auto r6 = urls::parse_ipv6_address(host))
+            ep.emplace(*r6, port);
+        if (ep)
+        {
+            *ec = {};
+            std::pmr::vector<resolver_entry> entries(mr);
+            entries.emplace_back(*ep, host, service);
+            *out = resolver_results(std::move(entries));
+            return true;
+        }
+    }
+
+    if ((flags & resolve_flags::numeric_host) != resolve_flags::none)
+    {
+        *ec = make_error_code(system::errc::no_such_device_or_address);
+        return true;
+    }
+
+    auto const system_only =
+        resolve_flags::passive |
+        resolve_flags::v4_mapped |
+        resolve_flags::all_matching;
+    if (!numeric_port || host.empty() || is_local_name(host) ||
+        (flags & system_only) != resolve_flags::none)
+    {
+        fallback.resolve(h, ex, host, service, flags, token, ec, out);
+        return false;
+    }
+
+    std::size_t first = 0;
+    if (conf_->rotate)
+        first = next_server_.fetch_add(1, std::memory_order_relaxed);
+
+    auto q = std::make_shared<dns_query>(ctx_, conf_, fallback,
+        host, service, port, flags, first, ex, h, ec, out, mr);
+    {
+        std::lock_guard lock(mutex_);
+        current_ = q;
+    }
+
+    // Runs at once if a stop was already requested
+    q->stop_cb_.emplace(token, dns_query::canceller{q.get()});
+    capy::run_async(ex, q->source_.get_token())(run_query(q));
+    return false;
+}
+
+void
+dns_resolver::
+cancel() noexcept
+{
+    std::shared_ptr<dns_query> q;
+    {
+        std::lock_guard lock(mutex_);
+        q = current_.lock();
+    }
+    if (q)
+        q->source_.request_stop();
+}
+
+} // namespace boost::corosio::detail
@@ -12,8 +12,6 @@
 #if BOOST_COROSIO_HAS_EPOLL
 
 #include "src/detail/epoll/scheduler.hpp"
-#include "src/detail/epoll/sockets.hpp"
-#include "src/detail/epoll/acceptors.hpp"
 
 #include <thread>
 
@@ -28,15 +26,19 @@ epoll_context()
 epoll_context::
 epoll_context(
     unsigned concurrency_hint)
+    : epoll_context(concurrency_hint, epoll_options{})
 {
-    sched_ = &make_service<detail::epoll_scheduler>(
-        static_cast<int>(concurrency_hint));
+}
 
-    // Install socket/acceptor services.
-    // These use socket_service and acceptor_service as key_type,
-    // enabling runtime polymorphism.
-    make_service<detail::epoll_socket_service>();
-    make_service<detail::epoll_acceptor_service>();
+epoll_context::
+epoll_context(
+    unsigned concurrency_hint,
+    epoll_options const& opts)
+{
+    // The socket, acceptor and UDP services are made on first use,
+    // see "Deferred Services" in epoll/scheduler.cpp
+    sched_ = &make_service<detail::epoll_scheduler>(
+        static_cast<int>(concurrency_hint), opts);
 }
 
 epoll_context::
@@ -46,6 +48,20 @@ epoll_context::
     destroy();
 }
 
+epoll_stats
+epoll_context::
+stats() const noexcept
+{
+    return static_cast<detail::epoll_scheduler const*>(sched_)->stats();
+}
+
+int
+epoll_context::
+native_handle() const noexcept
+{
+    return static_cast<detail::epoll_scheduler const*>(sched_)->epoll_fd();
+}
+
 } // namespace boost::corosio
 
 #endif // BOOST_COROSIO_HAS_EPOLL
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/frame_allocator.hpp>
+
+#include "src/detail/huge_page_arena.hpp"
+
+#include <new>
+
+/*
+    Frame Allocator
+    ===============
+
+    Free frames are threaded on singly linked lists through their
+    first bytes, one list per size class per thread, as the thread
+    caches of the buffer pool are. Callers pass the size they
+    allocated with back on free, so no header is needed to find a
+    frame's class. There is no shared list: a coroutine is usually
+    created and destroyed on the thread running its context, and a
+    lock on every frame would cost more than the allocator it saves.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+constexpr std::size_t class_count = 9;
+
+static_assert((frame_allocator::min_size << (class_count - 1)) ==
+    frame_allocator::max_size);
+
+// Per class, so that a thread caches many small frames or a few
+// large ones
+constexpr std::size_t thread_cache_bytes = 262144;
+
+struct block
+{
+    block* next;
+};
+
+constexpr std::size_t
+class_size(std::size_t cls) noexcept
+{
+    return frame_allocator::min_size << cls;
+}
+
+std::size_t
+class_of(std::size_t size) noexcept
+{
+    std::size_t cls = 0;
+    while (class_size(cls) < size)
+        ++cls;
+    return cls;
+}
+
+struct thread_cache
+{
+    block* head[class_count] = {};
+    std::size_t count[class_count] = {};
+    bool alive = true;
+
+    ~thread_cache()
+    {
+        trim();
+        // Frames freed later on this thread bypass the cache
+        alive = false;
+    }
+
+    void trim() noexcept
+    {
+        for (std::size_t cls = 0; cls < class_count; ++cls)
+        {
+            while (head[cls])
+            {
+                auto* b = head[cls];
+                head[cls] = b->next;
+                detail::pool_deallocate(b, class_size(cls));
+            }
+            count[cls] = 0;
+        }
+    }
+
+    void* pop(std::size_t cls) noexcept
+    {
+        auto* b = head[cls];
+        if (!b)
+            return nullptr;
+        head[cls] = b->next;
+        --count[cls];
+        return b;
+    }
+
+    bool push(void* p, std::size_t cls) noexcept
+    {
+        if (!alive || count[cls] >= thread_cache_bytes / class_size(cls))
+            return false;
+        head[cls] = ::new(p) block{head[cls]};
+        ++count[cls];
+        return true;
+    }
+};
+
+thread_cache&
+local_cache() noexcept
+{
+    thread_local thread_cache c;
+    return c;
+}
+
+class frame_resource final : public std::pmr::memory_resource
+{
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(align));
+        return frame_allocator::allocate(bytes);
+    }
+
+    void do_deallocate(
+        void* p, std::size_t bytes, std::size_t align) override
+    {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(p, std::align_val_t(align));
+        else
+            frame_allocator::deallocate(p, bytes);
+    }
+
+    bool do_is_equal(
+        std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+void*
+frame_allocator::allocate(std::size_t n)
+{
+    if (n > max_size)
+        return ::operator new(n);
+    auto const cls = class_of(n);
+    if (void* p = local_cache().pop(cls))
+        return p;
+    return detail::pool_allocate(class_size(cls));
+}
+
+void
+frame_allocator::deallocate(void* p, std::size_t n) noexcept
+{
+    if (!p)
+        return;
+    if (n > max_size)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto const cls = class_of(n);
+    if (!local_cache().push(p, cls))
+        detail::pool_deallocate(p, class_size(cls));
+}
+
+void
+frame_allocator::trim() noexcept
+{
+    local_cache().trim();
+}
+
+std::pmr::memory_resource*
+frame_allocator::resource() noexcept
+{
+    static frame_resource r;
+    return &r;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/huge_pages.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include "src/detail/huge_page_arena.hpp"
+
+#include <mutex>
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/windows.hpp"
+#elif BOOST_COROSIO_POSIX
+#include <sys/mman.h>
+#endif
+
+/*
+    Huge Page Arena
+    ===============
+
+    One region per process, mapped once and never unmapped, so that
+    a block may be freed at any time, including by the thread caches
+    of exiting threads. Blocks are carved from the front of the
+    region with an atomic bump in power-of-two classes of 64 bytes
+    to 64 KiB, which keeps every block 64-byte aligned. A freed
+    block goes to the free list of its class, under that class's
+    lock, and is reused before the bump moves on.
+
+    The pools in front of the arena keep their own thread caches, so
+    the arena is reached only when a cache is empty or overflows;
+    its locks see a small fraction of the pools' traffic.
+
+    The bounds are published with end last, so that pool_allocate
+    sees either no arena or a complete one. pool_deallocate tells
+    arena blocks from others by address alone, which lets blocks
+    allocated before the arena existed be freed normally.
+*/
+
+namespace boost::corosio {
+
+namespace detail {
+
+namespace {
+
+constexpr std::size_t min_class = 64;
+constexpr std::size_t class_count = 11;
+constexpr std::size_t max_class = min_class << (class_count - 1);
+
+struct free_block
+{
+    free_block* next;
+};
+
+std::size_t
+class_of(std::size_t n) noexcept
+{
+    std::size_t cls = 0;
+    while ((min_class << cls) < n)
+        ++cls;
+    return cls;
+}
+
+struct arena
+{
+    std::mutex reserve_mutex;
+    huge_page_backing backing = huge_page_backing::none;
+    bool reserved = false;
+
+    std::atomic<std::uintptr_t> next{0};
+
+    struct free_list
+    {
+        std::mutex mutex;
+        free_block* head = nullptr;
+    };
+    free_list lists[class_count];
+};
+
+arena&
+get_arena() noexcept
+{
+    static arena a;
+    return a;
+}
+
+#if BOOST_COROSIO_HAS_IOCP
+
+// Large pages need SeLockMemoryPrivilege enabled on the token
+void
+enable_lock_memory() noexcept
+{
+    HANDLE token = nullptr;
+    if (!::OpenProcessToken(::GetCurrentProcess(),
+            TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        return;
+    TOKEN_PRIVILEGES tp{};
+    tp.PrivilegeCount = 1;
+    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    if (::LookupPrivilegeValueW(nullptr, L"SeLockMemoryPrivilege",
+            &tp.Privileges[0].Luid))
+        ::AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr);
+    ::CloseHandle(token);
+}
+
+void*
+map_arena(std::size_t& bytes, huge_page_backing& backing) noexcept
+{
+    SIZE_T large = ::GetLargePageMinimum();
+    if (large == 0)
+        return nullptr;
+    bytes = (bytes + large - 1) / large * large;
+
+    enable_lock_memory();
+    void* p = ::VirtualAlloc(nullptr, bytes,
+        MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    if (p)
+        backing = huge_page_backing::reserved;
+    return p;
+}
+
+#elif BOOST_COROSIO_POSIX
+
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+void*
+map_arena(std::size_t& bytes, huge_page_backing& backing) noexcept
+{
+    bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+
+#ifdef MAP_HUGETLB
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED)
+    {
+        backing = huge_page_backing::reserved;
+        return p;
+    }
+#endif
+
+#ifdef MADV_HUGEPAGE
+    // Aligned to a huge page, so that every page of it can be one
+    std::size_t const span = bytes + huge_page_size;
+    void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        return nullptr;
+    auto const a = reinterpret_cast<std::uintptr_t>(raw);
+    auto const aligned =
+        (a + huge_page_size - 1) & ~(std::uintptr_t(huge_page_size) - 1);
+    if (aligned > a)
+        ::munmap(raw, aligned - a);
+    std::size_t const tail = (a + span) - (aligned + bytes);
+    if (tail > 0)
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+
+    void* q = reinterpret_cast<void*>(aligned);
+    if (::madvise(q, bytes, MADV_HUGEPAGE) != 0)
+    {
+        ::munmap(q, bytes);
+        return nullptr;
+    }
+    backing = huge_page_backing::transparent;
+    return q;
+#else
+    (void)backing;
+    return nullptr;
+#endif
+}
+
+#else
+
+void*
+map_arena(std::size_t&, huge_page_backing&) noexcept
+{
+    return nullptr;
+}
+
+#endif
+
+} // namespace
+
+huge_page_range&
+huge_page_bounds() noexcept
+{
+    static huge_page_range r;
+    return r;
+}
+
+void*
+huge_page_allocate(std::size_t n) noexcept
+{
+    if (n > max_class)
+        return nullptr;
+    auto& a = get_arena();
+    std::size_t const cls = class_of(n);
+    {
+        auto& fl = a.lists[cls];
+        std::lock_guard lock(fl.mutex);
+        if (auto* b = fl.head)
+        {
+            fl.head = b->next;
+            return b;
+        }
+    }
+
+    std::size_t const size = min_class << cls;
+    auto const end = huge_page_bounds().end.load(std::memory_order_relaxed);
+    auto p = a.next.load(std::memory_order_relaxed);
+    do
+    {
+        if (end - p < size)
+            return nullptr;
+    }
+    while (!a.next.compare_exchange_weak(
+        p, p + size, std::memory_order_relaxed));
+    return reinterpret_cast<void*>(p);
+}
+
+void
+huge_page_deallocate(void* p, std::size_t n) noexcept
+{
+    auto& fl = get_arena().lists[class_of(n)];
+    std::lock_guard lock(fl.mutex);
+    fl.head = ::new(p) free_block{fl.head};
+}
+
+} // namespace detail
+
+huge_page_backing
+reserve_huge_pages(std::size_t bytes)
+{
+    auto& a = detail::get_arena();
+    std::lock_guard lock(a.reserve_mutex);
+    if (a.reserved || bytes == 0)
+        return a.backing;
+    a.reserved = true;
+
+    huge_page_backing backing = huge_page_backing::none;
+    void* p = detail::map_arena(bytes, backing);
+    if (!p)
+        return a.backing;
+
+    auto const begin = reinterpret_cast<std::uintptr_t>(p);
+    auto& r = detail::huge_page_bounds();
+    a.next.store(begin, std::memory_order_relaxed);
+    r.begin.store(begin, std::memory_order_relaxed);
+    r.end.store(begin + bytes, std::memory_order_release);
+    a.backing = backing;
+    return backing;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,319 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context_pool.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include <exception>
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/windows.hpp"
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+
+#include <fstream>
+#include <string>
+#endif
+
+/*
+    NUMA Placement
+    ==============
+
+    With affinity::per_node, shard i belongs to the i % N-th of the
+    N nodes found, and both its context and its thread are bound to
+    that node's CPUs: the context is constructed on a short-lived
+    thread bound there, and start() binds the running thread before
+    it calls run(). Memory is placed on first touch by Linux and
+    Windows alike, so the scheduler, the reactor or completion port
+    state, and whatever the shard's thread allocates afterwards
+    (socket impls from their recycling lists, operation frames,
+    buffer_pool blocks) come from the node's own memory without an
+    allocator of our own.
+
+    The topology is read from /sys/devices/system/node on Linux and
+    with GetNumaNodeProcessorMaskEx on Windows, one processor group
+    per node. Elsewhere, or if it cannot be read, there is a single
+    node and nothing is bound.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+struct numa_node
+{
+    unsigned id = 0;
+#if BOOST_COROSIO_HAS_IOCP
+    GROUP_AFFINITY mask{};
+#elif defined(__linux__)
+    cpu_set_t set;
+#endif
+};
+
+#if defined(__linux__) && !BOOST_COROSIO_HAS_IOCP
+// Parse a cpulist such as "0-15,32-47"
+bool
+parse_cpulist(std::string const& list, cpu_set_t& set)
+{
+    CPU_ZERO(&set);
+    bool any = false;
+    std::size_t i = 0;
+    while (i < list.size())
+    {
+        std::size_t end = 0;
+        unsigned long lo = std::stoul(list.substr(i), &end);
+        i += end;
+        unsigned long hi = lo;
+        if (i < list.size() && list[i] == '-')
+        {
+            ++i;
+            hi = std::stoul(list.substr(i), &end);
+            i += end;
+        }
+        for (unsigned long cpu = lo; cpu <= hi && cpu < CPU_SETSIZE; ++cpu)
+        {
+            CPU_SET(cpu, &set);
+            any = true;
+        }
+        if (i < list.size() && list[i] == ',')
+            ++i;
+        else
+            break;
+    }
+    return any;
+}
+#endif
+
+// The nodes with CPUs, empty if there is at most one
+std::vector<numa_node>
+numa_topology()
+{
+    std::vector<numa_node> nodes;
+#if BOOST_COROSIO_HAS_IOCP
+    ULONG highest = 0;
+    if (!::GetNumaHighestNodeNumber(&highest))
+        return {};
+    for (ULONG n = 0; n <= highest; ++n)
+    {
+        numa_node node;
+        node.id = n;
+        if (::GetNumaNodeProcessorMaskEx(
+                static_cast<USHORT>(n), &node.mask) &&
+            node.mask.Mask != 0)
+            nodes.push_back(node);
+    }
+#elif defined(__linux__)
+    // Node numbers may have gaps
+    constexpr unsigned max_nodes = 1024;
+    for (unsigned n = 0; n < max_nodes; ++n)
+    {
+        std::ifstream f("/sys/devices/system/node/node" +
+            std::to_string(n) + "/cpulist");
+        if (!f)
+            continue;
+        std::string list;
+        std::getline(f, list);
+        numa_node node;
+        node.id = n;
+        try
+        {
+            if (parse_cpulist(list, node.set))
+                nodes.push_back(node);
+        }
+        catch (std::exception const&)
+        {
+            return {};
+        }
+    }
+#endif
+    if (nodes.size() < 2)
+        nodes.clear();
+    return nodes;
+}
+
+// Best effort, as for pin_thread
+void
+bind_this_thread(numa_node const& node) noexcept
+{
+#if BOOST_COROSIO_HAS_IOCP
+    ::SetThreadGroupAffinity(::GetCurrentThread(), &node.mask, nullptr);
+#elif defined(__linux__)
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(node.set), &node.set);
+#else
+    (void)node;
+#endif
+}
+
+// Best effort; a failure leaves the thread unpinned
+void
+pin_thread(std::thread& t, std::size_t index) noexcept
+{
+    unsigned ncpu = std::thread::hardware_concurrency();
+    if (ncpu == 0)
+        return;
+    auto cpu = index % ncpu;
+
+#if BOOST_COROSIO_HAS_IOCP
+    if (cpu < sizeof(DWORD_PTR) * 8)
+        ::SetThreadAffinityMask(
+            static_cast<HANDLE>(t.native_handle()),
+            static_cast<DWORD_PTR>(1) << cpu);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    ::pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+    (void)t;
+    (void)cpu;
+#endif
+}
+
+} // namespace
+
+io_context_pool::
+io_context_pool(affinity placement)
+    : io_context_pool(std::thread::hardware_concurrency(), placement)
+{
+}
+
+io_context_pool::
+io_context_pool(
+    std::size_t size,
+    affinity placement)
+    : placement_(placement)
+{
+    if (size == 0)
+        size = 1;
+    contexts_.reserve(size);
+
+    std::vector<numa_node> topology;
+    if (placement_ == affinity::per_node)
+        topology = numa_topology();
+    if (topology.empty())
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            contexts_.push_back(std::make_unique<io_context>(1u));
+        return;
+    }
+
+    // See "NUMA Placement"
+    nodes_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        auto const& node = topology[i % topology.size()];
+        std::unique_ptr<io_context> ctx;
+        std::exception_ptr ep;
+        std::thread([&]
+        {
+            bind_this_thread(node);
+            try
+            {
+                ctx = std::make_unique<io_context>(1u);
+            }
+            catch (...)
+            {
+                ep = std::current_exception();
+            }
+        }).join();
+        if (ep)
+            std::rethrow_exception(ep);
+        contexts_.push_back(std::move(ctx));
+        nodes_.push_back(node.id);
+    }
+}
+
+io_context_pool::
+~io_context_pool()
+{
+    stop();
+    join();
+}
+
+std::size_t
+io_context_pool::
+index_of(capy::execution_context const& ctx) const noexcept
+{
+    for (std::size_t i = 0; i < contexts_.size(); ++i)
+        if (contexts_[i].get() == &ctx)
+            return i;
+    return contexts_.size();
+}
+
+void
+io_context_pool::
+start()
+{
+    if (!threads_.empty())
+        detail::throw_logic_error("io_context_pool::start: already started");
+
+    // Keep every context alive while idle until join()
+    for (auto& ctx : contexts_)
+    {
+        ctx->restart();
+        ctx->get_executor().on_work_started();
+    }
+    holding_work_ = true;
+
+    std::vector<numa_node> topology;
+    if (!nodes_.empty())
+        topology = numa_topology();
+
+    threads_.reserve(contexts_.size());
+    for (std::size_t i = 0; i < contexts_.size(); ++i)
+    {
+        auto* ctx = contexts_[i].get();
+        numa_node const* node = nullptr;
+        for (auto const& n : topology)
+            if (n.id == nodes_[i])
+                node = &n;
+        if (node)
+        {
+            // Bound before run() allocates anything
+            threads_.emplace_back([ctx, n = *node]
+            {
+                bind_this_thread(n);
+                ctx->run();
+            });
+            continue;
+        }
+        threads_.emplace_back([ctx] { ctx->run(); });
+        if (placement_ == affinity::per_core)
+            pin_thread(threads_.back(), i);
+    }
+}
+
+void
+io_context_pool::
+stop()
+{
+    for (auto& ctx : contexts_)
+        ctx->stop();
+}
+
+void
+io_context_pool::
+join()
+{
+    if (holding_work_)
+    {
+        holding_work_ = false;
+        for (auto& ctx : contexts_)
+            ctx->get_executor().on_work_finished();
+    }
+
+    for (auto& t : threads_)
+        if (t.joinable())
+            t.join();
+    threads_.clear();
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/detail/io_deadline.hpp>
+#include <boost/corosio/timer.hpp>
+
+namespace boost::corosio::detail {
+
+// Defined in timer_service.cpp
+extern timer::timer_impl* timer_service_create(capy::execution_context&);
+extern void timer_service_destroy(timer::timer_impl&) noexcept;
+extern void timer_service_arm_callback(
+    timer::timer_impl&, timer::time_point, void (*)(void*) noexcept, void*);
+extern void timer_service_disarm(timer::timer_impl&) noexcept;
+
+namespace {
+
+timer::timer_impl&
+as_timer(io_object::io_object_impl* p) noexcept
+{
+    return *static_cast<timer::timer_impl*>(p);
+}
+
+} // namespace
+
+io_deadline::
+io_deadline(capy::execution_context& ctx)
+    : timer_(timer_service_create(ctx))
+{
+}
+
+io_deadline::
+~io_deadline()
+{
+    disarm();
+    timer_service_destroy(as_timer(timer_));
+}
+
+std::stop_token
+io_deadline::
+arm(time_point t, std::stop_token const& caller)
+{
+    // A stop source cannot be reset, so only a stopped one is replaced
+    if (source_.stop_requested())
+        source_ = std::stop_source();
+    fired_.store(false, std::memory_order_relaxed);
+
+    if (caller.stop_possible())
+        caller_cb_.emplace(caller, forward_stop{this});
+
+    timer_service_arm_callback(as_timer(timer_), t, &on_expiry, this);
+    return source_.get_token();
+}
+
+void
+io_deadline::
+disarm() noexcept
+{
+    timer_service_disarm(as_timer(timer_));
+    caller_cb_.reset();
+}
+
+void
+io_deadline::
+on_expiry(void* p) noexcept
+{
+    auto* self = static_cast<io_deadline*>(p);
+
+    // A caller that stopped first keeps its cancellation
+    if (self->source_.stop_requested())
+        return;
+    self->fired_.store(true, std::memory_order_release);
+    self->source_.request_stop();
+}
+
+void
+io_deadline::forward_stop::
+operator()() const noexcept
+{
+    self->source_.request_stop();
+}
+
+} // namespace boost::corosio::detail
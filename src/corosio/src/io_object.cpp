@@ -0,0 +1,37 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_object.hpp>
+#include <boost/corosio/detail/io_deadline.hpp>
+
+namespace boost::corosio {
+
+io_object::
+~io_object() = default;
+
+detail::io_deadline&
+io_object::
+get_deadline(deadline_slot slot)
+{
+    auto& p = deadlines_[slot];
+    if (!p)
+        p = std::make_unique<detail::io_deadline>(*ctx_);
+    return *p;
+}
+
+void
+io_object::
+rebind_context(capy::execution_context& ctx) noexcept
+{
+    deadlines_[read_slot].reset();
+    deadlines_[write_slot].reset();
+    ctx_ = &ctx;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_stream.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include "src/detail/resume_coro.hpp"
+
+#include <span>
+#include <vector>
+
+namespace boost::corosio {
+
+namespace {
+
+using buffer_span = std::span<capy::mutable_buffer const>;
+
+// One read_some or write_some on an impl, inside a coroutine
+struct some_awaitable
+{
+    io_stream::io_stream_impl& impl_;
+    bool is_read_;
+    buffer_span bufs_;
+    mutable system::error_code ec_;
+    mutable std::size_t n_ = 0;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<std::size_t> await_resume() const noexcept
+    {
+        return {ec_, n_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        bool done = is_read_
+            ? impl_.read_some(h, ex, bufs_, token, &ec_, &n_)
+            : impl_.write_some(h, ex, bufs_, token, &ec_, &n_);
+        if (done)
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+capy::task<>
+do_transfer_all(
+    io_stream::io_stream_impl& impl,
+    bool is_read,
+    std::vector<capy::mutable_buffer> bufs,
+    system::error_code* ec_out,
+    std::size_t* bytes_out,
+    std::coroutine_handle<> continuation,
+    capy::executor_ref ex)
+{
+    system::error_code ec;
+    std::size_t total = 0;
+    std::size_t first = 0;
+
+    while (first < bufs.size())
+    {
+        auto [e, n] = co_await some_awaitable{
+            impl, is_read, buffer_span(bufs).subspan(first)};
+        total += n;
+        if (e)
+        {
+            ec = e;
+            break;
+        }
+
+        // Drop what was transferred
+        while (n > 0 && n >= bufs[first].size())
+            n -= bufs[first++].size();
+        if (n > 0)
+            bufs[first] = capy::mutable_buffer(
+                static_cast<char*>(bufs[first].data()) + n,
+                bufs[first].size() - n);
+    }
+
+    *ec_out = ec;
+    *bytes_out = total;
+
+    detail::resume_coro(ex, continuation);
+}
+
+} // namespace
+
+bool
+io_stream::
+transfer_all(
+    io_stream_impl& impl,
+    bool is_read,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    io_buffer_param buffers,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    // The sequence is not known to end until a copy comes up short
+    std::vector<capy::mutable_buffer> bufs(16);
+    for (;;)
+    {
+        auto n = buffers.copy_to(bufs.data(), bufs.size());
+        if (n < bufs.size())
+        {
+            bufs.resize(n);
+            break;
+        }
+        bufs.resize(bufs.size() * 2);
+    }
+
+    if (bufs.empty())
+        return is_read
+            ? impl.read_some(h, ex, buffers, token, ec, bytes)
+            : impl.write_some(h, ex, buffers, token, ec, bytes);
+
+    capy::run_async(ex, token)(do_transfer_all(
+        impl, is_read, std::move(bufs), ec, bytes, h, ex));
+    return false;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_uring_context.hpp>
+
+#if BOOST_COROSIO_HAS_IO_URING
+
+#include "src/detail/io_uring/scheduler.hpp"
+#include "src/detail/io_uring/sockets.hpp"
+#include "src/detail/io_uring/acceptors.hpp"
+
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/detail/except.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace boost::corosio {
+
+io_uring_context::
+io_uring_context()
+    : io_uring_context(std::thread::hardware_concurrency())
+{
+}
+
+io_uring_context::
+io_uring_context(
+    unsigned concurrency_hint)
+    : io_uring_context(concurrency_hint, io_uring_options{})
+{
+}
+
+io_uring_context::
+io_uring_context(
+    unsigned concurrency_hint,
+    io_uring_options const& opts)
+{
+    sched_ = &make_service<detail::io_uring_scheduler>(
+        static_cast<int>(concurrency_hint), opts);
+
+    // Install socket/acceptor services.
+    // These use socket_service and acceptor_service as key_type,
+    // enabling runtime polymorphism.
+    make_service<detail::io_uring_socket_service>();
+    make_service<detail::io_uring_acceptor_service>();
+}
+
+io_uring_context::
+~io_uring_context()
+{
+    shutdown();
+    destroy();
+}
+
+void
+io_uring_context::
+register_buffers(std::span<capy::mutable_buffer const> bufs)
+{
+    std::vector<iovec> iovs;
+    iovs.reserve(bufs.size());
+    for (auto const& b : bufs)
+        iovs.push_back({b.data(), b.size()});
+
+    static_cast<detail::io_uring_scheduler*>(sched_)->register_buffers(
+        iovs.data(), iovs.size());
+}
+
+void
+io_uring_context::
+unregister_buffers() noexcept
+{
+    static_cast<detail::io_uring_scheduler*>(sched_)->unregister_buffers();
+}
+
+bool
+io_uring_context::
+register_file(socket& s)
+{
+    if (&s.context() != this)
+        detail::throw_logic_error("io_uring_context::register_file: context mismatch");
+
+    auto* impl = static_cast<detail::io_uring_socket_impl*>(s.get_impl());
+    return impl && impl->register_file();
+}
+
+} // namespace boost::corosio
+
+#endif // BOOST_COROSIO_HAS_IO_URING
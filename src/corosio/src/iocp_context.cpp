@@ -12,6 +12,10 @@
 #if BOOST_COROSIO_HAS_IOCP
 
 #include "src/detail/iocp/scheduler.hpp"
+#include "src/detail/iocp/sockets.hpp"
+#include "src/detail/make_err.hpp"
+
+#include <boost/corosio/detail/except.hpp>
 
 #include <thread>
 
@@ -26,9 +30,17 @@ iocp_context()
 iocp_context::
 iocp_context(
     unsigned concurrency_hint)
+    : iocp_context(concurrency_hint, iocp_options{})
+{
+}
+
+iocp_context::
+iocp_context(
+    unsigned concurrency_hint,
+    iocp_options const& opts)
 {
     sched_ = &make_service<detail::win_scheduler>(
-        static_cast<int>(concurrency_hint));
+        static_cast<int>(concurrency_hint), opts);
 }
 
 iocp_context::
@@ -38,6 +50,49 @@ iocp_context::
     destroy();
 }
 
+bool
+iocp_context::
+registered_io()
+{
+    return use_service<detail::win_sockets>().rio() != nullptr;
+}
+
+void
+iocp_context::
+register_buffers(std::span<capy::mutable_buffer const> bufs)
+{
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    if (auto* rio = use_service<detail::win_sockets>().rio())
+    {
+        rio->register_buffers(bufs.data(), bufs.size());
+        return;
+    }
+#else
+    (void)bufs;
+#endif
+    detail::throw_system_error(
+        detail::make_err(WSAEOPNOTSUPP),
+        "iocp_context::register_buffers");
+}
+
+void
+iocp_context::
+unregister_buffers() noexcept
+{
+#if BOOST_COROSIO_DETAIL_HAS_RIO
+    auto* svc = find_service<detail::win_sockets>();
+    if (auto* rio = svc ? svc->rio() : nullptr)
+        rio->unregister_buffers();
+#endif
+}
+
+void*
+iocp_context::
+native_handle() const noexcept
+{
+    return static_cast<detail::win_scheduler const*>(sched_)->native_handle();
+}
+
 } // namespace boost::corosio
 
 #endif // BOOST_COROSIO_HAS_IOCP
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/local_acceptor.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/sockets.hpp"
+#else
+// POSIX backends use the abstract acceptor_service interface
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/socket_service.hpp"
+#endif
+
+#include <boost/corosio/detail/except.hpp>
+
+namespace boost::corosio {
+
+local_acceptor::
+~local_acceptor()
+{
+    close();
+}
+
+local_acceptor::
+local_acceptor(
+    capy::execution_context& ctx)
+    : io_object(ctx)
+{
+}
+
+void
+local_acceptor::
+listen(std::string_view path, int backlog)
+{
+    if (impl_)
+        close();
+
+#if BOOST_COROSIO_HAS_IOCP
+    auto& svc = ctx_->use_service<detail::win_sockets>();
+    auto& wrapper = svc.create_acceptor_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc.open_local_acceptor(
+        *wrapper.get_internal(), path, backlog);
+#else
+    auto* svc = detail::find_deferred_service<detail::acceptor_service>(
+        *ctx_, detail::deferred_service::acceptor);
+    if (!svc)
+        detail::throw_logic_error(
+            "local_acceptor::listen: no acceptor service installed");
+    auto& wrapper = svc->create_acceptor_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->open_local_acceptor(wrapper, path, backlog);
+#endif
+    if (ec)
+    {
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "local_acceptor::listen");
+    }
+}
+
+void
+local_acceptor::
+close()
+{
+    if (!impl_)
+        return;
+
+    impl_->release();
+    impl_ = nullptr;
+}
+
+void
+local_acceptor::
+cancel()
+{
+    if (!impl_)
+        return;
+#if BOOST_COROSIO_HAS_IOCP
+    static_cast<detail::win_acceptor_impl*>(impl_)->get_internal()->cancel();
+#else
+    get().cancel();
+#endif
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/local_stream_socket.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include "src/detail/make_err.hpp"
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/sockets.hpp"
+#include <cstring>
+#else
+// POSIX backends use the abstract socket_service interface
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/socket_service.hpp"
+#include "src/detail/posix/local.hpp"
+#include <cerrno>
+#include <sys/socket.h>
+#endif
+
+namespace boost::corosio {
+
+local_stream_socket::
+~local_stream_socket()
+{
+    close();
+}
+
+local_stream_socket::
+local_stream_socket(
+    capy::execution_context& ctx)
+    : io_stream(ctx)
+{
+}
+
+void
+local_stream_socket::
+open()
+{
+    if (impl_)
+        return;
+
+#if BOOST_COROSIO_HAS_IOCP
+    auto& svc = ctx_->use_service<detail::win_sockets>();
+    auto& wrapper = svc.create_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc.open_local_socket(*wrapper.get_internal());
+#else
+    auto* svc = detail::find_deferred_service<detail::socket_service>(
+        *ctx_, detail::deferred_service::socket);
+    if (!svc)
+        detail::throw_logic_error(
+            "local_stream_socket::open: no socket service installed");
+    auto& wrapper = svc->create_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->open_local_socket(wrapper);
+#endif
+    if (ec)
+    {
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "local_stream_socket::open");
+    }
+}
+
+void
+local_stream_socket::
+close()
+{
+    if (!impl_)
+        return;
+
+    impl_->release();
+    impl_ = nullptr;
+}
+
+void
+local_stream_socket::
+cancel()
+{
+    if (!impl_)
+        return;
+#if BOOST_COROSIO_HAS_IOCP
+    static_cast<detail::win_socket_impl*>(impl_)->get_internal()->cancel();
+#else
+    get().cancel();
+#endif
+}
+
+void
+local_stream_socket::
+shutdown(socket::shutdown_type what)
+{
+    if (impl_)
+        get().shutdown(what);
+}
+
+native_handle_type
+local_stream_socket::
+native_handle() const noexcept
+{
+    if (!impl_)
+    {
+#if BOOST_COROSIO_HAS_IOCP
+        return static_cast<native_handle_type>(~0ull);  // INVALID_SOCKET
+#else
+        return -1;
+#endif
+    }
+    return get().native_handle();
+}
+
+system::error_code
+local_stream_socket::
+connect_now(std::string_view path)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        return detail::make_err(WSAENAMETOOLONG);
+    std::memcpy(addr.sun_path, path.data(), path.size());
+
+    SOCKET s = static_cast<SOCKET>(get().native_handle());
+    if (::connect(s, reinterpret_cast<sockaddr*>(&addr),
+            static_cast<int>(sizeof(addr))) == SOCKET_ERROR)
+        return detail::make_err(::WSAGetLastError());
+    return {};
+#else
+    sockaddr_un addr;
+    socklen_t len;
+    if (int err = detail::to_sockaddr_un(path, addr, len))
+        return detail::make_err(err);
+
+    // The connect is made or refused at once; EINPROGRESS is not
+    // reported for local sockets, so the reactor is not involved
+    int fd = get().native_handle();
+    int r;
+    do
+        r = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), len);
+    while (r < 0 && errno == EINTR);
+    if (r < 0)
+        return detail::make_err(errno);
+    return {};
+#endif
+}
+
+} // namespace boost::corosio
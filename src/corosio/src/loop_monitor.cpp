@@ -0,0 +1,285 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/loop_monitor.hpp>
+
+#include "src/detail/scheduler_op.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+
+/*
+    Loop Monitor
+    ============
+
+    The monitor thread wakes at the next probe time or the next stall
+    check, whichever comes first. A probe is a heap-allocated operation
+    posted straight to the scheduler that stamps the time it was
+    posted; when it runs it records the lag and frees itself. Only one
+    probe is queued at a time, so a stuck loop is not flooded with
+    them. The probe shares ownership of the state, so a probe still
+    queued when the monitor is destroyed is harmless, and is destroyed
+    with the context's other work.
+
+    Stall checks sample every thread inside run() through the
+    scheduler (see Handler Timing in thread_stats.hpp). A handler is
+    identified by its start time, which the monitor remembers per
+    thread, so a handler seen running is not reported again when it
+    finishes.
+*/
+
+namespace boost::corosio {
+
+struct loop_monitor::state
+    : std::enable_shared_from_this<state>
+{
+    using clock = std::chrono::steady_clock;
+
+    struct probe;
+
+    detail::scheduler& sched;
+    loop_monitor_options const opts;
+    bool timing = false;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    bool probe_queued = false;
+
+    std::atomic<std::int64_t> lag_ns{0};
+    std::atomic<std::int64_t> max_lag_ns{0};
+
+    // What the monitor thread has reported, per thread
+    struct seen
+    {
+        std::thread::id thread;
+        clock::time_point reported;
+        std::uint64_t slow_count = 0;
+    };
+    std::vector<detail::handler_sample> samples;
+    std::vector<seen> seen_;
+    std::vector<seen> next_seen_;
+
+    state(detail::scheduler& s, loop_monitor_options o)
+        : sched(s)
+        , opts(std::move(o))
+    {
+    }
+
+    void run();
+    void post_probe();
+    void check_stalls();
+};
+
+struct loop_monitor::state::probe final
+    : detail::scheduler_op
+{
+    std::shared_ptr<state> st;
+    clock::time_point posted = clock::now();
+
+    explicit
+    probe(std::shared_ptr<state> s) noexcept
+        : st(std::move(s))
+    {
+    }
+
+    void operator()() override
+    {
+        auto const lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now() - posted).count();
+        st->lag_ns.store(lag, std::memory_order_relaxed);
+        if (lag > st->max_lag_ns.load(std::memory_order_relaxed))
+            st->max_lag_ns.store(lag, std::memory_order_relaxed);
+        destroy();
+    }
+
+    void destroy() override
+    {
+        {
+            std::lock_guard lock(st->mutex);
+            st->probe_queued = false;
+        }
+        delete this;
+    }
+};
+
+void
+loop_monitor::state::
+post_probe()
+{
+    // Called with mutex held
+    if (probe_queued)
+        return;
+
+    auto* p = new (std::nothrow) probe(shared_from_this());
+    if (!p)
+        return;
+    probe_queued = true;
+    sched.post(p);
+}
+
+void
+loop_monitor::state::
+check_stalls()
+{
+    sched.sample_handlers(samples);
+    auto const now = clock::now();
+    auto const threshold = std::chrono::nanoseconds(opts.stall_threshold);
+
+    next_seen_.clear();
+    for (auto const& s : samples)
+    {
+        seen prev{s.thread, {}, 0};
+        for (auto const& p : seen_)
+            if (p.thread == s.thread)
+                prev = p;
+
+        if (s.running &&
+            now - s.running_since >= threshold &&
+            s.running_since != prev.reported)
+        {
+            prev.reported = s.running_since;
+            if (opts.on_stall)
+                opts.on_stall(stall_report{s.running, s.thread,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        now - s.running_since), true});
+        }
+
+        if (s.slow && s.slow_count != prev.slow_count)
+        {
+            prev.slow_count = s.slow_count;
+            if (s.slow_since != prev.reported)
+            {
+                prev.reported = s.slow_since;
+                if (opts.on_stall)
+                    opts.on_stall(stall_report{
+                        s.slow, s.thread, s.slow_time, false});
+            }
+        }
+
+        next_seen_.push_back(prev);
+    }
+    seen_.swap(next_seen_);
+}
+
+void
+loop_monitor::state::
+run()
+{
+    // Check at half the threshold so a stuck handler is seen running
+    auto const probe_every = (std::max)(
+        clock::duration(opts.probe_interval),
+        clock::duration(std::chrono::milliseconds(1)));
+    auto check_every = probe_every;
+    if (timing)
+        check_every = (std::max)(
+            clock::duration(opts.stall_threshold / 2),
+            clock::duration(std::chrono::milliseconds(1)));
+
+    auto next_probe = clock::now();
+    std::unique_lock lock(mutex);
+    while (!stop)
+    {
+        auto now = clock::now();
+        if (now >= next_probe)
+        {
+            post_probe();
+            next_probe = now + probe_every;
+        }
+
+        if (timing)
+        {
+            lock.unlock();
+            check_stalls();
+            lock.lock();
+        }
+
+        cv.wait_until(lock, (std::min)(next_probe, now + check_every),
+            [this] { return stop; });
+    }
+}
+
+loop_monitor::
+loop_monitor(
+    basic_io_context& ctx,
+    loop_monitor_options opts)
+    : st_(std::make_shared<state>(*ctx.sched_, std::move(opts)))
+{
+    if (st_->opts.stall_threshold.count() > 0)
+        st_->timing = st_->sched.time_handlers(st_->opts.stall_threshold);
+
+    try
+    {
+        thread_ = std::thread([st = st_.get()] { st->run(); });
+    }
+    catch (...)
+    {
+        if (st_->timing)
+            st_->sched.time_handlers(std::chrono::nanoseconds(0));
+        throw;
+    }
+}
+
+loop_monitor::
+~loop_monitor()
+{
+    {
+        std::lock_guard lock(st_->mutex);
+        st_->stop = true;
+    }
+    st_->cv.notify_all();
+    thread_.join();
+
+    if (st_->timing)
+        st_->sched.time_handlers(std::chrono::nanoseconds(0));
+}
+
+bool
+loop_monitor::
+timing_handlers() const noexcept
+{
+    return st_->timing;
+}
+
+std::chrono::nanoseconds
+loop_monitor::
+lag() const noexcept
+{
+    return std::chrono::nanoseconds(
+        st_->lag_ns.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds
+loop_monitor::
+max_lag() const noexcept
+{
+    return std::chrono::nanoseconds(
+        st_->max_lag_ns.load(std::memory_order_relaxed));
+}
+
+std::vector<loop_monitor::thread_longest>
+loop_monitor::
+longest_handlers() const
+{
+    std::vector<detail::handler_sample> samples;
+    st_->sched.sample_handlers(samples);
+
+    std::vector<thread_longest> out;
+    out.reserve(samples.size());
+    for (auto const& s : samples)
+        out.push_back({s.thread, s.longest});
+    return out;
+}
+
+} // namespace boost::corosio
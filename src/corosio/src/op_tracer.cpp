@@ -0,0 +1,319 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/op_tracer.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+/*
+    Histogram Layout
+    ================
+
+    The layout is HdrHistogram's with two significant digits and a
+    unit of one nanosecond. Bucket 0 counts the values 0 to 255 one by
+    one. Each later bucket b covers [128 << b, 256 << b) in 128 steps
+    of 1 << b, so a value is kept to within 1/128 of itself. Every
+    bucket after the first shares its lower half with the bucket
+    before, which is why each adds only 128 counters. With 35 buckets
+    the largest value kept is 2^42 - 1 nanoseconds.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+constexpr int sub_bucket_bits = 8;
+constexpr int half_bits = sub_bucket_bits - 1;
+constexpr std::uint64_t sub_bucket_mask = (1u << sub_bucket_bits) - 1;
+constexpr std::uint64_t half_count = 1u << half_bits;
+constexpr int bucket_count = 35;
+constexpr std::size_t counts_len = (bucket_count + 1) * half_count;
+constexpr std::uint64_t highest_value =
+    (std::uint64_t(1) << (bucket_count - 1 + sub_bucket_bits)) - 1;
+
+std::size_t
+index_of(std::uint64_t v) noexcept
+{
+    v = (std::min)(v, highest_value);
+    int const bucket = (64 - std::countl_zero(v | sub_bucket_mask)) -
+        sub_bucket_bits;
+    auto const sub = v >> bucket;
+    return ((static_cast<std::size_t>(bucket) + 1) << half_bits) +
+        static_cast<std::size_t>(sub - half_count);
+}
+
+// Returns the largest value counted at index `i`
+std::uint64_t
+highest_at(std::size_t i) noexcept
+{
+    int bucket = static_cast<int>(i >> half_bits) - 1;
+    std::uint64_t sub = (i & (half_count - 1)) + half_count;
+    if (bucket < 0)
+    {
+        sub -= half_count;
+        bucket = 0;
+    }
+    return (sub << bucket) + ((std::uint64_t(1) << bucket) - 1);
+}
+
+// Returns the index holding the value at `p`, and the count up to it
+std::size_t
+find_percentile(
+    std::vector<std::uint64_t> const& counts,
+    std::uint64_t total,
+    double p,
+    std::uint64_t& below) noexcept
+{
+    p = (std::clamp)(p, 0.0, 100.0);
+    auto const target = (std::max)(std::uint64_t(1),
+        static_cast<std::uint64_t>(std::ceil(p / 100.0 *
+            static_cast<double>(total))));
+    below = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        below += counts[i];
+        if (below >= target)
+            return i;
+    }
+    return counts.size() - 1;
+}
+
+} // namespace
+
+latency_histogram::
+latency_histogram()
+    : counts_(new std::atomic<std::uint64_t>[counts_len])
+    , min_((std::numeric_limits<std::uint64_t>::max)())
+{
+    for (std::size_t i = 0; i < counts_len; ++i)
+        counts_[i].store(0, std::memory_order_relaxed);
+}
+
+latency_histogram::
+~latency_histogram() = default;
+
+void
+latency_histogram::
+record(std::chrono::nanoseconds d) noexcept
+{
+    auto const v = static_cast<std::uint64_t>(
+        (std::max)(d.count(), std::chrono::nanoseconds::rep(0)));
+
+    counts_[index_of(v)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(v, std::memory_order_relaxed);
+
+    auto lo = min_.load(std::memory_order_relaxed);
+    while (v < lo &&
+        !min_.compare_exchange_weak(lo, v, std::memory_order_relaxed))
+    {
+    }
+    auto hi = max_.load(std::memory_order_relaxed);
+    while (v > hi &&
+        !max_.compare_exchange_weak(hi, v, std::memory_order_relaxed))
+    {
+    }
+
+    // Last, so a reader that sees the count sees most of the rest
+    total_.fetch_add(1, std::memory_order_release);
+}
+
+void
+latency_histogram::
+reset() noexcept
+{
+    for (std::size_t i = 0; i < counts_len; ++i)
+        counts_[i].store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store((std::numeric_limits<std::uint64_t>::max)(),
+        std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t
+latency_histogram::
+count() const noexcept
+{
+    return total_.load(std::memory_order_acquire);
+}
+
+std::chrono::nanoseconds
+latency_histogram::
+min() const noexcept
+{
+    if (count() == 0)
+        return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(min_.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds
+latency_histogram::
+max() const noexcept
+{
+    return std::chrono::nanoseconds(max_.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds
+latency_histogram::
+mean() const noexcept
+{
+    auto const n = count();
+    if (n == 0)
+        return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(
+        sum_.load(std::memory_order_relaxed) / n);
+}
+
+std::chrono::nanoseconds
+latency_histogram::
+value_at_percentile(double p) const noexcept
+{
+    p = (std::clamp)(p, 0.0, 100.0);
+    auto const total = count();
+    if (total == 0)
+        return std::chrono::nanoseconds(0);
+
+    auto const target = (std::max)(std::uint64_t(1),
+        static_cast<std::uint64_t>(std::ceil(p / 100.0 *
+            static_cast<double>(total))));
+    auto const hi = max_.load(std::memory_order_relaxed);
+    std::uint64_t below = 0;
+    for (std::size_t i = 0; i < counts_len; ++i)
+    {
+        below += counts_[i].load(std::memory_order_relaxed);
+        if (below >= target)
+            return std::chrono::nanoseconds((std::min)(highest_at(i), hi));
+    }
+    return std::chrono::nanoseconds(hi);
+}
+
+void
+latency_histogram::
+print(std::ostream& os, std::chrono::nanoseconds unit) const
+{
+    // Work from a copy so the lines agree with each other
+    std::vector<std::uint64_t> counts(counts_len);
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < counts_len; ++i)
+    {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    auto const hi = max_.load(std::memory_order_relaxed);
+    double const scale = unit.count() > 0
+        ? static_cast<double>(unit.count()) : 1.0;
+
+    char line[128];
+    auto const put = [&](int n)
+    {
+        if (n > 0)
+            os.write(line, (std::min)(n, int(sizeof(line)) - 1));
+    };
+
+    put(std::snprintf(line, sizeof(line), "%12s %14s %10s %14s\n\n",
+        "Value", "Percentile", "TotalCount", "1/(1-Percentile)"));
+
+    double mean = 0.0;
+    double sd = 0.0;
+    if (total > 0)
+    {
+        // Ticks halve the remaining distance to 100 in five steps
+        double p = 0.0;
+        for (;;)
+        {
+            std::uint64_t below = 0;
+            auto const i = find_percentile(counts, total, p, below);
+            if (below >= total)
+                break;
+            put(std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu %14.2f\n",
+                static_cast<double>((std::min)(highest_at(i), hi)) / scale,
+                p / 100.0,
+                static_cast<unsigned long long>(below),
+                1.0 / (1.0 - p / 100.0)));
+            double const ticks = 5.0 *
+                std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - p))) + 1);
+            p += 100.0 / ticks;
+        }
+        put(std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu\n",
+            static_cast<double>(hi) / scale, 1.0,
+            static_cast<unsigned long long>(total)));
+
+        mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+            static_cast<double>(total) / scale;
+        double sq = 0.0;
+        for (std::size_t i = 0; i < counts_len; ++i)
+        {
+            if (counts[i] == 0)
+                continue;
+            double const dev =
+                static_cast<double>(highest_at(i)) / scale - mean;
+            sq += dev * dev * static_cast<double>(counts[i]);
+        }
+        sd = std::sqrt(sq / static_cast<double>(total));
+    }
+
+    put(std::snprintf(line, sizeof(line),
+        "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean, sd));
+    put(std::snprintf(line, sizeof(line),
+        "#[Max     = %12.3f, Total count    = %12llu]\n",
+        static_cast<double>(hi) / scale,
+        static_cast<unsigned long long>(total)));
+    put(std::snprintf(line, sizeof(line),
+        "#[Buckets = %12d, SubBuckets     = %12d]\n",
+        bucket_count, 1 << sub_bucket_bits));
+}
+
+//------------------------------------------------------------------------------
+
+void
+hdr_op_tracer::
+on_complete(op_trace const& t) noexcept
+{
+    if (t.cancelled)
+        return;
+    if (t.parked)
+    {
+        wait.record(t.wait_time());
+        dispatch.record(t.dispatch_time());
+    }
+    queue_delay.record(t.queue_delay());
+    total.record(t.resumed - t.initiated);
+}
+
+void
+hdr_op_tracer::
+reset() noexcept
+{
+    wait.reset();
+    dispatch.reset();
+    queue_delay.reset();
+    total.reset();
+}
+
+void
+hdr_op_tracer::
+print(std::ostream& os, std::chrono::nanoseconds unit) const
+{
+    os << "# wait\n";
+    wait.print(os, unit);
+    os << "\n# dispatch\n";
+    dispatch.print(os, unit);
+    os << "\n# queue_delay\n";
+    queue_delay.print(os, unit);
+    os << "\n# total\n";
+    total.print(os, unit);
+}
+
+} // namespace boost::corosio
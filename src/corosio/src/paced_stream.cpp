@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/paced_stream.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/error.hpp>
+
+#include "src/detail/tuning.hpp"
+
+#include <algorithm>
+#include <climits>
+
+/*
+    Pacing
+    ======
+
+    A write asks the stream's bucket for up to the buffer's size,
+    then the shared bucket for up to what the first granted, and
+    gives the difference back to the first. Taking from the stream's
+    own bucket first keeps a stream that is over its own rate from
+    draining the tenant's tokens. If either grants nothing the write
+    sleeps for the longer of their waits and asks again. After the
+    write, tokens for the bytes it did not send go back to both.
+
+    A wait targets enough tokens for the whole write or a full burst,
+    not for one byte, so a starved stream wakes once per burst and
+    writes a burst at a time. The timer's slack lets the timer
+    service fold the wakeups of streams due within the same slack
+    into one; with the timing wheel, every wait is already rounded
+    to the wheel's tick.
+
+    Kernel pacing sets SO_MAX_PACING_RATE through the tuning options
+    of the socket and drops the stream's own bucket, since the send
+    buffer then holds back a writer that outruns the rate.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+std::size_t
+default_burst(std::uint64_t rate, std::size_t burst) noexcept
+{
+    if (burst)
+        return burst;
+    return static_cast<std::size_t>(
+        (std::max<std::uint64_t>)(rate / 100, 4096));
+}
+
+// Set the kernel's pacing rate, or return false if it cannot be set
+bool
+set_kernel_rate(io_stream& s, std::uint64_t rate) noexcept
+{
+    auto* sock = dynamic_cast<socket*>(&s);
+    if (!sock || !sock->is_open())
+        return false;
+    unsigned const r = rate == 0 ? UINT_MAX
+        : static_cast<unsigned>((std::min<std::uint64_t>)(
+            rate, UINT_MAX - 1));
+    return !detail::set_tuning_option(sock->native_handle(),
+        detail::tuning_option::max_pacing_rate,
+        static_cast<int>(r));
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+pacing_bucket::
+pacing_bucket(
+    std::uint64_t bytes_per_second,
+    std::size_t burst)
+    : refilled_(clock_type::now())
+{
+    set_rate(bytes_per_second, burst);
+    tokens_ = burst_;
+}
+
+void
+pacing_bucket::
+set_rate(
+    std::uint64_t bytes_per_second,
+    std::size_t burst)
+{
+    std::lock_guard lock(mutex_);
+    refill(clock_type::now());
+    rate_ = static_cast<double>(
+        (std::max<std::uint64_t>)(bytes_per_second, 1));
+    burst_ = static_cast<double>(default_burst(bytes_per_second, burst));
+    tokens_ = (std::min)(tokens_, burst_);
+}
+
+std::uint64_t
+pacing_bucket::
+rate() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return static_cast<std::uint64_t>(rate_);
+}
+
+std::size_t
+pacing_bucket::
+burst() const noexcept
+{
+    std::lock_guard lock(mutex_);
+    return static_cast<std::size_t>(burst_);
+}
+
+void
+pacing_bucket::
+refill(clock_type::time_point now) noexcept
+{
+    if (now <= refilled_)
+        return;
+    std::chrono::duration<double> const elapsed = now - refilled_;
+    tokens_ = (std::min)(burst_, tokens_ + elapsed.count() * rate_);
+    refilled_ = now;
+}
+
+std::size_t
+pacing_bucket::
+take(
+    std::size_t n,
+    clock_type::duration& wait) noexcept
+{
+    std::lock_guard lock(mutex_);
+    refill(clock_type::now());
+    if (tokens_ >= 1)
+    {
+        auto const granted = static_cast<std::size_t>(
+            (std::min)(tokens_, static_cast<double>(n)));
+        tokens_ -= static_cast<double>(granted);
+        wait = {};
+        return granted;
+    }
+    double const want = (std::min)(static_cast<double>(n), burst_);
+    wait = std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>((want - tokens_) / rate_));
+    return 0;
+}
+
+void
+pacing_bucket::
+put_back(std::size_t n) noexcept
+{
+    std::lock_guard lock(mutex_);
+    tokens_ = (std::min)(burst_, tokens_ + static_cast<double>(n));
+}
+
+//------------------------------------------------------------------------------
+
+paced_stream::
+paced_stream(
+    io_stream& s,
+    pacing_options const& opts)
+    : s_(s)
+    , timer_(s.context())
+    , shared_(opts.shared)
+{
+    timer_.set_slack(opts.slack);
+    if (opts.rate == 0)
+        return;
+    if (opts.kernel_pacing && set_kernel_rate(s_, opts.rate))
+        kernel_paced_ = true;
+    else
+        own_.emplace(opts.rate, opts.burst);
+}
+
+void
+paced_stream::
+set_rate(
+    std::uint64_t bytes_per_second,
+    std::size_t burst)
+{
+    if (kernel_paced_)
+    {
+        if (set_kernel_rate(s_, bytes_per_second))
+            return;
+        kernel_paced_ = false;
+    }
+    if (bytes_per_second == 0)
+        own_.reset();
+    else if (own_)
+        own_->set_rate(bytes_per_second, burst);
+    else
+        own_.emplace(bytes_per_second, burst);
+}
+
+capy::task<capy::io_result<std::size_t>>
+paced_stream::
+write_some(capy::const_buffer buffer)
+{
+    if (buffer.size() == 0)
+        co_return co_await s_.write_some(buffer);
+
+    std::size_t n = buffer.size();
+    for (;;)
+    {
+        pacing_bucket::clock_type::duration wait{};
+        pacing_bucket::clock_type::duration shared_wait{};
+        std::size_t granted = n;
+        if (own_)
+            granted = own_->take(granted, wait);
+        if (granted && shared_)
+        {
+            std::size_t const got = shared_->take(granted, shared_wait);
+            if (own_)
+                own_->put_back(granted - got);
+            granted = got;
+        }
+        if (granted)
+        {
+            n = granted;
+            break;
+        }
+
+        timer_.expires_after((std::max)(wait, shared_wait));
+        auto [ec] = co_await timer_.wait();
+        if (ec)
+            co_return {ec, 0};
+    }
+
+    auto [ec, sent] = co_await s_.write_some(
+        capy::const_buffer(buffer.data(), n));
+    if (sent < n)
+    {
+        if (own_)
+            own_->put_back(n - sent);
+        if (shared_)
+            shared_->put_back(n - sent);
+    }
+    co_return {ec, sent};
+}
+
+capy::task<capy::io_result<std::size_t>>
+paced_stream::
+write(capy::const_buffer buffer)
+{
+    auto const* p = static_cast<char const*>(buffer.data());
+    std::size_t total = 0;
+    while (total < buffer.size())
+    {
+        auto [ec, n] = co_await write_some(
+            capy::const_buffer(p + total, buffer.size() - total));
+        total += n;
+        if (ec)
+            co_return {ec, total};
+    }
+    co_return {{}, total};
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/parked_ops.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+#include <boost/corosio/signal_set.hpp>
+
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/timer_service.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+
+/*
+    Parked Operations
+    =================
+
+    The list is gathered from two places. The scheduler walks the
+    operations parked on descriptors, which only it can reach, and
+    the timer service walks its queues for timers with a coroutine
+    waiting. Each holds the locks its own handlers take, one
+    descriptor or queue at a time, so gathering never stops the
+    whole context; a running thread waits at most for one
+    descriptor's slots to be copied.
+
+    Both stamp the time an operation parks only on the path where it
+    parks, so an operation that completes at once costs nothing
+    extra. Callback timers, such as those of io_deadline, have no
+    coroutine and are left out.
+*/
+
+namespace boost::corosio {
+
+namespace {
+
+std::vector<parked_op>
+collect(capy::execution_context& ctx)
+{
+    std::vector<parked_op> out;
+    auto const now = std::chrono::steady_clock::now();
+    if (auto* sched = detail::io_context_access::get_scheduler(ctx))
+        sched->sample_parked(out, now);
+    if (auto* timers = ctx.find_service<detail::timer_service>())
+        timers->sample_waiters(out, now);
+    std::stable_sort(out.begin(), out.end(),
+        [](parked_op const& a, parked_op const& b)
+        {
+            return a.age > b.age;
+        });
+    return out;
+}
+
+} // namespace
+
+char const*
+to_string(parked_kind k) noexcept
+{
+    switch (k)
+    {
+    case parked_kind::read:         return "read";
+    case parked_kind::write:        return "write";
+    case parked_kind::connect:      return "connect";
+    case parked_kind::accept:       return "accept";
+    case parked_kind::timer:        return "timer";
+    case parked_kind::server_pop:   return "server_pop";
+    case parked_kind::server_admit: return "server_admit";
+    }
+    return "unknown";
+}
+
+std::vector<parked_op>
+parked_ops(basic_io_context& ctx)
+{
+    return collect(ctx);
+}
+
+void
+print_parked_ops(
+    std::ostream& os,
+    std::vector<parked_op> const& ops)
+{
+    constexpr std::size_t kinds =
+        static_cast<std::size_t>(parked_kind::server_admit) + 1;
+    std::size_t counts[kinds] = {};
+    for (auto const& op : ops)
+        ++counts[static_cast<std::size_t>(op.kind)];
+
+    os << ops.size() << " parked:";
+    for (std::size_t i = 0; i < kinds; ++i)
+        if (counts[i])
+            os << ' ' << to_string(static_cast<parked_kind>(i))
+               << '=' << counts[i];
+    os << '\n';
+
+    for (auto const& op : ops)
+    {
+        os << "  " << to_string(op.kind) << " fd=" << op.fd << " age="
+           << std::chrono::duration_cast<std::chrono::microseconds>(
+                  op.age).count()
+           << "us coro=" << op.coroutine << '\n';
+    }
+    os.flush();
+}
+
+capy::task<>
+dump_parked_ops_on(
+    signal_set& signals,
+    std::ostream& os)
+{
+    for (;;)
+    {
+        auto [ec, signum] = co_await signals.async_wait();
+        if (ec)
+            co_return;
+        (void)signum;
+        print_parked_ops(os, collect(signals.context()));
+    }
+}
+
+} // namespace boost::corosio
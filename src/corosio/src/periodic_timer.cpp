@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/periodic_timer.hpp>
+
+#include <boost/corosio/detail/except.hpp>
+
+namespace boost::corosio {
+
+namespace detail {
+
+// Defined in timer_service.cpp
+extern timer::timer_impl* timer_service_create(capy::execution_context&);
+extern void timer_service_destroy(timer::timer_impl&) noexcept;
+extern timer::time_point timer_service_expiry(timer::timer_impl&) noexcept;
+extern void timer_service_cancel(timer::timer_impl&) noexcept;
+extern void timer_service_start_periodic(
+    timer::timer_impl&, timer::time_point, timer::duration);
+extern void timer_service_start_periodic_after(
+    timer::timer_impl&, timer::duration);
+extern timer::duration timer_service_period(timer::timer_impl&) noexcept;
+extern void timer_service_wait_periodic(
+    timer::timer_impl&,
+    std::coroutine_handle<>,
+    capy::executor_ref,
+    std::stop_token,
+    system::error_code*,
+    std::uint64_t*);
+
+} // namespace detail
+
+periodic_timer::
+~periodic_timer()
+{
+    if (impl_)
+        detail::timer_service_destroy(get());
+}
+
+periodic_timer::
+periodic_timer(capy::execution_context& ctx)
+    : io_object(ctx)
+{
+    impl_ = detail::timer_service_create(ctx);
+}
+
+periodic_timer::
+periodic_timer(periodic_timer&& other) noexcept
+    : io_object(other.context())
+{
+    impl_ = other.impl_;
+    other.impl_ = nullptr;
+}
+
+periodic_timer&
+periodic_timer::
+operator=(periodic_timer&& other)
+{
+    if (this != &other)
+    {
+        if (ctx_ != other.ctx_)
+            detail::throw_logic_error(
+                "cannot move periodic_timer across execution contexts");
+        if (impl_)
+            detail::timer_service_destroy(get());
+        impl_ = other.impl_;
+        other.impl_ = nullptr;
+    }
+    return *this;
+}
+
+void
+periodic_timer::
+start(time_point first, duration period)
+{
+    if (period <= duration::zero())
+        detail::throw_logic_error("periodic_timer period must be positive");
+    detail::timer_service_start_periodic(get(), first, period);
+}
+
+void
+periodic_timer::
+start(duration period)
+{
+    if (period <= duration::zero())
+        detail::throw_logic_error("periodic_timer period must be positive");
+    detail::timer_service_start_periodic_after(get(), period);
+}
+
+void
+periodic_timer::
+cancel()
+{
+    detail::timer_service_cancel(get());
+}
+
+periodic_timer::duration
+periodic_timer::
+period() const noexcept
+{
+    return detail::timer_service_period(get());
+}
+
+periodic_timer::time_point
+periodic_timer::
+expiry() const noexcept
+{
+    return detail::timer_service_expiry(get());
+}
+
+void
+periodic_timer::
+do_wait(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::stop_token token,
+    system::error_code* ec,
+    std::uint64_t* missed)
+{
+    detail::timer_service_wait_periodic(
+        get(), h, ex, std::move(token), ec, missed);
+}
+
+} // namespace boost::corosio
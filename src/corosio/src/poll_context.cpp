@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/poll_context.hpp>
+
+#if BOOST_COROSIO_HAS_POLL
+
+#include "src/detail/poll/scheduler.hpp"
+#include "src/detail/poll/sockets.hpp"
+#include "src/detail/poll/acceptors.hpp"
+
+#include <thread>
+
+namespace boost::corosio {
+
+poll_context::
+poll_context()
+    : poll_context(std::thread::hardware_concurrency())
+{
+}
+
+poll_context::
+poll_context(
+    unsigned concurrency_hint)
+{
+    sched_ = &make_service<detail::poll_scheduler>(
+        static_cast<int>(concurrency_hint));
+
+    // Install socket/acceptor services.
+    // These use socket_service and acceptor_service as key_type,
+    // enabling runtime polymorphism.
+    make_service<detail::poll_socket_service>();
+    make_service<detail::poll_acceptor_service>();
+}
+
+poll_context::
+~poll_context()
+{
+    shutdown();
+    destroy();
+}
+
+} // namespace boost::corosio
+
+#endif // BOOST_COROSIO_HAS_POLL
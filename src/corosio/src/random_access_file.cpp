@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/random_access_file.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/file_service.hpp"
+
+namespace boost::corosio {
+
+random_access_file::
+~random_access_file()
+{
+    close();
+}
+
+random_access_file::
+random_access_file(
+    capy::execution_context& ctx)
+    : io_object(ctx)
+{
+}
+
+void
+random_access_file::
+open(std::string_view path, flags open_flags)
+{
+    close();
+
+    // The scheduler installs the backend's file service
+    auto* svc = detail::find_deferred_service<detail::file_service>(
+        *ctx_, detail::deferred_service::file);
+    if (!svc)
+        detail::throw_logic_error(
+            "random_access_file::open: no file service installed");
+    auto& impl = svc->create_random_access_impl();
+    impl_ = &impl;
+    system::error_code ec = impl.open(path, open_flags);
+    if (ec)
+    {
+        impl.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "random_access_file::open");
+    }
+}
+
+void
+random_access_file::
+close()
+{
+    if (!impl_)
+        return;
+    impl_->release();
+    impl_ = nullptr;
+}
+
+void
+random_access_file::
+cancel()
+{
+    if (impl_)
+        get().cancel();
+}
+
+native_file_type
+random_access_file::
+native_handle() const noexcept
+{
+    if (!impl_)
+    {
+#if BOOST_COROSIO_HAS_IOCP
+        return reinterpret_cast<native_file_type>(~std::uintptr_t(0));
+#else
+        return -1;
+#endif
+    }
+    return get().native_handle();
+}
+
+std::uint64_t
+random_access_file::
+size() const
+{
+    if (!impl_)
+        detail::throw_logic_error("size: file not open");
+    system::error_code ec;
+    auto n = get().size(ec);
+    if (ec)
+        detail::throw_system_error(ec, "random_access_file::size");
+    return n;
+}
+
+void
+random_access_file::
+resize(std::uint64_t n)
+{
+    if (!impl_)
+        detail::throw_logic_error("resize: file not open");
+    auto ec = get().resize(n);
+    if (ec)
+        detail::throw_system_error(ec, "random_access_file::resize");
+}
+
+void
+random_access_file::
+sync_all()
+{
+    if (!impl_)
+        detail::throw_logic_error("sync_all: file not open");
+    auto ec = get().sync_all();
+    if (ec)
+        detail::throw_system_error(ec, "random_access_file::sync_all");
+}
+
+void
+random_access_file::
+sync_data()
+{
+    if (!impl_)
+        detail::throw_logic_error("sync_data: file not open");
+    auto ec = get().sync_data();
+    if (ec)
+        detail::throw_system_error(ec, "random_access_file::sync_data");
+}
+
+} // namespace boost::corosio
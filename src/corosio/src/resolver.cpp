@@ -10,10 +10,13 @@
 #include <boost/corosio/resolver.hpp>
 #include <boost/corosio/detail/platform.hpp>
 
+#include "src/detail/deferred_service.hpp"
+
 #if BOOST_COROSIO_HAS_IOCP
 #include "src/detail/iocp/resolver_service.hpp"
 #elif BOOST_COROSIO_POSIX
 #include "src/detail/posix/resolver_service.hpp"
+#include "src/detail/dns_resolver.hpp"
 #endif
 
 #include <stdexcept>
@@ -27,12 +30,30 @@
     - Windows: win_resolver_service (uses GetAddrInfoExW)
     - POSIX: posix_resolver_service (uses getaddrinfo + worker threads)
 
-    The resolver constructor uses find_service() to locate the resolver
-    service, which must have been previously created by the scheduler
-    during io_context construction. If not found, construction fails.
+    The resolver constructor uses find_deferred_service() to locate the
+    resolver service, which the scheduler either created during
+    io_context construction or creates on this first use. If neither,
+    construction fails.
 
     This separation allows the public API to be platform-agnostic while
     the implementation details are hidden in the detail namespace.
+
+    set_resolver_cache() configures the DNS caches of the service. The
+    Windows service keeps only the reverse cache; its forward lookups
+    share flights instead.
+
+    set_backend(resolver_backend::dns) gives the resolver a
+    dns_resolver, which forward resolves then go through, passing it
+    the service's implementation for the names it leaves to the
+    system resolver. Windows has no datagram sockets yet, so there
+    the backend stays the system one.
+
+    With set_memory_resource(), answers from the DNS backend are built
+    in the resource directly. The system backend's lookups are shared
+    between resolves and with the cache, and built on the worker
+    threads, so those are left on the heap and resolve_awaitable
+    copies them into the resource when the coroutine resumes, on the
+    context's thread, where a resource without locking is safe.
 */
 
 namespace boost::corosio {
@@ -49,6 +70,8 @@ using resolver_service = detail::posix_resolver_service;
 resolver::
 ~resolver()
 {
+    if (dns_)
+        dns_->cancel();
     if (impl_)
         impl_->release();
 }
@@ -58,12 +81,13 @@ resolver(
     capy::execution_context& ctx)
     : io_object(ctx)
 {
-    auto* svc = ctx_->find_service<resolver_service>();
+    auto* svc = detail::find_deferred_service<resolver_service>(
+        *ctx_, detail::deferred_service::resolver);
     if (!svc)
     {
-        // Resolver service not yet created - this happens if io_context
-        // hasn't been constructed yet, or if the scheduler didn't
-        // initialize the resolver service
+        // Resolver service neither created by the scheduler nor
+        // deferred by it - this happens if io_context hasn't been
+        // constructed yet
         throw std::runtime_error("resolver_service not found");
     }
     auto& impl = svc->create_impl();
@@ -74,8 +98,58 @@ void
 resolver::
 cancel()
 {
+    if (dns_)
+        dns_->cancel();
     if (impl_)
         get().cancel();
 }
 
+void
+resolver::
+set_backend(resolver_backend b)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    (void)b;
+#elif BOOST_COROSIO_POSIX
+    if (b == resolver_backend::system)
+        dns_.reset();
+    else if (!dns_)
+        dns_ = std::make_shared<detail::dns_resolver>(*ctx_);
+#endif
+}
+
+bool
+resolver::
+resolve_dns(
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::string_view host,
+    std::string_view service,
+    resolve_flags flags,
+    std::stop_token token,
+    system::error_code* ec,
+    resolver_results* out)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    // Not reached: set_backend never installs a dns_resolver here
+    get().resolve(h, ex, host, service, flags, token, ec, out);
+    return false;
+#elif BOOST_COROSIO_POSIX
+    return dns_->resolve(get(), h, ex, host, service, flags,
+        std::move(token), ec, out, memory_resource());
+#endif
+}
+
+void
+set_resolver_cache(
+    capy::execution_context& ctx,
+    resolver_cache_options const& opts)
+{
+    auto* svc = detail::find_deferred_service<resolver_service>(
+        ctx, detail::deferred_service::resolver);
+    if (!svc)
+        throw std::runtime_error("resolver_service not found");
+    svc->set_cache(opts);
+}
+
 } // namespace boost::corosio
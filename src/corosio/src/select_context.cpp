@@ -28,6 +28,14 @@ select_context()
 select_context::
 select_context(
     unsigned concurrency_hint)
+    : select_context(concurrency_hint, select_options{})
+{
+}
+
+select_context::
+select_context(
+    unsigned concurrency_hint,
+    select_options const& opts)
 {
     sched_ = &make_service<detail::select_scheduler>(
         static_cast<int>(concurrency_hint));
@@ -36,7 +44,7 @@ select_context(
     // These use socket_service and acceptor_service as key_type,
     // enabling runtime polymorphism.
     make_service<detail::select_socket_service>();
-    make_service<detail::select_acceptor_service>();
+    make_service<detail::select_acceptor_service>(opts.accept_backlog);
 }
 
 select_context::
@@ -10,16 +10,617 @@
 #include <boost/corosio/socket.hpp>
 #include <boost/corosio/detail/except.hpp>
 #include <boost/corosio/detail/platform.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include "src/detail/make_err.hpp"
+#include "src/detail/resume_coro.hpp"
+#include "src/detail/tcp_info.hpp"
+#include "src/detail/tuning.hpp"
 
 #if BOOST_COROSIO_HAS_IOCP
 #include "src/detail/iocp/sockets.hpp"
 #else
 // POSIX backends use the abstract socket_service interface
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/endpoint_convert.hpp"
 #include "src/detail/socket_service.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <memory>
+
 namespace boost::corosio {
 
+namespace {
+
+void
+set_tuning(
+    native_handle_type fd,
+    detail::tuning_option opt,
+    int value,
+    char const* what)
+{
+    system::error_code ec = detail::set_tuning_option(fd, opt, value);
+    if (ec)
+        detail::throw_system_error(ec, what);
+}
+
+int
+get_tuning(
+    native_handle_type fd,
+    detail::tuning_option opt,
+    char const* what)
+{
+    int value = 0;
+    system::error_code ec = detail::get_tuning_option(fd, opt, value);
+    if (ec)
+        detail::throw_system_error(ec, what);
+    return value;
+}
+
+// The buffer of the read-and-write send_file
+constexpr std::size_t send_file_chunk = 65536;
+
+// Read up to `n` bytes of a file at `offset`, without its position
+std::size_t
+read_file_at(
+    native_file_type file,
+    std::uint64_t offset,
+    char* p,
+    std::size_t n,
+    system::error_code& ec)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    // The event keeps the wait local should the file be associated
+    // with a completion port
+    OVERLAPPED ov{};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    ov.hEvent = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!ov.hEvent)
+    {
+        ec = detail::make_err(::GetLastError());
+        return 0;
+    }
+    ov.hEvent = reinterpret_cast<HANDLE>(
+        reinterpret_cast<std::uintptr_t>(ov.hEvent) | 1);
+    DWORD got = 0;
+    BOOL ok = ::ReadFile(file, p, static_cast<DWORD>(n), &got, &ov);
+    if (!ok && ::GetLastError() == ERROR_IO_PENDING)
+        ok = ::GetOverlappedResult(file, &ov, &got, TRUE);
+    DWORD err = ok ? 0 : ::GetLastError();
+    ::CloseHandle(reinterpret_cast<HANDLE>(
+        reinterpret_cast<std::uintptr_t>(ov.hEvent) & ~std::uintptr_t(1)));
+    if (err == ERROR_HANDLE_EOF)
+        return 0;
+    if (err)
+    {
+        ec = detail::make_err(err);
+        return 0;
+    }
+    return got;
+#else
+    for (;;)
+    {
+        ssize_t r = ::pread(file, p, n, static_cast<off_t>(offset));
+        if (r >= 0)
+            return static_cast<std::size_t>(r);
+        if (errno != EINTR)
+        {
+            ec = detail::make_err(errno);
+            return 0;
+        }
+    }
+#endif
+}
+
+// One write_all on an impl, inside a coroutine
+struct write_all_op
+{
+    socket::socket_impl& impl_;
+    capy::const_buffer buf_;
+    mutable system::error_code ec_;
+    mutable std::size_t n_ = 0;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<std::size_t> await_resume() const noexcept
+    {
+        return {ec_, n_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        if (impl_.write_all(h, ex, buf_, token, &ec_, &n_))
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+// One connect on an impl, inside a coroutine
+struct connect_op
+{
+    socket::socket_impl& impl_;
+    endpoint ep_;
+    mutable system::error_code ec_;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<> await_resume() const noexcept
+    {
+        return {ec_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        impl_.connect(h, ex, ep_, token, &ec_);
+        return std::noop_coroutine();
+    }
+};
+
+// One write_some on an impl, inside a coroutine
+struct write_some_op
+{
+    socket::socket_impl& impl_;
+    capy::const_buffer buf_;
+    mutable system::error_code ec_;
+    mutable std::size_t n_ = 0;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<std::size_t> await_resume() const noexcept
+    {
+        return {ec_, n_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        if (impl_.write_some(h, ex, buf_, token, &ec_, &n_))
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+capy::task<>
+do_connect_then_write(
+    socket::socket_impl& impl,
+    endpoint ep,
+    capy::const_buffer data,
+    system::error_code* ec_out,
+    std::size_t* bytes_out,
+    std::coroutine_handle<> continuation,
+    capy::executor_ref ex)
+{
+    std::size_t sent = 0;
+    auto [ec] = co_await connect_op{impl, ep};
+    if (!ec && data.size() > 0)
+    {
+        // With a deferred connect, a refused handshake shows here
+        auto [e, n] = co_await write_some_op{impl, data};
+        ec = e;
+        if (!e)
+            sent = n;
+    }
+
+    *ec_out = ec;
+    *bytes_out = sent;
+
+    detail::resume_coro(ex, continuation);
+}
+
+// One wait on an impl, inside a coroutine
+struct wait_op
+{
+    socket::socket_impl& impl_;
+    socket::wait_type w_;
+    mutable system::error_code ec_;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<> await_resume() const noexcept
+    {
+        return {ec_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        if (impl_.wait(h, ex, w_, token, &ec_))
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+// One read_some on an impl, inside a coroutine
+struct read_some_op
+{
+    socket::socket_impl& impl_;
+    capy::mutable_buffer buf_;
+    mutable system::error_code ec_;
+    mutable std::size_t n_ = 0;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    capy::io_result<std::size_t> await_resume() const noexcept
+    {
+        return {ec_, n_};
+    }
+
+    auto await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token token) -> std::coroutine_handle<>
+    {
+        if (impl_.read_some(h, ex, buf_, token, &ec_, &n_))
+            return h;
+        return std::noop_coroutine();
+    }
+};
+
+capy::task<>
+do_read_when_ready(
+    socket::socket_impl& impl,
+    buffer_pool& pool,
+    std::size_t size,
+    system::error_code* ec_out,
+    buffer_lease* lease_out,
+    std::coroutine_handle<> continuation,
+    capy::executor_ref ex)
+{
+    auto [ec] = co_await wait_op{impl, socket::wait_type::read};
+    if (ec == system::errc::operation_not_supported)
+        ec = {};
+    if (!ec)
+    {
+        buffer_lease lease = pool.acquire(size);
+        auto [e, n] = co_await read_some_op{
+            impl, capy::mutable_buffer(lease)};
+        ec = e;
+        if (!ec)
+        {
+            lease.shrink(n);
+            *lease_out = std::move(lease);
+        }
+    }
+
+    *ec_out = ec;
+
+    detail::resume_coro(ex, continuation);
+}
+
+capy::task<>
+do_send_file_copy(
+    socket::socket_impl& impl,
+    native_file_type file,
+    std::uint64_t offset,
+    std::size_t count,
+    system::error_code* ec_out,
+    std::size_t* bytes_out,
+    std::coroutine_handle<> continuation,
+    capy::executor_ref ex)
+{
+    system::error_code ec;
+    std::size_t total = 0;
+    std::unique_ptr<char[]> buf(
+        new char[(std::min)(count, send_file_chunk)]);
+
+    while (total < count)
+    {
+        std::size_t n = read_file_at(file, offset + total, buf.get(),
+            (std::min)(count - total, send_file_chunk), ec);
+        if (ec)
+            break;
+        if (n == 0)
+        {
+            ec = capy::error::eof;
+            break;
+        }
+
+        auto [e, sent] = co_await write_all_op{
+            impl, capy::const_buffer(buf.get(), n)};
+        total += sent;
+        if (e)
+        {
+            ec = e;
+            break;
+        }
+    }
+
+    *ec_out = ec;
+    *bytes_out = total;
+
+    detail::resume_coro(ex, continuation);
+}
+
+// The buffer of a relay that does not splice
+constexpr std::size_t relay_chunk = 65536;
+
+#if !BOOST_COROSIO_HAS_IOCP && defined(__linux__)
+
+// Pipes emptied by this thread's relays, reused by its next ones.
+// A relay ends only when its pipe is drained or has failed, so a
+// pipe is never shared by two relays in flight.
+struct pipe_cache
+{
+    std::array<std::array<int, 2>, 16> pipes;
+    std::size_t size = 0;
+
+    ~pipe_cache()
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            ::close(pipes[i][0]);
+            ::close(pipes[i][1]);
+        }
+    }
+};
+
+thread_local pipe_cache this_thread_pipes;
+
+// The pipe of one relay, cached again if it ends empty
+struct relay_pipe
+{
+    std::array<int, 2> fds{-1, -1};
+    std::size_t pending = 0;
+
+    relay_pipe() = default;
+    relay_pipe(relay_pipe const&) = delete;
+    relay_pipe& operator=(relay_pipe const&) = delete;
+
+    ~relay_pipe()
+    {
+        if (fds[0] < 0)
+            return;
+        auto& c = this_thread_pipes;
+        if (pending == 0 && c.size < c.pipes.size())
+        {
+            c.pipes[c.size++] = fds;
+            return;
+        }
+        // Bytes left in the pipe are lost with it
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    bool acquire() noexcept
+    {
+        auto& c = this_thread_pipes;
+        if (c.size > 0)
+        {
+            fds = c.pipes[--c.size];
+            return true;
+        }
+        int p[2];
+        if (::pipe2(p, O_CLOEXEC | O_NONBLOCK) != 0)
+            return false;
+        fds = {p[0], p[1]};
+        return true;
+    }
+};
+
+#endif
+
+capy::task<>
+do_relay(
+    socket::socket_impl& src,
+    socket::socket_impl& dst,
+    std::size_t max,
+    system::error_code* ec_out,
+    std::size_t* bytes_out,
+    std::coroutine_handle<> continuation,
+    capy::executor_ref ex)
+{
+    system::error_code ec;
+    std::size_t moved = 0;
+
+    // No pipe or buffer is held while the source is idle
+    auto [e] = co_await wait_op{src, socket::wait_type::read};
+    bool buffered = e == system::errc::operation_not_supported;
+    if (!buffered)
+        ec = e;
+
+#if !BOOST_COROSIO_HAS_IOCP && defined(__linux__)
+    relay_pipe pipe;
+    if (!ec && !buffered && !pipe.acquire())
+        buffered = true;
+
+    while (!ec && !buffered)
+    {
+        ssize_t n = ::splice(src.native_handle(), nullptr,
+            pipe.fds[1], nullptr, max,
+            SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n > 0)
+        {
+            pipe.pending = static_cast<std::size_t>(n);
+            break;
+        }
+        if (n == 0)
+            ec = capy::error::eof;
+        else if (errno == EINVAL)
+            buffered = true;    // the socket type cannot splice
+        else if (errno == EAGAIN)
+        {
+            // The readiness was spurious
+            auto [e2] = co_await wait_op{src, socket::wait_type::read};
+            ec = e2;
+        }
+        else if (errno != EINTR)
+            ec = detail::make_err(errno);
+    }
+
+    while (!ec && pipe.pending > 0)
+    {
+        ssize_t n = ::splice(pipe.fds[0], nullptr,
+            dst.native_handle(), nullptr, pipe.pending,
+            SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n > 0)
+        {
+            pipe.pending -= static_cast<std::size_t>(n);
+            moved += static_cast<std::size_t>(n);
+        }
+        else if (n < 0 && errno == EAGAIN)
+        {
+            auto [e2] = co_await wait_op{dst, socket::wait_type::write};
+            ec = e2;
+        }
+        else if (n == 0 || errno != EINTR)
+            ec = detail::make_err(n < 0 ? errno : EIO);
+    }
+#else
+    // Without splice(2) every relay goes through a buffer
+    buffered = true;
+#endif
+
+    if (!ec && buffered)
+    {
+        std::size_t const size = (std::min)(max, relay_chunk);
+        std::unique_ptr<char[]> buf(new char[size]);
+        auto [e2, n] = co_await read_some_op{
+            src, capy::mutable_buffer(buf.get(), size)};
+        ec = e2;
+        if (!ec)
+        {
+            auto [e3, sent] = co_await write_all_op{
+                dst, capy::const_buffer(buf.get(), n)};
+            ec = e3;
+            moved = sent;
+        }
+    }
+
+    *ec_out = ec;
+    *bytes_out = moved;
+
+    detail::resume_coro(ex, continuation);
+}
+
+} // namespace
+
+bool
+socket::
+send_file_copy(
+    socket_impl& impl,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    native_file_type file,
+    std::uint64_t offset,
+    std::size_t count,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    if (count == 0)
+    {
+        *ec = {};
+        *bytes = 0;
+        return true;
+    }
+
+    capy::run_async(ex, token)(do_send_file_copy(
+        impl, file, offset, count, ec, bytes, h, ex));
+    return false;
+}
+
+bool
+socket::
+relay(
+    socket_impl& src,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    socket_impl& dst,
+    std::size_t max,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+    if (max == 0)
+    {
+        *ec = {};
+        *bytes = 0;
+        return true;
+    }
+
+    capy::run_async(ex, token)(do_relay(
+        src, dst, max, ec, bytes, h, ex));
+    return false;
+}
+
+void
+socket::
+connect_then_write(
+    socket_impl& impl,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    endpoint ep,
+    capy::const_buffer data,
+    std::stop_token token,
+    system::error_code* ec,
+    std::size_t* bytes)
+{
+#if defined(TCP_FASTOPEN_CONNECT)
+    // connect() returns at once when a cookie is cached, and the
+    // first write sends the SYN with the data. Best effort: without
+    // kernel support the connect is an ordinary one.
+    int one = 1;
+    ::setsockopt(impl.native_handle(), IPPROTO_TCP,
+        TCP_FASTOPEN_CONNECT, &one, sizeof(one));
+#endif
+
+    capy::run_async(ex, token)(do_connect_then_write(
+        impl, ep, data, ec, bytes, h, ex));
+}
+
+void
+socket::
+read_when_ready(
+    socket_impl& impl,
+    std::coroutine_handle<> h,
+    capy::executor_ref ex,
+    std::size_t size,
+    std::stop_token token,
+    system::error_code* ec,
+    buffer_lease* lease)
+{
+    // The pool belongs to the context the continuation runs on
+    capy::run_async(ex, token)(do_read_when_ready(
+        impl, get_buffer_pool(ex.context()), size, ec, lease, h, ex));
+}
+
 socket::
 ~socket()
 {
@@ -35,7 +636,7 @@ socket(
 
 void
 socket::
-open()
+open(ip_family family)
 {
     if (impl_)
         return;
@@ -44,17 +645,18 @@ open()
     auto& svc = ctx_->use_service<detail::win_sockets>();
     auto& wrapper = svc.create_impl();
     impl_ = &wrapper;
-    system::error_code ec = svc.open_socket(*wrapper.get_internal());
+    system::error_code ec = svc.open_socket(*wrapper.get_internal(), family);
 #else
     // POSIX backends use abstract socket_service for runtime polymorphism.
-    // The concrete service (epoll_sockets or select_sockets) must be installed
-    // by the context constructor before any socket operations.
-    auto* svc = ctx_->find_service<detail::socket_service>();
+    // The concrete service is installed by the context constructor, or
+    // made here on first use if the backend defers it.
+    auto* svc = detail::find_deferred_service<detail::socket_service>(
+        *ctx_, detail::deferred_service::socket);
     if (!svc)
         detail::throw_logic_error("socket::open: no socket service installed");
     auto& wrapper = svc->create_impl();
     impl_ = &wrapper;
-    system::error_code ec = svc->open_socket(wrapper);
+    system::error_code ec = svc->open_socket(wrapper, family);
 #endif
     if (ec)
     {
@@ -76,6 +678,104 @@ close()
     impl_ = nullptr;
 }
 
+void
+socket::
+rebind(capy::execution_context& ctx)
+{
+    if (&ctx == ctx_)
+        return;
+    if (!impl_)
+    {
+        rebind_context(ctx);
+        return;
+    }
+
+#if BOOST_COROSIO_HAS_IOCP
+    // A handle stays bound to the completion port it was first
+    // associated with
+    detail::throw_system_error(
+        make_error_code(system::errc::operation_not_supported),
+        "socket::rebind");
+#else
+    auto* svc = detail::find_deferred_service<detail::socket_service>(
+        ctx, detail::deferred_service::socket);
+    if (!svc)
+        detail::throw_logic_error("socket::rebind: no socket service installed");
+
+    // The duplicate keeps the connection open while the original
+    // descriptor leaves its reactor and is closed
+    int fd = ::fcntl(native_handle(), F_DUPFD_CLOEXEC, 0);
+    if (fd < 0)
+        detail::throw_system_error(detail::make_err(errno), "socket::rebind");
+
+    auto& wrapper = svc->create_impl();
+    system::error_code ec = svc->assign_socket(
+        wrapper, fd, local_endpoint(), remote_endpoint());
+    if (ec)
+    {
+        wrapper.release();
+        detail::throw_system_error(ec, "socket::rebind");
+    }
+
+    close();
+    impl_ = &wrapper;
+    rebind_context(ctx);
+#endif
+}
+
+void
+socket::
+assign(native_handle_type h)
+{
+    if (impl_)
+        close();
+
+#if BOOST_COROSIO_HAS_IOCP
+    (void)h;
+    detail::throw_system_error(
+        make_error_code(system::errc::operation_not_supported),
+        "socket::assign");
+#else
+    auto* svc = detail::find_deferred_service<detail::socket_service>(
+        *ctx_, detail::deferred_service::socket);
+    if (!svc)
+    {
+        ::close(h);
+        detail::throw_logic_error("socket::assign: no socket service installed");
+    }
+
+    int flags = ::fcntl(h, F_GETFL, 0);
+    if (flags < 0 ||
+        ::fcntl(h, F_SETFL, flags | O_NONBLOCK) < 0 ||
+        ::fcntl(h, F_SETFD, FD_CLOEXEC) < 0)
+    {
+        int errn = errno;
+        ::close(h);
+        detail::throw_system_error(detail::make_err(errn), "socket::assign");
+    }
+
+    // Non-IP sockets, such as the ends of a socketpair, report
+    // default endpoints
+    sockaddr_storage local{};
+    sockaddr_storage remote{};
+    socklen_t len = sizeof(local);
+    ::getsockname(h, reinterpret_cast<sockaddr*>(&local), &len);
+    len = sizeof(remote);
+    ::getpeername(h, reinterpret_cast<sockaddr*>(&remote), &len);
+
+    auto& wrapper = svc->create_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->assign_socket(wrapper, h,
+        detail::from_sockaddr(local), detail::from_sockaddr(remote));
+    if (ec)
+    {
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "socket::assign");
+    }
+#endif
+}
+
 void
 socket::
 cancel()
@@ -237,6 +937,319 @@ linger() const
     return result;
 }
 
+void
+socket::
+set_not_sent_low_watermark(std::size_t bytes)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_not_sent_low_watermark: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::not_sent_low_watermark,
+        static_cast<int>((std::min)(bytes, std::size_t(INT_MAX))),
+        "socket::set_not_sent_low_watermark");
+}
+
+std::size_t
+socket::
+not_sent_low_watermark() const
+{
+    if (!impl_)
+        detail::throw_logic_error("not_sent_low_watermark: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::not_sent_low_watermark,
+        "socket::not_sent_low_watermark");
+    return static_cast<std::size_t>(static_cast<unsigned>(value));
+}
+
+void
+socket::
+set_quick_ack(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_quick_ack: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::quick_ack,
+        enabled ? 1 : 0,
+        "socket::set_quick_ack");
+}
+
+bool
+socket::
+quick_ack() const
+{
+    if (!impl_)
+        detail::throw_logic_error("quick_ack: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::quick_ack,
+        "socket::quick_ack");
+    return value != 0;
+}
+
+void
+socket::
+set_user_timeout(std::chrono::milliseconds timeout)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_user_timeout: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::user_timeout,
+        static_cast<int>(timeout.count()),
+        "socket::set_user_timeout");
+}
+
+std::chrono::milliseconds
+socket::
+user_timeout() const
+{
+    if (!impl_)
+        detail::throw_logic_error("user_timeout: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::user_timeout,
+        "socket::user_timeout");
+    return std::chrono::milliseconds(static_cast<unsigned>(value));
+}
+
+void
+socket::
+set_incoming_cpu(int cpu)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_incoming_cpu: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::incoming_cpu,
+        cpu,
+        "socket::set_incoming_cpu");
+}
+
+int
+socket::
+incoming_cpu() const
+{
+    if (!impl_)
+        detail::throw_logic_error("incoming_cpu: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::incoming_cpu,
+        "socket::incoming_cpu");
+    return value;
+}
+
+void
+socket::
+set_priority(int priority)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_priority: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::priority,
+        priority,
+        "socket::set_priority");
+}
+
+int
+socket::
+priority() const
+{
+    if (!impl_)
+        detail::throw_logic_error("priority: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::priority,
+        "socket::priority");
+    return value;
+}
+
+void
+socket::
+set_busy_poll(std::chrono::microseconds duration)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_busy_poll: socket not open");
+    set_tuning(get().native_handle(),
+        detail::tuning_option::busy_poll,
+        static_cast<int>(duration.count()),
+        "socket::set_busy_poll");
+}
+
+std::chrono::microseconds
+socket::
+busy_poll() const
+{
+    if (!impl_)
+        detail::throw_logic_error("busy_poll: socket not open");
+    int value = get_tuning(get().native_handle(),
+        detail::tuning_option::busy_poll,
+        "socket::busy_poll");
+    return std::chrono::microseconds(value);
+}
+
+// The option holds an unsigned int, whose largest value means no cap
+void
+socket::
+set_max_pacing_rate(std::uint64_t bytes_per_second)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_max_pacing_rate: socket not open");
+    unsigned const rate = bytes_per_second == 0 ? UINT_MAX
+        : static_cast<unsigned>((std::min<std::uint64_t>)(
+            bytes_per_second, UINT_MAX - 1));
+    set_tuning(get().native_handle(),
+        detail::tuning_option::max_pacing_rate,
+        static_cast<int>(rate),
+        "socket::set_max_pacing_rate");
+}
+
+std::uint64_t
+socket::
+max_pacing_rate() const
+{
+    if (!impl_)
+        detail::throw_logic_error("max_pacing_rate: socket not open");
+    unsigned const rate = static_cast<unsigned>(get_tuning(
+        get().native_handle(),
+        detail::tuning_option::max_pacing_rate,
+        "socket::max_pacing_rate"));
+    return rate == UINT_MAX ? 0 : rate;
+}
+
+void
+socket::
+set_zero_copy(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_zero_copy: socket not open");
+    system::error_code ec = get().set_zero_copy(enabled);
+    if (ec)
+        detail::throw_system_error(ec, "socket::set_zero_copy");
+}
+
+bool
+socket::
+zero_copy() const
+{
+    if (!impl_)
+        detail::throw_logic_error("zero_copy: socket not open");
+    system::error_code ec;
+    bool result = get().zero_copy(ec);
+    if (ec)
+        detail::throw_system_error(ec, "socket::zero_copy");
+    return result;
+}
+
+void
+socket::
+set_high_priority_completions(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error(
+            "set_high_priority_completions: socket not open");
+    system::error_code ec = get().set_high_priority_completions(enabled);
+    if (ec)
+        detail::throw_system_error(ec,
+            "socket::set_high_priority_completions");
+}
+
+bool
+socket::
+high_priority_completions() const
+{
+    if (!impl_)
+        detail::throw_logic_error(
+            "high_priority_completions: socket not open");
+    system::error_code ec;
+    bool result = get().high_priority_completions(ec);
+    if (ec)
+        detail::throw_system_error(ec, "socket::high_priority_completions");
+    return result;
+}
+
+void
+socket::
+set_write_coalescing(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_write_coalescing: socket not open");
+    system::error_code ec = get().set_write_coalescing(enabled);
+    if (ec)
+        detail::throw_system_error(ec, "socket::set_write_coalescing");
+}
+
+bool
+socket::
+write_coalescing() const
+{
+    if (!impl_)
+        detail::throw_logic_error("write_coalescing: socket not open");
+    system::error_code ec;
+    bool result = get().write_coalescing(ec);
+    if (ec)
+        detail::throw_system_error(ec, "socket::write_coalescing");
+    return result;
+}
+
+socket::tcp_statistics
+socket::
+tcp_info() const
+{
+    if (!impl_)
+        detail::throw_logic_error("tcp_info: socket not open");
+    tcp_statistics result;
+    system::error_code ec = detail::get_tcp_info(
+        get().native_handle(), result);
+    if (ec)
+        detail::throw_system_error(ec, "socket::tcp_info");
+    return result;
+}
+
+void
+socket::
+set_timestamping(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_timestamping: socket not open");
+    system::error_code ec = get().set_timestamping(enabled);
+    if (ec)
+        detail::throw_system_error(ec, "socket::set_timestamping");
+}
+
+bool
+socket::
+timestamping() const
+{
+    if (!impl_)
+        detail::throw_logic_error("timestamping: socket not open");
+    system::error_code ec;
+    bool result = get().timestamping(ec);
+    if (ec)
+        detail::throw_system_error(ec, "socket::timestamping");
+    return result;
+}
+
+std::chrono::system_clock::time_point
+socket::
+last_receive_time() const noexcept
+{
+    if (!impl_)
+        return {};
+    return get().last_receive_time();
+}
+
+std::chrono::system_clock::time_point
+socket::
+last_send_time() const noexcept
+{
+    if (!impl_)
+        return {};
+    return get().last_send_time();
+}
+
+bool
+socket::
+set_account(io_account* a) noexcept
+{
+    if (!impl_)
+        return false;
+    return get().set_account(a);
+}
+
 endpoint
 socket::
 local_endpoint() const noexcept
@@ -0,0 +1,35 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/socket_stats.hpp>
+#include <boost/corosio/basic_io_context.hpp>
+
+#if BOOST_COROSIO_HAS_IOCP
+#include "src/detail/iocp/sockets.hpp"
+#else
+#include "src/detail/socket_service.hpp"
+#endif
+
+namespace boost::corosio {
+
+socket_stats
+collect_socket_stats(basic_io_context& ctx) noexcept
+{
+    socket_stats st;
+#if BOOST_COROSIO_HAS_IOCP
+    if (auto* svc = ctx.find_service<detail::win_sockets>())
+        svc->collect_stats(st);
+#else
+    if (auto* svc = ctx.find_service<detail::socket_service>())
+        svc->collect_stats(st);
+#endif
+    return st;
+}
+
+} // namespace boost::corosio
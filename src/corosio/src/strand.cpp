@@ -0,0 +1,302 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/strand.hpp>
+#include <boost/corosio/frame_allocator.hpp>
+#include <boost/corosio/detail/thread_local_ptr.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+
+/*
+    Strand
+    ======
+
+    Queue
+    -----
+    Posted coroutines go on an intrusive multi-producer single-consumer
+    queue (Vyukov's, with a stub node). A producer links its node with
+    one exchange on the tail and one store; only the runner pops. A pop
+    can briefly see an empty queue while a producer sits between the
+    exchange and the store, in which case the runner reschedules itself
+    rather than spin. Nodes come from the frame allocator, so a strand
+    in steady state does not reach the global allocator.
+
+    Runner
+    ------
+    pending_ counts coroutines pushed but not yet resumed. The push
+    that raises it from zero owns scheduling: it posts the runner, a
+    coroutine each strand keeps suspended for its whole life, to the
+    inner executor. The runner drains from inside await_suspend, after
+    its own frame is suspended, then subtracts what it resumed from
+    pending_. If that leaves zero the strand is idle, and the next push
+    may post the runner again, even to another thread, before the
+    current one has returned; nothing touches the frame after the
+    subtraction, so that is safe. Otherwise it posts itself again,
+    which bounds how long one strand holds a thread.
+
+    Lifetime
+    --------
+    The impl is reference counted by strand copies and by the runner
+    while it is scheduled, so a strand destroyed with coroutines still
+    queued stays alive until they have run.
+*/
+
+namespace boost::corosio::detail {
+
+namespace {
+
+// Coroutines resumed per runner turn before yielding to the context
+constexpr std::size_t strand_batch = 64;
+
+struct strand_runner
+{
+    struct promise_type
+    {
+        static void* operator new(std::size_t n)
+        {
+            return frame_allocator::allocate(n);
+        }
+
+        static void operator delete(void* p, std::size_t n) noexcept
+        {
+            frame_allocator::deallocate(p, n);
+        }
+
+        strand_runner get_return_object() noexcept
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+} // namespace
+
+struct strand_impl
+{
+    struct node
+    {
+        std::atomic<node*> next{nullptr};
+        capy::coro h;
+    };
+
+    std::atomic<std::size_t> refs_{1};
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<node*> tail_;
+    node* head_;                        // runner only
+    node stub_;
+    basic_io_context::executor_type ex_;
+    std::coroutine_handle<> runner_;
+
+    explicit strand_impl(basic_io_context::executor_type ex);
+    ~strand_impl();
+
+    void add_ref() noexcept
+    {
+        refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept
+    {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    void push(node* n) noexcept
+    {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        auto* prev = tail_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    node* pop() noexcept;
+    void post(capy::coro h);
+    void drain() noexcept;
+};
+
+namespace {
+
+// The strand running on this thread, if any
+corosio::detail::thread_local_ptr<strand_impl> current_strand;
+
+struct drain_awaiter
+{
+    strand_impl* impl;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<>) const noexcept
+    {
+        // May be resumed elsewhere before this returns
+        impl->drain();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+strand_runner
+make_runner(strand_impl* impl)
+{
+    for (;;)
+        co_await drain_awaiter{impl};
+}
+
+} // namespace
+
+strand_impl::
+strand_impl(basic_io_context::executor_type ex)
+    : tail_(&stub_)
+    , head_(&stub_)
+    , ex_(ex)
+    , runner_(make_runner(this).h)
+{
+}
+
+strand_impl::
+~strand_impl()
+{
+    runner_.destroy();
+}
+
+strand_impl::node*
+strand_impl::
+pop() noexcept
+{
+    auto* head = head_;
+    auto* next = head->next.load(std::memory_order_acquire);
+    if (head == &stub_)
+    {
+        if (!next)
+            return nullptr;
+        head_ = next;
+        head = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next)
+    {
+        head_ = next;
+        return head;
+    }
+    if (head != tail_.load(std::memory_order_acquire))
+        return nullptr;     // a push is in progress
+    push(&stub_);
+    next = head->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        head_ = next;
+        return head;
+    }
+    return nullptr;
+}
+
+void
+strand_impl::
+post(capy::coro h)
+{
+    auto* n = ::new(frame_allocator::allocate(sizeof(node))) node;
+    n->h = h;
+    push(n);
+    if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+    {
+        // Held by the runner until the strand goes idle
+        add_ref();
+        ex_.post(runner_);
+    }
+}
+
+void
+strand_impl::
+drain() noexcept
+{
+    auto* saved = current_strand.get();
+    current_strand = this;
+
+    std::size_t n = 0;
+    while (n < strand_batch)
+    {
+        auto* nd = pop();
+        if (!nd)
+            break;
+        auto h = nd->h;
+        nd->~node();
+        frame_allocator::deallocate(nd, sizeof(node));
+        ++n;
+        h.resume();
+    }
+
+    current_strand = saved;
+
+    if (pending_.fetch_sub(n, std::memory_order_acq_rel) == n)
+    {
+        release();
+        return;
+    }
+    ex_.post(runner_);
+}
+
+} // namespace boost::corosio::detail
+
+namespace boost::corosio {
+
+strand::
+strand(inner_executor_type ex)
+    : ex_(ex)
+    , impl_(new detail::strand_impl(ex))
+{
+}
+
+strand::
+strand(strand const& other) noexcept
+    : ex_(other.ex_)
+    , impl_(other.impl_)
+{
+    impl_->add_ref();
+}
+
+strand&
+strand::
+operator=(strand const& other) noexcept
+{
+    other.impl_->add_ref();
+    impl_->release();
+    ex_ = other.ex_;
+    impl_ = other.impl_;
+    return *this;
+}
+
+strand::
+~strand()
+{
+    impl_->release();
+}
+
+bool
+strand::
+running_in_this_thread() const noexcept
+{
+    return detail::current_strand.get() == impl_;
+}
+
+void
+strand::
+post(capy::coro h) const
+{
+    impl_->post(h);
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/stream_file.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/file_service.hpp"
+
+namespace boost::corosio {
+
+stream_file::
+~stream_file()
+{
+    close();
+}
+
+stream_file::
+stream_file(
+    capy::execution_context& ctx)
+    : io_stream(ctx)
+{
+}
+
+void
+stream_file::
+open(std::string_view path, flags open_flags)
+{
+    close();
+
+    // The scheduler installs the backend's file service
+    auto* svc = detail::find_deferred_service<detail::file_service>(
+        *ctx_, detail::deferred_service::file);
+    if (!svc)
+        detail::throw_logic_error(
+            "stream_file::open: no file service installed");
+    auto& impl = svc->create_stream_impl();
+    impl_ = static_cast<io_stream_impl*>(&impl);
+    system::error_code ec = impl.open(path, open_flags);
+    if (ec)
+    {
+        impl.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "stream_file::open");
+    }
+}
+
+void
+stream_file::
+close()
+{
+    if (!impl_)
+        return;
+    impl_->release();
+    impl_ = nullptr;
+}
+
+void
+stream_file::
+cancel()
+{
+    if (impl_)
+        get().cancel();
+}
+
+native_file_type
+stream_file::
+native_handle() const noexcept
+{
+    if (!impl_)
+    {
+#if BOOST_COROSIO_HAS_IOCP
+        return reinterpret_cast<native_file_type>(~std::uintptr_t(0));
+#else
+        return -1;
+#endif
+    }
+    return get().native_handle();
+}
+
+std::uint64_t
+stream_file::
+size() const
+{
+    if (!impl_)
+        detail::throw_logic_error("size: file not open");
+    system::error_code ec;
+    auto n = get().size(ec);
+    if (ec)
+        detail::throw_system_error(ec, "stream_file::size");
+    return n;
+}
+
+void
+stream_file::
+resize(std::uint64_t n)
+{
+    if (!impl_)
+        detail::throw_logic_error("resize: file not open");
+    auto ec = get().resize(n);
+    if (ec)
+        detail::throw_system_error(ec, "stream_file::resize");
+}
+
+void
+stream_file::
+sync_all()
+{
+    if (!impl_)
+        detail::throw_logic_error("sync_all: file not open");
+    auto ec = get().sync_all();
+    if (ec)
+        detail::throw_system_error(ec, "stream_file::sync_all");
+}
+
+void
+stream_file::
+sync_data()
+{
+    if (!impl_)
+        detail::throw_logic_error("sync_data: file not open");
+    auto ec = get().sync_data();
+    if (ec)
+        detail::throw_system_error(ec, "stream_file::sync_data");
+}
+
+std::uint64_t
+stream_file::
+seek(std::int64_t offset, seek_basis whence)
+{
+    if (!impl_)
+        detail::throw_logic_error("seek: file not open");
+    system::error_code ec;
+    auto pos = get().seek(offset, whence, ec);
+    if (ec)
+        detail::throw_system_error(ec, "stream_file::seek");
+    return pos;
+}
+
+} // namespace boost::corosio
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/stream_op.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <exception>
+#include <stop_token>
+
+/*
+    Stream Operation
+    ================
+
+    The backends resume a coroutine handle when an operation
+    completes, and io_stream_impl takes nothing else. Rather than
+    give every backend a second completion path, a stream_op owns
+    one coroutine, drive(), whose handle it passes in place of an
+    awaiting coroutine's. Its frame is allocated once, by the
+    constructor, and lives as long as the object.
+
+    drive() loops forever: it suspends idle, and when start()
+    resumes it, issues the operation from start_awaitable. The
+    backend parks it, or finishes it inline, in which case
+    await_suspend returns false and the frame carries on without
+    suspending, as an awaiting coroutine does. Either way the frame
+    then calls on_complete.
+
+    Re-arming
+    ---------
+    The frame is running while on_complete runs, so the next
+    operation cannot be issued with its handle from there. read_some
+    and write_some called from on_complete only record the request
+    in armed_; drive() issues it once the callback returns. Starting
+    from anywhere else resumes the idle frame, which runs on_complete
+    before start() returns if the operation finishes inline.
+
+    No stop token is passed: the operations are cancelled through
+    the stream, and an empty token registers nothing.
+*/
+
+namespace boost::corosio {
+
+// The coroutine type of drive(). The frame starts running at once,
+// up to its first idle suspension, and is destroyed by the owner.
+struct stream_op::driver
+{
+    struct promise_type
+    {
+        driver
+        get_return_object() noexcept
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+// Issues the recorded operation with the frame's handle
+struct stream_op::start_awaitable
+{
+    stream_op& op;
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool
+    await_suspend(std::coroutine_handle<> h)
+    {
+        auto& impl = *op.s_.get_impl();
+        capy::executor_ref ex(op.ex_);
+        bool done = op.is_read_
+            ? impl.read_some(h, ex, op.rbuf_, std::stop_token(),
+                &op.ec_, &op.n_)
+            : impl.write_some(h, ex, op.wbuf_, std::stop_token(),
+                &op.ec_, &op.n_);
+        return !done;
+    }
+
+    void
+    await_resume() const noexcept
+    {
+    }
+};
+
+stream_op::driver
+stream_op::
+drive(stream_op& op)
+{
+    for (;;)
+    {
+        co_await std::suspend_always{};
+        do
+        {
+            op.armed_ = false;
+            co_await start_awaitable{op};
+
+            op.pending_ = false;
+            op.in_complete_ = true;
+            op.on_complete(op.ec_, op.n_);
+            op.in_complete_ = false;
+        }
+        while (op.armed_);
+    }
+}
+
+stream_op::
+stream_op(io_stream& s)
+    : s_(s)
+    , ex_(dynamic_cast<basic_io_context&>(s.context()).get_executor())
+    , h_(drive(*this).h)
+{
+}
+
+stream_op::
+~stream_op()
+{
+    h_.destroy();
+}
+
+void
+stream_op::
+read_some(capy::mutable_buffer buf)
+{
+    rbuf_ = buf;
+    is_read_ = true;
+    start();
+}
+
+void
+stream_op::
+write_some(capy::const_buffer buf)
+{
+    wbuf_ = buf;
+    is_read_ = false;
+    start();
+}
+
+void
+stream_op::
+start()
+{
+    ec_ = {};
+    n_ = 0;
+    pending_ = true;
+    if (in_complete_)
+        armed_ = true;
+    else
+        h_.resume();
+}
+
+} // namespace boost::corosio
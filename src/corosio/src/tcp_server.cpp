@@ -8,37 +8,486 @@
 //
 
 #include <boost/corosio/tcp_server.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/timer.hpp>
+
+#include "src/detail/tcp_info.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <vector>
 
 namespace boost::corosio {
 
-// Accept loop: wait for idle worker, accept connection, dispatch
+// Accept loop: wait for admission and an idle worker, accept
+// connection, dispatch
 capy::task<void>
-tcp_server::do_accept(acceptor& acc)
+tcp_server::do_accept(acceptor& acc, std::size_t shard)
 {
     auto st = co_await capy::this_coro::stop_token;
+    timer delay(acc.context());
+    corosio::socket spare(acc.context());  // takes connections to reset
     while(! st.stop_requested())
     {
-        // Wait for an idle worker before blocking on accept
-        auto rv = co_await pop();
-        if(rv.has_error())
+        // Over a limit, stop accepting so connections stay in the
+        // backlog, or take them to reset
+        bool admitted = true;
+        if(admission_.max_accept_rate)
+        {
+            auto const wait = take_token();
+            if(wait > clock_type::duration::zero())
+            {
+                if(! admission_.reset_excess)
+                {
+                    delay.expires_after(wait);
+                    auto [ec] = co_await delay.wait();
+                    if(ec)
+                        break;
+                    continue;
+                }
+                admitted = false;
+            }
+        }
+        if(admitted && ! try_admit())
+        {
+            if(admission_.reset_excess)
+                admitted = false;
+            else
+            {
+                co_await admit_awaitable{*this};
+                if(st.stop_requested())
+                {
+                    release_slot();
+                    break;
+                }
+            }
+        }
+        if(! admitted)
+        {
+            auto [ec] = co_await acc.accept(spare);
+            if(! ec)
+                reject(spare);
             continue;
-        auto& w = rv.value();
+        }
+
+        // Wait for an idle worker before blocking on accept, unless
+        // the pool can grow
+        auto const start = clock_type::now();
+        bool waited = false;
+        worker_base* wp = has_idle(shard) ? nullptr : grow(shard);
+        if(! wp)
+        {
+            auto rv = co_await pop(shard, waited);
+            if(rv.has_error())
+                continue;
+            wp = &rv.value();
+        }
+        if(st.stop_requested())
+        {
+            // Woken by a worker returned during drain()
+            push_sync(*wp);
+            release_slot();
+            break;
+        }
+        auto const wait_time = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(clock_type::now() - start);
+
+        auto& w = *wp;
         auto [ec] = co_await acc.accept(w.socket());
+        if(! ec)
+            w.socket().set_account(&w.account_);
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            if(waited)
+                ++stats_.accept_waits;
+            stats_.accept_wait_time += wait_time;
+            stats_.max_accept_wait = (std::max)(stats_.max_accept_wait, wait_time);
+            if(! ec)
+            {
+                ++stats_.accepts;
+                w.connection_start_ = w.account_.usage();
+            }
+        }
         if(ec)
         {
-            co_await push(w);
+            push_sync(w);
+            release_slot();
             continue;
         }
+        accepted_.fetch_add(1, std::memory_order_relaxed);
+        w.handle = w.socket().native_handle();
+        w.remote = w.socket().remote_endpoint();
+        w.busy.store(true, std::memory_order_release);
         w.run(launcher{*this, w});
     }
+
+    // Closed here, on the context that owns it, once drain() stops us
+    acc.close();
+}
+
+std::unique_ptr<tcp_server::worker_base>
+tcp_server::make_worker(io_context&)
+{
+    return nullptr;
+}
+
+// Make a worker for a shard with no idle one, within max_workers
+tcp_server::worker_base*
+tcp_server::grow(std::size_t shard)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if(wv_.size() + growing_ >= limits_.max_workers)
+            return nullptr;
+        ++growing_;
+    }
+
+    // Made without the lock, which other accept loops need
+    auto& ctx = pool_ ? pool_->get_context(shard) : ctx_;
+    auto p = make_worker(ctx);
+
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    --growing_;
+    if(! p)
+        return nullptr;
+    ++stats_.workers_created;
+    return &wv_.adopt(std::move(p), shard);
+}
+
+// Destroy the workers above min_workers idle since before the
+// timeout. Idle lists are LIFO, so the longest idle are at the tail
+// and the busiest workers stay warm.
+void
+tcp_server::retire_idle()
+{
+    auto const cutoff = clock_type::now() - limits_.idle_timeout;
+    std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+    std::size_t n = wv_.size();
+    std::vector<worker_base*> retired;
+    for(std::size_t i = 0; i < wv_.idle_.size(); ++i)
+    {
+        std::lock_guard<std::mutex> lock(locks_[i]);
+        worker_base** pp = &wv_.idle_[i];
+        while(*pp && n > limits_.min_workers)
+        {
+            auto* w = *pp;
+            if(w->idle_since > cutoff)
+            {
+                pp = &w->next;
+                continue;
+            }
+            *pp = w->next;
+            retired.push_back(w);
+            --n;
+        }
+    }
+
+    // Unlinked, so no other thread can reach them
+    for(auto* w : retired)
+        wv_.destroy(*w);
+    stats_.workers_retired += retired.size();
+}
+
+// Take a connection slot if one is free
+bool
+tcp_server::try_admit() noexcept
+{
+    if(! admission_.max_connections)
+    {
+        active_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(admit_mutex_);
+    if(active_.load(std::memory_order_relaxed) >= admission_.max_connections)
+        return false;
+    active_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Free a connection slot, or hand it to a waiting accept loop
+void
+tcp_server::release_slot() noexcept
+{
+    if(! admission_.max_connections)
+    {
+        active_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+    waiter* wait = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(admit_mutex_);
+        wait = admit_waiters_;
+        if(wait)
+            admit_waiters_ = wait->next;
+        else
+            active_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if(wait)
+        wait->ex.post(wait->h);
+}
+
+// Take a token from the accept rate bucket, or return how long
+// until one is added
+tcp_server::clock_type::duration
+tcp_server::take_token() noexcept
+{
+    using seconds = std::chrono::duration<double>;
+    double const rate = static_cast<double>(admission_.max_accept_rate);
+    auto const now = clock_type::now();
+    std::lock_guard<std::mutex> lock(admit_mutex_);
+    tokens_ = (std::min)(rate,
+        tokens_ + rate * seconds(now - refilled_).count());
+    refilled_ = now;
+    if(tokens_ >= 1)
+    {
+        tokens_ -= 1;
+        return clock_type::duration::zero();
+    }
+    return std::chrono::ceil<clock_type::duration>(
+        seconds((1 - tokens_) / rate));
+}
+
+// Close a connection over the limits with a reset
+void
+tcp_server::reject(corosio::socket& s) noexcept
+{
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        s.set_linger(true, 0);
+    }
+    catch(std::exception const&)
+    {
+        // The peer may have gone; close anyway
+    }
+    s.close();
+}
+
+capy::task<void>
+tcp_server::reap_idle()
+{
+    auto st = co_await capy::this_coro::stop_token;
+    timer t(ctx_);
+    auto const period = (std::max)(
+        limits_.idle_timeout / 2, std::chrono::milliseconds(1));
+    while(! st.stop_requested())
+    {
+        t.expires_after(period);
+        auto [ec] = co_await t.wait();
+        if(ec)
+            co_return;
+        co_await enter_awaitable{*this};
+        retire_idle();
+    }
+}
+
+capy::task<tcp_server::worker_stats>
+tcp_server::sample_worker_stats()
+{
+    co_await enter_awaitable{*this};
+
+    std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+    worker_stats ws = stats_;
+    ws.workers = wv_.size();
+    ws.idle = 0;
+    for(std::size_t i = 0; i < wv_.idle_.size(); ++i)
+    {
+        // Before start() there are no locks, nor other threads
+        std::unique_lock<std::mutex> lock;
+        if(locks_)
+            lock = std::unique_lock<std::mutex>(locks_[i]);
+        for(auto* w = wv_.idle_[i]; w; w = w->next)
+            ++ws.idle;
+    }
+    co_return ws;
+}
+
+capy::task<std::vector<tcp_server::connection_sample>>
+tcp_server::sample_tcp_info()
+{
+    co_await enter_awaitable{*this};
+
+    std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+    std::vector<connection_sample> v;
+    for(auto& p : wv_.v_)
+    {
+        if(! p->busy.load(std::memory_order_acquire))
+            continue;
+        connection_sample cs;
+        cs.remote_endpoint = p->remote;
+        // A worker that has closed its socket reports an error
+        if(detail::get_tcp_info(p->handle, cs.stats))
+            continue;
+        v.push_back(cs);
+    }
+    co_return v;
+}
+
+void
+tcp_server::append_parked_ops(std::vector<parked_op>& out)
+{
+    auto const now = std::chrono::steady_clock::now();
+    auto add = [&](waiter const* w, parked_kind kind)
+    {
+        for(; w; w = w->next)
+        {
+            parked_op p;
+            p.kind = kind;
+            p.age = now - w->since;
+            p.coroutine = w->h.address();
+            out.push_back(p);
+        }
+    };
+
+    // Before start() there are no locks, nor waiters
+    if(locks_)
+    {
+        for(std::size_t i = 0; i < waiters_.size(); ++i)
+        {
+            std::lock_guard<std::mutex> lock(locks_[i]);
+            add(waiters_[i], parked_kind::server_pop);
+        }
+    }
+    std::lock_guard<std::mutex> lock(admit_mutex_);
+    add(admit_waiters_, parked_kind::server_admit);
+}
+
+capy::task<std::vector<tcp_server::worker_usage>>
+tcp_server::sample_worker_usage()
+{
+    co_await enter_awaitable{*this};
+
+    std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+    std::vector<worker_usage> v;
+    v.reserve(wv_.v_.size());
+    for(auto& p : wv_.v_)
+    {
+        worker_usage u;
+        u.worker = p.get();
+        u.busy = p->busy.load(std::memory_order_acquire);
+        u.remote_endpoint = p->remote;
+        u.total = p->account_.usage();
+        u.connection = u.total - p->connection_start_;
+        v.push_back(u);
+    }
+    co_return v;
+}
+
+system::error_code
+tcp_server::adopt(native_handle_type h)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    (void)h;
+    return make_error_code(system::errc::operation_not_supported);
+#else
+    // Handles arrive in the order the other process bound them, so
+    // dealing them out in turn gives each shard its share
+    std::size_t const shards = pool_ ? pool_->size() : 1;
+    auto& ctx = pool_ ? pool_->get_context(ports_.size() % shards) : ctx_;
+    acceptor acc(ctx);
+    try
+    {
+        acc.assign(h);
+    }
+    catch(std::system_error const& e)
+    {
+        return e.code();
+    }
+    ports_.push_back(std::move(acc));
+    return {};
+#endif
+}
+
+std::vector<native_handle_type>
+tcp_server::native_handles() const
+{
+    std::vector<native_handle_type> v;
+    v.reserve(ports_.size());
+    for(auto const& acc : ports_)
+        v.push_back(acc.native_handle());
+    return v;
+}
+
+capy::task<bool>
+tcp_server::drain(std::chrono::milliseconds timeout)
+{
+    co_await enter_awaitable{*this};
+
+    auto const deadline = clock_type::now() + timeout;
+    stop_.request_stop();
+
+    // Accept loops parked for a slot or a worker hold a slot until
+    // a finishing connection wakes them, so this also waits for them
+    timer t(ctx_);
+    while(active_.load(std::memory_order_acquire) > 0)
+    {
+        auto const now = clock_type::now();
+        if(now >= deadline)
+            co_return false;
+        t.expires_after((std::min)(
+            std::chrono::duration_cast<clock_type::duration>(
+                std::chrono::milliseconds(10)),
+            deadline - now));
+        auto [ec] = co_await t.wait();
+        if(ec)
+            co_return active_.load(std::memory_order_acquire) == 0;
+    }
+    co_return true;
 }
 
 system::error_code
 tcp_server::bind(endpoint ep)
 {
-    ports_.emplace_back(ctx_);
-    // VFALCO this should return error_code
-    ports_.back().listen(ep);
+    return bind(ep, acceptor::listen_options{});
+}
+
+system::error_code
+tcp_server::bind(endpoint ep, acceptor::listen_options opts)
+{
+#if BOOST_COROSIO_HAS_IOCP
+    // No SO_REUSEPORT: a single acceptor on the first shard
+    std::size_t const shards = 1;
+    std::size_t const loops = 1;
+#else
+    std::size_t const shards = pool_ ? pool_->size() : 1;
+    std::size_t const loops = accept_loops_;
+#endif
+    if(shards * loops == 1)
+    {
+        // Steering needs a group of acceptors to choose from
+        opts.cpu_steering = false;
+        ports_.emplace_back(ctx_);
+        // VFALCO this should return error_code
+        ports_.back().listen(ep, opts);
+        return {};
+    }
+
+    // Shards join the reuseport group in index order, which is the
+    // order cpu_steering relies on; with several acceptors per shard
+    // that order no longer maps onto CPUs
+    opts.reuse_port = true;
+    if(loops > 1)
+        opts.cpu_steering = false;
+    for(std::size_t i = 0; i < shards; ++i)
+    {
+        for(std::size_t k = 0; k < loops; ++k)
+        {
+            ports_.emplace_back(pool_ ? pool_->get_context(i) : ctx_);
+            ports_.back().listen(ep, opts);
+
+            // Every acceptor must share the port the first one was given
+            if(i == 0 && k == 0 && ep.port() == 0)
+            {
+                auto port = ports_.back().local_endpoint().port();
+                ep = ep.is_v4()
+                    ? endpoint(ep.v4_address(), port)
+                    : endpoint(ep.v6_address(), port);
+            }
+        }
+    }
     return {};
 }
 
@@ -46,8 +495,52 @@ void
 tcp_server::
 start()
 {
+    std::size_t shards = 1;
+    if(pool_)
+    {
+        shards = pool_->size();
+
+        // Route each worker to the shard owning its socket
+        wv_.idle_.assign(shards, nullptr);
+        for(auto& p : wv_.v_)
+        {
+            auto i = pool_->index_of(p->socket().context());
+            p->shard = i < shards ? i : 0;
+            wv_.push(*p);
+        }
+    }
+    if(wv_.idle_.size() < shards)
+        wv_.idle_.resize(shards, nullptr);
+    waiters_.assign(shards, nullptr);
+    locks_ = std::make_unique<std::mutex[]>(shards);
+
+    // The rate bucket starts full
+    tokens_ = static_cast<double>(admission_.max_accept_rate);
+    refilled_ = clock_type::now();
+
     for(auto& t : ports_)
-        capy::run_async(ex_)(do_accept(t));
+    {
+        std::size_t shard = 0;
+        if(pool_)
+        {
+            shard = pool_->index_of(t.context());
+            if(shard >= shards)
+                shard = 0;
+        }
+        // Each loop runs on the context that owns its acceptor, so
+        // accepted sockets are handed to workers without a hop
+        if(pool_)
+            capy::run_async(pool_->get_context(shard).get_executor(),
+                stop_.get_token())(do_accept(t, shard));
+        else
+            capy::run_async(ex_, stop_.get_token())(do_accept(t, shard));
+    }
+
+    // Stopped by drain() along with the accept loops, so the reaper's
+    // timer does not keep the context running
+    if(limits_.max_workers > 0 &&
+        limits_.idle_timeout > std::chrono::milliseconds::zero())
+        capy::run_async(ex_, stop_.get_token())(reap_idle());
 }
 
 } // namespace boost::corosio
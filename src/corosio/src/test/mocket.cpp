@@ -20,7 +20,6 @@
 #include <boost/url/ipv4_address.hpp>
 
 #include <boost/corosio/detail/platform.hpp>
-#include "src/detail/resume_coro.hpp"
 
 #include <algorithm>
 #include <cstdio>
@@ -38,7 +37,7 @@ namespace boost::corosio::test {
 
 namespace {
 
-constexpr std::size_t max_buffers = 8;
+constexpr std::size_t max_buffers = 64;
 using buffer_array = std::array<capy::mutable_buffer, max_buffers>;
 
 } // namespace
@@ -95,7 +94,7 @@ public:
 
     void release() override;
 
-    void read_some(
+    bool read_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param buffers,
@@ -103,7 +102,7 @@ public:
         system::error_code* ec,
         std::size_t* bytes_transferred) override;
 
-    void write_some(
+    bool write_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param buffers,
@@ -260,7 +259,7 @@ validate_expect(
     return true;
 }
 
-void
+bool
 mocket_impl::
 read_some(
     std::coroutine_handle<> h,
@@ -279,8 +278,7 @@ read_some(
         {
             *ec = fail_ec;
             *bytes_transferred = 0;
-            detail::resume_coro(d, h);
-            return;
+            return true;
         }
     }
 
@@ -294,15 +292,14 @@ read_some(
         std::size_t n = fill_from_provide(bufs, count);
         *ec = {};
         *bytes_transferred = n;
-        detail::resume_coro(d, h);
-        return;
+        return true;
     }
 
     // Pass through to the real socket (don't extract buffers - forward as-is)
-    sock_.get_impl()->read_some(h, d, buffers, token, ec, bytes_transferred);
+    return sock_.get_impl()->read_some(h, d, buffers, token, ec, bytes_transferred);
 }
 
-void
+bool
 mocket_impl::
 write_some(
     std::coroutine_handle<> h,
@@ -321,8 +318,7 @@ write_some(
         {
             *ec = fail_ec;
             *bytes_transferred = 0;
-            detail::resume_coro(d, h);
-            return;
+            return true;
         }
     }
 
@@ -342,19 +338,17 @@ write_some(
         {
             *ec = capy::error::test_failure;
             *bytes_transferred = 0;
-            detail::resume_coro(d, h);
-            return;
+            return true;
         }
 
         // If all expected data was validated, report success
         *ec = {};
         *bytes_transferred = total_size;
-        detail::resume_coro(d, h);
-        return;
+        return true;
     }
 
     // Pass through to the real socket (don't extract buffers - forward as-is)
-    sock_.get_impl()->write_some(h, d, buffers, token, ec, bytes_transferred);
+    return sock_.get_impl()->write_some(h, d, buffers, token, ec, bytes_transferred);
 }
 
 //------------------------------------------------------------------------------
@@ -16,11 +16,13 @@
 #include <boost/url/ipv4_address.hpp>
 
 #include <atomic>
+#include <cerrno>
 #include <cstdint>
 #include <cstdio>
 #include <stdexcept>
 
 #if BOOST_COROSIO_POSIX
+#include <sys/socket.h>
 #include <unistd.h>   // getpid()
 #else
 #include <process.h>  // _getpid()
@@ -59,7 +61,7 @@ get_test_port() noexcept
 } // namespace
 
 std::pair<socket, socket>
-make_socket_pair(io_context& ioc)
+make_socket_pair(basic_io_context& ioc)
 {
     auto ex = ioc.get_executor();
 
@@ -142,4 +144,35 @@ make_socket_pair(io_context& ioc)
     return {std::move(s1), std::move(s2)};
 }
 
+std::pair<socket, socket>
+make_local_socket_pair(basic_io_context& ioc)
+{
+#if BOOST_COROSIO_POSIX
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+    {
+        std::fprintf(stderr, "socket_pair: socketpair failed (errno=%d)\n", errno);
+        throw std::runtime_error("socket_pair: socketpair failed");
+    }
+
+    // assign() closes the handle it is given if it fails
+    socket s1(ioc);
+    socket s2(ioc);
+    try
+    {
+        s1.assign(fds[0]);
+    }
+    catch (...)
+    {
+        ::close(fds[1]);
+        throw;
+    }
+    s2.assign(fds[1]);
+
+    return {std::move(s1), std::move(s2)};
+#else
+    return make_socket_pair(ioc);
+#endif
+}
+
 } // namespace boost::corosio::test
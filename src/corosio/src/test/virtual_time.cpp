@@ -0,0 +1,28 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/test/virtual_time.hpp>
+#include <boost/corosio/detail/except.hpp>
+
+#include "src/detail/timer_service.hpp"
+
+namespace boost::corosio::test {
+
+void
+advance_time_to(
+    basic_io_context& ctx,
+    std::chrono::steady_clock::time_point t)
+{
+    auto* svc = ctx.find_service<detail::timer_service>();
+    if (!svc || !svc->advance_to(t))
+        detail::throw_logic_error(
+            "advance_time_to: context does not use virtual time");
+}
+
+} // namespace boost::corosio::test
@@ -22,6 +22,8 @@ extern timer::time_point timer_service_expiry(timer::timer_impl&) noexcept;
 extern void timer_service_expires_at(timer::timer_impl&, timer::time_point);
 extern void timer_service_expires_after(timer::timer_impl&, timer::duration);
 extern void timer_service_cancel(timer::timer_impl&) noexcept;
+extern timer::duration timer_service_slack(timer::timer_impl&) noexcept;
+extern void timer_service_set_slack(timer::timer_impl&, timer::duration) noexcept;
 
 } // namespace detail
 
@@ -92,4 +94,18 @@ expires_after(duration d)
     detail::timer_service_expires_after(get(), d);
 }
 
+timer::duration
+timer::
+slack() const
+{
+    return detail::timer_service_slack(get());
+}
+
+void
+timer::
+set_slack(duration s)
+{
+    detail::timer_service_set_slack(get(), s);
+}
+
 } // namespace boost::corosio
@@ -24,6 +24,20 @@ context()
 {
 }
 
+context::
+context( std::pmr::memory_resource* mr )
+    : impl_( std::allocate_shared<impl>(
+        std::pmr::polymorphic_allocator<impl>( mr ), mr ) )
+{
+}
+
+std::pmr::memory_resource*
+context::
+memory_resource() const noexcept
+{
+    return impl_->resource;
+}
+
 //------------------------------------------------------------------------------
 //
 // Credential Loading
@@ -36,7 +50,7 @@ use_certificate(
     std::string_view certificate,
     file_format format )
 {
-    impl_->entity_certificate = std::string( certificate );
+    impl_->entity_certificate = certificate;
     impl_->entity_cert_format = format;
     return {};
 }
@@ -53,7 +67,7 @@ use_certificate_file(
 
     std::ostringstream ss;
     ss << file.rdbuf();
-    impl_->entity_certificate = ss.str();
+    impl_->entity_certificate = ss.view();
     impl_->entity_cert_format = format;
     return {};
 }
@@ -62,7 +76,7 @@ system::result<void>
 context::
 use_certificate_chain( std::string_view chain )
 {
-    impl_->certificate_chain = std::string( chain );
+    impl_->certificate_chain = chain;
     return {};
 }
 
@@ -76,7 +90,7 @@ use_certificate_chain_file( std::string_view filename )
 
     std::ostringstream ss;
     ss << file.rdbuf();
-    impl_->certificate_chain = ss.str();
+    impl_->certificate_chain = ss.view();
     return {};
 }
 
@@ -86,7 +100,7 @@ use_private_key(
     std::string_view private_key,
     file_format format )
 {
-    impl_->private_key = std::string( private_key );
+    impl_->private_key = private_key;
     impl_->private_key_format = format;
     return {};
 }
@@ -103,7 +117,7 @@ use_private_key_file(
 
     std::ostringstream ss;
     ss << file.rdbuf();
-    impl_->private_key = ss.str();
+    impl_->private_key = ss.view();
     impl_->private_key_format = format;
     return {};
 }
@@ -152,7 +166,7 @@ load_verify_file( std::string_view filename )
 
     std::ostringstream ss;
     ss << file.rdbuf();
-    impl_->ca_certificates.push_back( ss.str() );
+    impl_->ca_certificates.emplace_back( ss.view() );
     return {};
 }
 
@@ -198,7 +212,7 @@ system::result<void>
 context::
 set_ciphersuites( std::string_view ciphers )
 {
-    impl_->ciphersuites = std::string( ciphers );
+    impl_->ciphersuites = ciphers;
     return {};
 }
 
@@ -212,6 +226,70 @@ set_alpn( std::initializer_list<std::string_view> protocols )
     return {};
 }
 
+void
+context::
+set_kernel_tls( bool enable )
+{
+    impl_->kernel_tls = enable;
+}
+
+void
+context::
+set_handshake_threads( std::size_t threads )
+{
+    impl_->handshake_threads = threads;
+}
+
+void
+context::
+set_dynamic_record_sizing( bool enable )
+{
+    impl_->dynamic_records = enable;
+}
+
+//------------------------------------------------------------------------------
+//
+// Crypto Offload
+//
+//------------------------------------------------------------------------------
+
+system::result<void>
+context::
+set_crypto_provider(
+    std::string_view name,
+    std::string_view properties )
+{
+    if( name.empty() )
+        return system::error_code( EINVAL, system::generic_category() );
+    impl_->crypto_provider = name;
+    impl_->crypto_properties = properties;
+    return {};
+}
+
+system::result<void>
+context::
+set_crypto_engine( std::string_view id )
+{
+    if( id.empty() )
+        return system::error_code( EINVAL, system::generic_category() );
+    impl_->crypto_engine = id;
+    return {};
+}
+
+void
+context::
+set_crypto_device( int id )
+{
+    impl_->crypto_device = id;
+}
+
+void
+context::
+set_async_crypto( bool enable )
+{
+    impl_->async_crypto = enable;
+}
+
 //------------------------------------------------------------------------------
 //
 // Certificate Verification
@@ -238,7 +316,7 @@ void
 context::
 set_hostname( std::string_view hostname )
 {
-    impl_->hostname = std::string( hostname );
+    impl_->hostname = hostname;
 }
 
 void
@@ -249,6 +327,27 @@ set_servername_callback_impl(
     impl_->servername_callback = std::move( callback );
 }
 
+void
+context::
+set_server_context_loader_impl(
+    std::function<std::optional<context>( std::string_view )> loader,
+    std::size_t cache_size,
+    std::size_t threads )
+{
+    impl_->server_contexts = std::make_unique<detail::server_context_cache>(
+        std::move( loader ), cache_size, threads );
+}
+
+system::result<void>
+context::
+add_server_context( std::string_view hostname, context const& ctx )
+{
+    // A context routing to itself would never be freed
+    if( ctx.impl_ == impl_ || !impl_->sni_routes.insert( hostname, ctx ) )
+        return system::error_code( EINVAL, system::generic_category() );
+    return {};
+}
+
 //------------------------------------------------------------------------------
 //
 // Revocation Checking
@@ -273,7 +372,7 @@ add_crl_file( std::string_view filename )
 
     std::ostringstream ss;
     ss << file.rdbuf();
-    impl_->crls.push_back( ss.str() );
+    impl_->crls.emplace_back( ss.view() );
     return {};
 }
 
@@ -281,10 +380,19 @@ system::result<void>
 context::
 set_ocsp_staple( std::string_view response )
 {
-    impl_->ocsp_staple = std::string( response );
+    impl_->ocsp.store( std::string( response ) );
     return {};
 }
 
+void
+context::
+set_ocsp_staple_source_impl(
+    std::function<std::string()> fetch,
+    std::chrono::seconds refresh )
+{
+    impl_->ocsp.set_source( std::move( fetch ), refresh );
+}
+
 void
 context::
 set_require_ocsp_staple( bool require )
@@ -299,4 +407,45 @@ set_revocation_policy( revocation_policy policy )
     impl_->revocation = policy;
 }
 
+//------------------------------------------------------------------------------
+//
+// Session Resumption
+//
+//------------------------------------------------------------------------------
+
+void
+context::
+set_session_cache_size( std::size_t size )
+{
+    impl_->session_cache_size = size;
+}
+
+void
+context::
+set_session_timeout( std::chrono::seconds timeout )
+{
+    impl_->session_timeout = timeout;
+}
+
+void
+context::
+set_session_tickets( bool enable )
+{
+    impl_->session_tickets = enable;
+}
+
+void
+context::
+set_ticket_key_lifetime( std::chrono::seconds lifetime )
+{
+    impl_->ticket_key_lifetime = lifetime;
+}
+
+void
+context::
+set_max_early_data( std::size_t bytes )
+{
+    impl_->max_early_data = bytes;
+}
+
 } // namespace boost::corosio::tls
@@ -11,10 +11,29 @@
 #define SRC_TLS_DETAIL_CONTEXT_IMPL_HPP
 
 #include <boost/corosio/tls/context.hpp>
+#include <boost/corosio/io_stream.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <list>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace boost::corosio::tls {
@@ -26,6 +45,13 @@ namespace detail {
     Stored in context::impl as an intrusive linked list.
     Each TLS backend derives from this to cache its native
     context handle ( WOLFSSL_CTX*, SSL_CTX*, etc. ).
+
+    A native context is built once per tls::context and backend,
+    from the settings in force when the first stream is made, and
+    is then shared by every stream made from any copy of the
+    context, on any thread and any io_context. It must not refer
+    to an io_context, and backends only use it in ways their
+    library documents as thread-safe.
 */
 class native_context_base
 {
@@ -36,22 +62,826 @@ public:
     virtual ~native_context_base() = default;
 };
 
+/** Client sessions kept for resumption.
+
+    Each entry owns a reference to a backend's session object
+    through a type-erased handle, and is keyed by the backend and
+    the server it came from. When the store is full the oldest
+    entry is dropped.
+*/
+class session_store
+{
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<void>> sessions_;
+    std::deque<std::string> order_;     // oldest first
+
+    static std::string
+    make_key( void const* backend, std::string_view peer )
+    {
+        std::string key = std::to_string(
+            reinterpret_cast<std::uintptr_t>( backend ) );
+        key += '|';
+        key += peer;
+        return key;
+    }
+
+public:
+    /** Return the session for a server, or null. */
+    std::shared_ptr<void>
+    find( void const* backend, std::string_view peer )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        auto it = sessions_.find( make_key( backend, peer ) );
+        if( it == sessions_.end() )
+            return nullptr;
+        return it->second;
+    }
+
+    /** Keep the latest session for a server. */
+    void
+    insert(
+        void const* backend,
+        std::string_view peer,
+        std::shared_ptr<void> session,
+        std::size_t limit )
+    {
+        if( limit == 0 )
+            return;
+        std::lock_guard<std::mutex> lock( mutex_ );
+        auto key = make_key( backend, peer );
+        auto it = sessions_.find( key );
+        if( it != sessions_.end() )
+        {
+            it->second = std::move( session );
+            return;
+        }
+        while( order_.size() >= limit )
+        {
+            sessions_.erase( order_.front() );
+            order_.pop_front();
+        }
+        sessions_.emplace( key, std::move( session ) );
+        order_.push_back( std::move( key ) );
+    }
+};
+
+/** Threads that run the computing steps of handshakes.
+
+    Jobs are intrusive, so posting one allocates nothing. The
+    destructor runs the jobs still queued before joining.
+*/
+class handshake_pool
+{
+public:
+    struct job
+    {
+        job* next = nullptr;
+        void ( *run )( job* ) = nullptr;
+    };
+
+    explicit
+    handshake_pool( std::size_t threads )
+    {
+        try
+        {
+            threads_.reserve( threads );
+            for( std::size_t i = 0; i < threads; ++i )
+                threads_.emplace_back( [this]{ work(); } );
+        }
+        catch( ... )
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ~handshake_pool()
+    {
+        stop();
+    }
+
+    void
+    post( job* j ) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            j->next = nullptr;
+            if( tail_ )
+                tail_->next = j;
+            else
+                head_ = j;
+            tail_ = j;
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void
+    stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for( auto& t : threads_ )
+            t.join();
+        threads_.clear();
+    }
+
+    void
+    work()
+    {
+        for(;;)
+        {
+            job* j;
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+                cv_.wait( lock, [this]{ return stop_ || head_; } );
+                if( !head_ )
+                    return;
+                j = head_;
+                head_ = j->next;
+                if( !head_ )
+                    tail_ = nullptr;
+            }
+            j->run( j );
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    job* head_ = nullptr;
+    job* tail_ = nullptr;
+    bool stop_ = false;
+    std::vector<std::thread> threads_;
+};
+
+/** Awaitable that calls `f` on a handshake pool.
+
+    The awaiting coroutine is posted back to its executor with the
+    result of `f`. The executor counts the job as outstanding work,
+    so its io_context keeps running meanwhile.
+*/
+template<class F>
+class offload_awaitable : handshake_pool::job
+{
+    using result_type = std::invoke_result_t<F&>;
+
+    handshake_pool& pool_;
+    F f_;
+    result_type result_{};
+    std::coroutine_handle<> h_;
+    capy::executor_ref ex_;
+
+    static void
+    do_run( handshake_pool::job* j )
+    {
+        auto* self = static_cast<offload_awaitable*>( j );
+        self->result_ = self->f_();
+
+        // The coroutine may destroy us once posted
+        auto ex = self->ex_;
+        auto h = self->h_;
+        ex.post( h );
+    }
+
+public:
+    offload_awaitable( handshake_pool& pool, F f )
+        : pool_( pool )
+        , f_( std::move( f ) )
+    {
+        this->run = &do_run;
+    }
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template<typename Ex>
+    void
+    await_suspend(
+        std::coroutine_handle<> h,
+        Ex const& ex,
+        std::stop_token ) noexcept
+    {
+        h_ = h;
+        ex_ = ex;
+        ex_.on_work_started();
+        pool_.post( this );
+    }
+
+    result_type
+    await_resume() noexcept
+    {
+        // Balanced here, on the executor's thread, where it is
+        // known to be alive
+        std::atomic_thread_fence( std::memory_order_acquire );
+        ex_.on_work_finished();
+        return std::move( result_ );
+    }
+};
+
+/** Return an awaitable that calls `f` on `pool`. */
+template<class F>
+offload_awaitable<F>
+offload( handshake_pool& pool, F f )
+{
+    return offload_awaitable<F>( pool, std::move( f ) );
+}
+
+/** Awaitable that reposts the awaiting coroutine to its executor.
+
+    Used to poll work that completes outside the reactor, such as
+    an asynchronous crypto job, without blocking other coroutines
+    on the same executor.
+*/
+struct yield_awaitable
+{
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template<typename Ex>
+    void
+    await_suspend(
+        std::coroutine_handle<> h,
+        Ex const& ex,
+        std::stop_token ) noexcept
+    {
+        capy::executor_ref( ex ).post( h );
+    }
+
+    void
+    await_resume() noexcept
+    {
+    }
+};
+
+/** Return an awaitable that reposts the caller to its executor. */
+inline yield_awaitable
+yield() noexcept
+{
+    return {};
+}
+
+/** The OCSP response a server staples, and its refresher.
+
+    Handshakes copy the current response from memory. When a source
+    is set, a thread owned by the context calls it once the first
+    native context is built and again every refresh interval, so a
+    fetch never runs during a handshake. A fetch that throws or
+    returns nothing keeps the previous response and is retried
+    after at most a minute.
+*/
+class ocsp_cache
+{
+public:
+    using source_type = std::function<std::string()>;
+
+    /// The longest wait before retrying a failed fetch.
+    static constexpr std::chrono::seconds retry_interval{ 60 };
+
+    ~ocsp_cache()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if( thread_.joinable() )
+            thread_.join();
+    }
+
+    /** Replace the response. An empty one clears it. */
+    void
+    store( std::string response )
+    {
+        std::shared_ptr<std::string const> p;
+        if( !response.empty() )
+            p = std::make_shared<std::string const>( std::move( response ) );
+        std::lock_guard<std::mutex> lock( mutex_ );
+        staple_ = std::move( p );
+    }
+
+    /** Return the current response, or null. */
+    std::shared_ptr<std::string const>
+    load() const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        return staple_;
+    }
+
+    /** Set the function that fetches fresh responses. */
+    void
+    set_source( source_type fetch, std::chrono::seconds refresh )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            source_ = std::move( fetch );
+            refresh_ = (std::max)( refresh, std::chrono::seconds( 1 ) );
+            ++generation_;
+            if( active_ )
+                launch();
+        }
+        cv_.notify_all();
+    }
+
+    /** Start refreshing, once a native context needs responses.
+
+        @throws std::system_error if the thread cannot be started.
+    */
+    void
+    start()
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        active_ = true;
+        launch();
+    }
+
+private:
+    // Called with the mutex held
+    void
+    launch()
+    {
+        if( source_ && !thread_.joinable() )
+            thread_ = std::thread( [this]{ run(); } );
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        while( !stop_ )
+        {
+            if( !source_ )
+            {
+                auto gen = generation_;
+                cv_.wait( lock, [&]{ return stop_ || generation_ != gen; } );
+                continue;
+            }
+
+            auto fetch = source_;
+            auto wait = refresh_;
+            auto gen = generation_;
+            lock.unlock();
+
+            std::string response;
+            try
+            {
+                response = fetch();
+            }
+            catch( ... )
+            {
+            }
+            if( response.empty() )
+                wait = (std::min)( wait, retry_interval );
+            else
+                store( std::move( response ) );
+
+            lock.lock();
+            cv_.wait_for( lock, wait,
+                [&]{ return stop_ || generation_ != gen; } );
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::shared_ptr<std::string const> staple_;
+    source_type source_;
+    std::chrono::seconds refresh_{ 3600 };
+    std::size_t generation_ = 0;
+    bool active_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+/** Routes SNI hostnames to the contexts that serve them.
+
+    Keys are lowercase, either an exact name or a wildcard such as
+    `*.example.com`. A lookup lowercases the requested name into a
+    buffer on the stack and tries it as is, then overwrites the
+    label before its first dot with `*` and tries the wildcard
+    covering it. Selecting a context thus costs at most two hash
+    lookups and no allocation, however many names are routed.
+
+    The table is filled while the context is configured and only
+    read once streams exist, so lookups take no lock.
+*/
+class sni_router
+{
+    struct hash
+    {
+        using is_transparent = void;
+
+        std::size_t
+        operator()( std::string_view s ) const noexcept
+        {
+            return std::hash<std::string_view>{}( s );
+        }
+    };
+
+    std::unordered_map<std::string, context, hash, std::equal_to<>> routes_;
+
+    static char
+    to_lower( char c ) noexcept
+    {
+        return ( c >= 'A' && c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' ) : c;
+    }
+
+    // A name may end with the dot of the root
+    static std::string_view
+    trim( std::string_view name ) noexcept
+    {
+        if( !name.empty() && name.back() == '.' )
+            name.remove_suffix( 1 );
+        return name;
+    }
+
+public:
+    /// The longest hostname DNS allows.
+    static constexpr std::size_t max_name = 253;
+
+    bool
+    empty() const noexcept
+    {
+        return routes_.empty();
+    }
+
+    /** Route a name, replacing any route it had.
+
+        @return `false` if `name` is not an exact name or a
+            leading wildcard.
+    */
+    bool
+    insert( std::string_view name, context const& ctx )
+    {
+        name = trim( name );
+        if( name.empty() || name.size() > max_name )
+            return false;
+        auto star = name.rfind( '*' );
+        if( star != std::string_view::npos &&
+            ( star != 0 || name.size() < 3 || name[1] != '.' ) )
+            return false;
+
+        std::string key( name );
+        for( auto& c : key )
+            c = to_lower( c );
+        routes_.insert_or_assign( std::move( key ), ctx );
+        return true;
+    }
+
+    /** Return the context serving a requested name, or null. */
+    context const*
+    find( std::string_view name ) const noexcept
+    {
+        name = trim( name );
+        if( name.empty() || name.size() > max_name )
+            return nullptr;
+
+        char buf[max_name];
+        for( std::size_t i = 0; i < name.size(); ++i )
+            buf[i] = to_lower( name[i] );
+        std::string_view key( buf, name.size() );
+        auto it = routes_.find( key );
+        if( it != routes_.end() )
+            return &it->second;
+
+        auto dot = key.find( '.' );
+        if( dot == std::string_view::npos || dot == 0 )
+            return nullptr;
+        buf[dot - 1] = '*';
+        it = routes_.find( key.substr( dot - 1 ) );
+        if( it != routes_.end() )
+            return &it->second;
+        return nullptr;
+    }
+};
+
+/** Server contexts built on demand, kept in an LRU.
+
+    acquire() finds or creates the entry of a hostname. A new entry
+    is queued as a job on the cache's own pool, which calls the
+    loader and then the backend's warm function to build the native
+    context, so that neither runs on an I/O thread. Handshakes that
+    find the entry still loading wait on it, so each hostname is
+    loaded once however many ask for it at the same time.
+
+    Entries are shared: the cache drops its reference when one falls
+    off the end of the LRU, while a handshake waiting on it, and the
+    job loading it, keep theirs.
+*/
+class server_context_cache
+{
+public:
+    using loader_type =
+        std::function<std::optional<context>( std::string_view )>;
+    using warm_type = void (*)( context const& );
+
+    class entry : handshake_pool::job
+    {
+        friend class server_context_cache;
+
+        struct waiter
+        {
+            waiter* next = nullptr;
+            std::coroutine_handle<> h;
+            capy::executor_ref ex;
+        };
+
+        server_context_cache& cache_;
+        warm_type warm_;
+        std::shared_ptr<entry> self_;   // set while loading
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        waiter* waiters_ = nullptr;     // newest first
+        std::atomic<bool> ready_{ false };
+        std::optional<context> ctx_;
+
+        static void
+        do_run( handshake_pool::job* j )
+        {
+            auto* e = static_cast<entry*>( j );
+            std::optional<context> ctx;
+            try
+            {
+                ctx = e->cache_.loader_( e->name );
+                if( ctx && e->warm_ )
+                    e->warm_( *ctx );
+            }
+            catch( ... )
+            {
+                ctx.reset();
+            }
+            e->finish( std::move( ctx ) );
+        }
+
+        void
+        finish( std::optional<context> ctx ) noexcept
+        {
+            // Released last, as it may hold the only reference
+            auto self = std::move( self_ );
+
+            waiter* list;
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                ctx_ = std::move( ctx );
+                ready_.store( true, std::memory_order_release );
+                list = waiters_;
+                waiters_ = nullptr;
+            }
+            cv_.notify_all();
+
+            waiter* head = nullptr;
+            while( list )
+            {
+                waiter* next = list->next;
+                list->next = head;
+                head = list;
+                list = next;
+            }
+            while( head )
+            {
+                waiter* next = head->next;
+                head->ex.post( head->h );
+                head = next;
+            }
+        }
+
+        // Returns true if w must suspend
+        bool
+        enqueue( waiter& w )
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            if( ready_.load( std::memory_order_relaxed ) )
+                return false;
+            w.next = waiters_;
+            waiters_ = &w;
+            return true;
+        }
+
+        class wait_awaitable
+        {
+            entry& e_;
+            waiter w_;
+
+        public:
+            explicit
+            wait_awaitable( entry& e ) noexcept
+                : e_( e )
+            {
+            }
+
+            bool
+            await_ready() const noexcept
+            {
+                return e_.ready();
+            }
+
+            template<typename Ex>
+            bool
+            await_suspend(
+                std::coroutine_handle<> h,
+                Ex const& ex,
+                std::stop_token )
+            {
+                w_.h = h;
+                w_.ex = ex;
+
+                // Keeps the io_context running while the load does
+                w_.ex.on_work_started();
+                return e_.enqueue( w_ );
+            }
+
+            void
+            await_resume() noexcept
+            {
+                if( w_.h )
+                    w_.ex.on_work_finished();
+            }
+        };
+
+    public:
+        /// The lowercase hostname.
+        std::string const name;
+
+        entry(
+            server_context_cache& cache,
+            std::string name_,
+            warm_type warm )
+            : cache_( cache )
+            , warm_( warm )
+            , name( std::move( name_ ) )
+        {
+            this->run = &do_run;
+        }
+
+        /// Return true once the load has finished.
+        bool
+        ready() const noexcept
+        {
+            return ready_.load( std::memory_order_acquire );
+        }
+
+        /** Return the loaded context, or null if there is none.
+
+            Only valid once @ref ready returns true.
+        */
+        context const*
+        get() const noexcept
+        {
+            return ctx_ ? &*ctx_ : nullptr;
+        }
+
+        /// Return an awaitable that completes once the load has finished.
+        wait_awaitable
+        wait() noexcept
+        {
+            return wait_awaitable( *this );
+        }
+
+        /// Block the calling thread until the load has finished.
+        void
+        wait_blocking()
+        {
+            std::unique_lock<std::mutex> lock( mutex_ );
+            cv_.wait( lock, [this]{ return ready_.load( std::memory_order_relaxed ); } );
+        }
+    };
+
+    server_context_cache(
+        loader_type loader,
+        std::size_t capacity,
+        std::size_t threads )
+        : loader_( std::move( loader ) )
+        , capacity_( (std::max)( capacity, std::size_t( 1 ) ) )
+        , threads_( (std::max)( threads, std::size_t( 1 ) ) )
+    {
+    }
+
+    /** Return the entry of a hostname, starting its load if new.
+
+        @param name The requested hostname, in any case.
+        @param warm Called on the loaded context, on the loading
+            thread, to build the backend's native context.
+
+        @return The entry, or null if `name` is not a hostname.
+
+        @throws std::system_error if the pool cannot be started.
+    */
+    std::shared_ptr<entry>
+    acquire( std::string_view name, warm_type warm )
+    {
+        if( !name.empty() && name.back() == '.' )
+            name.remove_suffix( 1 );
+        if( name.empty() || name.size() > sni_router::max_name )
+            return nullptr;
+        std::string key( name );
+        for( auto& c : key )
+            if( c >= 'A' && c <= 'Z' )
+                c = static_cast<char>( c - 'A' + 'a' );
+
+        std::lock_guard<std::mutex> lock( mutex_ );
+        auto it = index_.find( std::string_view( key ) );
+        if( it != index_.end() )
+        {
+            lru_.splice( lru_.begin(), lru_, it->second );
+            return *it->second;
+        }
+
+        if( !pool_ )
+            pool_ = std::make_unique<handshake_pool>( threads_ );
+
+        auto e = std::make_shared<entry>( *this, std::move( key ), warm );
+        lru_.push_front( e );
+        index_.emplace( std::string_view( e->name ), lru_.begin() );
+        while( lru_.size() > capacity_ )
+        {
+            index_.erase( std::string_view( lru_.back()->name ) );
+            lru_.pop_back();
+        }
+
+        e->self_ = e;
+        pool_->post( e.get() );
+        return e;
+    }
+
+private:
+    using lru_list = std::list<std::shared_ptr<entry>>;
+
+    loader_type loader_;
+    std::size_t capacity_;
+    std::size_t threads_;
+
+    std::mutex mutex_;
+    lru_list lru_;  // most recently requested first
+    std::unordered_map<std::string_view, lru_list::iterator> index_;
+
+    // Last, so that its threads stop before the rest goes away
+    std::unique_ptr<handshake_pool> pool_;
+};
+
+/** The server name state of a stream's handshake.
+
+    The backend's callbacks reach it through the native session.
+*/
+struct server_name_state
+{
+    // The loaded context the handshake switched to, kept alive for
+    // as long as the session refers to its native context
+    std::optional<context> routed;
+
+    // The load the handshake waits for, if any
+    std::shared_ptr<server_context_cache::entry> pending;
+};
+
 struct context_data
 {
+    /** Construct settings allocated from `mr`.
+
+        The credentials, trust anchors and other loaded data are
+        allocated from it; the callbacks and caches are not.
+    */
+    explicit
+    context_data(
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource() )
+        : resource( mr )
+        , entity_certificate( mr )
+        , certificate_chain( mr )
+        , private_key( mr )
+        , ca_certificates( mr )
+        , verify_paths( mr )
+        , ciphersuites( mr )
+        , alpn_protocols( mr )
+        , crypto_provider( mr )
+        , crypto_properties( mr )
+        , crypto_engine( mr )
+        , hostname( mr )
+        , crls( mr )
+    {
+    }
+
+    std::pmr::memory_resource* resource;
+
     //--------------------------------------------
     // Credentials
 
-    std::string entity_certificate;
+    std::pmr::string entity_certificate;
     file_format entity_cert_format = file_format::pem;
-    std::string certificate_chain;
-    std::string private_key;
+    std::pmr::string certificate_chain;
+    std::pmr::string private_key;
     file_format private_key_format = file_format::pem;
 
     //--------------------------------------------
     // Trust anchors
 
-    std::vector<std::string> ca_certificates;
-    std::vector<std::string> verify_paths;
+    std::pmr::vector<std::pmr::string> ca_certificates;
+    std::pmr::vector<std::pmr::string> verify_paths;
     bool use_default_verify_paths = false;
 
     //--------------------------------------------
@@ -59,30 +889,80 @@ struct context_data
 
     version min_version = version::tls_1_2;
     version max_version = version::tls_1_3;
-    std::string ciphersuites;
-    std::vector<std::string> alpn_protocols;
+    std::pmr::string ciphersuites;
+    std::pmr::vector<std::pmr::string> alpn_protocols;
+    bool kernel_tls = false;
+    std::size_t handshake_threads = 0;
+    bool dynamic_records = false;
+
+    //--------------------------------------------
+    // Crypto offload
+
+    std::pmr::string crypto_provider;
+    std::pmr::string crypto_properties;
+    std::pmr::string crypto_engine;
+    int crypto_device = -1;
+    bool async_crypto = false;
 
     //--------------------------------------------
     // Verification
 
     verify_mode verification_mode = verify_mode::none;
     int verify_depth = 100;
-    std::string hostname;
+    std::pmr::string hostname;
     std::function<bool( bool, void* )> verify_callback;
 
     //--------------------------------------------
     // SNI (Server Name Indication)
 
     std::function<bool( std::string_view )> servername_callback;
+    sni_router sni_routes;
+    std::unique_ptr<server_context_cache> server_contexts;
 
     //--------------------------------------------
     // Revocation
 
-    std::vector<std::string> crls;
-    std::string ocsp_staple;
+    std::pmr::vector<std::pmr::string> crls;
+    mutable ocsp_cache ocsp;
     bool require_ocsp_staple = false;
     revocation_policy revocation = revocation_policy::disabled;
 
+    //--------------------------------------------
+    // Session resumption
+
+    std::size_t session_cache_size = 20480;
+    std::chrono::seconds session_timeout{ 7200 };
+    bool session_tickets = true;
+    std::chrono::seconds ticket_key_lifetime{ 43200 };
+    std::size_t max_early_data = 0;
+    mutable session_store client_sessions;
+
+    //--------------------------------------------
+    // Handshake offload
+
+    mutable std::once_flag handshake_pool_once_;
+    mutable std::unique_ptr<handshake_pool> handshake_pool_;
+
+    /** Return the context's handshake pool, or null.
+
+        The pool is started by the first call, with the number of
+        threads configured then.
+
+        @throws std::system_error if a thread cannot be started.
+    */
+    handshake_pool*
+    get_handshake_pool() const
+    {
+        if( handshake_threads == 0 )
+            return nullptr;
+        std::call_once( handshake_pool_once_, [this]
+        {
+            handshake_pool_ = std::make_unique<handshake_pool>(
+                handshake_threads );
+        });
+        return handshake_pool_.get();
+    }
+
     //--------------------------------------------
     // Password
 
@@ -91,11 +971,28 @@ struct context_data
     //--------------------------------------------
     // Cached native contexts (intrusive list)
 
+    /*  Nodes are only ever prepended, and never change or go away
+        until the context_data is destroyed, so readers walk the
+        list without a lock. The mutex only serializes creation, so
+        that each backend builds its native context once even when
+        many threads construct streams at the same time.
+    */
     mutable std::mutex native_contexts_mutex_;
-    mutable native_context_base* native_contexts_ = nullptr;
+    mutable std::atomic<native_context_base*> native_contexts_{ nullptr };
+
+    static native_context_base*
+    find_in( native_context_base* p, void const* service ) noexcept
+    {
+        for( ; p; p = p->next_ )
+            if( p->service_ == service )
+                return p;
+        return nullptr;
+    }
 
     /** Find or insert a cached native context.
 
+        Lookups of a context that already exists take no lock.
+
         @param service The unique key for the backend.
         @param create Factory function called if not found.
 
@@ -105,28 +1002,34 @@ struct context_data
     native_context_base*
     find( void const* service, Factory&& create ) const
     {
+        if( auto* p = find_in(
+                native_contexts_.load( std::memory_order_acquire ), service ) )
+            return p;
+
         std::lock_guard<std::mutex> lock( native_contexts_mutex_ );
 
-        for( auto* p = native_contexts_; p; p = p->next_ )
-            if( p->service_ == service )
-                return p;
+        // Another thread may have created it while we waited
+        auto* head = native_contexts_.load( std::memory_order_relaxed );
+        if( auto* p = find_in( head, service ) )
+            return p;
 
-        // Not found - create and prepend
+        // Not found - create and publish
         auto* ctx = create();
         ctx->service_ = service;
-        ctx->next_ = native_contexts_;
-        native_contexts_ = ctx;
+        ctx->next_ = head;
+        native_contexts_.store( ctx, std::memory_order_release );
         return ctx;
     }
 
     ~context_data()
     {
         // Clean up cached native contexts (no lock needed - destructor)
-        while( native_contexts_ )
+        auto* p = native_contexts_.load( std::memory_order_relaxed );
+        while( p )
         {
-            auto* next = native_contexts_->next_;
-            delete native_contexts_;
-            native_contexts_ = next;
+            auto* next = p->next_;
+            delete p;
+            p = next;
         }
     }
 };
@@ -142,6 +1045,7 @@ struct context_data
 */
 struct context::impl : detail::context_data
 {
+    using context_data::context_data;
 };
 
 //------------------------------------------------------------------------------
@@ -163,6 +1067,31 @@ get_context_data( context const& ctx ) noexcept
     return *ctx.impl_;
 }
 
+/** Return the key under which a client keeps its session.
+
+    Combines the configured hostname with the remote endpoint
+    when the stream is a socket.
+
+    @return The key, or an empty string if the server cannot be
+        told apart from others.
+*/
+inline std::string
+session_peer( context_data const& cd, io_stream& s )
+{
+    std::string peer( cd.hostname );
+    if( auto* sock = dynamic_cast<socket*>( &s ) )
+    {
+        auto ep = sock->remote_endpoint();
+        peer += '|';
+        peer += ep.is_v4()
+            ? ep.v4_address().to_string()
+            : ep.v6_address().to_string();
+        peer += ':';
+        peer += std::to_string( ep.port() );
+    }
+    return peer;
+}
+
 } // namespace detail
 
 } // namespace boost::corosio::tls
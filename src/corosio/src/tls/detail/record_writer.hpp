@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#ifndef SRC_TLS_DETAIL_RECORD_WRITER_HPP
+#define SRC_TLS_DETAIL_RECORD_WRITER_HPP
+
+#include <boost/capy/buffers.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace boost::corosio::tls::detail {
+
+/** Chooses the plaintext size of the records a stream writes.
+
+    With dynamic sizing, a connection starts with records that fit
+    one TCP segment, so the peer can decrypt each as soon as it
+    arrives instead of waiting for the rest of a 16 KiB record
+    during slow start. Once a megabyte has been sent the stream
+    switches to full records, which cost the least per byte, and
+    after a second without writes it starts small again, since the
+    congestion window may have shrunk meanwhile.
+*/
+class record_sizer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// Plaintext that fits a 1400-byte segment with the record's
+    /// header, explicit nonce and tag.
+    static constexpr std::size_t small_size = 1360;
+
+    /// The largest plaintext of a record.
+    static constexpr std::size_t full_size = 16384;
+
+    /// Bytes sent in small records before switching to full ones.
+    static constexpr std::size_t ramp_bytes = 1024 * 1024;
+
+    /// Time without writes after which records start small again.
+    static constexpr std::chrono::milliseconds idle_reset{ 1000 };
+
+    /** Return the plaintext size of the next record. */
+    std::size_t
+    next( bool dynamic, clock::time_point now ) noexcept
+    {
+        if( !dynamic )
+            return full_size;
+        if( now - last_ > idle_reset )
+            sent_ = 0;
+        return sent_ < ramp_bytes ? small_size : full_size;
+    }
+
+    /** Account for plaintext written in a record. */
+    void
+    on_sent( std::size_t n, clock::time_point now ) noexcept
+    {
+        sent_ += n;
+        last_ = now;
+    }
+
+private:
+    std::size_t sent_ = 0;
+    clock::time_point last_{};
+};
+
+/** A position in the caller's buffers during a write.
+
+    @ref next returns the plaintext of the next record. When the
+    bytes at the position are contiguous for the whole record, or
+    are the last ones, it points into the caller's buffer; otherwise
+    it gathers the record from several buffers into a staging area,
+    so that a header and a body written together share a record
+    instead of the header taking one of its own.
+*/
+class write_cursor
+{
+    capy::mutable_buffer const* bufs_;
+    std::size_t count_;
+    std::size_t i_ = 0;
+    std::size_t off_ = 0;
+
+    void
+    skip_empty() noexcept
+    {
+        while( i_ < count_ && off_ == bufs_[i_].size() )
+        {
+            ++i_;
+            off_ = 0;
+        }
+    }
+
+public:
+    write_cursor(
+        capy::mutable_buffer const* bufs,
+        std::size_t count) noexcept
+        : bufs_( bufs )
+        , count_( count )
+    {
+        skip_empty();
+    }
+
+    /// Return `true` if every byte has been consumed.
+    bool
+    done() const noexcept
+    {
+        return i_ == count_;
+    }
+
+    /** Return the plaintext of the next record.
+
+        @param limit The most bytes to return.
+
+        @param stage A buffer of at least `limit` bytes to gather
+            into, or null to return only contiguous bytes.
+    */
+    capy::const_buffer
+    next( std::size_t limit, char* stage ) const noexcept
+    {
+        char const* p = static_cast<char const*>( bufs_[i_].data() ) + off_;
+        std::size_t avail = bufs_[i_].size() - off_;
+        if( avail >= limit || !stage || i_ + 1 == count_ )
+            return capy::const_buffer( p, (std::min)( avail, limit ) );
+
+        std::size_t n = 0;
+        std::size_t i = i_;
+        std::size_t off = off_;
+        while( n < limit && i < count_ )
+        {
+            std::size_t k = (std::min)( bufs_[i].size() - off, limit - n );
+            std::memcpy( stage + n,
+                static_cast<char const*>( bufs_[i].data() ) + off, k );
+            n += k;
+            ++i;
+            off = 0;
+        }
+        return capy::const_buffer( stage, n );
+    }
+
+    /** Advance past `n` bytes. */
+    void
+    consume( std::size_t n ) noexcept
+    {
+        while( n > 0 && i_ < count_ )
+        {
+            std::size_t k = (std::min)( n, bufs_[i_].size() - off_ );
+            off_ += k;
+            n -= k;
+            skip_empty();
+        }
+    }
+};
+
+} // namespace boost::corosio::tls::detail
+
+#endif
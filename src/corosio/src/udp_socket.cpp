@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/udp_socket.hpp>
+#include <boost/corosio/detail/except.hpp>
+#include <boost/corosio/detail/platform.hpp>
+
+#include "src/detail/deferred_service.hpp"
+#include "src/detail/socket_service.hpp"
+
+namespace boost::corosio {
+
+udp_socket::
+~udp_socket()
+{
+    close();
+}
+
+udp_socket::
+udp_socket(
+    capy::execution_context& ctx)
+    : io_object(ctx)
+{
+}
+
+void
+udp_socket::
+open()
+{
+    if (impl_)
+        return;
+
+    // Only backends with datagram support install a udp_service
+    auto* svc = detail::find_deferred_service<detail::udp_service>(
+        *ctx_, detail::deferred_service::udp);
+    if (!svc)
+        detail::throw_logic_error("udp_socket::open: no udp service installed");
+    auto& wrapper = svc->create_udp_impl();
+    impl_ = &wrapper;
+    system::error_code ec = svc->open_udp_socket(wrapper);
+    if (ec)
+    {
+        wrapper.release();
+        impl_ = nullptr;
+        detail::throw_system_error(ec, "udp_socket::open");
+    }
+}
+
+void
+udp_socket::
+bind(endpoint ep)
+{
+    open();
+    system::error_code ec = get().bind(ep);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::bind");
+}
+
+void
+udp_socket::
+close()
+{
+    if (!impl_)
+        return;
+
+    impl_->release();
+    impl_ = nullptr;
+}
+
+void
+udp_socket::
+cancel()
+{
+    if (!impl_)
+        return;
+    get().cancel();
+}
+
+native_handle_type
+udp_socket::
+native_handle() const noexcept
+{
+    if (!impl_)
+    {
+#if BOOST_COROSIO_HAS_IOCP
+        return static_cast<native_handle_type>(~0ull);  // INVALID_SOCKET
+#else
+        return -1;
+#endif
+    }
+    return get().native_handle();
+}
+
+endpoint
+udp_socket::
+local_endpoint() const noexcept
+{
+    if (!impl_)
+        return endpoint{};
+    return get().local_endpoint();
+}
+
+//------------------------------------------------------------------------------
+// Socket Options
+//------------------------------------------------------------------------------
+
+void
+udp_socket::
+set_receive_buffer_size(int size)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_receive_buffer_size: socket not open");
+    system::error_code ec = get().set_receive_buffer_size(size);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::set_receive_buffer_size");
+}
+
+int
+udp_socket::
+receive_buffer_size() const
+{
+    if (!impl_)
+        detail::throw_logic_error("receive_buffer_size: socket not open");
+    system::error_code ec;
+    int result = get().receive_buffer_size(ec);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::receive_buffer_size");
+    return result;
+}
+
+void
+udp_socket::
+set_send_buffer_size(int size)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_send_buffer_size: socket not open");
+    system::error_code ec = get().set_send_buffer_size(size);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::set_send_buffer_size");
+}
+
+int
+udp_socket::
+send_buffer_size() const
+{
+    if (!impl_)
+        detail::throw_logic_error("send_buffer_size: socket not open");
+    system::error_code ec;
+    int result = get().send_buffer_size(ec);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::send_buffer_size");
+    return result;
+}
+
+void
+udp_socket::
+set_gso_segment(std::size_t size)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_gso_segment: socket not open");
+    system::error_code ec = get().set_gso_segment(size);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::set_gso_segment");
+}
+
+std::size_t
+udp_socket::
+gso_segment() const
+{
+    if (!impl_)
+        detail::throw_logic_error("gso_segment: socket not open");
+    system::error_code ec;
+    std::size_t result = get().gso_segment(ec);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::gso_segment");
+    return result;
+}
+
+void
+udp_socket::
+set_gro(bool enabled)
+{
+    if (!impl_)
+        detail::throw_logic_error("set_gro: socket not open");
+    system::error_code ec = get().set_gro(enabled);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::set_gro");
+}
+
+bool
+udp_socket::
+gro() const
+{
+    if (!impl_)
+        detail::throw_logic_error("gro: socket not open");
+    system::error_code ec;
+    bool result = get().gro(ec);
+    if (ec)
+        detail::throw_system_error(ec, "udp_socket::gro");
+    return result;
+}
+
+} // namespace boost::corosio
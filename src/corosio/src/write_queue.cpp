@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/write_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+/*
+    Write Queue
+    ===========
+
+    Each call to write() keeps a writer record in its own coroutine
+    frame and links it into one of two lists under mutex_: the queue,
+    whose bytes count against limit_, or the blocked list of writers
+    waiting for room. Both are FIFO.
+
+    The Lead
+    --------
+    At most one writer, the lead, performs writes on the stream; it
+    is marked by flushing_. A writer that joins an empty queue
+    becomes the lead and does not suspend. Every other queued writer
+    suspends until it is either done or handed the lead.
+
+    The lead repeatedly gathers the unsent part of up to max_gather
+    queued buffers and writes them with one write_some. Outside the
+    lock, the queue only grows at its tail, so the gathered records
+    stay at its head. The bytes written are then taken from the
+    writers in queue order, completing each one whose buffer is
+    empty. A failed write completes every queued writer with the
+    error. Blocked writers are then moved into the queue while
+    there is room.
+
+    When the lead's own writer completes, it hands the lead to the
+    writer now at the head of the queue, if any, and returns. The
+    lead never posts itself, and a handed-off writer is resumed
+    through its own executor.
+
+    Waking Writers
+    --------------
+    A writer's record lives in a frame that may be destroyed as
+    soon as it is resumed, so completed writers are unlinked and
+    their handles read under the lock, and posted only after it is
+    released, each reading its next link before the post.
+*/
+
+namespace boost::corosio {
+
+// Joins the queue, or the blocked list while there is no room,
+// and suspends unless the writer becomes the lead
+class write_queue::join_awaitable
+{
+    write_queue& self_;
+    writer& w_;
+
+public:
+    join_awaitable(write_queue& self, writer& w) noexcept
+        : self_(self)
+        , w_(w)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+    bool await_suspend(
+        std::coroutine_handle<> h,
+        capy::executor_ref ex,
+        std::stop_token) noexcept
+    {
+        std::lock_guard<std::mutex> lock(self_.mutex_);
+        std::size_t const size = w_.buf.size();
+        if (self_.blocked_ ||
+            (self_.queued_ > 0 && self_.queued_ + size > self_.limit_))
+        {
+            if (self_.blocked_tail_)
+                self_.blocked_tail_->next = &w_;
+            else
+                self_.blocked_ = &w_;
+            self_.blocked_tail_ = &w_;
+        }
+        else
+        {
+            if (self_.tail_)
+                self_.tail_->next = &w_;
+            else
+                self_.head_ = &w_;
+            self_.tail_ = &w_;
+            self_.queued_ += size;
+
+            if (!self_.flushing_)
+            {
+                self_.flushing_ = true;
+                w_.lead = true;
+                return false;
+            }
+        }
+        w_.h = h;
+        w_.ex = ex;
+        return true;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+write_queue::
+write_queue(
+    io_stream& s,
+    std::size_t limit) noexcept
+    : s_(s)
+    , limit_(limit)
+{
+}
+
+std::size_t
+write_queue::
+queued() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+}
+
+capy::task<capy::io_result<std::size_t>>
+write_queue::
+write(capy::const_buffer buffer)
+{
+    if (buffer.size() == 0)
+        co_return {{}, 0};
+
+    writer w;
+    w.buf = buffer;
+    co_await join_awaitable(*this, w);
+
+    // Resumed either done, or as the lead
+    while (!w.done)
+        co_await send_queued(w);
+
+    co_return {w.ec, w.sent};
+}
+
+capy::task<>
+write_queue::
+send_queued(writer& lead)
+{
+    std::array<capy::const_buffer, max_gather> bufs;
+    std::size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (writer* p = head_; p && count < max_gather; p = p->next)
+            bufs[count++] = p->buf;
+    }
+
+    auto [ec, n] = co_await s_.write_some(
+        std::span<capy::const_buffer const>(bufs.data(), count));
+
+    writer* wake = nullptr;
+    writer* wake_tail = nullptr;
+    auto complete = [&](writer* p)
+    {
+        p->done = true;
+        p->next = nullptr;
+        if (p == &lead)
+            return;
+        if (wake_tail)
+            wake_tail->next = p;
+        else
+            wake = p;
+        wake_tail = p;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (head_)
+        {
+            writer* p = head_;
+            if (ec)
+            {
+                p->ec = ec;
+            }
+            else
+            {
+                std::size_t k = (std::min)(n, p->buf.size());
+                p->buf += k;
+                p->sent += k;
+                n -= k;
+                queued_ -= k;
+                if (p->buf.size() > 0)
+                    break;
+            }
+            queued_ -= p->buf.size();
+            head_ = p->next;
+            if (!head_)
+                tail_ = nullptr;
+            complete(p);
+        }
+
+        // Admit blocked writers in order while there is room; they
+        // stay suspended until done or handed the lead
+        while (blocked_ &&
+            (queued_ == 0 || queued_ + blocked_->buf.size() <= limit_))
+        {
+            writer* p = blocked_;
+            blocked_ = p->next;
+            if (!blocked_)
+                blocked_tail_ = nullptr;
+            p->next = nullptr;
+            if (tail_)
+                tail_->next = p;
+            else
+                head_ = p;
+            tail_ = p;
+            queued_ += p->buf.size();
+        }
+
+        if (lead.done)
+        {
+            flushing_ = false;
+            if (head_)
+            {
+                // The new lead stays queued, so its next link is
+                // not part of the wake list, which ends at it
+                flushing_ = true;
+                head_->lead = true;
+                if (wake_tail)
+                    wake_tail->next = head_;
+                else
+                    wake = head_;
+                wake_tail = head_;
+            }
+        }
+    }
+
+    while (wake)
+    {
+        writer* next = wake == wake_tail ? nullptr : wake->next;
+        wake->ex.post(wake->h);
+        wake = next;
+    }
+}
+
+} // namespace boost::corosio
@@ -8,6 +8,7 @@
 //
 
 #include <boost/corosio/tls/openssl_stream.hpp>
+#include <boost/corosio/buffer_pool.hpp>
 #include <boost/capy/ex/coro_lock.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/error.hpp>
@@ -15,19 +16,65 @@
 
 // Internal context implementation
 #include "src/tls/detail/context_impl.hpp"
+#include "src/tls/detail/record_writer.hpp"
 
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/bio.h>
+#include <openssl/ocsp.h>
+#include <openssl/rand.h>
 #include <openssl/x509.h>
+#ifndef OPENSSL_NO_ENGINE
+#include <openssl/engine.h>
+#endif
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <openssl/provider.h>
+#endif
 
 #include "src/detail/resume_coro.hpp"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <system_error>
 #include <vector>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <poll.h>
+#endif
+
+// Kernel TLS needs OpenSSL 3 built with KTLS, and Linux
+#if defined( __linux__ ) && defined( SSL_OP_ENABLE_KTLS ) && \
+    defined( BIO_CTRL_SET_KTLS ) && __has_include( <linux/tls.h> )
+#define BOOST_COROSIO_OPENSSL_KTLS 1
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#else
+#define BOOST_COROSIO_OPENSSL_KTLS 0
+#endif
+
 /*
     openssl_stream Architecture
     ===========================
@@ -35,10 +82,19 @@
     TLS layer wrapping an underlying io_stream. Supports one concurrent
     read_some and one concurrent write_some (like Asio's ssl::stream).
 
-    Data Flow (using BIO pairs)
-    ---------------------------
-    App -> SSL_write -> int_bio_ -> BIO_read(ext_bio_) -> out_buf_ -> s_.write_some -> Network
-    App <- SSL_read  <- int_bio_ <- BIO_write(ext_bio_) <- in_buf_ <- s_.read_some  <- Network
+    Data Flow (using a lease BIO)
+    -----------------------------
+    App -> SSL_write -> bio_write -> out_lease_ -> s_.write_some  -> Network
+    App <- SSL_read  <- bio_read  <- in_lease_  <- s_.read_leased <- Network
+
+    The SSL's BIO reads and writes buffers leased from the context's
+    buffer_pool instead of keeping buffers of its own, as a BIO pair
+    does for the life of the connection. in_lease_ is the lease of a
+    read_leased, which on a socket takes a buffer only once data has
+    arrived, and is returned as soon as OpenSSL has consumed it.
+    out_lease_ is taken by the first bio_write and returned once
+    flushed. With SSL_MODE_RELEASE_BUFFERS releasing OpenSSL's record
+    buffers too, an idle stream holds no buffers.
 
     WANT_READ / WANT_WRITE Pattern
     ------------------------------
@@ -46,15 +102,91 @@
     when they need I/O. Our coroutine handles this by:
 
       1. Call SSL_read or SSL_write
-      2. Check for pending output in ext_bio_ via BIO_ctrl_pending
-      3. If output pending: write to network via s_.write_some
-      4. If SSL_ERROR_WANT_READ: read from network into ext_bio_ via s_.read_some + BIO_write
-      5. Loop back to step 1
+      2. If output is pending in out_lease_: write it via s_.write_some
+      3. If SSL_ERROR_WANT_READ: fill in_lease_ via s_.read_leased
+      4. Loop back to step 1
+
+    A read keeps calling SSL_read while the caller's buffers have room
+    and the records already received last, and completes only when
+    OpenSSL would need more input. read_input sizes its lease to the
+    caller's buffers, so a large read can take many records at once.
+
+    A write encrypts records until the caller's buffers are used up or
+    out_lease_ is full, and sends them together. Each record takes up
+    to the size record_sizer chooses; bytes spanning several of the
+    caller's buffers are gathered into stage_ first, so a header and
+    its body share a record. out_lease_ is sized to the write.
 
     Renegotiation causes cross-direction I/O: SSL_read may need to write
     handshake data, SSL_write may need to read. Each operation handles
     whatever I/O direction OpenSSL requests.
 
+    Kernel TLS
+    ----------
+    With context::set_kernel_tls, the SSL has SSL_OP_ENABLE_KTLS and,
+    when it switches to new send keys, passes them to the BIO with
+    BIO_CTRL_SET_KTLS. The BIO installs them on the socket, after
+    sending what is still buffered, and reports offload from then on.
+    OpenSSL then writes records to the BIO unencrypted, marking other
+    records than application data with
+    BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG; those are buffered alone and
+    sent by flush_output with sendmsg and a TLS_SET_RECORD_TYPE cmsg.
+    Application data bypasses OpenSSL: do_write_some writes the
+    caller's buffers straight to the socket. Receive keys are
+    declined, so reads are decrypted by OpenSSL as before.
+
+    SNI Routing
+    -----------
+    A context with hostnames routed by add_server_context installs
+    sni_callback, which looks the requested name up in the context's
+    sni_router and moves the SSL to the routed context's SSL_CTX with
+    SSL_set_SSL_CTX. That SSL_CTX is cached like any other, so each
+    routed context is built once, on the first handshake naming it.
+
+    A context with a server context loader also installs
+    client_hello_callback, which reads the name from the ClientHello
+    and asks the context's server_context_cache for it. While the
+    load runs, the callback returns SSL_CLIENT_HELLO_RETRY and leaves
+    the entry in the stream's server_name_state; SSL_accept then
+    fails with SSL_ERROR_WANT_CLIENT_HELLO_CB, and run_handshake waits
+    on the entry before calling SSL_accept again. The stream keeps
+    the loaded context, since its SSL_CTX and the callbacks' ex data
+    belong to it, for as long as the SSL may use them.
+
+    Early Data
+    ----------
+    A context with set_max_early_data sets the limit on the SSL_CTX
+    for both sending tickets and receiving, and turns off OpenSSL's
+    single-use ticket cache (SSL_OP_NO_ANTI_REPLAY): whether a request
+    may be replayed is for the application to decide.
+
+    do_handshake_early resumes the cached session and, if its ticket
+    allows early data, writes it with SSL_write_early_data before
+    running the handshake. The bytes count as sent only if the server
+    accepted them. do_read_early_data steps SSL_read_early_data,
+    which runs the server handshake up to the client's Finished, and
+    flushes the server's flight as it goes. Both share handshake_wait
+    with run_handshake for the WANT_* states.
+
+    Crypto Offload
+    --------------
+    A context with set_crypto_provider builds its SSL_CTX in a library
+    context of its own holding that provider, with "default" loaded
+    behind it for the algorithms it lacks; the private key is decoded
+    in the same library context so signing uses the provider.
+    set_crypto_engine instead initializes an ENGINE and makes it the
+    process default. Either failing to load leaves the native context
+    null, so streams fail with function_not_supported rather than
+    quietly running in software.
+
+    With set_async_crypto, init_ssl sets SSL_MODE_ASYNC and an engine
+    or provider that runs RSA or ECDHE as an asynchronous job pauses
+    the step with SSL_ERROR_WANT_ASYNC. handshake_wait then waits on
+    the job's fds: on a handshake thread when the context has them,
+    otherwise by polling and yielding to the executor, and the step
+    is called again. run_handshake clears the mode once the handshake
+    is over, so record encryption stays a plain call.
+
     Key Types
     ---------
     - openssl_stream_impl_ : tls_stream_impl  -- the impl stored in io_object::impl_
@@ -68,8 +200,14 @@ namespace {
 // Default buffer size for TLS I/O
 constexpr std::size_t default_buffer_size = 16384;
 
-// Maximum number of buffers to handle in a single operation
-constexpr std::size_t max_buffers = 8;
+// Largest plaintext of a record, and the most a record adds to it
+constexpr std::size_t max_record_size = 16384;
+constexpr std::size_t record_overhead = 5 + 256;
+
+// Maximum number of buffers to handle in a single operation. Large
+// enough for the fragments of a serialized message, which a write
+// gathers into records.
+constexpr std::size_t max_buffers = 64;
 
 // Buffer array type for coroutine parameters (copied into frame)
 using buffer_array = std::array<capy::mutable_buffer, max_buffers>;
@@ -87,17 +225,71 @@ namespace tls::detail {
 // Ex data index for storing context_data pointer in SSL_CTX
 static int sni_ctx_data_index = -1;
 
-// SNI callback invoked by OpenSSL during handshake
+// Ex data index for storing the openssl_native_context in SSL_CTX
+static int native_ctx_index = -1;
+
+// Ex data index for storing a server stream's server_name_state in SSL
+static int server_name_index = -1;
+
+// Identifies OpenSSL sessions in context_data::client_sessions
+static char session_backend;
+
+// Invoked by OpenSSL for each session a client receives, including
+// TLS 1.3 tickets that arrive after the handshake. The SSL's app
+// data is the key of its server in the client session store.
 static int
-sni_callback( SSL* ssl, int* /* alert */, void* /* arg */ )
+new_session_callback( SSL* ssl, SSL_SESSION* sess )
+{
+    auto const* peer = static_cast<std::string const*>( SSL_get_app_data( ssl ) );
+    auto const* cd = static_cast<context_data const*>(
+        SSL_CTX_get_ex_data( SSL_get_SSL_CTX( ssl ), sni_ctx_data_index ) );
+    if( SSL_is_server( ssl ) || !peer || peer->empty() || !cd ||
+        !SSL_SESSION_is_resumable( sess ) )
+        return 0;
+
+    try
+    {
+        cd->client_sessions.insert( &session_backend, *peer,
+            std::shared_ptr<void>( sess, []( void* p )
+            {
+                SSL_SESSION_free( static_cast<SSL_SESSION*>( p ) );
+            }),
+            cd->session_cache_size );
+    }
+    catch( std::bad_alloc const& )
+    {
+        // The session was freed along with its handle
+        return 1;
+    }
+    return 1;  // The store holds the reference
+}
+
+inline SSL_CTX* get_openssl_context( context_data const& cd );
+
+// SNI callback invoked by OpenSSL during handshake. A routed name
+// moves the SSL to the SSL_CTX of its context, which supplies the
+// certificate from here on. The argument is the context_data of the
+// SSL_CTX the handshake began with, which a loaded context may have
+// replaced by now.
+static int
+sni_callback( SSL* ssl, int* /* alert */, void* arg )
 {
     char const* servername = SSL_get_servername( ssl, TLSEXT_NAMETYPE_host_name );
     if( !servername )
         return SSL_TLSEXT_ERR_NOACK;  // No SNI sent, continue
 
-    SSL_CTX* ctx = SSL_get_SSL_CTX( ssl );
-    auto* cd = static_cast<context_data const*>(
-        SSL_CTX_get_ex_data( ctx, sni_ctx_data_index ) );
+    auto* cd = static_cast<context_data const*>( arg );
+
+    if( cd && !cd->sni_routes.empty() )
+    {
+        if( auto const* routed = cd->sni_routes.find( servername ) )
+        {
+            SSL_CTX* routed_ctx = get_openssl_context(
+                get_context_data( *routed ) );
+            if( !routed_ctx || !SSL_set_SSL_CTX( ssl, routed_ctx ) )
+                return SSL_TLSEXT_ERR_ALERT_FATAL;
+        }
+    }
 
     if( cd && cd->servername_callback )
     {
@@ -108,6 +300,256 @@ sni_callback( SSL* ssl, int* /* alert */, void* /* arg */ )
     return SSL_TLSEXT_ERR_OK;
 }
 
+// Builds the SSL_CTX of a loaded context, on the loading thread
+static void
+warm_loaded_context( context const& ctx )
+{
+    get_openssl_context( get_context_data( ctx ) );
+}
+
+// Returns the host name a ClientHello requests, or an empty string
+static std::string_view
+client_hello_server_name( SSL* ssl )
+{
+    unsigned char const* p = nullptr;
+    std::size_t len = 0;
+    if( !SSL_client_hello_get0_ext( ssl, TLSEXT_TYPE_server_name, &p, &len ) )
+        return {};
+
+    // A list of names, of which only the first host name counts
+    if( len < 5 || ( ( std::size_t( p[0] ) << 8 ) | p[1] ) + 2 != len ||
+        p[2] != TLSEXT_NAMETYPE_host_name )
+        return {};
+    std::size_t n = ( std::size_t( p[3] ) << 8 ) | p[4];
+    if( n + 5 > len )
+        return {};
+    return { reinterpret_cast<char const*>( p + 5 ), n };
+}
+
+// Invoked by OpenSSL on a server when the ClientHello arrives. A
+// name neither routed nor loaded yet starts its load and pauses the
+// handshake, which waits for the load and then calls SSL_accept
+// again, invoking this again.
+static int
+client_hello_callback( SSL* ssl, int* alert, void* arg )
+{
+    auto const* cd = static_cast<context_data const*>( arg );
+    auto* state = static_cast<server_name_state*>(
+        SSL_get_ex_data( ssl, server_name_index ) );
+    if( !cd || !cd->server_contexts || !state )
+        return SSL_CLIENT_HELLO_SUCCESS;
+
+    auto entry = std::move( state->pending );
+    if( !entry )
+    {
+        auto name = client_hello_server_name( ssl );
+        if( name.empty() || cd->sni_routes.find( name ) )
+            return SSL_CLIENT_HELLO_SUCCESS;
+        try
+        {
+            entry = cd->server_contexts->acquire( name, &warm_loaded_context );
+        }
+        catch( std::system_error const& )
+        {
+            *alert = SSL_AD_INTERNAL_ERROR;
+            return SSL_CLIENT_HELLO_ERROR;
+        }
+        if( !entry )
+            return SSL_CLIENT_HELLO_SUCCESS;
+    }
+
+    if( !entry->ready() )
+    {
+        state->pending = std::move( entry );
+        return SSL_CLIENT_HELLO_RETRY;
+    }
+
+    if( auto const* loaded = entry->get() )
+    {
+        SSL_CTX* loaded_ctx = get_openssl_context( get_context_data( *loaded ) );
+        if( !loaded_ctx || !SSL_set_SSL_CTX( ssl, loaded_ctx ) )
+        {
+            *alert = SSL_AD_INTERNAL_ERROR;
+            return SSL_CLIENT_HELLO_ERROR;
+        }
+        state->routed = *loaded;
+    }
+    return SSL_CLIENT_HELLO_SUCCESS;
+}
+
+#ifndef OPENSSL_NO_OCSP
+// Returns the issuer of a peer's certificate, from the chain it
+// sent or the trusted store. The caller frees it.
+static X509*
+find_issuer( SSL* ssl, X509* leaf )
+{
+    STACK_OF( X509 )* chain = SSL_get_peer_cert_chain( ssl );
+    for( int i = 0; chain && i < sk_X509_num( chain ); ++i )
+    {
+        X509* cand = sk_X509_value( chain, i );
+        if( cand != leaf && X509_check_issued( cand, leaf ) == X509_V_OK )
+        {
+            X509_up_ref( cand );
+            return cand;
+        }
+    }
+
+    X509* issuer = nullptr;
+    X509_STORE_CTX* sctx = X509_STORE_CTX_new();
+    if( sctx && X509_STORE_CTX_init( sctx,
+            SSL_CTX_get_cert_store( SSL_get_SSL_CTX( ssl ) ), leaf, chain ) )
+    {
+        if( X509_STORE_CTX_get1_issuer( &issuer, sctx, leaf ) != 1 )
+            issuer = nullptr;
+    }
+    X509_STORE_CTX_free( sctx );
+    return issuer;
+}
+
+// Checks a server's stapled response against the peer chain and the
+// trusted store, without contacting the responder. Returns the
+// certificate's status, or -1 if the response is absent or cannot
+// be trusted.
+static int
+stapled_status( SSL* ssl )
+{
+    unsigned char const* der = nullptr;
+    long len = SSL_get_tlsext_status_ocsp_resp( ssl, &der );
+    if( !der || len <= 0 )
+        return -1;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    X509* leaf = SSL_get1_peer_certificate( ssl );
+#else
+    X509* leaf = SSL_get_peer_certificate( ssl );
+#endif
+    OCSP_RESPONSE* resp = d2i_OCSP_RESPONSE( nullptr, &der, len );
+    OCSP_BASICRESP* basic = nullptr;
+    X509* issuer = nullptr;
+    OCSP_CERTID* id = nullptr;
+    int result = -1;
+
+    if( leaf && resp &&
+        OCSP_response_status( resp ) == OCSP_RESPONSE_STATUS_SUCCESSFUL &&
+        ( basic = OCSP_response_get1_basic( resp ) ) != nullptr &&
+        OCSP_basic_verify( basic, SSL_get_peer_cert_chain( ssl ),
+            SSL_CTX_get_cert_store( SSL_get_SSL_CTX( ssl ) ), 0 ) > 0 &&
+        ( issuer = find_issuer( ssl, leaf ) ) != nullptr &&
+        ( id = OCSP_cert_to_id( nullptr, leaf, issuer ) ) != nullptr )
+    {
+        int status = -1;
+        int reason = 0;
+        ASN1_GENERALIZEDTIME* revoked_at = nullptr;
+        ASN1_GENERALIZEDTIME* this_update = nullptr;
+        ASN1_GENERALIZEDTIME* next_update = nullptr;
+        if( OCSP_resp_find_status( basic, id, &status, &reason,
+                &revoked_at, &this_update, &next_update ) == 1 &&
+            OCSP_check_validity( this_update, next_update, 300, -1 ) == 1 )
+            result = status;
+    }
+
+    OCSP_CERTID_free( id );
+    X509_free( issuer );
+    OCSP_BASICRESP_free( basic );
+    OCSP_RESPONSE_free( resp );
+    X509_free( leaf );
+    ERR_clear_error();
+    return result;
+}
+
+// Invoked by OpenSSL on a server when a client asks for a staple, and
+// on a client when the server's certificate status arrives. Servers
+// staple the cached response; nothing here waits on the network.
+static int
+ocsp_status_callback( SSL* ssl, void* /* arg */ )
+{
+    auto const* cd = static_cast<context_data const*>(
+        SSL_CTX_get_ex_data( SSL_get_SSL_CTX( ssl ), sni_ctx_data_index ) );
+    if( !cd )
+        return SSL_is_server( ssl ) ? SSL_TLSEXT_ERR_NOACK : 1;
+
+    if( SSL_is_server( ssl ) )
+    {
+        auto staple = cd->ocsp.load();
+        if( !staple )
+            return SSL_TLSEXT_ERR_NOACK;
+
+        // OpenSSL takes ownership of the copy
+        auto* p = static_cast<unsigned char*>(
+            OPENSSL_malloc( staple->size() ) );
+        if( !p )
+            return SSL_TLSEXT_ERR_NOACK;
+        std::memcpy( p, staple->data(), staple->size() );
+        if( !SSL_set_tlsext_status_ocsp_resp(
+                ssl, p, static_cast<long>( staple->size() ) ) )
+        {
+            OPENSSL_free( p );
+            return SSL_TLSEXT_ERR_NOACK;
+        }
+        return SSL_TLSEXT_ERR_OK;
+    }
+
+    bool const strict = cd->require_ocsp_staple ||
+        cd->revocation == revocation_policy::hard_fail;
+    switch( stapled_status( ssl ) )
+    {
+    case V_OCSP_CERTSTATUS_GOOD:
+        return 1;
+    case V_OCSP_CERTSTATUS_REVOKED:
+        return 0;
+    default:
+        return strict ? 0 : 1;
+    }
+}
+#endif
+
+#ifndef OPENSSL_NO_ENGINE
+// OpenSSL 3 deprecates engines in favour of providers, but hardware
+// is still often driven by one
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#elif defined( _MSC_VER )
+#pragma warning( push )
+#pragma warning( disable: 4996 )
+#endif
+
+// Initializes the engine and makes it the default for every
+// algorithm it implements, or returns null
+static ENGINE*
+load_engine( char const* id )
+{
+    ENGINE* e = ENGINE_by_id( id );
+    if( !e )
+        return nullptr;
+    if( !ENGINE_init( e ) )
+    {
+        ENGINE_free( e );
+        return nullptr;
+    }
+    if( !ENGINE_set_default( e, ENGINE_METHOD_ALL ) )
+    {
+        ENGINE_finish( e );
+        ENGINE_free( e );
+        return nullptr;
+    }
+    return e;
+}
+
+static void
+release_engine( ENGINE* e )
+{
+    ENGINE_finish( e );
+    ENGINE_free( e );
+}
+
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#elif defined( _MSC_VER )
+#pragma warning( pop )
+#endif
+#endif
+
 /** Cached OpenSSL context owning SSL_CTX.
 
     Created on first stream construction for a given tls::context,
@@ -120,12 +562,135 @@ public:
     SSL_CTX* ctx_;
     context_data const* cd_;  // For SNI callback access
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    // Library context holding the selected crypto provider
+    OSSL_LIB_CTX* libctx_ = nullptr;
+    OSSL_PROVIDER* provider_ = nullptr;
+    OSSL_PROVIDER* default_provider_ = nullptr;
+#endif
+#ifndef OPENSSL_NO_ENGINE
+    ENGINE* engine_ = nullptr;
+#endif
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    // Session ticket keys, current first
+    struct ticket_key
+    {
+        unsigned char name[16];
+        unsigned char aes[32];
+        unsigned char hmac[32];
+        std::chrono::steady_clock::time_point created;
+    };
+
+    std::mutex ticket_mutex_;
+    ticket_key ticket_keys_[2];
+    int ticket_key_count_ = 0;
+
+    /** Find the key of a ticket, rotating the current key when due.
+
+        @param name The name in a ticket to decrypt, or null for the
+            key to encrypt a new ticket with.
+
+        @return 1 for the current key, 2 for the previous one, 0 if
+            no key matches, and -1 on failure.
+    */
+    int
+    get_ticket_key( unsigned char const* name, ticket_key& key )
+    {
+        std::lock_guard<std::mutex> lock( ticket_mutex_ );
+        auto const now = std::chrono::steady_clock::now();
+        auto const lifetime = cd_->ticket_key_lifetime;
+        if( ticket_key_count_ == 0 || now - ticket_keys_[0].created >= lifetime )
+        {
+            ticket_key fresh;
+            if( RAND_bytes( fresh.name, sizeof( fresh.name ) ) <= 0 ||
+                RAND_bytes( fresh.aes, sizeof( fresh.aes ) ) <= 0 ||
+                RAND_bytes( fresh.hmac, sizeof( fresh.hmac ) ) <= 0 )
+                return -1;
+            fresh.created = now;
+            ticket_keys_[1] = ticket_keys_[0];
+            ticket_keys_[0] = fresh;
+            ticket_key_count_ = ( std::min )( ticket_key_count_ + 1, 2 );
+        }
+
+        if( !name )
+        {
+            key = ticket_keys_[0];
+            return 1;
+        }
+        for( int i = 0; i < ticket_key_count_; ++i )
+        {
+            // A replaced key decrypts for one more lifetime
+            if( i == 1 && now - ticket_keys_[1].created >= 2 * lifetime )
+                break;
+            if( std::memcmp( name, ticket_keys_[i].name, sizeof( key.name ) ) == 0 )
+            {
+                key = ticket_keys_[i];
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    // Invoked by OpenSSL to encrypt or decrypt a session ticket. A
+    // ticket under the previous key is accepted and renewed.
+    static int
+    ticket_key_callback(
+        SSL* ssl,
+        unsigned char* name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cctx,
+        EVP_MAC_CTX* hctx,
+        int enc )
+    {
+        auto* self = static_cast<openssl_native_context*>(
+            SSL_CTX_get_ex_data( SSL_get_SSL_CTX( ssl ), native_ctx_index ) );
+        if( !self )
+            return -1;
+
+        ticket_key key;
+        int result = self->get_ticket_key( enc ? nullptr : name, key );
+        if( result > 0 && enc )
+        {
+            std::memcpy( name, key.name, sizeof( key.name ) );
+            if( RAND_bytes( iv, 16 ) <= 0 )
+                result = -1;
+        }
+        if( result > 0 )
+        {
+            OSSL_PARAM params[] = {
+                OSSL_PARAM_construct_octet_string(
+                    OSSL_MAC_PARAM_KEY, key.hmac, sizeof( key.hmac ) ),
+                OSSL_PARAM_construct_utf8_string(
+                    OSSL_MAC_PARAM_DIGEST, const_cast<char*>( "SHA256" ), 0 ),
+                OSSL_PARAM_construct_end()
+            };
+            int ok = EVP_MAC_CTX_set_params( hctx, params ) && ( enc
+                ? EVP_EncryptInit_ex( cctx, EVP_aes_256_cbc(), nullptr, key.aes, iv )
+                : EVP_DecryptInit_ex( cctx, EVP_aes_256_cbc(), nullptr, key.aes, iv ) );
+            if( !ok )
+                result = -1;
+        }
+        OPENSSL_cleanse( &key, sizeof( key ) );
+        return result;
+    }
+#endif
+
     explicit
     openssl_native_context( context_data const& cd )
         : ctx_( nullptr )
         , cd_( &cd )
     {
-        // Create SSL_CTX supporting both client and server
+        // Create SSL_CTX supporting both client and server, in the
+        // library context of the selected provider if there is one
+        if( !load_crypto( cd ) )
+            return;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        if( libctx_ )
+            ctx_ = SSL_CTX_new_ex( libctx_, property_query( cd ).c_str(),
+                TLS_method() );
+        else
+#endif
         ctx_ = SSL_CTX_new( TLS_method() );
         if( !ctx_ )
             return;
@@ -137,9 +702,35 @@ public:
         // Store context_data pointer for SNI callback access
         SSL_CTX_set_ex_data( ctx_, sni_ctx_data_index, const_cast<context_data*>( &cd ) );
 
-        // Set SNI callback if provided
-        if( cd.servername_callback )
+        // Set SNI callback if provided or hostnames are routed
+        if( cd.servername_callback || !cd.sni_routes.empty() )
+        {
             SSL_CTX_set_tlsext_servername_callback( ctx_, sni_callback );
+            SSL_CTX_set_tlsext_servername_arg( ctx_, const_cast<context_data*>( &cd ) );
+        }
+
+        // Load contexts for other names when the ClientHello arrives
+        if( cd.server_contexts )
+        {
+            if( server_name_index < 0 )
+                server_name_index = SSL_get_ex_new_index( 0, nullptr, nullptr, nullptr, nullptr );
+            SSL_CTX_set_client_hello_cb( ctx_, client_hello_callback,
+                const_cast<context_data*>( &cd ) );
+        }
+
+#ifndef OPENSSL_NO_OCSP
+        // OCSP stapling. Servers staple the cached response, which a
+        // source set on the context keeps fresh in the background.
+        SSL_CTX_set_tlsext_status_cb( ctx_, ocsp_status_callback );
+        try
+        {
+            cd.ocsp.start();
+        }
+        catch( std::system_error const& )
+        {
+            // Without a refresher the stored response is stapled
+        }
+#endif
 
         // Set modes for partial writes and moving buffers
         SSL_CTX_set_mode( ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE );
@@ -148,6 +739,40 @@ public:
         SSL_CTX_set_mode( ctx_, SSL_MODE_RELEASE_BUFFERS );
 #endif
 
+        // Session resumption. The context serves both roles, so it
+        // caches server sessions and hands client ones to the store.
+        if( native_ctx_index < 0 )
+            native_ctx_index = SSL_CTX_get_ex_new_index( 0, nullptr, nullptr, nullptr, nullptr );
+        SSL_CTX_set_ex_data( ctx_, native_ctx_index, this );
+        if( cd.session_cache_size > 0 )
+        {
+            SSL_CTX_set_session_cache_mode( ctx_, SSL_SESS_CACHE_BOTH );
+            SSL_CTX_sess_set_cache_size( ctx_, static_cast<long>( cd.session_cache_size ) );
+            SSL_CTX_sess_set_new_cb( ctx_, new_session_callback );
+        }
+        else
+        {
+            SSL_CTX_set_session_cache_mode( ctx_, SSL_SESS_CACHE_OFF );
+        }
+        SSL_CTX_set_timeout( ctx_, static_cast<long>( cd.session_timeout.count() ) );
+        static unsigned char const sid_ctx[] = "corosio";
+        SSL_CTX_set_session_id_context( ctx_, sid_ctx, sizeof( sid_ctx ) - 1 );
+        // Early data, which the application protects from replay
+        if( cd.max_early_data > 0 )
+        {
+            auto max = static_cast<std::uint32_t>( ( std::min )(
+                cd.max_early_data, std::size_t( UINT32_MAX ) ) );
+            SSL_CTX_set_max_early_data( ctx_, max );
+            SSL_CTX_set_recv_max_early_data( ctx_, max );
+            SSL_CTX_set_options( ctx_, SSL_OP_NO_ANTI_REPLAY );
+        }
+        if( !cd.session_tickets )
+            SSL_CTX_set_options( ctx_, SSL_OP_NO_TICKET );
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        else
+            SSL_CTX_set_tlsext_ticket_key_evp_cb( ctx_, ticket_key_callback );
+#endif
+
         // Apply verify mode from config
         int verify_mode_flag = SSL_VERIFY_NONE;
         if( cd.verification_mode == verify_mode::peer )
@@ -216,10 +841,20 @@ public:
             if( bio )
             {
                 EVP_PKEY* pkey = nullptr;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+                auto const propq = property_query( cd );
+                if( cd.private_key_format == file_format::pem )
+                    pkey = PEM_read_bio_PrivateKey_ex( bio, nullptr, nullptr,
+                        nullptr, libctx_, libctx_ ? propq.c_str() : nullptr );
+                else
+                    pkey = d2i_PrivateKey_ex_bio( bio, nullptr,
+                        libctx_, libctx_ ? propq.c_str() : nullptr );
+#else
                 if( cd.private_key_format == file_format::pem )
                     pkey = PEM_read_bio_PrivateKey( bio, nullptr, nullptr, nullptr );
                 else
                     pkey = d2i_PrivateKey_bio( bio, nullptr );
+#endif
                 if( pkey )
                 {
                     SSL_CTX_use_PrivateKey( ctx_, pkey );
@@ -261,6 +896,73 @@ public:
     {
         if( ctx_ )
             SSL_CTX_free( ctx_ );
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        if( provider_ )
+            OSSL_PROVIDER_unload( provider_ );
+        if( default_provider_ )
+            OSSL_PROVIDER_unload( default_provider_ );
+        if( libctx_ )
+            OSSL_LIB_CTX_free( libctx_ );
+#endif
+#ifndef OPENSSL_NO_ENGINE
+        if( engine_ )
+            release_engine( engine_ );
+#endif
+    }
+
+private:
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    // Properties used to fetch algorithms from the provider
+    static std::string
+    property_query( context_data const& cd )
+    {
+        if( !cd.crypto_properties.empty() )
+            return std::string( cd.crypto_properties );
+        return "?provider=" + std::string( cd.crypto_provider );
+    }
+#endif
+
+    // Load the provider or engine selected on the context. Returns
+    // false, leaving ctx_ null, if one was selected and cannot be
+    // loaded, so that streams fail rather than silently run in
+    // software.
+    bool
+    load_crypto( context_data const& cd )
+    {
+        if( !cd.crypto_provider.empty() )
+        {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            libctx_ = OSSL_LIB_CTX_new();
+            if( !libctx_ )
+                return false;
+            provider_ = OSSL_PROVIDER_load(
+                libctx_, cd.crypto_provider.c_str() );
+            if( !provider_ )
+                return false;
+
+            // Algorithms the provider lacks fall back to the default
+            if( cd.crypto_provider != "default" )
+            {
+                default_provider_ = OSSL_PROVIDER_load( libctx_, "default" );
+                if( !default_provider_ )
+                    return false;
+            }
+#else
+            return false;
+#endif
+        }
+
+        if( !cd.crypto_engine.empty() )
+        {
+#ifndef OPENSSL_NO_ENGINE
+            engine_ = load_engine( cd.crypto_engine.c_str() );
+            if( !engine_ )
+                return false;
+#else
+            return false;
+#endif
+        }
+        return true;
     }
 };
 
@@ -291,11 +993,42 @@ struct openssl_stream_impl_
     io_stream& s_;
     tls::context ctx_;      // holds ref to cached native context
     SSL* ssl_ = nullptr;
-    BIO* ext_bio_ = nullptr;
 
-    // Buffers for network I/O
-    std::vector<char> in_buf_;
-    std::vector<char> out_buf_;
+    // Received bytes not yet consumed by OpenSSL
+    buffer_lease in_lease_;
+    std::size_t in_pos_ = 0;
+
+    // Encrypted bytes not yet sent
+    buffer_lease out_lease_;
+    std::size_t out_len_ = 0;
+    std::size_t out_size_ = default_buffer_size;    // lease size for bio_write
+
+    // Record sizing, and the area records are gathered in
+    tls::detail::record_sizer sizer_;
+    buffer_lease stage_;
+
+#if BOOST_COROSIO_OPENSSL_KTLS
+    // Set once the kernel encrypts what is sent
+    bool ktls_send_ = false;
+
+    // Record type of the next BIO write, if not application data
+    unsigned char ktls_next_type_ = 0;
+
+    // Record type of out_lease_, if it holds a control record
+    unsigned char ktls_out_type_ = 0;
+
+    // Set while flush_output has out_lease_ in a write
+    bool out_busy_ = false;
+#endif
+
+    // Key of the server in the client session store
+    std::string session_peer_;
+
+    // The context loaded for the requested name, on a server
+    tls::detail::server_name_state server_name_;
+
+    // Set once a server has read all the early data
+    bool early_done_ = false;
 
     // Renegotiation can cause both TLS read/write to access the socket
     capy::coro_lock io_cm_;
@@ -306,41 +1039,343 @@ struct openssl_stream_impl_
         : s_( s )
         , ctx_( std::move( ctx ) )
     {
-        in_buf_.resize( default_buffer_size );
-        out_buf_.resize( default_buffer_size );
     }
 
     ~openssl_stream_impl_()
     {
-        if( ext_bio_ )
-            BIO_free( ext_bio_ );
+        // Frees the BIO as well
         if( ssl_ )
             SSL_free( ssl_ );
         // SSL_CTX* is owned by cached native context, not freed here
     }
 
     //--------------------------------------------------------------------------
-    // Helper to flush pending output from BIO to network
+    // Lease BIO
     //--------------------------------------------------------------------------
 
-    capy::task<system::error_code>
-    flush_output(std::stop_token token)
+    static int
+    bio_read( BIO* b, char* buf, int len )
+    {
+        auto* self = static_cast<openssl_stream_impl_*>( BIO_get_data( b ) );
+        BIO_clear_retry_flags( b );
+
+        std::size_t available = self->in_lease_.size() - self->in_pos_;
+        if( available == 0 )
+        {
+            BIO_set_retry_read( b );
+            return -1;
+        }
+
+        std::size_t n = (std::min)( available, static_cast<std::size_t>( len ) );
+        std::memcpy( buf,
+            static_cast<char const*>( self->in_lease_.data() ) + self->in_pos_, n );
+        self->in_pos_ += n;
+        if( self->in_pos_ == self->in_lease_.size() )
+        {
+            self->in_lease_.reset();
+            self->in_pos_ = 0;
+        }
+        return static_cast<int>( n );
+    }
+
+    static int
+    bio_write( BIO* b, char const* buf, int len )
+    {
+        auto* self = static_cast<openssl_stream_impl_*>( BIO_get_data( b ) );
+        BIO_clear_retry_flags( b );
+
+#if BOOST_COROSIO_OPENSSL_KTLS
+        // A control record goes out alone, in one sendmsg
+        if( self->ktls_out_type_ != 0 ||
+            ( self->ktls_next_type_ != 0 && self->out_len_ > 0 ) )
+        {
+            BIO_set_retry_write( b );
+            return -1;
+        }
+        if( self->ktls_next_type_ != 0 &&
+            static_cast<std::size_t>( len ) > default_buffer_size )
+            return -1;
+#endif
+
+        if( self->out_lease_.empty() )
+        {
+            try
+            {
+                self->out_lease_ = get_buffer_pool(
+                    self->s_.context() ).acquire( self->out_size_ );
+            }
+            catch( std::bad_alloc const& )
+            {
+                return -1;
+            }
+        }
+
+        std::size_t room = self->out_lease_.size() - self->out_len_;
+        if( room == 0 )
+        {
+            BIO_set_retry_write( b );
+            return -1;
+        }
+
+        std::size_t n = (std::min)( room, static_cast<std::size_t>( len ) );
+        std::memcpy( static_cast<char*>( self->out_lease_.data() ) + self->out_len_,
+            buf, n );
+        self->out_len_ += n;
+#if BOOST_COROSIO_OPENSSL_KTLS
+        self->ktls_out_type_ = self->ktls_next_type_;
+        self->ktls_next_type_ = 0;
+#endif
+        return static_cast<int>( n );
+    }
+
+    static long
+    bio_ctrl( BIO* b, int cmd, long num, void* ptr )
+    {
+        auto* self = static_cast<openssl_stream_impl_*>( BIO_get_data( b ) );
+        (void)num;
+        (void)ptr;
+        switch( cmd )
+        {
+        case BIO_CTRL_FLUSH:
+#if BOOST_COROSIO_OPENSSL_KTLS
+            // OpenSSL flushes before handing over send keys, which
+            // must not apply to records it already encrypted
+            if( SSL_get_options( self->ssl_ ) & SSL_OP_ENABLE_KTLS )
+                return self->ktls_flush_now() ? 1 : 0;
+#endif
+            // Output is sent by flush_output
+            return 1;
+        case BIO_CTRL_PENDING:
+            return static_cast<long>( self->in_lease_.size() - self->in_pos_ );
+        case BIO_CTRL_WPENDING:
+            return static_cast<long>( self->out_len_ );
+#if BOOST_COROSIO_OPENSSL_KTLS
+        case BIO_CTRL_SET_KTLS:
+            // num is nonzero for send keys
+            if( num == 0 )
+                return 0;
+            return self->ktls_set_send_keys( ptr ) ? 1 : 0;
+        case BIO_CTRL_GET_KTLS_SEND:
+            return self->ktls_send_ ? 1 : 0;
+        case BIO_CTRL_GET_KTLS_RECV:
+            return 0;
+        case BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG:
+            self->ktls_next_type_ = static_cast<unsigned char>( num );
+            return 1;
+        case BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG:
+            self->ktls_next_type_ = 0;
+            return 1;
+#endif
+        default:
+            return 0;
+        }
+    }
+
+#if BOOST_COROSIO_OPENSSL_KTLS
+    //--------------------------------------------------------------------------
+    // Kernel TLS
+    //--------------------------------------------------------------------------
+
+    int
+    socket_fd() const noexcept
+    {
+        auto* sock = dynamic_cast<socket*>( &s_ );
+        return sock ? static_cast<int>( sock->native_handle() ) : -1;
+    }
+
+    // Send buffered output without waiting, returning true if none is left
+    bool
+    ktls_flush_now() noexcept
     {
-        while(BIO_ctrl_pending(ext_bio_) > 0 && !token.stop_requested())
+        int fd = socket_fd();
+        if( out_busy_ )
+            return false;
+        while( out_len_ > 0 && fd >= 0 )
         {
-            int pending = static_cast<int>(BIO_ctrl_pending(ext_bio_));
-            int to_read = (std::min)(pending, static_cast<int>(out_buf_.size()));
-            int n = BIO_read(ext_bio_, out_buf_.data(), to_read);
-            if(n <= 0)
+            ssize_t n = ktls_out_type_ != 0
+                ? send_record( fd, ktls_out_type_, out_lease_.data(), out_len_ )
+                : ::send( fd, out_lease_.data(), out_len_, MSG_NOSIGNAL );
+            if( n < 0 && errno == EINTR )
+                continue;
+            if( n <= 0 )
                 break;
+            consume_output( static_cast<std::size_t>( n ) );
+        }
+        return out_len_ == 0;
+    }
+
+    // The key material that OpenSSL passes starts with the kernel's
+    // tls_crypto_info, whose cipher names the structure that follows
+    static std::size_t
+    crypto_info_size( tls_crypto_info const& info ) noexcept
+    {
+        switch( info.cipher_type )
+        {
+#ifdef TLS_CIPHER_AES_GCM_128
+        case TLS_CIPHER_AES_GCM_128:
+            return sizeof( tls12_crypto_info_aes_gcm_128 );
+#endif
+#ifdef TLS_CIPHER_AES_GCM_256
+        case TLS_CIPHER_AES_GCM_256:
+            return sizeof( tls12_crypto_info_aes_gcm_256 );
+#endif
+#ifdef TLS_CIPHER_AES_CCM_128
+        case TLS_CIPHER_AES_CCM_128:
+            return sizeof( tls12_crypto_info_aes_ccm_128 );
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case TLS_CIPHER_CHACHA20_POLY1305:
+            return sizeof( tls12_crypto_info_chacha20_poly1305 );
+#endif
+        default:
+            return 0;
+        }
+    }
+
+    bool
+    ktls_set_send_keys( void* info ) noexcept
+    {
+        int fd = socket_fd();
+        if( fd < 0 || ktls_send_ || out_len_ > 0 || !info )
+            return false;
+        auto const& ci = *static_cast<tls_crypto_info const*>( info );
+        std::size_t size = crypto_info_size( ci );
+        if( size == 0 )
+            return false;
+
+        // Attaching the ULP alone changes nothing on the wire
+        if( ::setsockopt( fd, SOL_TCP, TCP_ULP, "tls", sizeof( "tls" ) ) != 0 &&
+            errno != EEXIST )
+            return false;
+        if( ::setsockopt( fd, SOL_TLS, TLS_TX, info,
+                static_cast<socklen_t>( size ) ) != 0 )
+            return false;
+        ktls_send_ = true;
+        return true;
+    }
+
+    static ssize_t
+    send_record(
+        int fd,
+        unsigned char type,
+        void const* data,
+        std::size_t size ) noexcept
+    {
+        char control[CMSG_SPACE( sizeof( type ) )] = {};
+        iovec iov{ const_cast<void*>( data ), size };
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof( control );
+        cmsghdr* cm = CMSG_FIRSTHDR( &msg );
+        cm->cmsg_level = SOL_TLS;
+        cm->cmsg_type = TLS_SET_RECORD_TYPE;
+        cm->cmsg_len = CMSG_LEN( sizeof( type ) );
+        std::memcpy( CMSG_DATA( cm ), &type, sizeof( type ) );
+        return ::sendmsg( fd, &msg, MSG_NOSIGNAL );
+    }
+
+    // Send the control record in out_lease_
+    capy::task<system::error_code>
+    flush_record()
+    {
+        auto& sock = dynamic_cast<socket&>( s_ );
+        while( out_len_ > 0 )
+        {
+            ssize_t n = send_record( socket_fd(), ktls_out_type_,
+                out_lease_.data(), out_len_ );
+            if( n >= 0 )
+            {
+                consume_output( static_cast<std::size_t>( n ) );
+                continue;
+            }
+            if( errno == EINTR )
+                continue;
+            if( errno != EAGAIN && errno != EWOULDBLOCK )
+                co_return system::error_code( errno, system::system_category() );
+
+            auto [ec] = co_await sock.wait( socket::wait_type::write );
+            if( ec == system::errc::operation_not_supported )
+            {
+                // No readiness waits on this backend; retry shortly
+                timer t( s_.context() );
+                t.expires_after( std::chrono::milliseconds( 1 ) );
+                auto [tec] = co_await t.wait();
+                ec = tec;
+            }
+            if( ec )
+                co_return ec;
+        }
+        co_return system::error_code{};
+    }
+#endif
 
+    // Drop the first n bytes of buffered output
+    void
+    consume_output( std::size_t n ) noexcept
+    {
+        char* p = static_cast<char*>( out_lease_.data() );
+        std::memmove( p, p + n, out_len_ - n );
+        out_len_ -= n;
+#if BOOST_COROSIO_OPENSSL_KTLS
+        if( out_len_ == 0 )
+            ktls_out_type_ = 0;
+#endif
+    }
+
+    static BIO_METHOD*
+    lease_bio_method()
+    {
+        static BIO_METHOD* const method = []
+        {
+            BIO_METHOD* m = BIO_meth_new(
+                BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "corosio lease" );
+            if( m )
+            {
+                BIO_meth_set_read( m, &bio_read );
+                BIO_meth_set_write( m, &bio_write );
+                BIO_meth_set_ctrl( m, &bio_ctrl );
+            }
+            return m;
+        }();
+        return method;
+    }
+
+    //--------------------------------------------------------------------------
+    // Helper to flush pending output to network
+    //--------------------------------------------------------------------------
+
+    capy::task<system::error_code>
+    flush_output(std::stop_token token)
+    {
+        while(out_len_ > 0 && !token.stop_requested())
+        {
             // Write to underlying stream
             auto guard = co_await io_cm_.scoped_lock();
+#if BOOST_COROSIO_OPENSSL_KTLS
+            if(ktls_out_type_ != 0)
+            {
+                auto ec = co_await flush_record();
+                if(ec)
+                    co_return ec;
+                continue;
+            }
+            out_busy_ = true;
+#endif
             auto [ec, written] = co_await s_.write_some(
-                capy::mutable_buffer(out_buf_.data(), static_cast<std::size_t>(n)));
+                capy::mutable_buffer(out_lease_.data(), out_len_));
+#if BOOST_COROSIO_OPENSSL_KTLS
+            out_busy_ = false;
+#endif
             if(ec)
                 co_return ec;
+
+            // Bytes appended by the other direction while writing stay
+            consume_output(written);
         }
+        if(out_len_ == 0)
+            out_lease_.reset();
         if(token.stop_requested())
         {
             co_return make_error_code(system::errc::operation_canceled);
@@ -349,21 +1384,30 @@ struct openssl_stream_impl_
     }
 
     capy::task<system::error_code>
-    read_input(std::stop_token token)
+    read_input(
+        std::stop_token token,
+        std::size_t size_hint = default_buffer_size)
     {
         if(token.stop_requested())
         {
             co_return make_error_code(system::errc::operation_canceled);
         }
+        // Room for the records holding size_hint bytes, within the
+        // sizes the buffer pool keeps
+        std::size_t size = (std::min)(
+            (std::max)(size_hint +
+                (size_hint / max_record_size + 1) * record_overhead,
+                default_buffer_size),
+            buffer_pool::max_size);
+
+        // OpenSSL wants input only once bio_read has consumed all of
+        // in_lease_, so each read replaces an empty lease
         auto guard = co_await io_cm_.scoped_lock();
-        auto [ec, n] = co_await s_.read_some(
-            capy::mutable_buffer(in_buf_.data(), in_buf_.size()));
+        auto [ec, lease] = co_await s_.read_leased( size );
         if(ec)
             co_return ec;
-
-        // Feed data into OpenSSL
-        int written = BIO_write(ext_bio_, in_buf_.data(), static_cast<int>(n));
-        (void)written;
+        in_lease_ = std::move( lease );
+        in_pos_ = 0;
 
         co_return system::error_code{};
     }
@@ -385,6 +1429,10 @@ struct openssl_stream_impl_
         system::error_code ec;
         std::size_t total_read = 0;
 
+        std::size_t capacity = 0;
+        for(std::size_t i = 0; i < buf_count; ++i)
+            capacity += dest_bufs[i].size();
+
         // Process each destination buffer
         for(std::size_t i = 0; i < buf_count && !token.stop_requested(); ++i)
         {
@@ -398,18 +1446,22 @@ struct openssl_stream_impl_
 
                 if(ret > 0)
                 {
+                    // Keep decrypting the records already received
+                    // while the buffers have room
                     dest += ret;
                     remaining -= ret;
                     total_read += static_cast<std::size_t>(ret);
-
-                    // For read_some semantics, return after first successful read
-                    if(total_read > 0)
-                        goto done;
                 }
                 else
                 {
                     int err = SSL_get_error(ssl_, ret);
 
+                    // For read_some semantics, return what was read
+                    // rather than wait for more; an error recurs on
+                    // the next call
+                    if(total_read > 0)
+                        goto done;
+
                     if(err == SSL_ERROR_WANT_WRITE)
                     {
                         // Flush pending output (renegotiation)
@@ -424,8 +1476,9 @@ struct openssl_stream_impl_
                         if(ec)
                             goto done;
 
-                        // Then read from network
-                        ec = co_await read_input(token);
+                        // Then read from network, enough to fill the
+                        // buffers if that much has arrived
+                        ec = co_await read_input(token, capacity);
                         if(ec)
                         {
                             if(ec == make_error_code(capy::error::eof))
@@ -489,29 +1542,75 @@ struct openssl_stream_impl_
         system::error_code ec;
         std::size_t total_written = 0;
 
-        // Process each source buffer
-        for(std::size_t i = 0; i < buf_count && !token.stop_requested(); ++i)
+#if BOOST_COROSIO_OPENSSL_KTLS
+        if(ktls_send_)
         {
-            char const* src = static_cast<char const*>(src_bufs[i].data());
-            int remaining = static_cast<int>(src_bufs[i].size());
+            // The kernel encrypts; send the caller's bytes as they are
+            ec = co_await flush_output(token);
+            if(!ec && !token.stop_requested())
+            {
+                auto guard = co_await io_cm_.scoped_lock();
+                auto [wec, n] = co_await s_.write_some(
+                    std::span<capy::mutable_buffer const>(
+                        src_bufs.data(), buf_count));
+                ec = wec;
+                total_written = n;
+            }
+            goto done;
+        }
+#endif
 
-            while(remaining > 0 && !token.stop_requested())
+        {
+            // Encrypt records until the caller's bytes run out or the
+            // output buffer is full, then send them with one write
+            tls::detail::write_cursor cur(src_bufs.data(), buf_count);
+            bool const dynamic =
+                tls::detail::get_context_data(ctx_).dynamic_records;
+            auto now = tls::detail::record_sizer::clock::now();
+
+            std::size_t total = 0;
+            for(std::size_t i = 0; i < buf_count; ++i)
+                total += src_bufs[i].size();
+            std::size_t const limit = sizer_.next(dynamic, now);
+            out_size_ = (std::min)(
+                (std::max)(total + (total / limit + 1) * record_overhead,
+                    default_buffer_size),
+                buffer_pool::max_size);
+
+            if(buf_count > 1)
             {
+                try
+                {
+                    stage_ = get_buffer_pool(s_.context()).acquire(
+                        max_record_size);
+                }
+                catch(std::bad_alloc const&)
+                {
+                    // Write a record per buffer instead
+                }
+            }
+
+            capy::const_buffer chunk;
+            bool full = false;
+            while(!cur.done() && !token.stop_requested())
+            {
+                // Retries must pass the same bytes
+                if(chunk.size() == 0)
+                    chunk = cur.next(sizer_.next(dynamic, now),
+                        static_cast<char*>(stage_.data()));
+
                 ERR_clear_error();
-                int ret = SSL_write(ssl_, src, remaining);
+                int ret = SSL_write(ssl_, chunk.data(),
+                    static_cast<int>(chunk.size()));
 
                 if(ret > 0)
                 {
-                    src += ret;
-                    remaining -= ret;
+                    cur.consume(static_cast<std::size_t>(ret));
                     total_written += static_cast<std::size_t>(ret);
-
-                    // For write_some semantics, flush and return after first successful write
-                    if(total_written > 0)
-                    {
-                        ec = co_await flush_output(token);
-                        goto done;
-                    }
+                    sizer_.on_sent(static_cast<std::size_t>(ret), now);
+                    chunk = {};
+                    if(full)
+                        break;
                 }
                 else
                 {
@@ -519,9 +1618,12 @@ struct openssl_stream_impl_
 
                     if(err == SSL_ERROR_WANT_WRITE)
                     {
+                        // The output is full. OpenSSL may hold part of
+                        // the record, so finish it, then return
                         ec = co_await flush_output(token);
                         if(ec)
                             goto done;
+                        full = total_written > 0;
                     }
                     else if(err == SSL_ERROR_WANT_READ)
                     {
@@ -543,9 +1645,14 @@ struct openssl_stream_impl_
                     }
                 }
             }
+
+            if(total_written > 0)
+                ec = co_await flush_output(token);
         }
 
     done:
+        stage_.reset();
+        out_size_ = default_buffer_size;
         if(token.stop_requested())
             ec = make_error_code(system::errc::operation_canceled);
 
@@ -556,6 +1663,13 @@ struct openssl_stream_impl_
         co_return;
     }
 
+    struct handshake_result
+    {
+        int ret = 0;
+        int err = 0;
+        unsigned long ssl_err = 0;
+    };
+
     capy::task<>
     do_handshake(
         int type,
@@ -563,65 +1677,281 @@ struct openssl_stream_impl_
         system::error_code* ec_out,
         std::coroutine_handle<> continuation,
         capy::executor_ref d)
+    {
+        if(type == openssl_stream::client)
+            resume_session();
+
+        *ec_out = co_await run_handshake(type, token);
+
+        detail::resume_coro(d, continuation);
+        co_return;
+    }
+
+    // Client handshake that sends early data with the ClientHello
+    // when the resumed session allows it
+    capy::task<>
+    do_handshake_early(
+        capy::const_buffer data,
+        std::stop_token token,
+        system::error_code* ec_out,
+        std::size_t* n_out,
+        std::coroutine_handle<> continuation,
+        capy::executor_ref d)
     {
         system::error_code ec;
+        std::size_t n = 0;
 
-        while(!token.stop_requested())
+        resume_session();
+        SSL_SESSION* sess = SSL_get_session(ssl_);
+        std::size_t len = sess ? (std::min)(data.size(),
+            static_cast<std::size_t>(SSL_SESSION_get_max_early_data(sess))) : 0;
+        while(len > 0 && !token.stop_requested())
         {
+            handshake_result r;
             ERR_clear_error();
-            int ret;
-            if(type == openssl_stream::client)
-                ret = SSL_connect(ssl_);
-            else
-                ret = SSL_accept(ssl_);
-
-            if(ret == 1)
+            r.ret = SSL_write_early_data(ssl_, data.data(), len, &n);
+            if(r.ret == 1)
             {
-                // Handshake completed - flush any remaining output
                 ec = co_await flush_output(token);
                 break;
             }
+            r.err = SSL_get_error(ssl_, r.ret);
+            r.ssl_err = ERR_get_error();
+            ec = co_await handshake_wait(r, token);
+            if(ec)
+                break;
+        }
+
+        if(!ec)
+            ec = co_await run_handshake(openssl_stream::client, token);
+        else if(token.stop_requested())
+            ec = make_error_code(system::errc::operation_canceled);
+
+        // Early data the server rejected must be sent again
+        if(ec || SSL_get_early_data_status(ssl_) != SSL_EARLY_DATA_ACCEPTED)
+            n = 0;
+        *ec_out = ec;
+        *n_out = n;
+
+        detail::resume_coro(d, continuation);
+        co_return;
+    }
+
+    // Server side: the ClientHello, then the early data sent with it
+    capy::task<>
+    do_read_early_data(
+        capy::mutable_buffer buf,
+        std::stop_token token,
+        system::error_code* ec_out,
+        std::size_t* n_out,
+        std::coroutine_handle<> continuation,
+        capy::executor_ref d)
+    {
+        system::error_code ec;
+        std::size_t n = 0;
+
+        if(!early_done_ && SSL_in_before(ssl_))
+            SSL_set_accept_state(ssl_);
+
+        tls::detail::handshake_pool* pool = handshake_pool();
+        while(!early_done_ && !token.stop_requested())
+        {
+            handshake_result r;
+            if(pool)
+                r = co_await tls::detail::offload( *pool,
+                    [this, buf, &n]{ return read_early_step(buf, n); });
             else
-            {
-                int err = SSL_get_error(ssl_, ret);
+                r = read_early_step(buf, n);
 
-                if(err == SSL_ERROR_WANT_WRITE)
-                {
-                    ec = co_await flush_output(token);
-                    if(ec)
-                        break;
-                }
-                else if(err == SSL_ERROR_WANT_READ)
-                {
-                    // Flush output first (e.g., ClientHello)
-                    ec = co_await flush_output(token);
-                    if(ec)
-                        break;
-                    // Then read response
-                    ec = co_await read_input(token);
-                    if(ec)
-                        break;
-                }
-                else
-                {
-                    unsigned long ssl_err = ERR_get_error();
-                    ec = system::error_code(
-                        static_cast<int>(ssl_err), system::system_category());
+            if(r.ret != SSL_READ_EARLY_DATA_ERROR)
+            {
+                // The server's flight need not wait for the data
+                ec = co_await flush_output(token);
+                if(r.ret == SSL_READ_EARLY_DATA_FINISH)
+                    early_done_ = true;
+                if(ec || n > 0)
                     break;
-                }
+                continue;
             }
+
+            ec = co_await handshake_wait(r, token);
+            if(ec)
+                break;
         }
 
         if(token.stop_requested())
-        {
             ec = make_error_code(system::errc::operation_canceled);
-        }
+        if(ec)
+            n = 0;
         *ec_out = ec;
+        *n_out = n;
 
         detail::resume_coro(d, continuation);
         co_return;
     }
 
+    tls::detail::handshake_pool*
+    handshake_pool() const noexcept
+    {
+        try
+        {
+            return tls::detail::get_context_data( ctx_ ).get_handshake_pool();
+        }
+        catch(std::system_error const&)
+        {
+            // Without threads, handshake on this one
+            return nullptr;
+        }
+    }
+
+    // Steps SSL_connect or SSL_accept until the handshake completes
+    capy::task<system::error_code>
+    run_handshake(int type, std::stop_token token)
+    {
+        system::error_code ec;
+        tls::detail::handshake_pool* pool = handshake_pool();
+
+        while(!token.stop_requested())
+        {
+            handshake_result r;
+            if(pool)
+                r = co_await tls::detail::offload( *pool,
+                    [this, type]{ return handshake_step(type); });
+            else
+                r = handshake_step(type);
+
+            if(r.ret == 1)
+            {
+                // Handshake completed - flush any remaining output
+                ec = co_await flush_output(token);
+                break;
+            }
+
+            ec = co_await handshake_wait(r, token);
+            if(ec)
+                break;
+        }
+
+        // Record crypto stays synchronous
+        if(SSL_get_mode(ssl_) & SSL_MODE_ASYNC)
+            SSL_clear_mode(ssl_, SSL_MODE_ASYNC);
+
+        if(token.stop_requested())
+            ec = make_error_code(system::errc::operation_canceled);
+        co_return ec;
+    }
+
+    // Does what a handshake step that did not finish is waiting for
+    capy::task<system::error_code>
+    handshake_wait(handshake_result r, std::stop_token token)
+    {
+        if(r.err == SSL_ERROR_WANT_WRITE)
+            co_return co_await flush_output(token);
+
+        if(r.err == SSL_ERROR_WANT_READ)
+        {
+            // Flush output first (e.g., ClientHello)
+            auto ec = co_await flush_output(token);
+            if(ec)
+                co_return ec;
+            // Then read response
+            co_return co_await read_input(token);
+        }
+
+        if(r.err == SSL_ERROR_WANT_CLIENT_HELLO_CB && server_name_.pending)
+        {
+            // The context for the requested name is loading
+            auto pending = server_name_.pending;
+            co_await pending->wait();
+            co_return system::error_code{};
+        }
+
+        if(r.err == SSL_ERROR_WANT_ASYNC)
+        {
+            co_await wait_async();
+            co_return system::error_code{};
+        }
+
+        co_return system::error_code(
+            static_cast<int>(r.ssl_err), system::system_category());
+    }
+
+    // Waits for the crypto job that paused a handshake step. With
+    // handshake threads a pool thread blocks on the job's fds;
+    // without, the stream polls them and yields to the executor
+    // between polls.
+    capy::task<>
+    wait_async()
+    {
+        if(auto* pool = handshake_pool())
+        {
+            (void) co_await tls::detail::offload( *pool,
+                [this]{ return poll_async(100); });
+            co_return;
+        }
+        if(!poll_async(0))
+            co_await tls::detail::yield();
+    }
+
+    // Returns true if a paused crypto job's fd is ready within
+    // timeout_ms, or if the job has no fds to wait on
+    bool
+    poll_async(int timeout_ms)
+    {
+        std::size_t n = 0;
+        if(!SSL_get_all_async_fds(ssl_, nullptr, &n) || n == 0)
+            return true;
+        std::vector<OSSL_ASYNC_FD> fds(n);
+        if(!SSL_get_all_async_fds(ssl_, fds.data(), &n))
+            return true;
+
+#ifdef _WIN32
+        return WaitForMultipleObjects(static_cast<DWORD>(n), fds.data(),
+            FALSE, static_cast<DWORD>(timeout_ms)) != WAIT_TIMEOUT;
+#else
+        std::vector<pollfd> pfds(n);
+        for(std::size_t i = 0; i < n; ++i)
+            pfds[i] = pollfd{fds[i], POLLIN, 0};
+        return ::poll(pfds.data(), static_cast<nfds_t>(n), timeout_ms) != 0;
+#endif
+    }
+
+    // One call of SSL_read_early_data, with the error queue read
+    // on the thread that made it as for handshake_step
+    handshake_result
+    read_early_step(capy::mutable_buffer buf, std::size_t& n)
+    {
+        handshake_result r;
+        ERR_clear_error();
+        r.ret = SSL_read_early_data(ssl_, buf.data(), buf.size(), &n);
+        if(r.ret == SSL_READ_EARLY_DATA_ERROR)
+        {
+            r.err = SSL_get_error(ssl_, 0);
+            r.ssl_err = ERR_get_error();
+        }
+        return r;
+    }
+
+    // One call of SSL_connect or SSL_accept. The error queue is
+    // per thread, so it is read here, on the thread that made the
+    // call, which with a handshake pool is one of its threads.
+    handshake_result
+    handshake_step(int type)
+    {
+        handshake_result r;
+        ERR_clear_error();
+        if(type == openssl_stream::client)
+            r.ret = SSL_connect(ssl_);
+        else
+            r.ret = SSL_accept(ssl_);
+        if(r.ret != 1)
+        {
+            r.err = SSL_get_error(ssl_, r.ret);
+            r.ssl_err = ERR_get_error();
+        }
+        return r;
+    }
+
     capy::task<>
     do_shutdown(
         std::stop_token token,
@@ -719,7 +2049,7 @@ struct openssl_stream_impl_
         delete this;
     }
 
-    void read_some(
+    bool read_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param param,
@@ -732,9 +2062,10 @@ struct openssl_stream_impl_
 
         capy::run_async(d, token)(
             do_read_some(bufs, count, token, ec, bytes, h, d));
+        return false;
     }
 
-    void write_some(
+    bool write_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param param,
@@ -747,6 +2078,7 @@ struct openssl_stream_impl_
 
         capy::run_async(d, token)(
             do_write_some(bufs, count, token, ec, bytes, h, d));
+        return false;
     }
 
     void handshake(
@@ -770,10 +2102,53 @@ struct openssl_stream_impl_
             do_shutdown(token, ec, h, d));
     }
 
+    void handshake_early(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        capy::const_buffer data,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        capy::run_async(d, token)(
+            do_handshake_early(data, token, ec, bytes, h, d));
+    }
+
+    void read_early_data(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        capy::mutable_buffer buf,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        capy::run_async(d, token)(
+            do_read_early_data(buf, token, ec, bytes, h, d));
+    }
+
+    bool session_reused() const noexcept override
+    {
+        return ssl_ && SSL_session_reused( ssl_ ) == 1;
+    }
+
     //--------------------------------------------------------------------------
     // Initialization
     //--------------------------------------------------------------------------
 
+    // Offer the session last received from this server, if any
+    void
+    resume_session()
+    {
+        auto const& cd = tls::detail::get_context_data( ctx_ );
+        session_peer_ = tls::detail::session_peer( cd, s_ );
+        if( session_peer_.empty() )
+            return;
+        auto sess = cd.client_sessions.find(
+            &tls::detail::session_backend, session_peer_ );
+        if( sess )
+            SSL_set_session( ssl_, static_cast<SSL_SESSION*>( sess.get() ) );
+    }
+
     system::error_code
     init_ssl()
     {
@@ -782,7 +2157,11 @@ struct openssl_stream_impl_
         SSL_CTX* native_ctx = tls::detail::get_openssl_context( impl );
         if( !native_ctx )
         {
+            // A crypto provider or engine that is not available
+            // leaves no error queued
             unsigned long err = ERR_get_error();
+            if( err == 0 )
+                return make_error_code( system::errc::function_not_supported );
             return system::error_code(
                 static_cast<int>( err ), system::system_category() );
         }
@@ -796,9 +2175,10 @@ struct openssl_stream_impl_
                 static_cast<int>( err ), system::system_category() );
         }
 
-        // Create BIO pair for I/O
-        BIO* int_bio = nullptr;
-        if( !BIO_new_bio_pair( &int_bio, 0, &ext_bio_, 0 ) )
+        // Create the lease BIO for I/O
+        BIO_METHOD* method = lease_bio_method();
+        BIO* bio = method ? BIO_new( method ) : nullptr;
+        if( !bio )
         {
             unsigned long err = ERR_get_error();
             SSL_free( ssl_ );
@@ -806,9 +2186,35 @@ struct openssl_stream_impl_
             return system::error_code(
                 static_cast<int>( err ), system::system_category() );
         }
+        BIO_set_data( bio, this );
+        BIO_set_init( bio, 1 );
+
+        // Attach the BIO to SSL (SSL takes ownership)
+        SSL_set_bio( ssl_, bio, bio );
+
+        // Lets new_session_callback file client sessions
+        SSL_set_app_data( ssl_, &session_peer_ );
+
+        // Lets client_hello_callback load a context for the server
+        if( impl.server_contexts )
+            SSL_set_ex_data( ssl_, tls::detail::server_name_index, &server_name_ );
+
+#if BOOST_COROSIO_OPENSSL_KTLS
+        if( impl.kernel_tls )
+            SSL_set_options( ssl_, SSL_OP_ENABLE_KTLS );
+#endif
 
-        // Attach internal BIO to SSL (SSL takes ownership)
-        SSL_set_bio( ssl_, int_bio, int_bio );
+        // Crypto jobs may pause the handshake, see run_handshake
+        if( impl.async_crypto )
+            SSL_set_mode( ssl_, SSL_MODE_ASYNC );
+
+#ifndef OPENSSL_NO_OCSP
+        // Ask servers to staple their certificate status. OpenSSL
+        // ignores this when the stream accepts.
+        if( impl.require_ocsp_staple ||
+            impl.revocation != tls::revocation_policy::disabled )
+            SSL_set_tlsext_status_type( ssl_, TLSEXT_STATUSTYPE_ocsp );
+#endif
 
         // Apply per-session config (SNI + hostname verification) from context
         if( !impl.hostname.empty() )
@@ -850,4 +2256,16 @@ openssl_stream::
         impl_->release();
 }
 
+bool
+openssl_stream::
+kernel_tls_send() const noexcept
+{
+#if BOOST_COROSIO_OPENSSL_KTLS
+    return impl_ &&
+        static_cast<openssl_stream_impl_ const*>( impl_ )->ktls_send_;
+#else
+    return false;
+#endif
+}
+
 } // namespace boost::corosio
@@ -8,6 +8,7 @@
 //
 
 #include <boost/corosio/tls/wolfssl_stream.hpp>
+#include <boost/corosio/buffer_pool.hpp>
 #include <boost/capy/ex/coro_lock.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/error.hpp>
@@ -16,6 +17,7 @@
 
 // Internal context implementation
 #include "src/tls/detail/context_impl.hpp"
+#include "src/tls/detail/record_writer.hpp"
 
 // Include WolfSSL options first to get proper feature detection
 #include <wolfssl/options.h>
@@ -26,8 +28,24 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
-#include <vector>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <utility>
+
+// Records can be sent straight from WolfSSL's buffer on POSIX sockets
+#if !defined( _WIN32 )
+#define BOOST_COROSIO_WOLFSSL_DIRECT_SEND 1
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <errno.h>
+#include <sys/socket.h>
+#else
+#define BOOST_COROSIO_WOLFSSL_DIRECT_SEND 0
+#endif
 
 /*
     wolfssl_stream Architecture
@@ -38,8 +56,27 @@
 
     Data Flow
     ---------
-    App -> wolfSSL_write -> send_callback -> out_buf_ -> s_.write_some -> Network
-    App <- wolfSSL_read  <- recv_callback <- in_buf_  <- s_.read_some  <- Network
+    App -> wolfSSL_write -> send_callback -> out_buf_ -> s_.write_some  -> Network
+    App <- wolfSSL_read  <- recv_callback <- in_buf_  <- s_.read_leased -> Network
+
+    The buffers are leases from the context's buffer_pool. An input
+    buffer is the lease of a read_leased, which on a socket takes a
+    buffer only once data has arrived, and is returned as soon as
+    WolfSSL has consumed it. An output buffer is taken by
+    send_callback when WolfSSL first writes and returned at the end of
+    the operation once flushed, so an idle stream holds none.
+
+    Direct Send
+    -----------
+    Over a POSIX socket, send_callback sends WolfSSL's records from
+    WolfSSL's own buffer with a non-blocking send, skipping the copy
+    into an output buffer. WolfSSL keeps what was not sent and offers
+    it again, so when the socket is full the callback reports
+    WANT_WRITE and the operation waits for the socket to become
+    writable before calling WolfSSL again. Nothing refers to WolfSSL's
+    buffer once the callback returns, since WolfSSL may move it.
+    Output already queued in an output buffer or being written must
+    go first, so while there is any the callback copies as before.
 
     WANT_READ / WANT_WRITE Pattern
     ------------------------------
@@ -50,7 +87,7 @@
       2. If data available: return it immediately
       3. If not: return WOLFSSL_CBIO_ERR_WANT_READ or WANT_WRITE
       4. wolfSSL_read/write returns WOLFSSL_ERROR_WANT_*
-      5. Our coroutine does async I/O: co_await s_.read_some() or write_some()
+      5. Our coroutine does async I/O: co_await s_.read_leased() or write_some()
       6. Loop back to step 1
 
     Renegotiation causes cross-direction I/O: SSL_read may need to write
@@ -77,6 +114,33 @@
     This design allows a single tls::context to be shared across both client
     and server streams without requiring OpenSSL compatibility mode in WolfSSL.
 
+    SNI Routing
+    -----------
+    A context with hostnames routed by add_server_context installs
+    wolfssl_sni_callback on its server context, which looks the
+    requested name up in the context's sni_router. With OpenSSL
+    compatibility the WOLFSSL moves to the routed context's cached
+    server WOLFSSL_CTX with wolfSSL_set_SSL_CTX. Without it the
+    routed context's certificate and key are loaded into the WOLFSSL
+    itself, which parses them on every such handshake.
+
+    Names that are not routed are looked up in the context's
+    server_context_cache, if it has a loader. WolfSSL offers no way
+    to pause a handshake at the ClientHello, so the callback blocks
+    until the load finishes, which with handshake threads happens on
+    one of them. The stream keeps the loaded context in its
+    server_name_state while the WOLFSSL may refer to it.
+
+    Crypto Offload
+    --------------
+    set_crypto_device gives both WOLFSSL_CTX the device id of a crypto
+    callback registered with wc_CryptoCb_RegisterDevice, in builds
+    with WOLF_CRYPTO_CB. In builds with WOLFSSL_ASYNC_CRYPT,
+    set_async_crypto enables asynchronous crypto on them, and a step
+    that returns WC_PENDING_E polls the device, yields to the
+    executor, and is called again. Providers and engines are OpenSSL
+    notions and are ignored here.
+
     Key Types
     ---------
     - wolfssl_stream_impl_ : tls_stream_impl  -- the impl stored in io_object::impl_
@@ -92,8 +156,13 @@ namespace {
 // Default buffer size for TLS I/O
 constexpr std::size_t default_buffer_size = 16384;
 
-// Maximum number of buffers to handle in a single operation
-constexpr std::size_t max_buffers = 8;
+// The most a record adds to its plaintext
+constexpr std::size_t record_overhead = 5 + 256;
+
+// Maximum number of buffers to handle in a single operation. Large
+// enough for the fragments of a serialized message, which a write
+// gathers into records.
+constexpr std::size_t max_buffers = 64;
 
 // Buffer array type for coroutine parameters (copied into frame)
 using buffer_array = std::array<capy::mutable_buffer, max_buffers>;
@@ -108,6 +177,21 @@ using buffer_array = std::array<capy::mutable_buffer, max_buffers>;
 
 namespace tls::detail {
 
+// Identifies WolfSSL sessions in context_data::client_sessions
+static char session_backend;
+
+// Gives a server handshake the credentials of a routed context
+static bool
+use_routed_context( WOLFSSL* ssl, context_data const& cd );
+
+// Builds the native contexts of a loaded context, on the loading thread
+static void
+warm_loaded_context( context const& ctx );
+
+// Returns the server name state of the stream a WOLFSSL belongs to
+static server_name_state*
+get_server_name_state( WOLFSSL* ssl ) noexcept;
+
 // SNI callback invoked by WolfSSL during handshake (server-side)
 // Returns SNICbReturn enum: 0 = OK, fatal_return (2) = abort
 static int
@@ -121,6 +205,44 @@ wolfssl_sni_callback( WOLFSSL* ssl, int* /* alert */, void* arg )
     std::string_view servername( static_cast<char const*>( sni_data ), sni_len );
 
     auto* cd = static_cast<context_data const*>( arg );
+    bool routed = false;
+    if( cd && !cd->sni_routes.empty() )
+    {
+        if( auto const* ctx = cd->sni_routes.find( servername ) )
+        {
+            if( !use_routed_context( ssl, get_context_data( *ctx ) ) )
+                return fatal_return;
+            routed = true;
+        }
+    }
+
+    // WolfSSL cannot pause here, so a name still loading is waited
+    // for on this thread
+    auto* state = get_server_name_state( ssl );
+    if( !routed && cd && cd->server_contexts && state )
+    {
+        std::shared_ptr<server_context_cache::entry> entry;
+        try
+        {
+            entry = cd->server_contexts->acquire(
+                servername, &warm_loaded_context );
+        }
+        catch( std::system_error const& )
+        {
+            return fatal_return;
+        }
+        if( entry )
+        {
+            entry->wait_blocking();
+            if( auto const* loaded = entry->get() )
+            {
+                if( !use_routed_context( ssl, get_context_data( *loaded ) ) )
+                    return fatal_return;
+                state->routed = *loaded;
+            }
+        }
+    }
+
     if( cd && cd->servername_callback )
     {
         if( !cd->servername_callback( servername ) )
@@ -199,6 +321,16 @@ public:
 
         // Apply verify depth
         wolfSSL_CTX_set_verify_depth( ctx, cd.verify_depth );
+
+        // Route crypto to a registered device or async device
+#ifdef WOLF_CRYPTO_CB
+        if( cd.crypto_device != -1 )
+            wolfSSL_CTX_SetDevId( ctx, cd.crypto_device );
+#endif
+#ifdef WOLFSSL_ASYNC_CRYPT
+        if( cd.async_crypto )
+            wolfSSL_CTX_UseAsync( ctx, cd.crypto_device );
+#endif
     }
 
     context_data const* cd_;  // For SNI callback access
@@ -216,8 +348,44 @@ public:
         apply_common_settings( client_ctx_, cd );
         apply_common_settings( server_ctx_, cd );
 
-        // Set SNI callback on server context if provided
-        if( server_ctx_ && cd.servername_callback )
+#if defined( HAVE_CERTIFICATE_STATUS_REQUEST ) && defined( HAVE_OCSP )
+        // Clients check stapled certificate status offline; WolfSSL
+        // only queries a responder when OCSP lookups are enabled,
+        // which they are not
+        if( client_ctx_ && ( cd.require_ocsp_staple ||
+            cd.revocation != revocation_policy::disabled ) )
+        {
+            wolfSSL_CTX_EnableOCSPStapling( client_ctx_ );
+            if( cd.require_ocsp_staple ||
+                cd.revocation == revocation_policy::hard_fail )
+                wolfSSL_CTX_EnableOCSPMustStaple( client_ctx_ );
+        }
+#endif
+
+        // Session resumption on the server; the size of WolfSSL's
+        // cache is fixed at build time, as is its ticket key lifetime
+        if( server_ctx_ )
+        {
+            wolfSSL_CTX_set_timeout( server_ctx_,
+                static_cast<unsigned>( cd.session_timeout.count() ) );
+            if( cd.session_cache_size == 0 )
+                wolfSSL_CTX_set_session_cache_mode(
+                    server_ctx_, WOLFSSL_SESS_CACHE_OFF );
+#if defined( HAVE_SESSION_TICKET ) && !defined( NO_WOLFSSL_SERVER )
+            if( !cd.session_tickets )
+            {
+                wolfSSL_CTX_NoTicketTLSv12( server_ctx_ );
+#ifdef WOLFSSL_TLS13
+                wolfSSL_CTX_no_ticket_TLSv13( server_ctx_ );
+#endif
+            }
+#endif
+        }
+
+        // Set SNI callback on server context if provided, hostnames
+        // are routed, or contexts are loaded for them
+        if( server_ctx_ && ( cd.servername_callback ||
+            !cd.sni_routes.empty() || cd.server_contexts ) )
         {
             wolfSSL_CTX_set_servername_callback( server_ctx_, wolfssl_sni_callback );
             wolfSSL_CTX_set_servername_arg( server_ctx_, const_cast<context_data*>( &cd ) );
@@ -250,6 +418,49 @@ get_wolfssl_native_context( context_data const& cd )
     return static_cast<wolfssl_native_context*>( p );
 }
 
+static void
+warm_loaded_context( context const& ctx )
+{
+    get_wolfssl_native_context( get_context_data( ctx ) );
+}
+
+static bool
+use_routed_context( WOLFSSL* ssl, context_data const& cd )
+{
+#if defined( OPENSSL_EXTRA ) || defined( OPENSSL_ALL )
+    auto* native = get_wolfssl_native_context( cd );
+    return native->server_ctx_ &&
+        wolfSSL_set_SSL_CTX( ssl, native->server_ctx_ ) != nullptr;
+#else
+    int result = WOLFSSL_SUCCESS;
+    if( !cd.certificate_chain.empty() )
+    {
+        result = wolfSSL_use_certificate_chain_buffer( ssl,
+            reinterpret_cast<unsigned char const*>( cd.certificate_chain.data() ),
+            static_cast<long>( cd.certificate_chain.size() ) );
+    }
+    else if( !cd.entity_certificate.empty() )
+    {
+        int format = ( cd.entity_cert_format == file_format::pem )
+            ? WOLFSSL_FILETYPE_PEM : WOLFSSL_FILETYPE_ASN1;
+        result = wolfSSL_use_certificate_buffer( ssl,
+            reinterpret_cast<unsigned char const*>( cd.entity_certificate.data() ),
+            static_cast<long>( cd.entity_certificate.size() ),
+            format );
+    }
+    if( result == WOLFSSL_SUCCESS && !cd.private_key.empty() )
+    {
+        int format = ( cd.private_key_format == file_format::pem )
+            ? WOLFSSL_FILETYPE_PEM : WOLFSSL_FILETYPE_ASN1;
+        result = wolfSSL_use_PrivateKey_buffer( ssl,
+            reinterpret_cast<unsigned char const*>( cd.private_key.data() ),
+            static_cast<long>( cd.private_key.size() ),
+            format );
+    }
+    return result == WOLFSSL_SUCCESS;
+#endif
+}
+
 } // namespace tls::detail
 
 //------------------------------------------------------------------------------
@@ -262,33 +473,53 @@ struct wolfssl_stream_impl_
     WOLFSSL* ssl_ = nullptr;
 
     // Buffers for read operations (used by do_read_some)
-    std::vector<char> read_in_buf_;
+    buffer_lease read_in_buf_;
     std::size_t read_in_pos_ = 0;
     std::size_t read_in_len_ = 0;
-    std::vector<char> read_out_buf_;
+    buffer_lease read_out_buf_;
     std::size_t read_out_len_ = 0;
 
     // Buffers for write operations (used by do_write_some)
-    std::vector<char> write_in_buf_;
+    buffer_lease write_in_buf_;
     std::size_t write_in_pos_ = 0;
     std::size_t write_in_len_ = 0;
-    std::vector<char> write_out_buf_;
+    buffer_lease write_out_buf_;
     std::size_t write_out_len_ = 0;
+    std::size_t write_out_size_ = default_buffer_size;  // lease size for writes
+
+    // Record sizing, and the area records are gathered in
+    tls::detail::record_sizer sizer_;
+    buffer_lease stage_;
 
     // Thread-local pointer to current operation's buffers
     // Set before calling wolfSSL_read/write so callbacks know which buffers to use
     struct op_buffers
     {
-        std::vector<char>* in_buf;
+        buffer_lease* in_buf;
         std::size_t* in_pos;
         std::size_t* in_len;
-        std::vector<char>* out_buf;
+        buffer_lease* out_buf;
         std::size_t* out_len;
         bool want_read;
         bool want_write;
+        bool direct_blocked = false;    // a direct send found the socket full
     };
     op_buffers* current_op_ = nullptr;
 
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+    // The stream as a socket, if it is one
+    socket* sock_ = nullptr;
+
+    // Writes to the stream in progress, which direct sends must not pass
+    int writes_in_flight_ = 0;
+#endif
+
+    // Key of the server in the client session store, for clients
+    std::string session_peer_;
+
+    // The context loaded for the requested name, on a server
+    tls::detail::server_name_state server_name_;
+
     // Renegotiation can cause both TLS read/write to access the socket
     capy::coro_lock io_cm_;
 
@@ -297,20 +528,74 @@ struct wolfssl_stream_impl_
     wolfssl_stream_impl_( io_stream& s, tls::context ctx )
         : s_( s )
         , ctx_( std::move( ctx ) )
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+        , sock_( dynamic_cast<socket*>( &s ) )
+#endif
     {
-        read_in_buf_.resize( default_buffer_size );
-        read_out_buf_.resize( default_buffer_size );
-        write_in_buf_.resize( default_buffer_size );
-        write_out_buf_.resize( default_buffer_size );
     }
 
     ~wolfssl_stream_impl_()
     {
         if( ssl_ )
+        {
+            // TLS 1.3 tickets arrive after the handshake
+            save_session();
             wolfSSL_free( ssl_ );
+        }
         // WOLFSSL_CTX* is owned by cached native context, not freed here
     }
 
+    //--------------------------------------------------------------------------
+    // Session resumption
+    //--------------------------------------------------------------------------
+
+    // Offer the session last kept for this server, if any
+    void
+    resume_session()
+    {
+#ifndef NO_SESSION_CACHE
+        auto const& cd = tls::detail::get_context_data( ctx_ );
+        session_peer_ = tls::detail::session_peer( cd, s_ );
+        if( session_peer_.empty() || cd.session_cache_size == 0 )
+        {
+            session_peer_.clear();
+            return;
+        }
+        auto sess = cd.client_sessions.find(
+            &tls::detail::session_backend, session_peer_ );
+        if( sess )
+            wolfSSL_set_session( ssl_, static_cast<WOLFSSL_SESSION*>( sess.get() ) );
+#endif
+    }
+
+    // Keep the session of a completed client handshake
+    void
+    save_session() noexcept
+    {
+#ifndef NO_SESSION_CACHE
+        if( session_peer_.empty() || !wolfSSL_is_init_finished( ssl_ ) )
+            return;
+        WOLFSSL_SESSION* sess = wolfSSL_get1_session( ssl_ );
+        if( !sess )
+            return;
+        auto const& cd = tls::detail::get_context_data( ctx_ );
+        try
+        {
+            cd.client_sessions.insert( &tls::detail::session_backend,
+                session_peer_,
+                std::shared_ptr<void>( sess, []( void* p )
+                {
+                    wolfSSL_SESSION_free( static_cast<WOLFSSL_SESSION*>( p ) );
+                }),
+                cd.session_cache_size );
+        }
+        catch( std::bad_alloc const& )
+        {
+            // The session was freed along with its handle
+        }
+#endif
+    }
+
     //--------------------------------------------------------------------------
     // WolfSSL I/O Callbacks
     //--------------------------------------------------------------------------
@@ -337,14 +622,16 @@ struct wolfssl_stream_impl_
 
         // Copy available data to WolfSSL's buffer
         std::size_t to_copy = (std::min)(available, static_cast<std::size_t>(sz));
-        std::memcpy(buf, op->in_buf->data() + *op->in_pos, to_copy);
+        std::memcpy(buf,
+            static_cast<char const*>(op->in_buf->data()) + *op->in_pos, to_copy);
         *op->in_pos += to_copy;
 
-        // If we've consumed all data, reset buffer position
+        // If we've consumed all data, return the buffer
         if(*op->in_pos == *op->in_len)
         {
             *op->in_pos = 0;
             *op->in_len = 0;
+            op->in_buf->reset();
         }
 
         return static_cast<int>(to_copy);
@@ -352,7 +639,8 @@ struct wolfssl_stream_impl_
 
     /** Callback invoked by WolfSSL when it needs to send data.
 
-        Copies data to the current operation's output buffer.
+        Sends the data directly when it can, and otherwise copies it
+        to the current operation's output buffer.
         Returns WOLFSSL_CBIO_ERR_WANT_WRITE if the buffer is full.
     */
     static int
@@ -361,6 +649,25 @@ struct wolfssl_stream_impl_
         auto* impl = static_cast<wolfssl_stream_impl_*>(ctx);
         auto* op = impl->current_op_;
 
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+        if(impl->can_send_directly())
+            return impl->send_directly(op, buf, sz);
+#endif
+
+        if(op->out_buf->empty())
+        {
+            try
+            {
+                *op->out_buf = get_buffer_pool(impl->s_.context()).acquire(
+                    op->out_buf == &impl->write_out_buf_ ?
+                        impl->write_out_size_ : default_buffer_size);
+            }
+            catch(std::bad_alloc const&)
+            {
+                return WOLFSSL_CBIO_ERR_GENERAL;
+            }
+        }
+
         // Check if we have room in the output buffer
         std::size_t available = op->out_buf->size() - *op->out_len;
         if(available == 0)
@@ -372,7 +679,7 @@ struct wolfssl_stream_impl_
 
         // Copy data to output buffer
         std::size_t to_copy = (std::min)(available, static_cast<std::size_t>(sz));
-        std::memcpy(op->out_buf->data() + *op->out_len, buf, to_copy);
+        std::memcpy(static_cast<char*>(op->out_buf->data()) + *op->out_len, buf, to_copy);
         *op->out_len += to_copy;
 
         // If we couldn't copy everything, signal partial write
@@ -382,17 +689,93 @@ struct wolfssl_stream_impl_
         return static_cast<int>(to_copy);
     }
 
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+    // True when nothing is queued or being written ahead of new output
+    bool
+    can_send_directly() const noexcept
+    {
+        return sock_ && sock_->is_open() && writes_in_flight_ == 0 &&
+            read_out_len_ == 0 && write_out_len_ == 0;
+    }
+
+    int
+    send_directly(op_buffers* op, char const* buf, int sz) noexcept
+    {
+        int flags = MSG_DONTWAIT;
+#ifdef MSG_NOSIGNAL
+        flags |= MSG_NOSIGNAL;
+#endif
+        for(;;)
+        {
+            ssize_t n = ::send(static_cast<int>(sock_->native_handle()),
+                buf, static_cast<std::size_t>(sz), flags);
+            if(n >= 0)
+                return static_cast<int>(n);
+            if(errno == EINTR)
+                continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                op->want_write = true;
+                op->direct_blocked = true;
+                return WOLFSSL_CBIO_ERR_WANT_WRITE;
+            }
+            if(errno == EPIPE || errno == ECONNRESET)
+                return WOLFSSL_CBIO_ERR_CONN_RST;
+            return WOLFSSL_CBIO_ERR_GENERAL;
+        }
+    }
+
+    // Wait until a direct send can make progress
+    capy::task<system::error_code>
+    wait_writable(std::stop_token token)
+    {
+        if(token.stop_requested())
+            co_return make_error_code(system::errc::operation_canceled);
+
+        auto guard = co_await io_cm_.scoped_lock();
+        auto [ec] = co_await sock_->wait(socket::wait_type::write);
+        if(ec == system::errc::operation_not_supported)
+        {
+            // No readiness waits on this backend; retry shortly
+            timer t(s_.context());
+            t.expires_after(std::chrono::milliseconds(1));
+            auto [tec] = co_await t.wait();
+            ec = tec;
+        }
+        co_return ec;
+    }
+#endif
+
     //--------------------------------------------------------------------------
 
-    capy::task<capy::io_result<std::size_t>>
-    do_underlying_read(capy::mutable_buffer buf, std::stop_token token)
+    // WolfSSL wants input only once recv_callback has consumed all
+    // of it, so each read replaces an empty input buffer
+    capy::task<system::error_code>
+    do_underlying_read(
+        buffer_lease& in_buf,
+        std::size_t& in_pos,
+        std::size_t& in_len,
+        std::stop_token token)
     {
         if(token.stop_requested())
-            co_return capy::io_result<std::size_t>{
-                make_error_code(system::errc::operation_canceled), 0};
+            co_return make_error_code(system::errc::operation_canceled);
 
         auto guard = co_await io_cm_.scoped_lock();
-        co_return co_await s_.read_some(buf);
+        auto [ec, lease] = co_await s_.read_leased(default_buffer_size);
+        if(ec)
+            co_return ec;
+        in_buf = std::move(lease);
+        in_pos = 0;
+        in_len = in_buf.size();
+        co_return system::error_code{};
+    }
+
+    // Return an operation's output buffer once it holds nothing to send
+    static void
+    release_idle_buffers(op_buffers& op) noexcept
+    {
+        if(*op.out_len == 0)
+            op.out_buf->reset();
     }
 
     capy::task<capy::io_result<std::size_t>>
@@ -402,14 +785,62 @@ struct wolfssl_stream_impl_
             co_return capy::io_result<std::size_t>{
                 make_error_code(system::errc::operation_canceled), 0};
 
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+        ++writes_in_flight_;
+        auto guard = co_await io_cm_.scoped_lock();
+        auto r = co_await s_.write_some(buf);
+        --writes_in_flight_;
+        co_return r;
+#else
         auto guard = co_await io_cm_.scoped_lock();
         co_return co_await s_.write_some(buf);
+#endif
+    }
+
+    // Send an operation's buffered output, or, when a direct send
+    // found the socket full, wait until it has room
+    capy::task<system::error_code>
+    flush_output(op_buffers& op, std::stop_token token)
+    {
+        while(*op.out_len > 0)
+        {
+            capy::mutable_buffer buf(op.out_buf->data(), *op.out_len);
+            auto [ec, n] = co_await do_underlying_write(buf, token);
+            if(ec)
+                co_return ec;
+            char* p = static_cast<char*>(op.out_buf->data());
+            std::memmove(p, p + n, *op.out_len - n);
+            *op.out_len -= n;
+        }
+#if BOOST_COROSIO_WOLFSSL_DIRECT_SEND
+        if(op.direct_blocked)
+        {
+            op.direct_blocked = false;
+            co_return co_await wait_writable(token);
+        }
+#endif
+        co_return system::error_code{};
     }
 
     //--------------------------------------------------------------------------
     // Inner coroutines for TLS read/write operations
     //--------------------------------------------------------------------------
 
+#ifdef WOLFSSL_ASYNC_CRYPT
+    /** Wait for a pending asynchronous crypto operation.
+
+        Called when a step fails with WC_PENDING_E. Polls the device
+        once and yields to the executor, after which the caller
+        repeats the step.
+    */
+    capy::task<>
+    wait_async()
+    {
+        wolfSSL_AsyncPoll(ssl_, WOLF_POLL_FLAG_CHECK_HW);
+        co_await tls::detail::yield();
+    }
+#endif
+
     /** Inner coroutine that performs TLS read with WANT_READ loop.
 
         Calls wolfSSL_read in a loop, performing async reads from the
@@ -466,9 +897,8 @@ struct wolfssl_stream_impl_
 
                     if(err == WOLFSSL_ERROR_WANT_READ)
                     {
-                        if(read_in_pos_ == read_in_len_) { read_in_pos_ = 0; read_in_len_ = 0; }
-                        capy::mutable_buffer buf(read_in_buf_.data() + read_in_len_, read_in_buf_.size() - read_in_len_);
-                        auto [rec, rn] = co_await do_underlying_read(buf, token);
+                        auto rec = co_await do_underlying_read(
+                            read_in_buf_, read_in_pos_, read_in_len_, token);
                         if(rec)
                         {
                             if(rec == make_error_code(capy::error::eof))
@@ -485,21 +915,20 @@ struct wolfssl_stream_impl_
                             }
                             goto done;
                         }
-                        read_in_len_ += rn;
                     }
                     else if(err == WOLFSSL_ERROR_WANT_WRITE)
                     {
                         // Renegotiation
-                        while(read_out_len_ > 0)
-                        {
-                            capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                            auto [wec, wn] = co_await do_underlying_write(buf, token);
-                            if(wec) { ec = wec; goto done; }
-                            if(wn < read_out_len_)
-                                std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                            read_out_len_ -= wn;
-                        }
+                        ec = co_await flush_output(op, token);
+                        if(ec)
+                            goto done;
+                    }
+#ifdef WOLFSSL_ASYNC_CRYPT
+                    else if(err == WC_PENDING_E)
+                    {
+                        co_await wait_async();
                     }
+#endif
                     else if(err == WOLFSSL_ERROR_ZERO_RETURN)
                     {
                         // Clean TLS shutdown - treat as EOF
@@ -518,6 +947,7 @@ struct wolfssl_stream_impl_
 
     done:
         current_op_ = nullptr;
+        release_idle_buffers(op);
 
         if(token.stop_requested())
             ec = make_error_code(system::errc::operation_canceled);
@@ -556,41 +986,59 @@ struct wolfssl_stream_impl_
         };
         current_op_ = &op;
 
-        // Process each source buffer
-        for(std::size_t i = 0; i < buf_count && !token.stop_requested(); ++i)
         {
-            char const* src = static_cast<char const*>(src_bufs[i].data());
-            int remaining = static_cast<int>(src_bufs[i].size());
+            // Encrypt records until the caller's bytes run out or the
+            // output buffer is full, then send them with one write
+            tls::detail::write_cursor cur(src_bufs.data(), buf_count);
+            bool const dynamic =
+                tls::detail::get_context_data(ctx_).dynamic_records;
+            auto now = tls::detail::record_sizer::clock::now();
+
+            std::size_t total = 0;
+            for(std::size_t i = 0; i < buf_count; ++i)
+                total += src_bufs[i].size();
+            std::size_t const limit = sizer_.next(dynamic, now);
+            write_out_size_ = (std::min)(
+                (std::max)(total + (total / limit + 1) * record_overhead,
+                    default_buffer_size),
+                buffer_pool::max_size);
+
+            if(buf_count > 1)
+            {
+                try
+                {
+                    stage_ = get_buffer_pool(s_.context()).acquire(
+                        tls::detail::record_sizer::full_size);
+                }
+                catch(std::bad_alloc const&)
+                {
+                    // Write a record per buffer instead
+                }
+            }
 
-            while(remaining > 0 && !token.stop_requested())
+            capy::const_buffer chunk;
+            bool full = false;
+            while(!cur.done() && !token.stop_requested())
             {
                 op.want_read = false;
                 op.want_write = false;
 
-                int ret = wolfSSL_write(ssl_, src, remaining);
+                // Retries must pass the same bytes
+                if(chunk.size() == 0)
+                    chunk = cur.next(sizer_.next(dynamic, now),
+                        static_cast<char*>(stage_.data()));
+
+                int ret = wolfSSL_write(ssl_, chunk.data(),
+                    static_cast<int>(chunk.size()));
 
                 if(ret > 0)
                 {
-                    // Successfully wrote some data
-                    src += ret;
-                    remaining -= ret;
+                    cur.consume(static_cast<std::size_t>(ret));
                     total_written += static_cast<std::size_t>(ret);
-
-                    // For write_some semantics, return after first successful write
-                    if(total_written > 0)
-                    {
-                        // Flush any pending output
-                        while(write_out_len_ > 0)
-                        {
-                            capy::mutable_buffer buf(write_out_buf_.data(), write_out_len_);
-                            auto [wec, wn] = co_await do_underlying_write(buf, token);
-                            if(wec) { ec = wec; goto done; }
-                            if(wn < write_out_len_)
-                                std::memmove(write_out_buf_.data(), write_out_buf_.data() + wn, write_out_len_ - wn);
-                            write_out_len_ -= wn;
-                        }
-                        goto done;
-                    }
+                    sizer_.on_sent(static_cast<std::size_t>(ret), now);
+                    chunk = {};
+                    if(full)
+                        break;
                 }
                 else
                 {
@@ -598,25 +1046,26 @@ struct wolfssl_stream_impl_
 
                     if(err == WOLFSSL_ERROR_WANT_WRITE)
                     {
-                        while(write_out_len_ > 0)
-                        {
-                            capy::mutable_buffer buf(write_out_buf_.data(), write_out_len_);
-                            auto [wec, wn] = co_await do_underlying_write(buf, token);
-                            if(wec) { ec = wec; goto done; }
-                            if(wn < write_out_len_)
-                                std::memmove(write_out_buf_.data(), write_out_buf_.data() + wn, write_out_len_ - wn);
-                            write_out_len_ -= wn;
-                        }
+                        // The output is full. WolfSSL may hold part of
+                        // the record, so finish it, then return
+                        ec = co_await flush_output(op, token);
+                        if(ec)
+                            goto done;
+                        full = total_written > 0;
                     }
                     else if(err == WOLFSSL_ERROR_WANT_READ)
                     {
                         // Renegotiation
-                        if(write_in_pos_ == write_in_len_) { write_in_pos_ = 0; write_in_len_ = 0; }
-                        capy::mutable_buffer buf(write_in_buf_.data() + write_in_len_, write_in_buf_.size() - write_in_len_);
-                        auto [rec, rn] = co_await do_underlying_read(buf, token);
+                        auto rec = co_await do_underlying_read(
+                            write_in_buf_, write_in_pos_, write_in_len_, token);
                         if(rec) { ec = rec; goto done; }
-                        write_in_len_ += rn;
                     }
+#ifdef WOLFSSL_ASYNC_CRYPT
+                    else if(err == WC_PENDING_E)
+                    {
+                        co_await wait_async();
+                    }
+#endif
                     else
                     {
                         // Other error
@@ -625,10 +1074,18 @@ struct wolfssl_stream_impl_
                     }
                 }
             }
+
+            // Flush any pending output
+            ec = co_await flush_output(op, token);
+            if(ec)
+                goto done;
         }
 
     done:
         current_op_ = nullptr;
+        release_idle_buffers(op);
+        stage_.reset();
+        write_out_size_ = default_buffer_size;
 
         if(token.stop_requested())
             ec = make_error_code(system::errc::operation_canceled);
@@ -674,90 +1131,79 @@ struct wolfssl_stream_impl_
         };
         current_op_ = &op;
 
+        tls::detail::handshake_pool* pool = nullptr;
+        try
+        {
+            pool = tls::detail::get_context_data( ctx_ ).get_handshake_pool();
+        }
+        catch(std::system_error const&)
+        {
+            // Without threads, handshake on this one
+        }
+
         while(!token.stop_requested())
         {
             op.want_read = false;
             op.want_write = false;
 
-            // Call appropriate handshake function based on type
-            int ret;
-            if(type == wolfssl_stream::client)
-                ret = wolfSSL_connect(ssl_);
+            // Call appropriate handshake function based on type,
+            // on the context's handshake pool when it has one
+            auto step = [this, type]() -> std::pair<int, int>
+            {
+                int ret;
+                if(type == wolfssl_stream::client)
+                    ret = wolfSSL_connect(ssl_);
+                else
+                    ret = wolfSSL_accept(ssl_);
+                return { ret,
+                    ret == WOLFSSL_SUCCESS ? 0 : wolfSSL_get_error(ssl_, ret) };
+            };
+            std::pair<int, int> r;
+            if(pool)
+                r = co_await tls::detail::offload( *pool, step );
             else
-                ret = wolfSSL_accept(ssl_);
+                r = step();
+            int ret = r.first;
 
             if(ret == WOLFSSL_SUCCESS)
             {
                 // Handshake completed successfully
+                save_session();
                 // Flush any remaining output
-                while(read_out_len_ > 0)
-                {
-                    capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                    auto [wec, wn] = co_await do_underlying_write(buf, token);
-                    if(wec)
-                    {
-                        ec = wec;
-                        break;
-                    }
-                    if(wn < read_out_len_)
-                        std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                    read_out_len_ -= wn;
-                }
+                ec = co_await flush_output(op, token);
                 break;
             }
             else
             {
-                int err = wolfSSL_get_error(ssl_, ret);
+                int err = r.second;
 
                 if(err == WOLFSSL_ERROR_WANT_READ)
                 {
                     // Must flush (e.g. ClientHello) before reading ServerHello
-                    while(read_out_len_ > 0)
-                    {
-                        capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                        auto [wec, wn] = co_await do_underlying_write(buf, token);
-                        if(wec)
-                        {
-                            ec = wec;
-                            goto exit_loop;
-                        }
-                        if(wn < read_out_len_)
-                            std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                        read_out_len_ -= wn;
-                    }
+                    ec = co_await flush_output(op, token);
+                    if(ec)
+                        goto exit_loop;
 
-                    if(read_in_pos_ == read_in_len_)
-                    {
-                        read_in_pos_ = 0;
-                        read_in_len_ = 0;
-                    }
-                    capy::mutable_buffer buf(
-                        read_in_buf_.data() + read_in_len_,
-                        read_in_buf_.size() - read_in_len_);
-                    auto [rec, rn] = co_await do_underlying_read(buf, token);
+                    auto rec = co_await do_underlying_read(
+                        read_in_buf_, read_in_pos_, read_in_len_, token);
                     if(rec)
                     {
                         ec = rec;
                         break;
                     }
-                    read_in_len_ += rn;
                 }
                 else if(err == WOLFSSL_ERROR_WANT_WRITE)
                 {
-                    while(read_out_len_ > 0)
-                    {
-                        capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                        auto [wec, wn] = co_await do_underlying_write(buf, token);
-                        if(wec)
-                        {
-                            ec = wec;
-                            goto exit_loop;
-                        }
-                        if(wn < read_out_len_)
-                            std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                        read_out_len_ -= wn;
-                    }
+                    ec = co_await flush_output(op, token);
+                    if(ec)
+                        goto exit_loop;
+                }
+#ifdef WOLFSSL_ASYNC_CRYPT
+                else if(err == WC_PENDING_E)
+                {
+                    co_await wait_async();
                 }
+#endif
                 else
                 {
                     // Other error
@@ -769,6 +1215,7 @@ struct wolfssl_stream_impl_
 
     exit_loop:
         current_op_ = nullptr;
+        release_idle_buffers(op);
 
         if(token.stop_requested())
             ec = make_error_code(system::errc::operation_canceled);
@@ -821,19 +1268,7 @@ struct wolfssl_stream_impl_
             if(ret == WOLFSSL_SUCCESS)
             {
                 // Bidirectional shutdown complete - flush any remaining output
-                while(read_out_len_ > 0)
-                {
-                    capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                    auto [wec, wn] = co_await do_underlying_write(buf, token);
-                    if(wec)
-                    {
-                        ec = wec;
-                        break;
-                    }
-                    if(wn < read_out_len_)
-                        std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                    read_out_len_ -= wn;
-                }
+                ec = co_await flush_output(op, token);
                 break;
             }
             else if(ret == WOLFSSL_SHUTDOWN_NOT_DONE)
@@ -842,18 +1277,10 @@ struct wolfssl_stream_impl_
                 // This mirrors OpenSSL's SSL_shutdown() returning 0.
                 
                 // First, flush any pending output (sends our close_notify)
-                while(read_out_len_ > 0)
+                if(co_await flush_output(op, token))
                 {
-                    capy::mutable_buffer buf(read_out_buf_.data(), read_out_len_);
-                    auto [wec, wn] = co_await do_underlying_write(buf, token);
-                    if(wec)
-                    {
-                        // Socket error during shutdown write - acceptable, we're done
-                        goto exit_shutdown;
-                    }
-                    if(wn < read_out_len_)
-                        std::memmove(read_out_buf_.data(), read_out_buf_.data() + wn, read_out_len_ - wn);
-                    read_out_len_ -= wn;
+                    // Socket error during shutdown write - acceptable, we're done
+                    goto exit_shutdown;
                 }
 
                 // Check what WolfSSL needs next
@@ -861,22 +1288,14 @@ struct wolfssl_stream_impl_
                 {
                     // Need to read peer's close_notify from the socket
                     // err==0 also needs a read - the close_notify was sent, now wait for peer
-                    if(read_in_pos_ == read_in_len_)
-                    {
-                        read_in_pos_ = 0;
-                        read_in_len_ = 0;
-                    }
-                    capy::mutable_buffer buf(
-                        read_in_buf_.data() + read_in_len_,
-                        read_in_buf_.size() - read_in_len_);
-                    auto [rec, rn] = co_await do_underlying_read(buf, token);
+                    auto rec = co_await do_underlying_read(
+                        read_in_buf_, read_in_pos_, read_in_len_, token);
                     if(rec)
                     {
                         // EOF or socket error during shutdown read - acceptable
                         // The peer may have just closed the socket without close_notify
                         goto exit_shutdown;
                     }
-                    read_in_len_ += rn;
                     // Continue loop to process the received data with wolfSSL_shutdown
                 }
                 else if(err == WOLFSSL_ERROR_WANT_WRITE)
@@ -895,6 +1314,12 @@ struct wolfssl_stream_impl_
                     break;
                 }
             }
+            else if(err == WOLFSSL_ERROR_WANT_WRITE)
+            {
+                // close_notify did not fit the socket; send it when it can
+                if(co_await flush_output(op, token))
+                    goto exit_shutdown;
+            }
             else
             {
                 // SSL_FATAL_ERROR or negative return
@@ -905,6 +1330,7 @@ struct wolfssl_stream_impl_
 
     exit_shutdown:
         current_op_ = nullptr;
+        release_idle_buffers(op);
 
         if(token.stop_requested())
             ec = make_error_code(system::errc::operation_canceled);
@@ -925,7 +1351,7 @@ struct wolfssl_stream_impl_
         delete this;
     }
 
-    void read_some(
+    bool read_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param param,
@@ -941,9 +1367,10 @@ struct wolfssl_stream_impl_
         // Launch inner coroutine via run_async with stop_token for cancellation
         capy::run_async(d, token)(
             do_read_some(bufs, count, token, ec, bytes, h, d));
+        return false;
     }
 
-    void write_some(
+    bool write_some(
         std::coroutine_handle<> h,
         capy::executor_ref d,
         io_buffer_param param,
@@ -959,6 +1386,7 @@ struct wolfssl_stream_impl_
         // Launch inner coroutine via run_async with stop_token for cancellation
         capy::run_async(d, token)(
             do_write_some(bufs, count, token, ec, bytes, h, d));
+        return false;
     }
 
     void handshake(
@@ -984,6 +1412,40 @@ struct wolfssl_stream_impl_
             do_shutdown(token, ec, h, d));
     }
 
+    // Early data is not sent: a regular handshake, reporting none
+    // accepted, so that the caller writes it all afterwards
+    void handshake_early(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        capy::const_buffer,
+        std::stop_token token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        *bytes = 0;
+        capy::run_async(d, token)(
+            do_handshake(wolfssl_stream::client, token, ec, h, d));
+    }
+
+    // Early data is never read, as if the client sent none
+    void read_early_data(
+        std::coroutine_handle<> h,
+        capy::executor_ref d,
+        capy::mutable_buffer,
+        std::stop_token,
+        system::error_code* ec,
+        std::size_t* bytes) override
+    {
+        *ec = {};
+        *bytes = 0;
+        d.post(h);
+    }
+
+    bool session_reused() const noexcept override
+    {
+        return ssl_ && wolfSSL_session_reused( ssl_ ) == 1;
+    }
+
     //--------------------------------------------------------------------------
     // Initialization
     //--------------------------------------------------------------------------
@@ -1050,10 +1512,38 @@ struct wolfssl_stream_impl_
             wolfSSL_check_domain_name( ssl_, impl.hostname.c_str() );
         }
 
+        if( type == wolfssl_stream::client )
+        {
+#if defined( HAVE_CERTIFICATE_STATUS_REQUEST ) && defined( HAVE_OCSP )
+            // Ask the server to staple its certificate status, without
+            // a nonce so that it can serve a cached response
+            if( impl.require_ocsp_staple ||
+                impl.revocation != tls::revocation_policy::disabled )
+                wolfSSL_UseOCSPStapling( ssl_, WOLFSSL_CSR_OCSP, 0 );
+#endif
+#ifdef HAVE_SESSION_TICKET
+            if( impl.session_tickets )
+                wolfSSL_UseSessionTicket( ssl_ );
+#endif
+            resume_session();
+        }
+
         return {};
     }
 };
 
+namespace tls::detail {
+
+// The stream is the I/O context of its WOLFSSL
+static server_name_state*
+get_server_name_state( WOLFSSL* ssl ) noexcept
+{
+    auto* impl = static_cast<wolfssl_stream_impl_*>( wolfSSL_GetIOReadCtx( ssl ) );
+    return impl ? &impl->server_name_ : nullptr;
+}
+
+} // namespace tls::detail
+
 //------------------------------------------------------------------------------
 
 wolfssl_stream::
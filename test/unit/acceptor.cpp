@@ -12,9 +12,14 @@
 
 #include <boost/corosio/io_context.hpp>
 #include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
 #include <boost/capy/cond.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/ipv6_address.hpp>
+
+#include <vector>
 
 // Include platform-specific context headers for multi-backend testing
 #include <boost/corosio/detail/platform.hpp>
@@ -22,6 +27,14 @@
 #include <boost/corosio/select_context.hpp>
 #endif
 
+#if BOOST_COROSIO_HAS_POLL
+#include <boost/corosio/poll_context.hpp>
+#endif
+
+#if BOOST_COROSIO_POSIX
+#include <unistd.h>
+#endif
+
 #include "test_suite.hpp"
 
 namespace boost::corosio {
@@ -148,6 +161,32 @@ struct acceptor_test_impl
         acc.close();
     }
 
+    void
+    testAcceptDeadline()
+    {
+        Context ioc;
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+
+        system::error_code accept_ec;
+        socket peer(ioc);
+
+        auto task = [&]() -> capy::task<>
+        {
+            // No incoming connections, so the accept times out
+            auto [ec] = co_await acc.accept(peer,
+                std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(20));
+            accept_ec = ec;
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST(accept_ec == system::errc::timed_out);
+        BOOST_TEST(!peer.is_open());
+        acc.close();
+    }
+
     void
     testCloseWhilePendingAccept()
     {
@@ -198,6 +237,361 @@ struct acceptor_test_impl
         ioc.run();
     }
 
+    void
+    testAcceptBurst()
+    {
+        // Connections established before accept() is awaited must all
+        // be delivered, including more than a pre-accepting backend
+        // keeps queued at once
+        Context ioc;
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint ep(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        constexpr int n = 8;
+        std::vector<socket> clients;
+        clients.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            clients.emplace_back(ioc);
+            clients.back().open();
+        }
+
+        int connected = 0;
+        int accepted = 0;
+        auto task = [&]() -> capy::task<>
+        {
+            for (auto& c : clients)
+            {
+                auto [ec] = co_await c.connect(ep);
+                if (!ec)
+                    ++connected;
+            }
+
+            for (int i = 0; i < n; ++i)
+            {
+                socket peer(ioc);
+                auto [ec] = co_await acc.accept(peer);
+                if (!ec && peer.is_open())
+                    ++accepted;
+            }
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(connected, n);
+        BOOST_TEST_EQ(accepted, n);
+        acc.close();
+    }
+
+    void
+    testAcceptWhileParked()
+    {
+        // A burst arriving while accept() waits in the reactor may be
+        // drained by one readiness event; every connection must still
+        // be delivered
+        Context ioc;
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint ep(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        constexpr int n = 8;
+        std::vector<socket> clients;
+        clients.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            clients.emplace_back(ioc);
+            clients.back().open();
+        }
+
+        int accepted = 0;
+        auto accept_all = [&]() -> capy::task<>
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                socket peer(ioc);
+                auto [ec] = co_await acc.accept(peer);
+                if (!ec && peer.is_open())
+                    ++accepted;
+            }
+        };
+        auto connect_all = [&]() -> capy::task<>
+        {
+            for (auto& c : clients)
+            {
+                auto [ec] = co_await c.connect(ep);
+                BOOST_TEST(!ec);
+            }
+        };
+        capy::run_async(ioc.get_executor())(accept_all());
+        capy::run_async(ioc.get_executor())(connect_all());
+
+        ioc.run();
+        BOOST_TEST_EQ(accepted, n);
+        acc.close();
+    }
+
+    void
+    testCloseDiscardsPending()
+    {
+        // Connections left waiting when the acceptor closes, whether
+        // in the kernel or drained into the acceptor, are dropped
+        Context ioc;
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint ep(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        constexpr int n = 4;
+        std::vector<socket> clients;
+        clients.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            clients.emplace_back(ioc);
+            clients.back().open();
+        }
+
+        // These must outlive the coroutines
+        socket peer(ioc);
+        bool accept_done = false;
+        int dropped = 0;
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto accept_one = [&]() -> capy::task<>
+            {
+                auto [ec] = co_await acc.accept(peer);
+                BOOST_TEST(!ec);
+                accept_done = true;
+            };
+            capy::run_async(ioc.get_executor())(accept_one());
+
+            for (auto& c : clients)
+            {
+                auto [ec] = co_await c.connect(ep);
+                BOOST_TEST(!ec);
+            }
+
+            // Let the readiness event be handled before closing
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+            BOOST_TEST(accept_done);
+            acc.close();
+
+            // Every client but the accepted one sees its connection end
+            for (auto& c : clients)
+            {
+                if (c.local_endpoint().port() == peer.remote_endpoint().port())
+                    continue;
+                char buf[1];
+                auto [ec, bytes] = co_await c.read_some(
+                    capy::mutable_buffer(buf, sizeof(buf)));
+                if (ec)
+                    ++dropped;
+            }
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(dropped, n - 1);
+    }
+
+    // Accept one connection from a client of the given family and
+    // report the peer's remote endpoint as seen by the acceptor
+    endpoint
+    acceptOne(Context& ioc, acceptor& acc, endpoint target, ip_family family)
+    {
+        socket client(ioc);
+        client.open(family);
+
+        endpoint peer_remote;
+        bool ok = false;
+        auto task = [&]() -> capy::task<>
+        {
+            auto [cec] = co_await client.connect(target);
+            BOOST_TEST(!cec);
+
+            socket peer(ioc);
+            auto [aec] = co_await acc.accept(peer);
+            BOOST_TEST(!aec);
+            ok = !cec && !aec;
+            if (ok)
+                peer_remote = peer.remote_endpoint();
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        ioc.restart();
+        BOOST_TEST(ok);
+        BOOST_TEST_EQ(peer_remote.port(), client.local_endpoint().port());
+        return peer_remote;
+    }
+
+    void
+    testListenIPv6()
+    {
+        Context ioc;
+        acceptor acc(ioc);
+        try
+        {
+            acc.listen(endpoint(urls::ipv6_address::loopback(), 0));
+        }
+        catch (system::system_error const&)
+        {
+            // IPv6 unavailable on this host
+            return;
+        }
+        BOOST_TEST(acc.local_endpoint().is_v6());
+        BOOST_TEST_NE(acc.local_endpoint().port(), 0);
+
+        endpoint ep(urls::ipv6_address::loopback(), acc.local_endpoint().port());
+        auto remote = acceptOne(ioc, acc, ep, ip_family::v6);
+        BOOST_TEST(remote.is_v6());
+        BOOST_TEST(remote.v6_address() == urls::ipv6_address::loopback());
+    }
+
+    void
+    testDualStack()
+    {
+        Context ioc;
+        acceptor acc(ioc);
+        acceptor::listen_options opts;
+        opts.dual_stack = true;
+        try
+        {
+            acc.listen(endpoint(urls::ipv6_address(), 0), opts);
+        }
+        catch (system::system_error const&)
+        {
+            return;
+        }
+        auto port = acc.local_endpoint().port();
+
+        // An IPv4 peer of a dual-stack acceptor is reported as IPv4
+        auto remote = acceptOne(ioc, acc,
+            endpoint(urls::ipv4_address::loopback(), port), ip_family::v4);
+        BOOST_TEST(remote.is_v4());
+        BOOST_TEST(remote.v4_address() == urls::ipv4_address::loopback());
+
+        acceptOne(ioc, acc,
+            endpoint(urls::ipv6_address::loopback(), port), ip_family::v6);
+    }
+
+#if BOOST_COROSIO_POSIX
+    void
+    testAssign()
+    {
+        Context ioc;
+        acceptor acc1(ioc);
+        acc1.listen(endpoint(urls::ipv4_address::loopback(), 0));
+        auto port = acc1.local_endpoint().port();
+
+        // A second handle to the same socket, as another process
+        // taking over the listener would have
+        acceptor acc2(ioc);
+        acc2.assign(::dup(acc1.native_handle()));
+        BOOST_TEST(acc2.is_open());
+        BOOST_TEST_EQ(acc2.local_endpoint().port(), port);
+
+        // Closing the first leaves the socket listening
+        acc1.close();
+        BOOST_TEST(acc1.native_handle() == -1);
+        acceptOne(ioc, acc2,
+            endpoint(urls::ipv4_address::loopback(), port), ip_family::v4);
+
+        // A socket that is not listening is refused and left open
+        socket s(ioc);
+        s.open();
+        int fd = ::dup(s.native_handle());
+        acceptor acc3(ioc);
+        BOOST_TEST_THROWS(acc3.assign(fd), system::system_error);
+        BOOST_TEST(!acc3.is_open());
+        BOOST_TEST_EQ(::close(fd), 0);
+    }
+
+    void
+    testShare()
+    {
+        Context ioc1;
+        Context ioc2;
+        acceptor::listen_options opts;
+        opts.exclusive_wakeup = true;
+        acceptor acc1(ioc1);
+        acc1.listen(endpoint(urls::ipv4_address::loopback(), 0), opts);
+        auto port = acc1.local_endpoint().port();
+        endpoint ep(urls::ipv4_address::loopback(), port);
+
+        acceptor acc2(ioc2);
+        BOOST_TEST_THROWS(acc2.share(acceptor(ioc2)), std::logic_error);
+        acc2.share(acc1);
+        BOOST_TEST(acc2.is_open());
+        BOOST_TEST(acc2.native_handle() != acc1.native_handle());
+        BOOST_TEST_EQ(acc2.local_endpoint().port(), port);
+
+        // Each context accepts from the one queue
+        acceptOne(ioc1, acc1, ep, ip_family::v4);
+        acceptOne(ioc2, acc2, ep, ip_family::v4);
+
+        // Closing the first leaves the second listening
+        acc1.close();
+        acceptOne(ioc2, acc2, ep, ip_family::v4);
+    }
+#endif
+
+#if defined(__linux__)
+    void
+    testCpuSteering()
+    {
+        Context ioc;
+
+        // Steering chooses among a reuseport group
+        {
+            acceptor acc(ioc);
+            acceptor::listen_options opts;
+            opts.cpu_steering = true;
+            BOOST_TEST_THROWS(
+                acc.listen(endpoint(urls::ipv4_address::loopback(), 0), opts),
+                system::system_error);
+        }
+
+        acceptor::listen_options opts;
+        opts.reuse_port = true;
+        opts.cpu_steering = true;
+        acceptor acc1(ioc);
+        acc1.listen(endpoint(urls::ipv4_address::loopback(), 0), opts);
+        endpoint ep(urls::ipv4_address::loopback(), acc1.local_endpoint().port());
+        acceptor acc2(ioc);
+        acc2.listen(ep, opts);
+
+        // Whichever acceptor the CPU selects, the connection arrives
+        socket client(ioc);
+        client.open();
+        int accepted = 0;
+        auto accept_one = [&](acceptor& acc) -> capy::task<>
+        {
+            socket peer(ioc);
+            auto [ec] = co_await acc.accept(peer);
+            if (!ec)
+            {
+                ++accepted;
+                acc1.cancel();
+                acc2.cancel();
+            }
+        };
+        auto connect = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await client.connect(ep);
+            BOOST_TEST(!ec);
+        };
+        capy::run_async(ioc.get_executor())(accept_one(acc1));
+        capy::run_async(ioc.get_executor())(accept_one(acc2));
+        capy::run_async(ioc.get_executor())(connect());
+
+        ioc.run();
+        BOOST_TEST_EQ(accepted, 1);
+    }
+#endif
+
     void
     run()
     {
@@ -205,9 +599,22 @@ struct acceptor_test_impl
         testListen();
         testMoveConstruct();
         testMoveAssign();
+        testAcceptBurst();
+        testAcceptWhileParked();
+        testCloseDiscardsPending();
+        testListenIPv6();
+        testDualStack();
+#if BOOST_COROSIO_POSIX
+        testAssign();
+        testShare();
+#endif
+#if defined(__linux__)
+        testCpuSteering();
+#endif
 
         // Cancellation
         testCancelAccept();
+        testAcceptDeadline();
         testCloseWhilePendingAccept();
     }
 };
@@ -226,4 +633,68 @@ struct acceptor_test_select : acceptor_test_impl<select_context> {};
 TEST_SUITE(acceptor_test_select, "boost.corosio.acceptor.select");
 #endif
 
+// POSIX: also test with poll_context explicitly
+#if BOOST_COROSIO_HAS_POLL
+struct acceptor_test_poll : acceptor_test_impl<poll_context> {};
+TEST_SUITE(acceptor_test_poll, "boost.corosio.acceptor.poll");
+#endif
+
+// epoll: also drain bursts ahead of accept(), with a backlog small
+// enough that bursts fill it
+#if BOOST_COROSIO_HAS_EPOLL
+struct epoll_backlog_context : epoll_context
+{
+    epoll_backlog_context()
+        : epoll_context(1, epoll_options{.accept_backlog = 4})
+    {
+    }
+};
+
+struct acceptor_test_epoll_backlog : acceptor_test_impl<epoll_backlog_context> {};
+TEST_SUITE(acceptor_test_epoll_backlog, "boost.corosio.acceptor.epoll_backlog");
+#endif
+
+#if BOOST_COROSIO_HAS_SELECT
+struct select_backlog_context : select_context
+{
+    select_backlog_context()
+        : select_context(1, select_options{.accept_backlog = 4})
+    {
+    }
+};
+
+struct acceptor_test_select_backlog : acceptor_test_impl<select_backlog_context> {};
+TEST_SUITE(acceptor_test_select_backlog, "boost.corosio.acceptor.select_backlog");
+#endif
+
+// io_uring: also test multishot accept, with a backlog small enough
+// that bursts are throttled
+#if BOOST_COROSIO_HAS_IO_URING
+struct io_uring_backlog_context : io_uring_context
+{
+    io_uring_backlog_context()
+        : io_uring_context(1, io_uring_options{.accept_backlog = 4})
+    {
+    }
+};
+
+struct acceptor_test_io_uring_backlog : acceptor_test_impl<io_uring_backlog_context> {};
+TEST_SUITE(acceptor_test_io_uring_backlog, "boost.corosio.acceptor.io_uring_backlog");
+#endif
+
+// IOCP: also test pre-posted AcceptEx, with a pool small enough
+// that bursts fill it
+#if BOOST_COROSIO_HAS_IOCP
+struct iocp_backlog_context : iocp_context
+{
+    iocp_backlog_context()
+        : iocp_context(1, iocp_options{.accept_backlog = 4})
+    {
+    }
+};
+
+struct acceptor_test_iocp_backlog : acceptor_test_impl<iocp_backlog_context> {};
+TEST_SUITE(acceptor_test_iocp_backlog, "boost.corosio.acceptor.iocp_backlog");
+#endif
+
 } // namespace boost::corosio
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/buffers/make_buffer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "test_suite.hpp"
+
+//------------------------------------------------
+// Counting replacements for the global allocation
+// functions. These are program-wide, so the count
+// covers coroutine frames as well as anything the
+// library allocates on the caller's behalf.
+//------------------------------------------------
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+std::size_t
+allocation_count() noexcept
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+void*
+operator new(std::size_t n)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Steady-state operations must not allocate.
+// Each test warms up first so that one-time
+// costs, such as the first timer implementation
+// or a recycled scheduler op, are paid before
+// counting starts.
+//------------------------------------------------
+
+struct allocation_test
+{
+    static constexpr int warmup = 16;
+    static constexpr int rounds = 1000;
+
+    void
+    testSocketReadWrite()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+
+        std::size_t allocated = 0;
+        auto task = [](socket& a, socket& b, std::size_t& allocated)
+            -> capy::task<>
+        {
+            char buf[64] = {};
+            std::size_t before = 0;
+            for (int i = 0; i < warmup + rounds; ++i)
+            {
+                if (i == warmup)
+                    before = allocation_count();
+
+                auto [ec1, n1] = co_await a.write_some(
+                    capy::const_buffer("ping", 4));
+                if (ec1 || n1 != 4)
+                    break;
+                auto [ec2, n2] = co_await b.read_some(
+                    capy::make_buffer(buf));
+                if (ec2)
+                    break;
+                auto [ec3, n3] = co_await b.write_some(
+                    capy::const_buffer(buf, n2));
+                if (ec3)
+                    break;
+                auto [ec4, n4] = co_await a.read_some(
+                    capy::make_buffer(buf));
+                if (ec4 || n4 != n3)
+                    break;
+            }
+            allocated = allocation_count() - before;
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2, allocated));
+        ioc.run();
+
+        BOOST_TEST_EQ(allocated, 0u);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testTimerWait()
+    {
+        io_context ioc;
+        timer t(ioc);
+
+        std::size_t allocated = 0;
+        auto task = [](timer& t, std::size_t& allocated) -> capy::task<>
+        {
+            std::size_t before = 0;
+            for (int i = 0; i < warmup + rounds; ++i)
+            {
+                if (i == warmup)
+                    before = allocation_count();
+
+                t.expires_after(std::chrono::nanoseconds(0));
+                auto [ec] = co_await t.wait();
+                if (ec)
+                    break;
+            }
+            allocated = allocation_count() - before;
+        };
+        capy::run_async(ioc.get_executor())(task(t, allocated));
+        ioc.run();
+
+        BOOST_TEST_EQ(allocated, 0u);
+    }
+
+    void
+    run()
+    {
+        testSocketReadWrite();
+        testTimerWait();
+    }
+};
+
+TEST_SUITE(allocation_test, "boost.corosio.allocation");
+
+} // namespace boost::corosio
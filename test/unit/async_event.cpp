@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/async_event.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Async event tests
+// Focus: waking every waiter in order, waits on a set event,
+// and reset.
+//------------------------------------------------
+
+struct async_event_test
+{
+    void
+    testSetReset()
+    {
+        async_event e;
+        BOOST_TEST(!e.is_set());
+        e.set();
+        BOOST_TEST(e.is_set());
+        e.set();
+        BOOST_TEST(e.is_set());
+        e.reset();
+        BOOST_TEST(!e.is_set());
+
+        async_event s(true);
+        BOOST_TEST(s.is_set());
+    }
+
+    void
+    testWaiters()
+    {
+        io_context ioc;
+        async_event e;
+        std::vector<int> order;
+
+        auto waiter = [&](int id) -> capy::task<>
+        {
+            co_await e.wait();
+            order.push_back(id);
+        };
+        auto setter = [&]() -> capy::task<>
+        {
+            BOOST_TEST(order.empty());
+            e.set();
+
+            // Already set, so this does not suspend
+            co_await e.wait();
+            order.push_back(-1);
+        };
+        for (int i = 0; i < 4; ++i)
+            capy::run_async(ioc.get_executor())(waiter(i));
+        capy::run_async(ioc.get_executor())(setter());
+
+        ioc.run();
+        BOOST_TEST_EQ(order.size(), 5u);
+        if (order.size() == 5)
+        {
+            BOOST_TEST_EQ(order[0], -1);
+            for (int i = 0; i < 4; ++i)
+                BOOST_TEST_EQ(order[i + 1], i);
+        }
+    }
+
+    void
+    run()
+    {
+        testSetReset();
+        testWaiters();
+    }
+};
+
+TEST_SUITE(async_event_test, "boost.corosio.async_event");
+
+} // namespace boost::corosio
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/async_mutex.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Async mutex tests
+// Focus: exclusion across suspension points and threads, and
+// handing the mutex to waiters in the order they waited.
+//------------------------------------------------
+
+struct async_mutex_test
+{
+    void
+    testTryLock()
+    {
+        async_mutex m;
+        BOOST_TEST(m.try_lock());
+        BOOST_TEST(!m.try_lock());
+        m.unlock();
+        BOOST_TEST(m.try_lock());
+        m.unlock();
+    }
+
+    void
+    testFifo()
+    {
+        io_context ioc;
+        async_mutex m;
+        std::vector<int> order;
+
+        auto holder = [&]() -> capy::task<>
+        {
+            auto g = co_await m.scoped_lock();
+
+            // The others queue while the mutex is held across a wait
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(10));
+            (void)co_await t.wait();
+            order.push_back(0);
+        };
+        auto waiter = [&](int id) -> capy::task<>
+        {
+            co_await m.lock();
+            order.push_back(id);
+            m.unlock();
+        };
+        capy::run_async(ioc.get_executor())(holder());
+        for (int i = 1; i <= 4; ++i)
+            capy::run_async(ioc.get_executor())(waiter(i));
+
+        ioc.run();
+        BOOST_TEST_EQ(order.size(), 5u);
+        for (std::size_t i = 0; i < order.size(); ++i)
+            BOOST_TEST_EQ(order[i], static_cast<int>(i));
+        BOOST_TEST(m.try_lock());
+        m.unlock();
+    }
+
+    void
+    testThreads()
+    {
+        io_context ioc(4);
+        async_mutex m;
+        std::atomic<int> inside{0};
+        std::atomic<bool> overlapped{false};
+        long counter = 0;
+
+        auto worker = [&]() -> capy::task<>
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto g = co_await m.scoped_lock();
+                if (inside.fetch_add(1) != 0)
+                    overlapped = true;
+                ++counter;
+                inside.fetch_sub(1);
+            }
+        };
+        for (int i = 0; i < 8; ++i)
+            capy::run_async(ioc.get_executor())(worker());
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&] { ioc.run(); });
+        for (auto& t : threads)
+            t.join();
+
+        BOOST_TEST(!overlapped);
+        BOOST_TEST_EQ(counter, 16000);
+    }
+
+    void
+    run()
+    {
+        testTryLock();
+        testFifo();
+        testThreads();
+    }
+};
+
+TEST_SUITE(async_mutex_test, "boost.corosio.async_mutex");
+
+} // namespace boost::corosio
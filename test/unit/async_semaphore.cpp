@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/async_semaphore.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Async semaphore tests
+// Focus: the bound on concurrent holders, FIFO hand-off of
+// released units, and many threads at once.
+//------------------------------------------------
+
+struct async_semaphore_test
+{
+    void
+    testTryAcquire()
+    {
+        async_semaphore s(2);
+        BOOST_TEST_EQ(s.available(), 2u);
+        BOOST_TEST(s.try_acquire());
+        BOOST_TEST(s.try_acquire());
+        BOOST_TEST(!s.try_acquire());
+        s.release(2);
+        BOOST_TEST_EQ(s.available(), 2u);
+    }
+
+    void
+    testFifo()
+    {
+        io_context ioc;
+        async_semaphore s(1);
+        std::vector<int> order;
+
+        auto worker = [&](int id) -> capy::task<>
+        {
+            co_await s.acquire();
+            order.push_back(id);
+
+            // Hold the unit across a wait, so the others queue
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(2));
+            (void)co_await t.wait();
+            s.release();
+        };
+        for (int i = 0; i < 5; ++i)
+            capy::run_async(ioc.get_executor())(worker(i));
+
+        ioc.run();
+        BOOST_TEST_EQ(order.size(), 5u);
+        for (std::size_t i = 0; i < order.size(); ++i)
+            BOOST_TEST_EQ(order[i], static_cast<int>(i));
+        BOOST_TEST_EQ(s.available(), 1u);
+    }
+
+    void
+    testThreads()
+    {
+        io_context ioc(4);
+        async_semaphore s(3);
+        std::atomic<int> inside{0};
+        std::atomic<int> most{0};
+        std::atomic<int> done{0};
+
+        auto worker = [&]() -> capy::task<>
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                co_await s.acquire();
+                int n = inside.fetch_add(1) + 1;
+                int m = most.load();
+                while (n > m && !most.compare_exchange_weak(m, n))
+                {
+                }
+                inside.fetch_sub(1);
+                s.release();
+            }
+            ++done;
+        };
+        for (int i = 0; i < 8; ++i)
+            capy::run_async(ioc.get_executor())(worker());
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&] { ioc.run(); });
+        for (auto& t : threads)
+            t.join();
+
+        BOOST_TEST_EQ(done.load(), 8);
+        BOOST_TEST(most.load() <= 3);
+        BOOST_TEST_EQ(s.available(), 3u);
+    }
+
+    void
+    run()
+    {
+        testTryAcquire();
+        testFifo();
+        testThreads();
+    }
+};
+
+TEST_SUITE(async_semaphore_test, "boost.corosio.async_semaphore");
+
+} // namespace boost::corosio
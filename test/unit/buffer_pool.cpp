@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/buffer_pool.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/buffers.hpp>
+
+#include <utility>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct buffer_pool_test
+{
+    void
+    testSizeClasses()
+    {
+        io_context ioc;
+        auto& pool = get_buffer_pool(ioc);
+        BOOST_TEST_EQ(&pool, &get_buffer_pool(ioc));
+
+        BOOST_TEST_EQ(pool.acquire(0).size(), buffer_pool::min_size);
+        BOOST_TEST_EQ(pool.acquire(1).size(), buffer_pool::min_size);
+        BOOST_TEST_EQ(pool.acquire(512).size(), 512u);
+        BOOST_TEST_EQ(pool.acquire(513).size(), 1024u);
+        BOOST_TEST_EQ(pool.acquire(16384).size(), 16384u);
+        BOOST_TEST_EQ(
+            pool.acquire(buffer_pool::max_size).size(),
+            buffer_pool::max_size);
+
+        // Above the largest class the exact size is allocated
+        BOOST_TEST_EQ(pool.acquire(100000).size(), 100000u);
+    }
+
+    void
+    testReuse()
+    {
+        io_context ioc;
+        auto& pool = get_buffer_pool(ioc);
+
+        void* p;
+        {
+            auto lease = pool.acquire(4096);
+            p = lease.data();
+            BOOST_TEST_EQ(pool.stats().leased_bytes, 4096u);
+        }
+        BOOST_TEST_EQ(pool.stats().leased_bytes, 0u);
+
+        // The thread cache hands the same buffer back
+        auto lease = pool.acquire(3000);
+        BOOST_TEST_EQ(lease.data(), p);
+        BOOST_TEST(pool.stats().hits >= 1);
+    }
+
+    void
+    testLease()
+    {
+        io_context ioc;
+        auto lease = get_buffer_pool(ioc).acquire(1024);
+        BOOST_TEST(!lease.empty());
+
+        capy::mutable_buffer mb = lease;
+        BOOST_TEST_EQ(mb.data(), lease.data());
+        BOOST_TEST_EQ(mb.size(), 1024u);
+
+        lease.shrink(10);
+        BOOST_TEST_EQ(lease.size(), 10u);
+        lease.shrink(100);
+        BOOST_TEST_EQ(lease.size(), 10u);
+
+        auto moved = std::move(lease);
+        BOOST_TEST(lease.empty());
+        BOOST_TEST_EQ(moved.size(), 10u);
+        moved.reset();
+        BOOST_TEST(moved.empty());
+    }
+
+    void
+    testSharedList()
+    {
+        io_context ioc;
+        auto& pool = get_buffer_pool(ioc);
+
+        // The thread cache keeps two of the largest class; the rest
+        // go to the shared list while it has room
+        auto return_eight = [&]
+        {
+            pool.trim();
+            std::vector<buffer_lease> leases;
+            for (int i = 0; i < 8; ++i)
+                leases.push_back(pool.acquire(buffer_pool::max_size));
+        };
+
+        pool.set_max_cached_bytes(0);
+        BOOST_TEST_EQ(pool.max_cached_bytes(), 0u);
+        return_eight();
+        BOOST_TEST_EQ(pool.stats().cached_bytes, 0u);
+
+        pool.set_max_cached_bytes(1 << 20);
+        return_eight();
+        BOOST_TEST_EQ(pool.stats().cached_bytes, 6 * buffer_pool::max_size);
+
+        pool.trim();
+        BOOST_TEST_EQ(pool.stats().cached_bytes, 0u);
+    }
+
+    void
+    run()
+    {
+        testSizeClasses();
+        testReuse();
+        testLease();
+        testSharedList();
+    }
+};
+
+TEST_SUITE(buffer_pool_test, "boost.corosio.buffer_pool");
+
+} // namespace boost::corosio
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/buffered_stream.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct buffered_stream_test
+{
+    static std::string_view
+    view(capy::const_buffer b)
+    {
+        return {static_cast<char const*>(b.data()), b.size()};
+    }
+
+    void
+    testPrepareCommit()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        buffered_stream bs(s1, 4096);
+        std::size_t const cap = bs.capacity();
+        BOOST_TEST(cap >= 4096);
+        BOOST_TEST_EQ(bs.size(), 0u);
+
+        auto put = [&](std::string_view s)
+        {
+            auto mb = bs.prepare(s.size());
+            std::memcpy(mb.data(), s.data(), s.size());
+            bs.commit(s.size());
+        };
+
+        // Move the readable bytes up to the end of the ring, so
+        // that the next ones wrap
+        std::string const fill(cap - 3, 'x');
+        put(fill);
+        bs.consume(cap - 5);
+        BOOST_TEST_EQ(view(bs.data()), "xx");
+
+        put("abcdef");
+        BOOST_TEST_EQ(bs.size(), 8u);
+        BOOST_TEST_EQ(view(bs.data()), "xxabcdef");
+
+        bs.consume(4);
+        BOOST_TEST_EQ(view(bs.data()), "cdef");
+        bs.consume(100);
+        BOOST_TEST_EQ(bs.size(), 0u);
+
+        BOOST_TEST_THROWS(bs.prepare(cap + 1), std::length_error);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testFill()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        buffered_stream bs(s1, 4096);
+
+        std::string got;
+        auto task = [&]() -> capy::task<>
+        {
+            std::string_view msg = "one\ntwo\n";
+            auto [wec, wn] = co_await s2.write_some(
+                capy::const_buffer(msg.data(), msg.size()));
+            BOOST_TEST(!wec);
+
+            // Both lines arrive with one read
+            while (bs.size() < msg.size())
+            {
+                auto [ec, n] = co_await bs.fill();
+                if (ec)
+                    co_return;
+            }
+            got = view(bs.data());
+            bs.consume(4);
+
+            char buf[16];
+            auto [ec, n] = co_await bs.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(std::string_view(buf, n), "two\n");
+            BOOST_TEST_EQ(bs.size(), 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(got, "one\ntwo\n");
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    run()
+    {
+        testPrepareCommit();
+        testFill();
+    }
+};
+
+TEST_SUITE(buffered_stream_test, "boost.corosio.buffered_stream");
+
+} // namespace boost::corosio
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/channel.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Channel tests
+// Focus: order and backpressure between coroutines, closing,
+// the non-suspending calls, and many threads at once.
+//------------------------------------------------
+
+struct channel_test
+{
+    void
+    testTryOps()
+    {
+        channel<int> ch(3);
+        BOOST_TEST_EQ(ch.capacity(), 4u);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int v = i;
+            BOOST_TEST(ch.try_send(v));
+        }
+        BOOST_TEST_EQ(ch.size(), 4u);
+
+        // A full channel leaves the value alone
+        int v = 42;
+        BOOST_TEST(!ch.try_send(v));
+        BOOST_TEST_EQ(v, 42);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            auto r = ch.try_receive();
+            BOOST_TEST(r.has_value());
+            if (r)
+                BOOST_TEST_EQ(*r, i);
+        }
+        BOOST_TEST(!ch.try_receive());
+
+        ch.close();
+        BOOST_TEST(ch.is_closed());
+        BOOST_TEST(!ch.try_send(v));
+    }
+
+    void
+    testOrderAndBackpressure()
+    {
+        io_context ioc;
+        channel<std::string> ch(2);
+        int const n = 100;
+        std::vector<std::string> got;
+
+        auto producer = [&]() -> capy::task<>
+        {
+            // Suspends each time the two cells are full
+            for (int i = 0; i < n; ++i)
+            {
+                auto [ec] = co_await ch.send(std::to_string(i));
+                BOOST_TEST(!ec);
+                BOOST_TEST(ch.size() <= ch.capacity());
+            }
+            ch.close();
+        };
+        auto consumer = [&]() -> capy::task<>
+        {
+            for (;;)
+            {
+                auto [ec, s] = co_await ch.receive();
+                if (ec)
+                {
+                    BOOST_TEST(ec == capy::cond::eof);
+                    break;
+                }
+                got.push_back(std::move(s));
+            }
+        };
+        capy::run_async(ioc.get_executor())(consumer());
+        capy::run_async(ioc.get_executor())(producer());
+
+        ioc.run();
+        BOOST_TEST_EQ(got.size(), static_cast<std::size_t>(n));
+        for (std::size_t i = 0; i < got.size(); ++i)
+            BOOST_TEST_EQ(got[i], std::to_string(i));
+    }
+
+    void
+    testClose()
+    {
+        io_context ioc;
+        channel<std::unique_ptr<int>> ch(2);
+
+        system::error_code send_ec;
+        system::error_code recv_ec;
+        int received = 0;
+
+        auto sender = [&]() -> capy::task<>
+        {
+            (void)co_await ch.send(std::make_unique<int>(1));
+            (void)co_await ch.send(std::make_unique<int>(2));
+
+            // Full: suspends until closed
+            auto [ec] = co_await ch.send(std::make_unique<int>(3));
+            send_ec = ec;
+        };
+        auto closer = [&]() -> capy::task<>
+        {
+            ch.close();
+
+            // The values sent before the close are still received
+            for (;;)
+            {
+                auto [ec, p] = co_await ch.receive();
+                if (ec)
+                {
+                    recv_ec = ec;
+                    break;
+                }
+                received += *p;
+            }
+        };
+        capy::run_async(ioc.get_executor())(sender());
+        capy::run_async(ioc.get_executor())(closer());
+
+        ioc.run();
+        BOOST_TEST(send_ec == system::errc::broken_pipe);
+        BOOST_TEST(recv_ec == capy::cond::eof);
+        BOOST_TEST_EQ(received, 3);
+    }
+
+    void
+    testThreads()
+    {
+        io_context ioc(4);
+        channel<int> ch(16);
+        int const producers = 4;
+        int const per_producer = 10000;
+        int const consumers = 4;
+
+        std::atomic<long long> sum{0};
+        std::atomic<int> count{0};
+        std::atomic<int> producing{producers};
+
+        auto producer = [&](int base) -> capy::task<>
+        {
+            for (int i = 0; i < per_producer; ++i)
+            {
+                auto [ec] = co_await ch.send(base + i);
+                BOOST_TEST(!ec);
+            }
+            if (producing.fetch_sub(1) == 1)
+                ch.close();
+        };
+        auto consumer = [&]() -> capy::task<>
+        {
+            for (;;)
+            {
+                auto [ec, v] = co_await ch.receive();
+                if (ec)
+                    break;
+                sum += v;
+                ++count;
+            }
+        };
+        for (int i = 0; i < consumers; ++i)
+            capy::run_async(ioc.get_executor())(consumer());
+        for (int i = 0; i < producers; ++i)
+            capy::run_async(ioc.get_executor())(producer(i * per_producer));
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&] { ioc.run(); });
+        for (auto& t : threads)
+            t.join();
+
+        long long const total = producers * per_producer;
+        BOOST_TEST_EQ(count.load(), static_cast<int>(total));
+        BOOST_TEST_EQ(sum.load(), total * (total - 1) / 2);
+    }
+
+    void
+    run()
+    {
+        testTryOps();
+        testOrderAndBackpressure();
+        testClose();
+        testThreads();
+    }
+};
+
+TEST_SUITE(channel_test, "boost.corosio.channel");
+
+} // namespace boost::corosio
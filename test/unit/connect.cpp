@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/connect.hpp>
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <stop_token>
+#include <vector>
+
+#include <boost/corosio/detail/platform.hpp>
+#if BOOST_COROSIO_HAS_SELECT
+#include <boost/corosio/select_context.hpp>
+#endif
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+template<class Context>
+struct connect_test_impl
+{
+    // A loopback endpoint that nothing listens on
+    static endpoint
+    closed_endpoint(Context& ioc)
+    {
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint ep(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+        acc.close();
+        return ep;
+    }
+
+    static resolver_results
+    make_results(std::vector<endpoint> const& eps)
+    {
+        std::vector<resolver_entry> entries;
+        for (auto const& ep : eps)
+            entries.emplace_back(ep, "localhost", "");
+        return resolver_results(std::move(entries));
+    }
+
+    void
+    testConnectSkipsRefused()
+    {
+        Context ioc;
+        endpoint bad = closed_endpoint(ioc);
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint good(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        socket s(ioc);
+        system::error_code result_ec;
+        endpoint result_ep;
+        bool accepted = false;
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [ec, ep] = co_await corosio::connect(
+                s, make_results({bad, good}));
+            result_ec = ec;
+            result_ep = ep;
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            socket peer(ioc);
+            auto [ec] = co_await acc.accept(peer);
+            accepted = !ec;
+        };
+        capy::run_async(ioc.get_executor())(server_task());
+        capy::run_async(ioc.get_executor())(client_task());
+
+        ioc.run();
+        BOOST_TEST(!result_ec);
+        BOOST_TEST(result_ep == good);
+        BOOST_TEST(s.is_open());
+        BOOST_TEST(s.remote_endpoint() == good);
+        BOOST_TEST(accepted);
+    }
+
+    void
+    testAllRefused()
+    {
+        Context ioc;
+        endpoint bad1 = closed_endpoint(ioc);
+        endpoint bad2 = closed_endpoint(ioc);
+
+        socket s(ioc);
+        system::error_code result_ec;
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec, ep] = co_await corosio::connect(
+                s, make_results({bad1, bad2}));
+            result_ec = ec;
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST(result_ec == system::errc::connection_refused);
+        BOOST_TEST(!s.is_open());
+    }
+
+    void
+    testEmptyResults()
+    {
+        Context ioc;
+        socket s(ioc);
+        system::error_code result_ec;
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec, ep] = co_await corosio::connect(s, resolver_results());
+            result_ec = ec;
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST(result_ec == system::errc::invalid_argument);
+    }
+
+    void
+    testStopped()
+    {
+        Context ioc;
+        acceptor acc(ioc);
+        acc.listen(endpoint(0));
+        endpoint good(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        socket s(ioc);
+        system::error_code result_ec;
+        std::stop_source stop;
+        stop.request_stop();
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec, ep] = co_await corosio::connect(s, make_results({good}));
+            result_ec = ec;
+        };
+        capy::run_async(ioc.get_executor(), stop.get_token())(task());
+
+        ioc.run();
+        BOOST_TEST(result_ec == capy::cond::canceled);
+        BOOST_TEST(!s.is_open());
+    }
+
+    void
+    run()
+    {
+        testConnectSkipsRefused();
+        testAllRefused();
+        testEmptyResults();
+        testStopped();
+    }
+};
+
+struct connect_test : connect_test_impl<io_context> {};
+TEST_SUITE(connect_test, "boost.corosio.connect");
+
+#if BOOST_COROSIO_HAS_SELECT
+struct connect_test_select : connect_test_impl<select_context> {};
+TEST_SUITE(connect_test_select, "boost.corosio.connect.select");
+#endif
+
+} // namespace boost::corosio
@@ -0,0 +1,280 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/connection_pool.hpp>
+
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Connection pool tests
+// Focus: reuse of checked in connections, the per-host limit,
+// health checks of idle connections and closing the pool.
+//------------------------------------------------
+
+struct connection_pool_test
+{
+    static endpoint
+    listen(acceptor& acc)
+    {
+        acc.listen(endpoint(0));
+        return endpoint(
+            urls::ipv4_address::loopback(), acc.local_endpoint().port());
+    }
+
+    void
+    testReuse()
+    {
+        io_context ioc;
+        acceptor acc(ioc);
+        endpoint ep = listen(acc);
+        connection_pool pool(ioc);
+        socket peer(ioc);
+
+        auto server = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+        };
+        auto client = [&]() -> capy::task<>
+        {
+            auto [ec1, c1] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec1);
+            if (ec1)
+                co_return;
+            std::uint16_t port = c1->local_endpoint().port();
+            BOOST_TEST_EQ(pool.size(), 1u);
+
+            pool.checkin(std::move(c1));
+            BOOST_TEST(!c1);
+            BOOST_TEST_EQ(pool.idle_size(), 1u);
+
+            // The same connection comes back
+            auto [ec2, c2] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(c2->local_endpoint().port(), port);
+            BOOST_TEST_EQ(pool.idle_size(), 0u);
+            BOOST_TEST_EQ(pool.size(), 1u);
+
+            // And it still works
+            auto [wec, wn] = co_await c2->write_some(
+                capy::const_buffer("x", 1));
+            BOOST_TEST(!wec);
+            char c;
+            auto [rec, rn] = co_await peer.read_some(
+                capy::mutable_buffer(&c, 1));
+            BOOST_TEST(!rec);
+            BOOST_TEST_EQ(rn, 1u);
+
+            // Dropping it closes it
+            c2 = {};
+            BOOST_TEST_EQ(pool.size(), 0u);
+            pool.close();
+        };
+        capy::run_async(ioc.get_executor())(server());
+        capy::run_async(ioc.get_executor())(client());
+
+        ioc.run();
+        peer.close();
+    }
+
+    void
+    testMaxPerHost()
+    {
+        io_context ioc;
+        acceptor acc(ioc);
+        endpoint ep = listen(acc);
+        connection_pool::options opts;
+        opts.max_per_host = 1;
+        connection_pool pool(ioc, opts);
+        socket peer(ioc);
+
+        bool second = false;
+        std::uint16_t first_port = 0;
+        std::uint16_t second_port = 0;
+
+        auto server = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+        };
+        auto waiter = [&]() -> capy::task<>
+        {
+            auto [ec, c] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec);
+            second = true;
+            if (!ec)
+                second_port = c->local_endpoint().port();
+            pool.close();
+        };
+        auto client = [&]() -> capy::task<>
+        {
+            auto [ec, c] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+            first_port = c->local_endpoint().port();
+
+            // The second checkout waits for this one
+            capy::run_async(ioc.get_executor())(waiter());
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(20));
+            (void)co_await t.wait();
+            BOOST_TEST(!second);
+
+            pool.checkin(std::move(c));
+        };
+        capy::run_async(ioc.get_executor())(server());
+        capy::run_async(ioc.get_executor())(client());
+
+        ioc.run();
+        BOOST_TEST(second);
+        BOOST_TEST_EQ(second_port, first_port);
+        peer.close();
+    }
+
+    void
+    testPeerClosed()
+    {
+        io_context ioc;
+        acceptor acc(ioc);
+        endpoint ep = listen(acc);
+        connection_pool pool(ioc);
+        socket peer(ioc);
+
+        auto server = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+        };
+        auto client = [&]() -> capy::task<>
+        {
+            auto [ec, c] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            // Backends without readiness waits keep idle
+            // connections unchecked
+            auto deadline = std::chrono::steady_clock::now();
+            auto [wec] = co_await c->wait(
+                socket::wait_type::read, deadline);
+            bool checked = wec != system::errc::operation_not_supported;
+
+            pool.checkin(std::move(c));
+            BOOST_TEST_EQ(pool.idle_size(), 1u);
+
+            peer.close();
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+
+            if (checked)
+            {
+                BOOST_TEST_EQ(pool.idle_size(), 0u);
+                BOOST_TEST_EQ(pool.size(), 0u);
+            }
+            pool.close();
+        };
+        capy::run_async(ioc.get_executor())(server());
+        capy::run_async(ioc.get_executor())(client());
+
+        ioc.run();
+    }
+
+    void
+    testIdleTimeout()
+    {
+        io_context ioc;
+        acceptor acc(ioc);
+        endpoint ep = listen(acc);
+        connection_pool::options opts;
+        opts.idle_timeout = std::chrono::milliseconds(20);
+        connection_pool pool(ioc, opts);
+        socket peer(ioc);
+
+        auto server = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+        };
+        auto client = [&]() -> capy::task<>
+        {
+            auto [ec, c] = co_await pool.checkout(ep);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+            pool.checkin(std::move(c));
+            BOOST_TEST_EQ(pool.idle_size(), 1u);
+        };
+        capy::run_async(ioc.get_executor())(server());
+        capy::run_async(ioc.get_executor())(client());
+
+        // Returns once the reaper has closed the idle connection
+        ioc.run();
+        BOOST_TEST_EQ(pool.idle_size(), 0u);
+        BOOST_TEST_EQ(pool.size(), 0u);
+        peer.close();
+    }
+
+    void
+    testErrors()
+    {
+        io_context ioc;
+        endpoint ep;
+        {
+            acceptor acc(ioc);
+            ep = listen(acc);
+        }
+        connection_pool pool(ioc);
+
+        auto task = [&]() -> capy::task<>
+        {
+            // Nothing listens there any more
+            auto [ec1, c1] = co_await pool.checkout(ep);
+            BOOST_TEST(ec1 == system::errc::connection_refused);
+            BOOST_TEST(!c1);
+            BOOST_TEST_EQ(pool.size(), 0u);
+
+            pool.close();
+            auto [ec2, c2] = co_await pool.checkout(ep);
+            BOOST_TEST(ec2 == system::errc::operation_canceled);
+            BOOST_TEST(!c2);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+    }
+
+    void
+    run()
+    {
+        testReuse();
+        testMaxPerHost();
+        testPeerClosed();
+        testIdleTimeout();
+        testErrors();
+    }
+};
+
+TEST_SUITE(connection_pool_test, "boost.corosio.connection_pool");
+
+} // namespace boost::corosio
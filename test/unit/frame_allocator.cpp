@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/frame_allocator.hpp>
+
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+namespace {
+
+// A coroutine whose frame comes from the frame allocator
+struct recycled_coro
+{
+    struct promise_type
+    {
+        static void* operator new(std::size_t n)
+        {
+            return frame_allocator::allocate(n);
+        }
+
+        static void operator delete(void* p, std::size_t n) noexcept
+        {
+            frame_allocator::deallocate(p, n);
+        }
+
+        recycled_coro get_return_object() noexcept
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+recycled_coro
+make_coro(int& counter)
+{
+    ++counter;
+    co_return;
+}
+
+} // namespace
+
+struct frame_allocator_test
+{
+    void
+    testReuse()
+    {
+        frame_allocator::trim();
+
+        void* p = frame_allocator::allocate(200);
+        std::memset(p, 0, 200);
+        frame_allocator::deallocate(p, 200);
+
+        // Any size of the same class gets the same block back
+        void* q = frame_allocator::allocate(129);
+        BOOST_TEST_EQ(p, q);
+        frame_allocator::deallocate(q, 129);
+
+        // Another class does not
+        void* r = frame_allocator::allocate(64);
+        BOOST_TEST_NE(p, r);
+        frame_allocator::deallocate(r, 64);
+
+        frame_allocator::trim();
+    }
+
+    void
+    testLarge()
+    {
+        // Above the largest class frames go to the global allocator
+        auto const n = frame_allocator::max_size + 1;
+        void* p = frame_allocator::allocate(n);
+        std::memset(p, 0, n);
+        frame_allocator::deallocate(p, n);
+
+        frame_allocator::deallocate(nullptr, 64);
+        BOOST_TEST_PASS();
+    }
+
+    void
+    testCoroutineFrames()
+    {
+        frame_allocator::trim();
+
+        int counter = 0;
+        void* first = nullptr;
+        for (int i = 0; i < 4; ++i)
+        {
+            auto c = make_coro(counter);
+            c.h.resume();
+            BOOST_TEST(c.h.done());
+            if (i == 0)
+                first = c.h.address();
+            else
+                BOOST_TEST_EQ(c.h.address(), first);
+            c.h.destroy();
+        }
+        BOOST_TEST_EQ(counter, 4);
+
+        frame_allocator::trim();
+    }
+
+    void
+    testOtherThread()
+    {
+        // A frame freed elsewhere joins the freeing thread's list
+        void* p = frame_allocator::allocate(1000);
+        void* q = nullptr;
+        std::thread t([&]
+        {
+            frame_allocator::deallocate(p, 1000);
+            q = frame_allocator::allocate(1000);
+            frame_allocator::deallocate(q, 1000);
+        });
+        t.join();
+        BOOST_TEST_EQ(p, q);
+    }
+
+    void
+    testResource()
+    {
+        auto* mr = frame_allocator::resource();
+        BOOST_TEST_EQ(mr, frame_allocator::resource());
+        BOOST_TEST(mr->is_equal(*mr));
+        BOOST_TEST(!mr->is_equal(*std::pmr::new_delete_resource()));
+
+        std::pmr::vector<int> v(mr);
+        for (int i = 0; i < 1000; ++i)
+            v.push_back(i);
+        BOOST_TEST_EQ(v[999], 999);
+
+        // Over-aligned requests bypass the lists
+        void* p = mr->allocate(256, 64);
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+        mr->deallocate(p, 256, 64);
+    }
+
+    void
+    run()
+    {
+        testReuse();
+        testLarge();
+        testCoroutineFrames();
+        testOtherThread();
+        testResource();
+    }
+};
+
+TEST_SUITE(frame_allocator_test, "boost.corosio.frame_allocator");
+
+} // namespace boost::corosio
@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/framed_stream.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/ex/run_async.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct framed_stream_test
+{
+    void
+    testPrefix()
+    {
+        unsigned char b[8];
+
+        using be4 = frame_prefix<4, std::endian::big>;
+        be4::encode(0x01020304, b);
+        BOOST_TEST_EQ(b[0], 1);
+        BOOST_TEST_EQ(b[3], 4);
+        BOOST_TEST_EQ(be4::decode(b), 0x01020304u);
+
+        using le2 = frame_prefix<2, std::endian::little>;
+        le2::encode(0x0102, b);
+        BOOST_TEST_EQ(b[0], 2);
+        BOOST_TEST_EQ(b[1], 1);
+        BOOST_TEST_EQ(le2::decode(b), 0x0102u);
+
+        using be8 = frame_prefix<8>;
+        be8::encode(0x0102030405060708ull, b);
+        BOOST_TEST_EQ(b[0], 1);
+        BOOST_TEST_EQ(be8::decode(b), 0x0102030405060708ull);
+
+        static_assert(frame_prefix<1>::max_length == 255);
+        static_assert(frame_prefix<2>::max_length == 65535);
+        static_assert(frame_prefix<8>::max_length == ~std::uint64_t(0));
+    }
+
+    void
+    testFrames()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+
+        std::vector<std::string> sent;
+        for (int i = 0; i < 200; ++i)
+            sent.push_back(std::string(i * 37 % 1500, char('a' + i % 26)));
+        sent.push_back(std::string());
+
+        framed_stream<> out(s1);
+        framed_stream<> in(s2, 4096);
+
+        auto writer = [](framed_stream<>& fs, socket& s,
+            std::vector<std::string>& frames) -> capy::task<>
+        {
+            // Batches of ten frames per flush
+            std::size_t expected = 0;
+            std::size_t written = 0;
+            for (std::size_t i = 0; i < frames.size(); ++i)
+            {
+                fs.queue(capy::const_buffer(
+                    frames[i].data(), frames[i].size()));
+                expected += 4 + frames[i].size();
+                if (fs.queued() == 10 || i + 1 == frames.size())
+                {
+                    auto [ec, n] = co_await fs.flush();
+                    BOOST_TEST(!ec);
+                    written += n;
+                    BOOST_TEST_EQ(fs.queued(), 0u);
+                }
+            }
+            BOOST_TEST_EQ(written, expected);
+            s.shutdown(socket::shutdown_send);
+        };
+        auto reader = [](framed_stream<>& fs,
+            std::vector<std::string>& frames) -> capy::task<>
+        {
+            for (auto const& f : frames)
+            {
+                auto [ec, b] = co_await fs.read_frame();
+                BOOST_TEST(!ec);
+                if (ec)
+                    co_return;
+                BOOST_TEST_EQ(b.size(), f.size());
+                BOOST_TEST(std::memcmp(b.data(), f.data(), f.size()) == 0);
+
+                // The payload is a view into the ring, just past its prefix
+                auto const* p = static_cast<unsigned char const*>(b.data());
+                BOOST_TEST_EQ(frame_prefix<>::decode(p - 4), f.size());
+            }
+
+            // The writer shut down after the last frame
+            auto [ec, b] = co_await fs.read_frame();
+            BOOST_TEST(ec);
+        };
+        capy::run_async(ioc.get_executor())(writer(out, s1, sent));
+        capy::run_async(ioc.get_executor())(reader(in, sent));
+        ioc.run();
+    }
+
+    void
+    testTooLong()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+
+        framed_stream<frame_prefix<2>> out(s1);
+        framed_stream<frame_prefix<2>> in(s2, 4096, 100);
+
+        std::string big(200, 'z');
+        BOOST_TEST_THROWS(
+            out.queue(capy::const_buffer(big.data(), 70000)),
+            std::length_error);
+        BOOST_TEST_EQ(out.queued(), 0u);
+
+        auto writer = [](framed_stream<frame_prefix<2>>& fs,
+            std::string& s) -> capy::task<>
+        {
+            auto [ec, n] = co_await fs.write_frame(
+                capy::const_buffer(s.data(), s.size()));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, s.size() + 2);
+        };
+        auto reader = [](framed_stream<frame_prefix<2>>& fs) -> capy::task<>
+        {
+            auto [ec, b] = co_await fs.read_frame();
+            BOOST_TEST(ec == make_error_code(system::errc::message_size));
+        };
+        capy::run_async(ioc.get_executor())(writer(out, big));
+        capy::run_async(ioc.get_executor())(reader(in));
+        ioc.run();
+    }
+
+    void
+    testQueueDuringFlush()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+
+        // Larger than the socket buffer, so the flush suspends
+        std::string big(4 << 20, 'b');
+        std::vector<std::string> late;
+        for (int i = 0; i < 100; ++i)
+            late.push_back(std::string(i % 7, char('a' + i % 26)));
+
+        framed_stream<> out(s1);
+        framed_stream<> in(s2, 8 << 20);
+
+        auto writer = [](framed_stream<>& fs, socket& s,
+            std::string& big, std::size_t late) -> capy::task<>
+        {
+            fs.queue(capy::const_buffer(big.data(), big.size()));
+            auto [ec, n] = co_await fs.flush();
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, big.size() + 4);
+
+            // Frames queued during the flush wait for the next one
+            BOOST_TEST_EQ(fs.queued(), late);
+            auto [ec2, n2] = co_await fs.flush();
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(fs.queued(), 0u);
+            s.shutdown(socket::shutdown_send);
+        };
+        auto queuer = [](framed_stream<>& fs,
+            std::vector<std::string>& frames) -> capy::task<>
+        {
+            for (auto const& f : frames)
+                fs.queue(capy::const_buffer(f.data(), f.size()));
+            co_return;
+        };
+        auto reader = [](framed_stream<>& fs, std::size_t big,
+            std::vector<std::string>& frames) -> capy::task<>
+        {
+            auto [ec, b] = co_await fs.read_frame();
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(b.size(), big);
+            for (auto const& f : frames)
+            {
+                auto [ec2, b2] = co_await fs.read_frame();
+                BOOST_TEST(!ec2);
+                if (ec2)
+                    co_return;
+                BOOST_TEST_EQ(b2.size(), f.size());
+                BOOST_TEST(std::memcmp(b2.data(), f.data(), f.size()) == 0);
+            }
+            auto [ec3, b3] = co_await fs.read_frame();
+            BOOST_TEST(ec3);
+        };
+        capy::run_async(ioc.get_executor())(
+            writer(out, s1, big, late.size()));
+        capy::run_async(ioc.get_executor())(queuer(out, late));
+        capy::run_async(ioc.get_executor())(reader(in, big.size(), late));
+        ioc.run();
+    }
+
+    void
+    testFlushError()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        s2.close();
+
+        framed_stream<> out(s1);
+        std::string payload("frame");
+        for (int i = 0; i < 3; ++i)
+            out.queue(capy::const_buffer(payload.data(), payload.size()));
+
+        // The frames not started stay queued
+        auto writer = [](framed_stream<>& fs) -> capy::task<>
+        {
+            auto [ec, n] = co_await fs.flush();
+            BOOST_TEST(ec);
+            BOOST_TEST_EQ(n, 0u);
+            BOOST_TEST_EQ(fs.queued(), 3u);
+        };
+        capy::run_async(ioc.get_executor())(writer(out));
+        ioc.run();
+    }
+
+    void
+    run()
+    {
+        testPrefix();
+        testFrames();
+        testTooLong();
+        testQueueDuringFlush();
+        testFlushError();
+    }
+};
+
+TEST_SUITE(framed_stream_test, "boost.corosio.framed_stream");
+
+} // namespace boost::corosio
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/huge_pages.hpp>
+
+#include <boost/corosio/buffer_pool.hpp>
+#include <boost/corosio/frame_allocator.hpp>
+#include <boost/corosio/io_context.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct huge_pages_test
+{
+    void
+    testReserve()
+    {
+        // Whatever the system offers, a second call reports the same
+        auto backing = reserve_huge_pages(std::size_t(4) << 20);
+        BOOST_TEST(reserve_huge_pages(std::size_t(64) << 20) == backing);
+    }
+
+    void
+    testPools()
+    {
+        reserve_huge_pages(std::size_t(4) << 20);
+
+        // More than the arena holds, so that pools fall back to the
+        // global allocator once it is used up
+        io_context ioc;
+        auto& pool = get_buffer_pool(ioc);
+        std::vector<buffer_lease> leases;
+        for (int i = 0; i < 128; ++i)
+        {
+            leases.push_back(pool.acquire(65536));
+            std::memset(leases.back().data(), i, leases.back().size());
+        }
+        for (int i = 0; i < 128; ++i)
+            BOOST_TEST_EQ(
+                static_cast<unsigned char const*>(leases[i].data())[100],
+                static_cast<unsigned char>(i));
+        leases.clear();
+        pool.trim();
+
+        // Frames freed past the thread cache go back to the arena
+        std::vector<void*> frames;
+        for (int i = 0; i < 1000; ++i)
+        {
+            frames.push_back(frame_allocator::allocate(1000));
+            std::memset(frames.back(), 0, 1000);
+        }
+        for (auto* p : frames)
+            frame_allocator::deallocate(p, 1000);
+        frame_allocator::trim();
+
+        void* p = frame_allocator::allocate(1000);
+        BOOST_TEST(p != nullptr);
+        frame_allocator::deallocate(p, 1000);
+    }
+
+    void
+    run()
+    {
+        testReserve();
+        testPools();
+    }
+};
+
+TEST_SUITE(huge_pages_test, "boost.corosio.huge_pages");
+
+} // namespace boost::corosio
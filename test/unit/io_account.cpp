@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/io_account.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct io_account_test
+{
+    void
+    testUsage()
+    {
+        io_account a;
+        a.add_op(true, 10);
+        a.add_op(false, 4);
+        a.add_op(false, 0);
+        a.add_cpu_time(std::chrono::nanoseconds(500));
+        auto const before = a.usage();
+        BOOST_TEST_EQ(before.ops, 3u);
+        BOOST_TEST_EQ(before.bytes_read, 10u);
+        BOOST_TEST_EQ(before.bytes_written, 4u);
+        BOOST_TEST(before.cpu_time == std::chrono::nanoseconds(500));
+
+        a.add_op(true, 5);
+        auto const d = a.usage() - before;
+        BOOST_TEST_EQ(d.ops, 1u);
+        BOOST_TEST_EQ(d.bytes_read, 5u);
+        BOOST_TEST_EQ(d.bytes_written, 0u);
+        BOOST_TEST(d.cpu_time == std::chrono::nanoseconds(0));
+    }
+
+    void
+    testSocket()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+        io_account a;
+        if (!s2.set_account(&a))
+            return;
+        BOOST_TEST(!socket(ioc).set_account(&a));
+
+        // The reader parks, so its coroutine is resumed and timed
+        auto reader = [](socket& s) -> capy::task<>
+        {
+            char buf[8];
+            auto [ec, n] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 3u);
+            std::this_thread::sleep_for(2ms);
+            (void) co_await s.write_some(capy::const_buffer("ok", 2));
+        };
+        auto writer = [](socket& s) -> capy::task<>
+        {
+            (void) co_await s.write_some(capy::const_buffer("abc", 3));
+            char buf[8];
+            (void) co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+        };
+        capy::run_async(ioc.get_executor())(reader(s2));
+        capy::run_async(ioc.get_executor())(writer(s1));
+        ioc.run();
+
+        auto const u = a.usage();
+        BOOST_TEST_EQ(u.ops, 2u);
+        BOOST_TEST_EQ(u.bytes_read, 3u);
+        BOOST_TEST_EQ(u.bytes_written, 2u);
+        BOOST_TEST(u.cpu_time >= 2ms);
+
+        // Closing detaches the account
+        s2.close();
+        BOOST_TEST_EQ(a.usage().ops, 2u);
+    }
+
+    void
+    run()
+    {
+        testUsage();
+        testSocket();
+    }
+};
+
+TEST_SUITE(io_account_test, "boost.corosio.io_account");
+
+} // namespace boost::corosio
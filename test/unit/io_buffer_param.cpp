@@ -147,6 +147,20 @@ struct io_buffer_param_test
         BOOST_TEST_EQ(dest[1].size(), 3);
     }
 
+    void
+    testSingleBufferLimit()
+    {
+        // A single buffer is held by value; n still bounds the copy
+        char data[] = "Hello";
+        io_buffer_param ref(capy::mutable_buffer(data, 5));
+
+        capy::mutable_buffer dest[1];
+        BOOST_TEST_EQ(ref.copy_to(dest, 0), 0);
+        BOOST_TEST_EQ(ref.copy_to(dest, 1), 1);
+        BOOST_TEST_EQ(dest[0].data(), data);
+        BOOST_TEST_EQ(dest[0].size(), 5);
+    }
+
     void
     testEmptySequence()
     {
@@ -323,6 +337,7 @@ struct io_buffer_param_test
         testArray();
         testCArray();
         testLimitedCopy();
+        testSingleBufferLimit();
         testEmptySequence();
         testZeroByteConstBuffer();
         testZeroByteMultiple();
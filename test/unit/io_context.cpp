@@ -10,8 +10,27 @@
 // Test that header file is self-contained.
 #include <boost/corosio/io_context.hpp>
 
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/resolver.hpp>
+#include <boost/corosio/signal_set.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/timer.hpp>
+#if BOOST_COROSIO_HAS_SELECT
+#include <boost/corosio/select_context.hpp>
+#endif
+#if BOOST_COROSIO_HAS_EPOLL
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+#include <boost/capy/buffers.hpp>
 #include <boost/capy/concept/executor.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <sstream>
@@ -132,6 +151,87 @@ inline check_coro make_check_coro(bool& result, io_context::executor_type& ex)
     return c;
 }
 
+// Coroutine that posts more counters from inside its handler
+struct fanout_coro
+{
+    struct promise_type
+    {
+        std::atomic<int>* counter_ = nullptr;
+        io_context::executor_type* ex_ = nullptr;
+        int fanout_ = 0;
+
+        fanout_coro get_return_object()
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void()
+        {
+            counter_->fetch_add(1, std::memory_order_relaxed);
+            for (int i = 0; i < fanout_; ++i)
+                ex_->post(make_atomic_coro(*counter_));
+        }
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+
+    operator capy::coro() const { return h; }
+};
+
+inline fanout_coro make_fanout_coro(
+    std::atomic<int>& counter,
+    io_context::executor_type& ex,
+    int fanout)
+{
+    auto c = []() -> fanout_coro { co_return; }();
+    c.h.promise().counter_ = &counter;
+    c.h.promise().ex_ = &ex;
+    c.h.promise().fanout_ = fanout;
+    return c;
+}
+
+// Coroutine that records its id when resumed
+struct order_coro
+{
+    struct promise_type
+    {
+        std::vector<int>* order_ = nullptr;
+        int id_ = 0;
+
+        order_coro get_return_object()
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void()
+        {
+            order_->push_back(id_);
+        }
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+
+    operator capy::coro() const { return h; }
+};
+
+inline order_coro make_order_coro(std::vector<int>& order, int id)
+{
+    auto c = []() -> order_coro { co_return; }();
+    c.h.promise().order_ = &order;
+    c.h.promise().id_ = id;
+    return c;
+}
+
 struct io_context_test
 {
     void
@@ -456,6 +556,855 @@ struct io_context_test
         }
     }
 
+#if BOOST_COROSIO_HAS_EPOLL
+    void
+    testEpollBusyPoll()
+    {
+        // Default is to block immediately
+        {
+            epoll_context ctx(1);
+            BOOST_TEST(ctx.stats().mode == busy_poll_mode::off);
+        }
+
+        // Spin count
+        {
+            epoll_options opts;
+            opts.busy_poll_spins = 8;
+            epoll_context ctx(1, opts);
+            BOOST_TEST(ctx.stats().mode == busy_poll_mode::spin);
+
+            int counter = 0;
+            ctx.get_executor().post(make_coro(counter));
+            ctx.get_executor().post(make_coro(counter));
+            BOOST_TEST(ctx.run() == 2);
+            BOOST_TEST(counter == 2);
+        }
+
+        // Deadline takes precedence over the spin count
+        {
+            epoll_options opts;
+            opts.busy_poll_spins = 8;
+            opts.busy_poll_duration = std::chrono::microseconds(50);
+            opts.socket_busy_poll = 50;
+            epoll_context ctx(2, opts);
+            BOOST_TEST(ctx.stats().mode == busy_poll_mode::deadline);
+
+            int counter = 0;
+            ctx.get_executor().post(make_coro(counter));
+            BOOST_TEST(ctx.run() == 1);
+            BOOST_TEST(counter == 1);
+        }
+    }
+
+    void
+    testEpollHandlerBudget()
+    {
+        epoll_options opts;
+        opts.max_events = 1;
+        opts.handler_budget = 2;
+        epoll_context ctx(1, opts);
+
+        // The budget forces reactor polls between queued handlers
+        int counter = 0;
+        for (int i = 0; i < 6; ++i)
+            ctx.get_executor().post(make_coro(counter));
+        BOOST_TEST(ctx.run() == 6);
+        BOOST_TEST(counter == 6);
+        BOOST_TEST(ctx.stats().reactor_polls >= 2);
+    }
+
+    void
+    testEpollInlineCompletions()
+    {
+        epoll_options opts;
+        opts.inline_completions = 3;
+        epoll_context ctx(1, opts);
+
+        // Timers sharing an expiry complete in one poll, more of them
+        // than one batch runs
+        constexpr int n = 8;
+        std::vector<timer> timers;
+        timers.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            timers.emplace_back(ctx);
+            timers.back().set_slack(std::chrono::milliseconds(50));
+            timers.back().expires_after(std::chrono::milliseconds(1));
+        }
+
+        int done = 0;
+        auto waiter = [](timer& t, int& done_out) -> capy::task<>
+        {
+            auto [ec] = co_await t.wait();
+            if (!ec)
+                ++done_out;
+        };
+        for (auto& t : timers)
+            capy::run_async(ctx.get_executor())(waiter(t, done));
+
+        BOOST_TEST(ctx.run() >= std::size_t(n));
+        BOOST_TEST(done == n);
+
+        // Stopping inside a batch leaves the rest queued
+        done = 0;
+        ctx.restart();
+        for (auto& t : timers)
+        {
+            t.expires_after(std::chrono::milliseconds(1));
+            capy::run_async(ctx.get_executor())(
+                [](timer& t, int& done_out, epoll_context& c)
+                    -> capy::task<>
+                {
+                    auto [ec] = co_await t.wait();
+                    if (!ec && ++done_out == 1)
+                        c.stop();
+                }(t, done, ctx));
+        }
+        ctx.run();
+        BOOST_TEST(done == 1);
+        ctx.restart();
+        ctx.run();
+        BOOST_TEST(done == n);
+    }
+
+    void
+    testEpollWakeupCoalescing()
+    {
+        epoll_context ctx(1);
+
+        // Stopping from another thread interrupts the reactor; the
+        // repeated stop/restart cycles must leave no stuck wakeup
+        for (int i = 0; i < 3; ++i)
+        {
+            ctx.get_executor().on_work_started();
+            std::thread t([&ctx] { ctx.stop(); });
+            ctx.run();
+            t.join();
+            ctx.get_executor().on_work_finished();
+            ctx.restart();
+        }
+
+        auto st = ctx.stats();
+        BOOST_TEST(st.wakeup_writes >= 1);
+        BOOST_TEST(st.wakeup_writes + st.wakeups_suppressed >= 3);
+    }
+
+    // Threads outside run() post one handler at a time, each waiting
+    // for the last to run, so the reactor goes back to sleep between
+    // posts and every wakeup races with the previous one's drain. A
+    // lost wakeup leaves the reactor blocked for good; the watchdog,
+    // driven by the timerfd rather than the eventfd, then ends run().
+    void
+    testEpollWakeupStress()
+    {
+        using namespace std::chrono_literals;
+
+        auto stress = [](unsigned threads, epoll_options const& opts)
+        {
+            constexpr int producers = 4;
+            constexpr int posts = 2000;
+
+            epoll_context ctx(threads, opts);
+            auto ex = ctx.get_executor();
+
+            timer watchdog(ctx);
+            watchdog.expires_after(20s);
+            std::atomic<bool> fired{false};
+            capy::run_async(ex)(
+                [](timer& t, epoll_context& ctx, std::atomic<bool>& out)
+                    -> capy::task<>
+                {
+                    auto [ec] = co_await t.wait();
+                    if (!ec)
+                    {
+                        out = true;
+                        ctx.stop();
+                    }
+                }(watchdog, ctx, fired));
+
+            std::vector<std::thread> runners;
+            for (unsigned i = 0; i < threads; ++i)
+                runners.emplace_back([&ctx] { ctx.run(); });
+
+            std::vector<std::atomic<int>> done(producers);
+            std::vector<std::thread> posters;
+            for (int p = 0; p < producers; ++p)
+            {
+                posters.emplace_back([&, p]
+                {
+                    for (int i = 0; i < posts && !fired; ++i)
+                    {
+                        ex.post(make_atomic_coro(done[p]));
+                        while (done[p].load() == i && !fired)
+                            std::this_thread::yield();
+                    }
+                });
+            }
+            for (auto& t : posters)
+                t.join();
+
+            // Ends run() by taking away the watchdog's work
+            capy::run_async(ex)(
+                [](timer& t) -> capy::task<>
+                {
+                    t.cancel();
+                    co_return;
+                }(watchdog));
+            for (auto& t : runners)
+                t.join();
+
+            BOOST_TEST(!fired);
+            for (auto& d : done)
+                BOOST_TEST(d.load() == posts);
+        };
+
+        stress(1, epoll_options{});
+        stress(2, epoll_options{});
+        stress(2, epoll_options{.reactors = 2});
+    }
+
+    // Workers on several threads open a pair, park a read that the
+    // peer's close completes, then close and reopen at once, so the
+    // hangup of one pair is often still in another reactor's event
+    // buffer when the next pair registers. Were its descriptor state
+    // reused early, that stale event would fail the new pair's reads.
+    void
+    testEpollDescriptorReuse()
+    {
+        auto churn = [](unsigned threads, epoll_options const& opts)
+        {
+            constexpr int workers = 8;
+            constexpr int rounds = 200;
+
+            epoll_context ctx(threads, opts);
+            auto ex = ctx.get_executor();
+            std::atomic<int> failures{0};
+            std::atomic<int> done{0};
+
+            for (int w = 0; w < workers; ++w)
+            {
+                capy::run_async(ex)(
+                    [](epoll_context& ctx,
+                        std::atomic<int>& failures,
+                        std::atomic<int>& done) -> capy::task<>
+                    {
+                        for (int i = 0; i < rounds; ++i)
+                        {
+                            auto [a, b] = test::make_local_socket_pair(ctx);
+                            capy::run_async(ctx.get_executor())(
+                                [](socket b) -> capy::task<>
+                                {
+                                    (void)co_await b.write_some(
+                                        capy::const_buffer("x", 1));
+                                    b.close();
+                                }(std::move(b)));
+
+                            char buf[4];
+                            auto [ec1, n1] = co_await a.read_some(
+                                capy::mutable_buffer(buf, sizeof(buf)));
+                            if (ec1 || n1 != 1)
+                                ++failures;
+                            auto [ec2, n2] = co_await a.read_some(
+                                capy::mutable_buffer(buf, sizeof(buf)));
+                            if (ec2 != capy::error::eof)
+                                ++failures;
+                            a.close();
+                        }
+                        ++done;
+                    }(ctx, failures, done));
+            }
+
+            std::vector<std::thread> runners;
+            for (unsigned i = 0; i < threads; ++i)
+                runners.emplace_back([&ctx] { ctx.run(); });
+            for (auto& t : runners)
+                t.join();
+
+            BOOST_TEST(done.load() == workers);
+            BOOST_TEST(failures.load() == 0);
+        };
+
+        churn(4, epoll_options{});
+        churn(4, epoll_options{.reactors = 2});
+    }
+
+    void
+    testEpollTimerSlack()
+    {
+        epoll_context ctx(1);
+
+        // Expiries 1ms apart with 50ms slack round to at most two
+        // times, so most timers share a wakeup
+        constexpr int n = 8;
+        std::vector<timer> timers;
+        timers.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            timers.emplace_back(ctx);
+            timers.back().set_slack(std::chrono::milliseconds(50));
+            timers.back().expires_after(std::chrono::milliseconds(1 + i));
+        }
+        BOOST_TEST(timers[0].slack() == std::chrono::milliseconds(50));
+
+        int done = 0;
+        auto waiter = [](timer& t, int& done_out) -> capy::task<>
+        {
+            auto [ec] = co_await t.wait();
+            if (!ec)
+                ++done_out;
+        };
+        for (auto& t : timers)
+            capy::run_async(ctx.get_executor())(waiter(t, done));
+
+        ctx.run();
+        BOOST_TEST(done == n);
+        BOOST_TEST(ctx.stats().timer_wakeups_coalesced >= n - 2);
+    }
+
+    void
+    testEpollTimerfd()
+    {
+        auto waiter = [](timer& t, bool& ok_out) -> capy::task<>
+        {
+            auto [ec] = co_await t.wait();
+            ok_out = !ec;
+        };
+
+        // Sub-millisecond timers, driven by the timerfd
+        {
+            epoll_context ctx(1);
+            BOOST_TEST(ctx.stats().timerfd);
+
+            timer t1(ctx);
+            timer t2(ctx);
+            t1.expires_after(std::chrono::microseconds(200));
+            t2.expires_after(std::chrono::microseconds(400));
+            bool ok1 = false;
+            bool ok2 = false;
+            capy::run_async(ctx.get_executor())(waiter(t1, ok1));
+            capy::run_async(ctx.get_executor())(waiter(t2, ok2));
+
+            ctx.run();
+            BOOST_TEST(ok1);
+            BOOST_TEST(ok2);
+            BOOST_TEST(ctx.stats().timerfd_rearms >= 2);
+        }
+
+        // Falling back to the epoll_wait timeout
+        {
+            epoll_options opts;
+            opts.use_timerfd = false;
+            epoll_context ctx(1, opts);
+            BOOST_TEST(!ctx.stats().timerfd);
+
+            timer t(ctx);
+            t.expires_after(std::chrono::microseconds(200));
+            bool ok = false;
+            capy::run_async(ctx.get_executor())(waiter(t, ok));
+
+            ctx.run();
+            BOOST_TEST(ok);
+            BOOST_TEST(ctx.stats().timerfd_rearms == 0);
+        }
+    }
+
+    void
+    testEpollDeferredServices()
+    {
+        // Threads racing to first use each service share one instance
+        epoll_context ctx(4);
+        std::atomic<int> opened{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&]
+            {
+                socket s(ctx);
+                s.open();
+                acceptor a(ctx);
+                a.listen(endpoint(0));
+                resolver r(ctx);
+                signal_set sigs(ctx);
+                if (s.is_open() && a.is_open())
+                    ++opened;
+            });
+        for (auto& t : threads)
+            t.join();
+        BOOST_TEST(opened.load() == 4);
+    }
+
+    void
+    testEpollSchedulerStats()
+    {
+        epoll_context ctx(1);
+        basic_io_context& base = ctx;
+        BOOST_TEST(base.stats().handlers_executed == 0);
+
+        int counter = 0;
+        for (int i = 0; i < 5; ++i)
+            ctx.get_executor().post(make_coro(counter));
+
+        // A timer makes the reactor block at least once
+        timer t(ctx);
+        t.expires_after(std::chrono::milliseconds(5));
+        capy::run_async(ctx.get_executor())(
+            [](timer& t) -> capy::task<> { co_await t.wait(); }(t));
+
+        ctx.run();
+        BOOST_TEST(counter == 5);
+
+        // Counted by a thread that has left run()
+        auto st = base.stats();
+        BOOST_TEST(st.handlers_executed >= 6);
+        BOOST_TEST(st.queue_depth_peak >= 1);
+        BOOST_TEST(st.blocking_waits >= 1);
+        BOOST_TEST(st.reactor_polls >= st.blocking_waits);
+        BOOST_TEST(st.events_harvested >= 1);
+        BOOST_TEST(st.events_per_poll() > 0.0);
+        BOOST_TEST(st.blocked_time >= std::chrono::milliseconds(1));
+        BOOST_TEST(st.running_time.count() >= 0);
+
+        // The epoll counters extend the common ones
+        BOOST_TEST(ctx.stats().handlers_executed == st.handlers_executed);
+    }
+
+    // Bounces `rounds` small messages over each pair, from `threads`
+    // threads, and returns the rounds completed
+    static int
+    pingPongEpoll(epoll_context& ctx, int pairs, int rounds, int threads)
+    {
+        std::vector<socket> sockets;
+        sockets.reserve(2 * pairs);
+        for (int i = 0; i < pairs; ++i)
+        {
+            auto [s1, s2] = test::make_socket_pair(ctx);
+            sockets.push_back(std::move(s1));
+            sockets.push_back(std::move(s2));
+        }
+
+        std::atomic<int> done{0};
+        auto pinger = [](socket& s, int rounds, std::atomic<int>& done)
+            -> capy::task<>
+        {
+            char buf[4] = {'p', 'i', 'n', 'g'};
+            for (int i = 0; i < rounds; ++i)
+            {
+                auto [wec, wn] = co_await s.write_some(
+                    capy::const_buffer(buf, sizeof(buf)));
+                if (wec || wn != sizeof(buf))
+                    co_return;
+                std::size_t got = 0;
+                while (got < sizeof(buf))
+                {
+                    auto [ec, n] = co_await s.read_some(
+                        capy::mutable_buffer(buf + got, sizeof(buf) - got));
+                    if (ec)
+                        co_return;
+                    got += n;
+                }
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+            s.close();
+        };
+        auto echoer = [](socket& s) -> capy::task<>
+        {
+            char buf[64];
+            for (;;)
+            {
+                auto [ec, n] = co_await s.read_some(
+                    capy::mutable_buffer(buf, sizeof(buf)));
+                if (ec)
+                    break;
+                auto [wec, wn] = co_await s.write_some(
+                    capy::const_buffer(buf, n));
+                if (wec)
+                    break;
+            }
+        };
+        for (int i = 0; i < pairs; ++i)
+        {
+            capy::run_async(ctx.get_executor())(
+                pinger(sockets[2 * i], rounds, done));
+            capy::run_async(ctx.get_executor())(echoer(sockets[2 * i + 1]));
+        }
+
+        std::vector<std::thread> runners;
+        for (int i = 1; i < threads; ++i)
+            runners.emplace_back([&ctx] { ctx.run(); });
+        ctx.run();
+        for (auto& t : runners)
+            t.join();
+        return done.load();
+    }
+
+    void
+    testEpollReactors()
+    {
+        // A single-threaded context keeps one reactor
+        {
+            epoll_context ctx(1, epoll_options{.reactors = 4});
+            BOOST_TEST(ctx.stats().reactors == 1u);
+        }
+
+        // One thread serves the sockets of every reactor through
+        // the watches in the primary
+        {
+            epoll_context ctx(2, epoll_options{.reactors = 3});
+            BOOST_TEST(ctx.stats().reactors == 3u);
+            BOOST_TEST(pingPongEpoll(ctx, 3, 50, 1) == 150);
+            BOOST_TEST(ctx.stats().events_harvested >= 1);
+        }
+
+        // A thread per reactor, and more threads than reactors
+        {
+            epoll_context ctx(4, epoll_options{.reactors = 4});
+            BOOST_TEST(pingPongEpoll(ctx, 8, 100, 4) == 800);
+        }
+        {
+            epoll_context ctx(6, epoll_options{.reactors = 2});
+            BOOST_TEST(pingPongEpoll(ctx, 4, 100, 6) == 400);
+        }
+
+        // Timers and stop() still reach the threads in secondaries
+        {
+            epoll_context ctx(3, epoll_options{.reactors = 3});
+            timer t(ctx);
+            t.expires_after(std::chrono::milliseconds(5));
+            bool fired = false;
+            capy::run_async(ctx.get_executor())(
+                [](timer& t, bool& out) -> capy::task<>
+                {
+                    auto [ec] = co_await t.wait();
+                    out = !ec;
+                }(t, fired));
+            std::vector<std::thread> runners;
+            for (int i = 0; i < 2; ++i)
+                runners.emplace_back([&ctx] { ctx.run(); });
+            ctx.run();
+            for (auto& r : runners)
+                r.join();
+            BOOST_TEST(fired);
+
+            ctx.restart();
+            ctx.get_executor().on_work_started();
+            for (int i = 0; i < 2; ++i)
+                runners[i] = std::thread([&ctx] { ctx.run(); });
+            std::thread stopper([&ctx] { ctx.stop(); });
+            ctx.run();
+            stopper.join();
+            for (auto& r : runners)
+                r.join();
+            ctx.get_executor().on_work_finished();
+        }
+    }
+
+    void
+    testEpollCompletionAffinity()
+    {
+        // Ignored without work stealing
+        {
+            epoll_context ctx(1, epoll_options{.completion_affinity = true});
+            BOOST_TEST(pingPongEpoll(ctx, 2, 50, 1) == 100);
+        }
+
+        // Completions kept for busy threads still all run, with
+        // thieves waiting out the delay
+        {
+            epoll_context ctx(4, epoll_options{
+                .completion_affinity = true,
+                .affinity_steal_delay = std::chrono::microseconds(20)});
+            BOOST_TEST(pingPongEpoll(ctx, 8, 100, 4) == 800);
+        }
+
+        // Together with several reactors
+        {
+            epoll_context ctx(4, epoll_options{
+                .reactors = 2,
+                .completion_affinity = true});
+            BOOST_TEST(pingPongEpoll(ctx, 8, 100, 4) == 800);
+        }
+    }
+
+    // Waits on `ctx` from a host epoll set as an embedding loop
+    // would, then processes what is ready; gives up after a second
+    static std::size_t
+    hostTurn(epoll_context& ctx, int host_fd)
+    {
+        auto t = ctx.poll_ready_timeout();
+        int ms = t > std::chrono::milliseconds(1000)
+            ? 1000 : static_cast<int>(t.count());
+        epoll_event ev{};
+        ::epoll_wait(host_fd, &ev, 1, ms);
+        return ctx.poll_ready();
+    }
+
+    void
+    testEpollPollReady()
+    {
+        auto embed = [](unsigned threads, epoll_options const& opts)
+        {
+            epoll_context ctx(threads, opts);
+            int const host_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            BOOST_TEST(::epoll_ctl(host_fd, EPOLL_CTL_ADD,
+                ctx.native_handle(), &ev) == 0);
+
+            // No work does not stop the context
+            BOOST_TEST(ctx.poll_ready() == 0);
+            BOOST_TEST(!ctx.stopped());
+
+            // A timer makes the handle ready, or bounds the wait
+            timer t(ctx);
+            t.expires_after(std::chrono::milliseconds(5));
+            bool fired = false;
+            capy::run_async(ctx.get_executor())(
+                [](timer& t, bool& out) -> capy::task<>
+                {
+                    auto [ec] = co_await t.wait();
+                    out = !ec;
+                }(t, fired));
+            for (int i = 0; i < 100 && !fired; ++i)
+                hostTurn(ctx, host_fd);
+            BOOST_TEST(fired);
+            BOOST_TEST(!ctx.stopped());
+
+            // Socket readiness
+            auto [s1, s2] = test::make_local_socket_pair(ctx);
+            char buf[4] = {};
+            std::size_t got = 0;
+            capy::run_async(ctx.get_executor())(
+                [](socket& s, char* buf, std::size_t& out) -> capy::task<>
+                {
+                    auto [ec, n] = co_await s.read_some(
+                        capy::mutable_buffer(buf, 4));
+                    out = ec ? 0 : n;
+                }(s2, buf, got));
+            BOOST_TEST(ctx.poll_ready() >= 1);
+            BOOST_TEST(got == 0);
+            capy::run_async(ctx.get_executor())(
+                [](socket& s) -> capy::task<>
+                {
+                    (void) co_await s.write_some(
+                        capy::const_buffer("ping", 4));
+                }(s1));
+            for (int i = 0; i < 100 && got == 0; ++i)
+                hostTurn(ctx, host_fd);
+            BOOST_TEST(got == 4);
+
+            // A post from another thread wakes the host
+            int counter = 0;
+            std::thread poster([&]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                ctx.get_executor().post(make_coro(counter));
+            });
+            for (int i = 0; i < 100 && counter == 0; ++i)
+                hostTurn(ctx, host_fd);
+            poster.join();
+            BOOST_TEST(counter == 1);
+
+            // Stopped until restarted
+            ctx.stop();
+            ctx.get_executor().post(make_coro(counter));
+            BOOST_TEST(ctx.poll_ready() == 0);
+            ctx.restart();
+            BOOST_TEST(ctx.poll_ready() == 1);
+            BOOST_TEST(counter == 2);
+
+            s1.close();
+            s2.close();
+            ::close(host_fd);
+        };
+
+        // Timers arrive through the timerfd
+        {
+            epoll_context ctx(1);
+            BOOST_TEST(ctx.poll_ready_timeout() ==
+                (std::chrono::milliseconds::max)());
+        }
+        embed(1, epoll_options{});
+
+        // Without one the host is told how long it may wait
+        {
+            epoll_context ctx(1, epoll_options{.use_timerfd = false});
+            timer t(ctx);
+            t.expires_after(std::chrono::milliseconds(50));
+            auto ms = ctx.poll_ready_timeout();
+            BOOST_TEST(ms <= std::chrono::milliseconds(50));
+        }
+        embed(1, epoll_options{.use_timerfd = false});
+
+        // Secondaries are watched from the primary
+        embed(2, epoll_options{.reactors = 2});
+    }
+#endif
+
+#if BOOST_COROSIO_HAS_IO_URING
+    void
+    testIoUringStopAndPost()
+    {
+        io_uring_context ctx(1);
+        auto ex = ctx.get_executor();
+        int counter = 0;
+
+        // Posted handlers run without any ring traffic
+        ex.post(make_coro(counter));
+        ex.post(make_coro(counter));
+        BOOST_TEST(ctx.run() == 2);
+        BOOST_TEST(counter == 2);
+        ctx.restart();
+
+        // Stopping from another thread must wake a reactor blocked
+        // in io_uring_enter, on every cycle
+        for (int i = 0; i < 3; ++i)
+        {
+            ex.on_work_started();
+            std::thread t([&ctx] { ctx.stop(); });
+            ctx.run();
+            t.join();
+            ex.on_work_finished();
+            ctx.restart();
+        }
+    }
+#endif
+
+    void
+    testPostFromHandler()
+    {
+        // Posts made by handlers are counted privately and published
+        // when the handler returns; run() must still see all of them
+        for (unsigned hint : {1u, 4u})
+        {
+            io_context ioc(hint);
+            auto ex = ioc.get_executor();
+            std::atomic<int> counter{0};
+
+            for (int i = 0; i < 100; ++i)
+                ex.post(make_fanout_coro(counter, ex, i % 4));
+
+            std::size_t n = 0;
+            if (hint == 1)
+            {
+                n = ioc.run();
+            }
+            else
+            {
+                std::atomic<std::size_t> total{0};
+                std::vector<std::thread> runners;
+                for (unsigned t = 0; t < hint; ++t)
+                    runners.emplace_back([&] { total += ioc.run(); });
+                for (auto& t : runners)
+                    t.join();
+                n = total.load();
+            }
+
+            // 100 fanout handlers plus 0+1+2+3 children per group of 4
+            BOOST_TEST(n == 250);
+            BOOST_TEST(counter.load() == 250);
+        }
+    }
+
+    void
+    testPostBatch()
+    {
+        for (unsigned hint : {1u, 4u})
+        {
+            io_context ioc(hint);
+            auto ex = ioc.get_executor();
+            std::atomic<int> counter{0};
+
+            // From outside run(), then from inside a handler
+            std::vector<capy::coro> outer;
+            std::vector<capy::coro> inner;
+            for (int i = 0; i < 500; ++i)
+            {
+                outer.push_back(make_atomic_coro(counter));
+                inner.push_back(make_atomic_coro(counter));
+            }
+            ex.post_batch(outer);
+            ex.post_batch({});
+
+            auto fan = [](io_context::executor_type ex,
+                std::vector<capy::coro> const& hs) -> capy::task<>
+            {
+                ex.post_batch(hs);
+                co_return;
+            };
+            capy::run_async(ex)(fan(ex, inner));
+
+            std::vector<std::thread> runners;
+            for (unsigned t = 1; t < hint; ++t)
+                runners.emplace_back([&ioc] { ioc.run(); });
+            ioc.run();
+            for (auto& t : runners)
+                t.join();
+
+            BOOST_TEST(counter.load() == 1000);
+        }
+
+        // Through a high priority executor
+        io_context ioc;
+        int counter = 0;
+        std::vector<capy::coro> hs;
+        for (int i = 0; i < 10; ++i)
+            hs.push_back(make_coro(counter));
+        ioc.get_executor().high_priority().post_batch(hs);
+        BOOST_TEST(ioc.run() == 10);
+        BOOST_TEST(counter == 10);
+    }
+
+    void
+    testHighPriorityExecutor()
+    {
+        io_context ioc;
+        auto ex = ioc.get_executor();
+        auto hp = ex.high_priority();
+        BOOST_TEST(hp.is_high_priority());
+        BOOST_TEST(!ex.is_high_priority());
+        BOOST_TEST(hp != ex);
+        BOOST_TEST(hp == ex.high_priority());
+        BOOST_TEST(&hp.context() == &ioc);
+
+        // Every backend runs them, with or without lanes
+        int counter = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            ex.post(make_coro(counter));
+            hp.post(make_coro(counter));
+        }
+        BOOST_TEST(ioc.run() == 20);
+        BOOST_TEST(counter == 20);
+    }
+
+    template<class Context>
+    void
+    testPriorityLanes()
+    {
+        Context ctx(1);
+        auto ex = ctx.get_executor();
+        auto hp = ex.high_priority();
+
+        // Bulk work is queued first; more priority handlers than
+        // one burst follow it
+        std::vector<int> order;
+        constexpr int n = 40;
+        for (int i = 0; i < n; ++i)
+            ex.post(make_order_coro(order, 0));
+        for (int i = 0; i < n; ++i)
+            hp.post(make_order_coro(order, 1));
+        ctx.run();
+
+        BOOST_TEST(order.size() == std::size_t(2 * n));
+        if (order.empty())
+            return;
+        BOOST_TEST(order.front() == 1);
+
+        // A bounded run of priority handlers lets bulk work through
+        auto first_bulk = std::find(order.begin(), order.end(), 0);
+        auto last_priority = std::find(order.rbegin(), order.rend(), 1);
+        BOOST_TEST(first_bulk < last_priority.base());
+    }
+
     void
     run()
     {
@@ -472,6 +1421,36 @@ struct io_context_test
         testExecutorRunningInThisThread();
         testMultithreaded();
         testMultithreadedStress();
+        testPostFromHandler();
+        testPostBatch();
+        testHighPriorityExecutor();
+#if BOOST_COROSIO_HAS_EPOLL
+        testPriorityLanes<epoll_context>();
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+        testPriorityLanes<select_context>();
+#endif
+#if BOOST_COROSIO_HAS_IOCP
+        testPriorityLanes<iocp_context>();
+#endif
+#if BOOST_COROSIO_HAS_EPOLL
+        testEpollBusyPoll();
+        testEpollHandlerBudget();
+        testEpollInlineCompletions();
+        testEpollWakeupCoalescing();
+        testEpollWakeupStress();
+        testEpollDescriptorReuse();
+        testEpollTimerSlack();
+        testEpollTimerfd();
+        testEpollDeferredServices();
+        testEpollSchedulerStats();
+        testEpollReactors();
+        testEpollCompletionAffinity();
+        testEpollPollReady();
+#endif
+#if BOOST_COROSIO_HAS_IO_URING
+        testIoUringStopAndPost();
+#endif
     }
 };
 
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/io_context_pool.hpp>
+
+#include <atomic>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+// Coroutine that increments an atomic counter when resumed
+struct pool_counter_coro
+{
+    struct promise_type
+    {
+        std::atomic<int>* counter_ = nullptr;
+
+        pool_counter_coro get_return_object()
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void()
+        {
+            if (counter_)
+                counter_->fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+
+    operator capy::coro() const { return h; }
+};
+
+inline pool_counter_coro make_pool_coro(std::atomic<int>& counter)
+{
+    auto c = []() -> pool_counter_coro { co_return; }();
+    c.h.promise().counter_ = &counter;
+    return c;
+}
+
+struct io_context_pool_test
+{
+    void
+    testConstruction()
+    {
+        {
+            io_context_pool pool(3);
+            BOOST_TEST(pool.size() == 3);
+        }
+
+        // Zero is treated as one
+        {
+            io_context_pool pool(0);
+            BOOST_TEST(pool.size() == 1);
+        }
+
+        {
+            io_context_pool pool;
+            BOOST_TEST(pool.size() >= 1);
+        }
+    }
+
+    void
+    testGetExecutor()
+    {
+        io_context_pool pool(3);
+
+        // Round-robin visits every shard in turn
+        auto e0 = pool.get_executor();
+        auto e1 = pool.get_executor();
+        auto e2 = pool.get_executor();
+        auto e3 = pool.get_executor();
+        BOOST_TEST(e0 != e1);
+        BOOST_TEST(e1 != e2);
+        BOOST_TEST(e0 == e3);
+
+        // Keyed selection is stable
+        BOOST_TEST(pool.get_executor(7) == pool.get_executor(7));
+        BOOST_TEST(pool.get_executor(1) == pool.get_context(1).get_executor());
+        BOOST_TEST(pool.get_executor(4) == pool.get_context(1).get_executor());
+    }
+
+    void
+    testIndexOf()
+    {
+        io_context_pool pool(2);
+        BOOST_TEST(pool.index_of(pool.get_context(0)) == 0);
+        BOOST_TEST(pool.index_of(pool.get_context(1)) == 1);
+
+        io_context other;
+        BOOST_TEST(pool.index_of(other) == pool.size());
+    }
+
+    void
+    testStartJoin()
+    {
+        io_context_pool pool(4);
+        std::atomic<int> counter{0};
+
+        for (int i = 0; i < 100; ++i)
+            pool.get_executor().post(make_pool_coro(counter));
+
+        pool.start();
+        pool.join();
+        BOOST_TEST(counter.load() == 100);
+
+        // The pool may be started again after join
+        for (int i = 0; i < 10; ++i)
+            pool.get_executor(i).post(make_pool_coro(counter));
+        pool.start();
+        pool.join();
+        BOOST_TEST(counter.load() == 110);
+    }
+
+    void
+    testPerCore()
+    {
+        io_context_pool pool(2, io_context_pool::affinity::per_core);
+        std::atomic<int> counter{0};
+
+        pool.get_executor(0).post(make_pool_coro(counter));
+        pool.get_executor(1).post(make_pool_coro(counter));
+        pool.start();
+        pool.join();
+        BOOST_TEST(counter.load() == 2);
+    }
+
+    void
+    testPerNode()
+    {
+        // Single-node machines run it unbound
+        io_context_pool pool(2, io_context_pool::affinity::per_node);
+        std::atomic<int> counter{0};
+
+        pool.get_executor(0).post(make_pool_coro(counter));
+        pool.get_executor(1).post(make_pool_coro(counter));
+        pool.start();
+        pool.join();
+        BOOST_TEST(counter.load() == 2);
+
+        // Shards alternate between nodes
+        if (pool.node_of(0) != pool.node_of(1))
+        {
+            io_context_pool wide(4, io_context_pool::affinity::per_node);
+            BOOST_TEST_EQ(wide.node_of(0), wide.node_of(2));
+        }
+    }
+
+    void
+    run()
+    {
+        testConstruction();
+        testGetExecutor();
+        testIndexOf();
+        testStartJoin();
+        testPerCore();
+        testPerNode();
+    }
+};
+
+TEST_SUITE(io_context_pool_test, "boost.corosio.io_context_pool");
+
+} // namespace boost::corosio
@@ -0,0 +1,270 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/local_stream_socket.hpp>
+
+#include <boost/corosio/local_acceptor.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#if BOOST_COROSIO_HAS_EPOLL
+#include <boost/corosio/epoll_context.hpp>
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+#include <boost/corosio/select_context.hpp>
+#endif
+#if BOOST_COROSIO_HAS_IO_URING
+#include <boost/corosio/io_uring_context.hpp>
+#endif
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+#if BOOST_COROSIO_POSIX
+#include <unistd.h>
+#endif
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+#if BOOST_COROSIO_POSIX
+
+namespace {
+
+std::atomic<int> next_local_path{0};
+
+// A fresh socket path for each test, removed before use
+std::string
+make_local_path()
+{
+    std::string path = "/tmp/corosio_test_" +
+        std::to_string(::getpid()) + "_" +
+        std::to_string(next_local_path.fetch_add(1)) + ".sock";
+    ::unlink(path.c_str());
+    return path;
+}
+
+} // namespace
+
+template<class Context>
+struct local_stream_socket_test_impl
+{
+    void
+    testEcho()
+    {
+        Context ioc;
+        std::string path = make_local_path();
+        local_acceptor acc(ioc);
+        acc.listen(path);
+        BOOST_TEST(acc.is_open());
+
+        std::string echoed;
+
+        auto server_task = [&]() -> capy::task<>
+        {
+            local_stream_socket peer(ioc);
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            char buf[16];
+            auto [rec, n] = co_await peer.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!rec);
+            auto [wec, wn] = co_await peer.write_all(
+                capy::const_buffer(buf, n));
+            BOOST_TEST(!wec);
+        };
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            local_stream_socket s(ioc);
+            s.open();
+            auto [ec] = co_await s.connect(path);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            auto [wec, wn] = co_await s.write_all(
+                capy::const_buffer("ping", 4));
+            BOOST_TEST(!wec);
+
+            echoed.resize(4);
+            auto [rec, rn] = co_await s.read_exact(
+                capy::mutable_buffer(echoed.data(), echoed.size()));
+            BOOST_TEST(!rec);
+
+            // The server closes after echoing
+            char c;
+            auto [eec, en] = co_await s.read_some(
+                capy::mutable_buffer(&c, 1));
+            BOOST_TEST(eec == capy::cond::eof);
+        };
+
+        capy::run_async(ioc.get_executor())(server_task());
+        capy::run_async(ioc.get_executor())(client_task());
+        ioc.run();
+
+        BOOST_TEST_EQ(echoed, "ping");
+        acc.close();
+        ::unlink(path.c_str());
+    }
+
+    void
+    testConnectRefused()
+    {
+        Context ioc;
+        std::string path = make_local_path();
+
+        auto task = [&]() -> capy::task<>
+        {
+            local_stream_socket s(ioc);
+            s.open();
+            auto [ec] = co_await s.connect(path);
+            BOOST_TEST(ec);
+        };
+        capy::run_async(ioc.get_executor())(task());
+        ioc.run();
+    }
+
+    void
+    testListenPathInUse()
+    {
+        Context ioc;
+        std::string path = make_local_path();
+        local_acceptor acc(ioc);
+        acc.listen(path);
+
+        // The file outlives the acceptor
+        local_acceptor other(ioc);
+        BOOST_TEST_THROWS(other.listen(path), system::system_error);
+        acc.close();
+        BOOST_TEST_THROWS(other.listen(path), system::system_error);
+
+        ::unlink(path.c_str());
+        other.listen(path);
+        BOOST_TEST(other.is_open());
+        other.close();
+        ::unlink(path.c_str());
+    }
+
+    void
+    testPassDescriptor()
+    {
+        Context ioc;
+        std::string path = make_local_path();
+        local_acceptor acc(ioc);
+        acc.listen(path);
+
+        int fds[2];
+        BOOST_TEST_EQ(::pipe(fds), 0);
+        int received = -1;
+
+        auto server_task = [&]() -> capy::task<>
+        {
+            local_stream_socket peer(ioc);
+            auto [ec] = co_await acc.accept(peer);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            // Send the pipe's write end
+            auto [sec] = co_await peer.send_descriptor(fds[1]);
+            BOOST_TEST(!sec);
+        };
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            local_stream_socket s(ioc);
+            s.open();
+            auto [ec] = co_await s.connect(path);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            auto [rec, fd] = co_await s.receive_descriptor();
+            BOOST_TEST(!rec);
+            received = fd;
+
+            // The peer has closed with no descriptor left
+            auto [eec, efd] = co_await s.receive_descriptor();
+            BOOST_TEST(eec == capy::cond::eof);
+            BOOST_TEST_EQ(efd, -1);
+        };
+
+        capy::run_async(ioc.get_executor())(server_task());
+        capy::run_async(ioc.get_executor())(client_task());
+        ioc.run();
+
+        // The received descriptor writes into the same pipe
+        BOOST_TEST(received >= 0);
+        BOOST_TEST(received != fds[1]);
+        if (received >= 0)
+        {
+            BOOST_TEST_EQ(::write(received, "x", 1), 1);
+            char c = 0;
+            BOOST_TEST_EQ(::read(fds[0], &c, 1), 1);
+            BOOST_TEST_EQ(c, 'x');
+            ::close(received);
+        }
+        ::close(fds[0]);
+        ::close(fds[1]);
+        acc.close();
+        ::unlink(path.c_str());
+    }
+
+    void
+    run()
+    {
+        testEcho();
+        testConnectRefused();
+        testListenPathInUse();
+        testPassDescriptor();
+    }
+};
+
+#if BOOST_COROSIO_HAS_EPOLL
+struct local_stream_socket_test
+    : local_stream_socket_test_impl<epoll_context> {};
+TEST_SUITE(local_stream_socket_test, "boost.corosio.local_stream_socket");
+#endif
+
+#if BOOST_COROSIO_HAS_SELECT
+struct local_stream_socket_test_select
+    : local_stream_socket_test_impl<select_context> {};
+TEST_SUITE(local_stream_socket_test_select,
+    "boost.corosio.local_stream_socket.select");
+#endif
+
+#if BOOST_COROSIO_HAS_IO_URING
+// io_uring does not pass descriptors
+struct local_stream_socket_test_io_uring
+    : local_stream_socket_test_impl<io_uring_context>
+{
+    void
+    run()
+    {
+        testEcho();
+        testConnectRefused();
+        testListenPathInUse();
+    }
+};
+TEST_SUITE(local_stream_socket_test_io_uring,
+    "boost.corosio.local_stream_socket.io_uring");
+#endif
+
+#endif // BOOST_COROSIO_POSIX
+
+} // namespace boost::corosio
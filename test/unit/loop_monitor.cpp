@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/loop_monitor.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct loop_monitor_test
+{
+    void
+    testStall()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        std::atomic<int> stalls{0};
+        std::atomic<std::int64_t> longest_report{0};
+
+        loop_monitor_options opts;
+        opts.probe_interval = 1ms;
+        opts.stall_threshold = 10ms;
+        opts.on_stall = [&](stall_report const& r)
+        {
+            ++stalls;
+            if (r.duration.count() > longest_report.load())
+                longest_report.store(r.duration.count());
+        };
+
+        loop_monitor mon(ioc, opts);
+
+        // A handler that blocks the loop, then a later one that looks
+        // at the longest handler of its thread
+        std::vector<loop_monitor::thread_longest> longest;
+        timer t(ioc);
+        auto stall = [](timer& t, loop_monitor& mon,
+            std::vector<loop_monitor::thread_longest>& out) -> capy::task<>
+        {
+            std::this_thread::sleep_for(30ms);
+            t.expires_after(5ms);
+            (void) co_await t.wait();
+            out = mon.longest_handlers();
+        };
+        capy::run_async(ioc.get_executor())(stall(t, mon, longest));
+        ioc.run();
+
+        // Probes queued behind the blocked handler saw the lag
+        BOOST_TEST(mon.max_lag() >= 10ms);
+        BOOST_TEST(mon.max_lag() >= mon.lag());
+
+        if (mon.timing_handlers())
+        {
+            BOOST_TEST(stalls.load() >= 1);
+            BOOST_TEST(longest_report.load() >=
+                std::chrono::nanoseconds(10ms).count());
+            BOOST_TEST_EQ(longest.size(), 1u);
+            if (!longest.empty())
+            {
+                BOOST_TEST(longest[0].thread == std::this_thread::get_id());
+                BOOST_TEST(longest[0].duration >= 30ms);
+            }
+        }
+    }
+
+    void
+    testQuiet()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        std::atomic<int> stalls{0};
+
+        loop_monitor_options opts;
+        opts.stall_threshold = 1000ms;
+        opts.on_stall = [&](stall_report const&) { ++stalls; };
+
+        {
+            loop_monitor mon(ioc, opts);
+            timer t(ioc);
+            t.expires_after(20ms);
+            capy::run_async(ioc.get_executor())(
+                [](timer& t) -> capy::task<> { (void) co_await t.wait(); }(t));
+            ioc.run();
+        }
+        BOOST_TEST_EQ(stalls.load(), 0);
+    }
+
+    void
+    run()
+    {
+        testStall();
+        testQuiet();
+    }
+};
+
+TEST_SUITE(loop_monitor_test, "boost.corosio.loop_monitor");
+
+} // namespace boost::corosio
@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/op_tracer.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct op_tracer_test
+{
+    struct recording_tracer : op_tracer
+    {
+        std::vector<op_trace> traces;
+
+        void
+        on_complete(op_trace const& t) noexcept override
+        {
+            traces.push_back(t);
+        }
+    };
+
+    void
+    testHistogram()
+    {
+        using namespace std::chrono_literals;
+
+        latency_histogram h;
+        BOOST_TEST_EQ(h.count(), 0u);
+        BOOST_TEST(h.value_at_percentile(50) == 0ns);
+
+        for (int i = 1; i <= 1000; ++i)
+            h.record(std::chrono::microseconds(i));
+        h.record(-5ns);
+
+        BOOST_TEST_EQ(h.count(), 1001u);
+        BOOST_TEST(h.min() == 0ns);
+        BOOST_TEST(h.max() == 1000us);
+        BOOST_TEST(h.value_at_percentile(100) == 1000us);
+
+        // Within 1 part in 128 of the exact value
+        auto const p50 = h.value_at_percentile(50);
+        BOOST_TEST(p50 >= 500us);
+        BOOST_TEST(p50 <= 500us + 500us / 128);
+        auto const p99 = h.value_at_percentile(99);
+        BOOST_TEST(p99 >= 990us);
+        BOOST_TEST(p99 <= 990us + 990us / 128);
+
+        // Small values are exact
+        latency_histogram s;
+        s.record(7ns);
+        s.record(200ns);
+        BOOST_TEST(s.value_at_percentile(0) == 7ns);
+        BOOST_TEST(s.value_at_percentile(100) == 200ns);
+
+        std::ostringstream os;
+        h.print(os);
+        BOOST_TEST(os.str().find("Percentile") != std::string::npos);
+        BOOST_TEST(os.str().find("Total count    =         1001")
+            != std::string::npos);
+
+        h.reset();
+        BOOST_TEST_EQ(h.count(), 0u);
+        BOOST_TEST(h.max() == 0ns);
+    }
+
+    void
+    testTrace()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        recording_tracer tracer;
+        if (!ioc.set_op_tracer(&tracer))
+            return;
+
+        auto [s1, s2] = test::make_socket_pair(ioc);
+        tracer.traces.clear();
+
+        // The read parks until the write made after the timer
+        auto reader = [](socket& s) -> capy::task<>
+        {
+            char buf[8];
+            auto [ec, n] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 2u);
+        };
+        auto writer = [](socket& s, timer& t) -> capy::task<>
+        {
+            t.expires_after(5ms);
+            (void) co_await t.wait();
+            auto [ec, n] = co_await s.write_some(
+                capy::const_buffer("hi", 2));
+            BOOST_TEST(!ec);
+        };
+        timer t(ioc);
+        capy::run_async(ioc.get_executor())(reader(s2));
+        capy::run_async(ioc.get_executor())(writer(s1, t));
+        ioc.run();
+
+        bool saw_parked = false;
+        for (auto const& tr : tracer.traces)
+        {
+            BOOST_TEST(!tr.cancelled);
+            BOOST_TEST(tr.initiated <= tr.ready);
+            BOOST_TEST(tr.ready <= tr.queued);
+            BOOST_TEST(tr.queued <= tr.resumed);
+            if (tr.parked)
+            {
+                saw_parked = true;
+                BOOST_TEST(tr.wait_time() >= 4ms);
+            }
+        }
+        BOOST_TEST(saw_parked);
+
+        // Operations started after clearing are not traced
+        ioc.set_op_tracer(nullptr);
+        tracer.traces.clear();
+        ioc.restart();
+        timer t2(ioc);
+        capy::run_async(ioc.get_executor())(reader(s2));
+        capy::run_async(ioc.get_executor())(writer(s1, t2));
+        ioc.run();
+        BOOST_TEST(tracer.traces.empty());
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testHdrTracer()
+    {
+        using namespace std::chrono_literals;
+
+        hdr_op_tracer tracer;
+        auto const t0 = op_trace::time_point{} + 1s;
+
+        op_trace t;
+        t.initiated = t0;
+        t.ready = t0 + 100us;
+        t.queued = t0 + 110us;
+        t.resumed = t0 + 150us;
+        t.parked = true;
+        tracer.on_complete(t);
+
+        t.cancelled = true;
+        tracer.on_complete(t);
+
+        BOOST_TEST_EQ(tracer.wait.count(), 1u);
+        BOOST_TEST_EQ(tracer.dispatch.count(), 1u);
+        BOOST_TEST_EQ(tracer.queue_delay.count(), 1u);
+        BOOST_TEST_EQ(tracer.total.count(), 1u);
+        BOOST_TEST(tracer.queue_delay.max() == 40us);
+        BOOST_TEST(tracer.total.max() == 150us);
+
+        std::ostringstream os;
+        tracer.print(os);
+        BOOST_TEST(os.str().find("# queue_delay") != std::string::npos);
+
+        tracer.reset();
+        BOOST_TEST_EQ(tracer.total.count(), 0u);
+    }
+
+    void
+    run()
+    {
+        testHistogram();
+        testTrace();
+        testHdrTracer();
+    }
+};
+
+TEST_SUITE(op_tracer_test, "boost.corosio.op_tracer");
+
+} // namespace boost::corosio
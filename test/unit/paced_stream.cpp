@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/paced_stream.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/ex/run_async.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct paced_stream_test
+{
+    void
+    testBucket()
+    {
+        using namespace std::chrono_literals;
+
+        pacing_bucket b(1000, 100);
+        BOOST_TEST_EQ(b.rate(), 1000u);
+        BOOST_TEST_EQ(b.burst(), 100u);
+
+        // Starts full, then waits for the smaller of the request
+        // and a burst
+        pacing_bucket::clock_type::duration wait{};
+        BOOST_TEST_EQ(b.take(60, wait), 60u);
+        BOOST_TEST_EQ(b.take(60, wait), 40u);
+        BOOST_TEST_EQ(b.take(60, wait), 0u);
+        BOOST_TEST(wait > 50ms && wait <= 60ms);
+        BOOST_TEST_EQ(b.take(500, wait), 0u);
+        BOOST_TEST(wait > 90ms && wait <= 100ms);
+
+        b.put_back(30);
+        BOOST_TEST(b.take(60, wait) >= 30u);
+
+        // The default burst is 10ms at the rate, at least 4096
+        b.set_rate(10'000'000);
+        BOOST_TEST_EQ(b.burst(), 100'000u);
+        b.set_rate(1000);
+        BOOST_TEST_EQ(b.burst(), 4096u);
+    }
+
+    void
+    testPacedWrite()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+
+        pacing_options opts;
+        opts.rate = 200'000;
+        opts.burst = 4096;
+        opts.kernel_pacing = false;
+        paced_stream ps(s1, opts);
+        BOOST_TEST(!ps.kernel_paced());
+        BOOST_TEST_EQ(&ps.next_layer(), static_cast<io_stream*>(&s1));
+
+        std::vector<char> data(24576, 'x');
+        std::size_t received = 0;
+        std::chrono::steady_clock::duration elapsed{};
+
+        auto writer = [](paced_stream& ps, socket& s, std::vector<char>& data,
+            std::chrono::steady_clock::duration& out) -> capy::task<>
+        {
+            auto const start = std::chrono::steady_clock::now();
+            auto [ec, n] = co_await ps.write(
+                capy::const_buffer(data.data(), data.size()));
+            out = std::chrono::steady_clock::now() - start;
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, data.size());
+            s.close();
+        };
+        auto reader = [](socket& s, std::size_t& total) -> capy::task<>
+        {
+            char buf[4096];
+            for (;;)
+            {
+                auto [ec, n] = co_await s.read_some(
+                    capy::mutable_buffer(buf, sizeof(buf)));
+                total += n;
+                if (ec)
+                    break;
+            }
+        };
+        capy::run_async(ioc.get_executor())(writer(ps, s1, data, elapsed));
+        capy::run_async(ioc.get_executor())(reader(s2, received));
+        ioc.run();
+
+        // A burst goes at once, the rest at the rate
+        BOOST_TEST_EQ(received, data.size());
+        BOOST_TEST(elapsed >= 90ms);
+    }
+
+    void
+    testShared()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        auto [a1, a2] = test::make_socket_pair(ioc);
+        auto [b1, b2] = test::make_socket_pair(ioc);
+
+        // Two unpaced streams limited together by a tenant bucket
+        pacing_bucket tenant(200'000, 4096);
+        pacing_options opts;
+        opts.shared = &tenant;
+        paced_stream pa(a1, opts);
+        paced_stream pb(b1, opts);
+
+        std::vector<char> data(12288, 'y');
+        auto const start = std::chrono::steady_clock::now();
+        auto writer = [](paced_stream& ps, std::vector<char>& data) -> capy::task<>
+        {
+            auto [ec, n] = co_await ps.write(
+                capy::const_buffer(data.data(), data.size()));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, data.size());
+        };
+        capy::run_async(ioc.get_executor())(writer(pa, data));
+        capy::run_async(ioc.get_executor())(writer(pb, data));
+        ioc.run();
+
+        // 24 KiB through a 4 KiB burst at 200 KB/s
+        BOOST_TEST(std::chrono::steady_clock::now() - start >= 90ms);
+    }
+
+    void
+    run()
+    {
+        testBucket();
+        testPacedWrite();
+        testShared();
+    }
+};
+
+TEST_SUITE(paced_stream_test, "boost.corosio.paced_stream");
+
+} // namespace boost::corosio
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/parked_ops.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/signal_set.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <sstream>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct parked_ops_test
+{
+    static std::size_t
+    count(std::vector<parked_op> const& ops, parked_kind k)
+    {
+        std::size_t n = 0;
+        for (auto const& op : ops)
+            if (op.kind == k)
+                ++n;
+        return n;
+    }
+
+    void
+    testTimersAndReads()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        auto [s1, s2] = test::make_socket_pair(ioc);
+        std::vector<parked_op> seen;
+
+        // A read and a timer wait are parked while the inspector
+        // looks, then the writer releases both
+        auto reader = [](socket& s) -> capy::task<>
+        {
+            char buf[8];
+            (void) co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+        };
+        auto sleeper = [](timer& t) -> capy::task<>
+        {
+            t.expires_after(50ms);
+            (void) co_await t.wait();
+        };
+        auto inspector = [](io_context& ioc, timer& t, socket& s,
+            timer& long_wait, std::vector<parked_op>& out) -> capy::task<>
+        {
+            t.expires_after(10ms);
+            (void) co_await t.wait();
+            out = parked_ops(ioc);
+            long_wait.cancel();
+            (void) co_await s.write_some(capy::const_buffer("hi", 2));
+        };
+
+        timer t1(ioc);
+        timer t2(ioc);
+        capy::run_async(ioc.get_executor())(reader(s2));
+        capy::run_async(ioc.get_executor())(sleeper(t1));
+        capy::run_async(ioc.get_executor())(
+            inspector(ioc, t2, s1, t1, seen));
+        ioc.run();
+
+        BOOST_TEST_EQ(count(seen, parked_kind::timer), 1u);
+        for (auto const& op : seen)
+        {
+            BOOST_TEST(op.coroutine != nullptr);
+            BOOST_TEST(op.age >= std::chrono::nanoseconds(0));
+            if (op.kind == parked_kind::timer)
+            {
+                BOOST_TEST_EQ(op.fd, -1);
+                BOOST_TEST(op.age >= 5ms);
+            }
+        }
+        for (std::size_t i = 1; i < seen.size(); ++i)
+            BOOST_TEST(seen[i - 1].age >= seen[i].age);
+
+#if BOOST_COROSIO_HAS_EPOLL && !BOOST_COROSIO_HAS_IO_URING
+        BOOST_TEST_EQ(count(seen, parked_kind::read), 1u);
+        for (auto const& op : seen)
+            if (op.kind == parked_kind::read)
+                BOOST_TEST(op.fd >= 0);
+#endif
+
+        // Nothing is parked once the context has run out of work
+        BOOST_TEST(parked_ops(ioc).empty());
+    }
+
+    void
+    testPrint()
+    {
+        std::vector<parked_op> ops(3);
+        ops[0].kind = parked_kind::read;
+        ops[0].fd = 7;
+        ops[0].age = std::chrono::microseconds(1500);
+        ops[1].kind = parked_kind::timer;
+        ops[2].kind = parked_kind::read;
+
+        std::ostringstream os;
+        print_parked_ops(os, ops);
+        auto const s = os.str();
+        BOOST_TEST(s.find("3 parked: read=2 timer=1") == 0);
+        BOOST_TEST(s.find("read fd=7 age=1500us") != std::string::npos);
+        BOOST_TEST_EQ(std::string(to_string(parked_kind::server_pop)),
+            std::string("server_pop"));
+    }
+
+    void
+    testDumpOnSignal()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        signal_set signals(ioc, SIGUSR1);
+        timer t(ioc);
+        std::ostringstream os;
+
+        auto raiser = [](timer& t, signal_set& signals) -> capy::task<>
+        {
+            t.expires_after(5ms);
+            (void) co_await t.wait();
+            std::raise(SIGUSR1);
+            t.expires_after(20ms);
+            (void) co_await t.wait();
+            signals.cancel();
+        };
+        capy::run_async(ioc.get_executor())(dump_parked_ops_on(signals, os));
+        capy::run_async(ioc.get_executor())(raiser(t, signals));
+        ioc.run();
+
+        // The raiser's second wait was parked during the dump
+        BOOST_TEST(os.str().find("timer=1") != std::string::npos);
+    }
+
+    void
+    run()
+    {
+        testTimersAndReads();
+        testPrint();
+        testDumpOnSignal();
+    }
+};
+
+TEST_SUITE(parked_ops_test, "boost.corosio.parked_ops");
+
+} // namespace boost::corosio
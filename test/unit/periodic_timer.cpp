@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/periodic_timer.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/test/virtual_time.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <boost/corosio/detail/platform.hpp>
+#if BOOST_COROSIO_HAS_EPOLL
+#include <boost/corosio/epoll_context.hpp>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Periodic timer tests
+// Focus: ticks land on multiples of the period from the first,
+// lag is reported as missed ticks, and every timer queue re-arms
+// the timer in place.
+//------------------------------------------------
+
+struct periodic_timer_test
+{
+    using duration = periodic_timer::duration;
+
+    void
+    testStart()
+    {
+        io_context ioc;
+        periodic_timer t(ioc);
+        BOOST_TEST(t.period() == duration::zero());
+
+        BOOST_TEST_THROWS(t.start(duration::zero()), std::logic_error);
+        BOOST_TEST_THROWS(t.start(-std::chrono::milliseconds(1)),
+            std::logic_error);
+
+        auto const first = periodic_timer::clock_type::now() +
+            std::chrono::hours(1);
+        t.start(first, std::chrono::seconds(1));
+        BOOST_TEST(t.period() == std::chrono::seconds(1));
+        BOOST_TEST(t.expiry() == first);
+
+        // Moves keep the period
+        periodic_timer t2(std::move(t));
+        BOOST_TEST(t2.period() == std::chrono::seconds(1));
+    }
+
+    // Ticks stay on the grid of the first expiry
+    template<class Context>
+    void
+    testTicks(Context& ctx)
+    {
+        using namespace std::chrono_literals;
+
+        periodic_timer t(ctx);
+        auto const period = std::chrono::duration_cast<duration>(5ms);
+        auto const first = periodic_timer::clock_type::now() + period;
+        t.start(first, period);
+
+        std::uint64_t ticks = 0;
+        bool ok = true;
+        auto loop = [&]() -> capy::task<>
+        {
+            while (ticks < 5)
+            {
+                auto [ec, missed] = co_await t.wait();
+                if (ec)
+                {
+                    ok = false;
+                    co_return;
+                }
+                ticks += missed + 1;
+                if (t.expiry() !=
+                        first + period * static_cast<duration::rep>(ticks))
+                    ok = false;
+            }
+        };
+        capy::run_async(ctx.get_executor())(loop());
+        ctx.run();
+
+        BOOST_TEST(ok);
+        BOOST_TEST(ticks >= 5);
+        t.cancel();
+    }
+
+    // A loop that blocks for several periods is told how many it missed
+    template<class Context>
+    void
+    testLag(Context& ctx)
+    {
+        using namespace std::chrono_literals;
+
+        periodic_timer t(ctx);
+        t.start(5ms);
+
+        std::uint64_t missed_total = 0;
+        auto loop = [&]() -> capy::task<>
+        {
+            auto [ec, missed] = co_await t.wait();
+            BOOST_TEST(!ec);
+            std::this_thread::sleep_for(40ms);
+            auto [ec2, missed2] = co_await t.wait();
+            BOOST_TEST(!ec2);
+            missed_total = missed + missed2;
+        };
+        capy::run_async(ctx.get_executor())(loop());
+        ctx.run();
+
+        BOOST_TEST(missed_total >= 3);
+        t.cancel();
+    }
+
+    template<class Context>
+    void
+    testCancel(Context& ctx)
+    {
+        using namespace std::chrono_literals;
+
+        periodic_timer t(ctx);
+        t.start(std::chrono::hours(1));
+
+        timer stopper(ctx);
+        bool canceled = false;
+        auto waiter = [&]() -> capy::task<>
+        {
+            auto [ec, missed] = co_await t.wait();
+            canceled = ec == capy::cond::canceled;
+            BOOST_TEST_EQ(missed, 0u);
+        };
+        auto stop = [&]() -> capy::task<>
+        {
+            stopper.expires_after(5ms);
+            (void) co_await stopper.wait();
+            t.cancel();
+        };
+        capy::run_async(ctx.get_executor())(waiter());
+        capy::run_async(ctx.get_executor())(stop());
+        ctx.run();
+
+        BOOST_TEST(canceled);
+    }
+
+    template<class Make>
+    void
+    testQueue(Make make)
+    {
+        {
+            auto ctx = make();
+            testTicks(*ctx);
+        }
+        {
+            auto ctx = make();
+            testLag(*ctx);
+        }
+        {
+            auto ctx = make();
+            testCancel(*ctx);
+        }
+    }
+
+#if BOOST_COROSIO_HAS_EPOLL
+    void
+    testVirtualTime()
+    {
+        using namespace std::chrono_literals;
+
+        // Five and a half periods pass with no wait: the next wait
+        // completes at once with four missed, and the next tick is
+        // the sixth
+        epoll_context ctx(1, epoll_options{.timers = {
+            .virtual_time = true, .auto_advance = false}});
+        periodic_timer t(ctx);
+        auto const t0 = ctx.now();
+        t.start(1s);
+        test::advance_time(ctx, 5500ms);
+
+        std::uint64_t missed = 99;
+        auto loop = [&]() -> capy::task<>
+        {
+            auto [ec, m] = co_await t.wait();
+            BOOST_TEST(!ec);
+            missed = m;
+        };
+        capy::run_async(ctx.get_executor())(loop());
+        ctx.run();
+
+        BOOST_TEST_EQ(missed, 4u);
+        BOOST_TEST(t.expiry() == t0 + 6s);
+    }
+#endif
+
+    void
+    run()
+    {
+        testStart();
+        testQueue([] { return std::make_unique<io_context>(); });
+#if BOOST_COROSIO_HAS_EPOLL
+        testQueue([]
+        {
+            return std::make_unique<epoll_context>(1, epoll_options{
+                .timers = {.queue = timer_queue::wheel}});
+        });
+        testQueue([]
+        {
+            return std::make_unique<epoll_context>(1, epoll_options{
+                .timers = {.queue = timer_queue::sharded, .shards = 2}});
+        });
+        testVirtualTime();
+#endif
+    }
+};
+
+TEST_SUITE(periodic_timer_test, "boost.corosio.periodic_timer");
+
+} // namespace boost::corosio
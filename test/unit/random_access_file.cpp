@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/random_access_file.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Random access file tests
+// Focus: positioned reads and writes, end of file and the
+// synchronous size and flush calls.
+//------------------------------------------------
+
+namespace {
+
+std::atomic<int> next_file{0};
+
+// A fresh file path for each test, removed before use
+std::string
+make_file_path()
+{
+    auto p = std::filesystem::temp_directory_path() /
+        ("corosio_raf_" + std::to_string(next_file.fetch_add(1)) + ".bin");
+    std::filesystem::remove(p);
+    return p.string();
+}
+
+} // namespace
+
+struct random_access_file_test
+{
+    void
+    testOpenClose()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+
+        random_access_file f(ioc);
+        BOOST_TEST(!f.is_open());
+
+        f.open(path, file_base::read_write | file_base::create);
+        BOOST_TEST(f.is_open());
+        BOOST_TEST_EQ(f.size(), 0u);
+
+        f.close();
+        BOOST_TEST(!f.is_open());
+
+        // A missing file is not created without file_base::create
+        std::filesystem::remove(path);
+        BOOST_TEST_THROWS(
+            f.open(path, file_base::read_only), system::system_error);
+        BOOST_TEST(!f.is_open());
+        BOOST_TEST_THROWS(f.size(), std::logic_error);
+    }
+
+    void
+    testWriteReadAt()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+        random_access_file f(
+            ioc, path, file_base::read_write | file_base::create);
+
+        std::array<char, 16> buf{};
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, n1] = co_await f.write_some_at(
+                100, capy::const_buffer("world", 5));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, 5u);
+
+            auto [ec2, n2] = co_await f.write_some_at(
+                0, capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, 5u);
+
+            auto [ec3, n3] = co_await f.read_some_at(
+                100, capy::mutable_buffer(buf.data(), buf.size()));
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(std::string_view(buf.data(), n3), "world");
+
+            auto [ec4, n4] = co_await f.read_some_at(
+                0, capy::mutable_buffer(buf.data(), 5));
+            BOOST_TEST(!ec4);
+            BOOST_TEST_EQ(std::string_view(buf.data(), n4), "hello");
+
+            // The gap reads back as zeros
+            auto [ec5, n5] = co_await f.read_some_at(
+                50, capy::mutable_buffer(buf.data(), 4));
+            BOOST_TEST(!ec5);
+            BOOST_TEST_EQ(n5, 4u);
+            BOOST_TEST_EQ(std::string_view(buf.data(), 4),
+                std::string_view("\0\0\0\0", 4));
+
+            // Reading at the end reports it
+            auto [ec6, n6] = co_await f.read_some_at(
+                105, capy::mutable_buffer(buf.data(), buf.size()));
+            BOOST_TEST(ec6 == capy::cond::eof);
+            BOOST_TEST_EQ(n6, 0u);
+
+            // An empty buffer is not the end of the file
+            auto [ec7, n7] = co_await f.read_some_at(
+                105, capy::mutable_buffer(nullptr, 0));
+            BOOST_TEST(!ec7);
+            BOOST_TEST_EQ(n7, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(f.size(), 105u);
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    testResize()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+        random_access_file f(
+            ioc, path, file_base::read_write | file_base::create);
+
+        f.resize(4096);
+        BOOST_TEST_EQ(f.size(), 4096u);
+        f.resize(10);
+        BOOST_TEST_EQ(f.size(), 10u);
+
+        f.sync_data();
+        f.sync_all();
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    testCloseReopen()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+
+        {
+            random_access_file f(
+                ioc, path, file_base::write_only | file_base::create);
+            auto task = [&]() -> capy::task<>
+            {
+                auto [ec, n] = co_await f.write_some_at(
+                    0, capy::const_buffer("data", 4));
+                BOOST_TEST(!ec);
+                BOOST_TEST_EQ(n, 4u);
+            };
+            capy::run_async(ioc.get_executor())(task());
+            ioc.run();
+        }
+
+        // Truncating drops what the first file wrote
+        random_access_file f(ioc);
+        f.open(path, file_base::read_write | file_base::truncate);
+        BOOST_TEST_EQ(f.size(), 0u);
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    run()
+    {
+        testOpenClose();
+        testWriteReadAt();
+        testResize();
+        testCloseReopen();
+    }
+};
+
+TEST_SUITE(random_access_file_test, "boost.corosio.random_access_file");
+
+} // namespace boost::corosio
@@ -9,6 +9,7 @@
 
 // Test that header file is self-contained.
 #include <boost/corosio/resolver.hpp>
+#include <boost/corosio/detail/platform.hpp>
 
 // GCC emits false-positive "may be used uninitialized" warnings
 // for structured bindings with co_await expressions
@@ -22,6 +23,9 @@
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
 
+#include <memory_resource>
+#include <vector>
+
 #include "test_suite.hpp"
 
 namespace boost::corosio {
@@ -410,6 +414,37 @@ struct resolver_test
         BOOST_TEST_PASS();
     }
 
+    void
+    testCancelMany()
+    {
+        io_context ioc;
+
+        // More resolves than resolver threads, all attached to one
+        // lookup that is abandoned once every resolve is cancelled
+        constexpr int count = 40;
+        std::vector<resolver> resolvers;
+        resolvers.reserve(count);
+        for (int i = 0; i < count; ++i)
+            resolvers.emplace_back(ioc);
+
+        int completed = 0;
+        auto task = [](resolver& r_ref, int& done_out) -> capy::task<>
+        {
+            auto [ec, res] = co_await r_ref.resolve("localhost", "80");
+            BOOST_TEST(!ec || ec == capy::cond::canceled);
+            ++done_out;
+        };
+        for (auto& r : resolvers)
+            capy::run_async(ioc.get_executor())(task(r, completed));
+
+        for (auto& r : resolvers)
+            r.cancel();
+
+        ioc.run();
+
+        BOOST_TEST_EQ(completed, count);
+    }
+
     //--------------------------------------------
     // Sequential resolution tests
     //--------------------------------------------
@@ -455,6 +490,34 @@ struct resolver_test
         BOOST_TEST_EQ(resolve_count, 3);
     }
 
+    void
+    testConcurrentResolves()
+    {
+        io_context ioc;
+
+        constexpr int count = 64;
+        std::vector<resolver> resolvers;
+        resolvers.reserve(count);
+        for (int i = 0; i < count; ++i)
+            resolvers.emplace_back(ioc);
+
+        int succeeded = 0;
+        auto task = [](resolver& r_ref, int& count_out) -> capy::task<>
+        {
+            auto [ec, res] = co_await r_ref.resolve(
+                "127.0.0.1", "80",
+                resolve_flags::numeric_host | resolve_flags::numeric_service);
+            if (!ec && !res.empty())
+                ++count_out;
+        };
+        for (auto& r : resolvers)
+            capy::run_async(ioc.get_executor())(task(r, succeeded));
+
+        ioc.run();
+
+        BOOST_TEST_EQ(succeeded, count);
+    }
+
     //--------------------------------------------
     // io_result tests
     //--------------------------------------------
@@ -632,6 +695,65 @@ struct resolver_test
         BOOST_TEST_EQ(r2.size(), 1u);
     }
 
+    void
+    testResolverResultsMemoryResource()
+    {
+        std::pmr::monotonic_buffer_resource mr;
+
+        // A pmr vector's entries move in with its resource
+        std::pmr::vector<resolver_entry> entries(&mr);
+        entries.emplace_back(
+            endpoint(urls::ipv4_address({127, 0, 0, 1}), 80), "h", "80");
+        auto const* first = entries.data();
+        resolver_results r1(std::move(entries));
+        BOOST_TEST(r1.get_allocator().resource() == &mr);
+        BOOST_TEST(&*r1.begin() == first);
+
+        // A copy into a resource does not share the entries
+        resolver_results heap(std::vector<resolver_entry>(r1.begin(), r1.end()));
+        BOOST_TEST(heap.get_allocator().resource() ==
+            std::pmr::get_default_resource());
+        resolver_results r2(heap, &mr);
+        BOOST_TEST(r2.get_allocator().resource() == &mr);
+        BOOST_TEST_EQ(r2.size(), 1u);
+        BOOST_TEST(r2 != heap);
+        BOOST_TEST_EQ(r2.begin()->host_name(), "h");
+    }
+
+    void
+    testResolveMemoryResource()
+    {
+        io_context ioc;
+        resolver r(ioc);
+        BOOST_TEST(r.memory_resource() == std::pmr::get_default_resource());
+
+        std::pmr::monotonic_buffer_resource mr;
+        r.set_memory_resource(&mr);
+        BOOST_TEST(r.memory_resource() == &mr);
+
+        auto task = [](resolver& r_ref,
+                       std::pmr::memory_resource* mr) -> capy::task<>
+        {
+            // Answered by a worker, then copied in
+            auto [ec1, res1] = co_await r_ref.resolve(
+                "127.0.0.1", "80", resolve_flags::numeric_host);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(res1.size(), 1u);
+            BOOST_TEST(res1.get_allocator().resource() == mr);
+
+            // Answered without a lookup
+            r_ref.set_backend(resolver_backend::dns);
+            auto [ec2, res2] = co_await r_ref.resolve("127.0.0.1", "80");
+            BOOST_TEST(!ec2);
+            BOOST_TEST(res2.get_allocator().resource() == mr);
+        };
+        capy::run_async(ioc.get_executor())(task(r, &mr));
+        ioc.run();
+
+        resolver r2(std::move(r));
+        BOOST_TEST(r2.memory_resource() == &mr);
+    }
+
     //--------------------------------------------
     // Reverse resolution tests
     //--------------------------------------------
@@ -920,6 +1042,215 @@ struct resolver_test
         BOOST_TEST(completed);
     }
 
+    void
+    testIdenticalResolves()
+    {
+        io_context ioc;
+
+        constexpr int count = 32;
+        std::vector<resolver> resolvers;
+        resolvers.reserve(count);
+        for (int i = 0; i < count; ++i)
+            resolvers.emplace_back(ioc);
+
+        int succeeded = 0;
+
+        // Concurrent resolves of one query share a lookup
+        auto task = [](resolver& r_ref, int& count_out) -> capy::task<>
+        {
+            auto [ec, results] = co_await r_ref.resolve("localhost", "80");
+            if (!ec && !results.empty())
+            {
+                BOOST_TEST_EQ(results.begin()->get_endpoint().port(), 80);
+                ++count_out;
+            }
+        };
+        for (auto& r : resolvers)
+            capy::run_async(ioc.get_executor())(task(r, succeeded));
+
+        ioc.run();
+
+        BOOST_TEST_EQ(succeeded, count);
+    }
+
+    void
+    testCancelIdenticalResolve()
+    {
+        io_context ioc;
+        resolver r1(ioc);
+        resolver r2(ioc);
+
+        system::error_code ec1;
+        system::error_code ec2;
+        bool done1 = false;
+        bool done2 = false;
+
+        auto task = [](resolver& r_ref,
+                       system::error_code& ec_out,
+                       bool& done_out) -> capy::task<>
+        {
+            auto [ec, results] = co_await r_ref.resolve("localhost", "80");
+            ec_out = ec;
+            done_out = true;
+        };
+        capy::run_async(ioc.get_executor())(task(r1, ec1, done1));
+        capy::run_async(ioc.get_executor())(task(r2, ec2, done2));
+
+        // Cancelling one resolve leaves the other's lookup running
+        r1.cancel();
+
+        ioc.run();
+
+        BOOST_TEST(done1);
+        BOOST_TEST(done2);
+        BOOST_TEST(!ec1 || ec1 == capy::cond::canceled);
+        BOOST_TEST(!ec2);
+    }
+
+    //--------------------------------------------
+    // DNS cache tests
+    //--------------------------------------------
+
+    void
+    testResolveCache()
+    {
+        io_context ioc;
+        resolver_cache_options opts;
+        opts.max_entries = 16;
+        set_resolver_cache(ioc, opts);
+        resolver r(ioc);
+
+        bool completed = false;
+
+        auto task = [](resolver& r_ref, bool& done_out) -> capy::task<>
+        {
+            auto const flags =
+                resolve_flags::numeric_host | resolve_flags::numeric_service;
+
+            auto [ec1, res1] = co_await r_ref.resolve("127.0.0.1", "80", flags);
+            BOOST_TEST(!ec1);
+            BOOST_TEST(!res1.empty());
+
+            // Answered again, from the cache where there is one
+            auto [ec2, res2] = co_await r_ref.resolve("127.0.0.1", "80", flags);
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(res2.size(), res1.size());
+            if (!res1.empty() && !res2.empty())
+                BOOST_TEST(res2.begin()->get_endpoint() ==
+                    res1.begin()->get_endpoint());
+
+            // A different service is a different query
+            auto [ec3, res3] = co_await r_ref.resolve("127.0.0.1", "443", flags);
+            BOOST_TEST(!ec3);
+            if (!res3.empty())
+                BOOST_TEST_EQ(res3.begin()->get_endpoint().port(), 443);
+
+            // A host that does not exist fails again
+            auto [ec4, res4] = co_await r_ref.resolve("not-an-ip", "80", flags);
+            BOOST_TEST(ec4);
+            auto [ec5, res5] = co_await r_ref.resolve("not-an-ip", "80", flags);
+            BOOST_TEST(ec5);
+            BOOST_TEST(res5.empty());
+
+            done_out = true;
+        };
+        capy::run_async(ioc.get_executor())(task(r, completed));
+
+        ioc.run();
+
+        BOOST_TEST(completed);
+    }
+
+    void
+    testReverseResolveCache()
+    {
+        io_context ioc;
+        resolver_cache_options opts;
+        opts.max_reverse_entries = 16;
+        set_resolver_cache(ioc, opts);
+        resolver r(ioc);
+
+        bool completed = false;
+
+        auto task = [](resolver& r_ref, bool& done_out) -> capy::task<>
+        {
+            auto const flags =
+                reverse_flags::numeric_host | reverse_flags::numeric_service;
+            auto const addr = urls::ipv4_address::loopback();
+
+            auto [ec1, res1] = co_await r_ref.resolve(endpoint(addr, 80), flags);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(res1.host_name(), "127.0.0.1");
+            BOOST_TEST_EQ(res1.service_name(), "80");
+
+            // The same address on another port shares the entry
+            auto [ec2, res2] = co_await r_ref.resolve(endpoint(addr, 8080), flags);
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(res2.host_name(), "127.0.0.1");
+            BOOST_TEST_EQ(res2.service_name(), "8080");
+            BOOST_TEST(res2.endpoint().port() == 8080);
+
+            // Other flags are another query
+            auto [ec3, res3] = co_await r_ref.resolve(
+                endpoint(addr, 80), reverse_flags::numeric_host);
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(res3.host_name(), "127.0.0.1");
+
+            done_out = true;
+        };
+        capy::run_async(ioc.get_executor())(task(r, completed));
+
+        ioc.run();
+
+        BOOST_TEST(completed);
+    }
+
+    void
+    testDnsBackend()
+    {
+        io_context ioc;
+        resolver r(ioc);
+        BOOST_TEST(r.backend() == resolver_backend::system);
+        r.set_backend(resolver_backend::dns);
+
+        bool completed = false;
+
+        // Neither query reaches a name server
+        auto task = [](resolver& r_ref, bool& done_out) -> capy::task<>
+        {
+            auto [ec1, res1] = co_await r_ref.resolve("127.0.0.1", "80");
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(res1.size(), 1u);
+            if (!res1.empty())
+            {
+                auto ep = res1.begin()->get_endpoint();
+                BOOST_TEST(ep.is_v4());
+                BOOST_TEST_EQ(ep.port(), 80);
+            }
+
+            // Left to the system resolver
+            auto [ec2, res2] = co_await r_ref.resolve("localhost", "8080");
+            BOOST_TEST(!ec2);
+            BOOST_TEST(!res2.empty());
+
+            auto [ec3, res3] = co_await r_ref.resolve(
+                "not-an-ip", "80", resolve_flags::numeric_host);
+            BOOST_TEST(ec3);
+
+            done_out = true;
+        };
+        capy::run_async(ioc.get_executor())(task(r, completed));
+
+        ioc.run();
+
+        BOOST_TEST(completed);
+#if BOOST_COROSIO_POSIX
+        BOOST_TEST(r.backend() == resolver_backend::dns);
+#endif
+        r.set_backend(resolver_backend::system);
+        BOOST_TEST(r.backend() == resolver_backend::system);
+    }
+
     //--------------------------------------------
     // resolver_entry tests
     //--------------------------------------------
@@ -972,9 +1303,18 @@ struct resolver_test
         // Cancellation
         testCancel();
         testCancelNoOperation();
+        testCancelMany();
 
         // Sequential resolves
         testSequentialResolves();
+        testConcurrentResolves();
+        testIdenticalResolves();
+        testCancelIdenticalResolve();
+
+        // DNS cache
+        testResolveCache();
+        testReverseResolveCache();
+        testDnsBackend();
 
         // io_result
         testIoResultSuccess();
@@ -988,6 +1328,8 @@ struct resolver_test
         testResolverResultsEmpty();
         testResolverResultsIteration();
         testResolverResultsSwap();
+        testResolverResultsMemoryResource();
+        testResolveMemoryResource();
 
         // resolver_entry
         testResolverEntryConstruction();
@@ -22,6 +22,14 @@
 #include <boost/corosio/select_context.hpp>
 #endif
 
+#if BOOST_COROSIO_HAS_POLL
+#include <boost/corosio/poll_context.hpp>
+#endif
+
+#if BOOST_COROSIO_HAS_EPOLL
+#include <boost/corosio/epoll_context.hpp>
+#endif
+
 #include <csignal>
 #include <chrono>
 
@@ -846,4 +854,37 @@ struct signal_set_test_select : signal_set_test_impl<select_context> {};
 TEST_SUITE(signal_set_test_select, "boost.corosio.signal_set.select");
 #endif
 
+// POSIX: also test with poll_context explicitly
+#if BOOST_COROSIO_HAS_POLL
+struct signal_set_test_poll : signal_set_test_impl<poll_context> {};
+TEST_SUITE(signal_set_test_poll, "boost.corosio.signal_set.poll");
+#endif
+
+// Linux: also test signals read from a signalfd
+#if BOOST_COROSIO_HAS_EPOLL
+namespace {
+
+epoll_options
+signalfd_options()
+{
+    epoll_options opts;
+    opts.use_signalfd = true;
+    return opts;
+}
+
+struct signalfd_context : epoll_context
+{
+    signalfd_context()
+        : epoll_context(1, signalfd_options())
+    {
+        BOOST_TEST(stats().signalfd);
+    }
+};
+
+} // namespace
+
+struct signal_set_test_signalfd : signal_set_test_impl<signalfd_context> {};
+TEST_SUITE(signal_set_test_signalfd, "boost.corosio.signal_set.signalfd");
+#endif
+
 } // namespace boost::corosio
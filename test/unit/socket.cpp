@@ -16,6 +16,9 @@
 #if BOOST_COROSIO_HAS_SELECT
 #include <boost/corosio/select_context.hpp>
 #endif
+#if BOOST_COROSIO_HAS_POLL
+#include <boost/corosio/poll_context.hpp>
+#endif
 #include <boost/capy/buffers/string_dynamic_buffer.hpp>
 #include <boost/capy/read.hpp>
 #include <boost/capy/write.hpp>
@@ -34,12 +37,15 @@
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <stop_token>
+#include <string>
 #include <stdexcept>
 
 #if BOOST_COROSIO_POSIX
 #include <unistd.h>   // getpid()
 #else
+#include <io.h>       // _get_osfhandle()
 #include <process.h>  // _getpid()
 #endif
 
@@ -135,6 +141,40 @@ make_socket_pair_t(Context& ctx)
     return {std::move(s1), std::move(s2)};
 }
 
+// A temporary file holding the given bytes, for send_file
+class temp_file
+{
+    std::FILE* f_;
+
+public:
+    explicit temp_file(std::string_view data)
+        : f_(std::tmpfile())
+    {
+        if (!f_)
+            throw std::runtime_error("tmpfile failed");
+        std::fwrite(data.data(), 1, data.size(), f_);
+        std::fflush(f_);
+    }
+
+    ~temp_file()
+    {
+        std::fclose(f_);
+    }
+
+    temp_file(temp_file const&) = delete;
+    temp_file& operator=(temp_file const&) = delete;
+
+    native_file_type native_handle() const noexcept
+    {
+#if BOOST_COROSIO_POSIX
+        return ::fileno(f_);
+#else
+        return reinterpret_cast<native_file_type>(
+            ::_get_osfhandle(::_fileno(f_)));
+#endif
+    }
+};
+
 } // namespace
 
 // Verify socket satisfies stream concepts
@@ -206,6 +246,57 @@ struct socket_test_impl
         sock2.close();
     }
 
+    void
+    testRebind()
+    {
+        Context ioc1;
+        Context ioc2;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc1);
+        auto local = s1.local_endpoint();
+        auto remote = s1.remote_endpoint();
+
+#if BOOST_COROSIO_HAS_IOCP
+        BOOST_TEST_THROWS(s1.rebind(ioc2), std::system_error);
+        BOOST_TEST(s1.is_open());
+#else
+        s1.rebind(ioc2);
+        BOOST_TEST(&s1.context() == &static_cast<capy::execution_context&>(ioc2));
+        BOOST_TEST(s1.is_open());
+        BOOST_TEST(s1.local_endpoint() == local);
+        BOOST_TEST(s1.remote_endpoint() == remote);
+
+        // The connection survives, now driven by ioc2
+        auto write = [](socket& a) -> capy::task<>
+        {
+            auto [ec, n] = co_await a.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 5u);
+        };
+        auto read = [](socket& b) -> capy::task<>
+        {
+            char buf[32] = {};
+            auto [ec, n] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(std::string_view(buf, n), "hello");
+        };
+        capy::run_async(ioc2.get_executor())(write(s1));
+        ioc2.run();
+        capy::run_async(ioc1.get_executor())(read(s2));
+        ioc1.run();
+
+        // A closed socket only changes context
+        socket s3(ioc1);
+        s3.rebind(ioc2);
+        BOOST_TEST(&s3.context() == &static_cast<capy::execution_context&>(ioc2));
+        BOOST_TEST(!s3.is_open());
+#endif
+
+        s1.close();
+        s2.close();
+    }
+
     // Basic Read/Write Operations
 
     void
@@ -333,6 +424,50 @@ struct socket_test_impl
         s2.close();
     }
 
+    void
+    testReadyStreamYields()
+    {
+        // Writes and reads that complete immediately may resume inline,
+        // but a stream that is always ready must still let other work run
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        constexpr int n = 100;
+        bool other_ran = false;
+        bool other_ran_during_loop = false;
+        int done = 0;
+
+        auto loop = [&](socket& a, socket& b) -> capy::task<>
+        {
+            char c = 'x';
+            for (int i = 0; i < n; ++i)
+            {
+                auto [wec, wn] = co_await a.write_some(capy::const_buffer(&c, 1));
+                BOOST_TEST(!wec);
+                BOOST_TEST_EQ(wn, 1u);
+                auto [rec, rn] = co_await b.read_some(capy::mutable_buffer(&c, 1));
+                BOOST_TEST(!rec);
+                BOOST_TEST_EQ(rn, 1u);
+                BOOST_TEST_EQ(c, 'x');
+                ++done;
+            }
+            other_ran_during_loop = other_ran;
+        };
+        auto other = [&]() -> capy::task<>
+        {
+            other_ran = true;
+            co_return;
+        };
+        capy::run_async(ioc.get_executor())(loop(s1, s2));
+        capy::run_async(ioc.get_executor())(other());
+
+        ioc.run();
+        BOOST_TEST_EQ(done, n);
+        BOOST_TEST(other_ran_during_loop);
+        s1.close();
+        s2.close();
+    }
+
     void
     testBidirectionalSimultaneous()
     {
@@ -386,6 +521,47 @@ struct socket_test_impl
         s2.close();
     }
 
+    void
+    testReadLeased()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // Data may queue up before the first leased read
+            for (char const* msg : {"one", "two", "three"})
+            {
+                auto [ec, n] = co_await a.write_some(
+                    capy::const_buffer(msg, std::strlen(msg)));
+                BOOST_TEST(!ec);
+            }
+
+            std::string received;
+            while (received.size() < 11)
+            {
+                auto [ec, lease] = co_await b.read_leased();
+                BOOST_TEST(!ec);
+                if (ec)
+                    break;
+                BOOST_TEST(!lease.empty());
+                received.append(
+                    static_cast<char const*>(lease.data()), lease.size());
+            }
+            BOOST_TEST_EQ(received, "onetwothree");
+
+            a.close();
+            auto [ec, lease] = co_await b.read_leased();
+            BOOST_TEST(ec == capy::cond::eof);
+            BOOST_TEST(lease.empty());
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
     //------------------------------------------------
     // Buffer Variations
     //------------------------------------------------
@@ -507,6 +683,52 @@ struct socket_test_impl
         s2.close();
     }
 
+    void
+    testManyBuffers()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // More fragments than fit inline in an operation
+            constexpr std::size_t count = 100;
+            constexpr std::size_t frag = 8;
+            std::vector<char> send_data(count * frag);
+            for (std::size_t i = 0; i < send_data.size(); ++i)
+                send_data[i] = static_cast<char>(i & 0xFF);
+
+            std::array<capy::const_buffer, count> src;
+            for (std::size_t i = 0; i < count; ++i)
+                src[i] = capy::const_buffer(
+                    send_data.data() + i * frag, frag);
+
+            // Twice, so the second pass reuses the overflow storage
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                std::vector<char> recv_data(send_data.size());
+                std::array<capy::mutable_buffer, count> dst;
+                for (std::size_t i = 0; i < count; ++i)
+                    dst[i] = capy::mutable_buffer(
+                        recv_data.data() + i * frag, frag);
+
+                auto [ec1, n1] = co_await a.write_some(src);
+                BOOST_TEST(!ec1);
+                BOOST_TEST_EQ(n1, send_data.size());
+
+                auto [ec2, n2] = co_await b.read_some(dst);
+                BOOST_TEST(!ec2);
+                BOOST_TEST_EQ(n2, send_data.size());
+                BOOST_TEST(send_data == recv_data);
+            }
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
     // EOF and Closure Handling
 
     void
@@ -750,6 +972,68 @@ struct socket_test_impl
         s2.close();
     }
 
+    void
+    testStopTokenOtherToken()
+    {
+        // A backend may keep the registration of the first token it
+        // sees on a socket for later ops. Stopping that token must
+        // not cancel a later op started with a different token.
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        std::stop_source first;
+        std::stop_source second;
+        system::error_code first_ec;
+        system::error_code second_ec;
+        char second_byte = 0;
+
+        auto first_task = [&]() -> capy::task<>
+        {
+            char buf[1];
+            auto [ec, n] = co_await s2.read_some(
+                capy::mutable_buffer(buf, 1));
+            first_ec = ec;
+        };
+
+        auto second_task = [&]() -> capy::task<>
+        {
+            (void)co_await s2.write_some(capy::const_buffer("R", 1));
+            char buf[1];
+            auto [ec, n] = co_await s2.read_some(
+                capy::mutable_buffer(buf, 1));
+            second_ec = ec;
+            if (n == 1)
+                second_byte = buf[0];
+        };
+
+        auto control_task = [&]() -> capy::task<>
+        {
+            // Let the first read finish
+            (void)co_await s1.write_some(capy::const_buffer("x", 1));
+
+            // Start the second read and wait until it is parked
+            capy::run_async(ioc.get_executor(), second.get_token())(
+                second_task());
+            char buf[1];
+            (void)co_await s1.read_some(capy::mutable_buffer(buf, 1));
+
+            first.request_stop();
+            (void)co_await s1.write_some(capy::const_buffer("y", 1));
+        };
+
+        capy::run_async(ioc.get_executor(), first.get_token())(first_task());
+        capy::run_async(ioc.get_executor())(control_task());
+
+        ioc.run();
+
+        BOOST_TEST(!first_ec);
+        BOOST_TEST(!second_ec);
+        BOOST_TEST_EQ(second_byte, 'y');
+
+        s1.close();
+        s2.close();
+    }
+
     // Composed Operations
 
     void
@@ -864,58 +1148,70 @@ struct socket_test_impl
         s2.close();
     }
 
-    // Shutdown
-
     void
-    testShutdownSend()
+    testWriteAllReadExact()
     {
         Context ioc;
         auto [s1, s2] = make_socket_pair_t<Context>(ioc);
 
-        auto task = [](socket& a, socket& b) -> capy::task<>
-        {
-            // Write data then shutdown send
-            (void)co_await a.write_some(capy::const_buffer("hello", 5));
-            a.shutdown(socket::shutdown_send);
+        // Larger than the socket buffers, so both sides take parts
+        constexpr std::size_t size = 4 * 1024 * 1024;
+        std::vector<char> send_data(size);
+        for (std::size_t i = 0; i < size; ++i)
+            send_data[i] = static_cast<char>(i * 7);
+        std::vector<char> recv_data(size);
 
-            // Read the data
-            char buf[32] = {};
-            auto [ec1, n1] = co_await b.read_some(
-                capy::mutable_buffer(buf, sizeof(buf)));
-            BOOST_TEST(!ec1);
-            BOOST_TEST_EQ(std::string_view(buf, n1), "hello");
+        auto writer = [&](socket& a) -> capy::task<>
+        {
+            // Two buffers, so the split falls inside the sequence
+            std::array<capy::const_buffer, 2> bufs{{
+                capy::const_buffer(send_data.data(), size / 3),
+                capy::const_buffer(
+                    send_data.data() + size / 3, size - size / 3)}};
+            auto [ec, n] = co_await a.write_all(bufs);
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, size);
+        };
 
-            // Next read should get EOF
-            auto [ec2, n2] = co_await b.read_some(
-                capy::mutable_buffer(buf, sizeof(buf)));
-            BOOST_TEST(ec2 == capy::cond::eof);
+        auto reader = [&](socket& b) -> capy::task<>
+        {
+            auto [ec, n] = co_await b.read_exact(
+                capy::mutable_buffer(recv_data.data(), size));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, size);
         };
-        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        capy::run_async(ioc.get_executor())(writer(s1));
+        capy::run_async(ioc.get_executor())(reader(s2));
 
         ioc.run();
+        BOOST_TEST(send_data == recv_data);
         s1.close();
         s2.close();
     }
 
     void
-    testShutdownReceive()
+    testReadExactEOF()
     {
         Context ioc;
         auto [s1, s2] = make_socket_pair_t<Context>(ioc);
 
         auto task = [](socket& a, socket& b) -> capy::task<>
         {
-            // Shutdown receive on b
-            b.shutdown(socket::shutdown_receive);
-
-            // b can still send
-            (void)co_await b.write_some(capy::const_buffer("from_b", 6));
+            std::string send_data(50, 'Z');
+            auto [ec1, n1] = co_await a.write_all(capy::const_buffer(
+                send_data.data(), send_data.size()));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, 50u);
+            a.close();
 
-            char buf[32] = {};
-            auto [ec, n] = co_await a.read_some(
+            // The bytes read before EOF are reported with it
+            char buf[100] = {};
+            auto [ec2, n2] = co_await b.read_exact(
                 capy::mutable_buffer(buf, sizeof(buf)));
-            BOOST_TEST(!ec);
-            BOOST_TEST_EQ(std::string_view(buf, n), "from_b");
+            BOOST_TEST(ec2 == capy::error::eof);
+            BOOST_TEST_EQ(n2, 50u);
+            BOOST_TEST_EQ(std::string_view(buf, n2), send_data);
         };
         capy::run_async(ioc.get_executor())(task(s1, s2));
 
@@ -925,76 +1221,723 @@ struct socket_test_impl
     }
 
     void
-    testShutdownOnClosedSocket()
+    testReadExactCancel()
     {
         Context ioc;
-        socket sock(ioc);
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+        std::stop_source stop;
+        char buf[100] = {};
 
-        // Shutdown on closed socket should not crash
-        sock.shutdown(socket::shutdown_send);
-        sock.shutdown(socket::shutdown_receive);
-        sock.shutdown(socket::shutdown_both);
+        auto writer = [](socket& a) -> capy::task<>
+        {
+            (void)co_await a.write_all(capy::const_buffer("partial", 7));
+        };
+
+        auto reader = [&](socket& b) -> capy::task<>
+        {
+            auto [ec, n] = co_await b.read_exact(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(ec == capy::cond::canceled);
+            BOOST_TEST_EQ(n, 7u);
+        };
+
+        // Stop once the first part has been read
+        auto stopper = [&]() -> capy::task<>
+        {
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+            stop.request_stop();
+        };
+
+        capy::run_async(ioc.get_executor(), stop.get_token())(reader(s2));
+        capy::run_async(ioc.get_executor())(writer(s1));
+        capy::run_async(ioc.get_executor())(stopper());
+
+        ioc.run();
+        BOOST_TEST_EQ(std::string_view(buf, 7), "partial");
+        s1.close();
+        s2.close();
     }
 
+    // File transmission
+
     void
-    testShutdownBothSendDirection()
+    testSendFile()
     {
         Context ioc;
         auto [s1, s2] = make_socket_pair_t<Context>(ioc);
 
-        auto task = [](socket& a, socket& b) -> capy::task<>
+        // Larger than the socket buffers, so the transfer takes parts
+        constexpr std::size_t size = 1024 * 1024;
+        std::string data(size, '\0');
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<char>(i * 13);
+        temp_file file(data);
+        std::string recv_data(size, '\0');
+        char part[500] = {};
+
+        auto writer = [&](socket& a) -> capy::task<>
         {
-            // Write data then shutdown both
-            (void)co_await a.write_some(capy::const_buffer("goodbye", 7));
-            a.shutdown(socket::shutdown_both);
+            auto [ec1, n1] = co_await a.send_file(
+                file.native_handle(), 0, size);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, size);
 
-            // Peer should receive the data
-            char buf[32] = {};
-            auto [ec1, n1] = co_await b.read_some(
-                capy::mutable_buffer(buf, sizeof(buf)));
+            // A range inside the file
+            auto [ec2, n2] = co_await a.send_file(
+                file.native_handle(), 1000, sizeof(part));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, sizeof(part));
+        };
+
+        auto reader = [&](socket& b) -> capy::task<>
+        {
+            auto [ec1, n1] = co_await b.read_exact(
+                capy::mutable_buffer(recv_data.data(), size));
             BOOST_TEST(!ec1);
-            BOOST_TEST_EQ(std::string_view(buf, n1), "goodbye");
+            BOOST_TEST_EQ(n1, size);
 
-            // Next read should get EOF
-            auto [ec2, n2] = co_await b.read_some(
-                capy::mutable_buffer(buf, sizeof(buf)));
-            BOOST_TEST(ec2 == capy::cond::eof);
+            auto [ec2, n2] = co_await b.read_exact(
+                capy::mutable_buffer(part, sizeof(part)));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, sizeof(part));
         };
-        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        capy::run_async(ioc.get_executor())(writer(s1));
+        capy::run_async(ioc.get_executor())(reader(s2));
 
         ioc.run();
+        BOOST_TEST(recv_data == data);
+        BOOST_TEST_EQ(std::string_view(part, sizeof(part)),
+            std::string_view(data).substr(1000, sizeof(part)));
         s1.close();
         s2.close();
     }
 
-    // Socket Options
-
     void
-    testNoDelay()
+    testSendFileEOF()
     {
         Context ioc;
-        socket sock(ioc);
-        sock.open();
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+        temp_file file("0123456789abcdefghij");
 
-        // Default state may vary by platform, just test set/get works
-        sock.set_no_delay(true);
-        BOOST_TEST_EQ(sock.no_delay(), true);
+        auto task = [&](socket& a, socket& b) -> capy::task<>
+        {
+            // The bytes before the end of the file are reported with it
+            auto [ec1, n1] = co_await a.send_file(
+                file.native_handle(), 15, 100);
+            BOOST_TEST(ec1 == capy::error::eof);
+            BOOST_TEST_EQ(n1, 5u);
 
-        sock.set_no_delay(false);
-        BOOST_TEST_EQ(sock.no_delay(), false);
+            char buf[5] = {};
+            auto [ec2, n2] = co_await b.read_exact(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(std::string_view(buf, n2), "fghij");
 
-        sock.set_no_delay(true);
-        BOOST_TEST_EQ(sock.no_delay(), true);
+            // Nothing to send
+            auto [ec3, n3] = co_await a.send_file(
+                file.native_handle(), 0, 0);
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(n3, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
 
-        sock.close();
+        ioc.run();
+        s1.close();
+        s2.close();
     }
 
+    // Socket-to-socket relays
+
     void
-    testKeepAlive()
+    testSpliceTo()
     {
         Context ioc;
-        socket sock(ioc);
-        sock.open();
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+        auto [s3, s4] = make_socket_pair_t<Context>(ioc);
+
+        // Larger than the socket buffers, so the relay takes steps
+        constexpr std::size_t size = 1024 * 1024;
+        std::string data(size, '\0');
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<char>(i * 7);
+        std::string recv_data(size, '\0');
+
+        auto writer = [&](socket& a) -> capy::task<>
+        {
+            auto [ec, n] = co_await a.write_all(
+                capy::const_buffer(data.data(), size));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, size);
+            a.shutdown(socket::shutdown_send);
+        };
+
+        auto proxy = [&](socket& from, socket& to) -> capy::task<>
+        {
+            std::size_t total = 0;
+            for (;;)
+            {
+                auto [ec, n] = co_await from.splice_to(to, 65536);
+                total += n;
+                if (ec)
+                {
+                    // The writer's shutdown ends the relay
+                    BOOST_TEST(ec == capy::cond::eof);
+                    BOOST_TEST_EQ(n, 0u);
+                    break;
+                }
+                BOOST_TEST(n > 0);
+                BOOST_TEST(n <= 65536u);
+            }
+            BOOST_TEST_EQ(total, size);
+
+            // Nothing to move
+            auto [ec, n] = co_await from.splice_to(to, 0);
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 0u);
+        };
+
+        auto reader = [&](socket& b) -> capy::task<>
+        {
+            auto [ec, n] = co_await b.read_exact(
+                capy::mutable_buffer(recv_data.data(), size));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, size);
+        };
+
+        capy::run_async(ioc.get_executor())(writer(s1));
+        capy::run_async(ioc.get_executor())(proxy(s2, s3));
+        capy::run_async(ioc.get_executor())(reader(s4));
+
+        ioc.run();
+        BOOST_TEST(recv_data == data);
+
+        socket closed(ioc);
+        BOOST_TEST_THROWS(s2.splice_to(closed, 1), std::logic_error);
+
+        s1.close();
+        s2.close();
+        s3.close();
+        s4.close();
+    }
+
+    // Zero-copy sends
+
+    void
+    testZeroCopy()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        try
+        {
+            s1.set_zero_copy(true);
+        }
+        catch (system::system_error const& e)
+        {
+            // Not every backend or kernel has zero-copy sends
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+            BOOST_TEST(!s1.zero_copy());
+            s1.close();
+            s2.close();
+            return;
+        }
+        BOOST_TEST(s1.zero_copy());
+
+        // Large enough to take the zero-copy path in several parts
+        constexpr std::size_t size = 1024 * 1024;
+        std::string data(size, '\0');
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<char>(i * 7);
+        std::string recv_data(size, '\0');
+
+        auto writer = [&](socket& a) -> capy::task<>
+        {
+            auto [ec1, n1] = co_await a.write_all(
+                capy::const_buffer(data.data(), size));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, size);
+
+            // Small writes are copied as usual
+            auto [ec2, n2] = co_await a.write_some(
+                capy::const_buffer("tail", 4));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, 4u);
+        };
+
+        char tail[4] = {};
+        auto reader = [&](socket& b) -> capy::task<>
+        {
+            auto [ec1, n1] = co_await b.read_exact(
+                capy::mutable_buffer(recv_data.data(), size));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, size);
+
+            auto [ec2, n2] = co_await b.read_exact(
+                capy::mutable_buffer(tail, sizeof(tail)));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, sizeof(tail));
+        };
+
+        capy::run_async(ioc.get_executor())(writer(s1));
+        capy::run_async(ioc.get_executor())(reader(s2));
+
+        ioc.run();
+        BOOST_TEST(recv_data == data);
+        BOOST_TEST_EQ(std::string_view(tail, 4), "tail");
+
+        s1.set_zero_copy(false);
+        BOOST_TEST(!s1.zero_copy());
+        s1.close();
+        s2.close();
+    }
+
+    // Write coalescing
+
+    void
+    testWriteCoalescing()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        try
+        {
+            s1.set_write_coalescing(true);
+        }
+        catch (system::system_error const& e)
+        {
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+            BOOST_TEST(!s1.write_coalescing());
+            s1.close();
+            s2.close();
+            return;
+        }
+        BOOST_TEST(s1.write_coalescing());
+
+        // A message written in parts, then a reply awaited, as in
+        // a request/response exchange
+        auto client = [](socket& a) -> capy::task<>
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                auto [ec1, n1] = co_await a.write_some(
+                    capy::const_buffer("head", 4));
+                BOOST_TEST(!ec1);
+                BOOST_TEST_EQ(n1, 4u);
+                auto [ec2, n2] = co_await a.write_some(
+                    capy::const_buffer("body", 4));
+                BOOST_TEST(!ec2);
+                BOOST_TEST_EQ(n2, 4u);
+
+                char reply[2] = {};
+                auto [ec3, n3] = co_await a.read_exact(
+                    capy::mutable_buffer(reply, sizeof(reply)));
+                BOOST_TEST(!ec3);
+                BOOST_TEST_EQ(std::string_view(reply, n3), "ok");
+            }
+        };
+
+        auto server = [](socket& b) -> capy::task<>
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                char msg[8] = {};
+                auto [ec1, n1] = co_await b.read_exact(
+                    capy::mutable_buffer(msg, sizeof(msg)));
+                BOOST_TEST(!ec1);
+                BOOST_TEST_EQ(std::string_view(msg, n1), "headbody");
+
+                auto [ec2, n2] = co_await b.write_some(
+                    capy::const_buffer("ok", 2));
+                BOOST_TEST(!ec2);
+                BOOST_TEST_EQ(n2, 2u);
+            }
+        };
+
+        capy::run_async(ioc.get_executor())(client(s1));
+        capy::run_async(ioc.get_executor())(server(s2));
+
+        ioc.run();
+
+        s1.set_write_coalescing(false);
+        BOOST_TEST(!s1.write_coalescing());
+        s1.close();
+        s2.close();
+    }
+
+    // High priority completions
+
+    void
+    testHighPriorityCompletions()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        try
+        {
+            s2.set_high_priority_completions(true);
+        }
+        catch (system::system_error const& e)
+        {
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+            s1.close();
+            s2.close();
+            return;
+        }
+        BOOST_TEST(s2.high_priority_completions());
+        BOOST_TEST(!s1.high_priority_completions());
+
+        // Flagged reads still complete with bulk traffic queued
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                auto [ec1, n1] = co_await a.write_some(
+                    capy::const_buffer("ping", 4));
+                BOOST_TEST(!ec1);
+                char buf[4] = {};
+                auto [ec2, n2] = co_await b.read_exact(
+                    capy::mutable_buffer(buf, sizeof(buf)));
+                BOOST_TEST(!ec2);
+                BOOST_TEST_EQ(std::string_view(buf, n2), "ping");
+            }
+        };
+        int bulk = 0;
+        for (int i = 0; i < 64; ++i)
+            capy::run_async(ioc.get_executor())(
+                [](int& n) -> capy::task<> { ++n; co_return; }(bulk));
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+        ioc.run();
+        BOOST_TEST_EQ(bulk, 64);
+
+        // Closing clears the flag
+        s2.close();
+        s2.open();
+        BOOST_TEST(!s2.high_priority_completions());
+        s1.close();
+        s2.close();
+    }
+
+    // Connection statistics
+
+    void
+    testTcpInfo()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            auto [ec1, n1] = co_await a.write_some(
+                capy::const_buffer("ping", 4));
+            BOOST_TEST(!ec1);
+            char buf[4] = {};
+            auto [ec2, n2] = co_await b.read_exact(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec2);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+        ioc.run();
+
+        try
+        {
+            auto st = s1.tcp_info();
+            BOOST_TEST(st.mss > 0);
+            BOOST_TEST(st.congestion_window > 0);
+            BOOST_TEST(st.rtt.count() >= 0);
+        }
+        catch (system::system_error const& e)
+        {
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+        }
+
+        s1.close();
+        BOOST_TEST_THROWS(s1.tcp_info(), std::logic_error);
+        s2.close();
+    }
+
+    void
+    testTimestamping()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        try
+        {
+            s2.set_timestamping(true);
+        }
+        catch (system::system_error const& e)
+        {
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+            BOOST_TEST(!s2.timestamping());
+            s1.close();
+            s2.close();
+            return;
+        }
+        BOOST_TEST(s2.timestamping());
+        BOOST_TEST(s2.last_receive_time() ==
+            std::chrono::system_clock::time_point{});
+
+        auto before = std::chrono::system_clock::now();
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            auto [ec1, n1] = co_await a.write_some(
+                capy::const_buffer("ping", 4));
+            BOOST_TEST(!ec1);
+            char buf[4] = {};
+            auto [ec2, n2] = co_await b.read_exact(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec2);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+        ioc.run();
+
+        // The kernel stamped the data between the write and the read
+        auto t = s2.last_receive_time();
+        BOOST_TEST(t >= before - std::chrono::seconds(1));
+        BOOST_TEST(t <= std::chrono::system_clock::now());
+
+        s2.set_timestamping(false);
+        BOOST_TEST(!s2.timestamping());
+        s1.close();
+        s2.close();
+    }
+
+    // Shutdown
+
+    void
+    testShutdownSend()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // Write data then shutdown send
+            (void)co_await a.write_some(capy::const_buffer("hello", 5));
+            a.shutdown(socket::shutdown_send);
+
+            // Read the data
+            char buf[32] = {};
+            auto [ec1, n1] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(std::string_view(buf, n1), "hello");
+
+            // Next read should get EOF
+            auto [ec2, n2] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(ec2 == capy::cond::eof);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testShutdownReceive()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // Shutdown receive on b
+            b.shutdown(socket::shutdown_receive);
+
+            // b can still send
+            (void)co_await b.write_some(capy::const_buffer("from_b", 6));
+
+            char buf[32] = {};
+            auto [ec, n] = co_await a.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(std::string_view(buf, n), "from_b");
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testShutdownOnClosedSocket()
+    {
+        Context ioc;
+        socket sock(ioc);
+
+        // Shutdown on closed socket should not crash
+        sock.shutdown(socket::shutdown_send);
+        sock.shutdown(socket::shutdown_receive);
+        sock.shutdown(socket::shutdown_both);
+    }
+
+    void
+    testShutdownBothSendDirection()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // Write data then shutdown both
+            (void)co_await a.write_some(capy::const_buffer("goodbye", 7));
+            a.shutdown(socket::shutdown_both);
+
+            // Peer should receive the data
+            char buf[32] = {};
+            auto [ec1, n1] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(std::string_view(buf, n1), "goodbye");
+
+            // Next read should get EOF
+            auto [ec2, n2] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(ec2 == capy::cond::eof);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    // Deadlines
+
+    void
+    testReadDeadline()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            // Nothing is sent, so the read times out
+            char buf[32];
+            auto start = std::chrono::steady_clock::now();
+            auto [ec, n] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)),
+                start + std::chrono::milliseconds(20));
+            BOOST_TEST(ec == system::errc::timed_out);
+            BOOST_TEST_EQ(n, 0u);
+            BOOST_TEST(std::chrono::steady_clock::now() - start >=
+                std::chrono::milliseconds(20));
+
+            // The stream is still usable, and a read that completes
+            // in time is unaffected by its deadline
+            (void)co_await a.write_some(capy::const_buffer("hi", 2));
+            auto [ec2, n2] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)),
+                std::chrono::steady_clock::now() + std::chrono::seconds(5));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, 2u);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testWriteDeadline()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [](socket& a) -> capy::task<>
+        {
+            // A write with room in the send buffer completes in time
+            auto [ec, n] = co_await a.write_some(
+                capy::const_buffer("hello", 5),
+                std::chrono::steady_clock::now() + std::chrono::seconds(5));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 5u);
+
+            // A deadline already passed cancels the write
+            auto [ec2, n2] = co_await a.write_some(
+                capy::const_buffer("hello", 5),
+                std::chrono::steady_clock::now() - std::chrono::seconds(1));
+            BOOST_TEST(ec2 == system::errc::timed_out);
+        };
+        capy::run_async(ioc.get_executor())(task(s1));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testDeadlineStopToken()
+    {
+        // The caller's stop token still cancels, and is reported as
+        // cancellation rather than a timeout
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        std::stop_source stop_src;
+        system::error_code read_ec;
+
+        auto reader_task = [&]() -> capy::task<>
+        {
+            char buf[32];
+            auto [ec, n] = co_await s2.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)),
+                std::chrono::steady_clock::now() + std::chrono::seconds(30));
+            read_ec = ec;
+        };
+
+        auto canceller_task = [&]() -> capy::task<>
+        {
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(10));
+            (void)co_await t.wait();
+            stop_src.request_stop();
+        };
+
+        capy::run_async(ioc.get_executor(), stop_src.get_token())(reader_task());
+        capy::run_async(ioc.get_executor())(canceller_task());
+
+        ioc.run();
+        BOOST_TEST(read_ec == capy::cond::canceled);
+        s1.close();
+        s2.close();
+    }
+
+    // Socket Options
+
+    void
+    testNoDelay()
+    {
+        Context ioc;
+        socket sock(ioc);
+        sock.open();
+
+        // Default state may vary by platform, just test set/get works
+        sock.set_no_delay(true);
+        BOOST_TEST_EQ(sock.no_delay(), true);
+
+        sock.set_no_delay(false);
+        BOOST_TEST_EQ(sock.no_delay(), false);
+
+        sock.set_no_delay(true);
+        BOOST_TEST_EQ(sock.no_delay(), true);
+
+        sock.close();
+    }
+
+    void
+    testKeepAlive()
+    {
+        Context ioc;
+        socket sock(ioc);
+        sock.open();
 
         sock.set_keep_alive(true);
         BOOST_TEST_EQ(sock.keep_alive(), true);
@@ -1075,6 +2018,46 @@ struct socket_test_impl
         sock.close();
     }
 
+    void
+    testTuningOptions()
+    {
+        Context ioc;
+        socket sock(ioc);
+        BOOST_TEST_THROWS(sock.set_quick_ack(true), std::logic_error);
+
+        sock.open();
+#if defined(__linux__)
+        sock.set_not_sent_low_watermark(16384);
+        BOOST_TEST_EQ(sock.not_sent_low_watermark(), 16384u);
+
+        sock.set_quick_ack(true);
+        BOOST_TEST(sock.quick_ack());
+        sock.set_quick_ack(false);
+        BOOST_TEST(!sock.quick_ack());
+
+        sock.set_user_timeout(std::chrono::milliseconds(5000));
+        BOOST_TEST(sock.user_timeout() == std::chrono::milliseconds(5000));
+
+        sock.set_priority(3);
+        BOOST_TEST_EQ(sock.priority(), 3);
+
+        (void)sock.incoming_cpu();
+        BOOST_TEST(sock.busy_poll() >= std::chrono::microseconds(0));
+#elif BOOST_COROSIO_HAS_IOCP
+        bool threw = false;
+        try
+        {
+            sock.set_quick_ack(true);
+        }
+        catch (system::system_error const& e)
+        {
+            threw = e.code() == system::errc::operation_not_supported;
+        }
+        BOOST_TEST(threw);
+#endif
+        sock.close();
+    }
+
     void
     testLingerValidation()
     {
@@ -1328,6 +2311,158 @@ struct socket_test_impl
         acc.close();
     }
 
+    void
+    testConnectWithData()
+    {
+        Context ioc;
+        acceptor acc(ioc);
+        acceptor::listen_options opts;
+        opts.fast_open_queue = 16;
+        try
+        {
+            acc.listen(endpoint(urls::ipv4_address::loopback(), 0), opts);
+        }
+        catch (system::system_error const&)
+        {
+            // No server Fast Open; the data then follows the handshake
+            acc = acceptor(ioc);
+            acc.listen(endpoint(urls::ipv4_address::loopback(), 0));
+        }
+        endpoint ep(urls::ipv4_address::loopback(), acc.local_endpoint().port());
+
+        // The first connection fetches the cookie the second may use,
+        // and the request must arrive whole either way
+        std::string const request = "GET / HTTP/1.1\r\n\r\n";
+        int delivered = 0;
+
+        auto serve_one = [&]() -> capy::task<>
+        {
+            socket server(ioc);
+            auto [ec] = co_await acc.accept(server);
+            BOOST_TEST(!ec);
+            if (ec)
+                co_return;
+
+            std::string got(request.size(), '\0');
+            auto [rec, rn] = co_await server.read_exact(
+                capy::mutable_buffer(got.data(), got.size()));
+            BOOST_TEST(!rec);
+            if (got == request)
+                ++delivered;
+        };
+
+        auto task = [&]() -> capy::task<>
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                capy::run_async(ioc.get_executor())(serve_one());
+
+                socket client(ioc);
+                client.open();
+                auto [ec, n] = co_await client.connect(
+                    ep, capy::const_buffer(request.data(), request.size()));
+                BOOST_TEST(!ec);
+                BOOST_TEST(n <= request.size());
+                if (ec)
+                    co_return;
+                BOOST_TEST(client.remote_endpoint() == ep);
+
+                auto [wec, wn] = co_await client.write_all(capy::const_buffer(
+                    request.data() + n, request.size() - n));
+                BOOST_TEST(!wec);
+            }
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(delivered, 2);
+        acc.close();
+    }
+
+    void
+    testWait()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [&](socket& a, socket& b) -> capy::task<>
+        {
+            // A connected socket with room in its buffer is writable
+            auto [wec] = co_await a.wait(socket::wait_type::write);
+            if (wec == system::errc::operation_not_supported)
+                co_return;
+            BOOST_TEST(!wec);
+
+            bool ready = false;
+            system::error_code rec;
+            auto waiter = [&]() -> capy::task<>
+            {
+                auto [ec] = co_await b.wait(socket::wait_type::read);
+                rec = ec;
+                ready = true;
+            };
+            capy::run_async(ioc.get_executor())(waiter());
+
+            // Nothing to read yet
+            timer t(a.context());
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+            BOOST_TEST(!ready);
+
+            auto [ec, n] = co_await a.write_some(
+                capy::const_buffer("ping", 4));
+            BOOST_TEST(!ec);
+
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+            BOOST_TEST(ready);
+            BOOST_TEST(!rec);
+
+            // The wait took no data
+            char buf[4] = {};
+            auto [rec2, rn] = co_await b.read_exact(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!rec2);
+            BOOST_TEST_EQ(std::string(buf, rn), "ping");
+
+            // A closed peer makes the socket readable; the read
+            // that follows reports the end of the stream
+            a.close();
+            auto [cec] = co_await b.wait(socket::wait_type::read);
+            BOOST_TEST(!cec);
+            auto [eec, en] = co_await b.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(eec == capy::cond::eof);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testWaitCancel()
+    {
+        Context ioc;
+        auto [s1, s2] = make_socket_pair_t<Context>(ioc);
+
+        auto task = [&](socket& b) -> capy::task<>
+        {
+            auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(50);
+            auto [ec] = co_await b.wait(socket::wait_type::read, deadline);
+            if (ec == system::errc::operation_not_supported)
+                co_return;
+            BOOST_TEST(ec == system::errc::timed_out);
+        };
+        capy::run_async(ioc.get_executor())(task(s2));
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
     void
     testEndpointOnClosedSocket()
     {
@@ -1500,18 +2635,22 @@ struct socket_test_impl
         testOpen();
         testMoveConstruct();
         testMoveAssign();
+        testRebind();
 
         // Basic I/O
         testReadSome();
         testWriteSome();
         testPartialRead();
         testSequentialReadWrite();
+        testReadyStreamYields();
         testBidirectionalSimultaneous();
+        testReadLeased();
 
         // Buffer variations
         testEmptyBuffer();
         testSmallBuffer();
         testLargeBuffer();
+        testManyBuffers();
 
         // EOF and closure
         testReadAfterPeerClose();
@@ -1527,6 +2666,12 @@ struct socket_test_impl
         testCancelRead();
         testCloseWhileReading();
         testStopTokenCancellation();
+        testStopTokenOtherToken();
+
+        // Deadlines
+        testReadDeadline();
+        testWriteDeadline();
+        testDeadlineStopToken();
 
         // Socket options
         testNoDelay();
@@ -1535,6 +2680,7 @@ struct socket_test_impl
         testSendBufferSize();
         testLinger();
         testLingerValidation();
+        testTuningOptions();
         testSocketOptionsOnConnectedSocket();
 
         // Composed operations
@@ -1542,6 +2688,36 @@ struct socket_test_impl
         testWriteFull();
         testReadString();
         testReadPartialEOF();
+        testWriteAllReadExact();
+        testReadExactEOF();
+        testReadExactCancel();
+
+        // File transmission
+        testSendFile();
+        testSendFileEOF();
+
+        // Socket-to-socket relays
+        testSpliceTo();
+
+        // Zero-copy sends
+        testZeroCopy();
+
+        // Write coalescing
+        testWriteCoalescing();
+
+        // High priority completions
+        testHighPriorityCompletions();
+
+        // Connection statistics
+        testTcpInfo();
+        testTimestamping();
+
+        // TCP Fast Open
+        testConnectWithData();
+
+        // Readiness waits
+        testWait();
+        testWaitCancel();
 
         // Data integrity
         testLargeTransfer();
@@ -1570,4 +2746,216 @@ struct socket_test_select : socket_test_impl<select_context> {};
 TEST_SUITE(socket_test_select, "boost.corosio.socket.select");
 #endif
 
+#if BOOST_COROSIO_HAS_POLL
+// Poll backend test (POSIX platforms)
+struct socket_test_poll : socket_test_impl<poll_context> {};
+TEST_SUITE(socket_test_poll, "boost.corosio.socket.poll");
+#endif
+
+#if BOOST_COROSIO_HAS_IOCP
+// IOCP dequeuing one completion per call instead of a batch
+struct iocp_unbatched_context : iocp_context
+{
+    iocp_unbatched_context()
+        : iocp_context(1, iocp_options{.completion_batch = 1})
+    {
+    }
+};
+
+struct socket_test_iocp_unbatched : socket_test_impl<iocp_unbatched_context> {};
+TEST_SUITE(socket_test_iocp_unbatched, "boost.corosio.socket.iocp_unbatched");
+
+// IOCP with sockets created for Registered I/O
+struct iocp_rio_context : iocp_context
+{
+    iocp_rio_context()
+        : iocp_context(1, iocp_options{.registered_io = true})
+    {
+    }
+};
+
+struct socket_test_iocp_rio : socket_test_impl<iocp_rio_context> {};
+TEST_SUITE(socket_test_iocp_rio, "boost.corosio.socket.iocp_rio");
+
+// IOCP with readiness waits polling the AFD driver
+struct iocp_afd_context : iocp_context
+{
+    iocp_afd_context()
+        : iocp_context(1, iocp_options{.afd_poll = true})
+    {
+    }
+};
+
+struct socket_test_iocp_afd : socket_test_impl<iocp_afd_context> {};
+TEST_SUITE(socket_test_iocp_afd, "boost.corosio.socket.iocp_afd");
+
+// Reads and writes on registered buffers
+struct socket_test_iocp_rio_buffers
+{
+    void
+    testRegisteredBuffers()
+    {
+        iocp_rio_context ioc;
+        if (!ioc.registered_io())
+            return;  // RIO unavailable on this system
+
+        std::array<char, 64> arena{};
+        capy::mutable_buffer arena_buf(arena.data(), arena.size());
+        ioc.register_buffers({&arena_buf, 1});
+
+        auto [s1, s2] = make_socket_pair_t(ioc);
+
+        auto task = [](socket& a, socket& b, char* region) -> capy::task<>
+        {
+            // Both ends inside the arena go through RIO
+            std::memcpy(region, "hello", 5);
+            auto [wec, wn] = co_await a.write_some(
+                capy::const_buffer(region, 5));
+            BOOST_TEST(!wec);
+            BOOST_TEST_EQ(wn, 5u);
+
+            std::size_t got = 0;
+            while (got < 5)
+            {
+                auto [ec, n] = co_await b.read_some(
+                    capy::mutable_buffer(region + 16 + got, 16 - got));
+                BOOST_TEST(!ec);
+                if (ec)
+                    break;
+                got += n;
+            }
+            BOOST_TEST_EQ(std::string(region + 16, got), "hello");
+
+            // A buffer outside the arena still reads normally
+            co_await a.write_some(capy::const_buffer("x", 1));
+            char c = 0;
+            auto [ec, n] = co_await b.read_some(capy::mutable_buffer(&c, 1));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(c, 'x');
+
+            // Closing the peer ends a registered read with EOF
+            a.close();
+            auto [eec, en] = co_await b.read_some(
+                capy::mutable_buffer(region + 32, 16));
+            BOOST_TEST(eec == capy::cond::eof);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2, arena.data()));
+
+        ioc.run();
+        s2.close();
+        ioc.unregister_buffers();
+    }
+
+    void
+    run()
+    {
+        testRegisteredBuffers();
+    }
+};
+
+TEST_SUITE(socket_test_iocp_rio_buffers, "boost.corosio.socket.iocp_rio_buffers");
+#endif
+
+#if BOOST_COROSIO_HAS_IO_URING
+// io_uring with a receive pool small enough that leased reads
+// split messages, throttle, and exhaust it
+struct io_uring_pool_context : io_uring_context
+{
+    io_uring_pool_context()
+        : io_uring_context(1, io_uring_options{
+            .buffer_count = 4, .buffer_size = 4})
+    {
+    }
+};
+
+struct socket_test_io_uring_pool : socket_test_impl<io_uring_pool_context> {};
+TEST_SUITE(socket_test_io_uring_pool, "boost.corosio.socket.io_uring_pool");
+
+// io_uring with a kernel thread polling the submission queue
+struct io_uring_sqpoll_context : io_uring_context
+{
+    io_uring_sqpoll_context()
+        : io_uring_context(1, io_uring_options{
+            .sq_poll = true, .sq_thread_idle = 10})
+    {
+    }
+};
+
+struct socket_test_io_uring_sqpoll : socket_test_impl<io_uring_sqpoll_context> {};
+TEST_SUITE(socket_test_io_uring_sqpoll, "boost.corosio.socket.io_uring_sqpoll");
+
+// Registered files and fixed-buffer reads
+struct socket_test_io_uring_registered
+{
+    void
+    testRegisteredIo()
+    {
+        io_uring_context ioc(1, io_uring_options{.registered_files = 2});
+        auto [s1, s2] = make_socket_pair_t(ioc);
+
+        BOOST_TEST(ioc.register_file(s1));
+        BOOST_TEST(ioc.register_file(s2));
+        BOOST_TEST(ioc.register_file(s2));  // already registered
+
+        // The table is full
+        socket s3(ioc);
+        s3.open();
+        BOOST_TEST(!ioc.register_file(s3));
+        s3.close();
+
+        std::array<char, 64> arena{};
+        capy::mutable_buffer arena_buf(arena.data(), arena.size());
+        ioc.register_buffers({&arena_buf, 1});
+
+        auto task = [](socket& a, socket& b, char* region) -> capy::task<>
+        {
+            auto [wec, wn] = co_await a.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!wec);
+            BOOST_TEST_EQ(wn, 5u);
+
+            // A sub-range of the arena reads as a fixed buffer
+            std::size_t got = 0;
+            while (got < 5)
+            {
+                auto [ec, n] = co_await b.read_some(
+                    capy::mutable_buffer(region + got, 16 - got));
+                BOOST_TEST(!ec);
+                if (ec)
+                    break;
+                got += n;
+            }
+            BOOST_TEST_EQ(std::string(region, got), "hello");
+
+            // Closing empties the slot, so the peer sees EOF
+            a.close();
+            char c;
+            auto [ec, n] = co_await b.read_some(capy::mutable_buffer(&c, 1));
+            BOOST_TEST(ec == capy::cond::eof);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2, arena.data() + 8));
+
+        ioc.run();
+        ioc.restart();
+        s2.close();
+        ioc.unregister_buffers();
+
+        // Both slots are free again
+        auto [s4, s5] = make_socket_pair_t(ioc);
+        BOOST_TEST(ioc.register_file(s4));
+        BOOST_TEST(ioc.register_file(s5));
+        s4.close();
+        s5.close();
+    }
+
+    void
+    run()
+    {
+        testRegisteredIo();
+    }
+};
+
+TEST_SUITE(socket_test_io_uring_registered, "boost.corosio.socket.io_uring_registered");
+#endif
+
 } // namespace boost::corosio
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/socket_stats.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <chrono>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+struct socket_stats_test
+{
+    void
+    testRatios()
+    {
+        socket_stats st;
+        BOOST_TEST_EQ(st.read_fast_path_ratio(), 0.0);
+        BOOST_TEST_EQ(st.write_fast_path_ratio(), 0.0);
+
+        st.reads_immediate = 3;
+        st.reads_waited = 1;
+        st.writes_immediate = 2;
+        BOOST_TEST_EQ(st.read_fast_path_ratio(), 0.75);
+        BOOST_TEST_EQ(st.write_fast_path_ratio(), 1.0);
+    }
+
+    template<class Context>
+    void
+    testCounters()
+    {
+        using namespace std::chrono_literals;
+
+        Context ctx;
+        BOOST_TEST_EQ(collect_socket_stats(ctx).live_sockets, 0u);
+
+        auto [s1, s2] = test::make_socket_pair(ctx);
+        auto st = collect_socket_stats(ctx);
+        BOOST_TEST_EQ(st.live_sockets, 2u);
+        BOOST_TEST_EQ(st.accepts, 1u);
+
+        // The first read parks until the writer sends, the second
+        // parks until the writer cancels it
+        auto reader = [](socket& s, bool& cancelled) -> capy::task<>
+        {
+            char buf[16];
+            auto [ec, n] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 5u);
+            auto [ec2, n2] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            cancelled = ec2 == capy::error::canceled;
+        };
+        auto writer = [](socket& s, socket& peer, timer& t) -> capy::task<>
+        {
+            auto [ec, n] = co_await s.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 5u);
+            t.expires_after(10ms);
+            (void) co_await t.wait();
+            peer.cancel();
+        };
+
+        bool cancelled = false;
+        timer t(ctx);
+        capy::run_async(ctx.get_executor())(reader(s2, cancelled));
+        capy::run_async(ctx.get_executor())(writer(s1, s2, t));
+        ctx.run();
+        BOOST_TEST(cancelled);
+
+        st = collect_socket_stats(ctx);
+        BOOST_TEST_EQ(st.bytes_read, 5u);
+        BOOST_TEST_EQ(st.bytes_written, 5u);
+        BOOST_TEST_EQ(st.reads_immediate + st.reads_waited, 1u);
+        BOOST_TEST_EQ(st.reads_waited, 1u);
+        BOOST_TEST_EQ(st.writes_immediate + st.writes_waited, 1u);
+        BOOST_TEST(st.would_block >= 2);
+        BOOST_TEST(st.cancellations >= 1);
+        BOOST_TEST_EQ(st.connect_failures, 0u);
+        BOOST_TEST_EQ(st.live_sockets, 2u);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    run()
+    {
+        testRatios();
+#if BOOST_COROSIO_HAS_EPOLL
+        testCounters<epoll_context>();
+#endif
+#if BOOST_COROSIO_HAS_SELECT
+        testCounters<select_context>();
+#endif
+#if BOOST_COROSIO_HAS_IOCP
+        testCounters<iocp_context>();
+#endif
+    }
+};
+
+TEST_SUITE(socket_stats_test, "boost.corosio.socket_stats");
+
+} // namespace boost::corosio
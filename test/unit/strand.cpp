@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/strand.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+namespace {
+
+// Coroutine driven by strand posts, with no task frames
+struct post_loop
+{
+    struct promise_type
+    {
+        post_loop get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct post_to
+{
+    strand s;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { s.post(h); }
+    void await_resume() const noexcept {}
+};
+
+struct overlap_check
+{
+    std::atomic<int> inside{0};
+    std::atomic<bool> overlapped{false};
+    int count = 0;
+};
+
+post_loop
+run_loop(strand s, int n, overlap_check& c)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        co_await post_to{s};
+        if (!s.running_in_this_thread())
+            c.overlapped = true;
+        if (c.inside.fetch_add(1) != 0)
+            c.overlapped = true;
+        ++c.count;
+        c.inside.fetch_sub(1);
+    }
+}
+
+} // namespace
+
+struct strand_test
+{
+    void
+    testSerialization()
+    {
+        io_context ioc(4);
+        strand s(ioc.get_executor());
+        overlap_check c;
+
+        // Several chains share one strand; four threads run them
+        constexpr int chains = 8;
+        constexpr int n = 5000;
+        for (int i = 0; i < chains; ++i)
+            run_loop(s, n, c);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&ioc] { ioc.run(); });
+        for (auto& t : threads)
+            t.join();
+
+        BOOST_TEST(!c.overlapped);
+        BOOST_TEST_EQ(c.count, chains * n);
+    }
+
+    void
+    testIndependentStrands()
+    {
+        io_context ioc(4);
+        std::vector<strand> strands;
+        std::vector<overlap_check> checks(16);
+        for (int i = 0; i < 16; ++i)
+            strands.emplace_back(ioc);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            run_loop(strands[i], 1000, checks[i]);
+            run_loop(strands[i], 1000, checks[i]);
+        }
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&ioc] { ioc.run(); });
+        for (auto& t : threads)
+            t.join();
+
+        for (auto& c : checks)
+        {
+            BOOST_TEST(!c.overlapped);
+            BOOST_TEST_EQ(c.count, 2000);
+        }
+    }
+
+    void
+    testDispatch()
+    {
+        io_context ioc;
+        strand s(ioc);
+        BOOST_TEST(!s.running_in_this_thread());
+
+        bool inner = false;
+        bool transferred = false;
+        auto body = [](strand s, bool& inner, bool& transferred)
+            -> capy::task<>
+        {
+            inner = s.running_in_this_thread();
+            auto h = std::noop_coroutine();
+            transferred = s.dispatch(h) == capy::coro(h);
+            co_return;
+        };
+        capy::run_async(s)(body(s, inner, transferred));
+        ioc.run();
+
+        // Inside it is returned for symmetric transfer
+        BOOST_TEST(inner);
+        BOOST_TEST(transferred);
+        BOOST_TEST(!s.running_in_this_thread());
+    }
+
+    void
+    testTimerResumesOnStrand()
+    {
+        io_context ioc(2);
+        strand s(ioc);
+        timer t(ioc);
+        t.expires_after(std::chrono::milliseconds(1));
+
+        bool on_strand = false;
+        auto body = [](strand s, timer& t, bool& on_strand)
+            -> capy::task<>
+        {
+            auto [ec] = co_await t.wait();
+            on_strand = !ec && s.running_in_this_thread();
+        };
+        capy::run_async(s)(body(s, t, on_strand));
+
+        std::thread other([&ioc] { ioc.run(); });
+        ioc.run();
+        other.join();
+        BOOST_TEST(on_strand);
+    }
+
+    void
+    testCopies()
+    {
+        io_context ioc;
+        strand a(ioc);
+        strand b(ioc);
+        strand c = a;
+        BOOST_TEST(a == c);
+        BOOST_TEST(a != b);
+        BOOST_TEST(&a.context() == &ioc);
+        BOOST_TEST(a.get_inner_executor() == ioc.get_executor());
+
+        c = b;
+        BOOST_TEST(c == b);
+        auto& self = c;
+        c = self;
+        BOOST_TEST(c == b);
+    }
+
+    void
+    testOutlivedByWork()
+    {
+        io_context ioc;
+        overlap_check c;
+
+        // Queued work keeps the strand's queue alive
+        {
+            strand s(ioc);
+            run_loop(s, 10, c);
+        }
+        ioc.run();
+        BOOST_TEST_EQ(c.count, 10);
+    }
+
+    void
+    run()
+    {
+        testSerialization();
+        testIndependentStrands();
+        testDispatch();
+        testTimerResumesOnStrand();
+        testCopies();
+        testOutlivedByWork();
+    }
+};
+
+TEST_SUITE(strand_test, "boost.corosio.strand");
+
+} // namespace boost::corosio
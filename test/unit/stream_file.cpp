@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/stream_file.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Stream file tests
+// Focus: the position advanced by reads and writes, seeking,
+// appending, and the composed operations of io_stream.
+//------------------------------------------------
+
+namespace {
+
+std::atomic<int> next_file{0};
+
+// A fresh file path for each test, removed before use
+std::string
+make_file_path()
+{
+    auto p = std::filesystem::temp_directory_path() /
+        ("corosio_sf_" + std::to_string(next_file.fetch_add(1)) + ".bin");
+    std::filesystem::remove(p);
+    return p.string();
+}
+
+} // namespace
+
+struct stream_file_test
+{
+    void
+    testWriteSeekRead()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+        stream_file f(ioc, path, file_base::read_write | file_base::create);
+
+        std::array<char, 32> buf{};
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, n1] = co_await f.write_some(
+                capy::const_buffer("abc", 3));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, 3u);
+
+            // Each write continues where the last one ended
+            auto [ec2, n2] = co_await f.write_some(
+                capy::const_buffer("def", 3));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, 3u);
+            BOOST_TEST_EQ(f.seek(0, file_base::seek_cur), 6u);
+
+            BOOST_TEST_EQ(f.seek(1, file_base::seek_set), 1u);
+            auto [ec3, n3] = co_await f.read_some(
+                capy::mutable_buffer(buf.data(), 2));
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(std::string_view(buf.data(), n3), "bc");
+
+            auto [ec4, n4] = co_await f.read_some(
+                capy::mutable_buffer(buf.data(), buf.size()));
+            BOOST_TEST(!ec4);
+            BOOST_TEST_EQ(std::string_view(buf.data(), n4), "def");
+
+            auto [ec5, n5] = co_await f.read_some(
+                capy::mutable_buffer(buf.data(), buf.size()));
+            BOOST_TEST(ec5 == capy::cond::eof);
+            BOOST_TEST_EQ(n5, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+
+        BOOST_TEST_EQ(f.seek(-2, file_base::seek_end), 4u);
+        BOOST_TEST_THROWS(
+            f.seek(-1, file_base::seek_set), system::system_error);
+        BOOST_TEST_EQ(f.seek(0, file_base::seek_cur), 4u);
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    testComposed()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+        stream_file f(ioc, path, file_base::read_write | file_base::create);
+
+        std::string const data(100000, 'z');
+        std::string back(data.size(), '\0');
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, n1] = co_await f.write_all(
+                capy::const_buffer(data.data(), data.size()));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, data.size());
+
+            f.seek(0, file_base::seek_set);
+            auto [ec2, n2] = co_await f.read_exact(
+                capy::mutable_buffer(back.data(), back.size()));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(n2, back.size());
+
+            // Nothing is left to fill another buffer
+            char c;
+            auto [ec3, n3] = co_await f.read_exact(
+                capy::mutable_buffer(&c, 1));
+            BOOST_TEST(ec3 == capy::cond::eof);
+            BOOST_TEST_EQ(n3, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST(back == data);
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    testAppend()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+
+        stream_file f(ioc, path, file_base::write_only | file_base::create);
+        f.resize(10);
+        f.close();
+
+        f.open(path, file_base::write_only | file_base::append);
+
+        auto task = [&]() -> capy::task<>
+        {
+            // The write goes to the end, and so does the position
+            auto [ec, n] = co_await f.write_some(
+                capy::const_buffer("tail", 4));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 4u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        BOOST_TEST_EQ(f.size(), 14u);
+        BOOST_TEST_EQ(f.seek(0, file_base::seek_cur), 14u);
+
+        f.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    testMove()
+    {
+        io_context ioc;
+        auto path = make_file_path();
+
+        stream_file a(ioc, path, file_base::read_write | file_base::create);
+        stream_file b(std::move(a));
+        BOOST_TEST(!a.is_open());
+        BOOST_TEST(b.is_open());
+        BOOST_TEST_THROWS(a.seek(0, file_base::seek_set), std::logic_error);
+
+        b.close();
+        std::filesystem::remove(path);
+    }
+
+    void
+    run()
+    {
+        testWriteSeekRead();
+        testComposed();
+        testAppend();
+        testMove();
+    }
+};
+
+TEST_SUITE(stream_file_test, "boost.corosio.stream_file");
+
+} // namespace boost::corosio
@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/stream_op.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Stream operation tests
+// Focus: operations re-armed from their own completion transfer
+// everything in order, and cancelling the stream completes the
+// pending one.
+//------------------------------------------------
+
+struct stream_op_test
+{
+    // Reads until `want` bytes arrive, re-arming from each completion
+    struct reader : stream_op
+    {
+        std::array<char, 256> buf;
+        std::string got;
+        std::size_t want = 0;
+        std::size_t completions = 0;
+        system::error_code last;
+
+        using stream_op::stream_op;
+
+        void
+        arm()
+        {
+            read_some(capy::mutable_buffer(buf.data(), buf.size()));
+        }
+
+        void
+        on_complete(system::error_code ec, std::size_t n) override
+        {
+            BOOST_TEST(!pending());
+            ++completions;
+            last = ec;
+            if (ec)
+                return;
+            got.append(buf.data(), n);
+            if (got.size() < want)
+                arm();
+        }
+    };
+
+    // Writes a message in chunks, re-arming from each completion
+    struct writer : stream_op
+    {
+        std::string msg;
+        std::size_t chunk = 1;
+        std::size_t sent = 0;
+
+        using stream_op::stream_op;
+
+        void
+        arm()
+        {
+            auto n = (std::min)(chunk, msg.size() - sent);
+            write_some(capy::const_buffer(msg.data() + sent, n));
+        }
+
+        void
+        on_complete(system::error_code ec, std::size_t n) override
+        {
+            BOOST_TEST(!ec);
+            sent += n;
+            if (!ec && sent < msg.size())
+                arm();
+        }
+    };
+
+    void
+    testEcho()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+
+        writer w(s1);
+        BOOST_TEST(&w.stream() == &s1);
+        for (std::size_t i = 0; i < 4096; ++i)
+            w.msg.push_back(static_cast<char>('a' + i % 26));
+        w.chunk = 100;
+
+        reader r(s2);
+        r.want = w.msg.size();
+
+        r.arm();
+        BOOST_TEST(r.pending());
+        w.arm();
+        ioc.run();
+
+        BOOST_TEST(!r.pending());
+        BOOST_TEST(!w.pending());
+        BOOST_TEST_EQ(w.sent, w.msg.size());
+        BOOST_TEST(r.got == w.msg);
+        BOOST_TEST(r.completions >= 1);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testInline()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+
+        // Data already waiting: reads may complete before
+        // read_some returns, and must not recurse
+        std::string msg(1000, 'x');
+        auto send = [&]() -> capy::task<>
+        {
+            auto [ec, n] = co_await s1.write_all(
+                capy::const_buffer(msg.data(), msg.size()));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, msg.size());
+        };
+        capy::run_async(ioc.get_executor())(send());
+        ioc.run();
+        ioc.restart();
+
+        reader r(s2);
+        r.want = msg.size();
+        r.arm();
+        ioc.run();
+        BOOST_TEST(r.got == msg);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testCancel()
+    {
+        using namespace std::chrono_literals;
+
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+
+        reader r(s2);
+        r.want = 1;
+        r.arm();
+
+        timer t(ioc);
+        auto cancel = [&]() -> capy::task<>
+        {
+            t.expires_after(10ms);
+            (void) co_await t.wait();
+            BOOST_TEST(r.pending());
+            s2.cancel();
+        };
+        capy::run_async(ioc.get_executor())(cancel());
+        ioc.run();
+
+        BOOST_TEST(!r.pending());
+        BOOST_TEST_EQ(r.completions, 1u);
+        BOOST_TEST(r.last == capy::error::canceled);
+
+        // Reusable after a failure
+        std::string msg = "again";
+        auto send = [&]() -> capy::task<>
+        {
+            (void) co_await s1.write_some(
+                capy::const_buffer(msg.data(), msg.size()));
+        };
+        r.want = msg.size();
+        r.arm();
+        capy::run_async(ioc.get_executor())(send());
+        ioc.restart();
+        ioc.run();
+        BOOST_TEST(r.got == msg);
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    run()
+    {
+        testEcho();
+        testInline();
+        testCancel();
+    }
+};
+
+TEST_SUITE(stream_op_test, "boost.corosio.stream_op");
+
+} // namespace boost::corosio
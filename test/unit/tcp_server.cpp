@@ -10,14 +10,483 @@
 // Test that header file is self-contained.
 #include <boost/corosio/tcp_server.hpp>
 
+#include <boost/corosio/acceptor.hpp>
+#include <boost/corosio/detail/platform.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/corosio/parked_ops.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "test_suite.hpp"
 
 namespace boost::corosio {
 
+namespace {
+
+using namespace std::chrono_literals;
+
+// A loopback endpoint whose port was free a moment ago
+endpoint
+free_endpoint(io_context& ioc)
+{
+    acceptor probe(ioc);
+    probe.listen(endpoint(urls::ipv4_address::loopback(), 0));
+    auto ep = probe.local_endpoint();
+    probe.close();
+    return ep;
+}
+
+// Wait until `done` holds, checking every 5ms for two seconds
+capy::task<bool>
+settle(io_context& ioc, std::function<bool()> done)
+{
+    timer t(ioc);
+    for (int i = 0; i < 400 && !done(); ++i)
+    {
+        t.expires_after(5ms);
+        (void)co_await t.wait();
+    }
+    co_return done();
+}
+
+// Open and connect `n` clients
+capy::task<>
+connect_clients(std::vector<socket>& clients, io_context& ioc, endpoint ep, int n)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        clients.emplace_back(ioc);
+        clients.back().open();
+        auto [ec] = co_await clients.back().connect(ep);
+        BOOST_TEST(!ec);
+    }
+}
+
+// Workers hold each connection until the peer closes it
+class test_server : public tcp_server
+{
+public:
+    class worker : public worker_base
+    {
+        test_server& srv_;
+        io_context& ctx_;
+        corosio::socket sock_;
+
+    public:
+        worker(test_server& srv, io_context& ctx)
+            : worker_base(srv.arena_size)
+            , srv_(srv)
+            , ctx_(ctx)
+            , sock_(ctx)
+        {
+        }
+
+        corosio::socket& socket() override
+        {
+            return sock_;
+        }
+
+        void run(launcher launch) override
+        {
+            auto& ctx = srv_.session_ctx ? *srv_.session_ctx : ctx_;
+            launch(ctx.get_executor(), session());
+        }
+
+        capy::task<> session()
+        {
+            srv_.session_thread = std::this_thread::get_id();
+            if (srv_.arena_size)
+                srv_.arena_blocks.push_back(arena().allocate(64));
+            char buf[16];
+            for (;;)
+            {
+                auto [ec, n] = co_await sock_.read_some(
+                    capy::mutable_buffer(buf, sizeof(buf)));
+                if (ec || n == 0)
+                    break;
+            }
+            sock_.close();
+            ++srv_.finished;
+        }
+    };
+
+    std::atomic<int> made{0};
+    std::atomic<int> finished{0};
+
+    // Where connections run, if not on the accepting context
+    io_context* session_ctx = nullptr;
+    std::atomic<std::thread::id> session_thread{};
+
+    // Each connection's first allocation from its worker's arena
+    std::size_t arena_size = 0;
+    std::vector<void*> arena_blocks;
+
+    explicit test_server(
+        io_context& ctx,
+        int workers = 0,
+        std::size_t arena = 0)
+        : tcp_server(ctx, ctx.get_executor())
+        , arena_size(arena)
+    {
+        for (int i = 0; i < workers; ++i)
+            wv_.emplace<worker>(*this, ctx);
+    }
+
+protected:
+    std::unique_ptr<worker_base>
+    make_worker(io_context& ctx) override
+    {
+        ++made;
+        return std::make_unique<worker>(*this, ctx);
+    }
+};
+
+} // namespace
+
 struct tcp_server_test
 {
-    void run()
+    // The pool grows to max_workers while accepts find no idle
+    // worker, then shrinks to min_workers once they idle
+    void
+    testGrowAndReap()
+    {
+        io_context ioc;
+        test_server srv(ioc);
+        srv.set_worker_limits({
+            .min_workers = 1,
+            .max_workers = 3,
+            .idle_timeout = 50ms});
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(5);
+            co_await connect_clients(clients, ioc, ep, 5);
+
+            // Three are served, the rest wait for a worker
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.counters().accepted == 3;
+            }));
+            auto ws = co_await srv.sample_worker_stats();
+            BOOST_TEST_EQ(ws.workers, 3u);
+            BOOST_TEST_EQ(ws.idle, 0u);
+            BOOST_TEST_EQ(ws.workers_created, 3u);
+            BOOST_TEST_EQ(srv.made.load(), 3);
+            BOOST_TEST_EQ(srv.counters().accepted, 3u);
+
+            for (auto& c : clients)
+                c.close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 5;
+            }));
+            ws = co_await srv.sample_worker_stats();
+            BOOST_TEST_EQ(ws.accepts, 5u);
+            BOOST_TEST(ws.accept_waits >= 1u);
+            BOOST_TEST(ws.max_accept_wait > 0ns);
+            BOOST_TEST(ws.max_accept_wait <= ws.accept_wait_time);
+            BOOST_TEST_EQ(ws.workers_created, 3u);
+            BOOST_TEST_EQ(ws.workers_retired, 0u);
+
+            // Idle past the timeout, all but min_workers are destroyed
+            timer t(ioc);
+            for (int i = 0; i < 400 && ws.workers > 1; ++i)
+            {
+                t.expires_after(5ms);
+                (void)co_await t.wait();
+                ws = co_await srv.sample_worker_stats();
+            }
+            BOOST_TEST_EQ(ws.workers, 1u);
+            BOOST_TEST_EQ(ws.workers_retired, 2u);
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+    }
+
+    // Without make_worker the pool keeps the workers it was given
+    void
+    testNoGrowth()
+    {
+        io_context ioc;
+        test_server srv(ioc, 1);
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(2);
+            co_await connect_clients(clients, ioc, ep, 2);
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.counters().accepted == 1;
+            }));
+
+            for (auto& c : clients)
+                c.close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 2;
+            }));
+            auto ws = co_await srv.sample_worker_stats();
+            BOOST_TEST_EQ(ws.workers, 1u);
+            BOOST_TEST_EQ(ws.accepts, 2u);
+            BOOST_TEST_EQ(ws.workers_created, 0u);
+            BOOST_TEST_EQ(srv.made.load(), 0);
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+    }
+
+    // A worker whose connection ran on another context's thread
+    // returns itself from there, waking the accept loop waiting for it
+    void
+    testReturnFromOtherThread()
+    {
+        io_context ioc;
+        io_context other;
+        test_server srv(ioc, 1);
+        srv.session_ctx = &other;
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(2);
+            co_await connect_clients(clients, ioc, ep, 2);
+
+            // The second accept waits for the only worker
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                std::vector<parked_op> v;
+                srv.append_parked_ops(v);
+                return srv.counters().accepted == 1 && v.size() == 1 &&
+                    v[0].kind == parked_kind::server_pop;
+            }));
+
+            clients[0].close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.counters().accepted == 2;
+            }));
+            clients[1].close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 2;
+            }));
+            auto ws = co_await srv.sample_worker_stats();
+            BOOST_TEST_EQ(ws.accepts, 2u);
+            BOOST_TEST_EQ(ws.accept_waits, 1u);
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+
+        // The other context runs until the test is done
+        other.get_executor().on_work_started();
+        std::thread t([&other] { other.run(); });
+        auto const id = t.get_id();
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+        other.get_executor().on_work_finished();
+        t.join();
+        BOOST_TEST(srv.session_thread.load() == id);
+    }
+
+    // Several accept loops share the port and every connection is
+    // served
+    void
+    testAcceptLoops()
+    {
+        io_context ioc;
+        test_server srv(ioc, 4);
+        srv.set_accept_loops(2);
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+#if BOOST_COROSIO_HAS_IOCP
+        BOOST_TEST_EQ(srv.native_handles().size(), 1u);
+#else
+        BOOST_TEST_EQ(srv.native_handles().size(), 2u);
+#endif
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(8);
+            co_await connect_clients(clients, ioc, ep, 8);
+            for (auto& c : clients)
+                c.close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 8;
+            }));
+            BOOST_TEST_EQ(srv.counters().accepted, 8u);
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+    }
+
+    // Over max_connections, a connection waits in the backlog until
+    // a slot is released
+    void
+    testAdmissionBacklog()
+    {
+        io_context ioc;
+        test_server srv(ioc, 2);
+        srv.set_admission_limits({.max_connections = 1});
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(2);
+            co_await connect_clients(clients, ioc, ep, 2);
+
+            // The accept loop waits for a slot, not a worker
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                std::vector<parked_op> v;
+                srv.append_parked_ops(v);
+                return srv.counters().accepted == 1 && v.size() == 1 &&
+                    v[0].kind == parked_kind::server_admit;
+            }));
+            BOOST_TEST_EQ(srv.counters().rejected, 0u);
+
+            clients[0].close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.counters().accepted == 2;
+            }));
+            clients[1].close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 2;
+            }));
+            BOOST_TEST_EQ(srv.counters().rejected, 0u);
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+    }
+
+    // With reset_excess, a connection over max_connections is
+    // accepted and reset at once
+    void
+    testAdmissionReset()
+    {
+        io_context ioc;
+        test_server srv(ioc, 2);
+        srv.set_admission_limits({
+            .max_connections = 1,
+            .reset_excess = true});
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            std::vector<socket> clients;
+            clients.reserve(2);
+            co_await connect_clients(clients, ioc, ep, 2);
+
+            // The peer learns at once
+            char buf[4];
+            auto [ec, n] = co_await clients[1].read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(ec);
+            BOOST_TEST_EQ(srv.counters().accepted, 1u);
+            BOOST_TEST_EQ(srv.counters().rejected, 1u);
+
+            for (auto& c : clients)
+                c.close();
+            BOOST_TEST(co_await settle(ioc, [&]
+            {
+                return srv.finished.load() == 1;
+            }));
+
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+    }
+
+    // A worker's arena is reset between connections, so each one
+    // allocates from the start of the buffer again
+    void
+    testArenaReset()
+    {
+        io_context ioc;
+        test_server srv(ioc, 1, 256);
+        auto const ep = free_endpoint(ioc);
+        BOOST_TEST(!srv.bind(ep));
+        srv.start();
+
+        auto task = [](io_context& ioc, test_server& srv, endpoint ep)
+            -> capy::task<>
+        {
+            for (int i = 1; i <= 3; ++i)
+            {
+                std::vector<socket> clients;
+                co_await connect_clients(clients, ioc, ep, 1);
+                clients[0].close();
+                BOOST_TEST(co_await settle(ioc, [&]
+                {
+                    return srv.finished.load() == i;
+                }));
+            }
+            BOOST_TEST(co_await srv.drain(1s));
+        };
+        capy::run_async(ioc.get_executor())(task(ioc, srv, ep));
+        ioc.run();
+
+        BOOST_TEST_EQ(srv.arena_blocks.size(), 3u);
+        for (auto* p : srv.arena_blocks)
+            BOOST_TEST(p == srv.arena_blocks.front());
+    }
+
+    void
+    run()
     {
+        testGrowAndReap();
+        testNoGrowth();
+        testReturnFromOtherThread();
+        testAcceptLoops();
+        testAdmissionBacklog();
+        testAdmissionReset();
+        testArenaReset();
     }
 };
 
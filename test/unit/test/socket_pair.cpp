@@ -78,11 +78,49 @@ struct socket_pair_test
         s2.close();
     }
 
+    void
+    testLocal()
+    {
+        io_context ioc;
+
+        auto [s1, s2] = make_local_socket_pair(ioc);
+        BOOST_TEST(s1.is_open());
+        BOOST_TEST(s2.is_open());
+
+        auto task = [](socket& a, socket& b) -> capy::task<>
+        {
+            char buf[32] = {};
+
+            auto [ec1, n1] = co_await a.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, 5u);
+
+            auto [ec2, n2] = co_await b.read_some(
+                capy::make_buffer(buf));
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(std::string_view(buf, n2), "hello");
+
+            // Closing one end is end of stream at the other
+            a.close();
+            auto [ec3, n3] = co_await b.read_some(
+                capy::make_buffer(buf));
+            BOOST_TEST(ec3);
+            BOOST_TEST_EQ(n3, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task(s1, s2));
+
+        ioc.run();
+
+        s2.close();
+    }
+
     void
     run()
     {
         testCreate();
         testBidirectional();
+        testLocal();
     }
 };
 
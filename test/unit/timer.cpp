@@ -11,6 +11,9 @@
 #include <boost/corosio/timer.hpp>
 
 #include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/test/virtual_time.hpp>
 #include <boost/capy/cond.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
@@ -21,7 +24,15 @@
 #include <boost/corosio/select_context.hpp>
 #endif
 
+#if BOOST_COROSIO_HAS_POLL
+#include <boost/corosio/poll_context.hpp>
+#endif
+
 #include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "test_suite.hpp"
 
@@ -438,6 +449,72 @@ struct timer_test_impl
         BOOST_TEST(t2_done);
     }
 
+    void
+    testManyTimers()
+    {
+        Context ioc;
+
+        // A third expire, a third are cancelled, and a third are
+        // rescheduled while waiting, so their first wait is cancelled
+        constexpr int n = 300;
+        std::vector<timer> timers;
+        timers.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            timers.emplace_back(ioc);
+            if (i % 3 == 0)
+                timers.back().expires_after(std::chrono::milliseconds(2 + i % 10));
+            else
+                timers.back().expires_after(std::chrono::hours(1));
+        }
+
+        int ok_count = 0;
+        int canceled_count = 0;
+
+        auto waiter = [](timer& t_ref, bool rewait,
+            int& ok_out, int& canceled_out) -> capy::task<>
+        {
+            auto [ec] = co_await t_ref.wait();
+            if (!ec)
+            {
+                ++ok_out;
+                co_return;
+            }
+            if (ec == capy::cond::canceled)
+                ++canceled_out;
+            if (rewait)
+            {
+                auto [ec2] = co_await t_ref.wait();
+                if (!ec2)
+                    ++ok_out;
+            }
+        };
+
+        auto control = [](timer& delay, std::vector<timer>& ts) -> capy::task<>
+        {
+            delay.expires_after(std::chrono::milliseconds(1));
+            (void)co_await delay.wait();
+            for (std::size_t i = 0; i < ts.size(); ++i)
+            {
+                if (i % 3 == 1)
+                    ts[i].cancel();
+                else if (i % 3 == 2)
+                    ts[i].expires_after(std::chrono::milliseconds(3));
+            }
+        };
+
+        for (int i = 0; i < n; ++i)
+            capy::run_async(ioc.get_executor())(
+                waiter(timers[i], i % 3 == 2, ok_count, canceled_count));
+
+        timer delay(ioc);
+        capy::run_async(ioc.get_executor())(control(delay, timers));
+
+        ioc.run();
+        BOOST_TEST_EQ(ok_count, 2 * n / 3);
+        BOOST_TEST_EQ(canceled_count, 2 * n / 3);
+    }
+
     //--------------------------------------------
     // Sequential wait tests
     //--------------------------------------------
@@ -593,6 +670,37 @@ struct timer_test_impl
         BOOST_TEST(completed);
     }
 
+    void
+    testSlack()
+    {
+        Context ioc;
+        timer t(ioc);
+
+        BOOST_TEST(t.slack() == timer::duration::zero());
+        t.set_slack(std::chrono::milliseconds(20));
+        BOOST_TEST(t.slack() == std::chrono::milliseconds(20));
+
+        // Slack may delay the wait but leaves expiry() exact
+        auto expiry = timer::clock_type::now() + std::chrono::milliseconds(5);
+        t.expires_at(expiry);
+        BOOST_TEST(t.expiry() == expiry);
+
+        bool ok = false;
+        timer::time_point completed_at{};
+        auto task = [](timer& t_ref, bool& ok_out,
+            timer::time_point& at_out) -> capy::task<>
+        {
+            auto [ec] = co_await t_ref.wait();
+            ok_out = !ec;
+            at_out = timer::clock_type::now();
+        };
+        capy::run_async(ioc.get_executor())(task(t, ok, completed_at));
+
+        ioc.run();
+        BOOST_TEST(ok);
+        BOOST_TEST(completed_at >= expiry);
+    }
+
     //--------------------------------------------
     // Type trait tests
     //--------------------------------------------
@@ -647,6 +755,7 @@ struct timer_test_impl
         // Multiple timer tests
         testMultipleTimersDifferentExpiry();
         testMultipleTimersSameExpiry();
+        testManyTimers();
 
         // Sequential wait tests
         testSequentialWaits();
@@ -659,6 +768,7 @@ struct timer_test_impl
         // Edge cases
         testLongDuration();
         testNegativeDuration();
+        testSlack();
 
         // Type trait tests
         testTypeAliases();
@@ -679,4 +789,352 @@ struct timer_test_select : timer_test_impl<select_context> {};
 TEST_SUITE(timer_test_select, "boost.corosio.timer.select");
 #endif
 
+// POSIX: also test with poll_context explicitly
+#if BOOST_COROSIO_HAS_POLL
+struct timer_test_poll : timer_test_impl<poll_context> {};
+TEST_SUITE(timer_test_poll, "boost.corosio.timer.poll");
+#endif
+
+
+// Timing wheel timer queue, with a small batch so bursts of
+// expiries are drained in several passes
+#if BOOST_COROSIO_HAS_EPOLL
+struct epoll_wheel_context : epoll_context
+{
+    epoll_wheel_context()
+        : epoll_context(1, epoll_options{.timers = {
+            .queue = timer_queue::wheel, .expiry_batch = 16}})
+    {
+    }
+};
+
+struct timer_test_epoll_wheel : timer_test_impl<epoll_wheel_context> {};
+TEST_SUITE(timer_test_epoll_wheel, "boost.corosio.timer.epoll_wheel");
+#endif
+
+#if BOOST_COROSIO_HAS_IO_URING
+struct io_uring_wheel_context : io_uring_context
+{
+    io_uring_wheel_context()
+        : io_uring_context(1, io_uring_options{.timers = {
+            .queue = timer_queue::wheel, .expiry_batch = 16}})
+    {
+    }
+};
+
+struct timer_test_io_uring_wheel : timer_test_impl<io_uring_wheel_context> {};
+TEST_SUITE(timer_test_io_uring_wheel, "boost.corosio.timer.io_uring_wheel");
+#endif
+
+#if BOOST_COROSIO_HAS_IOCP
+struct iocp_wheel_context : iocp_context
+{
+    iocp_wheel_context()
+        : iocp_context(1, iocp_options{.timers = {
+            .queue = timer_queue::wheel, .expiry_batch = 16}})
+    {
+    }
+};
+
+struct timer_test_iocp_wheel : timer_test_impl<iocp_wheel_context> {};
+TEST_SUITE(timer_test_iocp_wheel, "boost.corosio.timer.iocp_wheel");
+
+// The default suite uses a high resolution waitable timer where the
+// system has one; this one uses the system tick
+struct iocp_coarse_timer_context : iocp_context
+{
+    iocp_coarse_timer_context()
+        : iocp_context(1, iocp_options{.high_resolution_timers = false})
+    {
+    }
+};
+
+struct timer_test_iocp_coarse : timer_test_impl<iocp_coarse_timer_context> {};
+TEST_SUITE(timer_test_iocp_coarse, "boost.corosio.timer.iocp_coarse");
+#endif
+
+// Sharded timer heaps, with more shards than threads
+#if BOOST_COROSIO_HAS_EPOLL
+struct epoll_sharded_context : epoll_context
+{
+    epoll_sharded_context()
+        : epoll_context(2, epoll_options{.timers = {
+            .queue = timer_queue::sharded, .shards = 4}})
+    {
+    }
+};
+
+struct timer_test_epoll_sharded : timer_test_impl<epoll_sharded_context> {};
+TEST_SUITE(timer_test_epoll_sharded, "boost.corosio.timer.epoll_sharded");
+#endif
+
+// Time sampled once per reactor pass
+#if BOOST_COROSIO_HAS_EPOLL
+struct timer_cached_time_test
+{
+    static capy::task<>
+    wait_for(timer& t, bool& ok_out)
+    {
+        auto [ec] = co_await t.wait();
+        ok_out = !ec;
+    }
+
+    void
+    testLiveByDefault()
+    {
+        epoll_context ctx(1);
+        auto t0 = ctx.now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        BOOST_TEST(ctx.now() > t0);
+    }
+
+    void
+    testNowStandsStill()
+    {
+        epoll_context ctx(1, epoll_options{.timers = {.cached_time = true}});
+        auto t0 = ctx.now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        BOOST_TEST(ctx.now() == t0);
+
+        // Relative expiries measure from the sample
+        timer t(ctx);
+        t.expires_after(std::chrono::milliseconds(5));
+        BOOST_TEST(t.expiry() == t0 + std::chrono::milliseconds(5));
+
+        // The pass that expires the timer refreshes it
+        bool ok = false;
+        capy::run_async(ctx.get_executor())(wait_for(t, ok));
+        ctx.run();
+        BOOST_TEST(ok);
+        BOOST_TEST(ctx.now() >= t.expiry());
+    }
+
+    void
+    testCoarseClock()
+    {
+        epoll_context ctx(1, epoll_options{.timers = {
+            .cached_time = true, .coarse_clock = true}});
+
+        timer t(ctx);
+        t.expires_after(std::chrono::milliseconds(10));
+        bool ok = false;
+        capy::run_async(ctx.get_executor())(wait_for(t, ok));
+        ctx.run();
+        BOOST_TEST(ok);
+
+        // The coarse clock trails the precise one by at most a tick
+        BOOST_TEST(ctx.now() <= std::chrono::steady_clock::now());
+    }
+
+    // Waking at the precise expiry, before the coarse clock reaches
+    // it, would pass through the reactor again and again until the
+    // next tick
+    void
+    testCoarseClockWakeups()
+    {
+        epoll_context ctx(1, epoll_options{.timers = {
+            .cached_time = true, .coarse_clock = true}});
+
+        constexpr int expiries = 10;
+        timer t(ctx);
+        int fired = 0;
+        capy::run_async(ctx.get_executor())(
+            [](timer& t, int& fired) -> capy::task<>
+            {
+                for (int i = 0; i < expiries; ++i)
+                {
+                    t.expires_after(std::chrono::milliseconds(3));
+                    auto [ec] = co_await t.wait();
+                    if (!ec)
+                        ++fired;
+                }
+            }(t, fired));
+        ctx.run();
+        BOOST_TEST(fired == expiries);
+
+        // One pass per expiry, with room for early wakeups
+        BOOST_TEST(ctx.stats().reactor_polls <= 3u * expiries);
+    }
+
+    void
+    run()
+    {
+        testLiveByDefault();
+        testNowStandsStill();
+        testCoarseClock();
+        testCoarseClockWakeups();
+    }
+};
+
+TEST_SUITE(timer_cached_time_test, "boost.corosio.timer.cached_time");
+#endif
+
+// Timers on a virtual clock
+#if BOOST_COROSIO_HAS_EPOLL
+struct timer_virtual_time_test
+{
+    static capy::task<>
+    sleep(timer& t, std::chrono::minutes d, int id, std::vector<int>& order)
+    {
+        t.expires_after(d);
+        auto [ec] = co_await t.wait();
+        if (!ec)
+            order.push_back(id);
+    }
+
+    void
+    testAutoAdvance()
+    {
+        epoll_context ctx(1, epoll_options{.timers = {.virtual_time = true}});
+        auto const t0 = ctx.now();
+        auto const real = std::chrono::steady_clock::now();
+
+        // Five hours of timers, completed in expiry order
+        std::vector<int> order;
+        timer a(ctx), b(ctx), c(ctx);
+        capy::run_async(ctx.get_executor())(
+            sleep(a, std::chrono::minutes(300), 3, order));
+        capy::run_async(ctx.get_executor())(
+            sleep(b, std::chrono::minutes(60), 1, order));
+        capy::run_async(ctx.get_executor())(
+            sleep(c, std::chrono::minutes(120), 2, order));
+        ctx.run();
+
+        BOOST_TEST((order == std::vector<int>{1, 2, 3}));
+        BOOST_TEST(ctx.now() - t0 == std::chrono::hours(5));
+        BOOST_TEST(std::chrono::steady_clock::now() - real <
+            std::chrono::seconds(5));
+    }
+
+    void
+    testManualAdvance()
+    {
+        epoll_context ctx(1, epoll_options{.timers = {
+            .virtual_time = true, .auto_advance = false}});
+        auto const t0 = ctx.now();
+
+        std::vector<int> order;
+        timer t(ctx);
+        capy::run_async(ctx.get_executor())(
+            sleep(t, std::chrono::minutes(60), 1, order));
+        ctx.poll();
+        BOOST_TEST(order.empty());
+
+        test::advance_time(ctx, std::chrono::minutes(30));
+        ctx.poll();
+        BOOST_TEST(order.empty());
+        BOOST_TEST(ctx.now() - t0 == std::chrono::minutes(30));
+
+        test::advance_time(ctx, std::chrono::minutes(30));
+        ctx.poll();
+        BOOST_TEST_EQ(order.size(), 1u);
+
+        // The clock never runs backwards
+        test::advance_time_to(ctx, t0);
+        BOOST_TEST(ctx.now() - t0 == std::chrono::hours(1));
+
+        epoll_context real(1);
+        BOOST_TEST_THROWS(
+            test::advance_time(real, std::chrono::seconds(1)),
+            std::logic_error);
+    }
+
+    void
+    testParkedRead()
+    {
+        // A read parked on its socket does not hold the clock, so the
+        // peer's hour of sleep passes at once
+        epoll_context ctx(1, epoll_options{.timers = {.virtual_time = true}});
+        auto [s1, s2] = test::make_socket_pair(ctx);
+        auto const t0 = ctx.now();
+
+        auto writer = [](socket& s, timer& t) -> capy::task<>
+        {
+            t.expires_after(std::chrono::hours(1));
+            (void)co_await t.wait();
+            auto [ec, n] = co_await s.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec);
+        };
+        auto reader = [](socket& s, basic_io_context& ctx,
+            timer::time_point& at) -> capy::task<>
+        {
+            char buf[8] = {};
+            auto [ec, n] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(std::string_view(buf, n), "hello");
+            at = ctx.now();
+        };
+        timer t(ctx);
+        timer::time_point at{};
+        capy::run_async(ctx.get_executor())(writer(s1, t));
+        capy::run_async(ctx.get_executor())(reader(s2, ctx, at));
+        ctx.run();
+        BOOST_TEST(at - t0 == std::chrono::hours(1));
+    }
+
+    void
+    testReadyReadWins()
+    {
+        // Data already written completes its read before the clock
+        // jumps to a pending timeout
+        epoll_context ctx(1, epoll_options{.timers = {.virtual_time = true}});
+        auto [s1, s2] = test::make_socket_pair(ctx);
+        auto const t0 = ctx.now();
+
+        auto writer = [](socket& s) -> capy::task<>
+        {
+            auto [ec, n] = co_await s.write_some(
+                capy::const_buffer("hello", 5));
+            BOOST_TEST(!ec);
+        };
+        auto reader = [](socket& s, basic_io_context& ctx,
+            timer::time_point& at) -> capy::task<>
+        {
+            char buf[8] = {};
+            auto [ec, n] = co_await s.read_some(
+                capy::mutable_buffer(buf, sizeof(buf)));
+            BOOST_TEST(!ec);
+            at = ctx.now();
+        };
+        std::vector<int> order;
+        timer timeout(ctx);
+        timer::time_point at{};
+        capy::run_async(ctx.get_executor())(
+            sleep(timeout, std::chrono::minutes(10), 1, order));
+        capy::run_async(ctx.get_executor())(reader(s2, ctx, at));
+        capy::run_async(ctx.get_executor())(writer(s1));
+        ctx.run();
+        BOOST_TEST(at == t0);
+        BOOST_TEST_EQ(order.size(), 1u);
+    }
+
+    void
+    run()
+    {
+        testAutoAdvance();
+        testManualAdvance();
+        testParkedRead();
+        testReadyReadWins();
+    }
+};
+
+TEST_SUITE(timer_virtual_time_test, "boost.corosio.timer.virtual_time");
+#endif
+
+#if BOOST_COROSIO_HAS_IOCP
+struct iocp_sharded_context : iocp_context
+{
+    iocp_sharded_context()
+        : iocp_context(2, iocp_options{.timers = {
+            .queue = timer_queue::sharded, .shards = 4}})
+    {
+    }
+};
+
+struct timer_test_iocp_sharded : timer_test_impl<iocp_sharded_context> {};
+TEST_SUITE(timer_test_iocp_sharded, "boost.corosio.timer.iocp_sharded");
+#endif
+
 } // namespace boost::corosio
@@ -19,9 +19,14 @@
 #include <boost/corosio/tls/openssl_stream.hpp>
 #include <boost/corosio/tls/wolfssl_stream.hpp>
 
+#include "src/corosio/src/tls/detail/context_impl.hpp"
+
 #include "test_utils.hpp"
 #include "test_suite.hpp"
 #include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
 
 /*  Cross-Implementation TLS Tests
     ================================
@@ -84,6 +89,49 @@ struct cross_ssl_stream_test
         return wolfssl_stream( s, ctx );
     }
 
+    void
+    testConcurrentStreams()
+    {
+        using namespace tls::test;
+
+        // Handshakes of both backends run at once from one context,
+        // each thread with its own io_context. OpenSSL builds its
+        // native context with the stream, WolfSSL at the handshake;
+        // either way each backend builds one and shares it.
+        auto ctx = make_contexts( context_mode::shared_cert ).first;
+        constexpr int threads = 8;
+        std::vector<std::thread> pool;
+        for( int i = 0; i < threads; ++i )
+        {
+            pool.emplace_back( [ctx, i]
+            {
+                // Half the threads start with each backend
+                io_context ioc;
+                for( int k = 0; k < 2; ++k )
+                {
+                    if( ( i + k ) % 2 == 0 )
+                        run_tls_test( ioc, ctx, ctx, make_openssl, make_openssl );
+                    else
+                        run_tls_test( ioc, ctx, ctx, make_wolfssl, make_wolfssl );
+                    ioc.restart();
+                }
+            });
+        }
+        for( auto& t : pool )
+            t.join();
+
+        std::set<void const*> services;
+        int count = 0;
+        auto const& cd = tls::detail::get_context_data( ctx );
+        for( auto* p = cd.native_contexts_.load(); p; p = p->next_ )
+        {
+            services.insert( p->service_ );
+            ++count;
+        }
+        BOOST_TEST_EQ( count, 2 );
+        BOOST_TEST_EQ( services.size(), 2u );
+    }
+
     void
     testCrossImplSuccess()
     {
@@ -159,6 +207,7 @@ struct cross_ssl_stream_test
     run()
     {
 #if defined(BOOST_COROSIO_HAS_OPENSSL) && defined(BOOST_COROSIO_HAS_WOLFSSL)
+        testConcurrentStreams();
         testCrossImplSuccess();
         // Failure tests disabled: cancelling the underlying socket doesn't
         // propagate to TLS handshake operations - they have their own async
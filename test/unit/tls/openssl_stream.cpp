@@ -16,8 +16,23 @@
 // Test that header file is self-contained.
 #include <boost/corosio/tls/openssl_stream.hpp>
 
+#include <boost/corosio/buffer_pool.hpp>
+#include <boost/capy/read.hpp>
+#include <boost/capy/write.hpp>
+
 #include "test_utils.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <thread>
+
+#ifdef BOOST_COROSIO_HAS_OPENSSL
+#include <openssl/opensslv.h>
+#endif
 #include "test_suite.hpp"
 
 namespace boost::corosio {
@@ -47,6 +62,277 @@ struct openssl_stream_test
         }
     }
 
+    void
+    testHandshakeThreads()
+    {
+        using namespace tls::test;
+
+        // Handshake steps run on the contexts' pools and resume on ioc
+        for( auto mode : { context_mode::shared_cert,
+                           context_mode::separate_cert } )
+        {
+            io_context ioc;
+            auto [client_ctx, server_ctx] = make_contexts( mode );
+            client_ctx.set_handshake_threads( 2 );
+            server_ctx.set_handshake_threads( 2 );
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+    }
+
+    void
+    testCryptoProvider()
+    {
+        using namespace tls::test;
+
+        // A provider and engine must be named
+        {
+            tls::context ctx;
+            BOOST_TEST( ctx.set_crypto_provider( "" ).has_error() );
+            BOOST_TEST( ctx.set_crypto_engine( "" ).has_error() );
+            BOOST_TEST( !ctx.set_crypto_provider( "default" ).has_error() );
+        }
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        // Algorithms fetched from the default provider in a library
+        // context of the SSL_CTX's own, with async mode on, with and
+        // without handshake threads
+        for( int threads : { 0, 2 } )
+        {
+            io_context ioc;
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            for( auto* ctx : { &client_ctx, &server_ctx } )
+            {
+                BOOST_TEST( !ctx->set_crypto_provider( "default" ).has_error() );
+                ctx->set_async_crypto( true );
+                if( threads )
+                    ctx->set_handshake_threads( threads );
+            }
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+#endif
+    }
+
+    void
+    testMemoryResource()
+    {
+        using namespace tls::test;
+
+        // Settings loaded into the contexts come from the resource
+        std::pmr::monotonic_buffer_resource mr;
+        tls::context server_ctx( &mr );
+        BOOST_TEST( server_ctx.memory_resource() == &mr );
+        server_ctx.use_certificate( server_cert_pem, tls::file_format::pem );
+        server_ctx.use_private_key( server_key_pem, tls::file_format::pem );
+        server_ctx.set_verify_mode( tls::verify_mode::none );
+
+        tls::context client_ctx( &mr );
+        client_ctx.add_certificate_authority( ca_cert_pem );
+        client_ctx.set_verify_mode( tls::verify_mode::peer );
+        client_ctx.set_hostname( "www.example.com" );
+
+        tls::context copy = client_ctx;
+        BOOST_TEST( copy.memory_resource() == &mr );
+        BOOST_TEST( tls::context().memory_resource() ==
+            std::pmr::get_default_resource() );
+
+        io_context ioc;
+        run_tls_test( ioc, client_ctx, server_ctx,
+            make_stream, make_stream );
+    }
+
+    void
+    testGatherWrite()
+    {
+        using namespace tls::test;
+
+        // Small records at first, with a header and body gathered
+        // into the same records
+        for( bool dynamic : { false, true } )
+        {
+            io_context ioc;
+            auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+            auto ctx = make_anon_context();
+            ctx.set_dynamic_record_sizing( dynamic );
+            auto client = make_stream( s1, ctx );
+            auto server = make_stream( s2, ctx );
+
+            std::string const header = "HEADER\r\n";
+            std::string const body( 40000, 'b' );
+            std::string const trailer = "\r\n";
+            std::string got( header.size() + body.size() + trailer.size(), 0 );
+
+            auto client_task = [&]() -> capy::task<>
+            {
+                auto [hec] = co_await client.handshake( tls_stream::client );
+                BOOST_TEST( !hec );
+                std::array<capy::const_buffer, 3> bufs = {
+                    capy::const_buffer( header.data(), header.size() ),
+                    capy::const_buffer( body.data(), body.size() ),
+                    capy::const_buffer( trailer.data(), trailer.size() ) };
+                auto [ec, n] = co_await capy::write( client, bufs );
+                BOOST_TEST( !ec );
+                BOOST_TEST_EQ( n, got.size() );
+            };
+            auto server_task = [&]() -> capy::task<>
+            {
+                auto [hec] = co_await server.handshake( tls_stream::server );
+                BOOST_TEST( !hec );
+                auto [ec, n] = co_await capy::read( server,
+                    capy::mutable_buffer( got.data(), got.size() ) );
+                BOOST_TEST( !ec );
+                BOOST_TEST_EQ( n, got.size() );
+            };
+            capy::run_async( ioc.get_executor() )( client_task() );
+            capy::run_async( ioc.get_executor() )( server_task() );
+            ioc.run();
+
+            BOOST_TEST( got == header + body + trailer );
+            s1.close();
+            s2.close();
+        }
+    }
+
+    void
+    testPartialWrite()
+    {
+        using namespace tls::test;
+
+        // With small socket buffers each send takes part of the
+        // records, and the unsent rest must go out before more
+        io_context ioc;
+        auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+        s1.set_send_buffer_size( 4096 );
+        s2.set_receive_buffer_size( 4096 );
+        auto [client_ctx, server_ctx] = make_contexts( context_mode::separate_cert );
+        auto client = make_stream( s1, client_ctx );
+        auto server = make_stream( s2, server_ctx );
+
+        std::string data( 4 * 1024 * 1024, 0 );
+        for( std::size_t i = 0; i < data.size(); ++i )
+            data[i] = static_cast<char>( i * 7 );
+        std::string got( data.size(), 0 );
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [hec] = co_await client.handshake( tls_stream::client );
+            BOOST_TEST( !hec );
+            auto [ec, n] = co_await capy::write( client,
+                capy::const_buffer( data.data(), data.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, data.size() );
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            auto [hec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !hec );
+            auto [ec, n] = co_await capy::read( server,
+                capy::mutable_buffer( got.data(), got.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, got.size() );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+
+        BOOST_TEST( got == data );
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testMultiRecordRead()
+    {
+        using namespace tls::test;
+
+        // Three full records, all received before the read starts,
+        // come back from one read_some into a buffer that holds them
+        io_context ioc;
+        auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
+        auto [client_ctx, server_ctx] = make_contexts( context_mode::separate_cert );
+        auto client = make_stream( s1, client_ctx );
+        auto server = make_stream( s2, server_ctx );
+
+        std::string const data( 3 * 16384, 'r' );
+        std::string got( 65536, 0 );
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await client.handshake( tls_stream::client );
+            BOOST_TEST( !ec );
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !ec );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+        ioc.restart();
+
+        auto transfer_task = [&]() -> capy::task<>
+        {
+            auto [wec, written] = co_await capy::write( server,
+                capy::const_buffer( data.data(), data.size() ) );
+            BOOST_TEST( !wec );
+            BOOST_TEST_EQ( written, data.size() );
+            auto [ec, n] = co_await client.read_some(
+                capy::mutable_buffer( got.data(), got.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, data.size() );
+            BOOST_TEST( got.compare( 0, n, data ) == 0 );
+        };
+        capy::run_async( ioc.get_executor() )( transfer_task() );
+        ioc.run();
+
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testIdleBuffers()
+    {
+        using namespace tls::test;
+
+        // Between operations neither stream holds a pooled buffer
+        io_context ioc;
+        auto& pool = get_buffer_pool( ioc );
+        auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
+        auto [client_ctx, server_ctx] = make_contexts( context_mode::separate_cert );
+        auto client = make_stream( s1, client_ctx );
+        auto server = make_stream( s2, server_ctx );
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await client.handshake( tls_stream::client );
+            BOOST_TEST( !ec );
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !ec );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+        ioc.restart();
+        BOOST_TEST_EQ( pool.stats().leased_bytes, 0u );
+
+        auto transfer_task = [&]() -> capy::task<>
+        {
+            co_await test_stream( client, server );
+        };
+        capy::run_async( ioc.get_executor() )( transfer_task() );
+        ioc.run();
+        BOOST_TEST_EQ( pool.stats().leased_bytes, 0u );
+
+        s1.close();
+        s2.close();
+    }
+
     void
     testFailureCases()
     {
@@ -185,6 +471,53 @@ struct openssl_stream_test
         }
     }
 
+    void
+    testOcspStaple()
+    {
+        using namespace tls::test;
+
+        // Nothing stapled: soft-fail clients connect, requiring ones don't
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_revocation_policy( tls::revocation_policy::soft_fail );
+            run_tls_test( ioc, client_ctx, make_server_context(),
+                make_stream, make_stream );
+        }
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_require_ocsp_staple( true );
+            run_tls_test_fail( ioc, client_ctx, make_server_context(),
+                make_stream, make_stream );
+        }
+
+        // The source is fetched in the background and its response
+        // stapled; one the client cannot verify fails the handshake
+        {
+            std::atomic<int> fetches{ 0 };
+            io_context ioc;
+            auto server_ctx = make_server_context();
+            server_ctx.set_ocsp_staple_source( [&]
+            {
+                ++fetches;
+                return std::string( "not an OCSP response" );
+            });
+            {
+                socket sock( ioc );
+                auto warm = make_stream( sock, server_ctx );
+            }
+            for( int i = 0; i < 500 && fetches.load() == 0; ++i )
+                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            BOOST_TEST( fetches.load() >= 1 );
+
+            auto client_ctx = make_client_context();
+            client_ctx.set_require_ocsp_staple( true );
+            run_tls_test_fail( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+    }
+
     void
     testSni()
     {
@@ -252,6 +585,250 @@ struct openssl_stream_test
         }
     }
 
+    void
+    testSniRouting()
+    {
+        using namespace tls::test;
+
+        // Malformed names and routes to the context itself are refused
+        {
+            auto server_ctx = make_wrong_host_server_context();
+            auto routed = make_server_context();
+            BOOST_TEST( server_ctx.add_server_context( "", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context( "*.", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context( "www.*.com", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context(
+                "www.example.com", server_ctx ).has_error() );
+        }
+
+        // An exact route, matched without regard to case, presents the
+        // routed certificate instead of the default one
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "WWW.Example.com", make_server_context() ).has_error() );
+
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+
+        // A wildcard route covers the name
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "*.example.com", make_server_context() ).has_error() );
+
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+
+        // A name that is not routed gets the default certificate
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "api.example.com", make_server_context() ).has_error() );
+
+            run_tls_test_fail( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+    }
+
+    void
+    testServerContextLoader()
+    {
+        using namespace tls::test;
+
+        std::atomic<int> loads{ 0 };
+        auto server_ctx = make_wrong_host_server_context();
+        server_ctx.set_server_context_loader(
+            [&]( std::string_view hostname ) -> std::optional<tls::context>
+            {
+                ++loads;
+                if( hostname == "www.example.com" )
+                    return make_server_context();
+                return std::nullopt;
+            },
+            1 );
+
+        auto connect = [&]( char const* hostname, bool ok )
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( hostname );
+            if( ok )
+                run_tls_test( ioc, client_ctx, server_ctx,
+                    make_stream, make_stream );
+            else
+                run_tls_test_fail( ioc, client_ctx, server_ctx,
+                    make_stream, make_stream );
+        };
+
+        // The first handshake for a name loads its context, and later
+        // ones find it built
+        connect( "www.example.com", true );
+        connect( "www.example.com", true );
+        BOOST_TEST_EQ( loads.load(), 1 );
+
+        // A name the loader has no context for gets the default one
+        connect( "api.example.com", false );
+        BOOST_TEST_EQ( loads.load(), 2 );
+
+        // With room for one name, that dropped the first
+        connect( "www.example.com", true );
+        BOOST_TEST_EQ( loads.load(), 3 );
+    }
+
+    void
+    testSessionResumption()
+    {
+        using namespace tls::test;
+
+        auto connect = []( io_context& ioc, test_listener& listener,
+            tls::context const& client_ctx, tls::context const& server_ctx )
+        {
+            return run_resumption_test( ioc, listener, client_ctx,
+                server_ctx, make_stream, make_stream );
+        };
+
+        // A second connection to the same server resumes, through a
+        // ticket or, without tickets, the server's cache
+        for( auto v : { tls::version::tls_1_2, tls::version::tls_1_3 } )
+        {
+            for( bool tickets : { true, false } )
+            {
+                io_context ioc;
+                test_listener listener( ioc );
+                auto [client_ctx, server_ctx] = make_contexts(
+                    context_mode::separate_cert );
+                BOOST_TEST( !client_ctx.set_max_protocol_version( v ).has_error() );
+                server_ctx.set_session_tickets( tickets );
+                BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+                BOOST_TEST( connect( ioc, listener, client_ctx, server_ctx ) );
+            }
+        }
+
+        // A client without a cache offers no session
+        {
+            io_context ioc;
+            test_listener listener( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            client_ctx.set_session_cache_size( 0 );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+        }
+
+        // A server without a cache still resumes through tickets, and
+        // with neither it resumes nothing
+        for( bool tickets : { true, false } )
+        {
+            io_context ioc;
+            test_listener listener( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            server_ctx.set_session_cache_size( 0 );
+            server_ctx.set_session_tickets( tickets );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+            BOOST_TEST_EQ( connect( ioc, listener, client_ctx, server_ctx ), tickets );
+        }
+
+        // With room for one server, connecting to another evicts the
+        // first one's session
+        {
+            io_context ioc;
+            test_listener first( ioc );
+            test_listener second( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            client_ctx.set_session_cache_size( 1 );
+            BOOST_TEST( !connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, second, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, second, client_ctx, server_ctx ) );
+        }
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        // A ticket issued under the key just replaced is still
+        // accepted; the server has no cache to resume from instead
+        {
+            io_context ioc;
+            test_listener listener( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            server_ctx.set_session_cache_size( 0 );
+            server_ctx.set_ticket_key_lifetime( std::chrono::seconds( 1 ) );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1200 ) );
+            BOOST_TEST( connect( ioc, listener, client_ctx, server_ctx ) );
+        }
+#endif
+    }
+
+    void
+    testEarlyData()
+    {
+        using namespace tls::test;
+
+        // Without a session to resume nothing goes early, and the
+        // request is written once the handshake completes
+        io_context ioc;
+        auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+        auto client_ctx = make_client_context();
+        auto server_ctx = make_server_context();
+        server_ctx.set_max_early_data( 16384 );
+        auto client = make_stream( s1, client_ctx );
+        auto server = make_stream( s2, server_ctx );
+
+        std::string const request = "GET / HTTP/1.1\r\n\r\n";
+        std::string got( request.size(), 0 );
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [hec, sent] = co_await client.handshake_early(
+                capy::const_buffer( request.data(), request.size() ) );
+            BOOST_TEST( !hec );
+            BOOST_TEST_EQ( sent, 0u );
+            auto [ec, n] = co_await capy::write( client,
+                capy::const_buffer( request.data() + sent,
+                    request.size() - sent ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, request.size() );
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            auto [eec, early] = co_await server.read_early_data(
+                capy::mutable_buffer( got.data(), got.size() ) );
+            BOOST_TEST( !eec );
+            BOOST_TEST_EQ( early, 0u );
+            auto [hec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !hec );
+            auto [ec, n] = co_await capy::read( server,
+                capy::mutable_buffer( got.data(), got.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, got.size() );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+
+        BOOST_TEST( got == request );
+        s1.close();
+        s2.close();
+    }
+
     void
     testMtls()
     {
@@ -317,14 +894,26 @@ struct openssl_stream_test
     {
 #ifdef BOOST_COROSIO_HAS_OPENSSL
         testSuccessCases();
+        testHandshakeThreads();
+        testCryptoProvider();
+        testMemoryResource();
+        testGatherWrite();
+        testPartialWrite();
+        testMultiRecordRead();
+        testIdleBuffers();
         testTlsShutdown();
         testStreamTruncated();
         testFailureCases();
         testStopTokenCancellation();
         testSocketErrorPropagation();
         testCertificateValidation();
+        testOcspStaple();
         testSni();
         testSniCallback();
+        testSniRouting();
+        testServerContextLoader();
+        testSessionResumption();
+        testEarlyData();
         testMtls();
         testCertificateChain();
 #else
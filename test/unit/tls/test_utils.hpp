@@ -10,8 +10,10 @@
 #ifndef BOOST_COROSIO_TEST_TLS_TEST_UTILS_HPP
 #define BOOST_COROSIO_TEST_TLS_TEST_UTILS_HPP
 
+#include <boost/corosio/acceptor.hpp>
 #include <boost/corosio/io_context.hpp>
 #include <boost/corosio/io_stream.hpp>
+#include <boost/corosio/socket.hpp>
 #include <boost/corosio/timer.hpp>
 #include <boost/corosio/tls/context.hpp>
 #include <boost/corosio/tls/tls_stream.hpp>
@@ -20,11 +22,13 @@
 #include <boost/capy/cond.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
 
 #include "test_suite.hpp"
 
 #include <chrono>
 #include <stop_token>
+#include <utility>
 #include <vector>
 
 namespace boost::corosio::tls::test {
@@ -710,7 +714,7 @@ run_tls_test(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -772,7 +776,7 @@ run_tls_test_no_shutdown(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -832,7 +836,7 @@ run_tls_test_fail(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -930,7 +934,7 @@ run_tls_shutdown_test(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1035,7 +1039,7 @@ run_tls_truncation_test(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1290,7 +1294,7 @@ run_connection_reset_test(
     ClientStreamFactory make_client,
     ServerStreamFactory make_server )
 {
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1374,7 +1378,7 @@ run_stop_token_handshake_test(
     ServerStreamFactory make_server )
 {
 
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1448,7 +1452,7 @@ run_stop_token_read_test(
     ServerStreamFactory make_server )
 {
 
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1541,7 +1545,7 @@ run_stop_token_write_test(
     ServerStreamFactory make_server )
 {
 
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -1626,6 +1630,125 @@ run_stop_token_write_test(
     if( s2.is_open() ) s2.close();
 }
 
+//------------------------------------------------------------------------------
+//
+// Session Resumption Tests
+//
+//------------------------------------------------------------------------------
+
+/** A loopback listener that clients connect to repeatedly.
+
+    Clients keep sessions per server endpoint, so a test that
+    resumes a session connects to the same listener again.
+*/
+class test_listener
+{
+    io_context& ioc_;
+    acceptor acc_;
+    endpoint ep_;
+
+public:
+    explicit
+    test_listener( io_context& ioc )
+        : ioc_( ioc )
+        , acc_( ioc )
+    {
+        acc_.listen( endpoint( 0 ) );
+        ep_ = endpoint( urls::ipv4_address::loopback(),
+            acc_.local_endpoint().port() );
+    }
+
+    /** Return a connected pair, the client's end first. */
+    std::pair<socket, socket>
+    connect()
+    {
+        socket client( ioc_ );
+        socket server( ioc_ );
+        client.open();
+
+        system::error_code accept_ec;
+        system::error_code connect_ec;
+        auto accept_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await acc_.accept( server );
+            accept_ec = ec;
+        };
+        auto connect_task = [&]() -> capy::task<>
+        {
+            auto [ec] = co_await client.connect( ep_ );
+            connect_ec = ec;
+        };
+        capy::run_async( ioc_.get_executor() )( accept_task() );
+        capy::run_async( ioc_.get_executor() )( connect_task() );
+        ioc_.run();
+        ioc_.restart();
+
+        BOOST_TEST( !accept_ec );
+        BOOST_TEST( !connect_ec );
+        return { std::move( client ), std::move( server ) };
+    }
+};
+
+/** Connect to a listener, returning whether the session was resumed.
+
+    After the handshake the client reads, which is when TLS 1.3
+    tickets arrive, and its stream is destroyed before this
+    returns, which is when some backends keep the session.
+
+    @param ioc          The io_context of the listener
+    @param listener     The server to connect to
+    @param client_ctx   TLS context for the client
+    @param server_ctx   TLS context for the server
+    @param make_client  Factory: (io_stream&, context) -> TLS stream
+    @param make_server  Factory: (io_stream&, context) -> TLS stream
+*/
+template<typename ClientStreamFactory, typename ServerStreamFactory>
+bool
+run_resumption_test(
+    io_context& ioc,
+    test_listener& listener,
+    context client_ctx,
+    context server_ctx,
+    ClientStreamFactory make_client,
+    ServerStreamFactory make_server )
+{
+    auto [s1, s2] = listener.connect();
+    bool reused = false;
+    {
+        auto client = make_client( s1, client_ctx );
+        auto server = make_server( s2, server_ctx );
+
+        auto client_task = [&client]() -> capy::task<>
+        {
+            auto [ec] = co_await client.handshake( tls_stream::client );
+            BOOST_TEST( !ec );
+        };
+        auto server_task = [&server]() -> capy::task<>
+        {
+            auto [ec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !ec );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+        ioc.restart();
+
+        auto transfer_task = [&client, &server]() -> capy::task<>
+        {
+            co_await test_stream( client, server );
+        };
+        capy::run_async( ioc.get_executor() )( transfer_task() );
+        ioc.run();
+        ioc.restart();
+
+        reused = client.session_reused();
+        BOOST_TEST_EQ( server.session_reused(), reused );
+    }
+    s1.close();
+    s2.close();
+    return reused;
+}
+
 //------------------------------------------------------------------------------
 //
 // Socket Error Propagation Test
@@ -1650,7 +1773,7 @@ run_socket_cancel_test(
     ServerStreamFactory make_server )
 {
 
-    auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+    auto [s1, s2] = corosio::test::make_local_socket_pair( ioc );
 
     auto client = make_client( s1, client_ctx );
     auto server = make_server( s2, server_ctx );
@@ -18,9 +18,15 @@
 // Test that header file is self-contained.
 #include <boost/corosio/tls/wolfssl_stream.hpp>
 
+#include <boost/capy/read.hpp>
+#include <boost/capy/write.hpp>
+
 #include "test_utils.hpp"
 #include "test_suite.hpp"
+#include <atomic>
 #include <iostream>
+#include <optional>
+#include <string>
 
 namespace boost::corosio {
 
@@ -50,6 +56,69 @@ struct wolfssl_stream_test
         }
     }
 
+    void
+    testHandshakeThreads()
+    {
+        using namespace tls::test;
+
+        // Handshake steps run on the contexts' pools and resume on ioc
+        for( auto mode : { context_mode::shared_cert,
+                           context_mode::separate_cert } )
+        {
+            io_context ioc;
+            auto [client_ctx, server_ctx] = make_contexts( mode );
+            client_ctx.set_handshake_threads( 2 );
+            server_ctx.set_handshake_threads( 2 );
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+    }
+
+    void
+    testLargeTransfer()
+    {
+        using namespace tls::test;
+
+        // More than the socket buffers hold, so that sends straight
+        // from WolfSSL's buffer find the socket full and wait
+        io_context ioc;
+        auto [s1, s2] = corosio::test::make_socket_pair( ioc );
+        auto [client_ctx, server_ctx] = make_contexts( context_mode::shared_cert );
+        auto client = make_stream( s1, client_ctx );
+        auto server = make_stream( s2, server_ctx );
+
+        std::string data( 4 * 1024 * 1024, 0 );
+        for( std::size_t i = 0; i < data.size(); ++i )
+            data[i] = static_cast<char>( i * 7 );
+        std::string got( data.size(), 0 );
+
+        auto client_task = [&]() -> capy::task<>
+        {
+            auto [hec] = co_await client.handshake( tls_stream::client );
+            BOOST_TEST( !hec );
+            auto [ec, n] = co_await capy::write( client,
+                capy::const_buffer( data.data(), data.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, data.size() );
+        };
+        auto server_task = [&]() -> capy::task<>
+        {
+            auto [hec] = co_await server.handshake( tls_stream::server );
+            BOOST_TEST( !hec );
+            auto [ec, n] = co_await capy::read( server,
+                capy::mutable_buffer( got.data(), got.size() ) );
+            BOOST_TEST( !ec );
+            BOOST_TEST_EQ( n, got.size() );
+        };
+        capy::run_async( ioc.get_executor() )( client_task() );
+        capy::run_async( ioc.get_executor() )( server_task() );
+        ioc.run();
+
+        BOOST_TEST( got == data );
+        s1.close();
+        s2.close();
+    }
+
     void
     testFailureCases()
     {
@@ -255,6 +324,188 @@ struct wolfssl_stream_test
         }
     }
 
+    void
+    testSniRouting()
+    {
+        using namespace tls::test;
+
+        // Malformed names and routes to the context itself are refused
+        {
+            auto server_ctx = make_wrong_host_server_context();
+            auto routed = make_server_context();
+            BOOST_TEST( server_ctx.add_server_context( "", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context( "*.", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context( "www.*.com", routed ).has_error() );
+            BOOST_TEST( server_ctx.add_server_context(
+                "www.example.com", server_ctx ).has_error() );
+        }
+
+        // An exact route, matched without regard to case, presents the
+        // routed certificate instead of the default one
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "WWW.Example.com", make_server_context() ).has_error() );
+
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+
+        // A wildcard route covers the name
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "*.example.com", make_server_context() ).has_error() );
+
+            run_tls_test( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+
+        // A name that is not routed gets the default certificate
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( "www.example.com" );
+
+            auto server_ctx = make_wrong_host_server_context();
+            BOOST_TEST( !server_ctx.add_server_context(
+                "api.example.com", make_server_context() ).has_error() );
+
+            run_tls_test_fail( ioc, client_ctx, server_ctx,
+                make_stream, make_stream );
+        }
+    }
+
+    void
+    testServerContextLoader()
+    {
+        using namespace tls::test;
+
+        std::atomic<int> loads{ 0 };
+        auto server_ctx = make_wrong_host_server_context();
+        server_ctx.set_server_context_loader(
+            [&]( std::string_view hostname ) -> std::optional<tls::context>
+            {
+                ++loads;
+                if( hostname == "www.example.com" )
+                    return make_server_context();
+                return std::nullopt;
+            },
+            1 );
+
+        auto connect = [&]( char const* hostname, bool ok )
+        {
+            io_context ioc;
+            auto client_ctx = make_client_context();
+            client_ctx.set_hostname( hostname );
+            if( ok )
+                run_tls_test( ioc, client_ctx, server_ctx,
+                    make_stream, make_stream );
+            else
+                run_tls_test_fail( ioc, client_ctx, server_ctx,
+                    make_stream, make_stream );
+        };
+
+        // The first handshake for a name loads its context, and later
+        // ones find it built
+        connect( "www.example.com", true );
+        connect( "www.example.com", true );
+        BOOST_TEST_EQ( loads.load(), 1 );
+
+        // A name the loader has no context for gets the default one
+        connect( "api.example.com", false );
+        BOOST_TEST_EQ( loads.load(), 2 );
+
+        // With room for one name, that dropped the first
+        connect( "www.example.com", true );
+        BOOST_TEST_EQ( loads.load(), 3 );
+    }
+
+    void
+    testSessionResumption()
+    {
+        using namespace tls::test;
+
+        auto connect = []( io_context& ioc, test_listener& listener,
+            tls::context const& client_ctx, tls::context const& server_ctx )
+        {
+            return run_resumption_test( ioc, listener, client_ctx,
+                server_ctx, make_stream, make_stream );
+        };
+
+        // A second connection to the same server resumes through a
+        // ticket. Without tickets only TLS 1.2 resumes, from the
+        // server's cache; WolfSSL resumes TLS 1.3 through tickets.
+        for( auto v : { tls::version::tls_1_2, tls::version::tls_1_3 } )
+        {
+            for( bool tickets : { true, false } )
+            {
+                io_context ioc;
+                test_listener listener( ioc );
+                auto [client_ctx, server_ctx] = make_contexts(
+                    context_mode::separate_cert );
+                BOOST_TEST( !client_ctx.set_max_protocol_version( v ).has_error() );
+                server_ctx.set_session_tickets( tickets );
+                BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+                BOOST_TEST_EQ( connect( ioc, listener, client_ctx, server_ctx ),
+                    tickets || v == tls::version::tls_1_2 );
+            }
+        }
+
+        // A client without a cache offers no session
+        {
+            io_context ioc;
+            test_listener listener( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            client_ctx.set_session_cache_size( 0 );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+        }
+
+        // A server without a cache still resumes through tickets, and
+        // with neither it resumes nothing
+        for( bool tickets : { true, false } )
+        {
+            io_context ioc;
+            test_listener listener( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            server_ctx.set_session_cache_size( 0 );
+            server_ctx.set_session_tickets( tickets );
+            BOOST_TEST( !connect( ioc, listener, client_ctx, server_ctx ) );
+            BOOST_TEST_EQ( connect( ioc, listener, client_ctx, server_ctx ), tickets );
+        }
+
+        // With room for one server, connecting to another evicts the
+        // first one's session
+        {
+            io_context ioc;
+            test_listener first( ioc );
+            test_listener second( ioc );
+            auto [client_ctx, server_ctx] = make_contexts(
+                context_mode::separate_cert );
+            client_ctx.set_session_cache_size( 1 );
+            BOOST_TEST( !connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, second, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( connect( ioc, first, client_ctx, server_ctx ) );
+            BOOST_TEST( !connect( ioc, second, client_ctx, server_ctx ) );
+        }
+
+        // Ticket key rotation is not tested: WolfSSL ignores
+        // set_ticket_key_lifetime and rotates on a lifetime fixed
+        // when the library is built
+    }
+
     void
     testMtls()
     {
@@ -323,6 +574,8 @@ struct wolfssl_stream_test
     {
 #ifdef BOOST_COROSIO_HAS_WOLFSSL
         testSuccessCases();
+        testHandshakeThreads();
+        testLargeTransfer();
         testTlsShutdown();
         testStreamTruncated();
         testFailureCases();
@@ -331,6 +584,9 @@ struct wolfssl_stream_test
         testCertificateValidation();
         testSni();
         testSniCallback();
+        testSniRouting();
+        testServerContextLoader();
+        testSessionResumption();
         testMtls();
         testCertificateChain();
 #else
@@ -0,0 +1,445 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/udp_socket.hpp>
+
+#include <boost/corosio/detail/platform.hpp>
+
+#if BOOST_COROSIO_HAS_EPOLL
+
+#include <boost/corosio/epoll_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/url/ipv4_address.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Datagram socket tests
+// Focus: single and batched datagrams, truncation, cancellation
+// and segmentation offload over loopback.
+//------------------------------------------------
+
+namespace {
+
+// A socket bound to an ephemeral loopback port
+endpoint
+bind_loopback(udp_socket& s)
+{
+    s.bind(endpoint(urls::ipv4_address::loopback(), 0));
+    return s.local_endpoint();
+}
+
+} // namespace
+
+template<class Context>
+struct udp_socket_test_impl
+{
+    void
+    testOpenBind()
+    {
+        Context ioc;
+        udp_socket s(ioc);
+        BOOST_TEST(!s.is_open());
+        BOOST_TEST(s.local_endpoint() == endpoint{});
+
+        s.open();
+        BOOST_TEST(s.is_open());
+        BOOST_TEST(s.native_handle() >= 0);
+
+        auto ep = bind_loopback(s);
+        BOOST_TEST(ep.v4_address() == urls::ipv4_address::loopback());
+        BOOST_TEST(ep.port() != 0);
+
+        s.close();
+        BOOST_TEST(!s.is_open());
+        BOOST_TEST(s.native_handle() == -1);
+    }
+
+    void
+    testSendReceive()
+    {
+        Context ioc;
+        udp_socket a(ioc);
+        udp_socket b(ioc);
+        auto ep_a = bind_loopback(a);
+        auto ep_b = bind_loopback(b);
+
+        char buf[64] = {};
+        endpoint from;
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, n1] = co_await a.send_to(
+                capy::const_buffer("datagram", 8), ep_b);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(n1, 8u);
+
+            auto [ec2, n2] = co_await b.receive_from(
+                capy::mutable_buffer(buf, sizeof(buf)), from);
+            BOOST_TEST(!ec2);
+            BOOST_TEST_EQ(std::string_view(buf, n2), "datagram");
+            BOOST_TEST(from == ep_a);
+
+            // An empty datagram is not EOF
+            auto [ec3, n3] = co_await a.send_to(
+                capy::const_buffer(nullptr, 0), ep_b);
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(n3, 0u);
+
+            auto [ec4, n4] = co_await b.receive_from(
+                capy::mutable_buffer(buf, sizeof(buf)), from);
+            BOOST_TEST(!ec4);
+            BOOST_TEST_EQ(n4, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+    }
+
+    void
+    testReceiveFirst()
+    {
+        Context ioc;
+        udp_socket a(ioc);
+        udp_socket b(ioc);
+        bind_loopback(a);
+        auto ep_b = bind_loopback(b);
+
+        char buf[16] = {};
+        endpoint from;
+
+        // The receive parks before anything is sent
+        auto receiver = [&]() -> capy::task<>
+        {
+            auto [ec, n] = co_await b.receive_from(
+                capy::mutable_buffer(buf, sizeof(buf)), from);
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(std::string_view(buf, n), "late");
+        };
+
+        auto sender = [&]() -> capy::task<>
+        {
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(20));
+            (void)co_await t.wait();
+            (void)co_await a.send_to(capy::const_buffer("late", 4), ep_b);
+        };
+
+        capy::run_async(ioc.get_executor())(receiver());
+        capy::run_async(ioc.get_executor())(sender());
+
+        ioc.run();
+    }
+
+    void
+    testTruncated()
+    {
+        Context ioc;
+        udp_socket a(ioc);
+        udp_socket b(ioc);
+        bind_loopback(a);
+        auto ep_b = bind_loopback(b);
+
+        char buf[4] = {};
+        endpoint from;
+
+        auto task = [&]() -> capy::task<>
+        {
+            (void)co_await a.send_to(
+                capy::const_buffer("0123456789", 10), ep_b);
+
+            // The bytes that fit arrive with the error
+            auto [ec, n] = co_await b.receive_from(
+                capy::mutable_buffer(buf, sizeof(buf)), from);
+            BOOST_TEST(ec == system::errc::message_size);
+            BOOST_TEST_EQ(std::string_view(buf, n), "0123");
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+    }
+
+    void
+    testBatch()
+    {
+        Context ioc;
+        udp_socket a(ioc);
+        udp_socket b(ioc);
+        auto ep_a = bind_loopback(a);
+        auto ep_b = bind_loopback(b);
+
+        constexpr std::size_t count = 8;
+        std::array<std::string, count> data;
+        std::array<udp_socket::message, count> out;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            data[i] = "message " + std::to_string(i);
+            out[i].buffer = capy::mutable_buffer(data[i].data(), data[i].size());
+            out[i].peer = ep_b;
+        }
+
+        std::array<std::array<char, 64>, count + 2> storage{};
+        std::array<udp_socket::message, count + 2> in;
+        for (std::size_t i = 0; i < in.size(); ++i)
+            in[i].buffer = capy::mutable_buffer(storage[i].data(), storage[i].size());
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, sent] = co_await a.send_batch(out);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(sent, count);
+            for (std::size_t i = 0; i < sent; ++i)
+                BOOST_TEST_EQ(out[i].size, data[i].size());
+
+            // The receive returns what is queued, not a full span
+            std::size_t received = 0;
+            while (received < count)
+            {
+                auto [ec2, n] = co_await b.receive_batch(
+                    std::span(in).subspan(received));
+                BOOST_TEST(!ec2);
+                if (ec2)
+                    co_return;
+                received += n;
+            }
+            BOOST_TEST_EQ(received, count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                BOOST_TEST_EQ(
+                    std::string_view(storage[i].data(), in[i].size),
+                    data[i]);
+                BOOST_TEST(in[i].peer == ep_a);
+                BOOST_TEST(!in[i].truncated);
+            }
+
+            // Nothing to send
+            auto [ec3, none] = co_await a.send_batch({});
+            BOOST_TEST(!ec3);
+            BOOST_TEST_EQ(none, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+    }
+
+    void
+    testCancelReceive()
+    {
+        Context ioc;
+        udp_socket s(ioc);
+        bind_loopback(s);
+
+        char buf[16];
+        endpoint from;
+        bool done = false;
+
+        auto receiver = [&]() -> capy::task<>
+        {
+            auto [ec, n] = co_await s.receive_from(
+                capy::mutable_buffer(buf, sizeof(buf)), from);
+            BOOST_TEST(ec == capy::cond::canceled);
+            BOOST_TEST_EQ(n, 0u);
+            done = true;
+        };
+
+        auto canceller = [&]() -> capy::task<>
+        {
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(20));
+            (void)co_await t.wait();
+            s.cancel();
+        };
+
+        capy::run_async(ioc.get_executor())(receiver());
+        capy::run_async(ioc.get_executor())(canceller());
+
+        ioc.run();
+        BOOST_TEST(done);
+    }
+
+    void
+    testCloseWhilePending()
+    {
+        Context ioc;
+        udp_socket s(ioc);
+        bind_loopback(s);
+
+        std::array<char, 16> storage;
+        std::array<udp_socket::message, 1> in;
+        in[0].buffer = capy::mutable_buffer(storage.data(), storage.size());
+        bool done = false;
+
+        auto receiver = [&]() -> capy::task<>
+        {
+            auto [ec, n] = co_await s.receive_batch(in);
+            BOOST_TEST(ec == capy::cond::canceled);
+            BOOST_TEST_EQ(n, 0u);
+            done = true;
+        };
+
+        auto closer = [&]() -> capy::task<>
+        {
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(20));
+            (void)co_await t.wait();
+            s.close();
+        };
+
+        capy::run_async(ioc.get_executor())(receiver());
+        capy::run_async(ioc.get_executor())(closer());
+
+        ioc.run();
+        BOOST_TEST(done);
+    }
+
+    void
+    testSegmentationOffload()
+    {
+        Context ioc;
+        udp_socket a(ioc);
+        udp_socket b(ioc);
+        bind_loopback(a);
+        auto ep_b = bind_loopback(b);
+
+        try
+        {
+            a.set_gso_segment(0);
+        }
+        catch (system::system_error const& e)
+        {
+            // Kernels before 4.18 have no UDP GSO
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+            return;
+        }
+        BOOST_TEST_EQ(a.gso_segment(), 0u);
+
+        // One send of 2500 bytes leaves as three datagrams
+        std::string data(2500, '\0');
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<char>(i * 3);
+        std::array<udp_socket::message, 1> out;
+        out[0].buffer = capy::mutable_buffer(data.data(), data.size());
+        out[0].peer = ep_b;
+        out[0].segment_size = 1000;
+
+        std::array<std::array<char, 1500>, 4> storage;
+        std::array<udp_socket::message, 4> in;
+        for (std::size_t i = 0; i < in.size(); ++i)
+            in[i].buffer = capy::mutable_buffer(storage[i].data(), storage[i].size());
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec1, sent] = co_await a.send_batch(out);
+            BOOST_TEST(!ec1);
+            BOOST_TEST_EQ(sent, 1u);
+            BOOST_TEST_EQ(out[0].size, data.size());
+
+            std::size_t received = 0;
+            while (received < 3)
+            {
+                auto [ec2, n] = co_await b.receive_batch(
+                    std::span(in).subspan(received));
+                BOOST_TEST(!ec2);
+                if (ec2)
+                    co_return;
+                received += n;
+            }
+            BOOST_TEST_EQ(in[0].size, 1000u);
+            BOOST_TEST_EQ(in[1].size, 1000u);
+            BOOST_TEST_EQ(in[2].size, 500u);
+            std::string joined;
+            for (std::size_t i = 0; i < 3; ++i)
+                joined.append(storage[i].data(), in[i].size);
+            BOOST_TEST(joined == data);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+
+        // The socket-wide size applies to every send
+        a.set_gso_segment(1200);
+        BOOST_TEST_EQ(a.gso_segment(), 1200u);
+
+        try
+        {
+            b.set_gro(true);
+            BOOST_TEST(b.gro());
+            b.set_gro(false);
+            BOOST_TEST(!b.gro());
+        }
+        catch (system::system_error const& e)
+        {
+            // Kernels before 5.0 have no UDP GRO
+            BOOST_TEST(e.code() == system::errc::operation_not_supported);
+        }
+    }
+
+    void
+    testNotOpen()
+    {
+        Context ioc;
+        udp_socket s(ioc);
+        char buf[4];
+        endpoint from;
+
+        BOOST_TEST_THROWS(
+            (void)s.send_to(capy::const_buffer(buf, 4), endpoint{}),
+            std::logic_error);
+        BOOST_TEST_THROWS(
+            (void)s.receive_from(capy::mutable_buffer(buf, 4), from),
+            std::logic_error);
+        BOOST_TEST_THROWS(s.set_gro(true), std::logic_error);
+    }
+
+    void
+    run()
+    {
+        testOpenBind();
+        testSendReceive();
+        testReceiveFirst();
+        testTruncated();
+
+        // Batches
+        testBatch();
+
+        // Cancellation
+        testCancelReceive();
+        testCloseWhilePending();
+
+        // Offload
+        testSegmentationOffload();
+
+        testNotOpen();
+    }
+};
+
+//------------------------------------------------
+// Register test suites for each backend with datagram support
+//------------------------------------------------
+
+struct udp_socket_test_epoll : udp_socket_test_impl<epoll_context> {};
+TEST_SUITE(udp_socket_test_epoll, "boost.corosio.udp_socket.epoll");
+
+} // namespace boost::corosio
+
+#endif // BOOST_COROSIO_HAS_EPOLL
@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2026 Steve Gerbino
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/corosio
+//
+
+// Test that header file is self-contained.
+#include <boost/corosio/write_queue.hpp>
+
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/socket.hpp>
+#include <boost/corosio/test/socket_pair.hpp>
+#include <boost/corosio/timer.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost::corosio {
+
+//------------------------------------------------
+// Write queue tests
+// Focus: concurrent writers are sent whole and in order, each
+// sees its own byte count, and a failed stream fails the queue.
+//------------------------------------------------
+
+struct write_queue_test
+{
+    // Launch one writer per message, all at once, and read back
+    // everything they send
+    static std::string
+    run_writers(
+        std::size_t limit,
+        std::size_t count,
+        std::size_t size,
+        std::size_t* sent)
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        write_queue wq(s1, limit);
+        BOOST_TEST_EQ(wq.limit(), limit);
+
+        std::vector<std::string> msgs;
+        for (std::size_t i = 0; i < count; ++i)
+            msgs.emplace_back(size, static_cast<char>('a' + i));
+
+        auto writer = [&](std::size_t i) -> capy::task<>
+        {
+            auto [ec, n] = co_await wq.write(
+                capy::const_buffer(msgs[i].data(), msgs[i].size()));
+            BOOST_TEST(!ec);
+            sent[i] = n;
+        };
+        for (std::size_t i = 0; i < count; ++i)
+            capy::run_async(ioc.get_executor())(writer(i));
+
+        std::string got;
+        auto reader = [&]() -> capy::task<>
+        {
+            std::array<char, 4096> buf;
+            while (got.size() < count * size)
+            {
+                auto [ec, n] = co_await s2.read_some(
+                    capy::mutable_buffer(buf.data(), buf.size()));
+                if (ec)
+                    break;
+                got.append(buf.data(), n);
+            }
+        };
+        capy::run_async(ioc.get_executor())(reader());
+
+        ioc.run();
+        BOOST_TEST_EQ(wq.queued(), 0u);
+
+        s1.close();
+        s2.close();
+        return got;
+    }
+
+    // Each message arrives whole, and in the order written
+    static void
+    check_order(
+        std::string const& got,
+        std::size_t count,
+        std::size_t size)
+    {
+        BOOST_TEST_EQ(got.size(), count * size);
+        if (got.size() != count * size)
+            return;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto part = got.substr(i * size, size);
+            BOOST_TEST(part == std::string(size, static_cast<char>('a' + i)));
+        }
+    }
+
+    void
+    testConcurrent()
+    {
+        std::size_t const count = 8;
+        std::size_t const size = 20000;
+        std::array<std::size_t, count> sent{};
+
+        auto got = run_writers(
+            write_queue::default_limit, count, size, sent.data());
+        check_order(got, count, size);
+        for (auto n : sent)
+            BOOST_TEST_EQ(n, size);
+    }
+
+    void
+    testBackpressure()
+    {
+        // Every writer but the first waits for room
+        std::size_t const count = 6;
+        std::size_t const size = 3000;
+        std::array<std::size_t, count> sent{};
+
+        auto got = run_writers(1000, count, size, sent.data());
+        check_order(got, count, size);
+        for (auto n : sent)
+            BOOST_TEST_EQ(n, size);
+    }
+
+    void
+    testEmptyWrite()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        write_queue wq(s1);
+
+        auto task = [&]() -> capy::task<>
+        {
+            auto [ec, n] = co_await wq.write(capy::const_buffer());
+            BOOST_TEST(!ec);
+            BOOST_TEST_EQ(n, 0u);
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        s1.close();
+        s2.close();
+    }
+
+    void
+    testPeerClosed()
+    {
+        io_context ioc;
+        auto [s1, s2] = test::make_local_socket_pair(ioc);
+        write_queue wq(s1);
+
+        std::size_t const count = 4;
+        std::string const data(1024 * 1024, 'x');
+        std::array<system::error_code, count> errors{};
+
+        auto writer = [&](std::size_t i) -> capy::task<>
+        {
+            // Each writer sends until the stream fails
+            for (int j = 0; j < 16; ++j)
+            {
+                auto [ec, n] = co_await wq.write(
+                    capy::const_buffer(data.data(), data.size()));
+                if (ec)
+                {
+                    errors[i] = ec;
+                    co_return;
+                }
+            }
+        };
+
+        auto task = [&]() -> capy::task<>
+        {
+            s2.close();
+
+            // Give the OS time to process the close
+            timer t(ioc);
+            t.expires_after(std::chrono::milliseconds(50));
+            (void)co_await t.wait();
+
+            for (std::size_t i = 0; i < count; ++i)
+                capy::run_async(ioc.get_executor())(writer(i));
+        };
+        capy::run_async(ioc.get_executor())(task());
+
+        ioc.run();
+        for (auto const& ec : errors)
+            BOOST_TEST(ec);
+        BOOST_TEST_EQ(wq.queued(), 0u);
+
+        s1.close();
+    }
+
+    void
+    run()
+    {
+        testConcurrent();
+        testBackpressure();
+        testEmptyWrite();
+        testPeerClosed();
+    }
+};
+
+TEST_SUITE(write_queue_test, "boost.corosio.write_queue");
+
+} // namespace boost::corosio